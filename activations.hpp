@@ -53,8 +53,12 @@
 #define ACTIVATIONS_HPP
 
 #include "interpret.hpp"
+#include "utils.hpp"
+#include "mac.hpp"
 #include <hls_stream.h>
 #include <functional>
+#include <type_traits>
+#include <utility>
 
 namespace comp{
   using std::binary_function;
@@ -221,6 +225,443 @@ public:
   }
 };
 
+/*!
+ * Use a per-row multi-threshold comparison as activation function,
+ * evaluated by a binary search over the sorted thresholds.
+ *
+ * Drop-in replacement for ThresholdsActivation with the same threshold
+ * layout. Instead of NumTH parallel comparators and a NumTH-input adder,
+ * clog2(NumTH+1) comparator stages are used, each selecting its threshold
+ * through a multiplexer driven by the result of the previous stage.
+ *
+ * The thresholds of each row must be sorted such that Compare(threshold, accu)
+ * holding for a threshold implies it to hold for all preceding ones (i.e.
+ * ascending for the default comparison). The result is then identical to
+ * the one of ThresholdsActivation.
+ */
+template<unsigned NF, unsigned PE, unsigned NumTH,
+	 typename TA, typename TR, int ActVal = 0, typename Compare = comp::less<TA, TA>>
+class ThresholdsActivationBinarySearch {
+  static constexpr unsigned  STAGES = clog2(NumTH+1);
+public:
+  TA m_thresholds[PE][NF][NumTH];
+
+public:
+  TA init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+    return  TA(0);
+  }
+
+public:
+  TR activate(unsigned const  nf, unsigned const  pe,  TA const &accu) const {
+#pragma HLS inline
+    // number of thresholds passed so far
+    ap_uint<STAGES+1>  cnt = 0;
+	for(unsigned int s = STAGES; s-- > 0;){
+#pragma HLS unroll
+      unsigned const  idx = cnt + (1u << s) - 1;
+      if((idx < NumTH) && Compare()(m_thresholds[pe][nf][idx < NumTH? idx : 0], accu)) {
+        cnt += (1u << s);
+      }
+    }
+    TR result=ActVal;
+    return result + cnt;
+  }
+};
+
+//- Batch-norm Folding --------------------------------------------------------
+/*
+ * A batch normalization y = scale*accu + bias of the accumulator followed by
+ * a uniform quantizer of step size step computes the output level
+ *
+ *   out = clamp(floor(y/step + 1/2), ActVal, ActVal+NumTH)
+ *
+ * i.e. rounding half up. It equals the count of the thresholds of
+ * ThresholdsActivation, with the default comparison, passed by accu when
+ * threshold i is the largest accu with an output level of at most ActVal+i.
+ * The scale must be positive, the sign of a negative one is to be folded into
+ * the weights of the channel. Thresholds beyond the range of TA saturate.
+ */
+namespace bn_folding {
+
+  // smallest integer not less than x
+  constexpr long long ceil(double const  x) {
+    return  (x > double((long long)x))? (long long)x + 1 : (long long)x;
+  }
+
+} // namespace bn_folding
+
+/**
+ * \brief      Threshold of the folded batch normalization and quantizer below
+ * which the output does not exceed the given level
+ *
+ * \tparam     TA     DataType of the thresholds (accumulator)
+ *
+ * \param      scale  Scale of the batch normalization, positive
+ * \param      bias   Bias of the batch normalization
+ * \param      step   Step size of the quantizer
+ * \param      level  Output level not to be exceeded, ActVal + threshold index
+ *
+ * \return     Threshold saturated to the range of TA
+ */
+template<typename TA>
+constexpr long long bn_threshold(double const  scale, double const  bias, double const  step, int const  level) {
+  // local copies, as std::min and std::max take their arguments by reference
+  constexpr long long  lo = accu_width::value_range<TA>::min;
+  constexpr long long  hi = accu_width::value_range<TA>::max;
+  return  std::min(hi, std::max(lo, bn_folding::ceil(((level + 0.5)*step - bias) / scale) - 1));
+}
+
+namespace bn_folding {
+
+  template<typename Act, typename BN, int ActVal, size_t... I>
+  Act make(std::index_sequence<I...>) {
+    using  TH = decltype(Act::m_thresholds);
+    using  TA = typename std::remove_all_extents<TH>::type;
+    constexpr unsigned  NF = std::extent<TH, 1>::value;
+    constexpr unsigned  NumTH = std::extent<TH, 2>::value;
+    constexpr unsigned  PE = std::extent<TH, 0>::value;
+    // flat index I walks m_thresholds[pe][nf][i] in memory order, i.e. channel nf*PE + pe
+    return  Act{ TA(bn_threshold<TA>(
+      BN::scale((I/NumTH%NF)*PE + I/(NF*NumTH)), BN::bias((I/NumTH%NF)*PE + I/(NF*NumTH)),
+      BN::step(), ActVal + int(I%NumTH)))... };
+  }
+
+} // namespace bn_folding
+
+/**
+ * \brief      Fills the thresholds of a ThresholdsActivation (or of the
+ * ThresholdsActivationBinarySearch) from the batch normalization of every
+ * output channel, e.g. at the initialization of a csim testbench
+ *
+ * Channel nf*PE + pe is found in thresholds[pe][nf] as in the MVAU.
+ *
+ * \tparam     ActVal      Lowest output level, the ActVal of the activation
+ *
+ * \param      thresholds  m_thresholds member of the activation
+ * \param      scale       Scale of the batch normalization per channel
+ * \param      bias        Bias of the batch normalization per channel
+ * \param      step        Step size of the quantizer
+ */
+template<int ActVal = 0, unsigned PE, unsigned NF, unsigned NumTH, typename TA>
+void fold_batchnorm(TA (&thresholds)[PE][NF][NumTH], double const  scale[], double const  bias[], double const  step) {
+  for(unsigned  pe = 0; pe < PE; pe++) {
+    for(unsigned  nf = 0; nf < NF; nf++) {
+      for(unsigned  i = 0; i < NumTH; i++) {
+        unsigned const  ch = nf*PE + pe;
+        thresholds[pe][nf][i] = TA(bn_threshold<TA>(scale[ch], bias[ch], step, ActVal + int(i)));
+      }
+    }
+  }
+}
+
+/**
+ * \brief      Builds a ThresholdsActivation (or a
+ * ThresholdsActivationBinarySearch) from the batch normalization of every
+ * output channel with every threshold given by a constant expression
+ *
+ * Meant for the initialization of static activations, e.g.
+ *   static ThresholdsActivation<NF, PE, NumTH, TA, TR> const  threshs = bn_thresholds<decltype(threshs), BN>();
+ *
+ * \tparam     Act     Activation type with an m_thresholds[PE][NF][NumTH] member
+ * \tparam     BN      Parameter class with the constexpr static members
+ *                     scale(channel), bias(channel) and step()
+ * \tparam     ActVal  Lowest output level, the ActVal of the activation
+ */
+template<typename Act, typename BN, int ActVal = 0>
+Act bn_thresholds() {
+  using  TH = decltype(Act::m_thresholds);
+  return  bn_folding::make<Act, BN, ActVal>(std::make_index_sequence<
+    std::extent<TH, 0>::value * std::extent<TH, 1>::value * std::extent<TH, 2>::value>());
+}
+
+/*!
+ * Use a per-row multi-threshold comparison as activation function,
+ * with the thresholds stored in compressed form.
+ *
+ * Each row keeps its smallest threshold at full accumulator width in
+ * m_base and the remaining ones as the narrow unsigned differences
+ * between consecutive sorted thresholds in m_deltas, i.e. threshold i is
+ * m_base + m_deltas[0] + ... + m_deltas[i-1]. The thresholds are
+ * rebuilt on the fly by an adder chain ahead of the comparators. The
+ * result equals the one of ThresholdsActivation on the decompressed,
+ * ascending thresholds.
+ *
+ * \tparam TD    DataType of the threshold differences, expected unsigned
+ */
+template<unsigned NF, unsigned PE, unsigned NumTH,
+	 typename TA, typename TD, typename TR, int ActVal = 0, typename Compare = comp::less<TA, TA>>
+class CompressedThresholdsActivation {
+  static_assert(NumTH > 0, "At least one threshold is required.");
+public:
+  TA m_base[PE][NF];
+  TD m_deltas[PE][NF][NumTH > 1? NumTH-1 : 1];
+
+public:
+  TA init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+    return  TA(0);
+  }
+
+public:
+  TR activate(unsigned const  nf, unsigned const  pe,  TA const &accu) const {
+#pragma HLS inline
+    TR result=ActVal;
+    TA threshold = m_base[pe][nf];
+	for(unsigned int i=0; i< NumTH; i++){
+#pragma HLS unroll
+      result+=Compare()(threshold, accu);
+      if(i < NumTH-1)  threshold += m_deltas[pe][nf][i < NumTH-1? i : 0];
+    }
+    return result;
+  }
+};
+
+
+/*!
+ * \brief Use an integer requantization with per-row parameters as activation function.
+ *
+ * The accumulator is multiplied by a per-row fixed-point multiplier, shifted
+ * right by a per-row amount with rounding to nearest (ties towards positive
+ * infinity), offset by the zero point and saturated to the range of TR:
+ *   result = clamp(((accu * m_multiplier + 2^(m_shift-1)) >> m_shift) + ZeroPoint)
+ * The parameter arrays are public to allow direct initialization and to
+ * make their names accessible for top-level HLS pragmas.
+ *
+ * \tparam NF        First dimension of the parameter matrix
+ * \tparam PE        Second dimension of the parameter matrix
+ * \tparam TA        DataType of the accumulator
+ * \tparam TR        DataType of return values
+ * \tparam TM        DataType of the multipliers
+ * \tparam TS        DataType of the right shifts
+ * \tparam ZeroPoint Zero point added after scaling
+ */
+template<unsigned NF, unsigned PE,
+   typename TA, typename TR, typename TM = ap_int<16>, typename TS = ap_uint<6>, int ZeroPoint = 0>
+class RequantActivation {
+public:
+  TM m_multiplier[PE][NF];
+  TS m_shift[PE][NF];
+
+public:
+  TA init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+    return  TA(0);
+  }
+
+public:
+  TR activate(unsigned const  nf, unsigned const  pe,  TA const &accu) const {
+#pragma HLS inline
+    constexpr unsigned  PW = TA::width + TM::width + 1;
+    constexpr unsigned  RW = TR::width + 2;
+    ap_int<PW> const  prod = ap_int<PW>(accu) * m_multiplier[pe][nf];
+    TS const  sh = m_shift[pe][nf];
+    ap_int<PW> const  rnd = sh == 0? ap_int<PW>(0) : ap_int<PW>(ap_int<PW>(1) << (sh-1));
+    ap_int<PW+1> const  scaled = (ap_int<PW+1>(prod) + rnd) >> sh;
+    ap_int<PW+2> const  val = ap_int<PW+2>(scaled) + ZeroPoint;
+
+    // saturation bounds of TR
+    bool const  sgn = TR(-1) < TR(0);
+    ap_int<RW> const  hi = sgn? ap_int<RW>((ap_int<RW>(1) << (TR::width-1)) - 1) : ap_int<RW>((ap_int<RW>(1) << TR::width) - 1);
+    ap_int<RW> const  lo = sgn? ap_int<RW>(-(ap_int<RW>(1) << (TR::width-1))) : ap_int<RW>(0);
+    return  val > hi? TR(hi) : val < lo? TR(lo) : TR(val);
+  }
+};
+
+/*!
+ * \brief Round a floating-point accumulator to a MiniFloat output.
+ *
+ * Emits the bits of the MiniFloat nearest to the accumulator (ties to even)
+ * for an output interpreted through Slice<TM>, e.g. to chain Half layers.
+ *
+ * \tparam TM  MiniFloat type of the output, e.g. Half or BFloat16
+ */
+template<typename TM>
+class MiniFloatActivation {
+public:
+  float init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+    return  0.0f;
+  }
+
+public:
+  ap_uint<TM::width> activate(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe, float const &accu) const {
+#pragma HLS inline
+    return  TM::from_float(accu).m_bits;
+  }
+};
+
+/*!
+ * \brief Bit encoding of a floating-point output: float or a MiniFloat such as Half or BFloat16
+ *
+ * \tparam TF  Floating-point format, float or a MiniFloat type
+ */
+template<typename TF>
+struct float_format {
+  static_assert(std::is_same<TF, float>::value, "Unsupported floating-point format.");
+  static unsigned const  width = 32;
+  static ap_uint<width> encode(float const  f) {
+#pragma HLS inline
+    return  detail::float_to_bits(f);
+  }
+};
+template<unsigned ExpBits, unsigned ManBits>
+struct float_format<MiniFloat<ExpBits, ManBits>> {
+  static unsigned const  width = MiniFloat<ExpBits, ManBits>::width;
+  static ap_uint<width> encode(float const  f) {
+#pragma HLS inline
+    return  MiniFloat<ExpBits, ManBits>::from_float(f).m_bits;
+  }
+};
+
+/*!
+ * \brief Dequantize integer values to floating-point with per-row scale and zero-point.
+ *
+ * Computes per channel
+ *   result = m_scale[pe][nf] * (in - m_zero[pe][nf])
+ * with the difference taken exactly and a single float rounding of the product,
+ * which is exact for float and rounded once more to nearest even for a MiniFloat
+ * output format. The result is emitted as the bits of TF, to let integer layers
+ * hand floating-point results to the host. The parameter arrays are public to
+ * allow direct initialization and to make their names accessible for top-level
+ * HLS pragmas.
+ *
+ * \tparam NF  First dimension of the parameter matrix
+ * \tparam PE  Second dimension of the parameter matrix
+ * \tparam TI  DataType of input layer values, an ap_int or ap_uint of at most 23 bits, so that
+ *             the difference to the zero-point converts to float exactly
+ * \tparam TF  Floating-point format of the results, float or a MiniFloat type such as Half
+ */
+template<unsigned NF, unsigned PE, typename TI, typename TF = float>
+class DequantActivation {
+  static_assert(TI::width + 1 <= 24, "The zero-point difference must convert to float exactly.");
+public:
+  float m_scale[PE][NF];
+  TI m_zero[PE][NF];
+
+public:
+  TI init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+    return  TI(0);
+  }
+
+public:
+  ap_uint<float_format<TF>::width> activate(unsigned const  nf, unsigned const  pe, TI const &in) const {
+#pragma HLS inline
+    ap_int<TI::width + 1> const  diff = ap_int<TI::width + 1>(in) - ap_int<TI::width + 1>(m_zero[pe][nf]);
+    return  float_format<TF>::encode(m_scale[pe][nf] * float(diff.to_int()));
+  }
+};
+
+/*!
+ * \brief Activation of an MVAU over block floating-point inputs, see BFPSlice.
+ *
+ * The mantissa products are accumulated in TV and the shared exponent of the
+ * block is merged here: the sum scaled by 2^exponent is converted to the
+ * accumulator type of the wrapped activation TAct, which must be wide enough
+ * for the largest exponent, and passed on to it. The parameters of TAct, e.g.
+ * the m_thresholds of a ThresholdsActivation, are inherited. The accumulation
+ * starts from zero rather than from TAct::init.
+ *
+ * \tparam TAct   Activation applied to the scaled accumulation
+ * \tparam TV     DataType of the accumulation of the mantissa products
+ * \tparam EBits  Width of the shared exponent
+ */
+template<typename TAct, typename TV, unsigned EBits>
+class BFPActivation : public TAct {
+  using  TA = decltype(std::declval<TAct const&>().init(0, 0));
+
+public:
+  BFPAccu<TV, EBits> init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+    return  BFPAccu<TV, EBits>(TV(0), 0);
+  }
+
+public:
+  auto activate(unsigned const  nf, unsigned const  pe, BFPAccu<TV, EBits> const &accu) const
+    -> decltype(std::declval<TAct const&>().activate(nf, pe, std::declval<TA>())) {
+#pragma HLS inline
+    TA  val = TA(accu.m_sum);
+    val <<= accu.m_exp;
+    return  TAct::activate(nf, pe, val);
+  }
+};
+
+/*!
+ * \brief Use a per-row affine requantization of a floating-point accumulator to an integer.
+ *
+ * Bridges a floating-point layer into integer ones, computing
+ *   round(accu * m_scale[pe][nf] + m_bias[pe][nf])
+ * rounded half away from zero and saturated to the range of TR. Thresholding
+ * into an integer layer is available through ThresholdsActivation with float
+ * thresholds. The parameters are public to allow direct initialization.
+ *
+ * \tparam NF  First dimension of the parameter matrix
+ * \tparam PE  Second dimension of the parameter matrix
+ * \tparam TR  DataType of return values, an ap_int or ap_uint
+ */
+template<unsigned NF, unsigned PE, typename TR>
+class FloatRequantActivation {
+public:
+  float m_scale[PE][NF];
+  float m_bias[PE][NF];
+
+public:
+  float init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+    return  0.0f;
+  }
+
+public:
+  TR activate(unsigned const  nf, unsigned const  pe, float const &accu) const {
+#pragma HLS inline
+    bool const  sgn = TR(-1) < TR(0);
+    float const  hi = sgn? float((1ull << (TR::width-1)) - 1) : float((1ull << TR::width) - 1);
+    float const  lo = sgn? -float(1ull << (TR::width-1)) : 0.0f;
+    float const  val = accu * m_scale[pe][nf] + m_bias[pe][nf];
+    // saturate ahead of the conversion, also mapping NaN to lo
+    float const  sat = val > hi? hi : val >= lo? val : lo;
+    return  TR((long long)(sat < 0.0f? sat - 0.5f : sat + 0.5f));
+  }
+};
+
+/*!
+ * \brief Use a lookup table as activation function.
+ *
+ * The accumulator is offset, shifted right and clipped to the table range
+ * to form the index, i.e. m_table[clip((accu - Offset) >> Shift, 0, Entries-1)]
+ * is returned. This implements arbitrary nonlinearities (e.g. sigmoid, tanh,
+ * hard-swish or GELU) on quantized values with one memory read per PE. The
+ * table is shared by all rows and PEs; it is public to allow direct
+ * initialization and to make its name accessible for top-level HLS pragmas
+ * (e.g. to bind it to a dual-port BRAM or LUTRAM serving two PEs).
+ *
+ * \tparam TA       DataType of the accumulator
+ * \tparam TR       DataType of return values
+ * \tparam Entries  Number of table entries
+ * \tparam Offset   Accumulator value mapped to the first table entry
+ * \tparam Shift    Right shift applied to the offset accumulator
+ */
+template<typename TA, typename TR, unsigned Entries, int Offset = 0, unsigned Shift = 0>
+class LUTActivation {
+  static constexpr unsigned  IDX_WIDTH = TA::width + 2;
+public:
+  TR m_table[Entries];
+
+public:
+  TA init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+    return  TA(0);
+  }
+
+public:
+  TR activate(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe, TA const &accu) const {
+#pragma HLS inline
+    ap_int<IDX_WIDTH> const  idx = (ap_int<IDX_WIDTH>(accu) - Offset) >> Shift;
+    ap_uint<clog2(Entries)+1> const  addr = idx < 0? ap_int<IDX_WIDTH>(0) : idx > int(Entries-1)? ap_int<IDX_WIDTH>(Entries-1) : idx;
+    return  m_table[addr];
+  }
+};
 
 /*!
  * \brief Use a simple activation function with per-row parameters.
@@ -255,6 +696,58 @@ public:
   }
 };
 
+/*!
+ * \brief Affine channel-wise operation with per-row scale and bias, fused with a requantization.
+ *
+ * Computes per channel
+ *   result = clip((in * m_scale + m_bias + 2^(Shift-1)) >> Shift)
+ * within the range of TR, which takes a batchnorm-style transform in a single
+ * pass instead of a chain of a multiplying and an adding ChannelWiseOperation.
+ * Without Saturate the result is truncated to TR instead. The parameter arrays
+ * are public to allow direct initialization and to make their names accessible
+ * for top-level HLS pragmas.
+ *
+ * \tparam NF       First dimension of the parameter matrix
+ * \tparam PE       Second dimension of the parameter matrix
+ * \tparam TI       DataType of input layer values
+ * \tparam TS       DataType of the scales
+ * \tparam TB       DataType of the biases, in the scale of the products
+ * \tparam TR       DataType of return values
+ * \tparam Shift    Right shift of the requantization, with rounding
+ * \tparam Saturate Whether the result is clipped to the range of TR
+ */
+template<unsigned NF, unsigned PE,
+   typename TI, typename TS, typename TB, typename TR, unsigned Shift = 0, bool Saturate = true>
+class AffineChannelWiseOperation {
+public:
+  TS m_scale[PE][NF];
+  TB m_bias[PE][NF];
+
+public:
+  TI init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+    return  TI(0);
+  }
+
+public:
+  TR activate(unsigned const  nf, unsigned const  pe,  TI const &in) const {
+#pragma HLS inline
+    constexpr unsigned  PW = TI::width + TS::width + 1;
+    constexpr unsigned  SW = (PW > TB::width? PW : TB::width) + 2;
+    constexpr unsigned  RW = TR::width + 2;
+    ap_int<SW> const  rnd = Shift == 0? ap_int<SW>(0) : ap_int<SW>(ap_int<SW>(1) << (Shift == 0? 0 : Shift-1));
+    ap_int<SW> const  sum = ap_int<SW>(ap_int<PW>(in) * m_scale[pe][nf]) + m_bias[pe][nf] + rnd;
+    ap_int<SW> const  val = sum >> Shift;
+    if(!Saturate)  return  TR(val);
+
+    // saturation bounds of TR
+    bool const  sgn = TR(-1) < TR(0);
+    ap_int<RW> const  hi = sgn? ap_int<RW>((ap_int<RW>(1) << (TR::width-1)) - 1) : ap_int<RW>((ap_int<RW>(1) << TR::width) - 1);
+    ap_int<RW> const  lo = sgn? ap_int<RW>(-(ap_int<RW>(1) << (TR::width-1))) : ap_int<RW>(0);
+    return  val > hi? TR(hi) : val < lo? TR(lo) : TR(val);
+  }
+};
+
 /*!
  * \brief Thresholding function for multiple images
  *
@@ -311,6 +804,133 @@ void Thresholding_Batch(hls::stream<TI> &in,
   }
 }
 
+/*!
+ * \brief Dequantization of integer activations to floating-point for multiple images
+ *
+ * Thresholding_Batch with a DequantActivation, emitting PE results per folded
+ * input word packed in the bit encoding of TF, e.g. for writing floating-point
+ * results to memory through Stream2Mem_Batch with no further pass on the host.
+ *
+ * \tparam ImgDim         Total spatial size of input feature map
+ * \tparam NumChannels    Number of channels in input feature map
+ * \tparam PE             Number of channels computed in parallel
+ * \tparam TSrcI          DataType of the input activation (as used in the MAC)
+ * \tparam TF             Floating-point format of the results, float or a MiniFloat type such as Half
+ * \tparam TI             DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO             DataType of the output stream - safely deducible from the paramaters
+ * \tparam TA             DataType of the activation class, a DequantActivation - safely deducible from the paramaters
+ *
+ * \param in              Input stream
+ * \param out             Output stream, PE results of float_format<TF>::width bits per word
+ * \param activation      Dequantization parameters
+ * \param reps            Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template <
+    unsigned ImgDim, unsigned NumChannels, unsigned PE,
+    typename TSrcI, typename TF = float,
+    typename TI, typename TO, typename TA>
+void Dequantize_Batch(hls::stream<TI> &in,
+                      hls::stream<TO> &out,
+                      TA const &activation,
+                      int const reps)
+{
+#pragma HLS INLINE
+  static_assert(TO::width == PE * float_format<TF>::width, "Output stream must hold PE results of TF.");
+  Thresholding_Batch<ImgDim, NumChannels, PE, TSrcI, Slice<ap_uint<float_format<TF>::width>>>(in, out, activation, reps);
+}
+
+/*!
+ * \brief Thresholding function for multiple images, MMV pixels in parallel
+ *
+ * Variant of Thresholding_Batch consuming the MultiChanData output of an MMV convolution, e.g.
+ * Matrix_Vector_Activate_Batch with MMV > 1, so that the MMV pipeline keeps its pixel rate after the
+ * activation. Every input word holds the same PE channels of MMV pixels, which share their thresholds.
+ *
+ * \tparam ImgDim         Total spatial size of input feature map, a multiple of MMV
+ * \tparam NumChannels    Number of channels in input feature map
+ * \tparam PE             Number of output rows computed in parallel
+ * \tparam MMV            Number of pixels computed in parallel
+ * \tparam TSrcI          DataType of the input activation (as used in the MAC), e.g. Slice_mmv
+ * \tparam TDstI          DataType of the output activation (as generated by the activation), e.g. Slice_mmv
+ * \tparam TI             DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO             DataType of the output stream - safely deducible from the paramaters
+ * \tparam TA             DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ *
+ * \param in              Input stream
+ * \param out             Output stream
+ * \param activation      Activation class
+ * \param reps            Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template <
+    unsigned ImgDim, unsigned NumChannels, unsigned PE, unsigned MMV,
+    typename TSrcI = Identity, typename TDstI = Identity,
+    typename TI, typename TO, typename TA>
+void Thresholding_MMV_Batch(hls::stream<TI> &in,
+                            hls::stream<TO> &out,
+                            TA const &activation,
+                            int const reps)
+{
+  static_assert(ImgDim % MMV == 0, "MMV must divide ImgDim.");
+  constexpr unsigned  NF = NumChannels / PE;
+
+  unsigned nf = 0;
+  for (unsigned i = 0; i < reps * (ImgDim / MMV) * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+
+    TI const  inElem = in.read();
+    auto const act = TSrcI()(inElem);
+    auto outElem = TDstI().template operator()<TO>();
+    for (unsigned pe = 0; pe < PE; pe++)
+    {
+#pragma HLS UNROLL
+      for (unsigned mmv = 0; mmv < MMV; mmv++)
+      {
+#pragma HLS UNROLL
+        outElem(pe,mmv,1) = activation.activate(nf, pe, act(pe,mmv));
+      }
+    }
+    out.write(outElem);
+    if (++nf == NF)
+    {
+      nf = 0;
+    }
+  }
+}
+
+/*!
+ * \brief Lookup table activation function for multiple images
+ *
+ * The function applies a table-driven activation (see LUTActivation) to every element
+ * of the input activation vector, PE elements per cycle.
+ *
+ * \tparam ImgDim         Total spatial size of input feature map
+ * \tparam NumChannels    Number of channels in input feature map
+ * \tparam PE             Number of elements processed in parallel
+ * \tparam TSrcI          DataType of the input activation
+ * \tparam TDstI          DataType of the output activation (as generated by the activation)
+ * \tparam TI             DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO             DataType of the output stream - safely deducible from the paramaters
+ * \tparam TA             DataType of the activation class (e.g. LUTActivation) - safely deducible from the paramaters
+ *
+ * \param in              Input stream
+ * \param out             Output stream
+ * \param lut             Activation class holding the table
+ * \param reps            Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template <
+    unsigned ImgDim, unsigned NumChannels, unsigned PE,
+    typename TSrcI = Identity, typename TDstI = Identity,
+    typename TI, typename TO, typename TA>
+void LUT_Batch(hls::stream<TI> &in,
+               hls::stream<TO> &out,
+               TA const &lut,
+               int const reps)
+{
+#pragma HLS INLINE
+  // a table lookup is an activation that ignores the channel index
+  Thresholding_Batch<ImgDim, NumChannels, PE, TSrcI, TDstI>(in, out, lut, reps);
+}
+
 /*!
  * \brief Thresholding function for multiple images, with streaming thresholds
  *
@@ -384,4 +1004,234 @@ void Thresholding_Stream_Batch(hls::stream<TI> &in,
   }
 }
 
+/*!
+ * \brief Thresholding function for multiple images, with streaming thresholds, MMV pixels in parallel
+ *
+ * Variant of Thresholding_Stream_Batch consuming the MultiChanData output of an MMV convolution. The
+ * thresholds of a channel fold are read once for the MMV pixels of an input word, so that the threshold
+ * stream provides ImgDim/MMV * NumChannels/PE words per image.
+ *
+ * \tparam ImgDim         Total spatial size of input feature map, a multiple of MMV
+ * \tparam NumChannels    Number of channels in input feature map
+ * \tparam PE             Number of output rows computed in parallel
+ * \tparam MMV            Number of pixels computed in parallel
+ * \tparam TSrcI          DataType of the input activation (as used in the MAC), e.g. Slice_mmv
+ * \tparam TDstI          DataType of the output activation (as generated by the activation), Slice_mmv
+ * \tparam ActVal         Initial value of activation at start of thresholding procedure
+ * \tparam TT             DataType of the thresholds stream
+ * \tparam NumSteps       Number of thresholds per activation
+ * \tparam TI             DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO             DataType of the output stream - safely deducible from the paramaters
+ *
+ * \param in              Input stream
+ * \param out             Output stream
+ * \param weight          Weight stream
+ * \param reps            Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template <
+    unsigned ImgDim, unsigned NumChannels, unsigned PE, unsigned MMV,
+    typename TSrcI = Identity, typename TDstI = Identity,
+    int ActVal=0, typename TT, unsigned int NumSteps,
+    typename TI, typename TO>
+void Thresholding_Stream_MMV_Batch(hls::stream<TI> &in,
+                        hls::stream<TO> &out,
+                        hls::stream<ap_uint<PE*NumSteps*TT::width>> &weight,
+                        int const reps)
+{
+  static_assert(ImgDim % MMV == 0, "MMV must divide ImgDim.");
+  unsigned const NF = NumChannels / PE;
+
+  ThresholdsActivation<1, PE, NumSteps, TT, ap_uint<TDstI::width>, ActVal, comp::less_equal<TT, TT>> internal_thr;
+#pragma HLS ARRAY_PARTITION variable=internal_thr.m_thresholds complete dim=0
+
+  for (unsigned i = 0; i < reps * (ImgDim / MMV) * NF; i++)
+  {
+#pragma HLS pipeline style=flp II=1
+
+    ap_uint<PE*NumSteps*TT::width> const  packed_thr = weight.read();
+    auto const pe_slicer = Slice<ap_uint<NumSteps*TT::width>>()(packed_thr);
+
+    TI const  inElem = in.read();
+    auto const act = TSrcI()(inElem);
+    auto outElem = TDstI().template operator()<TO>();
+
+    for (unsigned pe = 0; pe < PE; pe++)
+    {
+#pragma HLS UNROLL
+      auto const thr_slicer = Slice<TT>()(pe_slicer(pe, 0));
+      for (unsigned nt = 0; nt < NumSteps; nt++)
+      {
+#pragma HLS UNROLL
+        internal_thr.m_thresholds[pe][0][nt] = thr_slicer(nt, 0);
+      }
+      for (unsigned mmv = 0; mmv < MMV; mmv++)
+      {
+#pragma HLS UNROLL
+        outElem(pe,mmv,1) = internal_thr.activate(0, pe, act(pe,mmv));
+      }
+    }
+    out.write(outElem);
+  }
+}
+
+/*!
+ * \brief Affine channel-wise operation for multiple images, with parameters streamed per frame
+ *
+ * Applies the fused scale, bias and requantization of AffineChannelWiseOperation with parameters
+ * read from a stream at the start of every frame, so that models may be switched at runtime. The
+ * NumChannels/PE parameter words of a frame are read along with the channel folds of its first
+ * pixel and kept for the others, which takes no extra cycles. Every word holds PE channels, each of
+ * them its scale in the lower TS::width bits followed by its bias.
+ *
+ * \tparam ImgDim         Total spatial size of input feature map
+ * \tparam NumChannels    Number of channels in input feature map
+ * \tparam PE             Number of channels computed in parallel
+ * \tparam TSrcI          DataType of the input activation
+ * \tparam TDstI          DataType of the output activation
+ * \tparam TS             DataType of the scales
+ * \tparam TB             DataType of the biases, in the scale of the products
+ * \tparam Shift          Right shift of the requantization, with rounding
+ * \tparam Saturate       Whether the results are clipped to the range of the output type
+ * \tparam TI             DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO             DataType of the output stream - safely deducible from the paramaters
+ *
+ * \param in              Input stream
+ * \param out             Output stream
+ * \param params          Parameter stream, NumChannels/PE words per frame
+ * \param reps            Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template <
+    unsigned ImgDim, unsigned NumChannels, unsigned PE,
+    typename TSrcI, typename TDstI, typename TS, typename TB,
+    unsigned Shift = 0, bool Saturate = true,
+    typename TI, typename TO>
+void ChannelWise_Affine_Stream_Batch(hls::stream<TI> &in,
+                        hls::stream<TO> &out,
+                        hls::stream<ap_uint<PE*(TS::width+TB::width)>> &params,
+                        int const reps)
+{
+  static_assert(NumChannels % PE == 0, "PE must divide NumChannels.");
+  constexpr unsigned  NF = NumChannels / PE;
+  constexpr unsigned  PW = TS::width + TB::width;
+  using TA = decltype(TSrcI()(TI())(0,0));
+  using TR = decltype(TDstI().template operator()<TO>()(0,0));
+
+  AffineChannelWiseOperation<NF, PE, TA, TS, TB, TR, Shift, Saturate>  affine;
+#pragma HLS ARRAY_PARTITION variable=affine.m_scale complete dim=1
+#pragma HLS ARRAY_PARTITION variable=affine.m_bias complete dim=1
+
+  unsigned  nf = 0;
+  unsigned  pix = 0;
+  for (unsigned i = 0; i < reps * ImgDim * NF; i++)
+  {
+#pragma HLS pipeline style=flp II=1
+    if (pix == 0) {
+      ap_uint<PE*PW> const  word = params.read();
+      for (unsigned pe = 0; pe < PE; pe++)
+      {
+#pragma HLS UNROLL
+        ap_uint<PW> const  p = word((pe+1)*PW-1, pe*PW);
+        affine.m_scale[pe][nf] = TS(ap_uint<TS::width>(p(TS::width-1, 0)));
+        affine.m_bias[pe][nf]  = TB(ap_uint<TB::width>(p(PW-1, TS::width)));
+      }
+    }
+
+    TI const  inElem = in.read();
+    auto const act = TSrcI()(inElem);
+    auto outElem = TDstI().template operator()<TO>();
+    for (unsigned pe = 0; pe < PE; pe++)
+    {
+#pragma HLS UNROLL
+      outElem(pe,0,1) = affine.activate(nf, pe, act(pe,0));
+    }
+    out.write(outElem);
+
+    if (++nf == NF) {
+      nf = 0;
+      if (++pix == ImgDim) {
+        pix = 0;
+      }
+    }
+  }
+}
+
+/*!
+ * \brief Thresholding function for multiple images, with streaming compressed thresholds
+ *
+ * The function performs thresholds comparison with input activation vector,
+ * and generating output based on the comparison results. The thresholds of
+ * each channel are streamed in the compressed form of CompressedThresholdsActivation:
+ * the smallest threshold of type TT in the lowest bits, followed by the NumSteps-1
+ * differences of type TD between consecutive sorted thresholds.
+ *
+ * \tparam ImgDim         Total spatial size of input feature map
+ * \tparam NumChannels    Number of channels in input feature map
+ * \tparam PE             Number of output rows computed in parallel
+ * \tparam TSrcI          DataType of the input activation (as used in the MAC)
+ * \tparam TDstI          DataType of the output activation (as generated by the activation)
+ * \tparam ActVal         Initial value of activation at start of thresholding procedure
+ * \tparam TT             DataType of the base thresholds
+ * \tparam TD             DataType of the threshold differences
+ * \tparam NumSteps       Number of thresholds per activation
+ * \tparam TI             DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO             DataType of the output stream - safely deducible from the paramaters
+ *
+ * \param in              Input stream
+ * \param out             Output stream
+ * \param weight          Compressed threshold stream
+ * \param reps            Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template <
+    unsigned ImgDim, unsigned NumChannels, unsigned PE,
+    typename TSrcI = Identity, typename TDstI = Identity,
+    int ActVal=0, typename TT, typename TD, unsigned int NumSteps,
+    typename TI, typename TO>
+void Thresholding_Stream_Compressed_Batch(hls::stream<TI> &in,
+                        hls::stream<TO> &out,
+                        hls::stream<ap_uint<PE*(TT::width+(NumSteps-1)*TD::width)>> &weight,
+                        int const reps)
+{
+  constexpr unsigned  PE_WIDTH = TT::width + (NumSteps-1)*TD::width;
+
+  // how many different rows each neuron will compute
+  // alternatively: number of vertical matrix chunks
+  unsigned const NF = NumChannels / PE;
+
+  CompressedThresholdsActivation<1, PE, NumSteps, TT, TD, TO, ActVal, comp::less_equal<TT, TT>> internal_thr;
+#pragma HLS ARRAY_PARTITION variable=internal_thr.m_base complete dim=0
+#pragma HLS ARRAY_PARTITION variable=internal_thr.m_deltas complete dim=0
+
+  // everything merged into a common iteration space (one "big" loop instead
+  // of smaller nested loops) to get the pipelinening the way we want
+  for (unsigned i = 0; i < reps * ImgDim * NF; i++)
+  {
+#pragma HLS pipeline style=flp II=1
+
+    ap_uint<PE*PE_WIDTH> packed_thr;
+    packed_thr = weight.read();
+    // slicer to get 1 PE's worth of thresholds
+    auto const pe_slicer = Slice<ap_uint<PE_WIDTH>>()(packed_thr);
+
+    TI inElem;
+    inElem = in.read();
+    auto outElem = TDstI().template operator()<TO>();
+
+    for (unsigned pe = 0; pe < PE; pe++)
+    {
+#pragma HLS UNROLL
+      ap_uint<PE_WIDTH> const  pe_thr = pe_slicer(pe, 0);
+      internal_thr.m_base[pe][0] = TT(pe_thr(TT::width-1, 0));
+      for (unsigned nt = 0; nt < NumSteps-1; nt++)
+      {
+#pragma HLS UNROLL
+        internal_thr.m_deltas[pe][0][nt] = pe_thr(TT::width+(nt+1)*TD::width-1, TT::width+nt*TD::width);
+      }
+
+      auto const act = TSrcI()(inElem);
+      outElem(pe,0,1) = internal_thr.activate(0, pe, act(pe,0));
+    }
+    out.write(outElem);
+  }
+}
+
 #endif
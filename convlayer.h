@@ -54,8 +54,12 @@
 
 #include "streamtools.h"
 #include "slidingwindow.h"
+#include "maxpool.h"
 #include "mvau.hpp"
+#include "vvau.hpp"
 #include "tmrcheck.hpp"
+#include "winograd.hpp"
+#include "dma.h"
 
 /**
  * \brief 	Convolutional layer implementation
@@ -118,16 +122,263 @@ void ConvLayer_Batch(hls::stream<ap_uint<InStreamW>>  &in,
   hls::stream<ap_uint<SIMD*TSrcI::width> > convInp("StreamingConvLayer_Batch.convInp");
   hls::stream<ap_uint<PE*TDstI::width> > mvOut("StreamingConvLayer_Batch.mvOut");
   StreamingDataWidthConverter_Batch<InStreamW, SIMD*TSrcI::width, InpPerImage>(in, wa_in, reps);
+  FINN_STREAM_PROBE(wa_in);
   ConvolutionInputGenerator<ConvKernelDim, IFMChannels, TSrcI::width, IFMDim,
 			OFMDim, SIMD,1>(wa_in, convInp, reps, ap_resource_dflt());
+  FINN_STREAM_PROBE(convInp);
   Matrix_Vector_Activate_Batch<MatrixW, MatrixH, SIMD, PE, 1, TSrcI, TDstI, TWeightI>
     (static_cast<hls::stream<ap_uint<SIMD*TSrcI::width>>&>(convInp),
      static_cast<hls::stream<ap_uint<PE*TDstI::width>>&>  (mvOut),
      weights, activation, reps* OFMDim * OFMDim, r);
+  FINN_STREAM_PROBE(mvOut);
   StreamingDataWidthConverter_Batch<PE*TDstI::width, OutStreamW, OFMDim * OFMDim * (OFMChannels / PE)>(mvOut, out, reps);
 
 }
 
+/**
+ * \brief 	Grouped convolutional layer implementation
+ *
+ * The function implements a grouped convolution, in which the input and output channels are split into Groups
+ * groups and each output channel only sees the input channels of its group. ConvolutionInputGenerator_Grouped
+ * emits the windows group by group and Matrix_Vector_Activate_Grouped_Batch multiplies every group by its own
+ * weights, avoiding the block-diagonal zero weights of the equivalent dense convolution.
+ *
+ * \tparam ConvKernelDim 	Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels 		Number of Input Feature Maps
+ * \tparam IFMDim 			Width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels 		Number of Output Feature Maps
+ * \tparam OFMDim 			Width and Height of the Output Feature Map (assumed square)
+ * \tparam Groups 			Number of groups, dividing IFMChannels and OFMChannels
+ * \tparam SIMD 			Number of input columns computed in parallel, dividing IFMChannels/Groups
+ * \tparam PE 				Number of output rows computed in parallel, dividing OFMChannels/Groups
+ * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
+ * \tparam TDstI 			DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI 		DataType of the weights (as used in the MAC)
+ * \tparam InStreamW 		Width of the input stream
+ * \tparam OutStreamW 		Width of the output stream
+ * \tparam TW 				DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA 				DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param weights 			Weights of the groups, Groups * (OFMChannels/Groups/PE) * (ConvKernelDim^2*IFMChannels/Groups/SIMD) tiles
+ * \param activation 		Activation class
+ * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int ConvKernelDim,
+		unsigned int IFMChannels,
+		unsigned int IFMDim,
+		unsigned int OFMChannels,
+		unsigned int OFMDim,
+		unsigned int Groups,
+
+		unsigned int SIMD, 				// number of SIMD lanes
+		unsigned int PE,				// number of PEs
+
+		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
+		typename TWeightI = Identity,	// redefine I/O interpretation as needed for weigths
+
+		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+		typename TW,   typename TA,  typename R
+>
+void ConvLayer_Grouped_Batch(hls::stream<ap_uint<InStreamW>>  &in,
+			    hls::stream<ap_uint<OutStreamW>> &out,
+			    TW const        &weights,
+			    TA const        &activation,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  static_assert(OFMChannels % Groups == 0, "Groups must divide OFMChannels.");
+  unsigned const MatrixW = ConvKernelDim * ConvKernelDim * (IFMChannels / Groups);
+  unsigned const MatrixH = OFMChannels;
+  unsigned const InpPerImage = IFMDim * IFMDim * IFMChannels * TSrcI::width / InStreamW;
+  hls::stream<ap_uint<SIMD*TSrcI::width> > wa_in("StreamingConvLayer_Grouped_Batch.wa_in");
+  hls::stream<ap_uint<SIMD*TSrcI::width> > convInp("StreamingConvLayer_Grouped_Batch.convInp");
+  hls::stream<ap_uint<PE*TDstI::width> > mvOut("StreamingConvLayer_Grouped_Batch.mvOut");
+  StreamingDataWidthConverter_Batch<InStreamW, SIMD*TSrcI::width, InpPerImage>(in, wa_in, reps);
+  FINN_STREAM_PROBE(wa_in);
+  ConvolutionInputGenerator_Grouped<ConvKernelDim, IFMChannels, Groups, TSrcI::width, IFMDim,
+			OFMDim, SIMD,1>(wa_in, convInp, reps, ap_resource_dflt());
+  FINN_STREAM_PROBE(convInp);
+  Matrix_Vector_Activate_Grouped_Batch<MatrixW, MatrixH, Groups, SIMD, PE, 1, TSrcI, TDstI, TWeightI>
+    (static_cast<hls::stream<ap_uint<SIMD*TSrcI::width>>&>(convInp),
+     static_cast<hls::stream<ap_uint<PE*TDstI::width>>&>  (mvOut),
+     weights, activation, reps* OFMDim * OFMDim, r);
+  FINN_STREAM_PROBE(mvOut);
+  StreamingDataWidthConverter_Batch<PE*TDstI::width, OutStreamW, OFMDim * OFMDim * (OFMChannels / PE)>(mvOut, out, reps);
+}
+
+/**
+ * \brief 	Convolutional layer implementation with fused max pooling
+ *
+ * The function implements a convolutional layer like ConvLayer_Batch directly followed by a non-overlapping
+ * max pooling with PoolDim x PoolDim windows. The outputs of the Matrix_Vector_Activate_Batch are pooled
+ * at PE granularity by StreamingMaxPool_Precision_kernel_stride_Batch, which only buffers a single pooled
+ * row, so that the full-resolution feature map never leaves the layer and the output width converter only
+ * sees the pooled pixels. As the pooling follows the activation, the result equals pooling the accumulators
+ * before the activation whenever the activation is monotonically non-decreasing (e.g. thresholds).
+ * Output rows and columns not covered by a pooling window are dropped.
+ *
+ * \tparam ConvKernelDim 	Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels 		Number of Input Feature Maps
+ * \tparam IFMDim 			Width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels 		Number of Output Feature Maps
+ * \tparam OFMDim 			Width and Height of the convolution Output Feature Map before pooling (assumed square)
+ * \tparam PoolDim 			Dimension and stride of the max pooling window (assumed square)
+ * \tparam SIMD 			Number of input columns computed in parallel
+ * \tparam PE 				Number of output rows computed in parallel
+ * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
+ * \tparam TDstI 			DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI 		DataType of the weights (as used in the MAC)
+ * \tparam TPool 			DataType of the output activation as used in the max comparison
+ * \tparam InStreamW 		Width of the input stream
+ * \tparam OutStreamW 		Width of the output stream
+ * \tparam TW 				DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA 				DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param weights 			Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation 		Activation class
+ * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int ConvKernelDim,
+		unsigned int IFMChannels,
+		unsigned int IFMDim,
+		unsigned int OFMChannels,
+		unsigned int OFMDim,
+		unsigned int PoolDim,
+
+		unsigned int SIMD, 				// number of SIMD lanes
+		unsigned int PE,				// number of PEs
+
+		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
+		typename TWeightI = Identity,	// redefine I/O interpretation as needed for weigths
+		typename TPool = ap_uint<TDstI::width>,	// interpretation of the output activations in the max comparison
+
+		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+		typename TW,   typename TA,  typename R
+>
+void ConvLayer_Pool_Batch(hls::stream<ap_uint<InStreamW>>  &in,
+			    hls::stream<ap_uint<OutStreamW>> &out,
+			    TW const        &weights,
+			    TA const        &activation,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  static_assert(TPool::width == TDstI::width, "TPool must match the width of TDstI");
+  unsigned const MatrixW = ConvKernelDim * ConvKernelDim * IFMChannels;
+  unsigned const MatrixH = OFMChannels;
+  unsigned const InpPerImage = IFMDim * IFMDim * IFMChannels * TSrcI::width / InStreamW;
+  unsigned const PoolOFMDim = OFMDim / PoolDim;
+  hls::stream<ap_uint<SIMD*TSrcI::width> > wa_in("StreamingConvLayer_Pool_Batch.wa_in");
+  hls::stream<ap_uint<SIMD*TSrcI::width> > convInp("StreamingConvLayer_Pool_Batch.convInp");
+  hls::stream<ap_uint<PE*TDstI::width> > mvOut("StreamingConvLayer_Pool_Batch.mvOut");
+  hls::stream<ap_uint<PE*TDstI::width> > poolOut("StreamingConvLayer_Pool_Batch.poolOut");
+  StreamingDataWidthConverter_Batch<InStreamW, SIMD*TSrcI::width, InpPerImage>(in, wa_in, reps);
+  FINN_STREAM_PROBE(wa_in);
+  ConvolutionInputGenerator<ConvKernelDim, IFMChannels, TSrcI::width, IFMDim,
+			OFMDim, SIMD,1>(wa_in, convInp, reps, ap_resource_dflt());
+  FINN_STREAM_PROBE(convInp);
+  Matrix_Vector_Activate_Batch<MatrixW, MatrixH, SIMD, PE, 1, TSrcI, TDstI, TWeightI>
+    (static_cast<hls::stream<ap_uint<SIMD*TSrcI::width>>&>(convInp),
+     static_cast<hls::stream<ap_uint<PE*TDstI::width>>&>  (mvOut),
+     weights, activation, reps* OFMDim * OFMDim, r);
+  FINN_STREAM_PROBE(mvOut);
+  StreamingMaxPool_Precision_kernel_stride_Batch<OFMDim, OFMDim, PoolDim, PoolDim, PoolDim, PoolDim, OFMChannels, PE, TPool>
+    (mvOut, poolOut, reps);
+  FINN_STREAM_PROBE(poolOut);
+  StreamingDataWidthConverter_Batch<PE*TDstI::width, OutStreamW, PoolOFMDim * PoolOFMDim * (OFMChannels / PE)>(poolOut, out, reps);
+
+}
+
+/**
+ * \brief 	Convolutional layer implementation for feature map dimensions and strides given at runtime
+ *
+ * The function implements a convolutional layer like ConvLayer_Batch, but with the sliding window generator
+ * and the width converters sized for MaxIFMDim and MaxStride and the actual dimensions given at runtime
+ * (e.g. over AXI-lite), so that different input resolutions can be served by the same hardware.
+ *
+ * \tparam ConvKernelDim 	Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels 		Number of Input Feature Maps
+ * \tparam MaxIFMDim 		Maximum width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels 		Number of Output Feature Maps
+ * \tparam MaxStride 		Maximum stride of the convolutional kernel
+ * \tparam SIMD 			Number of input columns computed in parallel
+ * \tparam PE 				Number of output rows computed in parallel
+ * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
+ * \tparam TDstI 			DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI 		DataType of the weights (as used in the MAC)
+ * \tparam InStreamW 		Width of the input stream
+ * \tparam OutStreamW 		Width of the output stream
+ * \tparam TW 				DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA 				DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param weights 			Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation 		Activation class
+ * \param IFMDim 			Width and Height of the Input Feature Map, at most MaxIFMDim
+ * \param OFMDim 			Width and Height of the Output Feature Map, (IFMDim - ConvKernelDim) / Stride + 1
+ * \param Stride 			Stride of the convolutional kernel, at most MaxStride
+ * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int ConvKernelDim,
+		unsigned int IFMChannels,
+		unsigned int MaxIFMDim,
+		unsigned int OFMChannels,
+		unsigned int MaxStride,
+
+		unsigned int SIMD, 				// number of SIMD lanes
+		unsigned int PE,				// number of PEs
+
+		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
+		typename TWeightI = Identity,	// redefine I/O interpretation as needed for weigths
+
+		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+		typename TW,   typename TA,  typename R
+>
+void ConvLayer_Batch_Dynamic(hls::stream<ap_uint<InStreamW>>  &in,
+			    hls::stream<ap_uint<OutStreamW>> &out,
+			    TW const        &weights,
+			    TA const        &activation,
+			    unsigned const   IFMDim,
+			    unsigned const   OFMDim,
+			    unsigned const   Stride,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  unsigned const MatrixW = ConvKernelDim * ConvKernelDim * IFMChannels;
+  unsigned const MatrixH = OFMChannels;
+  unsigned const InpPerImage = IFMDim * IFMDim * IFMChannels * TSrcI::width / InStreamW;
+  hls::stream<ap_uint<SIMD*TSrcI::width> > wa_in("StreamingConvLayer_Batch_Dynamic.wa_in");
+  hls::stream<ap_uint<SIMD*TSrcI::width> > convInp("StreamingConvLayer_Batch_Dynamic.convInp");
+  hls::stream<ap_uint<PE*TDstI::width> > mvOut("StreamingConvLayer_Batch_Dynamic.mvOut");
+  StreamingDataWidthConverter_Dynamic_Batch<InStreamW, SIMD*TSrcI::width>(in, wa_in, InpPerImage, reps);
+  FINN_STREAM_PROBE(wa_in);
+  ConvolutionInputGenerator_Dynamic<ConvKernelDim, IFMChannels, TSrcI::width, MaxIFMDim,
+			SIMD, MaxStride>(wa_in, convInp, IFMDim, OFMDim, Stride, reps, ap_resource_dflt());
+  FINN_STREAM_PROBE(convInp);
+  Matrix_Vector_Activate_Batch<MatrixW, MatrixH, SIMD, PE, 1, TSrcI, TDstI, TWeightI>
+    (static_cast<hls::stream<ap_uint<SIMD*TSrcI::width>>&>(convInp),
+     static_cast<hls::stream<ap_uint<PE*TDstI::width>>&>  (mvOut),
+     weights, activation, reps * OFMDim * OFMDim, r);
+  FINN_STREAM_PROBE(mvOut);
+  StreamingDataWidthConverter_Dynamic_Batch<PE*TDstI::width, OutStreamW>(mvOut, out, OFMDim * OFMDim * (OFMChannels / PE), reps);
+}
+
 /**
  * \brief   Convolutional layer implementation with STMR
  *
@@ -224,56 +475,184 @@ void ConvLayer_Batch_TMR(hls::stream<ap_uint<InStreamW>>  &in,
 }
 
 /**
- * \brief 	Convolutional layer implementation
- *
- * The function implements a generic convolutional layer, and it's basically composed of the sliding window generator
- * implemeting the im2col algorithm and the Matrix_Vector_Activate_Batch function to perform computation.
- *
- * \tparam ConvKernelDim 	Dimension of the convolutional kernel (assumed square)
- * \tparam IFMChannels 		Number of Input Feature Maps
- * \tparam IFMDim 			Width and Height of the Input Feature Map (assumed square)
- * \tparam OFMChannels 		Number of Output Feature Maps
- * \tparam OFMDim 			Width and Height of the Output Feature Map (assumed square)
- * \tparam STRIDE 			Stride of the convolutional kernel
+ * \brief   Convolutional layer implementation with STMR and per-triplet fault counters
  *
- * \tparam SIMD 			Number of input columns computed in parallel
- * \tparam PE 				Number of output rows computed in parallel
- * \tparam MMV 				Number of output pixels computed in parallel
+ * Works as the ConvLayer_Batch_TMR above, but checks the MVAU output in its PE folding with TMRCheck_Folded_Batch,
+ * which also keeps a saturating fault counter per triplet. Every triplet must be contained in a single group of
+ * PE output channels.
  *
- * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
- * \tparam TDstI 			DataType of the output activation (as generated by the activation)
- * \tparam TWeightI 		DataType of the weights (as used in the MAC)
- * \tparam InStreamW 		Width of the input stream
- * \tparam OutStreamW 		Width of the output stream
- * \tparam TW 				DataType of the weights matrix - safely deducible from the paramaters
- * \tparam TA 				DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
- * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ * \tparam ConvKernelDim    Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels      Number of Input Feature Maps
+ * \tparam IFMDim           Width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels      Number of Output Feature Maps
+ * \tparam OFMDim           Width and Height of the Output Feature Map (assumed square)
+ * \tparam SIMD             Number of input columns computed in parallel
+ * \tparam PE               Number of output rows computed in parallel
+ * \tparam NUM_RED          Number of redundancies (or triplicated channels)
+ * \tparam REDF             Redundancy factor (3 to triplicate)
+ * \tparam MAX_CH_WIDTH     Value to determine the precision of channel indexes
+ * \tparam TSrcI            DataType of the input activation (as used in the MAC)
+ * \tparam TDstI            DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI         DataType of the weights (as used in the MAC)
+ * \tparam InStreamW        Width of the input stream
+ * \tparam OutStreamW       Width of the output stream
+ * \tparam CntW             Width of the fault counters - safely deducible from the paramaters
+ * \tparam TW               DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA               DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R                DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
  *
- * \param in 				Input stream
- * \param out 				Output stream
- * \param weights 			Weights matrix (currently supports BinaryWeights or FixedPointWeights)
- * \param activation 		Activation class
- * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
- * \param r 				Resource type for the hardware implementation of the MAC block
+ * \param in                Input stream
+ * \param out               Output stream
+ * \param weights           Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation        Activation class
+ * \param reps              Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r                 Resource type for the hardware implementation of the MAC block
+ * \param errortype         Flag to inform redundancy check results. 0 if no faults, 1 if one PE is faulty, 2 if all differ
+ * \param channel_mask      Value with binary channel masks (1 if channel is triplicated, 0 otherwise)
+ * \param red_ch_index      Array of redundant triplets' indexes. Each position stores the first triplicated channel index of a triplet
+ * \param errcount          Saturating fault counters, one per triplet
  */
+
 template<
-		unsigned int ConvKernelDim,
-		unsigned int IFMChannels,
-		unsigned int IFMDim,
-		unsigned int OFMChannels,
-		unsigned int OFMDim,
-		unsigned int STRIDE,
+        unsigned int ConvKernelDim,
+        unsigned int IFMChannels,
+        unsigned int IFMDim,
+        unsigned int OFMChannels,
+        unsigned int OFMDim,
 
-		unsigned int SIMD,				// number of SIMD lanes
-		unsigned int PE,				// number of PEs
-		unsigned int MMV,
+        unsigned int SIMD,              // number of SIMD lanes
+        unsigned int PE,                // number of PEs
 
-		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
-		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
-		typename TWeightI = Identity,	// redefine I/O interpretation as needed for weigths
+        unsigned int NUM_RED,           // number of redundant channels
+        unsigned int REDF,              // redundancy factor (3 to triplicate)
+        unsigned int MAX_CH_WIDTH,      // width to represent channel indexes
 
-		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
-		typename TW,   typename TA,  typename R
+        typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+        typename TDstI = Identity,      // redefine I/O interpretation as needed for output activations
+        typename TWeightI = Identity,   // redefine I/O interpretation as needed for weigths
+
+        int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+        int CntW,
+        typename TW,   typename TA,  typename R
+>
+void ConvLayer_Batch_TMR(hls::stream<ap_uint<InStreamW>>  &in,
+                         hls::stream<ap_uint<OutStreamW>> &out,
+                         TW const        &weights,
+                         TA const        &activation,
+                         unsigned const   reps,
+                         R const &r,
+                         ap_uint<2> &errortype,
+                         ap_uint<OFMChannels> channel_mask,
+                         ap_uint<MAX_CH_WIDTH> red_cha_index[NUM_RED],
+                         ap_uint<CntW> errcount[NUM_RED]) {
+#pragma HLS INLINE
+  unsigned const MatrixW = ConvKernelDim * ConvKernelDim * IFMChannels;
+  unsigned const MatrixH = OFMChannels;
+  unsigned const InpPerImage = IFMDim*IFMDim;
+
+  hls::stream<ap_uint<SIMD*TSrcI::width> > wa_in("StreamingConvLayer_Batch.wa_in");
+  hls::stream<ap_uint<SIMD*TSrcI::width> > convInp("StreamingConvLayer_Batch.convInp");
+  hls::stream<ap_uint<PE*TDstI::width> > mvOut("StreamingConvLayer_Batch.mvOut");
+
+  StreamingDataWidthConverter_Batch<InStreamW, SIMD*TSrcI::width, InpPerImage>(in, wa_in, reps);
+
+  //Sliding window unit
+  ConvolutionInputGenerator<ConvKernelDim, IFMChannels, TSrcI::width, IFMDim,
+            OFMDim, SIMD,1>(wa_in, convInp, reps, ap_resource_dflt());
+
+  //MVTU
+  Matrix_Vector_Activate_Batch<MatrixW, MatrixH, SIMD, PE, 1, TSrcI, TDstI, TWeightI>
+    (static_cast<hls::stream<ap_uint<SIMD*TSrcI::width>>&>(convInp),
+     static_cast<hls::stream<ap_uint<PE*TDstI::width>>&>  (mvOut),
+     weights, activation, reps* OFMDim * OFMDim, r);
+
+  //Error check in the MVTU folding
+  TMRCheck_Folded_Batch<TDstI::width, OFMChannels, PE, NUM_RED, REDF, OFMDim, MAX_CH_WIDTH>(mvOut, out, errortype, channel_mask, red_cha_index, errcount, reps);
+}
+
+namespace detail {
+
+  // Output of the MMV pixels of a convolution in pixel-major order by a single serializer stage
+  template<unsigned PEWidth, unsigned ChanWidth, unsigned NF, unsigned MMV, unsigned GroupsPerImage, int OutStreamW>
+  void conv_mmv_output(hls::stream<MultiChanData<MMV, PEWidth> > &in,
+                       hls::stream<ap_uint<OutStreamW> > &out,
+                       unsigned const  reps,
+                       std::true_type) {
+#pragma HLS INLINE
+    MultiChanDataSerialize_Batch<PEWidth, OutStreamW, NF, MMV>(in, out, GroupsPerImage * reps);
+  }
+
+  // Output by the width converter chain for widths the serializer does not support
+  template<unsigned PEWidth, unsigned ChanWidth, unsigned NF, unsigned MMV, unsigned GroupsPerImage, int OutStreamW>
+  void conv_mmv_output(hls::stream<MultiChanData<MMV, PEWidth> > &in,
+                       hls::stream<ap_uint<OutStreamW> > &out,
+                       unsigned const  reps,
+                       std::false_type) {
+#pragma HLS INLINE
+    hls::stream<MultiChanData<MMV, ChanWidth>> dwc2flat("dwc2flat");
+    hls::stream<ap_uint<MMV * ChanWidth> > mvOut("StreamingConvLayerMMV_Batch.mvOut");
+    MultiChanDataWidthConverter_Batch<PEWidth, ChanWidth, GroupsPerImage * NF, MMV>(in, dwc2flat, reps);
+    FINN_STREAM_PROBE(dwc2flat);
+    FlattenMultiChanData<MMV, ChanWidth>(dwc2flat, mvOut, GroupsPerImage * reps);
+    FINN_STREAM_PROBE(mvOut);
+    StreamingDataWidthConverter_Batch<MMV * ChanWidth, OutStreamW, GroupsPerImage>(mvOut, out, reps);
+  }
+
+} // namespace detail
+
+/**
+ * \brief 	Convolutional layer implementation
+ *
+ * The function implements a generic convolutional layer, and it's basically composed of the sliding window generator
+ * implemeting the im2col algorithm and the Matrix_Vector_Activate_Batch function to perform computation.
+ * The MMV output pixels are reordered into the output stream by the single MultiChanDataSerialize_Batch stage
+ * wherever the widths allow (see mmv_serializable), by a chain of width converters otherwise.
+ *
+ * \tparam ConvKernelDim 	Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels 		Number of Input Feature Maps
+ * \tparam IFMDim 			Width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels 		Number of Output Feature Maps
+ * \tparam OFMDim 			Width and Height of the Output Feature Map (assumed square)
+ * \tparam STRIDE 			Stride of the convolutional kernel
+ *
+ * \tparam SIMD 			Number of input columns computed in parallel
+ * \tparam PE 				Number of output rows computed in parallel
+ * \tparam MMV 				Number of output pixels computed in parallel
+ *
+ * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
+ * \tparam TDstI 			DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI 		DataType of the weights (as used in the MAC)
+ * \tparam InStreamW 		Width of the input stream
+ * \tparam OutStreamW 		Width of the output stream
+ * \tparam TW 				DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA 				DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param weights 			Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation 		Activation class
+ * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int ConvKernelDim,
+		unsigned int IFMChannels,
+		unsigned int IFMDim,
+		unsigned int OFMChannels,
+		unsigned int OFMDim,
+		unsigned int STRIDE,
+
+		unsigned int SIMD,				// number of SIMD lanes
+		unsigned int PE,				// number of PEs
+		unsigned int MMV,
+
+		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
+		typename TWeightI = Identity,	// redefine I/O interpretation as needed for weigths
+
+		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+		typename TW,   typename TA,  typename R
 >
 void ConvLayer_Batch_MMV(hls::stream<ap_uint<InStreamW>>  &in,
 			    hls::stream<ap_uint<OutStreamW>> &out,
@@ -290,22 +669,1276 @@ void ConvLayer_Batch_MMV(hls::stream<ap_uint<InStreamW>>  &in,
   hls::stream<ap_uint<SIMD * TSrcI::width> > wa_in("StreamingConvLayerMMV_Batch.wa_in");
   hls::stream<MultiChanData<MMV, SIMD *TSrcI::width> > convInp("StreamingConvLayerMMV_Batch.convInp");
   hls::stream<MultiChanData<MMV, PE * TDstI::width> > mmv2dwc("StreamingConvLayerMMV_Batch.mmv2dwc");
-  hls::stream<MultiChanData<MMV, OFMChannels * TDstI::width>> dwc2flat("dwc2flat");
-  hls::stream<ap_uint<MMV * OFMChannels * TDstI::width> > mvOut("StreamingConvLayerMMV_Batch.mvOut");
 
   StreamingDataWidthConverter_Batch<InStreamW, SIMD * TSrcI::width, InpPerImage>(in, wa_in, reps);
+  FINN_STREAM_PROBE(wa_in);
 
   ConvolutionInputGenerator_MMV<ConvKernelDim, IFMChannels, TSrcI::width, IFMDim,
 			OFMDim, SIMD, STRIDE, MMV>(wa_in, convInp, reps, ap_resource_dflt());
+  FINN_STREAM_PROBE(convInp);
   Matrix_Vector_Activate_Batch<MatrixW, MatrixH, SIMD, PE, MMV, TSrcI, TDstI, TWeightI>
     (static_cast<hls::stream<MultiChanData<MMV,SIMD*TSrcI::width>>&>(convInp),
      static_cast<hls::stream<MultiChanData<MMV,PE*TDstI::width>>&>(mmv2dwc),
      weights, activation, mmvReps, r);
+  FINN_STREAM_PROBE(mmv2dwc);
   
-  MultiChanDataWidthConverter_Batch<PE * TDstI::width, OFMChannels * TDstI::width, OFMDim * OFMDim * (OFMChannels / PE), MMV>(mmv2dwc, dwc2flat, reps);
-  FlattenMultiChanData<MMV, OFMChannels * TDstI::width>(dwc2flat, mvOut, mmvReps);
-  StreamingDataWidthConverter_Batch<MMV * OFMChannels * TDstI::width, OutStreamW, OFMDim * OFMDim / MMV>(mvOut, out, reps);
+  detail::conv_mmv_output<PE * TDstI::width, OFMChannels * TDstI::width, OFMChannels / PE, MMV, OFMDim * OFMDim / MMV>
+    (mmv2dwc, out, reps,
+     std::integral_constant<bool, mmv_serializable<PE * TDstI::width, OutStreamW, OFMChannels / PE>::value>());
   
 }
 
+namespace detail {
+
+  /**
+   * Width conversion of a pixel stream into SIMD words with the pixels of a strided 1x1 convolution kept,
+   * those in every Stride-th row and column from the first, in a single loop.
+   */
+  template<unsigned InWidth, unsigned OutWidth, unsigned IFMChannels, unsigned IFMDim, unsigned Stride, unsigned ChanWidth>
+  void pointwise_input(hls::stream<ap_uint<InWidth> > &in,
+                       hls::stream<ap_uint<OutWidth> > &out,
+                       unsigned const  reps) {
+    static_assert((InWidth % OutWidth == 0) || (OutWidth % InWidth == 0), "Widths must be multiples of each other.");
+    constexpr unsigned  CF = IFMChannels * ChanWidth / OutWidth;	// SIMD words per pixel
+    constexpr bool  DOWN = InWidth >= OutWidth;
+    constexpr unsigned  RATIO = DOWN? InWidth / OutWidth : OutWidth / InWidth;
+    constexpr unsigned  ITERS = IFMDim * IFMDim * CF * (DOWN? 1 : RATIO);
+
+    ap_uint<InWidth>  ei = 0;
+    ap_uint<OutWidth>  eo = 0;
+    unsigned  sub = 0;
+    unsigned  cf = 0, x = 0, y = 0, sx = 0, sy = 0;
+    for(unsigned  i = 0; i < reps * ITERS; i++) {
+#pragma HLS pipeline style=flp II=1
+      bool  complete;
+      if(DOWN) {
+        if(sub == 0)  ei = in.read();
+        eo = ei(OutWidth-1, 0);
+        ei = ei >> (DOWN? OutWidth : 0);
+        complete = true;
+      }
+      else {
+        eo = eo >> (DOWN? 0 : InWidth);
+        eo(OutWidth-1, OutWidth-InWidth) = in.read();
+        complete = sub == RATIO-1;
+      }
+      if(++sub == RATIO)  sub = 0;
+
+      if(complete) {
+        if((sx == 0) && (sy == 0))  out.write(eo);
+        // advance to the next SIMD word of the pixel stream
+        if(++cf == CF) {
+          cf = 0;
+          if(++sx == Stride)  sx = 0;
+          if(++x == IFMDim) {
+            x = 0;
+            sx = 0;
+            if(++sy == Stride)  sy = 0;
+            if(++y == IFMDim) {
+              y = 0;
+              sy = 0;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Unit stride: plain width conversion
+  template<unsigned InWidth, unsigned OutWidth, unsigned IFMChannels, unsigned IFMDim, unsigned Stride, unsigned ChanWidth>
+  void pointwise_input(hls::stream<ap_uint<InWidth> > &in,
+                       hls::stream<ap_uint<OutWidth> > &out,
+                       unsigned const  reps,
+                       std::true_type) {
+#pragma HLS INLINE
+    StreamingDataWidthConverter_Batch<InWidth, OutWidth, IFMDim * IFMDim * IFMChannels * ChanWidth / InWidth>(in, out, reps);
+  }
+  template<unsigned InWidth, unsigned OutWidth, unsigned IFMChannels, unsigned IFMDim, unsigned Stride, unsigned ChanWidth>
+  void pointwise_input(hls::stream<ap_uint<InWidth> > &in,
+                       hls::stream<ap_uint<OutWidth> > &out,
+                       unsigned const  reps,
+                       std::false_type) {
+#pragma HLS INLINE
+    pointwise_input<InWidth, OutWidth, IFMChannels, IFMDim, Stride, ChanWidth>(in, out, reps);
+  }
+
+  /**
+   * Gathers the SIMD words of MMV consecutive pixels into one MultiChanData per SIMD fold, reading a
+   * group while the previous one is emitted from the other bank.
+   */
+  template<unsigned Width, unsigned CF, unsigned MMV, unsigned GroupsPerImage>
+  void pointwise_mmv_gather(hls::stream<ap_uint<Width> > &in,
+                            hls::stream<MultiChanData<MMV, Width> > &out,
+                            unsigned const  reps) {
+    ap_uint<Width>  buf[2][MMV][CF];
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=2
+    unsigned const  groups = reps * GroupsPerImage;
+    unsigned  bank = 0, m = 0, cf = 0;
+    // one more group of iterations to drain the last one
+    for(unsigned  i = 0; i < (groups + 1) * MMV * CF; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=buf inter false
+      unsigned const  g = i / (MMV * CF);
+      unsigned const  j = i % (MMV * CF);
+      if((g > 0) && (j < CF)) {
+        MultiChanData<MMV, Width>  o;
+        for(unsigned  v = 0; v < MMV; v++) {
+#pragma HLS UNROLL
+          o.data[v] = buf[bank ^ 1][v][j];
+        }
+        out.write(o);
+      }
+      if(g < groups) {
+        buf[bank][m][cf] = in.read();
+      }
+      if(++cf == CF) {
+        cf = 0;
+        if(++m == MMV) {
+          m = 0;
+          bank ^= 1;
+        }
+      }
+    }
+  }
+
+} // namespace detail
+
+/**
+ * \brief 	Pointwise (1x1) convolutional layer implementation
+ *
+ * A 1x1 convolution is a Matrix_Vector_Activate_Batch over the pixel stream, so the layer feeds the MVAU
+ * directly from the width converter of the input and needs no sliding window generator. With a Stride
+ * above one, the pixels not in every Stride-th row and column are dropped by a counter in that width
+ * converter, which yields the output of ConvolutionInputGenerator_2D_kernel1.
+ *
+ * \tparam IFMChannels 		Number of Input Feature Maps
+ * \tparam IFMDim 			Width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels 		Number of Output Feature Maps
+ * \tparam Stride 			Stride of the convolution, the Output Feature Map is (IFMDim-1)/Stride+1 pixels wide
+ * \tparam SIMD 			Number of input columns computed in parallel
+ * \tparam PE 				Number of output rows computed in parallel
+ * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
+ * \tparam TDstI 			DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI 		DataType of the weights (as used in the MAC)
+ * \tparam InStreamW 		Width of the input stream
+ * \tparam OutStreamW 		Width of the output stream
+ * \tparam TW 				DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA 				DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param weights 			Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation 		Activation class
+ * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int IFMChannels,
+		unsigned int IFMDim,
+		unsigned int OFMChannels,
+		unsigned int Stride,
+
+		unsigned int SIMD,				// number of SIMD lanes
+		unsigned int PE,				// number of PEs
+
+		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
+		typename TWeightI = Identity,	// redefine I/O interpretation as needed for weigths
+
+		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+		typename TW,   typename TA,  typename R
+>
+void PointwiseConvLayer_Batch(hls::stream<ap_uint<InStreamW>>  &in,
+			    hls::stream<ap_uint<OutStreamW>> &out,
+			    TW const        &weights,
+			    TA const        &activation,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+  static_assert(Stride > 0, "Stride must be positive.");
+  constexpr unsigned int OFMDim = (IFMDim - 1) / Stride + 1;
+  hls::stream<ap_uint<SIMD*TSrcI::width> > convInp("PointwiseConvLayer_Batch.convInp");
+  hls::stream<ap_uint<PE*TDstI::width> > mvOut("PointwiseConvLayer_Batch.mvOut");
+  detail::pointwise_input<InStreamW, SIMD*TSrcI::width, IFMChannels, IFMDim, Stride, TSrcI::width>
+    (in, convInp, reps, std::integral_constant<bool, Stride == 1>());
+  FINN_STREAM_PROBE(convInp);
+  Matrix_Vector_Activate_Batch<IFMChannels, OFMChannels, SIMD, PE, 1, TSrcI, TDstI, TWeightI>
+    (static_cast<hls::stream<ap_uint<SIMD*TSrcI::width>>&>(convInp),
+     static_cast<hls::stream<ap_uint<PE*TDstI::width>>&>  (mvOut),
+     weights, activation, reps * OFMDim * OFMDim, r);
+  FINN_STREAM_PROBE(mvOut);
+  StreamingDataWidthConverter_Batch<PE*TDstI::width, OutStreamW, OFMDim * OFMDim * (OFMChannels / PE)>(mvOut, out, reps);
+}
+
+/**
+ * \brief 	Pointwise (1x1) convolutional layer implementation with MMV
+ *
+ * Like PointwiseConvLayer_Batch, but the MVAU computes MMV consecutive output pixels in parallel. Their SIMD
+ * words are gathered from the pixel stream into one MultiChanData per SIMD fold by a small double buffer of
+ * 2*MMV pixels in place of ConvolutionInputGenerator_MMV, and the output is reordered as in ConvLayer_Batch_MMV.
+ * The input and output are interpreted by Slice_mmv as for ConvLayer_Batch_MMV.
+ *
+ * \tparam IFMChannels 		Number of Input Feature Maps
+ * \tparam IFMDim 			Width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels 		Number of Output Feature Maps
+ * \tparam Stride 			Stride of the convolution, the Output Feature Map is (IFMDim-1)/Stride+1 pixels wide
+ * \tparam SIMD 			Number of input columns computed in parallel
+ * \tparam PE 				Number of output rows computed in parallel
+ * \tparam MMV 				Number of output pixels computed in parallel, dividing the pixels of an output image
+ * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
+ * \tparam TDstI 			DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI 		DataType of the weights (as used in the MAC)
+ * \tparam InStreamW 		Width of the input stream
+ * \tparam OutStreamW 		Width of the output stream
+ * \tparam TW 				DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA 				DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param weights 			Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation 		Activation class
+ * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int IFMChannels,
+		unsigned int IFMDim,
+		unsigned int OFMChannels,
+		unsigned int Stride,
+
+		unsigned int SIMD,				// number of SIMD lanes
+		unsigned int PE,				// number of PEs
+		unsigned int MMV,
+
+		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
+		typename TWeightI = Identity,	// redefine I/O interpretation as needed for weigths
+
+		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+		typename TW,   typename TA,  typename R
+>
+void PointwiseConvLayer_Batch_MMV(hls::stream<ap_uint<InStreamW>>  &in,
+			    hls::stream<ap_uint<OutStreamW>> &out,
+			    TW const        &weights,
+			    TA const        &activation,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+  static_assert(Stride > 0, "Stride must be positive.");
+  constexpr unsigned int OFMDim = (IFMDim - 1) / Stride + 1;
+  static_assert((OFMDim * OFMDim) % MMV == 0, "MMV must divide the pixels of an output image.");
+  constexpr unsigned int GroupsPerImage = OFMDim * OFMDim / MMV;
+  hls::stream<ap_uint<SIMD*TSrcI::width> > wa_in("PointwiseConvLayer_Batch_MMV.wa_in");
+  hls::stream<MultiChanData<MMV, SIMD*TSrcI::width> > convInp("PointwiseConvLayer_Batch_MMV.convInp");
+  hls::stream<MultiChanData<MMV, PE*TDstI::width> > mmv2dwc("PointwiseConvLayer_Batch_MMV.mmv2dwc");
+  detail::pointwise_input<InStreamW, SIMD*TSrcI::width, IFMChannels, IFMDim, Stride, TSrcI::width>
+    (in, wa_in, reps, std::integral_constant<bool, Stride == 1>());
+  FINN_STREAM_PROBE(wa_in);
+  detail::pointwise_mmv_gather<SIMD*TSrcI::width, IFMChannels / SIMD, MMV, GroupsPerImage>(wa_in, convInp, reps);
+  FINN_STREAM_PROBE(convInp);
+  Matrix_Vector_Activate_Batch<IFMChannels, OFMChannels, SIMD, PE, MMV, TSrcI, TDstI, TWeightI>
+    (static_cast<hls::stream<MultiChanData<MMV,SIMD*TSrcI::width>>&>(convInp),
+     static_cast<hls::stream<MultiChanData<MMV,PE*TDstI::width>>&>(mmv2dwc),
+     weights, activation, reps * GroupsPerImage, r);
+  FINN_STREAM_PROBE(mmv2dwc);
+  detail::conv_mmv_output<PE * TDstI::width, OFMChannels * TDstI::width, OFMChannels / PE, MMV, GroupsPerImage>
+    (mmv2dwc, out, reps,
+     std::integral_constant<bool, mmv_serializable<PE * TDstI::width, OutStreamW, OFMChannels / PE>::value>());
+}
+
+/**
+ * \brief 	Convolutional layer implementation with MMV and STMR
+ *
+ * Works as ConvLayer_Batch_MMV, with a TMR checker performing the error checks on all MMV pixel lanes in
+ * parallel and outputting valid data, as in ConvLayer_Batch_TMR.
+ *
+ * \tparam ConvKernelDim 	Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels 		Number of Input Feature Maps
+ * \tparam IFMDim 			Width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels 		Number of Output Feature Maps, including triplications
+ * \tparam OFMDim 			Width and Height of the Output Feature Map (assumed square)
+ * \tparam STRIDE 			Stride of the convolutional kernel
+ *
+ * \tparam SIMD 			Number of input columns computed in parallel
+ * \tparam PE 				Number of output rows computed in parallel
+ * \tparam MMV 				Number of output pixels computed in parallel
+ *
+ * \tparam NUM_RED 			Number of redundancies (or triplicated channels)
+ * \tparam REDF 			Redundancy factor (3 to triplicate)
+ * \tparam MAX_CH_WIDTH 	Value to determine the precision of channel indexes
+ *
+ * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
+ * \tparam TDstI 			DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI 		DataType of the weights (as used in the MAC)
+ * \tparam InStreamW 		Width of the input stream
+ * \tparam OutStreamW 		Width of the output stream
+ * \tparam TW 				DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA 				DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param weights 			Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation 		Activation class
+ * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ * \param errortype 		Flag to inform redundancy check results. 0 if no faults, 1 if one PE is faulty, 2 if all differ
+ * \param channel_mask 		Value with binary channel masks (1 if channel is triplicated, 0 otherwise)
+ * \param red_ch_index 		Array of redundant triplets' indexes. Each position stores the first triplicated channel index of a triplet
+ */
+template<
+		unsigned int ConvKernelDim,
+		unsigned int IFMChannels,
+		unsigned int IFMDim,
+		unsigned int OFMChannels,
+		unsigned int OFMDim,
+		unsigned int STRIDE,
+
+		unsigned int SIMD,				// number of SIMD lanes
+		unsigned int PE,				// number of PEs
+		unsigned int MMV,
+
+		unsigned int NUM_RED,			// number of redundant channels
+		unsigned int REDF,				// redundancy factor (3 to triplicate)
+		unsigned int MAX_CH_WIDTH,		// width to represent channel indexes
+
+		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
+		typename TWeightI = Identity,	// redefine I/O interpretation as needed for weigths
+
+		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+		typename TW,   typename TA,  typename R
+>
+void ConvLayer_Batch_MMV_TMR(hls::stream<ap_uint<InStreamW>>  &in,
+			    hls::stream<ap_uint<OutStreamW>> &out,
+			    TW const        &weights,
+			    TA const        &activation,
+			    unsigned const   reps,
+				R const &r,
+				ap_uint<2> &errortype,
+				ap_uint<OFMChannels> channel_mask,
+				ap_uint<MAX_CH_WIDTH> red_ch_index[NUM_RED]) {
+#pragma HLS INLINE
+  unsigned const MatrixW = ConvKernelDim * ConvKernelDim * IFMChannels;
+  unsigned const MatrixH = OFMChannels;
+  unsigned const InpPerImage = IFMDim*IFMDim*IFMChannels * TSrcI::width/InStreamW;
+  const unsigned int mmvReps = (reps * OFMDim * OFMDim) / MMV;
+  constexpr unsigned int OFMChannelsTMR = OFMChannels - NUM_RED*(REDF-1);
+
+  hls::stream<ap_uint<SIMD * TSrcI::width> > wa_in("StreamingConvLayerMMV_TMR_Batch.wa_in");
+  hls::stream<MultiChanData<MMV, SIMD *TSrcI::width> > convInp("StreamingConvLayerMMV_TMR_Batch.convInp");
+  hls::stream<MultiChanData<MMV, PE * TDstI::width> > mmv2dwc("StreamingConvLayerMMV_TMR_Batch.mmv2dwc");
+  hls::stream<MultiChanData<MMV, OFMChannels * TDstI::width>> dwc2tmr("StreamingConvLayerMMV_TMR_Batch.dwc2tmr");
+  hls::stream<MultiChanData<MMV, OFMChannelsTMR * TDstI::width>> tmr2flat("StreamingConvLayerMMV_TMR_Batch.tmr2flat");
+  hls::stream<ap_uint<MMV * OFMChannelsTMR * TDstI::width> > mvOut("StreamingConvLayerMMV_TMR_Batch.mvOut");
+
+  StreamingDataWidthConverter_Batch<InStreamW, SIMD * TSrcI::width, InpPerImage>(in, wa_in, reps);
+  FINN_STREAM_PROBE(wa_in);
+
+  ConvolutionInputGenerator_MMV<ConvKernelDim, IFMChannels, TSrcI::width, IFMDim,
+			OFMDim, SIMD, STRIDE, MMV>(wa_in, convInp, reps, ap_resource_dflt());
+  FINN_STREAM_PROBE(convInp);
+  Matrix_Vector_Activate_Batch<MatrixW, MatrixH, SIMD, PE, MMV, TSrcI, TDstI, TWeightI>
+    (static_cast<hls::stream<MultiChanData<MMV,SIMD*TSrcI::width>>&>(convInp),
+     static_cast<hls::stream<MultiChanData<MMV,PE*TDstI::width>>&>(mmv2dwc),
+     weights, activation, mmvReps, r);
+  FINN_STREAM_PROBE(mmv2dwc);
+
+  MultiChanDataWidthConverter_Batch<PE * TDstI::width, OFMChannels * TDstI::width, OFMDim * OFMDim / MMV * (OFMChannels / PE), MMV>(mmv2dwc, dwc2tmr, reps);
+  FINN_STREAM_PROBE(dwc2tmr);
+  //Error check on all pixel lanes
+  TMRCheck_MMV_Batch<TDstI::width, OFMChannels, NUM_RED, REDF, OFMDim, MAX_CH_WIDTH, MMV>(dwc2tmr, tmr2flat, errortype, channel_mask, red_ch_index, reps);
+  FINN_STREAM_PROBE(tmr2flat);
+  FlattenMultiChanData<MMV, OFMChannelsTMR * TDstI::width>(tmr2flat, mvOut, mmvReps);
+  FINN_STREAM_PROBE(mvOut);
+  StreamingDataWidthConverter_Batch<MMV * OFMChannelsTMR * TDstI::width, OutStreamW, OFMDim * OFMDim / MMV>(mvOut, out, reps);
+}
+
+/**
+ * \brief 	Winograd convolutional layer implementation
+ *
+ * The function implements a 3x3, stride 1 convolutional layer using the Winograd F(2x2,3x3) algorithm,
+ * computing each 2x2 output tile with 16 multiplications per channel pair instead of 36. The sliding
+ * window generator extracts overlapping 4x4 input tiles, which are transformed, multiplied element-wise
+ * with the transformed weights, transformed back and finally reordered into raster order. No padding
+ * is applied, i.e. OFMDim = IFMDim - 2, which must be even. Use FMPadding_Batch upstream for same padding.
+ *
+ * The weights must be supplied as FixedPointWeights<SIMD, TW, PE, 16*(OFMChannels/PE)*(IFMChannels/SIMD)>
+ * holding U' = G' g G'^T with G' = [[2,0,0],[1,1,1],[1,-1,1],[0,0,2]], i.e. four times the usual
+ * transformed weights so that all values are integers. Tile (e*NF + nf)*SF + sf holds element e of
+ * the transformed kernels of neuron fold nf and synapse fold sf.
+ *
+ * \tparam IFMChannels 		Number of Input Feature Maps
+ * \tparam IFMDim 			Width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels 		Number of Output Feature Maps
+ * \tparam SIMD 			Number of input columns computed in parallel
+ * \tparam PE 				Number of output rows computed in parallel
+ * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
+ * \tparam TDstI 			DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI 		DataType of the weights (as used in the MAC)
+ * \tparam TAcc 			DataType of the accumulators of the element-wise stage
+ * \tparam InStreamW 		Width of the input stream
+ * \tparam OutStreamW 		Width of the output stream
+ * \tparam TW 				DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA 				DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param weights 			Transformed weights matrix (FixedPointWeights)
+ * \param activation 		Activation class
+ * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int IFMChannels,
+		unsigned int IFMDim,
+		unsigned int OFMChannels,
+
+		unsigned int SIMD, 				// number of SIMD lanes
+		unsigned int PE,				// number of PEs
+
+		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
+		typename TWeightI = Identity,	// redefine I/O interpretation as needed for weigths
+		typename TAcc = ap_int<32>,		// accumulator type of the element-wise stage
+
+		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+		typename TW,   typename TA,  typename R
+>
+void WinogradConvLayer_Batch(hls::stream<ap_uint<InStreamW>>  &in,
+			    hls::stream<ap_uint<OutStreamW>> &out,
+			    TW const        &weights,
+			    TA const        &activation,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  constexpr unsigned OFMDim = IFMDim - 2;
+  static_assert(OFMDim % 2 == 0, "Winograd F(2x2,3x3) requires an even output dimension.");
+  constexpr unsigned TileDim = OFMDim / 2;
+  constexpr unsigned NF = OFMChannels / PE;
+  using TV = ap_int<TSrcI::width + 3>;
+  unsigned const InpPerImage = IFMDim * IFMDim * IFMChannels * TSrcI::width / InStreamW;
+  unsigned const numTiles = reps * TileDim * TileDim;
+  hls::stream<ap_uint<SIMD*TSrcI::width> > wa_in("WinogradConvLayer_Batch.wa_in");
+  hls::stream<ap_uint<SIMD*TSrcI::width> > convInp("WinogradConvLayer_Batch.convInp");
+  hls::stream<ap_uint<SIMD*TV::width> > tileInp("WinogradConvLayer_Batch.tileInp");
+  hls::stream<ap_uint<PE*TAcc::width> > tileAcc("WinogradConvLayer_Batch.tileAcc");
+  hls::stream<ap_uint<PE*TDstI::width> > tileOut("WinogradConvLayer_Batch.tileOut");
+  hls::stream<ap_uint<PE*TDstI::width> > mvOut("WinogradConvLayer_Batch.mvOut");
+  StreamingDataWidthConverter_Batch<InStreamW, SIMD*TSrcI::width, InpPerImage>(in, wa_in, reps);
+  ConvolutionInputGenerator<4, IFMChannels, TSrcI::width, IFMDim,
+			TileDim, SIMD, 2>(wa_in, convInp, reps, ap_resource_dflt());
+  Winograd_InputTransform_Batch<IFMChannels, SIMD, TSrcI, TV>(convInp, tileInp, numTiles);
+  Winograd_Elementwise_Batch<IFMChannels, OFMChannels, SIMD, PE, TAcc, Slice<TV>, Slice<TAcc>, TWeightI>
+    (tileInp, tileAcc, weights, numTiles, r);
+  Winograd_OutputTransform_Batch<OFMChannels, PE, Slice<TAcc>, TDstI>(tileAcc, tileOut, activation, numTiles);
+  Winograd_OutputReorder_Batch<OFMDim, NF>(tileOut, mvOut, reps);
+  StreamingDataWidthConverter_Batch<PE*TDstI::width, OutStreamW, OFMDim * OFMDim * NF>(mvOut, out, reps);
+}
+
+/**
+ * \brief 	Depthwise separable convolutional layer implementation
+ *
+ * The function implements a depthwise convolution followed by a pointwise (1x1) convolution. The
+ * depthwise results of each output pixel are handed to the pointwise Matrix_Vector_Activate_Batch
+ * directly, which buffers them on chip for all of its output folds. To make this possible, the
+ * folding of both stages must match: the PE of the depthwise stage equals the SIMD of the pointwise
+ * stage, so that neither a width converter nor a deep FIFO is needed in between.
+ *
+ * The depthwise stage computes DW_SIMD kernel positions and DW_PE channels per cycle and expects the
+ * weights in the layout of Vector_Vector_Activate_Batch. Its activation (e.g. the thresholds of the
+ * intermediate quantization) produces values of type TMidI. Only ConvKernelDim%Stride = 0 is supported.
+ *
+ * \tparam ConvKernelDim 	Dimension of the depthwise convolutional kernel (assumed square)
+ * \tparam IFMChannels 		Number of Input Feature Maps
+ * \tparam IFMDim 			Width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels 		Number of Output Feature Maps
+ * \tparam OFMDim 			Width and Height of the Output Feature Map (assumed square)
+ * \tparam STRIDE 			Stride of the depthwise convolutional kernel
+ * \tparam DW_SIMD 			Number of kernel positions computed in parallel in the depthwise stage
+ * \tparam DW_PE 			Number of channels computed in parallel in the depthwise stage
+ * \tparam PW_PE 			Number of output rows computed in parallel in the pointwise stage
+ * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
+ * \tparam TMidI 			DataType of the intermediate activation (as generated by the depthwise activation)
+ * \tparam TDstI 			DataType of the output activation (as generated by the pointwise activation)
+ * \tparam TDwWeightI 		DataType of the depthwise weights (as used in the MAC)
+ * \tparam TPwWeightI 		DataType of the pointwise weights (as used in the MAC)
+ * \tparam InStreamW 		Width of the input stream
+ * \tparam OutStreamW 		Width of the output stream
+ * \tparam TDW 				DataType of the depthwise weights - safely deducible from the paramaters
+ * \tparam TDA 				DataType of the depthwise activation class - safely deducible from the paramaters
+ * \tparam TPW 				DataType of the pointwise weights matrix - safely deducible from the paramaters
+ * \tparam TPA 				DataType of the pointwise activation class - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param dwWeights 		Depthwise weights (FixedPointWeights)
+ * \param dwActivation 		Depthwise activation class
+ * \param pwWeights 		Pointwise weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param pwActivation 		Pointwise activation class
+ * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int ConvKernelDim,
+		unsigned int IFMChannels,
+		unsigned int IFMDim,
+		unsigned int OFMChannels,
+		unsigned int OFMDim,
+		unsigned int STRIDE,
+
+		unsigned int DW_SIMD,			// number of kernel positions of the depthwise stage
+		unsigned int DW_PE,				// number of channels of the depthwise stage, SIMD of the pointwise stage
+		unsigned int PW_PE,				// number of PEs of the pointwise stage
+
+		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+		typename TMidI = Identity,		// redefine I/O interpretation as needed for intermediate activations
+		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
+		typename TDwWeightI = Identity,	// redefine I/O interpretation as needed for depthwise weigths
+		typename TPwWeightI = Identity,	// redefine I/O interpretation as needed for pointwise weigths
+
+		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+		typename TDW, typename TDA, typename TPW, typename TPA, typename R
+>
+void DepthwiseSeparableLayer_Batch(hls::stream<ap_uint<InStreamW>>  &in,
+			    hls::stream<ap_uint<OutStreamW>> &out,
+			    TDW const        &dwWeights,
+			    TDA const        &dwActivation,
+			    TPW const        &pwWeights,
+			    TPA const        &pwActivation,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  static_assert(ConvKernelDim % STRIDE == 0, "Only ConvKernelDim%Stride = 0 is supported.");
+  unsigned const InpPerImage = IFMDim * IFMDim * IFMChannels * TSrcI::width / InStreamW;
+  unsigned const pixels = reps * OFMDim * OFMDim;
+  hls::stream<ap_uint<DW_SIMD*DW_PE*TSrcI::width> > wa_in("DepthwiseSeparableLayer_Batch.wa_in");
+  hls::stream<ap_uint<DW_SIMD*DW_PE*TSrcI::width> > convInp("DepthwiseSeparableLayer_Batch.convInp");
+  hls::stream<ap_uint<DW_SIMD*DW_PE*TSrcI::width> > dwInp("DepthwiseSeparableLayer_Batch.dwInp");
+  hls::stream<ap_uint<DW_PE*TMidI::width> > dwOut("DepthwiseSeparableLayer_Batch.dwOut");
+#pragma HLS STREAM variable=dwOut depth=2
+  hls::stream<ap_uint<PW_PE*TDstI::width> > mvOut("DepthwiseSeparableLayer_Batch.mvOut");
+  StreamingDataWidthConverter_Batch<InStreamW, DW_SIMD*DW_PE*TSrcI::width, InpPerImage>(in, wa_in, reps);
+  FINN_STREAM_PROBE(wa_in);
+  ConvolutionInputGenerator_dws<ConvKernelDim, IFMChannels, TSrcI::width, IFMDim,
+			OFMDim, DW_SIMD*DW_PE, STRIDE>(wa_in, convInp, reps, ap_resource_dflt());
+  FINN_STREAM_PROBE(convInp);
+  DepthwiseKernelPacker_Batch<ConvKernelDim*ConvKernelDim, IFMChannels, TSrcI::width, DW_SIMD, DW_PE>(convInp, dwInp, pixels);
+  FINN_STREAM_PROBE(dwInp);
+  Vector_Vector_Activate_Batch<IFMChannels, ConvKernelDim*ConvKernelDim, DW_SIMD, DW_PE, 1, TSrcI, TMidI, TDwWeightI>
+    (dwInp, dwOut, dwWeights, dwActivation, pixels, r);
+  FINN_STREAM_PROBE(dwOut);
+  Matrix_Vector_Activate_Batch<IFMChannels, OFMChannels, DW_PE, PW_PE, 1, TMidI, TDstI, TPwWeightI>
+    (static_cast<hls::stream<ap_uint<DW_PE*TMidI::width>>&>(dwOut),
+     static_cast<hls::stream<ap_uint<PW_PE*TDstI::width>>&>  (mvOut),
+     pwWeights, pwActivation, pixels, r);
+  FINN_STREAM_PROBE(mvOut);
+  StreamingDataWidthConverter_Batch<PW_PE*TDstI::width, OutStreamW, OFMDim * OFMDim * (OFMChannels / PW_PE)>(mvOut, out, reps);
+}
+
+/**
+ * \brief 	Weight streamer selecting one of several weight matrices per output pixel
+ *
+ * For every phase index read from the phase stream, the NF*SF tiles of the weight matrix of this phase are
+ * streamed in the order expected by Matrix_Vector_Activate_Stream_Batch. The weight matrix of phase p
+ * occupies tiles p*NF*SF to (p+1)*NF*SF-1 of the weights.
+ *
+ * \tparam MatrixW 		Width of a single weight matrix
+ * \tparam MatrixH 		Heigth of a single weight matrix
+ * \tparam Phases 		Number of weight matrices
+ * \tparam SIMD 		Number of input columns computed in parallel - safely deducible from the paramaters
+ * \tparam WT 			DataType of the weights - safely deducible from the paramaters
+ * \tparam PE 			Number of output rows computed in parallel - safely deducible from the paramaters
+ * \tparam TILES 		Number of weight tiles - safely deducible from the paramaters
+ * \tparam PhaseW 		Width of the phase stream - safely deducible from the paramaters
+ *
+ * \param phase 		Phase stream, one index per output pixel
+ * \param out 			Weight stream
+ * \param weights 		Weights of all phases
+ * \param numPixels 	Number of phase indices to be processed
+ */
+template<
+		unsigned int MatrixW, unsigned int MatrixH, unsigned int Phases,
+		unsigned int SIMD, typename WT, unsigned int PE, unsigned int TILES, int PhaseW
+>
+void WeightPhase_Streamer_Batch(hls::stream<ap_uint<PhaseW>> &phase,
+			    hls::stream<ap_uint<PE*SIMD*WT::width>> &out,
+			    FixedPointWeights<SIMD, WT, PE, TILES> const &weights,
+			    unsigned const numPixels) {
+  constexpr unsigned int NF = MatrixH / PE;
+  constexpr unsigned int SF = MatrixW / SIMD;
+  static_assert(TILES == Phases * NF * SF, "Weights do not match the phase matrices.");
+  unsigned int tile = 0;
+  unsigned int count = 0;
+  for (unsigned int i = 0; i < numPixels * NF * SF; i++) {
+#pragma HLS pipeline style=flp II=1
+    if (count == 0) {
+      tile = phase.read() * (NF * SF);
+    }
+    ap_uint<PE*SIMD*WT::width> W_packed;
+    for (unsigned int pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      W_packed((pe+1)*SIMD*WT::width-1, pe*SIMD*WT::width) = weights.m_weights[pe][tile];
+    }
+    out.write(W_packed);
+    tile++;
+    if (++count == NF * SF) {
+      count = 0;
+    }
+  }
+}
+
+/**
+ * \brief 	Transposed convolutional layer implementation
+ *
+ * The function implements a transposed convolution (deconvolution) with the given Stride, composed of
+ * ConvolutionInputGenerator_Transposed, which emits only the taps of each output pixel that hit an input pixel,
+ * and a Matrix_Vector_Activate_Stream_Batch fed with the weights of the sub-pixel phase of the output pixel.
+ * The weights hold Stride*Stride matrices of (ConvKernelDim/Stride)^2 * IFMChannels columns, column
+ * (ty*T + tx)*IFMChannels + c of phase py*Stride + px being the kernel weight at position
+ * (py + (T-1-ty)*Stride, px + (T-1-tx)*Stride), T = ConvKernelDim/Stride, and phase (py,px) applying to the
+ * output pixels with ((y+Padding)%Stride, (x+Padding)%Stride) = (py,px).
+ *
+ * \tparam ConvKernelDim 	Dimension of the convolutional kernel (assumed square), multiple of Stride
+ * \tparam IFMChannels 		Number of Input Feature Maps
+ * \tparam IFMDim 			Width and Height of the Input Feature Map (assumed square)
+ * \tparam OFMChannels 		Number of Output Feature Maps
+ * \tparam OFMDim 			Width and Height of the Output Feature Map, (IFMDim-1)*Stride + ConvKernelDim - 2*Padding
+ * \tparam Stride 			Stride of the transposed convolution (upsampling factor)
+ * \tparam Padding 			Number of output rows and columns cropped on each side
+ * \tparam SIMD 			Number of input columns computed in parallel
+ * \tparam PE 				Number of output rows computed in parallel
+ * \tparam TSrcI 			DataType of the input activation (as used in the MAC)
+ * \tparam TDstI 			DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI 		DataType of the weights (as used in the MAC)
+ * \tparam InStreamW 		Width of the input stream
+ * \tparam OutStreamW 		Width of the output stream
+ * \tparam WT 				DataType of the weights - safely deducible from the paramaters
+ * \tparam TILES 			Number of weight tiles - safely deducible from the paramaters
+ * \tparam TA 				DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param weights 			Weights of all phases (FixedPointWeights)
+ * \param activation 		Activation class
+ * \param reps 				Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int ConvKernelDim,
+		unsigned int IFMChannels,
+		unsigned int IFMDim,
+		unsigned int OFMChannels,
+		unsigned int OFMDim,
+		unsigned int Stride,
+		unsigned int Padding,
+
+		unsigned int SIMD, 				// number of SIMD lanes
+		unsigned int PE,				// number of PEs
+
+		typename TSrcI = Identity,      // redefine I/O interpretation as needed for input activations
+		typename TDstI = Identity,		// redefine I/O interpretation as needed for output activations
+		typename TWeightI = Identity,	// redefine I/O interpretation as needed for weigths
+
+		int InStreamW, int OutStreamW,  // safely deducible (stream width must be int though!)
+		typename WT, unsigned int TILES, typename TA, typename R
+>
+void TransposedConvLayer_Batch(hls::stream<ap_uint<InStreamW>>  &in,
+			    hls::stream<ap_uint<OutStreamW>> &out,
+			    FixedPointWeights<SIMD, WT, PE, TILES> const &weights,
+			    TA const        &activation,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  unsigned const MatrixW = (ConvKernelDim / Stride) * (ConvKernelDim / Stride) * IFMChannels;
+  unsigned const MatrixH = OFMChannels;
+  unsigned const InpPerImage = IFMDim * IFMDim * IFMChannels * TSrcI::width / InStreamW;
+  hls::stream<ap_uint<SIMD*TSrcI::width> > wa_in("TransposedConvLayer_Batch.wa_in");
+  hls::stream<ap_uint<SIMD*TSrcI::width> > convInp("TransposedConvLayer_Batch.convInp");
+  hls::stream<ap_uint<(Stride > 1? clog2(Stride*Stride) : 1)> > phase("TransposedConvLayer_Batch.phase");
+  hls::stream<ap_uint<PE*SIMD*WT::width> > wgt("TransposedConvLayer_Batch.wgt");
+  hls::stream<ap_uint<PE*TDstI::width> > mvOut("TransposedConvLayer_Batch.mvOut");
+  StreamingDataWidthConverter_Batch<InStreamW, SIMD*TSrcI::width, InpPerImage>(in, wa_in, reps);
+  FINN_STREAM_PROBE(wa_in);
+  ConvolutionInputGenerator_Transposed<ConvKernelDim, IFMChannels, TSrcI::width, IFMDim,
+			OFMDim, SIMD, Stride, Padding>(wa_in, convInp, phase, reps, ap_resource_dflt());
+  FINN_STREAM_PROBE(convInp);
+  FINN_STREAM_PROBE(phase);
+  WeightPhase_Streamer_Batch<MatrixW, MatrixH, Stride*Stride>(phase, wgt, weights, reps * OFMDim * OFMDim);
+  FINN_STREAM_PROBE(wgt);
+  Matrix_Vector_Activate_Stream_Batch<MatrixW, MatrixH, SIMD, PE, TSrcI, TDstI, TWeightI, WT>
+    (static_cast<hls::stream<ap_uint<SIMD*TSrcI::width>>&>(convInp),
+     static_cast<hls::stream<ap_uint<PE*TDstI::width>>&>  (mvOut),
+     wgt, activation, reps * OFMDim * OFMDim, r);
+  FINN_STREAM_PROBE(mvOut);
+  StreamingDataWidthConverter_Batch<PE*TDstI::width, OutStreamW, OFMDim * OFMDim * (OFMChannels / PE)>(mvOut, out, reps);
+}
+
+/**
+ * \brief 	Frame buffer and channel scaling stage of a squeeze-and-excitation block
+ *
+ * Holds one feature map in an on-chip buffer until its per-channel scales are available and applies them
+ * through a ChannelWiseOperation. Frame f is stored while frame f-1 is read out of the same locations, so
+ * the buffer is sized for exactly one frame and only the scale vector of frame f-1 must be available
+ * before storing of frame f starts.
+ *
+ * \tparam NumPixels 	Number of pixels per feature map
+ * \tparam Channels 	Number of channels
+ * \tparam PE 			Number of channels processed in parallel
+ * \tparam TI 			DataType of the feature map elements
+ * \tparam TS 			DataType of the channel scales
+ * \tparam TO 			DataType of the output elements
+ * \tparam Fxn 			Function applied on each scale and feature map element
+ *
+ * \param in 			Feature map stream
+ * \param scale 		Scale stream, Channels/PE words per image
+ * \param out 			Output stream
+ * \param reps 			Number of images
+ */
+template<
+		unsigned int NumPixels, unsigned int Channels, unsigned int PE,
+		typename TI, typename TS, typename TO, typename Fxn = comp::mul<TS, TI, TO>
+>
+void SqueezeExcite_Scale(hls::stream<ap_uint<PE*TI::width>> &in,
+			    hls::stream<ap_uint<PE*TS::width>> &scale,
+			    hls::stream<ap_uint<PE*TO::width>> &out,
+			    unsigned const   reps) {
+  static_assert(Channels % PE == 0, "PE must divide Channels");
+  constexpr unsigned int NF = Channels / PE;
+  constexpr unsigned int FRAME = NumPixels * NF;
+
+  ap_uint<PE*TI::width>  buf[FRAME];
+  ChannelWiseOperation<NF, PE, TI, TS, TO, Fxn>  scales;
+#pragma HLS ARRAY_PARTITION variable=scales.parameters complete dim=1
+
+  // one extra pass drains the last frame
+  unsigned const  frames = reps? reps + 1 : 0;
+  for(unsigned int  f = 0; f < frames; f++) {
+    if(f > 0) {
+      for(unsigned int  nf = 0; nf < NF; nf++) {
+#pragma HLS pipeline style=flp II=1
+        ap_uint<PE*TS::width> const  s = scale.read();
+        for(unsigned int  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          scales.parameters[pe][nf] = TS(s((pe+1)*TS::width-1, pe*TS::width));
+        }
+      }
+    }
+    unsigned int  nf = 0;
+    for(unsigned int  i = 0; i < FRAME; i++) {
+#pragma HLS pipeline style=flp II=1
+      ap_uint<PE*TI::width> const  prev = buf[i];
+      if(f < reps)  buf[i] = in.read();
+      if(f > 0) {
+        ap_uint<PE*TO::width>  outElem;
+        for(unsigned int  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          TI const  x = prev((pe+1)*TI::width-1, pe*TI::width);
+          TO const  y = scales.activate(nf, pe, x);
+          outElem((pe+1)*TO::width-1, pe*TO::width) = y;
+        }
+        out.write(outElem);
+      }
+      if(++nf == NF)  nf = 0;
+    }
+  }
+}
+
+/**
+ * \brief 	Frame buffer and channel scaling stage of a squeeze-and-excitation block with the frame spilled to memory
+ *
+ * Works as SqueezeExcite_Scale, but holds the feature map in an external memory buffer for maps too large to be
+ * kept on chip. Frames alternate between the two halves of the spill buffer.
+ *
+ * \tparam NumPixels 	Number of pixels per feature map
+ * \tparam Channels 	Number of channels
+ * \tparam PE 			Number of channels processed in parallel
+ * \tparam TI 			DataType of the feature map elements
+ * \tparam TS 			DataType of the channel scales
+ * \tparam TO 			DataType of the output elements
+ * \tparam Fxn 			Function applied on each scale and feature map element
+ *
+ * \param in 			Feature map stream
+ * \param scale 		Scale stream, Channels/PE words per image
+ * \param out 			Output stream
+ * \param spill 		Spill buffer of 2*NumPixels*Channels/PE words
+ * \param reps 			Number of images
+ */
+template<
+		unsigned int NumPixels, unsigned int Channels, unsigned int PE,
+		typename TI, typename TS, typename TO, typename Fxn = comp::mul<TS, TI, TO>
+>
+void SqueezeExcite_Scale_Spill(hls::stream<ap_uint<PE*TI::width>> &in,
+			    hls::stream<ap_uint<PE*TS::width>> &scale,
+			    hls::stream<ap_uint<PE*TO::width>> &out,
+			    ap_uint<PE*TI::width> *spill,
+			    unsigned const   reps) {
+  static_assert(Channels % PE == 0, "PE must divide Channels");
+  constexpr unsigned int NF = Channels / PE;
+  constexpr unsigned int FRAME = NumPixels * NF;
+
+  ChannelWiseOperation<NF, PE, TI, TS, TO, Fxn>  scales;
+#pragma HLS ARRAY_PARTITION variable=scales.parameters complete dim=1
+
+  unsigned const  frames = reps? reps + 1 : 0;
+  for(unsigned int  f = 0; f < frames; f++) {
+    if(f > 0) {
+      for(unsigned int  nf = 0; nf < NF; nf++) {
+#pragma HLS pipeline style=flp II=1
+        ap_uint<PE*TS::width> const  s = scale.read();
+        for(unsigned int  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          scales.parameters[pe][nf] = TS(s((pe+1)*TS::width-1, pe*TS::width));
+        }
+      }
+    }
+    ap_uint<PE*TI::width> *const  wr = spill + (f & 1) * FRAME;
+    ap_uint<PE*TI::width> const *const  rd = spill + (~f & 1) * FRAME;
+    unsigned int  nf = 0;
+    for(unsigned int  i = 0; i < FRAME; i++) {
+#pragma HLS pipeline style=flp II=1
+      if(f < reps)  wr[i] = in.read();
+      if(f > 0) {
+        ap_uint<PE*TI::width> const  prev = rd[i];
+        ap_uint<PE*TO::width>  outElem;
+        for(unsigned int  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          TI const  x = prev((pe+1)*TI::width-1, pe*TI::width);
+          TO const  y = scales.activate(nf, pe, x);
+          outElem((pe+1)*TO::width-1, pe*TO::width) = y;
+        }
+        out.write(outElem);
+      }
+      if(++nf == NF)  nf = 0;
+    }
+  }
+}
+
+/**
+ * \brief 	Excitation path of a squeeze-and-excitation block
+ *
+ * Global accumulation pool followed by two fully-connected layers computed by small MVAUs. The activation of the
+ * second layer (typically a sigmoid as LUTActivation or thresholds) produces the channel scales.
+ *
+ * \tparam NumPixels 	Number of pixels per feature map
+ * \tparam Channels 	Number of channels
+ * \tparam Reduced 		Number of channels of the squeezed vector
+ * \tparam PE 			Number of channels of the feature map stream in parallel
+ * \tparam SIMD1 		Number of input columns computed in parallel in the first layer
+ * \tparam PE1 			Number of output rows computed in parallel in the first layer
+ * \tparam SIMD2 		Number of input columns computed in parallel in the second layer
+ * \tparam PE2 			Number of output rows computed in parallel in the second layer
+ * \tparam TI 			DataType of the feature map elements
+ * \tparam TAcc 		DataType of the pooled channel sums
+ * \tparam TMid 		DataType of the squeezed vector (as generated by the first activation)
+ * \tparam TS 			DataType of the channel scales (as generated by the second activation)
+ * \tparam TW1I 		DataType of the weights of the first layer (as used in the MAC)
+ * \tparam TW2I 		DataType of the weights of the second layer (as used in the MAC)
+ * \tparam TW1 			DataType of the weights of the first layer - safely deducible from the paramaters
+ * \tparam TA1 			DataType of the activation of the first layer - safely deducible from the paramaters
+ * \tparam TW2 			DataType of the weights of the second layer - safely deducible from the paramaters
+ * \tparam TA2 			DataType of the activation of the second layer - safely deducible from the paramaters
+ * \tparam R 			DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 			Feature map stream
+ * \param scale 		Scale stream, Channels/PE words per image
+ * \param weights1 		Weights of the first layer (Reduced x Channels)
+ * \param activation1 	Activation of the first layer
+ * \param weights2 		Weights of the second layer (Channels x Reduced)
+ * \param activation2 	Activation of the second layer
+ * \param reps 			Number of images
+ * \param r 			Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int NumPixels, unsigned int Channels, unsigned int Reduced, unsigned int PE,
+		unsigned int SIMD1, unsigned int PE1, unsigned int SIMD2, unsigned int PE2,
+		typename TI, typename TAcc, typename TMid, typename TS,
+		typename TW1I = Identity, typename TW2I = Identity,
+		typename TW1, typename TA1, typename TW2, typename TA2, typename R
+>
+void SqueezeExcite_Excitation(hls::stream<ap_uint<PE*TI::width>> &in,
+			    hls::stream<ap_uint<PE*TS::width>> &scale,
+			    TW1 const        &weights1,
+			    TA1 const        &activation1,
+			    TW2 const        &weights2,
+			    TA2 const        &activation2,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  static_assert(Channels % PE == 0, "PE must divide Channels");
+  hls::stream<ap_uint<PE*TAcc::width>> pooled("SqueezeExcite_Excitation.pooled");
+  hls::stream<ap_uint<SIMD1*TAcc::width>> fc1In("SqueezeExcite_Excitation.fc1In");
+  hls::stream<ap_uint<PE1*TMid::width>> fc1Out("SqueezeExcite_Excitation.fc1Out");
+  hls::stream<ap_uint<SIMD2*TMid::width>> fc2In("SqueezeExcite_Excitation.fc2In");
+  hls::stream<ap_uint<PE2*TS::width>> fc2Out("SqueezeExcite_Excitation.fc2Out");
+  GlobalAccPool_Batch<NumPixels, Channels, TI, PE, TAcc>(in, pooled, reps);
+  FINN_STREAM_PROBE(pooled);
+  StreamingDataWidthConverter_Batch<PE*TAcc::width, SIMD1*TAcc::width, Channels/PE>(pooled, fc1In, reps);
+  FINN_STREAM_PROBE(fc1In);
+  Matrix_Vector_Activate_Batch<Channels, Reduced, SIMD1, PE1, 1, Slice<TAcc>, Slice<TMid>, TW1I>
+    (fc1In, fc1Out, weights1, activation1, reps, r);
+  FINN_STREAM_PROBE(fc1Out);
+  StreamingDataWidthConverter_Batch<PE1*TMid::width, SIMD2*TMid::width, Reduced/PE1>(fc1Out, fc2In, reps);
+  FINN_STREAM_PROBE(fc2In);
+  Matrix_Vector_Activate_Batch<Reduced, Channels, SIMD2, PE2, 1, Slice<TMid>, Slice<TS>, TW2I>
+    (fc2In, fc2Out, weights2, activation2, reps, r);
+  FINN_STREAM_PROBE(fc2Out);
+  StreamingDataWidthConverter_Batch<PE2*TS::width, PE*TS::width, Channels/PE2>(fc2Out, scale, reps);
+}
+
+/**
+ * \brief 	Squeeze-and-excitation block
+ *
+ * Scales every channel of a feature map by the excitation computed from the feature map itself:
+ * global pool, two fully-connected layers and their activations (see SqueezeExcite_Excitation). The feature map
+ * is held in a frame buffer sized for exactly one frame while the excitation is computed (see SqueezeExcite_Scale),
+ * instead of in a deep FIFO that must be dimensioned by hand to avoid a deadlock.
+ *
+ * \tparam NumPixels 	Number of pixels per feature map
+ * \tparam Channels 	Number of channels
+ * \tparam Reduced 		Number of channels of the squeezed vector
+ * \tparam PE 			Number of channels of the feature map stream in parallel
+ * \tparam SIMD1 		Number of input columns computed in parallel in the first layer
+ * \tparam PE1 			Number of output rows computed in parallel in the first layer
+ * \tparam SIMD2 		Number of input columns computed in parallel in the second layer
+ * \tparam PE2 			Number of output rows computed in parallel in the second layer
+ * \tparam TI 			DataType of the feature map elements
+ * \tparam TAcc 		DataType of the pooled channel sums
+ * \tparam TMid 		DataType of the squeezed vector (as generated by the first activation)
+ * \tparam TS 			DataType of the channel scales (as generated by the second activation)
+ * \tparam TO 			DataType of the output elements
+ * \tparam TW1I 		DataType of the weights of the first layer (as used in the MAC)
+ * \tparam TW2I 		DataType of the weights of the second layer (as used in the MAC)
+ * \tparam Fxn 			Function applied on each scale and feature map element
+ * \tparam TW1 			DataType of the weights of the first layer - safely deducible from the paramaters
+ * \tparam TA1 			DataType of the activation of the first layer - safely deducible from the paramaters
+ * \tparam TW2 			DataType of the weights of the second layer - safely deducible from the paramaters
+ * \tparam TA2 			DataType of the activation of the second layer - safely deducible from the paramaters
+ * \tparam R 			DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 			Input stream
+ * \param out 			Output stream
+ * \param weights1 		Weights of the first layer (Reduced x Channels)
+ * \param activation1 	Activation of the first layer
+ * \param weights2 		Weights of the second layer (Channels x Reduced)
+ * \param activation2 	Activation of the second layer
+ * \param reps 			Number of images
+ * \param r 			Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int NumPixels, unsigned int Channels, unsigned int Reduced, unsigned int PE,
+		unsigned int SIMD1, unsigned int PE1, unsigned int SIMD2, unsigned int PE2,
+		typename TI, typename TAcc, typename TMid, typename TS, typename TO,
+		typename TW1I = Identity, typename TW2I = Identity, typename Fxn = comp::mul<TS, TI, TO>,
+		typename TW1, typename TA1, typename TW2, typename TA2, typename R
+>
+void SqueezeExcite_Batch(hls::stream<ap_uint<PE*TI::width>> &in,
+			    hls::stream<ap_uint<PE*TO::width>> &out,
+			    TW1 const        &weights1,
+			    TA1 const        &activation1,
+			    TW2 const        &weights2,
+			    TA2 const        &activation2,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  hls::stream<ap_uint<PE*TI::width>> fmap("SqueezeExcite_Batch.fmap");
+  hls::stream<ap_uint<PE*TI::width>> squeeze("SqueezeExcite_Batch.squeeze");
+  hls::stream<ap_uint<PE*TS::width>> scale("SqueezeExcite_Batch.scale");
+  DuplicateStreams_Batch<PE*TI::width, NumPixels*(Channels/PE)>(in, fmap, squeeze, reps);
+  FINN_STREAM_PROBE(fmap);
+  FINN_STREAM_PROBE(squeeze);
+  SqueezeExcite_Excitation<NumPixels, Channels, Reduced, PE, SIMD1, PE1, SIMD2, PE2, TI, TAcc, TMid, TS, TW1I, TW2I>
+    (squeeze, scale, weights1, activation1, weights2, activation2, reps, r);
+  FINN_STREAM_PROBE(scale);
+  SqueezeExcite_Scale<NumPixels, Channels, PE, TI, TS, TO, Fxn>(fmap, scale, out, reps);
+}
+
+/**
+ * \brief 	Squeeze-and-excitation block with the feature map spilled to memory
+ *
+ * Works as SqueezeExcite_Batch, but holds the feature map in an external memory buffer of
+ * 2*NumPixels*Channels/PE words (see SqueezeExcite_Scale_Spill) for maps too large for on-chip memory.
+ *
+ * \tparam NumPixels 	Number of pixels per feature map
+ * \tparam Channels 	Number of channels
+ * \tparam Reduced 		Number of channels of the squeezed vector
+ * \tparam PE 			Number of channels of the feature map stream in parallel
+ * \tparam SIMD1 		Number of input columns computed in parallel in the first layer
+ * \tparam PE1 			Number of output rows computed in parallel in the first layer
+ * \tparam SIMD2 		Number of input columns computed in parallel in the second layer
+ * \tparam PE2 			Number of output rows computed in parallel in the second layer
+ * \tparam TI 			DataType of the feature map elements
+ * \tparam TAcc 		DataType of the pooled channel sums
+ * \tparam TMid 		DataType of the squeezed vector (as generated by the first activation)
+ * \tparam TS 			DataType of the channel scales (as generated by the second activation)
+ * \tparam TO 			DataType of the output elements
+ * \tparam TW1I 		DataType of the weights of the first layer (as used in the MAC)
+ * \tparam TW2I 		DataType of the weights of the second layer (as used in the MAC)
+ * \tparam Fxn 			Function applied on each scale and feature map element
+ * \tparam TW1 			DataType of the weights of the first layer - safely deducible from the paramaters
+ * \tparam TA1 			DataType of the activation of the first layer - safely deducible from the paramaters
+ * \tparam TW2 			DataType of the weights of the second layer - safely deducible from the paramaters
+ * \tparam TA2 			DataType of the activation of the second layer - safely deducible from the paramaters
+ * \tparam R 			DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 			Input stream
+ * \param out 			Output stream
+ * \param spill 		Spill buffer of 2*NumPixels*Channels/PE words
+ * \param weights1 		Weights of the first layer (Reduced x Channels)
+ * \param activation1 	Activation of the first layer
+ * \param weights2 		Weights of the second layer (Channels x Reduced)
+ * \param activation2 	Activation of the second layer
+ * \param reps 			Number of images
+ * \param r 			Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int NumPixels, unsigned int Channels, unsigned int Reduced, unsigned int PE,
+		unsigned int SIMD1, unsigned int PE1, unsigned int SIMD2, unsigned int PE2,
+		typename TI, typename TAcc, typename TMid, typename TS, typename TO,
+		typename TW1I = Identity, typename TW2I = Identity, typename Fxn = comp::mul<TS, TI, TO>,
+		typename TW1, typename TA1, typename TW2, typename TA2, typename R
+>
+void SqueezeExcite_Spill_Batch(hls::stream<ap_uint<PE*TI::width>> &in,
+			    hls::stream<ap_uint<PE*TO::width>> &out,
+			    ap_uint<PE*TI::width> *spill,
+			    TW1 const        &weights1,
+			    TA1 const        &activation1,
+			    TW2 const        &weights2,
+			    TA2 const        &activation2,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  hls::stream<ap_uint<PE*TI::width>> fmap("SqueezeExcite_Spill_Batch.fmap");
+  hls::stream<ap_uint<PE*TI::width>> squeeze("SqueezeExcite_Spill_Batch.squeeze");
+  hls::stream<ap_uint<PE*TS::width>> scale("SqueezeExcite_Spill_Batch.scale");
+  DuplicateStreams_Batch<PE*TI::width, NumPixels*(Channels/PE)>(in, fmap, squeeze, reps);
+  FINN_STREAM_PROBE(fmap);
+  FINN_STREAM_PROBE(squeeze);
+  SqueezeExcite_Excitation<NumPixels, Channels, Reduced, PE, SIMD1, PE1, SIMD2, PE2, TI, TAcc, TMid, TS, TW1I, TW2I>
+    (squeeze, scale, weights1, activation1, weights2, activation2, reps, r);
+  FINN_STREAM_PROBE(scale);
+  SqueezeExcite_Scale_Spill<NumPixels, Channels, PE, TI, TS, TO, Fxn>(fmap, scale, out, spill, reps);
+}
+
+/**
+ * \brief 	Depth of the skip path of a residual block for a deadlock-free dataflow
+ *
+ * Every convolution of the main path of ResidualBlock_Batch reads ahead of the pixels it emits: its
+ * sliding window generator buffers ConvKernelDim padded lines before the first window and reads the next line
+ * while emitting a row of windows. Less the PadUp zero lines inserted ahead of the map, this makes
+ * ConvKernelDim+1-PadUp rows of IFMDim pixels. Outside of the window buffer, a convolution is a chain of four
+ * processes, the SameResize ahead of it, its input width converter, its MVAU and its output width converter. Each
+ * of them holds at most a pixel in its registers and StreamDepth words in its output stream, none of which is
+ * wider than a pixel. The skip path has to hold the pixels read ahead by both convolutions.
+ *
+ * \tparam ConvKernelDim 	Dimension of the convolutional kernels (assumed square)
+ * \tparam IFMDim 			Width and Height of the feature map (assumed square)
+ */
+template<unsigned int ConvKernelDim, unsigned int IFMDim>
+struct residual_skip_depth {
+  // zero lines inserted above the map by SameResize (PaddingStyle 2)
+  static constexpr unsigned int  PadUp = (ConvKernelDim - 1) / 2 + (ConvKernelDim - 1) % 2;
+  // default depth of the streams between the processes of the main path
+  static constexpr unsigned int  StreamDepth = 2;
+  // processes of a convolution outside its sliding window generator
+  static constexpr unsigned int  ConvStages = 4;
+  // pixels of a convolution in flight in these processes and their output streams
+  static constexpr unsigned int  Slack = ConvStages * (1 + StreamDepth);
+  static constexpr unsigned int  ConvLead = (ConvKernelDim + 1 - PadUp) * IFMDim + Slack;
+  static constexpr unsigned int  value = 2 * ConvLead;
+};
+
+/**
+ * \brief 	Words of the spill buffer of ResidualBlock_Spill_Batch
+ *
+ * The skip path depth rounded up to whole bursts, as the ring buffer of the VirtualFIFO is written and read in
+ * bursts of SpillBurst words.
+ *
+ * \tparam ConvKernelDim 	Dimension of the convolutional kernels (assumed square)
+ * \tparam IFMDim 			Width and Height of the feature map (assumed square)
+ * \tparam SpillBurst 		Number of words per burst of the spill buffer
+ */
+template<unsigned int ConvKernelDim, unsigned int IFMDim, unsigned int SpillBurst = 16>
+struct residual_spill_depth {
+  static constexpr unsigned int  value =
+    (residual_skip_depth<ConvKernelDim, IFMDim>::value + SpillBurst - 1) / SpillBurst * SpillBurst;
+};
+
+namespace detail {
+
+  // Main path of a residual block: two padded convolutions keeping the feature map dimension
+  template<
+    unsigned int ConvKernelDim, unsigned int Channels, unsigned int IFMDim,
+    unsigned int SIMD1, unsigned int PE1, unsigned int SIMD2, unsigned int PE2,
+    typename TI, typename TM, typename TR, typename TW1I, typename TW2I,
+    typename TW1, typename TA1, typename TW2, typename TA2, typename R
+  >
+  void residual_main(hls::stream<ap_uint<Channels*TI::width>> &in,
+                     hls::stream<ap_uint<Channels*TR::width>> &out,
+                     TW1 const  &weights1, TA1 const  &activation1,
+                     TW2 const  &weights2, TA2 const  &activation2,
+                     unsigned const  reps, R const &r) {
+#pragma HLS INLINE
+    constexpr unsigned int  PaddedDim = IFMDim + ConvKernelDim - 1;
+    hls::stream<ap_uint<Channels*TI::width>> pad1("ResidualBlock.pad1");
+    hls::stream<ap_uint<Channels*TM::width>> mid("ResidualBlock.mid");
+    hls::stream<ap_uint<Channels*TM::width>> pad2("ResidualBlock.pad2");
+    SameResize_Batch<IFMDim, ConvKernelDim, 1, Channels, TI>(in, pad1, reps);
+    FINN_STREAM_PROBE(pad1);
+    ConvLayer_Batch<ConvKernelDim, Channels, PaddedDim, Channels, IFMDim, SIMD1, PE1, Slice<TI>, Slice<TM>, TW1I>
+      (pad1, mid, weights1, activation1, reps, r);
+    FINN_STREAM_PROBE(mid);
+    SameResize_Batch<IFMDim, ConvKernelDim, 1, Channels, TM>(mid, pad2, reps);
+    FINN_STREAM_PROBE(pad2);
+    ConvLayer_Batch<ConvKernelDim, Channels, PaddedDim, Channels, IFMDim, SIMD2, PE2, Slice<TM>, Slice<TR>, TW2I>
+      (pad2, out, weights2, activation2, reps, r);
+  }
+
+} // namespace detail
+
+/**
+ * \brief 	Residual block
+ *
+ * Implements the basic block of a ResNet: two convolutions with zero padding, so that the feature map keeps its
+ * dimension, whose result is added to the block input carried on the skip path. The skip path is a FIFO of
+ * residual_skip_depth pixels, which is the depth needed for the dataflow not to deadlock, so that it need not
+ * be found in cosimulation. The streams carry one pixel per word.
+ *
+ * \tparam ConvKernelDim 	Dimension of the convolutional kernels (assumed square)
+ * \tparam Channels 		Number of channels of all feature maps
+ * \tparam IFMDim 			Width and Height of the feature map (assumed square)
+ * \tparam SIMD1 			Number of input columns computed in parallel in the first convolution
+ * \tparam PE1 				Number of output rows computed in parallel in the first convolution
+ * \tparam SIMD2 			Number of input columns computed in parallel in the second convolution
+ * \tparam PE2 				Number of output rows computed in parallel in the second convolution
+ * \tparam TI 				DataType of the input elements
+ * \tparam TM 				DataType of the intermediate elements (as generated by the first activation)
+ * \tparam TR 				DataType of the main path result (as generated by the second activation)
+ * \tparam TO 				DataType of the output elements, the sums of input and main path result
+ * \tparam TW1I 			DataType of the weights of the first convolution (as used in the MAC)
+ * \tparam TW2I 			DataType of the weights of the second convolution (as used in the MAC)
+ * \tparam TW1 				DataType of the weights of the first convolution - safely deducible from the paramaters
+ * \tparam TA1 				DataType of the activation of the first convolution - safely deducible from the paramaters
+ * \tparam TW2 				DataType of the weights of the second convolution - safely deducible from the paramaters
+ * \tparam TA2 				DataType of the activation of the second convolution - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param weights1 			Weights of the first convolution
+ * \param activation1 		Activation of the first convolution
+ * \param weights2 			Weights of the second convolution
+ * \param activation2 		Activation of the second convolution
+ * \param reps 				Number of images
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int ConvKernelDim, unsigned int Channels, unsigned int IFMDim,
+		unsigned int SIMD1, unsigned int PE1, unsigned int SIMD2, unsigned int PE2,
+		typename TI, typename TM, typename TR, typename TO,
+		typename TW1I = Identity, typename TW2I = Identity,
+		typename TW1, typename TA1, typename TW2, typename TA2, typename R
+>
+void ResidualBlock_Batch(hls::stream<ap_uint<Channels*TI::width>> &in,
+			    hls::stream<ap_uint<Channels*TO::width>> &out,
+			    TW1 const        &weights1,
+			    TA1 const        &activation1,
+			    TW2 const        &weights2,
+			    TA2 const        &activation2,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  constexpr unsigned int  SkipDepth = residual_skip_depth<ConvKernelDim, IFMDim>::value;
+  hls::stream<ap_uint<Channels*TI::width>> fmap("ResidualBlock_Batch.fmap");
+  hls::stream<ap_uint<Channels*TI::width>, SkipDepth> skip("ResidualBlock_Batch.skip");
+  hls::stream<ap_uint<Channels*TR::width>> res("ResidualBlock_Batch.res");
+  DuplicateStreams_Batch<Channels*TI::width, IFMDim*IFMDim>(in, fmap, skip, reps);
+  FINN_STREAM_PROBE(fmap);
+  FINN_STREAM_PROBE(skip);
+  detail::residual_main<ConvKernelDim, Channels, IFMDim, SIMD1, PE1, SIMD2, PE2, TI, TM, TR, TW1I, TW2I>
+    (fmap, res, weights1, activation1, weights2, activation2, reps, r);
+  FINN_STREAM_PROBE(res);
+  AddStreams_Batch<Channels, TI, TR, TO, IFMDim*IFMDim>(skip, res, out, reps);
+}
+
+/**
+ * \brief 	Residual block with the skip path spilled to memory
+ *
+ * Works as ResidualBlock_Batch, but replaces the skip FIFO by a VirtualFIFO for blocks whose skip path would take
+ * too many BRAMs (see bram18_count). Its ring buffer of residual_spill_depth words in external memory is written
+ * and read back by the same process, so that every read is ordered behind the writes of the same slots. The
+ * VirtualFIFO runs without bypass, every pixel going through the external memory, which passes a pixel every two
+ * cycles at most, above the rate of the convolutions of the main path unless they are fully unrolled.
+ *
+ * \tparam ConvKernelDim 	Dimension of the convolutional kernels (assumed square)
+ * \tparam Channels 		Number of channels of all feature maps
+ * \tparam IFMDim 			Width and Height of the feature map (assumed square)
+ * \tparam SIMD1 			Number of input columns computed in parallel in the first convolution
+ * \tparam PE1 				Number of output rows computed in parallel in the first convolution
+ * \tparam SIMD2 			Number of input columns computed in parallel in the second convolution
+ * \tparam PE2 				Number of output rows computed in parallel in the second convolution
+ * \tparam TI 				DataType of the input elements
+ * \tparam TM 				DataType of the intermediate elements (as generated by the first activation)
+ * \tparam TR 				DataType of the main path result (as generated by the second activation)
+ * \tparam TO 				DataType of the output elements, the sums of input and main path result
+ * \tparam TW1I 			DataType of the weights of the first convolution (as used in the MAC)
+ * \tparam TW2I 			DataType of the weights of the second convolution (as used in the MAC)
+ * \tparam SpillBurst 		Number of words per burst of the spill buffer
+ * \tparam TW1 				DataType of the weights of the first convolution - safely deducible from the paramaters
+ * \tparam TA1 				DataType of the activation of the first convolution - safely deducible from the paramaters
+ * \tparam TW2 				DataType of the weights of the second convolution - safely deducible from the paramaters
+ * \tparam TA2 				DataType of the activation of the second convolution - safely deducible from the paramaters
+ * \tparam R 				DataType for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in 				Input stream
+ * \param out 				Output stream
+ * \param spill 			Spill buffer of residual_spill_depth<ConvKernelDim, IFMDim, SpillBurst>::value words
+ * \param weights1 			Weights of the first convolution
+ * \param activation1 		Activation of the first convolution
+ * \param weights2 			Weights of the second convolution
+ * \param activation2 		Activation of the second convolution
+ * \param reps 				Number of images
+ * \param r 				Resource type for the hardware implementation of the MAC block
+ */
+template<
+		unsigned int ConvKernelDim, unsigned int Channels, unsigned int IFMDim,
+		unsigned int SIMD1, unsigned int PE1, unsigned int SIMD2, unsigned int PE2,
+		typename TI, typename TM, typename TR, typename TO,
+		typename TW1I = Identity, typename TW2I = Identity, unsigned int SpillBurst = 16,
+		typename TW1, typename TA1, typename TW2, typename TA2, typename R
+>
+void ResidualBlock_Spill_Batch(hls::stream<ap_uint<Channels*TI::width>> &in,
+			    hls::stream<ap_uint<Channels*TO::width>> &out,
+			    ap_uint<Channels*TI::width> *spill,
+			    TW1 const        &weights1,
+			    TA1 const        &activation1,
+			    TW2 const        &weights2,
+			    TA2 const        &activation2,
+			    unsigned const   reps,
+				R const &r) {
+#pragma HLS INLINE
+  constexpr unsigned int  SpillDepth = residual_spill_depth<ConvKernelDim, IFMDim, SpillBurst>::value;
+  hls::stream<ap_uint<Channels*TI::width>> fmap("ResidualBlock_Spill_Batch.fmap");
+  hls::stream<ap_uint<Channels*TI::width>> skipIn("ResidualBlock_Spill_Batch.skipIn");
+  hls::stream<ap_uint<Channels*TI::width>> skipOut("ResidualBlock_Spill_Batch.skipOut");
+  hls::stream<ap_uint<Channels*TR::width>> res("ResidualBlock_Spill_Batch.res");
+  DuplicateStreams_Batch<Channels*TI::width, IFMDim*IFMDim>(in, fmap, skipIn, reps);
+  FINN_STREAM_PROBE(fmap);
+  FINN_STREAM_PROBE(skipIn);
+  VirtualFIFO<Channels*TI::width, SpillDepth, SpillBurst, false>(skipIn, skipOut, spill, reps * IFMDim * IFMDim);
+  FINN_STREAM_PROBE(skipOut);
+  detail::residual_main<ConvKernelDim, Channels, IFMDim, SIMD1, PE1, SIMD2, PE2, TI, TM, TR, TW1I, TW2I>
+    (fmap, res, weights1, activation1, weights2, activation2, reps, r);
+  FINN_STREAM_PROBE(res);
+  AddStreams_Batch<Channels, TI, TR, TO, IFMDim*IFMDim>(skipOut, res, out, reps);
+}
+
 #endif
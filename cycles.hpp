@@ -0,0 +1,998 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *
+ *  \file cycles.hpp
+ *
+ *  Analytical cycle and latency models of the library blocks.
+ *
+ *  Every model is a constexpr function named after the block it describes and
+ *  takes the block's compile-time geometry parameters in the same order, e.g.
+ *  ConvolutionInputGenerator_cycles<ConvKernelDim, IFMChannels, IFMDim,
+ *  OFMDim, SIMD, Stride>(numReps). The data type and precision parameters do
+ *  not influence the schedule and are omitted.
+ *
+ *  - <Block>_cycles() counts the iterations of the II=1 main loop of the block
+ *    for the given number of repetitions. It is the execution time in clock
+ *    cycles of a block that is never stalled by its streams, excluding the
+ *    pipeline depth, which is paid once per pipelined loop entry.
+ *  - <Block>_latency() counts the iterations until the first output word is
+ *    written, i.e. the cycles an unstalled block adds to the start of a
+ *    dataflow pipeline.
+ *
+ *  The sliding window generators and converters driven by a data-dependent
+ *  while loop have no closed-form schedule. Their models, marked as bounds, are
+ *  the lower bound derived from the number of words that must be read and
+ *  written per frame.
+ *
+ *  Being independent of the HLS headers, the models may also be evaluated in
+ *  host code, e.g. for design space exploration.
+ *
+ *******************************************************************************/
+
+#ifndef CYCLES_HPP
+#define CYCLES_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+/** Cycle counts are 64 bit wide as they easily overflow 32 bits over many repetitions. */
+using cycles_t = std::uint64_t;
+
+namespace detail {
+
+	/** Cycles of an MVAU over reps input vectors (or MMV vector groups). */
+	constexpr cycles_t mvau_cycles(
+		unsigned const  MatrixW, unsigned const  MatrixH, unsigned const  SIMD, unsigned const  PE,
+		cycles_t const  reps
+	) {
+		return  reps * (MatrixH/PE) * (MatrixW/SIMD);
+	}
+
+	/** Cycles of ConvolutionInputGenerator and its _MMV and _dws variants over numReps frames. */
+	constexpr cycles_t swg_cycles(
+		unsigned const  ConvKernelDim, unsigned const  IFMChannels, unsigned const  IFMDim, unsigned const  OFMDim,
+		unsigned const  SIMD, unsigned const  Stride, unsigned const  MMV, unsigned const  Dilation,
+		cycles_t const  numReps
+	) {
+		unsigned const  mf = IFMChannels/SIMD;
+		unsigned const  kernel_extent = (ConvKernelDim-1) * Dilation + 1;
+		unsigned const  cycles_write_block = (OFMDim * ConvKernelDim * ConvKernelDim * mf) / MMV;
+		unsigned const  cycles_read_block = Stride * IFMDim * mf;
+		return  numReps * (IFMDim * kernel_extent * mf + cycles_t(OFMDim) * std::max(cycles_write_block, cycles_read_block));
+	}
+
+} // namespace detail
+
+//=============================================================================
+// Matrix-Vector and Vector-Vector Activation Units
+
+/**
+ * \brief Cycles of Matrix_Vector_Activate_Batch, Matrix_Vector_Activate_Stream_Batch
+ *        and Matrix_Vector_Activate_MixedPrecision_Batch
+ *
+ * \tparam MatrixW	Width of the input matrix
+ * \tparam MatrixH	Heigth of the input matrix
+ * \tparam SIMD		Number of input columns computed in parallel
+ * \tparam PE		Number of output rows computed in parallel
+ * \tparam MMV		Number of output pixels computed in parallel
+ *
+ * \param reps		Number of input vectors, as passed to the block
+ */
+template<unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV = 1>
+constexpr cycles_t Matrix_Vector_Activate_Batch_cycles(unsigned const  reps) {
+	static_assert(MatrixW % SIMD == 0, "SIMD must divide MatrixW.");
+	static_assert(MatrixH % PE == 0, "PE must divide MatrixH.");
+	return  detail::mvau_cycles(MatrixW, MatrixH, SIMD, PE, reps);
+}
+
+/**
+ * \brief Latency of Matrix_Vector_Activate_Batch and Matrix_Vector_Activate_Stream_Batch
+ *
+ * The first output is complete after a full pass over the synapse fold.
+ */
+template<unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV = 1>
+constexpr cycles_t Matrix_Vector_Activate_Batch_latency() {
+	static_assert(MatrixW % SIMD == 0, "SIMD must divide MatrixW.");
+	return  MatrixW/SIMD;
+}
+
+/**
+ * \brief Cycles of Matrix_Vector_Activate_Stream_Stationary_Batch
+ *
+ * Every batch of up to BATCH vectors is computed in NF*SF cycles per vector and
+ * drained in further NF cycles per vector.
+ *
+ * \tparam BATCH	Number of input vectors sharing each streamed weight word
+ */
+template<unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned BATCH>
+constexpr cycles_t Matrix_Vector_Activate_Stream_Stationary_Batch_cycles(unsigned const  reps) {
+	static_assert(MatrixW % SIMD == 0, "SIMD must divide MatrixW.");
+	static_assert(MatrixH % PE == 0, "PE must divide MatrixH.");
+	return  cycles_t(reps) * (MatrixH/PE) * (MatrixW/SIMD + 1);
+}
+
+/**
+ * \brief Latency of Matrix_Vector_Activate_Stream_Stationary_Batch
+ *
+ * Outputs are only released once a whole batch has been computed.
+ */
+template<unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned BATCH>
+constexpr cycles_t Matrix_Vector_Activate_Stream_Stationary_Batch_latency(unsigned const  reps) {
+	return  cycles_t(std::min(reps, BATCH)) * (MatrixH/PE) * (MatrixW/SIMD) + 1;
+}
+
+/**
+ * \brief Cycles of Matrix_Matrix_Activate_Stream_Batch
+ *
+ * The streamed operand is buffered in NF*SF cycles before the NumVectors
+ * vectors are multiplied with it.
+ *
+ * \tparam NumVectors	Number of input vectors multiplied with each operand
+ *
+ * \param reps		Number of operands, as passed to the block
+ */
+template<unsigned MatrixW, unsigned MatrixH, unsigned NumVectors, unsigned SIMD, unsigned PE>
+constexpr cycles_t Matrix_Matrix_Activate_Stream_Batch_cycles(unsigned const  reps) {
+	static_assert(MatrixW % SIMD == 0, "SIMD must divide MatrixW.");
+	static_assert(MatrixH % PE == 0, "PE must divide MatrixH.");
+	return  cycles_t(reps) * (NumVectors + 1) * (MatrixH/PE) * (MatrixW/SIMD);
+}
+
+/**
+ * \brief Latency of Matrix_Matrix_Activate_Stream_Batch
+ */
+template<unsigned MatrixW, unsigned MatrixH, unsigned NumVectors, unsigned SIMD, unsigned PE>
+constexpr cycles_t Matrix_Matrix_Activate_Stream_Batch_latency() {
+	return  cycles_t(MatrixH/PE) * (MatrixW/SIMD) + MatrixW/SIMD;
+}
+
+/**
+ * \brief Cycles of Matrix_Vector_Activate_Grouped_Batch
+ *
+ * Each group takes the folds of its own MatrixH/Groups x MatrixW matrix.
+ *
+ * \tparam MatrixW	Width of the weight matrix of a group
+ * \tparam MatrixH	Heigth of the whole weight matrix
+ * \tparam Groups	Number of groups
+ *
+ * \param reps		Number of input vectors (all groups), as passed to the block
+ */
+template<unsigned MatrixW, unsigned MatrixH, unsigned Groups, unsigned SIMD, unsigned PE, unsigned MMV = 1>
+constexpr cycles_t Matrix_Vector_Activate_Grouped_Batch_cycles(unsigned const  reps) {
+	static_assert(MatrixH % (Groups * PE) == 0, "Groups*PE must divide MatrixH.");
+	return  detail::mvau_cycles(MatrixW, MatrixH, SIMD, PE, reps);
+}
+
+/**
+ * \brief Cycles of Matrix_Vector_Activate_Interleaved_Batch
+ *
+ * The interleaving reorders the folds of Matrix_Vector_Activate_Batch without
+ * adding any.
+ */
+template<unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned Interleave, unsigned MMV = 1>
+constexpr cycles_t Matrix_Vector_Activate_Interleaved_Batch_cycles(unsigned const  reps) {
+	static_assert((MatrixH / PE) % Interleave == 0, "Interleave must divide the neuron folds.");
+	return  detail::mvau_cycles(MatrixW, MatrixH, SIMD, PE, reps);
+}
+
+/**
+ * \brief Cycles of Recurrent_Cell_Batch
+ *
+ * Every time step takes the folds of the input-to-hidden and the
+ * hidden-to-hidden matrix, all gates being computed in parallel.
+ *
+ * \param seqLen	Number of time steps
+ */
+template<unsigned InputSize, unsigned HiddenSize, unsigned SIMD, unsigned PE>
+constexpr cycles_t Recurrent_Cell_Batch_cycles(unsigned const  seqLen) {
+	static_assert((InputSize % SIMD == 0) && (HiddenSize % SIMD == 0), "SIMD must divide InputSize and HiddenSize.");
+	static_assert(HiddenSize % PE == 0, "PE must divide HiddenSize.");
+	return  cycles_t(seqLen) * (HiddenSize/PE) * ((InputSize + HiddenSize)/SIMD);
+}
+
+/**
+ * \brief Cycles of Vector_Vector_Activate_Batch and Vector_Vector_Activate_Stream_Batch
+ *
+ * \tparam Channels	Number of channels
+ * \tparam Kernel_2	Kernel size, i.e. kernel height times kernel width
+ * \tparam SIMD		Number of kernel elements computed in parallel
+ * \tparam PE		Number of channels computed in parallel
+ * \tparam MMV		Number of output pixels computed in parallel
+ *
+ * \param reps		Number of output pixels, as passed to the block
+ */
+template<unsigned Channels, unsigned Kernel_2, unsigned SIMD, unsigned PE, unsigned MMV = 1>
+constexpr cycles_t Vector_Vector_Activate_Batch_cycles(unsigned const  reps) {
+	static_assert(Channels % PE == 0, "PE must divide Channels.");
+	static_assert(Kernel_2 % SIMD == 0, "SIMD must divide Kernel_2.");
+	return  cycles_t(reps) * (Channels/PE) * (Kernel_2/SIMD);
+}
+
+/**
+ * \brief Latency of Vector_Vector_Activate_Batch and Vector_Vector_Activate_Stream_Batch
+ */
+template<unsigned Channels, unsigned Kernel_2, unsigned SIMD, unsigned PE, unsigned MMV = 1>
+constexpr cycles_t Vector_Vector_Activate_Batch_latency() {
+	return  Kernel_2/SIMD;
+}
+
+//=============================================================================
+// Sliding Window Generators
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator and ConvolutionInputGenerator_Grouped
+ *
+ * Per frame, the initial ConvKernelDim input rows are buffered before every
+ * output row takes the longer of writing its windows and reading the next
+ * Stride input rows.
+ *
+ * \tparam ConvKernelDim	Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels		Number of Input Feature Maps
+ * \tparam IFMDim		Width and Heigth of the Input Feature Map (assumed square)
+ * \tparam OFMDim		Width and Heigth of the Output Feature Map (assumed square)
+ * \tparam SIMD			Number of input columns computed in parallel
+ * \tparam Stride		Stride of the convolutional kernel
+ * \tparam MMV			Number of pixels generated in parallel (ConvolutionInputGenerator_MMV)
+ * \tparam Dilation		Dilation of the kernel (ConvolutionInputGenerator_dws)
+ *
+ * \param numReps		Number of frames
+ */
+template<
+	unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMDim,
+	unsigned SIMD, unsigned Stride, unsigned MMV = 1, unsigned Dilation = 1
+>
+constexpr cycles_t ConvolutionInputGenerator_cycles(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	static_assert(OFMDim % MMV == 0, "MMV must divide OFMDim.");
+	return  detail::swg_cycles(ConvKernelDim, IFMChannels, IFMDim, OFMDim, SIMD, Stride, MMV, Dilation, numReps);
+}
+
+/**
+ * \brief Latency of ConvolutionInputGenerator and its MMV and dws variants
+ *
+ * The first window is written once the initial rows have been buffered.
+ */
+template<
+	unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMDim,
+	unsigned SIMD, unsigned Stride, unsigned MMV = 1, unsigned Dilation = 1
+>
+constexpr cycles_t ConvolutionInputGenerator_latency() {
+	return  cycles_t(IFMDim) * ((ConvKernelDim-1) * Dilation + 1) * (IFMChannels/SIMD) + 1;
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_dws
+ */
+template<
+	unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMDim,
+	unsigned SIMD, unsigned Stride, unsigned Dilation = 1
+>
+constexpr cycles_t ConvolutionInputGenerator_dws_cycles(unsigned const  numReps) {
+	return  ConvolutionInputGenerator_cycles<ConvKernelDim, IFMChannels, IFMDim, OFMDim, SIMD, Stride, 1, Dilation>(numReps);
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_MMV and ConvolutionInputGenerator_dws_MMV
+ */
+template<
+	unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMDim,
+	unsigned SIMD, unsigned Stride, unsigned MMV
+>
+constexpr cycles_t ConvolutionInputGenerator_MMV_cycles(unsigned const  numReps) {
+	return  ConvolutionInputGenerator_cycles<ConvKernelDim, IFMChannels, IFMDim, OFMDim, SIMD, Stride, MMV>(numReps);
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_kernel_stride and its MMV and dws variants
+ *
+ * The last output row only waits for the writing of its windows as no further
+ * input rows are due.
+ */
+template<
+	unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMDim,
+	unsigned SIMD, unsigned Stride, unsigned MMV = 1, unsigned Dilation = 1
+>
+constexpr cycles_t ConvolutionInputGenerator_kernel_stride_cycles(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	static_assert(OFMDim % MMV == 0, "MMV must divide OFMDim.");
+	constexpr unsigned  mf = IFMChannels/SIMD;
+	constexpr unsigned  kernel_extent = (ConvKernelDim-1) * Dilation + 1;
+	constexpr unsigned  cycles_write_block = (OFMDim * ConvKernelDim * ConvKernelDim * mf) / MMV;
+	constexpr unsigned  cycles_read_block = IFMDim * Stride * mf;
+	constexpr unsigned  max_cycles = std::max(cycles_write_block, cycles_read_block);
+	return  cycles_t(numReps) * (
+		IFMDim * kernel_extent * mf + cycles_t(OFMDim-1) * max_cycles + std::max(cycles_write_block, OFMDim)
+	);
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_NonSquare and ConvolutionInputGenerator_NonSquare_dws
+ *
+ * \tparam ConvKernelDim_x	Width of the convolutional kernel
+ * \tparam ConvKernelDim_y	Heigth of the convolutional kernel
+ * \tparam IFMDim_x		Width of the Input Feature Map
+ * \tparam IFMDim_y		Heigth of the Input Feature Map
+ * \tparam OFMDim_x		Width of the Output Feature Map
+ * \tparam OFMDim_y		Heigth of the Output Feature Map
+ * \tparam Dilation_x		Horizontal dilation (ConvolutionInputGenerator_NonSquare_Dilated)
+ * \tparam Dilation_y		Vertical dilation (ConvolutionInputGenerator_NonSquare_Dilated)
+ */
+template<
+	unsigned ConvKernelDim_x, unsigned ConvKernelDim_y, unsigned IFMChannels,
+	unsigned IFMDim_x, unsigned IFMDim_y, unsigned OFMDim_x, unsigned OFMDim_y,
+	unsigned SIMD, unsigned Stride_x, unsigned Stride_y,
+	unsigned Dilation_x = 1, unsigned Dilation_y = 1
+>
+constexpr cycles_t ConvolutionInputGenerator_NonSquare_cycles(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	constexpr unsigned  mf = IFMChannels/SIMD;
+	constexpr unsigned  cycles_write_block = OFMDim_x * ConvKernelDim_x * ConvKernelDim_y * mf;
+	constexpr unsigned  cycles_read_block = Stride_x * IFMDim_x * mf;
+	return  cycles_t(numReps) * (
+		IFMDim_x * ConvKernelDim_y * Dilation_y * mf + cycles_t(OFMDim_y) * std::max(cycles_write_block, cycles_read_block)
+	);
+}
+
+/**
+ * \brief Latency of ConvolutionInputGenerator_NonSquare and its dws and Dilated variants
+ */
+template<
+	unsigned ConvKernelDim_x, unsigned ConvKernelDim_y, unsigned IFMChannels,
+	unsigned IFMDim_x, unsigned IFMDim_y, unsigned OFMDim_x, unsigned OFMDim_y,
+	unsigned SIMD, unsigned Stride_x, unsigned Stride_y,
+	unsigned Dilation_x = 1, unsigned Dilation_y = 1
+>
+constexpr cycles_t ConvolutionInputGenerator_NonSquare_latency() {
+	return  cycles_t(IFMDim_x) * ConvKernelDim_y * Dilation_y * (IFMChannels/SIMD) + 1;
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_Dynamic for runtime dimensions
+ *
+ * \param IFMDim		Width and Heigth of the Input Feature Map, at most MaxIFMDim
+ * \param OFMDim		Width and Heigth of the Output Feature Map
+ * \param Stride		Stride of the convolutional kernel, at most MaxStride
+ * \param numReps		Number of frames
+ */
+template<unsigned ConvKernelDim, unsigned IFMChannels, unsigned MaxIFMDim, unsigned SIMD, unsigned MaxStride>
+constexpr cycles_t ConvolutionInputGenerator_Dynamic_cycles(
+	unsigned const  IFMDim, unsigned const  OFMDim, unsigned const  Stride, unsigned const  numReps
+) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	return  cycles_t(numReps) * (
+		cycles_t(ConvKernelDim) * IFMDim * (IFMChannels/SIMD) +
+		cycles_t(OFMDim) * std::max(OFMDim * ConvKernelDim * ConvKernelDim, Stride * IFMDim) * (IFMChannels/SIMD)
+	);
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_2D_kernel1
+ *
+ * Every input word is read in one cycle and forwarded unless it is skipped by the stride.
+ */
+template<unsigned IFMChannels, unsigned IFMDim, unsigned SIMD, unsigned Stride>
+constexpr cycles_t ConvolutionInputGenerator_2D_kernel1_cycles(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	return  cycles_t(numReps) * IFMDim * IFMDim * (IFMChannels/SIMD);
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_1D_kernel1
+ */
+template<unsigned IFMChannels, unsigned IFMDim, unsigned SIMD, unsigned Stride>
+constexpr cycles_t ConvolutionInputGenerator_1D_kernel1_cycles(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	return  cycles_t(numReps) * IFMDim * (IFMChannels/SIMD);
+}
+
+/**
+ * \brief Latency of the kernel1 sliding window generators
+ */
+constexpr cycles_t ConvolutionInputGenerator_kernel1_latency() {
+	return  1;
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_1D_parallel
+ */
+template<unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMDim, unsigned Stride, unsigned SIMD>
+constexpr cycles_t ConvolutionInputGenerator_1D_parallel_cycles(unsigned const  numReps) {
+	return  cycles_t(numReps) * (ConvKernelDim + OFMDim);
+}
+
+/**
+ * \brief Latency of ConvolutionInputGenerator_1D_parallel
+ */
+template<unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMDim, unsigned Stride, unsigned SIMD>
+constexpr cycles_t ConvolutionInputGenerator_1D_parallel_latency() {
+	return  ConvKernelDim + 1;
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_2D_parallel, one input word per cycle
+ */
+template<unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMDim, unsigned Stride, unsigned SIMD>
+constexpr cycles_t ConvolutionInputGenerator_2D_parallel_cycles(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	return  cycles_t(numReps) * IFMDim * IFMDim * (IFMChannels/SIMD);
+}
+
+/**
+ * \brief Latency of ConvolutionInputGenerator_2D_parallel, up to the last input word of the first window
+ */
+template<unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMDim, unsigned Stride, unsigned SIMD>
+constexpr cycles_t ConvolutionInputGenerator_2D_parallel_latency() {
+	return  ((ConvKernelDim-1) * IFMDim + ConvKernelDim) * (IFMChannels/SIMD) + 1;
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_1D_dws_naive
+ *
+ * The whole input row is buffered before the windows are written.
+ */
+template<
+	unsigned ConvKernelDim_x, unsigned IFMChannels, unsigned IFMDim_x, unsigned OFMDim_x,
+	unsigned Stride_x, unsigned Dilation_x, unsigned SIMD
+>
+constexpr cycles_t ConvolutionInputGenerator_1D_dws_naive_cycles(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	constexpr unsigned  mf = IFMChannels/SIMD;
+	return  cycles_t(numReps) * (IFMDim_x * mf + OFMDim_x * ConvKernelDim_x * mf);
+}
+
+/**
+ * \brief Latency of ConvolutionInputGenerator_1D_dws_naive
+ */
+template<
+	unsigned ConvKernelDim_x, unsigned IFMChannels, unsigned IFMDim_x, unsigned OFMDim_x,
+	unsigned Stride_x, unsigned Dilation_x, unsigned SIMD
+>
+constexpr cycles_t ConvolutionInputGenerator_1D_dws_naive_latency() {
+	return  cycles_t(IFMDim_x) * (IFMChannels/SIMD) + 1;
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_1D
+ *
+ * One window word is written every cycle after a single cycle of lead-in.
+ */
+template<unsigned ConvKernelDim_x, unsigned IFMChannels, unsigned IFMDim_x, unsigned OFMDim_x, unsigned Stride_x, unsigned SIMD>
+constexpr cycles_t ConvolutionInputGenerator_1D_cycles(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	return  cycles_t(numReps) * (1 + OFMDim_x * ConvKernelDim_x * (IFMChannels/SIMD));
+}
+
+/**
+ * \brief Latency of ConvolutionInputGenerator_1D
+ */
+template<unsigned ConvKernelDim_x, unsigned IFMChannels, unsigned IFMDim_x, unsigned OFMDim_x, unsigned Stride_x, unsigned SIMD>
+constexpr cycles_t ConvolutionInputGenerator_1D_latency() {
+	return  1;
+}
+
+/**
+ * \brief Cycles of ConvolutionInputGenerator_1D_dws and ConvolutionInputGenerator_1D_dws_stride
+ *
+ * The output is delayed until all but the last channel fold of the first window have been read.
+ */
+template<unsigned ConvKernelDim_x, unsigned IFMChannels, unsigned IFMDim_x, unsigned OFMDim_x, unsigned Stride_x, unsigned SIMD>
+constexpr cycles_t ConvolutionInputGenerator_1D_dws_cycles(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	constexpr unsigned  mf = IFMChannels/SIMD;
+	return  cycles_t(numReps) * (1 + (mf-1) * (ConvKernelDim_x-1) + OFMDim_x * ConvKernelDim_x * mf);
+}
+
+/**
+ * \brief Latency of ConvolutionInputGenerator_1D_dws and ConvolutionInputGenerator_1D_dws_stride
+ */
+template<unsigned ConvKernelDim_x, unsigned IFMChannels, unsigned IFMDim_x, unsigned OFMDim_x, unsigned Stride_x, unsigned SIMD>
+constexpr cycles_t ConvolutionInputGenerator_1D_dws_latency() {
+	return  1 + (IFMChannels/SIMD - 1) * (ConvKernelDim_x-1) + 1;
+}
+
+/**
+ * \brief Lower bound on the cycles of the sliding window generators scheduled by a while loop
+ *
+ * Applies to ConvolutionInputGenerator_Padded, _LineBuffer, _3D, _Transposed as
+ * well as the _NonSquare_MMV, _NonSquare_Dilated_MMV, _NonSquare_dws_MMV and
+ * _1D_MMV variants. These read and write at most one word per cycle each so
+ * that a frame takes at least as long as its larger stream. For 1D generators,
+ * pass a unit kernel and feature map heigth. For the 3D generator, fold the
+ * temporal dimension into the heigth and ConvKernelDim_y.
+ *
+ * \tparam MMV		Number of output pixels written in parallel
+ */
+template<
+	unsigned ConvKernelDim_x, unsigned ConvKernelDim_y, unsigned IFMChannels,
+	unsigned IFMDim_x, unsigned IFMDim_y, unsigned OFMDim_x, unsigned OFMDim_y,
+	unsigned SIMD, unsigned MMV = 1
+>
+constexpr cycles_t ConvolutionInputGenerator_cycles_bound(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	static_assert(OFMDim_x % MMV == 0, "MMV must divide OFMDim_x.");
+	constexpr unsigned  mf = IFMChannels/SIMD;
+	constexpr cycles_t  words_in  = cycles_t(IFMDim_x) * IFMDim_y * mf;
+	constexpr cycles_t  words_out = cycles_t(OFMDim_x/MMV) * OFMDim_y * ConvKernelDim_x * ConvKernelDim_y * mf;
+	return  cycles_t(numReps) * std::max(words_in, words_out);
+}
+
+/**
+ * \brief Lower bound on the cycles of ConvolutionInputGenerator_Shared
+ *
+ * The output words of all branches share one write per cycle.
+ *
+ * \tparam Windows	SWGWindow of every branch
+ */
+template<unsigned IFMChannels, unsigned IFMDim, unsigned SIMD, typename... Windows>
+constexpr cycles_t ConvolutionInputGenerator_Shared_cycles_bound(unsigned const  numReps) {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	constexpr unsigned  mf = IFMChannels/SIMD;
+	constexpr cycles_t  words_out[] = { cycles_t(Windows::ofm_dim(IFMDim)) * Windows::ofm_dim(IFMDim) * Windows::kernel * Windows::kernel * mf... };
+	cycles_t  total = 0;
+	for (cycles_t const  w : words_out)  total += w;
+	return  cycles_t(numReps) * std::max(cycles_t(IFMDim) * IFMDim * mf, total);
+}
+
+//=============================================================================
+// Pooling
+
+/**
+ * \brief Cycles of StreamingMaxPool_Batch and StreamingMaxPool_Precision_Batch
+ *
+ * Every output row of pixels is drained in a loop of its own after its PoolDim input rows have been read.
+ *
+ * \tparam ImgDim	Width and Heigth of the Input Feature Map (assumed square)
+ * \tparam PoolDim	Dimension of the Max Pool kernel (assumed square)
+ */
+template<unsigned ImgDim, unsigned PoolDim>
+constexpr cycles_t StreamingMaxPool_Batch_cycles(unsigned const  numReps) {
+	static_assert(ImgDim % PoolDim == 0, "PoolDim must divide ImgDim.");
+	return  cycles_t(numReps) * (ImgDim/PoolDim) * (PoolDim * ImgDim + ImgDim/PoolDim);
+}
+
+/**
+ * \brief Latency of StreamingMaxPool_Batch
+ */
+template<unsigned ImgDim, unsigned PoolDim>
+constexpr cycles_t StreamingMaxPool_Batch_latency() {
+	return  cycles_t(PoolDim) * ImgDim + 1;
+}
+
+/**
+ * \brief Cycles of StreamingMaxPool_Precision_kernel_stride_Batch
+ *
+ * The pooling windows are closed while the input is streamed so that every input word takes one cycle.
+ */
+template<
+	unsigned IFMDim_x, unsigned IFMDim_y, unsigned PoolDim_x, unsigned PoolDim_y,
+	unsigned Stride_x, unsigned Stride_y, unsigned NumChannels, unsigned PE
+>
+constexpr cycles_t StreamingMaxPool_Precision_kernel_stride_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumChannels % PE == 0, "PE must divide NumChannels.");
+	return  cycles_t(numReps) * IFMDim_y * IFMDim_x * (NumChannels/PE);
+}
+
+/**
+ * \brief Latency of StreamingMaxPool_Precision_kernel_stride_Batch
+ */
+template<
+	unsigned IFMDim_x, unsigned IFMDim_y, unsigned PoolDim_x, unsigned PoolDim_y,
+	unsigned Stride_x, unsigned Stride_y, unsigned NumChannels, unsigned PE
+>
+constexpr cycles_t StreamingMaxPool_Precision_kernel_stride_Batch_latency() {
+	return  cycles_t((PoolDim_y-1) * IFMDim_x + PoolDim_x - 1) * (NumChannels/PE) + 1;
+}
+
+/**
+ * \brief Cycles of Pool_batch
+ *
+ * \param reps		Number of output pixels, as passed to the block
+ */
+template<unsigned Channels, unsigned PE, unsigned TotalK>
+constexpr cycles_t Pool_batch_cycles(unsigned const  reps) {
+	static_assert(Channels % PE == 0, "PE must divide Channels.");
+	return  cycles_t(reps) * (Channels/PE) * TotalK;
+}
+
+/**
+ * \brief Cycles of Pool_MMV_batch
+ *
+ * \param reps		Number of groups of MMV output pixels, as passed to the block
+ */
+template<unsigned Channels, unsigned PE, unsigned TotalK, unsigned MMV>
+constexpr cycles_t Pool_MMV_batch_cycles(unsigned const  reps) {
+	static_assert(Channels % PE == 0, "PE must divide Channels.");
+	return  cycles_t(reps) * (Channels/PE) * TotalK;
+}
+
+/**
+ * \brief Latency of Pool_batch
+ */
+template<unsigned Channels, unsigned PE, unsigned TotalK>
+constexpr cycles_t Pool_batch_latency() {
+	return  TotalK;
+}
+
+/**
+ * \brief Cycles of GlobalAccPool_Batch and GlobalAvgPool_Batch
+ *
+ * \tparam NumPixels	Number of pixels per frame
+ */
+template<unsigned NumPixels, unsigned NumChannels, unsigned PECount>
+constexpr cycles_t GlobalAccPool_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumChannels % PECount == 0, "PECount must divide NumChannels.");
+	return  cycles_t(numReps) * (NumPixels + 1) * (NumChannels/PECount);
+}
+
+/**
+ * \brief Latency of GlobalAccPool_Batch and GlobalAvgPool_Batch
+ */
+template<unsigned NumPixels, unsigned NumChannels, unsigned PECount>
+constexpr cycles_t GlobalAccPool_Batch_latency() {
+	return  cycles_t(NumPixels) * (NumChannels/PECount) + 1;
+}
+
+/**
+ * \brief Cycles of LabelSelect_Batch
+ *
+ * The input classes are scanned before the NumTop labels are written.
+ */
+template<unsigned NumClasses, unsigned PECount, unsigned NumTop>
+constexpr cycles_t LabelSelect_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumClasses % PECount == 0, "PECount must divide NumClasses.");
+	return  cycles_t(numReps) * (NumClasses/PECount + NumTop);
+}
+
+/**
+ * \brief Latency of LabelSelect_Batch
+ */
+template<unsigned NumClasses, unsigned PECount, unsigned NumTop>
+constexpr cycles_t LabelSelect_Batch_latency() {
+	return  NumClasses/PECount + 1;
+}
+
+/**
+ * \brief Cycles of PixelArgmax_Batch
+ */
+template<unsigned NumClasses, unsigned PECount, unsigned NumPixels>
+constexpr cycles_t PixelArgmax_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumClasses % PECount == 0, "PECount must divide NumClasses.");
+	return  cycles_t(numReps) * NumPixels * (NumClasses/PECount);
+}
+
+/**
+ * \brief Cycles of NonMaxSuppression_Batch
+ *
+ * The candidates are scanned, the suppression matrix is computed by PE IoU
+ * units, resolved over TopN cycles and the TopN detections are written.
+ */
+template<unsigned NumCandidates, unsigned TopN, unsigned PE>
+constexpr cycles_t NonMaxSuppression_Batch_cycles(unsigned const  numReps) {
+	static_assert(TopN % PE == 0, "PE must divide TopN.");
+	return  cycles_t(numReps) * (NumCandidates + TopN*(TopN/PE) + 2*TopN);
+}
+
+/**
+ * \brief Cycles of RoIAlign_Batch
+ *
+ * The feature map is buffered before its crops are written.
+ */
+template<unsigned FMDim_x, unsigned FMDim_y, unsigned NumChannels, unsigned SIMD, unsigned CropDim, unsigned NumBoxes>
+constexpr cycles_t RoIAlign_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumChannels % SIMD == 0, "SIMD must divide NumChannels.");
+	return  cycles_t(numReps) * (FMDim_x * FMDim_y + NumBoxes * CropDim * CropDim) * (NumChannels/SIMD);
+}
+
+/**
+ * \brief Cycles of RoIAlign_External_Batch, one cycle per feature-map read
+ */
+template<unsigned NumChannels, unsigned SIMD, unsigned CropDim, unsigned NumBoxes, bool Bilinear>
+constexpr cycles_t RoIAlign_External_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumChannels % SIMD == 0, "SIMD must divide NumChannels.");
+	return  cycles_t(numReps) * NumBoxes * CropDim * CropDim * (NumChannels/SIMD) * (Bilinear? 4 : 1);
+}
+
+/**
+ * \brief Cycles of EarlyExitSelect_Batch
+ */
+template<unsigned NumClasses, unsigned PECount>
+constexpr cycles_t EarlyExitSelect_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumClasses % PECount == 0, "PECount must divide NumClasses.");
+	return  cycles_t(numReps) * (NumClasses/PECount);
+}
+
+/**
+ * \brief Cycles of EarlyExitGate_Batch
+ *
+ * The exited frames are drained at the same rate as the surviving ones are forwarded.
+ */
+template<unsigned NumWords>
+constexpr cycles_t EarlyExitGate_Batch_cycles(unsigned const  numReps) {
+	return  cycles_t(numReps) * NumWords;
+}
+
+//=============================================================================
+// Stream Tools
+
+/**
+ * \brief Cycles of StreamingDataWidthConverter_Batch
+ *
+ * Down-conversion takes a cycle per output word and up-conversion a cycle per input word.
+ */
+template<unsigned InWidth, unsigned OutWidth, unsigned NumInWords>
+constexpr cycles_t StreamingDataWidthConverter_Batch_cycles(unsigned const  numReps) {
+	static_assert((InWidth % OutWidth == 0) || (OutWidth % InWidth == 0), "");
+	return  cycles_t(numReps) * NumInWords * (InWidth > OutWidth? InWidth/OutWidth : 1);
+}
+
+/**
+ * \brief Latency of StreamingDataWidthConverter_Batch
+ */
+template<unsigned InWidth, unsigned OutWidth, unsigned NumInWords>
+constexpr cycles_t StreamingDataWidthConverter_Batch_latency() {
+	return  InWidth < OutWidth? OutWidth/InWidth : 1;
+}
+
+/**
+ * \brief Lower bound on the cycles of StreamingDataWidthConverterGeneralized_Batch
+ *
+ * Reading and writing overlap so that a frame takes at least as long as its
+ * larger stream. A word may be delayed by a cycle whenever the residue leaves
+ * no room for the next input word.
+ */
+template<
+	unsigned InWidth, unsigned OutWidth, unsigned NumInWords,
+	unsigned NumOutWords = (NumInWords * InWidth + OutWidth - 1) / OutWidth
+>
+constexpr cycles_t StreamingDataWidthConverterGeneralized_Batch_cycles_bound(unsigned const  numReps) {
+	return  cycles_t(numReps) * std::max(NumInWords, NumOutWords);
+}
+
+/**
+ * \brief Cycles of SpaceToDepth_Batch
+ *
+ * A row of Block input rows is written while the previous one is read, so the
+ * last one is read after the input has ended.
+ */
+template<unsigned ImgDim, unsigned Block, unsigned NumChannels, unsigned SIMD>
+constexpr cycles_t SpaceToDepth_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumChannels % SIMD == 0, "SIMD must divide NumChannels.");
+	return  numReps? (cycles_t(numReps) * (ImgDim/Block) + 1) * Block * ImgDim * (NumChannels/SIMD) : 0;
+}
+
+/**
+ * \brief Latency of SpaceToDepth_Batch, the buffering of a row of Block input rows
+ */
+template<unsigned ImgDim, unsigned Block, unsigned NumChannels, unsigned SIMD>
+constexpr cycles_t SpaceToDepth_Batch_latency() {
+	return  cycles_t(Block) * ImgDim * (NumChannels/SIMD) + 1;
+}
+
+/**
+ * \brief Cycles of DepthToSpace_Batch
+ *
+ * \tparam ImgDim		Width and Heigth of the input feature map
+ * \tparam NumChannels	Number of channels of the output feature map
+ */
+template<unsigned ImgDim, unsigned Block, unsigned NumChannels, unsigned SIMD>
+constexpr cycles_t DepthToSpace_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumChannels % SIMD == 0, "SIMD must divide NumChannels.");
+	return  numReps? (cycles_t(numReps) * ImgDim + 1) * ImgDim * Block * Block * (NumChannels/SIMD) : 0;
+}
+
+/**
+ * \brief Latency of DepthToSpace_Batch, the buffering of an input row
+ */
+template<unsigned ImgDim, unsigned Block, unsigned NumChannels, unsigned SIMD>
+constexpr cycles_t DepthToSpace_Batch_latency() {
+	return  cycles_t(ImgDim) * Block * Block * (NumChannels/SIMD) + 1;
+}
+
+/**
+ * \brief Cycles of NCHWToNHWC_Batch and NHWCToNCHW_Batch
+ *
+ * A frame is written while the previous one is read, so the last one is read
+ * after the input has ended.
+ */
+template<unsigned NumPixels, unsigned NumChannels, unsigned SIMD>
+constexpr cycles_t LayoutTranspose_Batch_cycles(unsigned const  numReps) {
+	static_assert((NumPixels % SIMD == 0) && (NumChannels % SIMD == 0), "SIMD must divide NumPixels and NumChannels.");
+	return  numReps? (cycles_t(numReps) + 1) * (NumPixels * NumChannels / SIMD) : 0;
+}
+
+/**
+ * \brief Latency of NCHWToNHWC_Batch and NHWCToNCHW_Batch, the buffering of a frame
+ */
+template<unsigned NumPixels, unsigned NumChannels, unsigned SIMD>
+constexpr cycles_t LayoutTranspose_Batch_latency() {
+	return  cycles_t(NumPixels) * NumChannels / SIMD + 1;
+}
+
+/**
+ * \brief Cycles of EmbeddingLookup_Batch and EmbeddingLookup_External_Batch
+ *
+ * One word of an embedding vector per cycle, after CachedRows rows have been
+ * copied into the cache of the external variant, which only the first call does.
+ * Memory stalls are not modelled.
+ */
+template<unsigned EmbeddingDim, unsigned SIMD, unsigned CachedRows = 0>
+constexpr cycles_t EmbeddingLookup_Batch_cycles(unsigned const  numReps) {
+	static_assert(EmbeddingDim % SIMD == 0, "SIMD must divide EmbeddingDim.");
+	return  numReps? (cycles_t(CachedRows) + numReps) * (EmbeddingDim/SIMD) : 0;
+}
+
+/**
+ * \brief Cycles of StreamStats_Batch
+ *
+ * One word per cycle, plus the clearing and the writing out of the statistics.
+ */
+template<unsigned NumChannels, unsigned PE, unsigned NumPixels, unsigned Bins>
+constexpr cycles_t StreamStats_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumChannels % PE == 0, "PE must divide NumChannels.");
+	return  cycles_t(numReps) * NumPixels * (NumChannels/PE) + 2*Bins + NumChannels/PE;
+}
+
+/**
+ * \brief Cycles of SLRCrossing_Batch, one word per cycle
+ */
+template<unsigned NumWords>
+constexpr cycles_t SLRCrossing_Batch_cycles(unsigned const  numReps) {
+	return  cycles_t(numReps) * NumWords;
+}
+
+/**
+ * \brief Latency of SLRCrossing_Batch, one cycle per register hop
+ */
+template<unsigned Stages>
+constexpr cycles_t SLRCrossing_Batch_latency() {
+	return  Stages;
+}
+
+/**
+ * \brief Cycles of Stream2Link_Batch and Link2Stream_Batch, one beat per cycle
+ *
+ * Every packet adds its header beat; stalls for credits are not included.
+ */
+template<unsigned NumWords, unsigned PacketWords>
+constexpr cycles_t Stream2Link_Batch_cycles(unsigned const  numReps) {
+	return  cycles_t(numReps) * (NumWords + (NumWords + PacketWords - 1) / PacketWords);
+}
+
+/**
+ * \brief Cycles of FMPadding_nonsquare_Batch and FMPadding_Batch
+ *
+ * Every output word, padding or not, takes one cycle.
+ *
+ * \tparam OutputDim_x	Padded width of the output feature map
+ * \tparam OutputDim_y	Padded heigth of the output feature map
+ */
+template<unsigned OutputDim_x, unsigned OutputDim_y, unsigned NumChannels, unsigned SIMD>
+constexpr cycles_t FMPadding_nonsquare_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumChannels % SIMD == 0, "SIMD must divide NumChannels.");
+	return  cycles_t(numReps) * OutputDim_x * OutputDim_y * (NumChannels/SIMD);
+}
+
+/**
+ * \brief Latency of FMPadding_nonsquare_Batch and FMPadding_Batch
+ */
+constexpr cycles_t FMPadding_latency() {
+	return  1;
+}
+
+//=============================================================================
+// Upsampling
+
+/**
+ * \brief Cycles of UpsampleNearestNeighbour_NonSquare_Batch, UpsampleNearestNeighbour_MMV_Batch
+ *        and, with a square feature map, UpsampleNearestNeighbour_Batch
+ *
+ * Every output word takes one cycle, MMV pixels being written in parallel.
+ */
+template<unsigned OFMDim_x, unsigned OFMDim_y, unsigned IFMDim_x, unsigned IFMDim_y, unsigned MMV = 1>
+constexpr cycles_t UpsampleNearestNeighbour_Batch_cycles(unsigned const  numReps) {
+	static_assert(OFMDim_x % MMV == 0, "MMV must divide OFMDim_x.");
+	return  cycles_t(numReps) * (OFMDim_x/MMV) * OFMDim_y;
+}
+
+/**
+ * \brief Cycles of UpsampleNearestNeighbour_1D called numReps times
+ */
+template<unsigned OFMDim, unsigned IFMDim>
+constexpr cycles_t UpsampleNearestNeighbour_1D_cycles(unsigned const  numReps) {
+	return  cycles_t(numReps) * OFMDim;
+}
+
+/**
+ * \brief Cycles of UpsampleBilinear_Batch
+ *
+ * Every output fold takes one cycle, the input rows being read in the shadow of the output.
+ */
+template<unsigned OFMDim, unsigned IFMDim, unsigned NumChannels, unsigned PE>
+constexpr cycles_t UpsampleBilinear_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumChannels % PE == 0, "PE must divide NumChannels.");
+	return  cycles_t(numReps) * OFMDim * OFMDim * (NumChannels/PE);
+}
+
+/**
+ * \brief Cycles of DownsampleBilinear_Batch and DownsampleArea_Batch, also of their _Dynamic_ variants
+ *
+ * Every input fold takes one cycle, the output pixels being written in the shadow of the input.
+ */
+template<unsigned IFMDim_x, unsigned IFMDim_y, unsigned NumChannels, unsigned PE>
+constexpr cycles_t Downsample_Batch_cycles(unsigned const  numReps) {
+	static_assert(NumChannels % PE == 0, "PE must divide NumChannels.");
+	return  cycles_t(numReps) * IFMDim_x * IFMDim_y * (NumChannels/PE);
+}
+
+/**
+ * \brief Latency of the upsampling blocks
+ *
+ * The first output pixel is a copy of, or interpolated from, the first input pixel only.
+ */
+constexpr cycles_t Upsample_latency() {
+	return  1;
+}
+
+//=============================================================================
+// Overlay
+
+/**
+ * \brief Cycles of one layer descriptor of Overlay_Execute
+ *
+ * The slowest of the sliding window generator and the matrix vector unit, which
+ * take the cycles of ConvolutionInputGenerator_Dynamic over the padded input and
+ * NF*SF cycles per output pixel. The prefetch of the weights of the next
+ * descriptor, one cycle per weight tile, is hidden unless it takes longer.
+ *
+ * \param kernel		Kernel dimension
+ * \param stride		Stride of the kernel
+ * \param padded_dim	Width and height of the zero-padded input feature map
+ * \param ifm_ch		Number of input channels
+ * \param ofm_ch		Number of output channels computed
+ * \param next_tiles	Weight tiles of the next descriptor
+ * \param numReps		Number of frames
+ */
+template<unsigned SIMD, unsigned PE>
+constexpr cycles_t Overlay_Layer_cycles(
+	unsigned const  kernel, unsigned const  stride, unsigned const  padded_dim, unsigned const  ifm_ch,
+	unsigned const  ofm_ch, unsigned const  next_tiles, unsigned const  numReps
+) {
+	return  std::max<cycles_t>(cycles_t(next_tiles), cycles_t(numReps) * std::max<cycles_t>(
+		cycles_t(kernel) * padded_dim * (ifm_ch/SIMD) +
+		cycles_t((padded_dim - kernel) / stride + 1) * std::max(((padded_dim - kernel) / stride + 1) * kernel * kernel, stride * padded_dim) * (ifm_ch/SIMD),
+		cycles_t((padded_dim - kernel) / stride + 1) * ((padded_dim - kernel) / stride + 1) * (kernel * kernel * ifm_ch / SIMD) * (ofm_ch / PE)
+	));
+}
+
+#endif
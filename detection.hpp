@@ -0,0 +1,539 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+/*******************************************************************************
+ *
+ *  \file detection.hpp
+ *
+ *  Library of templated HLS functions for BNN deployment.
+ *  This file lists the post-processing blocks of detection heads, which
+ *  reduce the candidate boxes of a frame to the final detections.
+ *
+ *  A box is streamed as one word of a DetectionBox, its score and the
+ *  corners of an axis-aligned rectangle in unsigned fixed-point coordinates.
+ *  The crops of the RoI align blocks take boxes in feature-map pixels with
+ *  FracBits fraction bits, pixel (x, y) covering [x, x+1) x [y, y+1).
+ *
+ *******************************************************************************/
+
+#ifndef DETECTION_HPP
+#define DETECTION_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "utils.hpp"
+#include "maxpool.h"
+#include "slidingwindow.h"
+
+/**
+ * \brief   Word format of a detection box
+ *
+ * Layout from the LSB: score, x1, y1, x2, y2, with x1 <= x2 and y1 <= y2. The score is stored
+ * bit by bit, so it may be of any ap_int, ap_uint or ap_fixed type. The coordinates are
+ * unsigned and may have any number of fraction bits, which the IoU does not depend on.
+ *
+ * \tparam     TS    Datatype of the score, an ap_int, ap_uint, ap_fixed or ap_ufixed
+ * \tparam     TC    Datatype of the coordinates, an ap_uint
+ */
+template<typename TS, typename TC>
+struct DetectionBox {
+  static_assert(!TC::sign_flag, "Box coordinates must be unsigned");
+  static constexpr unsigned int  width = TS::width + 4*TC::width;
+  using type = ap_uint<width>;
+
+  static type pack(TS const &score, TC const &x1, TC const &y1, TC const &x2, TC const &y2) {
+#pragma HLS inline
+    type  t;
+    t(TS::width - 1, 0) = score.range(TS::width - 1, 0);
+    t(TS::width + 1*TC::width - 1, TS::width + 0*TC::width) = x1;
+    t(TS::width + 2*TC::width - 1, TS::width + 1*TC::width) = y1;
+    t(TS::width + 3*TC::width - 1, TS::width + 2*TC::width) = x2;
+    t(TS::width + 4*TC::width - 1, TS::width + 3*TC::width) = y2;
+    return  t;
+  }
+  static TS score(type const &t) {
+#pragma HLS inline
+    TS  score;
+    score.range(TS::width - 1, 0) = t(TS::width - 1, 0);
+    return  score;
+  }
+  /** Coordinate i of x1, y1, x2, y2 */
+  static TC coord(type const &t, unsigned int const  i) {
+#pragma HLS inline
+    return  TC(t(TS::width + (i+1)*TC::width - 1, TS::width + i*TC::width));
+  }
+};
+
+namespace detail {
+
+/**
+ * \brief   Whether the intersection over union of two boxes exceeds iou_threshold / 2^IoUBits
+ *
+ * Compares the cross products of the integer areas, so that no division is needed.
+ */
+template<typename TS, typename TC, unsigned int IoUBits>
+bool iou_exceeds(typename DetectionBox<TS, TC>::type const &a, typename DetectionBox<TS, TC>::type const &b,
+                 ap_uint<IoUBits> const &iou_threshold) {
+#pragma HLS INLINE
+  using Box = DetectionBox<TS, TC>;
+  constexpr unsigned int  W = TC::width;
+  TC const  ax1 = Box::coord(a, 0), ay1 = Box::coord(a, 1), ax2 = Box::coord(a, 2), ay2 = Box::coord(a, 3);
+  TC const  bx1 = Box::coord(b, 0), by1 = Box::coord(b, 1), bx2 = Box::coord(b, 2), by2 = Box::coord(b, 3);
+
+  TC const  ix1 = ax1 > bx1? ax1 : bx1;
+  TC const  iy1 = ay1 > by1? ay1 : by1;
+  TC const  ix2 = ax2 < bx2? ax2 : bx2;
+  TC const  iy2 = ay2 < by2? ay2 : by2;
+  ap_uint<W> const  iw = ix2 > ix1? ap_uint<W>(ix2 - ix1) : ap_uint<W>(0);
+  ap_uint<W> const  ih = iy2 > iy1? ap_uint<W>(iy2 - iy1) : ap_uint<W>(0);
+
+  ap_uint<2*W> const  inter = iw * ih;
+  ap_uint<2*W> const  area_a = ap_uint<W>(ax2 - ax1) * ap_uint<W>(ay2 - ay1);
+  ap_uint<2*W> const  area_b = ap_uint<W>(bx2 - bx1) * ap_uint<W>(by2 - by1);
+  ap_uint<2*W+1> const  uni = area_a + area_b - inter;
+
+  ap_uint<2*W+IoUBits> const  lhs = ap_uint<2*W+IoUBits>(inter) << IoUBits;
+  ap_uint<2*W+1+IoUBits> const  rhs = iou_threshold * uni;
+  return  lhs > rhs;
+}
+
+} // namespace detail
+
+/**
+ * \brief   Non-maximum suppression - reduces the candidate boxes of a frame to the surviving detections
+ *
+ * Runs in three phases per frame:
+ *  - The NumCandidates input boxes are filtered by score_threshold and the TopN highest-scoring ones
+ *    are kept in a sorted list, one box per cycle, by the insertion of LabelSelect_Tournament_Batch.
+ *  - The suppression matrix of the kept boxes is computed by PE parallel IoU units, box j being
+ *    suppressed by a box i of higher score if their IoU exceeds iou_threshold / 2^IoUBits.
+ *    This takes TopN*TopN/PE cycles.
+ *  - The greedy suppression is resolved in score order over TopN cycles, a surviving box removing
+ *    all the boxes it suppresses.
+ *
+ * Exactly TopN boxes are written per frame, the surviving ones in descending score order followed
+ * by all-zero words, so that a Stream2Mem_Batch of fixed size receives the detections. Invalid
+ * entries are recognized by a score not above a non-negative score_threshold. Equal scores are ordered by their
+ * position in the input. A class-aware NMS either runs one instance per class or offsets the
+ * boxes of every class into a disjoint coordinate range.
+ *
+ * \tparam     NumCandidates    Number of input boxes per frame
+ * \tparam     TopN             Number of the highest-scoring boxes considered and output
+ * \tparam     PE               Number of IoU units, dividing TopN
+ * \tparam     TS               Datatype of the scores
+ * \tparam     TC               Datatype of the coordinates, an ap_uint
+ * \tparam     IoUBits          Number of fraction bits of the IoU threshold
+ *
+ * \param      in               Input stream of candidate boxes
+ * \param      out              Output stream of detections
+ * \param      score_threshold  Score a box must exceed to be considered
+ * \param      iou_threshold    IoU, in units of 2^-IoUBits, above which the lower-scoring box is suppressed
+ * \param      numReps          Number of frames
+ *
+ */
+template<
+  unsigned int NumCandidates, unsigned int TopN, unsigned int PE,
+  typename TS, typename TC, unsigned int IoUBits = 8
+>
+void NonMaxSuppression_Batch(
+  hls::stream<typename DetectionBox<TS, TC>::type> &in,
+  hls::stream<typename DetectionBox<TS, TC>::type> &out,
+  TS const &score_threshold, ap_uint<IoUBits> const &iou_threshold,
+  unsigned int const  numReps
+) {
+  static_assert(TopN <= NumCandidates, "TopN must not exceed NumCandidates");
+  static_assert(TopN % PE == 0, "PE must divide TopN");
+  using box_t = typename DetectionBox<TS, TC>::type;
+  constexpr unsigned int  CF = TopN / PE;
+
+  TS     topscore[TopN];
+  box_t  topbox[TopN];
+  bool   topvalid[TopN];
+#pragma HLS ARRAY_PARTITION variable=topscore complete dim=1
+#pragma HLS ARRAY_PARTITION variable=topbox complete dim=1
+#pragma HLS ARRAY_PARTITION variable=topvalid complete dim=1
+  ap_uint<TopN>  supp[TopN];
+
+  for(unsigned int  reps = 0; reps < numReps; reps++) {
+    for(unsigned int  i = 0; i < TopN; i++) {
+#pragma HLS UNROLL
+      topvalid[i] = false;
+    }
+
+    // Score filter and top-N selection
+    for(unsigned int  c = 0; c < NumCandidates; c++) {
+#pragma HLS pipeline style=flp II=1
+      box_t const  box = in.read();
+      TS const  score = DetectionBox<TS, TC>::score(box);
+      if(score > score_threshold) {
+        detail::top_insert<TopN>(score, box, topscore, topbox, topvalid);
+      }
+    }
+
+    // Suppression matrix, bit j of row i set if box i suppresses box j
+    unsigned int  i = 0;
+    unsigned int  cf = 0;
+    ap_uint<TopN>  row = 0;
+    for(unsigned int  t = 0; t < TopN * CF; t++) {
+#pragma HLS pipeline style=flp II=1
+      box_t const  a = topbox[i];
+      for(unsigned int  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        unsigned int const  j = cf*PE + pe;
+        row[j] = (j > i) && topvalid[j] && detail::iou_exceeds<TS, TC, IoUBits>(a, topbox[j], iou_threshold);
+      }
+      if(++cf == CF) {
+        supp[i] = row;
+        cf = 0;
+        i++;
+      }
+    }
+
+    // Greedy resolution in score order
+    ap_uint<TopN>  keep = 0;
+    for(unsigned int  j = 0; j < TopN; j++) {
+#pragma HLS UNROLL
+      keep[j] = topvalid[j];
+    }
+    for(unsigned int  j = 0; j < TopN; j++) {
+#pragma HLS pipeline style=flp II=1
+      if(keep[j]) {
+        keep &= ~supp[j];
+      }
+    }
+
+    // Output of the surviving boxes, lowest index first
+    for(unsigned int  o = 0; o < TopN; o++) {
+#pragma HLS pipeline style=flp II=1
+      box_t  res = 0;
+      bool  found = false;
+      for(unsigned int  j = 0; j < TopN; j++) {
+#pragma HLS UNROLL
+        if(!found && keep[j]) {
+          res = topbox[j];
+          keep[j] = 0;
+          found = true;
+        }
+      }
+      out.write(res);
+    }
+  }
+}
+
+namespace detail {
+
+/**
+ * \brief   Sampling position along one axis of crop pixel j of a box spanning [lo, hi)
+ *
+ * Each crop pixel is sampled once at the centre of its bin. The nearest sample is the pixel containing
+ * it, the bilinear neighbours are the pixels whose centres enclose it, with w1 the weight of the second in
+ * units of 2^-FracBits. Positions beyond the outermost pixel centres take the border pixel.
+ */
+template<unsigned int Dim, unsigned int CropDim, unsigned int FracBits, bool Bilinear, typename TC>
+void roi_axis(TC const &lo, TC const &hi, unsigned int const  j,
+              unsigned int &i0, unsigned int &i1, ap_uint<FracBits> &w1) {
+#pragma HLS INLINE
+  constexpr unsigned int  W = TC::width;
+  ap_uint<W> const  len = hi > lo? ap_uint<W>(hi - lo) : ap_uint<W>(0);
+  ap_uint<W + clog2(2*CropDim) + 1> const  offset = (ap_uint<clog2(2*CropDim) + 1>(2*j + 1) * len) / (2*CropDim);
+  ap_uint<W + 1> const  pos = lo + offset;
+  if(!Bilinear) {
+    unsigned int const  i = pos >> FracBits;
+    i0 = i1 = i < Dim? i : Dim-1;
+    w1 = 0;
+  }
+  else if(pos < (1u << FracBits >> 1)) {
+    i0 = i1 = 0;
+    w1 = 0;
+  }
+  else {
+    ap_uint<W + 1> const  s = pos - (1u << FracBits >> 1);
+    unsigned int const  i = s >> FracBits;
+    if(i >= Dim-1) {
+      i0 = i1 = Dim-1;
+      w1 = 0;
+    }
+    else {
+      i0 = i;
+      i1 = i+1;
+      w1 = s;
+    }
+  }
+}
+
+/**
+ * \brief   Bilinear interpolation of SIMD elements with weights in units of 2^-FracBits, rounded to nearest
+ */
+template<unsigned int SIMD, unsigned int FracBits, typename In_t>
+ap_uint<SIMD*In_t::width> roi_interpolate(
+  ap_uint<SIMD*In_t::width> const &a00, ap_uint<SIMD*In_t::width> const &a01,
+  ap_uint<SIMD*In_t::width> const &a10, ap_uint<SIMD*In_t::width> const &a11,
+  ap_uint<FracBits> const &wx, ap_uint<FracBits> const &wy
+) {
+#pragma HLS INLINE
+  constexpr unsigned int  AW = In_t::width + 2*FracBits + 3;
+  using acc_t = ap_int<AW>;
+  acc_t const  wx1 = wx, wx0 = acc_t(1 << FracBits) - wx1;
+  acc_t const  wy1 = wy, wy0 = acc_t(1 << FracBits) - wy1;
+  ap_uint<SIMD*In_t::width>  res;
+  for(unsigned int  s = 0; s < SIMD; s++) {
+#pragma HLS UNROLL
+    In_t const  v00 = a00((s+1)*In_t::width-1, s*In_t::width);
+    In_t const  v01 = a01((s+1)*In_t::width-1, s*In_t::width);
+    In_t const  v10 = a10((s+1)*In_t::width-1, s*In_t::width);
+    In_t const  v11 = a11((s+1)*In_t::width-1, s*In_t::width);
+    acc_t const  v = wy0*(wx0*acc_t(v00) + wx1*acc_t(v01)) + wy1*(wx0*acc_t(v10) + wx1*acc_t(v11));
+    // round half up, the shift floors negative values
+    In_t const  r = (v + (acc_t(1) << (2*FracBits - 1))) >> (2*FracBits);
+    res((s+1)*In_t::width-1, s*In_t::width) = ap_uint<In_t::width>(r);
+  }
+  return  res;
+}
+
+/**
+ * \brief   Crop word from the taps sampled for it, the nearest pixel for a single tap, the bilinear
+ *          interpolation for the four taps (y0,x0), (y0,x1), (y1,x0), (y1,x1)
+ */
+template<unsigned int SIMD, unsigned int FracBits, typename In_t>
+ap_uint<SIMD*In_t::width> roi_sample(
+  ap_uint<SIMD*In_t::width> const (&a)[1], ap_uint<FracBits> const&, ap_uint<FracBits> const&
+) {
+#pragma HLS INLINE
+  return  a[0];
+}
+template<unsigned int SIMD, unsigned int FracBits, typename In_t>
+ap_uint<SIMD*In_t::width> roi_sample(
+  ap_uint<SIMD*In_t::width> const (&a)[4], ap_uint<FracBits> const &wx, ap_uint<FracBits> const &wy
+) {
+#pragma HLS INLINE
+  return  roi_interpolate<SIMD, FracBits, In_t>(a[0], a[1], a[2], a[3], wx, wy);
+}
+
+} // namespace detail
+
+/**
+ * \brief   RoI align from an on-chip feature map - crops fixed-size regions of interest of every frame
+ *
+ * Reads the FMDim_y x FMDim_x pixels of a frame into an on-chip buffer and then, for each of the
+ * NumBoxes boxes of the frame from the boxes stream, e.g. the output of NonMaxSuppression_Batch,
+ * writes a CropDim x CropDim crop in the pixel order and word format of the feature map, ready for
+ * a ConvLayer_Batch. Every crop pixel is sampled at the centre of its bin, from the nearest feature-map
+ * pixel or by bilinear interpolation between the four around it, which are read in the same cycle from
+ * a buffer split by row and column parity. One word of SIMD channels is written per cycle.
+ *
+ * \tparam     FMDim_x      Width of the feature map
+ * \tparam     FMDim_y      Height of the feature map
+ * \tparam     NumChannels  Number of channels
+ * \tparam     SIMD         Number of channels per word
+ * \tparam     CropDim      Width and height of the crops
+ * \tparam     NumBoxes     Number of boxes per frame
+ * \tparam     FracBits     Number of fraction bits of the box coordinates
+ * \tparam     Bilinear     Whether to interpolate bilinearly rather than take the nearest pixel
+ * \tparam     In_t         Datatype of the feature-map elements
+ * \tparam     TS           Datatype of the box scores
+ * \tparam     TC           Datatype of the box coordinates, an ap_uint
+ * \tparam     R            Resource type of the feature-map buffer
+ *
+ * \param      fm           Input stream of the feature maps
+ * \param      boxes        Input stream of the boxes
+ * \param      out          Output stream of the crops
+ * \param      numReps      Number of frames
+ * \param      r            Resource type of the feature-map buffer, see memory_resource
+ *
+ */
+template<
+  unsigned int FMDim_x, unsigned int FMDim_y, unsigned int NumChannels, unsigned int SIMD,
+  unsigned int CropDim, unsigned int NumBoxes, unsigned int FracBits, bool Bilinear,
+  typename In_t, typename TS, typename TC, typename R = ap_resource_dflt
+>
+void RoIAlign_Batch(
+  hls::stream<ap_uint<SIMD*In_t::width>> &fm,
+  hls::stream<typename DetectionBox<TS, TC>::type> &boxes,
+  hls::stream<ap_uint<SIMD*In_t::width>> &out,
+  unsigned int const  numReps,
+  R const &r = R()
+) {
+  static_assert(NumChannels % SIMD == 0, "SIMD must divide NumChannels");
+  static_assert(FracBits > 0, "Box coordinates need fraction bits");
+  using Box = DetectionBox<TS, TC>;
+  using word_t = ap_uint<SIMD*In_t::width>;
+  constexpr unsigned int  NF = NumChannels / SIMD;
+  constexpr unsigned int  XH = (FMDim_x + 1) / 2;
+  constexpr unsigned int  YH = (FMDim_y + 1) / 2;
+
+  // split by row and column parity to read the four bilinear neighbours per cycle
+  word_t  buf[2][2][YH * XH * NF];
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=2
+  memory_resource(buf, r);
+
+  for(unsigned int  rep = 0; rep < numReps; rep++) {
+    unsigned int  x = 0, y = 0, f = 0;
+    for(unsigned int  i = 0; i < FMDim_y * FMDim_x * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+      buf[y & 1][x & 1][((y >> 1) * XH + (x >> 1)) * NF + f] = fm.read();
+      if(++f == NF) {
+        f = 0;
+        if(++x == FMDim_x) {
+          x = 0;
+          y++;
+        }
+      }
+    }
+
+    typename Box::type  box;
+    unsigned int  cx = 0, cy = 0;
+    f = 0;
+    for(unsigned int  i = 0; i < NumBoxes * CropDim * CropDim * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+      if((cx | cy | f) == 0)  box = boxes.read();
+
+      unsigned int  x0, x1, y0, y1;
+      ap_uint<FracBits>  wx, wy;
+      detail::roi_axis<FMDim_x, CropDim, FracBits, Bilinear>(Box::coord(box, 0), Box::coord(box, 2), cx, x0, x1, wx);
+      detail::roi_axis<FMDim_y, CropDim, FracBits, Bilinear>(Box::coord(box, 1), Box::coord(box, 3), cy, y0, y1, wy);
+
+      // the neighbours are equal or adjacent, hence at most one read per bank
+      unsigned int const  xe = (x0 & 1)? x1 : x0;
+      unsigned int const  xo = (x0 & 1)? x0 : x1;
+      unsigned int const  ye = (y0 & 1)? y1 : y0;
+      unsigned int const  yo = (y0 & 1)? y0 : y1;
+      word_t  bank[2][2];
+#pragma HLS ARRAY_PARTITION variable=bank complete dim=0
+      bank[0][0] = buf[0][0][((ye >> 1) * XH + (xe >> 1)) * NF + f];
+      bank[0][1] = buf[0][1][((ye >> 1) * XH + (xo >> 1)) * NF + f];
+      bank[1][0] = buf[1][0][((yo >> 1) * XH + (xe >> 1)) * NF + f];
+      bank[1][1] = buf[1][1][((yo >> 1) * XH + (xo >> 1)) * NF + f];
+      word_t const  a00 = bank[y0 & 1][x0 & 1];
+      if(Bilinear) {
+        out.write(detail::roi_interpolate<SIMD, FracBits, In_t>(a00, bank[y0 & 1][x1 & 1], bank[y1 & 1][x0 & 1], bank[y1 & 1][x1 & 1], wx, wy));
+      }
+      else {
+        out.write(a00);
+      }
+
+      if(++f == NF) {
+        f = 0;
+        if(++cx == CropDim) {
+          cx = 0;
+          if(++cy == CropDim)  cy = 0;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * \brief   RoI align from a feature map in external memory
+ *
+ * As RoIAlign_Batch, but reading the feature maps through the AXI4 master fm, where frame rep is
+ * stored from word rep*FMDim_y*FMDim_x*NumChannels/SIMD on in the pixel order of the stream, e.g. by
+ * a Stream2Mem_Batch. Only the sampled pixels are read, at one read per cycle, so that a crop word
+ * takes one cycle with nearest and four with bilinear sampling.
+ *
+ * \tparam     FMDim_x      Width of the feature map
+ * \tparam     FMDim_y      Height of the feature map
+ * \tparam     NumChannels  Number of channels
+ * \tparam     SIMD         Number of channels per word
+ * \tparam     CropDim      Width and height of the crops
+ * \tparam     NumBoxes     Number of boxes per frame
+ * \tparam     FracBits     Number of fraction bits of the box coordinates
+ * \tparam     Bilinear     Whether to interpolate bilinearly rather than take the nearest pixel
+ * \tparam     In_t         Datatype of the feature-map elements
+ * \tparam     TS           Datatype of the box scores
+ * \tparam     TC           Datatype of the box coordinates, an ap_uint
+ *
+ * \param      fm           Pointer to the feature maps in external memory
+ * \param      boxes        Input stream of the boxes
+ * \param      out          Output stream of the crops
+ * \param      numReps      Number of frames
+ *
+ */
+template<
+  unsigned int FMDim_x, unsigned int FMDim_y, unsigned int NumChannels, unsigned int SIMD,
+  unsigned int CropDim, unsigned int NumBoxes, unsigned int FracBits, bool Bilinear,
+  typename In_t, typename TS, typename TC
+>
+void RoIAlign_External_Batch(
+  ap_uint<SIMD*In_t::width> const *fm,
+  hls::stream<typename DetectionBox<TS, TC>::type> &boxes,
+  hls::stream<ap_uint<SIMD*In_t::width>> &out,
+  unsigned int const  numReps
+) {
+  static_assert(NumChannels % SIMD == 0, "SIMD must divide NumChannels");
+  static_assert(FracBits > 0, "Box coordinates need fraction bits");
+  using Box = DetectionBox<TS, TC>;
+  using word_t = ap_uint<SIMD*In_t::width>;
+  constexpr unsigned int  NF = NumChannels / SIMD;
+  constexpr unsigned int  FrameWords = FMDim_y * FMDim_x * NF;
+  constexpr unsigned int  Taps = Bilinear? 4 : 1;
+
+  typename Box::type  box;
+  unsigned int  frame = 0;
+  unsigned int  cx = 0, cy = 0, f = 0, b = 0;
+  for(unsigned int  i = 0; i < numReps * NumBoxes * CropDim * CropDim * NF; i++) {
+#pragma HLS pipeline style=flp II=Taps
+    if((cx | cy | f) == 0)  box = boxes.read();
+
+    unsigned int  x0, x1, y0, y1;
+    ap_uint<FracBits>  wx, wy;
+    detail::roi_axis<FMDim_x, CropDim, FracBits, Bilinear>(Box::coord(box, 0), Box::coord(box, 2), cx, x0, x1, wx);
+    detail::roi_axis<FMDim_y, CropDim, FracBits, Bilinear>(Box::coord(box, 1), Box::coord(box, 3), cy, y0, y1, wy);
+
+    word_t const *const  base = fm + frame * FrameWords + f;
+    // taps in the order (y0,x0), (y0,x1), (y1,x0), (y1,x1), one per cycle
+    word_t  a[Taps];
+    for(unsigned int  t = 0; t < Taps; t++) {
+#pragma HLS unroll
+      unsigned int const  y = (t & 2)? y1 : y0;
+      unsigned int const  x = (t & 1)? x1 : x0;
+      a[t] = base[(y * FMDim_x + x) * NF];
+    }
+    out.write(detail::roi_sample<SIMD, FracBits, In_t>(a, wx, wy));
+
+    if(++f == NF) {
+      f = 0;
+      if(++cx == CropDim) {
+        cx = 0;
+        if(++cy == CropDim) {
+          cy = 0;
+          if(++b == NumBoxes) {
+            b = 0;
+            frame++;
+          }
+        }
+      }
+    }
+  }
+}
+
+#endif
@@ -50,6 +50,9 @@
 
 #include <ap_int.h>
 #include <hls_stream.h>
+#include "utils.hpp"
+// SWGWindow and ReceptiveField of the tiled layer chains
+#include "slidingwindow.h"
 
 /*!
  * \brief DMA block accessing AXI4 memory and output HLS streams
@@ -116,6 +119,59 @@ void Mem2Stream_Batch_external_wmem(ap_uint<DataWidth> * in,
     }
 }
 
+/*!
+ * \brief Recursion over the striped pointers concatenating their slices of a word
+ */
+template<unsigned int SliceWidth, unsigned int Offset>
+struct StripeGather {
+  template<typename TB>
+  static void gather(__attribute__((unused)) TB &word, __attribute__((unused)) unsigned int const  idx) {
+#pragma HLS inline
+  }
+  template<typename TB, typename... TP>
+  static void gather(TB &word, unsigned int const  idx, ap_uint<SliceWidth> const *in, TP... rest) {
+#pragma HLS inline
+    word((Offset + 1) * SliceWidth - 1, Offset * SliceWidth) = in[idx];
+    StripeGather<SliceWidth, Offset + 1>::gather(word, idx, rest...);
+  }
+};
+
+/*!
+ * \brief DMA block fetching a weight stream striped over multiple AXI4 memories, e.g. HBM pseudo-channels
+ *
+ * Every word of the stream, e.g. the SIMD*PE*WP bits consumed by Matrix_Vector_Activate_Stream_Batch per cycle,
+ * is split into one slice per memory, the first memory holding the LSBs. All memories are read in the same
+ * pipelined loop so that each of them sustains its own burst and the bandwidth scales with their number.
+ * Each memory should be connected to its own m_axi bundle. As Mem2Stream_Batch_external_wmem, the same
+ * words are read again for every image.
+ *
+ * \tparam DataWidth Width, in number of bits, of the output HLS stream
+ * \tparam numBytes Number of bytes of the output stream per image
+ * \tparam TP Pointer types - safely deducible from the paramaters, all ap_uint<DataWidth/N> const*
+ *
+ * \param out Output HLS stream
+ * \param numReps Number of times the weights have to be streamed
+ * \param in Input memory pointers, one per slice
+ */
+template<unsigned int DataWidth, unsigned int numBytes, typename... TP>
+void Mem2Stream_Batch_external_wmem_striped(hls::stream<ap_uint<DataWidth> > & out, const unsigned int numReps, TP... in) {
+  constexpr unsigned int  N = sizeof...(TP);
+  static_assert(N > 0, "Need at least one memory pointer");
+  static_assert(DataWidth % N == 0, "DataWidth must be a multiple of the number of memories");
+  static_assert(DataWidth % 8 == 0, "");
+  constexpr unsigned int  SliceWidth = DataWidth / N;
+  unsigned int const  numWords = numBytes / (DataWidth / 8);
+  static_assert(numWords != 0, "");
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+    for (unsigned int i = 0; i < numWords; i++) {
+#pragma HLS pipeline style=flp II=1
+      ap_uint<DataWidth>  e;
+      StripeGather<SliceWidth, 0>::gather(e, i, in...);
+      out.write(e);
+    }
+  }
+}
+
 /*!
  * \brief DMA block writing HLS streams content in AXI4 pointed memory multiple times
  * 
@@ -198,6 +254,155 @@ void Stream2Mem_Batch(hls::stream<ap_uint<DataWidth> > & in, ap_uint<DataWidth>
   }
 }
 
+/*!
+ * \brief Reads a contiguous memory region in explicit bursts of at most MaxBurst beats
+ *
+ * The bursts start at multiples of MaxBurst beats from the base pointer, so that none of them crosses
+ * a 4KB boundary as long as the buffer itself is 4KB aligned.
+ *
+ * \tparam MemWidth Width, in number of bits, of the AXI4 memory pointer
+ * \tparam MaxBurst Maximum number of beats per burst
+ *
+ * \param in Input memory pointer
+ * \param out Output stream of memory beats
+ * \param numBeats Number of beats to be read
+ */
+template<unsigned int MemWidth, unsigned int MaxBurst>
+void Mem2Stream_Bursts(ap_uint<MemWidth> const * in, hls::stream<ap_uint<MemWidth> > & out, const unsigned int numBeats) {
+  static_assert(4096 % (MaxBurst * (MemWidth / 8)) == 0, "Bursts must tile 4KB pages");
+  for (unsigned int beat = 0; beat < numBeats; beat += MaxBurst) {
+    unsigned int const  len = (numBeats - beat < MaxBurst)? numBeats - beat : MaxBurst;
+    for (unsigned int i = 0; i < len; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=MaxBurst
+      out.write(in[beat + i]);
+    }
+  }
+}
+
+/*!
+ * \brief Splits a stream of memory beats into narrower words, the LSBs first
+ *
+ * Words may span two beats. The bits of the last beat not covered by numWords words are dropped.
+ *
+ * \tparam MemWidth Width, in number of bits, of the memory beats
+ * \tparam DataWidth Width, in number of bits, of the output words, at most MemWidth
+ *
+ * \param in Input stream of memory beats
+ * \param out Output HLS stream
+ * \param numWords Number of words to be produced
+ */
+template<unsigned int MemWidth, unsigned int DataWidth>
+void Mem2Stream_Unpack(hls::stream<ap_uint<MemWidth> > & in, hls::stream<ap_uint<DataWidth> > & out, const unsigned int numWords) {
+  static_assert(DataWidth <= MemWidth, "DataWidth must not exceed MemWidth");
+  ap_uint<MemWidth + DataWidth>  buf = 0;
+  unsigned int  bits = 0; // valid bits in buf
+  for (unsigned int i = 0; i < numWords; i++) {
+#pragma HLS pipeline style=flp II=1
+    if (bits < DataWidth) {
+      ap_uint<MemWidth + DataWidth>  beat = in.read();
+      buf |= beat << bits;
+      bits += MemWidth;
+    }
+    out.write(buf(DataWidth - 1, 0));
+    buf >>= DataWidth;
+    bits -= DataWidth;
+  }
+}
+
+/*!
+ * \brief Burst-optimized DMA block reading a wide AXI4 memory into a HLS stream multiple times
+ *
+ * Unlike Mem2Stream_Batch, the numReps images, stored back to back, are read as a single region in explicit
+ * bursts of MaxBurst beats. This keeps the bursts long whatever numBytes and immune to misaligned images.
+ * The beats are then converted to DataWidth words in a separate stage, so that the memory side runs at one
+ * beat per cycle. The beat FIFO holds Outstanding bursts. The m_axi interface of the top level should
+ * match the bursts, e.g. max_read_burst_length=MaxBurst num_read_outstanding=Outstanding.
+ *
+ * \tparam DataWidth Width, in number of bits, of the output HLS stream, multiple of 8 and at most MemWidth
+ * \tparam numBytes Number of bytes to be read from the memory per image
+ * \tparam MemWidth Width, in number of bits, of the AXI4 memory pointer
+ * \tparam MaxBurst Maximum number of beats per burst
+ * \tparam Outstanding Number of bursts buffered ahead of the width conversion
+ *
+ * \param in Input memory pointer
+ * \param out Output HLS stream
+ * \param numReps Number of images to be read
+ */
+template<unsigned int DataWidth, unsigned int numBytes, unsigned int MemWidth = 512,
+         unsigned int MaxBurst = 64, unsigned int Outstanding = 2>
+void Mem2Stream_Burst_Batch(ap_uint<MemWidth> const * in, hls::stream<ap_uint<DataWidth> > & out, const unsigned int numReps) {
+#pragma HLS DATAFLOW
+  static_assert(DataWidth % 8 == 0, "");
+  static_assert(MemWidth % 8 == 0, "");
+  static_assert(numBytes % (DataWidth / 8) == 0, "numBytes must be a multiple of the word size");
+  unsigned int const  BeatBytes = MemWidth / 8;
+  unsigned int const  numWords = numReps * (numBytes / (DataWidth / 8));
+  unsigned int const  numBeats = (numReps * numBytes + BeatBytes - 1) / BeatBytes;
+  constexpr unsigned int  BeatDepth = MaxBurst * Outstanding;
+
+  hls::stream<ap_uint<MemWidth> >  beats("Mem2Stream_Burst_Batch.beats");
+#pragma HLS STREAM variable=beats depth=BeatDepth
+  Mem2Stream_Bursts<MemWidth, MaxBurst>(in, beats, numBeats);
+  Mem2Stream_Unpack<MemWidth, DataWidth>(beats, out, numWords);
+}
+
+namespace detail {
+
+/** Bursts one image into a bank of the ping-pong buffer. */
+template<unsigned int DataWidth, unsigned int numWords>
+void pingpong_fetch(ap_uint<DataWidth> const * in, ap_uint<DataWidth> (&buf)[numWords], unsigned int const  rep) {
+#pragma HLS INLINE off
+  ap_uint<DataWidth> const * const  src = &in[rep * numWords];
+  for (unsigned int i = 0; i < numWords; i++) {
+#pragma HLS pipeline style=flp II=1
+    buf[i] = src[i];
+  }
+}
+
+/** Streams an image out of a bank of the ping-pong buffer. */
+template<unsigned int DataWidth, unsigned int numWords>
+void pingpong_emit(ap_uint<DataWidth> const (&buf)[numWords], hls::stream<ap_uint<DataWidth> > & out) {
+#pragma HLS INLINE off
+  for (unsigned int i = 0; i < numWords; i++) {
+#pragma HLS pipeline style=flp II=1
+    out.write(buf[i]);
+  }
+}
+
+} // namespace detail
+
+/*!
+ * \brief Prefetching DMA block reading AXI4 memory into a HLS stream multiple times through a ping-pong buffer
+ *
+ * Every image is fetched in a single burst of numBytes into a ping-pong buffer (PIPO) and streamed out
+ * of it by a separate process of a dataflow region. The region is pipelined across the images, so that
+ * the next image is fetched into one bank while the previous one streams out of the other. Each image
+ * thus takes max(DMA, consumer) rather than their sum, the fetch is not held up by a stalling consumer,
+ * and the bursts are the same size whatever numReps. The buffer holds two images.
+ *
+ * \tparam DataWidth Width, in number of bits, of the AXI4 memory pointer and the output HLS stream
+ * \tparam numBytes Number of bytes to be read from the memory per image
+ *
+ * \param in Input memory pointer
+ * \param out Output HLS stream
+ * \param numReps Number of images to be read
+ */
+template<unsigned int DataWidth, unsigned int numBytes>
+void Mem2Stream_PingPong_Batch(ap_uint<DataWidth> const * in, hls::stream<ap_uint<DataWidth> > & out, const unsigned int numReps) {
+  static_assert(DataWidth % 8 == 0, "");
+  unsigned int const  numWords = numBytes / (DataWidth / 8);
+  static_assert(numWords != 0, "");
+
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+#pragma HLS DATAFLOW
+    ap_uint<DataWidth>  buf[numWords];
+#pragma HLS STREAM variable=buf type=pipo depth=2
+    detail::pingpong_fetch<DataWidth, numWords>(in, buf, rep);
+    detail::pingpong_emit<DataWidth, numWords>(buf, out);
+  }
+}
+
 /*!
  * \brief Streaming block that fetches parameters from internal memory and presents them to the MVAU
  * 
@@ -235,4 +440,696 @@ void GenParamStream(TW const &W_in, hls::stream<ap_uint<SIMD * PE * WP>> &paramS
   }
 }
 
+namespace detail {
+
+/** Fetches the tiles not served by the cache of GenParamStream_Cached, all of them for a first image filling it. */
+template<unsigned int TILES, unsigned int CachedTiles, unsigned int Width>
+void cached_fetch(ap_uint<Width> const * W_in, hls::stream<ap_uint<Width>> &tiles, bool const  loaded, unsigned int const  numReps) {
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+    unsigned int const  first = (rep == 0) && !loaded? 0 : CachedTiles;
+    for (unsigned int tile = first; tile < TILES; tile++) {
+#pragma HLS pipeline style=flp II=1
+      tiles.write(W_in[tile]);
+    }
+  }
+}
+
+/** Emits the parameters of GenParamStream_Cached, replaying the cache and filling it if not loaded. */
+template<unsigned int TILES, unsigned int CachedTiles, unsigned int Width>
+void cached_emit(hls::stream<ap_uint<Width>> &tiles, hls::stream<ap_uint<Width>> &paramStreamOut,
+                 ap_uint<Width> (&cache)[CachedTiles], bool const  loaded, unsigned int const  numReps) {
+#pragma HLS DEPENDENCE variable=cache inter false
+  bool  hit = loaded;
+  unsigned int  tile = 0;
+  for (unsigned int i = 0; i < numReps * TILES; i++) {
+#pragma HLS pipeline style=flp II=1
+    ap_uint<Width>  e;
+    if (hit && (tile < CachedTiles))  e = cache[tile];
+    else {
+      e = tiles.read();
+      if (tile < CachedTiles)  cache[tile] = e;
+    }
+    paramStreamOut.write(e);
+    if (++tile == TILES) {
+      tile = 0;
+      hit = true;
+    }
+  }
+}
+
+/** Fetch and emission of GenParamStream_Cached with the fetch of the remainder running ahead. */
+template<unsigned int TILES, unsigned int CachedTiles, unsigned int Width, unsigned int Prefetch>
+void cached_stream(ap_uint<Width> const * W_in, hls::stream<ap_uint<Width>> &paramStreamOut,
+                   ap_uint<Width> (&cache)[CachedTiles], bool const  loaded, unsigned int const  numReps) {
+#pragma HLS DATAFLOW
+  hls::stream<ap_uint<Width>>  tiles("GenParamStream_Cached.tiles");
+#pragma HLS STREAM variable=tiles depth=Prefetch
+  cached_fetch<TILES, CachedTiles, Width>(W_in, tiles, loaded, numReps);
+  cached_emit<TILES, CachedTiles, Width>(tiles, paramStreamOut, cache, loaded, numReps);
+}
+
+} // namespace detail
+
+/*!
+ * \brief Streaming block presenting parameters to the MVAU from external memory and an on-chip tile cache
+ *
+ * For layers whose weights slightly exceed the on-chip memory. The first CachedTiles tiles in stream
+ * order are kept in an on-chip cache owned by the caller, which is filled while the first image ever
+ * streams all TILES tiles from memory. From then on, also over later calls, the images stream the cached
+ * tiles from chip and fetch only the remaining TILES-CachedTiles tiles, in a single burst. The burst is
+ * issued by a separate dataflow process, which fetches up to Prefetch tiles ahead while the cache is
+ * replayed, so that the memory latency is hidden. As every tile is used once per image, which tiles are
+ * cached does not change the saved traffic, which is proportional to CachedTiles/TILES.
+ *
+ * \tparam TILES          Total folding factor of the layer (Neuron Fold * Synapse Fold)
+ * \tparam CachedTiles    Number of leading tiles kept on chip
+ * \tparam SIMD           Number of input columns computed in parallel
+ * \tparam PE             Number of output rows computed in parallel
+ * \tparam WP             Precision of the weights in the network
+ * \tparam Prefetch       Depth of the FIFO of remaining tiles fetched ahead of their use
+ * \tparam R              Resource type of the tile cache
+ *
+ * \param W_in            Pointer to the external weight memory, one SIMD * PE * WP word per tile
+ * \param paramStreamOut  Parameter stream that contains SIMD * PE * WP long words to digest by the MVAU
+ * \param numReps         Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param cache           Tile cache persisting across calls, see OnChipCache
+ * \param r               Resource type of the tile cache, see memory_resource
+ */
+template<
+  unsigned int TILES,
+  unsigned int CachedTiles,
+  unsigned int SIMD,
+  unsigned int PE,
+  unsigned int WP,
+  unsigned int Prefetch = 64,
+  typename R = ap_resource_dflt
+>
+void GenParamStream_Cached(ap_uint<SIMD * PE * WP> const * W_in, hls::stream<ap_uint<SIMD * PE * WP>> &paramStreamOut,
+                           int const numReps, OnChipCache<CachedTiles, SIMD * PE * WP> &cache, R const &r = R()) {
+  static_assert(CachedTiles > 0, "Use Mem2Stream_Batch_external_wmem without a cache");
+  static_assert(CachedTiles <= TILES, "Cannot cache more tiles than the layer has");
+  memory_resource(cache.words, r);
+
+  if (numReps <= 0)  return;
+  detail::cached_stream<TILES, CachedTiles, SIMD * PE * WP, Prefetch>(W_in, paramStreamOut, cache.words, cache.loaded, numReps);
+  cache.loaded = true;
+}
+
+/*!
+ * \brief Streaming block decompressing a variable-width coded parameter stream for the MVAU
+ *
+ * Sits between Mem2Stream_Batch_external_wmem and Matrix_Vector_Activate_Stream_Batch so that the
+ * external memory only delivers the compressed weights. Every SIMD * PE * WP parameter word is split
+ * into Groups groups of lanes, each coded with the narrowest width b of 0 to WP bits holding all of its
+ * lanes, as two's complement if Signed. The code of a word is the Groups widths of clog2(WP+1) bits
+ * each, the first group's in the LSBs, followed by the lanes of all groups at their widths. The codes
+ * are concatenated into a bit stream, LSBs first, which is split into InWidth words and padded to a
+ * whole word per image, see tb/data/weight_compression.py. The decoder buffers one maximal code plus
+ * an input word and decompresses one parameter word per cycle while the bits for it are available.
+ *
+ * \tparam TILES          Total folding factor of the layer (Neuron Fold * Synapse Fold)
+ * \tparam SIMD           Number of input columns computed in parallel
+ * \tparam PE             Number of output rows computed in parallel
+ * \tparam WP             Precision of the weights in the network
+ * \tparam Groups         Number of lane groups coded with their own width, a divisor of SIMD * PE
+ * \tparam Signed         Whether the weights are signed
+ * \tparam InWidth        Width of the compressed stream - safely deducible from the paramaters
+ *
+ * \param in              Compressed parameter stream
+ * \param paramStreamOut  Parameter stream that contains SIMD * PE * WP long words to digest by the MVAU
+ * \param numInWords      Number of compressed words per image
+ * \param numReps         Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<
+  unsigned int TILES,
+  unsigned int SIMD,
+  unsigned int PE,
+  unsigned int WP,
+  unsigned int Groups = 1,
+  bool Signed = true,
+  int InWidth
+>
+void DecompressParamStream(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<SIMD * PE * WP>> &paramStreamOut,
+                           unsigned const numInWords, int const numReps) {
+  constexpr unsigned  LANES = SIMD * PE;
+  static_assert(LANES % Groups == 0, "Groups must divide SIMD * PE");
+  constexpr unsigned  GL = LANES / Groups;
+  constexpr unsigned  HB = clog2(WP+1);
+  constexpr unsigned  HDR = Groups * HB;
+  constexpr unsigned  MAX_LEN = HDR + LANES * WP;
+  constexpr unsigned  BW = MAX_LEN + InWidth;
+
+  for (unsigned rep = 0; rep < (unsigned)numReps; rep++) {
+    ap_uint<BW>  buf = 0;
+    unsigned  fill = 0;
+    unsigned  rd = 0;
+    for (unsigned tile = 0; tile < TILES; ) {
+#pragma HLS pipeline style=flp II=1
+      // widths of the groups and offsets of their lanes
+      unsigned  b[Groups];
+      unsigned  ofs[Groups];
+      unsigned  len = HDR;
+      for (unsigned g = 0; g < Groups; g++) {
+#pragma HLS UNROLL
+        b[g] = buf((g+1)*HB-1, g*HB);
+        ofs[g] = len;
+        len += GL * b[g];
+      }
+
+      ap_uint<BW>  next = buf;
+      unsigned  nfill = fill;
+      if ((fill >= HDR) && (fill >= len)) {
+        ap_uint<SIMD * PE * WP>  strMem;
+        for (unsigned g = 0; g < Groups; g++) {
+#pragma HLS UNROLL
+          ap_uint<GL * WP> const  grp = buf >> ofs[g];
+          for (unsigned l = 0; l < GL; l++) {
+#pragma HLS UNROLL
+            ap_uint<WP> const  raw = grp >> (l * b[g]);
+            // extend the b-bit field to WP bits
+            ap_uint<WP>  w = 0;
+            if (b[g] > 0) {
+              ap_uint<WP> const  field = raw & ((ap_uint<WP+1>(1) << b[g]) - 1);
+              bool const  neg = Signed && raw[b[g]-1];
+              w = neg? ap_uint<WP>(field | ~((ap_uint<WP+1>(1) << b[g]) - 1)) : field;
+            }
+            strMem(WP*(g*GL+l+1)-1, WP*(g*GL+l)) = w;
+          }
+        }
+        paramStreamOut.write(strMem);
+        tile++;
+        next = buf >> len;
+        nfill = fill - len;
+      }
+      // refill whenever the buffer holds no more than a maximal code
+      if ((rd < numInWords) && (fill <= MAX_LEN)) {
+        next |= ap_uint<BW>(in.read()) << nfill;
+        nfill += InWidth;
+        rd++;
+      }
+      buf = next;
+      fill = nfill;
+    }
+    // drop trailing padding words
+    for (; rd < numInWords; rd++) {
+      in.read();
+    }
+  }
+}
+
+/*!
+ * \brief Virtual FIFO spilling the middle of a deep stream to external memory
+ *
+ * Behaves as a FIFO of Depth + 4*Burst words between in and out. The words are accepted into an on-chip
+ * tail buffer and emitted from an on-chip head buffer, each of two bursts. Whenever the head buffer cannot
+ * take them directly, full bursts of the tail are written to a ring buffer of Depth words in external memory
+ * and read back into the head in bursts once it has room. The input is stalled once the tail and the ring
+ * buffer are full, so that the FIFO exerts back-pressure like a plain hls::stream.
+ *
+ * The block performs one external memory beat per cycle, reading or writing a whole burst at a time. With
+ * Bypass, words skip the external memory as long as the ring buffer is empty and the head has room, so that the
+ * FIFO runs at one word per cycle while the consumer keeps pace. Without, every word goes through the external
+ * memory and a final partial burst is written once the input is complete.
+ *
+ * \tparam DataWidth Width, in number of bits, of the streams and the AXI4 memory pointer
+ * \tparam Depth Number of words of the ring buffer in external memory, a multiple of Burst
+ * \tparam Burst Number of beats per burst
+ * \tparam Bypass Whether words may skip the external memory while the ring buffer is empty
+ *
+ * \param in Input HLS stream
+ * \param out Output HLS stream
+ * \param mem Ring buffer in external memory, Depth words
+ * \param numWords Number of words to be passed through
+ */
+template<unsigned int DataWidth, unsigned int Depth, unsigned int Burst = 64, bool Bypass = true>
+void VirtualFIFO(hls::stream<ap_uint<DataWidth> > & in, hls::stream<ap_uint<DataWidth> > & out,
+                 ap_uint<DataWidth> * mem, const unsigned int numWords) {
+  static_assert(Depth % Burst == 0, "Burst must divide Depth");
+  constexpr unsigned int  BufSize = 2 * Burst;
+  enum { NONE, WRITE, READ };
+
+  ap_uint<DataWidth>  tail[BufSize];
+  ap_uint<DataWidth>  head[BufSize];
+#pragma HLS DEPENDENCE variable=tail inter false
+#pragma HLS DEPENDENCE variable=head inter false
+  unsigned int  tail_wr = 0, tail_rd = 0, tail_n = 0;
+  unsigned int  head_wr = 0, head_rd = 0, head_n = 0;
+  unsigned int  mem_wr = 0, mem_rd = 0, mem_n = 0;   // ring buffer slots and fill
+  unsigned int  accepted = 0, emitted = 0;
+
+  while (emitted < numWords) {
+    // choose the transfer of the next Burst cycles
+    bool const  in_done = accepted == numWords;
+    bool const  can_read = (mem_n > 0) && (head_n <= BufSize - Burst);
+    bool const  can_write = ((tail_n >= Burst) || (!Bypass && in_done && (tail_n > 0))) &&
+                            (mem_n <= Depth - Burst) && (!Bypass || (mem_n > 0) || (head_n > BufSize - Burst));
+    unsigned int const  dir = (can_read && !(can_write && (head_n >= Burst)))? READ : can_write? WRITE : NONE;
+    unsigned int const  len = (dir == READ)? std::min(mem_n, Burst) : (dir == WRITE)? std::min(tail_n, Burst) : 0;
+    unsigned int const  base = (dir == READ)? mem_rd : mem_wr;
+#ifndef __SYNTHESIS__
+    unsigned int const  before = accepted + emitted;
+#endif
+
+    for (unsigned int i = 0; i < Burst; i++) {
+#pragma HLS pipeline style=flp II=1
+      // drain the head
+      if ((head_n > 0) && !out.full()) {
+        out.write(head[head_rd]);
+        if (++head_rd == BufSize)  head_rd = 0;
+        head_n--;
+        emitted++;
+      }
+      // move a word between the buffers
+      if (i < len) {
+        if (dir == WRITE) {
+          mem[base + i] = tail[tail_rd];
+          if (++tail_rd == BufSize)  tail_rd = 0;
+          tail_n--;
+        }
+        else {
+          head[head_wr] = mem[base + i];
+          if (++head_wr == BufSize)  head_wr = 0;
+          head_n++;
+        }
+      }
+      else if (Bypass && (dir == NONE) && (mem_n == 0) && (tail_n > 0) && (head_n < BufSize)) {
+        head[head_wr] = tail[tail_rd];
+        if (++head_wr == BufSize)  head_wr = 0;
+        if (++tail_rd == BufSize)  tail_rd = 0;
+        head_n++;
+        tail_n--;
+      }
+      // fill the tail
+      if ((accepted < numWords) && (tail_n < BufSize) && !in.empty()) {
+        tail[tail_wr] = in.read();
+        if (++tail_wr == BufSize)  tail_wr = 0;
+        tail_n++;
+        accepted++;
+      }
+    }
+
+    if (dir == WRITE) {
+      mem_n += len;
+      mem_wr += Burst;
+      if (mem_wr == Depth)  mem_wr = 0;
+    }
+    if (dir == READ) {
+      mem_n -= len;
+      mem_rd += Burst;
+      if (mem_rd == Depth)  mem_rd = 0;
+    }
+#ifndef __SYNTHESIS__
+    if ((dir == NONE) && (accepted + emitted == before) && in.empty()) {
+      std::cerr << "VirtualFIFO: input ended after " << accepted << " of " << numWords << " words" << std::endl;
+      break;
+    }
+#endif
+  }
+}
+
+/*!
+ * \brief Virtual FIFO spilling the middle of a deep stream to external memory, multiple times
+ *
+ * See VirtualFIFO, the numReps frames passing through back to back.
+ *
+ * \tparam DataWidth Width, in number of bits, of the streams and the AXI4 memory pointer
+ * \tparam NumWords Number of words per frame
+ * \tparam Depth Number of words of the ring buffer in external memory, a multiple of Burst
+ * \tparam Burst Number of beats per burst
+ * \tparam Bypass Whether words may skip the external memory while the ring buffer is empty
+ *
+ * \param in Input HLS stream
+ * \param out Output HLS stream
+ * \param mem Ring buffer in external memory, Depth words
+ * \param numReps Number of frames
+ */
+template<unsigned int DataWidth, unsigned int NumWords, unsigned int Depth, unsigned int Burst = 64, bool Bypass = true>
+void VirtualFIFO_Batch(hls::stream<ap_uint<DataWidth> > & in, hls::stream<ap_uint<DataWidth> > & out,
+                       ap_uint<DataWidth> * mem, const unsigned int numReps) {
+#pragma HLS INLINE
+  VirtualFIFO<DataWidth, Depth, Burst, Bypass>(in, out, mem, numReps * NumWords);
+}
+
+/*!
+ * \brief Completion descriptor of a frame written by Stream2Mem_Variable_Batch
+ *
+ * Layout from the LSB: length of the frame in bytes, byte offset of the frame inside the ring buffer,
+ * both 31 bits, and a valid bit set by the writer so that the host may poll a cleared descriptor.
+ */
+struct Stream2MemDescriptor {
+  static constexpr unsigned int  width = 64;
+  using type = ap_uint<width>;
+
+  static type pack(unsigned int const  offset, unsigned int const  length) {
+#pragma HLS inline
+    type  d = 0;
+    d(30, 0) = length;
+    d(61, 31) = offset;
+    d[63] = 1;
+    return  d;
+  }
+  static unsigned int length(type const &d) {
+#pragma HLS inline
+    return  d(30, 0);
+  }
+  static unsigned int offset(type const &d) {
+#pragma HLS inline
+    return  d(61, 31);
+  }
+  static bool valid(type const &d) {
+#pragma HLS inline
+    return  d[63];
+  }
+};
+
+/*!
+ * \brief DMA block writing frames of variable length from a HLS stream into a ring buffer in AXI4 memory
+ *
+ * The number of words of every frame is read from lengths ahead of its data, e.g. the survivors counted by
+ * the producer. The frames are packed back to back into the ring buffer, wrapping around at its end, in
+ * bursts of at most MaxBurst beats which are split at the end of the ring. Once a frame has been written,
+ * its descriptor is written to desc[rep]; it should share the m_axi bundle of the ring buffer so that it
+ * is not observed ahead of the data. The ring buffer is not flow-controlled: the host has to consume the
+ * frames before they are overwritten, e.g. by sizing the ring for all frames in flight.
+ *
+ * \tparam DataWidth Width, in number of bits, of the AXI4 memory pointer and the input HLS stream
+ * \tparam MaxBurst Maximum number of beats per burst
+ *
+ * \param in Input HLS stream
+ * \param lengths Number of words of each frame
+ * \param ring Ring buffer in memory
+ * \param ringWords Number of words of the ring buffer
+ * \param desc Descriptors of the frames, one per frame
+ * \param numReps Number of frames to be written
+ */
+template<unsigned int DataWidth, unsigned int MaxBurst = 64>
+void Stream2Mem_Variable_Batch(hls::stream<ap_uint<DataWidth> > & in, hls::stream<ap_uint<32> > & lengths,
+                               ap_uint<DataWidth> * ring, const unsigned int ringWords,
+                               Stream2MemDescriptor::type * desc, const unsigned int numReps) {
+  static_assert(DataWidth % 8 == 0, "");
+  unsigned int const  WordBytes = DataWidth / 8;
+  unsigned int  wr = 0;
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+    unsigned int const  numWords = lengths.read();
+    unsigned int const  start = wr;
+    for (unsigned int done = 0; done < numWords; ) {
+      unsigned int  len = std::min(numWords - done, ringWords - wr);
+      if (len > MaxBurst)  len = MaxBurst;
+      for (unsigned int i = 0; i < len; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=MaxBurst
+        ring[wr + i] = in.read();
+      }
+      done += len;
+      wr += len;
+      if (wr == ringWords)  wr = 0;
+    }
+    desc[rep] = Stream2MemDescriptor::pack(start * WordBytes, numWords * WordBytes);
+  }
+}
+
+/*!
+ * \brief Layout of the frames written by Stream2Mem_Layout_Batch into a host tensor, in words of the stream
+ *
+ * A frame arrives row by row, every row pixel by pixel and every pixel as groups words, each a group of
+ * channels. The pixels of a row are written either interleaved, all groups of a pixel next to each other
+ * (NHWC, with group_stride 1), or planar, the same group of all pixels next to each other and the groups
+ * group_stride words apart (blocked NCHWc, or NCHW with single-channel words). Rows are row_pitch words
+ * apart, which allows padded rows, and frames frame_stride words apart from base, or at the bases given
+ * per frame, which allows a slice of a larger batch tensor.
+ */
+struct Stream2MemLayout {
+  unsigned int  rows;          //!< rows per frame
+  unsigned int  pixels;        //!< pixels per row
+  unsigned int  groups;        //!< channel-group words per pixel
+  unsigned int  row_pitch;     //!< words from the start of a row to the next
+  unsigned int  group_stride;  //!< words from a channel-group plane to the next, 1 for interleaved pixels
+  unsigned int  frame_stride;  //!< words from a frame to the next
+  unsigned int  base;          //!< word offset of the first frame
+
+  bool planar() const {
+#pragma HLS inline
+    return  group_stride != 1;
+  }
+};
+
+namespace detail {
+
+/** Generates the base offsets base + rep*frame_stride of the frames. */
+inline void layout_bases(Stream2MemLayout const &layout, hls::stream<ap_uint<32> > & bases, const unsigned int numReps) {
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+#pragma HLS pipeline style=flp II=1
+    bases.write(layout.base + rep * layout.frame_stride);
+  }
+}
+
+/**
+ * Reorders every row of a planar layout from pixel-major to group-major through a ping-pong buffer, one
+ * row behind the input. Interleaved rows are passed on as they are.
+ */
+template<unsigned int DataWidth, unsigned int MaxRowWords>
+void layout_reorder(hls::stream<ap_uint<DataWidth> > & in, hls::stream<ap_uint<DataWidth> > & out,
+                    Stream2MemLayout const &layout, const unsigned int numReps) {
+  unsigned int const  rowWords = layout.pixels * layout.groups;
+  unsigned int const  numRows = numReps * layout.rows;
+  if (!layout.planar()) {
+    for (unsigned int i = 0; i < numRows * rowWords; i++) {
+#pragma HLS pipeline style=flp II=1
+      out.write(in.read());
+    }
+    return;
+  }
+  ap_uint<DataWidth>  buf[2][MaxRowWords];
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+  unsigned int  bank = 0;
+  // one more row of iterations to drain the last one
+  for (unsigned int row = 0; row <= numRows; row++) {
+    for (unsigned int g = 0, x = 0, i = 0; i < rowWords; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=buf inter false
+      if (row < numRows)  buf[bank][i] = in.read();
+      if (row > 0)  out.write(buf[bank ^ 1][x * layout.groups + g]);
+      if (++x == layout.pixels) {
+        x = 0;
+        g++;
+      }
+    }
+    bank ^= 1;
+  }
+}
+
+/** Writes the runs of contiguous words of every row in bursts of at most MaxBurst beats. */
+template<unsigned int DataWidth, unsigned int MaxBurst>
+void layout_write(hls::stream<ap_uint<DataWidth> > & in, hls::stream<ap_uint<32> > & bases, ap_uint<DataWidth> * out,
+                  Stream2MemLayout const &layout, const unsigned int numReps) {
+  bool const  planar = layout.planar();
+  unsigned int const  runs = planar? layout.groups : 1;
+  unsigned int const  runWords = planar? layout.pixels : layout.pixels * layout.groups;
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+    unsigned int const  base = bases.read();
+    for (unsigned int row = 0; row < layout.rows; row++) {
+      for (unsigned int run = 0; run < runs; run++) {
+        unsigned int const  start = base + row * layout.row_pitch + run * layout.group_stride;
+        for (unsigned int done = 0; done < runWords; done += MaxBurst) {
+          unsigned int const  len = (runWords - done < MaxBurst)? runWords - done : MaxBurst;
+          for (unsigned int i = 0; i < len; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=MaxBurst
+            out[start + done + i] = in.read();
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+/*!
+ * \brief DMA block writing the frames of a HLS stream into a host tensor of a given layout, with the frame offsets given per frame
+ *
+ * Writes every frame directly into its place in the host tensor described by layout, see Stream2MemLayout,
+ * at the word offset read from bases, so that the host needs no copy to its own layout. The rows of a
+ * planar layout are reordered on chip, in a ping-pong buffer of two rows, so that every run of contiguous
+ * words, a row of an interleaved layout or a row of one channel group of a planar one, is written in
+ * bursts of at most MaxBurst beats.
+ *
+ * \tparam DataWidth Width, in number of bits, of the AXI4 memory pointer and the input HLS stream
+ * \tparam MaxRowWords Maximum number of words per row of a planar layout
+ * \tparam MaxBurst Maximum number of beats per burst
+ *
+ * \param in Input HLS stream
+ * \param bases Word offset of every frame in the tensor
+ * \param out Host tensor in memory
+ * \param layout Layout of the frames in the tensor, base and frame_stride are not used
+ * \param numReps Number of frames to be written
+ */
+template<unsigned int DataWidth, unsigned int MaxRowWords, unsigned int MaxBurst = 64>
+void Stream2Mem_Layout_Batch(hls::stream<ap_uint<DataWidth> > & in, hls::stream<ap_uint<32> > & bases, ap_uint<DataWidth> * out,
+                             Stream2MemLayout const &layout, const unsigned int numReps) {
+#pragma HLS DATAFLOW
+  hls::stream<ap_uint<DataWidth> >  ordered("Stream2Mem_Layout_Batch.ordered");
+#pragma HLS STREAM variable=ordered depth=MaxBurst
+  detail::layout_reorder<DataWidth, MaxRowWords>(in, ordered, layout, numReps);
+  detail::layout_write<DataWidth, MaxBurst>(ordered, bases, out, layout, numReps);
+}
+
+/*!
+ * \brief DMA block writing the frames of a HLS stream into a host tensor of a given layout
+ *
+ * As the variant taking the frame offsets from a stream, with the frames frame_stride words apart from base.
+ *
+ * \tparam DataWidth Width, in number of bits, of the AXI4 memory pointer and the input HLS stream
+ * \tparam MaxRowWords Maximum number of words per row of a planar layout
+ * \tparam MaxBurst Maximum number of beats per burst
+ *
+ * \param in Input HLS stream
+ * \param out Host tensor in memory
+ * \param layout Layout of the frames in the tensor
+ * \param numReps Number of frames to be written
+ */
+template<unsigned int DataWidth, unsigned int MaxRowWords, unsigned int MaxBurst = 64>
+void Stream2Mem_Layout_Batch(hls::stream<ap_uint<DataWidth> > & in, ap_uint<DataWidth> * out,
+                             Stream2MemLayout const &layout, const unsigned int numReps) {
+#pragma HLS DATAFLOW
+  hls::stream<ap_uint<32> >  bases("Stream2Mem_Layout_Batch.bases");
+  hls::stream<ap_uint<DataWidth> >  ordered("Stream2Mem_Layout_Batch.ordered");
+#pragma HLS STREAM variable=ordered depth=MaxBurst
+  detail::layout_bases(layout, bases, numReps);
+  detail::layout_reorder<DataWidth, MaxRowWords>(in, ordered, layout, numReps);
+  detail::layout_write<DataWidth, MaxBurst>(ordered, bases, out, layout, numReps);
+}
+
+/*!
+ * \brief Geometry of the overlapping column tiles of an image processed by a chain of sliding-window layers
+ *
+ * The output feature map of the chain is split into tiles of TileOut columns and the full height, the
+ * last one shifted left to end at the border and so overlapping its neighbour. Every tile needs an input
+ * of the full height of the padded image and of tile_ifm_x columns, which exceed the TileOut*jump columns
+ * its outputs advance by by a halo of size-jump columns of the cumulative receptive field of the chain,
+ * see ReceptiveField, shared with the next tile. The tiles are processed by the chain
+ * without any padding, the padding of the first window is inserted into the tiles at the image borders by
+ * Mem2Stream_Tiled_Batch, so that the line buffers scale with the tile width instead of the image width.
+ * The later windows of the chain must hence not pad.
+ *
+ * \tparam IFMDim_x   Width of the input image
+ * \tparam IFMDim_y   Height of the input image
+ * \tparam TileOut    Number of output columns per tile
+ * \tparam W          SWGWindow of the first layer of the chain
+ * \tparam Windows    SWGWindow of every later layer of the chain
+ */
+template<unsigned int IFMDim_x, unsigned int IFMDim_y, unsigned int TileOut, typename W, typename... Windows>
+struct TileGeometry {
+  using  Field = ReceptiveField<W, Windows...>;
+  static_assert(ReceptiveField<Windows...>::pad == 0, "Only the first window of a tiled chain may pad.");
+  static_assert(W::pad_value == 0, "The tile reader pads with zeros.");
+
+  static constexpr unsigned int  pad = Field::pad;
+  static constexpr unsigned int  ifm_x = IFMDim_x;
+  static constexpr unsigned int  ifm_y = IFMDim_y;
+  static constexpr unsigned int  ofm_x = Field::ofm_dim(IFMDim_x);
+  static constexpr unsigned int  ofm_y = Field::ofm_dim(IFMDim_y);
+  static constexpr unsigned int  tile_ofm_x = TileOut;
+  static constexpr unsigned int  tile_ifm_x = Field::ifm_dim(TileOut);
+  static constexpr unsigned int  tile_ifm_y = IFMDim_y + 2*pad;
+  static constexpr unsigned int  halo = Field::size - Field::jump;
+  static constexpr unsigned int  tiles = (ofm_x + TileOut - 1) / TileOut;
+  static_assert(TileOut > 0 && TileOut <= ofm_x, "Tiles must not be wider than the output feature map.");
+
+  /** First output column of tile t */
+  static constexpr unsigned int ofm_col(unsigned int const  t) {
+    return  t * TileOut < ofm_x - TileOut? t * TileOut : ofm_x - TileOut;
+  }
+  /** First input column of tile t, negative within the padding */
+  static constexpr int ifm_col(unsigned int const  t) {
+    return  int(ofm_col(t) * Field::jump) - int(pad);
+  }
+};
+
+/*!
+ * \brief DMA block reading the overlapping column tiles of images in memory into a HLS stream
+ *
+ * Every image is stored row by row, every row pixel by pixel and every pixel as Groups words. The tiles
+ * of every image, see TileGeometry, are output one after the other, each row by row over the tile_ifm_x
+ * columns of its tile, with zeros in place of the pixels within the padding. Every row of a tile is read
+ * as one run of contiguous words.
+ *
+ * \tparam DataWidth Width, in number of bits, of the AXI4 memory pointer and the output HLS stream
+ * \tparam Groups Number of words per pixel
+ * \tparam Geometry TileGeometry of the tiles
+ *
+ * \param in Input images in memory
+ * \param out Output HLS stream
+ * \param numReps Number of images to be read
+ */
+template<unsigned int DataWidth, unsigned int Groups, typename Geometry>
+void Mem2Stream_Tiled_Batch(ap_uint<DataWidth> const * in, hls::stream<ap_uint<DataWidth> > & out, const unsigned int numReps) {
+  unsigned int const  ImageWords = Geometry::ifm_x * Geometry::ifm_y * Groups;
+  unsigned int const  RowWords = Geometry::tile_ifm_x * Groups;
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+    for (unsigned int t = 0; t < Geometry::tiles; t++) {
+      int const  x0 = Geometry::ifm_col(t);
+      for (unsigned int row = 0; row < Geometry::tile_ifm_y; row++) {
+        int const  y = int(row) - int(Geometry::pad);
+        bool const  inRow = (y >= 0) && (y < int(Geometry::ifm_y));
+        int const  start = int(rep * ImageWords) + (y * int(Geometry::ifm_x) + x0) * int(Groups);
+        for (unsigned int x = 0, g = 0, i = 0; i < RowWords; i++) {
+#pragma HLS pipeline style=flp II=1
+          int const  col = x0 + int(x);
+          bool const  inside = inRow && (col >= 0) && (col < int(Geometry::ifm_x));
+          out.write(inside? in[start + int(i)] : ap_uint<DataWidth>(0));
+          if (++g == Groups) {
+            g = 0;
+            x++;
+          }
+        }
+      }
+    }
+  }
+}
+
+namespace detail {
+
+/** Generates the base offsets of the output tiles of every image, see Stream2Mem_Tiled_Batch. */
+template<unsigned int Groups, typename Geometry>
+void tile_bases(hls::stream<ap_uint<32> > & bases, const unsigned int numReps) {
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+    for (unsigned int t = 0; t < Geometry::tiles; t++) {
+#pragma HLS pipeline style=flp II=1
+      bases.write((rep * Geometry::ofm_y * Geometry::ofm_x + Geometry::ofm_col(t)) * Groups);
+    }
+  }
+}
+
+} // namespace detail
+
+/*!
+ * \brief DMA block stitching the output tiles of a HLS stream into the output images in memory
+ *
+ * Takes the tiles of every image, see TileGeometry, as output by the chain from the tiles of
+ * Mem2Stream_Tiled_Batch, each row by row over its tile_ofm_x columns, and writes them into their places
+ * in the images, stored row by row, every row pixel by pixel and every pixel as Groups words. The columns
+ * shared by the last tile and its neighbour are written twice with the same values.
+ *
+ * \tparam DataWidth Width, in number of bits, of the AXI4 memory pointer and the input HLS stream
+ * \tparam Groups Number of words per pixel
+ * \tparam Geometry TileGeometry of the tiles
+ * \tparam MaxBurst Maximum number of beats per burst
+ *
+ * \param in Input HLS stream
+ * \param out Output images in memory
+ * \param numReps Number of images to be written
+ */
+template<unsigned int DataWidth, unsigned int Groups, typename Geometry, unsigned int MaxBurst = 64>
+void Stream2Mem_Tiled_Batch(hls::stream<ap_uint<DataWidth> > & in, ap_uint<DataWidth> * out, const unsigned int numReps) {
+#pragma HLS DATAFLOW
+  Stream2MemLayout const  layout = {
+    Geometry::ofm_y, Geometry::tile_ofm_x, Groups, Geometry::ofm_x * Groups, 1, 0, 0
+  };
+  hls::stream<ap_uint<32> >  bases("Stream2Mem_Tiled_Batch.bases");
+#pragma HLS STREAM variable=bases depth=Geometry::tiles
+  detail::tile_bases<Groups, Geometry>(bases, numReps);
+  detail::layout_write<DataWidth, MaxBurst>(in, bases, out, layout, numReps * Geometry::tiles);
+}
+
 #endif
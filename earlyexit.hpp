@@ -0,0 +1,330 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+/*******************************************************************************
+ *
+ *  \file earlyexit.hpp
+ *
+ *  Library of templated HLS functions for BNN deployment.
+ *  This file lists the blocks of early-exit classifiers, whose side heads
+ *  classify the confident frames early so that the rest of the network
+ *  only computes the others.
+ *
+ *  A side branch, split off the trunk by DuplicateStreams_Batch and ending in
+ *  a small classifier, feeds EarlyExitSelect_Batch, which passes the result of
+ *  every confident frame to EarlyExitMerge_Batch and tells EarlyExitGate_Batch
+ *  on the trunk to drop that frame. The gate sends a frame token per frame down
+ *  the trunk, which marks whether the frame survived. Every stage beyond the
+ *  gate is wrapped by EarlyExitStage_Batch, which runs it on the surviving
+ *  frames only as they arrive, so that the whole early-exit network is a single
+ *  dataflow region. EarlyExitMerge_Batch writes the early results as soon as
+ *  they are decided and the final results as the trunk completes them. Every
+ *  result carries the tag of its frame to restore the frame order.
+ *
+ *******************************************************************************/
+
+#ifndef EARLYEXIT_HPP
+#define EARLYEXIT_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "utils.hpp"
+
+/**
+ * \brief   Word format of the results of an early-exit classifier
+ *
+ * Layout from the LSB: label, frame tag, and whether the frame exited early. The tag is the
+ * frame number modulo 2^TagBits.
+ *
+ * \tparam     TagBits  Width of the frame tags
+ * \tparam     Out_T    Datatype of the labels
+ */
+template<unsigned int TagBits, typename Out_T>
+struct EarlyExitToken {
+  static constexpr unsigned int  width = Out_T::width + TagBits + 1;
+  using type = ap_uint<width>;
+  using tag_t = ap_uint<TagBits>;
+
+  static type pack(Out_T const &label, tag_t const &tag, bool const  early) {
+#pragma HLS inline
+    type  t;
+    t(Out_T::width - 1, 0) = ap_uint<Out_T::width>(label);
+    t(Out_T::width + TagBits - 1, Out_T::width) = tag;
+    t[width - 1] = early;
+    return  t;
+  }
+  static Out_T label(type const &t) {
+#pragma HLS inline
+    return  Out_T(t(Out_T::width - 1, 0));
+  }
+  static tag_t tag(type const &t) {
+#pragma HLS inline
+    return  t(Out_T::width + TagBits - 1, Out_T::width);
+  }
+  static bool early(type const &t) {
+#pragma HLS inline
+    return  t[width - 1];
+  }
+};
+
+/**
+ * \brief   Word format of the frame tokens passed down the trunk beyond EarlyExitGate_Batch
+ *
+ * Layout from the LSB: frame tag and whether the frame survived the early exits.
+ *
+ * \tparam     TagBits  Width of the frame tags
+ */
+template<unsigned int TagBits>
+struct EarlyExitFrame {
+  static constexpr unsigned int  width = TagBits + 1;
+  using type = ap_uint<width>;
+  using tag_t = ap_uint<TagBits>;
+
+  static type pack(tag_t const &tag, bool const  valid) {
+#pragma HLS inline
+    type  t;
+    t(TagBits - 1, 0) = tag;
+    t[width - 1] = valid;
+    return  t;
+  }
+  static tag_t tag(type const &t) {
+#pragma HLS inline
+    return  t(TagBits - 1, 0);
+  }
+  static bool valid(type const &t) {
+#pragma HLS inline
+    return  t[width - 1];
+  }
+};
+
+/**
+ * \brief   Early-exit decision - selects the top class of the side head and exits the confident frames
+ *
+ * Scans the NumClasses scores of every frame as LabelSelect_Batch with NumTop = 1, the lowest label
+ * winning ties. A frame whose top score exceeds threshold is confident: its label is written to exits
+ * together with its tag. The decision of every frame is written to decisions for EarlyExitGate_Batch.
+ *
+ * \tparam NumClasses   Number of classes of the side head
+ * \tparam PECount      Number of scores processed in parallel
+ * \tparam TagBits      Width of the frame tags
+ * \tparam In_T         Datatype of the scores
+ * \tparam Out_T        Datatype of the labels
+ *
+ * \param in            Input stream of the scores
+ * \param exits         Output stream of the early results
+ * \param decisions     Output stream of the decisions, true for an exited frame
+ * \param threshold     Score the top class must exceed for an early exit
+ * \param numReps       Number of frames
+ */
+template<
+  unsigned int NumClasses, unsigned int PECount, unsigned int TagBits,
+  typename In_T, typename Out_T
+>
+void EarlyExitSelect_Batch(
+  hls::stream<ap_uint<PECount * In_T::width>> &in,
+  hls::stream<typename EarlyExitToken<TagBits, Out_T>::type> &exits,
+  hls::stream<ap_uint<1>> &decisions,
+  In_T const &threshold,
+  unsigned int const  numReps
+) {
+  static_assert(NumClasses % PECount == 0, "PECount must divide NumClasses");
+  static_assert(clog2(NumClasses) <= Out_T::width - Out_T::sign_flag, "");
+  constexpr unsigned int  NF = NumClasses / PECount;
+  using Token = EarlyExitToken<TagBits, Out_T>;
+
+  In_T   best;
+  Out_T  label;
+  unsigned int  f = 0;
+  ap_uint<TagBits>  tag = 0;
+  for(unsigned int  i = 0; i < numReps * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+    ap_uint<PECount * In_T::width> const  inval = in.read();
+
+    // Best of the word, the lowest lane winning ties
+    In_T   wbest = inval(In_T::width - 1, 0);
+    Out_T  wlabel = f * PECount;
+    for(unsigned int  pe = 1; pe < PECount; pe++) {
+#pragma HLS UNROLL
+      In_T const  val = inval((pe+1) * In_T::width - 1, pe * In_T::width);
+      if(val > wbest) {
+        wbest = val;
+        wlabel = f * PECount + pe;
+      }
+    }
+    if((f == 0) || (wbest > best)) {
+      best = wbest;
+      label = wlabel;
+    }
+
+    if(++f == NF) {
+      f = 0;
+      bool const  confident = best > threshold;
+      if(confident)  exits.write(Token::pack(label, tag, true));
+      decisions.write(confident);
+      tag++;
+    }
+  }
+}
+
+/**
+ * \brief   Early-exit gate - drops the exited frames from the trunk
+ *
+ * Forwards the NumWords words of every frame not exited early. The words of an exited frame are
+ * read and dropped, so that the stages beyond the gate skip it altogether. For every frame, a token
+ * with its tag and whether it survived is written to frames, which is passed down the trunk by the
+ * EarlyExitStage_Batch wrappers to EarlyExitMerge_Batch. As the decision of a frame is taken at the
+ * end of the side head, the stream from the DuplicateStreams_Batch splitting off the side branch to
+ * the gate needs a depth of about one frame for the stages before the gate not to stall.
+ *
+ * \tparam NumWords     Number of words per frame of the trunk
+ * \tparam TagBits      Width of the frame tags
+ * \tparam T            Type of the trunk words
+ *
+ * \param in            Input stream of the trunk
+ * \param out           Output stream of the surviving frames
+ * \param decisions     Input stream of the decisions of EarlyExitSelect_Batch
+ * \param frames        Output stream of the frame tokens, one per frame
+ * \param numReps       Number of frames
+ */
+template<unsigned int NumWords, unsigned int TagBits, typename T>
+void EarlyExitGate_Batch(
+  hls::stream<T> &in, hls::stream<T> &out,
+  hls::stream<ap_uint<1>> &decisions,
+  hls::stream<typename EarlyExitFrame<TagBits>::type> &frames,
+  unsigned int const  numReps
+) {
+  using Frame = EarlyExitFrame<TagBits>;
+  ap_uint<TagBits>  tag = 0;
+  unsigned int  w = 0;
+  bool  drop = false;
+  for(unsigned int  i = 0; i < numReps * NumWords; i++) {
+#pragma HLS pipeline style=flp II=1
+    if(w == 0) {
+      drop = decisions.read();
+      frames.write(Frame::pack(tag, !drop));
+      tag++;
+    }
+    T const  val = in.read();
+    if(!drop)  out.write(val);
+    if(++w == NumWords)  w = 0;
+  }
+}
+
+/**
+ * \brief   Early-exit trunk stage - runs a stage beyond EarlyExitGate_Batch on the surviving frames
+ *
+ * Passes on the token of every frame and calls stage(1) for each surviving one, so that the stage
+ * processes a single frame per call. The token is forwarded ahead of the frame for the next stage
+ * to start on it while this one is still computing.
+ *
+ * \tparam TagBits      Width of the frame tags
+ * \tparam F            Type of the stage, callable with the number of frames to process
+ *
+ * \param frames_in     Input stream of the frame tokens
+ * \param frames_out    Output stream of the frame tokens
+ * \param stage         Stage of the trunk, e.g. a functor calling a layer with its streams
+ * \param numReps       Number of frames, including the exited ones
+ */
+template<unsigned int TagBits, typename F>
+void EarlyExitStage_Batch(
+  hls::stream<typename EarlyExitFrame<TagBits>::type> &frames_in,
+  hls::stream<typename EarlyExitFrame<TagBits>::type> &frames_out,
+  F const &stage,
+  unsigned int const  numReps
+) {
+  using Frame = EarlyExitFrame<TagBits>;
+  for(unsigned int  f = 0; f < numReps; f++) {
+    typename Frame::type const  t = frames_in.read();
+    frames_out.write(t);
+    if(Frame::valid(t))  stage(1);
+  }
+}
+
+/**
+ * \brief   Early-exit merge - collects the early and the final results
+ *
+ * Writes the early results of EarlyExitSelect_Batch as soon as they arrive. The final labels of the
+ * trunk, e.g. of a LabelSelect_Batch with NumTop = 1, are tagged by the tokens of the surviving
+ * frames passed down the trunk. As both inputs are polled, neither can hold up the other. The
+ * results are written in order of completion, one per frame, marked whether it exited early. Their
+ * tags need to tell apart all frames in flight at a time for the frame order to be restored.
+ *
+ * \tparam TagBits      Width of the frame tags
+ * \tparam Out_T        Datatype of the labels
+ *
+ * \param early         Input stream of the early results
+ * \param late          Input stream of the final labels of the surviving frames
+ * \param frames        Input stream of the frame tokens from the end of the trunk
+ * \param out           Output stream of the results
+ * \param numReps       Number of frames
+ */
+template<unsigned int TagBits, typename Out_T>
+void EarlyExitMerge_Batch(
+  hls::stream<typename EarlyExitToken<TagBits, Out_T>::type> &early,
+  hls::stream<Out_T> &late,
+  hls::stream<typename EarlyExitFrame<TagBits>::type> &frames,
+  hls::stream<typename EarlyExitToken<TagBits, Out_T>::type> &out,
+  unsigned int const  numReps
+) {
+  using Token = EarlyExitToken<TagBits, Out_T>;
+  using Frame = EarlyExitFrame<TagBits>;
+  unsigned int  seen = 0;
+  bool  pending = false;
+  ap_uint<TagBits>  tag = 0;
+  for(unsigned int  emitted = 0; emitted < numReps;) {
+#pragma HLS pipeline style=flp II=1
+    if(!early.empty()) {
+      out.write(early.read());
+      emitted++;
+    }
+    else if(pending) {
+      if(!late.empty()) {
+        out.write(Token::pack(late.read(), tag, false));
+        pending = false;
+        emitted++;
+      }
+    }
+    else if(!frames.empty()) {
+      typename Frame::type const  t = frames.read();
+      seen++;
+      pending = Frame::valid(t);
+      tag = Frame::tag(t);
+    }
+  }
+  // tokens of the frames exited after the last survivor
+  for(; seen < numReps; seen++) {
+#pragma HLS pipeline style=flp II=1
+    frames.read();
+  }
+}
+
+#endif
@@ -92,4 +92,156 @@ void StreamingEltwise(
 	}
 };
 
+/**
+ * \brief Operand layouts of the second input of StreamingEltwise_Batch
+ *
+ * NONE:    a full tensor, like the first input
+ * CHANNEL: one vector of Channels elements per image, read with the first pixel and held on chip
+ * SCALAR:  one word per image, whose first element is applied to all channels
+ */
+enum class EltwiseBroadcast { NONE, CHANNEL, SCALAR };
+
+/**
+ * \brief StreamingEltwise function for multiple images, with optional broadcast of the second input
+ *
+ * The function performs a generic eltwise function on two streams and produces an output stream.
+ * Broadcasting in1 over the pixels (e.g. the channel scales of a squeeze-and-excitation block or a
+ * bias) reduces its traffic by a factor of N.
+ *
+ * \tparam Channels   Number of channels for eltwise operation
+ * \tparam PE         Number of channels for eltwise operation computed in parallel
+ * \tparam N          Number of pixels per image
+ * \tparam SliceIn0   Data slicer for input 0 type
+ * \tparam SliceIn1   Data slicer for input 1 type
+ * \tparam SliceOut   Data slicer for output type
+ * \tparam Broadcast  Layout of input 1, see EltwiseBroadcast
+ * \tparam TStrmIn0   Type of the input 0 stream - safely deducible from the paramaters
+ * \tparam TStrmIn1   Type of the input 1 stream - safely deducible from the paramaters
+ * \tparam TStrmOut   Type of the output - safely deducible from the paramaters
+ * \tparam TFxn       Type of the function class (e.g. Max, Avg, Sum) - safely deducible from the paramaters
+ *
+ * \param in0         Input stream 0
+ * \param in1         Input stream 1
+ * \param out         Output stream
+ * \param reps        Number of images
+ * \param function    Function to apply, derived from EltwiseFunction
+ */
+template<
+	unsigned Channels, unsigned PE, unsigned N,
+	typename SliceIn0, typename SliceIn1, typename SliceOut,
+	EltwiseBroadcast Broadcast = EltwiseBroadcast::NONE,
+	typename TStrmIn0, typename TStrmIn1, typename TStrmOut,
+	typename Fxn
+>
+void StreamingEltwise_Batch(
+	hls::stream<TStrmIn0> &in0,
+	hls::stream<TStrmIn1> &in1,
+	hls::stream<TStrmOut> &out,
+	unsigned const  reps,
+	Fxn &&f
+) {
+	static_assert(Channels % PE == 0, "PE must divide Channels");
+	constexpr unsigned  CF = Channels / PE;
+
+	// broadcast operand held on chip
+	TStrmIn1  buf[CF];
+	TStrmIn1  scalar;
+
+	unsigned  cf = 0;
+	unsigned  n  = 0;
+	for(unsigned  i = 0; i < reps * CF * N; i++) {
+#pragma HLS pipeline style=flp II=1
+		TStrmIn1  in1_word;
+		switch(Broadcast) {
+		case EltwiseBroadcast::NONE:
+			in1_word = in1.read();
+			break;
+		case EltwiseBroadcast::CHANNEL:
+			if(n == 0)  buf[cf] = in1.read();
+			in1_word = buf[cf];
+			break;
+		case EltwiseBroadcast::SCALAR:
+			if((n == 0) && (cf == 0))  scalar = in1.read();
+			in1_word = scalar;
+			break;
+		}
+
+		auto const  in0_slice_channels = SliceIn0()(in0.read(), 0);
+		auto const  in1_slice_channels = SliceIn1()(in1_word, 0);
+		auto outElem = SliceOut().template operator()<TStrmOut>();
+		for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+			unsigned const  idx = (Broadcast == EltwiseBroadcast::SCALAR)? 0 : pe;
+			outElem(pe, 0, 1) = f(in0_slice_channels(pe, 0), in1_slice_channels(idx, 0));
+		}
+		out.write(outElem);
+
+		if(++cf == CF) {
+			cf = 0;
+			if(++n == N)  n = 0;
+		}
+	}
+}
+
+namespace detail {
+
+/** Applies f lane by lane to the sliced words of all inputs of StreamingEltwise_Fused_Batch. */
+template<unsigned PE, typename TOut, typename Fxn, typename... TIns>
+void eltwise_fused_apply(TOut &outElem, Fxn &f, TIns const&... ins) {
+#pragma HLS inline
+	for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+		outElem(pe, 0, 1) = f(ins(pe, 0)...);
+	}
+}
+
+} // namespace detail
+
+/**
+ * \brief Fused elementwise function of any number of streams, for multiple images
+ *
+ * Reads one word from every input stream per cycle and applies the fused function f to the
+ * corresponding lanes of all of them, e.g. [](auto a, auto b, auto c) { return relu(a + 3*b + c); }
+ * for the merge of a feature pyramid. One stage replaces the chain of N-1 two-input
+ * StreamingEltwise_Batch stages, together with their intermediate FIFOs and the truncation of
+ * their intermediate results.
+ *
+ * \tparam Channels   Number of channels for eltwise operation
+ * \tparam PE         Number of channels for eltwise operation computed in parallel
+ * \tparam N          Number of pixels per image
+ * \tparam SliceOut   Data slicer for output type
+ * \tparam SliceIns   Data slicers for the input types, one per input stream
+ * \tparam TStrmOut   Type of the output - safely deducible from the paramaters
+ * \tparam Fxn        Type of the function class - safely deducible from the paramaters
+ * \tparam TStrmIns   Types of the input streams - safely deducible from the paramaters
+ *
+ * \param out         Output stream
+ * \param reps        Number of images
+ * \param f           Function to apply, taking one argument per input stream
+ * \param in          Input streams, in the order of SliceIns
+ */
+template<
+	unsigned Channels, unsigned PE, unsigned N,
+	typename SliceOut, typename... SliceIns,
+	typename TStrmOut, typename Fxn, typename... TStrmIns
+>
+void StreamingEltwise_Fused_Batch(
+	hls::stream<TStrmOut> &out,
+	unsigned const  reps,
+	Fxn &&f,
+	hls::stream<TStrmIns>&... in
+) {
+	static_assert(Channels % PE == 0, "PE must divide Channels");
+	static_assert(sizeof...(SliceIns) == sizeof...(TStrmIns), "Need one slicer per input stream");
+	static_assert(sizeof...(TStrmIns) > 0, "Need at least one input stream");
+	constexpr unsigned  CF = Channels / PE;
+
+	for(unsigned  i = 0; i < reps * CF * N; i++) {
+#pragma HLS pipeline style=flp II=1
+		auto outElem = SliceOut().template operator()<TStrmOut>();
+		detail::eltwise_fused_apply<PE>(outElem, f, SliceIns()(in.read(), 0)...);
+		out.write(outElem);
+	}
+}
+
 #endif
@@ -0,0 +1,174 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *
+ *  \file embedding.hpp
+ *
+ *  Library of templated HLS functions for BNN deployment.
+ *  This file lists the embedding lookup blocks, which turn a stream of token
+ *  indices into the stream of their embedding vectors, from a table on chip
+ *  or in external memory.
+ *
+ *  An embedding vector of EmbeddingDim elements is stored as EmbeddingDim/SIMD
+ *  words of SIMD elements, the first elements in the LSBs of the first word,
+ *  and is emitted in this order.
+ *
+ *******************************************************************************/
+
+#ifndef EMBEDDING_HPP
+#define EMBEDDING_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "utils.hpp"
+
+/**
+ * \brief Embedding lookup from an on-chip table
+ *
+ * Emits the EmbeddingDim/SIMD words of the table row of every input index, one word per cycle. The table is
+ * an array of the caller, typically a top-level static array bound to BRAM or URAM with a BIND_STORAGE pragma
+ * (URAM tables are not initialized by the bitstream and must be written before the first lookup).
+ *
+ * \tparam NumEmbeddings  Number of rows of the table
+ * \tparam EmbeddingDim   Number of elements of an embedding vector
+ * \tparam SIMD           Number of elements per output word
+ * \tparam In_t           Element datatype
+ * \tparam TI             DataType of the index stream - safely deducible from the paramaters
+ *
+ * \param in              Input stream of indices, those not below NumEmbeddings yield zero vectors
+ * \param out             Output stream of embedding vectors
+ * \param table           Embedding table
+ * \param numReps         Number of indices
+ */
+template<
+	unsigned int NumEmbeddings,
+	unsigned int EmbeddingDim,
+	unsigned int SIMD,
+	typename In_t,
+	typename TI
+>
+void EmbeddingLookup_Batch(
+	hls::stream<TI> &in,
+	hls::stream<ap_uint<SIMD*In_t::width>> &out,
+	ap_uint<SIMD*In_t::width> const (&table)[NumEmbeddings][EmbeddingDim/SIMD],
+	unsigned int const  numReps
+) {
+	static_assert(EmbeddingDim % SIMD == 0, "SIMD must divide EmbeddingDim.");
+	constexpr unsigned int  Words = EmbeddingDim / SIMD;
+
+	unsigned int  row = 0;
+	unsigned int  w = 0;
+	for(unsigned int  i = 0; i < numReps * Words; i++) {
+#pragma HLS pipeline style=flp II=1
+		if(w == 0)  row = in.read();
+		out.write(row < NumEmbeddings? table[row][w] : ap_uint<SIMD*In_t::width>(0));
+		if(++w == Words)  w = 0;
+	}
+}
+
+/**
+ * \brief Embedding lookup from external memory with an on-chip cache of hot rows
+ *
+ * For tables exceeding the on-chip memory, e.g. held in HBM. The table is read through the AXI4 master
+ * table, NumEmbeddings rows of EmbeddingDim/SIMD words each. The reads of consecutive lookups are issued
+ * one word per cycle without waiting for any previous one to complete, so that the memory latency is hidden
+ * given enough outstanding reads of the AXI4 interface.
+ *
+ * The first CachedRows rows are kept in an on-chip cache owned by the caller and are served from there.
+ * Vocabularies sorted by token frequency, as produced by most tokenizers, thus keep their most frequent
+ * rows on chip. The cache is filled by the first call, taking CachedRows*EmbeddingDim/SIMD cycles, and is
+ * reused by all later ones. Indices not below NumEmbeddings yield zero vectors without accessing the table.
+ *
+ * \tparam NumEmbeddings  Number of rows of the table
+ * \tparam EmbeddingDim   Number of elements of an embedding vector
+ * \tparam SIMD           Number of elements per output word
+ * \tparam In_t           Element datatype
+ * \tparam CachedRows     Number of leading rows kept on chip, 0 for none
+ * \tparam TI             DataType of the index stream - safely deducible from the paramaters
+ * \tparam R              Resource type of the cache - safely deducible from the paramaters
+ *
+ * \param in              Input stream of indices
+ * \param out             Output stream of embedding vectors
+ * \param table           Pointer to the embedding table in external memory
+ * \param numReps         Number of indices
+ * \param cache           Cache of the leading rows persisting across calls, see OnChipCache
+ * \param r               Resource type of the cache, see memory_resource
+ */
+template<
+	unsigned int NumEmbeddings,
+	unsigned int EmbeddingDim,
+	unsigned int SIMD,
+	typename In_t,
+	unsigned int CachedRows = 0,
+	typename TI,
+	typename R = ap_resource_uram
+>
+void EmbeddingLookup_External_Batch(
+	hls::stream<TI> &in,
+	hls::stream<ap_uint<SIMD*In_t::width>> &out,
+	ap_uint<SIMD*In_t::width> const *table,
+	unsigned int const  numReps,
+	OnChipCache<(CachedRows? CachedRows : 1) * (EmbeddingDim/SIMD), SIMD*In_t::width> &cache,
+	R const &r = R()
+) {
+	static_assert(EmbeddingDim % SIMD == 0, "SIMD must divide EmbeddingDim.");
+	static_assert(CachedRows <= NumEmbeddings, "Cannot cache more rows than the table has.");
+	constexpr unsigned int  Words = EmbeddingDim / SIMD;
+	constexpr unsigned int  CacheWords = CachedRows * Words;
+	memory_resource(cache.words, r);
+
+	if(numReps == 0)  return;
+	if(!cache.loaded) {
+		for(unsigned int  i = 0; i < CacheWords; i++) {
+#pragma HLS pipeline style=flp II=1
+			cache.words[i] = table[i];
+		}
+		cache.loaded = true;
+	}
+
+	unsigned int  row = 0;
+	unsigned int  w = 0;
+	for(unsigned int  i = 0; i < numReps * Words; i++) {
+#pragma HLS pipeline style=flp II=1
+		if(w == 0)  row = in.read();
+		unsigned int const  addr = row * Words + w;
+		ap_uint<SIMD*In_t::width>  val = 0;
+		if(row < CachedRows)          val = cache.words[addr];
+		else if(row < NumEmbeddings)  val = table[addr];
+		out.write(val);
+		if(++w == Words)  w = 0;
+	}
+}
+
+#endif
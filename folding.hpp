@@ -0,0 +1,170 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *
+ *  \file folding.hpp
+ *
+ *  Compile-time selection of the folding factors of compute layers.
+ *
+ *  For a layer shape and a target number of cycles per frame, the helpers
+ *  search all SIMD, PE (and MMV) choices satisfying the divisibility
+ *  constraints of the layer and return the one with the smallest resource
+ *  proxy SIMD*PE*MMV whose modelled cycles meet the target. Ties are resolved
+ *  in favour of fewer cycles. The cycles are those of the models in
+ *  cycles.hpp, so that layers tuned to the same target form a balanced
+ *  dataflow pipeline. The result is a literal type usable as template
+ *  arguments:
+ *
+ *    constexpr Folding  F = ConvLayer_Batch_folding<3, 64, 32, 64, 30>(20000);
+ *    static_assert(F.meets, "Layer too large for the target rate.");
+ *    ConvLayer_Batch<3, 64, 32, 64, 30, F.simd, F.pe, ...>(...);
+ *
+ *  If no folding meets the target, the fastest one is returned with meets
+ *  cleared.
+ *
+ *******************************************************************************/
+
+#ifndef FOLDING_HPP
+#define FOLDING_HPP
+
+#include "cycles.hpp"
+
+/**
+ * \brief Folding factors of a layer together with their modelled cycles per frame
+ */
+struct Folding {
+	unsigned  simd;		// input columns computed in parallel
+	unsigned  pe;		// output rows computed in parallel
+	unsigned  mmv;		// output pixels computed in parallel
+	cycles_t  cycles;	// modelled cycles per frame
+	bool      meets;	// cycles within the requested target
+
+	/** Resource proxy of the folding, proportional to the number of multipliers. */
+	constexpr unsigned cost() const {
+		return  simd * pe * mmv;
+	}
+};
+
+namespace detail {
+
+	/** Whether folding a is a better choice than folding b. */
+	constexpr bool folding_better(Folding const &a, Folding const &b) {
+		if(a.meets != b.meets)  return  a.meets;
+		if(a.meets) {
+			// cheapest folding meeting the target, the faster one on a tie
+			return  (a.cost() < b.cost()) || ((a.cost() == b.cost()) && (a.cycles < b.cycles));
+		}
+		// fastest folding if none meets the target, the cheaper one on a tie
+		return  (a.cycles < b.cycles) || ((a.cycles == b.cycles) && (a.cost() < b.cost()));
+	}
+
+} // namespace detail
+
+/**
+ * \brief Folding of Matrix_Vector_Activate_Batch and Matrix_Vector_Activate_Stream_Batch
+ *
+ * \tparam MatrixW	Width of the input matrix
+ * \tparam MatrixH	Heigth of the input matrix
+ * \tparam MaxSIMD	Upper limit of the SIMD parallelism
+ * \tparam MaxPE	Upper limit of the PE parallelism
+ *
+ * \param target	Target number of cycles per frame
+ * \param vectors	Number of input vectors per frame
+ *
+ * \return		Folding with mmv = 1 and SIMD dividing MatrixW, PE dividing MatrixH
+ */
+template<unsigned MatrixW, unsigned MatrixH, unsigned MaxSIMD = MatrixW, unsigned MaxPE = MatrixH>
+constexpr Folding Matrix_Vector_Activate_Batch_folding(cycles_t const  target, unsigned const  vectors = 1) {
+	static_assert((MaxSIMD > 0) && (MaxPE > 0), "Parallelism limits must be positive.");
+	Folding  best { 1, 1, 1, detail::mvau_cycles(MatrixW, MatrixH, 1, 1, vectors), false };
+	best.meets = best.cycles <= target;
+	for(unsigned  simd = 1; simd <= std::min(MatrixW, MaxSIMD); simd++) {
+		if(MatrixW % simd != 0)  continue;
+		for(unsigned  pe = 1; pe <= std::min(MatrixH, MaxPE); pe++) {
+			if(MatrixH % pe != 0)  continue;
+			cycles_t const  cycles = detail::mvau_cycles(MatrixW, MatrixH, simd, pe, vectors);
+			Folding const  cand { simd, pe, 1, cycles, cycles <= target };
+			if(detail::folding_better(cand, best))  best = cand;
+		}
+	}
+	return  best;
+}
+
+/**
+ * \brief Folding of ConvLayer_Batch and ConvLayer_Batch_MMV
+ *
+ * The frame rate of the layer is limited by the slower of its sliding window
+ * generator and its MVAU, which share the SIMD parallelism. The SIMD is chosen
+ * among the divisors of IFMChannels, the PE among those of OFMChannels and
+ * the MMV among those of OFMDim up to MaxMMV. ConvLayer_Batch is only
+ * available for MaxMMV = 1 and Stride = 1, use ConvLayer_Batch_MMV otherwise.
+ *
+ * \tparam ConvKernelDim	Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels		Number of Input Feature Maps
+ * \tparam IFMDim		Width and Heigth of the Input Feature Map (assumed square)
+ * \tparam OFMChannels		Number of Output Feature Maps
+ * \tparam OFMDim		Width and Heigth of the Output Feature Map (assumed square)
+ * \tparam Stride		Stride of the convolutional kernel
+ * \tparam MaxMMV		Upper limit of the MMV parallelism
+ * \tparam MaxSIMD		Upper limit of the SIMD parallelism
+ * \tparam MaxPE		Upper limit of the PE parallelism
+ *
+ * \param target		Target number of cycles per frame
+ */
+template<
+	unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMChannels, unsigned OFMDim,
+	unsigned Stride = 1, unsigned MaxMMV = 1, unsigned MaxSIMD = IFMChannels, unsigned MaxPE = OFMChannels
+>
+constexpr Folding ConvLayer_Batch_folding(cycles_t const  target) {
+	static_assert((MaxMMV > 0) && (MaxSIMD > 0) && (MaxPE > 0), "Parallelism limits must be positive.");
+	constexpr unsigned  MatrixW = ConvKernelDim * ConvKernelDim * IFMChannels;
+	constexpr unsigned  MatrixH = OFMChannels;
+	Folding  best { 0, 0, 0, 0, false };
+	for(unsigned  mmv = 1; mmv <= std::min(OFMDim, MaxMMV); mmv++) {
+		if(OFMDim % mmv != 0)  continue;
+		for(unsigned  simd = 1; simd <= std::min(IFMChannels, MaxSIMD); simd++) {
+			if(IFMChannels % simd != 0)  continue;
+			cycles_t const  swg = detail::swg_cycles(ConvKernelDim, IFMChannels, IFMDim, OFMDim, simd, Stride, mmv, 1, 1);
+			for(unsigned  pe = 1; pe <= std::min(OFMChannels, MaxPE); pe++) {
+				if(OFMChannels % pe != 0)  continue;
+				cycles_t const  mvau = detail::mvau_cycles(MatrixW, MatrixH, simd, pe, OFMDim * OFMDim / mmv);
+				cycles_t const  cycles = std::max(swg, mvau);
+				Folding const  cand { simd, pe, mmv, cycles, cycles <= target };
+				if((best.simd == 0) || detail::folding_better(cand, best))  best = cand;
+			}
+		}
+	}
+	return  best;
+}
+
+#endif
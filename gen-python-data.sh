@@ -42,4 +42,5 @@ python3 gen_weigths_nonsquare_dws.py
 python3 gen_params_stmr.py tmrcheck
 python3 gen_params_stmr.py no_inj
 python3 gen_params_stmr.py inj
+python3 gen_param_file.py
 
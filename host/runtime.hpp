@@ -0,0 +1,439 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+/*******************************************************************************
+ *
+ *  \file host/runtime.hpp
+ *
+ *  Host-side runtime for accelerators built around the DMA blocks of dma.h,
+ *  i.e. top-level kernels taking an input buffer, an output buffer and the
+ *  number of images, in this order, as
+ *
+ *    void top(ap_uint<IW> *in, ap_uint<OW> *out, unsigned numReps) {
+ *      Mem2Stream_Batch<IW, InBytes>(in, ...); ... Stream2Mem_Batch<OW, OutBytes>(..., out, numReps);
+ *    }
+ *
+ *  A BufferPool allocates the buffers of a fixed number of batches once, as
+ *  pinned host memory the device accesses directly where the backend allows,
+ *  so that the application writes its images into and reads its results from
+ *  the mapped buffers without copying. A Queue keeps up to a given number of
+ *  batches in flight: submit starts a batch and returns at once, unless the
+ *  queue is full, and a completion thread retires the batches in order,
+ *  recording their timing and calling back the application.
+ *
+ *  The device is accessed through a backend providing
+ *
+ *    using buffer = ...;                      device buffer
+ *    using run = ...;                         handle of a started batch
+ *    buffer alloc(std::size_t bytes, unsigned arg);
+ *    void *map(buffer &b);
+ *    void to_device(buffer &b, std::size_t bytes);
+ *    void from_device(buffer &b, std::size_t bytes);
+ *    run start(buffer &in, buffer &out, unsigned reps);
+ *    void wait(run &r);
+ *
+ *  XrtBackend, available with FINN_HOST_XRT defined, runs the kernel of an
+ *  xclbin through the XRT native API. FunctionBackend runs a C++ function,
+ *  e.g. the C simulation of the top-level kernel, on a worker thread.
+ *
+ *******************************************************************************/
+
+#ifndef FINN_HOST_RUNTIME_HPP
+#define FINN_HOST_RUNTIME_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef FINN_HOST_XRT
+#include <xrt/xrt_bo.h>
+#include <xrt/xrt_device.h>
+#include <xrt/xrt_kernel.h>
+#endif
+
+namespace finn {
+namespace host {
+
+/**
+ * \brief   Buffer layout of Mem2Stream_Batch and Stream2Mem_Batch
+ *
+ * The images of a batch are stored back to back, numBytes each, as numBytes/(DataWidth/8) words of
+ * DataWidth bits, the first word of every image at its lowest address.
+ */
+struct StreamLayout {
+  std::size_t  word_bytes;   // DataWidth/8
+  std::size_t  image_bytes;  // numBytes
+
+  template<unsigned int DataWidth, unsigned int numBytes>
+  static constexpr StreamLayout of() {
+    static_assert(DataWidth % 8 == 0, "");
+    static_assert(numBytes % (DataWidth / 8) == 0, "numBytes must be a multiple of the word size");
+    return  StreamLayout{ DataWidth / 8, numBytes };
+  }
+
+  constexpr std::size_t words_per_image() const {
+    return  image_bytes / word_bytes;
+  }
+  constexpr std::size_t bytes(unsigned const  reps) const {
+    return  reps * image_bytes;
+  }
+  template<typename T = unsigned char>
+  T *image(void *base, unsigned const  rep) const {
+    return  reinterpret_cast<T*>(static_cast<unsigned char*>(base) + rep * image_bytes);
+  }
+  template<typename T = unsigned char>
+  T const *image(void const *base, unsigned const  rep) const {
+    return  reinterpret_cast<T const*>(static_cast<unsigned char const*>(base) + rep * image_bytes);
+  }
+};
+
+/**
+ * \brief   Timing of a batch, reported when it completes
+ */
+struct BatchTiming {
+  using clock = std::chrono::steady_clock;
+  std::uint64_t      id;         // sequence number of the batch
+  unsigned           reps;       // images of the batch
+  clock::time_point  submitted;  // submit called
+  clock::time_point  started;    // input synchronized and kernel started
+  clock::time_point  completed;  // kernel done and output synchronized
+
+  double latency_us() const {
+    return  std::chrono::duration<double, std::micro>(completed - submitted).count();
+  }
+  double device_us() const {
+    return  std::chrono::duration<double, std::micro>(completed - started).count();
+  }
+};
+
+/**
+ * \brief   Pool of the input and output buffers of a fixed number of batches
+ *
+ * All buffers are allocated and mapped upfront, sized for maxReps images. acquire blocks until a batch
+ * buffer is free, it is returned to the pool once its batch has completed and the completion callback
+ * has returned.
+ */
+template<typename Backend>
+class BufferPool {
+ public:
+  struct Slot {
+    typename Backend::buffer  in;
+    typename Backend::buffer  out;
+    void  *in_ptr;
+    void  *out_ptr;
+  };
+
+ private:
+  Backend            &m_backend;
+  StreamLayout const  m_in_layout;
+  StreamLayout const  m_out_layout;
+  unsigned const      m_max_reps;
+  std::vector<std::unique_ptr<Slot>>  m_slots;
+  std::vector<Slot*>  m_free;
+  std::mutex               m_mutex;
+  std::condition_variable  m_cv;
+
+ public:
+  BufferPool(Backend &backend, StreamLayout const &in_layout, StreamLayout const &out_layout,
+             unsigned const  maxReps, unsigned const  numSlots, unsigned const  inArg = 0, unsigned const  outArg = 1)
+    : m_backend(backend), m_in_layout(in_layout), m_out_layout(out_layout), m_max_reps(maxReps) {
+    for(unsigned  i = 0; i < numSlots; i++) {
+      std::unique_ptr<Slot>  s(new Slot{
+        backend.alloc(in_layout.bytes(maxReps), inArg), backend.alloc(out_layout.bytes(maxReps), outArg),
+        nullptr, nullptr
+      });
+      s->in_ptr  = backend.map(s->in);
+      s->out_ptr = backend.map(s->out);
+      m_free.push_back(s.get());
+      m_slots.push_back(std::move(s));
+    }
+  }
+
+  StreamLayout const& in_layout() const { return  m_in_layout; }
+  StreamLayout const& out_layout() const { return  m_out_layout; }
+  unsigned max_reps() const { return  m_max_reps; }
+  unsigned size() const { return  m_slots.size(); }
+
+  Slot &acquire() {
+    std::unique_lock<std::mutex>  lock(m_mutex);
+    m_cv.wait(lock, [this]() { return !m_free.empty(); });
+    Slot *const  s = m_free.back();
+    m_free.pop_back();
+    return *s;
+  }
+  void release(Slot &s) {
+    {
+      std::lock_guard<std::mutex>  lock(m_mutex);
+      m_free.push_back(&s);
+    }
+    m_cv.notify_one();
+  }
+};
+
+/**
+ * \brief   Asynchronous submission queue keeping up to Depth batches in flight
+ *
+ * submit synchronizes the input of the batch to the device and starts it. It blocks only while Depth
+ * batches are in flight. The batches complete in submission order on a dedicated thread, which
+ * synchronizes their output, calls the timing hook and the callback of the batch and finally returns
+ * the buffers to the pool. drain waits for all batches submitted so far. A batch whose input transfer or
+ * start throws is not submitted: its slot is returned to the pool and the exception passed on to the caller.
+ */
+template<typename Backend>
+class Queue {
+ public:
+  using Slot = typename BufferPool<Backend>::Slot;
+  using Callback = std::function<void(Slot&, BatchTiming const&)>;
+  using TimingHook = std::function<void(BatchTiming const&)>;
+
+ private:
+  struct Batch {
+    Slot                     *slot;
+    typename Backend::run     run;
+    Callback                  done;
+    BatchTiming               timing;
+  };
+
+  Backend              &m_backend;
+  BufferPool<Backend>  &m_pool;
+  unsigned const        m_depth;
+  TimingHook            m_hook;
+  std::deque<Batch>     m_flight;
+  std::uint64_t         m_next_id = 0;
+  std::uint64_t         m_retired = 0;
+  unsigned              m_starting = 0;   // batches between the depth check and their start
+  bool                  m_stop = false;
+  std::exception_ptr    m_error;
+  std::mutex               m_mutex;
+  std::condition_variable  m_cv;
+  std::thread              m_worker;
+
+  void retire() {
+    for(;;) {
+      Batch  b;
+      {
+        std::unique_lock<std::mutex>  lock(m_mutex);
+        m_cv.wait(lock, [this]() { return m_stop || !m_flight.empty(); });
+        if(m_flight.empty())  return;
+        b = std::move(m_flight.front());
+      }
+      try {
+        m_backend.wait(b.run);
+        m_backend.from_device(b.slot->out, m_pool.out_layout().bytes(b.timing.reps));
+        b.timing.completed = BatchTiming::clock::now();
+        TimingHook  hook;
+        {
+          std::lock_guard<std::mutex>  lock(m_mutex);
+          hook = m_hook;
+        }
+        if(hook)  hook(b.timing);
+        if(b.done)  b.done(*b.slot, b.timing);
+      }
+      catch(...) {
+        std::lock_guard<std::mutex>  lock(m_mutex);
+        if(!m_error)  m_error = std::current_exception();
+      }
+      m_pool.release(*b.slot);
+      {
+        std::lock_guard<std::mutex>  lock(m_mutex);
+        m_flight.pop_front();
+        m_retired++;
+      }
+      m_cv.notify_all();
+    }
+  }
+
+ public:
+  Queue(Backend &backend, BufferPool<Backend> &pool, unsigned const  depth)
+    : m_backend(backend), m_pool(pool), m_depth(depth? depth : 1) {
+    m_worker = std::thread(&Queue::retire, this);
+  }
+  ~Queue() {
+    drain_nothrow();
+    {
+      std::lock_guard<std::mutex>  lock(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    m_worker.join();
+  }
+  Queue(Queue const&) = delete;
+  Queue& operator=(Queue const&) = delete;
+
+  /** Hook called with the timing of every batch ahead of its own callback. */
+  void on_complete(TimingHook  hook) {
+    std::lock_guard<std::mutex>  lock(m_mutex);
+    m_hook = std::move(hook);
+  }
+
+  /** Starts reps images of an acquired slot, returns the sequence number of the batch. */
+  std::uint64_t submit(Slot &slot, unsigned const  reps, Callback  done = Callback()) {
+    if(reps > m_pool.max_reps())  throw std::invalid_argument("finn::host::Queue: batch exceeds the buffer pool");
+    BatchTiming  timing;
+    timing.reps = reps;
+    timing.submitted = BatchTiming::clock::now();
+    {
+      std::unique_lock<std::mutex>  lock(m_mutex);
+      m_cv.wait(lock, [this]() { return m_flight.size() + m_starting < m_depth; });
+      m_starting++;
+    }
+    Batch  b{ &slot, typename Backend::run(), std::move(done), timing };
+    try {
+      m_backend.to_device(slot.in, m_pool.in_layout().bytes(reps));
+      b.timing.started = BatchTiming::clock::now();
+      b.run = m_backend.start(slot.in, slot.out, reps);
+    }
+    catch(...) {
+      {
+        std::lock_guard<std::mutex>  lock(m_mutex);
+        m_starting--;
+      }
+      m_cv.notify_all();
+      m_pool.release(slot);
+      throw;
+    }
+    // the sequence number is only taken by a started batch, which is bound to be retired
+    {
+      std::lock_guard<std::mutex>  lock(m_mutex);
+      m_starting--;
+      timing.id = b.timing.id = m_next_id++;
+      m_flight.push_back(std::move(b));
+    }
+    m_cv.notify_all();
+    return  timing.id;
+  }
+
+  /** Waits for all batches submitted so far, rethrows the first error of a batch. */
+  void drain() {
+    drain_nothrow();
+    std::lock_guard<std::mutex>  lock(m_mutex);
+    if(m_error) {
+      std::exception_ptr  e = m_error;
+      m_error = nullptr;
+      std::rethrow_exception(e);
+    }
+  }
+
+  std::uint64_t retired() {
+    std::lock_guard<std::mutex>  lock(m_mutex);
+    return  m_retired;
+  }
+
+ private:
+  void drain_nothrow() {
+    std::unique_lock<std::mutex>  lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_retired == m_next_id; });
+  }
+};
+
+/**
+ * \brief   Backend running a C++ function in place of the device, batches executed in order on worker threads
+ *
+ * The function is called with the mapped input and output buffers and the number of images.
+ */
+class FunctionBackend {
+ public:
+  using Function = std::function<void(void const*, void*, unsigned)>;
+  using buffer = std::vector<unsigned char>;
+  using run = std::shared_future<void>;
+
+ private:
+  Function  m_fn;
+  run       m_last;
+
+ public:
+  explicit FunctionBackend(Function  fn) : m_fn(std::move(fn)) {}
+
+  buffer alloc(std::size_t const  bytes, unsigned) { return  buffer(bytes); }
+  void *map(buffer &b) { return  b.data(); }
+  void to_device(buffer&, std::size_t) {}
+  void from_device(buffer&, std::size_t) {}
+  run start(buffer &in, buffer &out, unsigned const  reps) {
+    run const  prev = m_last;
+    Function const &fn = m_fn;
+    void const *const  src = in.data();
+    void *const  dst = out.data();
+    m_last = std::async(std::launch::async, [prev, &fn, src, dst, reps]() {
+      if(prev.valid())  prev.wait();
+      fn(src, dst, reps);
+    }).share();
+    return  m_last;
+  }
+  void wait(run &r) { r.get(); }
+};
+
+#ifdef FINN_HOST_XRT
+/**
+ * \brief   Backend running a kernel of an xclbin through the XRT native API
+ *
+ * With zeroCopy, the buffers are allocated as pinned host memory accessed by the device directly, so that
+ * the synchronizations only maintain cache coherence, otherwise as device buffers copied by the
+ * synchronizations.
+ */
+class XrtBackend {
+ public:
+  using buffer = xrt::bo;
+  using run = xrt::run;
+
+ private:
+  xrt::device  m_device;
+  xrt::kernel  m_kernel;
+  bool const   m_zero_copy;
+
+ public:
+  XrtBackend(std::string const &xclbin, std::string const &kernel, unsigned const  deviceIndex = 0, bool const  zeroCopy = true)
+    : m_device(deviceIndex), m_kernel(m_device, m_device.load_xclbin(xclbin), kernel), m_zero_copy(zeroCopy) {}
+
+  buffer alloc(std::size_t const  bytes, unsigned const  arg) {
+    return  xrt::bo(m_device, bytes, m_zero_copy? xrt::bo::flags::host_only : xrt::bo::flags::normal, m_kernel.group_id(arg));
+  }
+  void *map(buffer &b) { return  b.map(); }
+  void to_device(buffer &b, std::size_t const  bytes) { if(bytes)  b.sync(XCL_BO_SYNC_BO_TO_DEVICE, bytes, 0); }
+  void from_device(buffer &b, std::size_t const  bytes) { if(bytes)  b.sync(XCL_BO_SYNC_BO_FROM_DEVICE, bytes, 0); }
+  run start(buffer &in, buffer &out, unsigned const  reps) { return  m_kernel(in, out, reps); }
+  void wait(run &r) { r.wait(); }
+};
+#endif
+
+} // namespace host
+} // namespace finn
+
+#endif
@@ -49,6 +49,7 @@
 #define INTERPRET_HPP
 
 #include <ap_int.h>
+#include <cstdint>
 #include <ostream>
 
 /**
@@ -129,7 +130,7 @@ class Recast {
  public:
   static unsigned const  width = 1;
 
- private:
+  // public to allow for the specialization of mac on recast operands
   template<typename TV>
   class Container {
     TV  m_val;
@@ -175,6 +176,124 @@ class Recast {
   }
 };
 
+namespace detail {
+  inline ap_uint<32> float_to_bits(float const  f) {
+#pragma HLS inline
+    union { float f; uint32_t u; }  conv;
+    conv.f = f;
+    return  conv.u;
+  }
+  inline float bits_to_float(ap_uint<32> const &b) {
+#pragma HLS inline
+    union { float f; uint32_t u; }  conv;
+    conv.u = b;
+    return  conv.f;
+  }
+  // right shift rounding to nearest, ties to even
+  inline ap_uint<40> shift_rne(ap_uint<40> const &v, unsigned const  sh) {
+#pragma HLS inline
+    if(sh == 0)  return  v;
+    ap_uint<40> const  q = v >> sh;
+    ap_uint<40> const  rem = v & ((ap_uint<40>(1) << sh) - 1);
+    ap_uint<40> const  half = ap_uint<40>(1) << (sh-1);
+    return  (rem > half) || ((rem == half) && q[0])? ap_uint<40>(q + 1) : q;
+  }
+}
+
+/**
+ * A binary floating-point number of 1 sign, ExpBits exponent and ManBits
+ * mantissa bits in IEEE 754 layout, e.g. Half or BFloat16, for use as the
+ * operand of a MAC accumulating in float.
+ *
+ * A MiniFloat constructed from an ap_(u)int takes its bits, so that Slice
+ * and FixedPointWeights extract MiniFloat lanes from packed words. It
+ * converts to float exactly and from float (see from_float) rounding to
+ * nearest even, with subnormals, infinities and NaN for all formats.
+ */
+template<unsigned ExpBits, unsigned ManBits>
+class MiniFloat {
+  static_assert((ExpBits >= 2) && (ExpBits <= 8) && (ManBits >= 1) && (ManBits <= 23), "Not representable as float");
+  static constexpr unsigned  EMAX = (1 << ExpBits) - 1;
+  static constexpr int  BIAS = (1 << (ExpBits-1)) - 1;
+
+ public:
+  static unsigned const  width = 1 + ExpBits + ManBits;
+  ap_uint<width>  m_bits;
+
+ public:
+  MiniFloat() {
+#pragma HLS inline
+  }
+  template<int W, bool S>
+  explicit MiniFloat(ap_int_base<W, S> const &bits) : m_bits(bits) {
+#pragma HLS inline
+  }
+
+ public:
+  operator float() const {
+#pragma HLS inline
+    ap_uint<1> const  s = m_bits[width-1];
+    ap_uint<ExpBits> const  e = m_bits(width-2, ManBits);
+    ap_uint<ManBits> const  m = m_bits(ManBits-1, 0);
+    if(ExpBits == 8)  return  detail::bits_to_float(ap_uint<32>(m_bits) << (23-ManBits));
+    if(e == EMAX)  return  detail::bits_to_float((ap_uint<32>(s) << 31) | (ap_uint<32>(0xFF) << 23) | (ap_uint<32>(m) << (23-ManBits)));
+    if(e == 0) {
+      // subnormal: m * 2^(1-BIAS-ManBits), with the power of two as float
+      float const  v = float(unsigned(m)) * detail::bits_to_float(ap_uint<32>(127 + 1 - BIAS - int(ManBits)) << 23);
+      return  s? -v : v;
+    }
+    return  detail::bits_to_float((ap_uint<32>(s) << 31) | (ap_uint<32>(int(e) - BIAS + 127) << 23) | (ap_uint<32>(m) << (23-ManBits)));
+  }
+
+  static MiniFloat from_float(float const  f) {
+#pragma HLS inline
+    ap_uint<32> const  b = detail::float_to_bits(f);
+    ap_uint<1>  const  s  = b[31];
+    ap_uint<8>  const  e  = b(30, 23);
+    ap_uint<23> const  m  = b(22, 0);
+    ap_uint<width>  res;
+    if(e == 0xFF) {
+      // infinity or quiet NaN
+      res = (ap_uint<width>(EMAX) << ManBits) | (m != 0? ap_uint<width>(1) << (ManBits-1) : ap_uint<width>(0));
+    }
+    else if(ExpBits == 8) {
+      // same exponent range as float
+      res = detail::shift_rne(b(30, 0), 23-ManBits);
+    }
+    else {
+      int const  te = int(e) - 127 + BIAS;
+      if(te >= int(EMAX))  res = ap_uint<width>(EMAX) << ManBits;
+      else if(te > 0)      res = detail::shift_rne((ap_uint<40>(te) << 23) | m, 23-ManBits);
+      else {
+        // subnormal or zero, a carry of the rounding yields the smallest normal number
+        unsigned const  sh = 23 - ManBits + 1 - te;
+        ap_uint<40> const  full = (e == 0? ap_uint<40>(0) : ap_uint<40>(1) << 23) | m;
+        res = sh > 25? ap_uint<40>(0) : detail::shift_rne(full, sh);
+      }
+    }
+    MiniFloat  ret;
+    ret.m_bits = (ap_uint<width>(s) << (width-1)) | res(width-2, 0);
+    return  ret;
+  }
+};
+
+// out-of-line definitions, as the ap_uint operators take these constants by reference
+template<unsigned ExpBits, unsigned ManBits>
+constexpr unsigned  MiniFloat<ExpBits, ManBits>::EMAX;
+template<unsigned ExpBits, unsigned ManBits>
+constexpr int  MiniFloat<ExpBits, ManBits>::BIAS;
+
+// IEEE 754 binary16
+typedef MiniFloat<5, 10>  Half;
+// bfloat16, the upper half of a float
+typedef MiniFloat<8, 7>   BFloat16;
+
+template<unsigned ExpBits, unsigned ManBits>
+inline float operator*(MiniFloat<ExpBits, ManBits> const &a, MiniFloat<ExpBits, ManBits> const &b) {
+#pragma HLS inline
+  return  float(a) * float(b);
+}
+
 template<typename T>
 struct Caster {
 	template<int M>
@@ -304,4 +423,93 @@ class Slice_mmv {
   }
 };
 
+/**
+ * A mantissa of a block floating-point word together with the shared
+ * exponent of its block, as the lane of a BFPSlice. The value is
+ * m_man * 2^m_exp.
+ */
+template<typename TM, unsigned EBits>
+struct BFPLane {
+  TM  m_man;
+  ap_uint<EBits>  m_exp;
+};
+
+/**
+ * Accumulator of mantissa products of a block floating-point input together
+ * with the exponent shared by the accumulated block. The value is
+ * m_sum * 2^m_exp, see the mac on BFPSlice inputs and BFPActivation.
+ */
+template<typename TV, unsigned EBits>
+struct BFPAccu {
+  TV  m_sum;
+  ap_uint<EBits>  m_exp;
+
+  BFPAccu() {
+#pragma HLS inline
+  }
+  BFPAccu(TV const &sum, ap_uint<EBits> const &exp) : m_sum(sum), m_exp(exp) {
+#pragma HLS inline
+  }
+};
+
+/**
+ * Slicer of a block floating-point word: lanes of TM mantissas in the lower
+ * bits followed by an EBits exponent in the topmost bits, which is shared by
+ * all lanes and all words of a block (see BFP_Encode_Batch). Indexing yields
+ * BFPLane elements, while mantissas() gives a Slice<TM> view of the word, so
+ * that an MVAU accumulates the plain mantissas with the exponent carried
+ * along into its activation.
+ */
+template<typename TM, unsigned EBits, unsigned STRIDE=TM::width>
+class BFPSlice {
+ public:
+  static unsigned const  width = STRIDE;
+
+ private:
+  template<typename TV>
+  class Container {
+    TV  m_val;
+
+   public:
+    Container() {
+#pragma HLS inline
+    }
+    Container(TV const &val) : m_val(val) {
+#pragma HLS inline
+    }
+   public:
+    ap_uint<EBits> exponent() const {
+#pragma HLS inline
+      return  m_val(TV::width-1, TV::width-EBits);
+    }
+    auto mantissas() const -> decltype(Slice<TM, STRIDE>()(m_val)) {
+#pragma HLS inline
+      return  Slice<TM, STRIDE>()(m_val);
+    }
+    BFPLane<TM, EBits> operator()(unsigned const idx, __attribute__((unused)) unsigned const mmv) const {
+#pragma HLS inline
+      BFPLane<TM, EBits>  lane;
+      lane.m_man = mantissas()(idx, mmv);
+      lane.m_exp = exponent();
+      return  lane;
+    }
+    operator TV const&() const {
+#pragma HLS inline
+      return  m_val;
+    }
+  };
+
+ public:
+  template<typename TV>
+  Container<TV> operator()(TV const &val) const {
+#pragma HLS inline
+    return  Container<TV>(val);
+  }
+  template<typename TV>
+  Container<TV> operator()(TV const &val, __attribute__((unused)) unsigned mmv) const {
+#pragma HLS inline
+    return  Container<TV>(val);
+  }
+};
+
 #endif
@@ -64,6 +64,10 @@
 #define MAC_HPP
 
 #include "utils.hpp"
+#include "interpret.hpp"
+#include "weights.hpp"
+
+#include <type_traits>
 
 
 /**
@@ -143,6 +147,172 @@ auto mul(TC const &c, TD const &d, ap_resource_dsp const&) -> decltype(c*d) {
   return  res;
 }
 
+/**
+ * \brief      Multipliy operation between 2 operands, implemented in a DSP48
+ *
+ * A single product cannot be packed, so ap_resource_dsp_packed falls back to
+ * one DSP48 per product whenever the multiplier is used on its own
+ * (as in Vector_Vector_Activate_Batch). The packing is applied by mac.
+ *
+ * \tparam     TC    First operand datatype (weights)
+ * \tparam     TD    Second operand datatype (input)
+ * 
+ * \param      c     First operand (array of weights)
+ * \param      d     Second operand (array of input activation)
+ * \param      r     Resource type for the hardware implementation of the MAC block
+ *
+ * \return     Result of the multiply operation
+ */
+template<typename TC, typename TD>
+auto mul(TC const &c, TD const &d, ap_resource_dsp_packed const&) -> decltype(c*d) {
+#pragma HLS inline
+  return  mul(c, d, ap_resource_dsp());
+}
+
+/**
+ * \brief      Multiply operation by a power-of-two weight, implemented as a
+ * barrel shift
+ *
+ * The input is shifted left by the exponent of the weight and negated for a
+ * negative sign, so that neither DSP48 nor multiplier LUTs are used.
+ *
+ * \tparam     ExpBits  Width of the exponent of the weight
+ * \tparam     W        Width of the input
+ * \tparam     S        Signedness of the input
+ *
+ * \param      c     First operand (power-of-two weight)
+ * \param      d     Second operand (input activation)
+ * \param      r     Resource type for the hardware implementation of the MAC block
+ *
+ * \return     Result of the multiply operation
+ */
+template<unsigned ExpBits, int W, bool S>
+ap_int<W + (1 << ExpBits)> mul(LogWeight<ExpBits> const &c, ap_int_base<W, S> const &d, ap_resource_shift const&) {
+#pragma HLS inline
+  typedef ap_int<W + (1 << ExpBits)>  res_t;
+  res_t const  m = res_t(d) << c.exp;
+  return  c.sign? res_t(-m) : m;
+}
+
+/**
+ * \brief      Multiply operation between 2 floating-point operands, implemented as a
+ * floating-point multiplier in DSP48
+ *
+ * \tparam     ExpBits  Width of the exponent of the operands
+ * \tparam     ManBits  Width of the mantissa of the operands
+ *
+ * \param      c     First operand (weight)
+ * \param      d     Second operand (input activation)
+ * \param      r     Resource type for the hardware implementation of the MAC block
+ *
+ * \return     Product in float, which holds it exactly for Half and BFloat16
+ */
+template<unsigned ExpBits, unsigned ManBits>
+float mul(MiniFloat<ExpBits, ManBits> const &c, MiniFloat<ExpBits, ManBits> const &d, ap_resource_fp_dsp const&) {
+#pragma HLS inline
+  float const  res = float(c) * float(d);
+#pragma HLS BIND_OP variable=res op=fmul impl=fulldsp
+  return  res;
+}
+
+/**
+ * \brief      Multipliy operation between 2 operands, implemented in a DSP48
+ *
+ * A single product has nothing to cascade with, so ap_resource_dsp_cascade
+ * falls back to one DSP48 per product whenever the multiplier is used on its
+ * own (as in Vector_Vector_Activate_Batch). The cascade is built by mac.
+ *
+ * \tparam     TC    First operand datatype (weights)
+ * \tparam     TD    Second operand datatype (input)
+ * 
+ * \param      c     First operand (array of weights)
+ * \param      d     Second operand (array of input activation)
+ * \param      r     Resource type for the hardware implementation of the MAC block
+ *
+ * \return     Result of the multiply operation
+ */
+template<typename TC, typename TD>
+auto mul(TC const &c, TD const &d, ap_resource_dsp_cascade const&) -> decltype(c*d) {
+#pragma HLS inline
+  return  mul(c, d, ap_resource_dsp());
+}
+
+//- DSP Packing ---------------------------------------------------------------
+/*
+ * Two products of a MAC are computed within a single DSP48 multiplier:
+ *
+ *   (c1*2^K + c0) * (d0*2^K + d1) = c1*d0*2^2K + (c0*d0 + c1*d1)*2^K + c0*d1
+ *
+ * The middle field directly yields the sum of both products. Adding 2^(K-1)
+ * before extracting it compensates the borrow of the signed lower field.
+ * K is chosen so that neither the middle nor the lower field can overflow.
+ */
+namespace dsp_packing {
+
+  // Signed width sufficient to hold an operand type, 0 if not packable
+  template<typename T> struct operand_width { static unsigned const  value = 0; };
+  template<int W> struct operand_width<ap_int<W>>  { static unsigned const  value = W; };
+  template<int W> struct operand_width<ap_uint<W>> { static unsigned const  value = W+1; };
+
+  template<typename TC, typename TD>
+  struct config {
+    static unsigned const  WC = operand_width<typename std::decay<TC>::type>::value;
+    static unsigned const  WD = operand_width<typename std::decay<TD>::type>::value;
+    // field width holding the sum of two products
+    static unsigned const  K  = WC + WD + 1;
+    // widths of the packed operands
+    static unsigned const  PC = K + WC + 1;
+    static unsigned const  PD = K + WD + 1;
+    // packed operands must fit the 27x18 multiplier of the DSP48E2
+    static bool const  fits = (WC > 0) && (WD > 0) &&
+      (((PC <= 27) && (PD <= 18)) || ((PC <= 18) && (PD <= 27)));
+  };
+
+  /**
+   * \brief    Computes c0*d0 + c1*d1 using a single DSP48 multiplier
+   */
+  template<typename CFG, typename TC, typename TD>
+  ap_int<CFG::K> dot2(TC const &c0, TC const &c1, TD const &d0, TD const &d1) {
+#pragma HLS inline
+    ap_int<CFG::PC> const  cp = (ap_int<CFG::PC>(ap_int<CFG::WC>(c1)) << CFG::K) + ap_int<CFG::WC>(c0);
+    ap_int<CFG::PD> const  dp = (ap_int<CFG::PD>(ap_int<CFG::WD>(d0)) << CFG::K) + ap_int<CFG::WD>(d1);
+    ap_int<CFG::PC+CFG::PD> const  p = cp * dp;
+#pragma HLS BIND_OP variable=p op=mul impl=dsp
+    ap_int<CFG::PC+CFG::PD> const  q = p + (ap_int<CFG::PC+CFG::PD>(1) << (CFG::K-1));
+    return  ap_int<CFG::K>(q(2*CFG::K-1, CFG::K));
+  }
+
+  // Uniform lane access for the activation of a specific output pixel
+  template<typename TD>
+  class MMVLane {
+    TD const &m_d;
+    unsigned const  m_mmv;
+   public:
+    MMVLane(TD const &d, unsigned const  mmv) : m_d(d), m_mmv(mmv) {
+#pragma HLS inline
+    }
+    auto operator[](unsigned const  i) const -> decltype(std::declval<TD const&>()(i, 0u)) {
+#pragma HLS inline
+      return  m_d(i, m_mmv);
+    }
+  };
+
+  // Two products per DSP48, a trailing odd lane uses a DSP48 of its own
+  template<unsigned N, typename T, typename TC, typename TD>
+  T accumulate(T const &a, TC const &c, TD const &d) {
+#pragma HLS inline
+    using  CFG = config<decltype(c[0]), decltype(d[0])>;
+    T  res = a;
+    for(unsigned  i = 0; i+1 < N; i += 2) {
+#pragma HLS unroll
+      res += dot2<CFG>(c[i], c[i+1], d[i], d[i+1]);
+    }
+    if(N % 2)  res += mul(c[N-1], d[N-1], ap_resource_dsp());
+    return  res;
+  }
+
+} // namespace dsp_packing
+
 /**
  * \brief      MAC with selectable implementation resource, used by Matrix_Vector_Activate_Batch
  *
@@ -197,10 +367,537 @@ T mac(T const &a, TC const &c, TD const &d, R const &r) {
   }
   return  res;
 }
+/**
+ * \brief      MAC of floating-point operands with multipliers and adders in DSP48, used by
+ * Matrix_Vector_Activate_Batch
+ *
+ * The products are accumulated in order into the accumulator, typically a float. As each
+ * addition takes several cycles, see Matrix_Vector_Activate_Interleaved_Batch for keeping
+ * II=1 on the accumulation.
+ *
+ * \tparam     N     Number of MAC to be performed (equals to SIMD in mvau)
+ * \tparam     T     Accumulator datatype
+ * \tparam     TC    First operand datatype (weights)
+ * \tparam     TD    Second operand datatype (input)
+ *
+ * \param      a     Initialization value of the accumulation
+ * \param      c     First operand (array of weights)
+ * \param      d     Second operand (array of input activation)
+ * \param      r     Resource type for the hardware implementation of the MAC block
+ * \param      mmv   MMV value to address accumulator and activation
+ *
+ * \return     Result of the MAC operation
+ */
+template<unsigned N, typename T, typename TC, typename TD>
+T mac(T const &a, TC const &c, TD const &d, ap_resource_fp_dsp const &r, unsigned mmv) {
+#pragma HLS inline
+  T  res = a;
+  for(unsigned  i = 0; i < N; i++) {
+#pragma HLS unroll
+    T const  sum = res + mul(c[i], d(i,mmv), r);
+#pragma HLS BIND_OP variable=sum op=fadd impl=fulldsp
+    res = sum;
+  }
+  return  res;
+}
+
+/**
+ * \brief      MAC packing two products into each DSP48, used by Matrix_Vector_Activate_Batch
+ *
+ * Pairs of SIMD lanes are computed by one DSP48 each. This overload is only
+ * viable for operands that can be packed into the 27x18 multiplier, others are
+ * served by the generic mac and end up with one DSP48 per product.
+ *
+ * \tparam     N     Number of MAC to be performed (equals to SIMD in mvau)
+ * \tparam     T     Accumulator datatype
+ * \tparam     TC    First operand datatype (weights)
+ * \tparam     TD    Second operand datatype (input)
+ * 
+ * \param      a     Initialization value of the accumulation
+ * \param      c     First operand (array of weights)
+ * \param      d     Second operand (array of input activation)
+ * \param      r     Resource type for the hardware implementation of the MAC block
+ * \param      mmv   MMV value to address accumulator and activation
+ *
+ * \return     Result of the MAC operation
+ */
+template<unsigned N, typename T, typename TC, typename TD>
+auto mac(T const &a, TC const &c, TD const &d, __attribute__((unused)) ap_resource_dsp_packed const &r, unsigned mmv)
+  -> typename std::enable_if<dsp_packing::config<decltype(c[0]), decltype(d(0,mmv))>::fits, T>::type {
+#pragma HLS inline
+  return  dsp_packing::accumulate<N>(a, c, dsp_packing::MMVLane<TD>(d, mmv));
+}
+
+/**
+ * \brief      MAC packing two products into each DSP48
+ *
+ * \tparam     N     Number of MAC to be performed (equals to SIMD in mvau)
+ * \tparam     T     Accumulator datatype
+ * \tparam     TC    First operand datatype (weights)
+ * \tparam     TD    Second operand datatype (input)
+ * 
+ * \param      a     Initialization value of the accumulation
+ * \param      c     First operand (array of weights)
+ * \param      d     Second operand (array of input activation)
+ * \param      r     Resource type for the hardware implementation of the MAC block
+ *
+ * \return     Result of the MAC operation
+ */
+template<unsigned N, typename T, typename TC, typename TD>
+auto mac(T const &a, TC const &c, TD const &d, __attribute__((unused)) ap_resource_dsp_packed const &r)
+  -> typename std::enable_if<dsp_packing::config<decltype(c[0]), decltype(d[0])>::fits, T>::type {
+#pragma HLS inline
+  return  dsp_packing::accumulate<N>(a, c, d);
+}
+
+//- DSP Cascade ---------------------------------------------------------------
+/*
+ * The products of a MAC are summed along a chain of DSP48 rather than by a
+ * fabric adder tree. Every DSP48 multiplies one lane and adds the partial sum
+ * of its predecessor in its post-adder, passed through the dedicated
+ * PCOUT/PCIN cascade:
+ *
+ *   res = (((a + c0*d0) + c1*d1) + c2*d2) + ...
+ *
+ * Within a pipelined loop, the scheduler delays the operands of the later
+ * lanes to meet the partial sum travelling down the chain.
+ */
+namespace dsp_cascade {
+
+  // operands must fit the 27x18 multiplier of the DSP48E2
+  template<typename TC, typename TD>
+  struct config {
+    static unsigned const  WC = dsp_packing::operand_width<typename std::decay<TC>::type>::value;
+    static unsigned const  WD = dsp_packing::operand_width<typename std::decay<TD>::type>::value;
+    static bool const  fits = (WC > 0) && (WD > 0) &&
+      (((WC <= 27) && (WD <= 18)) || ((WC <= 18) && (WD <= 27)));
+  };
+
+  // One multiply-add per DSP48, the partial sum following the chain
+  template<unsigned N, typename T, typename TC, typename TD>
+  T accumulate(T const &a, TC const &c, TD const &d) {
+#pragma HLS inline
+    T  res = a;
+    for(unsigned  i = 0; i < N; i++) {
+#pragma HLS unroll
+      auto const  p = c[i] * d[i];
+#pragma HLS BIND_OP variable=p op=mul impl=dsp
+      T const  s = res + p;
+#pragma HLS BIND_OP variable=s op=add impl=dsp
+      res = s;
+    }
+    return  res;
+  }
+
+} // namespace dsp_cascade
+
+/**
+ * \brief      MAC summing the products through a DSP48 cascade, used by Matrix_Vector_Activate_Batch
+ *
+ * Every SIMD lane is computed by one DSP48, which also adds the partial sum
+ * of the previous lane. This overload is only viable for operands fitting the
+ * 27x18 multiplier, others are served by the generic mac and end up with one
+ * DSP48 per product and a fabric adder tree.
+ *
+ * \tparam     N     Number of MAC to be performed (equals to SIMD in mvau)
+ * \tparam     T     Accumulator datatype
+ * \tparam     TC    First operand datatype (weights)
+ * \tparam     TD    Second operand datatype (input)
+ * 
+ * \param      a     Initialization value of the accumulation
+ * \param      c     First operand (array of weights)
+ * \param      d     Second operand (array of input activation)
+ * \param      r     Resource type for the hardware implementation of the MAC block
+ * \param      mmv   MMV value to address accumulator and activation
+ *
+ * \return     Result of the MAC operation
+ */
+template<unsigned N, typename T, typename TC, typename TD>
+auto mac(T const &a, TC const &c, TD const &d, __attribute__((unused)) ap_resource_dsp_cascade const &r, unsigned mmv)
+  -> typename std::enable_if<dsp_cascade::config<decltype(c[0]), decltype(d(0,mmv))>::fits, T>::type {
+#pragma HLS inline
+  return  dsp_cascade::accumulate<N>(a, c, dsp_packing::MMVLane<TD>(d, mmv));
+}
+
+/**
+ * \brief      MAC summing the products through a DSP48 cascade
+ *
+ * \tparam     N     Number of MAC to be performed (equals to SIMD in mvau)
+ * \tparam     T     Accumulator datatype
+ * \tparam     TC    First operand datatype (weights)
+ * \tparam     TD    Second operand datatype (input)
+ * 
+ * \param      a     Initialization value of the accumulation
+ * \param      c     First operand (array of weights)
+ * \param      d     Second operand (array of input activation)
+ * \param      r     Resource type for the hardware implementation of the MAC block
+ *
+ * \return     Result of the MAC operation
+ */
+template<unsigned N, typename T, typename TC, typename TD>
+auto mac(T const &a, TC const &c, TD const &d, __attribute__((unused)) ap_resource_dsp_cascade const &r)
+  -> typename std::enable_if<dsp_cascade::config<decltype(c[0]), decltype(d[0])>::fits, T>::type {
+#pragma HLS inline
+  return  dsp_cascade::accumulate<N>(a, c, d);
+}
+
+//- Binarized MAC -------------------------------------------------------------
+/**
+ * \brief      Population count of the lower N bits of a word
+ *
+ * The bits are first counted in groups of six, each of which maps onto
+ * three LUT6 (6:3 compressor). The group counts are summed by a balanced
+ * adder tree so that the logic depth only grows logarithmically with N.
+ *
+ * \tparam     N     Number of bits to count
+ * \tparam     OFS   Offset of the lowest bit to count
+ */
+template<unsigned N, unsigned OFS = 0, bool LEAF = (N <= 6)>
+struct PopCount {
+  // lower subtree covering a multiple of six bits
+  static unsigned const  N0 = 6 * (((N+5)/6 + 1) / 2);
+
+  template<int W>
+  static ap_uint<clog2(N+1)> count(ap_uint<W> const &x) {
+#pragma HLS inline
+    return  PopCount<N0, OFS>::count(x) + PopCount<N-N0, OFS+N0>::count(x);
+  }
+};
+template<unsigned N, unsigned OFS>
+struct PopCount<N, OFS, true> {
+  template<int W>
+  static ap_uint<clog2(N+1)> count(ap_uint<W> const &x) {
+#pragma HLS inline
+    ap_uint<clog2(N+1)>  res = 0;
+    for(unsigned  i = 0; i < N; i++) {
+#pragma HLS unroll
+      res += x[OFS+i];
+    }
+    return  res;
+  }
+};
+
+template<unsigned N, int W>
+ap_uint<clog2(N+1)> popcount(ap_uint<W> const &x) {
+#pragma HLS inline
+  static_assert(N <= (unsigned)W, "Counting beyond the word width.");
+  return  PopCount<N>::count(x);
+}
+
+/**
+ * \brief      XNOR MAC over a binary weight word and XnorMul activations
+ *
+ * Replaces the per-lane accumulation by popcount(~(c ^ d)) over the whole
+ * word, regardless of the resource selected for the MAC.
+ *
+ * \tparam     N     Number of MAC to be performed (equals to SIMD in mvau)
+ * \tparam     T     Accumulator datatype
+ * \tparam     W     Width of the weight word
+ * \tparam     TV    Datatype of the activation word
+ *
+ * \param      a     Initialization value of the accumulation
+ * \param      c     Binary weight word
+ * \param      d     Activation word recast as XnorMul
+ *
+ * \return     Result of the MAC operation
+ */
+template<unsigned N, typename T, int W, typename TV, typename R>
+T mac(T const &a, ap_uint<W> const &c, Recast<XnorMul>::Container<TV> const &d,
+      __attribute__((unused)) R const &r, __attribute__((unused)) unsigned mmv) {
+#pragma HLS inline
+  ap_uint<N> const  cw = c(N-1, 0);
+  ap_uint<N> const  dw = static_cast<TV const&>(d)(N-1, 0);
+  return  a + popcount<N>(ap_uint<N>(~(cw ^ dw)));
+}
+template<unsigned N, typename T, int W, typename TV, typename R>
+T mac(T const &a, ap_uint<W> const &c, Recast<XnorMul>::Container<TV> const &d, R const &r) {
+#pragma HLS inline
+  return  mac<N>(a, c, d, r, 0);
+}
+template<unsigned N, typename T, typename TV, int W, typename R>
+T mac(T const &a, Recast<XnorMul>::Container<TV> const &c, ap_uint<W> const &d, R const &r) {
+#pragma HLS inline
+  return  mac<N>(a, d, c, r, 0);
+}
+
+/**
+ * \brief      MAC over two words of Binary (+1/-1) operands
+ *
+ * Equal bits contribute +1 and differing bits -1, giving a result of
+ * 2*popcount(~(c ^ d)) - N.
+ *
+ * \tparam     N     Number of MAC to be performed (equals to SIMD in mvau)
+ * \tparam     T     Accumulator datatype
+ * \tparam     TC    Datatype of the weight word
+ * \tparam     TD    Datatype of the activation word
+ *
+ * \param      a     Initialization value of the accumulation
+ * \param      c     Weight word recast as Binary
+ * \param      d     Activation word recast as Binary
+ *
+ * \return     Result of the MAC operation
+ */
+template<unsigned N, typename T, typename TC, typename TD, typename R>
+T mac(T const &a, Recast<Binary>::Container<TC> const &c, Recast<Binary>::Container<TD> const &d,
+      __attribute__((unused)) R const &r, __attribute__((unused)) unsigned mmv) {
+#pragma HLS inline
+  ap_uint<N> const  cw = static_cast<TC const&>(c)(N-1, 0);
+  ap_uint<N> const  dw = static_cast<TD const&>(d)(N-1, 0);
+  ap_int<clog2(N+1)+2> const  sum = 2 * popcount<N>(ap_uint<N>(~(cw ^ dw))) - N;
+  return  a + sum;
+}
+template<unsigned N, typename T, typename TC, typename TD, typename R>
+T mac(T const &a, Recast<Binary>::Container<TC> const &c, Recast<Binary>::Container<TD> const &d, R const &r) {
+#pragma HLS inline
+  return  mac<N>(a, c, d, r, 0);
+}
+
+//- Ternary MAC ---------------------------------------------------------------
+/**
+ * \brief      Multiplier-free MAC over ternary (-1/0/+1) weights
+ *
+ * The activations of the lanes with a +1 weight and those with a -1 weight
+ * are summed by two masked adder trees, the result is their difference.
+ * No multiplier is used, regardless of the resource selected for the MAC.
+ *
+ * \tparam     N     Number of MAC to be performed (equals to SIMD in mvau)
+ * \tparam     T     Accumulator datatype
+ * \tparam     W     Number of lanes of the ternary weight word
+ * \tparam     TD    Second operand datatype (input)
+ *
+ * \param      a     Initialization value of the accumulation
+ * \param      c     Ternary weight word
+ * \param      d     Second operand (array of input activation)
+ * \param      mmv   MMV value to address the activation
+ *
+ * \return     Result of the MAC operation
+ */
+template<unsigned N, typename T, unsigned W, typename TD, typename R>
+T mac(T const &a, TernaryWord<W> const &c, TD const &d, __attribute__((unused)) R const &r, unsigned mmv) {
+#pragma HLS inline
+  static_assert(N <= W, "Ternary weight word narrower than the MAC.");
+  T  pos = 0;
+  T  neg = 0;
+  for(unsigned  i = 0; i < N; i++) {
+#pragma HLS unroll
+    auto const  x = d(i, mmv);
+    if(c.mask[i]) {
+      if(c.sign[i])  neg += x;
+      else           pos += x;
+    }
+  }
+  return  a + pos - neg;
+}
+template<unsigned N, typename T, unsigned W, typename TD, typename R>
+T mac(T const &a, TernaryWord<W> const &c, TD const &d, __attribute__((unused)) R const &r) {
+#pragma HLS inline
+  static_assert(N <= W, "Ternary weight word narrower than the MAC.");
+  T  pos = 0;
+  T  neg = 0;
+  for(unsigned  i = 0; i < N; i++) {
+#pragma HLS unroll
+    auto const  x = d[i];
+    if(c.mask[i]) {
+      if(c.sign[i])  neg += x;
+      else           pos += x;
+    }
+  }
+  return  a + pos - neg;
+}
+
 template<unsigned N, typename T, typename TC, typename TD>
 inline T mac(T const &a, TC const &c, TD const &d) {
 #pragma HLS inline
   return  mac<N>(a, c, d, ap_resource_dflt());
 }
 
+//- Block Floating-Point MAC -------------------------------------------------
+/**
+ * \brief      MAC over the mantissas of a block floating-point input, see BFPSlice
+ *
+ * The mantissas are accumulated by the MAC of the selected resource, e.g.
+ * packed into DSP48, and the shared exponent of the input word is passed on
+ * with the sum. All words accumulated into a result must belong to the same
+ * block, i.e. share their exponent.
+ *
+ * \tparam     N     Number of MAC to be performed (equals to SIMD in mvau)
+ * \tparam     TV    Accumulator datatype of the mantissa products
+ * \tparam     EBits Width of the shared exponent
+ * \tparam     TC    First operand datatype (weights)
+ * \tparam     TD    Second operand datatype (BFPSlice container of the input word)
+ * \tparam     R     Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param      a     Initialization value of the accumulation
+ * \param      c     First operand (array of weights)
+ * \param      d     Second operand (block floating-point input word)
+ * \param      r     Resource type for the hardware implementation of the MAC block
+ * \param      mmv   MMV value to address accumulator and activation
+ *
+ * \return     Result of the MAC operation with the exponent of the input
+ */
+template<unsigned N, typename TV, unsigned EBits, typename TC, typename TD, typename R>
+BFPAccu<TV, EBits> mac(BFPAccu<TV, EBits> const &a, TC const &c, TD const &d, R const &r, unsigned mmv) {
+#pragma HLS inline
+  return  BFPAccu<TV, EBits>(mac<N>(a.m_sum, c, d.mantissas(), r, mmv), d.exponent());
+}
+
+//- Precision-Scalable (Bit-Fusion) MAC ---------------------------------------
+/**
+ * \brief      MAC over fused multipliers whose operand width is selected at runtime
+ *
+ * Each of the N fused multipliers is built from (MaxBits/BrickBits)^2 brick
+ * multipliers of BrickBits x BrickBits, whose shifted products sum up to a
+ * single MaxBits x MaxBits product, to four products of MaxBits/2 bits, and
+ * so on down to one product of BrickBits per brick. A fused multiplier thus
+ * computes (MaxBits/bits)^2 products of operands of the given width, which
+ * are packed densely from the lsb of the weight and the activation word, so
+ * that N*(MaxBits/bits)^2 products are accumulated per call. The operands of
+ * every brick are selected by the operand width among the constant ones of
+ * every supported width, with the most significant brick of a signed operand
+ * sign-extended. Unsupported widths yield no products.
+ *
+ * \tparam     N         Number of fused multipliers (equals to SIMD in mvau)
+ * \tparam     MaxBits   Operand width of a fused multiplier
+ * \tparam     BrickBits Operand width of a brick multiplier, the narrowest supported one
+ * \tparam     SignedW   Whether the weights are signed
+ * \tparam     SignedA   Whether the activations are signed
+ * \tparam     T         Accumulator datatype
+ *
+ * \param      a     Initialization value of the accumulation
+ * \param      c     Weight word
+ * \param      d     Activation word
+ * \param      bits  Operand width, one of BrickBits*2^i up to MaxBits
+ *
+ * \return     Result of the MAC operation
+ */
+template<unsigned N, unsigned MaxBits, unsigned BrickBits, bool SignedW, bool SignedA, typename T>
+T mac_fused(T const &a, ap_uint<N*MaxBits*MaxBits/BrickBits> const &c, ap_uint<N*MaxBits*MaxBits/BrickBits> const &d,
+            unsigned const  bits) {
+#pragma HLS inline
+  unsigned const  Chunks = MaxBits / BrickBits;
+  unsigned const  Modes = clog2(Chunks) + 1;
+  static_assert(MaxBits % BrickBits == 0 && (1u << (Modes-1)) == Chunks,
+                "Fused multipliers must be a power-of-two number of bricks wide.");
+  using  TB = ap_int<BrickBits+1>;
+  using  TP = ap_int<2*MaxBits+2>;
+
+  T  res = a;
+  for(unsigned  s = 0; s < N; s++) {
+#pragma HLS unroll
+    TP  sum = 0;
+    for(unsigned  q = 0; q < Chunks*Chunks; q++) {
+#pragma HLS unroll
+      TB  x = 0;
+      TB  y = 0;
+      unsigned  shift = 0;
+      for(unsigned  m = 0; m < Modes; m++) {
+#pragma HLS unroll
+        // ch chunks per operand, brick q computes chunk i of the weight times
+        // chunk j of the activation of the product p of fused multiplier s
+        unsigned const  ch = 1u << m;
+        if(bits == ch*BrickBits) {
+          unsigned const  p = s * (Chunks/ch)*(Chunks/ch) + q / (ch*ch);
+          unsigned const  i = (q / ch) % ch;
+          unsigned const  j = q % ch;
+          ap_uint<BrickBits> const  cw = c((p*ch + i + 1)*BrickBits - 1, (p*ch + i)*BrickBits);
+          ap_uint<BrickBits> const  dw = d((p*ch + j + 1)*BrickBits - 1, (p*ch + j)*BrickBits);
+          x = (SignedW && i == ch-1)? TB(ap_int<BrickBits>(cw)) : TB(cw);
+          y = (SignedA && j == ch-1)? TB(ap_int<BrickBits>(dw)) : TB(dw);
+          shift = BrickBits * (i + j);
+        }
+      }
+      sum += TP(x * y) << shift;
+    }
+    res += sum;
+  }
+  return  res;
+}
+
+//- Accumulator Width ---------------------------------------------------------
+namespace accu_width {
+
+  // Value range of an operand type
+  template<typename T> struct value_range {};
+  template<int W> struct value_range<ap_int<W>> {
+    static_assert(W < 64, "Operand too wide for the range evaluation.");
+    static long long constexpr  min = -(1LL << (W-1));
+    static long long constexpr  max =  (1LL << (W-1)) - 1;
+  };
+  template<int W> struct value_range<ap_uint<W>> {
+    static_assert(W < 63, "Operand too wide for the range evaluation.");
+    static long long constexpr  min = 0;
+    static long long constexpr  max = (1LL << W) - 1;
+  };
+  template<> struct value_range<Binary> {
+    static long long constexpr  min = -1;
+    static long long constexpr  max =  1;
+  };
+  template<> struct value_range<XnorMul> {
+    static long long constexpr  min = 0;
+    static long long constexpr  max = 1;
+  };
+  template<unsigned ExpBits> struct value_range<LogWeight<ExpBits>> {
+    static_assert((1u << ExpBits) < 63, "Exponent too wide for the range evaluation.");
+    static long long constexpr  min = -(1LL << ((1u << ExpBits)-1));
+    static long long constexpr  max =  (1LL << ((1u << ExpBits)-1));
+  };
+
+  constexpr long long min4(long long  a, long long  b, long long  c, long long  d) {
+    return  std::min(std::min(a, b), std::min(c, d));
+  }
+  constexpr long long max4(long long  a, long long  b, long long  c, long long  d) {
+    return  std::max(std::max(a, b), std::max(c, d));
+  }
+
+  // Range of a single product, an XNOR product is 0 or 1
+  template<typename TI, typename TW, long long WMin, long long WMax>
+  struct product_range {
+    static long long constexpr  IMin = value_range<TI>::min;
+    static long long constexpr  IMax = value_range<TI>::max;
+    static long long constexpr  min = min4(IMin*WMin, IMin*WMax, IMax*WMin, IMax*WMax);
+    static long long constexpr  max = max4(IMin*WMin, IMin*WMax, IMax*WMin, IMax*WMax);
+  };
+  template<typename TW, long long WMin, long long WMax>
+  struct product_range<XnorMul, TW, WMin, WMax> {
+    static long long constexpr  min = 0;
+    static long long constexpr  max = 1;
+  };
+  template<typename TI, long long WMin, long long WMax>
+  struct product_range<TI, XnorMul, WMin, WMax> {
+    static long long constexpr  min = 0;
+    static long long constexpr  max = 1;
+  };
+
+} // namespace accu_width
+
+/**
+ * \brief      Minimal accumulator type of a dot product of MatrixW terms
+ *
+ * The accumulator is an ap_uint if no product can be negative and an ap_int
+ * otherwise, just wide enough for the full range of the sum. It can be used
+ * as TA of the activations, i.e. of the result of activation.init() and of
+ * the thresholds stored by ThresholdsActivation. For the VVAU, MatrixW is
+ * the number of kernel elements accumulated per channel.
+ *
+ * \tparam     MatrixW  Number of products accumulated
+ * \tparam     TI       Input element type, e.g. ap_uint<W>, Binary or XnorMul
+ * \tparam     TW       Weight element type, e.g. ap_int<W>, Binary or LogWeight<E>
+ * \tparam     WMin     Smallest weight value, the range of TW by default
+ * \tparam     WMax     Largest weight value, the range of TW by default
+ */
+template<unsigned MatrixW, typename TI, typename TW,
+	long long WMin = accu_width::value_range<TW>::min,
+	long long WMax = accu_width::value_range<TW>::max>
+struct accu_type {
+  static_assert(WMin <= WMax, "Empty weight range.");
+  using  product = accu_width::product_range<TI, TW, WMin, WMax>;
+  static long long constexpr  min = MatrixW * product::min;
+  static long long constexpr  max = MatrixW * product::max;
+  static bool constexpr  is_signed = min < 0;
+  static unsigned constexpr  width = is_signed?
+    1 + std::max(clog2(max < 0? 0 : max+1), clog2(-min)) :
+    std::max(1u, clog2(max+1));
+  using  type = typename std::conditional<is_signed, ap_int<width>, ap_uint<width>>::type;
+};
+
 #endif
@@ -50,6 +50,7 @@
 
 #include "interpret.hpp"
 #include "utils.hpp"
+#include "pool.hpp"
 
 /**
  * \brief   Max Pool implementation for Binarized values 
@@ -213,11 +214,13 @@ void StreamingMaxPool_Precision_Batch(hls::stream<ap_uint<InStreamW> > & in,
   hls::stream<ap_uint<NumChannels*ActType::width> > wa_in("StreamingMaxPool_Precision_Batch.wa_in");
   hls::stream<ap_uint<NumChannels*ActType::width> > mvOut("StreamingMaxPool_Precision_Batch.mvOut");
   StreamingDataWidthConverter_Batch<InStreamW, NumChannels*ActType::width, InpPerImage>(in, wa_in, numReps);
+  FINN_STREAM_PROBE(wa_in);
   for (unsigned int rep = 0; rep < numReps; rep++) {
     StreamingMaxPool_Precision<ImgDim, PoolDim, NumChannels, ActType, min_value>
       (static_cast<hls::stream<ap_uint<NumChannels*ActType::width>>&>(wa_in), 
       static_cast<hls::stream<ap_uint<NumChannels*ActType::width>>&>(mvOut));
   }
+  FINN_STREAM_PROBE(mvOut);
   StreamingDataWidthConverter_Batch<NumChannels*ActType::width, OutStreamW, OutPerImage>(mvOut, out, numReps);
 
 }
@@ -337,6 +340,125 @@ void StreamingMaxPool_Precision_Batch_1d(hls::stream<ap_uint<PE*ActType::width>
 }
 
 
+/**
+ * \brief   Max Pool implementation for non binarized values with arbitrary kernel and stride on multiple images
+ *
+ * This function performes the maxpool for non binary inputs with possibly overlapping windows, non-square
+ * kernels and non-square feature maps. Every input word is read exactly once: the last PoolDim_x-1 pixels of the
+ * current row are kept to compute the row maxima of the windows, the row maxima of the last PoolDim_y-1 rows
+ * are kept to combine them into the output. Input pixels beyond the last window are discarded.
+ * 
+ * \tparam IFMDim_x     Width of the Input Feature Map
+ * \tparam IFMDim_y     Height of the Input Feature Map
+ * \tparam PoolDim_x    Dimension of the Max Pool kernel - x axis
+ * \tparam PoolDim_y    Dimension of the Max Pool kernel - y axis
+ * \tparam Stride_x     Stride of the Max Pool kernel - x axis
+ * \tparam Stride_y     Stride of the Max Pool kernel - y axis
+ * \tparam NumChannels  Number of Input Feature Maps
+ * \tparam PE           Number of input rows (channels) computed in parallel
+ * \tparam ActType      DataType of the input activation (as used in the comparison)
+ * 
+ * \param in            Input stream
+ * \param out           Output stream
+ * \param numReps       Number of time the function has to be repeatedly executed (e.g. number of images)
+ *
+ */
+template<unsigned int IFMDim_x, unsigned int IFMDim_y, unsigned int PoolDim_x, unsigned int PoolDim_y,
+        unsigned int Stride_x, unsigned int Stride_y, unsigned int NumChannels, unsigned int PE, typename ActType
+        >
+void StreamingMaxPool_Precision_kernel_stride_Batch(hls::stream<ap_uint<PE*ActType::width> > & in,
+        hls::stream<ap_uint<PE*ActType::width> > & out, unsigned int numReps) {
+  static_assert(NumChannels % PE == 0, "");
+  static_assert((IFMDim_x >= PoolDim_x) && (IFMDim_y >= PoolDim_y), "Pool kernel larger than the feature map");
+  constexpr unsigned NF = NumChannels / PE;
+  constexpr unsigned OFMDim_x = (IFMDim_x - PoolDim_x) / Stride_x + 1;
+  // pixels of the current row and row maxima of the previous rows kept in circular buffers
+  constexpr unsigned HIST_X = PoolDim_x > 1? PoolDim_x - 1 : 1;
+  constexpr unsigned HIST_Y = PoolDim_y > 1? PoolDim_y - 1 : 1;
+  constexpr unsigned LAST_X = (OFMDim_x - 1) * Stride_x + PoolDim_x - 1;
+  constexpr unsigned LAST_Y = ((IFMDim_y - PoolDim_y) / Stride_y) * Stride_y + PoolDim_y - 1;
+
+  ap_uint<PE*ActType::width> pixbuf[HIST_X][NF];
+#pragma HLS ARRAY_PARTITION variable=pixbuf complete dim=1
+  ap_uint<PE*ActType::width> rowbuf[HIST_Y][OFMDim_x * NF];
+#pragma HLS ARRAY_PARTITION variable=rowbuf complete dim=1
+
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+    unsigned int pix_slot = 0, row_slot = 0;
+    // next column and row closing a window
+    unsigned int emit_x = PoolDim_x - 1, emit_y = PoolDim_y - 1;
+    unsigned int x = 0, y = 0, f = 0, ox = 0;
+    for (unsigned int i = 0; i < IFMDim_y * IFMDim_x * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=rowbuf inter false
+      ap_uint<PE*ActType::width> const  inputData = in.read();
+      bool const  close_x = x == emit_x;
+      if (close_x) {
+        // row maximum of the window closed by this pixel
+        ap_uint<PE*ActType::width> rowMax = inputData;
+        for (unsigned int k = 0; k < PoolDim_x - 1; k++) {
+#pragma HLS UNROLL
+          ap_uint<PE*ActType::width> const  pix = pixbuf[k][f];
+          for (unsigned int p = 0; p < PE; p++) {
+#pragma HLS UNROLL
+            ActType const  val = pix((p+1) * ActType::width - 1, p * ActType::width);
+            ActType const  oldMax = rowMax((p+1) * ActType::width - 1, p * ActType::width);
+            if (val > oldMax) {
+              rowMax((p+1) * ActType::width - 1, p * ActType::width) = val;
+            }
+          }
+        }
+        if (y == emit_y) {
+          // combine with the row maxima of the previous rows of the window
+          ap_uint<PE*ActType::width> outputData = rowMax;
+          for (unsigned int k = 0; k < PoolDim_y - 1; k++) {
+#pragma HLS UNROLL
+            ap_uint<PE*ActType::width> const  rm = rowbuf[k][ox * NF + f];
+            for (unsigned int p = 0; p < PE; p++) {
+#pragma HLS UNROLL
+              ActType const  val = rm((p+1) * ActType::width - 1, p * ActType::width);
+              ActType const  oldMax = outputData((p+1) * ActType::width - 1, p * ActType::width);
+              if (val > oldMax) {
+                outputData((p+1) * ActType::width - 1, p * ActType::width) = val;
+              }
+            }
+          }
+          out.write(outputData);
+        }
+        if (PoolDim_y > 1) {
+          rowbuf[row_slot][ox * NF + f] = rowMax;
+        }
+      }
+      if (PoolDim_x > 1) {
+        pixbuf[pix_slot][f] = inputData;
+      }
+
+      // advance to the next input word
+      if (++f == NF) {
+        f = 0;
+        if (++pix_slot == HIST_X) {
+          pix_slot = 0;
+        }
+        if (close_x) {
+          ox++;
+          emit_x = (x == LAST_X)? PoolDim_x - 1 : emit_x + Stride_x;
+        }
+        if (++x == IFMDim_x) {
+          x = 0;
+          ox = 0;
+          if (++row_slot == HIST_Y) {
+            row_slot = 0;
+          }
+          if ((y == emit_y) && (y != LAST_Y)) {
+            emit_y += Stride_y;
+          }
+          y++;
+        }
+      }
+    }
+  }
+}
+
 /**
  * \brief   ReLU for fixed-point or integer; can accept a bias at input, which it removes
  *
@@ -388,6 +510,59 @@ void ReLU_Batch(hls::stream<ap_uint<PECount * ActType::width> > & in,
     }
 }
 
+/**
+ * \brief   Global accumulate-pool - sums every channel over all pixels of a frame in a single pass
+ *
+ * Only one accumulator per channel is kept, no window buffer is needed. One vector of NumChannels
+ * accumulators is produced per frame, in NumChannels/PECount words.
+ *
+ * \tparam NumPixels    Number of pixels of the Input Feature Map (e.g. ImgDim*ImgDim)
+ * \tparam NumChannels  Number of Input Feature Maps
+ * \tparam ActType      DataType of the input activation
+ * \tparam PECount      Number of channels processed in parallel
+ * \tparam AccType      Datatype of the accumulation (e.g. output)
+ *
+ * \param in            Input stream
+ * \param out           Output stream
+ * \param numReps       Number of time the function has to be repeatedly executed (e.g. number of images)
+ *
+ */
+template<
+    unsigned int NumPixels,
+    unsigned int NumChannels,
+    typename ActType,
+    unsigned int PECount,
+    typename AccType>
+void GlobalAccPool_Batch(hls::stream<ap_uint<PECount * ActType::width> > & in,
+        hls::stream<ap_uint<PECount * AccType::width> > & out, const unsigned int numReps) {
+  static_assert(NumChannels % PECount == 0, "NumChannels must be a multiple of PECount");
+  constexpr unsigned int NF = NumChannels / PECount;
+  ap_uint<PECount * AccType::width> accumulators[NF];
+#pragma HLS bind_storage variable=accumulators type=RAM_2P impl=LUTRAM
+
+  for(unsigned int reps=0; reps<numReps; reps++){
+    for(unsigned int pixel=0; pixel<NumPixels; pixel++){
+      for(unsigned int fold=0; fold<NF; fold++){
+#pragma HLS pipeline style=flp II=1
+        ap_uint<PECount * ActType::width> const  thin = in.read();
+        ap_uint<PECount * AccType::width> accbank = accumulators[fold];
+        for(unsigned int pe=0; pe<PECount; pe++){
+#pragma HLS UNROLL
+          ActType const  val = thin((pe+1) * ActType::width - 1,pe * ActType::width);
+          AccType const  acc = accbank((pe+1) * AccType::width - 1,pe * AccType::width);
+          AccType const  result = val + (pixel == 0? AccType(0) : acc);
+          accbank((pe+1) * AccType::width - 1,pe * AccType::width) = result;
+        }
+        accumulators[fold] = accbank;
+      }
+    }
+    for(unsigned int fold = 0; fold < NF; fold++){
+#pragma HLS pipeline style=flp II=1
+      out.write(accumulators[fold]);
+    }
+  }
+}
+
 /**
  * \brief   Accumulate-pool - like average pooling over the whole frame, but without the division at end
  *
@@ -410,33 +585,72 @@ template<
         typename AccType>
 void AccPool_Batch(hls::stream<ap_uint<PECount * ActType::width> > & in,
         hls::stream<ap_uint<PECount * AccType::width> > & out, const unsigned int numReps) {
-    ap_uint<PECount * ActType::width> thin;
-  ap_uint<PECount * AccType::width> accumulators[NumChannels/PECount];
+#pragma HLS INLINE
+  GlobalAccPool_Batch<ImgDim*ImgDim, NumChannels, ActType, PECount, AccType>(in, out, numReps);
+}
+
+/**
+ * \brief   Global average pool - averages every channel over all pixels of a frame in a single pass
+ *
+ * Works as GlobalAccPool_Batch, the final division by NumPixels is performed as a multiplication
+ * with its reciprocal (see ReciprocalDivider in pool.hpp), giving the same results as AvgPoolFunction.
+ *
+ * \tparam NumPixels    Number of pixels of the Input Feature Map (e.g. ImgDim*ImgDim)
+ * \tparam NumChannels  Number of Input Feature Maps
+ * \tparam ActType      DataType of the input activation
+ * \tparam PECount      Number of channels processed in parallel
+ * \tparam AccType      Datatype of the accumulation
+ * \tparam OutType      Datatype of the output average
+ *
+ * \param in            Input stream
+ * \param out           Output stream
+ * \param numReps       Number of time the function has to be repeatedly executed (e.g. number of images)
+ *
+ */
+template<
+    unsigned int NumPixels,
+    unsigned int NumChannels,
+    typename ActType,
+    unsigned int PECount,
+    typename AccType,
+    typename OutType>
+void GlobalAvgPool_Batch(hls::stream<ap_uint<PECount * ActType::width> > & in,
+        hls::stream<ap_uint<PECount * OutType::width> > & out, const unsigned int numReps) {
+  static_assert(NumChannels % PECount == 0, "NumChannels must be a multiple of PECount");
+  constexpr unsigned int NF = NumChannels / PECount;
+  ReciprocalDivider<AccType, NumPixels> const  divider;
+  ap_uint<PECount * AccType::width> accumulators[NF];
 #pragma HLS bind_storage variable=accumulators type=RAM_2P impl=LUTRAM
 
-    //call to thresholding library function
-    for(unsigned int reps=0; reps<numReps; reps++){
-        for(unsigned int pixel=0; pixel<ImgDim*ImgDim; pixel++){
-      for(unsigned int fold=0; fold<NumChannels/PECount; fold++){
+  for(unsigned int reps=0; reps<numReps; reps++){
+    for(unsigned int pixel=0; pixel<NumPixels; pixel++){
+      for(unsigned int fold=0; fold<NF; fold++){
 #pragma HLS pipeline style=flp II=1
-        thin = in.read();
+        ap_uint<PECount * ActType::width> const  thin = in.read();
         ap_uint<PECount * AccType::width> accbank = accumulators[fold];
         for(unsigned int pe=0; pe<PECount; pe++){
 #pragma HLS UNROLL
-          // Threshold and assign to right bits of output buffers
           ActType const  val = thin((pe+1) * ActType::width - 1,pe * ActType::width);
           AccType const  acc = accbank((pe+1) * AccType::width - 1,pe * AccType::width);
           AccType const  result = val + (pixel == 0? AccType(0) : acc);
           accbank((pe+1) * AccType::width - 1,pe * AccType::width) = result;
         }
-        accumulators[fold] = accbank;     
+        accumulators[fold] = accbank;
       }
-        }
-    for (unsigned int fold = 0; fold < NumChannels / PECount; fold++)
-    {
-      out.write(accumulators[fold]);
     }
+    for(unsigned int fold = 0; fold < NF; fold++){
+#pragma HLS pipeline style=flp II=1
+      ap_uint<PECount * AccType::width> const  accbank = accumulators[fold];
+      ap_uint<PECount * OutType::width> outElem;
+      for(unsigned int pe=0; pe<PECount; pe++){
+#pragma HLS UNROLL
+        AccType const  acc = accbank((pe+1) * AccType::width - 1,pe * AccType::width);
+        OutType const  avg = divider.template divide<OutType>(acc);
+        outElem((pe+1) * OutType::width - 1,pe * OutType::width) = avg;
+      }
+      out.write(outElem);
     }
+  }
 }
 
 
@@ -531,6 +745,291 @@ void LabelSelect_Batch(hls::stream<ap_uint<PECount * In_T::width> > & in,
 }
 
 
+namespace detail {
+
+/**
+ * \brief   Inserts a value with its payload into a sorted top-NumTop list, best entry first
+ *
+ * All NumTop comparisons are made in parallel and the list shifts by one entry behind the insertion
+ * point, so that one value is inserted per cycle. A value equal to a listed one goes behind it.
+ */
+template<unsigned int NumTop, typename TV, typename TP>
+void top_insert(TV const &val, TP const &payload, TV topval[NumTop], TP toppayload[NumTop], bool topvalid[NumTop]) {
+#pragma HLS INLINE
+  // Insert before the first entry the input is greater than
+  bool  cmp[NumTop];
+  for(unsigned  i = 0; i < NumTop; i++) {
+#pragma HLS UNROLL
+    cmp[i] = !topvalid[i] || (val > topval[i]);
+  }
+  for(unsigned  i = NumTop; i-- > 0;) {
+#pragma HLS UNROLL
+    if(cmp[i]) {
+      if((i > 0) && cmp[i-1]) {
+        // Shift
+        topval    [i] = topval    [i-1];
+        toppayload[i] = toppayload[i-1];
+        topvalid  [i] = topvalid  [i-1];
+      }
+      else {
+        // Insert
+        topval    [i] = val;
+        toppayload[i] = payload;
+        topvalid  [i] = true;
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * \brief   LabelSelect_Tournament_Batch - returns labels (and optionally scores) of top-NumTop in stream
+ *
+ * Drop-in replacement for LabelSelect_Batch scaling to large PECount and NumTop. Every one of the
+ * PECount lanes maintains its own sorted top-NumTop list, so that no comparator chain spans the lanes.
+ * After the last input word, the lane lists are merged over NumTop cycles by a tournament tree of
+ * PECount-1 comparators selecting the best list head. Labels are output highest value first, equal
+ * values in order of their label as for LabelSelect_Batch.
+ *
+ * \tparam NumClasses   Number of classes of the dataset
+ * \tparam PECount      Number of inputs to be processed in parallel
+ * \tparam NumTop       Number of top classes to be selected in output
+ * \tparam In_T         Datatype of the input
+ * \tparam Out_T        Datatype of the output
+ * \tparam EmitScores   Whether the values of the selected labels are written to scores
+ * 
+ * \param in            Input stream
+ * \param out           Output stream of the labels
+ * \param scores        Output stream of the values of the selected labels
+ * \param numReps       Number of times the function has to be repeatedly executed (e.g. number of images)
+ *
+ */
+template<
+    // tensor size parameters
+    unsigned int NumClasses,
+    unsigned int PECount,
+    unsigned int NumTop,
+    typename In_T,
+    typename Out_T,
+    bool EmitScores = true>
+void LabelSelect_Tournament_Batch(hls::stream<ap_uint<PECount * In_T::width> > & in,
+        hls::stream<Out_T> & out, hls::stream<In_T> & scores, const unsigned int numReps) {
+
+  // Check that classes, aka. labels / indeces, can be encoded as non-negative outputs
+  static_assert(clog2(NumClasses) <= Out_T::width - Out_T::sign_flag, "");
+  static_assert(NumClasses % PECount == 0, "NumClasses must be a multiple of PECount");
+  static_assert(NumTop <= NumClasses, "NumTop must not exceed NumClasses");
+
+  // Per-lane top lists, best entry first
+  In_T topval[PECount][NumTop];
+#pragma HLS ARRAY_PARTITION variable=topval complete dim=0
+  Out_T toplabels[PECount][NumTop];
+#pragma HLS ARRAY_PARTITION variable=toplabels complete dim=0
+  bool topvalid[PECount][NumTop];
+#pragma HLS ARRAY_PARTITION variable=topvalid complete dim=0
+
+  for(unsigned int reps=0; reps<numReps; reps++){
+    for(unsigned int elem=0; elem<PECount; elem++){
+#pragma HLS UNROLL
+      for(unsigned int topx=0; topx<NumTop; topx++){
+#pragma HLS UNROLL
+        topvalid[elem][topx] = false;
+      }
+    }
+    for(unsigned int block=0; block<(NumClasses/PECount); block++){
+#pragma HLS pipeline style=flp II=1
+      ap_uint<PECount * In_T::width> const  inval = in.read();
+      for(unsigned int elem=0; elem<PECount; elem++){
+#pragma HLS UNROLL
+        In_T const  val = inval((elem+1) * In_T::width - 1, elem * In_T::width);
+        Out_T const  label = block*PECount + elem;
+
+        detail::top_insert<NumTop>(val, label, topval[elem], toplabels[elem], topvalid[elem]);
+      }
+    }
+
+    // Merge - select the best lane head and advance that lane
+    for(unsigned int topx = 0; topx < NumTop; topx++){
+#pragma HLS pipeline style=flp II=1
+      unsigned  cand[PECount];
+#pragma HLS ARRAY_PARTITION variable=cand complete dim=1
+      for(unsigned  elem = 0; elem < PECount; elem++) {
+#pragma HLS UNROLL
+        cand[elem] = elem;
+      }
+      for(unsigned  dist = 1; dist < PECount; dist *= 2) {
+#pragma HLS UNROLL
+        for(unsigned  elem = 0; elem + dist < PECount; elem += 2*dist) {
+#pragma HLS UNROLL
+          unsigned const  a = cand[elem];
+          unsigned const  b = cand[elem + dist];
+          bool const  take_b = topvalid[b][0] && (!topvalid[a][0] || (topval[b][0] > topval[a][0]) ||
+                              ((topval[b][0] == topval[a][0]) && (toplabels[b][0] < toplabels[a][0])));
+          cand[elem] = take_b? b : a;
+        }
+      }
+      unsigned const  win = cand[0];
+      out.write(toplabels[win][0]);
+      if(EmitScores) {
+        scores.write(topval[win][0]);
+      }
+      for(unsigned  elem = 0; elem < PECount; elem++) {
+#pragma HLS UNROLL
+        if(elem == win) {
+          for(unsigned  i = 0; i < NumTop-1; i++) {
+#pragma HLS UNROLL
+            topval   [elem][i] = topval   [elem][i+1];
+            toplabels[elem][i] = toplabels[elem][i+1];
+            topvalid [elem][i] = topvalid [elem][i+1];
+          }
+          topvalid[elem][NumTop-1] = false;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * \brief   LabelSelect_Tournament_Batch - returns labels of top-NumTop in stream
+ *
+ * See the variant with the scores output stream, which is left unused.
+ *
+ * \tparam NumClasses   Number of classes of the dataset
+ * \tparam PECount      Number of inputs to be processed in parallel
+ * \tparam NumTop       Number of top classes to be selected in output
+ * \tparam In_T         Datatype of the input
+ * \tparam Out_T        Datatype of the output
+ * 
+ * \param in            Input stream
+ * \param out           Output stream of the labels
+ * \param numReps       Number of times the function has to be repeatedly executed (e.g. number of images)
+ *
+ */
+template<
+    // tensor size parameters
+    unsigned int NumClasses,
+    unsigned int PECount,
+    unsigned int NumTop,
+    typename In_T,
+    typename Out_T>
+void LabelSelect_Tournament_Batch(hls::stream<ap_uint<PECount * In_T::width> > & in,
+        hls::stream<Out_T> & out, const unsigned int numReps) {
+#pragma HLS INLINE
+  hls::stream<In_T> scores("LabelSelect_Tournament_Batch.scores");
+  LabelSelect_Tournament_Batch<NumClasses, PECount, NumTop, In_T, Out_T, false>(in, out, scores, numReps);
+}
+
+/**
+ * \brief   PixelArgmax_Batch - returns the label (and optionally the score) of the top class of every pixel
+ *
+ * Reduces the NumClasses scores of every pixel, such as output by a segmentation head, to the index
+ * of their maximum. The PECount scores of an input word are reduced by a comparator tree and merged
+ * into the running maximum of the pixel, one word per cycle. Equal values resolve to the lowest label.
+ *
+ * \tparam NumClasses   Number of classes of the dataset
+ * \tparam PECount      Number of inputs to be processed in parallel
+ * \tparam NumPixels    Number of pixels per image
+ * \tparam In_T         Datatype of the input
+ * \tparam Out_T        Datatype of the output
+ * \tparam EmitScores   Whether the values of the selected labels are written to scores
+ *
+ * \param in            Input stream
+ * \param out           Output stream of the labels, one per pixel
+ * \param scores        Output stream of the values of the selected labels
+ * \param numReps       Number of times the function has to be repeatedly executed (e.g. number of images)
+ *
+ */
+template<
+    // tensor size parameters
+    unsigned int NumClasses,
+    unsigned int PECount,
+    unsigned int NumPixels,
+    typename In_T,
+    typename Out_T,
+    bool EmitScores = true>
+void PixelArgmax_Batch(hls::stream<ap_uint<PECount * In_T::width> > & in,
+        hls::stream<Out_T> & out, hls::stream<In_T> & scores, const unsigned int numReps) {
+
+  // Check that classes, aka. labels / indeces, can be encoded as non-negative outputs
+  static_assert(clog2(NumClasses) <= Out_T::width - Out_T::sign_flag, "");
+  static_assert(NumClasses % PECount == 0, "NumClasses must be a multiple of PECount");
+  constexpr unsigned int  NF = NumClasses / PECount;
+
+  In_T  bestval;
+  Out_T  bestlabel;
+  unsigned int  block = 0;
+  for(unsigned int i = 0; i < numReps * NumPixels * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+    ap_uint<PECount * In_T::width> const  inval = in.read();
+
+    // Reduce the lanes, the lower one winning ties
+    In_T  val[PECount];
+#pragma HLS ARRAY_PARTITION variable=val complete dim=1
+    Out_T  label[PECount];
+#pragma HLS ARRAY_PARTITION variable=label complete dim=1
+    for(unsigned int elem = 0; elem < PECount; elem++) {
+#pragma HLS UNROLL
+      val  [elem] = inval((elem+1) * In_T::width - 1, elem * In_T::width);
+      label[elem] = block*PECount + elem;
+    }
+    for(unsigned int dist = 1; dist < PECount; dist *= 2) {
+#pragma HLS UNROLL
+      for(unsigned int elem = 0; elem + dist < PECount; elem += 2*dist) {
+#pragma HLS UNROLL
+        if(val[elem + dist] > val[elem]) {
+          val  [elem] = val  [elem + dist];
+          label[elem] = label[elem + dist];
+        }
+      }
+    }
+
+    // Merge into the running maximum of the pixel
+    if((block == 0) || (val[0] > bestval)) {
+      bestval   = val[0];
+      bestlabel = label[0];
+    }
+    if(++block == NF) {
+      block = 0;
+      out.write(bestlabel);
+      if(EmitScores) {
+        scores.write(bestval);
+      }
+    }
+  }
+}
+
+/**
+ * \brief   PixelArgmax_Batch - returns the label of the top class of every pixel
+ *
+ * See the variant with the scores output stream, which is left unused.
+ *
+ * \tparam NumClasses   Number of classes of the dataset
+ * \tparam PECount      Number of inputs to be processed in parallel
+ * \tparam NumPixels    Number of pixels per image
+ * \tparam In_T         Datatype of the input
+ * \tparam Out_T        Datatype of the output
+ *
+ * \param in            Input stream
+ * \param out           Output stream of the labels, one per pixel
+ * \param numReps       Number of times the function has to be repeatedly executed (e.g. number of images)
+ *
+ */
+template<
+    // tensor size parameters
+    unsigned int NumClasses,
+    unsigned int PECount,
+    unsigned int NumPixels,
+    typename In_T,
+    typename Out_T>
+void PixelArgmax_Batch(hls::stream<ap_uint<PECount * In_T::width> > & in,
+        hls::stream<Out_T> & out, const unsigned int numReps) {
+#pragma HLS INLINE
+  hls::stream<In_T> scores("PixelArgmax_Batch.scores");
+  PixelArgmax_Batch<NumClasses, PECount, NumPixels, In_T, Out_T, false>(in, out, scores, numReps);
+}
+
+
 /**
  * \brief Pool_batch function
  *
@@ -606,4 +1105,82 @@ void Pool_batch(hls::stream<TI> &in,
   }
 }
 
+/**
+ * \brief Pool_batch function, MMV pixels in parallel
+ *
+ * Variant of Pool_batch consuming the MultiChanData output of an MMV sliding window unit, such as
+ * ConvolutionInputGenerator_MMV, so that a pooling stage keeps the pixel rate of the MMV pipeline. Every
+ * input word holds the same PE channels of one kernel position for the windows of MMV output pixels.
+ *
+ * \tparam Channels   Number of channels in the pool layer
+ * \tparam PE         Number of channels in the pool layer computed in parallel
+ * \tparam TotalK     Total kernel size of pooling (e.g. 3x3=9)
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TSrcI      DataType of the input value (Slice_mmv)
+ * \tparam TDstI      DataType of the output value (Slice_mmv)
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TA         DataType of the function class (e.g. Max, Avg, Sum) - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param function    Function class in the pool (Max, Avg, Sum)
+ * \param reps        Number of groups of MMV output pixels (e.g. output pixels / MMV times number of images)
+ */
+template<
+  unsigned Channels, unsigned PE, unsigned TotalK, unsigned MMV,
+  typename TSrcI = Identity,typename TDstI = Identity,
+  typename TI, typename TO, typename TA
+>
+void Pool_MMV_batch(hls::stream<TI> &in,
+                  hls::stream<TO> &out,
+                  TA  const &function,
+                  int const  reps) {
+
+  constexpr unsigned  NF = Channels / PE;
+  constexpr unsigned  SF = TotalK;
+  constexpr unsigned  TOTAL_FOLD = NF * SF ;
+
+  decltype(function.init())  accu[MMV][PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+
+  unsigned  sf   = 0;
+  for(unsigned  i = 0; i < reps * TOTAL_FOLD; i++) {
+#pragma HLS pipeline style=flp II=1
+    TI const  pixel_slice = in.read();
+
+    if(sf == 0) {
+      for(unsigned  mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+        for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          accu[mmv][pe] = function.init();
+        }
+      }
+    }
+
+    auto const  slice_channels = TSrcI()(pixel_slice);
+    for(unsigned  mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        accu[mmv][pe] = function.pool(slice_channels(pe,mmv), accu[mmv][pe]);
+      }
+    }
+
+    if(++sf == SF) {
+      auto  outElem = TDstI().template operator()<TO>();
+      for(unsigned  mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+        for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          outElem(pe,mmv,1) = function.activate(accu[mmv][pe]);
+        }
+      }
+      out.write(outElem);
+      sf = 0;
+    }
+  }
+}
+
 #endif
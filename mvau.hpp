@@ -52,10 +52,12 @@
 #define MVAU_HPP
 
 #include "hls_stream.h"
+#include <utility>
 
 #include "mac.hpp"
 #include "interpret.hpp"
 #include "weights.hpp"
+#include "streamtools.h"
 
 /**
  * \brief Matrix vector activate function
@@ -104,6 +106,8 @@ void Matrix_Vector_Activate_Batch(hls::stream<TI> &in,
   // how many synapse groups each row is split into
   // alternatively: number of horizontal matrix chunks
   unsigned const  SF = MatrixW / SIMD;
+  FINN_STREAM_CHECK_IN(in, 1ull * reps * SF);
+  FINN_STREAM_CHECK_OUT(out, 1ull * reps * NF);
 
   // input vector buffers
   TI  inputBuf[SF];
@@ -180,75 +184,1731 @@ void Matrix_Vector_Activate_Batch(hls::stream<TI> &in,
 }
 
 
+/**
+ * \brief Grouped matrix vector activate function
+ *
+ * Computes a grouped convolution, in which each output channel only sees the input channels of its group.
+ * Every input vector consists of Groups sub-vectors of MatrixW elements, one per group, as emitted by
+ * ConvolutionInputGenerator_Grouped. Group g multiplies its sub-vector by its own MatrixH/Groups x MatrixW
+ * weight matrix to produce the output rows g*MatrixH/Groups to (g+1)*MatrixH/Groups-1. The weight tiles are
+ * stored group by group, each group in the layout of Matrix_Vector_Activate_Batch, so that no compute and no
+ * weight memory is spent on the zero blocks of the equivalent dense matrix.
+ *
+ * \tparam MatrixW    Width of the weight matrix of a group
+ * \tparam MatrixH    Heigth of the whole weight matrix, i.e. the number of output channels
+ * \tparam Groups     Number of groups
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TW         DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param weights     Weights of Groups * (MatrixH/Groups/PE) * (MatrixW/SIMD) tiles
+ * \param activation  Activation class, indexed by the neuron fold of the whole matrix
+ * \param reps        Number of input vectors (all groups)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned Groups, unsigned SIMD, unsigned PE, unsigned MMV,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+  typename TI, typename TO, typename TW, typename TA, typename R
+>
+void Matrix_Vector_Activate_Grouped_Batch(hls::stream<TI> &in,
+				  hls::stream<TO> &out,
+				  TW  const &weights,
+				  TA  const &activation,
+				  int const  reps,
+				  R const &r) {
+  static_assert(MatrixH % Groups == 0, "Groups must divide MatrixH.");
+  static_assert((MatrixH / Groups) % PE == 0, "PE must divide the rows of a group.");
+  static_assert(MatrixW % SIMD == 0, "SIMD must divide MatrixW.");
+
+  // neuron folds of a group
+  unsigned const  NF = MatrixH / Groups / PE;
+  unsigned const  SF = MatrixW / SIMD;
+
+  // input buffer of the sub-vector of the current group
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+
+  decltype(activation.init(0,0))  accu[MMV][PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+
+  unsigned  g    = 0;
+  unsigned  nf   = 0;
+  unsigned  sf   = 0;
+  unsigned  tile = 0; // invariant: tile = (g*NF + nf)*SF + sf
+
+  unsigned const TOTAL_FOLD = Groups * NF * SF;
+  for(unsigned  i = 0; i < reps * TOTAL_FOLD; i++) {
+#pragma HLS pipeline style=flp II=1
+    TI  inElem;
+    if(nf == 0) {
+      inElem = in.read();
+      inputBuf[sf] = inElem;
+    }
+    else {
+      inElem = inputBuf[sf];
+    }
+
+    // neuron fold within the whole matrix
+    unsigned const  nfm = g*NF + nf;
+    if(sf == 0) {
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for(unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+          accu[mmv][pe] = activation.init(nfm, pe);
+        }
+      }
+    }
+
+    auto const &w = weights.weights(tile);
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      auto const  wgt = TWeightI()(w[pe]);
+      for (unsigned mmv = 0; mmv < MMV; mmv++){
+        auto const  act = TSrcI()(inElem, mmv);
+        accu[mmv][pe] = mac<SIMD>(accu[mmv][pe], wgt, act, r, mmv);
+      }
+    }
+
+    ++tile;
+    if(++sf == SF) {
+      auto  outElem = TDstI().template operator()<TO>();
+      for (unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for (unsigned mmv = 0; mmv < MMV; mmv++){
+#pragma HLS UNROLL
+          outElem(pe,mmv,1) = activation.activate(nfm, pe, accu[mmv][pe]);
+        }
+      }
+      out.write(outElem);
+      // next folded neuron, group or vector
+      sf = 0;
+      if(++nf == NF) {
+        nf = 0;
+        if(++g == Groups) {
+          g    = 0;
+          tile = 0;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * \brief Interleaved matrix vector activate function
+ *
+ * Drop-in replacement for Matrix_Vector_Activate_Batch for accumulators whose addition takes more than one
+ * cycle, e.g. floating-point or very wide ones. The neuron folds are processed in groups of Interleave, whose
+ * accumulations are interleaved cycle by cycle: a group accumulates synapse fold sf of all its neuron folds
+ * before moving on to sf+1. Each accumulator is thus updated only every Interleave cycles, which hides an
+ * addition latency of up to Interleave cycles at II=1. The outputs are produced in the order of the neuron
+ * folds, the last Interleave of them in consecutive cycles. The accumulators and the buffered input vector
+ * are banked internally.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam Interleave Number of interleaved neuron folds, dividing MatrixH/PE
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TW         DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param weights     Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV, unsigned Interleave,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+  typename TI, typename TO, typename TW, typename TA, typename R
+>
+void Matrix_Vector_Activate_Interleaved_Batch(hls::stream<TI> &in,
+				  hls::stream<TO> &out,
+				  TW  const &weights,
+				  TA  const &activation,
+				  int const  reps,
+				  R const &r) {
+  static_assert(MatrixH % PE == 0, "PE must divide MatrixH.");
+  static_assert(MatrixW % SIMD == 0, "SIMD must divide MatrixW.");
+  static_assert((MatrixH / PE) % Interleave == 0, "Interleave must divide the neuron folds.");
+
+  unsigned const  NF = MatrixH / PE;
+  unsigned const  SF = MatrixW / SIMD;
+  // groups of interleaved neuron folds
+  unsigned const  NG = NF / Interleave;
+
+  // input vector buffers
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+
+  // one bank of accumulators per interleaved neuron fold, each updated every Interleave cycles
+  decltype(activation.init(0,0))  accu[Interleave][MMV][PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=2
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=3
+#pragma HLS DEPENDENCE variable=accu inter RAW distance=Interleave true
+
+  unsigned  ng = 0;
+  unsigned  sf = 0;
+  unsigned  l  = 0;
+
+  unsigned const TOTAL_FOLD = NF * SF;
+  for(unsigned  i = 0; i < reps * TOTAL_FOLD; i++) {
+#pragma HLS pipeline style=flp II=1
+    unsigned const  nf = ng*Interleave + l;
+    TI  inElem;
+    if((ng == 0) && (l == 0)) {
+      // read input from stream
+      inElem = in.read();
+      // store in appropriate buffer for reuse
+      inputBuf[sf] = inElem;
+    }
+    else {
+      // reuse buffered input
+      inElem = inputBuf[sf];
+    }
+
+    // Threshold Initialisation
+    if(sf == 0) {
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for(unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+          accu[l][mmv][pe] = activation.init(nf, pe);
+        }
+      }
+    }
+
+    // compute matrix-vector product for each processing element
+    auto const &w = weights.weights(nf*SF + sf);
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      auto const  wgt = TWeightI()(w[pe]);
+      for (unsigned mmv = 0; mmv < MMV; mmv++){
+        auto const  act = TSrcI()(inElem, mmv);
+        accu[l][mmv][pe] = mac<SIMD>(accu[l][mmv][pe], wgt, act, r, mmv);
+      }
+    }
+
+    if(sf == SF-1) {
+      // produce output of the completed neuron fold
+      auto  outElem = TDstI().template operator()<TO>();
+      for (unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for (unsigned mmv = 0; mmv < MMV; mmv++){
+#pragma HLS UNROLL
+          outElem(pe,mmv,1) = activation.activate(nf, pe, accu[l][mmv][pe]);
+        }
+      }
+      out.write(outElem);
+    }
+
+    // next interleaved neuron fold, synapse fold, group or image
+    if(++l == Interleave) {
+      l = 0;
+      if(++sf == SF) {
+        sf = 0;
+        if(++ng == NG)  ng = 0;
+      }
+    }
+  }
+}
+
+/**
+ * \brief Bit-serial matrix vector activate function
+ *
+ * Drop-in replacement for Matrix_Vector_Activate_Batch trading cycles for area. The input activations
+ * are processed one bit-plane per cycle, LSB first, so that each folded tile takes as many cycles as the
+ * activations have bits. A bit-plane is multiplied by the weights through mac, which reduces to a masked
+ * adder tree (an AND and popcount for 1-bit weights), and shift-accumulated. The MSB plane of signed
+ * activations is subtracted. ap_resource_lut lets HLS reduce the single-bit products to plain logic.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC), a Slice of ap_int or ap_uint
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TW         DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param weights     Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+  typename TI, typename TO, typename TW, typename TA, typename R
+>
+void Matrix_Vector_Activate_BitSerial_Batch(hls::stream<TI> &in,
+				  hls::stream<TO> &out,
+				  TW  const &weights,
+				  TA  const &activation,
+				  int const  reps,
+				  R const &r) {
+
+  // how many different rows each neuron will compute
+  // alternatively: number of vertical matrix chunks
+  unsigned const  NF = MatrixH / PE;
+
+  // how many synapse groups each row is split into
+  // alternatively: number of horizontal matrix chunks
+  unsigned const  SF = MatrixW / SIMD;
+
+  // bit-planes per activation and whether the MSB plane has a negative weight
+  using  TE = typename std::decay<decltype(TSrcI()(std::declval<TI const&>(), 0)(0, 0))>::type;
+  unsigned const  BITS = TE::width;
+  bool const  SIGNED = accu_width::value_range<TE>::min < 0;
+
+  // input vector buffers
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+
+  using  TACC = decltype(activation.init(0,0));
+  TACC  accu[MMV][PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+
+  unsigned  nf   = 0;
+  unsigned  sf   = 0;
+  unsigned  bit  = 0;
+  unsigned  tile = 0; // invariant: tile = nf*SF + sf
+
+  // everything merged into a common iteration space (one "big" loop instead
+  // of smaller nested loops) to get the pipelinening the way we want
+  unsigned const TOTAL_FOLD = NF * SF * BITS;
+  for(unsigned  i = 0; i < reps * TOTAL_FOLD; i++) {
+#pragma HLS pipeline style=flp II=1
+    TI  inElem;
+    if((nf == 0) && (bit == 0)) {
+      // read input from stream
+      inElem = in.read();
+      // store in appropriate buffer for reuse
+      inputBuf[sf] = inElem;
+    }
+    else {
+      // reuse buffered input
+      inElem = inputBuf[sf];
+    }
+
+    // Threshold Initialisation
+    if((sf == 0) && (bit == 0)) {
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for(unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+          accu[mmv][pe] = activation.init(nf, pe);
+        }
+      }
+    }
+
+    // extract the current bit-plane of every output pixel
+    std::array<ap_uint<1>, SIMD>  plane[MMV];
+#pragma HLS ARRAY_PARTITION variable=plane complete dim=0
+    for(unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+      auto const  act = TSrcI()(inElem, mmv);
+      for(unsigned  i = 0; i < SIMD; i++) {
+#pragma HLS UNROLL
+        TE const  e = act(i, mmv);
+        plane[mmv][i] = e[bit];
+      }
+    }
+
+    // weigh the bit-plane and shift-accumulate it for each processing element
+    auto const &w = weights.weights(tile);
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      auto const  wgt = TWeightI()(w[pe]);
+      for (unsigned mmv = 0; mmv < MMV; mmv++){
+#pragma HLS UNROLL
+        TACC const  part = TACC(mac<SIMD>(TACC(0), wgt, plane[mmv], r)) << bit;
+        if(SIGNED && (bit == BITS-1))  accu[mmv][pe] -= part;
+        else                           accu[mmv][pe] += part;
+      }
+    }
+
+    // keep track of which bit-plane and folded synapse/neuron we are processing
+    if(++bit == BITS) {
+      bit = 0;
+      ++tile;
+      if(++sf == SF) {
+        // produce output and clear accumulators
+        auto  outElem = TDstI().template operator()<TO>();
+        for (unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          for (unsigned mmv = 0; mmv < MMV; mmv++){
+#pragma HLS UNROLL
+            outElem(pe,mmv,1) = activation.activate(nf, pe, accu[mmv][pe]);
+          }
+        }
+        out.write(outElem);
+        // next folded neuron or image
+        sf = 0;
+        if(++nf == NF) {
+          nf   = 0;
+          tile = 0;
+        }
+      }
+    }
+  }
+}
+
+
+/**
+ * \brief Systolic matrix vector activate function
+ *
+ * Drop-in replacement for Matrix_Vector_Activate_Batch avoiding the broadcast of the input words to all
+ * PEs. The PEs form a chain of registered, output-stationary MAC cells: an input word, together with the
+ * tile it belongs to, enters PE 0 and advances one PE per cycle, so that PE pe works on the step PE 0 did
+ * pe cycles before. Each PE reads the weights from its own partition, and each input word carries MMV
+ * output pixels so that the weights of a PE are reused across them. The completed outputs drain along the
+ * same chain into an output word, which leaves PE-1 cycles after PE 0 completed its part. The latency
+ * grows by PE-1 cycles, the throughput is that of Matrix_Vector_Activate_Batch.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TW         DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param weights     Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+  typename TI, typename TO, typename TW, typename TA, typename R
+>
+void Matrix_Vector_Activate_Systolic_Batch(hls::stream<TI> &in,
+				  hls::stream<TO> &out,
+				  TW  const &weights,
+				  TA  const &activation,
+				  int const  reps,
+				  R const &r) {
+
+  // how many different rows each neuron will compute
+  // alternatively: number of vertical matrix chunks
+  unsigned const  NF = MatrixH / PE;
+
+  // how many synapse groups each row is split into
+  // alternatively: number of horizontal matrix chunks
+  unsigned const  SF = MatrixW / SIMD;
+
+  // input vector buffers
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+
+  decltype(activation.init(0,0))  accu[MMV][PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+
+  // step registers between the PEs: the step processed by PE pe in the last cycle
+  bool      stepValid[PE];
+  TI        stepElem[PE];
+  unsigned  stepNF[PE];
+  unsigned  stepSF[PE];
+  unsigned  stepTile[PE];
+#pragma HLS ARRAY_PARTITION variable=stepValid complete dim=0
+#pragma HLS ARRAY_PARTITION variable=stepElem complete dim=0
+#pragma HLS ARRAY_PARTITION variable=stepNF complete dim=0
+#pragma HLS ARRAY_PARTITION variable=stepSF complete dim=0
+#pragma HLS ARRAY_PARTITION variable=stepTile complete dim=0
+  // drain registers: the output word filled up to PE pe in the last cycle
+  TO  drain[PE];
+#pragma HLS ARRAY_PARTITION variable=drain complete dim=0
+  for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+    stepValid[pe] = false;
+  }
+
+  unsigned  nf   = 0;
+  unsigned  sf   = 0;
+  unsigned  tile = 0; // invariant: tile = nf*SF + sf
+
+  // everything merged into a common iteration space, extended by the PE-1
+  // cycles it takes the last step to reach the end of the chain
+  unsigned const TOTAL_FOLD = NF * SF;
+  for(unsigned  i = 0; i < reps * TOTAL_FOLD + PE-1; i++) {
+#pragma HLS pipeline style=flp II=1
+    // step entering PE 0
+    bool const  valid = i < reps * TOTAL_FOLD;
+    TI  inElem;
+    if(valid) {
+      if(nf == 0) {
+        // read input from stream
+        inElem = in.read();
+        // store in appropriate buffer for reuse
+        inputBuf[sf] = inElem;
+      }
+      else {
+        // reuse buffered input
+        inElem = inputBuf[sf];
+      }
+    }
+
+    // advance the chain from its end so that every PE picks up the step of its predecessor
+    for(unsigned  pe = PE; pe-- > 0;) {
+#pragma HLS UNROLL
+      bool      const  v  = pe == 0? valid  : stepValid[pe-1];
+      TI        const  x  = pe == 0? inElem : stepElem[pe-1];
+      unsigned  const  n  = pe == 0? nf     : stepNF[pe-1];
+      unsigned  const  s  = pe == 0? sf     : stepSF[pe-1];
+      unsigned  const  t  = pe == 0? tile   : stepTile[pe-1];
+
+      if(v) {
+        // Threshold Initialisation
+        if(s == 0) {
+          for(unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+            accu[mmv][pe] = activation.init(n, pe);
+          }
+        }
+
+        // compute the contribution of this step
+        auto const  wgt = TWeightI()(weights.weights(t)[pe]);
+        for (unsigned mmv = 0; mmv < MMV; mmv++){
+#pragma HLS UNROLL
+          auto const  act = TSrcI()(x, mmv);
+          accu[mmv][pe] = mac<SIMD>(accu[mmv][pe], wgt, act, r, mmv);
+        }
+
+        // add the output of this PE to the word draining along the chain
+        if(s == SF-1) {
+          auto  outElem = pe == 0? TDstI().template operator()<TO>() : TDstI()(drain[pe-1]);
+          for (unsigned mmv = 0; mmv < MMV; mmv++){
+#pragma HLS UNROLL
+            outElem(pe,mmv,1) = activation.activate(n, pe, accu[mmv][pe]);
+          }
+          if(pe == PE-1)  out.write(outElem);
+          else            drain[pe] = outElem;
+        }
+      }
+
+      stepValid[pe] = v;
+      stepElem[pe]  = x;
+      stepNF[pe]    = n;
+      stepSF[pe]    = s;
+      stepTile[pe]  = t;
+    }
+
+    // keep track of which folded synapse/neuron enters the chain next
+    if(valid) {
+      ++tile;
+      if(++sf == SF) {
+        sf = 0;
+        if(++nf == NF) {
+          nf   = 0;
+          tile = 0;
+        }
+      }
+    }
+  }
+}
+
+
+namespace detail {
+  // View of the SIMD lanes [ofs, ofs+N) of a weight or activation container
+  template<typename T>
+  class LaneOffset {
+    T const &m_v;
+    unsigned const  m_ofs;
+   public:
+    LaneOffset(T const &v, unsigned const  ofs) : m_v(v), m_ofs(ofs) {
+#pragma HLS inline
+    }
+    template<typename U = T>
+    auto operator[](unsigned const  i) const -> decltype(std::declval<U const&>()[i]) {
+#pragma HLS inline
+      return  m_v[m_ofs + i];
+    }
+    template<typename U = T>
+    auto operator()(unsigned const  i, unsigned const  mmv) const -> decltype(std::declval<U const&>()(i, mmv)) {
+#pragma HLS inline
+      return  m_v(m_ofs + i, mmv);
+    }
+  };
+}
+
+/**
+ * \brief Operands of one folded tile passed to the multiply core of the double-pumped MVAU
+ *
+ * The input word and the SIMD weights of all PE rows of the tile, packed as the weight streams of
+ * Matrix_Vector_Activate_Stream_Batch.
+ */
+template<typename TI, int WeightWidth>
+struct DoublePumpedOperands {
+  TI                     act;
+  ap_uint<WeightWidth>   wgt;
+};
+
+/**
+ * \brief Dot products of one folded tile returned by the multiply core of the double-pumped MVAU
+ */
+template<typename TAcc, unsigned MMV, unsigned PE>
+struct DoublePumpedSums {
+  TAcc  sum[MMV][PE];
+};
+
+/**
+ * \brief Operand fetch of the double-pumped matrix vector activation, fabric clock
+ *
+ * Buffers the input vector for its reuse by all folded neurons, reads the weight memory and passes word
+ * and weights of one tile per cycle to DoublePumped_Multiply.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed per fabric cycle
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam WT         DataType of the weights - safely deducible from the paramaters
+ * \tparam TILES      Number of tiles of the weights - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param ops         Operand stream to the multiply core
+ * \param weights     Weights matrix
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE,
+  typename TI, typename WT, unsigned TILES
+>
+void DoublePumped_Fetch(hls::stream<TI> &in,
+                        hls::stream<DoublePumpedOperands<TI, PE*SIMD*WT::width>> &ops,
+                        FixedPointWeights<SIMD, WT, PE, TILES> const &weights,
+                        int const  reps) {
+  unsigned const  NF = MatrixH / PE;
+  unsigned const  SF = MatrixW / SIMD;
+  static_assert(TILES == (MatrixH / PE) * (MatrixW / SIMD), "The weights must hold one tile per fold.");
+
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+
+  unsigned  nf   = 0;
+  unsigned  sf   = 0;
+  unsigned  tile = 0; // invariant: tile = nf*SF + sf
+  for(unsigned  i = 0; i < reps * NF * SF; i++) {
+#pragma HLS pipeline style=flp II=1
+    DoublePumpedOperands<TI, PE*SIMD*WT::width>  op;
+    if(nf == 0) {
+      op.act = in.read();
+      inputBuf[sf] = op.act;
+    }
+    else {
+      op.act = inputBuf[sf];
+    }
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      op.wgt((pe+1)*SIMD*WT::width-1, pe*SIMD*WT::width) = weights.m_weights[pe][tile];
+    }
+    ops.write(op);
+
+    ++tile;
+    if(++sf == SF) {
+      sf = 0;
+      if(++nf == NF) {
+        nf   = 0;
+        tile = 0;
+      }
+    }
+  }
+}
+
+/**
+ * \brief Multiply core of the double-pumped matrix vector activation, twice the fabric clock
+ *
+ * Computes the dot products of every tile in two iterations of SIMD/2 lanes each, i.e. with half the
+ * multipliers of Matrix_Vector_Activate_Batch. Clocked at twice the frequency of the fabric, it consumes
+ * one tile per fabric cycle. It only holds the multipliers and the adder tree of the two halves, so that
+ * the weight memories, the accumulators, the activation and the control stay in the fabric clock domain.
+ *
+ * \tparam SIMD       Number of input columns per tile, even
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam WT         DataType of the weights
+ * \tparam TAcc       DataType of the dot products
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param ops         Operand stream from DoublePumped_Fetch
+ * \param sums        Dot product stream to DoublePumped_Accumulate
+ * \param numTiles    Number of tiles to be computed
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned SIMD, unsigned PE, unsigned MMV,
+  typename TSrcI, typename TWeightI, typename WT, typename TAcc,
+  typename TI, typename R
+>
+void DoublePumped_Multiply(hls::stream<DoublePumpedOperands<TI, PE*SIMD*WT::width>> &ops,
+                           hls::stream<DoublePumpedSums<TAcc, MMV, PE>> &sums,
+                           unsigned const  numTiles,
+                           R const &r) {
+  static_assert(SIMD % 2 == 0, "SIMD must be even to be split into two halves.");
+  unsigned const  HALF = SIMD / 2;
+
+  DoublePumpedOperands<TI, PE*SIMD*WT::width>  op;
+  DoublePumpedSums<TAcc, MMV, PE>  part;
+#pragma HLS ARRAY_PARTITION variable=part.sum complete dim=0
+
+  unsigned  half = 0;
+  for(unsigned  i = 0; i < 2 * numTiles; i++) {
+#pragma HLS pipeline style=flp II=1
+    if(half == 0)  op = ops.read();
+    Weights_Tile<SIMD, WT, PE>  w;
+#pragma HLS ARRAY_PARTITION variable=w.m_weights complete dim=0
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      w.m_weights[pe] = op.wgt((pe+1)*SIMD*WT::width-1, pe*SIMD*WT::width);
+    }
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      auto const  wgt = TWeightI()(w[pe]);
+      for(unsigned  mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+        auto const  act = TSrcI()(op.act, mmv);
+        part.sum[mmv][pe] = mac<HALF>(half? part.sum[mmv][pe] : TAcc(0),
+          detail::LaneOffset<decltype(wgt)>(wgt, half*HALF),
+          detail::LaneOffset<decltype(act)>(act, half*HALF), r, mmv);
+      }
+    }
+    if(++half == 2) {
+      half = 0;
+      sums.write(part);
+    }
+  }
+}
+
+/**
+ * \brief Accumulation and activation of the double-pumped matrix vector activation, fabric clock
+ *
+ * Adds up the dot products of the SF tiles of every folded neuron and applies the activation.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed per fabric cycle
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TAcc       DataType of the dot products - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ *
+ * \param sums        Dot product stream from DoublePumped_Multiply
+ * \param out         Output stream
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV,
+  typename TDstI, typename TO, typename TAcc, typename TA
+>
+void DoublePumped_Accumulate(hls::stream<DoublePumpedSums<TAcc, MMV, PE>> &sums,
+                             hls::stream<TO> &out,
+                             TA const &activation,
+                             int const  reps) {
+  unsigned const  NF = MatrixH / PE;
+  unsigned const  SF = MatrixW / SIMD;
+
+  decltype(activation.init(0,0))  accu[MMV][PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+
+  unsigned  nf = 0;
+  unsigned  sf = 0;
+  for(unsigned  i = 0; i < reps * NF * SF; i++) {
+#pragma HLS pipeline style=flp II=1
+    DoublePumpedSums<TAcc, MMV, PE> const  part = sums.read();
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      for(unsigned  mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+        accu[mmv][pe] = (sf == 0? activation.init(nf, pe) : accu[mmv][pe]) + part.sum[mmv][pe];
+      }
+    }
+    if(++sf == SF) {
+      auto  outElem = TDstI().template operator()<TO>();
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for(unsigned  mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+          outElem(pe,mmv,1) = activation.activate(nf, pe, accu[mmv][pe]);
+        }
+      }
+      out.write(outElem);
+      sf = 0;
+      if(++nf == NF)  nf = 0;
+    }
+  }
+}
+
+/**
+ * \brief Double-pumped matrix vector activate function
+ *
+ * Drop-in replacement for Matrix_Vector_Activate_Batch with FixedPointWeights halving the number of
+ * multipliers. It chains DoublePumped_Fetch, DoublePumped_Multiply and DoublePumped_Accumulate in a
+ * dataflow region. HLS synthesizes a function in a single clock domain, in which the multiply core takes
+ * two cycles per tile. For the throughput of Matrix_Vector_Activate_Batch, the three stages are
+ * synthesized as kernels of their own: the multiply core at twice the fabric clock (e.g. 2.5 ns next to a
+ * 200 MHz design) with registered AXI-Stream ports, the fetch and the accumulation at the fabric clock.
+ * Their operand and dot product streams cross the synchronous clock domains through AXI-Stream clock
+ * converters when the design is integrated.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed per fabric cycle, even
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam WT         DataType of the weights - safely deducible from the paramaters
+ * \tparam TILES      Number of tiles of the weights - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param weights     Weights matrix
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+  typename TI, typename TO, typename WT, unsigned TILES, typename TA, typename R
+>
+void Matrix_Vector_Activate_DoublePumped_Batch(hls::stream<TI> &in,
+				  hls::stream<TO> &out,
+				  FixedPointWeights<SIMD, WT, PE, TILES> const &weights,
+				  TA  const &activation,
+				  int const  reps,
+				  R const &r) {
+#pragma HLS INLINE
+  using TAcc = decltype(activation.init(0,0));
+  hls::stream<DoublePumpedOperands<TI, PE*SIMD*WT::width>>  ops("Matrix_Vector_Activate_DoublePumped_Batch.ops");
+  hls::stream<DoublePumpedSums<TAcc, MMV, PE>>  sums("Matrix_Vector_Activate_DoublePumped_Batch.sums");
+  DoublePumped_Fetch<MatrixW, MatrixH, SIMD, PE>(in, ops, weights, reps);
+  DoublePumped_Multiply<SIMD, PE, MMV, TSrcI, TWeightI, WT, TAcc>(ops, sums, reps * (MatrixH / PE) * (MatrixW / SIMD), r);
+  DoublePumped_Accumulate<MatrixW, MatrixH, SIMD, PE, MMV, TDstI>(sums, out, activation, reps);
+}
+
+
+/**
+ * \brief Matrix vector activate function for sparse weight matrices
+ *
+ * The function performs the multiplication between a sparse weigth matrix and the input activation vector,
+ * accumulating the results and then applying an activation function on the accumulated result.
+ * Only the tiles kept by the SparseFixedPointWeights container are processed so that the number of
+ * cycles per image is in the order of max(MatrixW/SIMD, NZTILES) rather than MatrixH*MatrixW/(SIMD*PE).
+ * The input vector is buffered one word per cycle while the stored tiles are consumed as soon as
+ * the input word they refer to is available.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam WT         DataType of the weights (as used in the MAC) - safely deducible from the paramaters
+ * \tparam NZTILES    Number of stored tiles - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param weights     Sparse weights matrix
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+  typename TI, typename TO, typename WT, unsigned NZTILES, typename TA, typename R
+>
+void Matrix_Vector_Activate_Sparse_Batch(hls::stream<TI> &in,
+				  hls::stream<TO> &out,
+				  SparseFixedPointWeights<SIMD, WT, PE, MatrixW/SIMD, NZTILES>  const &weights,
+				  TA  const &activation,
+				  int const  reps,
+				  R const &r) {
+
+  // how many different rows each neuron will compute
+  // alternatively: number of vertical matrix chunks
+  unsigned const  NF = MatrixH / PE;
+
+  // how many synapse groups each row is split into
+  // alternatively: number of horizontal matrix chunks
+  unsigned const  SF = MatrixW / SIMD;
+  static_assert(NZTILES >= NF, "Every neuron fold must keep at least one tile.");
+  static_assert(NZTILES <= NF*SF, "More tiles stored than in the dense matrix.");
+
+  // input vector buffers
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+
+  decltype(activation.init(0,0))  accu[MMV][PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+
+  unsigned  rep  = 0;
+  unsigned  nf   = 0;
+  unsigned  rd   = 0; // number of input words buffered for the current image
+  unsigned  tile = 0; // next stored tile
+  bool      fresh   = true;  // invariant: tile opens a neuron fold
+  bool      drained = false; // all stored tiles of the current image processed
+
+  // everything merged into a common iteration space, the trip count depends
+  // on how early the stored tiles find their input buffered
+  while(rep < (unsigned)reps) {
+#pragma HLS pipeline style=flp II=1
+    // buffer the input vector independently of the tile consumption
+    if(rd < SF) {
+      inputBuf[rd] = in.read();
+      rd++;
+    }
+
+    unsigned const  sf = weights.synapse(tile);
+    if(!drained && (sf < rd)) {
+      TI const  inElem = inputBuf[sf];
+
+      // Threshold Initialisation
+      if(fresh) {
+        for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          for(unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+            accu[mmv][pe] = activation.init(nf, pe);
+          }
+        }
+      }
+
+      // compute matrix-vector product for each processing element
+      auto const &w = weights.weights(tile);
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        auto const  wgt = TWeightI()(w[pe]);
+        for (unsigned mmv = 0; mmv < MMV; mmv++){
+          auto const  act = TSrcI()(inElem, mmv);
+          accu[mmv][pe] = mac<SIMD>(accu[mmv][pe], wgt, act, r, mmv);
+        }
+      }
+
+      // keep track of which folded neuron we are processing
+      fresh = weights.last(tile);
+      if(fresh) {
+        // produce output and clear accumulators
+        auto  outElem = TDstI().template operator()<TO>();
+        for (unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          for (unsigned mmv = 0; mmv < MMV; mmv++){
+#pragma HLS UNROLL
+            outElem(pe,mmv,1) = activation.activate(nf, pe, accu[mmv][pe]);
+          }
+        }
+        out.write(outElem);
+        nf++;
+      }
+      if(++tile == NZTILES) {
+        tile    = 0;
+        drained = true;
+      }
+    }
+
+    // next image once its input is fully consumed
+    if(drained && (rd == SF)) {
+      nf      = 0;
+      rd      = 0;
+      drained = false;
+      rep++;
+    }
+  }
+}
+
+
+/**
+ * \brief Matrix vector activate function skipping all-zero input words
+ *
+ * The function performs the multiplication between a weigth matrix and an input activation vector
+ * compressed by ZeroRunEncode_Batch in segments of one vector (MatrixW/SIMD words). Only the transmitted
+ * words are processed so that each image takes NF*K cycles with K being the number of its tokens, rather
+ * than NF*SF. This is only correct when zero activations contribute nothing to the accumulation,
+ * i.e. not for binary or bipolar inputs.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam InWidth    Width of an uncompressed input word
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TW         DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input token stream
+ * \param out         Output stream
+ * \param weights     Weights matrix (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+  unsigned InWidth = SIMD*TSrcI::width,
+  typename TO, typename TW, typename TA, typename R
+>
+void Matrix_Vector_Activate_ZeroSkip_Batch(hls::stream<typename ZeroRunToken<InWidth, MatrixW/SIMD>::type> &in,
+				  hls::stream<TO> &out,
+				  TW  const &weights,
+				  TA  const &activation,
+				  int const  reps,
+				  R const &r) {
+
+  // how many different rows each neuron will compute
+  // alternatively: number of vertical matrix chunks
+  unsigned const  NF = MatrixH / PE;
+
+  // how many synapse groups each row is split into
+  // alternatively: number of horizontal matrix chunks
+  unsigned const  SF = MatrixW / SIMD;
+  using Token = ZeroRunToken<InWidth, SF>;
+
+  // buffers of the transmitted input words and their synapse groups
+  ap_uint<InWidth>  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+  unsigned  sfBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=sfBuf complete dim=0
+
+  decltype(activation.init(0,0))  accu[PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+
+  unsigned  rep  = 0;
+  unsigned  nf   = 0;
+  unsigned  base = 0; // invariant: base = nf*SF
+  unsigned  k    = 0; // index of the transmitted word
+  unsigned  cnt  = 0; // number of transmitted words of the current image
+  unsigned  next = 0; // synapse group following the last one read
+
+  // the trip count depends on the number of transmitted words
+  while(rep < (unsigned)reps) {
+#pragma HLS pipeline style=flp II=1
+    ap_uint<InWidth>  inElem;
+    unsigned  sf;
+    bool  last;
+    if(nf == 0) {
+      // read input from stream and store it for reuse
+      typename Token::type const  t = in.read();
+      inElem = Token::data(t);
+      sf     = next + Token::run(t);
+      last   = Token::last(t);
+      next   = sf + 1;
+      inputBuf[k] = inElem;
+      sfBuf[k]    = sf;
+    }
+    else {
+      // reuse buffered input
+      inElem = inputBuf[k];
+      sf     = sfBuf[k];
+      last   = (k+1 == cnt);
+    }
+
+    // Threshold Initialisation
+    if(k == 0) {
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        accu[pe] = activation.init(nf, pe);
+      }
+    }
+
+    // compute matrix-vector product for each processing element
+    auto const &w = weights.weights(base + sf);
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      auto const  wgt = TWeightI()(w[pe]);
+      auto const  act = TSrcI()(inElem, 0);
+      accu[pe] = mac<SIMD>(accu[pe], wgt, act, r, 0);
+    }
+
+    if(last) {
+      // produce output and clear accumulators
+      auto  outElem = TDstI().template operator()<TO>();
+      for (unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        outElem(pe,0,1) = activation.activate(nf, pe, accu[pe]);
+      }
+      out.write(outElem);
+      if(nf == 0)  cnt = k+1;
+      k = 0;
+      // next folded neuron or image
+      base += SF;
+      if(++nf == NF) {
+        nf   = 0;
+        base = 0;
+        next = 0;
+        rep++;
+      }
+    }
+    else {
+      k++;
+    }
+  }
+}
+
+
+/**
+ * \brief Mixed-precision matrix vector activate function
+ *
+ * The function performs the multiplication between a weigth matrix and the input activation vector,
+ * accumulating the results and then applying an activation function on the accumulated result.
+ * The weights are taken from a MixedPrecisionWeights container. The PEs of its high-precision group
+ * compute with the resource r_hi and those of its low-precision group with the resource r_lo, both at
+ * the native width of their weights, e.g. DSPs for the sensitive channels and LUTs for the others.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam WT_HI      DataType of the high-precision weights - safely deducible from the paramaters
+ * \tparam WT_LO      DataType of the low-precision weights - safely deducible from the paramaters
+ * \tparam PE_HI      Number of high-precision PEs - safely deducible from the paramaters
+ * \tparam TILES      Number of tiles of the weights matrix - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R_HI       Datatype for the resource of the MACs of the high-precision PEs - safely deducible from the paramaters
+ * \tparam R_LO       Datatype for the resource of the MACs of the low-precision PEs - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param weights     Mixed-precision weights matrix
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r_hi        Resource type for the hardware implementation of the MACs of the high-precision PEs
+ * \param r_lo        Resource type for the hardware implementation of the MACs of the low-precision PEs
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+  typename TI, typename TO, typename WT_HI, typename WT_LO, unsigned PE_HI, unsigned TILES,
+  typename TA, typename R_HI, typename R_LO
+>
+void Matrix_Vector_Activate_MixedPrecision_Batch(hls::stream<TI> &in,
+				  hls::stream<TO> &out,
+				  MixedPrecisionWeights<SIMD, WT_HI, WT_LO, PE, PE_HI, TILES> const &weights,
+				  TA  const &activation,
+				  int const  reps,
+				  R_HI const &r_hi,
+				  R_LO const &r_lo) {
+
+  // how many different rows each neuron will compute
+  // alternatively: number of vertical matrix chunks
+  unsigned const  NF = MatrixH / PE;
+
+  // how many synapse groups each row is split into
+  // alternatively: number of horizontal matrix chunks
+  unsigned const  SF = MatrixW / SIMD;
+  static_assert(TILES == NF*SF, "Weight container does not match the matrix dimensions.");
+
+  // input vector buffers
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+
+  decltype(activation.init(0,0))  accu[MMV][PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+
+  unsigned  nf   = 0;
+  unsigned  sf   = 0;
+  unsigned  tile = 0; // invariant: tile = nf*SF + sf
+
+  // everything merged into a common iteration space (one "big" loop instead
+  // of smaller nested loops) to get the pipelinening the way we want
+  unsigned const TOTAL_FOLD = NF * SF;
+  for(unsigned  i = 0; i < reps * TOTAL_FOLD; i++) {
+#pragma HLS pipeline style=flp II=1
+    TI  inElem;
+    if(nf == 0) {
+      // read input from stream
+      inElem = in.read();
+      // store in appropriate buffer for reuse
+      inputBuf[sf] = inElem;
+    }
+    else {
+      // reuse buffered input
+      inElem = inputBuf[sf];
+    }
+
+    // Threshold Initialisation
+    if(sf == 0) {
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for(unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+          accu[mmv][pe] = activation.init(nf, pe);
+        }
+      }
+    }
+
+    // compute matrix-vector product for each processing element,
+    // the unrolled PE index selecting its precision group
+    auto const &w = weights.weights(tile);
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      for (unsigned mmv = 0; mmv < MMV; mmv++){
+        auto const  act = TSrcI()(inElem, mmv);
+        if(pe < PE_HI) {
+          auto const  wgt = TWeightI()(w.hi(pe));
+          accu[mmv][pe] = mac<SIMD>(accu[mmv][pe], wgt, act, r_hi, mmv);
+        }
+        else {
+          auto const  wgt = TWeightI()(w.lo(pe));
+          accu[mmv][pe] = mac<SIMD>(accu[mmv][pe], wgt, act, r_lo, mmv);
+        }
+      }
+    }
+
+    // keep track of which folded synapse/neuron we are processing
+    ++tile;
+    if(++sf == SF) {
+      // produce output and clear accumulators
+      auto  outElem = TDstI().template operator()<TO>();
+      for (unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for (unsigned mmv = 0; mmv < MMV; mmv++){
+#pragma HLS UNROLL
+          outElem(pe,mmv,1) = activation.activate(nf, pe, accu[mmv][pe]);
+        }
+      }
+      out.write(outElem);
+      // next folded neuron or image
+      sf = 0;
+      if(++nf == NF) {
+	    nf   = 0;
+	    tile = 0;
+      }
+    }
+  }
+}
+
+
+/**
+ * \brief Matrix vector activate function with runtime-reloadable weights
+ *
+ * The function performs the multiplication between a weigth matrix and the input activation vector,
+ * accumulating the results and then applying an activation function on the accumulated result.
+ * The weights are taken from the active bank of a ReloadableFixedPointWeights container. Words of the
+ * next weight set are accepted from the load stream whenever available, one tile per cycle, and written
+ * into the shadow bank without stalling the computation. The banks are swapped at the first frame boundary
+ * after the shadow bank is complete. Weights words are typically supplied by Mem2Stream_Batch followed by
+ * a StreamingDataWidthConverter_Batch.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam WT         DataType of the weights (as used in the MAC) - safely deducible from the paramaters
+ * \tparam TILES      Number of tiles of the weights matrix - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param load        Stream with the words of the next weight set
+ * \param weights     Double-buffered weights matrix, stateful across calls
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param frameReps   Number of repetitions forming a frame, banks may only be swapped between frames
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+  typename TI, typename TO, typename WT, unsigned TILES, typename TA, typename R
+>
+void Matrix_Vector_Activate_Reload_Batch(hls::stream<TI> &in,
+				  hls::stream<TO> &out,
+				  hls::stream<ap_uint<PE*SIMD*WT::width>> &load,
+				  ReloadableFixedPointWeights<SIMD, WT, PE, TILES> &weights,
+				  TA  const &activation,
+				  int const  reps,
+				  unsigned const  frameReps,
+				  R const &r) {
+  // one memory per bank and PE, so that all PEs read their weights in the same cycle
+#pragma HLS ARRAY_PARTITION variable=weights.m_weights complete dim=1
+#pragma HLS ARRAY_PARTITION variable=weights.m_weights complete dim=2
+  // the MVAU reads the active bank while the load only writes the shadow bank
+#pragma HLS DEPENDENCE variable=weights.m_weights inter false
+
+  // how many different rows each neuron will compute
+  // alternatively: number of vertical matrix chunks
+  unsigned const  NF = MatrixH / PE;
+
+  // how many synapse groups each row is split into
+  // alternatively: number of horizontal matrix chunks
+  unsigned const  SF = MatrixW / SIMD;
+  static_assert(TILES == NF*SF, "Weight container does not match the matrix dimensions.");
+
+  // input vector buffers
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+
+  decltype(activation.init(0,0))  accu[MMV][PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+
+  unsigned  nf   = 0;
+  unsigned  sf   = 0;
+  unsigned  tile = 0; // invariant: tile = nf*SF + sf
+  unsigned  rep  = 0; // repetition within the current frame
+
+  // everything merged into a common iteration space (one "big" loop instead
+  // of smaller nested loops) to get the pipelinening the way we want
+  unsigned const TOTAL_FOLD = NF * SF;
+  for(unsigned  i = 0; i < reps * TOTAL_FOLD; i++) {
+#pragma HLS pipeline style=flp II=1
+    // fill the shadow bank in the background
+    ap_uint<PE*SIMD*WT::width>  wload;
+    if(weights.loading() && load.read_nb(wload)) {
+      weights.load(wload);
+    }
+
+    TI  inElem;
+    if(nf == 0) {
+      // read input from stream
+      inElem = in.read();
+      // store in appropriate buffer for reuse
+      inputBuf[sf] = inElem;
+    }
+    else {
+      // reuse buffered input
+      inElem = inputBuf[sf];
+    }
+
+    // Threshold Initialisation
+    if(sf == 0) {
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for(unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+          accu[mmv][pe] = activation.init(nf, pe);
+        }
+      }
+    }
+
+    // compute matrix-vector product for each processing element
+    auto const &w = weights.weights(tile);
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      auto const  wgt = TWeightI()(w[pe]);
+      for (unsigned mmv = 0; mmv < MMV; mmv++){
+        auto const  act = TSrcI()(inElem, mmv);
+        accu[mmv][pe] = mac<SIMD>(accu[mmv][pe], wgt, act, r, mmv);
+      }
+    }
+
+    // keep track of which folded synapse/neuron we are processing
+    ++tile;
+    if(++sf == SF) {
+      // produce output and clear accumulators
+      auto  outElem = TDstI().template operator()<TO>();
+      for (unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for (unsigned mmv = 0; mmv < MMV; mmv++){
+#pragma HLS UNROLL
+          outElem(pe,mmv,1) = activation.activate(nf, pe, accu[mmv][pe]);
+        }
+      }
+      out.write(outElem);
+      // next folded neuron or image
+      sf = 0;
+      if(++nf == NF) {
+	    nf   = 0;
+	    tile = 0;
+        // switch to the new weights at frame boundaries only
+        if(++rep == frameReps) {
+          rep = 0;
+          weights.swap();
+        }
+      }
+    }
+  }
+}
+
+
+/**
+ * \brief Column split for partial-sum (split-K) matrix vector activation
+ *
+ * Distributes the SF input words of every input vector across NumParts
+ * streams, each of which feeds an MVAU instance covering a contiguous slice
+ * of MatrixW / NumParts columns. Part 0 receives the first slice.
+ *
+ * \tparam SF         Number of input words per vector (MatrixW / SIMD)
+ * \tparam NumParts   Number of MVAU instances the columns are split across
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Array of output streams, one per MVAU instance
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<unsigned SF, unsigned NumParts, typename TI>
+void Matrix_Vector_Split_Batch(hls::stream<TI> &in,
+				  hls::stream<TI> (&out)[NumParts],
+				  int const  reps) {
+  static_assert(SF % NumParts == 0, "Input words must be evenly distributable across parts.");
+  unsigned const  WORDS_PER_PART = SF / NumParts;
+
+  unsigned  part = 0;
+  unsigned  word = 0;
+  for(unsigned  i = 0; i < reps * SF; i++) {
+#pragma HLS pipeline style=flp II=1
+    TI const  inElem = in.read();
+    for(unsigned  p = 0; p < NumParts; p++) {
+#pragma HLS UNROLL
+      if(p == part)  out[p].write(inElem);
+    }
+    if(++word == WORDS_PER_PART) {
+      word = 0;
+      if(++part == NumParts)  part = 0;
+    }
+  }
+}
+
+/**
+ * \brief Partial-sum reduction for split-K matrix vector activation
+ *
+ * Adds up the raw accumulators produced by NumParts MVAU instances, each of
+ * which computes the product over a slice of the matrix columns with a
+ * PassThroughActivation, and applies the activation of the full layer
+ * (e.g. ThresholdsActivation) to the sum. The accumulation is initialised by
+ * the activation exactly as within Matrix_Vector_Activate_Batch.
+ *
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam NumParts   Number of partial sums to be reduced
+ * \tparam TSrcI      DataType of the partial sums
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TI         DataType of the partial-sum streams - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ *
+ * \param in          Array of partial-sum streams, one per MVAU instance
+ * \param out         Output stream
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<
+  unsigned MatrixH, unsigned PE, unsigned MMV, unsigned NumParts,
+  typename TSrcI = Identity, typename TDstI = Identity,
+  typename TI, typename TO, typename TA
+>
+void Matrix_Vector_Reduce_Batch(hls::stream<TI> (&in)[NumParts],
+				  hls::stream<TO> &out,
+				  TA  const &activation,
+				  int const  reps) {
+
+  // how many different rows each neuron will compute
+  unsigned const  NF = MatrixH / PE;
+
+  unsigned  nf = 0;
+  for(unsigned  i = 0; i < reps * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+    TI  inElem[NumParts];
+#pragma HLS ARRAY_PARTITION variable=inElem complete dim=0
+    for(unsigned  p = 0; p < NumParts; p++) {
+#pragma HLS UNROLL
+      inElem[p] = in[p].read();
+    }
+
+    auto  outElem = TDstI().template operator()<TO>();
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      for(unsigned  mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+        auto  accu = activation.init(nf, pe);
+        for(unsigned  p = 0; p < NumParts; p++) {
+#pragma HLS UNROLL
+          accu += TSrcI()(inElem[p], mmv)(pe, mmv);
+        }
+        outElem(pe,mmv,1) = activation.activate(nf, pe, accu);
+      }
+    }
+    out.write(outElem);
+
+    if(++nf == NF)  nf = 0;
+  }
+}
+
 /**
  * \brief Matrix vector activate function with streaming weights
  *
- * The function performs the multiplication between a weigth matrix, presnted as an input stream, and the input activation vector,
- * accumulating the results and then applying an activation function on the accumulated result. Does not support MMV.
+ * The function performs the multiplication between a weigth matrix, presnted as an input stream, and the input activation vector,
+ * accumulating the results and then applying an activation function on the accumulated result.
+ * Each weight word read from the stream is applied to all MMV output pixels processed in parallel.
+ *
+ * 
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam MMV        Number of output pixels computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TW         DataType of the weights (as used in the MAC) - not deducible from the paramaters
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param weight      Weight stream (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MMV,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity, typename TW,
+  typename TI, typename TO, typename TA, typename R
+>
+void Matrix_Vector_Activate_Stream_Batch(hls::stream<TI> &in,
+          hls::stream<TO> &out,
+          hls::stream<ap_uint<PE*SIMD*TW::width>> &weight,
+          TA  const &activation,
+          int const  reps,
+          R const &r) {
+
+  // how many different rows each neuron will compute
+  // alternatively: number of vertical matrix chunks
+  unsigned const  NF = MatrixH / PE;
+
+  // how many synapse groups each row is split into
+  // alternatively: number of horizontal matrix chunks
+  unsigned const  SF = MatrixW / SIMD;
+
+  // input vector buffers
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=1
+  // accumulators
+  decltype(activation.init(0,0))  accu[MMV][PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+  // unpacked and packed buffers for weight stream
+  Weights_Tile<SIMD, TW, PE > w;
+#pragma HLS ARRAY_PARTITION variable=w.m_weights complete dim=0
+  ap_uint<PE * SIMD * TW::width> W_packed;
+
+
+  unsigned  nf   = 0;
+  unsigned  sf   = 0;
+  unsigned  tile = 0; // invariant: tile = nf*SF + sf
+  
+  // everything merged into a common iteration space (one "big" loop instead
+  // of smaller nested loops) to get the pipelinening the way we want
+  unsigned const TOTAL_FOLD = NF * SF;
+  for(unsigned  i = 0; i < reps * TOTAL_FOLD; i++) {
+#pragma HLS pipeline style=flp II=1
+    TI  inElem;
+
+    if(nf == 0) {
+      // read input from stream
+      inElem = in.read();
+      // store in appropriate buffer for reuse
+      inputBuf[sf] = inElem;
+    }
+    else {
+      // reuse buffered input
+      inElem = inputBuf[sf];
+    }
+
+    // read from the parameter stream
+    W_packed = weight.read();
+    for (unsigned pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      w.m_weights[pe] = W_packed((pe+1)*SIMD*TW::width-1,pe*SIMD*TW::width);
+    }
+
+    // Threshold Initialisation
+    if(sf == 0) {
+      for(unsigned pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for(unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+          accu[mmv][pe] = activation.init(nf, pe);
+        }
+      }
+    }
+
+    // compute matrix-vector product for each processing element
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      auto const  wgt = TWeightI()(w[pe]);
+      for(unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+        auto const  act = TSrcI()(inElem, mmv);
+        accu[mmv][pe] = mac<SIMD>(accu[mmv][pe], wgt, act, r, mmv);
+      }
+    }
+
+    // keep track of which folded synapse/neuron we are processing
+    ++tile;
+    if(++sf == SF) {
+      // produce output and clear accumulators
+      auto  outElem = TDstI().template operator()<TO>();
+      for (unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for (unsigned mmv = 0; mmv < MMV; mmv++) {
+#pragma HLS UNROLL
+          outElem(pe,mmv,1) = activation.activate(nf, pe, accu[mmv][pe]);
+        }
+      }
+
+      out.write(outElem);
+
+      // next folded neuron or image
+      sf = 0;
+      if(++nf == NF) {
+      nf   = 0;
+      tile = 0;
+      }
+    }
+  }
+}
+
+/**
+ * \brief Precision-scalable matrix vector activate function with streaming weights
+ *
+ * The function performs the multiplication between a weigth matrix, presented as an input stream, and the input activation vector,
+ * accumulating the results and then applying an activation function on the accumulated result.
+ * The SIMD fused multipliers of every PE compute with the operand width selected at runtime by bits, see mac_fused,
+ * so that every input word carries SIMD*(MaxBits/bits)^2 activations, packed densely from the lsb, and every
+ * weight word as many weights per PE. The effective SIMD and thus the throughput grow quadratically as the
+ * precision drops, e.g. four times for bits = MaxBits/2, allowing models of different precisions on the same hardware.
  *
- * 
- * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixW    Width of the input matrix, a multiple of the effective SIMD of every operand width
  * \tparam MatrixH    Heigth of the input matrix
- * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam SIMD       Number of fused multipliers per PE
  * \tparam PE         Number of output rows computed in parallel
- * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam MaxBits    Operand width of a fused multiplier
+ * \tparam BrickBits  Operand width of the brick multipliers, the narrowest operand width
+ * \tparam SignedW    Whether the weights are signed
+ * \tparam SignedA    Whether the input activations are signed
  * \tparam TDstI      DataType of the output activation (as generated by the activation)
- * \tparam TWeightI   DataType of the weights and how to access them in the array
- * \tparam TW         DataType of the weights (as used in the MAC) - not deducible from the paramaters
- * \tparam TI         DataType of the input stream - safely deducible from the paramaters
  * \tparam TO         DataType of the output stream - safely deducible from the paramaters
  * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
- * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
  *
  * \param in          Input stream
  * \param out         Output stream
- * \param weight      Weight stream (currently supports BinaryWeights or FixedPointWeights)
+ * \param weight      Weight stream, PE words of SIMD fused multipliers each
  * \param activation  Activation class
  * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
- * \param r           Resource type for the hardware implementation of the MAC block
+ * \param bits        Operand width of the weights and the input activations, one of BrickBits*2^i up to MaxBits
  */
 template<
-  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, 
-  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity, typename TW,
-  typename TI, typename TO, typename TA, typename R
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned MaxBits = 8, unsigned BrickBits = 2,
+  bool SignedW = true, bool SignedA = false, typename TDstI = Identity,
+  typename TO, typename TA
 >
-void Matrix_Vector_Activate_Stream_Batch(hls::stream<TI> &in,
+void Matrix_Vector_Activate_Fused_Stream_Batch(hls::stream<ap_uint<SIMD*MaxBits*MaxBits/BrickBits>> &in,
           hls::stream<TO> &out,
-          hls::stream<ap_uint<PE*SIMD*TW::width>> &weight,
+          hls::stream<ap_uint<PE*SIMD*MaxBits*MaxBits/BrickBits>> &weight,
           TA  const &activation,
           int const  reps,
-          R const &r) {
+          unsigned const  bits) {
+
+  unsigned const  Chunks = MaxBits / BrickBits;
+  unsigned const  WordBits = SIMD * MaxBits * Chunks;
+  static_assert(MatrixW % (SIMD * Chunks*Chunks) == 0, "MatrixW must be a multiple of the effective SIMD of every operand width.");
 
   // how many different rows each neuron will compute
   // alternatively: number of vertical matrix chunks
   unsigned const  NF = MatrixH / PE;
 
-  // how many synapse groups each row is split into
-  // alternatively: number of horizontal matrix chunks
-  unsigned const  SF = MatrixW / SIMD;
+  // how many synapse groups each row is split into at the selected width,
+  // MatrixW / SIMD at most for the widest operands
+  unsigned  SF = 0;
+  for(unsigned  m = 0; (BrickBits << m) <= MaxBits; m++) {
+#pragma HLS UNROLL
+    unsigned const  fuse = Chunks >> m;
+    if(bits == (BrickBits << m))  SF = MatrixW / (SIMD * fuse*fuse);
+  }
 
   // input vector buffers
-  TI  inputBuf[SF];
-#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=1
+  ap_uint<WordBits>  inputBuf[MatrixW / SIMD];
   // accumulators
-  decltype(activation.init(0,0))  accu[1][PE];
+  decltype(activation.init(0,0))  accu[PE];
 #pragma HLS ARRAY_PARTITION variable=accu complete dim=0
-  // unpacked and packed buffers for weight stream
-  Weights_Tile<SIMD, TW, PE > w;
-#pragma HLS ARRAY_PARTITION variable=w.m_weights complete dim=0
-  ap_uint<PE * SIMD * TW::width> W_packed;
-
 
   unsigned  nf   = 0;
   unsigned  sf   = 0;
-  unsigned  tile = 0; // invariant: tile = nf*SF + sf
-  
+
   // everything merged into a common iteration space (one "big" loop instead
   // of smaller nested loops) to get the pipelinening the way we want
   unsigned const TOTAL_FOLD = NF * SF;
   for(unsigned  i = 0; i < reps * TOTAL_FOLD; i++) {
 #pragma HLS pipeline style=flp II=1
-    TI  inElem;
+#pragma HLS LOOP_TRIPCOUNT min=NF*MatrixW/(SIMD*Chunks*Chunks) max=NF*MatrixW/SIMD
+    ap_uint<WordBits>  inElem;
 
     if(nf == 0) {
       // read input from stream
@@ -262,49 +1922,354 @@ void Matrix_Vector_Activate_Stream_Batch(hls::stream<TI> &in,
     }
 
     // read from the parameter stream
-    W_packed = weight.read();
-    for (unsigned pe = 0; pe < PE; pe++) {
-#pragma HLS UNROLL
-      w.m_weights[pe] = W_packed((pe+1)*SIMD*TW::width-1,pe*SIMD*TW::width);
-    }
+    ap_uint<PE * WordBits> const  W_packed = weight.read();
 
     // Threshold Initialisation
     if(sf == 0) {
       for(unsigned pe = 0; pe < PE; pe++) {
 #pragma HLS UNROLL
-      accu[0][pe] = activation.init(nf, pe);
+        accu[pe] = activation.init(nf, pe);
       }
     }
 
     // compute matrix-vector product for each processing element
     for(unsigned  pe = 0; pe < PE; pe++) {
 #pragma HLS UNROLL
-      auto const  act = TSrcI()(inElem, 0);
-      auto const  wgt = TWeightI()(w[pe]);
-      //auto const  wgt = w[pe];
-      accu[0][pe] = mac<SIMD>(accu[0][pe], wgt, act, r, 0);
+      ap_uint<WordBits> const  wgt = W_packed((pe+1)*WordBits-1, pe*WordBits);
+      accu[pe] = mac_fused<SIMD, MaxBits, BrickBits, SignedW, SignedA>(accu[pe], wgt, inElem, bits);
     }
 
     // keep track of which folded synapse/neuron we are processing
-    ++tile;
     if(++sf == SF) {
       // produce output and clear accumulators
       auto  outElem = TDstI().template operator()<TO>();
       for (unsigned  pe = 0; pe < PE; pe++) {
 #pragma HLS UNROLL
-      outElem(pe,0,1) = activation.activate(nf, pe, accu[0][pe]);
-          }
+        outElem(pe,0,1) = activation.activate(nf, pe, accu[pe]);
+      }
 
       out.write(outElem);
 
       // next folded neuron or image
       sf = 0;
+      if(++nf == NF)  nf = 0;
+    }
+  }
+}
+
+/**
+ * \brief Weight-stationary matrix vector activate function with streaming weights
+ *
+ * The function performs the multiplication between a weigth matrix, presented as an input stream, and the input activation vector,
+ * accumulating the results and then applying an activation function on the accumulated result.
+ * Up to BATCH input vectors are buffered on chip, so that every weight word read from the stream is applied to all vectors of the
+ * batch before advancing. The weight stream hence needs to provide the weights only once per batch, i.e. ceil(reps/BATCH) times
+ * instead of reps times. The outputs of a batch are buffered and emitted in input order.
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam BATCH      Maximum number of input vectors sharing one pass over the weights
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TW         DataType of the weights (as used in the MAC) - not deducible from the paramaters
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param weight      Weight stream (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE, unsigned BATCH,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity, typename TW,
+  typename TI, typename TO, typename TA, typename R
+>
+void Matrix_Vector_Activate_Stream_Stationary_Batch(hls::stream<TI> &in,
+          hls::stream<TO> &out,
+          hls::stream<ap_uint<PE*SIMD*TW::width>> &weight,
+          TA  const &activation,
+          int const  reps,
+          R const &r) {
+
+  // how many different rows each neuron will compute
+  // alternatively: number of vertical matrix chunks
+  unsigned const  NF = MatrixH / PE;
+
+  // how many synapse groups each row is split into
+  // alternatively: number of horizontal matrix chunks
+  unsigned const  SF = MatrixW / SIMD;
+
+  // buffered input vectors, weights of the current neuron fold and outputs of the batch
+  TI  inputBuf[BATCH][SF];
+  ap_uint<PE * SIMD * TW::width>  weightBuf[SF];
+  TO  outputBuf[BATCH][NF];
+  // accumulators
+  decltype(activation.init(0,0))  accu[PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+  // unpacked buffer for weight stream
+  Weights_Tile<SIMD, TW, PE > w;
+#pragma HLS ARRAY_PARTITION variable=w.m_weights complete dim=0
+
+  for(unsigned  rep = 0; rep < (unsigned)reps; rep += BATCH) {
+    // size of this batch, the last one may be incomplete
+    unsigned const  nb = ((unsigned)reps - rep) < BATCH? (unsigned)reps - rep : BATCH;
+
+    unsigned  nf = 0;
+    unsigned  b  = 0;
+    unsigned  sf = 0;
+    // iterate the weights in the outer loops to reuse every weight word for the whole batch
+    for(unsigned  i = 0; i < nb * NF * SF; i++) {
+#pragma HLS pipeline style=flp II=1
+      TI  inElem;
+      if(nf == 0) {
+        // read input from stream
+        inElem = in.read();
+        // store in appropriate buffer for reuse
+        inputBuf[b][sf] = inElem;
+      }
+      else {
+        // reuse buffered input
+        inElem = inputBuf[b][sf];
+      }
+
+      ap_uint<PE * SIMD * TW::width>  W_packed;
+      if(b == 0) {
+        // read from the parameter stream
+        W_packed = weight.read();
+        weightBuf[sf] = W_packed;
+      }
+      else {
+        // reuse buffered weights
+        W_packed = weightBuf[sf];
+      }
+      for (unsigned pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        w.m_weights[pe] = W_packed((pe+1)*SIMD*TW::width-1,pe*SIMD*TW::width);
+      }
+
+      // Threshold Initialisation
+      if(sf == 0) {
+        for(unsigned pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          accu[pe] = activation.init(nf, pe);
+        }
+      }
+
+      // compute matrix-vector product for each processing element
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        auto const  act = TSrcI()(inElem, 0);
+        auto const  wgt = TWeightI()(w[pe]);
+        accu[pe] = mac<SIMD>(accu[pe], wgt, act, r, 0);
+      }
+
+      // keep track of which folded synapse/neuron/vector we are processing
+      if(++sf == SF) {
+        // produce output and clear accumulators
+        auto  outElem = TDstI().template operator()<TO>();
+        for (unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          outElem(pe,0,1) = activation.activate(nf, pe, accu[pe]);
+        }
+        outputBuf[b][nf] = outElem;
+
+        // next vector of the batch or next folded neuron
+        sf = 0;
+        if(++b == nb) {
+          b = 0;
+          nf++;
+        }
+      }
+    }
+
+    // emit the outputs of the batch in input order
+    nf = 0;
+    b  = 0;
+    for(unsigned  i = 0; i < nb * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+      out.write(outputBuf[b][nf]);
       if(++nf == NF) {
-      nf   = 0;
-      tile = 0;
+        nf = 0;
+        b++;
+      }
+    }
+  }
+}
+
+/**
+ * \brief Matrix matrix activate function with two streamed operands
+ *
+ * The function multiplies NumVectors input vectors per frame with a second operand matrix that is itself computed at run time,
+ * e.g. the keys or values of an attention layer, accumulating the results and then applying an activation function on the
+ * accumulated result. The operand matrix is presented in the same layout as the weight stream of
+ * Matrix_Vector_Activate_Stream_Batch, but only once per frame. It is buffered on chip before the NumVectors input vectors of the
+ * frame are processed with the usual SIMD/PE folding.
+ *
+ * \tparam MatrixW    Width of the operand matrix
+ * \tparam MatrixH    Heigth of the operand matrix
+ * \tparam NumVectors Number of input vectors multiplied with the operand matrix of one frame
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the operand matrix elements and how to access them in the array
+ * \tparam TW         DataType of the operand matrix elements (as used in the MAC) - not deducible from the paramaters
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param operand     Operand matrix stream, MatrixH/PE * MatrixW/SIMD words per frame
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of frames)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned NumVectors, unsigned SIMD, unsigned PE,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity, typename TW,
+  typename TI, typename TO, typename TA, typename R
+>
+void Matrix_Matrix_Activate_Stream_Batch(hls::stream<TI> &in,
+          hls::stream<TO> &out,
+          hls::stream<ap_uint<PE*SIMD*TW::width>> &operand,
+          TA  const &activation,
+          int const  reps,
+          R const &r) {
+
+  // how many different rows each neuron will compute
+  // alternatively: number of vertical matrix chunks
+  unsigned const  NF = MatrixH / PE;
+
+  // how many synapse groups each row is split into
+  // alternatively: number of horizontal matrix chunks
+  unsigned const  SF = MatrixW / SIMD;
+
+  // buffered operand matrix of the current frame and input vector
+  ap_uint<PE * SIMD * TW::width>  operandBuf[NF * SF];
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=1
+  // accumulators
+  decltype(activation.init(0,0))  accu[PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+  // unpacked operand tile
+  Weights_Tile<SIMD, TW, PE > w;
+#pragma HLS ARRAY_PARTITION variable=w.m_weights complete dim=0
+
+  for(unsigned  rep = 0; rep < (unsigned)reps; rep++) {
+    // buffer the operand matrix of this frame
+    for(unsigned  i = 0; i < NF * SF; i++) {
+#pragma HLS pipeline style=flp II=1
+      operandBuf[i] = operand.read();
+    }
+
+    unsigned  nf   = 0;
+    unsigned  sf   = 0;
+    unsigned  tile = 0; // invariant: tile = nf*SF + sf
+    for(unsigned  i = 0; i < NumVectors * NF * SF; i++) {
+#pragma HLS pipeline style=flp II=1
+      TI  inElem;
+      if(nf == 0) {
+        // read input from stream
+        inElem = in.read();
+        // store in appropriate buffer for reuse
+        inputBuf[sf] = inElem;
+      }
+      else {
+        // reuse buffered input
+        inElem = inputBuf[sf];
+      }
+
+      ap_uint<PE * SIMD * TW::width> const  W_packed = operandBuf[tile];
+      for (unsigned pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        w.m_weights[pe] = W_packed((pe+1)*SIMD*TW::width-1,pe*SIMD*TW::width);
+      }
+
+      // Threshold Initialisation
+      if(sf == 0) {
+        for(unsigned pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          accu[pe] = activation.init(nf, pe);
+        }
+      }
+
+      // compute matrix-vector product for each processing element
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        auto const  act = TSrcI()(inElem, 0);
+        auto const  wgt = TWeightI()(w[pe]);
+        accu[pe] = mac<SIMD>(accu[pe], wgt, act, r, 0);
+      }
+
+      // keep track of which folded synapse/neuron we are processing
+      ++tile;
+      if(++sf == SF) {
+        // produce output and clear accumulators
+        auto  outElem = TDstI().template operator()<TO>();
+        for (unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          outElem(pe,0,1) = activation.activate(nf, pe, accu[pe]);
+        }
+        out.write(outElem);
+
+        // next folded neuron or input vector
+        sf = 0;
+        if(++nf == NF) {
+          nf   = 0;
+          tile = 0;
+        }
       }
     }
   }
 }
 
+/**
+ * \brief Matrix vector activate function with streaming weights, processing a single output pixel at a time
+ *
+ * \tparam MatrixW    Width of the input matrix
+ * \tparam MatrixH    Heigth of the input matrix
+ * \tparam SIMD       Number of input columns computed in parallel
+ * \tparam PE         Number of output rows computed in parallel
+ * \tparam TSrcI      DataType of the input activation (as used in the MAC)
+ * \tparam TDstI      DataType of the output activation (as generated by the activation)
+ * \tparam TWeightI   DataType of the weights and how to access them in the array
+ * \tparam TW         DataType of the weights (as used in the MAC) - not deducible from the paramaters
+ * \tparam TI         DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO         DataType of the output stream - safely deducible from the paramaters
+ * \tparam TA         DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in          Input stream
+ * \param out         Output stream
+ * \param weight      Weight stream (currently supports BinaryWeights or FixedPointWeights)
+ * \param activation  Activation class
+ * \param reps        Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity, typename TW,
+  typename TI, typename TO, typename TA, typename R
+>
+void Matrix_Vector_Activate_Stream_Batch(hls::stream<TI> &in,
+          hls::stream<TO> &out,
+          hls::stream<ap_uint<PE*SIMD*TW::width>> &weight,
+          TA  const &activation,
+          int const  reps,
+          R const &r) {
+#pragma HLS INLINE
+  Matrix_Vector_Activate_Stream_Batch<MatrixW, MatrixH, SIMD, PE, 1, TSrcI, TDstI, TWeightI, TW>
+    (in, out, weight, activation, reps, r);
+}
+
 #endif
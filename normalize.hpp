@@ -35,6 +35,7 @@
 #define NORMALIZE_HPP
 
 #include <ap_int.h>
+#include <ap_fixed.h>
 #include <hls_stream.h>
 #include <functional>
 
@@ -81,11 +82,102 @@ void normalize(
 
 } // normalize()
 
+/**
+ * Per-channel coefficients of the default preprocessing function:
+ *
+ *	x -> (x - mean) * scale
+ *
+ * with scale usually being the reciprocal standard deviation of the channel.
+ */
+template<typename  TM, typename  TS>
+struct MeanScale {
+	TM  mean;
+	TS  scale;
+};
+
+namespace detail {
+	struct MeanScaleOp {
+		template<typename  TC, typename  TI>
+		auto operator()(TC const &c, TI const &x) const -> decltype((x - c.mean) * c.scale) {
+#pragma HLS inline
+			return  (x - c.mean) * c.scale;
+		}
+	};
+} // namespace detail
+
+/**
+ * Image preprocessing front end turning a stream of raw pixels into the
+ * input of the first layer in one pass. The pixels of FM_SIZE per frame
+ * arrive as interleaved CHANNELS lanes of WI bits in words of SIMD pixels.
+ * Every pixel is normalized channelwise by g and quantized by assignment to
+ * the output lane type TO, which determines the rounding and saturation.
+ * SWAP reverses the channel order, e.g. turning RGB into BGR.
+ *
+ * As for normalize(), the coefficients are obtained by calling f() CHANNELS
+ * times, in the output channel order. This happens once for all reps frames.
+ *
+ * Type Requirements:
+ *	f: void -> TC
+ *	g: TC x ap_uint<WI> -> TO
+ */
+template<
+	unsigned  FM_SIZE,						// Pixels per Frame
+	unsigned  CHANNELS,						// Channels per Pixel
+	unsigned  SIMD,							// Pixels per Stream Word
+	typename  TO,							// Output Channel Type
+	bool      SWAP = false,					// Reverse Channel Order
+	unsigned  WI = 8,						// Input Channel Precision
+	typename  G = detail::MeanScaleOp,		// Normalization Function
+	typename  F								// Coefficient Function
+>
+void preprocess(
+	hls::stream<ap_uint<SIMD*CHANNELS*WI>> &src,
+	hls::stream<ap_uint<SIMD*CHANNELS*TO::width>> &dst,
+	F &&f,
+	unsigned const  reps = 1,
+	G &&g = G()
+) {
+	static_assert(FM_SIZE % SIMD == 0, "SIMD must divide the frame size");
+	constexpr unsigned  WO = TO::width;
+	constexpr unsigned  FOLD = FM_SIZE / SIMD;
+
+	decltype(f())  coeff_buf[CHANNELS];
+#pragma HLS array_partition variable=coeff_buf complete
+	for(unsigned  c = 0; c < CHANNELS; c++) {
+#pragma HLS pipeline II=1 style=flp
+		coeff_buf[c] = f();
+	}
+
+	for(unsigned  i = 0; i < reps * FOLD; i++) {
+#pragma HLS pipeline II=1 style=flp
+		auto const  x = src.read();
+		ap_uint<SIMD*CHANNELS*WO>  y;
+		for(unsigned  s = 0; s < SIMD; s++) {
+#pragma HLS unroll
+			for(unsigned  c = 0; c < CHANNELS; c++) {
+#pragma HLS unroll
+				unsigned const  ci = SWAP? CHANNELS-1-c : c;
+				ap_uint<WI> const  v = x((s*CHANNELS + ci + 1)*WI-1, (s*CHANNELS + ci)*WI);
+				TO const  w = g(coeff_buf[c], v);
+				y((s*CHANNELS + c + 1)*WO-1, (s*CHANNELS + c)*WO) = w.range(WO-1, 0);
+			}
+		}
+		dst.write(y);
+	}
+
+} // preprocess()
+
 /**
  * Quantized maximum normalization over input vectors of length FM_SIZE
  * into the numeric range of the output type `ap_uint<WO>`:
  *
  *	x_i -> round( NORMAX * x_i / max{x_j | j=0:FM_SIZE} )
+ *
+ * The division is replaced by a multiplication with a reciprocal of the
+ * maximum, which is computed once per vector with enough precision to
+ * reproduce the exactly rounded quotient. Scanning, reciprocal computation
+ * and scaling are dataflow stages with a two-vector buffer, so that the next
+ * of reps vectors streams in while the current one is normalized.
  */
 template<
 	unsigned  FM_SIZE,		// Vector length
@@ -95,33 +187,403 @@ template<
 >
 void max_norm(
 	hls::stream<ap_uint<WI>> &src,
-	hls::stream<ap_uint<WO>> &dst
+	hls::stream<ap_uint<WO>> &dst,
+	unsigned const  reps = 1
 ) {
 	static_assert(clog2(1+NORMAX) <= WO, "Specified normalized maximum exceeds output range");
 	static ap_uint<WO> const  MAX { NORMAX? NORMAX : -1u };
 
+	// Numerators 2*MAX*x have WN bits; a reciprocal with K = WN+WI fractional
+	// bits, rounded up, yields their exact quotients by any max < 2^WI.
+	constexpr unsigned  WN = WO+WI+1;
+	constexpr unsigned  K  = WN+WI;
+
 #pragma HLS dataflow disable_start_propagation
 	hls::stream<ap_uint<WI>>  buffer;
-#pragma HLS stream variable=buffer depth=FM_SIZE
+#pragma HLS stream variable=buffer depth=2*FM_SIZE
+	hls::stream<ap_uint<WI>>  maxs;
+#pragma HLS stream variable=maxs depth=2
+	hls::stream<ap_uint<K+1>>  rcps;
+#pragma HLS stream variable=rcps depth=2
 
 	// Buffer input and scan it for the maximum
 	ap_uint<WI>  max = 1;	// Prevent division by zero
-	for(unsigned  i = 0; i < FM_SIZE; i++) {
+	unsigned  i = 0;
+	for(unsigned  j = 0; j < reps * FM_SIZE; j++) {
 #pragma HLS pipeline II=1 style=flp
 		auto const  x = src.read();
-		max = std::max(max, x);
+		max = std::max(i == 0? ap_uint<WI>(1) : max, x);
 		buffer.write(x);
+		if(++i == FM_SIZE) {
+			i = 0;
+			maxs.write(max);
+		}
+	}
+
+	// Reciprocal ceil(2^K / max), one division per vector
+	for(unsigned  r = 0; r < reps; r++) {
+		ap_uint<WI> const  m = maxs.read();
+		ap_uint<K+1> const  rcp = ((ap_uint<K+1>(1) << K) + m - 1) / m;
+		rcps.write(rcp);
 	}
 
 	// Replay buffer normalizing all values
-	for(unsigned  i = 0; i < FM_SIZE; i++) {
+	ap_uint<K+1>  rcp;
+	i = 0;
+	for(unsigned  j = 0; j < reps * FM_SIZE; j++) {
 #pragma HLS pipeline II=1 style=flp
+		if(i == 0)  rcp = rcps.read();
 		ap_uint<WO+WI>   const  a = MAX * buffer.read();
-		ap_uint<WO+WI+1> const  b = (a, ap_uint<1>(0));	// div with one fractional binary digit for rounding
-		ap_uint<WO+1>    const  q = b / max;
+		ap_uint<WN>      const  b = (a, ap_uint<1>(0));	// quotient with one fractional binary digit for rounding
+		ap_uint<WN+K+1>  const  p = b * rcp;
+		ap_uint<WO+1>    const  q = p >> K;
 		dst.write(q(WO, 1) + q[0]);
+		if(++i == FM_SIZE)  i = 0;
 	}
 
 } // max_norm()
 
+namespace detail {
+	/**
+	 * Compile-time evaluation of exp(-t) for t >= 0 by argument halving,
+	 * a truncated Taylor series and repeated squaring.
+	 */
+	constexpr double  exp_neg(double  t) {
+		unsigned  n = 0;
+		while(t > 1.0/16) {
+			t /= 2;
+			n++;
+		}
+		double  term = 1.0;
+		double  res  = 1.0;
+		for(unsigned  k = 1; k < 12; k++) {
+			term *= -t / k;
+			res  += term;
+		}
+		while(n-- > 0)  res *= res;
+		return  res;
+	}
+
+	/**
+	 * Table of round(2^WE * exp(-d / 2^FRAC)) for d = 0:N-1.
+	 */
+	template<unsigned  N, unsigned  WE, unsigned  FRAC>
+	class SoftmaxExpTable {
+		static_assert(WE < 32, "Exponent precision exceeds table entry width");
+	public:
+		unsigned  tab[N];
+	public:
+		constexpr SoftmaxExpTable() : tab() {
+			for(unsigned  d = 0; d < N; d++) {
+				tab[d] = unsigned(double(1u<<WE) * exp_neg(double(d) / (1u<<FRAC)) + 0.5);
+			}
+		}
+	};
+
+	/**
+	 * Compile-time evaluation of sqrt(x) for x > 0 by Newton iteration.
+	 */
+	constexpr double  sqrt_pos(double  x) {
+		double  r = x < 1? 1 : x;
+		for(unsigned  k = 0; k < 64; k++)  r = (r + x/r) / 2;
+		return  r;
+	}
+
+	/**
+	 * Table of round(2^RF / sqrt(m)) for the mantissas m in [1, 4) selected
+	 * by the LB leading bits j of m, evaluated at the center of each interval.
+	 */
+	template<unsigned  LB, unsigned  RF>
+	class RsqrtTable {
+		static_assert(RF < 31, "Reciprocal precision exceeds table entry width");
+	public:
+		unsigned  tab[1u<<LB];
+	public:
+		constexpr RsqrtTable() : tab() {
+			for(unsigned  j = 1u<<(LB-2); j < (1u<<LB); j++) {
+				tab[j] = unsigned(double(1u<<RF) / sqrt_pos((j + 0.5) / (1u<<(LB-2))) + 0.5);
+			}
+		}
+	};
+} // namespace detail
+
+/**
+ * Quantized softmax over input vectors of length FM_SIZE, which are streamed
+ * in words of PE lanes. The input lanes x_i of type TI are interpreted as
+ * fixed-point values x_i/2^FRAC. The probabilities are scaled into the
+ * numeric range of the output type `ap_uint<WO>`:
+ *
+ *	x_i -> round( NORMAX * exp(x_i - max) / sum{exp(x_j - max) | j=0:FM_SIZE} )
+ *
+ * The first pass determines the maximum, the second one looks up
+ * exp(x_i - max) with a precision of WE fractional bits in a table and
+ * accumulates their sum, and the third one scales the exponents by the
+ * reciprocal of this sum. Only one division is performed per vector.
+ */
+template<
+	unsigned  FM_SIZE,		// Vector length
+	unsigned  PE,			// Vector elements per stream word
+	unsigned  FRAC,			// Fractional bits of the input
+	unsigned  WE,			// Fractional bits of the exponent table
+	typename  TI,			// Input Element Type: ap_int<WI> or ap_uint<WI>
+	unsigned  WO,			// Output Precision
+	unsigned  NORMAX = 0	// Value of normalized maximum: 0 -> 2^WO-1
+>
+void softmax(
+	hls::stream<ap_uint<PE * TI::width>> &src,
+	hls::stream<ap_uint<PE * WO>> &dst
+) {
+	static_assert(FM_SIZE % PE == 0, "PE must divide the vector length");
+	static_assert(clog2(1+NORMAX) <= WO, "Specified normalized maximum exceeds output range");
+	constexpr unsigned  WI = TI::width;
+	constexpr unsigned  FOLD = FM_SIZE / PE;
+
+	// Distances beyond the table map to exponents rounding to zero
+	constexpr unsigned  DMAX = unsigned((WE+1) * 0.6931471805599453 * (1u<<FRAC)) + 2;
+	constexpr unsigned  N = (WI < 32) && ((1uL<<WI) < DMAX)? (1u<<WI) : DMAX;
+	static constexpr detail::SoftmaxExpTable<N, WE, FRAC>  EXP {};
+
+	constexpr unsigned  WS = WE+1 + clog2(FM_SIZE);	// Width of exponent sum
+	constexpr unsigned  K  = WE+2;					// Fractional bits of reciprocal
+	static ap_uint<WO> const  MAX { NORMAX? NORMAX : -1u };
+
+#pragma HLS dataflow disable_start_propagation
+	hls::stream<ap_uint<PE * WI>>  buffer;
+#pragma HLS stream variable=buffer depth=FOLD
+	hls::stream<ap_uint<PE * (WE+1)>>  exps;
+#pragma HLS stream variable=exps depth=FOLD
+
+	// Pass 1: Buffer input and scan it for the maximum
+	TI  max;
+	for(unsigned  i = 0; i < FOLD; i++) {
+#pragma HLS pipeline II=1 style=flp
+		auto const  x = src.read();
+		for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+			TI const  v = x((pe+1)*WI-1, pe*WI);
+			if(((i == 0) && (pe == 0)) || (v > max))  max = v;
+		}
+		buffer.write(x);
+	}
+
+	// Pass 2: Look up exp(x - max) and accumulate
+	ap_uint<WS>  sum = 0;
+	for(unsigned  i = 0; i < FOLD; i++) {
+#pragma HLS pipeline II=1 style=flp
+		auto const  x = buffer.read();
+		ap_uint<PE * (WE+1)>  e;
+		ap_uint<WS>  part = 0;
+		for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+			TI const  v = x((pe+1)*WI-1, pe*WI);
+			ap_uint<WI> const  d = max - v;
+			ap_uint<WE+1> const  ev = d < N? EXP.tab[d] : 0;
+			e((pe+1)*(WE+1)-1, pe*(WE+1)) = ev;
+			part += ev;
+		}
+		sum += part;
+		exps.write(e);
+	}
+
+	// Pass 3: Scale by the reciprocal of the sum, which is at least 2^WE
+	ap_uint<WO+K+WS> const  num = ap_uint<WO+K+WS>(MAX) << K;
+	ap_uint<WO+2> const  rcp = (num + sum/2) / sum;
+	for(unsigned  i = 0; i < FOLD; i++) {
+#pragma HLS pipeline II=1 style=flp
+		auto const  e = exps.read();
+		ap_uint<PE * WO>  y;
+		for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+			ap_uint<WE+1> const  ev = e((pe+1)*(WE+1)-1, pe*(WE+1));
+			ap_uint<WE+1+WO+2> const  p = ev * rcp;
+			y((pe+1)*WO-1, pe*WO) = (p + (ap_uint<WE+1+WO+2>(1) << (K-1))) >> K;
+		}
+		dst.write(y);
+	}
+
+} // softmax()
+
+
+/**
+ * Fixed-point reciprocal square root of a positive integer d:
+ *
+ *	1/sqrt(d) ~ y * 2^-(RF+e)
+ *
+ * d is normalized by an even shift into a mantissa in [1, 4) whose LB
+ * leading bits select an initial estimate from a table, which is refined
+ * by one Newton step.
+ */
+template<
+	unsigned  RF,	// Fractional bits of the result
+	unsigned  LB,	// Index bits of the initial estimate table
+	int  WD			// Width of the argument
+>
+void rsqrt_fixed(ap_uint<WD> const &d, ap_uint<RF+1> &y, unsigned &e) {
+#pragma HLS inline
+	static_assert(LB >= 3, "Table needs at least one mantissa fraction bit");
+	static_assert(RF >= LB-2, "Result precision below table precision");
+	static constexpr detail::RsqrtTable<LB, RF>  RSQRT {};
+
+	// Even shift normalizing d into [1, 4)
+	unsigned  msb = 0;
+	for(unsigned  b = 0; b < WD; b++) {
+#pragma HLS unroll
+		if(d[b])  msb = b;
+	}
+	unsigned const  sh = msb & ~1u;
+	e = sh / 2;
+
+	// Mantissa with RF fractional bits
+	ap_uint<RF+2> const  m = (ap_uint<WD+RF>(d) << RF) >> sh;
+
+	// Table estimate and Newton step y1 = y0 * (3 - m*y0^2) / 2
+	ap_uint<RF+1> const  y0 = RSQRT.tab[unsigned(m >> (RF-(LB-2)))];
+	ap_uint<RF+2> const  t  = (ap_uint<2*RF+2>(y0) * y0) >> RF;
+	ap_uint<RF+3> const  u  = (ap_uint<2*RF+4>(m) * t) >> RF;
+	ap_uint<RF+3> const  v  = (ap_uint<RF+3>(3) << RF) - u;
+	ap_uint<2*RF+4> const  p = ap_uint<2*RF+4>(y0) * v;
+	ap_uint<2*RF+4> const  y1 = p >> (RF+1);
+	y = y1 > (1u<<RF)? ap_uint<RF+1>(1u<<RF) : ap_uint<RF+1>(y1);
+}
+
+/**
+ * Per-vector layer normalization over input vectors of length N, which are
+ * streamed in words of PE lanes:
+ *
+ *	x_i -> gamma_i * (x_i - mean) / sqrt(var + EPS) + beta_i
+ *
+ * Mean and variance are derived from adder trees over the PE lanes into
+ * exact integer sums. Their combination N^2 * (var + EPS) is turned into a
+ * fixed-point reciprocal square root by rsqrt_fixed(). The normalized value
+ * is formed with ZF fractional bits before the affine transformation using
+ * gamma and beta, whose result is assigned to the output lane type TO,
+ * which determines the final rounding and saturation. The affine
+ * parameters follow the [PE][N/PE] layout of ChannelWiseOperation.
+ *
+ * The statistics, reciprocal square root and normalization stages form a
+ * dataflow pipeline whose buffer holds two vectors so that vector i+1 is
+ * buffered while vector i is normalized.
+ */
+template<
+	unsigned  N,			// Vector length
+	unsigned  PE,			// Vector elements per stream word
+	unsigned  ZF,			// Fractional bits of the normalized value
+	typename  TI,			// Input Element Type: ap_int<WI> or ap_uint<WI>
+	typename  TO,			// Output Element Type
+	unsigned  EPS = 1,		// Variance offset in units of the squared input LSB, at least 1
+	unsigned  RF = ZF+4,	// Fractional bits of the reciprocal square root
+	unsigned  LB = 6,		// Index bits of the reciprocal square root table
+	typename  TG,			// Scale Type
+	typename  TB			// Offset Type
+>
+void LayerNorm_Batch(
+	hls::stream<ap_uint<PE * TI::width>> &src,
+	hls::stream<ap_uint<PE * TO::width>> &dst,
+	TG const (&gamma)[PE][N/PE],
+	TB const (&beta)[PE][N/PE],
+	unsigned const  reps
+) {
+	static_assert(N % PE == 0, "PE must divide the vector length");
+	static_assert(EPS > 0, "Variance offset must be positive");
+	static_assert(ZF <= RF, "Normalized value precision exceeds reciprocal precision");
+	constexpr unsigned  WI = TI::width;
+	constexpr unsigned  WO = TO::width;
+	constexpr unsigned  FOLD = N / PE;
+	constexpr unsigned  WN = clog2(N+1);
+
+	constexpr unsigned  WS1 = WI + WN + 1;			// Signed input sum
+	constexpr unsigned  WS2 = 2*WI + WN;			// Sum of squares
+	constexpr unsigned  WD  = 2*WI + 2*WN + 1;		// N^2 * (var + EPS)
+	constexpr unsigned  WZ  = ZF + (WN+1)/2 + 2;	// |z| <= sqrt(N)
+	using  TZ = ap_fixed<WZ, WZ-ZF>;
+
+#pragma HLS dataflow disable_start_propagation
+	hls::stream<ap_uint<PE * WI>>  buffer;
+#pragma HLS stream variable=buffer depth=2*FOLD
+	hls::stream<ap_int<WS1>>  sums;
+#pragma HLS stream variable=sums depth=4
+	hls::stream<ap_uint<WD>>  dists;
+	hls::stream<ap_int<WS1>>  means;
+#pragma HLS stream variable=means depth=4
+	hls::stream<ap_uint<RF+1>>  rcps;
+	hls::stream<unsigned>  exps;
+
+	// Buffer vectors and accumulate their statistics
+	{
+		ap_int<WS1>   s1 = 0;
+		ap_uint<WS2>  s2 = 0;
+		unsigned  f = 0;
+		for(unsigned  i = 0; i < reps * FOLD; i++) {
+#pragma HLS pipeline II=1 style=flp
+			auto const  x = src.read();
+			ap_int<WS1>   p1 = 0;
+			ap_uint<WS2>  p2 = 0;
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+				TI const  v = x((pe+1)*WI-1, pe*WI);
+				p1 += v;
+				p2 += v*v;
+			}
+			buffer.write(x);
+			if(f == 0) {
+				s1 = p1;
+				s2 = p2;
+			}
+			else {
+				s1 += p1;
+				s2 += p2;
+			}
+			if(++f == FOLD) {
+				f = 0;
+				ap_int<WD+1> const  d = ap_int<WD+1>(N) * s2 - ap_int<WD+1>(s1) * s1 + ap_int<WD+1>(N*N) * EPS;
+				sums.write(s1);
+				dists.write(d);
+			}
+		}
+	}
+
+	// Reciprocal square root once per vector
+	for(unsigned  r = 0; r < reps; r++) {
+#pragma HLS pipeline II=1 style=flp
+		ap_uint<RF+1>  y;
+		unsigned  e;
+		rsqrt_fixed<RF, LB>(dists.read(), y, e);
+		means.write(sums.read());
+		rcps.write(y);
+		exps.write(e);
+	}
+
+	// Normalize and apply the affine transformation
+	{
+		ap_int<WS1>    s1;
+		ap_uint<RF+1>  y;
+		unsigned  sh;
+		unsigned  nf = 0;
+		for(unsigned  i = 0; i < reps * FOLD; i++) {
+#pragma HLS pipeline II=1 style=flp
+			if(nf == 0) {
+				s1 = means.read();
+				y  = rcps.read();
+				sh = RF - ZF + exps.read();
+			}
+			auto const  x = buffer.read();
+			ap_uint<PE * WO>  o;
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+				TI const  v = x((pe+1)*WI-1, pe*WI);
+				ap_int<WS1+1> const  c = ap_int<WS1+1>(N) * v - s1;
+				ap_int<WS1+RF+3> const  p = c * y;
+				ap_int<WS1+RF+3> const  q = sh == 0? p : ap_int<WS1+RF+3>((p + (ap_int<WS1+RF+3>(1) << (sh-1))) >> sh);
+				TZ  z;
+				z.range(WZ-1, 0) = q(WZ-1, 0);
+				TO const  w = gamma[pe][nf] * z + beta[pe][nf];
+				o((pe+1)*WO-1, pe*WO) = w.range(WO-1, 0);
+			}
+			dst.write(o);
+			if(++nf == FOLD)  nf = 0;
+		}
+	}
+
+} // LayerNorm_Batch()
+
 #endif
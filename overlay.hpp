@@ -0,0 +1,471 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+/*******************************************************************************
+ *
+ *  \file overlay.hpp
+ *
+ *  Library of templated HLS functions for BNN deployment.
+ *  This file lists the blocks of the layer-sequential overlay, which runs a
+ *  whole network layer by layer on a single runtime-parameterized engine
+ *  instead of one dedicated instance per layer.
+ *
+ *  The network is described by a table of OverlayLayer descriptors. The
+ *  weights of all layers and the intermediate feature maps reside in
+ *  external memory, the feature maps in HWC order with SIMD channels per
+ *  word. Every descriptor is executed as one dataflow region, which reads and
+ *  zero-pads its input feature map, generates the sliding windows, computes
+ *  them on on-chip weights and requantizes and writes the output feature map.
+ *  The weights of layer i are taken from one of two on-chip banks while the
+ *  weights of layer i+1 are prefetched into the other one.
+ *
+ *  The on-chip weights of a descriptor are bounded by MaxTiles. Larger layers
+ *  are split by the host into several descriptors computing consecutive
+ *  slices of the output channels from the same input.
+ *
+ *******************************************************************************/
+
+#ifndef OVERLAY_HPP
+#define OVERLAY_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include <algorithm>
+
+#include "utils.hpp"
+#include "interpret.hpp"
+#include "mac.hpp"
+#include "weights.hpp"
+
+/**
+ * \brief   Descriptor of one layer, or one slice of the output channels of a layer, executed by the overlay
+ *
+ * The layer computes a square convolution of a square input feature map, a fully connected layer being a
+ * convolution of a 1x1 feature map. The accumulated results are shifted right by shift, clipped to zero if
+ * relu is set and saturated to the range of the activation type.
+ *
+ * All offsets count memory words: weight words of PE*SIMD weights for wgt_ofs and activation words of SIMD
+ * channels for src_ofs and dst_ofs. The frames of a batch follow each other in memory, the output of a
+ * descriptor fills the channels dst_base to dst_base + ofm_ch of a feature map of dst_ch channels.
+ */
+struct OverlayLayer {
+  unsigned  ifm_dim;   // Width and height of the input feature map
+  unsigned  ifm_ch;    // Number of input channels, a multiple of SIMD
+  unsigned  ofm_ch;    // Number of output channels computed, a multiple of SIMD and PE
+  unsigned  kernel;    // Kernel dimension
+  unsigned  stride;    // Stride of the kernel
+  unsigned  pad;       // Zero padding on every side of the input feature map
+  unsigned  shift;     // Requantization shift
+  unsigned  relu;      // Non-zero to clip negative results to zero
+  unsigned  wgt_ofs;   // First weight word
+  unsigned  src_ofs;   // First word of the input feature map
+  unsigned  dst_ofs;   // First word of the output feature map
+  unsigned  dst_ch;    // Number of channels of the output feature map
+  unsigned  dst_base;  // First output channel computed, a multiple of SIMD
+
+  unsigned padded_dim() const {
+#pragma HLS inline
+    return  ifm_dim + 2*pad;
+  }
+  unsigned ofm_dim() const {
+#pragma HLS inline
+    return  (padded_dim() - kernel) / stride + 1;
+  }
+  unsigned matrix_w() const {
+#pragma HLS inline
+    return  kernel * kernel * ifm_ch;
+  }
+  template<unsigned SIMD, unsigned PE>
+  unsigned tiles() const {
+#pragma HLS inline
+    return  (matrix_w() / SIMD) * (ofm_ch / PE);
+  }
+};
+
+namespace detail {
+
+  /**
+   * Saturation bounds of the activation type of the overlay.
+   */
+  template<typename T>
+  struct OverlayRange {};
+  template<int W>
+  struct OverlayRange<ap_uint<W>> {
+    static constexpr long long  min = 0;
+    static constexpr long long  max = (1LL << W) - 1;
+  };
+  template<int W>
+  struct OverlayRange<ap_int<W>> {
+    static constexpr long long  min = -(1LL << (W-1));
+    static constexpr long long  max = (1LL << (W-1)) - 1;
+  };
+
+  /**
+   * Copies the weights of one descriptor into an on-chip bank, nothing if load is false.
+   */
+  template<unsigned MaxTiles, int WordWidth>
+  void overlay_load(ap_uint<WordWidth> const *weights, unsigned const  ofs, unsigned const  tiles, bool const  load,
+                    ap_uint<WordWidth> (&bank)[MaxTiles]) {
+    unsigned const  n = load? tiles : 0;
+    for(unsigned  i = 0; i < n; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS loop_tripcount max=MaxTiles
+      bank[i] = weights[ofs + i];
+    }
+  }
+
+  /**
+   * Reads the input feature maps of a descriptor and inserts the zero padding.
+   */
+  template<unsigned SIMD, typename TI>
+  void overlay_read(ap_uint<SIMD*TI::width> const *src, hls::stream<ap_uint<SIMD*TI::width>> &out,
+                    OverlayLayer const &l, unsigned const  numReps) {
+    unsigned const  CF = l.ifm_ch / SIMD;
+    unsigned const  P  = l.padded_dim();
+    unsigned  x = 0, y = 0, c = 0;
+    unsigned  addr = l.src_ofs;
+    for(unsigned  i = 0; i < numReps * P * P * CF; i++) {
+#pragma HLS pipeline style=flp II=1
+      bool const  inside = (x >= l.pad) && (x < l.pad + l.ifm_dim) && (y >= l.pad) && (y < l.pad + l.ifm_dim);
+      ap_uint<SIMD*TI::width>  word = 0;
+      if(inside) {
+        word = src[addr++];
+      }
+      out.write(word);
+      if(++c == CF) {
+        c = 0;
+        if(++x == P) {
+          x = 0;
+          if(++y == P) {
+            y = 0;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Sliding window generator of ConvolutionInputGenerator_Dynamic with the kernel dimension and the
+   * number of channels also given at runtime.
+   */
+  template<unsigned MaxIFMDim, unsigned MaxIFMCh, unsigned MaxK, unsigned MaxStride, unsigned SIMD, typename TI>
+  void overlay_swg(hls::stream<ap_uint<SIMD*TI::width>> &in, hls::stream<ap_uint<SIMD*TI::width>> &out,
+                   OverlayLayer const &l, unsigned const  numReps) {
+    static_assert(MaxIFMCh % SIMD == 0, "SIMD must divide MaxIFMCh.");
+    unsigned const  number_rows = MaxK + MaxStride;
+    unsigned const  row_pitch = MaxIFMDim * (MaxIFMCh / SIMD);
+    ap_uint<SIMD*TI::width>  inputBuf[number_rows * row_pitch];
+
+    unsigned const  K   = l.kernel;
+    unsigned const  S   = l.stride;
+    unsigned const  CF  = l.ifm_ch / SIMD;
+    unsigned const  P   = l.padded_dim();
+    unsigned const  OFM = l.ofm_dim();
+    unsigned const  words_row = P * CF;
+    unsigned const  cycles_write_row = OFM * K * K * CF;
+    unsigned const  rows_last = P - K - (OFM-1) * S; // trailing rows not covered by a window
+    unsigned const  cycles_read_row  = S * words_row;
+    unsigned const  cycles_read_last = rows_last * words_row;
+    unsigned const  baseIter = K * words_row // Initial buffer
+                             + (OFM-1) * std::max(cycles_write_row, cycles_read_row)
+                             + std::max(cycles_write_row, cycles_read_last);
+
+    for(unsigned  count_image = 0; count_image < numReps; count_image++) {
+      unsigned  wr_row = 0, wr_pos = 0;     // buffer write position
+      unsigned  top_row = 0;                // buffer row of the topmost window row
+      unsigned  inp = 0;                    // words of the initial buffer read
+      unsigned  written = 0, read = 0;      // words emitted and read for the current output row
+      unsigned  reads = (OFM == 1)? cycles_read_last : cycles_read_row;
+      unsigned  ofm_y = 0, ofm_x = 0, base_x = 0, k_y = 0, k_x = 0, count_simd = 0;
+      for(unsigned  i = 0; i < baseIter; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=inputBuf inter false
+#pragma HLS DEPENDENCE variable=inputBuf intra false
+        bool  do_read = false;
+        if(inp < K * words_row) { // Initial buffer of K lines
+          do_read = true;
+          inp++;
+        }
+        else {
+          if(written < cycles_write_row) { // We are writing output
+            unsigned  current_row = top_row + k_y;
+            if(current_row >= number_rows) {
+              current_row -= number_rows;
+            }
+            out.write(inputBuf[current_row * row_pitch + (base_x + k_x) * CF + count_simd]);
+            written++;
+            if(++count_simd == CF) {
+              count_simd = 0;
+              if(++k_x == K) {
+                k_x = 0;
+                if(++k_y == K) {
+                  k_y = 0;
+                  base_x += S;
+                  if(++ofm_x == OFM) {
+                    ofm_x = 0;
+                    base_x = 0;
+                  }
+                }
+              }
+            }
+          }
+          if(read < reads) { // In parallel we fill the rows outside of the current window
+            do_read = true;
+            read++;
+          }
+          if((written == cycles_write_row) && (read == reads)) { // next output row
+            written = 0;
+            read = 0;
+            ofm_y++;
+            reads = (ofm_y == OFM-1)? cycles_read_last : cycles_read_row;
+            top_row += S;
+            if(top_row >= number_rows) {
+              top_row -= number_rows;
+            }
+          }
+        }
+        if(do_read) {
+          inputBuf[wr_row * row_pitch + wr_pos] = in.read();
+          if(++wr_pos == words_row) {
+            wr_pos = 0;
+            if(++wr_row == number_rows) {
+              wr_row = 0;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Matrix vector unit of the overlay with the matrix dimensions given at runtime. The weights are read
+   * from an on-chip bank in the tile order of Matrix_Vector_Activate_Batch.
+   */
+  template<
+    unsigned MaxMatrixW, unsigned MaxTiles, unsigned SIMD, unsigned PE, unsigned AccBits,
+    typename TI, typename TW, typename R
+  >
+  void overlay_mvau(hls::stream<ap_uint<SIMD*TI::width>> &in, hls::stream<ap_uint<PE*TI::width>> &out,
+                    ap_uint<PE*SIMD*TW::width> const (&bank)[MaxTiles], OverlayLayer const &l,
+                    unsigned const  numReps, R const &r) {
+    unsigned const  SF = l.matrix_w() / SIMD;
+    unsigned const  NF = l.ofm_ch / PE;
+    unsigned const  OFM = l.ofm_dim();
+    constexpr long long  min = OverlayRange<TI>::min;
+    long long const  lo = l.relu? std::max(0LL, min) : min;
+    long long const  hi = OverlayRange<TI>::max;
+
+    ap_uint<SIMD*TI::width>  inputBuf[MaxMatrixW / SIMD];
+    ap_int<AccBits>  accu[PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=1
+    Weights_Tile<SIMD, TW, PE>  w;
+#pragma HLS ARRAY_PARTITION variable=w.m_weights complete dim=0
+
+    unsigned  nf   = 0;
+    unsigned  sf   = 0;
+    unsigned  tile = 0; // invariant: tile = nf*SF + sf
+    for(unsigned  i = 0; i < numReps * OFM * OFM * NF * SF; i++) {
+#pragma HLS pipeline style=flp II=1
+      ap_uint<SIMD*TI::width>  inElem;
+      if(nf == 0) {
+        inElem = in.read();
+        inputBuf[sf] = inElem;
+      }
+      else {
+        inElem = inputBuf[sf];
+      }
+
+      ap_uint<PE*SIMD*TW::width> const  W_packed = bank[tile];
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        w.m_weights[pe] = W_packed((pe+1)*SIMD*TW::width-1, pe*SIMD*TW::width);
+      }
+      if(sf == 0) {
+        for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          accu[pe] = 0;
+        }
+      }
+      auto const  act = Slice<TI>()(inElem, 0);
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        accu[pe] = mac<SIMD>(accu[pe], w[pe], act, r, 0);
+      }
+
+      ++tile;
+      if(++sf == SF) {
+        ap_uint<PE*TI::width>  outElem;
+        for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+          ap_int<AccBits> const  shifted = accu[pe] >> l.shift;
+          long long const  v = shifted < lo? lo : shifted > hi? hi : (long long)shifted;
+          outElem((pe+1)*TI::width-1, pe*TI::width) = ap_uint<TI::width>(TI(v));
+        }
+        out.write(outElem);
+        sf = 0;
+        if(++nf == NF) {
+          nf   = 0;
+          tile = 0;
+        }
+      }
+    }
+  }
+
+  /**
+   * Regroups the PE channels of the output words into words of SIMD channels and writes them to their
+   * channel slice of the output feature maps.
+   */
+  template<unsigned SIMD, unsigned PE, typename TI>
+  void overlay_write(hls::stream<ap_uint<PE*TI::width>> &in, ap_uint<SIMD*TI::width> *dst,
+                     OverlayLayer const &l, unsigned const  numReps) {
+    constexpr unsigned  G = SIMD < PE? SIMD : PE;
+    constexpr unsigned  W = TI::width;
+    static_assert((SIMD % PE == 0) || (PE % SIMD == 0), "SIMD and PE must divide one another.");
+    unsigned const  OFM = l.ofm_dim();
+    unsigned const  CF  = l.ofm_ch / SIMD;
+    unsigned const  skip = l.dst_ch / SIMD - CF; // words of the other channel slices of a pixel
+
+    ap_uint<PE*W>    ibuf = 0;
+    ap_uint<SIMD*W>  obuf = 0;
+    unsigned  ilanes = 0, olanes = 0, c = 0;
+    unsigned  addr = l.dst_ofs + l.dst_base / SIMD;
+    for(unsigned  i = 0; i < numReps * OFM * OFM * (l.ofm_ch / G); i++) {
+#pragma HLS pipeline style=flp II=1
+      if(ilanes == 0) {
+        ibuf = in.read();
+        ilanes = PE;
+      }
+      obuf = obuf >> (G*W);
+      obuf(SIMD*W-1, (SIMD-G)*W) = ibuf(G*W-1, 0);
+      ibuf = ibuf >> (G*W);
+      ilanes -= G;
+      olanes += G;
+      if(olanes == SIMD) {
+        olanes = 0;
+        dst[addr++] = obuf;
+        if(++c == CF) {
+          c = 0;
+          addr += skip;
+        }
+      }
+    }
+  }
+
+  /**
+   * Executes one descriptor while the weights of the next one are prefetched.
+   */
+  template<
+    unsigned MaxIFMDim, unsigned MaxIFMCh, unsigned MaxK, unsigned MaxStride, unsigned MaxTiles,
+    unsigned SIMD, unsigned PE, unsigned AccBits, typename TI, typename TW, typename R
+  >
+  void overlay_step(OverlayLayer const  cur, OverlayLayer const  next, bool const  has_next,
+                    ap_uint<PE*SIMD*TW::width> const *weights,
+                    ap_uint<SIMD*TI::width> const *src, ap_uint<SIMD*TI::width> *dst,
+                    ap_uint<PE*SIMD*TW::width> const (&bank_cur)[MaxTiles],
+                    ap_uint<PE*SIMD*TW::width> (&bank_next)[MaxTiles],
+                    unsigned const  numReps, R const &r) {
+#pragma HLS DATAFLOW
+    hls::stream<ap_uint<SIMD*TI::width>>  padded("overlay_padded");
+    hls::stream<ap_uint<SIMD*TI::width>>  windows("overlay_windows");
+    hls::stream<ap_uint<PE*TI::width>>    results("overlay_results");
+    overlay_load<MaxTiles>(weights, next.wgt_ofs, next.tiles<SIMD, PE>(), has_next, bank_next);
+    overlay_read<SIMD, TI>(src, padded, cur, numReps);
+    overlay_swg<MaxIFMDim, MaxIFMCh, MaxK, MaxStride, SIMD, TI>(padded, windows, cur, numReps);
+    overlay_mvau<MaxK*MaxK*MaxIFMCh, MaxTiles, SIMD, PE, AccBits, TI, TW>(windows, results, bank_cur, cur, numReps, r);
+    overlay_write<SIMD, PE, TI>(results, dst, cur, numReps);
+  }
+
+} // namespace detail
+
+/**
+ * \brief   Layer-sequential overlay - executes a table of layer descriptors on one engine
+ *
+ * The descriptors are executed in order, every one over all numReps frames of the batch before the
+ * next one is started, so that its weights are loaded only once per batch. The weights of the first
+ * descriptor are loaded upfront, those of every following descriptor are prefetched into the other of
+ * the two on-chip banks while the previous one computes. The input and the output feature maps of a
+ * descriptor must not overlap; src and dst may refer to the same memory.
+ *
+ * \tparam MaxIFMDim  Maximum width and height of the zero-padded input feature maps
+ * \tparam MaxIFMCh   Maximum number of input channels
+ * \tparam MaxK       Maximum kernel dimension
+ * \tparam MaxStride  Maximum stride
+ * \tparam MaxTiles   Weight words of an on-chip bank, at least the tiles of every descriptor
+ * \tparam SIMD       Number of input channels computed in parallel
+ * \tparam PE         Number of output channels computed in parallel
+ * \tparam TI         DataType of the activations, ap_uint or ap_int
+ * \tparam TW         DataType of the weights
+ * \tparam AccBits    Width of the accumulators
+ * \tparam R          Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param layers      Table of the layer descriptors
+ * \param numLayers   Number of descriptors
+ * \param weights     Weights of all descriptors, in the tile order of Matrix_Vector_Activate_Batch
+ * \param src         Memory of the feature maps read
+ * \param dst         Memory of the feature maps written
+ * \param numReps     Number of frames of the batch
+ * \param r           Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned MaxIFMDim, unsigned MaxIFMCh, unsigned MaxK, unsigned MaxStride, unsigned MaxTiles,
+  unsigned SIMD, unsigned PE, typename TI, typename TW, unsigned AccBits = 24, typename R
+>
+void Overlay_Execute(OverlayLayer const *layers, unsigned const  numLayers,
+                     ap_uint<PE*SIMD*TW::width> const *weights,
+                     ap_uint<SIMD*TI::width> const *src, ap_uint<SIMD*TI::width> *dst,
+                     unsigned const  numReps, R const &r) {
+  ap_uint<PE*SIMD*TW::width>  bank0[MaxTiles];
+  ap_uint<PE*SIMD*TW::width>  bank1[MaxTiles];
+  if(numLayers == 0) {
+    return;
+  }
+  OverlayLayer  cur = layers[0];
+  detail::overlay_load<MaxTiles>(weights, cur.wgt_ofs, cur.tiles<SIMD, PE>(), true, bank0);
+  // The banks swap their roles from one descriptor to the next. Each of them is passed to the step
+  // as a separate array for its loader and its MAC not to share a memory within the dataflow region,
+  // so the step has a call site per bank assignment. Both must map onto a single engine.
+#pragma HLS ALLOCATION function instances=overlay_step limit=1
+  for(unsigned  i = 0; i < numLayers; i++) {
+    bool const  has_next = i + 1 < numLayers;
+    OverlayLayer const  next = layers[has_next? i + 1 : i];
+    if(i & 1) {
+      detail::overlay_step<MaxIFMDim, MaxIFMCh, MaxK, MaxStride, MaxTiles, SIMD, PE, AccBits, TI, TW>
+        (cur, next, has_next, weights, src, dst, bank1, bank0, numReps, r);
+    }
+    else {
+      detail::overlay_step<MaxIFMDim, MaxIFMCh, MaxK, MaxStride, MaxTiles, SIMD, PE, AccBits, TI, TW>
+        (cur, next, has_next, weights, src, dst, bank0, bank1, numReps, r);
+    }
+    cur = next;
+  }
+}
+
+#endif
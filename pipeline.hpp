@@ -0,0 +1,412 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *
+ *  \file pipeline.hpp
+ *
+ *  Type-level composition of layers into a dataflow pipeline.
+ *
+ *  A pipeline is given as the list of its layer descriptors, e.g.
+ *
+ *    using Net = Pipeline<
+ *      pipeline::Conv<3, 16, 32, 32, 30, 4, 8, Slice<ap_uint<4>>, Slice<ap_uint<4>>>,
+ *      pipeline::MaxPool<30, 2, 32, ap_uint<4>, 0>,
+ *      pipeline::MatrixVector<15*15*32, 10, 16, 2, Slice<ap_uint<4>>, Slice<ap_uint<16>>>
+ *    >;
+ *    Net::run(in, out, reps, pipeline::params(weights1, thresholds1, ap_resource_dsp()),
+ *             pipeline::none(), pipeline::params(weights2, PassThroughActivation<ap_uint<16>>(), ap_resource_dsp()));
+ *
+ *  Every descriptor states the widths of the streams the layer reads and writes
+ *  natively together with their words per frame and its modelled cycles per
+ *  frame (see cycles.hpp). The pipeline declares the streams between the
+ *  layers and inserts a width converter only where adjacent widths differ,
+ *  including at the pipeline input and output. Each stream is deep enough for
+ *  the faster of its two ends to run through a frame without being stalled by
+ *  the slower one, up to the MaxDepth of the pipeline.
+ *
+ *  The parameters of the layers are passed to run in the order of the layers,
+ *  pipeline::none() for a layer without parameters. pipeline::params only
+ *  refers to its arguments, which are thus passed as temporaries within the
+ *  call to run only.
+ *
+ *  On multi-die devices, layers are wrapped as pipeline::OnSLR<Slr, Layer> and
+ *  the pipeline inserts an SLRCrossing_Batch wherever adjacent layers are on
+ *  different SLRs.
+ *
+ *******************************************************************************/
+
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include <algorithm>
+#include <type_traits>
+
+#include "cycles.hpp"
+#include "streamtools.h"
+#include "slidingwindow.h"
+#include "maxpool.h"
+#include "mvau.hpp"
+
+namespace pipeline {
+
+/**
+ * \brief Parameters of a layer without any
+ */
+struct none {};
+
+/**
+ * \brief Parameters of a compute layer: its weights, activation and MAC resource
+ */
+template<typename TW, typename TA, typename R>
+struct layer_params {
+	TW const &weights;
+	TA const &activation;
+	R const  &r;
+};
+
+template<typename TW, typename TA, typename R>
+layer_params<TW, TA, R> params(TW const &weights, TA const &activation, R const &r) {
+#pragma HLS inline
+	return  layer_params<TW, TA, R>{ weights, activation, r };
+}
+
+/**
+ * \brief Convolutional layer as ConvLayer_Batch without its width converters
+ *
+ * Reads SIMD input channels and writes PE output channels per word.
+ */
+template<
+	unsigned ConvKernelDim, unsigned IFMChannels, unsigned IFMDim, unsigned OFMChannels, unsigned OFMDim,
+	unsigned SIMD, unsigned PE,
+	typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity
+>
+struct Conv {
+	static constexpr unsigned  InWidth = SIMD * TSrcI::width;
+	static constexpr unsigned  OutWidth = PE * TDstI::width;
+	static constexpr unsigned  InWords = IFMDim * IFMDim * (IFMChannels / SIMD);
+	static constexpr unsigned  OutWords = OFMDim * OFMDim * (OFMChannels / PE);
+	static constexpr cycles_t  Cycles = std::max(
+		ConvolutionInputGenerator_cycles<ConvKernelDim, IFMChannels, IFMDim, OFMDim, SIMD, 1>(1),
+		Matrix_Vector_Activate_Batch_cycles<ConvKernelDim*ConvKernelDim*IFMChannels, OFMChannels, SIMD, PE>(OFMDim*OFMDim)
+	);
+
+	template<typename TW, typename TA, typename R>
+	static void run(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<OutWidth>> &out,
+		unsigned const  reps, layer_params<TW, TA, R> const &p) {
+#pragma HLS INLINE
+		hls::stream<ap_uint<InWidth>>  convInp("pipeline::Conv.convInp");
+		ConvolutionInputGenerator<ConvKernelDim, IFMChannels, TSrcI::width, IFMDim, OFMDim, SIMD, 1>
+			(in, convInp, reps, ap_resource_dflt());
+		Matrix_Vector_Activate_Batch<ConvKernelDim*ConvKernelDim*IFMChannels, OFMChannels, SIMD, PE, 1, TSrcI, TDstI, TWeightI>
+			(convInp, out, p.weights, p.activation, reps * OFMDim * OFMDim, p.r);
+	}
+};
+
+/**
+ * \brief Fully-connected layer as Matrix_Vector_Activate_Batch over Vectors input vectors per frame
+ */
+template<
+	unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE,
+	typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+	unsigned Vectors = 1
+>
+struct MatrixVector {
+	static constexpr unsigned  InWidth = SIMD * TSrcI::width;
+	static constexpr unsigned  OutWidth = PE * TDstI::width;
+	static constexpr unsigned  InWords = Vectors * (MatrixW / SIMD);
+	static constexpr unsigned  OutWords = Vectors * (MatrixH / PE);
+	static constexpr cycles_t  Cycles = Matrix_Vector_Activate_Batch_cycles<MatrixW, MatrixH, SIMD, PE>(Vectors);
+
+	template<typename TW, typename TA, typename R>
+	static void run(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<OutWidth>> &out,
+		unsigned const  reps, layer_params<TW, TA, R> const &p) {
+#pragma HLS INLINE
+		Matrix_Vector_Activate_Batch<MatrixW, MatrixH, SIMD, PE, 1, TSrcI, TDstI, TWeightI>
+			(in, out, p.weights, p.activation, reps * Vectors, p.r);
+	}
+};
+
+/**
+ * \brief Max pool layer as StreamingMaxPool_Precision_Batch reading and writing one pixel per word
+ */
+template<unsigned ImgDim, unsigned PoolDim, unsigned NumChannels, typename ActType, int min_value>
+struct MaxPool {
+	static constexpr unsigned  InWidth = NumChannels * ActType::width;
+	static constexpr unsigned  OutWidth = NumChannels * ActType::width;
+	static constexpr unsigned  InWords = ImgDim * ImgDim;
+	static constexpr unsigned  OutWords = (ImgDim / PoolDim) * (ImgDim / PoolDim);
+	static constexpr cycles_t  Cycles = StreamingMaxPool_Batch_cycles<ImgDim, PoolDim>(1);
+
+	static void run(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<OutWidth>> &out,
+		unsigned const  reps, none const&) {
+#pragma HLS INLINE
+		StreamingMaxPool_Precision_Batch<ImgDim, PoolDim, NumChannels, ActType, min_value>(in, out, reps);
+	}
+};
+
+/**
+ * \brief Layer L placed on SLR Slr of a multi-die device
+ *
+ * The pipeline inserts an SLRCrossing_Batch of Stages register hops on the stream from the
+ * previous layer if that one is on another SLR. Layers without the annotation are on SLR 0.
+ * The placement itself is left to the floorplan of the layers.
+ */
+template<unsigned Slr, typename L, unsigned Stages = 2>
+struct OnSLR : L {};
+
+/**
+ * \brief SLR of a layer and the register hops on its input from another SLR
+ */
+template<typename L>
+struct slr_of {
+	static constexpr unsigned  value = 0;
+	static constexpr unsigned  stages = 0;
+};
+template<unsigned Slr, typename L, unsigned Stages>
+struct slr_of<OnSLR<Slr, L, Stages>> {
+	static constexpr unsigned  value = Slr;
+	static constexpr unsigned  stages = Stages;
+};
+
+/**
+ * \brief Depth of a stream between a producer and a consumer running through a frame in the given cycles
+ *
+ * The faster end runs ahead by the share of the words it moves while the slower end is still behind.
+ */
+constexpr unsigned fifo_depth(unsigned const  words, cycles_t const  producer, cycles_t const  consumer, unsigned const  max_depth) {
+	return  std::min<cycles_t>(max_depth, std::max<cycles_t>(2,
+		words - words * std::min(producer, consumer) / std::max<cycles_t>(1, std::max(producer, consumer))));
+}
+
+/**
+ * \brief Cycles of the width converter inserted into a pipeline for NumInWords words of InWidth bits per frame
+ */
+template<unsigned InWidth, unsigned OutWidth, unsigned NumInWords>
+constexpr cycles_t converter_cycles() {
+	return  std::max<cycles_t>(NumInWords, (cycles_t(NumInWords) * InWidth + OutWidth - 1) / OutWidth);
+}
+
+} // namespace pipeline
+
+namespace detail {
+
+	template<unsigned InWidth, unsigned OutWidth, unsigned NumInWords>
+	void pipeline_convert(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<OutWidth>> &out, unsigned const  reps, std::true_type) {
+#pragma HLS INLINE
+		StreamingDataWidthConverter_Batch<InWidth, OutWidth, NumInWords>(in, out, reps);
+	}
+	// widths that are no multiples of each other
+	template<unsigned InWidth, unsigned OutWidth, unsigned NumInWords>
+	void pipeline_convert(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<OutWidth>> &out, unsigned const  reps, std::false_type) {
+#pragma HLS INLINE
+		static_assert((NumInWords * InWidth) % OutWidth == 0, "The frame must fill whole words of the converted stream.");
+		StreamingDataWidthConverterGeneralized_Batch<InWidth, OutWidth, NumInWords>(in, out, reps);
+	}
+
+	/** Width converter of NumInWords words of InWidth bits per frame. */
+	template<unsigned InWidth, unsigned OutWidth, unsigned NumInWords>
+	void pipeline_convert(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<OutWidth>> &out, unsigned const  reps) {
+#pragma HLS INLINE
+		pipeline_convert<InWidth, OutWidth, NumInWords>(in, out, reps,
+			std::integral_constant<bool, (InWidth % OutWidth == 0) || (OutWidth % InWidth == 0)>());
+	}
+
+	/** Consumer cycles of a stream of Words words of Width bits per frame feeding layer L. */
+	template<typename L, unsigned Width, unsigned Words>
+	constexpr cycles_t pipeline_consumer_cycles() {
+		return  Width == L::InWidth? L::Cycles : pipeline::converter_cycles<Width, L::InWidth, Words>();
+	}
+
+	/** Runs layer L on a stream of the layer input width. */
+	template<unsigned MaxDepth, typename L, typename P>
+	void pipeline_stage(hls::stream<ap_uint<L::InWidth>> &in, hls::stream<ap_uint<L::OutWidth>> &out,
+		unsigned const  reps, P const &p, std::true_type) {
+#pragma HLS INLINE
+		L::run(in, out, reps, p);
+	}
+	/** Runs layer L behind a width converter. */
+	template<unsigned MaxDepth, typename L, int InWidth, typename P>
+	void pipeline_stage(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<L::OutWidth>> &out,
+		unsigned const  reps, P const &p, std::false_type) {
+#pragma HLS INLINE
+		constexpr unsigned  NumInWords = L::InWords * L::InWidth / InWidth;
+		static_assert(NumInWords * InWidth == L::InWords * L::InWidth, "The frame must fill whole words of the input stream.");
+		constexpr unsigned  Depth = pipeline::fifo_depth(L::InWords,
+			pipeline::converter_cycles<InWidth, L::InWidth, NumInWords>(), L::Cycles, MaxDepth);
+		hls::stream<ap_uint<L::InWidth>>  adjusted("pipeline_stage.adjusted");
+#pragma HLS STREAM variable=adjusted depth=Depth
+		pipeline_convert<InWidth, L::InWidth, NumInWords>(in, adjusted, reps);
+		L::run(adjusted, out, reps, p);
+	}
+	template<unsigned MaxDepth, typename L, int InWidth, typename P>
+	void pipeline_stage(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<L::OutWidth>> &out,
+		unsigned const  reps, P const &p) {
+#pragma HLS INLINE
+		pipeline_stage<MaxDepth, L>(in, out, reps, p, std::integral_constant<bool, InWidth == L::InWidth>());
+	}
+
+	/** Pipeline output written by the last layer. */
+	template<unsigned MaxDepth, typename L, int OutWidth>
+	void pipeline_output(hls::stream<ap_uint<L::OutWidth>> &in, hls::stream<ap_uint<OutWidth>> &out, unsigned const  reps) {
+#pragma HLS INLINE
+		constexpr unsigned  NumOutWords = L::OutWords * L::OutWidth / OutWidth;
+		static_assert(NumOutWords * OutWidth == L::OutWords * L::OutWidth, "The frame must fill whole words of the output stream.");
+		pipeline_convert<L::OutWidth, OutWidth, L::OutWords>(in, out, reps);
+	}
+
+	template<unsigned MaxDepth, typename... Layers>
+	struct pipeline_chain;
+
+	// with the last layer
+	template<unsigned MaxDepth, typename L>
+	struct pipeline_chain<MaxDepth, L> {
+		template<int InWidth, int OutWidth, typename P>
+		static void run(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<OutWidth>> &out,
+			unsigned const  reps, P const &p) {
+#pragma HLS INLINE
+			run(in, out, reps, p, std::integral_constant<bool, OutWidth == L::OutWidth>());
+		}
+		template<int InWidth, typename P>
+		static void run(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<L::OutWidth>> &out,
+			unsigned const  reps, P const &p, std::true_type) {
+#pragma HLS INLINE
+			pipeline_stage<MaxDepth, L>(in, out, reps, p);
+		}
+		template<int InWidth, int OutWidth, typename P>
+		static void run(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<OutWidth>> &out,
+			unsigned const  reps, P const &p, std::false_type) {
+#pragma HLS INLINE
+			constexpr unsigned  Depth = pipeline::fifo_depth(L::OutWords,
+				L::Cycles, pipeline::converter_cycles<L::OutWidth, OutWidth, L::OutWords>(), MaxDepth);
+			hls::stream<ap_uint<L::OutWidth>>  result("pipeline_chain.result");
+#pragma HLS STREAM variable=result depth=Depth
+			pipeline_stage<MaxDepth, L>(in, result, reps, p);
+			pipeline_output<MaxDepth, L>(result, out, reps);
+		}
+	};
+
+	// with layer L followed by N
+	template<unsigned MaxDepth, typename L, typename N, typename... Layers>
+	struct pipeline_chain<MaxDepth, L, N, Layers...> {
+		template<int InWidth, int OutWidth, typename P, typename... Ps>
+		static void run(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<OutWidth>> &out,
+			unsigned const  reps, P const &p, Ps const&... ps) {
+#pragma HLS INLINE
+			constexpr unsigned  Depth = pipeline::fifo_depth(L::OutWords,
+				L::Cycles, pipeline_consumer_cycles<N, L::OutWidth, L::OutWords>(), MaxDepth);
+			hls::stream<ap_uint<L::OutWidth>>  link("pipeline_chain.link");
+#pragma HLS STREAM variable=link depth=Depth
+			pipeline_stage<MaxDepth, L>(in, link, reps, p);
+			next(link, out, reps, std::integral_constant<bool, pipeline::slr_of<L>::value == pipeline::slr_of<N>::value>(), ps...);
+		}
+		// on the same SLR
+		template<int OutWidth, typename... Ps>
+		static void next(hls::stream<ap_uint<L::OutWidth>> &link, hls::stream<ap_uint<OutWidth>> &out,
+			unsigned const  reps, std::true_type, Ps const&... ps) {
+#pragma HLS INLINE
+			pipeline_chain<MaxDepth, N, Layers...>::run(link, out, reps, ps...);
+		}
+		// across an SLR boundary
+		template<int OutWidth, typename... Ps>
+		static void next(hls::stream<ap_uint<L::OutWidth>> &link, hls::stream<ap_uint<OutWidth>> &out,
+			unsigned const  reps, std::false_type, Ps const&... ps) {
+#pragma HLS INLINE
+			hls::stream<ap_uint<L::OutWidth>>  crossed("pipeline_chain.crossed");
+#pragma HLS STREAM variable=crossed depth=2
+			SLRCrossing_Batch<pipeline::slr_of<N>::stages, L::OutWords>(link, crossed, reps);
+			pipeline_chain<MaxDepth, N, Layers...>::run(crossed, out, reps, ps...);
+		}
+	};
+
+	/** Number of SLR boundaries between adjacent layers. */
+	template<typename L>
+	constexpr unsigned pipeline_crossings() {
+		return  0;
+	}
+	template<typename L, typename N, typename... Layers>
+	constexpr unsigned pipeline_crossings() {
+		return  (pipeline::slr_of<L>::value != pipeline::slr_of<N>::value) + pipeline_crossings<N, Layers...>();
+	}
+
+	constexpr cycles_t pipeline_max_cycles() {
+		return  0;
+	}
+	template<typename... Tail>
+	constexpr cycles_t pipeline_max_cycles(cycles_t const  head, Tail const... tail) {
+		return  std::max(head, pipeline_max_cycles(tail...));
+	}
+
+} // namespace detail
+
+/**
+ * \brief Dataflow pipeline of the given layers with stream depths up to MaxDepth
+ *
+ * \tparam MaxDepth	Upper limit of the depth of the streams between the layers
+ * \tparam Layers	Layer descriptors in dataflow order
+ */
+template<unsigned MaxDepth, typename... Layers>
+struct BoundedPipeline {
+	static_assert(sizeof...(Layers) > 0, "A pipeline needs at least one layer.");
+
+	/** Modelled cycles per frame, those of the slowest layer. */
+	static constexpr cycles_t  Cycles = detail::pipeline_max_cycles(Layers::Cycles...);
+
+	/** Number of SLR crossings inserted between the layers. */
+	static constexpr unsigned  Crossings = detail::pipeline_crossings<Layers...>();
+
+	/**
+	 * \brief Runs the pipeline over reps frames
+	 *
+	 * \param in		Input stream
+	 * \param out		Output stream
+	 * \param reps		Number of frames
+	 * \param ps		Parameters of the layers, in the order of the layers
+	 */
+	template<int InWidth, int OutWidth, typename... Ps>
+	static void run(hls::stream<ap_uint<InWidth>> &in, hls::stream<ap_uint<OutWidth>> &out,
+		unsigned const  reps, Ps const&... ps) {
+#pragma HLS INLINE
+		static_assert(sizeof...(Ps) == sizeof...(Layers), "Pass one parameter set per layer.");
+		detail::pipeline_chain<MaxDepth, Layers...>::run(in, out, reps, ps...);
+	}
+};
+
+/**
+ * \brief Dataflow pipeline of the given layers with stream depths up to 1024 words
+ */
+template<typename... Layers>
+using Pipeline = BoundedPipeline<1024, Layers...>;
+
+#endif
@@ -155,6 +155,99 @@ public:
   }
 };
 
+/*!
+ * \brief ReciprocalDivider: Division by a constant through multiplication with its fixed-point reciprocal
+ *
+ * The reciprocal is computed at compile time and scaled by 2^(TA::width + 1 + clog2(size)), which is
+ * enough for the quotient to be exact for every value of TA, also after adding the rounding offset.
+ * 
+ * \tparam TA Datatype of the dividend
+ * \tparam size Constant divisor
+ *
+ */
+template<typename TA, unsigned size>
+class ReciprocalDivider {
+  static_assert(size > 0, "Divisor must be positive");
+  static constexpr unsigned  SHIFT = TA::width + 1 + clog2(size);
+  static_assert(SHIFT < 64, "Dividend too wide for the reciprocal");
+  static constexpr unsigned long long  MULT = ((1ull << SHIFT) + size - 1) / size;
+
+  // floor(mag/size) for any mag < 2^(TA::width+1)
+  ap_uint<TA::width+1> quotient(ap_uint<TA::width+1> const &mag) const {
+#pragma HLS inline
+    ap_uint<2*TA::width+3> const  prod = mag * ap_uint<TA::width+2>(MULT);
+    return  prod >> SHIFT;
+  }
+
+  template<typename TO>
+  TO apply_sign(bool const  neg, ap_uint<TA::width+1> const &quot) const {
+#pragma HLS inline
+    return  neg? TO(-ap_int<TA::width+2>(quot)) : TO(quot);
+  }
+
+public:
+/*!
+ * \brief divide: computes accu/size, truncated towards zero as the integer division
+ *
+ * \param accu Dividend
+*/
+  template<typename TO>
+  TO divide(TA const &accu) const {
+#pragma HLS inline
+    bool const  neg = accu < 0;
+    ap_uint<TA::width+1> const  mag = neg? ap_uint<TA::width+1>(-accu) : ap_uint<TA::width+1>(accu);
+    return  apply_sign<TO>(neg, quotient(mag));
+  }
+/*!
+ * \brief round: computes accu/size, rounded to the nearest integer with ties away from zero
+ *
+ * \param accu Dividend
+*/
+  template<typename TO>
+  TO round(TA const &accu) const {
+#pragma HLS inline
+    bool const  neg = accu < 0;
+    ap_uint<TA::width+1> const  mag = neg? ap_uint<TA::width+1>(-accu) : ap_uint<TA::width+1>(accu);
+    return  apply_sign<TO>(neg, quotient(mag + size/2));
+  }
+};
+
+/*!
+ * \brief ReciprocalAvgPoolFunction: Implementing avg pool without a divider
+ *
+ * This class inherits from the generic Poolfunction to implement Average Pool
+ * with a multiplication by the constant reciprocal of size, rounding the
+ * average to the nearest integer (ties away from zero)
+ * 
+ * \tparam TA Datatype of the internal accumulation in the avg pool function
+ * \tparam TO Datatype of the output generated by the avg pool function
+ * \tparam size Value used as divisor on the accumulator to generate output 
+ *
+ */
+template<typename TA, typename TO, unsigned size>
+class ReciprocalAvgPoolFunction : public PoolFunction<TA, TO, size> {
+public:
+/*!
+ * \brief pool: computes the sum 
+ *
+ * \param input Input value to be used in the avg pool function 
+ * \param accu  Accumulation value already computed in previous iterations
+*/
+  TA pool(TA const &input, TA const &accu) const{
+#pragma HLS inline
+    return comp::add<TA, TA, TA>()(input,accu);
+  }
+/*!
+ * \brief activate: compute the rounded output of the avg pooling algorithm
+ *
+ * \param accu Accumulation value already computed in previous iterations 
+*/    
+  TO activate(TA const &accu) const {
+#pragma HLS inline
+    return  ReciprocalDivider<TA, size>().template round<TO>(accu);
+  }
+};
+
 /*!
  * \brief AccPoolFunction: Implementing accumulation pool 
  *
@@ -0,0 +1,351 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *
+ *  \file recurrent.hpp
+ *
+ *  Library of templated HLS functions for BNN deployment.
+ *  This file lists a recurrent cell built from an input-to-hidden and a
+ *  hidden-to-hidden matrix vector product, together with the LSTM and GRU
+ *  gate functions it is parameterized with.
+ *
+ *  All gate values are fixed-point numbers with Frac fractional bits, as
+ *  produced by the lookup table activations (see LUTActivation) applying the
+ *  gate nonlinearities. The hidden and cell states use the same scale.
+ *
+ *******************************************************************************/
+
+#ifndef RECURRENT_HPP
+#define RECURRENT_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "mac.hpp"
+#include "interpret.hpp"
+
+namespace detail {
+
+	/** Saturates an ap_int value into the range of the ap_(u)int type T. */
+	template<typename T, typename TV>
+	T saturate(TV const &val) {
+#pragma HLS inline
+		constexpr unsigned  RW = T::width + 2;
+		bool const  sgn = T(-1) < T(0);
+		ap_int<RW> const  hi = sgn? ap_int<RW>((ap_int<RW>(1) << (T::width-1)) - 1) : ap_int<RW>((ap_int<RW>(1) << T::width) - 1);
+		ap_int<RW> const  lo = sgn? ap_int<RW>(-(ap_int<RW>(1) << (T::width-1))) : ap_int<RW>(0);
+		return  val > hi? T(hi) : val < lo? T(lo) : T(val);
+	}
+
+} // namespace detail
+
+/*!
+ * \brief Gate function of an LSTM cell for Recurrent_Cell_Batch.
+ *
+ * Computes the gates i, f, g and o (in this order of the weight rows) and
+ *   c' = f*c + i*g
+ *   h' = o*tanh(c')
+ * from the accumulated input and hidden contributions of a hidden unit.
+ * The members are public to allow direct initialization.
+ *
+ * \tparam NF      Number of neuron folds, i.e. HiddenSize/PE
+ * \tparam PE      Number of hidden units computed in parallel
+ * \tparam TA      DataType of the accumulators and the biases
+ * \tparam TSig    Activation class of the sigmoid on TA (e.g. LUTActivation)
+ * \tparam TTanh   Activation class of the tanh on TA
+ * \tparam TTanhC  Activation class of the tanh on TC
+ * \tparam TC      DataType of the cell state
+ * \tparam TH      DataType of the hidden state
+ * \tparam Frac    Number of fractional bits of the gates and states
+ */
+template<unsigned NF, unsigned PE, typename TA, typename TSig, typename TTanh, typename TTanhC,
+	typename TC, typename TH, unsigned Frac>
+class LSTMCell {
+public:
+	static constexpr unsigned  GATES = 4;
+	typedef TH  hidden_type;
+	typedef TC  state_type;
+
+public:
+	TA      m_bias[GATES][PE][NF];
+	TSig    m_sigmoid;
+	TTanh   m_tanh;
+	TTanhC  m_tanh_c;
+
+public:
+	TA init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+		return  TA(0);
+	}
+
+	TH update(unsigned const  nf, unsigned const  pe, TA const (&ax)[GATES], TA const (&ah)[GATES],
+		__attribute__((unused)) TH const &h, TC &c) const {
+#pragma HLS inline
+		auto const  i = m_sigmoid.activate(nf, pe, TA(ax[0] + ah[0] + m_bias[0][pe][nf]));
+		auto const  f = m_sigmoid.activate(nf, pe, TA(ax[1] + ah[1] + m_bias[1][pe][nf]));
+		auto const  g = m_tanh   .activate(nf, pe, TA(ax[2] + ah[2] + m_bias[2][pe][nf]));
+		auto const  o = m_sigmoid.activate(nf, pe, TA(ax[3] + ah[3] + m_bias[3][pe][nf]));
+		c = detail::saturate<TC>((f*c + i*g) >> Frac);
+		auto const  t = m_tanh_c.activate(nf, pe, c);
+		return  detail::saturate<TH>((o*t) >> Frac);
+	}
+};
+
+/*!
+ * \brief Gate function of a GRU cell for Recurrent_Cell_Batch.
+ *
+ * Computes the gates r, z and n (in this order of the weight rows) and
+ *   n  = tanh(x_n + r*(h_n + b_hn))
+ *   h' = (1-z)*n + z*h
+ * from the accumulated input (x) and hidden (h) contributions of a hidden unit.
+ * The biases of r and z and the input bias of n are in m_bias, the hidden bias
+ * of n, which is scaled by r, in m_bias_hn. There is no cell state.
+ * The members are public to allow direct initialization.
+ *
+ * \tparam NF      Number of neuron folds, i.e. HiddenSize/PE
+ * \tparam PE      Number of hidden units computed in parallel
+ * \tparam TA      DataType of the accumulators and the biases
+ * \tparam TSig    Activation class of the sigmoid on TA (e.g. LUTActivation)
+ * \tparam TTanh   Activation class of the tanh on TA
+ * \tparam TH      DataType of the hidden state
+ * \tparam Frac    Number of fractional bits of the gates and states
+ */
+template<unsigned NF, unsigned PE, typename TA, typename TSig, typename TTanh, typename TH, unsigned Frac>
+class GRUCell {
+public:
+	static constexpr unsigned  GATES = 3;
+	typedef TH  hidden_type;
+	typedef ap_uint<1>  state_type;
+
+public:
+	TA     m_bias[GATES][PE][NF];
+	TA     m_bias_hn[PE][NF];
+	TSig   m_sigmoid;
+	TTanh  m_tanh;
+
+public:
+	TA init(__attribute__((unused)) unsigned const  nf, __attribute__((unused)) unsigned const  pe) const {
+#pragma HLS inline
+		return  TA(0);
+	}
+
+	TH update(unsigned const  nf, unsigned const  pe, TA const (&ax)[GATES], TA const (&ah)[GATES],
+		TH const &h, __attribute__((unused)) state_type &c) const {
+#pragma HLS inline
+		auto const  r = m_sigmoid.activate(nf, pe, TA(ax[0] + ah[0] + m_bias[0][pe][nf]));
+		auto const  z = m_sigmoid.activate(nf, pe, TA(ax[1] + ah[1] + m_bias[1][pe][nf]));
+		TA const  hn = TA(ah[2] + m_bias_hn[pe][nf]);
+		auto const  n = m_tanh.activate(nf, pe, TA(ax[2] + m_bias[2][pe][nf] + ((r*hn) >> Frac)));
+		ap_int<Frac+2> const  zc = (ap_int<Frac+2>(1) << Frac) - z;
+		return  detail::saturate<TH>((zc*n + z*h) >> Frac);
+	}
+};
+
+/**
+ * \brief Recurrent cell over a sequence
+ *
+ * Runs a recurrent cell (e.g. LSTMCell or GRUCell) over the seqLen input vectors of a sequence. For every time
+ * step, the input-to-hidden product Wx*x and the hidden-to-hidden product Wh*h of the previous hidden state
+ * are accumulated per gate and passed to the gate function of the cell, which updates the hidden state and the
+ * cell state. Both states are kept on chip across the time steps and are zero at the start of the sequence. The
+ * hidden state is double-buffered so that the products of a time step read the previous state while the new one
+ * is written. The hidden state of every time step is also written to the output stream.
+ *
+ * Both weight matrices hold Gates*HiddenSize rows. Their PE dimension is Gates*PE, where lane g*PE + pe of tile
+ * nf*SF + sf holds the weights of gate g of hidden unit nf*PE + pe, so that all gates of PE hidden units are
+ * computed in parallel. A time step takes HiddenSize/PE * (InputSize + HiddenSize)/SIMD cycles. The hidden state
+ * of the last neuron fold is read in the next time step after InputSize/SIMD + HiddenSize/SIMD cycles, which
+ * bounds the pipeline depth for II=1.
+ *
+ * \tparam InputSize   Number of elements of an input vector
+ * \tparam HiddenSize  Number of hidden units
+ * \tparam SIMD        Number of input columns computed in parallel, dividing InputSize and HiddenSize
+ * \tparam PE          Number of hidden units computed in parallel
+ * \tparam TSrcI       DataType of the input activation (as used in the MAC)
+ * \tparam TWeightI    DataType of the weights and how to access them in the array
+ * \tparam TI          DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO          DataType of the output stream - safely deducible from the paramaters
+ * \tparam TWX         DataType of the input-to-hidden weights - safely deducible from the paramaters
+ * \tparam TWH         DataType of the hidden-to-hidden weights - safely deducible from the paramaters
+ * \tparam TCell       DataType of the cell function - safely deducible from the paramaters
+ * \tparam R           Datatype for the resource used for FPGA implementation of the MAC - safely deducible from the paramaters
+ *
+ * \param in           Input stream, InputSize/SIMD words per time step
+ * \param out          Output stream of the hidden states, HiddenSize/PE words per time step
+ * \param wx           Input-to-hidden weights (e.g. FixedPointWeights)
+ * \param wh           Hidden-to-hidden weights
+ * \param cell         Gate function holding the nonlinearities and biases
+ * \param seqLen       Number of time steps of the sequence
+ * \param r            Resource type for the hardware implementation of the MAC block
+ */
+template<
+	unsigned InputSize, unsigned HiddenSize, unsigned SIMD, unsigned PE,
+	typename TSrcI = Identity, typename TWeightI = Identity,
+	typename TI, typename TO, typename TWX, typename TWH, typename TCell, typename R
+>
+void Recurrent_Cell_Batch(hls::stream<TI> &in,
+				  hls::stream<TO> &out,
+				  TWX const &wx,
+				  TWH const &wh,
+				  TCell const &cell,
+				  unsigned const  seqLen,
+				  R const &r) {
+	static_assert(InputSize % SIMD == 0, "SIMD must divide InputSize.");
+	static_assert(HiddenSize % SIMD == 0, "SIMD must divide HiddenSize.");
+	static_assert(HiddenSize % PE == 0, "PE must divide HiddenSize.");
+	typedef typename TCell::hidden_type  TH;
+	typedef typename TCell::state_type  TC;
+	typedef decltype(cell.init(0,0))  TA;
+	static_assert(TO::width == PE*TH::width, "Output stream must hold PE hidden values.");
+	constexpr unsigned  GATES = TCell::GATES;
+	constexpr unsigned  NF = HiddenSize / PE;
+	constexpr unsigned  SFX = InputSize / SIMD;
+	constexpr unsigned  SFH = HiddenSize / SIMD;
+	constexpr unsigned  BANKS = SIMD * PE;
+
+	// input vector buffer
+	TI  inputBuf[SFX];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+
+	// hidden state of the previous and the current time step, cell state
+	ap_uint<TH::width>  hstate[2][HiddenSize];
+#pragma HLS ARRAY_PARTITION variable=hstate complete dim=1
+#pragma HLS ARRAY_PARTITION variable=hstate cyclic factor=BANKS dim=2
+	TC  cstate[HiddenSize];
+#pragma HLS ARRAY_PARTITION variable=cstate cyclic factor=PE dim=1
+
+	TA  accx[GATES][PE];
+#pragma HLS ARRAY_PARTITION variable=accx complete dim=0
+	TA  acch[GATES][PE];
+#pragma HLS ARRAY_PARTITION variable=acch complete dim=0
+
+	unsigned  nf = 0;
+	unsigned  sf = 0;
+	unsigned  tx = 0; // invariant: tx = nf*SFX + min(sf, SFX)
+	unsigned  th = 0; // invariant: th = nf*SFH + max(sf-SFX, 0)
+	unsigned  t  = 0;
+
+	// everything merged into a common iteration space (one "big" loop instead
+	// of smaller nested loops) to get the pipelinening the way we want
+	constexpr unsigned  STEP_FOLD = NF * (SFX + SFH);
+	for(unsigned  i = 0; i < seqLen * STEP_FOLD; i++) {
+#pragma HLS pipeline style=flp II=1
+		bool const  first = t == 0;
+		unsigned const  rd = t & 1;
+
+		if(sf == 0) {
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+				for(unsigned  g = 0; g < GATES; g++) {
+#pragma HLS UNROLL
+					accx[g][pe] = cell.init(nf, pe);
+					acch[g][pe] = cell.init(nf, pe);
+				}
+			}
+		}
+
+		if(sf < SFX) {
+			TI  inElem;
+			if(nf == 0) {
+				inElem = in.read();
+				inputBuf[sf] = inElem;
+			}
+			else {
+				inElem = inputBuf[sf];
+			}
+			auto const &w = wx.weights(tx++);
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+				for(unsigned  g = 0; g < GATES; g++) {
+#pragma HLS UNROLL
+					auto const  wgt = TWeightI()(w[g*PE + pe]);
+					auto const  act = TSrcI()(inElem, 0);
+					accx[g][pe] = mac<SIMD>(accx[g][pe], wgt, act, r, 0);
+				}
+			}
+		}
+		else {
+			ap_uint<SIMD*TH::width>  hElem = 0;
+			if(!first) {
+				for(unsigned  s = 0; s < SIMD; s++) {
+#pragma HLS UNROLL
+					hElem((s+1)*TH::width-1, s*TH::width) = hstate[rd][(sf-SFX)*SIMD + s];
+				}
+			}
+			auto const &w = wh.weights(th++);
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+				for(unsigned  g = 0; g < GATES; g++) {
+#pragma HLS UNROLL
+					auto const  wgt = TWeightI()(w[g*PE + pe]);
+					auto const  act = Slice<TH>()(hElem, 0);
+					acch[g][pe] = mac<SIMD>(acch[g][pe], wgt, act, r, 0);
+				}
+			}
+		}
+
+		if(++sf == SFX + SFH) {
+			// apply the gates and update the states
+			TO  outElem;
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+				unsigned const  unit = nf*PE + pe;
+				TA  ax[GATES];
+				TA  ah[GATES];
+				for(unsigned  g = 0; g < GATES; g++) {
+#pragma HLS UNROLL
+					ax[g] = accx[g][pe];
+					ah[g] = acch[g][pe];
+				}
+				TH const  h = first? TH(0) : TH(hstate[rd][unit]);
+				TC  c = first? TC(0) : cstate[unit];
+				TH const  hn = cell.update(nf, pe, ax, ah, h, c);
+				cstate[unit] = c;
+				hstate[!rd][unit] = hn;
+				outElem((pe+1)*TH::width-1, pe*TH::width) = hn;
+			}
+			out.write(outElem);
+
+			// next folded neuron or time step
+			sf = 0;
+			if(++nf == NF) {
+				nf = 0;
+				tx = 0;
+				th = 0;
+				t++;
+			}
+		}
+	}
+}
+
+#endif
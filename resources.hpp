@@ -0,0 +1,479 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *
+ *  \file resources.hpp
+ *
+ *  Compile-time resource estimates of the library blocks.
+ *
+ *  Like the cycle models of cycles.hpp, every estimate is a constexpr function
+ *  named after the block it describes, taking the geometry parameters of the
+ *  block in the same order followed by the precisions and resource types that
+ *  determine its implementation, e.g.
+ *  Matrix_Vector_Activate_Batch_resources<MatrixW, MatrixH, SIMD, PE,
+ *  InputBits, AccBits, TW, TA, R>(). It returns the LUT, FF, BRAM18, URAM288
+ *  and DSP48 counts of the block as a Resources record, which adds up across
+ *  the blocks of a design and is checked against a device budget:
+ *
+ *    constexpr Resources  R = Matrix_Vector_Activate_Batch_resources<...>()
+ *                           + ConvolutionInputGenerator_resources<...>();
+ *    static_assert(R.fits(device::xczu3eg), "Design does not fit the device.");
+ *
+ *  The memories are counted exactly from their geometry: weight, threshold
+ *  and sliding window buffers by the bram18_count and uram288_count of their
+ *  banks, or by the LUTs of LUTRAM banks, following the memory resource that
+ *  is forced or selected by auto_memory_resource. The logic is estimated per
+ *  operator bit with the coefficients of resource_coefficients. A project
+ *  calibrates them to its device and tool version by passing a class with the
+ *  same members fitted to the synthesis results of tb/sweep/sweep.py, which
+ *  prints the fitted values with --calibrate.
+ *
+ *  Matrix_Vector_Activate_Batch_folding_fit extends the folding selection of
+ *  folding.hpp to foldings that fit a device budget, so that configurations
+ *  bound to exceed the device are rejected before synthesis.
+ *
+ *******************************************************************************/
+
+#ifndef RESOURCES_HPP
+#define RESOURCES_HPP
+
+#include <ap_int.h>
+#include <algorithm>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "weights.hpp"
+#include "activations.hpp"
+#include "folding.hpp"
+
+/**
+ * \brief Resource counts of a block or a design
+ */
+struct Resources {
+	unsigned long long  lut;	// LUTs, including those used as LUTRAM and SRL
+	unsigned long long  ff;		// flip-flops
+	unsigned long long  bram18;	// BRAM18 blocks, a BRAM36 counting as two
+	unsigned long long  uram;	// URAM288 blocks
+	unsigned long long  dsp;	// DSP48 slices
+
+	/** Whether all counts are within those of the budget. */
+	constexpr bool fits(Resources const &budget) const {
+		return  (lut <= budget.lut) && (ff <= budget.ff) && (bram18 <= budget.bram18) &&
+		        (uram <= budget.uram) && (dsp <= budget.dsp);
+	}
+};
+
+constexpr Resources operator+(Resources const &a, Resources const &b) {
+	return  { a.lut + b.lut, a.ff + b.ff, a.bram18 + b.bram18, a.uram + b.uram, a.dsp + b.dsp };
+}
+constexpr Resources operator*(Resources const &a, unsigned long long const  n) {
+	return  { n*a.lut, n*a.ff, n*a.bram18, n*a.uram, n*a.dsp };
+}
+
+/**
+ * \brief Available resources of common devices, to be scaled down for the
+ * share a design is allowed to occupy
+ */
+namespace device {
+	constexpr Resources  xc7z020 {  53200,  106400,  280,   0,  220 };
+	constexpr Resources  xczu3eg {  70560,  141120,  432,   0,  360 };
+	constexpr Resources  xczu7ev { 230400,  460800,  624,  96, 1728 };
+	constexpr Resources  xcu250  {1728000, 3456000, 5376, 1280, 12288 };
+} // namespace device
+
+/**
+ * \brief   Default coefficients of the logic estimates
+ *
+ * The values are nominal figures for UltraScale+ devices. A project can override
+ * them with values calibrated against its synthesis results by passing a class
+ * with the same members to the estimates.
+ */
+struct resource_coefficients {
+	// LUTs of a LUT multiplier per product of the operand widths
+	static constexpr double  MUL_LUT = 1.0;
+	// LUTs of a binary (XNOR) lane of the popcount
+	static constexpr double  XNOR_LUT = 1.0;
+	// LUTs and FFs per bit of a pipelined adder, also used for accumulators and negations
+	static constexpr double  ADD_LUT = 1.0;
+	static constexpr double  ADD_FF = 1.0;
+	// FFs per operand bit of a fabric MAC lane, DSP48 lanes register their operands internally
+	static constexpr double  OPERAND_FF = 1.0;
+	// LUTs per bit of a threshold comparator
+	static constexpr double  CMP_LUT = 1.0;
+	// products of ap_resource_dflt with at most this sum of operand widths are taken to be mapped to LUTs
+	static constexpr unsigned  DFLT_LUT_MAX_BITS = 8;
+	// control logic of a block: loop counters, address generation and stream handshakes
+	static constexpr unsigned  MVAU_LUT = 200;
+	static constexpr unsigned  MVAU_FF = 150;
+	static constexpr unsigned  SWG_LUT = 250;
+	static constexpr unsigned  SWG_FF = 200;
+	static constexpr unsigned  FIFO_LUT = 20;
+	static constexpr unsigned  FIFO_FF = 20;
+	// FIFOs of at most this number of bits are implemented in shift registers (SRL), larger ones in memory
+	static constexpr unsigned  FIFO_SRL_MAX_BITS = 1024;
+};
+
+namespace detail {
+
+	constexpr unsigned long long res_ceil(double const  x) {
+		return  (unsigned long long)x + (double((unsigned long long)x) < x? 1 : 0);
+	}
+	constexpr unsigned long long res_div_up(unsigned long long const  a, unsigned long long const  b) {
+		return  (a + b - 1) / b;
+	}
+
+	/** Total adder bits of a balanced tree summing n operands of w bits, the width growing by one per level. */
+	constexpr unsigned long long adder_tree_bits(unsigned long long const  n, unsigned const  w) {
+		return  n < 2? 0 : (n/2)*(w+1) + adder_tree_bits((n+1)/2, w+1);
+	}
+
+	//- Memories ----------------------------------------------------------
+	// banks x depth x width bits in LUTRAM: RAM64M primitives of four LUTs hold 64x3 bits with a separate write port
+	constexpr Resources memory_resources(unsigned long long const  depth, unsigned const  width, unsigned long long const  banks, ap_resource_lutram const&) {
+		return  { banks * res_div_up(depth, 64) * res_div_up(width, 3) * 4, 0, 0, 0, 0 };
+	}
+	constexpr Resources memory_resources(unsigned long long const  depth, unsigned const  width, unsigned long long const  banks, ap_resource_bram const&) {
+		return  { 0, 0, banks * bram18_count(depth, width), 0, 0 };
+	}
+	constexpr Resources memory_resources(unsigned long long const  depth, unsigned const  width, unsigned long long const  banks, ap_resource_uram const&) {
+		return  { 0, 0, 0, banks * uram288_count(depth, width), 0 };
+	}
+	// the selection of auto_memory_resource evaluated on function arguments
+	template<typename Thresholds>
+	constexpr Resources memory_resources(unsigned long long const  depth, unsigned const  width, unsigned long long const  banks, ap_resource_auto_t<Thresholds> const&) {
+		return  (depth <= Thresholds::LUTRAM_MAX_DEPTH) || (depth*width <= Thresholds::LUTRAM_MAX_BITS)?
+		          memory_resources(depth, width, banks, ap_resource_lutram()) :
+		        uram288_count(depth, width) * Thresholds::URAM_BRAM18_RATIO <= bram18_count(depth, width)?
+		          memory_resources(depth, width, banks, ap_resource_uram()) :
+		          memory_resources(depth, width, banks, ap_resource_bram());
+	}
+	// the choice of the tool is approximated by the automatic selection
+	constexpr Resources memory_resources(unsigned long long const  depth, unsigned const  width, unsigned long long const  banks, ap_resource_dflt const&) {
+		return  memory_resources(depth, width, banks, ap_resource_auto());
+	}
+
+	//- MAC lanes ---------------------------------------------------------
+	// DSP48E2 slices of one product, its 27x18 multiplier tiled for wider operands
+	constexpr unsigned long long dsp_per_mul(unsigned const  a, unsigned const  b) {
+		return  ((a <= 27) && (b <= 18)) || ((a <= 18) && (b <= 27))? 1 :
+		        res_div_up(std::max(a, b), 27) * res_div_up(std::min(a, b), 18);
+	}
+	// the packing condition of dsp_packing::config
+	constexpr bool dsp_packable(unsigned const  a, unsigned const  b) {
+		return  ((2*a + b + 2 <= 27) && (a + 2*b + 2 <= 18)) || ((2*a + b + 2 <= 18) && (a + 2*b + 2 <= 27));
+	}
+
+	// width of a product, a binary weight selecting the input or its negation
+	constexpr unsigned product_bits(unsigned const  in_bits, unsigned const  w_bits) {
+		return  w_bits > 1? in_bits + w_bits : in_bits > 1? in_bits + 1 : 1;
+	}
+
+	/**
+	 * PE dot products of SIMD lanes with their accumulators. The products of
+	 * in_bits x w_bits are summed by a fabric adder tree, except for a DSP48
+	 * cascade, and accumulated in acc_bits.
+	 */
+	template<typename C>
+	constexpr Resources mac_fabric(unsigned const  simd, unsigned const  pe, unsigned const  in_bits, unsigned const  w_bits, unsigned const  acc_bits,
+	                               double const  lane_lut, double const  lane_ff, unsigned long long const  dsp, bool const  tree) {
+		return  {
+			res_ceil(pe * (simd*lane_lut + (tree? C::ADD_LUT*adder_tree_bits(simd, product_bits(in_bits, w_bits)) : 0) + C::ADD_LUT*acc_bits)),
+			res_ceil(pe * (simd*lane_ff  + (tree? C::ADD_FF *adder_tree_bits(simd, product_bits(in_bits, w_bits)) : 0) + C::ADD_FF *acc_bits)),
+			0, 0, dsp
+		};
+	}
+	template<typename C>
+	constexpr Resources mac_resources(unsigned const  simd, unsigned const  pe, unsigned const  in_bits, unsigned const  w_bits, unsigned const  acc_bits, ap_resource_lut const&) {
+		return  mac_fabric<C>(simd, pe, in_bits, w_bits, acc_bits,
+			// binary: XNOR lanes of a popcount, binary weights: negation of the input, other: LUT multiplier
+			(in_bits == 1) && (w_bits == 1)? C::XNOR_LUT : w_bits == 1? C::ADD_LUT*in_bits : C::MUL_LUT*in_bits*w_bits,
+			C::OPERAND_FF*(in_bits + w_bits), 0, true);
+	}
+	template<typename C>
+	constexpr Resources mac_resources(unsigned const  simd, unsigned const  pe, unsigned const  in_bits, unsigned const  w_bits, unsigned const  acc_bits, ap_resource_dsp const&) {
+		return  mac_fabric<C>(simd, pe, in_bits, w_bits, acc_bits, 0, 0, pe * simd * dsp_per_mul(in_bits, w_bits), true);
+	}
+	template<typename C>
+	constexpr Resources mac_resources(unsigned const  simd, unsigned const  pe, unsigned const  in_bits, unsigned const  w_bits, unsigned const  acc_bits, ap_resource_dsp_packed const&) {
+		return  dsp_packable(w_bits, in_bits)?
+			mac_fabric<C>(simd, pe, in_bits, w_bits, acc_bits, 0, 0, pe * res_div_up(simd, 2), true) :
+			mac_resources<C>(simd, pe, in_bits, w_bits, acc_bits, ap_resource_dsp());
+	}
+	template<typename C>
+	constexpr Resources mac_resources(unsigned const  simd, unsigned const  pe, unsigned const  in_bits, unsigned const  w_bits, unsigned const  acc_bits, ap_resource_dsp_cascade const&) {
+		return  dsp_per_mul(in_bits, w_bits) == 1?
+			mac_fabric<C>(simd, pe, in_bits, w_bits, acc_bits, 0, 0, pe * simd, false) :
+			mac_resources<C>(simd, pe, in_bits, w_bits, acc_bits, ap_resource_dsp());
+	}
+	template<typename C>
+	constexpr Resources mac_resources(unsigned const  simd, unsigned const  pe, unsigned const  in_bits, unsigned const  w_bits, unsigned const  acc_bits, ap_resource_dflt const&) {
+		return  in_bits + w_bits <= C::DFLT_LUT_MAX_BITS?
+			mac_resources<C>(simd, pe, in_bits, w_bits, acc_bits, ap_resource_lut()) :
+			mac_resources<C>(simd, pe, in_bits, w_bits, acc_bits, ap_resource_dsp());
+	}
+
+	// comparators of NumTH thresholds of ta_bits for each of PE lanes with their memory banks of NF thresholds
+	template<typename C>
+	constexpr Resources threshold_resources(unsigned const  nf, unsigned const  pe, unsigned const  num_th, unsigned const  ta_bits, unsigned const  comparators) {
+		return  memory_resources(nf, ta_bits, (unsigned long long)pe * num_th, ap_resource_dflt()) + Resources {
+			res_ceil(pe * (C::CMP_LUT*comparators*ta_bits + C::ADD_LUT*adder_tree_bits(comparators, 1))),
+			res_ceil(pe * C::ADD_FF*clog2(num_th+1)),
+			0, 0, 0
+		};
+	}
+
+} // namespace detail
+
+/**
+ * \brief   Precision of the weights held by a weight storage class
+ *
+ * Specialized for the storage classes of weights.hpp whose MAC lanes are estimated.
+ */
+template<typename TW>
+struct weight_precision {};
+template<unsigned SIMD, unsigned PE, unsigned TILES>
+struct weight_precision<BinaryWeights<SIMD, PE, TILES>> : std::integral_constant<unsigned, 1> {};
+template<unsigned SIMD, unsigned PE, unsigned TILES, unsigned PE_PER_WORD>
+struct weight_precision<PackedBinaryWeights<SIMD, PE, TILES, PE_PER_WORD>> : std::integral_constant<unsigned, 1> {};
+template<unsigned SIMD, typename WT, unsigned PE, unsigned TILES>
+struct weight_precision<FixedPointWeights<SIMD, WT, PE, TILES>> : std::integral_constant<unsigned, WT::width> {};
+template<unsigned SIMD, typename WT, unsigned PE, unsigned TILES, unsigned PE_PER_WORD>
+struct weight_precision<PackedFixedPointWeights<SIMD, WT, PE, TILES, PE_PER_WORD>> : std::integral_constant<unsigned, WT::width> {};
+
+/**
+ * \brief   Resources of the activation of an MVAU or of Thresholding_Batch
+ *
+ * Activations without parameters, such as PassThroughActivation, are free. The
+ * thresholds of a ThresholdsActivation are taken to be partitioned completely
+ * along the PE and the threshold dimensions, as in the testbenches, and are
+ * compared all at once. ThresholdsActivationBinarySearch compares one threshold
+ * per search stage.
+ */
+template<typename TA, typename Coeffs = resource_coefficients>
+struct activation_resources {
+	static constexpr Resources value() { return  { 0, 0, 0, 0, 0 }; }
+};
+template<unsigned NF, unsigned PE, unsigned NumTH, typename TA, typename TR, int ActVal, typename Compare, typename Coeffs>
+struct activation_resources<ThresholdsActivation<NF, PE, NumTH, TA, TR, ActVal, Compare>, Coeffs> {
+	static constexpr Resources value() { return  detail::threshold_resources<Coeffs>(NF, PE, NumTH, TA::width, NumTH); }
+};
+template<unsigned NF, unsigned PE, unsigned NumTH, typename TA, typename TR, int ActVal, typename Compare, typename Coeffs>
+struct activation_resources<ThresholdsActivationBinarySearch<NF, PE, NumTH, TA, TR, ActVal, Compare>, Coeffs> {
+	static constexpr Resources value() { return  detail::threshold_resources<Coeffs>(NF, PE, NumTH, TA::width, clog2(NumTH+1)); }
+};
+
+//- MVAU ----------------------------------------------------------------------
+
+/**
+ * \brief Resources of Matrix_Vector_Activate_Stream_Batch, with the weights streamed in
+ *
+ * \tparam MatrixW	Width of the input matrix
+ * \tparam MatrixH	Heigth of the input matrix
+ * \tparam SIMD		Number of input columns computed in parallel
+ * \tparam PE		Number of output rows computed in parallel
+ * \tparam InputBits	Precision of an input element
+ * \tparam WeightBits	Precision of a weight
+ * \tparam AccBits	Precision of the accumulator
+ * \tparam TA		Activation class, see activation_resources
+ * \tparam R		Resource type of the MAC lanes
+ * \tparam Coeffs	Coefficients of the logic estimates, see resource_coefficients
+ */
+template<
+	unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE,
+	unsigned InputBits, unsigned WeightBits, unsigned AccBits, typename TA, typename R,
+	typename Coeffs = resource_coefficients
+>
+constexpr Resources Matrix_Vector_Activate_Stream_Batch_resources() {
+	static_assert((MatrixW % SIMD == 0) && (MatrixH % PE == 0), "SIMD and PE must divide the matrix dimensions.");
+	return  detail::mac_resources<Coeffs>(SIMD, PE, InputBits, WeightBits, AccBits, R()) +
+	        activation_resources<TA, Coeffs>::value() +
+	        Resources { Coeffs::MVAU_LUT, Coeffs::MVAU_FF, 0, 0, 0 };
+}
+
+/**
+ * \brief Resources of Matrix_Vector_Activate_Batch, including its weight memory
+ *
+ * The weight memory is counted from the geometry of the m_weights array of the
+ * storage class, its outer dimensions being partitioned into banks, and is
+ * mapped as by the tool default approximated by ap_resource_auto.
+ *
+ * \tparam MatrixW	Width of the input matrix
+ * \tparam MatrixH	Heigth of the input matrix
+ * \tparam SIMD		Number of input columns computed in parallel
+ * \tparam PE		Number of output rows computed in parallel
+ * \tparam InputBits	Precision of an input element
+ * \tparam AccBits	Precision of the accumulator
+ * \tparam TW		Weight storage class, e.g. BinaryWeights or FixedPointWeights
+ * \tparam TA		Activation class, see activation_resources
+ * \tparam R		Resource type of the MAC lanes
+ * \tparam Coeffs	Coefficients of the logic estimates, see resource_coefficients
+ */
+template<
+	unsigned MatrixW, unsigned MatrixH, unsigned SIMD, unsigned PE,
+	unsigned InputBits, unsigned AccBits, typename TW, typename TA, typename R,
+	typename Coeffs = resource_coefficients
+>
+constexpr Resources Matrix_Vector_Activate_Batch_resources() {
+	using  geometry = memory_geometry<decltype(TW::m_weights)>;
+	static_assert(geometry::depth * SIMD * PE == 1ull * MatrixW * MatrixH, "Weight storage does not match the matrix and its folding.");
+	return  Matrix_Vector_Activate_Stream_Batch_resources<MatrixW, MatrixH, SIMD, PE, InputBits, weight_precision<TW>::value, AccBits, TA, R, Coeffs>() +
+	        detail::memory_resources(geometry::depth, geometry::width, geometry::banks, ap_resource_dflt());
+}
+
+/**
+ * \brief Resources of Thresholding_Batch
+ *
+ * \tparam TA		Activation class, see activation_resources
+ * \tparam Coeffs	Coefficients of the logic estimates, see resource_coefficients
+ */
+template<typename TA, typename Coeffs = resource_coefficients>
+constexpr Resources Thresholding_Batch_resources() {
+	return  activation_resources<TA, Coeffs>::value() + Resources { Coeffs::MVAU_LUT/2, Coeffs::MVAU_FF/2, 0, 0, 0 };
+}
+
+//- Sliding Window Generators -------------------------------------------------
+
+/**
+ * \brief Resources of a buffer array bound to the memory resource R
+ *
+ * The innermost dimension of the array is the depth of a memory bank, the outer
+ * dimensions are taken to be partitioned, see memory_geometry.
+ *
+ * \tparam T		Type of the buffer array, e.g. ap_uint<32>[4][256]
+ * \tparam R		Memory resource as passed to memory_resource
+ */
+template<typename T, typename R = ap_resource_dflt>
+constexpr Resources memory_buffer_resources() {
+	return  detail::memory_resources(memory_geometry<T>::depth, memory_geometry<T>::width, memory_geometry<T>::banks, R());
+}
+
+/**
+ * \brief Resources of ConvolutionInputGenerator and ConvolutionInputGenerator_Grouped
+ *
+ * \tparam ConvKernelDim	Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels		Number of Input Feature Maps
+ * \tparam Input_precision	Number bits per pixel
+ * \tparam IFMDim		Width and Heigth of the Input Feature Map (assumed square)
+ * \tparam OFMDim		Width and Heigth of the Output Feature Map (assumed square)
+ * \tparam SIMD			Number of input columns computed in parallel
+ * \tparam Stride		Stride of the convolutional kernel
+ * \tparam R			Memory resource of the buffer
+ * \tparam Coeffs		Coefficients of the logic estimates, see resource_coefficients
+ */
+template<
+	unsigned ConvKernelDim, unsigned IFMChannels, unsigned Input_precision, unsigned IFMDim, unsigned OFMDim,
+	unsigned SIMD, unsigned Stride = 1, typename R = ap_resource_dflt,
+	typename Coeffs = resource_coefficients
+>
+constexpr Resources ConvolutionInputGenerator_resources() {
+	static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+	static_assert(ConvKernelDim % Stride == 0, "Stride must divide ConvKernelDim.");
+	using  buffer_t = ap_uint<SIMD*Input_precision>[ConvKernelDim/Stride + 1][Stride * IFMDim * (IFMChannels/SIMD)];
+	return  memory_buffer_resources<buffer_t, R>() +
+	        Resources { Coeffs::SWG_LUT, Coeffs::SWG_FF + SIMD*Input_precision, 0, 0, 0 };
+}
+
+//- FIFOs ---------------------------------------------------------------------
+
+/**
+ * \brief Resources of a FIFO of Depth words of Width bits, as of a stream depth pragma
+ *
+ * FIFOs of at most FIFO_SRL_MAX_BITS are implemented in SRL32 shift registers,
+ * larger ones in the memory chosen by ap_resource_auto.
+ *
+ * \tparam Width	Width of a word
+ * \tparam Depth	Number of words
+ * \tparam Coeffs	Coefficients of the logic estimates, see resource_coefficients
+ */
+template<unsigned Width, unsigned Depth, typename Coeffs = resource_coefficients>
+constexpr Resources StreamingFIFO_resources() {
+	return  Resources { Coeffs::FIFO_LUT, Coeffs::FIFO_FF + Width, 0, 0, 0 } + (
+		1ull * Width * Depth <= Coeffs::FIFO_SRL_MAX_BITS?
+			Resources { 1ull * Width * detail::res_div_up(Depth, 32), 0, 0, 0, 0 } :
+			detail::memory_resources(Depth, Width, 1, ap_resource_auto())
+	);
+}
+
+//- Folding -------------------------------------------------------------------
+
+/**
+ * \brief Folding of Matrix_Vector_Activate_Batch within a resource budget
+ *
+ * As Matrix_Vector_Activate_Batch_folding but limited to the foldings whose
+ * resources, including a FixedPointWeights memory of WeightBits, fit the budget:
+ * meets is only set for a folding within the target and the budget. If no
+ * folding fits, the unconstrained choice is returned.
+ *
+ * \tparam MatrixW	Width of the input matrix
+ * \tparam MatrixH	Heigth of the input matrix
+ * \tparam InputBits	Precision of an input element
+ * \tparam WeightBits	Precision of a weight
+ * \tparam AccBits	Precision of the accumulator
+ * \tparam R		Resource type of the MAC lanes
+ * \tparam MaxSIMD	Upper limit of the SIMD parallelism
+ * \tparam MaxPE	Upper limit of the PE parallelism
+ * \tparam Coeffs	Coefficients of the logic estimates, see resource_coefficients
+ *
+ * \param target	Target number of cycles per frame
+ * \param budget	Resources available to the layer
+ * \param vectors	Number of input vectors per frame
+ */
+template<
+	unsigned MatrixW, unsigned MatrixH, unsigned InputBits, unsigned WeightBits, unsigned AccBits, typename R,
+	unsigned MaxSIMD = MatrixW, unsigned MaxPE = MatrixH, typename Coeffs = resource_coefficients
+>
+constexpr Folding Matrix_Vector_Activate_Batch_folding_fit(cycles_t const  target, Resources const &budget, unsigned const  vectors = 1) {
+	static_assert((MaxSIMD > 0) && (MaxPE > 0), "Parallelism limits must be positive.");
+	Folding  best = Matrix_Vector_Activate_Batch_folding<MatrixW, MatrixH, MaxSIMD, MaxPE>(target, vectors);
+	bool  best_fits = false;
+	for(unsigned  simd = 1; simd <= std::min(MatrixW, MaxSIMD); simd++) {
+		if(MatrixW % simd != 0)  continue;
+		for(unsigned  pe = 1; pe <= std::min(MatrixH, MaxPE); pe++) {
+			if(MatrixH % pe != 0)  continue;
+			Resources const  res = detail::mac_resources<Coeffs>(simd, pe, InputBits, WeightBits, AccBits, R()) +
+				detail::memory_resources(MatrixW/simd * (MatrixH/pe), simd*WeightBits, pe, ap_resource_dflt()) +
+				Resources { Coeffs::MVAU_LUT, Coeffs::MVAU_FF, 0, 0, 0 };
+			if(!res.fits(budget))  continue;
+			cycles_t const  cycles = detail::mvau_cycles(MatrixW, MatrixH, simd, pe, vectors);
+			Folding const  cand { simd, pe, 1, cycles, cycles <= target };
+			if(!best_fits || detail::folding_better(cand, best)) {
+				best = cand;
+				best_fits = true;
+			}
+		}
+	}
+	if(!best_fits)  best.meets = false;
+	return  best;
+}
+
+#endif
@@ -52,91 +52,6 @@
 #include <algorithm>
 #include "utils.hpp"
 
-/**
- * \brief     Memory resource pragma instantiation for the sliding window generator, default resource
- * 
- * The buffer in the sliding window generator can be implemented in multiple hardware resources. 
- * 
- * ap_resource_dflt will let HLS choose the best one
- * ap_resource_bram will force HLS to implement the buffer in BRAMs
- * ap_resource_uram will force HLS to implement the buffer in URAMs
- * ap_resource_lutram will force HLS to implement the buffer in LUTRAMs
- *
- * \tparam     T		Datatype of the buffer instantiated in the sliding window generator
- * 
- * \param      inputBuf	Buffer used in the SWG
- * \param      r     	Resource type for the hardware implementation
- *
- * \return     Result of the multiply operation
- */
-template <typename T>
-void memory_resource(T inputBuf, ap_resource_dflt const&){
-#pragma HLS BIND_STORAGE variable=inputBuf type=RAM_2P
-}
-/**
- * \brief     Memory resource pragma instantiation for the sliding window generator, BRAM resource
- * 
- * The buffer in the sliding window generator can be implemented in multiple hardware resources. 
- * 
- * ap_resource_dflt will let HLS choose the best one
- * ap_resource_bram will force HLS to implement the buffer in BRAMs
- * ap_resource_uram will force HLS to implement the buffer in URAMs
- * ap_resource_lutram will force HLS to implement the buffer in LUTRAMs
- *
- * \tparam     T		Datatype of the buffer instantiated in the sliding window generator
- * 
- * \param      inputBuf	Buffer used in the SWG
- * \param      r     	Resource type for the hardware implementation
- *
- * \return     Result of the multiply operation
- */
-template <typename T>
-void memory_resource(T inputBuf, ap_resource_bram const&){
-#pragma HLS BIND_STORAGE variable=inputBuf type=RAM_S2P impl=BRAM
-}
-/**
- * \brief     Memory resource pragma instantiation for the sliding window generator, URAM resource
- * 
- * The buffer in the sliding window generator can be implemented in multiple hardware resources. 
- * 
- * ap_resource_dflt will let HLS choose the best one
- * ap_resource_bram will force HLS to implement the buffer in BRAMs
- * ap_resource_uram will force HLS to implement the buffer in URAMs
- * ap_resource_lutram will force HLS to implement the buffer in LUTRAMs
- *
- * \tparam     T		Datatype of the buffer instantiated in the sliding window generator
- * 
- * \param      inputBuf	Buffer used in the SWG
- * \param      r     	Resource type for the hardware implementation
- *
- * \return     Result of the multiply operation
- */
-template <typename T>
-void memory_resource(T inputBuf, ap_resource_uram const&){
-#pragma HLS BIND_STORAGE variable=inputBuf type=RAM_S2P impl=URAM
-}
-/**
- * \brief     Memory resource pragma instantiation for the sliding window generator, LUTRAM resource
- * 
- * The buffer in the sliding window generator can be implemented in multiple hardware resources. 
- * 
- * ap_resource_dflt will let HLS choose the best one
- * ap_resource_bram will force HLS to implement the buffer in BRAMs
- * ap_resource_uram will force HLS to implement the buffer in URAMs
- * ap_resource_lutram will force HLS to implement the buffer in LUTRAMs
- *
- * \tparam     T		Datatype of the buffer instantiated in the sliding window generator
- * 
- * \param      inputBuf	Buffer used in the SWG
- * \param      r     	Resource type for the hardware implementation
- *
- * \return     Result of the multiply operation
- */
-template <typename T>
-void memory_resource(T inputBuf, ap_resource_lutram const&){
-#pragma HLS BIND_STORAGE variable=inputBuf type=RAM_S2P impl=LUTRAM
-}
-
 /**
  * \brief Sliding Window unit that produces output vectors for feeding
  * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm. To be used only if 
@@ -172,6 +87,8 @@ void ConvolutionInputGenerator(
   static_assert(IFMChannels % SIMD == 0, "");
   static_assert(ConvKernelDim % Stride == 0, "");
   const unsigned int multiplying_factor = IFMChannels/SIMD;
+  FINN_STREAM_CHECK_IN(in, 1ull * numReps * IFMDim * IFMDim * multiplying_factor);
+  FINN_STREAM_CHECK_OUT(out, 1ull * numReps * OFMDim * OFMDim * ConvKernelDim * ConvKernelDim * multiplying_factor);
   const unsigned int number_blocks = ConvKernelDim/Stride + 1 ;
   ap_uint<SIMD*Input_precision> inputBuf[number_blocks][Stride * IFMDim * multiplying_factor];
 #pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=1
@@ -264,6 +181,1047 @@ void ConvolutionInputGenerator(
   } // End count_image
 } // End generator
 
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Matrix_Vector_Activate_Grouped_Batch, implementing the im2col algorithm for a grouped convolution.
+ * To be used only if ConvKernelDim%Stride = 0
+ *
+ * Works as ConvolutionInputGenerator, but emits the window of every output pixel group by group: the
+ * ConvKernelDim x ConvKernelDim taps of the IFMChannels/Groups channels of the first group, then those of
+ * the second group and so on. Each group thus forms a contiguous input vector for the weights of its group.
+ *
+ * \tparam ConvKernelDim    Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels      Number of Input Feature Maps
+ * \tparam Groups           Number of channel groups, dividing IFMChannels
+ * \tparam Input_precision  Number bits per pixel
+ * \tparam IFMDim           Width and Heigth of the Input Feature Map (assumed square)
+ * \tparam OFMDim           Width and Heigth of the Output Feature Map (assumed square)
+ * \tparam SIMD             Number of input columns computed in parallel
+ * \tparam Stride           Stride of the convolutional kernel
+ * \tparam R          	  Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the paramaters
+ *
+ * \param in                Input stream
+ * \param out               Output stream
+ * \param numReps           Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  Resource type for the hardware implementation of the memory block
+ */
+template<unsigned int ConvKernelDim, 
+		 unsigned int IFMChannels,
+		 unsigned int Groups,
+		 unsigned int Input_precision,		
+		 unsigned int IFMDim, 
+		 unsigned int OFMDim,
+		 unsigned int SIMD,
+		 unsigned int Stride, 
+		 typename R>  
+void ConvolutionInputGenerator_Grouped(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<ap_uint<SIMD*Input_precision> > & out,
+		const unsigned int numReps,
+		R const &r) {
+  static_assert(IFMChannels % Groups == 0, "Groups must divide IFMChannels.");
+  static_assert((IFMChannels / Groups) % SIMD == 0, "SIMD must divide the channels of a group.");
+  static_assert(ConvKernelDim % Stride == 0, "");
+  const unsigned int multiplying_factor = IFMChannels/SIMD;
+  // SIMD words of a group in a pixel
+  const unsigned int group_factor = multiplying_factor/Groups;
+  const unsigned int number_blocks = ConvKernelDim/Stride + 1 ;
+  ap_uint<SIMD*Input_precision> inputBuf[number_blocks][Stride * IFMDim * multiplying_factor];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=1
+  memory_resource(inputBuf, r);
+  const unsigned int cycles_write_block = (OFMDim * ConvKernelDim * ConvKernelDim * multiplying_factor);
+  const unsigned int cycles_read_block = Stride * IFMDim * multiplying_factor;
+  const unsigned int max_cycles = std::max(cycles_write_block,cycles_read_block);
+  const unsigned int baseIter = IFMDim * ConvKernelDim * multiplying_factor// Initial buffer
+			                  + OFMDim * std::max(cycles_write_block,cycles_read_block);
+  unsigned int counter_internal_block = 0;
+  unsigned int current_block_write = 0;
+  unsigned int current_line = 0;
+  unsigned int read_block = 0; 
+  unsigned int inp = 0, ofm_y = 0, ofm_x = 0, group = 0, k_y = 0, k_x = 0, count_simd =0;
+
+  for (unsigned int count_image = 0; count_image < numReps; count_image++) {
+    for (unsigned int i = 0; i < baseIter; i++) {
+#pragma HLS pipeline style=flp II=1
+      if (inp < IFMDim * ConvKernelDim*multiplying_factor) {// Initial buffer of ConvKernelDim lines	
+        ap_uint<SIMD*Input_precision> inElem;
+        inElem = in.read();
+        inputBuf[current_block_write][current_line] = inElem;
+        current_line++;
+        inp++;
+        if (current_line == Stride * IFMDim * multiplying_factor ) {
+          current_line = 0;
+          current_block_write++;
+          if (current_block_write == number_blocks) {
+            current_block_write=0;
+          }
+          read_block++;
+          counter_internal_block = 0;
+        }
+      } else {
+        if (counter_internal_block < cycles_write_block-1) { // We are writing output, MMV IFMChan per cycle
+          unsigned int current_block_read = (current_block_write + 1 + k_y / Stride);
+          if (current_block_read >= number_blocks) {
+            current_block_read-= number_blocks;
+		  }
+          unsigned int current_line_in_block = ((k_y%Stride) * IFMDim + ofm_x*Stride + k_x)*multiplying_factor + group*group_factor + count_simd;
+          ap_uint<SIMD*Input_precision> outElem = inputBuf[current_block_read][(current_line_in_block)];
+          out.write(outElem);
+          count_simd++;
+          if (count_simd == group_factor) {
+            count_simd=0;
+            k_x++;
+            if (k_x == ConvKernelDim) {
+              k_x = 0;
+              k_y++;
+              if (k_y == ConvKernelDim) {
+                k_y = 0;
+                group++;
+                if (group == Groups) {
+                  group = 0;
+                  ofm_x ++;
+                  if (ofm_x == OFMDim) {
+                    ofm_x = 0;
+                    ofm_y++;
+                    if (ofm_y == OFMDim) {
+                      ofm_y = 0;
+                      inp = 0;
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+        if ((counter_internal_block < cycles_read_block-1) && (read_block<IFMDim/Stride)) { // In parallel we write in the buffer, in the current block write if we still need to
+          ap_uint<SIMD*Input_precision> inElem;
+          inElem = in.read();
+          inputBuf[current_block_write][current_line] = inElem;
+#pragma AP dependence variable=inputBuf intra false
+#pragma AP dependence variable=inputBuf inter false
+          current_line++;
+          if (current_line == Stride * IFMDim * multiplying_factor) {// We read the whole block, we change the next block in which we want to we
+            // We filled up a block, let's not read until
+            current_line = 0;
+            read_block++;
+            current_block_write++;
+            if (current_block_write == number_blocks) {
+              current_block_write=0;
+			}
+#pragma AP dependence variable=current_block_write intra false	
+          }
+        }
+        counter_internal_block++; // = (counter_internal_block +1) % max_cycles;
+        if (counter_internal_block == (max_cycles-1)) {
+          counter_internal_block = 0;
+        }
+      }
+    } // End base_iter
+	read_block = 0;
+  } // End count_image
+} // End generator
+
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm with a minimal line buffer and
+ * padding generated on the fly
+ *
+ * The output order is the one of ConvolutionInputGenerator applied to the padded feature map. Only the
+ * IFMDim x IFMDim pixels of the unpadded input are read and buffered, the taps falling into the padding
+ * are filled with PadValue as they are emitted, so no FMPadding_Batch stage is needed upstream.
+ *
+ * Instead of ConvKernelDim/Stride + 1 blocks of Stride rows, only (ConvKernelDim-1) rows plus
+ * ConvKernelDim + Stride pixels are buffered in a circular buffer. A window is emitted as soon as its
+ * last pixel inside the input has been read, while the input is read ahead as far as the buffer allows.
+ * The windows are read directly from the buffer rather than from a register cache, so the register
+ * count does not grow with the number of channels. Any Stride is supported, pixels not covered by any
+ * window are consumed and dropped.
+ *
+ * \tparam ConvKernelDim    Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels      Number of Input Feature Maps
+ * \tparam Input_precision  Number bits per pixel
+ * \tparam IFMDim           Width and Heigth of the unpadded Input Feature Map (assumed square)
+ * \tparam OFMDim           Width and Heigth of the Output Feature Map (assumed square)
+ * \tparam SIMD             Number of input columns computed in parallel
+ * \tparam Stride           Stride of the convolutional kernel
+ * \tparam PadTop           Number of padding rows above the input
+ * \tparam PadBottom        Number of padding rows below the input
+ * \tparam PadLeft          Number of padding columns left of the input
+ * \tparam PadRight         Number of padding columns right of the input
+ * \tparam PadValue         Value of the padding elements
+ * \tparam R          	  Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the paramaters
+ *
+ * \param in                Input stream
+ * \param out               Output stream
+ * \param numReps           Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  Resource type for the hardware implementation of the memory block
+ */
+template<unsigned int ConvKernelDim,
+		 unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int IFMDim,
+		 unsigned int OFMDim,
+		 unsigned int SIMD,
+		 unsigned int Stride,
+		 unsigned int PadTop,
+		 unsigned int PadBottom,
+		 unsigned int PadLeft,
+		 unsigned int PadRight,
+		 int PadValue = 0,
+		 typename R>
+void ConvolutionInputGenerator_Padded(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<ap_uint<SIMD*Input_precision> > & out,
+		const unsigned int numReps,
+		R const &r) {
+  static_assert(IFMChannels % SIMD == 0, "");
+  static_assert(IFMDim + PadTop + PadBottom >= (OFMDim-1)*Stride + ConvKernelDim, "Vertical padding too small for OFMDim.");
+  static_assert(IFMDim + PadLeft + PadRight >= (OFMDim-1)*Stride + ConvKernelDim, "Horizontal padding too small for OFMDim.");
+  constexpr unsigned int multiplying_factor = IFMChannels/SIMD;
+  // distance from the bottom-right to the top-left pixel of a window
+  constexpr unsigned int window_span = (ConvKernelDim-1)*IFMDim + ConvKernelDim-1;
+  // buffered pixels: the window plus the Stride pixels read ahead
+  constexpr unsigned int buffer_pixels = window_span + 1 + Stride;
+  constexpr unsigned int in_pixels = IFMDim * IFMDim;
+  constexpr unsigned int out_words = OFMDim * OFMDim * ConvKernelDim * ConvKernelDim * multiplying_factor;
+  // buffer slot increments to the next kernel row, the next window and the first window of the next row,
+  // which may be negative with padding
+  constexpr int tap_row_step = int(IFMDim) - int(ConvKernelDim) + 1;
+  constexpr int row_step = int(Stride * IFMDim) - int((OFMDim-1) * Stride);
+  constexpr unsigned int tap_row_slot_step = ((tap_row_step % int(buffer_pixels)) + int(buffer_pixels)) % buffer_pixels;
+  constexpr unsigned int win_slot_step = Stride % buffer_pixels;
+  constexpr unsigned int row_slot_step = ((row_step % int(buffer_pixels)) + int(buffer_pixels)) % buffer_pixels;
+  // buffer slot of the (virtual) top-left pixel of the first window
+  constexpr int first_pixel = -int(PadTop*IFMDim + PadLeft);
+  constexpr unsigned int first_slot = ((first_pixel % int(buffer_pixels)) + int(buffer_pixels)) % buffer_pixels;
+  ap_uint<SIMD*Input_precision> inputBuf[buffer_pixels * multiplying_factor];
+  memory_resource(inputBuf, r);
+
+  ap_uint<SIMD*Input_precision> padElem;
+  for (unsigned int simd = 0; simd < SIMD; simd++) {
+#pragma HLS UNROLL
+    padElem((simd+1)*Input_precision-1, simd*Input_precision) = PadValue;
+  }
+
+  for (unsigned int count_image = 0; count_image < numReps; count_image++) {
+    // reader state
+    unsigned int rd_pix = 0, rd_slot = 0, rd_simd = 0;
+    // emitter state: top-left corner of the current window in input coordinates and its buffer slot
+    int win_y = -int(PadTop), win_x = -int(PadLeft);
+    unsigned int win_slot = first_slot;
+    unsigned int ofm_x = 0, k_x = 0, k_y = 0, count_simd = 0;
+    unsigned int slot = first_slot; // buffer slot of the current window pixel
+    unsigned int written = 0;
+    while ((rd_pix < in_pixels) || (written < out_words)) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=inputBuf inter false
+#pragma HLS DEPENDENCE variable=inputBuf intra false
+      // first and last pixel of the current window inside the input, while the window still reaches into
+      // the top padding the next window row may start again at the first input pixel
+      int const first_y = win_y < 0? 0 : win_y;
+      int const first_x = (win_y < 0) || (win_x < 0)? 0 : win_x;
+      int const last_y = win_y + int(ConvKernelDim) > int(IFMDim)? int(IFMDim)-1 : win_y + int(ConvKernelDim)-1;
+      int const last_x = win_x + int(ConvKernelDim) > int(IFMDim)? int(IFMDim)-1 : win_x + int(ConvKernelDim)-1;
+      int const first_pix = first_y*int(IFMDim) + first_x;
+      int const last_pix = last_y*int(IFMDim) + last_x;
+
+      // emit the current window once its last pixel is available
+      if ((written < out_words) && (int(rd_pix) > last_pix)) {
+        int const y = win_y + int(k_y);
+        int const x = win_x + int(k_x);
+        bool const inside = (y >= 0) && (y < int(IFMDim)) && (x >= 0) && (x < int(IFMDim));
+        ap_uint<SIMD*Input_precision> const bufElem = inputBuf[slot * multiplying_factor + count_simd];
+        out.write(inside? bufElem : padElem);
+        written++;
+        count_simd++;
+        if (count_simd == multiplying_factor) {
+          count_simd = 0;
+          // advance to the next window pixel
+          slot += (k_x == ConvKernelDim-1)? tap_row_slot_step : 1;
+          if (slot >= buffer_pixels) {
+            slot -= buffer_pixels;
+          }
+          k_x++;
+          if (k_x == ConvKernelDim) {
+            k_x = 0;
+            k_y++;
+            if (k_y == ConvKernelDim) {
+              k_y = 0;
+              // advance to the next window
+              ofm_x++;
+              if (ofm_x == OFMDim) {
+                ofm_x = 0;
+                win_x = -int(PadLeft);
+                win_y += Stride;
+                win_slot += row_slot_step;
+              } else {
+                win_x += Stride;
+                win_slot += win_slot_step;
+              }
+              if (win_slot >= buffer_pixels) {
+                win_slot -= buffer_pixels;
+              }
+              slot = win_slot;
+            }
+          }
+        }
+      }
+      // read ahead as long as no pixel of the current window is overwritten
+      if ((rd_pix < in_pixels) && ((written == out_words) || (int(rd_pix) < first_pix + int(buffer_pixels)))) {
+        ap_uint<SIMD*Input_precision> inElem = in.read();
+        inputBuf[rd_slot * multiplying_factor + rd_simd] = inElem;
+        rd_simd++;
+        if (rd_simd == multiplying_factor) {
+          rd_simd = 0;
+          rd_pix++;
+          rd_slot++;
+          if (rd_slot == buffer_pixels) {
+            rd_slot = 0;
+          }
+        }
+      }
+    }
+  } // End count_image
+} // End generator
+
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm with a minimal line buffer
+ *
+ * The output order is the one of ConvolutionInputGenerator. Instead of ConvKernelDim/Stride + 1 blocks of
+ * Stride rows, only (ConvKernelDim-1) rows plus ConvKernelDim + Stride pixels are buffered. This is
+ * ConvolutionInputGenerator_Padded without padding, see there for details.
+ *
+ * \tparam ConvKernelDim    Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels      Number of Input Feature Maps
+ * \tparam Input_precision  Number bits per pixel
+ * \tparam IFMDim           Width and Heigth of the Input Feature Map (assumed square)
+ * \tparam OFMDim           Width and Heigth of the Output Feature Map (assumed square)
+ * \tparam SIMD             Number of input columns computed in parallel
+ * \tparam Stride           Stride of the convolutional kernel
+ * \tparam R          	  Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the paramaters
+ *
+ * \param in                Input stream
+ * \param out               Output stream
+ * \param numReps           Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  Resource type for the hardware implementation of the memory block
+ */
+template<unsigned int ConvKernelDim,
+		 unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int IFMDim,
+		 unsigned int OFMDim,
+		 unsigned int SIMD,
+		 unsigned int Stride,
+		 typename R>
+void ConvolutionInputGenerator_LineBuffer(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<ap_uint<SIMD*Input_precision> > & out,
+		const unsigned int numReps,
+		R const &r) {
+#pragma HLS INLINE
+  ConvolutionInputGenerator_Padded<ConvKernelDim, IFMChannels, Input_precision, IFMDim, OFMDim, SIMD, Stride,
+    0, 0, 0, 0>(in, out, numReps, r);
+}
+
+/**
+ * \brief Window of one branch of ConvolutionInputGenerator_Shared
+ *
+ * \tparam Kernel     Dimension of the convolutional kernel (assumed square)
+ * \tparam Stride     Stride of the convolutional kernel
+ * \tparam Pad        Number of padding rows and columns on every side, by default the "same" padding
+ * \tparam PadValue   Value of the padding elements
+ */
+template<unsigned int Kernel, unsigned int Stride = 1, unsigned int Pad = (Kernel-1)/2, int PadValue = 0>
+struct SWGWindow {
+  static_assert(Stride > 0, "Stride must be positive.");
+  static_assert(Pad < Kernel, "Padding must leave every window a pixel of the input.");
+  static constexpr unsigned int  kernel = Kernel;
+  static constexpr unsigned int  stride = Stride;
+  static constexpr unsigned int  pad = Pad;
+  static constexpr int  pad_value = PadValue;
+
+  /** Width and height of the output feature map of the branch */
+  static constexpr unsigned int ofm_dim(unsigned int const  ifm_dim) {
+    return  (ifm_dim + 2*Pad - Kernel) / Stride + 1;
+  }
+};
+
+/**
+ * \brief Cumulative receptive field of a chain of sliding windows, the first one applied first
+ *
+ * An output pixel o of the chain depends on the size input pixels starting at o*jump - pad.
+ *
+ * \tparam Windows    SWGWindow of every layer of the chain
+ */
+template<typename... Windows>
+struct ReceptiveField {
+  static constexpr unsigned int  size = 1;
+  static constexpr unsigned int  jump = 1;
+  static constexpr unsigned int  pad = 0;
+
+  static constexpr unsigned int ofm_dim(unsigned int const  ifm_dim) {
+    return  ifm_dim;
+  }
+  static constexpr unsigned int ifm_dim(unsigned int const  ofm_dim) {
+    return  ofm_dim;
+  }
+};
+
+template<typename W, typename... Windows>
+struct ReceptiveField<W, Windows...> {
+  using  Tail = ReceptiveField<Windows...>;
+  static constexpr unsigned int  size = W::kernel + (Tail::size - 1) * W::stride;
+  static constexpr unsigned int  jump = W::stride * Tail::jump;
+  static constexpr unsigned int  pad = W::pad + Tail::pad * W::stride;
+
+  /** Width and height of the output feature map of the chain */
+  static constexpr unsigned int ofm_dim(unsigned int const  ifm_dim) {
+    return  Tail::ofm_dim(W::ofm_dim(ifm_dim));
+  }
+
+  /** Width and height of the input feature map, without padding, yielding an output feature map of ofm_dim */
+  static constexpr unsigned int ifm_dim(unsigned int const  ofm_dim) {
+    return  (ofm_dim - 1) * jump + size;
+  }
+};
+
+namespace detail {
+
+constexpr unsigned int swg_mod(int const  a, unsigned int const  m) {
+  return  ((a % int(m)) + int(m)) % m;
+}
+
+template<unsigned int N>
+constexpr unsigned int swg_max(unsigned int const (&a)[N]) {
+  unsigned int  m = 0;
+  for (unsigned int i = 0; i < N; i++) {
+    if (a[i] > m)  m = a[i];
+  }
+  return  m;
+}
+
+} // namespace detail
+
+/**
+ * \brief Sliding Window unit that produces the output vectors of several convolutions of the same input,
+ * e.g. the parallel branches of an Inception block, from a single line buffer
+ *
+ * Every branch is described by a SWGWindow and gets its own output stream, whose order is the one of
+ * ConvolutionInputGenerator_Padded with the padding of the branch on all sides. Instead of one copy of
+ * the input per branch from DuplicateStreams and a line buffer for each of their generators, only the
+ * circular buffer of ConvolutionInputGenerator_Padded for the largest kernel and stride is kept, and the
+ * windows of all branches are read from it, so the branch windows are sub-windows of the largest one.
+ *
+ * One output word is emitted per cycle, from the first branch with a complete window. The input is read
+ * ahead as long as no pixel of the window of the lagging branch is overwritten, so the branches may run
+ * up to a buffer apart and their consumers should be decoupled by FIFOs before they are joined again.
+ * A frame takes about as many cycles as all branches have output words together.
+ *
+ * \tparam IFMChannels      Number of Input Feature Maps
+ * \tparam Input_precision  Number bits per pixel
+ * \tparam IFMDim           Width and Heigth of the unpadded Input Feature Map (assumed square)
+ * \tparam SIMD             Number of input columns computed in parallel
+ * \tparam Windows          SWGWindow of every branch
+ * \tparam R          	  Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the paramaters
+ *
+ * \param in                Input stream
+ * \param out               Output streams, one per branch
+ * \param numReps           Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  Resource type for the hardware implementation of the memory block
+ */
+template<unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int IFMDim,
+		 unsigned int SIMD,
+		 typename... Windows,
+		 typename R>
+void ConvolutionInputGenerator_Shared(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<ap_uint<SIMD*Input_precision> > (&out)[sizeof...(Windows)],
+		const unsigned int numReps,
+		R const &r) {
+#pragma HLS ARRAY_PARTITION variable=out complete dim=1
+  static_assert(IFMChannels % SIMD == 0, "");
+  constexpr unsigned int NB = sizeof...(Windows);
+  static_assert(NB > 0, "At least one branch required.");
+  constexpr unsigned int multiplying_factor = IFMChannels/SIMD;
+  constexpr unsigned int kernel[NB] = { Windows::kernel... };
+  constexpr unsigned int stride[NB] = { Windows::stride... };
+  constexpr unsigned int pad[NB] = { Windows::pad... };
+  constexpr int pad_value[NB] = { Windows::pad_value... };
+  constexpr unsigned int ofm_dim[NB] = { Windows::ofm_dim(IFMDim)... };
+  constexpr unsigned int max_kernel = detail::swg_max(kernel);
+  constexpr unsigned int max_stride = detail::swg_max(stride);
+  // the window of the largest kernel plus the pixels read ahead, see ConvolutionInputGenerator_Padded
+  constexpr unsigned int buffer_pixels = (max_kernel-1)*IFMDim + max_kernel + max_stride;
+  constexpr unsigned int in_pixels = IFMDim * IFMDim;
+  constexpr unsigned int out_words[NB] = { Windows::ofm_dim(IFMDim) * Windows::ofm_dim(IFMDim) * Windows::kernel * Windows::kernel * multiplying_factor... };
+  // buffer slot increments to the next kernel row, the next window and the first window of the next row
+  constexpr unsigned int tap_row_slot_step[NB] = { detail::swg_mod(int(IFMDim) - int(Windows::kernel) + 1, buffer_pixels)... };
+  constexpr unsigned int win_slot_step[NB] = { Windows::stride % buffer_pixels... };
+  constexpr unsigned int row_slot_step[NB] = {
+    detail::swg_mod(int(Windows::stride * IFMDim) - int((Windows::ofm_dim(IFMDim)-1) * Windows::stride), buffer_pixels)... };
+  constexpr unsigned int first_slot[NB] = { detail::swg_mod(-int(Windows::pad*IFMDim + Windows::pad), buffer_pixels)... };
+  ap_uint<SIMD*Input_precision> inputBuf[buffer_pixels * multiplying_factor];
+  memory_resource(inputBuf, r);
+
+  for (unsigned int count_image = 0; count_image < numReps; count_image++) {
+    // reader state
+    unsigned int rd_pix = 0, rd_slot = 0, rd_simd = 0;
+    // emitter state of every branch, see ConvolutionInputGenerator_Padded
+    int win_y[NB], win_x[NB];
+    unsigned int win_slot[NB], slot[NB], ofm_x[NB], k_x[NB], k_y[NB], count_simd[NB], written[NB];
+#pragma HLS ARRAY_PARTITION variable=win_y complete
+#pragma HLS ARRAY_PARTITION variable=win_x complete
+#pragma HLS ARRAY_PARTITION variable=win_slot complete
+#pragma HLS ARRAY_PARTITION variable=slot complete
+#pragma HLS ARRAY_PARTITION variable=ofm_x complete
+#pragma HLS ARRAY_PARTITION variable=k_x complete
+#pragma HLS ARRAY_PARTITION variable=k_y complete
+#pragma HLS ARRAY_PARTITION variable=count_simd complete
+#pragma HLS ARRAY_PARTITION variable=written complete
+    for (unsigned int b = 0; b < NB; b++) {
+#pragma HLS UNROLL
+      win_y[b] = -int(pad[b]);
+      win_x[b] = -int(pad[b]);
+      win_slot[b] = first_slot[b];
+      slot[b] = first_slot[b];
+      ofm_x[b] = 0;
+      k_x[b] = 0;
+      k_y[b] = 0;
+      count_simd[b] = 0;
+      written[b] = 0;
+    }
+    bool done = false;
+    while ((rd_pix < in_pixels) || !done) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=inputBuf inter false
+#pragma HLS DEPENDENCE variable=inputBuf intra false
+      // pick the first branch with a complete window, and find the first pixel still needed by any branch
+      int min_first = int(in_pixels);
+      bool emit = false;
+      unsigned int sel = 0;
+      bool sel_inside = false;
+      done = true;
+      for (unsigned int b = 0; b < NB; b++) {
+#pragma HLS UNROLL
+        if (written[b] < out_words[b]) {
+          int const first_y = win_y[b] < 0? 0 : win_y[b];
+          int const first_x = (win_y[b] < 0) || (win_x[b] < 0)? 0 : win_x[b];
+          int const last_y = win_y[b] + int(kernel[b]) > int(IFMDim)? int(IFMDim)-1 : win_y[b] + int(kernel[b])-1;
+          int const last_x = win_x[b] + int(kernel[b]) > int(IFMDim)? int(IFMDim)-1 : win_x[b] + int(kernel[b])-1;
+          int const first_pix = first_y*int(IFMDim) + first_x;
+          int const last_pix = last_y*int(IFMDim) + last_x;
+          if (first_pix < min_first)  min_first = first_pix;
+          if (!emit && (int(rd_pix) > last_pix)) {
+            int const y = win_y[b] + int(k_y[b]);
+            int const x = win_x[b] + int(k_x[b]);
+            emit = true;
+            sel = b;
+            sel_inside = (y >= 0) && (y < int(IFMDim)) && (x >= 0) && (x < int(IFMDim));
+          }
+          done = false;
+        }
+      }
+
+      if (emit) {
+        unsigned int addr = 0;
+        int value = 0;
+        for (unsigned int b = 0; b < NB; b++) {
+#pragma HLS UNROLL
+          if (b == sel) {
+            addr = slot[b] * multiplying_factor + count_simd[b];
+            value = pad_value[b];
+          }
+        }
+        ap_uint<SIMD*Input_precision> padElem;
+        for (unsigned int simd = 0; simd < SIMD; simd++) {
+#pragma HLS UNROLL
+          padElem((simd+1)*Input_precision-1, simd*Input_precision) = value;
+        }
+        ap_uint<SIMD*Input_precision> const bufElem = inputBuf[addr];
+        out[sel].write(sel_inside? bufElem : padElem);
+
+        for (unsigned int b = 0; b < NB; b++) {
+#pragma HLS UNROLL
+          if (b == sel) {
+            written[b]++;
+            count_simd[b]++;
+            if (count_simd[b] == multiplying_factor) {
+              count_simd[b] = 0;
+              // advance to the next window pixel
+              slot[b] += (k_x[b] == kernel[b]-1)? tap_row_slot_step[b] : 1;
+              if (slot[b] >= buffer_pixels) {
+                slot[b] -= buffer_pixels;
+              }
+              k_x[b]++;
+              if (k_x[b] == kernel[b]) {
+                k_x[b] = 0;
+                k_y[b]++;
+                if (k_y[b] == kernel[b]) {
+                  k_y[b] = 0;
+                  // advance to the next window
+                  ofm_x[b]++;
+                  if (ofm_x[b] == ofm_dim[b]) {
+                    ofm_x[b] = 0;
+                    win_x[b] = -int(pad[b]);
+                    win_y[b] += stride[b];
+                    win_slot[b] += row_slot_step[b];
+                  } else {
+                    win_x[b] += stride[b];
+                    win_slot[b] += win_slot_step[b];
+                  }
+                  if (win_slot[b] >= buffer_pixels) {
+                    win_slot[b] -= buffer_pixels;
+                  }
+                  slot[b] = win_slot[b];
+                }
+              }
+            }
+          }
+        }
+      }
+      // read ahead as long as no pixel of the window of the lagging branch is overwritten
+      if ((rd_pix < in_pixels) && (int(rd_pix) < min_first + int(buffer_pixels))) {
+        ap_uint<SIMD*Input_precision> inElem = in.read();
+        inputBuf[rd_slot * multiplying_factor + rd_simd] = inElem;
+        rd_simd++;
+        if (rd_simd == multiplying_factor) {
+          rd_simd = 0;
+          rd_pix++;
+          rd_slot++;
+          if (rd_slot == buffer_pixels) {
+            rd_slot = 0;
+          }
+        }
+      }
+    }
+  } // End count_image
+} // End generator
+
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm for 3D (spatio-temporal) convolutions
+ *
+ * The input is a sequence of IFMDepth frames of IFMDim x IFMDim pixels. For every output position, in order of
+ * output frame, row and column, the ConvKernelDim_t x ConvKernelDim x ConvKernelDim window is emitted in order of
+ * kernel frame, row, column and SIMD group, so that the result can be fed to Matrix_Vector_Activate_Batch with
+ * MatrixW = ConvKernelDim_t * ConvKernelDim * ConvKernelDim * IFMChannels.
+ * Only (ConvKernelDim_t-1) frames plus (ConvKernelDim-1) rows plus ConvKernelDim + Stride pixels are buffered
+ * on chip in a circular buffer, each input pixel is read exactly once. A window is emitted as soon as its last
+ * pixel has been read, while the input is read ahead as far as the buffer allows. Pixels and frames not covered
+ * by any window are consumed and dropped.
+ *
+ * \tparam ConvKernelDim_t  Temporal dimension of the convolutional kernel
+ * \tparam ConvKernelDim    Spatial dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels      Number of Input Feature Maps
+ * \tparam Input_precision  Number bits per pixel
+ * \tparam IFMDepth         Number of input frames
+ * \tparam IFMDim           Width and Heigth of the input frames (assumed square)
+ * \tparam OFMDepth         Number of output frames, (IFMDepth - ConvKernelDim_t)/Stride_t + 1
+ * \tparam OFMDim           Width and Heigth of the output frames (assumed square)
+ * \tparam SIMD             Number of input columns computed in parallel
+ * \tparam Stride_t         Temporal stride of the convolutional kernel
+ * \tparam Stride           Spatial stride of the convolutional kernel
+ * \tparam R          	  Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the paramaters
+ *
+ * \param in                Input stream
+ * \param out               Output stream
+ * \param numReps           Number of time the function has to be repeatedly executed (e.g. number of clips)
+ * \param r			  Resource type for the hardware implementation of the memory block
+ */
+template<unsigned int ConvKernelDim_t,
+		 unsigned int ConvKernelDim,
+		 unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int IFMDepth,
+		 unsigned int IFMDim,
+		 unsigned int OFMDepth,
+		 unsigned int OFMDim,
+		 unsigned int SIMD,
+		 unsigned int Stride_t,
+		 unsigned int Stride,
+		 typename R>
+void ConvolutionInputGenerator_3D(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<ap_uint<SIMD*Input_precision> > & out,
+		const unsigned int numReps,
+		R const &r) {
+  static_assert(IFMChannels % SIMD == 0, "");
+  static_assert(IFMDepth >= (OFMDepth-1)*Stride_t + ConvKernelDim_t, "OFMDepth too large for IFMDepth.");
+  static_assert(IFMDim >= (OFMDim-1)*Stride + ConvKernelDim, "OFMDim too large for IFMDim.");
+  constexpr unsigned int multiplying_factor = IFMChannels/SIMD;
+  constexpr unsigned int frame_pixels = IFMDim * IFMDim;
+  // distance from the last to the first pixel of a window
+  constexpr unsigned int window_span = (ConvKernelDim_t-1)*frame_pixels + (ConvKernelDim-1)*IFMDim + ConvKernelDim-1;
+  // buffered pixels: the window plus the Stride pixels read ahead
+  constexpr unsigned int buffer_pixels = window_span + 1 + Stride;
+  constexpr unsigned int in_pixels = IFMDepth * frame_pixels;
+  constexpr unsigned int out_words = OFMDepth * OFMDim * OFMDim * ConvKernelDim_t * ConvKernelDim * ConvKernelDim * multiplying_factor;
+  // pixel index increments to the next kernel row and frame, and to the next window, row of windows and frame of windows
+  constexpr unsigned int tap_row_step = IFMDim - ConvKernelDim + 1;
+  constexpr unsigned int tap_frame_step = frame_pixels - (ConvKernelDim-1)*IFMDim - ConvKernelDim + 1;
+  constexpr unsigned int row_step = Stride * IFMDim - (OFMDim-1) * Stride;
+  constexpr unsigned int frame_step = Stride_t * frame_pixels - (OFMDim-1) * Stride * IFMDim - (OFMDim-1) * Stride;
+  ap_uint<SIMD*Input_precision> inputBuf[buffer_pixels * multiplying_factor];
+  memory_resource(inputBuf, r);
+
+  for (unsigned int count_image = 0; count_image < numReps; count_image++) {
+    // reader state
+    unsigned int rd_pix = 0, rd_slot = 0, rd_simd = 0;
+    // emitter state: first pixel of the current window and its buffer slot
+    unsigned int win_pix = 0, win_slot = 0;
+    unsigned int ofm_x = 0, ofm_y = 0, k_x = 0, k_y = 0, k_t = 0, count_simd = 0;
+    unsigned int slot = 0; // buffer slot of the current window pixel
+    unsigned int written = 0;
+    while ((rd_pix < in_pixels) || (written < out_words)) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=inputBuf inter false
+#pragma HLS DEPENDENCE variable=inputBuf intra false
+      // emit the current window once its last pixel is available
+      if ((written < out_words) && (rd_pix > win_pix + window_span)) {
+        out.write(inputBuf[slot * multiplying_factor + count_simd]);
+        written++;
+        count_simd++;
+        if (count_simd == multiplying_factor) {
+          count_simd = 0;
+          // advance to the next window pixel
+          slot += (k_x < ConvKernelDim-1)? 1 : (k_y < ConvKernelDim-1)? tap_row_step % buffer_pixels : tap_frame_step % buffer_pixels;
+          if (slot >= buffer_pixels) {
+            slot -= buffer_pixels;
+          }
+          k_x++;
+          if (k_x == ConvKernelDim) {
+            k_x = 0;
+            k_y++;
+            if (k_y == ConvKernelDim) {
+              k_y = 0;
+              k_t++;
+              if (k_t == ConvKernelDim_t) {
+                k_t = 0;
+                // advance to the next window
+                unsigned int step = Stride;
+                ofm_x++;
+                if (ofm_x == OFMDim) {
+                  ofm_x = 0;
+                  step = row_step;
+                  ofm_y++;
+                  if (ofm_y == OFMDim) {
+                    ofm_y = 0;
+                    step = frame_step;
+                  }
+                }
+                win_pix += step;
+                win_slot += step % buffer_pixels;
+                if (win_slot >= buffer_pixels) {
+                  win_slot -= buffer_pixels;
+                }
+                slot = win_slot;
+              }
+            }
+          }
+        }
+      }
+      // read ahead as long as no pixel of the current window is overwritten
+      if ((rd_pix < in_pixels) && ((written == out_words) || (rd_pix < win_pix + buffer_pixels))) {
+        ap_uint<SIMD*Input_precision> inElem = in.read();
+        inputBuf[rd_slot * multiplying_factor + rd_simd] = inElem;
+        rd_simd++;
+        if (rd_simd == multiplying_factor) {
+          rd_simd = 0;
+          rd_pix++;
+          rd_slot++;
+          if (rd_slot == buffer_pixels) {
+            rd_slot = 0;
+          }
+        }
+      }
+    }
+  } // End count_image
+} // End generator
+
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm for feature map dimensions and
+ * strides given at runtime
+ *
+ * The buffer is sized for MaxIFMDim and MaxStride and organized as a circular buffer of
+ * ConvKernelDim + MaxStride rows. The first ConvKernelDim rows of an image are buffered upfront,
+ * afterwards the next Stride rows are read while the windows of an output row are emitted. The
+ * number of iterations follows the runtime dimensions, so smaller images finish proportionally
+ * faster. The output order is the one of ConvolutionInputGenerator. Any Stride up to MaxStride is
+ * supported, rows not covered by any window are consumed and dropped.
+ *
+ * \tparam ConvKernelDim    Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels      Number of Input Feature Maps
+ * \tparam Input_precision  Number bits per pixel
+ * \tparam MaxIFMDim        Maximum width and heigth of the Input Feature Map (assumed square)
+ * \tparam SIMD             Number of input columns computed in parallel
+ * \tparam MaxStride        Maximum stride of the convolutional kernel
+ * \tparam R          	  Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the paramaters
+ *
+ * \param in                Input stream
+ * \param out               Output stream
+ * \param IFMDim            Width and Heigth of the Input Feature Map, at most MaxIFMDim
+ * \param OFMDim            Width and Heigth of the Output Feature Map, (IFMDim - ConvKernelDim) / Stride + 1
+ * \param Stride            Stride of the convolutional kernel, at most MaxStride
+ * \param numReps           Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  Resource type for the hardware implementation of the memory block
+ */
+template<unsigned int ConvKernelDim,
+		 unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int MaxIFMDim,
+		 unsigned int SIMD,
+		 unsigned int MaxStride,
+		 typename R>
+void ConvolutionInputGenerator_Dynamic(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<ap_uint<SIMD*Input_precision> > & out,
+		const unsigned int IFMDim,
+		const unsigned int OFMDim,
+		const unsigned int Stride,
+		const unsigned int numReps,
+		R const &r) {
+  static_assert(IFMChannels % SIMD == 0, "");
+  const unsigned int multiplying_factor = IFMChannels/SIMD;
+  const unsigned int number_rows = ConvKernelDim + MaxStride;
+  const unsigned int row_pitch = MaxIFMDim * multiplying_factor;
+  ap_uint<SIMD*Input_precision> inputBuf[number_rows * row_pitch];
+  memory_resource(inputBuf, r);
+
+  const unsigned int words_row = IFMDim * multiplying_factor;
+  const unsigned int cycles_write_row = OFMDim * ConvKernelDim * ConvKernelDim * multiplying_factor;
+  const unsigned int rows_last = IFMDim - ConvKernelDim - (OFMDim-1) * Stride; // trailing rows not covered by a window
+  const unsigned int cycles_read_row = Stride * words_row;
+  const unsigned int cycles_read_last = rows_last * words_row;
+  const unsigned int baseIter = ConvKernelDim * words_row // Initial buffer
+                              + (OFMDim-1) * std::max(cycles_write_row, cycles_read_row)
+                              + std::max(cycles_write_row, cycles_read_last);
+
+  for (unsigned int count_image = 0; count_image < numReps; count_image++) {
+    unsigned int wr_row = 0, wr_pos = 0;     // buffer write position
+    unsigned int top_row = 0;                // buffer row of the topmost window row
+    unsigned int inp = 0;                    // words of the initial buffer read
+    unsigned int written = 0, read = 0;      // words emitted and read for the current output row
+    unsigned int reads = cycles_read_row;    // words to be read for the current output row
+    unsigned int ofm_y = 0, ofm_x = 0, base_x = 0, k_y = 0, k_x = 0, count_simd = 0;
+    if (OFMDim == 1)  reads = cycles_read_last;
+    for (unsigned int i = 0; i < baseIter; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=inputBuf inter false
+#pragma HLS DEPENDENCE variable=inputBuf intra false
+      bool do_read = false;
+      if (inp < ConvKernelDim * words_row) { // Initial buffer of ConvKernelDim lines
+        do_read = true;
+        inp++;
+      } else {
+        if (written < cycles_write_row) { // We are writing output
+          unsigned int current_row = top_row + k_y;
+          if (current_row >= number_rows) {
+            current_row -= number_rows;
+          }
+          ap_uint<SIMD*Input_precision> outElem = inputBuf[current_row * row_pitch + (base_x + k_x) * multiplying_factor + count_simd];
+          out.write(outElem);
+          written++;
+          count_simd++;
+          if (count_simd == multiplying_factor) {
+            count_simd = 0;
+            k_x++;
+            if (k_x == ConvKernelDim) {
+              k_x = 0;
+              k_y++;
+              if (k_y == ConvKernelDim) {
+                k_y = 0;
+                ofm_x++;
+                base_x += Stride;
+                if (ofm_x == OFMDim) {
+                  ofm_x = 0;
+                  base_x = 0;
+                }
+              }
+            }
+          }
+        }
+        if (read < reads) { // In parallel we fill the rows outside of the current window
+          do_read = true;
+          read++;
+        }
+        if ((written == cycles_write_row) && (read == reads)) { // next output row
+          written = 0;
+          read = 0;
+          ofm_y++;
+          reads = (ofm_y == OFMDim-1)? cycles_read_last : cycles_read_row;
+          top_row += Stride;
+          if (top_row >= number_rows) {
+            top_row -= number_rows;
+          }
+        }
+      }
+      if (do_read) {
+        ap_uint<SIMD*Input_precision> inElem = in.read();
+        inputBuf[wr_row * row_pitch + wr_pos] = inElem;
+        wr_pos++;
+        if (wr_pos == words_row) {
+          wr_pos = 0;
+          wr_row++;
+          if (wr_row == number_rows) {
+            wr_row = 0;
+          }
+        }
+      }
+    } // End base_iter
+  } // End count_image
+} // End generator
+
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Matrix_Vector_Activate_Stream_Batch, implementing the im2col algorithm for transposed convolutions
+ *
+ * A transposed convolution with Stride S is equivalent to a convolution over the input with S-1 zeros inserted
+ * between neighbouring pixels. Instead of generating these zeros, only the taps hitting an input pixel are emitted:
+ * the output pixel with uncropped coordinate u = o + Padding receives kernel rows (and columns) u%S + t*S from input
+ * row u/S - t for t = 0..ConvKernelDim/S-1. The ConvKernelDim/S x ConvKernelDim/S taps of each output pixel are
+ * emitted in order of increasing input row, then input column, then SIMD group, taps falling out of the input being
+ * zero, i.e. tap (ty,tx) of sub-pixel phase (py,px) carries input pixel (u_y/S - T+1+ty, u_x/S - T+1+tx) and is to be
+ * multiplied with kernel position (py + (T-1-ty)*S, px + (T-1-tx)*S), T = ConvKernelDim/S.
+ * Before the taps of each output pixel its weight phase py*S + px is written to the phase stream. The MVAU hence
+ * multiplies with a (ConvKernelDim/S)^2 * IFMChannels wide weight matrix selected by the phase, compute drops by S^2
+ * compared to a convolution over the zero-inserted input.
+ *
+ * \tparam ConvKernelDim    Dimension of the convolutional kernel (assumed square), multiple of Stride
+ * \tparam IFMChannels      Number of Input Feature Maps
+ * \tparam Input_precision  Number bits per pixel
+ * \tparam IFMDim           Width and Heigth of the Input Feature Map (assumed square)
+ * \tparam OFMDim           Width and Heigth of the Output Feature Map (assumed square), (IFMDim-1)*Stride + ConvKernelDim - 2*Padding
+ * \tparam SIMD             Number of input columns computed in parallel
+ * \tparam Stride           Stride of the transposed convolution (upsampling factor)
+ * \tparam Padding          Number of output rows and columns cropped on each side
+ * \tparam R          	  Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the paramaters
+ *
+ * \param in                Input stream
+ * \param out               Output stream
+ * \param phase             Weight phase stream, one word per output pixel
+ * \param numReps           Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  Resource type for the hardware implementation of the memory block
+ */
+template<unsigned int ConvKernelDim,
+		 unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int IFMDim,
+		 unsigned int OFMDim,
+		 unsigned int SIMD,
+		 unsigned int Stride,
+		 unsigned int Padding = 0,
+		 typename R>
+void ConvolutionInputGenerator_Transposed(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<ap_uint<SIMD*Input_precision> > & out,
+		hls::stream<ap_uint<(Stride > 1? clog2(Stride*Stride) : 1)> > & phase,
+		const unsigned int numReps,
+		R const &r) {
+  static_assert(IFMChannels % SIMD == 0, "");
+  static_assert(ConvKernelDim % Stride == 0, "ConvKernelDim must be a multiple of Stride.");
+  static_assert(OFMDim + 2*Padding == (IFMDim-1)*Stride + ConvKernelDim, "OFMDim does not match the transposed convolution.");
+  constexpr unsigned int multiplying_factor = IFMChannels/SIMD;
+  // taps per output pixel along each axis
+  constexpr unsigned int taps = ConvKernelDim/Stride;
+  // taps rows are kept, plus one row read ahead
+  constexpr unsigned int number_rows = taps + 1;
+  constexpr unsigned int in_words = IFMDim * IFMDim * multiplying_factor;
+  constexpr unsigned int out_words = OFMDim * OFMDim * taps * taps * multiplying_factor;
+  constexpr unsigned int first_phase = Padding % Stride;
+  // first input row and column of the first output pixel
+  constexpr int first_tap = int(Padding / Stride) - int(taps) + 1;
+  constexpr unsigned int first_slot = ((first_tap % int(number_rows)) + int(number_rows)) % number_rows;
+  ap_uint<SIMD*Input_precision> inputBuf[number_rows * IFMDim * multiplying_factor];
+  memory_resource(inputBuf, r);
+
+  for (unsigned int count_image = 0; count_image < numReps; count_image++) {
+    // reader state
+    unsigned int rd_word = 0, rd_row = 0, rd_slot = 0, rd_col = 0;
+    // emitter state: sub-pixel phase and first tap row/column of the current output pixel
+    unsigned int ofm_x = 0, ph_x = first_phase, ph_y = first_phase;
+    int row = first_tap, col = first_tap;
+    unsigned int row_slot = first_slot;
+    unsigned int k_y = 0, k_x = 0, count_simd = 0;
+    unsigned int written = 0;
+    while ((rd_word < in_words) || (written < out_words)) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=inputBuf inter false
+#pragma HLS DEPENDENCE variable=inputBuf intra false
+      // last input row of the current output pixel
+      int const last_row = row + int(taps) - 1 < int(IFMDim)? row + int(taps) - 1 : int(IFMDim) - 1;
+
+      // emit the current output pixel once all its input rows are available
+      if ((written < out_words) && (int(rd_row) > last_row)) {
+        if ((k_y == 0) && (k_x == 0) && (count_simd == 0)) {
+          phase.write(ph_y*Stride + ph_x);
+        }
+        int const y = row + int(k_y);
+        int const x = col + int(k_x);
+        bool const inside = (y >= 0) && (y < int(IFMDim)) && (x >= 0) && (x < int(IFMDim));
+        unsigned int slot = row_slot + k_y;
+        if (slot >= number_rows) {
+          slot -= number_rows;
+        }
+        ap_uint<SIMD*Input_precision> const bufElem = inputBuf[(slot * IFMDim + (inside? x : 0)) * multiplying_factor + count_simd];
+        out.write(inside? bufElem : ap_uint<SIMD*Input_precision>(0));
+        written++;
+        count_simd++;
+        if (count_simd == multiplying_factor) {
+          count_simd = 0;
+          k_x++;
+          if (k_x == taps) {
+            k_x = 0;
+            k_y++;
+            if (k_y == taps) {
+              k_y = 0;
+              // advance to the next output pixel
+              ph_x++;
+              if (ph_x == Stride) {
+                ph_x = 0;
+                col++;
+              }
+              ofm_x++;
+              if (ofm_x == OFMDim) {
+                ofm_x = 0;
+                ph_x = first_phase;
+                col = first_tap;
+                ph_y++;
+                if (ph_y == Stride) {
+                  ph_y = 0;
+                  row++;
+                  row_slot++;
+                  if (row_slot == number_rows) {
+                    row_slot = 0;
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+      // read ahead as long as no input row of the current output pixel is overwritten
+      if ((rd_word < in_words) && ((written == out_words) || (int(rd_row) < row + int(number_rows)))) {
+        ap_uint<SIMD*Input_precision> inElem = in.read();
+        inputBuf[(rd_slot * IFMDim) * multiplying_factor + rd_col] = inElem;
+        rd_col++;
+        if (rd_col == IFMDim * multiplying_factor) {
+          rd_col = 0;
+          rd_row++;
+          rd_slot++;
+          if (rd_slot == number_rows) {
+            rd_slot = 0;
+          }
+        }
+        rd_word++;
+      }
+    }
+  } // End count_image
+} // End generator
+
 /**
  * \brief Sliding Window unit that produces output vectors for feeding
  * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm with support to multiple output pixels
@@ -421,7 +1379,7 @@ void ConvolutionInputGenerator_MMV(
 /**
  * \brief Sliding Window unit that produces output vectors for feeding
  * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm. To be used when 
- * ConvKernelDim%Stride != 0 (e.g., Kernel=3, Stride=2)
+ * ConvKernelDim%Stride != 0 (e.g., Kernel=3, Stride=2) or with dilation
  *
  * \tparam ConvKernelDim    Dimension of the convolutional kernel (assumed square)
  * \tparam IFMChannels      Number of Input Feature Maps
@@ -430,6 +1388,7 @@ void ConvolutionInputGenerator_MMV(
  * \tparam OFMDim           Width and Heigth of the Output Feature Map (assumed square)
  * \tparam SIMD             Number of input columns computed in parallel
  * \tparam Stride           Stride of the convolutional kernel
+ * \tparam Dilation         Dilation of the convolutional kernel, OFMDim = (IFMDim - (ConvKernelDim-1)*Dilation - 1)/Stride + 1
  * \tparam R          	  Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the paramaters
  *
  * \param in                Input stream
@@ -445,6 +1404,7 @@ template<unsigned int ConvKernelDim,
 		 unsigned int OFMDim,
 		 unsigned int SIMD,
 		 unsigned int Stride, 
+		 unsigned int Dilation = 1,
 		 typename R>  
 void ConvolutionInputGenerator_kernel_stride(  
 		hls::stream<ap_uint<SIMD*Input_precision> > & in,
@@ -452,14 +1412,16 @@ void ConvolutionInputGenerator_kernel_stride(
 		const unsigned int numReps,
 		R const &r) {
 	static_assert(IFMChannels % SIMD == 0, "");
-    static_assert(ConvKernelDim % Stride != 0, "");
+    static_assert((ConvKernelDim % Stride != 0) || (Dilation > 1), "");
+	static_assert(Dilation > 0, "");
 	constexpr unsigned  multiplying_factor = IFMChannels/SIMD;
-	constexpr unsigned  number_blocks = ConvKernelDim + Stride ;
+	constexpr unsigned  kernel_extent = (ConvKernelDim-1) * Dilation + 1;
+	constexpr unsigned  number_blocks = kernel_extent + Stride ;
 	constexpr unsigned  cycles_write_block = OFMDim * ConvKernelDim * ConvKernelDim * multiplying_factor;
 	constexpr unsigned  cycles_read_block = IFMDim * Stride * multiplying_factor;
 	constexpr unsigned  max_cycles = std::max(cycles_write_block, cycles_read_block);
-	constexpr unsigned  baseIter = (IFMDim * ConvKernelDim * multiplying_factor) + (OFMDim-1) * max_cycles+std::max(cycles_write_block,OFMDim);
-	constexpr unsigned  initial_buffer_cycles = (IFMDim * ConvKernelDim * multiplying_factor) ;
+	constexpr unsigned  baseIter = (IFMDim * kernel_extent * multiplying_factor) + (OFMDim-1) * max_cycles+std::max(cycles_write_block,OFMDim);
+	constexpr unsigned  initial_buffer_cycles = (IFMDim * kernel_extent * multiplying_factor) ;
 
 	ap_uint<SIMD*Input_precision> inputBuf[number_blocks][IFMDim * multiplying_factor];
 	memory_resource(inputBuf, r);
@@ -499,7 +1461,7 @@ for (unsigned int count_image = 0; count_image < numReps; count_image++) {
 				if (counter_internal_block < cycles_write_block-1 || read_block==IFMDim) // We are writing output, MMV IFMChan per cycle
 				{
 					//following code implements: current_block_read = (ofm_y*Stride + k_y)%number_blocks;
-          unsigned int current_block_read = (ofm_y*Stride + k_y);
+          unsigned int current_block_read = (ofm_y*Stride + k_y*Dilation);
             //reminder computation
             if (current_block_read >= ceil_block_read)
             {
@@ -511,7 +1473,7 @@ for (unsigned int count_image = 0; count_image < numReps; count_image++) {
             }
             current_block_read -= floor_block_read;
 
-					unsigned int current_line_in_block = (ofm_x * Stride + k_x)*multiplying_factor + count_simd;
+					unsigned int current_line_in_block = (ofm_x * Stride + k_x*Dilation)*multiplying_factor + count_simd;
 					ap_uint<SIMD*Input_precision> outElem = inputBuf[current_block_read][(current_line_in_block)];
 					out.write(outElem);
 					count_simd++;
@@ -567,7 +1529,7 @@ for (unsigned int count_image = 0; count_image < numReps; count_image++) {
 /**
  * \brief Sliding Window unit that produces output vectors for feeding
  * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm. To be used when 
- * ConvKernelDim%Stride != 0 (e.g., Kernel=3, Stride=2)
+ * ConvKernelDim%Stride != 0 (e.g., Kernel=3, Stride=2) or with dilation
  *
  * \tparam ConvKernelDim    Dimension of the convolutional kernel (assumed square)
  * \tparam IFMChannels      Number of Input Feature Maps
@@ -577,6 +1539,7 @@ for (unsigned int count_image = 0; count_image < numReps; count_image++) {
  * \tparam SIMD             Number of input columns computed in parallel
  * \tparam Stride           Stride of the convolutional kernel
  * \tparam MMV              Number of pixels that have to be produced in parallel
+ * \tparam Dilation         Dilation of the convolutional kernel, OFMDim = (IFMDim - (ConvKernelDim-1)*Dilation - 1)/Stride + 1
  * \tparam R          	  Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the paramaters
  *
  * \param in                Input stream
@@ -593,6 +1556,7 @@ template<unsigned int ConvKernelDim,
 		 unsigned int SIMD,
 		 unsigned int Stride, 
 		 unsigned int MMV, 
+		 unsigned int Dilation = 1,
 		 typename R>  
 void ConvolutionInputGenerator_kernel_stride_MMV(  
 		hls::stream<ap_uint<SIMD*Input_precision> > & in,
@@ -600,12 +1564,14 @@ void ConvolutionInputGenerator_kernel_stride_MMV(
 		const unsigned int numReps,
 		R const &r) {
 	static_assert(IFMChannels % SIMD == 0, "");
-	static_assert(ConvKernelDim % Stride != 0, "");
+	static_assert((ConvKernelDim % Stride != 0) || (Dilation > 1), "");
+	static_assert(Dilation > 0, "");
 	static_assert(OFMDim % MMV == 0, "");
 	static_assert(MMV <= OFMDim, "");
 
 	const unsigned int multiplying_factor = IFMChannels/SIMD;
-	const unsigned int number_blocks = ConvKernelDim + Stride ;
+	const unsigned int kernel_extent = (ConvKernelDim-1) * Dilation + 1;
+	const unsigned int number_blocks = kernel_extent + Stride ;
 	ap_uint<SIMD*Input_precision> inputBuf[MMV][number_blocks][IFMDim * multiplying_factor];
 #pragma HLS DEPENDENCE variable=inputBuf inter false
 #pragma HLS DEPENDENCE variable=inputBuf intra false
@@ -615,8 +1581,8 @@ void ConvolutionInputGenerator_kernel_stride_MMV(
 	const unsigned int cycles_write_block = (OFMDim * ConvKernelDim * ConvKernelDim * multiplying_factor)/MMV;
 	const unsigned int cycles_read_block = IFMDim * Stride * multiplying_factor;
 	const unsigned int max_cycles = std::max(cycles_write_block, cycles_read_block);
-	const unsigned int baseIter = (IFMDim * ConvKernelDim * multiplying_factor) + (OFMDim-1) * max_cycles+std::max(cycles_write_block,OFMDim);
-	const unsigned int initial_buffer_cycles = (IFMDim * ConvKernelDim * multiplying_factor) ;
+	const unsigned int baseIter = (IFMDim * kernel_extent * multiplying_factor) + (OFMDim-1) * max_cycles+std::max(cycles_write_block,OFMDim);
+	const unsigned int initial_buffer_cycles = (IFMDim * kernel_extent * multiplying_factor) ;
 	unsigned int counter_internal_block = 0;
 	unsigned int current_line = 0;
 
@@ -655,7 +1621,7 @@ for (unsigned int count_image = 0; count_image < numReps; count_image++) {
 				if (counter_internal_block < cycles_write_block-1 || read_block==IFMDim) // We are writing output, MMV IFMChan per cycle
 				{
 					//following code implements: current_block_read = (ofm_y*Stride + k_y)%number_blocks;
-            unsigned int current_block_read = (ofm_y*Stride + k_y);
+            unsigned int current_block_read = (ofm_y*Stride + k_y*Dilation);
             //reminder computation
             if (current_block_read >= ceil_block_read)
             {
@@ -666,7 +1632,7 @@ for (unsigned int count_image = 0; count_image < numReps; count_image++) {
               floor_block_read -= number_blocks;
             }
             current_block_read -= floor_block_read;
-			unsigned int current_line_in_block = (ofm_x * Stride + k_x)*multiplying_factor + count_simd;
+			unsigned int current_line_in_block = (ofm_x * Stride + k_x*Dilation)*multiplying_factor + count_simd;
 			MultiChanData<MMV, SIMD*Input_precision> outElem;
 			for(unsigned int v = 0; v < MMV; v++) {
 #pragma HLS UNROLL
@@ -730,7 +1696,7 @@ for (unsigned int count_image = 0; count_image < numReps; count_image++) {
 /**
  * \brief Sliding Window unit that produces output vectors for feeding
  * a Vector_Vector_Activate_Batch, implementing the im2col algorithm for depthwise separable convolutions. To be used only if 
- * ConvKernelDim%Stride = 0 and square kernel
+ * ((ConvKernelDim-1)*Dilation+1)%Stride = 0 and square kernel
  *
  * \tparam ConvKernelDim    Dimension of the convolutional kernel (assumed square)
  * \tparam IFMChannels      Number of Input Feature Maps
@@ -739,6 +1705,7 @@ for (unsigned int count_image = 0; count_image < numReps; count_image++) {
  * \tparam OFMDim           Width and Heigth of the Output Feature Map (assumed square)
  * \tparam SIMD             Number of input columns computed in parallel
  * \tparam Stride           Stride of the convolutional kernel
+ * \tparam Dilation         Dilation of the convolutional kernel, OFMDim = (IFMDim - (ConvKernelDim-1)*Dilation - 1)/Stride + 1
  * \tparam R          	  Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the paramaters
  *
  * \param in                Input stream
@@ -753,6 +1720,7 @@ template<unsigned int ConvKernelDim,
 		 unsigned int OFMDim,
 		 unsigned int SIMD,
 		 unsigned int Stride, 
+		 unsigned int Dilation = 1,
 		 typename R>  
 void ConvolutionInputGenerator_dws(
 		hls::stream<ap_uint<SIMD*Input_precision> > & in,
@@ -760,16 +1728,18 @@ void ConvolutionInputGenerator_dws(
 		const unsigned int numReps,
 		R const &r) {
   static_assert(IFMChannels % SIMD == 0, "");
-  static_assert(ConvKernelDim % Stride == 0, "");
+  static_assert(Dilation > 0, "");
+  const unsigned int kernel_extent = (ConvKernelDim-1) * Dilation + 1;
+  static_assert(kernel_extent % Stride == 0, "");
   const unsigned int multiplying_factor = IFMChannels/SIMD;
-  const unsigned int number_blocks = ConvKernelDim/Stride + 1 ;
+  const unsigned int number_blocks = kernel_extent/Stride + 1 ;
   ap_uint<SIMD*Input_precision> inputBuf[number_blocks][Stride * IFMDim * multiplying_factor];
 #pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=1
   memory_resource(inputBuf, r);
   const unsigned int cycles_write_block = (OFMDim * ConvKernelDim * ConvKernelDim * multiplying_factor);
   const unsigned int cycles_read_block = Stride * IFMDim * multiplying_factor;
   const unsigned int max_cycles = std::max(cycles_write_block,cycles_read_block);
-  const unsigned int baseIter = IFMDim * ConvKernelDim * multiplying_factor// Initial buffer
+  const unsigned int baseIter = IFMDim * kernel_extent * multiplying_factor// Initial buffer
 			                  + OFMDim * std::max(cycles_write_block,cycles_read_block);
   unsigned int counter_internal_block = 0;
   unsigned int current_block_write = 0;
@@ -780,7 +1750,7 @@ void ConvolutionInputGenerator_dws(
   for (unsigned int count_image = 0; count_image < numReps; count_image++) {
     for (unsigned int i = 0; i < baseIter; i++) {
 #pragma HLS pipeline style=flp II=1
-      if (inp < IFMDim * ConvKernelDim*multiplying_factor) {// Initial buffer of ConvKernelDim lines	
+      if (inp < IFMDim * kernel_extent*multiplying_factor) {// Initial buffer of kernel_extent lines	
         ap_uint<SIMD*Input_precision> inElem;
         inElem = in.read();
         inputBuf[current_block_write][current_line] = inElem;
@@ -797,11 +1767,11 @@ void ConvolutionInputGenerator_dws(
         }
       } else {
         if (counter_internal_block < cycles_write_block-1) { // We are writing output, MMV IFMChan per cycle
-          unsigned int current_block_read = (current_block_write + 1 + k_y / Stride);
+          unsigned int current_block_read = (current_block_write + 1 + (k_y*Dilation) / Stride);
           if (current_block_read >= number_blocks) {
             current_block_read-= number_blocks;
 		  }
-          unsigned int current_line_in_block = ((k_y%Stride) * IFMDim + ofm_x*Stride + k_x)*multiplying_factor + count_simd;
+          unsigned int current_line_in_block = (((k_y*Dilation)%Stride) * IFMDim + ofm_x*Stride + k_x*Dilation)*multiplying_factor + count_simd;
           ap_uint<SIMD*Input_precision> outElem = inputBuf[current_block_read][(current_line_in_block)];
           out.write(outElem);		
 		  k_x++;
@@ -855,6 +1825,77 @@ void ConvolutionInputGenerator_dws(
 } // End generator
 
 
+/**
+ * \brief Repacks the output of a depthwise sliding window generator for a Vector_Vector_Activate_Batch
+ * computing SIMD kernel positions in parallel
+ *
+ * The input is expected as produced by ConvolutionInputGenerator_dws (or any of its variants) configured with
+ * SIMD*PE channels per word, i.e. for every output pixel and channel group the Kernel_2 kernel positions in order.
+ * For every group of PE channels, the function emits Kernel_2/SIMD words, element pe*SIMD + simd of word sf
+ * holding kernel position sf*SIMD + simd of channel pe. A group is buffered while the previous one is emitted,
+ * so a word is consumed and produced every cycle.
+ *
+ * \tparam Kernel_2         Kernel * Kernel dimension (Kernel ^ 2 if square)
+ * \tparam IFMChannels      Number of Input Feature Maps
+ * \tparam Input_precision  Number bits per pixel
+ * \tparam SIMD             Number of kernel positions per output word
+ * \tparam PE               Number of channels per output word
+ *
+ * \param in                Input stream
+ * \param out               Output stream
+ * \param numReps           Number of output pixels to be processed
+ */
+template<unsigned int Kernel_2,
+		 unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int SIMD,
+		 unsigned int PE>
+void DepthwiseKernelPacker_Batch(
+		hls::stream<ap_uint<SIMD*PE*Input_precision> > & in,
+		hls::stream<ap_uint<SIMD*PE*Input_precision> > & out,
+		const unsigned int numReps) {
+  static_assert(IFMChannels % (SIMD*PE) == 0, "SIMD*PE must divide IFMChannels.");
+  static_assert(Kernel_2 % SIMD == 0, "SIMD must divide Kernel_2.");
+  const unsigned int groups = IFMChannels / (SIMD*PE);
+  ap_uint<SIMD*PE*Input_precision> buf[2][Kernel_2];
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=0
+
+  ap_uint<1> bank = 0; // bank being filled
+  unsigned int k = 0;  // kernel position being buffered
+  unsigned int j = 0;  // PE channel group being emitted
+  unsigned int sf = 0; // kernel fold being emitted
+  for (unsigned int i = 0; i < (numReps*groups+1) * Kernel_2; i++) {
+#pragma HLS pipeline style=flp II=1
+    if (i < numReps*groups*Kernel_2) {
+      buf[bank][k] = in.read();
+    }
+    if (i >= Kernel_2) {
+      ap_uint<SIMD*PE*Input_precision> outElem;
+      for (unsigned int pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        for (unsigned int simd = 0; simd < SIMD; simd++) {
+#pragma HLS UNROLL
+          outElem((pe*SIMD+simd+1)*Input_precision-1, (pe*SIMD+simd)*Input_precision) =
+            buf[!bank][sf*SIMD+simd]((j*PE+pe+1)*Input_precision-1, (j*PE+pe)*Input_precision);
+        }
+      }
+      out.write(outElem);
+      sf++;
+      if (sf == Kernel_2/SIMD) {
+        sf = 0;
+        j++;
+      }
+    }
+    k++;
+    if (k == Kernel_2) {
+      k = 0;
+      j = 0;
+      bank = !bank;
+    }
+  }
+}
+
+
 /**
  * \brief Sliding Window unit that produces output vectors for feeding
  * a Vector_Vector_Activate_Batch, implementing the im2col algorithm for depthwise separable convolutions. To be used when 
@@ -1493,38 +2534,325 @@ void ConvolutionInputGenerator_NonSquare_dws(
             }
           }
         }
-        if ((counter_internal_block < cycles_read_block-1) && (read_block<IFMDim_y/Stride_y)) { // In parallel we write in the buffer, in the current block write if we still need to
-          ap_uint<SIMD*Input_precision> inElem;
-          inElem = in.read();
-          inputBuf[current_block_write][current_line] = inElem;
-#pragma AP dependence variable=inputBuf intra false
-#pragma AP dependence variable=inputBuf inter false
-          current_line++;
-          if (current_line == Stride_x * IFMDim_x * multiplying_factor) {// We read the whole block, we change the next block in which we want to we
-            // We filled up a block, let's not read until
-            current_line = 0;
-            read_block++;
-            current_block_write++;
-            if (current_block_write == number_blocks) {
-              current_block_write=0;
-			}
-#pragma AP dependence variable=current_block_write intra false
-          }
+        if ((counter_internal_block < cycles_read_block-1) && (read_block<IFMDim_y/Stride_y)) { // In parallel we write in the buffer, in the current block write if we still need to
+          ap_uint<SIMD*Input_precision> inElem;
+          inElem = in.read();
+          inputBuf[current_block_write][current_line] = inElem;
+#pragma AP dependence variable=inputBuf intra false
+#pragma AP dependence variable=inputBuf inter false
+          current_line++;
+          if (current_line == Stride_x * IFMDim_x * multiplying_factor) {// We read the whole block, we change the next block in which we want to we
+            // We filled up a block, let's not read until
+            current_line = 0;
+            read_block++;
+            current_block_write++;
+            if (current_block_write == number_blocks) {
+              current_block_write=0;
+			}
+#pragma AP dependence variable=current_block_write intra false
+          }
+        }
+        counter_internal_block++; // = (counter_internal_block +1) % max_cycles;
+        if (counter_internal_block == (max_cycles-1)) {
+          counter_internal_block = 0;
+        }
+      }
+    } // End base_iter
+	read_block = 0;
+  } // End count_image
+} // End generator
+
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm. To be used when kernel is not square and with dilation
+ * NOTE: Dilation over the Y axis not yet supported
+ *
+ * \tparam ConvKernelDim_x    	Dimension of the convolutional kernel - x axis
+ * \tparam ConvKernelDim_y    	Dimension of the convolutional kernel - y axis
+ * \tparam IFMChannels      	Number of Input Feature Maps
+ * \tparam Input_precision  	Number bits per pixel
+ * \tparam IFMDim_x          	Width of the Input Feature Map
+ * \tparam IFMDim_y           	Height of the Input Feature Map
+ * \tparam OFMDim_x           	Width of the Output Feature Map
+ * \tparam OFMDim_y           	Height of the Output Feature Map
+ * \tparam SIMD             	Number of input columns computed in parallel
+ * \tparam Stride_x           	Stride of the convolutional kernel - x axis
+ * \tparam Stride_y          	Stride of the convolutional kernel - y axis
+ * \tparam Dilation_x          	Dilation the convolutional kernel - x axis
+ * \tparam Dilation_y          	Dilation the convolutional kernel - y axis
+ * \tparam R          	  		Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the parameters
+ *
+ * \param in                	Input stream
+ * \param out               	Output stream
+ * \param numReps           	Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  			Resource type for the hardware implementation of the memory block
+ */
+template<unsigned int ConvKernelDim_x,
+		 unsigned int ConvKernelDim_y,
+		 unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int IFMDim_x,
+		 unsigned int IFMDim_y,
+		 unsigned int OFMDim_x,
+		 unsigned int OFMDim_y,
+		 unsigned int SIMD,
+		 unsigned int Stride_x,
+		 unsigned int Stride_y,
+		 unsigned int Dilation_x,
+		 unsigned int Dilation_y,
+		 typename R>
+void ConvolutionInputGenerator_NonSquare_Dilated(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<ap_uint<SIMD*Input_precision> > & out,
+		const unsigned int numReps,
+		R const &r) {
+  static_assert(IFMChannels % SIMD == 0, "");
+  static_assert(Dilation_y == 1, ""); // Dilation on the Y axes not yet supported, available only for API definition
+
+  const unsigned int multiplying_factor = IFMChannels/SIMD;
+  const unsigned int number_blocks = (ConvKernelDim_y*Dilation_y)/Stride_y + 1 ;
+  ap_uint<SIMD*Input_precision> inputBuf[number_blocks][Stride_x * IFMDim_x * multiplying_factor];
+
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=1
+  memory_resource(inputBuf, r);
+  const unsigned int cycles_write_block = (OFMDim_x * ConvKernelDim_x * ConvKernelDim_y * multiplying_factor);
+  const unsigned int cycles_read_block = Stride_x * IFMDim_x * multiplying_factor;
+  const unsigned int max_cycles = std::max(cycles_write_block,cycles_read_block);
+  const unsigned int baseIter = IFMDim_x * ConvKernelDim_y * Dilation_y  * multiplying_factor// Initial buffer
+			                  + OFMDim_y * std::max(cycles_write_block,cycles_read_block);
+  unsigned int counter_internal_block = 0;
+  unsigned int current_block_write = 0;
+  unsigned int current_line = 0;
+  unsigned int read_block = 0;
+  unsigned int inp = 0, ofm_y = 0, ofm_x = 0, k_y = 0, k_x = 0, count_simd =0;
+
+  for (unsigned int count_image = 0; count_image < numReps; count_image++) {
+    for (unsigned int i = 0; i < baseIter; i++) {
+#pragma HLS pipeline style=flp II=1
+      if (inp < IFMDim_x * ConvKernelDim_y * Dilation_y *multiplying_factor) {// Initial buffer of ConvKernelDim lines
+        ap_uint<SIMD*Input_precision> inElem;
+        inElem = in.read();
+        inputBuf[current_block_write][current_line] = inElem;
+        current_line++;
+        inp++;
+        if (current_line == Stride_x * IFMDim_x * multiplying_factor ) {
+          current_line = 0;
+          current_block_write++;
+          if (current_block_write == number_blocks) {
+            current_block_write=0;
+          }
+          read_block++;
+          counter_internal_block = 0;
+        }
+      } else {
+        if (counter_internal_block < cycles_write_block-1) { // We are writing output, IFMChan per cycle
+          unsigned int current_block_read = (current_block_write + 1 + (k_y*Dilation_y) / Stride_y);
+          if (current_block_read >= number_blocks) {
+            current_block_read-= number_blocks;
+		  }
+          unsigned int current_line_in_block = ((ofm_x*Stride_x + k_x*Dilation_x)*multiplying_factor + count_simd);
+          ap_uint<SIMD*Input_precision> outElem;
+          outElem = inputBuf[current_block_read][(current_line_in_block)];
+          out.write(outElem);
+          count_simd++;
+          if (count_simd == multiplying_factor) {
+            count_simd=0;
+            k_x++;
+            if (k_x == ConvKernelDim_x) {
+              k_x = 0;
+              k_y++;
+              if (k_y == ConvKernelDim_y) {
+                k_y = 0;
+                ofm_x ++;
+                if (ofm_x == OFMDim_x) {
+                  ofm_x = 0;
+                  ofm_y++;
+                  if (ofm_y == OFMDim_y) {
+                    ofm_y = 0;
+                    inp = 0;
+                  }
+                }
+              }
+            }
+          }
+        }
+        if ((counter_internal_block < cycles_read_block-1) && (read_block<IFMDim_y/Stride_y)) { // In parallel we write in the buffer, in the current block write if we still need to
+          ap_uint<SIMD*Input_precision> inElem;
+          inElem = in.read();
+          inputBuf[current_block_write][current_line] = inElem;
+#pragma AP dependence variable=inputBuf intra false
+#pragma AP dependence variable=inputBuf inter false
+          current_line++;
+          if (current_line == Stride_x * IFMDim_x * multiplying_factor) {// We read the whole block, we change the next block in which we want to we
+            // We filled up a block, let's not read until
+            current_line = 0;
+            read_block++;
+            current_block_write++;
+            if (current_block_write == number_blocks) {
+              current_block_write=0;
+			}
+#pragma AP dependence variable=current_block_write intra false
+          }
+        }
+        counter_internal_block++; // = (counter_internal_block +1) % max_cycles;
+        if (counter_internal_block == (max_cycles-1)) {
+          counter_internal_block = 0;
+        }
+      }
+    } // End base_iter
+	read_block = 0;
+  } // End count_image
+} // End generator
+
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm with support to multiple output pixels.
+ * To be used when kernel is not square and with dilation
+ *
+ * Every output word carries the same kernel position of MMV neighbouring output pixels along the x axis,
+ * the kernel positions being emitted in the order of ConvolutionInputGenerator_NonSquare. Only the rows
+ * spanned by a window plus the pixels of MMV further windows are kept in a circular buffer, which is
+ * replicated MMV times so that all pixels are read in parallel. A group of windows is emitted as soon as its
+ * last pixel has been read, while the input is read ahead as far as the buffer allows.
+ *
+ * \tparam ConvKernelDim_x    	Dimension of the convolutional kernel - x axis
+ * \tparam ConvKernelDim_y    	Dimension of the convolutional kernel - y axis
+ * \tparam IFMChannels      	Number of Input Feature Maps
+ * \tparam Input_precision  	Number bits per pixel
+ * \tparam IFMDim_x          	Width of the Input Feature Map
+ * \tparam IFMDim_y           	Height of the Input Feature Map
+ * \tparam OFMDim_x           	Width of the Output Feature Map
+ * \tparam OFMDim_y           	Height of the Output Feature Map
+ * \tparam SIMD             	Number of input columns computed in parallel
+ * \tparam Stride_x           	Stride of the convolutional kernel - x axis
+ * \tparam Stride_y          	Stride of the convolutional kernel - y axis
+ * \tparam Dilation_x          	Dilation the convolutional kernel - x axis
+ * \tparam Dilation_y          	Dilation the convolutional kernel - y axis
+ * \tparam MMV              	Number of pixels that have to be produced in parallel
+ * \tparam R          	  		Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the parameters
+ *
+ * \param in                	Input stream
+ * \param out               	Output stream
+ * \param numReps           	Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  			Resource type for the hardware implementation of the memory block
+ */
+template<unsigned int ConvKernelDim_x,
+		 unsigned int ConvKernelDim_y,
+		 unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int IFMDim_x,
+		 unsigned int IFMDim_y,
+		 unsigned int OFMDim_x,
+		 unsigned int OFMDim_y,
+		 unsigned int SIMD,
+		 unsigned int Stride_x,
+		 unsigned int Stride_y,
+		 unsigned int Dilation_x,
+		 unsigned int Dilation_y,
+		 unsigned int MMV,
+		 typename R>
+void ConvolutionInputGenerator_NonSquare_Dilated_MMV(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<MultiChanData<MMV, SIMD*Input_precision> > & out,
+		const unsigned int numReps,
+		R const &r) {
+  static_assert(IFMChannels % SIMD == 0, "");
+  static_assert(OFMDim_x % MMV == 0, "");
+  constexpr unsigned int kernel_extent_x = (ConvKernelDim_x-1) * Dilation_x + 1;
+  constexpr unsigned int kernel_extent_y = (ConvKernelDim_y-1) * Dilation_y + 1;
+  static_assert(IFMDim_x >= (OFMDim_x-1)*Stride_x + kernel_extent_x, "OFMDim_x too large for IFMDim_x.");
+  static_assert(IFMDim_y >= (OFMDim_y-1)*Stride_y + kernel_extent_y, "OFMDim_y too large for IFMDim_y.");
+  constexpr unsigned int multiplying_factor = IFMChannels/SIMD;
+  // distance from the first to the last pixel of MMV neighbouring windows
+  constexpr unsigned int window_span = (kernel_extent_y-1)*IFMDim_x + (MMV-1)*Stride_x + kernel_extent_x-1;
+  // buffered pixels: the windows plus the pixels read ahead for the next MMV windows
+  constexpr unsigned int buffer_pixels = window_span + 1 + MMV*Stride_x;
+  constexpr unsigned int in_pixels = IFMDim_x * IFMDim_y;
+  constexpr unsigned int out_words = OFMDim_y * (OFMDim_x/MMV) * ConvKernelDim_x * ConvKernelDim_y * multiplying_factor;
+  // pixel index increments to the next MMV windows and to the first windows of the next row
+  constexpr unsigned int group_step = MMV * Stride_x;
+  constexpr unsigned int row_step = Stride_y * IFMDim_x - (OFMDim_x - MMV) * Stride_x;
+  ap_uint<SIMD*Input_precision> inputBuf[MMV][buffer_pixels * multiplying_factor];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=1
+  memory_resource(inputBuf, r);
+
+  for (unsigned int count_image = 0; count_image < numReps; count_image++) {
+    // reader state
+    unsigned int rd_pix = 0, rd_slot = 0, rd_simd = 0;
+    // emitter state: first pixel of the current windows and its buffer slot
+    unsigned int win_pix = 0, win_slot = 0;
+    unsigned int ofm_x = 0, k_y = 0, k_x = 0, count_simd = 0;
+    unsigned int written = 0;
+    while ((rd_pix < in_pixels) || (written < out_words)) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=inputBuf inter false
+#pragma HLS DEPENDENCE variable=inputBuf intra false
+      // emit the current windows once their last pixel is available
+      if ((written < out_words) && (rd_pix > win_pix + window_span)) {
+        unsigned int const tap = win_slot + k_y*Dilation_y*IFMDim_x + k_x*Dilation_x;
+        MultiChanData<MMV, SIMD*Input_precision> outElem;
+        // parallel read from all input buffers
+        for(unsigned int v = 0; v < MMV; v++) {
+#pragma HLS UNROLL
+          // each buffer's read addr is offset by its buffer index
+          unsigned int slot = tap + v*Stride_x;
+          if (slot >= buffer_pixels) {
+            slot -= buffer_pixels;
+          }
+          outElem.data[v] = inputBuf[v][slot * multiplying_factor + count_simd];
+        }
+        out.write(outElem);
+        written++;
+        count_simd++;
+        if (count_simd == multiplying_factor) {
+          count_simd = 0;
+          k_x++;
+          if (k_x == ConvKernelDim_x) {
+            k_x = 0;
+            k_y++;
+            if (k_y == ConvKernelDim_y) {
+              k_y = 0;
+              // advance to the next MMV windows
+              unsigned int step = group_step;
+              ofm_x += MMV;
+              if (ofm_x == OFMDim_x) {
+                ofm_x = 0;
+                step = row_step;
+              }
+              win_pix += step;
+              win_slot += step % buffer_pixels;
+              if (win_slot >= buffer_pixels) {
+                win_slot -= buffer_pixels;
+              }
+            }
+          }
+        }
+      }
+      // read ahead as long as no pixel of the current windows is overwritten
+      if ((rd_pix < in_pixels) && ((written == out_words) || (rd_pix < win_pix + buffer_pixels))) {
+        ap_uint<SIMD*Input_precision> inElem = in.read();
+        for(unsigned int v = 0; v < MMV; v++) {
+#pragma HLS UNROLL
+          inputBuf[v][rd_slot * multiplying_factor + rd_simd] = inElem;
         }
-        counter_internal_block++; // = (counter_internal_block +1) % max_cycles;
-        if (counter_internal_block == (max_cycles-1)) {
-          counter_internal_block = 0;
+        rd_simd++;
+        if (rd_simd == multiplying_factor) {
+          rd_simd = 0;
+          rd_pix++;
+          rd_slot++;
+          if (rd_slot == buffer_pixels) {
+            rd_slot = 0;
+          }
         }
       }
-    } // End base_iter
-	read_block = 0;
+    }
   } // End count_image
 } // End generator
 
 /**
  * \brief Sliding Window unit that produces output vectors for feeding
- * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm. To be used when kernel is not square and with dilation
- * NOTE: Dilation over the Y axis not yet supported
+ * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm with support to multiple output pixels.
+ * To be used when kernel is not square, see ConvolutionInputGenerator_NonSquare_Dilated_MMV
  *
  * \tparam ConvKernelDim_x    	Dimension of the convolutional kernel - x axis
  * \tparam ConvKernelDim_y    	Dimension of the convolutional kernel - y axis
@@ -1537,8 +2865,7 @@ void ConvolutionInputGenerator_NonSquare_dws(
  * \tparam SIMD             	Number of input columns computed in parallel
  * \tparam Stride_x           	Stride of the convolutional kernel - x axis
  * \tparam Stride_y          	Stride of the convolutional kernel - y axis
- * \tparam Dilation_x          	Dilation the convolutional kernel - x axis
- * \tparam Dilation_y          	Dilation the convolutional kernel - y axis
+ * \tparam MMV              	Number of pixels that have to be produced in parallel
  * \tparam R          	  		Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the parameters
  *
  * \param in                	Input stream
@@ -1557,109 +2884,152 @@ template<unsigned int ConvKernelDim_x,
 		 unsigned int SIMD,
 		 unsigned int Stride_x,
 		 unsigned int Stride_y,
-		 unsigned int Dilation_x,
-		 unsigned int Dilation_y,
+		 unsigned int MMV,
 		 typename R>
-void ConvolutionInputGenerator_NonSquare_Dilated(
+void ConvolutionInputGenerator_NonSquare_MMV(
 		hls::stream<ap_uint<SIMD*Input_precision> > & in,
-		hls::stream<ap_uint<SIMD*Input_precision> > & out,
+		hls::stream<MultiChanData<MMV, SIMD*Input_precision> > & out,
 		const unsigned int numReps,
 		R const &r) {
-  static_assert(IFMChannels % SIMD == 0, "");
-  static_assert(Dilation_y == 1, ""); // Dilation on the Y axes not yet supported, available only for API definition
-
-  const unsigned int multiplying_factor = IFMChannels/SIMD;
-  const unsigned int number_blocks = (ConvKernelDim_y*Dilation_y)/Stride_y + 1 ;
-  ap_uint<SIMD*Input_precision> inputBuf[number_blocks][Stride_x * IFMDim_x * multiplying_factor];
+#pragma HLS INLINE
+  ConvolutionInputGenerator_NonSquare_Dilated_MMV<ConvKernelDim_x, ConvKernelDim_y, IFMChannels, Input_precision,
+    IFMDim_x, IFMDim_y, OFMDim_x, OFMDim_y, SIMD, Stride_x, Stride_y, 1, 1, MMV>(in, out, numReps, r);
+}
 
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Vector_Vector_Activate_Batch, implementing the im2col algorithm for depthwise separable convolutions with
+ * support to multiple output pixels. To be used when kernel is not square
+ *
+ * Every output word carries the same kernel position of MMV neighbouring output pixels along the x axis,
+ * the kernel positions being emitted in the order of ConvolutionInputGenerator_NonSquare_dws. The buffering
+ * is the one of ConvolutionInputGenerator_NonSquare_Dilated_MMV.
+ *
+ * \tparam ConvKernelDim_x    	Dimension of the convolutional kernel - x axis
+ * \tparam ConvKernelDim_y    	Dimension of the convolutional kernel - y axis
+ * \tparam IFMChannels      	Number of Input Feature Maps
+ * \tparam Input_precision  	Number bits per pixel
+ * \tparam IFMDim_x          	Width of the Input Feature Map
+ * \tparam IFMDim_y           	Height of the Input Feature Map
+ * \tparam OFMDim_x           	Width of the Output Feature Map
+ * \tparam OFMDim_y           	Height of the Output Feature Map
+ * \tparam SIMD             	Number of input columns computed in parallel
+ * \tparam Stride_x           	Stride of the convolutional kernel - x axis
+ * \tparam Stride_y          	Stride of the convolutional kernel - y axis
+ * \tparam MMV              	Number of pixels that have to be produced in parallel
+ * \tparam R          	  		Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the parameters
+ *
+ * \param in                	Input stream
+ * \param out               	Output stream
+ * \param numReps           	Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  			Resource type for the hardware implementation of the memory block
+ */
+template<unsigned int ConvKernelDim_x,
+		 unsigned int ConvKernelDim_y,
+		 unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int IFMDim_x,
+		 unsigned int IFMDim_y,
+		 unsigned int OFMDim_x,
+		 unsigned int OFMDim_y,
+		 unsigned int SIMD,
+		 unsigned int Stride_x,
+		 unsigned int Stride_y,
+		 unsigned int MMV,
+		 typename R>
+void ConvolutionInputGenerator_NonSquare_dws_MMV(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<MultiChanData<MMV, SIMD*Input_precision> > & out,
+		const unsigned int numReps,
+		R const &r) {
+  static_assert(IFMChannels % SIMD == 0, "");
+  static_assert(OFMDim_x % MMV == 0, "");
+  static_assert(IFMDim_x >= (OFMDim_x-1)*Stride_x + ConvKernelDim_x, "OFMDim_x too large for IFMDim_x.");
+  static_assert(IFMDim_y >= (OFMDim_y-1)*Stride_y + ConvKernelDim_y, "OFMDim_y too large for IFMDim_y.");
+  constexpr unsigned int multiplying_factor = IFMChannels/SIMD;
+  // distance from the first to the last pixel of MMV neighbouring windows
+  constexpr unsigned int window_span = (ConvKernelDim_y-1)*IFMDim_x + (MMV-1)*Stride_x + ConvKernelDim_x-1;
+  // buffered pixels: the windows plus the pixels read ahead for the next MMV windows
+  constexpr unsigned int buffer_pixels = window_span + 1 + MMV*Stride_x;
+  constexpr unsigned int in_pixels = IFMDim_x * IFMDim_y;
+  constexpr unsigned int out_words = OFMDim_y * (OFMDim_x/MMV) * ConvKernelDim_x * ConvKernelDim_y * multiplying_factor;
+  // pixel index increments to the next MMV windows and to the first windows of the next row
+  constexpr unsigned int group_step = MMV * Stride_x;
+  constexpr unsigned int row_step = Stride_y * IFMDim_x - (OFMDim_x - MMV) * Stride_x;
+  ap_uint<SIMD*Input_precision> inputBuf[MMV][buffer_pixels * multiplying_factor];
 #pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=1
   memory_resource(inputBuf, r);
-  const unsigned int cycles_write_block = (OFMDim_x * ConvKernelDim_x * ConvKernelDim_y * multiplying_factor);
-  const unsigned int cycles_read_block = Stride_x * IFMDim_x * multiplying_factor;
-  const unsigned int max_cycles = std::max(cycles_write_block,cycles_read_block);
-  const unsigned int baseIter = IFMDim_x * ConvKernelDim_y * Dilation_y  * multiplying_factor// Initial buffer
-			                  + OFMDim_y * std::max(cycles_write_block,cycles_read_block);
-  unsigned int counter_internal_block = 0;
-  unsigned int current_block_write = 0;
-  unsigned int current_line = 0;
-  unsigned int read_block = 0;
-  unsigned int inp = 0, ofm_y = 0, ofm_x = 0, k_y = 0, k_x = 0, count_simd =0;
 
   for (unsigned int count_image = 0; count_image < numReps; count_image++) {
-    for (unsigned int i = 0; i < baseIter; i++) {
+    // reader state
+    unsigned int rd_pix = 0, rd_slot = 0, rd_simd = 0;
+    // emitter state: first pixel of the current windows and its buffer slot
+    unsigned int win_pix = 0, win_slot = 0;
+    unsigned int ofm_x = 0, k_y = 0, k_x = 0, count_simd = 0;
+    unsigned int written = 0;
+    while ((rd_pix < in_pixels) || (written < out_words)) {
 #pragma HLS pipeline style=flp II=1
-      if (inp < IFMDim_x * ConvKernelDim_y * Dilation_y *multiplying_factor) {// Initial buffer of ConvKernelDim lines
-        ap_uint<SIMD*Input_precision> inElem;
-        inElem = in.read();
-        inputBuf[current_block_write][current_line] = inElem;
-        current_line++;
-        inp++;
-        if (current_line == Stride_x * IFMDim_x * multiplying_factor ) {
-          current_line = 0;
-          current_block_write++;
-          if (current_block_write == number_blocks) {
-            current_block_write=0;
+#pragma HLS DEPENDENCE variable=inputBuf inter false
+#pragma HLS DEPENDENCE variable=inputBuf intra false
+      // emit the current windows once their last pixel is available
+      if ((written < out_words) && (rd_pix > win_pix + window_span)) {
+        unsigned int const tap = win_slot + k_y*IFMDim_x + k_x;
+        MultiChanData<MMV, SIMD*Input_precision> outElem;
+        // parallel read from all input buffers
+        for(unsigned int v = 0; v < MMV; v++) {
+#pragma HLS UNROLL
+          // each buffer's read addr is offset by its buffer index
+          unsigned int slot = tap + v*Stride_x;
+          if (slot >= buffer_pixels) {
+            slot -= buffer_pixels;
           }
-          read_block++;
-          counter_internal_block = 0;
+          outElem.data[v] = inputBuf[v][slot * multiplying_factor + count_simd];
         }
-      } else {
-        if (counter_internal_block < cycles_write_block-1) { // We are writing output, IFMChan per cycle
-          unsigned int current_block_read = (current_block_write + 1 + (k_y*Dilation_y) / Stride_y);
-          if (current_block_read >= number_blocks) {
-            current_block_read-= number_blocks;
-		  }
-          unsigned int current_line_in_block = ((ofm_x*Stride_x + k_x*Dilation_x)*multiplying_factor + count_simd);
-          ap_uint<SIMD*Input_precision> outElem;
-          outElem = inputBuf[current_block_read][(current_line_in_block)];
-          out.write(outElem);
-          count_simd++;
-          if (count_simd == multiplying_factor) {
-            count_simd=0;
-            k_x++;
-            if (k_x == ConvKernelDim_x) {
-              k_x = 0;
-              k_y++;
-              if (k_y == ConvKernelDim_y) {
-                k_y = 0;
-                ofm_x ++;
-                if (ofm_x == OFMDim_x) {
-                  ofm_x = 0;
-                  ofm_y++;
-                  if (ofm_y == OFMDim_y) {
-                    ofm_y = 0;
-                    inp = 0;
-                  }
-                }
+        out.write(outElem);
+        written++;
+        k_x++;
+        if (k_x == ConvKernelDim_x) {
+          k_x = 0;
+          k_y++;
+          if (k_y == ConvKernelDim_y) {
+            k_y = 0;
+            count_simd++;
+            if (count_simd == multiplying_factor) {
+              count_simd = 0;
+              // advance to the next MMV windows
+              unsigned int step = group_step;
+              ofm_x += MMV;
+              if (ofm_x == OFMDim_x) {
+                ofm_x = 0;
+                step = row_step;
+              }
+              win_pix += step;
+              win_slot += step % buffer_pixels;
+              if (win_slot >= buffer_pixels) {
+                win_slot -= buffer_pixels;
               }
             }
           }
         }
-        if ((counter_internal_block < cycles_read_block-1) && (read_block<IFMDim_y/Stride_y)) { // In parallel we write in the buffer, in the current block write if we still need to
-          ap_uint<SIMD*Input_precision> inElem;
-          inElem = in.read();
-          inputBuf[current_block_write][current_line] = inElem;
-#pragma AP dependence variable=inputBuf intra false
-#pragma AP dependence variable=inputBuf inter false
-          current_line++;
-          if (current_line == Stride_x * IFMDim_x * multiplying_factor) {// We read the whole block, we change the next block in which we want to we
-            // We filled up a block, let's not read until
-            current_line = 0;
-            read_block++;
-            current_block_write++;
-            if (current_block_write == number_blocks) {
-              current_block_write=0;
-			}
-#pragma AP dependence variable=current_block_write intra false
-          }
+      }
+      // read ahead as long as no pixel of the current windows is overwritten
+      if ((rd_pix < in_pixels) && ((written == out_words) || (rd_pix < win_pix + buffer_pixels))) {
+        ap_uint<SIMD*Input_precision> inElem = in.read();
+        for(unsigned int v = 0; v < MMV; v++) {
+#pragma HLS UNROLL
+          inputBuf[v][rd_slot * multiplying_factor + rd_simd] = inElem;
         }
-        counter_internal_block++; // = (counter_internal_block +1) % max_cycles;
-        if (counter_internal_block == (max_cycles-1)) {
-          counter_internal_block = 0;
+        rd_simd++;
+        if (rd_simd == multiplying_factor) {
+          rd_simd = 0;
+          rd_pix++;
+          rd_slot++;
+          if (rd_slot == buffer_pixels) {
+            rd_slot = 0;
+          }
         }
       }
-    } // End base_iter
-	read_block = 0;
+    }
   } // End count_image
 } // End generator
 
@@ -1774,6 +3144,130 @@ void ConvolutionInputGenerator_1D_parallel(
   } // End count_image
 } // End generator
 
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm.
+ * Feeds all ConvKernelDim x ConvKernelDim pixels of the window in parallel for full SIMD unfolding of the
+ * following layer, so that a Matrix_Vector_Activate_Batch with SIMD = ConvKernelDim*ConvKernelDim*IFMChannels
+ * computes one output pixel per cycle.
+ *
+ * The input is read at one word per cycle into ConvKernelDim-1 line buffers, and the column of
+ * ConvKernelDim vertically adjacent words is shifted into a ConvKernelDim x ConvKernelDim shift-register
+ * window from which the output is taken. Word (ky*ConvKernelDim + kx) of an output vector holds tap
+ * (ky, kx), the first one in the LSBs. With SIMD < IFMChannels, the IFMChannels/SIMD folds of a window are
+ * output in consecutive cycles, so that the weights of the following layer are ordered with the fold
+ * outermost, i.e. by fold, ky, kx and then SIMD lane. Input pixels not covered by any window are consumed
+ * and dropped.
+ *
+ * \tparam ConvKernelDim    	Dimension of the convolutional kernel (assumed square)
+ * \tparam IFMChannels      	Number of Input Feature Maps
+ * \tparam Input_precision  	Number bits per pixel
+ * \tparam IFMDim           	Width and Heigth of the Input Feature Map (assumed square)
+ * \tparam OFMDim           	Width and Heigth of the Output Feature Map (assumed square)
+ * \tparam Stride          	    Stride of the convolutional kernel
+ * \tparam SIMD             	Number of input columns computed in parallel
+ * \tparam R          	  		Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the parameters
+ *
+ * \param in                	Input stream
+ * \param out               	Output stream
+ * \param numReps           	Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  			      Resource type for the hardware implementation of the line buffers
+*/
+template<unsigned int ConvKernelDim,
+		 unsigned int IFMChannels,
+		 unsigned int Input_precision,
+		 unsigned int IFMDim,
+		 unsigned int OFMDim,
+		 unsigned int Stride,
+		 unsigned int SIMD,
+		 typename R>
+void ConvolutionInputGenerator_2D_parallel(
+		hls::stream<ap_uint<SIMD*Input_precision> > & in,
+		hls::stream<ap_uint<ConvKernelDim*ConvKernelDim*SIMD*Input_precision> > & out,
+		const unsigned int numReps,
+		R const &r) {
+
+  static_assert(IFMChannels % SIMD == 0, "");
+  static_assert((OFMDim - 1) * Stride + ConvKernelDim <= IFMDim, "");
+  constexpr unsigned  multiplying_factor = IFMChannels/SIMD;
+  constexpr unsigned  K = ConvKernelDim;
+  // shift registers of K pixels per window row, the newest word last
+  constexpr unsigned  row_words = K * multiplying_factor;
+  using  word_t = ap_uint<SIMD*Input_precision>;
+
+  word_t  lineBuf[K > 1? K-1 : 1][IFMDim * multiplying_factor];
+#pragma HLS ARRAY_PARTITION variable=lineBuf complete dim=1
+  memory_resource(lineBuf, r);
+#pragma HLS DEPENDENCE variable=lineBuf inter false
+  word_t  window[K][row_words];
+#pragma HLS ARRAY_PARTITION variable=window complete dim=0
+
+  for (unsigned int count_image = 0; count_image < numReps; count_image++) {
+    unsigned int  x = 0, y = 0, f = 0;
+    // window column and row within the stride, and output column and row
+    unsigned int  px = 0, py = 0, ox = 0, oy = 0;
+    for (unsigned int i = 0; i < IFMDim * IFMDim * multiplying_factor; i++) {
+#pragma HLS pipeline style=flp II=1
+      word_t const  inElem = in.read();
+      unsigned int const  addr = x * multiplying_factor + f;
+
+      // column of the K vertically adjacent words ending with the input
+      word_t  column[K];
+#pragma HLS ARRAY_PARTITION variable=column complete
+      for (unsigned int ky = 0; ky+1 < K; ky++) {
+#pragma HLS UNROLL
+        column[ky] = lineBuf[ky][addr];
+      }
+      column[K-1] = inElem;
+      for (unsigned int ky = 0; ky+1 < K; ky++) {
+#pragma HLS UNROLL
+        lineBuf[ky][addr] = column[ky+1];
+      }
+
+      for (unsigned int ky = 0; ky < K; ky++) {
+#pragma HLS UNROLL
+        for (unsigned int j = 0; j+1 < row_words; j++) {
+#pragma HLS UNROLL
+          window[ky][j] = window[ky][j+1];
+        }
+        window[ky][row_words-1] = column[ky];
+      }
+
+      bool const  emit = (y+1 >= K) && (x+1 >= K) && (py == 0) && (px == 0) && (oy < OFMDim) && (ox < OFMDim);
+      if (emit) {
+        ap_uint<K*K*SIMD*Input_precision>  outElem;
+        for (unsigned int ky = 0; ky < K; ky++) {
+#pragma HLS UNROLL
+          for (unsigned int kx = 0; kx < K; kx++) {
+#pragma HLS UNROLL
+            unsigned int const  tap = ky*K + kx;
+            outElem((tap+1)*SIMD*Input_precision-1, tap*SIMD*Input_precision) = window[ky][(kx+1)*multiplying_factor-1];
+          }
+        }
+        out.write(outElem);
+      }
+
+      if (++f == multiplying_factor) {
+        f = 0;
+        if (x+1 >= K) {
+          if (px == 0)  ox++;
+          if (++px == Stride)  px = 0;
+        }
+        if (++x == IFMDim) {
+          x = 0;
+          px = 0;
+          ox = 0;
+          if (y+1 >= K) {
+            if (py == 0)  oy++;
+            if (++py == Stride)  py = 0;
+          }
+          y++;
+        }
+      }
+    }
+  } // End count_image
+} // End generator
+
 /**
  * \brief Sliding Window unit that produces output vectors for feeding
  * a Vector_Vector_Activate_Batch, implementing the im2col algorithm. To be used with 1D kernels
@@ -1930,6 +3424,53 @@ void ConvolutionInputGenerator_1D(
 	}
 }
 
+/**
+ * \brief Sliding Window unit that produces output vectors for feeding
+ * a Matrix_Vector_Activate_Batch, implementing the im2col algorithm with support to multiple output pixels.
+ * To be used only for 1D feature maps
+ *
+ * Every output word carries the same kernel position of MMV neighbouring output pixels, the kernel positions
+ * being emitted in the order of ConvolutionInputGenerator_1D. Only (MMV-1)*Stride_x + ConvKernelDim_x + MMV*Stride_x
+ * pixels are buffered, see ConvolutionInputGenerator_NonSquare_Dilated_MMV.
+ *
+ * \tparam ConvKernelDim_x    	Dimension of the convolutional kernel - x axis
+ * \tparam IFMChannels      	Number of Input Feature Maps
+ * \tparam Input_precision  	Number bits per pixel
+ * \tparam IFMDim_x          	Width of the Input Feature Map
+ * \tparam OFMDim_x           	Width of the Output Feature Map
+ * \tparam Stride_x           	Stride of the convolutional kernel - x axis
+ * \tparam SIMD             	Number of input columns computed in parallel
+ * \tparam MMV              	Number of pixels that have to be produced in parallel
+ * \tparam R          	  		Datatype for the resource used for FPGA implementation of the SWG  - safely deducible from the parameters
+ *
+ * \param in                	Input stream
+ * \param out               	Output stream
+ * \param numReps           	Number of time the function has to be repeatedly executed (e.g. number of images)
+ * \param r			  			Resource type for the hardware implementation of the memory block
+ */
+template<
+	unsigned  ConvKernelDim_x,
+	unsigned  IFMChannels,
+	unsigned  Input_precision,
+	unsigned  IFMDim_x,
+	unsigned  OFMDim_x,
+	unsigned  Stride_x,
+	unsigned  SIMD,
+	unsigned  MMV,
+	typename  R		// Memory resource selector
+>
+void ConvolutionInputGenerator_1D_MMV(
+	hls::stream<ap_uint<SIMD*Input_precision>> &in,
+	hls::stream<MultiChanData<MMV, SIMD*Input_precision>> &out,
+	unsigned const  numReps,
+	R const &r
+) {
+#pragma HLS INLINE
+	static_assert(OFMDim_x == ((IFMDim_x - ConvKernelDim_x) / Stride_x + 1), "Unexpected OFM dimension");
+	ConvolutionInputGenerator_NonSquare_Dilated_MMV<ConvKernelDim_x, 1, IFMChannels, Input_precision,
+		IFMDim_x, 1, OFMDim_x, 1, SIMD, Stride_x, 1, 1, 1, MMV>(in, out, numReps, r);
+}
+
 /**
  * \brief Sliding Window unit that produces output vectors for feeding
  * a Vector_Vector_Activate_Batch, implementing the im2col algorithm. To be used with 1D kernels
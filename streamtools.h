@@ -49,6 +49,7 @@
 #define STREAMTOOLS_H
 
 #include "ap_axi_sdata.h"
+#include <type_traits>
 
 /**
  * \brief   Stream limiter - limits the number of stream packets
@@ -417,6 +418,307 @@ void FMPadding_Batch(
 	}
 }
 
+namespace detail {
+
+	/** Read order of a block row by SpaceToDepth_Batch: output pixels, block rows, block columns, channel folds. */
+	template<unsigned int ImgDim, unsigned int Block, unsigned int CF>
+	struct space_to_depth_order {
+		unsigned int  ox = 0, by = 0, bx = 0, cf = 0;
+		unsigned int addr() const {
+#pragma HLS inline
+			return  ((by*ImgDim + ox*Block + bx) * CF) + cf;
+		}
+		void next() {
+#pragma HLS inline
+			if(++cf == CF) {
+				cf = 0;
+				if(++bx == Block) {
+					bx = 0;
+					if(++by == Block) {
+						by = 0;
+						if(++ox == ImgDim/Block)  ox = 0;
+					}
+				}
+			}
+		}
+	};
+
+	/** Read order of an input row by DepthToSpace_Batch: block rows, input pixels, block columns, channel folds. */
+	template<unsigned int ImgDim, unsigned int Block, unsigned int CF>
+	struct depth_to_space_order {
+		unsigned int  by = 0, ix = 0, bx = 0, cf = 0;
+		unsigned int addr() const {
+#pragma HLS inline
+			return  (((ix*Block + by)*Block + bx) * CF) + cf;
+		}
+		void next() {
+#pragma HLS inline
+			if(++cf == CF) {
+				cf = 0;
+				if(++bx == Block) {
+					bx = 0;
+					if(++ix == ImgDim) {
+						ix = 0;
+						if(++by == Block)  by = 0;
+					}
+				}
+			}
+		}
+	};
+
+	/**
+	 * Writes rows of Words words into one half of a ping-pong buffer while the previous row is
+	 * read from the other half in the given Order, one word per cycle each.
+	 */
+	template<unsigned int Words, typename Order, int W>
+	void reorder_rows(hls::stream<ap_uint<W>> &in, hls::stream<ap_uint<W>> &out, unsigned int const  rows) {
+		ap_uint<W>  buf[2][Words];
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+#pragma HLS DEPENDENCE variable=buf inter false
+		Order  order;
+		unsigned int  row = 0;
+		unsigned int  i = 0;
+		unsigned int const  total = rows? (rows + 1) * Words : 0;
+		for(unsigned int  k = 0; k < total; k++) {
+#pragma HLS pipeline style=flp II=1
+			if(row < rows)  buf[row & 1][i] = in.read();
+			if(row > 0) {
+				out.write(buf[~row & 1][order.addr()]);
+				order.next();
+			}
+			if(++i == Words) {
+				i = 0;
+				row++;
+			}
+		}
+	}
+
+} // namespace detail
+
+/**
+ * \brief   Space to depth - Moves every Block x Block tile of pixels into the channels of a single pixel
+ *
+ * Implements the reorg layer of YOLO-style networks. Output pixel (y, x) holds channel c of input pixel
+ * (y*Block + by, x*Block + bx) in its channel (by*Block + bx)*NumChannels + c. A row of Block input rows
+ * is buffered while the previous one is emitted, so that one SIMD word is passed per cycle.
+ *
+ * \tparam	ImgDim			Width and Heigth of the input feature map, a multiple of Block
+ * \tparam	Block			Edge of the pixel tiles
+ * \tparam	NumChannels		Number of channels of the input feature map
+ * \tparam	SIMD			Number of channels per stream word, dividing NumChannels
+ * \tparam	In_t			Element datatype
+ *
+ * \param	in		Input stream
+ * \param	out		Output stream, with Block*Block*NumChannels channels per pixel
+ * \param	numReps	Number of frames / images
+ */
+template<
+	unsigned  ImgDim,
+	unsigned  Block,
+	unsigned  NumChannels,
+	unsigned  SIMD,
+	typename  In_t
+>
+void SpaceToDepth_Batch(
+	hls::stream<ap_uint<SIMD*In_t::width>> &in,
+	hls::stream<ap_uint<SIMD*In_t::width>> &out,
+	unsigned const  numReps
+) {
+	static_assert(ImgDim % Block == 0, "Block must divide ImgDim.");
+	static_assert(NumChannels % SIMD == 0, "SIMD must divide NumChannels.");
+	constexpr unsigned  CF = NumChannels / SIMD;
+	detail::reorder_rows<Block * ImgDim * CF, detail::space_to_depth_order<ImgDim, Block, CF>>(in, out, numReps * (ImgDim / Block));
+}
+
+/**
+ * \brief   Depth to space - Spreads the channels of every pixel over a Block x Block tile of pixels
+ *
+ * Implements the pixel shuffle of super-resolution networks as the inverse of SpaceToDepth_Batch: channel
+ * (by*Block + bx)*NumChannels + c of input pixel (y, x) becomes channel c of output pixel
+ * (y*Block + by, x*Block + bx). An input row is buffered while the previous one is emitted, so that one SIMD
+ * word is passed per cycle.
+ *
+ * \tparam	ImgDim			Width and Heigth of the input feature map
+ * \tparam	Block			Edge of the pixel tiles
+ * \tparam	NumChannels		Number of channels of the output feature map
+ * \tparam	SIMD			Number of channels per stream word, dividing NumChannels
+ * \tparam	In_t			Element datatype
+ *
+ * \param	in		Input stream, with Block*Block*NumChannels channels per pixel
+ * \param	out		Output stream
+ * \param	numReps	Number of frames / images
+ */
+template<
+	unsigned  ImgDim,
+	unsigned  Block,
+	unsigned  NumChannels,
+	unsigned  SIMD,
+	typename  In_t
+>
+void DepthToSpace_Batch(
+	hls::stream<ap_uint<SIMD*In_t::width>> &in,
+	hls::stream<ap_uint<SIMD*In_t::width>> &out,
+	unsigned const  numReps
+) {
+	static_assert(NumChannels % SIMD == 0, "SIMD must divide NumChannels.");
+	constexpr unsigned  CF = NumChannels / SIMD;
+	detail::reorder_rows<ImgDim * Block * Block * CF, detail::depth_to_space_order<ImgDim, Block, CF>>(in, out, numReps * ImgDim);
+}
+
+namespace detail {
+
+	/**
+	 * Position in a frame buffered by layout_transpose. The element of pixel p and channel c is kept in bank
+	 * (p + c) % SIMD at address (p / SIMD) * NumChannels + c, so that both SIMD pixels of a channel (planar)
+	 * and SIMD channels of a pixel (interleaved) lie in distinct banks. Bank b holds the lane
+	 * (b - rot) % SIMD of the word at address base, plus that lane for interleaved words.
+	 */
+	template<unsigned int NumPixels, unsigned int NumChannels, unsigned int SIMD, bool Interleaved>
+	struct layout_position {
+		// planar: channel and pixel group, interleaved: pixel and channel group
+		unsigned int  outer = 0, inner = 0;
+		unsigned int  rot = 0;
+		unsigned int  base = 0;
+
+		unsigned int addr(unsigned int const  bank) const {
+#pragma HLS inline
+			return  Interleaved? base + (bank + SIMD - rot) % SIMD : base;
+		}
+		void next() {
+#pragma HLS inline
+			constexpr unsigned int  Outer = Interleaved? NumPixels : NumChannels;
+			constexpr unsigned int  Inner = (Interleaved? NumChannels : NumPixels) / SIMD;
+			if(++inner == Inner) {
+				inner = 0;
+				if(++outer == Outer)  outer = 0;
+			}
+			rot = outer % SIMD;
+			base = Interleaved? (outer / SIMD) * NumChannels + inner * SIMD : inner * NumChannels + outer;
+		}
+	};
+
+	/** Rotates the SIMD lanes of a word by rot lanes towards the MSBs. */
+	template<unsigned int SIMD, unsigned int W>
+	ap_uint<SIMD*W> rotate_lanes(ap_uint<SIMD*W> const &word, unsigned int const  rot) {
+#pragma HLS inline
+		ap_uint<2*SIMD*W>  dbl = (word, word);
+		return  ap_uint<SIMD*W>(dbl >> ((SIMD - rot) % SIMD * W));
+	}
+
+	template<unsigned int NumPixels, unsigned int NumChannels, unsigned int SIMD, bool PlanarIn, typename In_t, typename R>
+	void layout_transpose(hls::stream<ap_uint<SIMD*In_t::width>> &in, hls::stream<ap_uint<SIMD*In_t::width>> &out,
+		unsigned int const  numReps, R const &r) {
+		static_assert(NumPixels % SIMD == 0, "SIMD must divide NumPixels.");
+		static_assert(NumChannels % SIMD == 0, "SIMD must divide NumChannels.");
+		constexpr unsigned int  W = In_t::width;
+		constexpr unsigned int  Words = NumPixels * NumChannels / SIMD;
+
+		ap_uint<W>  buf[2][SIMD][Words];
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=2
+#pragma HLS DEPENDENCE variable=buf inter false
+		memory_resource(buf, r);
+
+		layout_position<NumPixels, NumChannels, SIMD, !PlanarIn>  wr;
+		layout_position<NumPixels, NumChannels, SIMD, PlanarIn>  rd;
+		unsigned int  frame = 0;
+		unsigned int  i = 0;
+		unsigned int const  total = numReps? (numReps + 1) * Words : 0;
+		for(unsigned int  k = 0; k < total; k++) {
+#pragma HLS pipeline style=flp II=1
+			if(frame < numReps) {
+				ap_uint<SIMD*W> const  banked = rotate_lanes<SIMD, W>(in.read(), wr.rot);
+				for(unsigned int  b = 0; b < SIMD; b++) {
+#pragma HLS UNROLL
+					buf[frame & 1][b][wr.addr(b)] = banked((b+1)*W-1, b*W);
+				}
+				wr.next();
+			}
+			if(frame > 0) {
+				ap_uint<SIMD*W>  banked;
+				for(unsigned int  b = 0; b < SIMD; b++) {
+#pragma HLS UNROLL
+					banked((b+1)*W-1, b*W) = buf[~frame & 1][b][rd.addr(b)];
+				}
+				out.write(rotate_lanes<SIMD, W>(banked, (SIMD - rd.rot) % SIMD));
+				rd.next();
+			}
+			if(++i == Words) {
+				i = 0;
+				frame++;
+			}
+		}
+	}
+
+} // namespace detail
+
+/**
+ * \brief   Layout transpose - Converts frames from planar (NCHW) to interleaved (NHWC) order
+ *
+ * The input holds SIMD consecutive pixels of a channel per word, channel by channel. The output holds SIMD
+ * consecutive channels of a pixel per word, pixel by pixel, as read by all other blocks of the library.
+ * A frame is written into one half of a double buffer while the previous one is read from the other, so that
+ * consecutive frames overlap at one word per cycle. The buffer holds two frames in SIMD banks.
+ *
+ * \tparam	NumPixels		Number of pixels per frame, i.e. height times width
+ * \tparam	NumChannels		Number of channels
+ * \tparam	SIMD			Number of elements per stream word, dividing NumPixels and NumChannels
+ * \tparam	In_t			Element datatype
+ * \tparam	R				Resource type of the frame buffer - safely deducible from the paramaters
+ *
+ * \param	in		Input stream in NCHW order
+ * \param	out		Output stream in NHWC order
+ * \param	numReps	Number of frames / images
+ * \param	r		Resource type of the frame buffer, see memory_resource
+ */
+template<
+	unsigned  NumPixels,
+	unsigned  NumChannels,
+	unsigned  SIMD,
+	typename  In_t,
+	typename  R
+>
+void NCHWToNHWC_Batch(
+	hls::stream<ap_uint<SIMD*In_t::width>> &in,
+	hls::stream<ap_uint<SIMD*In_t::width>> &out,
+	unsigned const  numReps,
+	R const &r
+) {
+	detail::layout_transpose<NumPixels, NumChannels, SIMD, true, In_t>(in, out, numReps, r);
+}
+
+/**
+ * \brief   Layout transpose - Converts frames from interleaved (NHWC) to planar (NCHW) order
+ *
+ * The inverse of NCHWToNHWC_Batch with the same double buffer.
+ *
+ * \tparam	NumPixels		Number of pixels per frame, i.e. height times width
+ * \tparam	NumChannels		Number of channels
+ * \tparam	SIMD			Number of elements per stream word, dividing NumPixels and NumChannels
+ * \tparam	In_t			Element datatype
+ * \tparam	R				Resource type of the frame buffer - safely deducible from the paramaters
+ *
+ * \param	in		Input stream in NHWC order
+ * \param	out		Output stream in NCHW order
+ * \param	numReps	Number of frames / images
+ * \param	r		Resource type of the frame buffer, see memory_resource
+ */
+template<
+	unsigned  NumPixels,
+	unsigned  NumChannels,
+	unsigned  SIMD,
+	typename  In_t,
+	typename  R
+>
+void NHWCToNCHW_Batch(
+	hls::stream<ap_uint<SIMD*In_t::width>> &in,
+	hls::stream<ap_uint<SIMD*In_t::width>> &out,
+	unsigned const  numReps,
+	R const &r
+) {
+	detail::layout_transpose<NumPixels, NumChannels, SIMD, false, In_t>(in, out, numReps, r);
+}
+
 /**
  * \brief   Stream Data Width Converter - Converts the width of the input stream in the output stream
  *
@@ -440,6 +742,8 @@ template<unsigned int InWidth,
 void StreamingDataWidthConverter_Batch(hls::stream<ap_uint<InWidth> > & in,
 		hls::stream<ap_uint<OutWidth> > & out, const unsigned int numReps) {
   static_assert((InWidth % OutWidth == 0) || (OutWidth % InWidth == 0), "");
+  FINN_STREAM_CHECK_IN(in, 1ull * numReps * NumInWords);
+  FINN_STREAM_CHECK_OUT(out, 1ull * numReps * NumInWords * InWidth / OutWidth);
 
   if (InWidth > OutWidth) {
     // emit multiple output words per input word read
@@ -495,6 +799,141 @@ void StreamingDataWidthConverter_Batch(hls::stream<ap_uint<InWidth> > & in,
   }
 }
 
+/**
+ * \brief   Stream Data Width Converter - Converts the width of the input stream in the output stream,
+ *          with the number of words per repetition given at runtime
+ *
+ * Runtime-count variant of StreamingDataWidthConverter_Batch, e.g. for feature maps whose
+ * dimensions are only known at runtime.
+ *
+ * \tparam     InWidth      Width, in number of bits, of the input stream
+ * \tparam     OutWidth     Width, in number of bits, of the output stream
+ *
+ * \param      in           Input stream
+ * \param      out          Output stream
+ * \param      numInWords   Number of input words to process per repetition
+ * \param      numReps      Number of times the function has to be called
+ *
+ */
+template<unsigned int InWidth,
+		unsigned int OutWidth
+>
+void StreamingDataWidthConverter_Dynamic_Batch(hls::stream<ap_uint<InWidth> > & in,
+		hls::stream<ap_uint<OutWidth> > & out, const unsigned int numInWords, const unsigned int numReps) {
+  static_assert((InWidth % OutWidth == 0) || (OutWidth % InWidth == 0), "");
+
+  if (InWidth > OutWidth) {
+    // emit multiple output words per input word read
+    const unsigned int outPerIn = InWidth / OutWidth;
+    const unsigned int totalIters = numInWords * outPerIn * numReps;
+    unsigned int o = 0;
+    ap_uint<InWidth> ei = 0;
+    for (unsigned int t = 0; t < totalIters; t++) {
+#pragma HLS pipeline style=flp II=1
+      // read new input word if current out count is zero
+      if (o == 0) {
+        ei = in.read();
+	  }
+      // pick output word from the rightmost position
+      ap_uint<OutWidth> eo = ei(OutWidth - 1, 0);
+      out.write(eo);
+      // shift input to get new output word for next iteration
+      ei = ei >> OutWidth;
+      // increment written output count
+      o++;
+      // wraparound indices to recreate the nested loop structure
+      if (o == outPerIn) {
+        o = 0;
+      }
+    }
+  } else if (InWidth == OutWidth) {
+    // straight-through copy
+    for (unsigned int i = 0; i < numInWords * numReps; i++) {
+#pragma HLS pipeline style=flp II=1
+      ap_uint<InWidth> e = in.read();
+      out.write(e);
+    }
+  } else { // InWidth < OutWidth
+    // read multiple input words per output word emitted
+    const unsigned int inPerOut = OutWidth / InWidth;
+    const unsigned int totalIters = numInWords * numReps;
+    unsigned int i = 0;
+    ap_uint<OutWidth> eo = 0;
+    for (unsigned int t = 0; t < totalIters; t++) {
+#pragma HLS pipeline style=flp II=1
+      // read input and shift into output buffer
+      ap_uint<InWidth> ei = in.read();
+      eo = eo >> InWidth;
+      eo(OutWidth - 1, OutWidth - InWidth) = ei;
+      // increment read input count
+      i++;
+      // wraparound logic to recreate nested loop functionality
+      if (i == inPerOut) {
+        i = 0;
+        out.write(eo);
+      }
+    }
+  }
+}
+
+/**
+ * \brief   Stream Data Width Converter Generalized - Converts the width of the input stream in the output stream
+ *          for arbitrary widths
+ *
+ * Used to upscale or downscale a stream by any ratio of InWidth and OutWidth. The input bits are collected,
+ * LSB first, in a residue buffer of InWidth+OutWidth-1 bits, from which an output word is emitted as soon as
+ * it is complete. One input word can be read and one output word written every cycle.
+ * NumOutWords output words are produced per repetition: if they carry more bits than the input, the last
+ * output word is padded with zeroes; if they carry fewer, the remaining input bits are discarded (flushed).
+ *
+ * \tparam     InWidth      Width, in number of bits, of the input stream
+ * \tparam     OutWidth     Width, in number of bits, of the output stream 
+ * \tparam     NumInWords   Number of input words to process per repetition
+ * \tparam     NumOutWords  Number of output words to produce per repetition
+ *
+ * \param      in           Input stream
+ * \param      out          Output stream
+ * \param      numReps      Number of times the function has to be called
+ *
+ */
+template<unsigned int InWidth,
+		unsigned int OutWidth,
+		unsigned int NumInWords,
+		unsigned int NumOutWords = (NumInWords * InWidth + OutWidth - 1) / OutWidth
+>
+void StreamingDataWidthConverterGeneralized_Batch(hls::stream<ap_uint<InWidth> > & in,
+		hls::stream<ap_uint<OutWidth> > & out, const unsigned int numReps) {
+  constexpr unsigned int BufWidth = InWidth + OutWidth - 1;
+
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+    ap_uint<BufWidth> buf = 0;
+    // number of valid bits in buf
+    unsigned int fill = 0;
+    unsigned int rd = 0, wr = 0;
+    while ((rd < NumInWords) || (wr < NumOutWords)) {
+#pragma HLS pipeline style=flp II=1
+      // emit a complete output word, or a padded one after the last input word
+      if ((wr < NumOutWords) && ((fill >= OutWidth) || (rd == NumInWords))) {
+        ap_uint<OutWidth> const  eo = buf(OutWidth - 1, 0);
+        out.write(eo);
+        buf = buf >> OutWidth;
+        fill = (fill > OutWidth)? fill - OutWidth : 0;
+        wr++;
+      }
+      // read as long as the residue leaves room for a full input word
+      if ((rd < NumInWords) && ((wr == NumOutWords) || (fill < OutWidth))) {
+        ap_uint<InWidth> const  ei = in.read();
+        rd++;
+        // input bits beyond the last output word are discarded
+        if (wr < NumOutWords) {
+          buf |= ap_uint<BufWidth>(ei) << fill;
+          fill += InWidth;
+        }
+      }
+    }
+  }
+}
+
 /**
  * \brief   Stream Data Width Converter No Multiple - 
  *          Converts the width of the input stream in the output stream for no multiple dimensions
@@ -615,11 +1054,59 @@ template<unsigned int DataWidth,
 >
 void DuplicateStreams_Batch(hls::stream<ap_uint<DataWidth> > & in, hls::stream<ap_uint<DataWidth> > & out1,
 		hls::stream<ap_uint<DataWidth> > & out2, const unsigned int numReps) {
+	FINN_STREAM_CHECK_IN(in, 1ull * numReps * NumTotal);
+	FINN_STREAM_CHECK_OUT(out1, 1ull * numReps * NumTotal);
+	FINN_STREAM_CHECK_OUT(out2, 1ull * numReps * NumTotal);
 	for (unsigned int image = 0; image < numReps; image++) {
 		DuplicateStreams<DataWidth, NumTotal>(in, out1, out2);
 	}
 }
 
+/**
+ * \brief   N-way Batch Stream Duplicator - Reads in a stream and writes the data into NumOutputs identical streams
+ *
+ * Feeds all branches of a multi-branch topology from a single stage, avoiding the latency and the extra FIFOs
+ * of a tree of 2-way duplicators. Every output can optionally be folded to a narrower width, each input word
+ * being split into InWidth/OutWidth output words, least significant part first.
+ *
+ * \tparam     InWidth      Width, in number of bits, of the input stream
+ * \tparam     NumTotal     Total number of words in the input stream per image
+ * \tparam     NumOutputs   Number of output streams
+ * \tparam     OutWidth     Width, in number of bits, of the output streams, must divide InWidth
+ *
+ * \param      in           Input stream
+ * \param      out          Array of output streams
+ * \param      numReps      Number of frames / images
+ *
+ */
+template<unsigned int InWidth,
+		unsigned int NumTotal,
+		unsigned int NumOutputs,
+		unsigned int OutWidth = InWidth
+>
+void DuplicateStreams_Batch(hls::stream<ap_uint<InWidth> > & in,
+		// non-deduced element type as ap_uint takes a signed width
+		typename std::common_type<hls::stream<ap_uint<OutWidth> > >::type (&out)[NumOutputs],
+		const unsigned int numReps) {
+	static_assert(NumOutputs > 0, "Need at least one output stream");
+	static_assert(InWidth % OutWidth == 0, "OutWidth must divide InWidth");
+#pragma HLS ARRAY_PARTITION variable=out complete dim=1
+	unsigned int const  Parts = InWidth / OutWidth;
+	ap_uint<InWidth>  ei;
+	unsigned int  part = 0;
+	for (unsigned int i = 0; i < numReps * NumTotal * Parts; i++) {
+#pragma HLS pipeline style=flp II=1
+		if(part == 0)  ei = in.read();
+		ap_uint<OutWidth> const  eo = ei(OutWidth-1, 0);
+		for(unsigned int o = 0; o < NumOutputs; o++) {
+#pragma HLS UNROLL
+			out[o].write(eo);
+		}
+		ei >>= OutWidth;
+		if(++part == Parts)  part = 0;
+	}
+}
+
 /**
  * \brief   Element-Wise Addition - Reads in data elements from two streams and writes the sum of these elements to an output
  *
@@ -688,6 +1175,9 @@ template <unsigned int NumChannels,
           int offset = 0>
 void AddStreams_Batch(hls::stream<ap_uint<NumChannels * In1_t::width>> &in1, hls::stream<ap_uint<NumChannels * In2_t::width>> &in2,
                 hls::stream<ap_uint<NumChannels * Out_t::width>> &out, const unsigned int numReps) {
+  FINN_STREAM_CHECK_IN(in1, 1ull * numReps * NumTotal);
+  FINN_STREAM_CHECK_IN(in2, 1ull * numReps * NumTotal);
+  FINN_STREAM_CHECK_OUT(out, 1ull * numReps * NumTotal);
   for (unsigned int image = 0; image < numReps; image++) {
     AddStreams<NumChannels, In1_t, In2_t, Out_t, NumTotal, offset>(in1, in2, out);
   }
@@ -726,48 +1216,413 @@ void AddStreamsLayer_Batch(hls::stream<ap_uint<NumChannels * In1_t::width>> &in1
   hls::stream<ap_uint<PECount * In2_t::width>> in_folded2;
   hls::stream<ap_uint<PECount * Out_t::width>> out_folded;
   StreamingDataWidthConverter_Batch<NumChannels * In1_t::width, PECount * In1_t::width, NumTotal>(in1, in_folded1, numReps);
+  FINN_STREAM_PROBE(in_folded1);
   StreamingDataWidthConverter_Batch<NumChannels * In2_t::width, PECount * In2_t::width, NumTotal>(in2, in_folded2, numReps);
+  FINN_STREAM_PROBE(in_folded2);
   AddStreams_Batch<PECount, In1_t, In2_t, Out_t, NumTotal *(NumChannels / PECount),offset>(in_folded1, in_folded2, out_folded, numReps);
+  FINN_STREAM_PROBE(out_folded);
   StreamingDataWidthConverter_Batch<PECount * Out_t::width, NumChannels * Out_t::width, NumTotal *(NumChannels / PECount)>(out_folded, out, numReps);
 }
 
 
 /**
- * \brief   Stream Multi Chan Data Width Converter - Converts the width of the input stream in the output stream, working on multiple parallel streams
+ * \brief   Requantizing Element-Wise Addition - Adds two PE-folded streams of differently scaled operands
  *
- * Used to upscale or downscale a stream, without any loss of data in the procedure. 
- * For downscaling (InWidth > OutWidth), InWidth has to be a multiple of OutWidth.
- * For upscaling (InWidth < OutWidth), OutWidth has to be a multiple of InWidth.
- * This version works on the MMV structure, with multiple parallel streams
+ * Used for the residual connections of quantized networks. The operands are aligned by the left shifts
+ * Shift1 and Shift2 and added exactly together with offset. The sum is then divided by 2^OutShift and
+ * converted to Out_t, whose quantization and overflow modes define the rounding and saturation, e.g.
+ * ap_fixed<8, 8, AP_RND, AP_SAT> produces the rounded and saturated 8-bit input of the next MVAU.
  *
- * \tparam     InWidth      Width, in number of bits, of the input stream
- * \tparam     OutWidth     Width, in number of bits, of the output stream 
- * \tparam     NumInWords   Number of input words to process
- * \tparam     NumVecs      Number of parallel vectors MMV
+ * \tparam     PECount      Number of channels per stream word
+ * \tparam     In1_t        First operand datatype
+ * \tparam     In2_t        Second operand datatype
+ * \tparam     Out_t        Datatype of the requantized output
+ * \tparam     NumTotal     Total number of words in the input streams per image
+ * \tparam     Shift1       Left shift applied to the first operand
+ * \tparam     Shift2       Left shift applied to the second operand
+ * \tparam     OutShift     Right shift applied to the sum before the conversion to Out_t
+ * \tparam     offset       Offset value for the accumulation
  *
- * \param      in           Input stream
+ * \param      in1          Input stream I
+ * \param      in2          Input stream II
  * \param      out          Output stream
- * \param      numReps      Number of times the function has to be called
+ * \param      numReps      Number of frames / images
  *
  */
-template<unsigned int InWidth,		// width of input stream
-		unsigned int OutWidth,		// width of output stream
-		unsigned int NumInWords,		// number of input words to process
-		unsigned int NumVecs
->
-void MultiChanDataWidthConverter_Batch(
-	hls::stream<MultiChanData<NumVecs, InWidth> > & in,
-	hls::stream<MultiChanData<NumVecs, OutWidth> > & out,
-	const unsigned int numReps) {
-	static_assert((InWidth % OutWidth == 0) || (OutWidth % InWidth == 0), "");
-	if (InWidth > OutWidth) {
-		// emit multiple output words per input word read
-		const unsigned int outPerIn = InWidth / OutWidth;
-		const unsigned int totalIters = NumInWords * outPerIn * numReps;
-		unsigned int o = 0;
-		MultiChanData<NumVecs, InWidth> ei;
-		for (unsigned int t = 0; t < totalIters; t++) {
-#pragma HLS pipeline style=flp II=1
+template <unsigned int PECount,
+          typename In1_t,
+          typename In2_t,
+          typename Out_t,
+          unsigned int NumTotal,
+          unsigned int Shift1 = 0,
+          unsigned int Shift2 = 0,
+          unsigned int OutShift = 0,
+          int offset = 0>
+void AddStreamsRequant_Batch(hls::stream<ap_uint<PECount * In1_t::width>> &in1, hls::stream<ap_uint<PECount * In2_t::width>> &in2,
+                             hls::stream<ap_uint<PECount * Out_t::width>> &out, const unsigned int numReps) {
+  // exact sum: the wider aligned operand, the offset, the carry and a sign bit
+  constexpr unsigned int  W1 = In1_t::width + Shift1;
+  constexpr unsigned int  W2 = In2_t::width + Shift2;
+  constexpr unsigned int  WO = clog2((offset < 0? -(long long)offset : offset) + 1);
+  constexpr unsigned int  SumW = (W1 > W2? (W1 > WO? W1 : WO) : (W2 > WO? W2 : WO)) + 2;
+
+  for (unsigned int i = 0; i < numReps * NumTotal; i++) {
+#pragma HLS pipeline style=flp II=1
+    ap_uint<PECount * In1_t::width> const  e1 = in1.read();
+    ap_uint<PECount * In2_t::width> const  e2 = in2.read();
+    ap_uint<PECount * Out_t::width>  e;
+    for (unsigned int j = 0; j < PECount; j++) {
+#pragma HLS UNROLL
+      In1_t const  op1 = e1((j + 1) * In1_t::width - 1, j * In1_t::width);
+      In2_t const  op2 = e2((j + 1) * In2_t::width - 1, j * In2_t::width);
+      ap_int<SumW> const  sum = (ap_int<SumW>(op1) << Shift1) + (ap_int<SumW>(op2) << Shift2) + offset;
+      // exact sum / 2^OutShift with Out_t rounding and saturation
+      ap_fixed<SumW + OutShift, SumW>  scaled = sum;
+      scaled >>= OutShift;
+      Out_t const  res = scaled;
+      e((j + 1) * Out_t::width - 1, j * Out_t::width) = res;
+    }
+    out.write(e);
+  }
+}
+
+/**
+ * \brief   Requantizing Addition Layer - Reads in two streams and writes their requantized sum to an output
+ *
+ * Folds the NumChannels wide input streams to PECount channels, see AddStreamsRequant_Batch, and unfolds the result.
+ *
+ * \tparam     NumChannels  Amount of channels of the streams
+ * \tparam     In1_t        First operand datatype
+ * \tparam     In2_t        Second operand datatype
+ * \tparam     Out_t        Datatype of the requantized output
+ * \tparam     NumTotal     Total number of words in the input streams
+ * \tparam     PECount      Amount of processing elements working in parallel
+ * \tparam     Shift1       Left shift applied to the first operand
+ * \tparam     Shift2       Left shift applied to the second operand
+ * \tparam     OutShift     Right shift applied to the sum before the conversion to Out_t
+ * \tparam     offset       Offset value for the accumulation
+ *
+ * \param      in1          Input stream I
+ * \param      in2          Input stream II
+ * \param      out          Output stream
+ * \param      numReps      Number of frames / images
+ *
+ */
+template <unsigned int NumChannels,
+          typename In1_t,
+          typename In2_t,
+          typename Out_t,
+          unsigned int NumTotal,
+          unsigned int PECount,
+          unsigned int Shift1 = 0,
+          unsigned int Shift2 = 0,
+          unsigned int OutShift = 0,
+          int offset = 0>
+void AddStreamsRequantLayer_Batch(hls::stream<ap_uint<NumChannels * In1_t::width>> &in1, hls::stream<ap_uint<NumChannels * In2_t::width>> &in2,
+                                  hls::stream<ap_uint<NumChannels * Out_t::width>> &out, const unsigned int numReps) {
+#pragma HLS INLINE
+  static_assert(NumChannels % PECount == 0, "");
+  hls::stream<ap_uint<PECount * In1_t::width>> in_folded1;
+  hls::stream<ap_uint<PECount * In2_t::width>> in_folded2;
+  hls::stream<ap_uint<PECount * Out_t::width>> out_folded;
+  StreamingDataWidthConverter_Batch<NumChannels * In1_t::width, PECount * In1_t::width, NumTotal>(in1, in_folded1, numReps);
+  FINN_STREAM_PROBE(in_folded1);
+  StreamingDataWidthConverter_Batch<NumChannels * In2_t::width, PECount * In2_t::width, NumTotal>(in2, in_folded2, numReps);
+  FINN_STREAM_PROBE(in_folded2);
+  AddStreamsRequant_Batch<PECount, In1_t, In2_t, Out_t, NumTotal *(NumChannels / PECount), Shift1, Shift2, OutShift, offset>
+    (in_folded1, in_folded2, out_folded, numReps);
+  FINN_STREAM_PROBE(out_folded);
+  StreamingDataWidthConverter_Batch<PECount * Out_t::width, NumChannels * Out_t::width, NumTotal *(NumChannels / PECount)>(out_folded, out, numReps);
+}
+
+/**
+ * \brief   Describes one input of ConcatStreams_Batch or one output of ChannelSplit_Batch
+ *
+ * \tparam     NumChannels  Number of channels contributed to each pixel
+ * \tparam     T            Datatype of a channel element
+ */
+template<unsigned int NumChannels, typename T>
+struct ConcatPort {
+  static constexpr unsigned int  channels = NumChannels;
+  static constexpr unsigned int  width = NumChannels * T::width;
+  using type = T;
+};
+
+/**
+ * \brief   Recursion over the ConcatPorts gathering one pixel from each input into a buffer of Out_t elements
+ */
+template<typename Out_t, unsigned int Offset, typename... Ports>
+struct ConcatGather {
+  static constexpr unsigned int  channels = 0;
+  template<typename TB>
+  static void gather(__attribute__((unused)) TB &buf) {
+#pragma HLS inline
+  }
+};
+template<typename Out_t, unsigned int Offset, typename P, typename... Ps>
+struct ConcatGather<Out_t, Offset, P, Ps...> {
+  static constexpr unsigned int  channels = P::channels + ConcatGather<Out_t, Offset + P::channels, Ps...>::channels;
+  template<typename TB>
+  static void gather(TB &buf, hls::stream<ap_uint<P::width>> &in, hls::stream<ap_uint<Ps::width>>&... rest) {
+#pragma HLS inline
+    ap_uint<P::width> const  e = in.read();
+    for (unsigned int c = 0; c < P::channels; c++) {
+#pragma HLS UNROLL
+      typename P::type const  op = e((c + 1) * P::type::width - 1, c * P::type::width);
+      Out_t const  res = op;
+      buf((Offset + c + 1) * Out_t::width - 1, (Offset + c) * Out_t::width) = res;
+    }
+    ConcatGather<Out_t, Offset + P::channels, Ps...>::gather(buf, rest...);
+  }
+};
+
+/**
+ * \brief   Channel Concatenation - Concatenates the channels of every pixel of N input streams into one output stream
+ *
+ * Used to merge the branches of DenseNet and Inception topologies on chip. Every input carries one full pixel
+ * per word, StreamingDataWidthConverter_Batch can be used to unfold PE-folded branches. The channels of
+ * the first input come first in the output pixel. All elements are converted to Out_t, and the output
+ * pixel is folded into words of PECount elements.
+ *
+ * \tparam     NumPixels    Number of pixels per image
+ * \tparam     PECount      Number of channels per output word, must divide the total channel count
+ * \tparam     Out_t        Datatype of the output channel elements
+ * \tparam     Ports        One ConcatPort per input stream, in concatenation order
+ *
+ * \param      in           Input streams, one per ConcatPort
+ * \param      out          Output stream
+ * \param      numReps      Number of frames / images
+ *
+ */
+template<unsigned int NumPixels,
+         unsigned int PECount,
+         typename Out_t,
+         typename... Ports>
+void ConcatStreams_Batch(hls::stream<ap_uint<Ports::width>>&... in,
+                         hls::stream<ap_uint<PECount * Out_t::width>> &out, const unsigned int numReps) {
+  static_assert(sizeof...(Ports) > 0, "Need at least one input stream");
+  unsigned int const  TotalChannels = ConcatGather<Out_t, 0, Ports...>::channels;
+  static_assert(TotalChannels % PECount == 0, "PECount must divide the total channel count");
+  unsigned int const  OutWords = TotalChannels / PECount;
+
+  ap_uint<TotalChannels * Out_t::width>  buf;
+  unsigned int  word = 0;
+  for (unsigned int i = 0; i < numReps * NumPixels * OutWords; i++) {
+#pragma HLS pipeline style=flp II=1
+    if (word == 0) {
+      ConcatGather<Out_t, 0, Ports...>::gather(buf, in...);
+    }
+    out.write(buf(PECount * Out_t::width - 1, 0));
+    buf >>= PECount * Out_t::width;
+    if (++word == OutWords)  word = 0;
+  }
+}
+
+
+/**
+ * \brief   Recursion over the ConcatPorts writing one pixel slice of a buffer of In_t elements to each output
+ */
+template<typename In_t, unsigned int Offset, typename... Ports>
+struct ChannelScatter {
+  static constexpr unsigned int  channels = 0;
+  template<typename TB>
+  static void scatter(__attribute__((unused)) TB const &buf) {
+#pragma HLS inline
+  }
+};
+template<typename In_t, unsigned int Offset, typename P, typename... Ps>
+struct ChannelScatter<In_t, Offset, P, Ps...> {
+  static constexpr unsigned int  channels = P::channels + ChannelScatter<In_t, Offset + P::channels, Ps...>::channels;
+  template<typename TB>
+  static void scatter(TB const &buf, hls::stream<ap_uint<P::width>> &out, hls::stream<ap_uint<Ps::width>>&... rest) {
+#pragma HLS inline
+    ap_uint<P::width>  e;
+    for (unsigned int c = 0; c < P::channels; c++) {
+#pragma HLS UNROLL
+      In_t const  op = buf((Offset + c + 1) * In_t::width - 1, (Offset + c) * In_t::width);
+      typename P::type const  res = op;
+      e((c + 1) * P::type::width - 1, c * P::type::width) = res;
+    }
+    out.write(e);
+    ChannelScatter<In_t, Offset + P::channels, Ps...>::scatter(buf, rest...);
+  }
+};
+
+/**
+ * \brief   Channel Split - Splits the channels of every pixel of a stream into N output streams
+ *
+ * The inverse of ConcatStreams_Batch, e.g. for the channel split of ShuffleNet units. The input pixel is
+ * folded into words of PECount elements, every output receives its channel slice as one full pixel per
+ * word, converted to the element type of its ConcatPort. The first output takes the lowest channels.
+ *
+ * \tparam     NumPixels    Number of pixels per image
+ * \tparam     PECount      Number of channels per input word, must divide the total channel count
+ * \tparam     In_t         Datatype of the input channel elements
+ * \tparam     Ports        One ConcatPort per output stream, in channel order
+ *
+ * \param      in           Input stream
+ * \param      out          Output streams, one per ConcatPort
+ * \param      numReps      Number of frames / images
+ *
+ */
+template<unsigned int NumPixels,
+         unsigned int PECount,
+         typename In_t,
+         typename... Ports>
+void ChannelSplit_Batch(hls::stream<ap_uint<PECount * In_t::width>> &in,
+                        hls::stream<ap_uint<Ports::width>>&... out, const unsigned int numReps) {
+  static_assert(sizeof...(Ports) > 0, "Need at least one output stream");
+  unsigned int const  TotalChannels = ChannelScatter<In_t, 0, Ports...>::channels;
+  static_assert(TotalChannels % PECount == 0, "PECount must divide the total channel count");
+  unsigned int const  InWords = TotalChannels / PECount;
+  unsigned int const  WordWidth = PECount * In_t::width;
+
+  ap_uint<TotalChannels * In_t::width>  buf;
+  unsigned int  word = 0;
+  for (unsigned int i = 0; i < numReps * NumPixels * InWords; i++) {
+#pragma HLS pipeline style=flp II=1
+    buf >>= WordWidth;
+    buf(TotalChannels * In_t::width - 1, (TotalChannels - PECount) * In_t::width) = in.read();
+    if (++word == InWords) {
+      word = 0;
+      ChannelScatter<In_t, 0, Ports...>::scatter(buf, out...);
+    }
+  }
+}
+
+/**
+ * \brief   Channel permutation of the ShuffleNet channel shuffle
+ *
+ * Views the channels as a Groups x (NumChannels/Groups) matrix and transposes it, so that output channel
+ * o is taken from channel source(o) of the input.
+ *
+ * \tparam     NumChannels  Number of channels per pixel
+ * \tparam     Groups       Number of channel groups, must divide NumChannels
+ */
+template<unsigned int NumChannels, unsigned int Groups>
+struct ChannelShufflePermutation {
+  static_assert(NumChannels % Groups == 0, "Groups must divide NumChannels");
+  static constexpr unsigned int source(unsigned int const  o) {
+    return  (o % Groups) * (NumChannels / Groups) + o / Groups;
+  }
+};
+
+/**
+ * \brief   Channel Permutation - Reorders the channels within every pixel of a stream
+ *
+ * Perm::source(o) must be a constexpr function returning the input channel of output channel o, which turns
+ * the reordering into plain wiring. A complete pixel is collected before it is emitted permuted, the next one
+ * being read meanwhile, which sustains II=1 at the cost of one pixel of latency.
+ *
+ * \tparam     NumChannels  Number of channels per pixel
+ * \tparam     PECount      Number of channels per input and output word, must divide NumChannels
+ * \tparam     T            Datatype of the channel elements
+ * \tparam     NumPixels    Number of pixels per image
+ * \tparam     Perm         Permutation providing the constexpr source(o)
+ *
+ * \param      in           Input stream
+ * \param      out          Output stream
+ * \param      numReps      Number of frames / images
+ *
+ */
+template<unsigned int NumChannels,
+         unsigned int PECount,
+         typename T,
+         unsigned int NumPixels,
+         typename Perm>
+void ChannelPermute_Batch(hls::stream<ap_uint<PECount * T::width>> &in,
+                          hls::stream<ap_uint<PECount * T::width>> &out, const unsigned int numReps) {
+  static_assert(NumChannels % PECount == 0, "PECount must divide NumChannels");
+  unsigned int const  Words = NumChannels / PECount;
+  unsigned int const  WordWidth = PECount * T::width;
+  unsigned int const  PixelWidth = NumChannels * T::width;
+
+  ap_uint<PixelWidth>  nxt;  // pixel being read
+  ap_uint<PixelWidth>  cur;  // permuted pixel being written
+  unsigned int  word = 0;
+  for (unsigned int i = 0; i < (numReps * NumPixels + 1) * Words; i++) {
+#pragma HLS pipeline style=flp II=1
+    if (i >= Words) {
+      out.write(cur(WordWidth - 1, 0));
+      cur >>= WordWidth;
+    }
+    if (i < numReps * NumPixels * Words) {
+      nxt >>= WordWidth;
+      nxt(PixelWidth - 1, PixelWidth - WordWidth) = in.read();
+    }
+    if (++word == Words) {
+      word = 0;
+      for (unsigned int o = 0; o < NumChannels; o++) {
+#pragma HLS UNROLL
+        unsigned int const  src = Perm::source(o);
+        cur((o + 1) * T::width - 1, o * T::width) = nxt((src + 1) * T::width - 1, src * T::width);
+      }
+    }
+  }
+}
+
+/**
+ * \brief   Channel Shuffle - Applies the ShuffleNet channel shuffle to every pixel of a stream
+ *
+ * \tparam     NumChannels  Number of channels per pixel
+ * \tparam     Groups       Number of channel groups, must divide NumChannels
+ * \tparam     PECount      Number of channels per input and output word, must divide NumChannels
+ * \tparam     T            Datatype of the channel elements
+ * \tparam     NumPixels    Number of pixels per image
+ *
+ * \param      in           Input stream
+ * \param      out          Output stream
+ * \param      numReps      Number of frames / images
+ *
+ */
+template<unsigned int NumChannels,
+         unsigned int Groups,
+         unsigned int PECount,
+         typename T,
+         unsigned int NumPixels>
+void ChannelShuffle_Batch(hls::stream<ap_uint<PECount * T::width>> &in,
+                          hls::stream<ap_uint<PECount * T::width>> &out, const unsigned int numReps) {
+#pragma HLS INLINE
+  ChannelPermute_Batch<NumChannels, PECount, T, NumPixels, ChannelShufflePermutation<NumChannels, Groups>>(in, out, numReps);
+}
+
+
+/**
+ * \brief   Stream Multi Chan Data Width Converter - Converts the width of the input stream in the output stream, working on multiple parallel streams
+ *
+ * Used to upscale or downscale a stream, without any loss of data in the procedure. 
+ * For downscaling (InWidth > OutWidth), InWidth has to be a multiple of OutWidth.
+ * For upscaling (InWidth < OutWidth), OutWidth has to be a multiple of InWidth.
+ * This version works on the MMV structure, with multiple parallel streams
+ *
+ * \tparam     InWidth      Width, in number of bits, of the input stream
+ * \tparam     OutWidth     Width, in number of bits, of the output stream 
+ * \tparam     NumInWords   Number of input words to process
+ * \tparam     NumVecs      Number of parallel vectors MMV
+ *
+ * \param      in           Input stream
+ * \param      out          Output stream
+ * \param      numReps      Number of times the function has to be called
+ *
+ */
+template<unsigned int InWidth,		// width of input stream
+		unsigned int OutWidth,		// width of output stream
+		unsigned int NumInWords,		// number of input words to process
+		unsigned int NumVecs
+>
+void MultiChanDataWidthConverter_Batch(
+	hls::stream<MultiChanData<NumVecs, InWidth> > & in,
+	hls::stream<MultiChanData<NumVecs, OutWidth> > & out,
+	const unsigned int numReps) {
+	static_assert((InWidth % OutWidth == 0) || (OutWidth % InWidth == 0), "");
+	if (InWidth > OutWidth) {
+		// emit multiple output words per input word read
+		const unsigned int outPerIn = InWidth / OutWidth;
+		const unsigned int totalIters = NumInWords * outPerIn * numReps;
+		unsigned int o = 0;
+		MultiChanData<NumVecs, InWidth> ei;
+		for (unsigned int t = 0; t < totalIters; t++) {
+#pragma HLS pipeline style=flp II=1
 			// read new input word if current out count is zero
 			if (o == 0)
 				ei = in.read();
@@ -859,6 +1714,150 @@ void FlattenMultiChanData(
 	}
 }
 
+namespace detail {
+
+  // InWidth is a multiple of OutWidth: every buffered chunk yields InWidth/OutWidth output words
+  template<unsigned InWidth, unsigned OutWidth, unsigned NumChunks, unsigned NumVecs>
+  void mmv_serialize(
+	hls::stream<MultiChanData<NumVecs, InWidth> > &in,
+	hls::stream<ap_uint<OutWidth> > &out,
+	unsigned const  numReps,
+	std::true_type) {
+	unsigned const  OutPerChunk = InWidth / OutWidth;
+
+	// ping-pong buffer of two groups of NumChunks input words
+	ap_uint<InWidth>  buf[2][NumVecs][NumChunks];
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=2
+#pragma HLS DEPENDENCE variable=buf inter false
+
+	unsigned  wgrp = 0, wn = 0;
+	unsigned  rgrp = 0, rv = 0, rn = 0, rsub = 0;
+	while(rgrp < numReps) {
+#pragma HLS pipeline style=flp II=1
+		// fill the next group while the previous one is still being drained
+		if((wgrp < numReps) && (wgrp < rgrp + 2)) {
+			MultiChanData<NumVecs, InWidth> const  e = in.read();
+			for(unsigned  v = 0; v < NumVecs; v++) {
+#pragma HLS UNROLL
+				buf[wgrp & 1][v][wn] = e.data[v];
+			}
+			if(++wn == NumChunks) {
+				wn = 0;
+				wgrp++;
+			}
+		}
+		// drain a complete group pixel by pixel
+		if(rgrp < wgrp) {
+			ap_uint<InWidth> const  chunk = buf[rgrp & 1][rv][rn];
+			out.write(chunk((rsub+1)*OutWidth-1, rsub*OutWidth));
+			if(++rsub == OutPerChunk) {
+				rsub = 0;
+				if(++rn == NumChunks) {
+					rn = 0;
+					if(++rv == NumVecs) {
+						rv = 0;
+						rgrp++;
+					}
+				}
+			}
+		}
+	}
+  }
+
+  // OutWidth is a multiple of InWidth: every output word gathers OutWidth/InWidth chunks of one pixel
+  template<unsigned InWidth, unsigned OutWidth, unsigned NumChunks, unsigned NumVecs>
+  void mmv_serialize(
+	hls::stream<MultiChanData<NumVecs, InWidth> > &in,
+	hls::stream<ap_uint<OutWidth> > &out,
+	unsigned const  numReps,
+	std::false_type) {
+	unsigned const  ChunksPerOut = OutWidth / InWidth;
+
+	// ping-pong buffer of two groups of NumChunks input words
+	ap_uint<InWidth>  buf[2][NumVecs][NumChunks];
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=2
+#pragma HLS ARRAY_PARTITION variable=buf cyclic factor=ChunksPerOut dim=3
+#pragma HLS DEPENDENCE variable=buf inter false
+
+	unsigned  wgrp = 0, wn = 0;
+	unsigned  rgrp = 0, rv = 0, rn = 0;
+	while(rgrp < numReps) {
+#pragma HLS pipeline style=flp II=1
+		// fill the next group while the previous one is still being drained
+		if((wgrp < numReps) && (wgrp < rgrp + 2)) {
+			MultiChanData<NumVecs, InWidth> const  e = in.read();
+			for(unsigned  v = 0; v < NumVecs; v++) {
+#pragma HLS UNROLL
+				buf[wgrp & 1][v][wn] = e.data[v];
+			}
+			if(++wn == NumChunks) {
+				wn = 0;
+				wgrp++;
+			}
+		}
+		// drain a complete group pixel by pixel
+		if(rgrp < wgrp) {
+			ap_uint<OutWidth>  o;
+			for(unsigned  k = 0; k < ChunksPerOut; k++) {
+#pragma HLS UNROLL
+				o((k+1)*InWidth-1, k*InWidth) = buf[rgrp & 1][rv][rn + k];
+			}
+			out.write(o);
+			rn += ChunksPerOut;
+			if(rn == NumChunks) {
+				rn = 0;
+				if(++rv == NumVecs) {
+					rv = 0;
+					rgrp++;
+				}
+			}
+		}
+	}
+  }
+
+} // namespace detail
+
+// Whether MultiChanDataSerialize_Batch supports the combination of widths
+template<unsigned InWidth, unsigned OutWidth, unsigned NumChunks>
+struct mmv_serializable {
+  static bool const  value = (InWidth % OutWidth == 0) ||
+    ((OutWidth % InWidth == 0) && (NumChunks % (OutWidth / InWidth) == 0));
+};
+
+/**
+ * \brief   Multi Chan Data Serializer - Converts groups of parallel MMV words into a pixel-major output stream
+ *
+ * Produces the same output as MultiChanDataWidthConverter_Batch to NumChunks*InWidth, followed by
+ * FlattenMultiChanData and StreamingDataWidthConverter_Batch to OutWidth, in a single stage. A group of
+ * NumChunks input words carries NumChunks consecutive chunks of all NumVecs pixels. It is buffered and
+ * emitted pixel by pixel, chunk by chunk, LSB first, while the next group is received into the second
+ * half of a ping-pong buffer. No word wider than max(InWidth, OutWidth) is built.
+ *
+ * Either OutWidth divides InWidth, or InWidth divides OutWidth and OutWidth/InWidth divides NumChunks, see
+ * mmv_serializable.
+ *
+ * \tparam     InWidth      Width, in number of bits, of each pixel of the input stream
+ * \tparam     OutWidth     Width, in number of bits, of the output stream
+ * \tparam     NumChunks    Number of input words per group
+ * \tparam     NumVecs      Number of parallel vectors MMV
+ *
+ * \param      in           Input parallel stream
+ * \param      out          Output stream
+ * \param      numReps      Number of groups to process
+ */
+template<unsigned InWidth, unsigned OutWidth, unsigned NumChunks, unsigned NumVecs>
+void MultiChanDataSerialize_Batch(
+	hls::stream<MultiChanData<NumVecs, InWidth> > &in,
+	hls::stream<ap_uint<OutWidth> > &out,
+	unsigned const  numReps
+) {
+	static_assert(mmv_serializable<InWidth, OutWidth, NumChunks>::value, "Unsupported combination of widths.");
+	detail::mmv_serialize<InWidth, OutWidth, NumChunks, NumVecs>(in, out, numReps,
+		std::integral_constant<bool, InWidth % OutWidth == 0>());
+}
+
 /**
  * \brief   Pack Multi Chan Data - Converts the flatten input stream into a parallel output stream
  *
@@ -1005,4 +2004,1276 @@ void Stream2Qdma_Batch(hls::stream<ap_uint<DataWidth> > & in, hls::stream<qdma_a
 	}
 }
 
+/**
+ * \brief   Framed QDMA stream to normal stream conversion - Forwards one TLAST-delimited frame of any length
+ *
+ * Used in free-running kernels, which handle frames as they arrive rather than batches of a size fixed at
+ * launch. A frame is made of all beats up to and including the one with TLAST. A single beat with TLAST
+ * and an all-zero TKEEP carries no data and terminates the batch. For every frame a token is written to
+ * eob: false for a data frame, whose words are forwarded to out, true for the batch terminator.
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the data on streams
+ *
+ * \param      in           Input QDMA stream
+ * \param      out          Output stream
+ * \param      eob          End-of-batch token stream, one token per frame
+ *
+ * \return     Number of data words forwarded
+ *
+ */
+template<unsigned int DataWidth>
+unsigned int Qdma2Stream_Framed(hls::stream<qdma_axis<DataWidth,0,0,0> > & in, hls::stream<ap_uint<DataWidth> > & out,
+		hls::stream<bool> & eob){
+	unsigned int  words = 0;
+	bool  last = false;
+	while (!last) {
+#pragma HLS pipeline style=flp II=1
+		qdma_axis<DataWidth,0,0,0> const  temp = in.read();
+		last = temp.get_last();
+		bool const  terminator = last && (words == 0) && (temp.get_keep() == 0);
+		if (!terminator) {
+			out.write(temp.get_data());
+			words++;
+		}
+		if (last)  eob.write(terminator);
+	}
+	return  words;
+}
+
+/**
+ * \brief   Framed QDMA stream to normal stream conversion for a whole batch of unknown size
+ *
+ * Forwards frames, see Qdma2Stream_Framed, up to and including the batch terminator.
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the data on streams
+ *
+ * \param      in           Input QDMA stream
+ * \param      out          Output stream
+ * \param      eob          End-of-batch token stream, one token per frame
+ *
+ * \return     Number of data frames in the batch
+ *
+ */
+template<unsigned int DataWidth>
+unsigned int Qdma2Stream_Framed_Batch(hls::stream<qdma_axis<DataWidth,0,0,0> > & in, hls::stream<ap_uint<DataWidth> > & out,
+		hls::stream<bool> & eob){
+	unsigned int  frames = 0;
+	while (Qdma2Stream_Framed<DataWidth>(in, out, eob) != 0) {
+		frames++;
+	}
+	return  frames;
+}
+
+/**
+ * \brief   Normal stream to framed QDMA stream conversion - Emits one frame per end-of-batch token
+ *
+ * The counterpart of Qdma2Stream_Framed: a false token forwards a frame of NumTotal words with TLAST on
+ * the last one, a true token emits the batch terminator, a single beat with TLAST and an all-zero TKEEP.
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the data on streams
+ * \tparam     NumTotal     Number of words per data frame
+ *
+ * \param      in           Input stream
+ * \param      eob          End-of-batch token stream
+ * \param      out          Output QDMA stream
+ *
+ * \return     True if the batch terminator was emitted
+ *
+ */
+template<unsigned int DataWidth, unsigned int NumTotal>
+bool Stream2Qdma_Framed(hls::stream<ap_uint<DataWidth> > & in, hls::stream<bool> & eob,
+		hls::stream<qdma_axis<DataWidth,0,0,0> > & out){
+	bool const  terminator = eob.read();
+	if (terminator) {
+		qdma_axis<DataWidth,0,0,0>  temp;
+		temp.set_data(0);
+		temp.set_keep(0);
+		temp.set_last(1);
+		out.write(temp);
+	}
+	else {
+		for (unsigned int word = 0; word < NumTotal; word++) {
+#pragma HLS pipeline style=flp II=1
+			qdma_axis<DataWidth,0,0,0>  temp;
+			temp.set_data(in.read());
+			temp.set_keep(-1);
+			temp.set_last(word == NumTotal-1);
+			out.write(temp);
+		}
+	}
+	return  terminator;
+}
+
+/**
+ * \brief   Normal stream to framed QDMA stream conversion for a whole batch of unknown size
+ *
+ * Emits frames, see Stream2Qdma_Framed, up to and including the batch terminator.
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the data on streams
+ * \tparam     NumTotal     Number of words per data frame
+ *
+ * \param      in           Input stream
+ * \param      eob          End-of-batch token stream
+ * \param      out          Output QDMA stream
+ *
+ * \return     Number of data frames in the batch
+ *
+ */
+template<unsigned int DataWidth, unsigned int NumTotal>
+unsigned int Stream2Qdma_Framed_Batch(hls::stream<ap_uint<DataWidth> > & in, hls::stream<bool> & eob,
+		hls::stream<qdma_axis<DataWidth,0,0,0> > & out){
+	unsigned int  frames = 0;
+	while (!Stream2Qdma_Framed<DataWidth, NumTotal>(in, eob, out)) {
+		frames++;
+	}
+	return  frames;
+}
+
+/**
+ * \brief   Tag identifying the QDMA queue a frame came from, see Qdma2Stream_Arbiter_Batch
+ *
+ * \tparam     NumQueues    Number of queues
+ */
+template<unsigned int NumQueues>
+struct QdmaQueueTag {
+  static constexpr unsigned int  width = NumQueues > 1? clog2(NumQueues) : 1;
+  using type = ap_uint<width>;
+};
+
+/**
+ * \brief   Multi-queue QDMA front end - Merges the frames of several QDMA streams into one tagged stream
+ *
+ * Used to serve several clients, each through its own host queue, from one pipeline. Whole TLAST-delimited
+ * frames are forwarded from the queues with data available, either round-robin or by priority, the lowest
+ * queue index first. The queue of every frame is written to tag so that Stream2Qdma_Router_Batch can return
+ * the results. The choice of the next queue takes one cycle per frame.
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the data on streams
+ * \tparam     NumQueues    Number of input queues
+ * \tparam     Priority     Serve queues by priority instead of round-robin
+ *
+ * \param      in           Input QDMA streams, one per queue
+ * \param      out          Output stream
+ * \param      tag          Output stream of the queue of every frame
+ * \param      numFrames    Number of frames to be forwarded in total
+ *
+ */
+template<unsigned int DataWidth, unsigned int NumQueues, bool Priority = false>
+void Qdma2Stream_Arbiter_Batch(hls::stream<qdma_axis<DataWidth,0,0,0> > (&in)[NumQueues], hls::stream<ap_uint<DataWidth> > & out,
+		hls::stream<typename QdmaQueueTag<NumQueues>::type> & tag, const unsigned int numFrames){
+#pragma HLS ARRAY_PARTITION variable=in complete dim=1
+	unsigned int  frames = 0;
+	bool  active = false;
+	unsigned int  queue = 0;
+	unsigned int  served = NumQueues - 1; // queue of the last frame
+	while (frames < numFrames) {
+#pragma HLS pipeline style=flp II=1
+		if (!active) {
+			// pick the first queue with data, starting after the last served one for round-robin
+			for (unsigned int k = 0; k < NumQueues; k++) {
+#pragma HLS UNROLL
+				unsigned int const  q = Priority? k : (served + 1 + k) % NumQueues;
+				if (!active && !in[q].empty()) {
+					active = true;
+					queue  = q;
+				}
+			}
+			if (active)  tag.write(queue);
+		}
+		else {
+			qdma_axis<DataWidth,0,0,0> const  temp = in[queue].read();
+			out.write(temp.get_data());
+			if (temp.get_last()) {
+				active = false;
+				served = queue;
+				frames++;
+			}
+		}
+	}
+}
+
+/**
+ * \brief   Multi-queue QDMA back end - Routes the frames of a tagged stream to their QDMA queues
+ *
+ * The counterpart of Qdma2Stream_Arbiter_Batch: every frame of NumTotal words is written to the queue read
+ * from tag, with TLAST on its last word.
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the data on streams
+ * \tparam     NumTotal     Number of words per frame
+ * \tparam     NumQueues    Number of output queues
+ *
+ * \param      in           Input stream
+ * \param      tag          Input stream of the queue of every frame
+ * \param      out          Output QDMA streams, one per queue
+ * \param      numFrames    Number of frames to be routed in total
+ *
+ */
+template<unsigned int DataWidth, unsigned int NumTotal, unsigned int NumQueues>
+void Stream2Qdma_Router_Batch(hls::stream<ap_uint<DataWidth> > & in, hls::stream<typename QdmaQueueTag<NumQueues>::type> & tag,
+		hls::stream<qdma_axis<DataWidth,0,0,0> > (&out)[NumQueues], const unsigned int numFrames){
+#pragma HLS ARRAY_PARTITION variable=out complete dim=1
+	unsigned int  queue = 0;
+	unsigned int  word = 0;
+	for (unsigned int i = 0; i < numFrames * NumTotal; i++) {
+#pragma HLS pipeline style=flp II=1
+		if (word == 0)  queue = tag.read();
+		qdma_axis<DataWidth,0,0,0>  temp;
+		temp.set_data(in.read());
+		temp.set_keep(-1);
+		temp.set_last(word == NumTotal-1);
+		out[queue].write(temp);
+		if (++word == NumTotal)  word = 0;
+	}
+}
+
+/**
+ * \brief   Token format of zero-run-length compressed streams
+ *
+ * A stream is compressed in segments of NumWords words, e.g. the SF input words of one matrix-vector
+ * product. Every non-zero word is sent as a token together with the number of all-zero words skipped
+ * before it. The final word of a segment is always sent, whether zero or not, with the last flag set, so
+ * that a segment is never empty. Token layout from the LSB: data, run, last.
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the uncompressed words
+ * \tparam     NumWords     Number of words per segment
+ */
+template<unsigned int DataWidth, unsigned int NumWords>
+struct ZeroRunToken {
+  static constexpr unsigned int  RunBits = clog2(NumWords) > 0? clog2(NumWords) : 1;
+  static constexpr unsigned int  width = DataWidth + RunBits + 1;
+  using type = ap_uint<width>;
+
+  static type pack(ap_uint<DataWidth> const &data, unsigned int const  run, bool const  last) {
+#pragma HLS inline
+    type  t;
+    t(DataWidth - 1, 0) = data;
+    t(DataWidth + RunBits - 1, DataWidth) = run;
+    t[width - 1] = last;
+    return  t;
+  }
+  static ap_uint<DataWidth> data(type const &t) {
+#pragma HLS inline
+    return  t(DataWidth - 1, 0);
+  }
+  static unsigned int run(type const &t) {
+#pragma HLS inline
+    return  t(DataWidth + RunBits - 1, DataWidth);
+  }
+  static bool last(type const &t) {
+#pragma HLS inline
+    return  t[width - 1];
+  }
+};
+
+/**
+ * \brief   Zero-run-length encoder - Drops the all-zero words of a stream, see ZeroRunToken
+ *
+ * Used in front of Stream2Mem spills and of Matrix_Vector_Activate_ZeroSkip_Batch for sparse (e.g. ReLU)
+ * activations. A compressed segment occupies between 1 and NumWords tokens.
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the input words
+ * \tparam     NumWords     Number of words per segment
+ * \tparam     NumTotal     Total number of words in the input stream per image, multiple of NumWords
+ *
+ * \param      in           Input stream
+ * \param      out          Output token stream
+ * \param      numReps      Number of frames / images
+ *
+ */
+template<unsigned int DataWidth, unsigned int NumWords, unsigned int NumTotal>
+void ZeroRunEncode_Batch(hls::stream<ap_uint<DataWidth> > & in,
+		hls::stream<typename ZeroRunToken<DataWidth, NumWords>::type> & out, const unsigned int numReps) {
+	static_assert(NumTotal % NumWords == 0, "NumTotal must be a multiple of NumWords");
+	unsigned int  run = 0;
+	unsigned int  pos = 0;
+	for (unsigned int i = 0; i < numReps * NumTotal; i++) {
+#pragma HLS pipeline style=flp II=1
+		ap_uint<DataWidth> const  e = in.read();
+		bool const  last = (++pos == NumWords);
+		if (last)  pos = 0;
+		if ((e != 0) || last) {
+			out.write(ZeroRunToken<DataWidth, NumWords>::pack(e, run, last));
+			run = 0;
+		}
+		else {
+			run++;
+		}
+	}
+}
+
+/**
+ * \brief   Zero-run-length decoder - Restores the stream compressed by ZeroRunEncode_Batch
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the output words
+ * \tparam     NumWords     Number of words per segment
+ * \tparam     NumTotal     Total number of words in the output stream per image, multiple of NumWords
+ *
+ * \param      in           Input token stream
+ * \param      out          Output stream
+ * \param      numReps      Number of frames / images
+ *
+ */
+template<unsigned int DataWidth, unsigned int NumWords, unsigned int NumTotal>
+void ZeroRunDecode_Batch(hls::stream<typename ZeroRunToken<DataWidth, NumWords>::type> & in,
+		hls::stream<ap_uint<DataWidth> > & out, const unsigned int numReps) {
+	static_assert(NumTotal % NumWords == 0, "NumTotal must be a multiple of NumWords");
+	using Token = ZeroRunToken<DataWidth, NumWords>;
+	unsigned int  run = 0;
+	bool  have = false;
+	ap_uint<DataWidth>  val = 0;
+	for (unsigned int i = 0; i < numReps * NumTotal; i++) {
+#pragma HLS pipeline style=flp II=1
+		if (!have) {
+			typename Token::type const  t = in.read();
+			run  = Token::run(t);
+			val  = Token::data(t);
+			have = true;
+		}
+		if (run > 0) {
+			out.write(0);
+			run--;
+		}
+		else {
+			out.write(val);
+			have = false;
+		}
+	}
+}
+
+/**
+ * \brief   Cycle counters of a StreamPerfMonitor_Batch
+ *
+ * Placed on an AXI-lite interface of the top-level, they are readable by the
+ * host once the accelerator has completed.
+ */
+struct StreamPerfCounters {
+	ap_uint<64>  active;	//!< cycles in which a word was passed on
+	ap_uint<64>  stall_in;	//!< cycles waiting on an empty input, i.e. for the producer
+	ap_uint<64>  stall_out;	//!< cycles waiting on a full output, i.e. for the consumer
+};
+
+namespace detail {
+	template<unsigned int NumWords, typename T>
+	void stream_perf_monitor(hls::stream<T> &in, hls::stream<T> &out, StreamPerfCounters &counters,
+		unsigned int const numReps, std::true_type) {
+		unsigned int const  total = numReps * NumWords;
+		ap_uint<64>  active = 0;
+		ap_uint<64>  stall_in = 0;
+		ap_uint<64>  stall_out = 0;
+		while (active < total) {
+#pragma HLS pipeline style=flp II=1
+			if (in.empty()) {
+#ifndef __SYNTHESIS__
+				// the stages run one after another in csim, an empty input is premature end of data
+				std::cerr << "StreamPerfMonitor_Batch: input ended after " << active << " of " << total << " words" << std::endl;
+				break;
+#endif
+				stall_in++;
+			}
+			else if (out.full()) {
+				stall_out++;
+			}
+			else {
+				out.write(in.read());
+				active++;
+			}
+		}
+		counters.active = active;
+		counters.stall_in = stall_in;
+		counters.stall_out = stall_out;
+	}
+
+	template<unsigned int NumWords, typename T>
+	void stream_perf_monitor(hls::stream<T> &, hls::stream<T> &, StreamPerfCounters &, unsigned int const, std::false_type) {}
+}
+
+/**
+ * \brief   Stream performance monitor - passes a stream on and counts the cycles active and stalled
+ *
+ * Inserted as a dataflow stage on the stream between two blocks, it counts the cycles in which a
+ * word is passed on, the cycles in which the producer has not delivered a word and those in which
+ * the consumer could not take one. The stall counters thus tell which side of the stream throttles
+ * the pipeline. The consumer has to read the stream returned by StreamPerfOutput, so that a disabled
+ * monitor leaves the blocks connected directly and compiles to nothing:
+ *
+ *   StreamingDataWidthConverter_Batch<...>(in, s0, numReps);
+ *   StreamPerfMonitor_Batch<PERF, NumWords>(s0, s0_mon, counters, numReps);
+ *   StreamingMaxPool_Batch<...>(StreamPerfOutput<PERF>(s0, s0_mon), out, numReps);
+ *
+ * In csim the stages run one after another, so only the active count is meaningful there.
+ *
+ * \tparam     Enable     Whether the monitor is instantiated
+ * \tparam     NumWords   Number of words per image
+ * \tparam     T          Type of the stream words
+ *
+ * \param      in         Input stream
+ * \param      out        Output stream, read in place of the input when enabled
+ * \param      counters   Cycle counters, written when all words have passed
+ * \param      numReps    Number of images
+ *
+ */
+template<bool Enable, unsigned int NumWords, typename T>
+void StreamPerfMonitor_Batch(hls::stream<T> &in, hls::stream<T> &out, StreamPerfCounters &counters, unsigned int const numReps) {
+	detail::stream_perf_monitor<NumWords>(in, out, counters, numReps, std::integral_constant<bool, Enable>());
+}
+
+/**
+ * \brief   Stream to read behind a StreamPerfMonitor_Batch - its output when enabled, its input otherwise
+ */
+template<bool Enable, typename T>
+hls::stream<T>& StreamPerfOutput(hls::stream<T> &in, hls::stream<T> &out) {
+#pragma HLS inline
+	return  Enable? out : in;
+}
+
+/**
+ * \brief   Timestamps of the frames entering a pipeline, as cycle counts of FrameTimestamp_Batch
+ */
+typedef ap_uint<64> frame_stamp_t;
+
+namespace detail {
+	template<unsigned int NumWords, typename T>
+	void frame_timestamp(hls::stream<T> &in, hls::stream<T> &out, hls::stream<frame_stamp_t> &stamps,
+		unsigned int const numReps, std::true_type) {
+		unsigned int const  total = numReps * NumWords;
+		frame_stamp_t  cycle = 0;
+		unsigned int  words = 0;
+		unsigned int  pos = 0;
+		while (words < total) {
+#pragma HLS pipeline style=flp II=1
+#ifndef __SYNTHESIS__
+			if (in.empty()) {
+				std::cerr << "FrameTimestamp_Batch: input ended after " << words << " of " << total << " words" << std::endl;
+				break;
+			}
+#endif
+			bool const  first = pos == 0;
+			if (!in.empty() && !out.full() && !(first && stamps.full())) {
+				out.write(in.read());
+				if (first) {
+					stamps.write(cycle);
+				}
+				pos = (pos == NumWords-1)? 0 : pos+1;
+				words++;
+			}
+			cycle++;
+		}
+	}
+
+	template<unsigned int NumWords, typename T>
+	void frame_timestamp(hls::stream<T> &, hls::stream<T> &, hls::stream<frame_stamp_t> &, unsigned int const, std::false_type) {}
+
+	/** Stamps sink of the final FrameLatency_Batch, dropping the timestamps. */
+	struct frame_stamp_drop {
+		bool full() const { return  false; }
+		void write(frame_stamp_t const&) {}
+	};
+
+	/** Passes the stream on and records the latency of every frame since its timestamp when its last word passes. */
+	template<unsigned int NumWords, unsigned int Depth, typename T, typename S>
+	void frame_latency(hls::stream<T> &in, hls::stream<T> &out, hls::stream<frame_stamp_t> &stamps_in, S &stamps_out,
+		ap_uint<32> latency[Depth], unsigned int &frames, unsigned int const numReps) {
+		static_assert((Depth & (Depth-1)) == 0, "The latency ring buffer Depth must be a power of two");
+		unsigned int const  total = numReps * NumWords;
+		frame_stamp_t  cycle = 0;
+		unsigned int  words = 0;
+		unsigned int  pos = 0;
+		unsigned int  frame = 0;
+		while (words < total) {
+#pragma HLS pipeline style=flp II=1
+#ifndef __SYNTHESIS__
+			if (in.empty()) {
+				std::cerr << "FrameLatency_Batch: input ended after " << words << " of " << total << " words" << std::endl;
+				break;
+			}
+#endif
+			bool const  last = pos == NumWords-1;
+			if (!in.empty() && !out.full() && !(last && (stamps_in.empty() || stamps_out.full()))) {
+				out.write(in.read());
+				if (last) {
+					frame_stamp_t const  stamp = stamps_in.read();
+					latency[frame % Depth] = cycle - stamp;
+					stamps_out.write(stamp);
+					frame++;
+				}
+				pos = last? 0 : pos+1;
+				words++;
+			}
+			cycle++;
+		}
+		frames = frame;
+	}
+}
+
+/**
+ * \brief   Frame timestamp - passes a stream on and timestamps the first word of every frame
+ *
+ * Placed at the entry of a pipeline, e.g. on the output of Mem2Stream_Batch or Qdma2Stream_Batch,
+ * it runs a free cycle counter and sends its value at the first word of every frame on the stamps
+ * stream to the FrameLatency_Batch at the exit of the pipeline, possibly through FrameLatencyTap_Batch
+ * stages after intermediate layers. As all stages of a dataflow region start together, their
+ * cycle counters run in step and the differences are the latencies of the frames through the
+ * pipeline. The stamps stream needs a depth of at least the number of frames in flight.
+ * Like StreamPerfMonitor_Batch, a disabled stage compiles to nothing when the consumer reads
+ * StreamPerfOutput<Enable>(in, out).
+ *
+ * In csim the stages run one after another, so only the frame counts are meaningful there.
+ *
+ * \tparam     Enable     Whether the timestamping is instantiated
+ * \tparam     NumWords   Number of words per frame
+ * \tparam     T          Type of the stream words
+ *
+ * \param      in         Input stream
+ * \param      out        Output stream
+ * \param      stamps     Timestamps of the frames
+ * \param      numReps    Number of frames
+ *
+ */
+template<bool Enable, unsigned int NumWords, typename T>
+void FrameTimestamp_Batch(hls::stream<T> &in, hls::stream<T> &out, hls::stream<frame_stamp_t> &stamps, unsigned int const numReps) {
+	detail::frame_timestamp<NumWords>(in, out, stamps, numReps, std::integral_constant<bool, Enable>());
+}
+
+/**
+ * \brief   Frame latency - records the latency of every frame since its FrameTimestamp_Batch
+ *
+ * Placed at the exit of a pipeline, e.g. on the input of Stream2Mem_Batch or on the output of
+ * LabelSelect_Batch, it takes the timestamp of a frame when its last word passes and stores the
+ * cycles since into entry frame % Depth of the latency ring buffer, to be read by the host over
+ * AXI-lite together with the number of recorded frames.
+ *
+ * \tparam     Enable     Whether the measurement is instantiated
+ * \tparam     NumWords   Number of words per frame at this point of the pipeline
+ * \tparam     Depth      Number of entries of the latency ring buffer, a power of two
+ * \tparam     T          Type of the stream words
+ *
+ * \param      in         Input stream
+ * \param      out        Output stream
+ * \param      stamps     Timestamps of the frames
+ * \param      latency    Ring buffer of the latencies in cycles of the last Depth frames
+ * \param      frames     Number of frames recorded
+ * \param      numReps    Number of frames
+ *
+ */
+template<bool Enable, unsigned int NumWords, unsigned int Depth, typename T>
+void FrameLatency_Batch(hls::stream<T> &in, hls::stream<T> &out, hls::stream<frame_stamp_t> &stamps,
+	ap_uint<32> latency[Depth], unsigned int &frames, unsigned int const numReps) {
+	if (Enable) {
+		detail::frame_stamp_drop  drop;
+		detail::frame_latency<NumWords, Depth>(in, out, stamps, drop, latency, frames, numReps);
+	}
+}
+
+/**
+ * \brief   Frame latency tap - records the latency of every frame at an intermediate point of the pipeline
+ *
+ * As FrameLatency_Batch, but passing the timestamps on to the next tap or to the final FrameLatency_Batch.
+ *
+ * \tparam     Enable       Whether the measurement is instantiated
+ * \tparam     NumWords     Number of words per frame at this point of the pipeline
+ * \tparam     Depth        Number of entries of the latency ring buffer, a power of two
+ * \tparam     T            Type of the stream words
+ *
+ * \param      in           Input stream
+ * \param      out          Output stream
+ * \param      stamps_in    Timestamps of the frames
+ * \param      stamps_out   Timestamps passed on
+ * \param      latency      Ring buffer of the latencies in cycles of the last Depth frames
+ * \param      frames       Number of frames recorded
+ * \param      numReps      Number of frames
+ *
+ */
+template<bool Enable, unsigned int NumWords, unsigned int Depth, typename T>
+void FrameLatencyTap_Batch(hls::stream<T> &in, hls::stream<T> &out, hls::stream<frame_stamp_t> &stamps_in, hls::stream<frame_stamp_t> &stamps_out,
+	ap_uint<32> latency[Depth], unsigned int &frames, unsigned int const numReps) {
+	if (Enable) {
+		detail::frame_latency<NumWords, Depth>(in, out, stamps_in, stamps_out, latency, frames, numReps);
+	}
+}
+
+/**
+ * \brief   Stream tap - passes a stream on and, in csim, records it or checks it against a golden file
+ *
+ * A plain copy stage in synthesis. In csim, the words are handed to the tap Id of StreamTapper as
+ * they pass, which records them into a preallocated buffer or file, or compares them against a
+ * golden file reporting the first mismatch, if the testbench selected the tap. Unlike
+ * logStringStream, the stream is neither drained nor copied, so taps can sit between any stages
+ * of a dataflow region.
+ *
+ * \tparam     Id         Number of the tap in StreamTapper
+ * \tparam     NumWords   Number of words per image
+ * \tparam     T          Type of the stream words, an ap_uint or ap_int
+ *
+ * \param      in         Input stream
+ * \param      out        Output stream
+ * \param      numReps    Number of images
+ *
+ */
+template<unsigned int Id, unsigned int NumWords, typename T>
+void StreamTap_Batch(hls::stream<T> &in, hls::stream<T> &out, unsigned int const numReps) {
+#ifndef __SYNTHESIS__
+	StreamTapper::Tap *const  tap = StreamTapper::instance().begin(Id, (unsigned long long)numReps * NumWords, (T::width+7)/8);
+#endif
+	for (unsigned int i = 0; i < numReps * NumWords; i++) {
+#pragma HLS pipeline style=flp II=1
+		T const  w = in.read();
+#ifndef __SYNTHESIS__
+		if (tap) {
+			tap->word(Id, ap_uint<T::width>(w));
+		}
+#endif
+		out.write(w);
+	}
+}
+
+namespace detail {
+
+/**
+ * \brief   Histogram bin of a value - the top bits of its offset into the value range of its type
+ */
+template<unsigned int Bins, typename TElem>
+ap_uint<clog2(Bins)> stream_stats_bin(TElem const &x) {
+#pragma HLS INLINE
+	constexpr unsigned int  W = TElem::width;
+	ap_uint<W>  u = x;
+	if (TElem::sign_flag) {
+		u[W-1] = !u[W-1];
+	}
+	return  u(W-1, W-clog2(Bins));
+}
+
+} // namespace detail
+
+/**
+ * \brief   Stream statistics - passes a stream of channel vectors on and records per-channel min/max and a histogram
+ *
+ * A copy stage at II=1 for recalibrating quantization on live traffic. Every word carries PE
+ * elements of type TElem, the element pe of fold nf being channel nf*PE + pe as on the output
+ * of the MVAU and ConvLayer blocks. The minimum and maximum of every channel and a histogram of
+ * all elements over the value range of TElem, split into Bins equal bins, are collected over
+ * the numReps images of the call and written to the host-readable minimum, maximum and
+ * histogram arrays once the last word has passed.
+ *
+ * Each PE lane counts into its own bank of the histogram, so that the lanes never contend for a
+ * port, and the banks are summed when the statistics are written out. A lane keeps the counter
+ * of its last bin in a register while the same bin repeats and forwards the value it stored one
+ * word earlier, so that the read-modify-write of a counter bank never depends on the previous
+ * word. The per-channel extrema forward the same way when every word holds all channels.
+ * Clearing and writing out the statistics takes Bins + NumChannels/PE cycles per call.
+ *
+ * \tparam     NumChannels  Number of channels
+ * \tparam     PE           Number of channels per stream word
+ * \tparam     NumPixels    Number of pixels per image
+ * \tparam     Bins         Number of histogram bins, a power of two of at least two
+ * \tparam     TElem        Type of the elements, an ap_int or ap_uint
+ * \tparam     R            Resource type of the counter banks
+ *
+ * \param      in           Input stream
+ * \param      out          Output stream
+ * \param      minimum      Minimum of every channel
+ * \param      maximum      Maximum of every channel
+ * \param      histogram    Number of elements in every bin
+ * \param      numReps      Number of images
+ * \param      r            Resource type of the counter banks
+ *
+ */
+template<unsigned int NumChannels, unsigned int PE, unsigned int NumPixels, unsigned int Bins,
+	typename TElem, typename R = ap_resource_bram>
+void StreamStats_Batch(hls::stream<ap_uint<PE*TElem::width>> &in, hls::stream<ap_uint<PE*TElem::width>> &out,
+	TElem minimum[NumChannels], TElem maximum[NumChannels], ap_uint<32> histogram[Bins],
+	unsigned int const numReps, R const &r = R()) {
+	static_assert(NumChannels % PE == 0, "PE must divide NumChannels");
+	static_assert(Bins >= 2 && (Bins & (Bins-1)) == 0, "Bins must be a power of two of at least two");
+	static_assert(clog2(Bins) <= TElem::width, "More bins than values of TElem");
+	constexpr unsigned int  NF = NumChannels / PE;
+	constexpr unsigned int  W  = TElem::width;
+	constexpr unsigned int  BB = clog2(Bins);
+	using bin_t = ap_uint<BB>;
+	using count_t = ap_uint<32>;
+
+	count_t  hist[PE][Bins];
+#pragma HLS ARRAY_PARTITION variable=hist complete dim=1
+	memory_resource(hist, r);
+#pragma HLS DEPENDENCE variable=hist inter RAW distance=2 true
+	TElem  lo[PE][NF];
+	TElem  hi[PE][NF];
+#pragma HLS ARRAY_PARTITION variable=lo complete dim=1
+#pragma HLS ARRAY_PARTITION variable=hi complete dim=1
+#pragma HLS DEPENDENCE variable=lo inter RAW distance=2 true
+#pragma HLS DEPENDENCE variable=hi inter RAW distance=2 true
+
+	for (unsigned int  b = 0; b < Bins; b++) {
+#pragma HLS pipeline style=flp II=1
+		for (unsigned int  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+			hist[pe][b] = 0;
+		}
+	}
+
+	// Counter of the current bin and the last counter stored of every lane
+	bin_t    cur_bin[PE];
+	count_t  cur_cnt[PE];
+	bin_t    last_bin[PE];
+	count_t  last_cnt[PE];
+	// Extrema of the previous fold
+	TElem    last_lo[PE];
+	TElem    last_hi[PE];
+#pragma HLS ARRAY_PARTITION variable=cur_bin complete
+#pragma HLS ARRAY_PARTITION variable=cur_cnt complete
+#pragma HLS ARRAY_PARTITION variable=last_bin complete
+#pragma HLS ARRAY_PARTITION variable=last_cnt complete
+#pragma HLS ARRAY_PARTITION variable=last_lo complete
+#pragma HLS ARRAY_PARTITION variable=last_hi complete
+	for (unsigned int  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+		cur_bin[pe] = 0;
+		cur_cnt[pe] = 0;
+		last_bin[pe] = 0;
+		last_cnt[pe] = 0;
+	}
+
+	unsigned int  nf = 0;
+	unsigned int  prev_nf = NF;
+	bool  first = true;
+	for (unsigned int  i = 0; i < numReps * NumPixels * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+		ap_uint<PE*W> const  w = in.read();
+		out.write(w);
+		for (unsigned int  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+			TElem const  x = w((pe+1)*W-1, pe*W);
+
+			// Extrema, taken from the register when written by the previous word
+			TElem const  l = nf == prev_nf? last_lo[pe] : lo[pe][nf];
+			TElem const  h = nf == prev_nf? last_hi[pe] : hi[pe][nf];
+			TElem const  nl = first || x < l? x : l;
+			TElem const  nh = first || x > h? x : h;
+			lo[pe][nf] = nl;
+			hi[pe][nf] = nh;
+			last_lo[pe] = nl;
+			last_hi[pe] = nh;
+
+			// Histogram, stores the finished counter whenever the bin changes
+			bin_t const  b = detail::stream_stats_bin<Bins>(x);
+			if (b == cur_bin[pe]) {
+				cur_cnt[pe]++;
+			}
+			else {
+				count_t const  c = b == last_bin[pe]? last_cnt[pe] : hist[pe][b];
+				hist[pe][cur_bin[pe]] = cur_cnt[pe];
+				last_bin[pe] = cur_bin[pe];
+				last_cnt[pe] = cur_cnt[pe];
+				cur_bin[pe] = b;
+				cur_cnt[pe] = c + 1;
+			}
+		}
+		prev_nf = nf;
+		if (++nf == NF) {
+			nf = 0;
+			first = false;
+		}
+	}
+
+	for (unsigned int  b = 0; b < Bins; b++) {
+#pragma HLS pipeline style=flp II=1
+		count_t  sum = 0;
+		for (unsigned int  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+			sum += b == cur_bin[pe]? cur_cnt[pe] : hist[pe][b];
+		}
+		histogram[b] = sum;
+	}
+	for (unsigned int  f = 0; f < NF; f++) {
+#pragma HLS pipeline style=flp II=1
+		for (unsigned int  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+			minimum[f*PE + pe] = lo[pe][f];
+			maximum[f*PE + pe] = hi[pe][f];
+		}
+	}
+}
+
+namespace detail {
+
+/** One register hop of an SLR crossing. */
+template<unsigned int NumWords, typename T>
+void slr_hop(hls::stream<T> &in, hls::stream<T> &out, unsigned int const numReps) {
+	for (unsigned int i = 0; i < numReps * NumWords; i++) {
+#pragma HLS pipeline style=flp II=1
+		out.write(in.read());
+	}
+}
+
+template<unsigned int NumWords, typename T>
+void slr_crossing(hls::stream<T> &in, hls::stream<T> &out, unsigned int const numReps, std::integral_constant<unsigned int, 1>) {
+#pragma HLS INLINE
+	slr_hop<NumWords>(in, out, numReps);
+}
+template<unsigned int NumWords, unsigned int Stages, typename T>
+void slr_crossing(hls::stream<T> &in, hls::stream<T> &out, unsigned int const numReps, std::integral_constant<unsigned int, Stages>) {
+#pragma HLS INLINE
+	hls::stream<T>  hop("SLRCrossing_Batch.hop");
+#pragma HLS STREAM variable=hop depth=2
+	slr_hop<NumWords>(in, hop, numReps);
+	slr_crossing<NumWords>(hop, out, numReps, std::integral_constant<unsigned int, Stages-1>());
+}
+
+} // namespace detail
+
+/**
+ * \brief   SLR crossing - passes a stream on through a chain of register hops for a die boundary
+ *
+ * Meant for the dataflow edges between stages placed on different SLRs of a multi-die device,
+ * such as the wide output of ConvLayer_Batch_MMV or the weight stream of GenParamStream. Each
+ * of the Stages hops is a copy stage writing into a FIFO of depth two, which registers the
+ * data and valid of the word and, as it signals full one word early, drives the ready of the
+ * previous hop from a register as well. No path of the handshake thus spans more than one hop,
+ * and the hops can be placed on either side of the boundary and on the Laguna registers across
+ * it. The hops add Stages words of buffering and latency but keep a throughput of one word per
+ * cycle. The caller inserts them into a dataflow region, and the SLRs of its stages are set by
+ * the floorplan, e.g. with pipeline::OnSLR in pipeline.hpp.
+ *
+ * \tparam     Stages     Number of register hops, at least one
+ * \tparam     NumWords   Number of words per image
+ * \tparam     T          Type of the stream words
+ *
+ * \param      in         Input stream
+ * \param      out        Output stream
+ * \param      numReps    Number of images
+ *
+ */
+template<unsigned int Stages, unsigned int NumWords, typename T>
+void SLRCrossing_Batch(hls::stream<T> &in, hls::stream<T> &out, unsigned int const numReps) {
+#pragma HLS INLINE
+	static_assert(Stages > 0, "An SLR crossing needs at least one register hop");
+	detail::slr_crossing<NumWords>(in, out, numReps, std::integral_constant<unsigned int, Stages>());
+}
+
+/**
+ * \brief   Header beat of a packet on an inter-device link, see Stream2Link_Batch
+ *
+ * Every packet starts with a header beat followed by its payload beats, the last of which carries TLAST.
+ * Header layout from the LSB: frame index (32 bits), packet index within the frame (16 bits), number of
+ * payload beats (16 bits), end-of-frame flag.
+ *
+ * \tparam     LinkWidth    Width, in number of bits, of the link beats
+ */
+template<unsigned int LinkWidth>
+struct LinkPacketHeader {
+  static_assert(LinkWidth >= 65, "A link beat must hold the packet header");
+  using type = ap_uint<LinkWidth>;
+
+  static type pack(unsigned int const  frame, unsigned int const  packet, unsigned int const  words, bool const  last) {
+#pragma HLS inline
+    type  h = 0;
+    h(31, 0)  = frame;
+    h(47, 32) = packet;
+    h(63, 48) = words;
+    h[64] = last;
+    return  h;
+  }
+  static unsigned int frame(type const &h) {
+#pragma HLS inline
+    return  h(31, 0);
+  }
+  static unsigned int packet(type const &h) {
+#pragma HLS inline
+    return  h(47, 32);
+  }
+  static unsigned int words(type const &h) {
+#pragma HLS inline
+    return  h(63, 48);
+  }
+  static bool last(type const &h) {
+#pragma HLS inline
+    return  h[64];
+  }
+};
+
+/** Credit token returned by Link2Stream_Batch: the number of packets released from the receive buffer. */
+using LinkCredit = ap_uint<16>;
+
+/**
+ * \brief   Stream to inter-device link conversion - Sends frames as credit-controlled packets over a network link
+ *
+ * Lets a dataflow pipeline, e.g. of ConvLayer_Batch stages, be partitioned across devices connected by
+ * 100G Ethernet (through a UDP/IP stack) or Aurora cores, whose AXI4-Stream ports take the qdma_axis beats.
+ * Each frame of NumWords beats is cut into packets of at most PacketWords payload beats plus a header beat,
+ * see LinkPacketHeader, so that packets never span frames. The sender may have up to Credits packets in
+ * flight. A packet consumes one credit, and the receiving Link2Stream_Batch returns credits on the reverse
+ * direction of the link as it drains its buffer of Credits packets, so data is never dropped by the link.
+ * The credit count persists across invocations, like the buffer it stands for. With PacketWords large
+ * against the round-trip time, the throughput is that of the link less one header beat per packet.
+ *
+ * Partitioning convention: both sides of every link are launched with the same numReps and the same frame
+ * geometry, and the frame index of the headers restarts from zero with every invocation.
+ *
+ * \tparam     LinkWidth    Width, in number of bits, of the link beats
+ * \tparam     NumWords     Number of beats per frame
+ * \tparam     PacketWords  Maximum number of payload beats per packet
+ * \tparam     Credits      Number of packets the receive buffer holds
+ *
+ * \param      in           Input stream
+ * \param      out          Output link stream
+ * \param      credit       Credit tokens returned by the receiver
+ * \param      numReps      Number of frames / images
+ *
+ */
+template<unsigned int LinkWidth, unsigned int NumWords, unsigned int PacketWords, unsigned int Credits>
+void Stream2Link_Batch(hls::stream<ap_uint<LinkWidth> > & in, hls::stream<qdma_axis<LinkWidth,0,0,0> > & out,
+		hls::stream<LinkCredit> & credit, const unsigned int numReps){
+	static_assert(PacketWords > 0 && PacketWords < (1u << 16), "Packet payload must fit the header");
+	static_assert(Credits > 0, "The receiver must hold at least one packet");
+	constexpr unsigned int  Packets = (NumWords + PacketWords - 1) / PacketWords;
+
+	static unsigned int  available = Credits;
+#pragma HLS reset variable=available
+
+	unsigned int  frame  = 0;
+	unsigned int  packet = 0;
+	unsigned int  word   = 0;	// beat in the packet, 0 for the header
+	for (unsigned int i = 0; i < numReps * (Packets + NumWords); i++) {
+#pragma HLS pipeline style=flp II=1
+		unsigned int const  words = packet == Packets-1? NumWords - (Packets-1)*PacketWords : PacketWords;
+		qdma_axis<LinkWidth,0,0,0>  temp;
+		temp.set_keep(-1);
+		if (word == 0) {
+			LinkCredit  c;
+			if (available == 0)  available += credit.read();
+			else if (credit.read_nb(c))  available += c;
+			available--;
+			temp.set_data(LinkPacketHeader<LinkWidth>::pack(frame, packet, words, packet == Packets-1));
+			temp.set_last(0);
+		}
+		else {
+			temp.set_data(in.read());
+			temp.set_last(word == words);
+		}
+		out.write(temp);
+
+		if (word++ == words) {
+			word = 0;
+			if (++packet == Packets) {
+				packet = 0;
+				frame++;
+			}
+		}
+	}
+}
+
+/**
+ * \brief   Inter-device link to stream conversion - Receives the credit-controlled packets of Stream2Link_Batch
+ *
+ * Strips the headers and forwards the payload of every packet, then returns its credit. The link input is
+ * meant to be fed through a FIFO holding the Credits packets of the sender, counting their header beats.
+ * Headers are checked against the expected frame, packet and length but the payload is forwarded by the
+ * expected length regardless, so that a corrupt header cannot desynchronise the pipeline behind.
+ *
+ * \tparam     LinkWidth    Width, in number of bits, of the link beats
+ * \tparam     NumWords     Number of beats per frame
+ * \tparam     PacketWords  Maximum number of payload beats per packet
+ *
+ * \param      in           Input link stream
+ * \param      out          Output stream
+ * \param      credit       Credit tokens returned to the sender
+ * \param      numReps      Number of frames / images
+ *
+ * \return     Number of packets with an unexpected header
+ *
+ */
+template<unsigned int LinkWidth, unsigned int NumWords, unsigned int PacketWords>
+unsigned int Link2Stream_Batch(hls::stream<qdma_axis<LinkWidth,0,0,0> > & in, hls::stream<ap_uint<LinkWidth> > & out,
+		hls::stream<LinkCredit> & credit, const unsigned int numReps){
+	constexpr unsigned int  Packets = (NumWords + PacketWords - 1) / PacketWords;
+	using Header = LinkPacketHeader<LinkWidth>;
+
+	unsigned int  errors = 0;
+	unsigned int  frame  = 0;
+	unsigned int  packet = 0;
+	unsigned int  word   = 0;
+	for (unsigned int i = 0; i < numReps * (Packets + NumWords); i++) {
+#pragma HLS pipeline style=flp II=1
+		unsigned int const  words = packet == Packets-1? NumWords - (Packets-1)*PacketWords : PacketWords;
+		ap_uint<LinkWidth> const  data = in.read().get_data();
+		if (word == 0) {
+			bool const  ok = Header::frame(data) == frame && Header::packet(data) == packet &&
+				Header::words(data) == words && Header::last(data) == (packet == Packets-1);
+			if (!ok)  errors++;
+		}
+		else {
+			out.write(data);
+			if (word == words)  credit.write(1);
+		}
+
+		if (word++ == words) {
+			word = 0;
+			if (++packet == Packets) {
+				packet = 0;
+				frame++;
+			}
+		}
+	}
+	return  errors;
+}
+
+/**
+ * \brief   Stream to inter-device link conversion with a bridge from the stream width to the link width
+ *
+ * Adjusts the width of the input stream to LinkWidth, see WidthAdjustedInputStream, and sends it on
+ * with Stream2Link_Batch.
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the input stream
+ * \tparam     LinkWidth    Width, in number of bits, of the link beats
+ * \tparam     NumWords     Number of input words per frame
+ * \tparam     PacketWords  Maximum number of payload beats per packet
+ * \tparam     Credits      Number of packets the receive buffer holds
+ *
+ * \param      in           Input stream
+ * \param      out          Output link stream
+ * \param      credit       Credit tokens returned by the receiver
+ * \param      numReps      Number of frames / images
+ *
+ */
+template<unsigned int DataWidth, unsigned int LinkWidth, unsigned int NumWords, unsigned int PacketWords, unsigned int Credits>
+void Stream2Link_Adjusted_Batch(hls::stream<ap_uint<DataWidth> > & in, hls::stream<qdma_axis<LinkWidth,0,0,0> > & out,
+		hls::stream<LinkCredit> & credit, const unsigned int numReps){
+#pragma HLS INLINE
+	static_assert((NumWords * DataWidth) % LinkWidth == 0, "Frames must fill whole link beats");
+	WidthAdjustedInputStream<DataWidth, LinkWidth, NumWords>  wa_in(in, numReps);
+	Stream2Link_Batch<LinkWidth, NumWords*DataWidth/LinkWidth, PacketWords, Credits>(wa_in, out, credit, numReps);
+}
+
+/**
+ * \brief   Inter-device link to stream conversion with a bridge from the link width to the stream width
+ *
+ * The counterpart of Stream2Link_Adjusted_Batch: receives with Link2Stream_Batch and adjusts the width of
+ * the output to DataWidth, see WidthAdjustedOutputStream.
+ *
+ * \tparam     DataWidth    Width, in number of bits, of the output stream
+ * \tparam     LinkWidth    Width, in number of bits, of the link beats
+ * \tparam     NumWords     Number of output words per frame
+ * \tparam     PacketWords  Maximum number of payload beats per packet
+ *
+ * \param      in           Input link stream
+ * \param      out          Output stream
+ * \param      credit       Credit tokens returned to the sender
+ * \param      numReps      Number of frames / images
+ *
+ * \return     Number of packets with an unexpected header
+ *
+ */
+template<unsigned int DataWidth, unsigned int LinkWidth, unsigned int NumWords, unsigned int PacketWords>
+unsigned int Link2Stream_Adjusted_Batch(hls::stream<qdma_axis<LinkWidth,0,0,0> > & in, hls::stream<ap_uint<DataWidth> > & out,
+		hls::stream<LinkCredit> & credit, const unsigned int numReps){
+#pragma HLS INLINE
+	static_assert((NumWords * DataWidth) % LinkWidth == 0, "Frames must fill whole link beats");
+	constexpr unsigned int  LinkWords = NumWords*DataWidth/LinkWidth;
+	WidthAdjustedOutputStream<LinkWidth, DataWidth, LinkWords>  wa_out(out, numReps);
+	return  Link2Stream_Batch<LinkWidth, LinkWords, PacketWords>(in, wa_out, credit, numReps);
+}
+
+//- Block Floating-Point Streams ---------------------------------------------
+/*
+ * A block floating-point word holds N lanes of signed M-bit mantissas in its
+ * lower N*M bits, lane i at bits [i*M, (i+1)*M), and an unsigned E-bit
+ * exponent in its topmost bits. A lane represents the integer mantissa * 2^exponent,
+ * the exponent being shared by all lanes of all words of a block. Blocks
+ * keep the dynamic range of W-bit integers at the stream cost of M-bit
+ * ones, at a precision of M bits relative to the largest element of the block.
+ * An MVAU consumes such words through BFPSlice and BFPActivation, for which
+ * a block must span all SIMD words of an input vector.
+ */
+
+/**
+ * \brief   Block floating-point encoder
+ *
+ * Encodes blocks of BlockWords words of N signed W-bit integers. The exponent
+ * of a block is the smallest one for which its largest element fits an M-bit
+ * mantissa, limited to 2^E-1. The mantissas are rounded to nearest, ties
+ * towards positive infinity, and saturated. A block is buffered while
+ * it is read and emitted while the next one is read, the two banks taking II=1.
+ *
+ * \tparam     N            Number of lanes per word
+ * \tparam     W            Width of an input integer
+ * \tparam     M            Width of a mantissa
+ * \tparam     E            Width of the exponent
+ * \tparam     BlockWords   Number of words sharing an exponent
+ *
+ * \param      in           Input stream of N lanes of W bits
+ * \param      out          Output stream of block floating-point words
+ * \param      numBlocks    Number of blocks to encode
+ */
+template<unsigned N, unsigned W, unsigned M, unsigned E, unsigned BlockWords>
+void BFP_Encode_Batch(hls::stream<ap_uint<N*W> > &in, hls::stream<ap_uint<N*M+E> > &out, unsigned const  numBlocks) {
+	static_assert((M >= 2) && (M <= W), "Mantissas must be of 2 to W bits.");
+	static_assert((E > 0) && (E <= 5), "Exponents must be of 1 to 5 bits.");
+	static_assert(BlockWords > 0, "Blocks must not be empty.");
+	FINN_STREAM_CHECK_IN(in, 1ull * numBlocks * BlockWords);
+	FINN_STREAM_CHECK_OUT(out, 1ull * numBlocks * BlockWords);
+	constexpr unsigned  EMAX = (1u << E) - 1;
+
+	ap_uint<N*W>  buf[2][BlockWords];
+#pragma HLS DEPENDENCE variable=buf inter false
+	ap_uint<W-1>  mag = 0;	// OR of the magnitudes of the block being read
+	ap_uint<E>  exp = 0;	// exponent of the block being emitted
+	ap_uint<1>  bank = 0;	// bank of the block being read
+	unsigned  w = 0;
+	for(unsigned  i = 0; i < (numBlocks+1) * BlockWords; i++) {
+#pragma HLS pipeline style=flp II=1
+		if(i >= BlockWords) {
+			ap_uint<N*W> const  word = buf[!bank][w];
+			ap_uint<N*M+E>  res;
+			for(unsigned  n = 0; n < N; n++) {
+#pragma HLS UNROLL
+				ap_int<W+1> const  x = ap_int<W>(word((n+1)*W-1, n*W));
+				ap_int<W+1> const  rnd = exp == 0? ap_int<W+1>(0) : ap_int<W+1>(ap_int<W+1>(1) << (exp-1));
+				ap_int<W+1> const  m = (x + rnd) >> exp;
+				ap_int<W+1> const  hi = (ap_int<W+1>(1) << (M-1)) - 1;
+				ap_int<W+1> const  lo = -(ap_int<W+1>(1) << (M-1));
+				res((n+1)*M-1, n*M) = m > hi? hi : m < lo? lo : m;
+			}
+			res(N*M+E-1, N*M) = exp;
+			out.write(res);
+		}
+		ap_uint<W-1>  mag_cur = mag;
+		if(i < numBlocks * BlockWords) {
+			ap_uint<N*W> const  word = in.read();
+			buf[bank][w] = word;
+			for(unsigned  n = 0; n < N; n++) {
+#pragma HLS UNROLL
+				ap_int<W> const  x = word((n+1)*W-1, n*W);
+				// the magnitude bits beyond the sign, ~x for negative values
+				mag_cur |= ap_uint<W-1>(x < 0? ap_int<W>(~x) : x);
+			}
+		}
+		if(++w == BlockWords) {
+			// number of magnitude bits of the block, its elements need one more for the sign
+			unsigned  bits = 0;
+			for(unsigned  b = 0; b < W-1; b++) {
+#pragma HLS UNROLL
+				if(mag_cur[b])  bits = b+1;
+			}
+			exp = bits+1 > M? (bits+1-M > EMAX? EMAX : bits+1-M) : 0;
+			mag = 0;
+			bank = !bank;
+			w = 0;
+		}
+		else {
+			mag = mag_cur;
+		}
+	}
+}
+
+/**
+ * \brief   Block floating-point decoder
+ *
+ * Expands every lane to the integer mantissa * 2^exponent, saturated to W bits.
+ *
+ * \tparam     N            Number of lanes per word
+ * \tparam     M            Width of a mantissa
+ * \tparam     E            Width of the exponent
+ * \tparam     W            Width of an output integer
+ * \tparam     NumWords     Number of words to decode
+ *
+ * \param      in           Input stream of block floating-point words
+ * \param      out          Output stream of N lanes of W bits
+ * \param      numReps      Number of times the function has to be called
+ */
+template<unsigned N, unsigned M, unsigned E, unsigned W, unsigned NumWords>
+void BFP_Decode_Batch(hls::stream<ap_uint<N*M+E> > &in, hls::stream<ap_uint<N*W> > &out, unsigned const  numReps) {
+	static_assert((E > 0) && (E <= 5), "Exponents must be of 1 to 5 bits.");
+	FINN_STREAM_CHECK_IN(in, 1ull * numReps * NumWords);
+	FINN_STREAM_CHECK_OUT(out, 1ull * numReps * NumWords);
+	constexpr unsigned  XW = M + (1u << E) - 1;
+	constexpr unsigned  RW = (XW > W? XW : W) + 1;
+	for(unsigned  i = 0; i < numReps * NumWords; i++) {
+#pragma HLS pipeline style=flp II=1
+		ap_uint<N*M+E> const  word = in.read();
+		ap_uint<E> const  exp = word(N*M+E-1, N*M);
+		ap_uint<N*W>  res;
+		for(unsigned  n = 0; n < N; n++) {
+#pragma HLS UNROLL
+			ap_int<RW>  x = ap_int<M>(word((n+1)*M-1, n*M));
+			x <<= exp;
+			ap_int<RW> const  hi = (ap_int<RW>(1) << (W-1)) - 1;
+			ap_int<RW> const  lo = -(ap_int<RW>(1) << (W-1));
+			res((n+1)*W-1, n*W) = x > hi? hi : x < lo? lo : x;
+		}
+		out.write(res);
+	}
+}
+
+/**
+ * \brief   Stream Data Width Converter for block floating-point words
+ *
+ * Converts words of InLanes mantissas into words of OutLanes mantissas with the
+ * exponent kept in the topmost bits. Splitting a word replicates its exponent.
+ * Merging words takes the exponent of the last one, so the words merged into
+ * one must belong to the same block, i.e. the block length must be a multiple
+ * of OutLanes/InLanes input words.
+ *
+ * \tparam     InLanes      Number of mantissas per input word
+ * \tparam     OutLanes     Number of mantissas per output word
+ * \tparam     M            Width of a mantissa
+ * \tparam     E            Width of the exponent
+ * \tparam     NumInWords   Number of input words to process
+ *
+ * \param      in           Input stream
+ * \param      out          Output stream
+ * \param      numReps      Number of times the function has to be called
+ */
+template<unsigned InLanes, unsigned OutLanes, unsigned M, unsigned E, unsigned NumInWords>
+void StreamingDataWidthConverter_BFP_Batch(hls::stream<ap_uint<InLanes*M+E> > &in,
+		hls::stream<ap_uint<OutLanes*M+E> > &out, unsigned const  numReps) {
+	static_assert((InLanes % OutLanes == 0) || (OutLanes % InLanes == 0), "");
+	FINN_STREAM_CHECK_IN(in, 1ull * numReps * NumInWords);
+	FINN_STREAM_CHECK_OUT(out, 1ull * numReps * NumInWords * InLanes / OutLanes);
+
+	if(InLanes > OutLanes) {
+		// emit multiple output words per input word read
+		unsigned const  outPerIn = InLanes / OutLanes;
+		unsigned  o = 0;
+		ap_uint<InLanes*M>  ei = 0;
+		ap_uint<E>  exp = 0;
+		for(unsigned  t = 0; t < NumInWords * outPerIn * numReps; t++) {
+#pragma HLS pipeline style=flp II=1
+			if(o == 0) {
+				ap_uint<InLanes*M+E> const  word = in.read();
+				ei = word(InLanes*M-1, 0);
+				exp = word(InLanes*M+E-1, InLanes*M);
+			}
+			ap_uint<OutLanes*M+E>  eo = ei(OutLanes*M-1, 0);
+			eo(OutLanes*M+E-1, OutLanes*M) = exp;
+			out.write(eo);
+			ei = ei >> (OutLanes*M);
+			if(++o == outPerIn)  o = 0;
+		}
+	}
+	else if(InLanes == OutLanes) {
+		// straight-through copy
+		for(unsigned  t = 0; t < NumInWords * numReps; t++) {
+#pragma HLS pipeline style=flp II=1
+			out.write(in.read());
+		}
+	}
+	else {
+		// read multiple input words per output word emitted
+		unsigned const  inPerOut = OutLanes / InLanes;
+		unsigned  i = 0;
+		ap_uint<OutLanes*M>  eo = 0;
+		for(unsigned  t = 0; t < NumInWords * numReps; t++) {
+#pragma HLS pipeline style=flp II=1
+			ap_uint<InLanes*M+E> const  ei = in.read();
+			eo = eo >> (InLanes*M);
+			eo(OutLanes*M-1, (OutLanes-InLanes)*M) = ei(InLanes*M-1, 0);
+			if(++i == inPerOut) {
+				i = 0;
+				ap_uint<OutLanes*M+E>  word = eo;
+				word(OutLanes*M+E-1, OutLanes*M) = ei(InLanes*M+E-1, InLanes*M);
+				out.write(word);
+			}
+		}
+	}
+}
+
 #endif
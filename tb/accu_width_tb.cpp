@@ -0,0 +1,117 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file accu_width_tb.cpp
+ *
+ *  Testbench for the minimal accumulator type derived by accu_type
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_codebook.h"
+#include "data/config_codebook.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 8
+#define SF_CB (MatrixW_CB/SIMD_CB)
+#define NF_CB (MatrixH_CB/PE_CB)
+
+typedef accu_type<MatrixW_CB, ap_uint<INPUT_PRECISION_CB>, ap_int<WIDTH_CB> >  accu_t;
+// 32 * -128*15 = -61440 needs 17 signed bits
+static_assert(accu_t::width == 17 && accu_t::is_signed, "Unexpected accumulator of the codebook layer.");
+// popcount of 64 XNOR products
+static_assert(std::is_same<accu_type<64, XnorMul, ap_uint<1> >::type, ap_uint<7> >::value, "Unexpected XNOR accumulator.");
+// 64 binary products of 4-bit inputs within [-960, 960]
+static_assert(std::is_same<accu_type<64, ap_uint<4>, Binary>::type, ap_int<11> >::value, "Unexpected binary accumulator.");
+// known range of the weights, 16 products of 2-bit inputs and weights within [0, 5]
+static_assert(std::is_same<accu_type<16, ap_uint<2>, ap_int<8>, 0, 5>::type, ap_uint<8> >::value, "Unexpected range-restricted accumulator.");
+// 9 products of signed 3-bit inputs and power-of-two weights up to 2^3 within [-288, 288]
+static_assert(std::is_same<accu_type<9, ap_int<3>, LogWeight<2> >::type, ap_int<10> >::value, "Unexpected power-of-two accumulator.");
+
+void Testbench_accu_width(stream<ap_uint<SIMD_CB*INPUT_PRECISION_CB> > & in, stream<ap_uint<PE_CB*accu_t::width> > & out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<INPUT_PRECISION_CB> IMAGE[NUM_REPEAT][MatrixW_CB];
+	stream<ap_uint<SIMD_CB*INPUT_PRECISION_CB> > input_stream("input_stream");
+	stream<ap_uint<PE_CB*accu_t::width> > output_stream("output_stream");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_CB; sf++) {
+			ap_uint<SIMD_CB*INPUT_PRECISION_CB> word;
+			for (unsigned int simd = 0; simd < SIMD_CB; simd++) {
+				// the last image drives all inputs to their maximum
+				ap_uint<INPUT_PRECISION_CB> const act = rep == NUM_REPEAT-1? ~0 : rand();
+				IMAGE[rep][sf*SIMD_CB + simd] = act;
+				word((simd+1)*INPUT_PRECISION_CB-1, simd*INPUT_PRECISION_CB) = act;
+			}
+			input_stream.write(word);
+		}
+	}
+
+	Testbench_accu_width(input_stream, output_stream, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF_CB; nf++) {
+			ap_uint<PE_CB*accu_t::width> const outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_CB; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_CB; col++)
+					exp += PARAM_CODEBOOK::raw[nf*PE_CB + pe][col] * IMAGE[rep][col];
+				accu_t::type const EXP = exp;
+				accu_t::type out_chan;
+				out_chan(accu_t::width-1, 0) = outElem((pe+1)*accu_t::width-1, pe*accu_t::width);
+				if ((EXP != out_chan) || (exp != int(out_chan))) {
+					cout << "ERROR: rep " << rep << " expected[" << nf*PE_CB + pe << "]=" << EXP << " actual " << out_chan << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
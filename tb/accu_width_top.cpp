@@ -0,0 +1,20 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_codebook.h"
+#include "data/config_codebook.h"
+
+// smallest accumulator of the codebook layer, 8-bit weights times 4-bit inputs over 32 columns
+typedef accu_type<MatrixW_CB, ap_uint<INPUT_PRECISION_CB>, ap_int<WIDTH_CB> >  accu_t;
+
+void Testbench_accu_width(stream<ap_uint<SIMD_CB*INPUT_PRECISION_CB> > & in, stream<ap_uint<PE_CB*accu_t::width> > & out, unsigned int numReps){
+#pragma HLS ARRAY_PARTITION variable=PARAM_CODEBOOK::weights.m_codebook complete dim=0
+	Matrix_Vector_Activate_Batch<MatrixW_CB, MatrixH_CB, SIMD_CB, PE_CB, 1, Slice<ap_uint<INPUT_PRECISION_CB> >, Slice<accu_t::type>, Identity>
+		(in, out, PARAM_CODEBOOK::weights, PassThroughActivation<accu_t::type>(), numReps, ap_resource_dsp());
+}
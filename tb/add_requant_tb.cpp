@@ -0,0 +1,133 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file add_requant_tb.cpp
+ *
+ *  Testbench for the requantizing element-wise addition, PE-folded and as
+ *  a layer with width conversion
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_add_requant.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_add_requant(stream<ap_uint<PE_AR*IN1_WIDTH_AR> > & in1, stream<ap_uint<PE_AR*IN2_WIDTH_AR> > & in2,
+	stream<ap_uint<PE_AR*OUT_WIDTH_AR> > & out, stream<ap_uint<CHANNELS_L_AR*IN1_WIDTH_AR> > & in1_l,
+	stream<ap_uint<CHANNELS_L_AR*IN2_WIDTH_AR> > & in2_l, stream<ap_uint<CHANNELS_L_AR*OUT_WIDTH_L_AR> > & out_l, unsigned int numReps);
+
+// golden requantization: aligned exact sum, scaled, rounded half up or truncated, saturated
+int requant(int a, int b, int shift1, int shift2, int out_shift, int offset, bool round, int lo, int hi) {
+	int const sum = (a << shift1) + (b << shift2) + offset;
+	double const scaled = double(sum) / (1 << out_shift);
+	int const q = int(round? floor(scaled + 0.5) : floor(scaled));
+	return q < lo? lo : q > hi? hi : q;
+}
+
+int main()
+{
+	stream<ap_uint<PE_AR*IN1_WIDTH_AR> > in1("in1");
+	stream<ap_uint<PE_AR*IN2_WIDTH_AR> > in2("in2");
+	stream<ap_uint<PE_AR*OUT_WIDTH_AR> > out("out");
+	stream<ap_uint<CHANNELS_L_AR*IN1_WIDTH_AR> > in1_l("in1_l");
+	stream<ap_uint<CHANNELS_L_AR*IN2_WIDTH_AR> > in2_l("in2_l");
+	stream<ap_uint<CHANNELS_L_AR*OUT_WIDTH_L_AR> > out_l("out_l");
+	static int expected[MAX_IMAGES*NUM_WORDS_AR][PE_AR];
+	static int expected_l[MAX_IMAGES*NUM_WORDS_AR][CHANNELS_L_AR];
+	unsigned int errors = 0;
+
+	for (unsigned int w = 0; w < MAX_IMAGES*NUM_WORDS_AR; w++) {
+		ap_uint<PE_AR*IN1_WIDTH_AR> e1;
+		ap_uint<PE_AR*IN2_WIDTH_AR> e2;
+		for (unsigned int pe = 0; pe < PE_AR; pe++) {
+			ap_uint<IN1_WIDTH_AR> const a = rand();
+			ap_int<IN2_WIDTH_AR> const b = rand();
+			e1((pe+1)*IN1_WIDTH_AR-1, pe*IN1_WIDTH_AR) = a;
+			e2((pe+1)*IN2_WIDTH_AR-1, pe*IN2_WIDTH_AR) = b;
+			expected[w][pe] = requant(a.to_int(), b.to_int(), SHIFT1_AR, SHIFT2_AR, OUT_SHIFT_AR, OFFSET_AR, true,
+				-(1 << (OUT_WIDTH_AR-1)), (1 << (OUT_WIDTH_AR-1)) - 1);
+		}
+		in1.write(e1);
+		in2.write(e2);
+
+		ap_uint<CHANNELS_L_AR*IN1_WIDTH_AR> l1;
+		ap_uint<CHANNELS_L_AR*IN2_WIDTH_AR> l2;
+		for (unsigned int c = 0; c < CHANNELS_L_AR; c++) {
+			ap_uint<IN1_WIDTH_AR> const a = rand();
+			ap_int<IN2_WIDTH_AR> const b = rand();
+			l1((c+1)*IN1_WIDTH_AR-1, c*IN1_WIDTH_AR) = a;
+			l2((c+1)*IN2_WIDTH_AR-1, c*IN2_WIDTH_AR) = b;
+			expected_l[w][c] = requant(a.to_int(), b.to_int(), 0, SHIFT2_L_AR, OUT_SHIFT_L_AR, 0, false,
+				0, (1 << OUT_WIDTH_L_AR) - 1);
+		}
+		in1_l.write(l1);
+		in2_l.write(l2);
+	}
+
+	Testbench_add_requant(in1, in2, out, in1_l, in2_l, out_l, MAX_IMAGES);
+
+	for (unsigned int w = 0; w < MAX_IMAGES*NUM_WORDS_AR; w++) {
+		ap_uint<PE_AR*OUT_WIDTH_AR> const e = out.read();
+		for (unsigned int pe = 0; pe < PE_AR; pe++) {
+			ap_int<OUT_WIDTH_AR> const value = e((pe+1)*OUT_WIDTH_AR-1, pe*OUT_WIDTH_AR);
+			if (value.to_int() != expected[w][pe]) {
+				cout << "ERROR folded: word " << w << " channel " << pe << " expected " << expected[w][pe] << " value " << value.to_int() << endl;
+				errors++;
+			}
+		}
+		ap_uint<CHANNELS_L_AR*OUT_WIDTH_L_AR> const l = out_l.read();
+		for (unsigned int c = 0; c < CHANNELS_L_AR; c++) {
+			ap_uint<OUT_WIDTH_L_AR> const value = l((c+1)*OUT_WIDTH_L_AR-1, c*OUT_WIDTH_L_AR);
+			if (value.to_int() != expected_l[w][c]) {
+				cout << "ERROR layer: word " << w << " channel " << c << " expected " << expected_l[w][c] << " value " << value.to_int() << endl;
+				errors++;
+			}
+		}
+	}
+
+	if (!in1.empty() || !in2.empty() || !out.empty() || !in1_l.empty() || !in2_l.empty() || !out_l.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,16 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_add_requant.h"
+
+void Testbench_add_requant(stream<ap_uint<PE_AR*IN1_WIDTH_AR> > & in1, stream<ap_uint<PE_AR*IN2_WIDTH_AR> > & in2,
+	stream<ap_uint<PE_AR*OUT_WIDTH_AR> > & out, stream<ap_uint<CHANNELS_L_AR*IN1_WIDTH_AR> > & in1_l,
+	stream<ap_uint<CHANNELS_L_AR*IN2_WIDTH_AR> > & in2_l, stream<ap_uint<CHANNELS_L_AR*OUT_WIDTH_L_AR> > & out_l, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	AddStreamsRequant_Batch<PE_AR, ap_uint<IN1_WIDTH_AR>, ap_int<IN2_WIDTH_AR>, ap_fixed<OUT_WIDTH_AR, OUT_WIDTH_AR, AP_RND, AP_SAT>,
+		NUM_WORDS_AR, SHIFT1_AR, SHIFT2_AR, OUT_SHIFT_AR, OFFSET_AR>(in1, in2, out, numReps);
+	AddStreamsRequantLayer_Batch<CHANNELS_L_AR, ap_uint<IN1_WIDTH_AR>, ap_int<IN2_WIDTH_AR>, ap_ufixed<OUT_WIDTH_L_AR, OUT_WIDTH_L_AR, AP_TRN, AP_SAT>,
+		NUM_WORDS_AR, PE_L_AR, 0, SHIFT2_L_AR, OUT_SHIFT_L_AR>(in1_l, in2_l, out_l, numReps);
+}
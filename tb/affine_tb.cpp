@@ -0,0 +1,146 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file affine_tb.cpp
+ *
+ *  Testbench for the fused affine channel-wise operation, with constant
+ *  parameters and with parameters streamed per frame
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_affine.h"
+#include "data/config_affine.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 4
+void Testbench_affine(stream<ap_uint<PE_AF*INPUT_PRECISION_AF> > & in, stream<ap_uint<PE_AF*OUTPUT_PRECISION_AF> > & out,
+	stream<ap_uint<PE_AF*INPUT_PRECISION_AF> > & in_s, stream<ap_uint<PE_AF*OUTPUT_PRECISION_AF> > & out_s,
+	stream<ap_uint<PE_AF*(SCALE_PRECISION_AF+BIAS_PRECISION_AF)> > & params, unsigned int numReps);
+
+int expected(int const in, int const scale, int const bias) {
+	int val = in * scale + bias;
+	if (SHIFT_AF > 0)
+		val = (val + (1 << (SHIFT_AF-1))) >> SHIFT_AF;
+	int const hi = (1 << OUTPUT_PRECISION_AF) - 1;
+	return val > hi? hi : val < 0? 0 : val;
+}
+
+int main()
+{
+	constexpr unsigned int NF = Channels_AF / PE_AF;
+	constexpr unsigned int PW = SCALE_PRECISION_AF + BIAS_PRECISION_AF;
+	static ap_int<INPUT_PRECISION_AF> IMAGE[MAX_IMAGES][IMGDIM_AF][Channels_AF];
+	static ap_int<SCALE_PRECISION_AF> SCALE[MAX_IMAGES][Channels_AF];
+	static ap_int<BIAS_PRECISION_AF> BIAS[MAX_IMAGES][Channels_AF];
+	stream<ap_uint<PE_AF*INPUT_PRECISION_AF> > input_stream("input_stream");
+	stream<ap_uint<PE_AF*OUTPUT_PRECISION_AF> > output_stream("output_stream");
+	stream<ap_uint<PE_AF*INPUT_PRECISION_AF> > input_stream_s("input_stream_s");
+	stream<ap_uint<PE_AF*OUTPUT_PRECISION_AF> > output_stream_s("output_stream_s");
+	stream<ap_uint<PE_AF*PW> > param_stream("param_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		// the first frame reuses the constant parameters, the others switch to new ones
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_AF*PW> param_word = 0;
+			for (unsigned int pe = 0; pe < PE_AF; pe++) {
+				unsigned int const ch = nf*PE_AF + pe;
+				SCALE[n_image][ch] = n_image == 0? PARAM_AFFINE::affine.m_scale[pe][nf] : (ap_int<SCALE_PRECISION_AF>)rand();
+				BIAS[n_image][ch] = n_image == 0? PARAM_AFFINE::affine.m_bias[pe][nf] : (ap_int<BIAS_PRECISION_AF>)rand();
+				param_word(pe*PW+SCALE_PRECISION_AF-1, pe*PW) = ap_uint<SCALE_PRECISION_AF>(SCALE[n_image][ch]);
+				param_word((pe+1)*PW-1, pe*PW+SCALE_PRECISION_AF) = ap_uint<BIAS_PRECISION_AF>(BIAS[n_image][ch]);
+			}
+			param_stream.write(param_word);
+		}
+		for (unsigned int pix = 0; pix < IMGDIM_AF; pix++) {
+			for (unsigned int nf = 0; nf < NF; nf++) {
+				ap_uint<PE_AF*INPUT_PRECISION_AF> input_word = 0;
+				for (unsigned int pe = 0; pe < PE_AF; pe++) {
+					ap_int<INPUT_PRECISION_AF> input = (ap_int<INPUT_PRECISION_AF>)rand();
+					IMAGE[n_image][pix][nf*PE_AF + pe] = input;
+					input_word((pe+1)*INPUT_PRECISION_AF-1, pe*INPUT_PRECISION_AF) = input;
+				}
+				input_stream.write(input_word);
+				input_stream_s.write(input_word);
+			}
+		}
+	}
+
+	Testbench_affine(input_stream, output_stream, input_stream_s, output_stream_s, param_stream, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int pix = 0; pix < IMGDIM_AF; pix++) {
+			for (unsigned int nf = 0; nf < NF; nf++) {
+				ap_uint<PE_AF*OUTPUT_PRECISION_AF> const outElem = output_stream.read();
+				ap_uint<PE_AF*OUTPUT_PRECISION_AF> const outElem_s = output_stream_s.read();
+				for (unsigned int pe = 0; pe < PE_AF; pe++) {
+					unsigned int const ch = nf*PE_AF + pe;
+					int const in = IMAGE[n_image][pix][ch];
+					int const EXP = expected(in, PARAM_AFFINE::affine.m_scale[pe][nf], PARAM_AFFINE::affine.m_bias[pe][nf]);
+					int const EXP_S = expected(in, SCALE[n_image][ch], BIAS[n_image][ch]);
+					unsigned int const out_chan = outElem((pe+1)*OUTPUT_PRECISION_AF-1, pe*OUTPUT_PRECISION_AF);
+					unsigned int const out_chan_s = outElem_s((pe+1)*OUTPUT_PRECISION_AF-1, pe*OUTPUT_PRECISION_AF);
+					if (EXP != out_chan) {
+						std::cout << "ERROR: Image " << n_image << " Pixel " << pix << " Expected[" << ch << "]=" << EXP << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+					if (EXP_S != out_chan_s) {
+						std::cout << "ERROR: Streamed, Image " << n_image << " Pixel " << pix << " Expected[" << ch << "]=" << EXP_S << " actual " << out_chan_s << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (!output_stream.empty() || !output_stream_s.empty() || !param_stream.empty()) {
+		std::cout << "ERROR: Streams not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return 0;
+}
@@ -0,0 +1,22 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_affine.h"
+#include "data/config_affine.h"
+
+void Testbench_affine(stream<ap_uint<PE_AF*INPUT_PRECISION_AF> > & in, stream<ap_uint<PE_AF*OUTPUT_PRECISION_AF> > & out,
+	stream<ap_uint<PE_AF*INPUT_PRECISION_AF> > & in_s, stream<ap_uint<PE_AF*OUTPUT_PRECISION_AF> > & out_s,
+	stream<ap_uint<PE_AF*(SCALE_PRECISION_AF+BIAS_PRECISION_AF)> > & params, unsigned int numReps){
+#pragma HLS DATAFLOW
+#pragma HLS ARRAY_PARTITION variable=PARAM_AFFINE::affine.m_scale complete dim=1
+#pragma HLS ARRAY_PARTITION variable=PARAM_AFFINE::affine.m_bias complete dim=1
+	Thresholding_Batch<IMGDIM_AF, Channels_AF, PE_AF, Slice<ap_int<INPUT_PRECISION_AF> >, Slice<ap_uint<OUTPUT_PRECISION_AF> > >
+		(in, out, PARAM_AFFINE::affine, numReps);
+	ChannelWise_Affine_Stream_Batch<IMGDIM_AF, Channels_AF, PE_AF, Slice<ap_int<INPUT_PRECISION_AF> >, Slice<ap_uint<OUTPUT_PRECISION_AF> >,
+		ap_int<SCALE_PRECISION_AF>, ap_int<BIAS_PRECISION_AF>, SHIFT_AF>
+		(in_s, out_s, params, numReps);
+}
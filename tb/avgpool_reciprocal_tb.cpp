@@ -0,0 +1,103 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file avgpool_reciprocal_tb.cpp
+ *
+ *  Testbench for the average pooling with reciprocal multiplication
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_avgpool_reciprocal.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_avgpool_reciprocal(stream<ap_uint<PE_RA*INPUT_PRECISION_RA> > & in, stream<ap_uint<PE_RA*OUTPUT_PRECISION_RA> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int NF = IFM_Channels_RA / PE_RA;
+	static int IMAGE[MAX_IMAGES][IFMDim_RA][IFMDim_RA][IFM_Channels_RA];
+	stream<ap_uint<PE_RA*INPUT_PRECISION_RA> > input_stream("input_stream");
+	stream<ap_uint<PE_RA*OUTPUT_PRECISION_RA> > output_stream("output_stream");
+	unsigned int err_counter = 0;
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int y = 0; y < IFMDim_RA; y++)
+			for (unsigned int x = 0; x < IFMDim_RA; x++)
+				for (unsigned int nf = 0; nf < NF; nf++) {
+					ap_uint<PE_RA*INPUT_PRECISION_RA> word;
+					for (unsigned int pe = 0; pe < PE_RA; pe++) {
+						ap_int<INPUT_PRECISION_RA> const val = rand();
+						IMAGE[n_image][y][x][nf*PE_RA + pe] = val;
+						word((pe+1)*INPUT_PRECISION_RA-1, pe*INPUT_PRECISION_RA) = val;
+					}
+					input_stream.write(word);
+				}
+
+	Testbench_avgpool_reciprocal(input_stream, output_stream, MAX_IMAGES);
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int oy = 0; oy < OFMDim_RA; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_RA; ox++)
+				for (unsigned int nf = 0; nf < NF; nf++) {
+					ap_uint<PE_RA*OUTPUT_PRECISION_RA> const outElem = output_stream.read();
+					for (unsigned int pe = 0; pe < PE_RA; pe++) {
+						int sum = 0;
+						for (unsigned int ky = 0; ky < KERNEL_DIM_RA; ky++)
+							for (unsigned int kx = 0; kx < KERNEL_DIM_RA; kx++)
+								sum += IMAGE[n_image][oy*STRIDE_RA + ky][ox*STRIDE_RA + kx][nf*PE_RA + pe];
+						// round to nearest, ties away from zero
+						ap_int<OUTPUT_PRECISION_RA> const exp = int(std::round(double(sum) / (KERNEL_DIM_RA*KERNEL_DIM_RA)));
+						ap_int<OUTPUT_PRECISION_RA> const avg = outElem((pe+1)*OUTPUT_PRECISION_RA-1, pe*OUTPUT_PRECISION_RA);
+						if (avg != exp) {
+							std::cout << "ERROR: Image " << n_image << " oy= " << oy << " ox= " << ox << " channel " << nf*PE_RA + pe
+								<< " Expected " << exp << " actual " << avg << std::endl;
+							err_counter++;
+						}
+					}
+				}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	return 0;
+}
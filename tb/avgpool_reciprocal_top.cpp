@@ -0,0 +1,17 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "pool.hpp"
+#include "data/config_avgpool_reciprocal.h"
+
+void Testbench_avgpool_reciprocal(stream<ap_uint<PE_RA*INPUT_PRECISION_RA> > & in, stream<ap_uint<PE_RA*OUTPUT_PRECISION_RA> > & out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	hls::stream<ap_uint<PE_RA*INPUT_PRECISION_RA> > swg_out("swg_out");
+	ConvolutionInputGenerator_dws<KERNEL_DIM_RA, IFM_Channels_RA, INPUT_PRECISION_RA, IFMDim_RA, OFMDim_RA, PE_RA, STRIDE_RA>
+		(in, swg_out, numReps, ap_resource_dflt());
+	ReciprocalAvgPoolFunction<ap_int<ACC_PRECISION_RA>, ap_int<OUTPUT_PRECISION_RA>, KERNEL_DIM_RA*KERNEL_DIM_RA> avgpool_fxn;
+	Pool_batch<IFM_Channels_RA, PE_RA, KERNEL_DIM_RA*KERNEL_DIM_RA, Slice<ap_int<INPUT_PRECISION_RA> >, Slice<ap_int<OUTPUT_PRECISION_RA> > >
+		(swg_out, out, avgpool_fxn, OFMDim_RA*OFMDim_RA*numReps);
+}
@@ -0,0 +1,155 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file bfp_tb.cpp
+ *
+ *  Testbench for the block floating-point stream format: encoding, width
+ *  conversion, decoding and an MVAU consuming the mantissas
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_bfp.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_bfp(stream<ap_uint<N_BF*W_BF> > & in, stream<ap_uint<PE_BF*SIMD_BF*WIDTH_BF> > & weights, stream<ap_uint<PE_BF*OUT_BF> > & out,
+	stream<ap_uint<N_BF*W_BF> > & in_d, stream<ap_uint<DEC_LANES_BF*W_BF> > & out_d, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int SF = MatrixW_BF / SIMD_BF;
+	constexpr unsigned int NF = MatrixH_BF / PE_BF;
+	constexpr unsigned int VECTORS = MAX_IMAGES * VECTORS_BF;
+	constexpr int MAN_HI = (1 << (M_BF-1)) - 1;
+	constexpr int MAN_LO = -(1 << (M_BF-1));
+	static int IN[VECTORS][MatrixW_BF];
+	static int DEC[VECTORS][MatrixW_BF];
+	static int W[MatrixH_BF][MatrixW_BF];
+	stream<ap_uint<N_BF*W_BF> > input_stream("input_stream");
+	stream<ap_uint<N_BF*W_BF> > input_stream_d("input_stream_d");
+	stream<ap_uint<PE_BF*SIMD_BF*WIDTH_BF> > weight_stream("weight_stream");
+	stream<ap_uint<PE_BF*OUT_BF> > output_stream("output_stream");
+	stream<ap_uint<DEC_LANES_BF*W_BF> > output_stream_d("output_stream_d");
+
+	for (unsigned int v = 0; v < VECTORS; v++) {
+		// vectors of very different magnitudes, the last one of every image all zero
+		unsigned int const shift = rand() % W_BF;
+		for (unsigned int c = 0; c < MatrixW_BF; c++)
+			IN[v][c] = v % VECTORS_BF == VECTORS_BF-1? 0 : int(ap_int<W_BF>(rand())) >> shift;
+		for (unsigned int c = 0; c < MatrixW_BF; c += N_BF) {
+			ap_uint<N_BF*W_BF> word;
+			for (unsigned int n = 0; n < N_BF; n++)
+				word((n+1)*W_BF-1, n*W_BF) = ap_int<W_BF>(IN[v][c+n]);
+			input_stream.write(word);
+			input_stream_d.write(word);
+		}
+		// reference encoding: the smallest exponent shifting all elements into the mantissa range
+		unsigned int exp = 0;
+		for (bool fits = false; !fits && exp < (1u << E_BF) - 1; ) {
+			fits = true;
+			for (unsigned int c = 0; c < MatrixW_BF; c++)
+				fits = fits && ((IN[v][c] >> exp) >= MAN_LO) && ((IN[v][c] >> exp) <= MAN_HI);
+			if (!fits)
+				exp++;
+		}
+		for (unsigned int c = 0; c < MatrixW_BF; c++) {
+			int man = exp == 0? IN[v][c] : (IN[v][c] + (1 << (exp-1))) >> exp;
+			man = man > MAN_HI? MAN_HI : man < MAN_LO? MAN_LO : man;
+			DEC[v][c] = man * (1 << exp);
+			if (std::abs(DEC[v][c] - IN[v][c]) > (1 << exp)) {
+				std::cout << "ERROR: Reference encoding of vector " << v << " off by more than a unit" << std::endl;
+				return 1;
+			}
+		}
+	}
+	for (unsigned int h = 0; h < MatrixH_BF; h++)
+		for (unsigned int c = 0; c < MatrixW_BF; c++)
+			W[h][c] = int(ap_int<WIDTH_BF>(rand()));
+	for (unsigned int v = 0; v < VECTORS; v++)
+		for (unsigned int nf = 0; nf < NF; nf++)
+			for (unsigned int sf = 0; sf < SF; sf++) {
+				ap_uint<PE_BF*SIMD_BF*WIDTH_BF> word;
+				for (unsigned int pe = 0; pe < PE_BF; pe++)
+					for (unsigned int simd = 0; simd < SIMD_BF; simd++)
+						word((pe*SIMD_BF + simd + 1)*WIDTH_BF-1, (pe*SIMD_BF + simd)*WIDTH_BF) = ap_int<WIDTH_BF>(W[nf*PE_BF + pe][sf*SIMD_BF + simd]);
+				weight_stream.write(word);
+			}
+
+	Testbench_bfp(input_stream, weight_stream, output_stream, input_stream_d, output_stream_d, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int v = 0; v < VECTORS; v++) {
+		for (unsigned int c = 0; c < MatrixW_BF; c += DEC_LANES_BF) {
+			ap_uint<DEC_LANES_BF*W_BF> const outElem = output_stream_d.read();
+			for (unsigned int n = 0; n < DEC_LANES_BF; n++) {
+				int const out_val = ap_int<W_BF>(outElem((n+1)*W_BF-1, n*W_BF));
+				int const EXP = DEC[v][c+n] > (1 << (W_BF-1)) - 1? (1 << (W_BF-1)) - 1 : DEC[v][c+n];
+				if (EXP != out_val) {
+					std::cout << "ERROR: Decoded vector " << v << " Expected[" << c+n << "]=" << EXP << " actual " << out_val << std::endl;
+					err_counter++;
+				}
+			}
+		}
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_BF*OUT_BF> const outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_BF; pe++) {
+				unsigned int const h = nf*PE_BF + pe;
+				long long EXP = 0;
+				for (unsigned int c = 0; c < MatrixW_BF; c++)
+					EXP += (long long)W[h][c] * DEC[v][c];
+				long long const out_val = ap_int<OUT_BF>(outElem((pe+1)*OUT_BF-1, pe*OUT_BF)).to_int64();
+				if (EXP != out_val) {
+					std::cout << "ERROR: MVAU vector " << v << " Expected[" << h << "]=" << EXP << " actual " << out_val << std::endl;
+					err_counter++;
+				}
+			}
+		}
+	}
+	if (!input_stream.empty() || !input_stream_d.empty() || !weight_stream.empty() || !output_stream.empty() || !output_stream_d.empty()) {
+		std::cout << "ERROR: Streams not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return 0;
+}
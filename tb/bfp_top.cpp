@@ -0,0 +1,31 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/config_bfp.h"
+
+constexpr unsigned BLOCK_WORDS_BF = MatrixW_BF / N_BF;
+
+void Testbench_bfp(stream<ap_uint<N_BF*W_BF> > & in, stream<ap_uint<PE_BF*SIMD_BF*WIDTH_BF> > & weights, stream<ap_uint<PE_BF*OUT_BF> > & out,
+	stream<ap_uint<N_BF*W_BF> > & in_d, stream<ap_uint<DEC_LANES_BF*W_BF> > & out_d, unsigned int numReps){
+#pragma HLS DATAFLOW
+	stream<ap_uint<N_BF*M_BF+E_BF> > enc("Testbench_bfp.enc");
+	stream<ap_uint<SIMD_BF*M_BF+E_BF> > mvau_in("Testbench_bfp.mvau_in");
+	stream<ap_uint<N_BF*M_BF+E_BF> > enc_d("Testbench_bfp.enc_d");
+	stream<ap_uint<DEC_LANES_BF*M_BF+E_BF> > dec_in("Testbench_bfp.dec_in");
+
+	// one block per input vector, merged into SIMD_BF lanes for the MVAU
+	BFP_Encode_Batch<N_BF, W_BF, M_BF, E_BF, BLOCK_WORDS_BF>(in, enc, numReps * VECTORS_BF);
+	StreamingDataWidthConverter_BFP_Batch<N_BF, SIMD_BF, M_BF, E_BF, VECTORS_BF * BLOCK_WORDS_BF>(enc, mvau_in, numReps);
+	Matrix_Vector_Activate_Stream_Batch<MatrixW_BF, MatrixH_BF, SIMD_BF, PE_BF, 1, BFPSlice<ap_int<M_BF>, E_BF>, Slice<ap_int<OUT_BF> >, Identity, ap_int<WIDTH_BF> >
+		(mvau_in, out, weights, BFPActivation<PassThroughActivation<ap_int<OUT_BF>>, ap_int<ACC_BF>, E_BF>(), numReps * VECTORS_BF, ap_resource_dsp());
+
+	// the same encoding split into DEC_LANES_BF lanes and decoded
+	BFP_Encode_Batch<N_BF, W_BF, M_BF, E_BF, BLOCK_WORDS_BF>(in_d, enc_d, numReps * VECTORS_BF);
+	StreamingDataWidthConverter_BFP_Batch<N_BF, DEC_LANES_BF, M_BF, E_BF, VECTORS_BF * BLOCK_WORDS_BF>(enc_d, dec_in, numReps);
+	BFP_Decode_Batch<DEC_LANES_BF, M_BF, E_BF, W_BF, VECTORS_BF * BLOCK_WORDS_BF * N_BF / DEC_LANES_BF>(dec_in, out_d, numReps);
+}
@@ -0,0 +1,123 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file binary_mvau_tb.cpp
+ *
+ *  Testbench for the matrix vector activation on binarized operands
+ *
+ *  The popcount MACs are checked against a bit-by-bit reference for a SIMD
+ *  that is not a multiple of six and for a wide SIMD, both for XNOR counts
+ *  (XnorMul) and for bipolar +1/-1 dot products (Binary).
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_binary.h"
+#include "data/config_binary.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 4
+
+void Testbench_binary_xnor_small(stream<ap_uint<SIMD_BS> > & in, stream<ap_uint<PE_BS*ACTIVATION_PRECISION_BN> > & out, unsigned int numReps);
+void Testbench_binary_xnor_large(stream<ap_uint<SIMD_BL> > & in, stream<ap_uint<PE_BL*ACTIVATION_PRECISION_BN> > & out, unsigned int numReps);
+void Testbench_binary_bipolar_small(stream<ap_uint<SIMD_BS> > & in, stream<ap_uint<PE_BS*ACTIVATION_PRECISION_BN> > & out, unsigned int numReps);
+
+template<unsigned MW, unsigned MH, unsigned SIMD, unsigned PE>
+unsigned test(void (*top)(stream<ap_uint<SIMD> > &, stream<ap_uint<PE*ACTIVATION_PRECISION_BN> > &, unsigned int), int const (&raw)[MH][MW], bool const bipolar, string const &name)
+{
+	static unsigned IMAGE[NUM_REPEAT][MW];
+	stream<ap_uint<SIMD> > input_stream("input_stream");
+	stream<ap_uint<PE*ACTIVATION_PRECISION_BN> > output_stream("output_stream");
+	unsigned const SF = MW/SIMD;
+	unsigned const NF = MH/PE;
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF; sf++) {
+			ap_uint<SIMD> word = 0;
+			for (unsigned int simd = 0; simd < SIMD; simd++) {
+				unsigned const bit = rand() & 1;
+				IMAGE[rep][sf*SIMD + simd] = bit;
+				word[simd] = bit;
+			}
+			input_stream.write(word);
+		}
+	}
+
+	top(input_stream, output_stream, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE*ACTIVATION_PRECISION_BN> const outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE; pe++) {
+				// equal bits count +1, differing ones 0 (XNOR) or -1 (bipolar)
+				int exp = 0;
+				for (unsigned int col = 0; col < MW; col++) {
+					if (unsigned(raw[nf*PE + pe][col]) == IMAGE[rep][col])  exp++;
+					else if (bipolar)  exp--;
+				}
+				ap_uint<ACTIVATION_PRECISION_BN> const bits = outElem((pe+1)*ACTIVATION_PRECISION_BN-1, pe*ACTIVATION_PRECISION_BN);
+				int const out_chan = bipolar? int(ap_int<ACTIVATION_PRECISION_BN>(bits)) : int(bits);
+				if (exp != out_chan) {
+					cout << "ERROR " << name << ": rep " << rep << " expected[" << nf*PE + pe << "]=" << exp << " actual " << out_chan << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR " << name << ": streams not empty" << endl;
+		errors++;
+	}
+	return errors;
+}
+
+int main()
+{
+	unsigned int errors = 0;
+	errors += test<MatrixW_BS, MatrixH_BS, SIMD_BS, PE_BS>(Testbench_binary_xnor_small, PARAM_BINARY::raw_bs, false, "xnor small");
+	errors += test<MatrixW_BL, MatrixH_BL, SIMD_BL, PE_BL>(Testbench_binary_xnor_large, PARAM_BINARY::raw_bl, false, "xnor large");
+	errors += test<MatrixW_BS, MatrixH_BS, SIMD_BS, PE_BS>(Testbench_binary_bipolar_small, PARAM_BINARY::raw_bs, true, "bipolar small");
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,35 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_binary.h"
+#include "data/config_binary.h"
+
+// the popcount tree works on leaves of six bits
+static_assert(SIMD_BS % 6 != 0, "The small SIMD must leave a partial leaf.");
+
+typedef ap_uint<ACTIVATION_PRECISION_BN>  count_t;
+typedef ap_int<ACTIVATION_PRECISION_BN>   sum_t;
+
+void Testbench_binary_xnor_small(stream<ap_uint<SIMD_BS> > & in, stream<ap_uint<PE_BS*ACTIVATION_PRECISION_BN> > & out, unsigned int numReps){
+#pragma HLS ARRAY_PARTITION variable=PARAM_BINARY::weights_bs.m_weights complete dim=1
+	Matrix_Vector_Activate_Batch<MatrixW_BS, MatrixH_BS, SIMD_BS, PE_BS, 1, Recast<XnorMul>, Slice<count_t>, Identity>
+		(in, out, PARAM_BINARY::weights_bs, PassThroughActivation<count_t>(), numReps, ap_resource_lut());
+}
+
+void Testbench_binary_xnor_large(stream<ap_uint<SIMD_BL> > & in, stream<ap_uint<PE_BL*ACTIVATION_PRECISION_BN> > & out, unsigned int numReps){
+#pragma HLS ARRAY_PARTITION variable=PARAM_BINARY::weights_bl.m_weights complete dim=1
+	Matrix_Vector_Activate_Batch<MatrixW_BL, MatrixH_BL, SIMD_BL, PE_BL, 1, Recast<XnorMul>, Slice<count_t>, Identity>
+		(in, out, PARAM_BINARY::weights_bl, PassThroughActivation<count_t>(), numReps, ap_resource_lut());
+}
+
+void Testbench_binary_bipolar_small(stream<ap_uint<SIMD_BS> > & in, stream<ap_uint<PE_BS*ACTIVATION_PRECISION_BN> > & out, unsigned int numReps){
+#pragma HLS ARRAY_PARTITION variable=PARAM_BINARY::weights_bs.m_weights complete dim=1
+	Matrix_Vector_Activate_Batch<MatrixW_BS, MatrixH_BS, SIMD_BS, PE_BS, 1, Recast<Binary>, Slice<sum_t>, Recast<Binary> >
+		(in, out, PARAM_BINARY::weights_bs, PassThroughActivation<sum_t>(), numReps, ap_resource_lut());
+}
@@ -0,0 +1,17 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_codebook.h"
+#include "data/config_codebook.h"
+
+void Testbench_bitserial_mvau(stream<ap_uint<SIMD_CB*INPUT_PRECISION_CB> > & in, stream<ap_uint<PE_CB*ACTIVATION_PRECISION_CB> > & out, unsigned int numReps){
+#pragma HLS ARRAY_PARTITION variable=PARAM_CODEBOOK::weights.m_codebook complete dim=0
+	Matrix_Vector_Activate_BitSerial_Batch<MatrixW_CB, MatrixH_CB, SIMD_CB, PE_CB, 1, Slice<ap_int<INPUT_PRECISION_CB> >, Slice<ap_int<ACTIVATION_PRECISION_CB> >, Identity>
+		(in, out, PARAM_CODEBOOK::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_CB>>(), numReps, ap_resource_lut());
+}
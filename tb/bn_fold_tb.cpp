@@ -0,0 +1,124 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file bn_fold_tb.cpp
+ *
+ *  Testbench for the thresholds derived from a batch normalization and
+ *  quantizer by bn_thresholds and fold_batchnorm
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_bn_fold.h"
+#include "data/config_bn_fold.h"
+using namespace hls;
+using namespace std;
+
+#define NF_BN (Channels_BN/PE_BN)
+// every input value in every channel
+#define NUM_IMAGES (1 << INPUT_PRECISION_BN)
+
+void Testbench_bn_fold(stream<ap_uint<PE_BN*INPUT_PRECISION_BN> > & in, stream<ap_uint<PE_BN*OUTPUT_PRECISION_BN> > & out, unsigned int numReps);
+
+int main()
+{
+	typedef ThresholdsActivation<NF_BN, PE_BN, NumTH_BN, ap_int<INPUT_PRECISION_BN>, ap_uint<OUTPUT_PRECISION_BN> > act_t;
+	stream<ap_uint<PE_BN*INPUT_PRECISION_BN> > input_stream("input_stream");
+	stream<ap_uint<PE_BN*OUTPUT_PRECISION_BN> > output_stream("output_stream");
+	unsigned int errors = 0;
+
+	// the thresholds filled at runtime must match the constant ones
+	act_t const folded = bn_thresholds<act_t, PARAM_BN_FOLD::bn>();
+	act_t filled;
+	fold_batchnorm(filled.m_thresholds, PARAM_BN_FOLD::SCALE, PARAM_BN_FOLD::BIAS, PARAM_BN_FOLD::bn::step());
+	for (unsigned int pe = 0; pe < PE_BN; pe++) {
+		for (unsigned int nf = 0; nf < NF_BN; nf++) {
+			for (unsigned int t = 0; t < NumTH_BN; t++) {
+				if (folded.m_thresholds[pe][nf][t] != filled.m_thresholds[pe][nf][t]) {
+					cout << "ERROR: threshold " << t << " of channel " << nf*PE_BN + pe << " constant " << folded.m_thresholds[pe][nf][t] << " filled " << filled.m_thresholds[pe][nf][t] << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	ap_int<INPUT_PRECISION_BN> IMAGE[NUM_IMAGES][Channels_BN];
+	for (unsigned int n_image = 0; n_image < NUM_IMAGES; n_image++) {
+		for (unsigned int nf = 0; nf < NF_BN; nf++) {
+			ap_uint<PE_BN*INPUT_PRECISION_BN> input_word = 0;
+			for (unsigned int pe = 0; pe < PE_BN; pe++) {
+				unsigned int const ch = nf*PE_BN + pe;
+				ap_int<INPUT_PRECISION_BN> const input = n_image + 37*ch;
+				IMAGE[n_image][ch] = input;
+				input_word((pe+1)*INPUT_PRECISION_BN-1, pe*INPUT_PRECISION_BN) = input;
+			}
+			input_stream.write(input_word);
+		}
+	}
+
+	Testbench_bn_fold(input_stream, output_stream, NUM_IMAGES);
+
+	for (unsigned int n_image = 0; n_image < NUM_IMAGES; n_image++) {
+		for (unsigned int nf = 0; nf < NF_BN; nf++) {
+			ap_uint<PE_BN*OUTPUT_PRECISION_BN> const outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_BN; pe++) {
+				unsigned int const ch = nf*PE_BN + pe;
+				// batch normalization and quantization rounding half up
+				double const y = PARAM_BN_FOLD::SCALE[ch] * int(IMAGE[n_image][ch]) + PARAM_BN_FOLD::BIAS[ch];
+				double const q = floor(y / PARAM_BN_FOLD::bn::step() + 0.5);
+				unsigned int const EXP = q < 0? 0 : q > NumTH_BN? NumTH_BN : unsigned(q);
+				ap_uint<OUTPUT_PRECISION_BN> const out_chan = outElem((pe+1)*OUTPUT_PRECISION_BN-1, pe*OUTPUT_PRECISION_BN);
+				if (EXP != out_chan) {
+					cout << "ERROR: input " << IMAGE[n_image][ch] << " of channel " << ch << " expected " << EXP << " actual " << out_chan << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
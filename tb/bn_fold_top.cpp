@@ -0,0 +1,19 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_bn_fold.h"
+#include "data/config_bn_fold.h"
+
+static ThresholdsActivation<Channels_BN/PE_BN, PE_BN, NumTH_BN, ap_int<INPUT_PRECISION_BN>, ap_uint<OUTPUT_PRECISION_BN> > const threshs_bn =
+	bn_thresholds<ThresholdsActivation<Channels_BN/PE_BN, PE_BN, NumTH_BN, ap_int<INPUT_PRECISION_BN>, ap_uint<OUTPUT_PRECISION_BN> >, PARAM_BN_FOLD::bn>();
+
+void Testbench_bn_fold(stream<ap_uint<PE_BN*INPUT_PRECISION_BN> > & in, stream<ap_uint<PE_BN*OUTPUT_PRECISION_BN> > & out, unsigned int numReps){
+#pragma HLS ARRAY_PARTITION variable=threshs_bn.m_thresholds complete dim=1
+#pragma HLS ARRAY_PARTITION variable=threshs_bn.m_thresholds complete dim=3
+	Thresholding_Batch<1, Channels_BN, PE_BN, Slice<ap_int<INPUT_PRECISION_BN> >, Slice<ap_uint<OUTPUT_PRECISION_BN> > >
+		(in, out, threshs_bn, numReps);
+}
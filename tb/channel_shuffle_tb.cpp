@@ -0,0 +1,135 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file channel_shuffle_tb.cpp
+ *
+ *  Testbench for the channel shuffle, channel split and generic channel
+ *  permutation blocks
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_channel_shuffle.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+#define PIXELS_CS (MAX_IMAGES*NUM_PIXELS_CS)
+void Testbench_channel_shuffle(stream<ap_uint<PE_CS*WIDTH_CS> > & in_shuffle, stream<ap_uint<PE_CS*WIDTH_CS> > & out_shuffle,
+	stream<ap_uint<PE_SPLIT_CS*WIDTH_CS> > & in_split, stream<ap_uint<CH0_SPLIT_CS*WIDTH0_SPLIT_CS> > & out_split0,
+	stream<ap_uint<CH1_SPLIT_CS*WIDTH1_SPLIT_CS> > & out_split1, stream<ap_uint<PE_REV_CS*WIDTH_CS> > & in_rev,
+	stream<ap_uint<PE_REV_CS*WIDTH_CS> > & out_rev, unsigned int numReps);
+
+// writes a pixel folded into words of PE channels
+template<unsigned int PE>
+void write_pixel(stream<ap_uint<PE*WIDTH_CS> > & in, ap_uint<WIDTH_CS> const *pixel) {
+	for (unsigned int w = 0; w < CHANNELS_CS/PE; w++) {
+		ap_uint<PE*WIDTH_CS> word;
+		for (unsigned int pe = 0; pe < PE; pe++)
+			word((pe+1)*WIDTH_CS-1, pe*WIDTH_CS) = pixel[w*PE + pe];
+		in.write(word);
+	}
+}
+
+// checks a pixel folded into words of PE channels, channel o being expected from channel source(o)
+template<unsigned int PE, typename F>
+unsigned int check_pixel(stream<ap_uint<PE*WIDTH_CS> > & out, ap_uint<WIDTH_CS> const *pixel, F source, char const *name) {
+	unsigned int errors = 0;
+	for (unsigned int w = 0; w < CHANNELS_CS/PE; w++) {
+		ap_uint<PE*WIDTH_CS> const word = out.read();
+		for (unsigned int pe = 0; pe < PE; pe++) {
+			unsigned int const o = w*PE + pe;
+			ap_uint<WIDTH_CS> const value = word((pe+1)*WIDTH_CS-1, pe*WIDTH_CS);
+			if (value != pixel[source(o)]) {
+				cout << "ERROR " << name << ": channel " << o << " expected " << pixel[source(o)] << " value " << value << endl;
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+int main()
+{
+	stream<ap_uint<PE_CS*WIDTH_CS> > in_shuffle("in_shuffle"), out_shuffle("out_shuffle");
+	stream<ap_uint<PE_SPLIT_CS*WIDTH_CS> > in_split("in_split");
+	stream<ap_uint<CH0_SPLIT_CS*WIDTH0_SPLIT_CS> > out_split0("out_split0");
+	stream<ap_uint<CH1_SPLIT_CS*WIDTH1_SPLIT_CS> > out_split1("out_split1");
+	stream<ap_uint<PE_REV_CS*WIDTH_CS> > in_rev("in_rev"), out_rev("out_rev");
+	static ap_uint<WIDTH_CS> pixels[PIXELS_CS][CHANNELS_CS];
+	unsigned int errors = 0;
+
+	for (unsigned int p = 0; p < PIXELS_CS; p++) {
+		for (unsigned int c = 0; c < CHANNELS_CS; c++)
+			pixels[p][c] = rand();
+		write_pixel<PE_CS>(in_shuffle, pixels[p]);
+		write_pixel<PE_SPLIT_CS>(in_split, pixels[p]);
+		write_pixel<PE_REV_CS>(in_rev, pixels[p]);
+	}
+
+	Testbench_channel_shuffle(in_shuffle, out_shuffle, in_split, out_split0, out_split1, in_rev, out_rev, MAX_IMAGES);
+
+	for (unsigned int p = 0; p < PIXELS_CS; p++) {
+		errors += check_pixel<PE_CS>(out_shuffle, pixels[p], [](unsigned int o) {
+			return (o % GROUPS_CS) * (CHANNELS_CS / GROUPS_CS) + o / GROUPS_CS; }, "shuffle");
+		errors += check_pixel<PE_REV_CS>(out_rev, pixels[p], [](unsigned int o) {
+			return CHANNELS_CS - 1 - o; }, "reverse");
+		ap_uint<CH0_SPLIT_CS*WIDTH0_SPLIT_CS> const split0 = out_split0.read();
+		ap_uint<CH1_SPLIT_CS*WIDTH1_SPLIT_CS> const split1 = out_split1.read();
+		for (unsigned int c = 0; c < CHANNELS_CS; c++) {
+			unsigned int const value = c < CH0_SPLIT_CS?
+				unsigned(split0((c+1)*WIDTH0_SPLIT_CS-1, c*WIDTH0_SPLIT_CS)) :
+				unsigned(split1((c-CH0_SPLIT_CS+1)*WIDTH1_SPLIT_CS-1, (c-CH0_SPLIT_CS)*WIDTH1_SPLIT_CS));
+			// the first output truncates to its narrower elements
+			unsigned int const exp = c < CH0_SPLIT_CS? unsigned(pixels[p][c]) % (1u << WIDTH0_SPLIT_CS) : unsigned(pixels[p][c]);
+			if (value != exp) {
+				cout << "ERROR split: pixel " << p << " channel " << c << " expected " << exp << " value " << value << endl;
+				errors++;
+			}
+		}
+	}
+
+	if (!in_shuffle.empty() || !out_shuffle.empty() || !in_split.empty() || !out_split0.empty() ||
+	    !out_split1.empty() || !in_rev.empty() || !out_rev.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
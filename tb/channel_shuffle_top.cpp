@@ -0,0 +1,25 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_channel_shuffle.h"
+
+// reverses the channel order of a pixel
+struct ReversePermutation {
+	static constexpr unsigned int source(unsigned int const o) {
+		return CHANNELS_CS - 1 - o;
+	}
+};
+
+void Testbench_channel_shuffle(stream<ap_uint<PE_CS*WIDTH_CS> > & in_shuffle, stream<ap_uint<PE_CS*WIDTH_CS> > & out_shuffle,
+	stream<ap_uint<PE_SPLIT_CS*WIDTH_CS> > & in_split, stream<ap_uint<CH0_SPLIT_CS*WIDTH0_SPLIT_CS> > & out_split0,
+	stream<ap_uint<CH1_SPLIT_CS*WIDTH1_SPLIT_CS> > & out_split1, stream<ap_uint<PE_REV_CS*WIDTH_CS> > & in_rev,
+	stream<ap_uint<PE_REV_CS*WIDTH_CS> > & out_rev, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	ChannelShuffle_Batch<CHANNELS_CS, GROUPS_CS, PE_CS, ap_uint<WIDTH_CS>, NUM_PIXELS_CS>(in_shuffle, out_shuffle, numReps);
+	ChannelSplit_Batch<NUM_PIXELS_CS, PE_SPLIT_CS, ap_uint<WIDTH_CS>,
+		ConcatPort<CH0_SPLIT_CS, ap_uint<WIDTH0_SPLIT_CS>>, ConcatPort<CH1_SPLIT_CS, ap_uint<WIDTH1_SPLIT_CS>>>
+		(in_split, out_split0, out_split1, numReps);
+	ChannelPermute_Batch<CHANNELS_CS, PE_REV_CS, ap_uint<WIDTH_CS>, NUM_PIXELS_CS, ReversePermutation>(in_rev, out_rev, numReps);
+}
@@ -0,0 +1,119 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file codebook_mvau_tb.cpp
+ *
+ *  Testbench for the matrix vector activation with codebook weights
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_codebook.h"
+#include "data/config_codebook.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 8
+#define SF_CB (MatrixW_CB/SIMD_CB)
+#define NF_CB (MatrixH_CB/PE_CB)
+
+void Testbench_codebook_mvau(stream<ap_uint<SIMD_CB*INPUT_PRECISION_CB> > & in, stream<ap_uint<PE_CB*ACTIVATION_PRECISION_CB> > & out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<INPUT_PRECISION_CB> IMAGE[NUM_REPEAT][MatrixW_CB];
+	stream<ap_uint<SIMD_CB*INPUT_PRECISION_CB> > input_stream("input_stream");
+	stream<ap_uint<PE_CB*ACTIVATION_PRECISION_CB> > output_stream("output_stream");
+	unsigned int errors = 0;
+
+	// the decoded weights must be those of the generator
+	for (unsigned int nf = 0; nf < NF_CB; nf++) {
+		for (unsigned int sf = 0; sf < SF_CB; sf++) {
+			for (unsigned int pe = 0; pe < PE_CB; pe++) {
+				auto const w = PARAM_CODEBOOK::weights.weights(nf*SF_CB + sf)[pe];
+				for (unsigned int simd = 0; simd < SIMD_CB; simd++) {
+					if (w[simd] != PARAM_CODEBOOK::raw[nf*PE_CB + pe][sf*SIMD_CB + simd]) {
+						cout << "ERROR decode: row " << nf*PE_CB + pe << " column " << sf*SIMD_CB + simd << " expected " << PARAM_CODEBOOK::raw[nf*PE_CB + pe][sf*SIMD_CB + simd] << " decoded " << w[simd] << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_CB; sf++) {
+			ap_uint<SIMD_CB*INPUT_PRECISION_CB> word;
+			for (unsigned int simd = 0; simd < SIMD_CB; simd++) {
+				ap_uint<INPUT_PRECISION_CB> const act = rand();
+				IMAGE[rep][sf*SIMD_CB + simd] = act;
+				word((simd+1)*INPUT_PRECISION_CB-1, simd*INPUT_PRECISION_CB) = act;
+			}
+			input_stream.write(word);
+		}
+	}
+
+	Testbench_codebook_mvau(input_stream, output_stream, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF_CB; nf++) {
+			ap_uint<PE_CB*ACTIVATION_PRECISION_CB> const outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_CB; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_CB; col++)
+					exp += PARAM_CODEBOOK::raw[nf*PE_CB + pe][col] * IMAGE[rep][col];
+				ap_int<ACTIVATION_PRECISION_CB> const EXP = exp;
+				ap_int<ACTIVATION_PRECISION_CB> out_chan;
+				out_chan(ACTIVATION_PRECISION_CB-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_CB-1, pe*ACTIVATION_PRECISION_CB);
+				if (EXP != out_chan) {
+					cout << "ERROR: rep " << rep << " expected[" << nf*PE_CB + pe << "]=" << EXP << " actual " << out_chan << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
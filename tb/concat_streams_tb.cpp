@@ -0,0 +1,111 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file concat_streams_tb.cpp
+ *
+ *  Testbench for the channel concatenation of streams with different
+ *  channel counts and precisions
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_concat_streams.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+#define TOTAL_CH_CC (CH0_CC + CH1_CC + CH2_CC)
+void Testbench_concat_streams(stream<ap_uint<CH0_CC*WIDTH0_CC> > & in0, stream<ap_uint<CH1_CC*WIDTH1_CC> > & in1,
+	stream<ap_uint<CH2_CC*WIDTH2_CC> > & in2, stream<ap_uint<PE_CC*OUT_WIDTH_CC> > & out, unsigned int numReps);
+
+int main()
+{
+	stream<ap_uint<CH0_CC*WIDTH0_CC> > input_stream0("input_stream0");
+	stream<ap_uint<CH1_CC*WIDTH1_CC> > input_stream1("input_stream1");
+	stream<ap_uint<CH2_CC*WIDTH2_CC> > input_stream2("input_stream2");
+	stream<ap_uint<PE_CC*OUT_WIDTH_CC> > output_stream("output_stream");
+	vector<int> expected;
+	unsigned int errors = 0;
+
+	for (unsigned int p = 0; p < MAX_IMAGES*NUM_PIXELS_CC; p++) {
+		ap_uint<CH0_CC*WIDTH0_CC> w0;
+		ap_uint<CH1_CC*WIDTH1_CC> w1;
+		ap_uint<CH2_CC*WIDTH2_CC> w2;
+		for (unsigned int c = 0; c < CH0_CC; c++) {
+			ap_uint<WIDTH0_CC> const v = rand();
+			w0((c+1)*WIDTH0_CC-1, c*WIDTH0_CC) = v;
+			expected.push_back(v.to_int());
+		}
+		for (unsigned int c = 0; c < CH1_CC; c++) {
+			ap_int<WIDTH1_CC> const v = rand();
+			w1((c+1)*WIDTH1_CC-1, c*WIDTH1_CC) = v;
+			expected.push_back(v.to_int());
+		}
+		for (unsigned int c = 0; c < CH2_CC; c++) {
+			ap_uint<WIDTH2_CC> const v = rand();
+			w2((c+1)*WIDTH2_CC-1, c*WIDTH2_CC) = v;
+			expected.push_back(v.to_int());
+		}
+		input_stream0.write(w0);
+		input_stream1.write(w1);
+		input_stream2.write(w2);
+	}
+
+	Testbench_concat_streams(input_stream0, input_stream1, input_stream2, output_stream, MAX_IMAGES);
+
+	for (unsigned int w = 0; w < MAX_IMAGES*NUM_PIXELS_CC*TOTAL_CH_CC/PE_CC; w++) {
+		ap_uint<PE_CC*OUT_WIDTH_CC> const value = output_stream.read();
+		for (unsigned int pe = 0; pe < PE_CC; pe++) {
+			ap_int<OUT_WIDTH_CC> const elem = value((pe+1)*OUT_WIDTH_CC-1, pe*OUT_WIDTH_CC);
+			int const exp = expected[w*PE_CC + pe];
+			if (elem.to_int() != exp) {
+				cout << "ERROR word " << w << " channel " << pe << " expected " << exp << " value " << elem.to_int() << endl;
+				errors++;
+			}
+		}
+	}
+
+	if (!input_stream0.empty() || !input_stream1.empty() || !input_stream2.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
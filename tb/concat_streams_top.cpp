@@ -0,0 +1,14 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_concat_streams.h"
+
+void Testbench_concat_streams(stream<ap_uint<CH0_CC*WIDTH0_CC> > & in0, stream<ap_uint<CH1_CC*WIDTH1_CC> > & in1,
+	stream<ap_uint<CH2_CC*WIDTH2_CC> > & in2, stream<ap_uint<PE_CC*OUT_WIDTH_CC> > & out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	ConcatStreams_Batch<NUM_PIXELS_CC, PE_CC, ap_int<OUT_WIDTH_CC>,
+		ConcatPort<CH0_CC, ap_uint<WIDTH0_CC>>, ConcatPort<CH1_CC, ap_int<WIDTH1_CC>>, ConcatPort<CH2_CC, ap_uint<WIDTH2_CC>>>
+		(in0, in1, in2, out, numReps);
+}
@@ -41,6 +41,12 @@
 #ifndef CONV_TB_H
 #define CONV_TB_H
 
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "ap_int.h"
+
 template<int MAX_IMAGE,
 	int IFMDim, 
 	int OFMDim, 
@@ -170,4 +176,249 @@ template<int MAX_IMAGE,
 					}
 	}
 
+/*
+ * Optimized reference path
+ *
+ * The *_fast variants below take the same arguments as the references above and
+ * produce bit-exact results for integer types (ap_int, ap_uint and the native
+ * integers): the operands are copied once into native integers laid out so that
+ * every tap of a window is a contiguous run, which the compiler vectorizes. The
+ * accumulator is int32_t if the sum of the operand widths and the number of taps
+ * fits, int64_t otherwise; as the ap_int accumulation of the references wraps
+ * modulo the output width, narrowing the exact sum to TO at the end gives the
+ * same value. The output channels are distributed over threads when compiled
+ * with -fopenmp: every thread reads the weights of its own channel only and
+ * writes a channel-major result, which is narrowed into out afterwards.
+ */
+namespace detail {
+	template<typename T, typename = void>
+	struct conv_width { static constexpr int  value = 0; };
+	template<typename T>
+	struct conv_width<T, typename std::enable_if<std::is_integral<T>::value>::type> { static constexpr int  value = 8*sizeof(T); };
+	template<int W>
+	struct conv_width<ap_int<W>> { static constexpr int  value = W; };
+	template<int W>
+	struct conv_width<ap_uint<W>> { static constexpr int  value = W+1; };
+
+	template<int W>
+	std::int64_t conv_native(ap_int<W> const &v) { return  v.to_int64(); }
+	template<int W>
+	std::int64_t conv_native(ap_uint<W> const &v) { return  v.to_uint64(); }
+	template<typename T>
+	std::int64_t conv_native(T const  v) { return  v; }
+
+	constexpr int conv_bits(unsigned long const  n) { return  n < 2? 0 : 1 + conv_bits((n+1)/2); }
+
+	/** Native accumulator for the signed products of TI and TW summed over Taps terms */
+	template<typename TI, typename TW, unsigned long Taps>
+	struct conv_acc {
+		static_assert(conv_width<TI>::value > 0 && conv_width<TW>::value > 0, "The fast reference requires integer input and weight types");
+		static constexpr int  bits = conv_width<TI>::value + conv_width<TW>::value + conv_bits(Taps);
+		static_assert(bits <= 64, "The fast reference accumulator would overflow 64 bits");
+		using type = typename std::conditional<bits <= 32, std::int32_t, std::int64_t>::type;
+	};
+}
+
+template<int MAX_IMAGE,
+	int IFMDim,
+	int OFMDim,
+	int IFMCh,
+	int OFMCh,
+	int kernel,
+	int stride,
+	typename TI,
+	typename TO,
+	typename TW>
+	void conv_fast(TI const img[MAX_IMAGE][IFMDim*IFMDim][IFMCh], TW const weights[OFMCh][kernel][kernel][IFMCh], TO out[MAX_IMAGE][OFMDim][OFMDim][OFMCh]){
+		using acc_t = typename detail::conv_acc<TI, TW, (unsigned long)kernel*kernel*IFMCh>::type;
+		constexpr int taps = kernel*kernel*IFMCh;
+		std::vector<acc_t> in((std::size_t)MAX_IMAGE*IFMDim*IFMDim*IFMCh), w((std::size_t)OFMCh*taps);
+		for(int n=0;n<MAX_IMAGE;n++)
+			for(int p=0;p<IFMDim*IFMDim;p++)
+				for(int c=0;c<IFMCh;c++)
+					in[((std::size_t)n*IFMDim*IFMDim+p)*IFMCh+c] = detail::conv_native(img[n][p][c]);
+		for(int h=0;h<OFMCh;h++)
+			for(int kx=0;kx<kernel;kx++)
+				for(int ky=0;ky<kernel;ky++)
+					for(int c=0;c<IFMCh;c++)
+						w[(std::size_t)h*taps+(kx*kernel+ky)*IFMCh+c] = detail::conv_native(weights[h][kx][ky][c]);
+		constexpr std::size_t pixels = (std::size_t)MAX_IMAGE*OFMDim*OFMDim;
+		std::vector<acc_t> res(OFMCh*pixels);
+#pragma omp parallel for
+		for(int h=0;h<OFMCh;h++){
+			acc_t const *const wh = &w[(std::size_t)h*taps];
+			acc_t *dst = &res[h*pixels];
+			for(int n=0;n<MAX_IMAGE;n++)
+				for(int x=0;x<OFMDim;x++)
+					for(int y=0;y<OFMDim;y++){
+						acc_t tmp = 0;
+						for(int kx=0;kx<kernel;kx++)
+							for(int ky=0;ky<kernel;ky++){
+								acc_t const *const src = &in[((std::size_t)n*IFMDim*IFMDim+(y*stride+ky)*IFMDim+x*stride+kx)*IFMCh];
+								acc_t const *const wk = &wh[(kx*kernel+ky)*IFMCh];
+								for(int c=0;c<IFMCh;c++)
+									tmp += src[c] * wk[c];
+							}
+						*dst++ = tmp;
+					}
+		}
+		for(int h=0;h<OFMCh;h++)
+			for(int n=0;n<MAX_IMAGE;n++)
+				for(int x=0;x<OFMDim;x++)
+					for(int y=0;y<OFMDim;y++)
+						out[n][x][y][h] = res[((h*MAX_IMAGE+n)*(std::size_t)OFMDim+x)*OFMDim+y];
+	}
+
+template<int MAX_IMAGE,
+	int IFMDim_x,
+	int IFMDim_y,
+	int OFMDim_x,
+	int OFMDim_y,
+	int IFMCh,
+	int OFMCh,
+	int kernel_x,
+	int kernel_y,
+	int stride_x,
+	int stride_y,
+	typename TI,
+	typename TO,
+	typename TW>
+	void conv_nonsquare_fast(TI const img[MAX_IMAGE][IFMDim_x][IFMDim_y][IFMCh], TW const weights[OFMCh][kernel_x][kernel_y][IFMCh], TO out[MAX_IMAGE][OFMDim_x][OFMDim_y][OFMCh]){
+		using acc_t = typename detail::conv_acc<TI, TW, (unsigned long)kernel_x*kernel_y*IFMCh>::type;
+		constexpr int taps = kernel_x*kernel_y*IFMCh;
+		std::vector<acc_t> in((std::size_t)MAX_IMAGE*IFMDim_x*IFMDim_y*IFMCh), w((std::size_t)OFMCh*taps);
+		for(int n=0;n<MAX_IMAGE;n++)
+			for(int ix=0;ix<IFMDim_x;ix++)
+				for(int iy=0;iy<IFMDim_y;iy++)
+					for(int c=0;c<IFMCh;c++)
+						in[(((std::size_t)n*IFMDim_x+ix)*IFMDim_y+iy)*IFMCh+c] = detail::conv_native(img[n][ix][iy][c]);
+		for(int h=0;h<OFMCh;h++)
+			for(int kx=0;kx<kernel_x;kx++)
+				for(int ky=0;ky<kernel_y;ky++)
+					for(int c=0;c<IFMCh;c++)
+						w[(std::size_t)h*taps+(kx*kernel_y+ky)*IFMCh+c] = detail::conv_native(weights[h][kx][ky][c]);
+		constexpr std::size_t pixels = (std::size_t)MAX_IMAGE*OFMDim_x*OFMDim_y;
+		std::vector<acc_t> res(OFMCh*pixels);
+#pragma omp parallel for
+		for(int h=0;h<OFMCh;h++){
+			acc_t const *const wh = &w[(std::size_t)h*taps];
+			acc_t *dst = &res[h*pixels];
+			for(int n=0;n<MAX_IMAGE;n++)
+				for(int x=0;x<OFMDim_x;x++)
+					for(int y=0;y<OFMDim_y;y++){
+						acc_t tmp = 0;
+						for(int kx=0;kx<kernel_x;kx++){
+							// the kernel_y rows of one column are contiguous in the image
+							acc_t const *const src = &in[(((std::size_t)n*IFMDim_x+x*stride_x+kx)*IFMDim_y+y*stride_y)*IFMCh];
+							acc_t const *const wk = &wh[kx*kernel_y*IFMCh];
+							for(int t=0;t<kernel_y*IFMCh;t++)
+								tmp += src[t] * wk[t];
+						}
+						*dst++ = tmp;
+					}
+		}
+		for(int h=0;h<OFMCh;h++)
+			for(int n=0;n<MAX_IMAGE;n++)
+				for(int x=0;x<OFMDim_x;x++)
+					for(int y=0;y<OFMDim_y;y++)
+						out[n][x][y][h] = res[((h*MAX_IMAGE+n)*(std::size_t)OFMDim_x+x)*OFMDim_y+y];
+	}
+
+template<int MAX_IMAGE,
+	int IFMDim,
+	int OFMDim,
+	int FMCh,
+	int kernel,
+	int stride,
+	typename TI,
+	typename TO,
+	typename TW>
+	void dwsconv_fast(TI const img[MAX_IMAGE][IFMDim][IFMDim][FMCh], TW const weights[FMCh][kernel][kernel], TO out[MAX_IMAGE][OFMDim][OFMDim][FMCh]){
+		using acc_t = typename detail::conv_acc<TI, TW, (unsigned long)kernel*kernel>::type;
+		std::vector<acc_t> in((std::size_t)MAX_IMAGE*IFMDim*IFMDim*FMCh), w((std::size_t)kernel*kernel*FMCh);
+		for(int n=0;n<MAX_IMAGE;n++)
+			for(int i=0;i<IFMDim;i++)
+				for(int j=0;j<IFMDim;j++)
+					for(int h=0;h<FMCh;h++)
+						in[(((std::size_t)h*MAX_IMAGE+n)*IFMDim+i)*IFMDim+j] = detail::conv_native(img[n][i][j][h]);
+		// channels outermost, so that every thread works on one contiguous plane
+		for(int h=0;h<FMCh;h++)
+			for(int kx=0;kx<kernel;kx++)
+				for(int ky=0;ky<kernel;ky++)
+					w[(h*kernel+kx)*kernel+ky] = detail::conv_native(weights[h][kx][ky]);
+		constexpr std::size_t pixels = (std::size_t)MAX_IMAGE*OFMDim*OFMDim;
+		std::vector<acc_t> res(FMCh*pixels);
+#pragma omp parallel for
+		for(int h=0;h<FMCh;h++){
+			acc_t const *const wh = &w[(std::size_t)h*kernel*kernel];
+			acc_t *dst = &res[h*pixels];
+			for(int n=0;n<MAX_IMAGE;n++){
+				acc_t const *const plane = &in[((std::size_t)h*MAX_IMAGE+n)*IFMDim*IFMDim];
+				for(int x=0;x<OFMDim;x++)
+					for(int y=0;y<OFMDim;y++){
+						acc_t tmp = 0;
+						for (int kx=0;kx<kernel;kx++)
+							for (int ky=0;ky<kernel;ky++)
+								tmp += plane[(y+kx)*IFMDim+x+ky] * wh[kx*kernel+ky];
+						*dst++ = tmp;
+					}
+			}
+		}
+		for(int h=0;h<FMCh;h++)
+			for(int n=0;n<MAX_IMAGE;n++)
+				for(int x=0;x<OFMDim;x++)
+					for(int y=0;y<OFMDim;y++)
+						out[n][x][y][h] = res[((h*MAX_IMAGE+n)*(std::size_t)OFMDim+x)*OFMDim+y];
+	}
+
+template<int MAX_IMAGE,
+	int IFMDim_x,
+	int IFMDim_y,
+	int OFMDim_x,
+	int OFMDim_y,
+	int FMCh,
+	int kernel_x,
+	int kernel_y,
+	int stride_x,
+	int stride_y,
+	typename TI,
+	typename TO,
+	typename TW>
+	void dwsconv_nonsquare_fast(TI const img[MAX_IMAGE][IFMDim_x][IFMDim_y][FMCh], TW const weights[FMCh][kernel_x][kernel_y], TO out[MAX_IMAGE][OFMDim_x][OFMDim_y][FMCh]){
+		using acc_t = typename detail::conv_acc<TI, TW, (unsigned long)kernel_x*kernel_y>::type;
+		std::vector<acc_t> in((std::size_t)MAX_IMAGE*IFMDim_x*IFMDim_y*FMCh), w((std::size_t)kernel_x*kernel_y*FMCh);
+		for(int n=0;n<MAX_IMAGE;n++)
+			for(int ix=0;ix<IFMDim_x;ix++)
+				for(int iy=0;iy<IFMDim_y;iy++)
+					for(int h=0;h<FMCh;h++)
+						in[(((std::size_t)h*MAX_IMAGE+n)*IFMDim_x+ix)*IFMDim_y+iy] = detail::conv_native(img[n][ix][iy][h]);
+		for(int h=0;h<FMCh;h++)
+			for(int kx=0;kx<kernel_x;kx++)
+				for(int ky=0;ky<kernel_y;ky++)
+					w[(h*kernel_x+kx)*kernel_y+ky] = detail::conv_native(weights[h][kx][ky]);
+		constexpr std::size_t pixels = (std::size_t)MAX_IMAGE*OFMDim_x*OFMDim_y;
+		std::vector<acc_t> res(FMCh*pixels);
+#pragma omp parallel for
+		for(int h=0;h<FMCh;h++){
+			acc_t const *const wh = &w[(std::size_t)h*kernel_x*kernel_y];
+			acc_t *dst = &res[h*pixels];
+			for(int n=0;n<MAX_IMAGE;n++){
+				acc_t const *const plane = &in[((std::size_t)h*MAX_IMAGE+n)*IFMDim_x*IFMDim_y];
+				for(int x=0;x<OFMDim_x;x++)
+					for(int y=0;y<OFMDim_y;y++){
+						acc_t tmp = 0;
+						for (int kx=0;kx<kernel_x;kx++)
+							for (int ky=0;ky<kernel_y;ky++)
+								tmp += plane[(x*stride_x+kx)*IFMDim_y+y*stride_y+ky] * wh[kx*kernel_y+ky];
+						*dst++ = tmp;
+					}
+			}
+		}
+		for(int h=0;h<FMCh;h++)
+			for(int n=0;n<MAX_IMAGE;n++)
+				for(int x=0;x<OFMDim_x;x++)
+					for(int y=0;y<OFMDim_y;y++)
+						out[n][x][y][h] = res[((h*MAX_IMAGE+n)*(std::size_t)OFMDim_x+x)*OFMDim_y+y];
+	}
+
 #endif
@@ -67,6 +67,9 @@ int main()
 	//create_memdata();
 	static	ap_uint<INPUT_PRECISION> IMAGE[MAX_IMAGES][IFMDim1*IFMDim1][IFM_Channels1];
 	static	ap_int<ACTIVATION_PRECISION> TEST[MAX_IMAGES][OFMDim1][OFMDim1][OFM_Channels1];
+#ifdef FINN_TB_REF_CHECK
+	static	ap_int<ACTIVATION_PRECISION> TEST_REF[MAX_IMAGES][OFMDim1][OFMDim1][OFM_Channels1];
+#endif
 	stream<ap_uint<IFM_Channels1*INPUT_PRECISION> > input_stream("input_stream");
 	stream<ap_uint<OFM_Channels1*ACTIVATION_PRECISION> > output_stream("output_stream");
 	unsigned int counter = 0;
@@ -122,7 +125,19 @@ int main()
 			}
 		}
 	}
-	conv<MAX_IMAGES,IFMDim1,OFMDim1,IFM_Channels1,OFM_Channels1, KERNEL_DIM, 1, ap_uint<INPUT_PRECISION> >(IMAGE, W1, TEST);
+	conv_fast<MAX_IMAGES,IFMDim1,OFMDim1,IFM_Channels1,OFM_Channels1, KERNEL_DIM, 1, ap_uint<INPUT_PRECISION> >(IMAGE, W1, TEST);
+#ifdef FINN_TB_REF_CHECK
+	// the fast golden model must reproduce the reference one
+	conv<MAX_IMAGES,IFMDim1,OFMDim1,IFM_Channels1,OFM_Channels1, KERNEL_DIM, 1, ap_uint<INPUT_PRECISION> >(IMAGE, W1, TEST_REF);
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int ox = 0; ox < OFMDim1; ox++)
+			for (unsigned int oy = 0; oy < OFMDim1; oy++)
+				for (unsigned int channel = 0; channel < OFM_Channels1; channel++)
+					if (TEST[n_image][ox][oy][channel] != TEST_REF[n_image][ox][oy][channel]) {
+						cout << "ERROR: fast reference differs at image " << n_image << " (" << ox << ", " << oy << ", " << channel << "): " << TEST[n_image][ox][oy][channel] << " vs " << TEST_REF[n_image][ox][oy][channel] << endl;
+						return 1;
+					}
+#endif
 	Testbench_conv(input_stream, output_stream, MAX_IMAGES);
 	int err_counter = 0, err_perimage=0;
 	ap_int<ACTIVATION_PRECISION> out_chan;
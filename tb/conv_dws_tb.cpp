@@ -67,6 +67,9 @@ int main()
 	ap_uint<INPUT_PRECISION> IMAGE[MAX_IMAGES][IFMDim1*IFMDim1][FM_Channels1];
 	ap_uint<INPUT_PRECISION> IMAGE_PADDED[MAX_IMAGES][IFMDim1+2][IFMDim1+2][FM_Channels1];
 	ap_int<ACTIVATION_PRECISION> TEST[MAX_IMAGES][OFMDim1][OFMDim1][FM_Channels1];
+#ifdef FINN_TB_REF_CHECK
+	ap_int<ACTIVATION_PRECISION> TEST_REF[MAX_IMAGES][OFMDim1][OFMDim1][FM_Channels1];
+#endif
 	stream<ap_uint<FM_Channels1*INPUT_PRECISION> > input_stream("input_stream");
 	stream<ap_uint<FM_Channels1*ACTIVATION_PRECISION> > output_stream("output_stream");
 	unsigned int value = 0;
@@ -125,7 +128,19 @@ int main()
 			}
 		}
 	}
-	dwsconv<MAX_IMAGES,IFMDim1+2,OFMDim1,FM_Channels1, KERNEL_DIM, 1, ap_uint<INPUT_PRECISION> >(IMAGE_PADDED, W1, TEST);
+	dwsconv_fast<MAX_IMAGES,IFMDim1+2,OFMDim1,FM_Channels1, KERNEL_DIM, 1, ap_uint<INPUT_PRECISION> >(IMAGE_PADDED, W1, TEST);
+#ifdef FINN_TB_REF_CHECK
+	// the fast golden model must reproduce the reference one
+	dwsconv<MAX_IMAGES,IFMDim1+2,OFMDim1,FM_Channels1, KERNEL_DIM, 1, ap_uint<INPUT_PRECISION> >(IMAGE_PADDED, W1, TEST_REF);
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int ox = 0; ox < OFMDim1; ox++)
+			for (unsigned int oy = 0; oy < OFMDim1; oy++)
+				for (unsigned int channel = 0; channel < FM_Channels1; channel++)
+					if (TEST[n_image][ox][oy][channel] != TEST_REF[n_image][ox][oy][channel]) {
+						cout << "ERROR: fast reference differs at image " << n_image << " (" << ox << ", " << oy << ", " << channel << "): " << TEST[n_image][ox][oy][channel] << " vs " << TEST_REF[n_image][ox][oy][channel] << endl;
+						return 1;
+					}
+#endif
 	Testbench_conv_dws(input_stream, output_stream, MAX_IMAGES);
 	ap_int<ACTIVATION_PRECISION> out_chan;
 	int output_value;
@@ -0,0 +1,131 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file conv_dynamic_tb.cpp
+ *
+ *  Testbench for the convolutional layer with runtime feature map dimensions
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "weights.hpp"
+#include "bnn-library.h"
+#include "data/memdata_conv_dynamic.h"
+#include "data/config_conv_dynamic.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "convlayer.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_conv_dynamic(stream<ap_uint<IFM_Channels_D*INPUT_PRECISION_D> > & in, stream<ap_uint<OFM_Channels_D*ACTIVATION_PRECISION_D> > & out,
+	unsigned int IFMDim, unsigned int OFMDim, unsigned int Stride, unsigned int numReps);
+
+// runs one resolution through the layer and checks it against a direct convolution
+int test_resolution(unsigned int const IFMDim, unsigned int const Stride)
+{
+	constexpr unsigned int SF = KERNEL_DIM_D*KERNEL_DIM_D*IFM_Channels_D / SIMD_D;
+	unsigned int const OFMDim = (IFMDim - KERNEL_DIM_D) / Stride + 1;
+	static ap_uint<INPUT_PRECISION_D> IMAGE[MAX_IMAGES][MaxIFMDim_D][MaxIFMDim_D][IFM_Channels_D];
+	stream<ap_uint<IFM_Channels_D*INPUT_PRECISION_D> > input_stream("input_stream");
+	stream<ap_uint<OFM_Channels_D*ACTIVATION_PRECISION_D> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < IFMDim; oy++) {
+			for (unsigned int ox = 0; ox < IFMDim; ox++) {
+				ap_uint<IFM_Channels_D*INPUT_PRECISION_D> input_word = 0;
+				for (unsigned int channel = 0; channel < IFM_Channels_D; channel++) {
+					ap_uint<INPUT_PRECISION_D> input = (ap_uint<INPUT_PRECISION_D>)rand();
+					IMAGE[n_image][oy][ox][channel] = input;
+					input_word((channel+1)*INPUT_PRECISION_D-1, channel*INPUT_PRECISION_D) = input;
+				}
+				input_stream.write(input_word);
+			}
+		}
+	}
+
+	Testbench_conv_dynamic(input_stream, output_stream, IFMDim, OFMDim, Stride, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < OFMDim; oy++) {
+			for (unsigned int ox = 0; ox < OFMDim; ox++) {
+				ap_uint<OFM_Channels_D*ACTIVATION_PRECISION_D> outElem = output_stream.read();
+				for (unsigned int channel = 0; channel < OFM_Channels_D; channel++) {
+					int exp = 0;
+					for (unsigned int ky = 0; ky < KERNEL_DIM_D; ky++)
+						for (unsigned int kx = 0; kx < KERNEL_DIM_D; kx++)
+							for (unsigned int c = 0; c < IFM_Channels_D; c++) {
+								unsigned int const col = (ky*KERNEL_DIM_D + kx)*IFM_Channels_D + c;
+								exp += PARAM_CONV_DYNAMIC::weights.weights((channel/PE_D)*SF + col/SIMD_D)[channel%PE_D][col%SIMD_D] *
+									IMAGE[n_image][oy*Stride + ky][ox*Stride + kx][c];
+							}
+					ap_int<ACTIVATION_PRECISION_D> const EXP = exp;
+					ap_int<ACTIVATION_PRECISION_D> out_chan;
+					out_chan(ACTIVATION_PRECISION_D-1, 0) = outElem((channel+1)*ACTIVATION_PRECISION_D-1, channel*ACTIVATION_PRECISION_D);
+					if (EXP != out_chan) {
+						std::cout << "ERROR: IFMDim " << IFMDim << " Stride " << Stride << " Image " << n_image << " Pixel (" << oy << "," << ox << ") Expected[" << channel << "]=" << EXP << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (!output_stream.empty() || !input_stream.empty()) {
+		std::cout << "ERROR: IFMDim " << IFMDim << " Stride " << Stride << " streams not empty" << std::endl;
+		err_counter++;
+	}
+	return err_counter;
+}
+
+int main()
+{
+	int err_counter = 0;
+	err_counter += test_resolution(MaxIFMDim_D, 1);
+	err_counter += test_resolution(MaxIFMDim_D, 2);
+	err_counter += test_resolution(6, 2);
+	err_counter += test_resolution(5, 1);
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
@@ -0,0 +1,23 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "convlayer.h"
+#include "data/memdata_conv_dynamic.h"
+#include "data/config_conv_dynamic.h"
+
+void Testbench_conv_dynamic(stream<ap_uint<IFM_Channels_D*INPUT_PRECISION_D> > & in, stream<ap_uint<OFM_Channels_D*ACTIVATION_PRECISION_D> > & out,
+	unsigned int IFMDim, unsigned int OFMDim, unsigned int Stride, unsigned int numReps){
+#pragma HLS INTERFACE s_axilite port=IFMDim
+#pragma HLS INTERFACE s_axilite port=OFMDim
+#pragma HLS INTERFACE s_axilite port=Stride
+#pragma HLS INTERFACE s_axilite port=numReps
+#pragma HLS DATAFLOW
+	ConvLayer_Batch_Dynamic<KERNEL_DIM_D, IFM_Channels_D, MaxIFMDim_D, OFM_Channels_D, MaxStride_D, SIMD_D, PE_D,
+		Slice<ap_uint<INPUT_PRECISION_D> >, Slice<ap_int<ACTIVATION_PRECISION_D> >, Identity>
+		(in, out, PARAM_CONV_DYNAMIC::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_D>>(), IFMDim, OFMDim, Stride, numReps, ap_resource_dsp());
+}
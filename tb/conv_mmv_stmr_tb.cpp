@@ -0,0 +1,101 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file conv_mmv_stmr_tb.cpp
+ *
+ *  Testbench for the MMV convolutional layer with redundancy checks, compared
+ *  against the non-MMV ConvLayer_Batch_TMR
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_noinj.h"
+#include "data/config_noinj.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 4
+#define OFM_ChannelsTMR (OFM_Channels1-NUM_RED*(REDF-1))
+
+void Testbench_conv_mmv_stmr(stream<ap_uint<IFM_Channels1*INPUT_PRECISION> > & in_ref,
+						 stream<ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> > & out_ref,
+						 stream<ap_uint<IFM_Channels1*INPUT_PRECISION> > & in,
+						 stream<ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> > & out,
+						 unsigned int numReps,
+						 ap_uint<2> &errortype_ref,
+						 ap_uint<2> &errortype);
+
+int main()
+{
+	stream<ap_uint<IFM_Channels1*INPUT_PRECISION> > in_ref("in_ref"), in("in");
+	stream<ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> > out_ref("out_ref"), out("out");
+	unsigned int errors = 0;
+
+	for (unsigned int i = 0; i < NUM_REPEAT*IFMDim1*IFMDim1; i++) {
+		ap_uint<IFM_Channels1*INPUT_PRECISION> word;
+		for (unsigned int ch = 0; ch < IFM_Channels1; ch++)
+			word((ch+1)*INPUT_PRECISION-1, ch*INPUT_PRECISION) = rand();
+		in_ref.write(word);
+		in.write(word);
+	}
+
+	ap_uint<2> errortype_ref = 0, errortype = 3;
+	Testbench_conv_mmv_stmr(in_ref, out_ref, in, out, NUM_REPEAT, errortype_ref, errortype);
+
+	for (unsigned int i = 0; i < NUM_REPEAT*OFMDim1*OFMDim1; i++) {
+		ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> const exp = out_ref.read();
+		ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> const value = out.read();
+		if (value != exp) {
+			cout << "ERROR: pixel " << i << hex << " expected " << exp << " value " << value << dec << endl;
+			errors++;
+		}
+	}
+	if ((errortype != errortype_ref) || (errortype != 0)) {
+		cout << "ERROR: errortype expected " << errortype_ref << " value " << errortype << endl;
+		errors++;
+	}
+
+	if (!in_ref.empty() || !out_ref.empty() || !in.empty() || !out.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,30 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_noinj.h"
+#include "data/config_noinj.h"
+
+#define MMV_MS 2
+#define OFM_ChannelsTMR (OFM_Channels1-NUM_RED*(REDF-1))
+
+void Testbench_conv_mmv_stmr(stream<ap_uint<IFM_Channels1*INPUT_PRECISION> > & in_ref,
+						 stream<ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> > & out_ref,
+						 stream<ap_uint<IFM_Channels1*INPUT_PRECISION> > & in,
+						 stream<ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> > & out,
+						 unsigned int numReps,
+						 ap_uint<2> &errortype_ref,
+						 ap_uint<2> &errortype){
+#pragma HLS DATAFLOW
+	ConvLayer_Batch_TMR<KERNEL_DIM, IFM_Channels1, IFMDim1, OFM_Channels1, OFMDim1, SIMD1, PE1, NUM_RED, REDF, MAX_CH_WIDTH,
+						Slice<ap_uint<INPUT_PRECISION> >, Slice<ap_int<ACTIVATION_PRECISION> >, Identity >
+	(in_ref, out_ref, PARAM::weights, PassThroughActivation<ap_uint<ACTIVATION_PRECISION>>(), numReps, ap_resource_dsp(), errortype_ref, PARAM::channel_mask, PARAM::red_ch_index);
+	ConvLayer_Batch_MMV_TMR<KERNEL_DIM, IFM_Channels1, IFMDim1, OFM_Channels1, OFMDim1, STRIDE, SIMD1, PE1, MMV_MS, NUM_RED, REDF, MAX_CH_WIDTH,
+						Slice_mmv<ap_uint<INPUT_PRECISION>, MMV_MS >, Slice_mmv<ap_int<ACTIVATION_PRECISION>, MMV_MS >, Identity >
+	(in, out, PARAM::weights, PassThroughActivation<ap_uint<ACTIVATION_PRECISION>>(), numReps, ap_resource_dsp(), errortype, PARAM::channel_mask, PARAM::red_ch_index);
+}
@@ -0,0 +1,124 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file conv_pool_tb.cpp
+ *
+ *  Testbench for the convolutional layer with fused max pooling
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#include "ap_int.h"
+#include "weights.hpp"
+#include "bnn-library.h"
+#include "data/memdata_conv_pool.h"
+#include "data/config_conv_pool.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "convlayer.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_conv_pool(stream<ap_uint<IFM_Channels_CP*INPUT_PRECISION_CP> > & in, stream<ap_uint<OFM_Channels_CP*ACTIVATION_PRECISION_CP> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int POOL_OFMDim = OFMDim_CP / POOL_DIM_CP;
+	static ap_uint<INPUT_PRECISION_CP> IMAGE[MAX_IMAGES][IFMDim_CP][IFMDim_CP][IFM_Channels_CP];
+	stream<ap_uint<IFM_Channels_CP*INPUT_PRECISION_CP> > input_stream("input_stream");
+	stream<ap_uint<OFM_Channels_CP*ACTIVATION_PRECISION_CP> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < IFMDim_CP; oy++) {
+			for (unsigned int ox = 0; ox < IFMDim_CP; ox++) {
+				ap_uint<IFM_Channels_CP*INPUT_PRECISION_CP> input_word = 0;
+				for (unsigned int channel = 0; channel < IFM_Channels_CP; channel++) {
+					ap_uint<INPUT_PRECISION_CP> input = (ap_uint<INPUT_PRECISION_CP>)rand();
+					IMAGE[n_image][oy][ox][channel] = input;
+					input_word((channel+1)*INPUT_PRECISION_CP-1, channel*INPUT_PRECISION_CP) = input;
+				}
+				input_stream.write(input_word);
+			}
+		}
+	}
+
+	Testbench_conv_pool(input_stream, output_stream, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int py = 0; py < POOL_OFMDim; py++) {
+			for (unsigned int px = 0; px < POOL_OFMDim; px++) {
+				ap_uint<OFM_Channels_CP*ACTIVATION_PRECISION_CP> outElem = output_stream.read();
+				for (unsigned int channel = 0; channel < OFM_Channels_CP; channel++) {
+					// convolution and thresholding of every pixel of the pooling window, then maximum
+					unsigned int exp = 0;
+					for (unsigned int wy = 0; wy < POOL_DIM_CP; wy++)
+						for (unsigned int wx = 0; wx < POOL_DIM_CP; wx++) {
+							unsigned int const oy = py*POOL_DIM_CP + wy;
+							unsigned int const ox = px*POOL_DIM_CP + wx;
+							int acc = 0;
+							for (unsigned int ky = 0; ky < KERNEL_DIM_CP; ky++)
+								for (unsigned int kx = 0; kx < KERNEL_DIM_CP; kx++)
+									for (unsigned int c = 0; c < IFM_Channels_CP; c++)
+										acc += PARAM_CONV_POOL::raw[channel][ky][kx][c] * IMAGE[n_image][oy + ky][ox + kx][c];
+							unsigned int act = 0;
+							for (unsigned int t = 0; t < NumTH_CP; t++)
+								act += PARAM_CONV_POOL::raw_th[channel][t] < acc;
+							if (act > exp)
+								exp = act;
+						}
+					unsigned int const out_chan = outElem((channel+1)*ACTIVATION_PRECISION_CP-1, channel*ACTIVATION_PRECISION_CP);
+					if (exp != out_chan) {
+						std::cout << "ERROR: Image " << n_image << " Pixel (" << py << "," << px << ") Expected[" << channel << "]=" << exp << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
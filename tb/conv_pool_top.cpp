@@ -0,0 +1,18 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "convlayer.h"
+#include "data/memdata_conv_pool.h"
+#include "data/config_conv_pool.h"
+
+void Testbench_conv_pool(stream<ap_uint<IFM_Channels_CP*INPUT_PRECISION_CP> > & in, stream<ap_uint<OFM_Channels_CP*ACTIVATION_PRECISION_CP> > & out, unsigned int numReps){
+#pragma HLS DATAFLOW
+	ConvLayer_Pool_Batch<KERNEL_DIM_CP, IFM_Channels_CP, IFMDim_CP, OFM_Channels_CP, OFMDim_CP, POOL_DIM_CP, SIMD_CP, PE_CP,
+		Slice<ap_uint<INPUT_PRECISION_CP> >, Slice<ap_uint<ACTIVATION_PRECISION_CP> >, Identity>
+		(in, out, PARAM_CONV_POOL::weights, PARAM_CONV_POOL::threshs, numReps, ap_resource_dsp());
+}
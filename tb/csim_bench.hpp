@@ -0,0 +1,70 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file csim_bench.hpp
+ *
+ *  Wall-clock measurement of C simulation runs of the unit test top-levels
+ *
+ *****************************************************************************/
+#ifndef CSIM_BENCH_HPP
+#define CSIM_BENCH_HPP
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+/**
+ * \brief Scoped timer reporting the time per frame and the consumed input words per second
+ *
+ * Construct it right before the call of the top-level with the number of frames and the number of input words
+ * (e.g. the size of the filled input stream), the report is printed when it goes out of scope.
+ */
+class CsimBench {
+	std::string const  m_name;
+	unsigned long const  m_frames;
+	unsigned long const  m_words;
+	std::chrono::steady_clock::time_point const  m_start;
+
+public:
+	CsimBench(std::string const &name, unsigned long const  frames, unsigned long const  words)
+		: m_name(name), m_frames(frames), m_words(words), m_start(std::chrono::steady_clock::now()) {}
+
+	~CsimBench() {
+		double const  sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+		std::cout << "BENCH " << m_name << ": " << m_frames << " frames in " << sec << " s, "
+			<< (m_frames? 1e6 * sec / m_frames : 0) << " us/frame, "
+			<< (sec > 0? m_words / sec : 0) << " words/s" << std::endl;
+	}
+};
+
+#endif
@@ -0,0 +1,168 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file cycles_model_tb.cpp
+ *
+ *  Testbench for the analytical cycle models of cycles.hpp
+ *
+ *  Besides checking the functional output, the testbench records the modelled
+ *  cycle counts of the two tops in cycles_model.txt of its working directory.
+ *  test_cycles_model.tcl compares them against the latencies measured by
+ *  the cosimulation.
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "cycles.hpp"
+#include "data/config_cycles_model.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_cycles_model_swg(stream<ap_uint<SIMD_CM*INPUT_PRECISION_CM> > & in, stream<ap_uint<SIMD_CM*INPUT_PRECISION_CM> > & out);
+void Testbench_cycles_model_mvau(stream<ap_uint<MVAU_SIMD_CM*INPUT_PRECISION_CM> > & in, stream<ap_uint<PE_CM*MVAU_SIMD_CM*WIDTH_CM> > & weights,
+	stream<ap_uint<PE_CM*ACTIVATION_PRECISION_CM> > & out);
+
+// models evaluated at compile time
+constexpr cycles_t SWG_CYCLES = ConvolutionInputGenerator_cycles<KERNEL_DIM_CM, IFM_Channels_CM, IFMDim_CM, OFMDim_CM, SIMD_CM, STRIDE_CM>(NUM_REPEAT_CM);
+constexpr cycles_t MVAU_CYCLES = Matrix_Vector_Activate_Batch_cycles<MatrixW_CM, MatrixH_CM, MVAU_SIMD_CM, PE_CM>(NUM_REPEAT_CM);
+
+// spot checks against hand-derived schedules
+static_assert(SWG_CYCLES == NUM_REPEAT_CM * (8*3*2 + 6*(6*9*2)), "");
+static_assert(MVAU_CYCLES == NUM_REPEAT_CM * 4*4, "");
+static_assert(ConvolutionInputGenerator_kernel_stride_cycles<3, 4, 7, 3, 2, 2>(1) == 7*3*2 + 2*(3*9*2) + 3*9*2, "");
+static_assert(ConvolutionInputGenerator_1D_dws_cycles<3, 8, 10, 8, 1, 2>(1) == 1 + 3*2 + 8*3*4, "");
+static_assert(StreamingDataWidthConverter_Batch_cycles<32, 8, 10>(2) == 80, "");
+static_assert(StreamingDataWidthConverter_Batch_cycles<8, 32, 40>(2) == 80, "");
+static_assert(LabelSelect_Batch_cycles<10, 2, 3>(4) == 32, "");
+static_assert(ConvolutionInputGenerator_cycles_bound<3, 3, 4, 8, 8, 6, 6, 2>(1) == 6*6*9*2, "");
+
+int main()
+{
+	constexpr unsigned int CF = IFM_Channels_CM / SIMD_CM;
+	constexpr unsigned int SF = MatrixW_CM / MVAU_SIMD_CM;
+	constexpr unsigned int NF = MatrixH_CM / PE_CM;
+	static ap_uint<SIMD_CM*INPUT_PRECISION_CM> IMAGE[NUM_REPEAT_CM][IFMDim_CM][IFMDim_CM][CF];
+	static ap_int<INPUT_PRECISION_CM> A[NUM_REPEAT_CM][MatrixW_CM];
+	static ap_int<WIDTH_CM> W[NUM_REPEAT_CM][MatrixH_CM][MatrixW_CM];
+	stream<ap_uint<SIMD_CM*INPUT_PRECISION_CM> > swg_in("swg_in");
+	stream<ap_uint<SIMD_CM*INPUT_PRECISION_CM> > swg_out("swg_out");
+	stream<ap_uint<MVAU_SIMD_CM*INPUT_PRECISION_CM> > mvau_in("mvau_in");
+	stream<ap_uint<PE_CM*MVAU_SIMD_CM*WIDTH_CM> > mvau_weights("mvau_weights");
+	stream<ap_uint<PE_CM*ACTIVATION_PRECISION_CM> > mvau_out("mvau_out");
+
+	for (unsigned int n_image = 0; n_image < NUM_REPEAT_CM; n_image++)
+		for (unsigned int y = 0; y < IFMDim_CM; y++)
+			for (unsigned int x = 0; x < IFMDim_CM; x++)
+				for (unsigned int cf = 0; cf < CF; cf++) {
+					ap_uint<SIMD_CM*INPUT_PRECISION_CM> const word = ap_uint<SIMD_CM*INPUT_PRECISION_CM>(rand());
+					IMAGE[n_image][y][x][cf] = word;
+					swg_in.write(word);
+				}
+
+	// the weights are streamed again for every input vector
+	for (unsigned int rep = 0; rep < NUM_REPEAT_CM; rep++) {
+		for (unsigned int col = 0; col < MatrixW_CM; col++)
+			A[rep][col] = (ap_int<INPUT_PRECISION_CM>)rand();
+		for (unsigned int row = 0; row < MatrixH_CM; row++)
+			for (unsigned int col = 0; col < MatrixW_CM; col++)
+				W[rep][row][col] = (ap_int<WIDTH_CM>)rand();
+		for (unsigned int sf = 0; sf < SF; sf++) {
+			ap_uint<MVAU_SIMD_CM*INPUT_PRECISION_CM> input_word;
+			for (unsigned int simd = 0; simd < MVAU_SIMD_CM; simd++)
+				input_word((simd+1)*INPUT_PRECISION_CM-1, simd*INPUT_PRECISION_CM) = A[rep][sf*MVAU_SIMD_CM + simd];
+			mvau_in.write(input_word);
+		}
+		for (unsigned int nf = 0; nf < NF; nf++)
+			for (unsigned int sf = 0; sf < SF; sf++) {
+				ap_uint<PE_CM*MVAU_SIMD_CM*WIDTH_CM> weight_word;
+				for (unsigned int pe = 0; pe < PE_CM; pe++)
+					for (unsigned int simd = 0; simd < MVAU_SIMD_CM; simd++)
+						weight_word((pe*MVAU_SIMD_CM + simd + 1)*WIDTH_CM-1, (pe*MVAU_SIMD_CM + simd)*WIDTH_CM) = W[rep][nf*PE_CM + pe][sf*MVAU_SIMD_CM + simd];
+				mvau_weights.write(weight_word);
+			}
+	}
+
+	Testbench_cycles_model_swg(swg_in, swg_out);
+	Testbench_cycles_model_mvau(mvau_in, mvau_weights, mvau_out);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < NUM_REPEAT_CM; n_image++)
+		for (unsigned int oy = 0; oy < OFMDim_CM; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_CM; ox++)
+				for (unsigned int ky = 0; ky < KERNEL_DIM_CM; ky++)
+					for (unsigned int kx = 0; kx < KERNEL_DIM_CM; kx++)
+						for (unsigned int cf = 0; cf < CF; cf++) {
+							ap_uint<SIMD_CM*INPUT_PRECISION_CM> const exp = IMAGE[n_image][oy*STRIDE_CM + ky][ox*STRIDE_CM + kx][cf];
+							ap_uint<SIMD_CM*INPUT_PRECISION_CM> const outElem = swg_out.read();
+							if (exp != outElem) {
+								std::cout << "ERROR: Image " << n_image << " oy= " << oy << " ox= " << ox << " ky= " << ky << " kx= " << kx << " cf= " << cf
+									<< " Expected " << exp << " actual " << outElem << std::endl;
+								err_counter++;
+							}
+						}
+	for (unsigned int rep = 0; rep < NUM_REPEAT_CM; rep++)
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_CM*ACTIVATION_PRECISION_CM> const outElem = mvau_out.read();
+			for (unsigned int pe = 0; pe < PE_CM; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_CM; col++)
+					exp += W[rep][nf*PE_CM + pe][col] * A[rep][col];
+				ap_int<ACTIVATION_PRECISION_CM> const EXP = exp;
+				ap_int<ACTIVATION_PRECISION_CM> out_chan;
+				out_chan(ACTIVATION_PRECISION_CM-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_CM-1, pe*ACTIVATION_PRECISION_CM);
+				if (EXP != out_chan) {
+					std::cout << "ERROR: Rep " << rep << " Expected[" << nf*PE_CM + pe << "]=" << EXP << " actual " << out_chan << std::endl;
+					err_counter++;
+				}
+			}
+		}
+	if (!swg_in.empty() || !swg_out.empty() || !mvau_in.empty() || !mvau_weights.empty() || !mvau_out.empty()) {
+		std::cout << "ERROR: Streams not drained" << std::endl;
+		err_counter++;
+	}
+
+	std::ofstream model("cycles_model.txt");
+	model << "Testbench_cycles_model_swg " << SWG_CYCLES << " " << NUM_REPEAT_CM << std::endl;
+	model << "Testbench_cycles_model_mvau " << MVAU_CYCLES << " 1" << std::endl;
+	std::cout << "Modelled cycles: SWG " << SWG_CYCLES << ", MVAU " << MVAU_CYCLES << std::endl;
+
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
@@ -0,0 +1,22 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/config_cycles_model.h"
+
+void Testbench_cycles_model_swg(stream<ap_uint<SIMD_CM*INPUT_PRECISION_CM> > & in, stream<ap_uint<SIMD_CM*INPUT_PRECISION_CM> > & out)
+{
+	ConvolutionInputGenerator<KERNEL_DIM_CM, IFM_Channels_CM, INPUT_PRECISION_CM, IFMDim_CM, OFMDim_CM, SIMD_CM, STRIDE_CM>
+		(in, out, NUM_REPEAT_CM, ap_resource_dflt());
+}
+
+void Testbench_cycles_model_mvau(stream<ap_uint<MVAU_SIMD_CM*INPUT_PRECISION_CM> > & in, stream<ap_uint<PE_CM*MVAU_SIMD_CM*WIDTH_CM> > & weights,
+	stream<ap_uint<PE_CM*ACTIVATION_PRECISION_CM> > & out)
+{
+	Matrix_Vector_Activate_Stream_Batch<MatrixW_CM, MatrixH_CM, MVAU_SIMD_CM, PE_CM, 1, Slice<ap_int<INPUT_PRECISION_CM> >, Slice<ap_int<ACTIVATION_PRECISION_CM> >, Identity, ap_int<WIDTH_CM> >
+		(in, out, weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_CM>>(), NUM_REPEAT_CM, ap_resource_dsp());
+}
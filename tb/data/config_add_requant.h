@@ -0,0 +1,14 @@
+#define PE_AR 3 
+#define IN1_WIDTH_AR 4 
+#define IN2_WIDTH_AR 6 
+#define OUT_WIDTH_AR 5 
+#define SHIFT1_AR 1 
+#define SHIFT2_AR 0 
+#define OUT_SHIFT_AR 2 
+#define OFFSET_AR 3 
+#define CHANNELS_L_AR 8 
+#define PE_L_AR 2 
+#define OUT_WIDTH_L_AR 6 
+#define SHIFT2_L_AR 2 
+#define OUT_SHIFT_L_AR 1 
+#define NUM_WORDS_AR 16 
@@ -0,0 +1,8 @@
+#define Channels_AF 8 
+#define PE_AF 2 
+#define IMGDIM_AF 4 
+#define INPUT_PRECISION_AF 6 
+#define SCALE_PRECISION_AF 5 
+#define BIAS_PRECISION_AF 10 
+#define OUTPUT_PRECISION_AF 4 
+#define SHIFT_AF 5 
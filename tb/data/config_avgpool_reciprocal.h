@@ -0,0 +1,9 @@
+#define KERNEL_DIM_RA 3 
+#define IFM_Channels_RA 8 
+#define PE_RA 2 
+#define IFMDim_RA 6 
+#define OFMDim_RA 4 
+#define STRIDE_RA 1 
+#define INPUT_PRECISION_RA 4 
+#define ACC_PRECISION_RA 8 
+#define OUTPUT_PRECISION_RA 4 
@@ -0,0 +1,13 @@
+#define N_BF 4 
+#define W_BF 16 
+#define M_BF 8 
+#define E_BF 4 
+#define MatrixW_BF 32 
+#define MatrixH_BF 8 
+#define SIMD_BF 8 
+#define PE_BF 2 
+#define WIDTH_BF 8 
+#define ACC_BF 24 
+#define OUT_BF 40 
+#define VECTORS_BF 6 
+#define DEC_LANES_BF 2 
@@ -0,0 +1,9 @@
+#define MatrixW_BS 33 
+#define MatrixH_BS 8 
+#define SIMD_BS 11 
+#define PE_BS 4 
+#define MatrixW_BL 200 
+#define MatrixH_BL 4 
+#define SIMD_BL 100 
+#define PE_BL 2 
+#define ACTIVATION_PRECISION_BN 16 
@@ -0,0 +1,5 @@
+#define Channels_BN 8 
+#define PE_BN 2 
+#define NumTH_BN 7 
+#define INPUT_PRECISION_BN 8 
+#define OUTPUT_PRECISION_BN 3 
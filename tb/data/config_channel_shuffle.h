@@ -0,0 +1,11 @@
+#define NUM_PIXELS_CS 9 
+#define CHANNELS_CS 12 
+#define GROUPS_CS 3 
+#define PE_CS 4 
+#define WIDTH_CS 5 
+#define PE_SPLIT_CS 3 
+#define CH0_SPLIT_CS 4 
+#define WIDTH0_SPLIT_CS 4 
+#define CH1_SPLIT_CS 8 
+#define WIDTH1_SPLIT_CS 6 
+#define PE_REV_CS 2 
@@ -0,0 +1,8 @@
+#define MatrixW_CB 32 
+#define MatrixH_CB 16 
+#define SIMD_CB 4 
+#define PE_CB 4 
+#define INDEX_BITS_CB 4 
+#define WIDTH_CB 8 
+#define INPUT_PRECISION_CB 4 
+#define ACTIVATION_PRECISION_CB 16 
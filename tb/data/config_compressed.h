@@ -0,0 +1,13 @@
+#define TILES_DC 48 
+#define SIMD_DC 4 
+#define PE_DC 4 
+#define WP_DC 4 
+#define GROUPS_DC 4 
+#define IN_WIDTH_DC 32 
+#define IN_WORDS_DC 70 
+#define TILES2_DC 40 
+#define SIMD2_DC 4 
+#define PE2_DC 2 
+#define WP2_DC 3 
+#define IN_WIDTH2_DC 16 
+#define IN_WORDS2_DC 40 
@@ -0,0 +1,9 @@
+#define NUM_PIXELS_CC 10 
+#define PE_CC 4 
+#define CH0_CC 4 
+#define WIDTH0_CC 3 
+#define CH1_CC 6 
+#define WIDTH1_CC 5 
+#define CH2_CC 2 
+#define WIDTH2_CC 8 
+#define OUT_WIDTH_CC 9 
@@ -0,0 +1,10 @@
+#define KERNEL_DIM_D 3 
+#define IFM_Channels_D 4 
+#define OFM_Channels_D 4 
+#define MaxIFMDim_D 9 
+#define MaxStride_D 2 
+#define SIMD_D 2 
+#define PE_D 2 
+#define WIDTH_D 4 
+#define INPUT_PRECISION_D 4 
+#define ACTIVATION_PRECISION_D 16 
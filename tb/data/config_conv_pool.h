@@ -0,0 +1,13 @@
+#define KERNEL_DIM_CP 3 
+#define IFM_Channels_CP 4 
+#define OFM_Channels_CP 4 
+#define IFMDim_CP 10 
+#define OFMDim_CP 8 
+#define POOL_DIM_CP 2 
+#define SIMD_CP 2 
+#define PE_CP 2 
+#define WIDTH_CP 4 
+#define INPUT_PRECISION_CP 4 
+#define ACC_PRECISION_CP 16 
+#define ACTIVATION_PRECISION_CP 2 
+#define NumTH_CP 3 
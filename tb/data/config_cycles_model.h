@@ -0,0 +1,14 @@
+#define KERNEL_DIM_CM 3 
+#define IFM_Channels_CM 4 
+#define IFMDim_CM 8 
+#define OFMDim_CM 6 
+#define STRIDE_CM 1 
+#define SIMD_CM 2 
+#define INPUT_PRECISION_CM 4 
+#define MatrixW_CM 16 
+#define MatrixH_CM 12 
+#define MVAU_SIMD_CM 4 
+#define PE_CM 3 
+#define WIDTH_CM 4 
+#define ACTIVATION_PRECISION_CM 16 
+#define NUM_REPEAT_CM 3 
@@ -0,0 +1,12 @@
+#define IFM_Channels_DC 4 
+#define OFM_Channels_DC 4 
+#define KERNEL_DIM_DC 4 
+#define STRIDE_DC 2 
+#define PADDING_DC 1 
+#define IFMDim_DC 4 
+#define OFMDim_DC 8 
+#define SIMD_DC 2 
+#define PE_DC 2 
+#define WIDTH_DC 4 
+#define INPUT_PRECISION_DC 4 
+#define ACTIVATION_PRECISION_DC 16 
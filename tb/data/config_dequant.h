@@ -0,0 +1,4 @@
+#define Channels_DQ 16 
+#define PE_DQ 4 
+#define IMGDIM_DQ 8 
+#define INPUT_PRECISION_DQ 8 
@@ -0,0 +1,9 @@
+#define DATA_WIDTH_DB 24 
+#define NUM_BYTES_DB 300 
+#define MEM_WIDTH_DB 512 
+#define MAX_BURST_DB 4 
+#define DATA_WIDTH_WIDE_DB 128 
+#define NUM_BYTES_WIDE_DB 4160 
+#define MEM_WIDTH_WIDE_DB 256 
+#define MAX_BURST_WIDE_DB 16 
+#define NUM_REPS_DB 3 
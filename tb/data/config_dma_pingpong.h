@@ -0,0 +1,3 @@
+#define DATA_WIDTH_PP 64 
+#define NUM_BYTES_PP 136 
+#define NUM_REPS_PP 5 
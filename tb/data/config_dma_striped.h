@@ -0,0 +1,4 @@
+#define DATA_WIDTH_ST 96 
+#define SLICE_WIDTH_ST 32 
+#define NUM_WORDS_ST 20 
+#define NUM_REPS_ST 3 
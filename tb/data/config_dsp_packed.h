@@ -0,0 +1,9 @@
+#define MatrixW_DP 20 
+#define MatrixH_DP 4 
+#define SIMD_DP 5 
+#define PE_DP 2 
+#define WEIGHT_PRECISION_DP 4 
+#define INPUT_PRECISION_DP 4 
+#define WIDE_WEIGHT_PRECISION_DP 10 
+#define WIDE_INPUT_PRECISION_DP 8 
+#define ACTIVATION_PRECISION_DP 24 
@@ -0,0 +1,6 @@
+#define WIDTH_DN 16 
+#define NUM_WORDS_DN 12 
+#define NUM_OUT_DN 3 
+#define IN_WIDTH_FOLD_DN 24 
+#define OUT_WIDTH_FOLD_DN 8 
+#define NUM_OUT_FOLD_DN 4 
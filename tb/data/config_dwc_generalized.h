@@ -0,0 +1,10 @@
+#define IN_WIDTH_DOWN_DG 24 
+#define OUT_WIDTH_DOWN_DG 16 
+#define NUM_IN_DOWN_DG 10 
+#define IN_WIDTH_UP_DG 12 
+#define OUT_WIDTH_UP_DG 20 
+#define NUM_IN_UP_DG 7 
+#define IN_WIDTH_FLUSH_DG 20 
+#define OUT_WIDTH_FLUSH_DG 12 
+#define NUM_IN_FLUSH_DG 6 
+#define NUM_OUT_FLUSH_DG 9 
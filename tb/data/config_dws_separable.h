@@ -0,0 +1,12 @@
+#define IFM_Channels_DS 12 
+#define OFM_Channels_DS 8 
+#define KERNEL_DIM_DS 3 
+#define IFMDim_DS 6 
+#define OFMDim_DS 4 
+#define DW_SIMD_DS 3 
+#define DW_PE_DS 2 
+#define PW_PE_DS 4 
+#define WIDTH_DS 4 
+#define INPUT_PRECISION_DS 4 
+#define MID_PRECISION_DS 12 
+#define ACTIVATION_PRECISION_DS 24 
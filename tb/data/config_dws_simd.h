@@ -0,0 +1,9 @@
+#define FM_Channels_V 12 
+#define KERNEL_DIM_V 3 
+#define IFMDim_V 6 
+#define OFMDim_V 4 
+#define SIMD_V 3 
+#define PE_V 2 
+#define WIDTH_V 4 
+#define INPUT_PRECISION_V 4 
+#define ACTIVATION_PRECISION_V 16 
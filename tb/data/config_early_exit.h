@@ -0,0 +1,7 @@
+#define NUM_CLASSES_EE 10 
+#define PE_EE 2 
+#define SCORE_WIDTH_EE 8 
+#define LABEL_WIDTH_EE 8 
+#define TAG_BITS_EE 5 
+#define THRESHOLD_EE 200 
+#define NUM_REPS_EE 24 
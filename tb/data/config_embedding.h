@@ -0,0 +1,6 @@
+#define NUM_EMBEDDINGS_EM 16 
+#define EMBEDDING_DIM_EM 8 
+#define SIMD_EM 2 
+#define PRECISION_EM 4 
+#define INDEX_WIDTH_EM 5 
+#define CACHED_ROWS_EM 4 
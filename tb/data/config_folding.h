@@ -0,0 +1,10 @@
+#define KERNEL_DIM_FD 3 
+#define IFM_Channels_FD 8 
+#define IFMDim_FD 6 
+#define OFM_Channels_FD 8 
+#define OFMDim_FD 4 
+#define INPUT_PRECISION_FD 4 
+#define WIDTH_FD 4 
+#define ACTIVATION_PRECISION_FD 16 
+#define TARGET_CYCLES_FD 300 
+#define MAX_IMAGES_FD 2 
@@ -0,0 +1,6 @@
+#define MatrixW_FP 8 
+#define MatrixH_FP 8 
+#define SIMD_FP 4 
+#define PE_FP 2 
+#define OUTPUT_PRECISION_FP 8 
+#define NUM_TH_FP 3 
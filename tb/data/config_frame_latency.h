@@ -0,0 +1,5 @@
+#define IN_WIDTH_FL 32 
+#define MID_WIDTH_FL 8 
+#define NUM_WORDS_FL 16 
+#define DEPTH_FL 4 
+#define NUM_REPS_FL 6 
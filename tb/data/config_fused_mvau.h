@@ -0,0 +1,7 @@
+#define MatrixW_FU 32 
+#define MatrixH_FU 4 
+#define SIMD_FU 2 
+#define PE_FU 2 
+#define MAX_BITS_FU 8 
+#define BRICK_BITS_FU 2 
+#define ACTIVATION_PRECISION_FU 24 
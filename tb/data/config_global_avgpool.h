@@ -0,0 +1,7 @@
+#define IFMDim_X_GP 7 
+#define IFMDim_Y_GP 5 
+#define IFM_Channels_GP 8 
+#define PE_GP 2 
+#define INPUT_PRECISION_GP 4 
+#define ACC_PRECISION_GP 10 
+#define OUTPUT_PRECISION_GP 6 
@@ -0,0 +1,11 @@
+#define KERNEL_DIM_GC 3 
+#define IFM_Channels_GC 8 
+#define IFMDim_GC 5 
+#define OFM_Channels_GC 4 
+#define OFMDim_GC 3 
+#define GROUPS_GC 2 
+#define SIMD_GC 2 
+#define PE_GC 2 
+#define INPUT_PRECISION_GC 4 
+#define ACTIVATION_PRECISION_GC 16 
+#define WIDTH_GC 4 
@@ -0,0 +1,5 @@
+#define NumClasses_LT 64 
+#define PE_LT 8 
+#define NumTop_LT 5 
+#define INPUT_PRECISION_LT 4 
+#define OUT_WIDTH_LT 8 
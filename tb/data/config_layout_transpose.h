@@ -0,0 +1,4 @@
+#define PIXELS_LT 12 
+#define Channels_LT 4 
+#define SIMD_LT 2 
+#define PRECISION_LT 4 
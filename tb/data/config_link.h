@@ -0,0 +1,5 @@
+#define DATA_WIDTH_LK 24 
+#define LINK_WIDTH_LK 96 
+#define NUM_WORDS_LK 40 
+#define PACKET_WORDS_LK 4 
+#define CREDITS_LK 3 
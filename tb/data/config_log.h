@@ -0,0 +1,7 @@
+#define MatrixW_LG 32 
+#define MatrixH_LG 16 
+#define SIMD_LG 4 
+#define PE_LG 4 
+#define EXP_BITS_LG 3 
+#define INPUT_PRECISION_LG 4 
+#define ACTIVATION_PRECISION_LG 20 
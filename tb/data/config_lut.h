@@ -0,0 +1,7 @@
+#define Channels_L 8 
+#define PE_L 2 
+#define INPUT_PRECISION_L 10 
+#define OFFSET_L -512 
+#define SHIFT_L 2 
+#define ENTRIES_L 256 
+#define OUTPUT_PRECISION_L 8 
@@ -0,0 +1,9 @@
+#define IFMDim_X_MK 9 
+#define IFMDim_Y_MK 8 
+#define POOL_DIM_X_MK 3 
+#define POOL_DIM_Y_MK 2 
+#define STRIDE_X_MK 2 
+#define STRIDE_Y_MK 1 
+#define FM_Channels_MK 8 
+#define PE_MK 2 
+#define PRECISION_MK 5 
@@ -0,0 +1,9 @@
+#define MatrixW_MP 32 
+#define MatrixH_MP 16 
+#define SIMD_MP 4 
+#define PE_MP 4 
+#define PE_HI_MP 1 
+#define WIDTH_HI_MP 8 
+#define WIDTH_LO_MP 4 
+#define INPUT_PRECISION_MP 4 
+#define ACTIVATION_PRECISION_MP 16 
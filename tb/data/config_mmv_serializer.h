@@ -0,0 +1,5 @@
+#define MMV_SR 3 
+#define IN_WIDTH_SR 32 
+#define CHUNKS_SR 4 
+#define DOWN_WIDTH_SR 8 
+#define UP_WIDTH_SR 64 
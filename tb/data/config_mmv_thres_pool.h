@@ -0,0 +1,9 @@
+#define MMV_MT 2 
+#define IMG_DIM_MT 16 
+#define KERNEL_DIM_MT 2 
+#define STRIDE_MT 2 
+#define IFMDIM_MT 8 
+#define OFMDIM_MT 4 
+#define CHANNELS_MT 4 
+#define PRECISION_MT 4 
+#define NUM_REPS_MT 2 
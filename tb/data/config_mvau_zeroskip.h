@@ -0,0 +1,7 @@
+#define MatrixW_ZS 24 
+#define MatrixH_ZS 8 
+#define SIMD_ZS 4 
+#define PE_ZS 2 
+#define WIDTH_ZS 4 
+#define INPUT_PRECISION_ZS 4 
+#define ACTIVATION_PRECISION_ZS 16 
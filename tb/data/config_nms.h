@@ -0,0 +1,10 @@
+#define NUM_CANDIDATES_NM 48 
+#define TOP_N_NM 16 
+#define PE_NM 4 
+#define SCORE_WIDTH_NM 8 
+#define COORD_WIDTH_NM 10 
+#define IOU_BITS_NM 8 
+#define SCORE_THRESHOLD_NM 40 
+#define IOU_THRESHOLD_NM 128 
+#define NUM_REPS_NM 4 
+#define SCORE_INT_BITS_NM 3 
@@ -0,0 +1,10 @@
+#define SIMD_OV 2 
+#define PE_OV 4 
+#define ACT_BITS_OV 5 
+#define WGT_BITS_OV 3 
+#define MAX_IFM_DIM_OV 8 
+#define MAX_IFM_CH_OV 8 
+#define MAX_K_OV 3 
+#define MAX_STRIDE_OV 2 
+#define MAX_TILES_OV 36 
+#define NUM_REPS_OV 2 
@@ -0,0 +1,8 @@
+#define MatrixW_PK 128 
+#define MatrixH_PK 16 
+#define SIMD_PK 2 
+#define PE_PK 8 
+#define PE_PER_WORD_PK 8 
+#define WIDTH_PK 4 
+#define INPUT_PRECISION_PK 4 
+#define ACTIVATION_PRECISION_PK 16 
@@ -0,0 +1,9 @@
+#define MatrixW_PF 32 
+#define MatrixH_PF 16 
+#define SIMD_PF 4 
+#define PE_PF 4 
+#define WIDTH_PF 4 
+#define INPUT_PRECISION_PF 4 
+#define ACC_PRECISION_PF 16 
+#define NUM_TH_PF 3 
+#define OUTPUT_PRECISION_PF 2 
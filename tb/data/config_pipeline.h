@@ -0,0 +1,17 @@
+#define KERNEL_DIM_PL 3 
+#define IFM_Channels_PL 2 
+#define IFMDim_PL 6 
+#define OFM_Channels_PL 4 
+#define OFMDim_PL 4 
+#define CONV_SIMD_PL 2 
+#define CONV_PE_PL 2 
+#define POOL_DIM_PL 2 
+#define FC_IN_PL 16 
+#define FC_OUT_PL 4 
+#define FC_SIMD_PL 8 
+#define FC_PE_PL 4 
+#define INPUT_PRECISION_PL 4 
+#define CONV_PRECISION_PL 16 
+#define FC_PRECISION_PL 24 
+#define OUT_STREAM_WIDTH_PL 48 
+#define WIDTH_PL 4 
@@ -0,0 +1,6 @@
+#define NUM_CLASSES_PA 21 
+#define PE_PA 3 
+#define NUM_PIXELS_PA 36 
+#define INPUT_PRECISION_PA 4 
+#define OUT_WIDTH_PA 5 
+#define NUM_REPS_PA 3 
@@ -0,0 +1,10 @@
+#define IFM_Channels_PW 8 
+#define IFMDim_PW 7 
+#define OFM_Channels_PW 8 
+#define STRIDE_PW 2 
+#define SIMD_PW 2 
+#define PE_PW 2 
+#define MMV_PW 2 
+#define INPUT_PRECISION_PW 4 
+#define ACTIVATION_PRECISION_PW 16 
+#define WIDTH_PW 4 
@@ -0,0 +1,3 @@
+#define DATA_WIDTH_QF 64 
+#define NUM_WORDS_QF 7 
+#define NUM_FRAMES_QF 4 
@@ -0,0 +1,3 @@
+#define DATA_WIDTH_MQ 32 
+#define NUM_QUEUES_MQ 3 
+#define NUM_WORDS_MQ 5 
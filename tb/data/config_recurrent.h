@@ -0,0 +1,16 @@
+#define INPUT_SIZE_RC 4 
+#define HIDDEN_SIZE_RC 4 
+#define SIMD_RC 2 
+#define PE_RC 2 
+#define SEQ_LEN_RC 6 
+#define INPUT_PRECISION_RC 4 
+#define WIDTH_RC 4 
+#define ACC_PRECISION_RC 16 
+#define STATE_PRECISION_RC 12 
+#define HIDDEN_PRECISION_RC 8 
+#define FRAC_RC 6 
+#define ENTRIES_RC 64 
+#define ACC_OFFSET_RC -512 
+#define ACC_SHIFT_RC 4 
+#define STATE_OFFSET_RC -2048 
+#define STATE_SHIFT_RC 6 
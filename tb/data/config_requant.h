@@ -0,0 +1,6 @@
+#define Channels_RQ 8 
+#define PE_RQ 2 
+#define INPUT_PRECISION_RQ 20 
+#define MULT_PRECISION_RQ 16 
+#define OUTPUT_PRECISION_RQ 8 
+#define ZERO_POINT_RQ -5 
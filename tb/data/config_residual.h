@@ -0,0 +1,12 @@
+#define KERNEL_DIM_RB 3 
+#define IFMDim_RB 5 
+#define Channels_RB 4 
+#define SIMD1_RB 2 
+#define PE1_RB 2 
+#define SIMD2_RB 4 
+#define PE2_RB 1 
+#define INPUT_PRECISION_RB 4 
+#define MID_PRECISION_RB 16 
+#define RES_PRECISION_RB 16 
+#define OUTPUT_PRECISION_RB 17 
+#define WIDTH_RB 4 
@@ -0,0 +1,9 @@
+#define MatrixW_RS 64 
+#define MatrixH_RS 32 
+#define INPUT_PRECISION_RS 8 
+#define WIDTH_RS 8 
+#define ACTIVATION_PRECISION_RS 24 
+#define VECTORS_RS 4 
+#define TARGET_CYCLES_RS 64 
+#define DSP_BUDGET_RS 64 
+#define MAX_IMAGES_RS 2 
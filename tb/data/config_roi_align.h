@@ -0,0 +1,11 @@
+#define FMDIM_X_RA 7 
+#define FMDIM_Y_RA 6 
+#define CHANNELS_RA 4 
+#define SIMD_RA 2 
+#define PRECISION_RA 8 
+#define CROP_DIM_RA 3 
+#define NUM_BOXES_RA 3 
+#define FRAC_BITS_RA 4 
+#define SCORE_WIDTH_RA 4 
+#define COORD_WIDTH_RA 8 
+#define NUM_REPS_RA 2 
@@ -0,0 +1,6 @@
+#define DATA_WIDTH_RT 64 
+#define IMAGE_BYTES_RT 256 
+#define MAX_REPS_RT 4 
+#define SLOTS_RT 3 
+#define DEPTH_RT 2 
+#define NUM_BATCHES_RT 10 
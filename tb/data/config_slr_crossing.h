@@ -0,0 +1,4 @@
+#define WIDTH_SC 96 
+#define STAGES_SC 3 
+#define NUM_WORDS_SC 20 
+#define NUM_REPS_SC 3 
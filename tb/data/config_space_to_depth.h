@@ -0,0 +1,5 @@
+#define IFMDim_S2D 6 
+#define BLOCK_S2D 2 
+#define Channels_S2D 4 
+#define SIMD_S2D 2 
+#define PRECISION_S2D 4 
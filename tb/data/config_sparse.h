@@ -0,0 +1,8 @@
+#define MatrixW_S 32 
+#define MatrixH_S 16 
+#define SIMD_S 4 
+#define PE_S 2 
+#define WIDTH_S 4 
+#define INPUT_PRECISION_S 4 
+#define ACTIVATION_PRECISION_S 16 
+#define NZTILES_S 20 
@@ -0,0 +1,18 @@
+#define IFMDim_SE 3 
+#define Channels_SE 8 
+#define Reduced_SE 4 
+#define PE_SE 2 
+#define SIMD1_SE 4 
+#define PE1_SE 2 
+#define SIMD2_SE 2 
+#define PE2_SE 4 
+#define INPUT_PRECISION_SE 4 
+#define ACC_PRECISION_SE 8 
+#define MID_PRECISION_SE 16 
+#define LUT_PRECISION_SE 20 
+#define SCALE_PRECISION_SE 4 
+#define OUTPUT_PRECISION_SE 8 
+#define WIDTH_SE 4 
+#define ENTRIES_SE 64 
+#define OFFSET_SE -16384 
+#define SHIFT_SE 9 
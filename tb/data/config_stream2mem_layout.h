@@ -0,0 +1,5 @@
+#define DATA_WIDTH_SL 16 
+#define MAX_ROW_WORDS_SL 16 
+#define MAX_BURST_SL 4 
+#define MEM_WORDS_SL 128 
+#define NUM_REPS_SL 3 
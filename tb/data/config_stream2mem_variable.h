@@ -0,0 +1,5 @@
+#define DATA_WIDTH_SV 64 
+#define MAX_BURST_SV 16 
+#define RING_WORDS_SV 100 
+#define MAX_WORDS_SV 40 
+#define NUM_REPS_SV 8 
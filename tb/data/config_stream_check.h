@@ -0,0 +1,5 @@
+#define NUM_CHANNELS_CK 2 
+#define INPUT_WIDTH_CK 8 
+#define OUTPUT_WIDTH_CK 9 
+#define NUM_WORDS_CK 8 
+#define NUM_REPS_CK 3 
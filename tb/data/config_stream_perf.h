@@ -0,0 +1,4 @@
+#define IN_WIDTH_PC 32 
+#define OUT_WIDTH_PC 8 
+#define NUM_WORDS_PC 16 
+#define NUM_REPS_PC 3 
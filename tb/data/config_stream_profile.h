@@ -0,0 +1,6 @@
+#define NUM_CHANNELS_SP 8 
+#define PE_SP 2 
+#define INPUT_WIDTH_SP 4 
+#define OUTPUT_WIDTH_SP 5 
+#define NUM_WORDS_SP 16 
+#define NUM_REPS_SP 3 
@@ -0,0 +1,6 @@
+#define NUM_CHANNELS_SS 8 
+#define PE_SS 2 
+#define NUM_PIXELS_SS 9 
+#define BINS_SS 8 
+#define ELEM_WIDTH_SS 6 
+#define NUM_REPS_SS 3 
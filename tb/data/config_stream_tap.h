@@ -0,0 +1,5 @@
+#define IN_WIDTH_ST 32 
+#define OUT_WIDTH_ST 8 
+#define NUM_WORDS_ST 16 
+#define NUM_REPS_ST 3 
+#define CORRUPT_ST 77 
@@ -0,0 +1,12 @@
+#define KERNEL_DIM_SP 3 
+#define INPUT_PRECISION_SP 4 
+#define IFM_CHANNELS_SP 3 
+#define IFMDIM_SP 8 
+#define OFMDIM_SP 6 
+#define STRIDE_SP 1 
+#define IFM_CHANNELS_FOLDED_SP 4 
+#define SIMD_FOLDED_SP 2 
+#define IFMDIM_FOLDED_SP 9 
+#define OFMDIM_FOLDED_SP 4 
+#define STRIDE_FOLDED_SP 2 
+#define NUM_REPS_SP 2 
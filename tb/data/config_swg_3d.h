@@ -0,0 +1,11 @@
+#define KERNEL_DIM_T_3D 2 
+#define KERNEL_DIM_3D 3 
+#define IFM_Channels_3D 4 
+#define IFMDepth_3D 5 
+#define IFMDim_3D 7 
+#define OFMDepth_3D 2 
+#define OFMDim_3D 3 
+#define STRIDE_T_3D 2 
+#define STRIDE_3D 2 
+#define SIMD_3D 2 
+#define INPUT_PRECISION_3D 8 
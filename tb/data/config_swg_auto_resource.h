@@ -0,0 +1,7 @@
+#define KERNEL_DIM_AR 3 
+#define IFM_Channels_AR 4 
+#define IFMDim_AR 8 
+#define OFMDim_AR 6 
+#define STRIDE_AR 1 
+#define SIMD_AR 2 
+#define INPUT_PRECISION_AR 8 
@@ -0,0 +1,9 @@
+#define KERNEL_DIM_DL 3 
+#define DILATION_DL 2 
+#define IFM_Channels_DL 4 
+#define IFMDim_DL 10 
+#define OFMDim_DL 6 
+#define STRIDE_DL 1 
+#define SIMD_DL 2 
+#define MMV_DL 2 
+#define INPUT_PRECISION_DL 8 
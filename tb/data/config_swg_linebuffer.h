@@ -0,0 +1,7 @@
+#define KERNEL_DIM_LB 3 
+#define IFM_Channels_LB 4 
+#define IFMDim_LB 8 
+#define OFMDim_LB 3 
+#define STRIDE_LB 2 
+#define SIMD_LB 2 
+#define INPUT_PRECISION_LB 8 
@@ -0,0 +1,17 @@
+#define KERNEL_DIM_X_NM 3 
+#define KERNEL_DIM_Y_NM 2 
+#define DILATION_X_NM 2 
+#define DILATION_Y_NM 2 
+#define IFM_Channels_NM 4 
+#define IFMDim_X_NM 11 
+#define IFMDim_Y_NM 7 
+#define OFMDim_X_NM 4 
+#define OFMDim_Y_NM 5 
+#define STRIDE_X_NM 2 
+#define STRIDE_Y_NM 1 
+#define IFMDim_1D_NM 12 
+#define OFMDim_1D_NM 10 
+#define STRIDE_1D_NM 1 
+#define SIMD_NM 2 
+#define MMV_NM 2 
+#define INPUT_PRECISION_NM 8 
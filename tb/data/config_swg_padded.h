@@ -0,0 +1,12 @@
+#define KERNEL_DIM_PD 3 
+#define IFM_Channels_PD 4 
+#define IFMDim_PD 7 
+#define OFMDim_PD 4 
+#define STRIDE_PD 2 
+#define SIMD_PD 2 
+#define INPUT_PRECISION_PD 8 
+#define PAD_TOP_PD 2 
+#define PAD_BOTTOM_PD 1 
+#define PAD_LEFT_PD 1 
+#define PAD_RIGHT_PD 2 
+#define PAD_VALUE_PD 5 
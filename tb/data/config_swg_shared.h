@@ -0,0 +1,5 @@
+#define IFM_Channels_SH 4 
+#define IFMDim_SH 9 
+#define SIMD_SH 2 
+#define INPUT_PRECISION_SH 8 
+#define PAD_VALUE_SH 3 
@@ -0,0 +1,8 @@
+#define MatrixW_SY 8 
+#define MatrixH_SY 32 
+#define SIMD_SY 4 
+#define PE_SY 8 
+#define MMV_SY 2 
+#define WIDTH_SY 4 
+#define INPUT_PRECISION_SY 4 
+#define ACTIVATION_PRECISION_SY 16 
@@ -0,0 +1,6 @@
+#define MatrixW_TN 32 
+#define MatrixH_TN 16 
+#define SIMD_TN 8 
+#define PE_TN 4 
+#define INPUT_PRECISION_TN 4 
+#define ACTIVATION_PRECISION_TN 16 
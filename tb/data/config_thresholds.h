@@ -0,0 +1,5 @@
+#define Channels_T 8 
+#define PE_T 2 
+#define NumTH_T 6 
+#define INPUT_PRECISION_T 8 
+#define OUTPUT_PRECISION_T 3 
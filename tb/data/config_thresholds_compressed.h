@@ -0,0 +1,6 @@
+#define Channels_TC 8 
+#define PE_TC 2 
+#define NumTH_TC 7 
+#define INPUT_PRECISION_TC 16 
+#define DELTA_PRECISION_TC 6 
+#define OUTPUT_PRECISION_TC 3 
@@ -0,0 +1,20 @@
+#define IFMDim_x_TL 14 
+#define IFMDim_y_TL 6 
+#define IFM_Channels_TL 1 
+#define TILE_OUT_TL 3 
+#define INPUT_PRECISION_TL 4 
+#define WIDTH_TL 4 
+#define KERNEL_DIM1_TL 3 
+#define STRIDE1_TL 1 
+#define PAD1_TL 1 
+#define OFM_Channels1_TL 2 
+#define SIMD1_TL 1 
+#define PE1_TL 2 
+#define ACTIVATION_PRECISION1_TL 16 
+#define KERNEL_DIM2_TL 2 
+#define STRIDE2_TL 2 
+#define PAD2_TL 0 
+#define OFM_Channels2_TL 2 
+#define SIMD2_TL 2 
+#define PE2_TL 2 
+#define ACTIVATION_PRECISION2_TL 32 
@@ -0,0 +1,5 @@
+#define DATA_WIDTH_VF 32 
+#define NUM_WORDS_VF 300 
+#define DEPTH_VF 64 
+#define BURST_VF 16 
+#define NUM_REPS_VF 3 
@@ -0,0 +1,6 @@
+#define TILES_WC 24 
+#define CACHED_TILES_WC 10 
+#define SIMD_WC 2 
+#define PE_WC 2 
+#define WP_WC 4 
+#define NUM_REPS_WC 3 
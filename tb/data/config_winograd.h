@@ -0,0 +1,11 @@
+#define IFM_Channels_W 4 
+#define OFM_Channels_W 4 
+#define IFMDim_W 6 
+#define OFMDim_W 4 
+#define SIMD_W 2 
+#define PE_W 2 
+#define WIDTH_W 3 
+#define U_WIDTH_W 8 
+#define INPUT_PRECISION_W 4 
+#define ACC_PRECISION_W 16 
+#define ACTIVATION_PRECISION_W 16 
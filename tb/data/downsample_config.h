@@ -0,0 +1,29 @@
+#define IFMDIM_X_DS 20 
+#define IFMDIM_Y_DS 12 
+#define OFMDIM_X_DS 7 
+#define OFMDIM_Y_DS 5 
+#define FM_CHANNELS_DS 6 
+#define PE_DS 3 
+#define PRECISION_DS 8 
+#define MAX_IFMDIM_X2_DS 32 
+#define IFMDIM_X2_DS 16 
+#define IFMDIM_Y2_DS 15 
+#define OFMDIM_X2_DS 16 
+#define OFMDIM_Y2_DS 6 
+#define FM_CHANNELS2_DS 3 
+#define PRECISION2_DS 8 
+#define IFMDIM_X3_DS 24 
+#define IFMDIM_Y3_DS 10 
+#define OFMDIM_X3_DS 5 
+#define OFMDIM_Y3_DS 4 
+#define FM_CHANNELS3_DS 4 
+#define PE3_DS 2 
+#define PRECISION3_DS 6 
+#define MAX_OFMDIM_X4_DS 16 
+#define MAX_BOX4_DS 4 
+#define IFMDIM_X4_DS 27 
+#define IFMDIM_Y4_DS 13 
+#define OFMDIM_X4_DS 8 
+#define OFMDIM_Y4_DS 5 
+#define FM_CHANNELS4_DS 3 
+#define PRECISION4_DS 8 
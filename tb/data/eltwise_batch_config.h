@@ -0,0 +1,7 @@
+constexpr unsigned  NUM_CHANNELS  = 8;
+constexpr unsigned  PE            = 2;
+constexpr unsigned  INPUT_1_WIDTH = 4;
+constexpr unsigned  INPUT_2_WIDTH = 4;
+constexpr unsigned  OUTPUT_WIDTH  = 8;
+constexpr unsigned  NUM_PIXELS    = 5;
+constexpr unsigned  NUM_REPEAT    = 3;
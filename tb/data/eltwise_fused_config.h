@@ -0,0 +1,8 @@
+constexpr unsigned  NUM_CHANNELS  = 8;
+constexpr unsigned  PE            = 2;
+constexpr unsigned  INPUT_A_WIDTH = 4;
+constexpr unsigned  INPUT_B_WIDTH = 4;
+constexpr unsigned  INPUT_C_WIDTH = 6;
+constexpr unsigned  OUTPUT_WIDTH  = 6;
+constexpr unsigned  NUM_PIXELS    = 5;
+constexpr unsigned  NUM_REPEAT    = 3;
@@ -0,0 +1,69 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random per-channel scales and biases for the fused affine
+#  channel-wise operation testbench.
+#
+import random
+
+outFileParams = open("memdata_affine.h" , "wt")
+outFileConfig = open("config_affine.h" , "wt")
+
+channels = 8
+pe = 2
+img_dim = 4
+input_precision = 6
+scale_precision = 5
+bias_precision = 10
+output_precision = 4
+shift = 5
+
+nf = channels // pe
+
+outFileConfig.write("#define Channels_AF %d \n" % channels)
+outFileConfig.write("#define PE_AF %d \n" % pe)
+outFileConfig.write("#define IMGDIM_AF %d \n" % img_dim)
+outFileConfig.write("#define INPUT_PRECISION_AF %d \n" % input_precision)
+outFileConfig.write("#define SCALE_PRECISION_AF %d \n" % scale_precision)
+outFileConfig.write("#define BIAS_PRECISION_AF %d \n" % bias_precision)
+outFileConfig.write("#define OUTPUT_PRECISION_AF %d \n" % output_precision)
+outFileConfig.write("#define SHIFT_AF %d \n" % shift)
+outFileConfig.close()
+
+outFileParams.write("#ifndef PARAMS_AFFINE_HPP\n")
+outFileParams.write("#define PARAMS_AFFINE_HPP\n")
+outFileParams.write("namespace PARAM_AFFINE{ \n")
+outFileParams.write("static AffineChannelWiseOperation<%d,%d,ap_int<%d>,ap_int<%d>,ap_int<%d>,ap_uint<%d>,%d> affine= {\n" % (nf, pe, input_precision, scale_precision, bias_precision, output_precision, shift))
+scales = ["{ %s }" % ", ".join(str(random.randint(-(1 << (scale_precision-1)), (1 << (scale_precision-1))-1)) for n in range(nf)) for p in range(pe)]
+outFileParams.write("{\n%s\n},\n" % ",\n".join(scales))
+biases = ["{ %s }" % ", ".join(str(random.randint(-(1 << (bias_precision-1)), (1 << (bias_precision-1))-1)) for n in range(nf)) for p in range(pe)]
+outFileParams.write("{\n%s\n}\n" % ",\n".join(biases))
+outFileParams.write("};\n } \n")
+outFileParams.write("#endif \n")
+outFileParams.close()
@@ -0,0 +1,66 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random batch normalization parameters for the batch-norm folding
+#  testbench. The thresholds are derived from them by bn_thresholds.
+#
+import random
+
+outFileParams = open("memdata_bn_fold.h" , "wt")
+outFileConfig = open("config_bn_fold.h" , "wt")
+
+channels = 8
+pe = 2
+num_th = 7
+input_precision = 8
+output_precision = 3
+step = 1.5
+
+outFileConfig.write("#define Channels_BN %d \n" % channels)
+outFileConfig.write("#define PE_BN %d \n" % pe)
+outFileConfig.write("#define NumTH_BN %d \n" % num_th)
+outFileConfig.write("#define INPUT_PRECISION_BN %d \n" % input_precision)
+outFileConfig.write("#define OUTPUT_PRECISION_BN %d \n" % output_precision)
+outFileConfig.close()
+
+scale = [random.uniform(0.02, 0.5) for c in range(channels)]
+bias = [random.uniform(-5.0, 5.0) for c in range(channels)]
+
+outFileParams.write("#ifndef PARAMS_BN_FOLD_HPP\n")
+outFileParams.write("#define PARAMS_BN_FOLD_HPP\n")
+outFileParams.write("namespace PARAM_BN_FOLD{ \n")
+outFileParams.write("static constexpr double SCALE[%d] = { %s };\n" % (channels, ", ".join(repr(s) for s in scale)))
+outFileParams.write("static constexpr double BIAS[%d] = { %s };\n" % (channels, ", ".join(repr(b) for b in bias)))
+outFileParams.write("struct bn {\n")
+outFileParams.write("\tstatic constexpr double scale(unsigned const c) { return SCALE[c]; }\n")
+outFileParams.write("\tstatic constexpr double bias(unsigned const c) { return BIAS[c]; }\n")
+outFileParams.write("\tstatic constexpr double step() { return %s; }\n" % repr(step))
+outFileParams.write("};\n } \n")
+outFileParams.write("#endif \n")
+outFileParams.close()
@@ -0,0 +1,66 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random per-channel scales and zero-points for the dequantization
+#  testbench.
+#
+import random
+
+outFileParams = open("memdata_dequant.h" , "wt")
+outFileConfig = open("config_dequant.h" , "wt")
+
+channels = 16
+pe = 4
+img_dim = 8
+input_precision = 8
+
+nf = channels // pe
+
+outFileConfig.write("#define Channels_DQ %d \n" % channels)
+outFileConfig.write("#define PE_DQ %d \n" % pe)
+outFileConfig.write("#define IMGDIM_DQ %d \n" % img_dim)
+outFileConfig.write("#define INPUT_PRECISION_DQ %d \n" % input_precision)
+outFileConfig.close()
+
+def write_params(name, fmt):
+    outFileParams.write("static DequantActivation<%d,%d,ap_int<%d>,%s> %s= {\n" % (nf, pe, input_precision, fmt, name))
+    scales = ["{ %s }" % ", ".join("%.6ef" % (random.choice([-1, 1]) * random.uniform(1e-3, 0.5)) for n in range(nf)) for p in range(pe)]
+    outFileParams.write("{\n%s\n},\n" % ",\n".join(scales))
+    zeros = ["{ %s }" % ", ".join(str(random.randint(-(1 << (input_precision-2)), (1 << (input_precision-2))-1)) for n in range(nf)) for p in range(pe)]
+    outFileParams.write("{\n%s\n}\n" % ",\n".join(zeros))
+    outFileParams.write("};\n")
+
+outFileParams.write("#ifndef PARAMS_DEQUANT_HPP\n")
+outFileParams.write("#define PARAMS_DEQUANT_HPP\n")
+outFileParams.write("namespace PARAM_DEQUANT{ \n")
+write_params("dequant", "float")
+write_params("dequant_half", "Half")
+outFileParams.write(" } \n")
+outFileParams.write("#endif \n")
+outFileParams.close()
@@ -0,0 +1,86 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates the table of a LUTActivation for a quantized nonlinearity.
+#  Entry i covers the accumulator values offset + (i << shift) and up, it is
+#  filled with the function evaluated at the center of that range, scaled by
+#  input_scale, then quantized with output_scale and clipped to the output
+#  precision.
+#
+import math
+
+outFileTable = open("memdata_lut.h" , "wt")
+outFileConfig = open("config_lut.h" , "wt")
+
+functions = {
+	"sigmoid"   : lambda x: 1.0 / (1.0 + math.exp(-x)),
+	"tanh"      : math.tanh,
+	"hardswish" : lambda x: x * min(max(x + 3.0, 0.0), 6.0) / 6.0,
+	"gelu"      : lambda x: 0.5 * x * (1.0 + math.erf(x / math.sqrt(2.0))),
+}
+
+function = "sigmoid"
+channels = 8
+pe = 2
+input_precision = 10
+offset = -512
+shift = 2
+entries = 256
+input_scale = 1.0 / 32
+output_precision = 8
+output_signed = False
+output_scale = 255.0
+
+outFileConfig.write("#define Channels_L %d \n" % channels)
+outFileConfig.write("#define PE_L %d \n" % pe)
+outFileConfig.write("#define INPUT_PRECISION_L %d \n" % input_precision)
+outFileConfig.write("#define OFFSET_L %d \n" % offset)
+outFileConfig.write("#define SHIFT_L %d \n" % shift)
+outFileConfig.write("#define ENTRIES_L %d \n" % entries)
+outFileConfig.write("#define OUTPUT_PRECISION_L %d \n" % output_precision)
+outFileConfig.close()
+
+if output_signed:
+	lo, hi = -(1 << (output_precision-1)), (1 << (output_precision-1)) - 1
+else:
+	lo, hi = 0, (1 << output_precision) - 1
+fxn = functions[function]
+table = []
+for i in range(entries):
+	x = (offset + (i << shift) + ((1 << shift) - 1) / 2.0) * input_scale
+	table.append(min(max(int(round(fxn(x) * output_scale)), lo), hi))
+
+outFileTable.write("#ifndef PARAMS_LUT_HPP\n")
+outFileTable.write("#define PARAMS_LUT_HPP\n")
+outFileTable.write("namespace PARAM_LUT{ \n")
+outFileTable.write("static LUTActivation<ap_int<%d>,ap_%sint<%d>,%d,%d,%d> lut= {\n{\n" % (input_precision, "" if output_signed else "u", output_precision, entries, offset, shift))
+outFileTable.write(",\n".join(", ".join(str(v) for v in table[i:i+16]) for i in range(0, entries, 16)))
+outFileTable.write("\n}\n};\n } \n")
+outFileTable.write("#endif \n")
+outFileTable.close()
@@ -0,0 +1,87 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random weights and thresholds for the parameter file testbench,
+#  both as the usual headers for synthesis and as binary parameter files that
+#  the testbench loads with tb/param_file.hpp.
+#
+import random
+import param_file
+
+outFileParams = open("memdata_param_file.h" , "wt")
+outFileConfig = open("config_param_file.h" , "wt")
+
+matrix_w = 32
+matrix_h = 16
+simd = 4
+pe = 4
+w_precision = 4
+input_precision = 4
+acc_precision = 16
+num_th = 3
+output_precision = 2
+
+nf = matrix_h // pe
+sf = matrix_w // simd
+tiles = nf * sf
+
+outFileConfig.write("#define MatrixW_PF %d \n" % matrix_w)
+outFileConfig.write("#define MatrixH_PF %d \n" % matrix_h)
+outFileConfig.write("#define SIMD_PF %d \n" % simd)
+outFileConfig.write("#define PE_PF %d \n" % pe)
+outFileConfig.write("#define WIDTH_PF %d \n" % w_precision)
+outFileConfig.write("#define INPUT_PRECISION_PF %d \n" % input_precision)
+outFileConfig.write("#define ACC_PRECISION_PF %d \n" % acc_precision)
+outFileConfig.write("#define NUM_TH_PF %d \n" % num_th)
+outFileConfig.write("#define OUTPUT_PRECISION_PF %d \n" % output_precision)
+outFileConfig.close()
+
+# weight words in m_weights[pe][nf*SF + sf] order, row nf*PE + pe of the matrix
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+words = [[param_file.pack([random.randint(lo, hi) for i in range(simd)], w_precision) for t in range(tiles)] for p in range(pe)]
+
+# sorted thresholds around the range of the dot products
+bound = matrix_w * (1 << (w_precision-1)) * ((1 << input_precision)-1) // 4
+thresholds = [[sorted(random.randint(-bound, bound) for i in range(num_th)) for n in range(nf)] for p in range(pe)]
+
+outFileParams.write("#ifndef PARAMS_PARAM_FILE_HPP\n")
+outFileParams.write("#define PARAMS_PARAM_FILE_HPP\n")
+outFileParams.write("namespace PARAM_PF{ \n")
+outFileParams.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> weights= {\n{\n" % (simd, w_precision, pe, tiles))
+outFileParams.write(",\n".join("{\n%s\n}" % ",\n".join(hex(w) for w in words[p]) for p in range(pe)))
+outFileParams.write("\n}\n};\n")
+outFileParams.write("static ThresholdsActivation<%d,%d,%d,ap_int<%d>,ap_uint<%d>> threshs= {\n{\n" % (nf, pe, num_th, acc_precision, output_precision))
+outFileParams.write(",\n".join("{\n%s\n}" % ",\n".join("{ %s }" % ", ".join(str(t) for t in thresholds[p][n]) for n in range(nf)) for p in range(pe)))
+outFileParams.write("\n}\n};\n } \n")
+outFileParams.write("#endif \n")
+outFileParams.close()
+
+param_file.write_weights("params_param_file.bin", words, simd * w_precision)
+param_file.write_thresholds("thresholds_param_file.bin", thresholds, acc_precision, True)
@@ -0,0 +1,66 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random per-channel requantization parameters for the
+#  requantization activation testbench.
+#
+import random
+
+outFileParams = open("memdata_requant.h" , "wt")
+outFileConfig = open("config_requant.h" , "wt")
+
+channels = 8
+pe = 2
+input_precision = 20
+mult_precision = 16
+output_precision = 8
+zero_point = -5
+
+nf = channels // pe
+
+outFileConfig.write("#define Channels_RQ %d \n" % channels)
+outFileConfig.write("#define PE_RQ %d \n" % pe)
+outFileConfig.write("#define INPUT_PRECISION_RQ %d \n" % input_precision)
+outFileConfig.write("#define MULT_PRECISION_RQ %d \n" % mult_precision)
+outFileConfig.write("#define OUTPUT_PRECISION_RQ %d \n" % output_precision)
+outFileConfig.write("#define ZERO_POINT_RQ %d \n" % zero_point)
+outFileConfig.close()
+
+outFileParams.write("#ifndef PARAMS_REQUANT_HPP\n")
+outFileParams.write("#define PARAMS_REQUANT_HPP\n")
+outFileParams.write("namespace PARAM_REQUANT{ \n")
+outFileParams.write("static RequantActivation<%d,%d,ap_int<%d>,ap_int<%d>,ap_int<%d>,ap_uint<6>,%d> requant= {\n" % (nf, pe, input_precision, output_precision, mult_precision, zero_point))
+mults = ["{ %s }" % ", ".join(str(random.randint(-(1 << (mult_precision-1)), (1 << (mult_precision-1))-1)) for n in range(nf)) for p in range(pe)]
+outFileParams.write("{\n%s\n},\n" % ",\n".join(mults))
+# shift 0 included to cover the case without rounding
+shifts = ["{ %s }" % ", ".join(str(0 if (n == 0 and p == 0) else random.randint(14, 28)) for n in range(nf)) for p in range(pe)]
+outFileParams.write("{\n%s\n}\n" % ",\n".join(shifts))
+outFileParams.write("};\n } \n")
+outFileParams.write("#endif \n")
+outFileParams.close()
@@ -0,0 +1,89 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random sorted thresholds for the thresholding testbench in
+#  ThresholdsActivation layout.
+#
+import random
+import sys
+import param_file
+
+# with --binary, the thresholds are written to memdata_thresholds.bin and memdata_thresholds.h only
+# loads them from there through tb/param_file.hpp, so that they need not be compiled
+binary = "--binary" in sys.argv
+
+outFileThresholds = open("memdata_thresholds.h" , "wt")
+outFileConfig = open("config_thresholds.h" , "wt")
+
+channels = 8
+pe = 2
+num_th = 6
+input_precision = 8
+output_precision = 3
+
+nf = channels // pe
+
+outFileConfig.write("#define Channels_T %d \n" % channels)
+outFileConfig.write("#define PE_T %d \n" % pe)
+outFileConfig.write("#define NumTH_T %d \n" % num_th)
+outFileConfig.write("#define INPUT_PRECISION_T %d \n" % input_precision)
+outFileConfig.write("#define OUTPUT_PRECISION_T %d \n" % output_precision)
+outFileConfig.close()
+
+lo = -(1 << (input_precision-1))
+hi = (1 << (input_precision-1)) - 1
+outFileThresholds.write("#ifndef PARAMS_THRESHOLDS_HPP\n")
+outFileThresholds.write("#define PARAMS_THRESHOLDS_HPP\n")
+threshs_type = "ThresholdsActivationBinarySearch<%d,%d,%d,ap_int<%d>,ap_uint<%d>>" % (nf, pe, num_th, input_precision, output_precision)
+pes = []
+values = []
+for p in range(pe):
+	rows = []
+	values.append([])
+	for n in range(nf):
+		# sorted, duplicates allowed
+		th = sorted(random.randint(lo, hi) for t in range(num_th))
+		values[p].append(th)
+		rows.append("{ %s }" % ", ".join(str(t) for t in th))
+	pes.append("{\n%s\n}" % ",\n".join(rows))
+if binary:
+	outFileThresholds.write("#include \"param_file.hpp\"\n")
+outFileThresholds.write("namespace PARAM_THRESHOLDS{ \n")
+if binary:
+	outFileThresholds.write("static %s threshs = load_params<%s>(param_path(__FILE__, \"memdata_thresholds.bin\"));\n" % (threshs_type, threshs_type))
+else:
+	outFileThresholds.write("static %s threshs= {\n{\n" % threshs_type)
+	outFileThresholds.write(",\n".join(pes))
+	outFileThresholds.write("\n}\n};\n")
+outFileThresholds.write(" } \n")
+outFileThresholds.write("#endif \n")
+outFileThresholds.close()
+
+if binary:
+	param_file.write_thresholds("memdata_thresholds.bin", values, input_precision, True)
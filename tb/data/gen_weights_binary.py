@@ -0,0 +1,79 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random binary weights for the binarized MVAU testbench, one
+#  layer with a SIMD that is not a multiple of the six bit popcount leaves
+#  and one with a wide SIMD, together with the plain weight bits for the
+#  golden model.
+#
+import random
+
+outFileWeights = open("memdata_binary.h" , "wt")
+outFileConfig = open("config_binary.h" , "wt")
+
+# suffix, matrix_w, matrix_h, simd, pe
+layers = [("BS", 33, 8, 11, 4), ("BL", 200, 4, 100, 2)]
+activation_precision = 16
+
+outFileWeights.write("#ifndef PARAMS_BINARY_HPP\n")
+outFileWeights.write("#define PARAMS_BINARY_HPP\n")
+outFileWeights.write("namespace PARAM_BINARY{ \n")
+for (suf, matrix_w, matrix_h, simd, pe) in layers:
+	nf = matrix_h // pe
+	sf = matrix_w // simd
+	raw = [[random.randint(0, 1) for c in range(matrix_w)] for r in range(matrix_h)]
+
+	outFileConfig.write("#define MatrixW_%s %d \n" % (suf, matrix_w))
+	outFileConfig.write("#define MatrixH_%s %d \n" % (suf, matrix_h))
+	outFileConfig.write("#define SIMD_%s %d \n" % (suf, simd))
+	outFileConfig.write("#define PE_%s %d \n" % (suf, pe))
+
+	# bit i of tile nf*SF + sf of PE pe is column sf*SIMD + i of row nf*PE + pe
+	outFileWeights.write("static BinaryWeights<%d,%d,%d> weights_%s= {\n{\n" % (simd, pe, nf*sf, suf.lower()))
+	words = []
+	for p in range(pe):
+		vals = []
+		for n in range(nf):
+			for s in range(sf):
+				val = 0
+				for i in range(simd):
+					val |= raw[n*pe + p][s*simd + i] << i
+				vals.append("\"%s\"" % hex(val))
+		words.append("{\n%s\n}" % ",\n".join(vals))
+	outFileWeights.write(",\n".join(words))
+	outFileWeights.write("\n}\n};\n")
+	outFileWeights.write("static int const raw_%s[%d][%d] = {\n" % (suf.lower(), matrix_h, matrix_w))
+	outFileWeights.write(",\n".join("{%s}" % ", ".join(str(raw[r][c]) for c in range(matrix_w)) for r in range(matrix_h)))
+	outFileWeights.write("\n};\n")
+outFileWeights.write(" } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
+
+outFileConfig.write("#define ACTIVATION_PRECISION_BN %d \n" % activation_precision)
+outFileConfig.close()
@@ -0,0 +1,90 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random centroid indices and per-PE codebooks for the codebook
+#  weight MVAU testbench in CodebookWeights layout, together with the decoded
+#  weights for the golden model.
+#
+import random
+
+outFileWeights = open("memdata_codebook.h" , "wt")
+outFileConfig = open("config_codebook.h" , "wt")
+
+matrix_w = 32
+matrix_h = 16
+simd = 4
+pe = 4
+index_bits = 4
+w_precision = 8
+input_precision = 4
+activation_precision = 16
+
+nf = matrix_h // pe
+sf = matrix_w // simd
+centroids = 1 << index_bits
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+codebook = [[random.randint(lo, hi) for c in range(centroids)] for p in range(pe)]
+index = [[random.randrange(centroids) for c in range(matrix_w)] for r in range(matrix_h)]
+
+outFileConfig.write("#define MatrixW_CB %d \n" % matrix_w)
+outFileConfig.write("#define MatrixH_CB %d \n" % matrix_h)
+outFileConfig.write("#define SIMD_CB %d \n" % simd)
+outFileConfig.write("#define PE_CB %d \n" % pe)
+outFileConfig.write("#define INDEX_BITS_CB %d \n" % index_bits)
+outFileConfig.write("#define WIDTH_CB %d \n" % w_precision)
+outFileConfig.write("#define INPUT_PRECISION_CB %d \n" % input_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_CB %d \n" % activation_precision)
+outFileConfig.close()
+
+outFileWeights.write("#ifndef PARAMS_CODEBOOK_HPP\n")
+outFileWeights.write("#define PARAMS_CODEBOOK_HPP\n")
+outFileWeights.write("namespace PARAM_CODEBOOK{ \n")
+outFileWeights.write("static CodebookWeights<%d,ap_int<%d>,%d,%d,%d> weights= {\n{\n" % (simd, w_precision, pe, nf*sf, index_bits))
+pes = []
+for p in range(pe):
+	vals = []
+	for n in range(nf):
+		for s in range(sf):
+			val = 0
+			for i in range(simd):
+				val |= index[n*pe + p][s*simd + i] << (i*index_bits)
+			vals.append(hex(val))
+	pes.append("{\n%s\n}" % ",\n".join(vals))
+outFileWeights.write(",\n".join(pes))
+outFileWeights.write("\n},\n{\n")
+outFileWeights.write(",\n".join("{ %s }" % ", ".join(str(c) for c in codebook[p]) for p in range(pe)))
+outFileWeights.write("\n}\n};\n")
+# row r of the matrix is computed by PE r % PE
+outFileWeights.write("static int const raw[%d][%d] = {\n" % (matrix_h, matrix_w))
+outFileWeights.write(",\n".join("{%s}" % ", ".join(str(codebook[r % pe][index[r][c]]) for c in range(matrix_w)) for r in range(matrix_h)))
+outFileWeights.write("\n};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
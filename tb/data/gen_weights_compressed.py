@@ -0,0 +1,97 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random parameter words of small weights for the testbench of the
+#  parameter stream decompression, together with their compressed streams.
+#
+import random
+from weight_compression import compress
+
+outFileWeights = open("memdata_compressed.h" , "wt")
+outFileConfig = open("config_compressed.h" , "wt")
+
+# instance 1: signed weights, four lane groups, narrow input
+tiles = 48
+simd = 4
+pe = 4
+wp = 4
+groups = 4
+in_width = 32
+# instance 2: unsigned weights, one lane group
+tiles2 = 40
+simd2 = 4
+pe2 = 2
+wp2 = 3
+in_width2 = 16
+
+def small(wp, signed):
+	# Laplacian-like weights, mostly close to zero
+	hi = (1 << (wp-1)) - 1 if signed else (1 << wp) - 1
+	lo = -(1 << (wp-1)) if signed else 0
+	v = int(random.expovariate(0.9))
+	if signed and random.random() < 0.5:
+		v = -v
+	return max(lo, min(hi, v))
+
+words = [[small(wp, True) for l in range(simd*pe)] for t in range(tiles)]
+words2 = [[small(wp2, False) for l in range(simd2*pe2)] for t in range(tiles2)]
+comp = compress(words, wp, groups, in_width, True)
+comp2 = compress(words2, wp2, 1, in_width2, False)
+
+outFileConfig.write("#define TILES_DC %d \n" % tiles)
+outFileConfig.write("#define SIMD_DC %d \n" % simd)
+outFileConfig.write("#define PE_DC %d \n" % pe)
+outFileConfig.write("#define WP_DC %d \n" % wp)
+outFileConfig.write("#define GROUPS_DC %d \n" % groups)
+outFileConfig.write("#define IN_WIDTH_DC %d \n" % in_width)
+outFileConfig.write("#define IN_WORDS_DC %d \n" % len(comp))
+outFileConfig.write("#define TILES2_DC %d \n" % tiles2)
+outFileConfig.write("#define SIMD2_DC %d \n" % simd2)
+outFileConfig.write("#define PE2_DC %d \n" % pe2)
+outFileConfig.write("#define WP2_DC %d \n" % wp2)
+outFileConfig.write("#define IN_WIDTH2_DC %d \n" % in_width2)
+outFileConfig.write("#define IN_WORDS2_DC %d \n" % len(comp2))
+outFileConfig.close()
+
+def word(lanes, wp):
+	val = 0
+	for i, v in enumerate(lanes):
+		val |= (v & ((1 << wp) - 1)) << (i*wp)
+	return val
+
+outFileWeights.write("#ifndef PARAMS_COMPRESSED_HPP\n")
+outFileWeights.write("#define PARAMS_COMPRESSED_HPP\n")
+outFileWeights.write("namespace PARAM_COMPRESSED{ \n")
+outFileWeights.write("static unsigned long long const compressed[%d] = {\n%s\n};\n" % (len(comp), ",\n".join(hex(w) for w in comp)))
+outFileWeights.write("static unsigned long long const raw[%d] = {\n%s\n};\n" % (tiles, ",\n".join(hex(word(w, wp)) for w in words)))
+outFileWeights.write("static unsigned long long const compressed2[%d] = {\n%s\n};\n" % (len(comp2), ",\n".join(hex(w) for w in comp2)))
+outFileWeights.write("static unsigned long long const raw2[%d] = {\n%s\n};\n" % (tiles2, ",\n".join(hex(word(w, wp2)) for w in words2)))
+outFileWeights.write(" } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,77 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random weights for the runtime-sized convolutional layer
+#  testbench in FixedPointWeights layout.
+#
+import random
+
+outFileWeights = open("memdata_conv_dynamic.h" , "wt")
+outFileConfig = open("config_conv_dynamic.h" , "wt")
+
+kernel_dim = 3
+ifm_ch = 4
+ofm_ch = 4
+max_ifm_dim = 9
+max_stride = 2
+simd = 2
+pe = 2
+w_precision = 4
+input_precision = 4
+activation_precision = 16
+
+nf = ofm_ch // pe
+sf = kernel_dim * kernel_dim * ifm_ch // simd
+
+outFileConfig.write("#define KERNEL_DIM_D %d \n" % kernel_dim)
+outFileConfig.write("#define IFM_Channels_D %d \n" % ifm_ch)
+outFileConfig.write("#define OFM_Channels_D %d \n" % ofm_ch)
+outFileConfig.write("#define MaxIFMDim_D %d \n" % max_ifm_dim)
+outFileConfig.write("#define MaxStride_D %d \n" % max_stride)
+outFileConfig.write("#define SIMD_D %d \n" % simd)
+outFileConfig.write("#define PE_D %d \n" % pe)
+outFileConfig.write("#define WIDTH_D %d \n" % w_precision)
+outFileConfig.write("#define INPUT_PRECISION_D %d \n" % input_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_D %d \n" % activation_precision)
+outFileConfig.close()
+
+outFileWeights.write("#ifndef PARAMS_CONV_DYNAMIC_HPP\n")
+outFileWeights.write("#define PARAMS_CONV_DYNAMIC_HPP\n")
+outFileWeights.write("namespace PARAM_CONV_DYNAMIC{ \n")
+outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> weights= {\n{\n" %(simd,w_precision,pe,nf*sf))
+for p in range(pe):
+	outFileWeights.write("{ \n")
+	vals = [hex(random.randint(0, (1<<(simd*w_precision))-1)) for t in range(nf*sf)]
+	outFileWeights.write(",\n".join(vals))
+	outFileWeights.write("} \n")
+	if p!=pe-1:
+		outFileWeights.write(",")
+outFileWeights.write("}\n};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,108 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random weights and sorted thresholds for the fused convolution
+#  and max pooling testbench, together with the raw weights for the golden model.
+#
+import random
+
+outFileWeights = open("memdata_conv_pool.h" , "wt")
+outFileConfig = open("config_conv_pool.h" , "wt")
+
+kernel_dim = 3
+ifm_ch = 4
+ofm_ch = 4
+ifm_dim = 10
+pool_dim = 2
+simd = 2
+pe = 2
+w_precision = 4
+input_precision = 4
+acc_precision = 16
+activation_precision = 2
+num_th = 3
+
+ofm_dim = ifm_dim - kernel_dim + 1
+matrix_w = kernel_dim * kernel_dim * ifm_ch
+nf = ofm_ch // pe
+sf = matrix_w // simd
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+raw = [[[[random.randint(lo, hi) for c in range(ifm_ch)] for kx in range(kernel_dim)] for ky in range(kernel_dim)] for o in range(ofm_ch)]
+th = [sorted(random.randint(-400, 400) for t in range(num_th)) for o in range(ofm_ch)]
+
+outFileConfig.write("#define KERNEL_DIM_CP %d \n" % kernel_dim)
+outFileConfig.write("#define IFM_Channels_CP %d \n" % ifm_ch)
+outFileConfig.write("#define OFM_Channels_CP %d \n" % ofm_ch)
+outFileConfig.write("#define IFMDim_CP %d \n" % ifm_dim)
+outFileConfig.write("#define OFMDim_CP %d \n" % ofm_dim)
+outFileConfig.write("#define POOL_DIM_CP %d \n" % pool_dim)
+outFileConfig.write("#define SIMD_CP %d \n" % simd)
+outFileConfig.write("#define PE_CP %d \n" % pe)
+outFileConfig.write("#define WIDTH_CP %d \n" % w_precision)
+outFileConfig.write("#define INPUT_PRECISION_CP %d \n" % input_precision)
+outFileConfig.write("#define ACC_PRECISION_CP %d \n" % acc_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_CP %d \n" % activation_precision)
+outFileConfig.write("#define NumTH_CP %d \n" % num_th)
+outFileConfig.close()
+
+outFileWeights.write("#ifndef PARAMS_CONV_POOL_HPP\n")
+outFileWeights.write("#define PARAMS_CONV_POOL_HPP\n")
+outFileWeights.write("namespace PARAM_CONV_POOL{ \n")
+outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> weights= {\n{\n" %(simd,w_precision,pe,nf*sf))
+for p in range(pe):
+	outFileWeights.write("{ \n")
+	vals = []
+	for n in range(nf):
+		for s in range(sf):
+			val = 0
+			for i in range(simd):
+				col = s*simd + i
+				ky = (col // ifm_ch) // kernel_dim
+				kx = (col // ifm_ch) % kernel_dim
+				w = raw[n*pe + p][ky][kx][col % ifm_ch] & ((1 << w_precision)-1)
+				val |= w << (i*w_precision)
+			vals.append(hex(val))
+	outFileWeights.write(",\n".join(vals))
+	outFileWeights.write("} \n")
+	if p!=pe-1:
+		outFileWeights.write(",")
+outFileWeights.write("}\n};\n")
+outFileWeights.write("static ThresholdsActivation<%d,%d,%d,ap_int<%d>,ap_uint<%d>> threshs= {\n{\n" % (nf, pe, num_th, acc_precision, activation_precision))
+outFileWeights.write(",\n".join("{\n%s\n}" % ",\n".join("{ %s }" % ", ".join(str(t) for t in th[n*pe + p]) for n in range(nf)) for p in range(pe)))
+outFileWeights.write("\n}\n};\n")
+outFileWeights.write("static int const raw[%d][%d][%d][%d] = {\n" % (ofm_ch, kernel_dim, kernel_dim, ifm_ch))
+outFileWeights.write(",\n".join("{" + ", ".join("{" + ", ".join("{%s}" % ", ".join(str(v) for v in raw[o][ky][kx]) for kx in range(kernel_dim)) + "}" for ky in range(kernel_dim)) + "}" for o in range(ofm_ch)))
+outFileWeights.write("\n};\n")
+outFileWeights.write("static int const raw_th[%d][%d] = {\n" % (ofm_ch, num_th))
+outFileWeights.write(",\n".join("{%s}" % ", ".join(str(t) for t in th[o]) for o in range(ofm_ch)))
+outFileWeights.write("\n};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,106 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random weights for the transposed convolution testbench and
+#  writes them both in their raw form (for the golden model) and split into
+#  the Stride*Stride sub-pixel phase matrices in FixedPointWeights layout.
+#
+import random
+
+outFileWeights = open("memdata_deconv.h" , "wt")
+outFileConfig = open("config_deconv.h" , "wt")
+
+ifm_ch = 4
+ofm_ch = 4
+kernel_dim = 4
+stride = 2
+padding = 1
+ifm_dim = 4
+simd = 2
+pe = 2
+w_precision = 4
+input_precision = 4
+activation_precision = 16
+
+ofm_dim = (ifm_dim - 1) * stride + kernel_dim - 2 * padding
+taps = kernel_dim // stride
+matrix_w = taps * taps * ifm_ch
+nf = ofm_ch // pe
+sf = matrix_w // simd
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+raw = [[[[random.randint(lo, hi) for c in range(ifm_ch)] for kx in range(kernel_dim)] for ky in range(kernel_dim)] for o in range(ofm_ch)]
+
+outFileConfig.write("#define IFM_Channels_DC %d \n" % ifm_ch)
+outFileConfig.write("#define OFM_Channels_DC %d \n" % ofm_ch)
+outFileConfig.write("#define KERNEL_DIM_DC %d \n" % kernel_dim)
+outFileConfig.write("#define STRIDE_DC %d \n" % stride)
+outFileConfig.write("#define PADDING_DC %d \n" % padding)
+outFileConfig.write("#define IFMDim_DC %d \n" % ifm_dim)
+outFileConfig.write("#define OFMDim_DC %d \n" % ofm_dim)
+outFileConfig.write("#define SIMD_DC %d \n" % simd)
+outFileConfig.write("#define PE_DC %d \n" % pe)
+outFileConfig.write("#define WIDTH_DC %d \n" % w_precision)
+outFileConfig.write("#define INPUT_PRECISION_DC %d \n" % input_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_DC %d \n" % activation_precision)
+outFileConfig.close()
+
+outFileWeights.write("#ifndef PARAMS_DECONV_HPP\n")
+outFileWeights.write("#define PARAMS_DECONV_HPP\n")
+outFileWeights.write("namespace PARAM_DECONV{ \n")
+outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> weights= {\n{\n" %(simd,w_precision,pe,stride*stride*nf*sf))
+for p in range(pe):
+	outFileWeights.write("{ \n")
+	vals = []
+	for ph in range(stride*stride):
+		py = ph // stride
+		px = ph % stride
+		for n in range(nf):
+			for s in range(sf):
+				val = 0
+				for i in range(simd):
+					col = s*simd + i
+					ty = (col // ifm_ch) // taps
+					tx = (col // ifm_ch) % taps
+					ky = py + (taps-1-ty) * stride
+					kx = px + (taps-1-tx) * stride
+					w = raw[n*pe + p][ky][kx][col % ifm_ch] & ((1 << w_precision)-1)
+					val |= w << (i*w_precision)
+				vals.append(hex(val))
+	outFileWeights.write(",\n".join(vals))
+	outFileWeights.write("} \n")
+	if p!=pe-1:
+		outFileWeights.write(",")
+outFileWeights.write("}\n};\n")
+outFileWeights.write("static int const raw[%d][%d][%d][%d] = {\n" % (ofm_ch, kernel_dim, kernel_dim, ifm_ch))
+outFileWeights.write(",\n".join("{" + ", ".join("{" + ", ".join("{%s}" % ", ".join(str(v) for v in raw[o][ky][kx]) for kx in range(kernel_dim)) + "}" for ky in range(kernel_dim)) + "}" for o in range(ofm_ch)))
+outFileWeights.write("\n};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,84 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random depthwise and pointwise weights for the fused depthwise
+#  separable layer testbench in FixedPointWeights layout.
+#
+import random
+
+outFileWeights = open("memdata_dws_separable.h" , "wt")
+outFileConfig = open("config_dws_separable.h" , "wt")
+
+ifm_ch = 12
+ofm_ch = 8
+kernel_dim = 3
+ifm_dim = 6
+dw_simd = 3
+dw_pe = 2
+pw_pe = 4
+w_precision = 4
+input_precision = 4
+mid_precision = 12
+activation_precision = 24
+
+k2 = kernel_dim * kernel_dim
+
+def write_weights(name, simd, pe, tiles):
+	outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> %s= {\n{\n" %(simd,w_precision,pe,tiles,name))
+	for p in range(pe):
+		outFileWeights.write("{ \n")
+		vals = [hex(random.randint(0, (1<<(simd*w_precision))-1)) for t in range(tiles)]
+		outFileWeights.write(",\n".join(vals))
+		outFileWeights.write("} \n")
+		if p!=pe-1:
+			outFileWeights.write(",")
+	outFileWeights.write("}\n};\n")
+
+outFileConfig.write("#define IFM_Channels_DS %d \n" % ifm_ch)
+outFileConfig.write("#define OFM_Channels_DS %d \n" % ofm_ch)
+outFileConfig.write("#define KERNEL_DIM_DS %d \n" % kernel_dim)
+outFileConfig.write("#define IFMDim_DS %d \n" % ifm_dim)
+outFileConfig.write("#define OFMDim_DS %d \n" % (ifm_dim - kernel_dim + 1))
+outFileConfig.write("#define DW_SIMD_DS %d \n" % dw_simd)
+outFileConfig.write("#define DW_PE_DS %d \n" % dw_pe)
+outFileConfig.write("#define PW_PE_DS %d \n" % pw_pe)
+outFileConfig.write("#define WIDTH_DS %d \n" % w_precision)
+outFileConfig.write("#define INPUT_PRECISION_DS %d \n" % input_precision)
+outFileConfig.write("#define MID_PRECISION_DS %d \n" % mid_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_DS %d \n" % activation_precision)
+outFileConfig.close()
+
+outFileWeights.write("#ifndef PARAMS_DWS_SEPARABLE_HPP\n")
+outFileWeights.write("#define PARAMS_DWS_SEPARABLE_HPP\n")
+outFileWeights.write("namespace PARAM_DWS_SEPARABLE{ \n")
+write_weights("dw_weights", dw_simd, dw_pe, (ifm_ch // dw_pe) * (k2 // dw_simd))
+write_weights("pw_weights", dw_pe, pw_pe, (ofm_ch // pw_pe) * (ifm_ch // dw_pe))
+outFileWeights.write(" } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
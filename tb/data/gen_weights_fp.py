@@ -0,0 +1,111 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#
+#  Generates random half and bfloat16 weights, the parameters of the float to
+#  integer requantization and the float thresholds for the floating-point
+#  compute testbench, together with the raw bits for the golden model.
+#
+import random
+import struct
+
+outFileWeights = open("memdata_fp.h" , "wt")
+outFileConfig = open("config_fp.h" , "wt")
+
+matrix_w = 8
+matrix_h = 8
+simd = 4
+pe = 2
+output_precision = 8
+num_th = 3
+
+outFileConfig.write("#define MatrixW_FP %d \n" % matrix_w)
+outFileConfig.write("#define MatrixH_FP %d \n" % matrix_h)
+outFileConfig.write("#define SIMD_FP %d \n" % simd)
+outFileConfig.write("#define PE_FP %d \n" % pe)
+outFileConfig.write("#define OUTPUT_PRECISION_FP %d \n" % output_precision)
+outFileConfig.write("#define NUM_TH_FP %d \n" % num_th)
+outFileConfig.close()
+
+def half_bits(val):
+	return struct.unpack("<H", struct.pack("<e", val))[0]
+
+def bf16_bits(val):
+	# the values are drawn with at most 7 mantissa bits, so truncation is exact
+	return struct.unpack("<I", struct.pack("<f", val))[0] >> 16
+
+def rand_val():
+	return random.randint(-64, 64) / 32.0
+
+nf = matrix_h // pe
+sf = matrix_w // simd
+
+def write_weights(name, type_name, bits):
+	raw = [[bits(rand_val()) for c in range(matrix_w)] for r in range(matrix_h)]
+	outFileWeights.write("static FixedPointWeights<%d,%s,%d,%d> %s= {\n{\n" %(simd,type_name,pe,nf*sf,name))
+	for p in range(pe):
+		outFileWeights.write("{ \n")
+		vals = []
+		for n in range(nf):
+			for s in range(sf):
+				val = 0
+				for i in range(simd):
+					val |= raw[n*pe + p][s*simd + i] << (i*16)
+				vals.append(hex(val))
+		outFileWeights.write(",\n".join(vals))
+		outFileWeights.write("} \n")
+		if p!=pe-1:
+			outFileWeights.write(",")
+	outFileWeights.write("}\n};\n")
+	outFileWeights.write("static unsigned const %s_raw[%d][%d] = {\n" % (name, matrix_h, matrix_w))
+	outFileWeights.write(",\n".join("{%s}" % ", ".join(hex(v) for v in raw[r]) for r in range(matrix_h)))
+	outFileWeights.write("\n};\n")
+
+def pe_nf(vals):
+	return "{%s}" % ", ".join("{%s}" % ", ".join(vals[n*pe + p] for n in range(nf)) for p in range(pe))
+
+outFileWeights.write("#ifndef PARAMS_FP_HPP\n")
+outFileWeights.write("#define PARAMS_FP_HPP\n")
+outFileWeights.write("namespace PARAM_FP{ \n")
+write_weights("weights_half", "Half", half_bits)
+write_weights("weights_bf16", "BFloat16", bf16_bits)
+
+scale = ["%sf" % repr(random.randint(1, 16) / 4.0) for r in range(matrix_h)]
+bias = ["%sf" % repr(random.randint(-32, 32) / 2.0) for r in range(matrix_h)]
+outFileWeights.write("static FloatRequantActivation<%d,%d,ap_int<%d> > requant= {\n%s,\n%s\n};\n" % (nf, pe, output_precision, pe_nf(scale), pe_nf(bias)))
+
+# thresholds of the Thresholding_Batch over MatrixH channels, ascending per channel
+ths = []
+for r in range(matrix_h):
+	th = sorted(random.randint(-64, 64) / 16.0 for i in range(num_th))
+	ths.append("{%s}" % ", ".join("%sf" % repr(t) for t in th))
+outFileWeights.write("static ThresholdsActivation<%d,%d,%d,float,ap_uint<2> > thresholds= {\n%s\n};\n" % (nf, pe, num_th, pe_nf(ths)))
+outFileWeights.write(" } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,86 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random power-of-two weights for the power-of-two weight MVAU
+#  testbench in LogWeights layout (sign and exponent per lane), together with
+#  the weight values for the golden model.
+#
+import random
+
+outFileWeights = open("memdata_log.h" , "wt")
+outFileConfig = open("config_log.h" , "wt")
+
+matrix_w = 32
+matrix_h = 16
+simd = 4
+pe = 4
+exp_bits = 3
+input_precision = 4
+activation_precision = 20
+
+nf = matrix_h // pe
+sf = matrix_w // simd
+lane_bits = exp_bits + 1
+
+sign = [[random.randint(0, 1) for c in range(matrix_w)] for r in range(matrix_h)]
+expo = [[random.randrange(1 << exp_bits) for c in range(matrix_w)] for r in range(matrix_h)]
+
+outFileConfig.write("#define MatrixW_LG %d \n" % matrix_w)
+outFileConfig.write("#define MatrixH_LG %d \n" % matrix_h)
+outFileConfig.write("#define SIMD_LG %d \n" % simd)
+outFileConfig.write("#define PE_LG %d \n" % pe)
+outFileConfig.write("#define EXP_BITS_LG %d \n" % exp_bits)
+outFileConfig.write("#define INPUT_PRECISION_LG %d \n" % input_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_LG %d \n" % activation_precision)
+outFileConfig.close()
+
+outFileWeights.write("#ifndef PARAMS_LOG_HPP\n")
+outFileWeights.write("#define PARAMS_LOG_HPP\n")
+outFileWeights.write("namespace PARAM_LOG{ \n")
+outFileWeights.write("static LogWeights<%d,%d,%d,%d> weights= {\n{\n" % (simd, pe, nf*sf, exp_bits))
+pes = []
+for p in range(pe):
+	vals = []
+	for n in range(nf):
+		for s in range(sf):
+			val = 0
+			for i in range(simd):
+				r = n*pe + p
+				c = s*simd + i
+				val |= ((sign[r][c] << exp_bits) | expo[r][c]) << (i*lane_bits)
+			vals.append(hex(val))
+	pes.append("{\n%s\n}" % ",\n".join(vals))
+outFileWeights.write(",\n".join(pes))
+outFileWeights.write("\n}\n};\n")
+# row r of the matrix is computed by PE r % PE
+outFileWeights.write("static int const raw[%d][%d] = {\n" % (matrix_h, matrix_w))
+outFileWeights.write(",\n".join("{%s}" % ", ".join(str((-1 if sign[r][c] else 1) << expo[r][c]) for c in range(matrix_w)) for r in range(matrix_h)))
+outFileWeights.write("\n};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
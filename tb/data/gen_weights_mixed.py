@@ -0,0 +1,95 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random mixed-precision weights for the mixed-precision MVAU
+#  testbench in MixedPrecisionWeights layout, the first PE_HI PEs holding
+#  8-bit and the others 4-bit weights, together with the weights for the
+#  golden model.
+#
+import random
+
+outFileWeights = open("memdata_mixed.h" , "wt")
+outFileConfig = open("config_mixed.h" , "wt")
+
+matrix_w = 32
+matrix_h = 16
+simd = 4
+pe = 4
+pe_hi = 1
+w_precision_hi = 8
+w_precision_lo = 4
+input_precision = 4
+activation_precision = 16
+
+nf = matrix_h // pe
+sf = matrix_w // simd
+
+def width(p):
+	return w_precision_hi if p < pe_hi else w_precision_lo
+
+# row r of the matrix is computed by PE r % PE
+raw = [[random.randint(-(1 << (width(r % pe)-1)), (1 << (width(r % pe)-1)) - 1) for c in range(matrix_w)] for r in range(matrix_h)]
+
+outFileConfig.write("#define MatrixW_MP %d \n" % matrix_w)
+outFileConfig.write("#define MatrixH_MP %d \n" % matrix_h)
+outFileConfig.write("#define SIMD_MP %d \n" % simd)
+outFileConfig.write("#define PE_MP %d \n" % pe)
+outFileConfig.write("#define PE_HI_MP %d \n" % pe_hi)
+outFileConfig.write("#define WIDTH_HI_MP %d \n" % w_precision_hi)
+outFileConfig.write("#define WIDTH_LO_MP %d \n" % w_precision_lo)
+outFileConfig.write("#define INPUT_PRECISION_MP %d \n" % input_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_MP %d \n" % activation_precision)
+outFileConfig.close()
+
+def group(pes):
+	out = []
+	for p in pes:
+		vals = []
+		for n in range(nf):
+			for s in range(sf):
+				val = 0
+				for i in range(simd):
+					val |= (raw[n*pe + p][s*simd + i] & ((1 << width(p)) - 1)) << (i*width(p))
+				vals.append(hex(val))
+		out.append("{\n%s\n}" % ",\n".join(vals))
+	return ",\n".join(out)
+
+outFileWeights.write("#ifndef PARAMS_MIXED_HPP\n")
+outFileWeights.write("#define PARAMS_MIXED_HPP\n")
+outFileWeights.write("namespace PARAM_MIXED{ \n")
+outFileWeights.write("static MixedPrecisionWeights<%d,ap_int<%d>,ap_int<%d>,%d,%d,%d> weights= {\n{\n" % (simd, w_precision_hi, w_precision_lo, pe, pe_hi, nf*sf))
+outFileWeights.write(group(range(pe_hi)))
+outFileWeights.write("\n},\n{\n")
+outFileWeights.write(group(range(pe_hi, pe)))
+outFileWeights.write("\n}\n};\n")
+outFileWeights.write("static int const raw[%d][%d] = {\n" % (matrix_h, matrix_w))
+outFileWeights.write(",\n".join("{%s}" % ", ".join(str(v) for v in row) for row in raw))
+outFileWeights.write("\n};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,84 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random weights for the zero-skipping matrix vector activation
+#  testbench, together with the raw weights for the golden model.
+#
+import random
+
+outFileWeights = open("memdata_mvau_zeroskip.h" , "wt")
+outFileConfig = open("config_mvau_zeroskip.h" , "wt")
+
+matrix_w = 24
+matrix_h = 8
+simd = 4
+pe = 2
+w_precision = 4
+input_precision = 4
+activation_precision = 16
+
+nf = matrix_h // pe
+sf = matrix_w // simd
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+raw = [[random.randint(lo, hi) for c in range(matrix_w)] for r in range(matrix_h)]
+
+outFileConfig.write("#define MatrixW_ZS %d \n" % matrix_w)
+outFileConfig.write("#define MatrixH_ZS %d \n" % matrix_h)
+outFileConfig.write("#define SIMD_ZS %d \n" % simd)
+outFileConfig.write("#define PE_ZS %d \n" % pe)
+outFileConfig.write("#define WIDTH_ZS %d \n" % w_precision)
+outFileConfig.write("#define INPUT_PRECISION_ZS %d \n" % input_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_ZS %d \n" % activation_precision)
+outFileConfig.close()
+
+outFileWeights.write("#ifndef PARAMS_MVAU_ZEROSKIP_HPP\n")
+outFileWeights.write("#define PARAMS_MVAU_ZEROSKIP_HPP\n")
+outFileWeights.write("namespace PARAM_MVAU_ZEROSKIP{ \n")
+outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> weights= {\n{\n" %(simd,w_precision,pe,nf*sf))
+for p in range(pe):
+	outFileWeights.write("{ \n")
+	vals = []
+	for n in range(nf):
+		for s in range(sf):
+			val = 0
+			for i in range(simd):
+				val |= (raw[n*pe + p][s*simd + i] & ((1 << w_precision)-1)) << (i*w_precision)
+			vals.append(hex(val))
+	outFileWeights.write(",\n".join(vals))
+	outFileWeights.write("} \n")
+	if p!=pe-1:
+		outFileWeights.write(",")
+outFileWeights.write("}\n};\n")
+outFileWeights.write("static int const raw[%d][%d] = {\n" % (matrix_h, matrix_w))
+outFileWeights.write(",\n".join("{%s}" % ", ".join(str(v) for v in raw[r]) for r in range(matrix_h)))
+outFileWeights.write("\n};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,89 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random fixed point weights for the packed weight MVAU testbench in
+#  PackedFixedPointWeights layout with pe_per_word PEs per memory word,
+#  together with the plain weight matrix for the golden model.
+#
+import random
+
+outFileWeights = open("memdata_packed.h" , "wt")
+outFileConfig = open("config_packed.h" , "wt")
+
+matrix_w = 128
+matrix_h = 16
+simd = 2
+pe = 8
+pe_per_word = 8
+w_precision = 4
+input_precision = 4
+activation_precision = 16
+
+nf = matrix_h // pe
+sf = matrix_w // simd
+pe_bits = simd * w_precision
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+raw = [[random.randint(lo, hi) for c in range(matrix_w)] for r in range(matrix_h)]
+
+outFileConfig.write("#define MatrixW_PK %d \n" % matrix_w)
+outFileConfig.write("#define MatrixH_PK %d \n" % matrix_h)
+outFileConfig.write("#define SIMD_PK %d \n" % simd)
+outFileConfig.write("#define PE_PK %d \n" % pe)
+outFileConfig.write("#define PE_PER_WORD_PK %d \n" % pe_per_word)
+outFileConfig.write("#define WIDTH_PK %d \n" % w_precision)
+outFileConfig.write("#define INPUT_PRECISION_PK %d \n" % input_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_PK %d \n" % activation_precision)
+outFileConfig.close()
+
+outFileWeights.write("#ifndef PARAMS_PACKED_HPP\n")
+outFileWeights.write("#define PARAMS_PACKED_HPP\n")
+outFileWeights.write("namespace PARAM_PACKED{ \n")
+outFileWeights.write("static PackedFixedPointWeights<%d,ap_int<%d>,%d,%d,%d> weights= {\n{\n" % (simd, w_precision, pe, nf*sf, pe_per_word))
+words = []
+for g in range(pe // pe_per_word):
+	vals = []
+	for n in range(nf):
+		for s in range(sf):
+			val = 0
+			for q in range(pe_per_word):
+				r = n*pe + g*pe_per_word + q
+				for i in range(simd):
+					val |= (raw[r][s*simd + i] & ((1 << w_precision) - 1)) << (q*pe_bits + i*w_precision)
+			vals.append(hex(val))
+	words.append("{\n%s\n}" % ",\n".join(vals))
+outFileWeights.write(",\n".join(words))
+outFileWeights.write("\n}\n};\n")
+# row r of the matrix is computed by PE r % PE
+outFileWeights.write("static int const raw[%d][%d] = {\n" % (matrix_h, matrix_w))
+outFileWeights.write(",\n".join("{%s}" % ", ".join(str(raw[r][c]) for c in range(matrix_w)) for r in range(matrix_h)))
+outFileWeights.write("\n};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,113 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random weights for the convolution and the fully-connected layer
+#  of the pipeline composer testbench and the raw weights for the golden model.
+#
+import random
+
+outFileWeights = open("memdata_pipeline.h" , "wt")
+outFileConfig = open("config_pipeline.h" , "wt")
+
+kernel_dim = 3
+ifm_channels = 2
+ifm_dim = 6
+ofm_channels = 4
+ofm_dim = ifm_dim - kernel_dim + 1
+conv_simd = 2
+conv_pe = 2
+pool_dim = 2
+fc_out = 4
+fc_simd = 8
+fc_pe = 4
+input_precision = 4
+conv_precision = 16
+fc_precision = 24
+out_stream_width = 48
+w_precision = 4
+
+fc_in = (ofm_dim // pool_dim) * (ofm_dim // pool_dim) * ofm_channels
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+
+outFileConfig.write("#define KERNEL_DIM_PL %d \n" % kernel_dim)
+outFileConfig.write("#define IFM_Channels_PL %d \n" % ifm_channels)
+outFileConfig.write("#define IFMDim_PL %d \n" % ifm_dim)
+outFileConfig.write("#define OFM_Channels_PL %d \n" % ofm_channels)
+outFileConfig.write("#define OFMDim_PL %d \n" % ofm_dim)
+outFileConfig.write("#define CONV_SIMD_PL %d \n" % conv_simd)
+outFileConfig.write("#define CONV_PE_PL %d \n" % conv_pe)
+outFileConfig.write("#define POOL_DIM_PL %d \n" % pool_dim)
+outFileConfig.write("#define FC_IN_PL %d \n" % fc_in)
+outFileConfig.write("#define FC_OUT_PL %d \n" % fc_out)
+outFileConfig.write("#define FC_SIMD_PL %d \n" % fc_simd)
+outFileConfig.write("#define FC_PE_PL %d \n" % fc_pe)
+outFileConfig.write("#define INPUT_PRECISION_PL %d \n" % input_precision)
+outFileConfig.write("#define CONV_PRECISION_PL %d \n" % conv_precision)
+outFileConfig.write("#define FC_PRECISION_PL %d \n" % fc_precision)
+outFileConfig.write("#define OUT_STREAM_WIDTH_PL %d \n" % out_stream_width)
+outFileConfig.write("#define WIDTH_PL %d \n" % w_precision)
+outFileConfig.close()
+
+def write_weights(name, rows, cols, simd, pe, raw):
+	nf = rows // pe
+	sf = cols // simd
+	outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> %s= {\n{\n" %(simd,w_precision,pe,nf*sf,name))
+	for p in range(pe):
+		outFileWeights.write("{ \n")
+		vals = []
+		for n in range(nf):
+			for s in range(sf):
+				val = 0
+				for i in range(simd):
+					val |= (raw[n*pe + p][s*simd + i] & ((1 << w_precision)-1)) << (i*w_precision)
+				vals.append(hex(val))
+		outFileWeights.write(",\n".join(vals))
+		outFileWeights.write("} \n")
+		if p!=pe-1:
+			outFileWeights.write(",")
+	outFileWeights.write("}\n};\n")
+	outFileWeights.write("static int const %s_raw[%d][%d] = {\n" % (name, rows, cols))
+	outFileWeights.write(",\n".join("{%s}" % ", ".join(str(v) for v in raw[r]) for r in range(rows)))
+	outFileWeights.write("\n};\n")
+
+# conv columns in (ky*kernel_dim + kx)*ifm_channels + c order, fc columns in pixel*ofm_channels + c order
+conv_cols = kernel_dim * kernel_dim * ifm_channels
+raw_conv = [[random.randint(lo, hi) for c in range(conv_cols)] for r in range(ofm_channels)]
+raw_fc = [[random.randint(lo, hi) for c in range(fc_in)] for r in range(fc_out)]
+
+outFileWeights.write("#ifndef PARAMS_PIPELINE_HPP\n")
+outFileWeights.write("#define PARAMS_PIPELINE_HPP\n")
+outFileWeights.write("namespace PARAM_PIPELINE{ \n")
+write_weights("conv_weights", ofm_channels, conv_cols, conv_simd, conv_pe, raw_conv)
+write_weights("fc_weights", fc_out, fc_in, fc_simd, fc_pe, raw_fc)
+outFileWeights.write(" } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
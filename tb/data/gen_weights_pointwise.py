@@ -0,0 +1,92 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random weights for the pointwise convolution testbench and the
+#  raw weights for the golden model.
+#
+import random
+
+outFileWeights = open("memdata_pointwise.h" , "wt")
+outFileConfig = open("config_pointwise.h" , "wt")
+
+ifm_channels = 8
+ifm_dim = 7
+ofm_channels = 8
+stride = 2
+simd = 2
+pe = 2
+mmv = 2
+input_precision = 4
+activation_precision = 16
+w_precision = 4
+
+nf = ofm_channels // pe
+sf = ifm_channels // simd
+
+outFileConfig.write("#define IFM_Channels_PW %d \n" % ifm_channels)
+outFileConfig.write("#define IFMDim_PW %d \n" % ifm_dim)
+outFileConfig.write("#define OFM_Channels_PW %d \n" % ofm_channels)
+outFileConfig.write("#define STRIDE_PW %d \n" % stride)
+outFileConfig.write("#define SIMD_PW %d \n" % simd)
+outFileConfig.write("#define PE_PW %d \n" % pe)
+outFileConfig.write("#define MMV_PW %d \n" % mmv)
+outFileConfig.write("#define INPUT_PRECISION_PW %d \n" % input_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_PW %d \n" % activation_precision)
+outFileConfig.write("#define WIDTH_PW %d \n" % w_precision)
+outFileConfig.close()
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+# raw[out channel][in channel]
+raw = [[random.randint(lo, hi) for c in range(ifm_channels)] for r in range(ofm_channels)]
+
+outFileWeights.write("#ifndef PARAMS_POINTWISE_HPP\n")
+outFileWeights.write("#define PARAMS_POINTWISE_HPP\n")
+outFileWeights.write("namespace PARAM_POINTWISE{ \n")
+outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> weights= {\n{\n" %(simd,w_precision,pe,nf*sf))
+for p in range(pe):
+	outFileWeights.write("{ \n")
+	vals = []
+	for n in range(nf):
+		for s in range(sf):
+			val = 0
+			for i in range(simd):
+				val |= (raw[n*pe + p][s*simd + i] & ((1 << w_precision)-1)) << (i*w_precision)
+			vals.append(hex(val))
+	outFileWeights.write(",\n".join(vals))
+	outFileWeights.write("} \n")
+	if p!=pe-1:
+		outFileWeights.write(",")
+outFileWeights.write("}\n};\n")
+outFileWeights.write("static int const weights_raw[%d][%d] = {\n" % (ofm_channels, ifm_channels))
+outFileWeights.write(",\n".join("{%s}" % ", ".join(str(v) for v in raw[r]) for r in range(ofm_channels)))
+outFileWeights.write("\n};\n")
+outFileWeights.write(" } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
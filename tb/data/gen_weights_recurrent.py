@@ -0,0 +1,151 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#
+#  Generates random weights and biases of an LSTM and a GRU cell together with
+#  the lookup tables of their gate nonlinearities for the recurrent cell
+#  testbench, and the raw values for the golden model.
+#
+import math
+import random
+
+outFileWeights = open("memdata_recurrent.h" , "wt")
+outFileConfig = open("config_recurrent.h" , "wt")
+
+input_size = 4
+hidden_size = 4
+simd = 2
+pe = 2
+seq_len = 6
+input_precision = 4
+w_precision = 4
+acc_precision = 16
+state_precision = 12
+hidden_precision = 8
+frac = 6
+entries = 64
+# the accumulator lookup tables cover [-512, 512), the cell state table [-2048, 2048)
+acc_offset = -512
+acc_shift = 4
+state_offset = -2048
+state_shift = 6
+
+outFileConfig.write("#define INPUT_SIZE_RC %d \n" % input_size)
+outFileConfig.write("#define HIDDEN_SIZE_RC %d \n" % hidden_size)
+outFileConfig.write("#define SIMD_RC %d \n" % simd)
+outFileConfig.write("#define PE_RC %d \n" % pe)
+outFileConfig.write("#define SEQ_LEN_RC %d \n" % seq_len)
+outFileConfig.write("#define INPUT_PRECISION_RC %d \n" % input_precision)
+outFileConfig.write("#define WIDTH_RC %d \n" % w_precision)
+outFileConfig.write("#define ACC_PRECISION_RC %d \n" % acc_precision)
+outFileConfig.write("#define STATE_PRECISION_RC %d \n" % state_precision)
+outFileConfig.write("#define HIDDEN_PRECISION_RC %d \n" % hidden_precision)
+outFileConfig.write("#define FRAC_RC %d \n" % frac)
+outFileConfig.write("#define ENTRIES_RC %d \n" % entries)
+outFileConfig.write("#define ACC_OFFSET_RC %d \n" % acc_offset)
+outFileConfig.write("#define ACC_SHIFT_RC %d \n" % acc_shift)
+outFileConfig.write("#define STATE_OFFSET_RC %d \n" % state_offset)
+outFileConfig.write("#define STATE_SHIFT_RC %d \n" % state_shift)
+outFileConfig.close()
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+nf = hidden_size // pe
+
+# raw[gate][hidden unit][column], lane g*pe + p of tile n*sf + s holds gate g of unit n*pe + p
+def write_weights(name, gates, cols, raw):
+	sf = cols // simd
+	outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> %s= {\n{\n" %(simd,w_precision,gates*pe,nf*sf,name))
+	for g in range(gates):
+		for p in range(pe):
+			outFileWeights.write("{ \n")
+			vals = []
+			for n in range(nf):
+				for s in range(sf):
+					val = 0
+					for i in range(simd):
+						val |= (raw[g][n*pe + p][s*simd + i] & ((1 << w_precision)-1)) << (i*w_precision)
+					vals.append(hex(val))
+			outFileWeights.write(",\n".join(vals))
+			outFileWeights.write("} \n")
+			if g*pe + p != gates*pe-1:
+				outFileWeights.write(",")
+	outFileWeights.write("}\n};\n")
+	outFileWeights.write("static int const %s_raw[%d][%d][%d] = {\n" % (name, gates, hidden_size, cols))
+	outFileWeights.write(",\n".join("{%s}" % ", ".join("{%s}" % ", ".join(str(v) for v in raw[g][u]) for u in range(hidden_size)) for g in range(gates)))
+	outFileWeights.write("\n};\n")
+
+def table(fxn, offset, shift):
+	return [int(round((1 << frac) * fxn((offset + (i << shift) + (1 << shift)/2) / float(1 << frac)))) for i in range(entries)]
+
+def sigmoid(x):
+	return 1.0 / (1.0 + math.exp(-x))
+
+def pe_nf(vals):
+	return "{%s}" % ", ".join("{%s}" % ", ".join(str(vals[n*pe + p]) for n in range(nf)) for p in range(pe))
+
+def list_init(vals):
+	return "{%s}" % ", ".join(str(v) for v in vals)
+
+sig_acc = table(sigmoid, acc_offset, acc_shift)
+tanh_acc = table(math.tanh, acc_offset, acc_shift)
+tanh_state = table(math.tanh, state_offset, state_shift)
+
+outFileWeights.write("#ifndef PARAMS_RECURRENT_HPP\n")
+outFileWeights.write("#define PARAMS_RECURRENT_HPP\n")
+outFileWeights.write("namespace PARAM_RECURRENT{ \n")
+outFileWeights.write("typedef ap_int<%d> TA_RC;\n" % acc_precision)
+outFileWeights.write("typedef LUTActivation<TA_RC, ap_uint<%d>, %d, %d, %d> Sigmoid_RC;\n" % (frac+1, entries, acc_offset, acc_shift))
+outFileWeights.write("typedef LUTActivation<TA_RC, ap_int<%d>, %d, %d, %d> Tanh_RC;\n" % (frac+2, entries, acc_offset, acc_shift))
+outFileWeights.write("typedef LUTActivation<ap_int<%d>, ap_int<%d>, %d, %d, %d> TanhState_RC;\n" % (state_precision, frac+2, entries, state_offset, state_shift))
+outFileWeights.write("typedef LSTMCell<%d, %d, TA_RC, Sigmoid_RC, Tanh_RC, TanhState_RC, ap_int<%d>, ap_int<%d>, %d> LSTMCell_RC;\n" % (nf, pe, state_precision, hidden_precision, frac))
+outFileWeights.write("typedef GRUCell<%d, %d, TA_RC, Sigmoid_RC, Tanh_RC, ap_int<%d>, %d> GRUCell_RC;\n" % (nf, pe, hidden_precision, frac))
+outFileWeights.write("static int const sigmoid_raw[%d] = %s;\n" % (entries, list_init(sig_acc)))
+outFileWeights.write("static int const tanh_raw[%d] = %s;\n" % (entries, list_init(tanh_acc)))
+outFileWeights.write("static int const tanh_state_raw[%d] = %s;\n" % (entries, list_init(tanh_state)))
+
+for cell, gates in (("lstm", 4), ("gru", 3)):
+	wx = [[[random.randint(lo, hi) for c in range(input_size)] for u in range(hidden_size)] for g in range(gates)]
+	wh = [[[random.randint(lo, hi) for c in range(hidden_size)] for u in range(hidden_size)] for g in range(gates)]
+	bias = [[random.randint(-64, 64) for u in range(hidden_size)] for g in range(gates)]
+	write_weights(cell + "_wx", gates, input_size, wx)
+	write_weights(cell + "_wh", gates, hidden_size, wh)
+	outFileWeights.write("static int const %s_bias_raw[%d][%d] = {%s};\n" % (cell, gates, hidden_size, ", ".join(list_init(b) for b in bias)))
+	if cell == "lstm":
+		outFileWeights.write("static LSTMCell_RC lstm_cell = {\n{%s},\n{%s},\n{%s},\n{%s}\n};\n" %
+			(", ".join(pe_nf(b) for b in bias), list_init(sig_acc), list_init(tanh_acc), list_init(tanh_state)))
+	else:
+		bias_hn = [random.randint(-64, 64) for u in range(hidden_size)]
+		outFileWeights.write("static int const gru_bias_hn_raw[%d] = %s;\n" % (hidden_size, list_init(bias_hn)))
+		outFileWeights.write("static GRUCell_RC gru_cell = {\n{%s},\n%s,\n{%s},\n{%s}\n};\n" %
+			(", ".join(pe_nf(b) for b in bias), pe_nf(bias_hn), list_init(sig_acc), list_init(tanh_acc)))
+
+outFileWeights.write(" } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,102 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random weights for both convolutions of the residual block
+#  testbench and the raw weights for the golden model.
+#
+import random
+
+outFileWeights = open("memdata_residual.h" , "wt")
+outFileConfig = open("config_residual.h" , "wt")
+
+kernel_dim = 3
+ifm_dim = 5
+channels = 4
+simd1 = 2
+pe1 = 2
+simd2 = 4
+pe2 = 1
+input_precision = 4
+mid_precision = 16
+res_precision = 16
+output_precision = 17
+w_precision = 4
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+
+outFileConfig.write("#define KERNEL_DIM_RB %d \n" % kernel_dim)
+outFileConfig.write("#define IFMDim_RB %d \n" % ifm_dim)
+outFileConfig.write("#define Channels_RB %d \n" % channels)
+outFileConfig.write("#define SIMD1_RB %d \n" % simd1)
+outFileConfig.write("#define PE1_RB %d \n" % pe1)
+outFileConfig.write("#define SIMD2_RB %d \n" % simd2)
+outFileConfig.write("#define PE2_RB %d \n" % pe2)
+outFileConfig.write("#define INPUT_PRECISION_RB %d \n" % input_precision)
+outFileConfig.write("#define MID_PRECISION_RB %d \n" % mid_precision)
+outFileConfig.write("#define RES_PRECISION_RB %d \n" % res_precision)
+outFileConfig.write("#define OUTPUT_PRECISION_RB %d \n" % output_precision)
+outFileConfig.write("#define WIDTH_RB %d \n" % w_precision)
+outFileConfig.close()
+
+# raw[out channel][(ky*kernel_dim + kx)*channels + in channel]
+def write_weights(name, rows, cols, simd, pe, raw):
+	nf = rows // pe
+	sf = cols // simd
+	outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> %s= {\n{\n" %(simd,w_precision,pe,nf*sf,name))
+	for p in range(pe):
+		outFileWeights.write("{ \n")
+		vals = []
+		for n in range(nf):
+			for s in range(sf):
+				val = 0
+				for i in range(simd):
+					val |= (raw[n*pe + p][s*simd + i] & ((1 << w_precision)-1)) << (i*w_precision)
+				vals.append(hex(val))
+		outFileWeights.write(",\n".join(vals))
+		outFileWeights.write("} \n")
+		if p!=pe-1:
+			outFileWeights.write(",")
+	outFileWeights.write("}\n};\n")
+	outFileWeights.write("static int const %s_raw[%d][%d] = {\n" % (name, rows, cols))
+	outFileWeights.write(",\n".join("{%s}" % ", ".join(str(v) for v in raw[r]) for r in range(rows)))
+	outFileWeights.write("\n};\n")
+
+cols = kernel_dim * kernel_dim * channels
+raw1 = [[random.randint(lo, hi) for c in range(cols)] for r in range(channels)]
+raw2 = [[random.randint(lo, hi) for c in range(cols)] for r in range(channels)]
+
+outFileWeights.write("#ifndef PARAMS_RESIDUAL_HPP\n")
+outFileWeights.write("#define PARAMS_RESIDUAL_HPP\n")
+outFileWeights.write("namespace PARAM_RESIDUAL{ \n")
+write_weights("weights1", channels, cols, simd1, pe1, raw1)
+write_weights("weights2", channels, cols, simd2, pe2, raw2)
+outFileWeights.write(" } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
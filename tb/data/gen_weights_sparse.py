@@ -0,0 +1,92 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates a random pruned weight matrix for the sparse MVAU testbench and
+#  writes it in SparseFixedPointWeights layout, keeping only the tiles with
+#  at least one non-zero weight.
+#
+import random
+
+outFileWeights = open("memdata_sparse.h" , "wt")
+outFileConfig = open("config_sparse.h" , "wt")
+
+matrix_w = 32
+matrix_h = 16
+simd = 4
+pe = 2
+w_precision = 4
+input_precision = 4
+activation_precision = 16
+tile_density = 0.3
+
+nf = matrix_h // pe
+sf = matrix_w // simd
+
+# pick the non-zero tiles, neuron fold 1 is left fully pruned
+tiles = []
+for n in range(nf):
+	row = [s for s in range(sf) if n != 1 and random.random() < tile_density]
+	if len(row) == 0:
+		# a fully pruned neuron fold still needs one (all-zero) tile
+		tiles.append((random.randrange(sf), True, True))
+		continue
+	for i, s in enumerate(row):
+		tiles.append((s, i == len(row)-1, False))
+
+outFileConfig.write("#define MatrixW_S %d \n" % matrix_w)
+outFileConfig.write("#define MatrixH_S %d \n" % matrix_h)
+outFileConfig.write("#define SIMD_S %d \n" % simd)
+outFileConfig.write("#define PE_S %d \n" % pe)
+outFileConfig.write("#define WIDTH_S %d \n" % w_precision)
+outFileConfig.write("#define INPUT_PRECISION_S %d \n" % input_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_S %d \n" % activation_precision)
+outFileConfig.write("#define NZTILES_S %d \n" % len(tiles))
+outFileConfig.close()
+
+outFileWeights.write("#ifndef PARAMS_SPARSE_HPP\n")
+outFileWeights.write("#define PARAMS_SPARSE_HPP\n")
+outFileWeights.write("namespace PARAM_SPARSE{ \n")
+outFileWeights.write("static SparseFixedPointWeights<%d,ap_int<%d>,%d,%d,%d> weights= {\n{\n" %(simd,w_precision,pe,sf,len(tiles)))
+for p in range(pe):
+	outFileWeights.write("{ \n")
+	vals = []
+	for (s, last, zero) in tiles:
+		val = 0
+		while val == 0 and not zero:
+			val = random.randint(0, (1<<(simd*w_precision))-1)
+		vals.append(hex(val))
+	outFileWeights.write(",\n".join(vals))
+	outFileWeights.write("} \n")
+	if p!=pe-1:
+		outFileWeights.write(",")
+outFileWeights.write("},\n{ %s },\n" % ", ".join(str(s) for (s, last, zero) in tiles))
+outFileWeights.write("{ %s }\n" % ", ".join(str(int(last)) for (s, last, zero) in tiles))
+outFileWeights.write("};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,119 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random weights for both fully-connected layers of the
+#  squeeze-and-excitation testbench, the sigmoid table applied on the second
+#  layer and the raw weights for the golden model.
+#
+import random
+import math
+
+outFileWeights = open("memdata_squeeze_excite.h" , "wt")
+outFileConfig = open("config_squeeze_excite.h" , "wt")
+
+ifm_dim = 3
+channels = 8
+reduced = 4
+pe = 2
+simd1 = 4
+pe1 = 2
+simd2 = 2
+pe2 = 4
+input_precision = 4
+acc_precision = 8
+mid_precision = 16
+lut_precision = 20
+scale_precision = 4
+output_precision = 8
+w_precision = 4
+entries = 64
+shift = 9
+offset = -(entries // 2) << shift
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+
+outFileConfig.write("#define IFMDim_SE %d \n" % ifm_dim)
+outFileConfig.write("#define Channels_SE %d \n" % channels)
+outFileConfig.write("#define Reduced_SE %d \n" % reduced)
+outFileConfig.write("#define PE_SE %d \n" % pe)
+outFileConfig.write("#define SIMD1_SE %d \n" % simd1)
+outFileConfig.write("#define PE1_SE %d \n" % pe1)
+outFileConfig.write("#define SIMD2_SE %d \n" % simd2)
+outFileConfig.write("#define PE2_SE %d \n" % pe2)
+outFileConfig.write("#define INPUT_PRECISION_SE %d \n" % input_precision)
+outFileConfig.write("#define ACC_PRECISION_SE %d \n" % acc_precision)
+outFileConfig.write("#define MID_PRECISION_SE %d \n" % mid_precision)
+outFileConfig.write("#define LUT_PRECISION_SE %d \n" % lut_precision)
+outFileConfig.write("#define SCALE_PRECISION_SE %d \n" % scale_precision)
+outFileConfig.write("#define OUTPUT_PRECISION_SE %d \n" % output_precision)
+outFileConfig.write("#define WIDTH_SE %d \n" % w_precision)
+outFileConfig.write("#define ENTRIES_SE %d \n" % entries)
+outFileConfig.write("#define OFFSET_SE %d \n" % offset)
+outFileConfig.write("#define SHIFT_SE %d \n" % shift)
+outFileConfig.close()
+
+def write_weights(name, rows, cols, simd, pe, raw):
+	nf = rows // pe
+	sf = cols // simd
+	outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> %s= {\n{\n" %(simd,w_precision,pe,nf*sf,name))
+	for p in range(pe):
+		outFileWeights.write("{ \n")
+		vals = []
+		for n in range(nf):
+			for s in range(sf):
+				val = 0
+				for i in range(simd):
+					val |= (raw[n*pe + p][s*simd + i] & ((1 << w_precision)-1)) << (i*w_precision)
+				vals.append(hex(val))
+		outFileWeights.write(",\n".join(vals))
+		outFileWeights.write("} \n")
+		if p!=pe-1:
+			outFileWeights.write(",")
+	outFileWeights.write("}\n};\n")
+	outFileWeights.write("static int const %s_raw[%d][%d] = {\n" % (name, rows, cols))
+	outFileWeights.write(",\n".join("{%s}" % ", ".join(str(v) for v in raw[r]) for r in range(rows)))
+	outFileWeights.write("\n};\n")
+
+raw1 = [[random.randint(lo, hi) for c in range(channels)] for r in range(reduced)]
+raw2 = [[random.randint(lo, hi) for c in range(reduced)] for r in range(channels)]
+
+outFileWeights.write("#ifndef PARAMS_SQUEEZE_EXCITE_HPP\n")
+outFileWeights.write("#define PARAMS_SQUEEZE_EXCITE_HPP\n")
+outFileWeights.write("namespace PARAM_SQUEEZE_EXCITE{ \n")
+write_weights("weights1", reduced, channels, simd1, pe1, raw1)
+write_weights("weights2", channels, reduced, simd2, pe2, raw2)
+scale_max = (1 << scale_precision) - 1
+table = [int(round(scale_max / (1 + math.exp(-(k - entries // 2) / 4.0)))) for k in range(entries)]
+outFileWeights.write("static LUTActivation<ap_int<%d>,ap_uint<%d>,%d,%d,%d> sigmoid= {\n{\n" % (lut_precision, scale_precision, entries, offset, shift))
+outFileWeights.write(",\n".join(str(v) for v in table))
+outFileWeights.write("\n}\n};\n")
+outFileWeights.write(" } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
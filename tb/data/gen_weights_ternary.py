@@ -0,0 +1,87 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random ternary weights for the ternary weight MVAU testbench in
+#  TernaryWeights layout (nonzero mask and sign bitplanes), together with the
+#  -1/0/+1 weights for the golden model.
+#
+import random
+
+outFileWeights = open("memdata_ternary.h" , "wt")
+outFileConfig = open("config_ternary.h" , "wt")
+
+matrix_w = 32
+matrix_h = 16
+simd = 8
+pe = 4
+input_precision = 4
+activation_precision = 16
+
+nf = matrix_h // pe
+sf = matrix_w // simd
+
+# roughly half of the weights are zero
+raw = [[random.choice([-1, 0, 0, 1]) for c in range(matrix_w)] for r in range(matrix_h)]
+
+outFileConfig.write("#define MatrixW_TN %d \n" % matrix_w)
+outFileConfig.write("#define MatrixH_TN %d \n" % matrix_h)
+outFileConfig.write("#define SIMD_TN %d \n" % simd)
+outFileConfig.write("#define PE_TN %d \n" % pe)
+outFileConfig.write("#define INPUT_PRECISION_TN %d \n" % input_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_TN %d \n" % activation_precision)
+outFileConfig.close()
+
+def plane(bit):
+	pes = []
+	for p in range(pe):
+		vals = []
+		for n in range(nf):
+			for s in range(sf):
+				val = 0
+				for i in range(simd):
+					if bit(raw[n*pe + p][s*simd + i]):
+						val |= 1 << i
+				vals.append(hex(val))
+		pes.append("{\n%s\n}" % ",\n".join(vals))
+	return ",\n".join(pes)
+
+outFileWeights.write("#ifndef PARAMS_TERNARY_HPP\n")
+outFileWeights.write("#define PARAMS_TERNARY_HPP\n")
+outFileWeights.write("namespace PARAM_TERNARY{ \n")
+outFileWeights.write("static TernaryWeights<%d,%d,%d> weights= {\n{\n" % (simd, pe, nf*sf))
+outFileWeights.write(plane(lambda w: w != 0))
+outFileWeights.write("\n},\n{\n")
+outFileWeights.write(plane(lambda w: w < 0))
+outFileWeights.write("\n}\n};\n")
+# row r of the matrix is computed by PE r % PE
+outFileWeights.write("static int const raw[%d][%d] = {\n" % (matrix_h, matrix_w))
+outFileWeights.write(",\n".join("{%s}" % ", ".join(str(raw[r][c]) for c in range(matrix_w)) for r in range(matrix_h)))
+outFileWeights.write("\n};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,96 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  Generates random weights of the two convolutional layers for the spatial
+#  tiling testbench and the raw weights for the golden model.
+#
+import random
+
+outFileWeights = open("memdata_tiling.h" , "wt")
+outFileConfig = open("config_tiling.h" , "wt")
+
+ifm_dim_x = 14
+ifm_dim_y = 6
+ifm_channels = 1
+tile_out = 3
+input_precision = 4
+w_precision = 4
+# kernel, stride, padding, output channels, simd, pe, activation precision
+layers = [(3, 1, 1, 2, 1, 2, 16), (2, 2, 0, 2, 2, 2, 32)]
+
+outFileConfig.write("#define IFMDim_x_TL %d \n" % ifm_dim_x)
+outFileConfig.write("#define IFMDim_y_TL %d \n" % ifm_dim_y)
+outFileConfig.write("#define IFM_Channels_TL %d \n" % ifm_channels)
+outFileConfig.write("#define TILE_OUT_TL %d \n" % tile_out)
+outFileConfig.write("#define INPUT_PRECISION_TL %d \n" % input_precision)
+outFileConfig.write("#define WIDTH_TL %d \n" % w_precision)
+for l, (k, s, p, oc, simd, pe, a) in enumerate(layers):
+	outFileConfig.write("#define KERNEL_DIM%d_TL %d \n" % (l+1, k))
+	outFileConfig.write("#define STRIDE%d_TL %d \n" % (l+1, s))
+	outFileConfig.write("#define PAD%d_TL %d \n" % (l+1, p))
+	outFileConfig.write("#define OFM_Channels%d_TL %d \n" % (l+1, oc))
+	outFileConfig.write("#define SIMD%d_TL %d \n" % (l+1, simd))
+	outFileConfig.write("#define PE%d_TL %d \n" % (l+1, pe))
+	outFileConfig.write("#define ACTIVATION_PRECISION%d_TL %d \n" % (l+1, a))
+outFileConfig.close()
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+
+outFileWeights.write("#ifndef PARAMS_TILING_HPP\n")
+outFileWeights.write("#define PARAMS_TILING_HPP\n")
+outFileWeights.write("namespace PARAM_TILING{ \n")
+channels = ifm_channels
+for l, (k, s, p, oc, simd, pe, a) in enumerate(layers):
+	mw = k * k * channels
+	nf = oc // pe
+	sf = mw // simd
+	# raw[out channel][(kernel row * k + kernel column) * in channels + in channel]
+	raw = [[random.randint(lo, hi) for c in range(mw)] for r in range(oc)]
+	outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> weights%d= {\n{\n" %(simd,w_precision,pe,nf*sf,l+1))
+	for q in range(pe):
+		outFileWeights.write("{ \n")
+		vals = []
+		for n in range(nf):
+			for f in range(sf):
+				val = 0
+				for i in range(simd):
+					val |= (raw[n*pe + q][f*simd + i] & ((1 << w_precision)-1)) << (i*w_precision)
+				vals.append(hex(val))
+		outFileWeights.write(",\n".join(vals))
+		outFileWeights.write("} \n")
+		if q!=pe-1:
+			outFileWeights.write(",")
+	outFileWeights.write("}\n};\n")
+	outFileWeights.write("static int const weights%d_raw[%d][%d] = {\n" % (l+1, oc, mw))
+	outFileWeights.write(",\n".join("{%s}" % ", ".join(str(v) for v in raw[r]) for r in range(oc)))
+	outFileWeights.write("\n};\n")
+	channels = oc
+outFileWeights.write(" } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
@@ -0,0 +1,101 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Generates random 3x3 weights for the Winograd convolution testbench and
+#  writes them both in their raw form (for the golden model) and transformed
+#  as U' = G' g G'^T, G' = 2G, in FixedPointWeights layout.
+#
+import random
+
+outFileWeights = open("memdata_winograd.h" , "wt")
+outFileConfig = open("config_winograd.h" , "wt")
+
+ifm_ch = 4
+ofm_ch = 4
+ifm_dim = 6
+simd = 2
+pe = 2
+w_precision = 3
+u_precision = 8
+input_precision = 4
+acc_precision = 16
+activation_precision = 16
+
+nf = ofm_ch // pe
+sf = ifm_ch // simd
+
+G = [[2, 0, 0], [1, 1, 1], [1, -1, 1], [0, 0, 2]]
+
+def transform(g):
+	tmp = [[sum(G[i][k] * g[k][j] for k in range(3)) for j in range(3)] for i in range(4)]
+	return [[sum(tmp[i][k] * G[j][k] for k in range(3)) for j in range(4)] for i in range(4)]
+
+lo = -(1 << (w_precision-1))
+hi = (1 << (w_precision-1)) - 1
+raw = [[[[random.randint(lo, hi) for kx in range(3)] for ky in range(3)] for c in range(ifm_ch)] for o in range(ofm_ch)]
+trans = [[transform(raw[o][c]) for c in range(ifm_ch)] for o in range(ofm_ch)]
+
+outFileConfig.write("#define IFM_Channels_W %d \n" % ifm_ch)
+outFileConfig.write("#define OFM_Channels_W %d \n" % ofm_ch)
+outFileConfig.write("#define IFMDim_W %d \n" % ifm_dim)
+outFileConfig.write("#define OFMDim_W %d \n" % (ifm_dim-2))
+outFileConfig.write("#define SIMD_W %d \n" % simd)
+outFileConfig.write("#define PE_W %d \n" % pe)
+outFileConfig.write("#define WIDTH_W %d \n" % w_precision)
+outFileConfig.write("#define U_WIDTH_W %d \n" % u_precision)
+outFileConfig.write("#define INPUT_PRECISION_W %d \n" % input_precision)
+outFileConfig.write("#define ACC_PRECISION_W %d \n" % acc_precision)
+outFileConfig.write("#define ACTIVATION_PRECISION_W %d \n" % activation_precision)
+outFileConfig.close()
+
+outFileWeights.write("#ifndef PARAMS_WINOGRAD_HPP\n")
+outFileWeights.write("#define PARAMS_WINOGRAD_HPP\n")
+outFileWeights.write("namespace PARAM_WINOGRAD{ \n")
+outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> weights= {\n{\n" %(simd,u_precision,pe,16*nf*sf))
+for p in range(pe):
+	outFileWeights.write("{ \n")
+	vals = []
+	for e in range(16):
+		for n in range(nf):
+			for s in range(sf):
+				val = 0
+				for i in range(simd):
+					u = trans[n*pe + p][s*simd + i][e // 4][e % 4] & ((1 << u_precision)-1)
+					val |= u << (i*u_precision)
+				vals.append(hex(val))
+	outFileWeights.write(",\n".join(vals))
+	outFileWeights.write("} \n")
+	if p!=pe-1:
+		outFileWeights.write(",")
+outFileWeights.write("}\n};\n")
+outFileWeights.write("static int const raw[%d][%d][3][3] = {\n" % (ofm_ch, ifm_ch))
+outFileWeights.write(",\n".join("{" + ", ".join("{" + ", ".join("{%s}" % ", ".join(str(v) for v in row) for row in raw[o][c]) + "}" for c in range(ifm_ch)) + "}" for o in range(ofm_ch)))
+outFileWeights.write("\n};\n } \n")
+outFileWeights.write("#endif \n")
+outFileWeights.close()
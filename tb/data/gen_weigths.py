@@ -32,6 +32,11 @@ import os
 import sys
 import random 
 import subprocess
+import param_file
+
+# with --binary, the weights are written to memdata.bin and memdata.h only loads them from
+# there through tb/param_file.hpp, so that they need not be compiled
+binary = "--binary" in sys.argv
 
 outFileWeights = open("memdata.h" , "wt")
 outFileConfig = open("config.h" , "wt")
@@ -73,28 +78,35 @@ outFileConfig.close()
 outFileWeights.write("#ifndef PARAMS_HPP\n")
 outFileWeights.write("#define PARAMS_HPP\n")
 
-outFileWeights.write("namespace PARAM{ \n")
 if (w_precision == 1):
-	outFileWeights.write("static BinaryWeights<%d,%d,%d> weights= {\n{\n" %(simd,pe,tile))
+	weights_type = "BinaryWeights<%d,%d,%d>" % (simd,pe,tile)
 else:
-	outFileWeights.write("static FixedPointWeights<%d,ap_int<%d>,%d,%d> weights= {\n{\n" %(simd,w_precision,pe,tile))
+	weights_type = "FixedPointWeights<%d,ap_int<%d>,%d,%d>" % (simd,w_precision,pe,tile)
 
+words = []
 for p in range(pe):
-	outFileWeights.write("{ \n")
+	words.append([])
 	for t in range(tile):
 		width = simd*w_precision;
-		val = random.randint(0, 1<<width-1)
-		outFileWeights.write("%s" % hex(val))
-		if t!=tile-1:
-			outFileWeights.write(",\n")
-	outFileWeights.write("} \n")
-	if p!=pe-1:
-		outFileWeights.write(",")
+		words[p].append(random.randint(0, 1<<width-1))
 
-
-outFileWeights.write("}\n};\n } \n")
+if binary:
+	outFileWeights.write("#include \"param_file.hpp\"\n")
+outFileWeights.write("namespace PARAM{ \n")
+if binary:
+	outFileWeights.write("static %s weights = load_params<%s>(param_path(__FILE__, \"memdata.bin\"));\n" % (weights_type, weights_type))
+else:
+	outFileWeights.write("static %s weights= {\n{\n" % weights_type)
+	for p in range(pe):
+		outFileWeights.write("{ \n")
+		outFileWeights.write(",\n".join(hex(val) for val in words[p]))
+		outFileWeights.write("} \n")
+		if p!=pe-1:
+			outFileWeights.write(",")
+	outFileWeights.write("}\n};\n")
+outFileWeights.write(" } \n")
 outFileWeights.write("#endif \n")
 outFileWeights.close()
 
-
-
+if binary:
+	param_file.write_weights("memdata.bin", words, simd*w_precision)
@@ -0,0 +1,15 @@
+#ifndef PARAMS_AFFINE_HPP
+#define PARAMS_AFFINE_HPP
+namespace PARAM_AFFINE{ 
+static AffineChannelWiseOperation<4,2,ap_int<6>,ap_int<5>,ap_int<10>,ap_uint<4>,5> affine= {
+{
+{ -11, -5, -9, -5 },
+{ -13, 10, -3, 9 }
+},
+{
+{ 421, 463, 111, -36 },
+{ -176, 308, -312, -210 }
+}
+};
+ } 
+#endif 
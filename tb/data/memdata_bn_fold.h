@@ -0,0 +1,12 @@
+#ifndef PARAMS_BN_FOLD_HPP
+#define PARAMS_BN_FOLD_HPP
+namespace PARAM_BN_FOLD{ 
+static constexpr double SCALE[8] = { 0.2517841168194691, 0.16533519908567715, 0.038997939717379526, 0.07144118011549304, 0.054451552487491575, 0.2554816636536784, 0.14481296536817245, 0.21532011486598468 };
+static constexpr double BIAS[8] = { 0.7138776421305622, 2.405322050634661, 2.100129860068437, -4.881487303492179, 0.9933706451607813, -0.357730165747423, -1.9965162473253684, -2.193593778640847 };
+struct bn {
+	static constexpr double scale(unsigned const c) { return SCALE[c]; }
+	static constexpr double bias(unsigned const c) { return BIAS[c]; }
+	static constexpr double step() { return 1.5; }
+};
+ } 
+#endif 
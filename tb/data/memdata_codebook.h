@@ -0,0 +1,169 @@
+#ifndef PARAMS_CODEBOOK_HPP
+#define PARAMS_CODEBOOK_HPP
+namespace PARAM_CODEBOOK{ 
+static CodebookWeights<4,ap_int<8>,4,32,4> weights= {
+{
+{
+0xa970,
+0xcf1c,
+0x276c,
+0x2886,
+0x3ccd,
+0x39ea,
+0xa66f,
+0x71c2,
+0x1ba4,
+0x1b9f,
+0x7d6c,
+0xeb8,
+0x643b,
+0x8e42,
+0xb466,
+0xbc18,
+0xc911,
+0x6e3b,
+0x35ee,
+0x384,
+0xfc9b,
+0x1fac,
+0x87a3,
+0xb74e,
+0x69b7,
+0x720c,
+0x6b90,
+0x9036,
+0xa8d6,
+0x8e99,
+0xbe1f,
+0x5f0e
+},
+{
+0x8022,
+0x37ae,
+0xd672,
+0x7bb,
+0x2793,
+0xae0,
+0xb732,
+0xb958,
+0x43ac,
+0xb25a,
+0xffe2,
+0x149f,
+0x6ea2,
+0x4294,
+0x9d60,
+0x851b,
+0xb7eb,
+0x7f66,
+0x4a8a,
+0x3bcf,
+0x3bf5,
+0x62a,
+0xd77d,
+0x6c71,
+0xca4,
+0x7d0e,
+0x4799,
+0xc78a,
+0x8160,
+0xb0bc,
+0x821e,
+0x854d
+},
+{
+0x2148,
+0x1dfd,
+0x6fa9,
+0xdbbc,
+0xc0c8,
+0xff8,
+0xbb61,
+0xfda4,
+0x9521,
+0x4d94,
+0x35b2,
+0x7f8f,
+0xa558,
+0xd8ac,
+0x5df0,
+0x6939,
+0x232b,
+0x370a,
+0x28d6,
+0x870b,
+0xf6f5,
+0xd558,
+0x5703,
+0x5831,
+0xc867,
+0x4af0,
+0xa1a5,
+0xc509,
+0x42f3,
+0x1283,
+0xbfe3,
+0x6f2
+},
+{
+0x3abd,
+0x36c9,
+0x2a2d,
+0x2100,
+0x32c5,
+0x310d,
+0x4a8f,
+0x16f9,
+0x7233,
+0xee6,
+0x383f,
+0x2e95,
+0x4a04,
+0xc071,
+0xe1c2,
+0xd832,
+0xcf2a,
+0x2750,
+0x8bea,
+0x253d,
+0x6a77,
+0x140e,
+0xbc1d,
+0x561a,
+0x8578,
+0x941b,
+0x5b1a,
+0xc395,
+0x4aa7,
+0x30ac,
+0x903f,
+0xcb9d
+}
+},
+{
+{ 102, -87, -86, -9, -81, 13, -40, -18, -4, 60, 32, -45, -46, -89, -8, -40 },
+{ 71, 61, 44, -54, 4, -101, -3, 7, -20, 109, 64, 5, -104, 55, -19, -75 },
+{ 87, 24, -114, -127, -50, -3, 125, 45, -66, -15, -115, 17, -116, 112, -113, 97 },
+{ -34, -126, -47, 26, -45, 85, 113, 107, -121, 41, 26, 69, -24, 33, 56, 124 }
+}
+};
+static int const raw[16][32] = {
+{102, -18, 60, 32, -46, -87, -40, -46, -46, -40, -18, -86, -40, -4, -4, -86, -89, -46, -46, -9, 32, -8, 60, -9, -40, -40, -40, 32, -86, -46, -87, -18},
+{44, 44, 71, -20, -19, 64, 7, -54, 44, 7, -3, 55, 5, 5, 7, 71, -54, 109, 7, 44, 71, -19, 64, 71, 44, -54, 7, 5, -20, -101, 109, 5},
+{-66, -50, 24, -114, 112, 97, 112, 24, -15, -115, 97, 125, -116, 17, 17, 112, -66, -116, 87, -116, -66, 97, 97, 87, 24, 125, 17, 17, -50, -115, 112, 97},
+{33, 69, 26, 26, 41, -24, 113, 26, 33, -47, 26, -47, -34, -34, -126, -47, 85, -24, -47, 26, 33, -34, -126, 26, 124, -121, 26, -45, 41, 124, 113, -126},
+{-81, 32, -45, -87, -40, 60, -45, -87, -46, -40, -89, -18, -4, -45, -8, 102, -45, -9, -81, -40, -86, -81, -8, -4, -40, -40, -81, -45, -4, -87, -46, -45},
+{-104, 64, -54, 4, 64, -101, 44, 5, 44, -19, -75, -75, -75, 109, 4, 61, 44, 64, -19, -3, 4, 109, 44, 4, 71, -3, 55, 109, 5, 61, -101, -20},
+{24, -114, -3, -15, -50, -15, 112, -50, -114, 17, -3, -127, 97, -66, 97, 45, -66, -3, -3, -115, -116, -115, -66, 112, 87, 97, 112, -3, -15, -127, -15, 125},
+{26, 26, -47, 107, 113, 56, 56, -34, 124, 26, -121, 26, 85, 41, 56, -47, -45, -34, 26, -45, -126, 107, -34, -24, -47, -24, -126, 56, -47, 26, -121, 33},
+{-87, -87, 60, -46, -45, -9, -8, -40, -8, -8, 13, -9, -81, -4, -9, 102, -45, 60, -46, -40, -46, 32, -40, -87, -9, 32, -18, -4, -8, -81, -18, -45},
+{5, -19, 7, 5, -3, -3, -75, 7, 64, -20, 64, 4, -75, -104, 5, -54, -101, -75, 5, -54, 64, 44, -3, 71, 55, 7, 7, 55, 61, 7, -104, -3},
+{17, -114, -127, -114, -115, 87, 45, -127, 125, 112, -66, -114, 17, 87, 45, -66, -3, 97, 125, 97, -66, -3, -3, 112, -127, 87, 45, -3, 24, -127, -66, -3},
+{26, -47, 124, -24, -34, 85, 107, -47, 26, 56, 69, -121, 33, 26, 85, -47, 107, 107, 26, 113, 56, -34, -45, -126, 33, -126, -24, 69, 26, -126, 113, 85},
+{-18, -45, 60, -40, -46, 102, -86, -18, 102, 60, -45, -40, -40, -9, 102, 60, -40, -89, -4, 32, 60, 60, -8, -4, -40, -87, -8, -45, -8, 102, -40, 13},
+{4, 64, -104, 71, -19, 71, 55, 7, 109, 109, 7, 4, 64, -20, 7, -104, 71, -3, 61, -20, -104, 5, 71, 5, -19, 61, 44, -20, 55, 4, -101, -20},
+{45, 125, -66, -116, 87, 97, -115, -50, -3, -115, 24, -115, -15, 87, -3, -116, -127, 97, -114, -50, -127, -66, -114, 24, -127, -113, 97, 17, -114, 97, 125, 87},
+{-121, 107, 85, -121, 69, -126, -45, 41, 26, -126, 69, 85, 85, 41, 26, -24, 107, 26, 26, -45, -24, 26, -34, 26, 124, 26, -34, 41, 33, 41, 69, -24}
+};
+ } 
+#endif 
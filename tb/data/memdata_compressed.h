@@ -0,0 +1,211 @@
+#ifndef PARAMS_COMPRESSED_HPP
+#define PARAMS_COMPRESSED_HPP
+namespace PARAM_COMPRESSED{ 
+static unsigned long long const compressed[70] = {
+0xa115499,
+0x8765b438,
+0x7578e800,
+0x800280c3,
+0xfa2c80a0,
+0x2f8d8040,
+0x1040800,
+0xf471051a,
+0xd211041d,
+0x60010042,
+0xf0914a24,
+0x8121c4eb,
+0xe4d46054,
+0x5e4,
+0x83402436,
+0x40542104,
+0x408f14da,
+0x2db04402,
+0x2580288,
+0x1106d21c,
+0x94106200,
+0xc28f445,
+0x104069a2,
+0x92010c40,
+0x913264,
+0x54c44,
+0x4dc28451,
+0x114640ff,
+0x4837ce1,
+0x911011e8,
+0x80d04016,
+0x7e3b09b5,
+0x69a39a4,
+0x46400104,
+0xc04345af,
+0x429b0d9e,
+0x10401001,
+0xa4041a,
+0x2c2d1d0,
+0x58db4e18,
+0x217cc018,
+0xe09b5010,
+0x42a0601,
+0x1700f46e,
+0x49a010a,
+0x4d38401,
+0xeb8d4c1,
+0x40404906,
+0x40d0d208,
+0x51243ec,
+0x940d,
+0x4a0d6d27,
+0x142c0dca,
+0xa01f10b6,
+0x7010da03,
+0x48b04260,
+0x4d0140d,
+0x1d110642,
+0xe3c14122,
+0x194a3f8,
+0x1404d071,
+0x10241290,
+0xb03406a2,
+0x98bf8100,
+0x11804084,
+0x2851c4d2,
+0x249a0200,
+0x440a000,
+0x104036d8,
+0x2800
+};
+static unsigned long long const raw[48] = {
+0x100fe000d0210f0f,
+0x3d2ff000f200020f,
+0x200000000d0,
+0x40f0000f0f00ef0,
+0x104020000df0000,
+0x101041dfd0f0100,
+0xf00300001000010,
+0xe01f010ebf0e101,
+0xf1101e0000000f0f,
+0x100011036000005e,
+0x1000111000001020,
+0x1020022010ff01,
+0xfe0022e001210,
+0x202030c000010100,
+0xe00ff00121f0f00,
+0x20f01000201000,
+0x100000e1010f0e1e,
+0xee0212100000005,
+0x1ff0f0210d0e40ff,
+0x10001010000f200,
+0x2e00f1001000000f,
+0xfe1d10ff0f3,
+0xfd0e100000201000,
+0xf1f00ff300100f,
+0xf00100020002c,
+0xf100000000121000,
+0xf00f030000eff00,
+0x5010102fe3000e0d,
+0x100ed00e003e,
+0x20d02f00f40000,
+0x10f10fc1000100,
+0x1e00f2f00000ff0f,
+0xe0100010000000,
+0x20fef01000f1,
+0x1f0000091000f100,
+0x1300ef1210ee00f1,
+0xf200000001f10b,
+0x102300f0001,
+0x10f100000f201d,
+0x103d000f00000100,
+0xffe00000fe0ff001,
+0x1100010d0710031,
+0xf000e10010000,
+0xdff001000b031000,
+0x101e00020100000,
+0xe0002e01101f0,
+0x101000d000000e,
+0x1200002020030000
+};
+static unsigned long long const compressed2[40] = {
+0x4128,
+0x5824,
+0x680,
+0x8a31,
+0x9814,
+0x3040,
+0x401,
+0x11c1,
+0x200,
+0x8012,
+0xa0c,
+0x3009,
+0x2038,
+0x6080,
+0x9101,
+0xc215,
+0x8001,
+0x52c0,
+0x2908,
+0x901d,
+0x8abc,
+0x8105,
+0x3068,
+0x50a4,
+0x955,
+0x482b,
+0x408,
+0x40a2,
+0x4442,
+0x66,
+0x1354,
+0x508e,
+0x2108,
+0x2049,
+0x8094,
+0x40d3,
+0x3402,
+0x4479,
+0x5910,
+0xeb
+};
+static unsigned long long const raw2[40] = {
+0x0,
+0x208042,
+0x1280,
+0xc100a,
+0x9082,
+0x8011,
+0x41004,
+0x20011,
+0x80008,
+0x90a0,
+0x80e0,
+0x1280,
+0x48040,
+0x8001,
+0x0,
+0xc08001,
+0x202048,
+0x1642,
+0x249008,
+0x9412,
+0x8000,
+0x20300a,
+0x249202,
+0x201,
+0x2120a,
+0x8000,
+0x11002,
+0x40040,
+0x51,
+0x9041,
+0x9200,
+0x10240,
+0x40200,
+0x202008,
+0x8,
+0x200643,
+0x219000,
+0x820b,
+0x48040,
+0x248209
+};
+ } 
+#endif 
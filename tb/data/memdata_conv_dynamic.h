@@ -0,0 +1,83 @@
+#ifndef PARAMS_CONV_DYNAMIC_HPP
+#define PARAMS_CONV_DYNAMIC_HPP
+namespace PARAM_CONV_DYNAMIC{ 
+static FixedPointWeights<2,ap_int<4>,2,36> weights= {
+{
+{ 
+0xa,
+0x8c,
+0xbf,
+0x87,
+0xf6,
+0xc4,
+0x83,
+0xe0,
+0x4e,
+0xa3,
+0x3e,
+0x1f,
+0xb7,
+0x73,
+0x31,
+0xa0,
+0x9e,
+0x48,
+0x86,
+0x1e,
+0xb4,
+0x22,
+0x57,
+0x13,
+0x8,
+0x63,
+0xbd,
+0x22,
+0x80,
+0xde,
+0xda,
+0xcb,
+0xec,
+0x52,
+0x34,
+0x67} 
+,{ 
+0xfe,
+0x7c,
+0x8f,
+0x7c,
+0xdf,
+0xab,
+0xee,
+0xa5,
+0x5,
+0x98,
+0xab,
+0xcb,
+0xc0,
+0xd3,
+0x58,
+0x31,
+0x11,
+0xc7,
+0xc0,
+0xce,
+0x34,
+0x57,
+0x30,
+0x3e,
+0x94,
+0xf1,
+0x6f,
+0x3,
+0x8e,
+0x2d,
+0x94,
+0x53,
+0x7a,
+0x0,
+0x41,
+0x74} 
+}
+};
+ } 
+#endif 
@@ -0,0 +1,107 @@
+#ifndef PARAMS_CONV_POOL_HPP
+#define PARAMS_CONV_POOL_HPP
+namespace PARAM_CONV_POOL{ 
+static FixedPointWeights<2,ap_int<4>,2,36> weights= {
+{
+{ 
+0x79,
+0xe3,
+0xc6,
+0x8d,
+0x10,
+0x5b,
+0x7d,
+0x5b,
+0xfc,
+0x23,
+0x8,
+0x77,
+0x3e,
+0xa6,
+0x97,
+0x5f,
+0xc7,
+0xd1,
+0xef,
+0x1,
+0xf1,
+0x8e,
+0x38,
+0x9f,
+0x42,
+0xca,
+0x45,
+0xec,
+0x9d,
+0xe9,
+0x44,
+0x80,
+0x99,
+0x87,
+0x7b,
+0x32} 
+,{ 
+0xc3,
+0xac,
+0x60,
+0x4,
+0xed,
+0x6d,
+0x61,
+0xdf,
+0xda,
+0x23,
+0xbc,
+0xbd,
+0x83,
+0xf2,
+0x80,
+0xbf,
+0x92,
+0x70,
+0xbc,
+0x49,
+0x2d,
+0xb,
+0x91,
+0x9a,
+0x16,
+0x40,
+0x1,
+0x4d,
+0xb5,
+0x7,
+0xe5,
+0xc0,
+0x80,
+0x5e,
+0x2c,
+0xc} 
+}
+};
+static ThresholdsActivation<2,2,3,ap_int<16>,ap_uint<2>> threshs= {
+{
+{
+{ -164, 225, 377 },
+{ -249, -161, 49 }
+},
+{
+{ -240, -100, -25 },
+{ -23, 85, 244 }
+}
+}
+};
+static int const raw[4][3][3][4] = {
+{{{-7, 7, 3, -2}, {6, -4, -3, -8}, {0, 1, -5, 5}}, {{-3, 7, -5, 5}, {-4, -1, 3, 2}, {-8, 0, 7, 7}}, {{-2, 3, 6, -6}, {7, -7, -1, 5}, {7, -4, 1, -3}}},
+{{{3, -4, -4, -6}, {0, 6, 4, 0}, {-3, -2, -3, 6}}, {{1, 6, -1, -3}, {-6, -3, 3, 2}, {-4, -5, -3, -5}}, {{3, -8, 2, -1}, {0, -8, -1, -5}, {2, -7, 0, 7}}},
+{{{-1, -2, 1, 0}, {1, -1, -2, -8}, {-8, 3, -1, -7}}, {{2, 4, -6, -4}, {5, 4, -4, -2}, {-3, -7, -7, -2}}, {{4, 4, 0, -8}, {-7, -7, 7, -8}, {-5, 7, 2, 3}}},
+{{{-4, -5, -7, 4}, {-3, 2, -5, 0}, {1, -7, -6, -7}}, {{6, 1, 0, 4}, {1, 0, -3, 4}, {5, -5, 7, 0}}, {{5, -2, 0, -4}, {0, -8, -2, 5}, {-4, 2, -4, 0}}}
+};
+static int const raw_th[4][3] = {
+{-164, 225, 377},
+{-240, -100, -25},
+{-249, -161, 49},
+{-23, 85, 244}
+};
+ } 
+#endif 
@@ -0,0 +1,145 @@
+#ifndef PARAMS_DECONV_HPP
+#define PARAMS_DECONV_HPP
+namespace PARAM_DECONV{ 
+static FixedPointWeights<2,ap_int<4>,2,64> weights= {
+{
+{ 
+0x5b,
+0xdf,
+0xf7,
+0x12,
+0x1c,
+0x71,
+0x41,
+0x34,
+0x9c,
+0x66,
+0x22,
+0x79,
+0xa7,
+0x2e,
+0x1f,
+0xf7,
+0x59,
+0x2a,
+0xee,
+0xa0,
+0x7f,
+0x22,
+0xe,
+0x3b,
+0xdc,
+0xca,
+0xf6,
+0x0,
+0x92,
+0xfd,
+0x49,
+0x7d,
+0x57,
+0x7b,
+0x61,
+0x66,
+0x23,
+0x2e,
+0x8b,
+0x6a,
+0x29,
+0xc1,
+0x34,
+0x83,
+0x32,
+0x88,
+0x86,
+0xfe,
+0x1f,
+0xbc,
+0x82,
+0xc8,
+0x4e,
+0xf7,
+0x85,
+0xfd,
+0x96,
+0xd6,
+0xe4,
+0xf3,
+0x86,
+0x2e,
+0x2e,
+0xb0} 
+,{ 
+0xd9,
+0x3e,
+0xe6,
+0x5f,
+0x86,
+0xd2,
+0xc8,
+0x10,
+0xfc,
+0x5f,
+0xd4,
+0x8,
+0xf8,
+0xc9,
+0xad,
+0xd0,
+0x17,
+0xe3,
+0xbf,
+0xd5,
+0xc8,
+0x4e,
+0xe8,
+0x7c,
+0x1c,
+0xb,
+0x5c,
+0x65,
+0x38,
+0x4a,
+0xf9,
+0xff,
+0xb7,
+0xc4,
+0xbd,
+0xe,
+0x4d,
+0xbf,
+0xfc,
+0x12,
+0x54,
+0xac,
+0x31,
+0x4a,
+0x1a,
+0x4,
+0x18,
+0x5b,
+0x98,
+0x19,
+0xc0,
+0xc1,
+0x5c,
+0x84,
+0x5b,
+0x64,
+0x4f,
+0xf9,
+0xcb,
+0xac,
+0xc2,
+0x9b,
+0xa3,
+0x2d} 
+}
+};
+static int const raw[4][4][4][4] = {
+{{{1, 4, 4, 3}, {-2, 0, -5, 3}, {-4, 1, 1, 7}, {-1, 7, 2, 2}}, {{-5, -8, -6, 6}, {5, -8, -3, -1}, {3, 2, -2, 2}, {-2, 4, 7, -1}}, {{7, -1, 2, 1}, {-2, -2, 0, -6}, {-5, 5, -1, -3}, {-7, 5, -6, 2}}, {{1, 6, 6, 6}, {2, -8, -8, -4}, {7, 5, -5, 7}, {-1, 1, -4, -5}}},
+{{{-8, -4, 0, 1}, {-8, -2, -4, 7}, {6, -8, 2, -3}, {-8, -4, -2, 4}}, {{-4, -1, 2, 1}, {-5, 5, 4, 6}, {-3, 4, -1, -5}, {-4, 5, 4, -8}}, {{6, -2, -1, 5}, {-1, -5, 5, -3}, {-7, -3, -2, 3}, {7, 1, 3, -2}}, {{-3, -5, -2, 0}, {0, -4, 1, -4}, {7, -5, 4, -4}, {-8, -7, -7, 1}}},
+{{{-1, 1, 7, -1}, {-7, 4, -3, 7}, {7, -6, -2, 2}, {2, -7, -3, -1}}, {{6, -8, -2, -1}, {-2, 2, 0, -5}, {2, 3, -8, -8}, {6, -8, -2, 2}}, {{2, 2, -7, 7}, {6, -1, 0, 0}, {-4, -7, 6, 6}, {-4, -3, -6, -4}}, {{4, 3, 3, -8}, {4, -2, 3, -1}, {-7, 2, 1, -4}, {6, -7, 6, -3}}},
+{{{-3, -6, 0, -3}, {-7, -1, -1, -1}, {-8, -1, -7, -4}, {-8, 3, -6, 4}}, {{-8, 1, -5, 5}, {3, -6, -3, 2}, {-6, 1, 4, 0}, {2, -4, -5, -7}}, {{4, -3, -8, 0}, {-4, 5, 5, 6}, {-4, -1, -1, 5}, {-4, 1, -5, 0}}, {{1, 3, -6, 4}, {-5, -4, -4, -6}, {4, 5, -4, -6}, {-1, 4, -7, -1}}}
+};
+ } 
+#endif 
@@ -0,0 +1,33 @@
+#ifndef PARAMS_DEQUANT_HPP
+#define PARAMS_DEQUANT_HPP
+namespace PARAM_DEQUANT{ 
+static DequantActivation<4,4,ap_int<8>,float> dequant= {
+{
+{ 2.293194e-01f, 3.066819e-01f, 4.832141e-01f, -4.389014e-02f },
+{ 5.726024e-02f, -4.099353e-01f, 1.449305e-01f, -2.596834e-01f },
+{ 1.819300e-01f, -4.208549e-01f, 4.401432e-01f, 1.738322e-01f },
+{ -4.150161e-01f, 3.164925e-01f, 6.918069e-02f, -4.569998e-01f }
+},
+{
+{ -34, -51, 33, 2 },
+{ -10, 45, 12, -14 },
+{ 24, -4, 8, -36 },
+{ 2, 52, 16, 61 }
+}
+};
+static DequantActivation<4,4,ap_int<8>,Half> dequant_half= {
+{
+{ 4.497309e-01f, 8.881490e-02f, -2.155627e-01f, -7.022680e-02f },
+{ 4.838937e-01f, -3.557739e-01f, -4.747571e-01f, -3.335633e-01f },
+{ -3.436318e-01f, 2.400717e-02f, -2.985046e-01f, 1.571284e-01f },
+{ -2.499425e-01f, -4.132456e-02f, -9.079985e-02f, -2.262281e-01f }
+},
+{
+{ -60, 29, -60, -38 },
+{ -10, 40, -60, -19 },
+{ -17, -26, 20, -36 },
+{ 4, -16, -19, -45 }
+}
+};
+ } 
+#endif 
@@ -0,0 +1,103 @@
+#ifndef PARAMS_DWS_SEPARABLE_HPP
+#define PARAMS_DWS_SEPARABLE_HPP
+namespace PARAM_DWS_SEPARABLE{ 
+static FixedPointWeights<3,ap_int<4>,2,18> dw_weights= {
+{
+{ 
+0x7b8,
+0x9ab,
+0x791,
+0x2e,
+0x8ac,
+0x46f,
+0x4da,
+0xf18,
+0x10b,
+0xd8d,
+0xe70,
+0x751,
+0x5c0,
+0x9d4,
+0x7ca,
+0x968,
+0x9d9,
+0x31f} 
+,{ 
+0xfcb,
+0x5a0,
+0x90b,
+0xe83,
+0xde8,
+0x8f1,
+0x16d,
+0x74,
+0x55b,
+0x756,
+0xf1e,
+0xc08,
+0x33d,
+0x2af,
+0x769,
+0xa50,
+0xdfd,
+0x946} 
+}
+};
+static FixedPointWeights<2,ap_int<4>,4,12> pw_weights= {
+{
+{ 
+0xed,
+0x75,
+0x94,
+0xbe,
+0x96,
+0x65,
+0x3a,
+0x41,
+0xba,
+0xeb,
+0x29,
+0x0} 
+,{ 
+0xed,
+0x9e,
+0x6b,
+0x32,
+0xa4,
+0x23,
+0x77,
+0x11,
+0x39,
+0x0,
+0x5e,
+0x99} 
+,{ 
+0x42,
+0x9f,
+0x8d,
+0xf2,
+0x87,
+0x88,
+0xc4,
+0x31,
+0x79,
+0xba,
+0xea,
+0xd0} 
+,{ 
+0x95,
+0xb4,
+0xe,
+0xc0,
+0x46,
+0x5,
+0x4a,
+0xee,
+0x66,
+0x9b,
+0x88,
+0xd1} 
+}
+};
+ } 
+#endif 
@@ -0,0 +1,47 @@
+#ifndef PARAMS_DWS_SIMD_HPP
+#define PARAMS_DWS_SIMD_HPP
+namespace PARAM_DWS_SIMD{ 
+static FixedPointWeights<3,ap_int<4>,2,18> weights= {
+{
+{ 
+0x23a,
+0xf71,
+0x4ff,
+0x748,
+0xed2,
+0x9fa,
+0x195,
+0x8a6,
+0xd34,
+0x50e,
+0x26a,
+0x2c8,
+0xd4e,
+0xec9,
+0x64a,
+0x519,
+0xc73,
+0xdf6} 
+,{ 
+0x882,
+0x110,
+0x8c9,
+0xd58,
+0x1d0,
+0x7fe,
+0x436,
+0xe22,
+0x634,
+0x213,
+0xee7,
+0xb7e,
+0x901,
+0x4ae,
+0x6ed,
+0xeef,
+0x16a,
+0x46e} 
+}
+};
+ } 
+#endif 
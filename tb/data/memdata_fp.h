@@ -0,0 +1,76 @@
+#ifndef PARAMS_FP_HPP
+#define PARAMS_FP_HPP
+namespace PARAM_FP{ 
+static FixedPointWeights<4,Half,2,8> weights_half= {
+{
+{ 
+0xbd803900b980b800,
+0x3680a8003e203a80,
+0xbda03ca0bf40b880,
+0x3c60bd0039000000,
+0xb9c0bac0b8c03840,
+0xbe00b800b6003b80,
+0xbe60ba80bca0b900,
+0x3e403d403f00bce0} 
+,{ 
+0xbc603dc0b2003d40,
+0x3ac0be00bce0b940,
+0x3680ae003e003980,
+0xbc20bc00ba40bf40,
+0xbe003a803e003700,
+0x3e00b800bee0b8c0,
+0xc000be60b100bec0,
+0xbde0300033003a40} 
+}
+};
+static unsigned const weights_half_raw[8][8] = {
+{0xb800, 0xb980, 0x3900, 0xbd80, 0x3a80, 0x3e20, 0xa800, 0x3680},
+{0x3d40, 0xb200, 0x3dc0, 0xbc60, 0xb940, 0xbce0, 0xbe00, 0x3ac0},
+{0xb880, 0xbf40, 0x3ca0, 0xbda0, 0x0, 0x3900, 0xbd00, 0x3c60},
+{0x3980, 0x3e00, 0xae00, 0x3680, 0xbf40, 0xba40, 0xbc00, 0xbc20},
+{0x3840, 0xb8c0, 0xbac0, 0xb9c0, 0x3b80, 0xb600, 0xb800, 0xbe00},
+{0x3700, 0x3e00, 0x3a80, 0xbe00, 0xb8c0, 0xbee0, 0xb800, 0x3e00},
+{0xb900, 0xbca0, 0xba80, 0xbe60, 0xbce0, 0x3f00, 0x3d40, 0x3e40},
+{0xbec0, 0xb100, 0xbe60, 0xc000, 0x3a40, 0x3300, 0x3000, 0xbde0}
+};
+static FixedPointWeights<4,BFloat16,2,8> weights_bf16= {
+{
+{ 
+0xbef03f943ff03eb0,
+0xbf943f8cbd00bea0,
+0xbfc83f603ed0bfa8,
+0xbf783fe43fcc3ff8,
+0xbf00bd00bf00bf80,
+0x3fc03e203fe4bf58,
+0x3f08bec03ffc3ea0,
+0xbf883f903e60bfac} 
+,{ 
+0x3fe8bf603f803f18,
+0xbf883e40bf8c3fb4,
+0x3e203fc83fe43fdc,
+0xbf94bf84bf84bd80,
+0x3fc4bf483f84be90,
+0xbe203fd84000bf68,
+0x3ed03f10bf38be60,
+0xbef03f483fd8bf58} 
+}
+};
+static unsigned const weights_bf16_raw[8][8] = {
+{0x3eb0, 0x3ff0, 0x3f94, 0xbef0, 0xbea0, 0xbd00, 0x3f8c, 0xbf94},
+{0x3f18, 0x3f80, 0xbf60, 0x3fe8, 0x3fb4, 0xbf8c, 0x3e40, 0xbf88},
+{0xbfa8, 0x3ed0, 0x3f60, 0xbfc8, 0x3ff8, 0x3fcc, 0x3fe4, 0xbf78},
+{0x3fdc, 0x3fe4, 0x3fc8, 0x3e20, 0xbd80, 0xbf84, 0xbf84, 0xbf94},
+{0xbf80, 0xbf00, 0xbd00, 0xbf00, 0xbf58, 0x3fe4, 0x3e20, 0x3fc0},
+{0xbe90, 0x3f84, 0xbf48, 0x3fc4, 0xbf68, 0x4000, 0x3fd8, 0xbe20},
+{0x3ea0, 0x3ffc, 0xbec0, 0x3f08, 0xbfac, 0x3e60, 0x3f90, 0xbf88},
+{0xbe60, 0xbf38, 0x3f10, 0x3ed0, 0xbf58, 0x3fd8, 0x3f48, 0xbef0}
+};
+static FloatRequantActivation<4,2,ap_int<8> > requant= {
+{{3.0f, 3.25f, 2.25f, 0.75f}, {3.25f, 3.25f, 0.5f, 0.75f}},
+{{13.0f, -6.0f, 6.0f, 8.5f}, {-16.0f, 6.5f, -4.5f, -9.5f}}
+};
+static ThresholdsActivation<4,2,3,float,ap_uint<2> > thresholds= {
+{{{-3.9375f, -3.375f, 3.1875f}, {-3.375f, -1.625f, 3.9375f}, {-2.75f, -2.5f, 1.25f}, {-1.3125f, -0.75f, 3.0625f}}, {{-1.375f, -1.125f, -0.1875f}, {-2.1875f, 1.0625f, 2.0f}, {-2.5f, -1.25f, 3.5625f}, {-0.1875f, 0.0f, 3.3125f}}}
+};
+ } 
+#endif 
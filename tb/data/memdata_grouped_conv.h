@@ -0,0 +1,89 @@
+#ifndef PARAMS_GROUPED_CONV_HPP
+#define PARAMS_GROUPED_CONV_HPP
+namespace PARAM_GROUPED_CONV{ 
+static FixedPointWeights<2,ap_int<4>,2,36> weights= {
+{
+{ 
+0xe8,
+0x6d,
+0x25,
+0xb2,
+0x2a,
+0xaf,
+0x25,
+0x75,
+0x1b,
+0x8e,
+0x7,
+0x10,
+0x5,
+0xa6,
+0x0,
+0xc9,
+0x1c,
+0xd7,
+0x80,
+0x15,
+0xe8,
+0x96,
+0x50,
+0x32,
+0xa9,
+0x28,
+0x9f,
+0x2e,
+0x57,
+0x4d,
+0x72,
+0xa6,
+0x40,
+0x53,
+0xa0,
+0x1b} 
+,{ 
+0x5,
+0x84,
+0x73,
+0x9c,
+0xdb,
+0x78,
+0x31,
+0x42,
+0xcf,
+0xa8,
+0x88,
+0x8,
+0xfb,
+0xe,
+0x58,
+0xc1,
+0x7b,
+0x72,
+0x72,
+0xba,
+0xc4,
+0x4b,
+0x39,
+0x39,
+0x12,
+0x95,
+0xeb,
+0x99,
+0xd5,
+0xbf,
+0xbe,
+0x64,
+0x64,
+0x66,
+0x36,
+0xec} 
+}
+};
+static int const weights_raw[4][36] = {
+{-8, -2, -3, 6, 5, 2, 2, -5, -6, 2, -1, -6, 5, 2, 5, 7, -5, 1, -2, -8, 7, 0, 0, 1, 5, 0, 6, -6, 0, 0, -7, -4, -4, 1, 7, -3},
+{5, 0, 4, -8, 3, 7, -4, -7, -5, -3, -8, 7, 1, 3, 2, 4, -1, -4, -8, -6, -8, -8, -8, 0, -5, -1, -2, 0, -8, 5, 1, -4, -5, 7, 2, 7},
+{0, -8, 5, 1, -8, -2, 6, -7, 0, 5, 2, 3, -7, -6, -8, 2, -1, -7, -2, 2, 7, 5, -3, 4, 2, 7, 6, -6, 0, 4, 3, 5, 0, -6, -5, 1},
+{2, 7, -6, -5, 4, -4, -5, 4, -7, 3, -7, 3, 2, 1, 5, -7, -5, -2, -7, -7, 5, -3, -1, -5, -2, -5, 4, 6, 4, 6, 6, 6, 6, 3, -4, -2}
+};
+ } 
+#endif 
@@ -0,0 +1,163 @@
+#ifndef PARAMS_LOG_HPP
+#define PARAMS_LOG_HPP
+namespace PARAM_LOG{ 
+static LogWeights<4,4,32,3> weights= {
+{
+{
+0x5ef5,
+0x1fc5,
+0x50c2,
+0xa72e,
+0x7bfa,
+0xc3f1,
+0x4aee,
+0x872a,
+0xd730,
+0xe7e4,
+0x1615,
+0xfbee,
+0x49c6,
+0x6e54,
+0xad61,
+0xa03a,
+0xfd16,
+0x3d66,
+0x2edd,
+0xed90,
+0x361d,
+0xcd1e,
+0x456d,
+0x3751,
+0x5270,
+0x6e1f,
+0x9ed3,
+0xda07,
+0xc25a,
+0x7e22,
+0x62d9,
+0x1673
+},
+{
+0x7d9a,
+0x13c9,
+0x7e0a,
+0xce69,
+0xcc68,
+0x2fb9,
+0x7f40,
+0xf3cb,
+0x2d29,
+0xebaa,
+0xd402,
+0x53da,
+0x7279,
+0x2611,
+0xdaa1,
+0x50a9,
+0x3c69,
+0xe332,
+0xd26b,
+0x82e5,
+0x77bd,
+0x3623,
+0x67ca,
+0x8d63,
+0xced5,
+0x1570,
+0x2b1f,
+0x748a,
+0xfd2e,
+0xc434,
+0x990,
+0xec32
+},
+{
+0x62e7,
+0x762a,
+0x9916,
+0xdaac,
+0x23da,
+0xeca9,
+0xa4,
+0x9ab6,
+0xfd1c,
+0x7352,
+0x121b,
+0xd85d,
+0x54,
+0xfe7e,
+0x2a5e,
+0x57fb,
+0x5433,
+0xa2fb,
+0xdf7,
+0xa18c,
+0x427e,
+0xbc81,
+0x436,
+0x85ba,
+0x8f95,
+0x1c7,
+0xc7fd,
+0x9003,
+0xc0bc,
+0xdcf3,
+0xacb0,
+0x936c
+},
+{
+0xc269,
+0xba9,
+0x8c6b,
+0xe9f7,
+0xd6aa,
+0x2c0f,
+0x98d9,
+0x8f53,
+0x7c84,
+0x4a19,
+0xb2ae,
+0xb6f4,
+0x4794,
+0xc6d1,
+0x301,
+0x10e5,
+0x6b0b,
+0x5398,
+0x6047,
+0x5661,
+0xdbdb,
+0x43a2,
+0x3298,
+0x149,
+0xf3c2,
+0x29f6,
+0xc436,
+0xd191,
+0x2337,
+0x4d,
+0x5869,
+0xc7c5
+}
+}
+};
+static int const raw[16][32] = {
+{32, -128, -64, 32, 32, -16, -128, 2, 4, -16, 1, 32, -64, 4, 128, -4, -4, -128, -8, 128, 2, -128, 8, -16, -64, -64, -4, 16, -4, 4, 128, -1},
+{-4, -2, -32, 128, -2, -16, 8, 2, -4, 1, -64, 128, -2, 64, -64, -16, -1, 64, -16, -16, -2, -8, -128, 4, 1, 16, -128, 128, -8, -16, 8, -128},
+{128, -64, 4, 64, -4, 4, 64, 128, 64, 2, -2, -2, -16, -4, -4, -32, -4, -32, 8, 4, -2, -4, -16, -64, 16, -4, 1, 1, 64, -8, -4, -2},
+{-2, 64, 4, -16, -2, -4, -8, 1, -8, 64, -16, -1, 128, -128, -2, -64, -4, -4, 64, -32, -128, 1, -16, 4, -2, -32, -1, -2, 8, 32, -128, -1},
+{1, 8, 128, -32, 16, -64, 128, -64, 32, 2, 64, 2, -64, -64, -8, -128, 64, -16, -2, 16, 16, 32, -64, 64, 2, 64, -32, -4, -4, 8, 1, -4},
+{-2, 4, -32, 4, -4, -4, -8, -64, 4, 1, 16, -32, -4, -32, 8, 32, -2, 128, 4, 128, 2, 2, 64, 4, 2, -4, -4, -32, -2, -4, 1, 32},
+{-16, 2, -32, -128, 4, 32, 8, 128, -8, 2, 4, 2, -32, 32, -1, -32, 16, 32, 1, 1, -64, 128, -64, -128, -64, 32, -4, 4, -8, -128, 128, 32},
+{16, -1, -16, 128, -2, 2, -4, 16, -64, -4, 4, -8, 16, -128, 64, -8, 16, -2, 128, 16, 2, -32, 64, -16, 2, 1, 8, 1, 32, -64, 1, 2},
+{64, 2, -32, -128, 64, 64, -32, 8, -32, -32, -64, 4, 1, -2, -32, -64, -32, 2, 64, 8, -64, 2, -32, -16, -32, 64, 32, 16, 2, 32, 128, 8},
+{-2, 64, -16, 8, 4, 8, 8, -64, -8, 64, 4, -32, 32, -64, 4, -1, -32, -8, 128, 128, 8, 4, 64, 8, -4, -16, 128, 64, 8, 64, -32, -1},
+{8, 8, 16, 32, -8, -128, 4, -4, 128, -128, -32, 1, -16, -1, 2, -4, -64, 128, 4, 16, 2, -1, -16, -8, 64, 8, 16, 1, -4, -8, 32, -1},
+{-8, 1, -8, 64, -1, -2, 8, 32, 128, 16, 1, 64, 2, 64, 64, 32, -8, -32, -8, -32, 4, -4, 8, 16, -1, -2, 4, 8, -2, 16, 2, 1},
+{1, 128, 4, 32, -128, 2, -64, 64, 8, -32, -64, -2, 128, 1, -4, -32, -4, 32, 4, -16, 4, 4, -64, 128, -2, -32, 4, 64, 8, 128, 64, 2},
+{32, -32, -64, -16, 1, 128, 32, 2, -128, 2, -8, 4, -4, -1, 16, 128, -64, 4, -32, -128, 16, 8, 16, -16, 1, -2, -2, 1, 4, 8, -16, -64},
+{32, -2, -128, -1, 128, -16, 2, 1, -32, -128, 128, -16, 8, 1, 1, -2, -16, -8, 1, -16, 8, -128, -16, -32, 1, -8, -16, -4, -16, 64, 8, -2},
+{4, -16, 8, -128, 64, -128, -2, 4, 64, 8, 16, -16, 2, -2, 2, -32, 128, 8, 8, 4, -32, 16, 1, 1, -2, 64, -1, 32, 32, -16, 128, -16}
+};
+ } 
+#endif 
@@ -0,0 +1,25 @@
+#ifndef PARAMS_LUT_HPP
+#define PARAMS_LUT_HPP
+namespace PARAM_LUT{ 
+static LUTActivation<ap_int<10>,ap_uint<8>,256,-512,2> lut= {
+{
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 4, 4,
+5, 5, 6, 7, 8, 9, 10, 11, 13, 14, 16, 18, 20, 23, 25, 28,
+32, 35, 39, 44, 48, 53, 59, 65, 71, 78, 84, 92, 99, 107, 115, 123,
+130, 138, 146, 154, 162, 169, 176, 182, 189, 195, 200, 205, 210, 215, 219, 222,
+226, 229, 232, 234, 236, 239, 240, 242, 243, 245, 246, 247, 248, 249, 249, 250,
+251, 251, 252, 252, 252, 253, 253, 253, 253, 254, 254, 254, 254, 254, 254, 254,
+254, 254, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+}
+};
+ } 
+#endif 
@@ -0,0 +1,165 @@
+#ifndef PARAMS_MIXED_HPP
+#define PARAMS_MIXED_HPP
+namespace PARAM_MIXED{ 
+static MixedPrecisionWeights<4,ap_int<8>,ap_int<4>,4,1,32> weights= {
+{
+{
+0xa7ea6f3f,
+0x26cae3ca,
+0xc8d17af3,
+0x4782e2a9,
+0x4f700553,
+0x4070541,
+0x49955b39,
+0x1ad01a09,
+0xa13b8e8d,
+0xbc871207,
+0xff1de296,
+0x8e8c182c,
+0x8a88d11b,
+0x2afcd316,
+0x661cf799,
+0x5e1fe980,
+0x58cfd20d,
+0xb134c04,
+0x2e802834,
+0x26f562df,
+0x3e94ce7f,
+0xfd9c8e9e,
+0xd235fea2,
+0x1d67c53e,
+0x5123e6b7,
+0xfc8e527d,
+0xbd868948,
+0x73a9e7f7,
+0x424e5c5,
+0xa983bcf3,
+0x207810e9,
+0xe0e84d78
+}
+},
+{
+{
+0x61,
+0x65c0,
+0x5b4,
+0x65bf,
+0xa3bd,
+0xfd50,
+0x5b33,
+0xe17e,
+0x2dcd,
+0xa213,
+0x154f,
+0xaef0,
+0xb190,
+0x2534,
+0x61c1,
+0x58a9,
+0xe062,
+0x68e8,
+0xc7f5,
+0x26c9,
+0xa2fc,
+0xbe9d,
+0xd2e,
+0xb464,
+0x9ae5,
+0x66b9,
+0xa8df,
+0xdf06,
+0xff16,
+0xc492,
+0x8cb4,
+0xce8a
+},
+{
+0xd661,
+0x22eb,
+0x1361,
+0xbd2f,
+0x86aa,
+0xaded,
+0xa40e,
+0xb97b,
+0xa77a,
+0x6ac5,
+0x5e45,
+0x331c,
+0x632b,
+0xdf40,
+0x1114,
+0xca9d,
+0xdaa4,
+0x3e8f,
+0x5389,
+0xbae,
+0xcf5b,
+0x2c0d,
+0x1c7c,
+0xc886,
+0x68fc,
+0xd96a,
+0x45d1,
+0x6f50,
+0x6fce,
+0x19ee,
+0xe39e,
+0xbb6c
+},
+{
+0xc498,
+0x4831,
+0x466f,
+0xbe0e,
+0xf59b,
+0x247d,
+0x4893,
+0x2d53,
+0x2fef,
+0x2fc4,
+0xdc0c,
+0x32b8,
+0x7938,
+0xe540,
+0x41d3,
+0xb73c,
+0xc14a,
+0x6ed3,
+0x7f7a,
+0xecea,
+0xdc6e,
+0x5086,
+0xcfdf,
+0x36d0,
+0x8020,
+0x943e,
+0xb386,
+0xfb4b,
+0x9fdb,
+0x72b6,
+0x514e,
+0xa86f
+}
+}
+};
+static int const raw[16][32] = {
+{63, 111, -22, -89, -54, -29, -54, 38, -13, 122, -47, -56, -87, -30, -126, 71, 83, 5, 112, 79, 65, 5, 7, 4, 57, 91, -107, 73, 9, 26, -48, 26},
+{1, 6, 0, 0, 0, -4, 5, 6, 4, -5, 5, 0, -1, -5, 5, 6, -3, -5, 3, -6, 0, 5, -3, -1, 3, 3, -5, 5, -2, 7, 1, -2},
+{1, 6, 6, -3, -5, -2, 2, 2, 1, 6, 3, 1, -1, 2, -3, -5, -6, -6, 6, -8, -3, -2, -3, -6, -2, 0, 4, -6, -5, 7, -7, -5},
+{-8, -7, 4, -4, 1, 3, -8, 4, -1, 6, 6, 4, -2, 0, -2, -5, -5, -7, 5, -1, -3, 7, 4, 2, 3, -7, -8, 4, 3, 5, -3, 2},
+{-115, -114, 59, -95, 7, 18, -121, -68, -106, -30, 29, -1, 44, 24, -116, -114, 27, -47, -120, -118, 22, -45, -4, 42, -103, -9, 28, 102, -128, -23, 31, 94},
+{-3, -4, -3, 2, 3, 1, 2, -6, -1, 4, 5, 1, 0, -1, -2, -6, 0, -7, 1, -5, 4, 3, 5, 2, 1, -4, 1, 6, -7, -6, -8, 5},
+{-6, 7, 7, -6, 5, -4, -6, 6, 5, 4, -2, 5, -4, 1, 3, 3, -5, 2, 3, 6, 0, 4, -1, -3, 4, 1, 1, 1, -3, -7, -6, -4},
+{-1, -2, -1, 2, 4, -4, -1, 2, -4, 0, -4, -3, -8, -5, 2, 3, -8, 3, -7, 7, 0, 4, 5, -2, 3, -3, 1, 4, -4, 3, 7, -5},
+{13, -46, -49, 88, 4, 76, 19, 11, 52, 40, -128, 46, -33, 98, -11, 38, 127, -50, -108, 62, -98, -114, -100, -3, -94, -2, 53, -46, 62, -59, 103, 29},
+{2, 6, 0, -2, -8, -2, -8, 6, 5, -1, 7, -4, -7, -4, 6, 2, -4, -1, 2, -6, -3, -7, -2, -5, -2, 2, -3, 0, 4, 6, 4, -5},
+{4, -6, -6, -3, -1, -8, -2, 3, -7, -8, 3, 5, -2, -6, -5, 0, -5, 5, -1, -4, -3, 0, -4, 2, -4, 7, -4, 1, 6, -8, -8, -4},
+{-6, 4, 1, -4, 3, -3, -2, 6, -6, 7, -1, 7, -6, -2, -4, -2, -2, 6, -4, -3, 6, -8, 0, 5, -1, -3, -1, -4, 0, -3, 6, 3},
+{-73, -26, 35, 81, 125, 82, -114, -4, 72, -119, -122, -67, -9, -25, -87, 115, -59, -27, 36, 4, -13, -68, -125, -87, -23, 16, 120, 32, 120, 77, -24, -32},
+{5, -2, -6, -7, -7, -5, 6, 6, -1, -3, -8, -6, 6, 0, -1, -3, 6, 1, -1, -1, 2, -7, 4, -4, 4, -5, -4, -8, -6, -8, -2, -4},
+{-4, -1, -8, 6, -6, 6, -7, -3, 1, -3, 5, 4, 0, 5, -1, 6, -2, -4, -1, 6, -2, -2, -7, 1, -2, -7, 3, -2, -4, 6, -5, -5},
+{0, 2, 0, -8, -2, 3, 4, -7, 6, -8, 3, -5, -5, 4, -5, -1, -5, -3, -1, -7, 6, -5, 2, 7, -2, 4, 1, 5, -1, 6, -8, -6}
+};
+ } 
+#endif 
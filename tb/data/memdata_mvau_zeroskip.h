@@ -0,0 +1,69 @@
+#ifndef PARAMS_MVAU_ZEROSKIP_HPP
+#define PARAMS_MVAU_ZEROSKIP_HPP
+namespace PARAM_MVAU_ZEROSKIP{ 
+static FixedPointWeights<4,ap_int<4>,2,24> weights= {
+{
+{ 
+0x47ce,
+0xa561,
+0x74c8,
+0x4892,
+0x5c32,
+0x7813,
+0x73e7,
+0xc1d2,
+0x4ef5,
+0xbc3,
+0x412a,
+0xe2b1,
+0x5eec,
+0x2e8c,
+0x4a60,
+0xbddf,
+0x1d58,
+0xca47,
+0xe7f5,
+0xd416,
+0x2ab9,
+0x379c,
+0xd1f5,
+0x9e4a} 
+,{ 
+0x8e93,
+0x1f68,
+0xaef0,
+0x5ab5,
+0xa737,
+0x2f0b,
+0x3d74,
+0x1f28,
+0x38dd,
+0x2542,
+0xc7dc,
+0xb67c,
+0x5f9e,
+0x488,
+0xbce1,
+0x3516,
+0xfca2,
+0xfcba,
+0xb0ab,
+0xc3a8,
+0x5758,
+0x6c13,
+0x5afc,
+0xc28} 
+}
+};
+static int const raw[8][24] = {
+{-2, -4, 7, 4, 1, 6, 5, -6, -8, -4, 4, 7, 2, -7, -8, 4, 2, 3, -4, 5, 3, 1, -8, 7},
+{3, -7, -2, -8, -8, 6, -1, 1, 0, -1, -2, -6, 5, -5, -6, 5, 7, 3, 7, -6, -5, 0, -1, 2},
+{7, -2, 3, 7, 2, -3, 1, -4, 5, -1, -2, 4, 3, -4, -5, 0, -6, 2, 1, 4, 1, -5, 2, -2},
+{4, 7, -3, 3, -8, 2, -1, 1, -3, -3, -8, 3, 2, 4, 5, 2, -4, -3, 7, -4, -4, 7, 6, -5},
+{-4, -2, -2, 5, -4, -8, -2, 2, 0, 6, -6, 4, -1, -3, -3, -5, -8, 5, -3, 1, 7, 4, -6, -4},
+{-2, -7, -1, 5, -8, -8, 4, 0, 1, -2, -4, -5, 6, 1, 5, 3, 2, -6, -4, -1, -6, -5, -4, -1},
+{5, -1, 7, -2, 6, 1, 4, -3, -7, -5, -6, 2, -4, -7, 7, 3, 5, -1, 1, -3, -6, 4, -2, -7},
+{-5, -6, 0, -5, -8, -6, 3, -4, -8, 5, 7, 5, 3, 1, -4, 6, -4, -1, -6, 5, -8, 2, -4, 0}
+};
+ } 
+#endif 
@@ -0,0 +1,157 @@
+#ifndef PARAMS_PACKED_HPP
+#define PARAMS_PACKED_HPP
+namespace PARAM_PACKED{ 
+static PackedFixedPointWeights<2,ap_int<4>,8,128,8> weights= {
+{
+{
+0x870df2e3e06c3d1a,
+0x410d1dab9e669679,
+0xffd6a3a1849a451a,
+0x13562b4c7979490c,
+0x17e95d3516162335,
+0xe5ee06404cf69a90,
+0xc90f8ee7d2f63087,
+0x491faf17c0e65bdd,
+0x2b434f861633e328,
+0x603a8ab93111e52,
+0x95aa2c7d5f6a2551,
+0xe7cb200ea269ca2c,
+0xa7e6f71a4aae798b,
+0x801dbafc5fa4df86,
+0xed65bfe4636d1034,
+0x176d7893cd4fe370,
+0xb3037442295099b0,
+0xc100963c8148de0f,
+0x31e1643731b1f61d,
+0xdab56a0f6de1d3f6,
+0xb145d5097b9d6500,
+0x2ba6fc8d0df972dd,
+0xbb8540067110c09c,
+0x84906b5554ff8d9d,
+0xa7263f4b99a0df2f,
+0xe5d2164c3c830ddd,
+0x258919dc7a1c1a71,
+0x16ca4c539ace244d,
+0x9f0b708c04cf7d93,
+0xd5f3736972c6366c,
+0x2512e894698ccbb3,
+0xb38c3acf7e2a86f1,
+0xbf2222321f9f92fb,
+0xf4983da501855c72,
+0xf89cf00bae870615,
+0x30e0b6a213d008ba,
+0xe72bca95adc2a764,
+0xf9e7e4562beb3940,
+0xa48f7ae7a31cd2f6,
+0x207551f0f7328a04,
+0x838ea7a36ab01d72,
+0x40a2e64d4d5c6070,
+0x5f77fbb3ebab0d23,
+0x423149535a5eb19d,
+0xdafd0018f0300104,
+0xa28b1d0aaed78349,
+0x1967caeed6de5d37,
+0xa7f9a543e310b84a,
+0xf47311b955e11972,
+0xe737e4d60071a5e4,
+0x8088b135bce56268,
+0x354048ef9eb3dbd9,
+0x51b90ca46a34ac93,
+0x85b7fa7017bac1,
+0xa17e0b6db60421e,
+0x15d1b82dd3cf8d54,
+0xceb1487284a9ab03,
+0xd48206c5d59dcdbf,
+0x5b06948c5c4b0290,
+0x22b07320c4c6aa7f,
+0xb4f30e123a4f9e43,
+0xb158fccdc4497de2,
+0x19ff773bfb93f0ce,
+0x67784a3f71c646c4,
+0x15e58081fdff7606,
+0xd920427a99192b0e,
+0x26a03d27eaf25f96,
+0xec90ffae8d200f1b,
+0xa5494a43cd173d84,
+0xfe25c3aca823606b,
+0x57e04e796e6bd85f,
+0x57f4446b6c2c731d,
+0xfa6e227f0c8014b2,
+0xfebc090224008b01,
+0x8c73e8975faa325c,
+0xa6b57356b3697279,
+0x31968043e87e0796,
+0xf93efdd2d4cf5820,
+0x77cf293748b7a6be,
+0x90a91c925c50d6ed,
+0x3cedf8801df73e9a,
+0x32a800634600452d,
+0xff557aca0959769d,
+0xb0e215921152d75a,
+0xadfbc52f65b499ff,
+0xdbc6d0a6c99ddc9a,
+0x2d81988a49319b30,
+0xdb0d8567e929c064,
+0x4c6bc1218700e23c,
+0x21443d795b9fba14,
+0x8e5781e026898f9b,
+0x1809ab693b0c196e,
+0x9ed4320041b9a63a,
+0x96814773a7f989f0,
+0xaeb0a2c2e7be0b51,
+0xe5e1402795d5e2f5,
+0x32a4655987467d1f,
+0xbdf78af86d218a4d,
+0x35843471c23c2a31,
+0xee0bf966599ab6b4,
+0x9eb83c5a1641e548,
+0x9aa609ccd8dfc7eb,
+0x55d981425526b71f,
+0x2ba8de0adabd34fe,
+0xc00abfd2a40d4b,
+0x673ac961ca0c258c,
+0xea4ebd8ce910d6d,
+0x711b8ca2c567bf08,
+0x31a73fc43c25b767,
+0x3c533c0765bb4419,
+0x5897ff3e1e64605a,
+0x33d6ecc70e34dbf6,
+0x2f4ebc073c7b748,
+0xa892d47f90cce833,
+0x79c5568db06e40dd,
+0xd9eb7f5edc1dd639,
+0x42dc15fdce6cc048,
+0xb874bd390f579408,
+0xe67bb5c1c0d46473,
+0xd54cccf6d33e39b6,
+0xfa508519a4546ca2,
+0x1cc4948ca7290808,
+0x4148b30f50007cf9,
+0x11ebfed4c3e29c82,
+0x8e07578df352db2b,
+0xd3366f74e7d1e720,
+0xb2ea381c0ddf28a,
+0x7af550fbe5061e2a
+}
+}
+};
+static int const raw[16][128] = {
+{-6, 1, -7, 7, -6, 1, -4, 0, 5, 3, 0, -7, 7, -8, -3, -3, -8, 2, 2, 5, 1, 5, -4, 2, -5, -8, 6, -8, 4, 3, 0, 7, 0, -5, -1, 0, -3, 1, 6, -1, 0, 0, -3, -3, -4, -7, -3, -7, -1, 2, -3, -3, 1, 7, -3, 4, 3, -7, -4, 6, 3, -5, 1, -1, -5, -1, 2, 7, 5, 1, -6, -5, 4, 6, 0, 4, 6, -1, 4, 0, 2, 7, 0, 7, 3, 2, -3, -7, 4, 0, -7, 4, 7, 3, -6, 4, 2, 7, 4, -2, -8, 6, -7, -3, 3, -7, 1, -4, -2, 1, 4, 5, 3, 0, -1, -5, 0, -7, -1, 7, 3, 4, 2, -2, -2, -4, 4, -4},
+{-3, 3, 6, -7, 5, 4, -7, 4, 3, 2, -6, -7, 0, 3, -5, 5, 3, -2, -2, 1, 5, 2, -6, -4, -7, 7, -1, -3, 0, 1, 3, -2, -7, -7, -2, -3, 6, -1, 3, -3, 5, 6, 2, 7, 0, -4, -3, -8, -1, -3, -3, 0, -6, 1, 4, 2, -3, 7, 6, 3, -5, -4, 6, -8, 2, -7, -4, 5, 6, 0, -8, 0, 7, -6, -7, 3, 2, -3, -6, -8, -3, 1, 0, 6, -3, 0, 1, -5, 1, 0, 3, -8, -3, 5, -8, -5, -7, 1, 5, -6, 2, 6, -5, -3, -4, -6, -6, -5, 2, 4, -3, -8, -5, -6, -3, -4, 2, 0, -6, -6, -2, -7, -3, 7, 0, -1, 6, 4},
+{-4, 6, 6, 6, -6, -7, -7, 7, 6, 1, 6, -1, 6, -1, 6, -2, 3, 3, 1, 1, -6, 6, -7, 6, -2, -6, 4, -6, -3, 6, -1, 4, 0, 5, -8, 4, 1, -5, 1, -2, -3, -7, -7, -1, 0, 1, -1, -1, 0, -6, 3, -8, -4, 1, -2, -4, -1, -4, 6, -4, -4, -8, -6, 2, -1, -7, 5, -8, 7, -8, 0, -3, 2, -4, -5, -2, -4, 1, 2, 3, 0, -5, -4, 5, -5, -6, -2, 5, 0, 3, 7, -3, -2, -3, 0, 1, 1, -2, 1, 7, 5, -2, 3, -5, 4, 3, 7, 1, 0, 6, -1, -4, -7, -6, -3, -7, -5, 4, 6, -4, -1, 4, -7, 4, 3, -7, 6, -4},
+{0, -2, -2, -7, 4, -8, -7, 7, 6, 1, -4, 4, 2, -3, 0, -4, 6, 1, 3, -7, -1, 5, 2, -6, -6, 4, -1, 5, 3, 6, -3, -4, -7, 2, 1, -8, 1, 3, -3, 6, -5, 7, -3, 0, 1, 7, 4, 5, -7, -7, -4, 3, -6, 7, -6, -7, 4, 0, 2, 7, -7, 6, -2, 7, -1, 1, 1, 0, -2, -6, 3, 1, -3, -6, -5, 2, 3, -6, 7, -1, -6, 6, -3, 4, -5, -2, -6, 5, 0, -1, -2, -6, 6, -3, 3, -2, 5, 5, 0, 0, -4, -5, -2, -7, -6, 6, 0, 7, -5, -3, 3, -3, 4, -8, 5, -3, -4, 5, 4, -4, -6, 3, 4, -4, -5, -1, 1, 7},
+{3, -2, -5, -6, 1, -6, -4, 4, 5, 3, 0, 4, 7, -2, 7, 1, 6, -8, -5, -6, -3, 7, -2, 0, -6, 1, -4, -1, 4, -2, 3, -7, 2, 4, -4, 3, 7, 3, -1, 0, -7, 0, -3, -8, 6, 0, 5, 5, -5, 4, -4, 4, -4, -3, 3, 5, -4, -8, -7, 6, 4, -7, -1, -4, 2, 3, 5, -6, -5, 0, 2, -6, 5, -7, 6, 5, 7, -2, 0, -1, 3, -6, -3, 4, 3, -5, 3, 5, -8, 1, -6, 0, -2, -2, 3, 4, -7, -5, 6, -3, 5, 3, -1, -2, 4, -6, -6, -1, 6, -5, -3, 2, 2, 7, 5, -4, -4, -8, 0, 2, 2, 1, -3, -4, -5, 3, -1, 3},
+{2, -1, -3, 1, 3, -6, -5, 2, -3, 5, 6, 0, -2, -8, -1, -6, -1, 4, -8, -6, -4, 2, 0, 2, 7, -1, -6, -5, -1, -5, -8, 7, 4, 7, 6, -7, 4, 6, -6, 6, 5, -3, -4, -1, 0, 4, -5, 6, -1, 3, 6, 1, -7, 1, -4, 4, 0, 7, 3, 7, -8, -2, -6, 3, 2, 2, -3, 3, 0, -1, 6, -5, -6, -4, 4, -2, -6, 7, 1, 5, 7, -6, 6, -2, -5, -1, -7, 4, 0, 0, -3, 1, -6, -4, 5, -6, 1, 1, 4, -2, 1, -5, -8, 4, -4, 0, 7, -5, 0, -2, -8, -5, -8, 4, 6, 0, 4, -7, 3, 7, -2, 0, -4, -1, 7, 7, -6, 4},
+{-3, 0, -3, 0, 6, -3, 6, 5, -7, -2, -2, -2, -1, 0, -1, 1, 3, 4, 3, 0, -6, -6, -5, -4, 6, -2, -3, 1, 5, 6, -3, 6, 3, 0, 0, 0, 1, -2, 5, -5, 5, 4, 6, -6, 5, -8, 0, -7, 6, 2, 2, -3, -7, -8, -6, -4, -5, 0, 3, -1, 2, 1, -4, -8, 2, 2, -8, -7, -4, -7, 0, -2, -5, 2, 7, -2, -1, -8, 5, 7, -2, -8, 2, -6, 7, 7, 1, 3, -3, -1, -5, -8, 7, 6, -7, -1, 3, 7, 7, 3, -8, -8, 0, 4, -7, -5, 5, -8, 7, 1, 1, -3, 1, -5, 2, -8, 6, 0, 0, -5, 3, -1, -8, 5, -1, -1, -8, 7},
+{7, -8, 1, 4, -1, -1, 3, 1, 7, 1, 5, -2, -7, -4, -7, 4, -5, 2, 6, 0, 5, -7, 7, -2, 7, -6, 0, -8, -3, -2, 7, 1, 3, -5, 1, -4, 1, 3, -6, -3, 1, -5, -5, 2, -5, -5, 4, -8, 7, -6, 5, -2, 5, 2, 6, 1, -1, -7, 5, -3, 5, 2, 3, -5, -1, -5, 4, -1, -8, -1, 0, 3, 7, -2, -7, -1, 4, -6, 0, 2, 3, -8, 0, 4, -1, 5, 2, 4, -6, -3, 2, -6, -7, 1, 7, -6, 4, -1, 7, -2, 0, -8, 5, 3, 1, 5, 0, 0, -6, 0, 5, 1, -2, -4, 4, -3, -5, 5, 2, 2, 4, -5, 1, -5, -7, 1, 7, 6},
+{6, 0, -2, 0, 6, -7, -5, 1, 4, -8, -5, 6, -1, 5, -3, 1, 2, -5, 1, 0, -4, 5, -7, 7, 6, -7, 0, 2, -2, -5, -3, -2, -6, -7, -3, 2, -3, -7, -6, 5, -1, -1, -6, -7, 0, 3, 4, 6, -4, 3, 4, 1, -5, -7, -2, 6, -6, 3, 0, -1, 1, 5, 5, -1, -1, 1, -3, 4, 1, 3, 4, -5, -8, 4, -5, -2, -1, 1, -2, -1, -5, 4, -4, -8, -3, 6, -8, 0, 7, 6, -7, 1, -6, 5, 6, -1, -8, 4, 3, 3, -3, -3, -7, 3, -8, 4, -8, 0, 3, 7, 6, -5, 2, -6, -8, 0, -7, -1, 2, -8, -5, 2, 0, 2, -6, -8, -6, 2},
+{6, 7, -5, 2, -1, 5, -1, 0, -3, 3, 0, 6, -8, -3, 3, 7, 4, 1, -5, -8, 2, 3, 2, 7, 7, 0, -8, 5, 6, -6, 6, -3, -2, 3, 5, 4, 6, 7, 7, -3, -7, -7, -4, -3, -5, -7, 0, -4, 2, -2, -6, -5, -1, -8, -7, 1, 6, -6, -7, -8, -5, 0, 2, -2, -3, 7, -6, -8, -6, 2, 6, -5, 5, -2, 7, -4, 7, -5, 4, 3, -3, 0, 5, 2, -3, 0, -1, -5, 7, -5, 4, 4, 0, 6, -5, -3, 7, -5, -8, -2, 0, 4, 6, -3, 0, -4, 4, -7, 4, 6, -7, 3, -4, 6, -8, 0, -4, 7, -4, -7, -5, -3, 7, -2, 2, -1, -2, 1},
+{-1, -1, -7, 1, 2, -1, 0, 2, 7, 1, 3, 2, -5, 6, -4, 2, 0, -8, 0, 0, -6, -6, -7, 6, -2, 7, -1, -4, 7, -5, 0, 5, 7, -1, 0, 0, -7, 5, 2, 5, 4, -5, -3, -7, 1, 3, -7, 2, 0, 0, -1, -7, -7, -8, -4, 0, -7, -5, -7, -1, -2, -5, 5, -3, 6, 4, 1, 2, -4, 3, -6, -7, 1, 4, -1, -3, 6, 2, -3, -5, 4, -6, -4, 0, 1, -7, 7, 6, 5, 2, -5, -5, 4, 6, 4, 3, 7, -4, -4, -4, -2, 6, -3, 1, -4, 6, 7, 5, 4, -3, -2, 3, 4, 5, -7, 2, 0, 0, 2, -2, 2, 5, 1, -3, -3, -3, 6, 0},
+{-3, -1, -7, -7, -6, -2, -3, -8, -3, -4, -8, -6, -2, 6, -4, 6, -4, 0, 4, 2, -1, 5, 3, -5, -8, -2, 4, -3, -8, 4, -4, 5, -3, 1, 6, 4, -7, 0, 1, 1, 5, 6, -7, -4, -7, 4, -7, -2, 7, -8, -5, 5, 6, 2, -5, 3, 1, 4, 7, -6, 7, -2, 5, -7, 7, -8, -3, 6, 2, -4, -7, 5, 6, 1, -8, -3, 5, 5, -6, -3, 2, -3, -6, -4, -2, -4, 5, -4, -4, 3, 5, 6, -2, 1, -2, 0, 3, 7, 0, -7, 0, -5, -4, -3, -2, -4, -1, 0, 0, -4, 3, -3, 4, -6, 7, -6, 0, 5, 3, -4, 3, -1, 7, -2, 0, -4, 5, -2},
+{1, -8, -6, 7, 7, 2, -2, -6, 3, 4, -4, -6, -7, 7, -5, 6, -1, 7, 2, 0, 7, -7, 6, 5, 3, 4, 2, -3, 7, 3, 2, -7, 0, -8, 3, 6, -6, -4, 2, -7, -1, 2, 6, -6, -6, -8, 7, 6, 1, 2, -7, 7, 0, -2, -7, 6, 0, 0, 3, 7, 2, -4, 7, 2, -7, 5, -8, -1, 1, 7, 6, 6, -6, 5, -4, -4, 2, 4, -6, 0, -1, -5, 1, 6, -8, -3, 2, -6, 4, -4, 7, 0, -2, 3, 7, -4, 0, -4, -1, 7, -3, -8, -2, 5, -3, -1, -7, 3, 1, -4, 6, -1, -7, 1, -4, -8, -1, 0, 4, -3, -3, -8, 4, 7, 1, -8, -5, -1},
+{0, -8, 2, 4, -3, 3, -1, -1, -6, 4, 3, -4, -2, 4, 4, 4, 2, 2, -7, 0, -8, -2, 3, 7, 0, -8, -3, -1, -7, 2, -4, 1, -8, -1, 0, 0, -6, 7, 5, 1, 5, -4, 0, -3, -8, -7, 5, -8, 1, -4, -3, 3, 1, -8, -5, -6, 2, 3, 7, 4, 2, -6, 0, 4, 5, 6, -6, -8, 4, 3, -7, -1, -4, 3, -7, 0, 1, -8, -2, -3, -6, 0, -7, -4, -5, -2, -4, -8, -1, 3, -4, 3, -1, -1, -4, -2, -5, -2, 4, -3, 6, 5, -1, 7, 5, 1, -3, -5, 5, -5, -4, -4, 5, -8, 4, -7, 3, -5, -2, -1, 7, 5, -1, 6, 3, -6, 0, 5},
+{5, -2, 0, 2, 0, -6, 0, -7, -7, 4, 5, 2, 0, -2, 4, -1, -2, 6, -4, -5, 3, 7, 5, -5, 6, -7, -2, 3, -1, -4, -7, -6, -3, -2, -8, -6, 5, 5, 2, -2, -5, -1, 6, -4, 1, -8, -3, 0, -5, 6, 4, 4, 7, 5, -7, 0, 4, -3, 1, -8, 0, -5, 1, -2, 4, -6, 7, -1, 4, -8, -5, 0, -8, -5, 6, -6, -7, -3, -8, -6, 0, -4, -6, 3, 4, -6, -5, 1, 7, -6, 3, 5, 7, -7, 6, -3, 4, -1, 2, -7, 5, -4, -5, -2, -4, -3, 4, 7, -5, 7, -4, 4, 0, 5, 4, -4, -8, 4, -5, -2, 7, 0, 6, 3, -2, 2, 5, -1},
+{5, 1, -7, -3, 6, 2, -4, -2, 5, -6, -2, -1, 7, 5, 7, 5, -6, -1, -2, -1, -4, -8, 6, -6, 1, 3, -7, -1, 7, 7, 0, -7, -4, 3, 2, 3, -1, -1, 0, -5, -3, -6, -5, -3, -3, 2, -5, -3, -4, 4, 1, 2, -2, -8, -8, 1, -2, -7, 6, -7, -2, -6, 5, -2, 2, 3, -3, -5, 5, 3, -2, -2, -2, -7, -6, -7, 5, 5, -5, 2, 0, 0, 7, 6, -2, 0, 1, 7, 1, 3, -4, 3, -8, 5, 3, 3, 2, 0, -8, -6, -7, 7, -7, -3, 2, 4, -8, -5, 6, -2, 5, -3, -6, -1, -4, 1, 1, 4, 1, 1, -2, -8, 3, -3, -5, 0, -6, 7}
+};
+ } 
+#endif 
@@ -0,0 +1,173 @@
+#ifndef PARAMS_PARAM_FILE_HPP
+#define PARAMS_PARAM_FILE_HPP
+namespace PARAM_PF{ 
+static FixedPointWeights<4,ap_int<4>,4,32> weights= {
+{
+{
+0x29ad,
+0xeccf,
+0x39bd,
+0x4621,
+0x8b21,
+0xdfcc,
+0xb517,
+0x830c,
+0x68dd,
+0x349b,
+0xb89b,
+0x8f05,
+0xc151,
+0xd6da,
+0xe2d2,
+0x8aee,
+0x34d,
+0xc5b6,
+0xbe2a,
+0x4cea,
+0x5a2a,
+0x2da,
+0x4908,
+0xb388,
+0x19ee,
+0x9985,
+0x1af3,
+0x7d58,
+0xc1f7,
+0x8342,
+0x7e82,
+0x8f21
+},
+{
+0x140d,
+0x7ed2,
+0x1536,
+0xaf00,
+0xf1e8,
+0x2f49,
+0x9e26,
+0x5171,
+0x25f4,
+0x445b,
+0x3985,
+0xa740,
+0xe05b,
+0x6f6c,
+0x444b,
+0xec85,
+0xc4a6,
+0x130,
+0x9b6,
+0x63ce,
+0x1c84,
+0xe424,
+0x4b69,
+0x6674,
+0x7de0,
+0x4c87,
+0x9f39,
+0x5ff6,
+0xd4ac,
+0x2edf,
+0xb5e1,
+0x8b48
+},
+{
+0x7451,
+0x8f71,
+0xab48,
+0xd1f0,
+0x9d08,
+0x1e5c,
+0x6033,
+0x6fac,
+0x365e,
+0x531c,
+0x5ce3,
+0xe7e3,
+0x724b,
+0xf0f3,
+0xa3b2,
+0xf3b4,
+0x4720,
+0x8330,
+0x702a,
+0x9a7d,
+0xe862,
+0xd862,
+0x9285,
+0x67ed,
+0x25b0,
+0xeac,
+0xdcd1,
+0xacdd,
+0x6779,
+0x1d24,
+0xbfe6,
+0xeed9
+},
+{
+0x5968,
+0xfbf9,
+0x882c,
+0xa2f7,
+0xf752,
+0xd488,
+0xd906,
+0x321a,
+0x764e,
+0x2673,
+0xeeb0,
+0x71eb,
+0x8a96,
+0x4ef8,
+0x8dd,
+0x635c,
+0xb5cb,
+0xf6fb,
+0x873c,
+0x4346,
+0x7719,
+0x159a,
+0xdeb9,
+0xcf3a,
+0x8946,
+0x13f3,
+0xf4d5,
+0x33cf,
+0x2dd5,
+0x1353,
+0x7b2c,
+0x2c7a
+}
+}
+};
+static ThresholdsActivation<4,4,3,ap_int<16>,ap_uint<2>> threshs= {
+{
+{
+{ -686, -215, 918 },
+{ -370, 294, 388 },
+{ -525, -153, 887 },
+{ -725, -293, 521 }
+},
+{
+{ 372, 575, 793 },
+{ 25, 649, 853 },
+{ -392, 238, 656 },
+{ -598, 751, 810 }
+},
+{
+{ -465, 129, 351 },
+{ -673, -617, 255 },
+{ -854, 539, 743 },
+{ -351, -88, 557 }
+},
+{
+{ 601, 625, 908 },
+{ -708, -421, 120 },
+{ -223, 35, 455 },
+{ -388, -334, 833 }
+}
+}
+};
+ } 
+#endif 
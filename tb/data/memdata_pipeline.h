@@ -0,0 +1,75 @@
+#ifndef PARAMS_PIPELINE_HPP
+#define PARAMS_PIPELINE_HPP
+namespace PARAM_PIPELINE{ 
+static FixedPointWeights<2,ap_int<4>,2,18> conv_weights= {
+{
+{ 
+0x3e,
+0x1d,
+0xf1,
+0x8,
+0xed,
+0x61,
+0xa,
+0x16,
+0x76,
+0x90,
+0xa9,
+0x9c,
+0xdd,
+0xef,
+0x3a,
+0x70,
+0xe,
+0xfb} 
+,{ 
+0x43,
+0xb6,
+0xc8,
+0x3a,
+0x13,
+0x36,
+0x76,
+0x45,
+0x66,
+0x9,
+0x7c,
+0x47,
+0x63,
+0x6f,
+0x54,
+0xed,
+0x59,
+0xad} 
+}
+};
+static int const conv_weights_raw[4][18] = {
+{-2, 3, -3, 1, 1, -1, -8, 0, -3, -2, 1, 6, -6, 0, 6, 1, 6, 7},
+{3, 4, 6, -5, -8, -4, -6, 3, 3, 1, 6, 3, 6, 7, 5, 4, 6, 6},
+{0, -7, -7, -6, -4, -7, -3, -3, -1, -2, -6, 3, 0, 7, -2, 0, -5, -1},
+{-7, 0, -4, 7, 7, 4, 3, 6, -1, 6, 4, 5, -3, -2, -7, 5, -3, -6}
+};
+static FixedPointWeights<8,ap_int<4>,4,2> fc_weights= {
+{
+{ 
+0x3e69259a,
+0x3245e05b} 
+,{ 
+0x1a30075f,
+0x1e5218f7} 
+,{ 
+0xa3d6339e,
+0x3b780cf2} 
+,{ 
+0xf151be8c,
+0x2afcff5a} 
+}
+};
+static int const fc_weights_raw[4][16] = {
+{-6, -7, 5, 2, -7, 6, -2, 3, -5, 5, 0, -2, 5, 4, 2, 3},
+{-1, 5, 7, 0, 0, 3, -6, 1, 7, -1, -8, 1, 2, 5, -2, 1},
+{-2, -7, 3, 3, 6, -3, 3, -6, 2, -1, -4, 0, -8, 7, -5, 3},
+{-4, -8, -2, -5, 1, 5, 1, -1, -6, 5, -1, -1, -4, -1, -6, 2}
+};
+ } 
+#endif 
@@ -0,0 +1,53 @@
+#ifndef PARAMS_POINTWISE_HPP
+#define PARAMS_POINTWISE_HPP
+namespace PARAM_POINTWISE{ 
+static FixedPointWeights<2,ap_int<4>,2,16> weights= {
+{
+{ 
+0xb2,
+0xef,
+0xc8,
+0x78,
+0x94,
+0xeb,
+0x27,
+0x84,
+0x20,
+0x80,
+0x6e,
+0x1a,
+0xe2,
+0xf6,
+0x49,
+0x9d} 
+,{ 
+0x8f,
+0x39,
+0xf7,
+0xf0,
+0xe0,
+0xd,
+0x49,
+0xa,
+0xef,
+0x26,
+0xd0,
+0xa7,
+0x2,
+0x7b,
+0x79,
+0xc6} 
+}
+};
+static int const weights_raw[8][8] = {
+{2, -5, -1, -2, -8, -4, -8, 7},
+{-1, -8, -7, 3, 7, -1, 0, -1},
+{4, -7, -5, -2, 7, 2, 4, -8},
+{0, -2, -3, 0, -7, 4, -6, 0},
+{0, 2, 0, -8, -2, 6, -6, 1},
+{-1, -2, 6, 2, 0, -3, 7, -6},
+{2, -2, 6, -1, -7, 4, -3, -7},
+{2, 0, -5, 7, -7, 7, 6, -4}
+};
+ } 
+#endif 
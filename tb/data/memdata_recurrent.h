@@ -0,0 +1,207 @@
+#ifndef PARAMS_RECURRENT_HPP
+#define PARAMS_RECURRENT_HPP
+namespace PARAM_RECURRENT{ 
+typedef ap_int<16> TA_RC;
+typedef LUTActivation<TA_RC, ap_uint<7>, 64, -512, 4> Sigmoid_RC;
+typedef LUTActivation<TA_RC, ap_int<8>, 64, -512, 4> Tanh_RC;
+typedef LUTActivation<ap_int<12>, ap_int<8>, 64, -2048, 6> TanhState_RC;
+typedef LSTMCell<2, 2, TA_RC, Sigmoid_RC, Tanh_RC, TanhState_RC, ap_int<12>, ap_int<8>, 6> LSTMCell_RC;
+typedef GRUCell<2, 2, TA_RC, Sigmoid_RC, Tanh_RC, ap_int<8>, 6> GRUCell_RC;
+static int const sigmoid_raw[64] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 4, 5, 7, 9, 11, 13, 16, 19, 22, 26, 30, 34, 38, 42, 45, 48, 51, 53, 55, 57, 59, 60, 61, 61, 62, 62, 63, 63, 63, 63, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64};
+static int const tanh_raw[64] = {-64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -63, -63, -62, -61, -59, -56, -52, -45, -35, -23, -8, 8, 23, 35, 45, 52, 56, 59, 61, 62, 63, 63, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64};
+static int const tanh_state_raw[64] = {-64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -63, -58, -30, 30, 58, 63, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64};
+static FixedPointWeights<2,ap_int<4>,8,4> lstm_wx= {
+{
+{ 
+0x3e,
+0x94,
+0x2c,
+0xe9} 
+,{ 
+0xa3,
+0xcb,
+0xa2,
+0x80} 
+,{ 
+0x6c,
+0xaa,
+0x17,
+0xe} 
+,{ 
+0xae,
+0x9a,
+0x91,
+0xed} 
+,{ 
+0x5b,
+0x7c,
+0x53,
+0x35} 
+,{ 
+0x9b,
+0x3f,
+0x9,
+0xf6} 
+,{ 
+0xbb,
+0xd1,
+0xea,
+0xc3} 
+,{ 
+0xda,
+0x6b,
+0xaa,
+0x25} 
+}
+};
+static int const lstm_wx_raw[4][4][4] = {
+{{-2, 3, 4, -7}, {3, -6, -5, -4}, {-4, 2, -7, -2}, {2, -6, 0, -8}},
+{{-4, 6, -6, -6}, {-2, -6, -6, -7}, {7, 1, -2, 0}, {1, -7, -3, -2}},
+{{-5, 5, -4, 7}, {-5, -7, -1, 3}, {3, 5, 5, 3}, {-7, 0, 6, -1}},
+{{-5, -5, 1, -3}, {-6, -3, -5, 6}, {-6, -2, 3, -4}, {-6, -6, 5, 2}}
+};
+static FixedPointWeights<2,ap_int<4>,8,4> lstm_wh= {
+{
+{ 
+0xd6,
+0xdb,
+0x5b,
+0x7e} 
+,{ 
+0xfb,
+0xdf,
+0xc7,
+0x76} 
+,{ 
+0x4,
+0xec,
+0xdb,
+0x83} 
+,{ 
+0xf8,
+0x75,
+0xb3,
+0x41} 
+,{ 
+0xe5,
+0x96,
+0x90,
+0x71} 
+,{ 
+0x45,
+0x17,
+0x8d,
+0x67} 
+,{ 
+0x6b,
+0x83,
+0xcd,
+0xcd} 
+,{ 
+0x5c,
+0x53,
+0x91,
+0x14} 
+}
+};
+static int const lstm_wh_raw[4][4][4] = {
+{{6, -3, -5, -3}, {-5, -1, -1, -3}, {-5, 5, -2, 7}, {7, -4, 6, 7}},
+{{4, 0, -4, -2}, {-8, -1, 5, 7}, {-5, -3, 3, -8}, {3, -5, 1, 4}},
+{{5, -2, 6, -7}, {5, 4, 7, 1}, {0, -7, 1, 7}, {-3, -8, 7, 6}},
+{{-5, 6, 3, -8}, {-4, 5, 3, 5}, {-3, -4, -3, -4}, {1, -7, 4, 1}}
+};
+static int const lstm_bias_raw[4][4] = {{-1, 29, -49, -16}, {54, -34, -11, 10}, {-14, 14, 52, -60}, {-10, -5, 36, -56}};
+static LSTMCell_RC lstm_cell = {
+{{{-1, -49}, {29, -16}}, {{54, -11}, {-34, 10}}, {{-14, 52}, {14, -60}}, {{-10, 36}, {-5, -56}}},
+{{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 4, 5, 7, 9, 11, 13, 16, 19, 22, 26, 30, 34, 38, 42, 45, 48, 51, 53, 55, 57, 59, 60, 61, 61, 62, 62, 63, 63, 63, 63, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64}},
+{{-64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -63, -63, -62, -61, -59, -56, -52, -45, -35, -23, -8, 8, 23, 35, 45, 52, 56, 59, 61, 62, 63, 63, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64}},
+{{-64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -63, -58, -30, 30, 58, 63, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64}}
+};
+static FixedPointWeights<2,ap_int<4>,6,4> gru_wx= {
+{
+{ 
+0x59,
+0x8e,
+0x65,
+0x9d} 
+,{ 
+0xe2,
+0x83,
+0xc5,
+0x8b} 
+,{ 
+0xd0,
+0x53,
+0xb2,
+0x6e} 
+,{ 
+0xcf,
+0x74,
+0x27,
+0x86} 
+,{ 
+0x0,
+0x87,
+0x9b,
+0x44} 
+,{ 
+0x7c,
+0x40,
+0x5e,
+0xb1} 
+}
+};
+static int const gru_wx_raw[3][4][4] = {
+{{-7, 5, -2, -8}, {2, -2, 3, -8}, {5, 6, -3, -7}, {5, -4, -5, -8}},
+{{0, -3, 3, 5}, {-1, -4, 4, 7}, {2, -5, -2, 6}, {7, 2, 6, -8}},
+{{0, 0, 7, -8}, {-4, 7, 0, 4}, {-5, -7, 4, 4}, {-2, 5, 1, -5}}
+};
+static FixedPointWeights<2,ap_int<4>,6,4> gru_wh= {
+{
+{ 
+0x56,
+0x2c,
+0x80,
+0xd3} 
+,{ 
+0x8f,
+0x35,
+0xd,
+0xf9} 
+,{ 
+0x93,
+0xab,
+0xd8,
+0x8c} 
+,{ 
+0x79,
+0x67,
+0x4f,
+0x5} 
+,{ 
+0xb1,
+0x63,
+0x67,
+0x40} 
+,{ 
+0x33,
+0x1e,
+0x2f,
+0x28} 
+}
+};
+static int const gru_wh_raw[3][4][4] = {
+{{6, 5, -4, 2}, {-1, -8, 5, 3}, {0, -8, 3, -3}, {-3, 0, -7, -1}},
+{{3, -7, -5, -6}, {-7, 7, 7, 6}, {-8, -3, -4, -8}, {-1, 4, 5, 0}},
+{{1, -5, 3, 6}, {3, 3, -2, 1}, {7, 6, 0, 4}, {-1, 2, -8, 2}}
+};
+static int const gru_bias_raw[3][4] = {{-64, 15, -27, 44}, {35, -42, -54, 59}, {44, -1, 32, 62}};
+static int const gru_bias_hn_raw[4] = {63, 11, -50, -18};
+static GRUCell_RC gru_cell = {
+{{{-64, -27}, {15, 44}}, {{35, -54}, {-42, 59}}, {{44, 32}, {-1, 62}}},
+{{63, -50}, {11, -18}},
+{{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 4, 5, 7, 9, 11, 13, 16, 19, 22, 26, 30, 34, 38, 42, 45, 48, 51, 53, 55, 57, 59, 60, 61, 61, 62, 62, 63, 63, 63, 63, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64}},
+{{-64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -64, -63, -63, -62, -61, -59, -56, -52, -45, -35, -23, -8, 8, 23, 35, 45, 52, 56, 59, 61, 62, 63, 63, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64}}
+};
+ } 
+#endif 
@@ -0,0 +1,15 @@
+#ifndef PARAMS_REQUANT_HPP
+#define PARAMS_REQUANT_HPP
+namespace PARAM_REQUANT{ 
+static RequantActivation<4,2,ap_int<20>,ap_int<8>,ap_int<16>,ap_uint<6>,-5> requant= {
+{
+{ -1090, 28732, -2884, -5780 },
+{ 19931, 20706, 21662, -13740 }
+},
+{
+{ 0, 18, 22, 20 },
+{ 27, 25, 19, 27 }
+}
+};
+ } 
+#endif 
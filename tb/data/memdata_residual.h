@@ -0,0 +1,136 @@
+#ifndef PARAMS_RESIDUAL_HPP
+#define PARAMS_RESIDUAL_HPP
+namespace PARAM_RESIDUAL{ 
+static FixedPointWeights<2,ap_int<4>,2,36> weights1= {
+{
+{ 
+0xe6,
+0xdd,
+0x4a,
+0x56,
+0xc7,
+0x86,
+0x35,
+0x7e,
+0xe2,
+0x69,
+0xb5,
+0xfb,
+0x25,
+0xf6,
+0x87,
+0x31,
+0x35,
+0xa5,
+0x6d,
+0x90,
+0x8a,
+0xe,
+0xa0,
+0xd2,
+0xf9,
+0x4a,
+0x7f,
+0x5,
+0x5b,
+0x32,
+0x32,
+0x3,
+0x4f,
+0x35,
+0x70,
+0x68} 
+,{ 
+0x9b,
+0x38,
+0xb6,
+0x83,
+0x3c,
+0x3d,
+0x51,
+0x31,
+0x75,
+0xd5,
+0xcd,
+0xa,
+0xa9,
+0xda,
+0xaa,
+0x8a,
+0xd4,
+0x71,
+0xfe,
+0xa8,
+0x83,
+0x26,
+0x7e,
+0x76,
+0x39,
+0x7d,
+0xaf,
+0x83,
+0x9c,
+0x9f,
+0xa6,
+0x4d,
+0x50,
+0xd1,
+0xf0,
+0x35} 
+}
+};
+static int const weights1_raw[4][36] = {
+{6, -2, -3, -3, -6, 4, 6, 5, 7, -4, 6, -8, 5, 3, -2, 7, 2, -2, -7, 6, 5, -5, -5, -1, 5, 2, 6, -1, 7, -8, 1, 3, 5, 3, 5, -6},
+{-5, -7, -8, 3, 6, -5, 3, -8, -4, 3, -3, 3, 1, 5, 1, 3, 5, 7, 5, -3, -3, -4, -6, 0, -7, -6, -6, -3, -6, -6, -6, -8, 4, -3, 1, 7},
+{-3, 6, 0, -7, -6, -8, -2, 0, 0, -6, 2, -3, -7, -1, -6, 4, -1, 7, 5, 0, -5, 5, 2, 3, 2, 3, 3, 0, -1, 4, 5, 3, 0, 7, -8, 6},
+{-2, -1, -8, -6, 3, -8, 6, 2, -2, 7, 6, 7, -7, 3, -3, 7, -1, -6, 3, -8, -4, -7, -1, -7, 6, -6, -3, 4, 0, 5, 1, -3, 0, -1, 5, 3}
+};
+static FixedPointWeights<4,ap_int<4>,1,36> weights2= {
+{
+{ 
+0xe1b9,
+0x4e92,
+0x99b1,
+0x9e71,
+0xc931,
+0xdc2b,
+0xec42,
+0x29f0,
+0x66a6,
+0xcea4,
+0xcb28,
+0x7556,
+0x6284,
+0x926d,
+0x240d,
+0x1250,
+0x960d,
+0xfb7c,
+0x6987,
+0x2132,
+0x73d0,
+0xefd1,
+0x48bd,
+0x7e4b,
+0x8fa3,
+0x7b1f,
+0x949e,
+0x891,
+0x4a93,
+0x4278,
+0x2b28,
+0x24f,
+0x3e09,
+0x587e,
+0x2f9a,
+0x77c1} 
+}
+};
+static int const weights2_raw[4][36] = {
+{-7, -5, 1, -2, 2, -7, -2, 4, 1, -5, -7, -7, 1, 7, -2, -7, 1, 3, -7, -4, -5, 2, -4, -3, 2, 4, -4, -2, 0, -1, -7, 2, 6, -6, 6, 6},
+{4, -6, -2, -4, -8, 2, -5, -4, 6, 5, 5, 7, 4, -8, 2, 6, -3, 6, 2, -7, -3, 0, 4, 2, 0, 5, 2, 1, -3, 0, 6, -7, -4, 7, -5, -1},
+{7, -8, -7, 6, 2, 3, 1, 2, 0, -3, 3, 7, 1, -3, -1, -2, -3, -5, -8, 4, -5, 4, -2, 7, 3, -6, -1, -8, -1, 1, -5, 7, -2, -7, 4, -7},
+{1, -7, -8, 0, 3, -7, -6, 4, -8, 7, 2, 4, -8, 2, -5, 2, -1, 4, 2, 0, -7, 0, -2, 3, -2, 7, -8, 5, -6, -7, -1, 2, 1, -4, 7, 7}
+};
+ } 
+#endif 
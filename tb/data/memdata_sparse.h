@@ -0,0 +1,53 @@
+#ifndef PARAMS_SPARSE_HPP
+#define PARAMS_SPARSE_HPP
+namespace PARAM_SPARSE{ 
+static SparseFixedPointWeights<4,ap_int<4>,2,8,20> weights= {
+{
+{ 
+0x65ca,
+0x459c,
+0xf56f,
+0x0,
+0x75c0,
+0x4876,
+0xe0c8,
+0xd208,
+0xf905,
+0x0,
+0xa88a,
+0x8482,
+0x2a24,
+0x6686,
+0x3346,
+0xb628,
+0xde5,
+0x4100,
+0x8798,
+0x7819} 
+,{ 
+0xb731,
+0x899e,
+0xdf87,
+0x0,
+0x7ab,
+0xd7f5,
+0x9f,
+0xf637,
+0xbe17,
+0x0,
+0xab7d,
+0xc946,
+0xf344,
+0x1f77,
+0xd13a,
+0xeb77,
+0x39bd,
+0x8e3b,
+0x8b35,
+0x95b9} 
+},
+{ 0, 3, 7, 6, 5, 2, 5, 6, 7, 6, 1, 4, 5, 6, 7, 0, 2, 3, 2, 4 },
+{ 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 0, 0, 1, 0, 1 }
+};
+ } 
+#endif 
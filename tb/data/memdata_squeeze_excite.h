@@ -0,0 +1,127 @@
+#ifndef PARAMS_SQUEEZE_EXCITE_HPP
+#define PARAMS_SQUEEZE_EXCITE_HPP
+namespace PARAM_SQUEEZE_EXCITE{ 
+static FixedPointWeights<4,ap_int<4>,2,4> weights1= {
+{
+{ 
+0xee36,
+0xeb4f,
+0x9d70,
+0x4238} 
+,{ 
+0xa360,
+0xd793,
+0x128,
+0xb9e6} 
+}
+};
+static int const weights1_raw[4][8] = {
+{6, 3, -2, -2, -1, 4, -5, -2},
+{0, 6, 3, -6, 3, -7, 7, -3},
+{0, 7, -3, -7, -8, 3, 2, 4},
+{-8, 2, 1, 0, 6, -2, -7, -5}
+};
+static FixedPointWeights<2,ap_int<4>,4,4> weights2= {
+{
+{ 
+0xbe,
+0xd1,
+0x16,
+0x8c} 
+,{ 
+0xe0,
+0xf3,
+0xde,
+0x50} 
+,{ 
+0x4f,
+0xf7,
+0x90,
+0x99} 
+,{ 
+0xae,
+0x6b,
+0xb4,
+0xd6} 
+}
+};
+static int const weights2_raw[8][4] = {
+{-2, -5, 1, -3},
+{0, -2, 3, -1},
+{-1, 4, 7, -1},
+{-2, -6, -5, 6},
+{6, 1, -4, -8},
+{-2, -3, 0, 5},
+{0, -7, -7, -7},
+{4, -5, 6, -3}
+};
+static LUTActivation<ap_int<20>,ap_uint<4>,64,-16384,9> sigmoid= {
+{
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+1,
+1,
+1,
+1,
+1,
+2,
+2,
+3,
+3,
+4,
+5,
+6,
+7,
+8,
+8,
+9,
+10,
+11,
+12,
+12,
+13,
+13,
+14,
+14,
+14,
+14,
+14,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15,
+15
+}
+};
+ } 
+#endif 
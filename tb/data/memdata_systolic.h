@@ -0,0 +1,123 @@
+#ifndef PARAMS_SYSTOLIC_HPP
+#define PARAMS_SYSTOLIC_HPP
+namespace PARAM_SYSTOLIC{ 
+static FixedPointWeights<4,ap_int<4>,8,8> weights= {
+{
+{
+0x7b3a,
+0x1f4,
+0x83e0,
+0xd1d0,
+0x6f09,
+0xc84e,
+0x68c,
+0x7d8f
+},
+{
+0xf481,
+0xf317,
+0xd1b2,
+0x26d5,
+0x48c8,
+0x33c4,
+0x3c90,
+0x948
+},
+{
+0x9723,
+0x4718,
+0x2e48,
+0xe7cd,
+0xeb22,
+0x36e5,
+0xb4d4,
+0x4612
+},
+{
+0xf13a,
+0x36e9,
+0x3f5c,
+0x2893,
+0xaab,
+0x5448,
+0x2f80,
+0xe8c6
+},
+{
+0xaf3f,
+0xf700,
+0x19b5,
+0x599,
+0xf386,
+0xd77e,
+0x411f,
+0xc89c
+},
+{
+0x4297,
+0x3e93,
+0x8117,
+0x38d4,
+0x4130,
+0xadfe,
+0xb645,
+0xbe3
+},
+{
+0xb53d,
+0x4415,
+0x853d,
+0xb44d,
+0xfb05,
+0xb065,
+0x91bd,
+0x6d89
+},
+{
+0x645a,
+0x51c5,
+0xb3df,
+0x876c,
+0x5675,
+0xd995,
+0x818b,
+0xbc77
+}
+}
+};
+static int const raw[32][8] = {
+{-6, 3, -5, 7, 4, -1, 1, 0},
+{1, -8, 4, -1, 7, 1, 3, -1},
+{3, 2, 7, -7, -8, 1, 7, 4},
+{-6, 3, 1, -1, -7, -2, 6, 3},
+{-1, 3, -1, -6, 0, 0, 7, -1},
+{7, -7, 2, 4, 3, -7, -2, 3},
+{-3, 3, 5, -5, 5, 1, 4, 4},
+{-6, 5, 4, 6, 5, -4, 1, 5},
+{0, -2, 3, -8, 0, -3, 1, -3},
+{2, -5, 1, -3, 5, -3, 6, 2},
+{-8, 4, -2, 2, -3, -4, 7, -2},
+{-4, 5, -1, 3, 3, -7, -8, 2},
+{5, -5, -7, 1, -7, -7, 5, 0},
+{7, 1, 1, -8, 4, -3, -8, 3},
+{-3, 3, 5, -8, -3, 4, 4, -5},
+{-1, -3, 3, -5, -4, 6, 7, -8},
+{-7, 0, -1, 6, -2, 4, -8, -4},
+{-8, -4, -8, 4, 4, -4, 3, 3},
+{2, 2, -5, -2, 5, -2, 6, 3},
+{-5, -6, -6, 0, -8, 4, 4, 5},
+{6, -8, 3, -1, -2, 7, 7, -3},
+{0, 3, 1, 4, -2, -1, -3, -6},
+{5, 0, -5, -1, 5, 6, 0, -5},
+{5, 7, 6, 5, 5, -7, -7, -3},
+{-4, -8, 6, 0, -1, -8, -3, 7},
+{0, -7, -4, 3, -8, 4, -7, 0},
+{4, -3, 4, -5, 2, 1, 6, 4},
+{0, -8, -1, 2, 6, -4, -8, -2},
+{-1, 1, 1, 4, -4, -7, -8, -4},
+{5, 4, 6, -5, 3, -2, -5, 0},
+{-3, -5, 1, -7, -7, -8, -3, 6},
+{-5, -8, 1, -8, 7, 7, -4, -5}
+};
+ } 
+#endif 
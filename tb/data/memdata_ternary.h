@@ -0,0 +1,173 @@
+#ifndef PARAMS_TERNARY_HPP
+#define PARAMS_TERNARY_HPP
+namespace PARAM_TERNARY{ 
+static TernaryWeights<8,4,16> weights= {
+{
+{
+0xf5,
+0x1a,
+0xb5,
+0x66,
+0x96,
+0xc7,
+0x7a,
+0xef,
+0x22,
+0xd,
+0x20,
+0x8e,
+0xdb,
+0xef,
+0xda,
+0xfc
+},
+{
+0x2f,
+0x72,
+0x33,
+0xbe,
+0x45,
+0x6e,
+0xbc,
+0x39,
+0x82,
+0x75,
+0x13,
+0x6e,
+0x11,
+0xa9,
+0x6f,
+0x8e
+},
+{
+0x1c,
+0x2a,
+0xe1,
+0xe5,
+0xb0,
+0x39,
+0xa6,
+0x5d,
+0xb1,
+0x36,
+0x77,
+0x2,
+0x5d,
+0x90,
+0x7a,
+0x2f
+},
+{
+0x57,
+0xe7,
+0x8b,
+0x96,
+0x71,
+0xd8,
+0x75,
+0x92,
+0xb6,
+0x95,
+0xa2,
+0x7,
+0x6,
+0x0,
+0xd1,
+0x8e
+}
+},
+{
+{
+0xc0,
+0x2,
+0x94,
+0x22,
+0x14,
+0x86,
+0x58,
+0xb,
+0x22,
+0x8,
+0x20,
+0xa,
+0xd0,
+0xc8,
+0xda,
+0xac
+},
+{
+0x20,
+0x30,
+0x30,
+0x8,
+0x0,
+0x6,
+0x3c,
+0x31,
+0x82,
+0x34,
+0x2,
+0x4a,
+0x10,
+0x1,
+0x5,
+0x8
+},
+{
+0x18,
+0xa,
+0xc1,
+0xc4,
+0x0,
+0x20,
+0x0,
+0x59,
+0x80,
+0x36,
+0x50,
+0x0,
+0x48,
+0x90,
+0x42,
+0x4
+},
+{
+0x10,
+0x63,
+0x9,
+0x12,
+0x21,
+0x10,
+0x75,
+0x92,
+0x2,
+0x10,
+0xa0,
+0x5,
+0x6,
+0x0,
+0xc1,
+0x82
+}
+}
+};
+static int const raw[16][32] = {
+{1, 0, 1, 0, 1, 1, -1, -1, 0, -1, 0, 1, 1, 0, 0, 0, 1, 0, -1, 0, -1, 1, 0, -1, 0, -1, 1, 0, 0, -1, 1, 0},
+{1, 1, 1, 1, 0, -1, 0, 0, 0, 1, 0, 0, -1, -1, 1, 0, 1, 1, 0, 0, -1, -1, 0, 0, 0, 1, 1, -1, 1, 1, 0, 1},
+{0, 0, 1, -1, -1, 0, 0, 0, 0, -1, 0, -1, 0, 1, 0, 0, -1, 0, 0, 0, 0, 1, -1, -1, 1, 0, -1, 0, 0, 1, -1, -1},
+{1, 1, 1, 0, -1, 0, 1, 0, -1, -1, 1, 0, 0, -1, -1, 1, -1, 1, 0, -1, 0, 0, 0, 1, 0, -1, 1, 0, -1, 0, 0, 1},
+{0, 1, -1, 0, -1, 0, 0, 1, 1, -1, -1, 0, 0, 0, 1, -1, 0, 1, 0, -1, -1, 1, -1, 0, -1, -1, 1, -1, 0, 1, 1, 1},
+{1, 0, 1, 0, 0, 0, 1, 0, 0, -1, -1, 1, 0, 1, 1, 0, 0, 0, -1, -1, -1, -1, 0, 1, -1, 0, 0, 1, -1, -1, 0, 0},
+{0, 0, 0, 0, 1, 1, 0, 1, 1, 0, 0, 1, 1, -1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 1, -1, 0, 1, -1, -1, 0, -1, 0},
+{-1, 0, 0, 0, 1, -1, 1, 0, 0, 0, 0, 1, -1, 0, 1, 1, -1, 0, -1, 0, -1, -1, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1},
+{0, -1, 0, 0, 0, -1, 0, 0, 1, 0, 1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1, 0, 0, 0, -1, 1, -1, 0, 0, 0, 1},
+{0, -1, 0, 0, 0, 0, 0, -1, 1, 0, -1, 0, -1, -1, 1, 0, 1, -1, 0, 0, 1, 0, 0, 0, 0, -1, 1, -1, 0, 1, -1, 0},
+{1, 0, 0, 0, 1, 1, 0, -1, 0, -1, -1, 0, -1, -1, 0, 0, 1, 1, 1, 0, -1, 1, -1, 0, 0, 1, 0, 0, 0, 0, 0, 0},
+{0, -1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 0, -1, 0, 0, 1, 0, 1, 0, 0, 0, -1, 0, -1, -1, 1, -1, 0, 0, 0, 0, 0},
+{1, 1, 0, 1, -1, 0, -1, -1, 1, 1, 1, -1, 0, 1, -1, -1, 0, -1, 0, -1, -1, 0, -1, -1, 0, 0, -1, -1, 1, -1, 1, -1},
+{1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 1, 0, 1, 0, 1, -1, 1, -1, 1, 0, 1, 1, 0, 0, 1, 1, -1, 0, 0, 0, 1},
+{1, 0, 1, -1, 1, 0, -1, 0, 0, 0, 0, 0, -1, 0, 0, -1, 0, -1, 0, 1, 1, 1, -1, 0, 1, 1, -1, 1, 0, 1, 0, 0},
+{0, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1, 0, 0, 0, 1, 0, -1, -1, 0, -1, 1, 1, 0, 0, 0, -1}
+};
+ } 
+#endif 
@@ -0,0 +1,21 @@
+#ifndef PARAMS_THRESHOLDS_HPP
+#define PARAMS_THRESHOLDS_HPP
+namespace PARAM_THRESHOLDS{ 
+static ThresholdsActivationBinarySearch<4,2,6,ap_int<8>,ap_uint<3>> threshs= {
+{
+{
+{ -114, -70, -53, -25, 77, 101 },
+{ -127, -109, -43, -43, -31, -28 },
+{ -62, -48, -30, 31, 45, 56 },
+{ -86, -65, -64, -33, -9, -3 }
+},
+{
+{ -101, -87, 14, 24, 24, 47 },
+{ -19, -18, -11, 3, 54, 72 },
+{ -125, -115, -84, -79, -50, 57 },
+{ -114, -68, -25, 7, 64, 68 }
+}
+}
+};
+ } 
+#endif 
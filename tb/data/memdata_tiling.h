@@ -0,0 +1,51 @@
+#ifndef PARAMS_TILING_HPP
+#define PARAMS_TILING_HPP
+namespace PARAM_TILING{ 
+static FixedPointWeights<1,ap_int<4>,2,9> weights1= {
+{
+{ 
+0xc,
+0x9,
+0xb,
+0x6,
+0x9,
+0xe,
+0x9,
+0x4,
+0xd} 
+,{ 
+0x0,
+0xb,
+0x7,
+0x7,
+0x9,
+0x5,
+0xb,
+0x1,
+0x3} 
+}
+};
+static int const weights1_raw[2][9] = {
+{-4, -7, -5, 6, -7, -2, -7, 4, -3},
+{0, -5, 7, 7, -7, 5, -5, 1, 3}
+};
+static FixedPointWeights<2,ap_int<4>,2,4> weights2= {
+{
+{ 
+0x21,
+0x94,
+0x40,
+0x4f} 
+,{ 
+0x1a,
+0xe,
+0xc2,
+0xef} 
+}
+};
+static int const weights2_raw[2][8] = {
+{1, 2, 4, -7, 0, 4, -1, 4},
+{-6, 1, -2, 0, 2, -4, -1, -2}
+};
+ } 
+#endif 
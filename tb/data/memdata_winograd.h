@@ -0,0 +1,145 @@
+#ifndef PARAMS_WINOGRAD_HPP
+#define PARAMS_WINOGRAD_HPP
+namespace PARAM_WINOGRAD{ 
+static FixedPointWeights<2,ap_int<8>,2,64> weights= {
+{
+{ 
+0xf0f8,
+0xf400,
+0xf008,
+0xf008,
+0xfaf6,
+0xf202,
+0xf8fe,
+0xf204,
+0xf6fa,
+0x20a,
+0xf80e,
+0xfe0c,
+0xf8,
+0xc,
+0x4,
+0x8,
+0xf4ec,
+0xf604,
+0x2fe,
+0xf400,
+0xf8f0,
+0xf801,
+0xfdf6,
+0xf5f8,
+0xf6f8,
+0xfc05,
+0xff00,
+0x902,
+0xfafc,
+0xfe02,
+0xfaf8,
+0xafa,
+0x4fc,
+0xee00,
+0xfa02,
+0xfcfc,
+0x6fc,
+0xf001,
+0xfb00,
+0xfbfc,
+0x4f4,
+0xf0f9,
+0xf906,
+0xff06,
+0x6f4,
+0xf2fa,
+0xfa04,
+0xfe06,
+0x8f0,
+0xf004,
+0xcf8,
+0xf4,
+0x4f6,
+0xf600,
+0xf8,
+0xfef0,
+0x4f2,
+0xeaf4,
+0xf8,
+0xafc,
+0xf8,
+0xf0f0,
+0xf4f8,
+0x8f8} 
+,{ 
+0xf80c,
+0xcf0,
+0xf0f4,
+0xfcf4,
+0xf808,
+0xf8ee,
+0xfcec,
+0xf402,
+0xf808,
+0x4fa,
+0xfcf8,
+0xfe,
+0xf804,
+0xf0f8,
+0x8f0,
+0xf80c,
+0xf402,
+0x2f8,
+0xf4f0,
+0xfcfa,
+0xf601,
+0xf5fd,
+0x2f0,
+0xf0fb,
+0x3,
+0x503,
+0xfeee,
+0x405,
+0x202,
+0xf808,
+0xcee,
+0xf806,
+0xfa,
+0xfaf4,
+0xfcfc,
+0x8f2,
+0xfefd,
+0xf3f3,
+0xf6,
+0xfaf7,
+0xfc0b,
+0xf7fd,
+0xfcfc,
+0xfef9,
+0xfa0e,
+0xf0fc,
+0xf6,
+0xf0fe,
+0xfcf0,
+0xf0fc,
+0xf8,
+0x8f8,
+0xfcf6,
+0xf002,
+0x6fa,
+0xf6f0,
+0x406,
+0xf806,
+0xfef2,
+0x200,
+0x40c,
+0xf80c,
+0x4f4,
+0xf0f8} 
+}
+};
+static int const raw[4][4][3][3] = {
+{{{-2, -1, -2}, {-4, -4, 2}, {-4, 1, -2}}, {{-4, 1, 0}, {-4, 0, -3}, {2, 0, 0}}, {{0, -2, 3}, {1, -3, 2}, {1, 3, -4}}, {{-3, -4, 0}, {2, -1, 3}, {-4, 3, -4}}},
+{{{3, 0, 1}, {2, 3, -3}, {-4, -4, 3}}, {{-2, 0, -2}, {-3, -3, 2}, {-1, -2, 1}}, {{-4, -3, -2}, {1, 1, 3}, {-1, -1, 3}}, {{3, -3, -4}, {2, -3, 2}, {-4, -2, -2}}},
+{{{2, -4, 1}, {-1, -1, -3}, {-2, 0, -2}}, {{-4, 0, 0}, {2, -1, 0}, {3, 0, -3}}, {{2, -2, 2}, {1, 0, -3}, {-3, -3, -2}}, {{-4, -3, 0}, {-2, -4, 3}, {0, -3, 2}}},
+{{{-3, -3, -4}, {-3, 2, -2}, {-2, 2, -3}}, {{-4, 0, 2}, {-2, 0, 3}, {0, 2, 1}}, {{-3, 1, 3}, {2, -2, 2}, {-2, -4, -2}}, {{-1, -3, -2}, {-3, -4, 2}, {2, -3, -4}}}
+};
+ } 
+#endif 
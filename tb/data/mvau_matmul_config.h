@@ -0,0 +1,9 @@
+#define MatrixW_MM 16
+#define MatrixH_MM 12
+#define NumVectors_MM 5
+#define SIMD_MM 4
+#define PE_MM 3
+#define WIDTH_MM 4
+#define INPUT_PRECISION_MM 4
+#define ACTIVATION_PRECISION_MM 16
+#define NUM_REPEAT 4
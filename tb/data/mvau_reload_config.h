@@ -0,0 +1,8 @@
+#define MatrixW_R 16
+#define MatrixH_R 8
+#define SIMD_R 4
+#define PE_R 2
+#define WIDTH_R 4
+#define INPUT_PRECISION_R 4
+#define ACTIVATION_PRECISION_R 16
+#define TILES_R 16
@@ -0,0 +1,9 @@
+#define MatrixW_K 48
+#define MatrixH_K 8
+#define SIMD_K 4
+#define PE_K 2
+#define PARTS_K 3
+#define WIDTH_K 4
+#define INPUT_PRECISION_K 4
+#define ACTIVATION_PRECISION_K 16
+#define NUM_REPEAT 3
@@ -0,0 +1,9 @@
+#define MatrixW_B 24
+#define MatrixH_B 12
+#define SIMD_B 4
+#define PE_B 3
+#define BATCH_B 4
+#define WIDTH_B 4
+#define INPUT_PRECISION_B 4
+#define ACTIVATION_PRECISION_B 16
+#define NUM_REPEAT 6
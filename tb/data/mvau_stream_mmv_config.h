@@ -0,0 +1,9 @@
+#define MatrixW_M 24
+#define MatrixH_M 16
+#define SIMD_M 4
+#define PE_M 4
+#define MMV_M 2
+#define WIDTH_M 4
+#define INPUT_PRECISION_M 4
+#define ACTIVATION_PRECISION_M 16
+#define NUM_REPEAT 3
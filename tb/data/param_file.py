@@ -0,0 +1,77 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Writer of the binary parameter files loaded by tb/param_file.hpp.
+#
+#  The files hold the m_weights[PE][TILES] words of BinaryWeights and
+#  FixedPointWeights or the m_thresholds[PE][NF][NumTH] values of
+#  ThresholdsActivation, see param_file.hpp for the layout.
+#
+import struct
+
+MAGIC = b"FINNPRM\0"
+VERSION = 1
+WEIGHTS = 1
+THRESHOLDS = 2
+
+
+def _write(path, kind, bits, signed, dims, values):
+	nbytes = (bits + 7) // 8
+	mask = (1 << bits) - 1
+	with open(path, "wb") as f:
+		f.write(MAGIC)
+		f.write(struct.pack("<7I", VERSION, kind, bits, 1 if signed else 0, dims[0], dims[1], dims[2]))
+		f.write(struct.pack("<I", 0))
+		for v in values:
+			# two's complement truncated to the word width
+			f.write((int(v) & mask).to_bytes(nbytes, "little"))
+
+
+def write_weights(path, words, word_bits):
+	""" Writes the packed weight words given as words[pe][tile], each of word_bits = SIMD * weight width bits. """
+	pe = len(words)
+	tiles = len(words[0])
+	_write(path, WEIGHTS, word_bits, False, (pe, tiles, 1), (w for row in words for w in row))
+
+
+def write_thresholds(path, thresholds, width, signed):
+	""" Writes the thresholds given as thresholds[pe][nf][i] of width bits each. """
+	pe = len(thresholds)
+	nf = len(thresholds[0])
+	num_th = len(thresholds[0][0])
+	_write(path, THRESHOLDS, width, signed, (pe, nf, num_th), (t for p in thresholds for n in p for t in n))
+
+
+def pack(values, width):
+	""" Packs a list of values of width bits into one word, the first value in the least significant bits. """
+	mask = (1 << width) - 1
+	word = 0
+	for i, v in enumerate(values):
+		word |= (int(v) & mask) << (i * width)
+	return word
@@ -0,0 +1,9 @@
+#define IFMDIM_UB 4 
+#define OFMDIM_UB 12 
+#define FM_CHANNELS_UB 6 
+#define PE_UB 2 
+#define PRECISION_UB 6 
+#define IFMDIM2_UB 3 
+#define OFMDIM2_UB 6 
+#define FM_CHANNELS2_UB 2 
+#define PRECISION2_UB 8 
@@ -0,0 +1,9 @@
+#define IFMDIM_X_UM 5 
+#define IFMDIM_Y_UM 3 
+#define OFMDIM_X_UM 16 
+#define OFMDIM_Y_UM 8 
+#define FM_CHANNELS_UM 3 
+#define PRECISION_UM 4 
+#define MMV_UM 2 
+#define IFMDIM_SQ_UM 4 
+#define OFMDIM_SQ_UM 9 
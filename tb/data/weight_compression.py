@@ -0,0 +1,68 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Variable-width coding of parameter streams for DecompressParamStream in
+#  dma.h. Every word of lanes is split into groups, each coded with the
+#  narrowest width holding all of its lanes. The code of a word are the group
+#  widths followed by the lanes of all groups at their widths, all fields LSBs
+#  first, and the codes of all words are concatenated into one bit stream.
+#
+
+def lane_width(v, wp, signed):
+	"""Narrowest width of 0 to wp bits holding v."""
+	if v == 0:
+		return 0
+	if signed:
+		b = (v if v >= 0 else ~v).bit_length() + 1
+	else:
+		b = v.bit_length()
+	assert b <= wp, "value %d exceeds %d bits" % (v, wp)
+	return b
+
+def compress(words, wp, groups, in_width, signed=True):
+	"""Codes words, lists of lane values in stream order, into in_width-bit words."""
+	hb = (wp).bit_length()
+	bits = 0
+	nbits = 0
+	def put(val, width):
+		nonlocal bits, nbits
+		bits |= (val & ((1 << width) - 1)) << nbits
+		nbits += width
+	for lanes in words:
+		assert len(lanes) % groups == 0
+		gl = len(lanes) // groups
+		grps = [lanes[g*gl:(g+1)*gl] for g in range(groups)]
+		widths = [max(lane_width(v, wp, signed) for v in grp) for grp in grps]
+		for b in widths:
+			put(b, hb)
+		for b, grp in zip(widths, grps):
+			for v in grp:
+				put(v, b)
+	count = (nbits + in_width - 1) // in_width
+	return [(bits >> (i*in_width)) & ((1 << in_width) - 1) for i in range(count)]
@@ -0,0 +1,103 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file decompress_tb.cpp
+ *
+ *  Testbench for the decompression of variable-width coded parameter streams,
+ *  for signed weights in several lane groups and for unsigned ones
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_compressed.h"
+#include "data/config_compressed.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 3
+
+void Testbench_decompress(stream<ap_uint<IN_WIDTH_DC> > & in, stream<ap_uint<SIMD_DC*PE_DC*WP_DC> > & out,
+	stream<ap_uint<IN_WIDTH2_DC> > & in2, stream<ap_uint<SIMD2_DC*PE2_DC*WP2_DC> > & out2, unsigned int numReps);
+
+int main()
+{
+	stream<ap_uint<IN_WIDTH_DC> > input_stream("input_stream");
+	stream<ap_uint<SIMD_DC*PE_DC*WP_DC> > output_stream("output_stream");
+	stream<ap_uint<IN_WIDTH2_DC> > input_stream2("input_stream2");
+	stream<ap_uint<SIMD2_DC*PE2_DC*WP2_DC> > output_stream2("output_stream2");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int i = 0; i < IN_WORDS_DC; i++)
+			input_stream.write(PARAM_COMPRESSED::compressed[i]);
+		for (unsigned int i = 0; i < IN_WORDS2_DC; i++)
+			input_stream2.write(PARAM_COMPRESSED::compressed2[i]);
+	}
+
+	Testbench_decompress(input_stream, output_stream, input_stream2, output_stream2, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int tile = 0; tile < TILES_DC; tile++) {
+			ap_uint<SIMD_DC*PE_DC*WP_DC> const exp = PARAM_COMPRESSED::raw[tile];
+			ap_uint<SIMD_DC*PE_DC*WP_DC> const val = output_stream.read();
+			if (val != exp) {
+				cout << "ERROR: rep " << rep << " tile " << tile << " expected " << hex << exp << " actual " << val << dec << endl;
+				errors++;
+			}
+		}
+		for (unsigned int tile = 0; tile < TILES2_DC; tile++) {
+			ap_uint<SIMD2_DC*PE2_DC*WP2_DC> const exp = PARAM_COMPRESSED::raw2[tile];
+			ap_uint<SIMD2_DC*PE2_DC*WP2_DC> const val = output_stream2.read();
+			if (val != exp) {
+				cout << "ERROR: rep " << rep << " tile2 " << tile << " expected " << hex << exp << " actual " << val << dec << endl;
+				errors++;
+			}
+		}
+	}
+	cout << "Compression " << TILES_DC*SIMD_DC*PE_DC*WP_DC << " -> " << IN_WORDS_DC*IN_WIDTH_DC << " bits, "
+		<< TILES2_DC*SIMD2_DC*PE2_DC*WP2_DC << " -> " << IN_WORDS2_DC*IN_WIDTH2_DC << " bits" << endl;
+
+	if (!input_stream.empty() || !output_stream.empty() || !input_stream2.empty() || !output_stream2.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,14 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_compressed.h"
+
+void Testbench_decompress(stream<ap_uint<IN_WIDTH_DC> > & in, stream<ap_uint<SIMD_DC*PE_DC*WP_DC> > & out,
+	stream<ap_uint<IN_WIDTH2_DC> > & in2, stream<ap_uint<SIMD2_DC*PE2_DC*WP2_DC> > & out2, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	DecompressParamStream<TILES_DC, SIMD_DC, PE_DC, WP_DC, GROUPS_DC>(in, out, IN_WORDS_DC, numReps);
+	DecompressParamStream<TILES2_DC, SIMD2_DC, PE2_DC, WP2_DC, 1, false>(in2, out2, IN_WORDS2_DC, numReps);
+}
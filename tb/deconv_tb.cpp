@@ -0,0 +1,120 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file deconv_tb.cpp
+ *
+ *  Testbench for the transposed convolutional layer
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_DC 8191
+#include "ap_int.h"
+#include "weights.hpp"
+#include "bnn-library.h"
+#include "data/memdata_deconv.h"
+#include "data/config_deconv.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "convlayer.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_deconv(stream<ap_uint<IFM_Channels_DC*INPUT_PRECISION_DC> > & in, stream<ap_uint<OFM_Channels_DC*ACTIVATION_PRECISION_DC> > & out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<INPUT_PRECISION_DC> IMAGE[MAX_IMAGES][IFMDim_DC][IFMDim_DC][IFM_Channels_DC];
+	stream<ap_uint<IFM_Channels_DC*INPUT_PRECISION_DC> > input_stream("input_stream");
+	stream<ap_uint<OFM_Channels_DC*ACTIVATION_PRECISION_DC> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < IFMDim_DC; oy++) {
+			for (unsigned int ox = 0; ox < IFMDim_DC; ox++) {
+				ap_uint<IFM_Channels_DC*INPUT_PRECISION_DC> input_word = 0;
+				for (unsigned int channel = 0; channel < IFM_Channels_DC; channel++) {
+					ap_uint<INPUT_PRECISION_DC> input = (ap_uint<INPUT_PRECISION_DC>)rand();
+					IMAGE[n_image][oy][ox][channel] = input;
+					input_word((channel+1)*INPUT_PRECISION_DC-1, channel*INPUT_PRECISION_DC) = input;
+				}
+				input_stream.write(input_word);
+			}
+		}
+	}
+
+	Testbench_deconv(input_stream, output_stream, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < OFMDim_DC; oy++) {
+			for (unsigned int ox = 0; ox < OFMDim_DC; ox++) {
+				ap_uint<OFM_Channels_DC*ACTIVATION_PRECISION_DC> outElem = output_stream.read();
+				for (unsigned int channel = 0; channel < OFM_Channels_DC; channel++) {
+					// scatter form of the transposed convolution as reference
+					int exp = 0;
+					for (unsigned int iy = 0; iy < IFMDim_DC; iy++)
+						for (unsigned int ix = 0; ix < IFMDim_DC; ix++) {
+							int const ky = int(oy + PADDING_DC) - int(iy*STRIDE_DC);
+							int const kx = int(ox + PADDING_DC) - int(ix*STRIDE_DC);
+							if ((ky < 0) || (ky >= KERNEL_DIM_DC) || (kx < 0) || (kx >= KERNEL_DIM_DC))
+								continue;
+							for (unsigned int c = 0; c < IFM_Channels_DC; c++)
+								exp += PARAM_DECONV::raw[channel][ky][kx][c] * IMAGE[n_image][iy][ix][c];
+						}
+					ap_int<ACTIVATION_PRECISION_DC> const EXP = exp;
+					ap_int<ACTIVATION_PRECISION_DC> out_chan;
+					out_chan(ACTIVATION_PRECISION_DC-1, 0) = outElem((channel+1)*ACTIVATION_PRECISION_DC-1, channel*ACTIVATION_PRECISION_DC);
+					if (EXP != out_chan) {
+						std::cout << "ERROR: Image " << n_image << " Pixel (" << oy << "," << ox << ") Expected[" << channel << "]=" << EXP << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
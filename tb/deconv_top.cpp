@@ -0,0 +1,17 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "convlayer.h"
+#include "data/memdata_deconv.h"
+#include "data/config_deconv.h"
+
+void Testbench_deconv(stream<ap_uint<IFM_Channels_DC*INPUT_PRECISION_DC> > & in, stream<ap_uint<OFM_Channels_DC*ACTIVATION_PRECISION_DC> > & out, unsigned int numReps){
+#pragma HLS DATAFLOW
+	TransposedConvLayer_Batch<KERNEL_DIM_DC, IFM_Channels_DC, IFMDim_DC, OFM_Channels_DC, OFMDim_DC, STRIDE_DC, PADDING_DC, SIMD_DC, PE_DC, Slice<ap_uint<INPUT_PRECISION_DC> >, Slice<ap_int<ACTIVATION_PRECISION_DC> >, Identity>
+		(in, out, PARAM_DECONV::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_DC>>(), numReps, ap_resource_dsp());
+}
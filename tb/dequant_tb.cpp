@@ -0,0 +1,128 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file dequant_tb.cpp
+ *
+ *  Testbench for the dequantization of integer activations to float and Half
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_dequant.h"
+#include "data/config_dequant.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 4
+void Testbench_dequant(stream<ap_uint<PE_DQ*INPUT_PRECISION_DQ> > & in, stream<ap_uint<PE_DQ*32> > & out,
+	stream<ap_uint<PE_DQ*INPUT_PRECISION_DQ> > & in_h, stream<ap_uint<PE_DQ*Half::width> > & out_h, unsigned int numReps);
+
+float bits2float(unsigned int const bits) {
+	float f;
+	memcpy(&f, &bits, sizeof(f));
+	return f;
+}
+
+int main()
+{
+	constexpr unsigned int NF = Channels_DQ / PE_DQ;
+	static ap_int<INPUT_PRECISION_DQ> IMAGE[MAX_IMAGES][IMGDIM_DQ][Channels_DQ];
+	stream<ap_uint<PE_DQ*INPUT_PRECISION_DQ> > input_stream("input_stream");
+	stream<ap_uint<PE_DQ*32> > output_stream("output_stream");
+	stream<ap_uint<PE_DQ*INPUT_PRECISION_DQ> > input_stream_h("input_stream_h");
+	stream<ap_uint<PE_DQ*Half::width> > output_stream_h("output_stream_h");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int pix = 0; pix < IMGDIM_DQ; pix++) {
+			for (unsigned int nf = 0; nf < NF; nf++) {
+				ap_uint<PE_DQ*INPUT_PRECISION_DQ> input_word = 0;
+				for (unsigned int pe = 0; pe < PE_DQ; pe++) {
+					ap_int<INPUT_PRECISION_DQ> input = (ap_int<INPUT_PRECISION_DQ>)rand();
+					IMAGE[n_image][pix][nf*PE_DQ + pe] = input;
+					input_word((pe+1)*INPUT_PRECISION_DQ-1, pe*INPUT_PRECISION_DQ) = input;
+				}
+				input_stream.write(input_word);
+				input_stream_h.write(input_word);
+			}
+		}
+	}
+
+	Testbench_dequant(input_stream, output_stream, input_stream_h, output_stream_h, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int pix = 0; pix < IMGDIM_DQ; pix++) {
+			for (unsigned int nf = 0; nf < NF; nf++) {
+				ap_uint<PE_DQ*32> const outElem = output_stream.read();
+				ap_uint<PE_DQ*Half::width> const outElem_h = output_stream_h.read();
+				for (unsigned int pe = 0; pe < PE_DQ; pe++) {
+					unsigned int const ch = nf*PE_DQ + pe;
+					int const in = IMAGE[n_image][pix][ch];
+					// exact in float: an 8-bit difference times the scale
+					float const EXP = PARAM_DEQUANT::dequant.m_scale[pe][nf] * float(in - int(PARAM_DEQUANT::dequant.m_zero[pe][nf]));
+					float const out_chan = bits2float(outElem((pe+1)*32-1, pe*32).to_uint());
+					if (EXP != out_chan) {
+						std::cout << "ERROR: Image " << n_image << " Pixel " << pix << " Expected[" << ch << "]=" << EXP << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+					// Half within half a unit in the last place of the exact value, up to the preceding float rounding
+					double const exact_h = double(PARAM_DEQUANT::dequant_half.m_scale[pe][nf]) * (in - int(PARAM_DEQUANT::dequant_half.m_zero[pe][nf]));
+					Half out_h;
+					out_h.m_bits = outElem_h((pe+1)*Half::width-1, pe*Half::width);
+					double const ulp = fabs(exact_h) < ldexp(1.0, -14)? ldexp(1.0, -24) : ldexp(1.0, ilogb(exact_h) - 10);
+					if (fabs(float(out_h) - exact_h) > ulp * (0.5 + 1.0/8192)) {
+						std::cout << "ERROR: Half, Image " << n_image << " Pixel " << pix << " Expected[" << ch << "]=" << exact_h << " actual " << float(out_h) << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (!input_stream.empty() || !input_stream_h.empty() || !output_stream.empty() || !output_stream_h.empty()) {
+		std::cout << "ERROR: Streams not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return 0;
+}
@@ -0,0 +1,22 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_dequant.h"
+#include "data/config_dequant.h"
+
+void Testbench_dequant(stream<ap_uint<PE_DQ*INPUT_PRECISION_DQ> > & in, stream<ap_uint<PE_DQ*32> > & out,
+	stream<ap_uint<PE_DQ*INPUT_PRECISION_DQ> > & in_h, stream<ap_uint<PE_DQ*Half::width> > & out_h, unsigned int numReps){
+#pragma HLS DATAFLOW
+#pragma HLS ARRAY_PARTITION variable=PARAM_DEQUANT::dequant.m_scale complete dim=1
+#pragma HLS ARRAY_PARTITION variable=PARAM_DEQUANT::dequant.m_zero complete dim=1
+#pragma HLS ARRAY_PARTITION variable=PARAM_DEQUANT::dequant_half.m_scale complete dim=1
+#pragma HLS ARRAY_PARTITION variable=PARAM_DEQUANT::dequant_half.m_zero complete dim=1
+	Dequantize_Batch<IMGDIM_DQ, Channels_DQ, PE_DQ, Slice<ap_int<INPUT_PRECISION_DQ> > >
+		(in, out, PARAM_DEQUANT::dequant, numReps);
+	Dequantize_Batch<IMGDIM_DQ, Channels_DQ, PE_DQ, Slice<ap_int<INPUT_PRECISION_DQ> >, Half>
+		(in_h, out_h, PARAM_DEQUANT::dequant_half, numReps);
+}
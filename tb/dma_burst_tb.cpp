@@ -0,0 +1,106 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file dma_burst_tb.cpp
+ *
+ *  Testbench for the burst-optimized wide memory to stream DMA block
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <hls_stream.h>
+#define AP_INT_MAX_W 1024
+#include "ap_int.h"
+#include "data/config_dma_burst.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_dma_burst(ap_uint<MEM_WIDTH_DB> const * in, stream<ap_uint<DATA_WIDTH_DB> > & out,
+	ap_uint<MEM_WIDTH_WIDE_DB> const * in_wide, stream<ap_uint<DATA_WIDTH_WIDE_DB> > & out_wide, unsigned int numReps);
+
+// fills the memory beats with random bytes, returns the bytes in order
+template<unsigned int MemWidth>
+vector<unsigned char> fill_memory(vector<ap_uint<MemWidth> > & mem, unsigned int numBytes) {
+	vector<unsigned char> bytes(numBytes);
+	mem.assign((numBytes + MemWidth/8 - 1) / (MemWidth/8), 0);
+	for (unsigned int b = 0; b < numBytes; b++) {
+		bytes[b] = rand();
+		mem[b / (MemWidth/8)]((b % (MemWidth/8))*8 + 7, (b % (MemWidth/8))*8) = bytes[b];
+	}
+	return bytes;
+}
+
+// checks the stream words against the bytes, little endian
+template<unsigned int DataWidth>
+unsigned int check_stream(stream<ap_uint<DataWidth> > & out, vector<unsigned char> const & bytes, char const *name) {
+	unsigned int errors = 0;
+	for (unsigned int w = 0; w < bytes.size() / (DataWidth/8); w++) {
+		ap_uint<DataWidth> const word = out.read();
+		for (unsigned int b = 0; b < DataWidth/8; b++) {
+			unsigned int const value = word(b*8 + 7, b*8);
+			unsigned int const exp = bytes[w*(DataWidth/8) + b];
+			if (value != exp) {
+				cout << "ERROR " << name << ": word " << w << " byte " << b << " expected " << exp << " value " << value << endl;
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+int main()
+{
+	vector<ap_uint<MEM_WIDTH_DB> > mem;
+	vector<ap_uint<MEM_WIDTH_WIDE_DB> > mem_wide;
+	vector<unsigned char> const bytes = fill_memory<MEM_WIDTH_DB>(mem, NUM_REPS_DB*NUM_BYTES_DB);
+	vector<unsigned char> const bytes_wide = fill_memory<MEM_WIDTH_WIDE_DB>(mem_wide, NUM_REPS_DB*NUM_BYTES_WIDE_DB);
+	stream<ap_uint<DATA_WIDTH_DB> > out("out");
+	stream<ap_uint<DATA_WIDTH_WIDE_DB> > out_wide("out_wide");
+	unsigned int errors = 0;
+
+	Testbench_dma_burst(mem.data(), out, mem_wide.data(), out_wide, NUM_REPS_DB);
+
+	errors += check_stream<DATA_WIDTH_DB>(out, bytes, "narrow");
+	errors += check_stream<DATA_WIDTH_WIDE_DB>(out_wide, bytes_wide, "wide");
+	if (!out.empty() || !out_wide.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
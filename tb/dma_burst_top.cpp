@@ -0,0 +1,16 @@
+#include <hls_stream.h>
+using namespace hls;
+#define AP_INT_MAX_W 1024
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_dma_burst.h"
+
+void Testbench_dma_burst(ap_uint<MEM_WIDTH_DB> const * in, stream<ap_uint<DATA_WIDTH_DB> > & out,
+	ap_uint<MEM_WIDTH_WIDE_DB> const * in_wide, stream<ap_uint<DATA_WIDTH_WIDE_DB> > & out_wide, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi port=in offset=slave max_read_burst_length=4 num_read_outstanding=2
+#pragma HLS INTERFACE m_axi port=in_wide offset=slave max_read_burst_length=16 num_read_outstanding=2
+#pragma HLS DATAFLOW
+	Mem2Stream_Burst_Batch<DATA_WIDTH_DB, NUM_BYTES_DB, MEM_WIDTH_DB, MAX_BURST_DB>(in, out, numReps);
+	Mem2Stream_Burst_Batch<DATA_WIDTH_WIDE_DB, NUM_BYTES_WIDE_DB, MEM_WIDTH_WIDE_DB, MAX_BURST_WIDE_DB>(in_wide, out_wide, numReps);
+}
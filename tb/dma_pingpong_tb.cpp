@@ -0,0 +1,81 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file dma_pingpong_tb.cpp
+ *
+ *  Testbench for the prefetching ping-pong memory to stream DMA block
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_dma_pingpong.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_WORDS_PP (NUM_BYTES_PP / (DATA_WIDTH_PP / 8))
+void Testbench_dma_pingpong(ap_uint<DATA_WIDTH_PP> const * in, stream<ap_uint<DATA_WIDTH_PP> > & out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<DATA_WIDTH_PP> mem[NUM_REPS_PP * NUM_WORDS_PP];
+	stream<ap_uint<DATA_WIDTH_PP> > out("out");
+	unsigned int errors = 0;
+
+	for (unsigned int i = 0; i < NUM_REPS_PP * NUM_WORDS_PP; i++)
+		mem[i] = (ap_uint<DATA_WIDTH_PP>(rand()) << 32) | rand();
+
+	// odd and even image counts end in different halves of the buffer
+	for (unsigned int reps = 0; reps <= NUM_REPS_PP; reps++) {
+		Testbench_dma_pingpong(mem, out, reps);
+		for (unsigned int i = 0; i < reps * NUM_WORDS_PP; i++) {
+			ap_uint<DATA_WIDTH_PP> const value = out.read();
+			if (value != mem[i]) {
+				cout << "ERROR: reps " << reps << " word " << i << hex << " expected " << mem[i] << " value " << value << dec << endl;
+				errors++;
+			}
+		}
+		if (!out.empty()) {
+			cout << "ERROR: reps " << reps << " output stream not empty" << endl;
+			errors++;
+			while (!out.empty())  out.read();
+		}
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,11 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_dma_pingpong.h"
+
+void Testbench_dma_pingpong(ap_uint<DATA_WIDTH_PP> const * in, stream<ap_uint<DATA_WIDTH_PP> > & out, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi port=in offset=slave
+	Mem2Stream_PingPong_Batch<DATA_WIDTH_PP, NUM_BYTES_PP>(in, out, numReps);
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file dma_striped_tb.cpp
+ *
+ *  Testbench for the weight fetcher striped over multiple memories
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_dma_striped.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_dma_striped(ap_uint<SLICE_WIDTH_ST> const * hbm0, ap_uint<SLICE_WIDTH_ST> const * hbm1,
+	ap_uint<SLICE_WIDTH_ST> const * hbm2, stream<ap_uint<DATA_WIDTH_ST> > & out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<DATA_WIDTH_ST> words[NUM_WORDS_ST];
+	static ap_uint<SLICE_WIDTH_ST> hbm[DATA_WIDTH_ST/SLICE_WIDTH_ST][NUM_WORDS_ST];
+	stream<ap_uint<DATA_WIDTH_ST> > out("out");
+	unsigned int errors = 0;
+
+	// stripe every word over the memories, LSBs first
+	for (unsigned int i = 0; i < NUM_WORDS_ST; i++) {
+		for (unsigned int k = 0; k < DATA_WIDTH_ST/SLICE_WIDTH_ST; k++) {
+			hbm[k][i] = rand();
+			words[i]((k+1)*SLICE_WIDTH_ST-1, k*SLICE_WIDTH_ST) = hbm[k][i];
+		}
+	}
+
+	Testbench_dma_striped(hbm[0], hbm[1], hbm[2], out, NUM_REPS_ST);
+
+	for (unsigned int rep = 0; rep < NUM_REPS_ST; rep++) {
+		for (unsigned int i = 0; i < NUM_WORDS_ST; i++) {
+			ap_uint<DATA_WIDTH_ST> const value = out.read();
+			if (value != words[i]) {
+				cout << "ERROR: rep " << rep << " word " << i << hex << " expected " << words[i] << " value " << value << dec << endl;
+				errors++;
+			}
+		}
+	}
+	if (!out.empty()) {
+		cout << "ERROR: output stream not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,14 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_dma_striped.h"
+
+void Testbench_dma_striped(ap_uint<SLICE_WIDTH_ST> const * hbm0, ap_uint<SLICE_WIDTH_ST> const * hbm1,
+	ap_uint<SLICE_WIDTH_ST> const * hbm2, stream<ap_uint<DATA_WIDTH_ST> > & out, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi port=hbm0 offset=slave bundle=hbm0
+#pragma HLS INTERFACE m_axi port=hbm1 offset=slave bundle=hbm1
+#pragma HLS INTERFACE m_axi port=hbm2 offset=slave bundle=hbm2
+	Mem2Stream_Batch_external_wmem_striped<DATA_WIDTH_ST, NUM_WORDS_ST*DATA_WIDTH_ST/8>(out, numReps, hbm0, hbm1, hbm2);
+}
@@ -0,0 +1,135 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file double_pumped_tb.cpp
+ *
+ *  Testbench for the double-pumped matrix vector activation
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_systolic.h"
+#include "data/config_systolic.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 8
+#define SF_SY (MatrixW_SY/SIMD_SY)
+#define NF_SY (MatrixH_SY/PE_SY)
+
+void Testbench_double_pumped(stream<MultiChanData<MMV_SY, SIMD_SY*INPUT_PRECISION_SY> > & in, stream<MultiChanData<MMV_SY, PE_SY*ACTIVATION_PRECISION_SY> > & out, unsigned int numReps);
+void Testbench_double_pumped_core(stream<DoublePumpedOperands<MultiChanData<MMV_SY, SIMD_SY*INPUT_PRECISION_SY>, PE_SY*SIMD_SY*WIDTH_SY> > & ops, stream<DoublePumpedSums<ap_int<ACTIVATION_PRECISION_SY>, MMV_SY, PE_SY> > & sums, unsigned int numTiles);
+
+static ap_uint<INPUT_PRECISION_SY> IMAGE[NUM_REPEAT][MMV_SY][MatrixW_SY];
+
+// Checks the outputs of all images against the plain matrix vector product
+static unsigned check(stream<MultiChanData<MMV_SY, PE_SY*ACTIVATION_PRECISION_SY> > & output_stream, char const *name) {
+	unsigned int errors = 0;
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF_SY; nf++) {
+			MultiChanData<MMV_SY, PE_SY*ACTIVATION_PRECISION_SY> const outElem = output_stream.read();
+			for (unsigned int mmv = 0; mmv < MMV_SY; mmv++) {
+				for (unsigned int pe = 0; pe < PE_SY; pe++) {
+					int exp = 0;
+					for (unsigned int col = 0; col < MatrixW_SY; col++)
+						exp += PARAM_SYSTOLIC::raw[nf*PE_SY + pe][col] * IMAGE[rep][mmv][col];
+					ap_int<ACTIVATION_PRECISION_SY> const EXP = exp;
+					ap_int<ACTIVATION_PRECISION_SY> out_chan;
+					out_chan(ACTIVATION_PRECISION_SY-1, 0) = outElem.data[mmv]((pe+1)*ACTIVATION_PRECISION_SY-1, pe*ACTIVATION_PRECISION_SY);
+					if (EXP != out_chan) {
+						cout << "ERROR " << name << ": rep " << rep << " pixel " << mmv << " expected[" << nf*PE_SY + pe << "]=" << EXP << " actual " << out_chan << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+	if (!output_stream.empty()) {
+		cout << "ERROR " << name << ": output stream not empty" << endl;
+		errors++;
+	}
+	return errors;
+}
+
+int main()
+{
+	stream<MultiChanData<MMV_SY, SIMD_SY*INPUT_PRECISION_SY> > input_stream("input_stream"), core_input("core_input");
+	stream<MultiChanData<MMV_SY, PE_SY*ACTIVATION_PRECISION_SY> > output_stream("output_stream");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_SY; sf++) {
+			MultiChanData<MMV_SY, SIMD_SY*INPUT_PRECISION_SY> word;
+			for (unsigned int mmv = 0; mmv < MMV_SY; mmv++) {
+				for (unsigned int simd = 0; simd < SIMD_SY; simd++) {
+					ap_uint<INPUT_PRECISION_SY> const act = rand();
+					IMAGE[rep][mmv][sf*SIMD_SY + simd] = act;
+					word.data[mmv]((simd+1)*INPUT_PRECISION_SY-1, simd*INPUT_PRECISION_SY) = act;
+				}
+			}
+			input_stream.write(word);
+			core_input.write(word);
+		}
+	}
+
+	Testbench_double_pumped(input_stream, output_stream, NUM_REPEAT);
+	errors += check(output_stream, "double-pumped");
+	if (!input_stream.empty()) {
+		cout << "ERROR: input stream not empty" << endl;
+		errors++;
+	}
+
+	// The fabric clock stages around the multiply core top level
+	stream<DoublePumpedOperands<MultiChanData<MMV_SY, SIMD_SY*INPUT_PRECISION_SY>, PE_SY*SIMD_SY*WIDTH_SY> > ops("ops");
+	stream<DoublePumpedSums<ap_int<ACTIVATION_PRECISION_SY>, MMV_SY, PE_SY> > sums("sums");
+	stream<MultiChanData<MMV_SY, PE_SY*ACTIVATION_PRECISION_SY> > core_output("core_output");
+	DoublePumped_Fetch<MatrixW_SY, MatrixH_SY, SIMD_SY, PE_SY>(core_input, ops, PARAM_SYSTOLIC::weights, NUM_REPEAT);
+	Testbench_double_pumped_core(ops, sums, NUM_REPEAT * NF_SY * SF_SY);
+	DoublePumped_Accumulate<MatrixW_SY, MatrixH_SY, SIMD_SY, PE_SY, MMV_SY, Slice_mmv<ap_int<ACTIVATION_PRECISION_SY>, MMV_SY> >
+		(sums, core_output, PassThroughActivation<ap_int<ACTIVATION_PRECISION_SY>>(), NUM_REPEAT);
+	errors += check(core_output, "core");
+	if (!core_input.empty() || !ops.empty() || !sums.empty()) {
+		cout << "ERROR: core streams not empty" << endl;
+		errors++;
+	}
+
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,171 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file downsample_tb.cpp
+ *
+ *  Testbench for the bilinear and the area downsampling, each with fixed and
+ *  runtime feature map dimensions, for signed inputs with PE folding and for
+ *  unsigned ones
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "cycles.hpp"
+#include "data/downsample_config.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 2
+
+void Testbench_downsample(stream<ap_uint<PE_DS*PRECISION_DS> > & in, stream<ap_uint<PE_DS*PRECISION_DS> > & out,
+	stream<ap_uint<FM_CHANNELS2_DS*PRECISION2_DS> > & in2, stream<ap_uint<FM_CHANNELS2_DS*PRECISION2_DS> > & out2,
+	stream<ap_uint<PE3_DS*PRECISION3_DS> > & in3, stream<ap_uint<PE3_DS*PRECISION3_DS> > & out3,
+	stream<ap_uint<FM_CHANNELS4_DS*PRECISION4_DS> > & in4, stream<ap_uint<FM_CHANNELS4_DS*PRECISION4_DS> > & out4,
+	unsigned int numReps);
+
+// Random feature maps [rep][y][x][c], streamed in folds of PE channels
+template<typename In_t, unsigned PE>
+vector<int> feed(stream<ap_uint<PE*In_t::width> > & in, unsigned ifm_x, unsigned ifm_y, unsigned ch)
+{
+	vector<int> fm;
+	for (unsigned int i = 0; i < NUM_REPEAT * ifm_y * ifm_x * ch / PE; i++) {
+		ap_uint<PE*In_t::width> word;
+		for (unsigned int pe = 0; pe < PE; pe++) {
+			In_t const val = rand();
+			fm.push_back(val);
+			word((pe+1)*In_t::width-1, pe*In_t::width) = val;
+		}
+		in.write(word);
+	}
+	return fm;
+}
+
+// Golden model: bilinear interpolation with half-pixel centers and 8-bit weights, rounded to nearest
+void golden_coord(int o, int ifm, int ofm, int &i0, int &i1, int &w1)
+{
+	double const src = (o + 0.5) * ifm / ofm - 0.5;
+	i0 = (int)floor(src);
+	w1 = (int)floor((src - i0) * 256);
+	i1 = i0+1 > ifm-1? ifm-1 : i0+1;
+}
+int golden_bilinear(vector<int> const & fm, unsigned rep, unsigned ifm_x, unsigned ifm_y, unsigned ofm_x, unsigned ofm_y, unsigned ch,
+	unsigned y, unsigned x, unsigned c)
+{
+	int y0, y1, wy1, x0, x1, wx1;
+	golden_coord(y, ifm_y, ofm_y, y0, y1, wy1);
+	golden_coord(x, ifm_x, ofm_x, x0, x1, wx1);
+	auto px = [&](int yy, int xx) { return fm[((rep*ifm_y + yy)*ifm_x + xx)*ch + c]; };
+	int const v = (256 - wy1) * ((256 - wx1) * px(y0, x0) + wx1 * px(y0, x1)) + wy1 * ((256 - wx1) * px(y1, x0) + wx1 * px(y1, x1));
+	return (int)floor((v + 32768) / 65536.0);
+}
+
+// Golden model: average of the input samples i of o = floor(i*ofm/ifm) in either dimension, rounded half up
+int golden_area(vector<int> const & fm, unsigned rep, unsigned ifm_x, unsigned ifm_y, unsigned ofm_x, unsigned ofm_y, unsigned ch,
+	unsigned y, unsigned x, unsigned c)
+{
+	int sum = 0, n = 0;
+	for (unsigned int yy = 0; yy < ifm_y; yy++)
+		for (unsigned int xx = 0; xx < ifm_x; xx++)
+			if ((yy * ofm_y / ifm_y == y) && (xx * ofm_x / ifm_x == x)) {
+				sum += fm[((rep*ifm_y + yy)*ifm_x + xx)*ch + c];
+				n++;
+			}
+	return (int)floor((sum + n/2) / double(n));
+}
+
+template<typename In_t, unsigned PE, typename Golden>
+unsigned check(stream<ap_uint<PE*In_t::width> > & out, vector<int> const & fm, unsigned ifm_x, unsigned ifm_y, unsigned ofm_x, unsigned ofm_y,
+	unsigned ch, int tolerance, Golden golden, char const *name)
+{
+	unsigned int errors = 0;
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++)
+		for (unsigned int y = 0; y < ofm_y; y++)
+			for (unsigned int x = 0; x < ofm_x; x++)
+				for (unsigned int nf = 0; nf < ch/PE; nf++) {
+					ap_uint<PE*In_t::width> const word = out.read();
+					for (unsigned int pe = 0; pe < PE; pe++) {
+						In_t const val = word((pe+1)*In_t::width-1, pe*In_t::width);
+						int const exp = golden(fm, rep, ifm_x, ifm_y, ofm_x, ofm_y, ch, y, x, nf*PE + pe);
+						if (abs(int(val) - exp) > tolerance) {
+							cout << "ERROR: " << name << " rep " << rep << " Expected[" << y << "][" << x << "][" << nf*PE + pe << "]=" << exp << " actual " << val << endl;
+							errors++;
+						}
+					}
+				}
+	return errors;
+}
+
+int main()
+{
+	static_assert(Downsample_Batch_cycles<IFMDIM_X_DS, IFMDIM_Y_DS, FM_CHANNELS_DS, PE_DS>(NUM_REPEAT) ==
+		NUM_REPEAT * IFMDIM_X_DS * IFMDIM_Y_DS * FM_CHANNELS_DS / PE_DS, "");
+
+	stream<ap_uint<PE_DS*PRECISION_DS> > in("in"), out("out");
+	stream<ap_uint<FM_CHANNELS2_DS*PRECISION2_DS> > in2("in2"), out2("out2");
+	stream<ap_uint<PE3_DS*PRECISION3_DS> > in3("in3"), out3("out3");
+	stream<ap_uint<FM_CHANNELS4_DS*PRECISION4_DS> > in4("in4"), out4("out4");
+
+	vector<int> const fm1 = feed<ap_int<PRECISION_DS>, PE_DS>(in, IFMDIM_X_DS, IFMDIM_Y_DS, FM_CHANNELS_DS);
+	vector<int> const fm2 = feed<ap_uint<PRECISION2_DS>, FM_CHANNELS2_DS>(in2, IFMDIM_X2_DS, IFMDIM_Y2_DS, FM_CHANNELS2_DS);
+	vector<int> const fm3 = feed<ap_int<PRECISION3_DS>, PE3_DS>(in3, IFMDIM_X3_DS, IFMDIM_Y3_DS, FM_CHANNELS3_DS);
+	vector<int> const fm4 = feed<ap_uint<PRECISION4_DS>, FM_CHANNELS4_DS>(in4, IFMDIM_X4_DS, IFMDIM_Y4_DS, FM_CHANNELS4_DS);
+
+	Testbench_downsample(in, out, in2, out2, in3, out3, in4, out4, NUM_REPEAT);
+
+	// the fixed-point sample positions may select a weight one LSB apart
+	unsigned int errors = 0;
+	errors += check<ap_int<PRECISION_DS>, PE_DS>(out, fm1, IFMDIM_X_DS, IFMDIM_Y_DS, OFMDIM_X_DS, OFMDIM_Y_DS, FM_CHANNELS_DS,
+		1, golden_bilinear, "bilinear");
+	errors += check<ap_uint<PRECISION2_DS>, FM_CHANNELS2_DS>(out2, fm2, IFMDIM_X2_DS, IFMDIM_Y2_DS, OFMDIM_X2_DS, OFMDIM_Y2_DS, FM_CHANNELS2_DS,
+		1, golden_bilinear, "bilinear dynamic");
+	errors += check<ap_int<PRECISION3_DS>, PE3_DS>(out3, fm3, IFMDIM_X3_DS, IFMDIM_Y3_DS, OFMDIM_X3_DS, OFMDIM_Y3_DS, FM_CHANNELS3_DS,
+		0, golden_area, "area");
+	errors += check<ap_uint<PRECISION4_DS>, FM_CHANNELS4_DS>(out4, fm4, IFMDIM_X4_DS, IFMDIM_Y4_DS, OFMDIM_X4_DS, OFMDIM_Y4_DS, FM_CHANNELS4_DS,
+		0, golden_area, "area dynamic");
+
+	if (!in.empty() || !out.empty() || !in2.empty() || !out2.empty() || !in3.empty() || !out3.empty() || !in4.empty() || !out4.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,21 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/downsample_config.h"
+
+void Testbench_downsample(stream<ap_uint<PE_DS*PRECISION_DS> > & in, stream<ap_uint<PE_DS*PRECISION_DS> > & out,
+	stream<ap_uint<FM_CHANNELS2_DS*PRECISION2_DS> > & in2, stream<ap_uint<FM_CHANNELS2_DS*PRECISION2_DS> > & out2,
+	stream<ap_uint<PE3_DS*PRECISION3_DS> > & in3, stream<ap_uint<PE3_DS*PRECISION3_DS> > & out3,
+	stream<ap_uint<FM_CHANNELS4_DS*PRECISION4_DS> > & in4, stream<ap_uint<FM_CHANNELS4_DS*PRECISION4_DS> > & out4,
+	unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	DownsampleBilinear_Batch<IFMDIM_X_DS, IFMDIM_Y_DS, OFMDIM_X_DS, OFMDIM_Y_DS, FM_CHANNELS_DS, PE_DS, ap_int<PRECISION_DS> >(in, out, numReps);
+	DownsampleBilinear_Dynamic_Batch<MAX_IFMDIM_X2_DS, FM_CHANNELS2_DS, FM_CHANNELS2_DS, ap_uint<PRECISION2_DS> >
+		(in2, out2, IFMDIM_X2_DS, IFMDIM_Y2_DS, OFMDIM_X2_DS, OFMDIM_Y2_DS, numReps);
+	DownsampleArea_Batch<IFMDIM_X3_DS, IFMDIM_Y3_DS, OFMDIM_X3_DS, OFMDIM_Y3_DS, FM_CHANNELS3_DS, PE3_DS, ap_int<PRECISION3_DS> >(in3, out3, numReps);
+	DownsampleArea_Dynamic_Batch<MAX_OFMDIM_X4_DS, MAX_BOX4_DS, FM_CHANNELS4_DS, FM_CHANNELS4_DS, ap_uint<PRECISION4_DS> >
+		(in4, out4, IFMDIM_X4_DS, IFMDIM_Y4_DS, OFMDIM_X4_DS, OFMDIM_Y4_DS, numReps);
+}
@@ -0,0 +1,141 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file dsp_packed_tb.cpp
+ *
+ *  Testbench for the matrix vector activation packing two products per DSP48
+ *
+ *  Compares the packed MAC against a scalar reference for signed and unsigned
+ *  inputs with an odd SIMD as well as for operands too wide to be packed.
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_dsp_packed.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 4
+#define SF_DP (MatrixW_DP/SIMD_DP)
+#define NF_DP (MatrixH_DP/PE_DP)
+
+void Testbench_dsp_packed_unsigned(stream<ap_uint<SIMD_DP*INPUT_PRECISION_DP> > & in, stream<ap_uint<PE_DP*SIMD_DP*WEIGHT_PRECISION_DP> > & weights, stream<ap_uint<PE_DP*ACTIVATION_PRECISION_DP> > & out, unsigned int numReps);
+void Testbench_dsp_packed_signed(stream<ap_uint<SIMD_DP*INPUT_PRECISION_DP> > & in, stream<ap_uint<PE_DP*SIMD_DP*WEIGHT_PRECISION_DP> > & weights, stream<ap_uint<PE_DP*ACTIVATION_PRECISION_DP> > & out, unsigned int numReps);
+void Testbench_dsp_packed_wide(stream<ap_uint<SIMD_DP*WIDE_INPUT_PRECISION_DP> > & in, stream<ap_uint<PE_DP*SIMD_DP*WIDE_WEIGHT_PRECISION_DP> > & weights, stream<ap_uint<PE_DP*ACTIVATION_PRECISION_DP> > & out, unsigned int numReps);
+
+template<typename TW, typename TI>
+unsigned test(void (*top)(stream<ap_uint<SIMD_DP*TI::width> > &, stream<ap_uint<PE_DP*SIMD_DP*TW::width> > &, stream<ap_uint<PE_DP*ACTIVATION_PRECISION_DP> > &, unsigned int), string const &name)
+{
+	static TW W[MatrixH_DP][MatrixW_DP];
+	static TI IMAGE[NUM_REPEAT][MatrixW_DP];
+	stream<ap_uint<SIMD_DP*TI::width> > input_stream("input_stream");
+	stream<ap_uint<PE_DP*SIMD_DP*TW::width> > weight_stream("weight_stream");
+	stream<ap_uint<PE_DP*ACTIVATION_PRECISION_DP> > output_stream("output_stream");
+	unsigned int errors = 0;
+
+	// full range operands including the most negative values
+	for (unsigned int row = 0; row < MatrixH_DP; row++) {
+		for (unsigned int col = 0; col < MatrixW_DP; col++) {
+			ap_uint<TW::width> const bits = rand();
+			W[row][col](TW::width-1, 0) = bits;
+		}
+	}
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_DP; sf++) {
+			ap_uint<SIMD_DP*TI::width> word;
+			for (unsigned int simd = 0; simd < SIMD_DP; simd++) {
+				ap_uint<TI::width> const bits = rand();
+				IMAGE[rep][sf*SIMD_DP + simd](TI::width-1, 0) = bits;
+				word((simd+1)*TI::width-1, simd*TI::width) = bits;
+			}
+			input_stream.write(word);
+		}
+		// the weights are streamed once per image, row nf*PE + pe is computed by PE pe
+		for (unsigned int nf = 0; nf < NF_DP; nf++) {
+			for (unsigned int sf = 0; sf < SF_DP; sf++) {
+				ap_uint<PE_DP*SIMD_DP*TW::width> word;
+				for (unsigned int pe = 0; pe < PE_DP; pe++) {
+					for (unsigned int simd = 0; simd < SIMD_DP; simd++) {
+						unsigned int const lo = (pe*SIMD_DP + simd)*TW::width;
+						word(lo+TW::width-1, lo) = W[nf*PE_DP + pe][sf*SIMD_DP + simd](TW::width-1, 0);
+					}
+				}
+				weight_stream.write(word);
+			}
+		}
+	}
+
+	top(input_stream, weight_stream, output_stream, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF_DP; nf++) {
+			ap_uint<PE_DP*ACTIVATION_PRECISION_DP> const outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_DP; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_DP; col++)
+					exp += int(W[nf*PE_DP + pe][col]) * int(IMAGE[rep][col]);
+				ap_int<ACTIVATION_PRECISION_DP> const EXP = exp;
+				ap_int<ACTIVATION_PRECISION_DP> out_chan;
+				out_chan(ACTIVATION_PRECISION_DP-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_DP-1, pe*ACTIVATION_PRECISION_DP);
+				if (EXP != out_chan) {
+					cout << "ERROR " << name << ": rep " << rep << " expected[" << nf*PE_DP + pe << "]=" << EXP << " actual " << out_chan << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !weight_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR " << name << ": streams not empty" << endl;
+		errors++;
+	}
+	return errors;
+}
+
+int main()
+{
+	unsigned int errors = 0;
+	errors += test<ap_int<WEIGHT_PRECISION_DP>, ap_uint<INPUT_PRECISION_DP> >(Testbench_dsp_packed_unsigned, "unsigned");
+	errors += test<ap_int<WEIGHT_PRECISION_DP>, ap_int<INPUT_PRECISION_DP> >(Testbench_dsp_packed_signed, "signed");
+	errors += test<ap_int<WIDE_WEIGHT_PRECISION_DP>, ap_uint<WIDE_INPUT_PRECISION_DP> >(Testbench_dsp_packed_wide, "wide");
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,38 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/config_dsp_packed.h"
+
+typedef ap_int<ACTIVATION_PRECISION_DP>  acc_t;
+
+// the narrow operands are packed two per DSP48, the wide ones are left to the generic MAC
+static_assert(dsp_packing::config<ap_int<WEIGHT_PRECISION_DP>, ap_uint<INPUT_PRECISION_DP> >::fits, "Unsigned inputs not packed.");
+static_assert(dsp_packing::config<ap_int<WEIGHT_PRECISION_DP>, ap_int<INPUT_PRECISION_DP> >::fits, "Signed inputs not packed.");
+static_assert(!dsp_packing::config<ap_int<WIDE_WEIGHT_PRECISION_DP>, ap_uint<WIDE_INPUT_PRECISION_DP> >::fits, "Wide operands unexpectedly packed.");
+// an odd SIMD leaves an unpaired last lane
+static_assert(SIMD_DP % 2 == 1, "SIMD must be odd.");
+
+template<typename TW, typename TI>
+void dsp_packed_mvau(stream<ap_uint<SIMD_DP*TI::width> > & in, stream<ap_uint<PE_DP*SIMD_DP*TW::width> > & weights, stream<ap_uint<PE_DP*ACTIVATION_PRECISION_DP> > & out, unsigned int numReps){
+#pragma HLS inline
+	Matrix_Vector_Activate_Stream_Batch<MatrixW_DP, MatrixH_DP, SIMD_DP, PE_DP, 1, Slice<TI>, Slice<acc_t>, Identity, TW>
+		(in, out, weights, PassThroughActivation<acc_t>(), numReps, ap_resource_dsp_packed());
+}
+
+void Testbench_dsp_packed_unsigned(stream<ap_uint<SIMD_DP*INPUT_PRECISION_DP> > & in, stream<ap_uint<PE_DP*SIMD_DP*WEIGHT_PRECISION_DP> > & weights, stream<ap_uint<PE_DP*ACTIVATION_PRECISION_DP> > & out, unsigned int numReps){
+	dsp_packed_mvau<ap_int<WEIGHT_PRECISION_DP>, ap_uint<INPUT_PRECISION_DP> >(in, weights, out, numReps);
+}
+
+void Testbench_dsp_packed_signed(stream<ap_uint<SIMD_DP*INPUT_PRECISION_DP> > & in, stream<ap_uint<PE_DP*SIMD_DP*WEIGHT_PRECISION_DP> > & weights, stream<ap_uint<PE_DP*ACTIVATION_PRECISION_DP> > & out, unsigned int numReps){
+	dsp_packed_mvau<ap_int<WEIGHT_PRECISION_DP>, ap_int<INPUT_PRECISION_DP> >(in, weights, out, numReps);
+}
+
+void Testbench_dsp_packed_wide(stream<ap_uint<SIMD_DP*WIDE_INPUT_PRECISION_DP> > & in, stream<ap_uint<PE_DP*SIMD_DP*WIDE_WEIGHT_PRECISION_DP> > & weights, stream<ap_uint<PE_DP*ACTIVATION_PRECISION_DP> > & out, unsigned int numReps){
+	dsp_packed_mvau<ap_int<WIDE_WEIGHT_PRECISION_DP>, ap_uint<WIDE_INPUT_PRECISION_DP> >(in, weights, out, numReps);
+}
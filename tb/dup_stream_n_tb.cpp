@@ -0,0 +1,106 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file dup_stream_n_tb.cpp
+ *
+ *  Testbench for the N-way stream duplicator with and without output folding
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_dup_stream_n.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 3
+void Testbench_dup_stream_n(stream<ap_uint<WIDTH_DN> > & in, stream<ap_uint<WIDTH_DN> > (&out)[NUM_OUT_DN],
+	stream<ap_uint<IN_WIDTH_FOLD_DN> > & in_fold, stream<ap_uint<OUT_WIDTH_FOLD_DN> > (&out_fold)[NUM_OUT_FOLD_DN], unsigned int numReps);
+
+int main()
+{
+	unsigned int const  Parts = IN_WIDTH_FOLD_DN / OUT_WIDTH_FOLD_DN;
+	stream<ap_uint<WIDTH_DN> > input_stream("input_stream");
+	stream<ap_uint<WIDTH_DN> > output_streams[NUM_OUT_DN];
+	stream<ap_uint<IN_WIDTH_FOLD_DN> > input_stream_fold("input_stream_fold");
+	stream<ap_uint<OUT_WIDTH_FOLD_DN> > output_streams_fold[NUM_OUT_FOLD_DN];
+	static ap_uint<WIDTH_DN> expected[MAX_IMAGES*NUM_WORDS_DN];
+	static ap_uint<OUT_WIDTH_FOLD_DN> expected_fold[MAX_IMAGES*NUM_WORDS_DN*Parts];
+	unsigned int errors = 0;
+
+	for (unsigned int i = 0; i < MAX_IMAGES*NUM_WORDS_DN; i++) {
+		ap_uint<WIDTH_DN> const value = rand();
+		ap_uint<IN_WIDTH_FOLD_DN> value_fold = (ap_uint<IN_WIDTH_FOLD_DN>(rand()) << 12) ^ rand();
+		input_stream.write(value);
+		input_stream_fold.write(value_fold);
+		expected[i] = value;
+		for (unsigned int p = 0; p < Parts; p++)
+			expected_fold[i*Parts + p] = value_fold((p+1)*OUT_WIDTH_FOLD_DN-1, p*OUT_WIDTH_FOLD_DN);
+	}
+
+	Testbench_dup_stream_n(input_stream, output_streams, input_stream_fold, output_streams_fold, MAX_IMAGES);
+
+	for (unsigned int i = 0; i < MAX_IMAGES*NUM_WORDS_DN; i++) {
+		for (unsigned int o = 0; o < NUM_OUT_DN; o++) {
+			ap_uint<WIDTH_DN> const value = output_streams[o].read();
+			if (value != expected[i]) {
+				cout << "ERROR output " << o << " word " << i << hex << " expected " << expected[i] << " value " << value << dec << endl;
+				errors++;
+			}
+		}
+	}
+	for (unsigned int i = 0; i < MAX_IMAGES*NUM_WORDS_DN*Parts; i++) {
+		for (unsigned int o = 0; o < NUM_OUT_FOLD_DN; o++) {
+			ap_uint<OUT_WIDTH_FOLD_DN> const value = output_streams_fold[o].read();
+			if (value != expected_fold[i]) {
+				cout << "ERROR folded output " << o << " word " << i << hex << " expected " << expected_fold[i] << " value " << value << dec << endl;
+				errors++;
+			}
+		}
+	}
+
+	bool empty = input_stream.empty() && input_stream_fold.empty();
+	for (unsigned int o = 0; o < NUM_OUT_DN; o++)  empty &= output_streams[o].empty();
+	for (unsigned int o = 0; o < NUM_OUT_FOLD_DN; o++)  empty &= output_streams_fold[o].empty();
+	if (!empty) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
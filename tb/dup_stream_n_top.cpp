@@ -0,0 +1,13 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_dup_stream_n.h"
+
+void Testbench_dup_stream_n(stream<ap_uint<WIDTH_DN> > & in, stream<ap_uint<WIDTH_DN> > (&out)[NUM_OUT_DN],
+	stream<ap_uint<IN_WIDTH_FOLD_DN> > & in_fold, stream<ap_uint<OUT_WIDTH_FOLD_DN> > (&out_fold)[NUM_OUT_FOLD_DN], unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	DuplicateStreams_Batch<WIDTH_DN, NUM_WORDS_DN, NUM_OUT_DN>(in, out, numReps);
+	DuplicateStreams_Batch<IN_WIDTH_FOLD_DN, NUM_WORDS_DN, NUM_OUT_FOLD_DN, OUT_WIDTH_FOLD_DN>(in_fold, out_fold, numReps);
+}
@@ -0,0 +1,120 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file dwc_generalized_tb.cpp
+ *
+ *  Testbench for the data width converter with arbitrary width ratio
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_dwc_generalized.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 3
+void Testbench_dwc_generalized(stream<ap_uint<IN_WIDTH_DOWN_DG> > & in_down, stream<ap_uint<IN_WIDTH_UP_DG> > & in_up,
+	stream<ap_uint<IN_WIDTH_FLUSH_DG> > & in_flush, stream<ap_uint<OUT_WIDTH_DOWN_DG> > & out_down,
+	stream<ap_uint<OUT_WIDTH_UP_DG> > & out_up, stream<ap_uint<OUT_WIDTH_FLUSH_DG> > & out_flush, unsigned int numReps);
+
+// writes NumIn random words and records their bits LSB first
+template<unsigned int InWidth>
+void fill_input(stream<ap_uint<InWidth> > & in, std::vector<bool> & bits, unsigned int NumIn) {
+	for (unsigned int i = 0; i < NumIn; i++) {
+		ap_uint<InWidth> word;
+		for (unsigned int b = 0; b < InWidth; b++) {
+			bool const bit = rand() & 1;
+			word[b] = bit;
+			bits.push_back(bit);
+		}
+		in.write(word);
+	}
+}
+
+// checks NumOut output words against the recorded bits, zero beyond their end
+template<unsigned int OutWidth>
+unsigned int check_output(stream<ap_uint<OutWidth> > & out, std::vector<bool> const & bits, unsigned int NumOut, char const *name) {
+	unsigned int errors = 0;
+	for (unsigned int o = 0; o < NumOut; o++) {
+		ap_uint<OutWidth> const word = out.read();
+		for (unsigned int b = 0; b < OutWidth; b++) {
+			unsigned int const pos = o*OutWidth + b;
+			bool const exp = pos < bits.size()? bits[pos] : false;
+			if (bool(word[b]) != exp) {
+				std::cout << "ERROR " << name << ": word " << o << " bit " << b << " Expected " << exp << " actual " << word[b] << std::endl;
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+int main()
+{
+	constexpr unsigned int NUM_OUT_DOWN = (NUM_IN_DOWN_DG*IN_WIDTH_DOWN_DG + OUT_WIDTH_DOWN_DG - 1) / OUT_WIDTH_DOWN_DG;
+	constexpr unsigned int NUM_OUT_UP = (NUM_IN_UP_DG*IN_WIDTH_UP_DG + OUT_WIDTH_UP_DG - 1) / OUT_WIDTH_UP_DG;
+	stream<ap_uint<IN_WIDTH_DOWN_DG> > input_stream_down("input_stream_down");
+	stream<ap_uint<IN_WIDTH_UP_DG> > input_stream_up("input_stream_up");
+	stream<ap_uint<IN_WIDTH_FLUSH_DG> > input_stream_flush("input_stream_flush");
+	stream<ap_uint<OUT_WIDTH_DOWN_DG> > output_stream_down("output_stream_down");
+	stream<ap_uint<OUT_WIDTH_UP_DG> > output_stream_up("output_stream_up");
+	stream<ap_uint<OUT_WIDTH_FLUSH_DG> > output_stream_flush("output_stream_flush");
+	std::vector<bool> bits_down[MAX_IMAGES], bits_up[MAX_IMAGES], bits_flush[MAX_IMAGES];
+	unsigned int err_counter = 0;
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		fill_input<IN_WIDTH_DOWN_DG>(input_stream_down, bits_down[n_image], NUM_IN_DOWN_DG);
+		fill_input<IN_WIDTH_UP_DG>(input_stream_up, bits_up[n_image], NUM_IN_UP_DG);
+		fill_input<IN_WIDTH_FLUSH_DG>(input_stream_flush, bits_flush[n_image], NUM_IN_FLUSH_DG);
+	}
+
+	Testbench_dwc_generalized(input_stream_down, input_stream_up, input_stream_flush, output_stream_down, output_stream_up, output_stream_flush, MAX_IMAGES);
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		err_counter += check_output<OUT_WIDTH_DOWN_DG>(output_stream_down, bits_down[n_image], NUM_OUT_DOWN, "DOWN");
+		err_counter += check_output<OUT_WIDTH_UP_DG>(output_stream_up, bits_up[n_image], NUM_OUT_UP, "UP");
+		err_counter += check_output<OUT_WIDTH_FLUSH_DG>(output_stream_flush, bits_flush[n_image], NUM_OUT_FLUSH_DG, "FLUSH");
+	}
+	if (!output_stream_down.empty() || !output_stream_up.empty() || !output_stream_flush.empty()) {
+		std::cout << "ERROR: Output streams not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	return 0;
+}
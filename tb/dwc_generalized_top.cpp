@@ -0,0 +1,15 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_dwc_generalized.h"
+
+void Testbench_dwc_generalized(stream<ap_uint<IN_WIDTH_DOWN_DG> > & in_down, stream<ap_uint<IN_WIDTH_UP_DG> > & in_up,
+	stream<ap_uint<IN_WIDTH_FLUSH_DG> > & in_flush, stream<ap_uint<OUT_WIDTH_DOWN_DG> > & out_down,
+	stream<ap_uint<OUT_WIDTH_UP_DG> > & out_up, stream<ap_uint<OUT_WIDTH_FLUSH_DG> > & out_flush, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	StreamingDataWidthConverterGeneralized_Batch<IN_WIDTH_DOWN_DG, OUT_WIDTH_DOWN_DG, NUM_IN_DOWN_DG>(in_down, out_down, numReps);
+	StreamingDataWidthConverterGeneralized_Batch<IN_WIDTH_UP_DG, OUT_WIDTH_UP_DG, NUM_IN_UP_DG>(in_up, out_up, numReps);
+	StreamingDataWidthConverterGeneralized_Batch<IN_WIDTH_FLUSH_DG, OUT_WIDTH_FLUSH_DG, NUM_IN_FLUSH_DG, NUM_OUT_FLUSH_DG>(in_flush, out_flush, numReps);
+}
@@ -53,6 +53,7 @@
 
 #include "activations.hpp"
 #include "interpret.hpp"
+#include "csim_bench.hpp"
 
 using namespace hls;
 using namespace std;
@@ -96,7 +97,10 @@ int main()
 			}
 		}
 	}
-	Testbench_dwc(input_stream, output_stream, MAX_IMAGES);
+	{
+		CsimBench const  bench("DWC", MAX_IMAGES, input_stream.size());
+		Testbench_dwc(input_stream, output_stream, MAX_IMAGES);
+	}
 	for (unsigned int counter=0 ; counter <  NUM_REPEAT*MAX_IMAGES*INPUT_WIDTH/OUT_WIDTH; counter++)
 	{
 		ap_uint<OUT_WIDTH> value = output_stream.read();
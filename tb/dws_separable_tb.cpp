@@ -0,0 +1,123 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file dws_separable_tb.cpp
+ *
+ *  Testbench for the fused depthwise separable convolutional layer
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "weights.hpp"
+#include "bnn-library.h"
+#include "data/memdata_dws_separable.h"
+#include "data/config_dws_separable.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "convlayer.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_dws_separable(stream<ap_uint<IFM_Channels_DS*INPUT_PRECISION_DS> > & in, stream<ap_uint<OFM_Channels_DS*ACTIVATION_PRECISION_DS> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int DW_SF = KERNEL_DIM_DS*KERNEL_DIM_DS / DW_SIMD_DS;
+	constexpr unsigned int PW_SF = IFM_Channels_DS / DW_PE_DS;
+	static ap_uint<INPUT_PRECISION_DS> IMAGE[MAX_IMAGES][IFMDim_DS][IFMDim_DS][IFM_Channels_DS];
+	stream<ap_uint<IFM_Channels_DS*INPUT_PRECISION_DS> > input_stream("input_stream");
+	stream<ap_uint<OFM_Channels_DS*ACTIVATION_PRECISION_DS> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < IFMDim_DS; oy++) {
+			for (unsigned int ox = 0; ox < IFMDim_DS; ox++) {
+				ap_uint<IFM_Channels_DS*INPUT_PRECISION_DS> input_word = 0;
+				for (unsigned int channel = 0; channel < IFM_Channels_DS; channel++) {
+					ap_uint<INPUT_PRECISION_DS> input = (ap_uint<INPUT_PRECISION_DS>)rand();
+					IMAGE[n_image][oy][ox][channel] = input;
+					input_word((channel+1)*INPUT_PRECISION_DS-1, channel*INPUT_PRECISION_DS) = input;
+				}
+				input_stream.write(input_word);
+			}
+		}
+	}
+
+	Testbench_dws_separable(input_stream, output_stream, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < OFMDim_DS; oy++) {
+			for (unsigned int ox = 0; ox < OFMDim_DS; ox++) {
+				// depthwise reference
+				int mid[IFM_Channels_DS];
+				for (unsigned int c = 0; c < IFM_Channels_DS; c++) {
+					mid[c] = 0;
+					for (unsigned int k = 0; k < KERNEL_DIM_DS*KERNEL_DIM_DS; k++)
+						mid[c] += PARAM_DWS_SEPARABLE::dw_weights.weights((c/DW_PE_DS)*DW_SF + k/DW_SIMD_DS)[c%DW_PE_DS][k%DW_SIMD_DS] *
+							IMAGE[n_image][oy + k/KERNEL_DIM_DS][ox + k%KERNEL_DIM_DS][c];
+				}
+				// pointwise reference
+				ap_uint<OFM_Channels_DS*ACTIVATION_PRECISION_DS> outElem = output_stream.read();
+				for (unsigned int channel = 0; channel < OFM_Channels_DS; channel++) {
+					int exp = 0;
+					for (unsigned int c = 0; c < IFM_Channels_DS; c++)
+						exp += PARAM_DWS_SEPARABLE::pw_weights.weights((channel/PW_PE_DS)*PW_SF + c/DW_PE_DS)[channel%PW_PE_DS][c%DW_PE_DS] * mid[c];
+					ap_int<ACTIVATION_PRECISION_DS> const EXP = exp;
+					ap_int<ACTIVATION_PRECISION_DS> out_chan;
+					out_chan(ACTIVATION_PRECISION_DS-1, 0) = outElem((channel+1)*ACTIVATION_PRECISION_DS-1, channel*ACTIVATION_PRECISION_DS);
+					if (EXP != out_chan) {
+						std::cout << "ERROR: Image " << n_image << " Pixel (" << oy << "," << ox << ") Expected[" << channel << "]=" << EXP << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
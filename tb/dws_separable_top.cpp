@@ -0,0 +1,19 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "convlayer.h"
+#include "data/memdata_dws_separable.h"
+#include "data/config_dws_separable.h"
+
+void Testbench_dws_separable(stream<ap_uint<IFM_Channels_DS*INPUT_PRECISION_DS> > & in, stream<ap_uint<OFM_Channels_DS*ACTIVATION_PRECISION_DS> > & out, unsigned int numReps){
+#pragma HLS DATAFLOW
+	DepthwiseSeparableLayer_Batch<KERNEL_DIM_DS, IFM_Channels_DS, IFMDim_DS, OFM_Channels_DS, OFMDim_DS, 1, DW_SIMD_DS, DW_PE_DS, PW_PE_DS,
+		Slice<ap_uint<INPUT_PRECISION_DS> >, Slice<ap_int<MID_PRECISION_DS> >, Slice<ap_int<ACTIVATION_PRECISION_DS> >, Identity, Identity>
+		(in, out, PARAM_DWS_SEPARABLE::dw_weights, PassThroughActivation<ap_int<MID_PRECISION_DS>>(),
+		 PARAM_DWS_SEPARABLE::pw_weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_DS>>(), numReps, ap_resource_dsp());
+}
@@ -0,0 +1,120 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file dws_simd_tb.cpp
+ *
+ *  Testbench for the depthwise convolution computing several kernel
+ *  positions in parallel
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "weights.hpp"
+#include "bnn-library.h"
+#include "data/memdata_dws_simd.h"
+#include "data/config_dws_simd.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "vvau.hpp"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_dws_simd(stream<ap_uint<FM_Channels_V*INPUT_PRECISION_V> > & in, stream<ap_uint<FM_Channels_V*ACTIVATION_PRECISION_V> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int SF = KERNEL_DIM_V*KERNEL_DIM_V / SIMD_V;
+	static ap_uint<INPUT_PRECISION_V> IMAGE[MAX_IMAGES][IFMDim_V][IFMDim_V][FM_Channels_V];
+	stream<ap_uint<FM_Channels_V*INPUT_PRECISION_V> > input_stream("input_stream");
+	stream<ap_uint<FM_Channels_V*ACTIVATION_PRECISION_V> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < IFMDim_V; oy++) {
+			for (unsigned int ox = 0; ox < IFMDim_V; ox++) {
+				ap_uint<FM_Channels_V*INPUT_PRECISION_V> input_word = 0;
+				for (unsigned int channel = 0; channel < FM_Channels_V; channel++) {
+					ap_uint<INPUT_PRECISION_V> input = (ap_uint<INPUT_PRECISION_V>)rand();
+					IMAGE[n_image][oy][ox][channel] = input;
+					input_word((channel+1)*INPUT_PRECISION_V-1, channel*INPUT_PRECISION_V) = input;
+				}
+				input_stream.write(input_word);
+			}
+		}
+	}
+
+	Testbench_dws_simd(input_stream, output_stream, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < OFMDim_V; oy++) {
+			for (unsigned int ox = 0; ox < OFMDim_V; ox++) {
+				ap_uint<FM_Channels_V*ACTIVATION_PRECISION_V> outElem = output_stream.read();
+				for (unsigned int channel = 0; channel < FM_Channels_V; channel++) {
+					unsigned int const nf = channel / PE_V;
+					unsigned int const pe = channel % PE_V;
+					int exp = 0;
+					for (unsigned int ky = 0; ky < KERNEL_DIM_V; ky++) {
+						for (unsigned int kx = 0; kx < KERNEL_DIM_V; kx++) {
+							unsigned int const k = ky*KERNEL_DIM_V + kx;
+							exp += PARAM_DWS_SIMD::weights.weights(nf*SF + k/SIMD_V)[pe][k%SIMD_V] * IMAGE[n_image][oy+ky][ox+kx][channel];
+						}
+					}
+					ap_int<ACTIVATION_PRECISION_V> const EXP = exp;
+					ap_int<ACTIVATION_PRECISION_V> out_chan;
+					out_chan(ACTIVATION_PRECISION_V-1, 0) = outElem((channel+1)*ACTIVATION_PRECISION_V-1, channel*ACTIVATION_PRECISION_V);
+					if (EXP != out_chan) {
+						std::cout << "ERROR: Image " << n_image << " Pixel (" << oy << "," << ox << ") Expected[" << channel << "]=" << EXP << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
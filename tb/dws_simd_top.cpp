@@ -0,0 +1,26 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "vvau.hpp"
+#include "data/memdata_dws_simd.h"
+#include "data/config_dws_simd.h"
+
+void Testbench_dws_simd(stream<ap_uint<FM_Channels_V*INPUT_PRECISION_V> > & in, stream<ap_uint<FM_Channels_V*ACTIVATION_PRECISION_V> > & out, unsigned int numReps){
+#pragma HLS DATAFLOW
+	constexpr unsigned int K2 = KERNEL_DIM_V*KERNEL_DIM_V;
+	hls::stream<ap_uint<SIMD_V*PE_V*INPUT_PRECISION_V> > resized_stream("resized_stream");
+	hls::stream<ap_uint<SIMD_V*PE_V*INPUT_PRECISION_V> > swg_out("swg_out");
+	hls::stream<ap_uint<SIMD_V*PE_V*INPUT_PRECISION_V> > packed_out("packed_out");
+	hls::stream<ap_uint<PE_V*ACTIVATION_PRECISION_V> > vvau_out("vvau_out");
+	StreamingDataWidthConverter_Batch<FM_Channels_V*INPUT_PRECISION_V, SIMD_V*PE_V*INPUT_PRECISION_V, IFMDim_V*IFMDim_V>(in, resized_stream, numReps);
+	ConvolutionInputGenerator_dws<KERNEL_DIM_V, FM_Channels_V, INPUT_PRECISION_V, IFMDim_V, OFMDim_V, SIMD_V*PE_V, 1>(resized_stream, swg_out, numReps, ap_resource_dflt());
+	DepthwiseKernelPacker_Batch<K2, FM_Channels_V, INPUT_PRECISION_V, SIMD_V, PE_V>(swg_out, packed_out, numReps*OFMDim_V*OFMDim_V);
+	Vector_Vector_Activate_Batch<FM_Channels_V, K2, SIMD_V, PE_V, 1, Slice<ap_uint<INPUT_PRECISION_V> >, Slice<ap_int<ACTIVATION_PRECISION_V> >, Identity>
+		(packed_out, vvau_out, PARAM_DWS_SIMD::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_V>>(), numReps*OFMDim_V*OFMDim_V, ap_resource_dsp());
+	StreamingDataWidthConverter_Batch<PE_V*ACTIVATION_PRECISION_V, FM_Channels_V*ACTIVATION_PRECISION_V, OFMDim_V*OFMDim_V*FM_Channels_V/PE_V>(vvau_out, out, numReps);
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file early_exit_tb.cpp
+ *
+ *  Testbench for the early-exit classifier, checking that confident frames
+ *  exit with the top label of the side head, that the others are classified
+ *  by a trunk of several stages and that every frame returns a single result
+ *  with its tag
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "earlyexit.hpp"
+#include "cycles.hpp"
+#include "data/config_early_exit.h"
+using namespace hls;
+using namespace std;
+
+constexpr unsigned  NF_EE = NUM_CLASSES_EE / PE_EE;
+typedef ap_uint<PE_EE * SCORE_WIDTH_EE> Word_EE;
+typedef EarlyExitToken<TAG_BITS_EE, ap_uint<LABEL_WIDTH_EE> > Token_EE;
+
+void Testbench_early_exit(stream<Word_EE> & in, stream<Token_EE::type> & out, unsigned int numReps);
+
+int main()
+{
+	static_assert(EarlyExitGate_Batch_cycles<NF_EE>(NUM_REPS_EE) == NUM_REPS_EE * NF_EE, "");
+
+	stream<Word_EE> input_stream("input_stream");
+	stream<Token_EE::type> output_stream("output_stream");
+	unsigned expected_label[NUM_REPS_EE];
+	bool expected_early[NUM_REPS_EE];
+	unsigned num_early = 0;
+
+	srand(1);
+	for (unsigned f = 0; f < NUM_REPS_EE; f++) {
+		unsigned scores[NUM_CLASSES_EE];
+		// Distinct scores below the threshold, with one confident class in every third frame
+		for (unsigned c = 0; c < NUM_CLASSES_EE; c++)
+			scores[c] = 10 + (c * 7 + f * 3) % NUM_CLASSES_EE * 15;
+		if (f % 3 == 0)
+			scores[rand() % NUM_CLASSES_EE] = THRESHOLD_EE + 1 + rand() % (255 - THRESHOLD_EE);
+
+		unsigned top = 0, bottom = 0;
+		for (unsigned c = 1; c < NUM_CLASSES_EE; c++) {
+			if (scores[c] > scores[top]) top = c;
+			if (scores[c] < scores[bottom]) bottom = c;
+		}
+		expected_early[f] = scores[top] > THRESHOLD_EE;
+		expected_label[f] = expected_early[f]? top : bottom;
+		num_early += expected_early[f];
+
+		for (unsigned w = 0; w < NF_EE; w++) {
+			Word_EE word = 0;
+			for (unsigned pe = 0; pe < PE_EE; pe++)
+				word((pe+1) * SCORE_WIDTH_EE - 1, pe * SCORE_WIDTH_EE) = scores[w * PE_EE + pe];
+			input_stream.write(word);
+		}
+	}
+
+	Testbench_early_exit(input_stream, output_stream, NUM_REPS_EE);
+
+	// the results come in order of completion, the tags being distinct within the batch
+	static_assert(NUM_REPS_EE <= (1 << TAG_BITS_EE), "Ambiguous tags.");
+	unsigned errors = 0;
+	bool seen[NUM_REPS_EE] = {};
+	for (unsigned i = 0; i < NUM_REPS_EE; i++) {
+		Token_EE::type const t = output_stream.read();
+		unsigned const f = Token_EE::tag(t);
+		if ((f >= NUM_REPS_EE) || seen[f]) {
+			cout << "ERROR: unexpected tag " << f << endl;
+			errors++;
+			continue;
+		}
+		seen[f] = true;
+		if ((Token_EE::label(t) != expected_label[f]) || (Token_EE::early(t) != expected_early[f])) {
+			cout << "ERROR: frame " << f << " expected label " << expected_label[f] << (expected_early[f]? " (early)" : "")
+				<< ", got label " << Token_EE::label(t) << (Token_EE::early(t)? " (early)" : "") << endl;
+			errors++;
+		}
+	}
+	cout << num_early << " of " << NUM_REPS_EE << " frames exited early" << endl;
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
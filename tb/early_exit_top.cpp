@@ -0,0 +1,69 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "earlyexit.hpp"
+#include "data/config_early_exit.h"
+
+constexpr unsigned  NF_EE = NUM_CLASSES_EE / PE_EE;
+typedef ap_uint<PE_EE * SCORE_WIDTH_EE> Word_EE;
+typedef ap_uint<SCORE_WIDTH_EE> Score_EE;
+typedef ap_uint<LABEL_WIDTH_EE> Label_EE;
+typedef EarlyExitToken<TAG_BITS_EE, Label_EE> Token_EE;
+typedef EarlyExitFrame<TAG_BITS_EE> Frame_EE;
+
+// Trunk stages beyond the gate: selecting the lowest score tells their results apart from the early ones
+struct SplitScores {
+	stream<Word_EE> &in;
+	stream<Score_EE> &out;
+	void operator()(unsigned int numReps) const {
+#pragma HLS inline
+		StreamingDataWidthConverter_Batch<PE_EE * SCORE_WIDTH_EE, SCORE_WIDTH_EE, NF_EE>(in, out, numReps);
+	}
+};
+struct InvertScores {
+	stream<Score_EE> &in;
+	stream<Score_EE> &out;
+	void operator()(unsigned int numReps) const {
+#pragma HLS inline
+		for(unsigned int i = 0; i < numReps * NUM_CLASSES_EE; i++) {
+#pragma HLS pipeline II=1
+			out.write(~in.read());
+		}
+	}
+};
+struct SelectLabel {
+	stream<Score_EE> &in;
+	stream<Label_EE> &out;
+	void operator()(unsigned int numReps) const {
+#pragma HLS inline
+		LabelSelect_Batch<NUM_CLASSES_EE, 1, 1, Score_EE, Label_EE>(in, out, numReps);
+	}
+};
+
+void Testbench_early_exit(stream<Word_EE> & in, stream<Token_EE::type> & out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	stream<Word_EE> side("side");
+	stream<Word_EE> main("main");
+#pragma HLS STREAM variable=main depth=NF_EE
+	stream<ap_uint<1> > decisions("decisions");
+	stream<Token_EE::type> exits("exits");
+	stream<Word_EE> trunk("trunk");
+	stream<Score_EE> scores("scores");
+	stream<Score_EE> inverted("inverted");
+	stream<Label_EE> late("late");
+	stream<Frame_EE::type> frames0("frames0");
+	stream<Frame_EE::type> frames1("frames1");
+	stream<Frame_EE::type> frames2("frames2");
+	stream<Frame_EE::type> frames3("frames3");
+
+	DuplicateStreams_Batch<PE_EE * SCORE_WIDTH_EE, NF_EE>(in, side, main, numReps);
+	EarlyExitSelect_Batch<NUM_CLASSES_EE, PE_EE, TAG_BITS_EE, Score_EE, Label_EE>(side, exits, decisions, THRESHOLD_EE, numReps);
+	EarlyExitGate_Batch<NF_EE, TAG_BITS_EE>(main, trunk, decisions, frames0, numReps);
+	EarlyExitStage_Batch<TAG_BITS_EE>(frames0, frames1, SplitScores{trunk, scores}, numReps);
+	EarlyExitStage_Batch<TAG_BITS_EE>(frames1, frames2, InvertScores{scores, inverted}, numReps);
+	EarlyExitStage_Batch<TAG_BITS_EE>(frames2, frames3, SelectLabel{inverted, late}, numReps);
+	EarlyExitMerge_Batch<TAG_BITS_EE, Label_EE>(exits, late, frames3, out, numReps);
+}
@@ -0,0 +1,89 @@
+#include <hls_stream.h>
+#include <ap_int.h>
+
+#include <iostream>
+#include <iomanip>
+
+#include "data/eltwise_batch_config.h"
+
+using namespace hls;
+
+void Testbench_Eltwise_Batch(
+	int  mode,
+	hls::stream<ap_uint<PE * INPUT_1_WIDTH>> &in0,
+	hls::stream<ap_uint<PE * INPUT_2_WIDTH>> &in1,
+	hls::stream<ap_uint<PE * OUTPUT_WIDTH>>  &out,
+	unsigned const  reps
+);
+
+// Element c of pixel n of image r in either operand
+int in0_val(unsigned r, unsigned n, unsigned c) { return  int((r*7 + n*3 + c) % 16) - 8; }
+int in1_val(unsigned r, unsigned n, unsigned c) { return  int((r*5 + n*11 + c*3 + 1) % 16) - 8; }
+
+int main() {
+	constexpr unsigned  CF = NUM_CHANNELS / PE;
+
+	stream<ap_uint<PE * INPUT_1_WIDTH>> input_stream1("input_stream1");
+	stream<ap_uint<PE * INPUT_2_WIDTH>> input_stream2("input_stream2");
+	stream<ap_uint<PE * OUTPUT_WIDTH>>  output_stream("output_stream");
+
+	unsigned  errors = 0;
+	for(int mode = 0; mode < 3; mode++) {
+		ap_uint<PE * OUTPUT_WIDTH>  expected[NUM_REPEAT][NUM_PIXELS][CF];
+		for(unsigned r = 0; r < NUM_REPEAT; r++) {
+			// broadcast operands are only supplied once per image
+			if(mode == 2) {
+				ap_uint<PE * INPUT_2_WIDTH>  word = 0;
+				word(INPUT_2_WIDTH-1, 0) = in1_val(r, 0, 0);
+				input_stream2.write(word);
+			}
+			for(unsigned n = 0; n < NUM_PIXELS; n++) {
+				for(unsigned f = 0; f < CF; f++) {
+					ap_uint<PE * INPUT_1_WIDTH>  word1;
+					ap_uint<PE * INPUT_2_WIDTH>  word2;
+					ap_uint<PE * OUTPUT_WIDTH>   res;
+					for(unsigned p = 0; p < PE; p++) {
+						unsigned const  c = f*PE + p;
+						int const  a = in0_val(r, n, c);
+						int const  b = in1_val(r, mode == 0? n : 0, mode == 2? 0 : c);
+						int  y;
+						switch(mode) {
+						case 0: y = a + b; break;
+						case 1: y = a * b; break;
+						default: y = a - b; break;
+						}
+						word1((p+1)*INPUT_1_WIDTH-1, p*INPUT_1_WIDTH) = a;
+						word2((p+1)*INPUT_2_WIDTH-1, p*INPUT_2_WIDTH) = b;
+						res((p+1)*OUTPUT_WIDTH-1, p*OUTPUT_WIDTH) = y;
+					}
+					input_stream1.write(word1);
+					if((mode == 0) || ((mode == 1) && (n == 0)))  input_stream2.write(word2);
+					expected[r][n][f] = res;
+				}
+			}
+		}
+		Testbench_Eltwise_Batch(mode, input_stream1, input_stream2, output_stream, NUM_REPEAT);
+		for(unsigned r = 0; r < NUM_REPEAT; r++) {
+			for(unsigned n = 0; n < NUM_PIXELS; n++) {
+				for(unsigned f = 0; f < CF; f++) {
+					ap_uint<PE * OUTPUT_WIDTH> const  value = output_stream.read();
+					if(value != expected[r][n][f]) {
+						std::cout << "ERROR with mode " << mode << " image " << r << " pixel " << n << " fold " << f << std::hex << " expected " << expected[r][n][f] << " value " << value << std::dec << std::endl;
+						errors++;
+					}
+				}
+			}
+		}
+		if(!input_stream1.empty() || !input_stream2.empty() || !output_stream.empty()) {
+			std::cout << "ERROR with mode " << mode << ": streams not drained" << std::endl;
+			errors++;
+		}
+	}
+
+	if(errors) {
+		std::cout << "Test failed with " << errors << " errors" << std::endl;
+		return  1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return  0;
+}
@@ -0,0 +1,35 @@
+#include "eltwise.hpp"
+#include "interpret.hpp"
+
+#include <cassert>
+
+#include "data/eltwise_batch_config.h"
+
+
+void Testbench_Eltwise_Batch(
+	int  mode,
+	hls::stream<ap_uint<PE * INPUT_1_WIDTH>> &in0,
+	hls::stream<ap_uint<PE * INPUT_2_WIDTH>> &in1,
+	hls::stream<ap_uint<PE * OUTPUT_WIDTH>>  &out,
+	unsigned const  reps
+) {
+	switch(mode) {
+	case 0:
+		StreamingEltwise_Batch<NUM_CHANNELS, PE, NUM_PIXELS, Slice<ap_int<INPUT_1_WIDTH>>, Slice<ap_int<INPUT_2_WIDTH>>, Slice<ap_int<OUTPUT_WIDTH>>, EltwiseBroadcast::NONE>(
+			in0, in1, out, reps, [](auto a, auto b) { return  a + b; }
+		);
+		break;
+	case 1:
+		StreamingEltwise_Batch<NUM_CHANNELS, PE, NUM_PIXELS, Slice<ap_int<INPUT_1_WIDTH>>, Slice<ap_int<INPUT_2_WIDTH>>, Slice<ap_int<OUTPUT_WIDTH>>, EltwiseBroadcast::CHANNEL>(
+			in0, in1, out, reps, [](auto a, auto b) { return  a * b; }
+		);
+		break;
+	case 2:
+		StreamingEltwise_Batch<NUM_CHANNELS, PE, NUM_PIXELS, Slice<ap_int<INPUT_1_WIDTH>>, Slice<ap_int<INPUT_2_WIDTH>>, Slice<ap_int<OUTPUT_WIDTH>>, EltwiseBroadcast::SCALAR>(
+			in0, in1, out, reps, [](auto a, auto b) { return  a - b; }
+		);
+		break;
+	default:
+		assert(!"Mode out of range");
+	}
+}
@@ -0,0 +1,83 @@
+#include <hls_stream.h>
+#include <ap_int.h>
+
+#include <iostream>
+#include <iomanip>
+
+#include "data/eltwise_fused_config.h"
+
+using namespace hls;
+
+void Testbench_Eltwise_Fused(
+	hls::stream<ap_uint<PE * INPUT_A_WIDTH>> &in_a,
+	hls::stream<ap_uint<PE * INPUT_B_WIDTH>> &in_b,
+	hls::stream<ap_uint<PE * INPUT_C_WIDTH>> &in_c,
+	hls::stream<ap_uint<PE * OUTPUT_WIDTH>>  &out,
+	unsigned const  reps
+);
+
+// Element c of pixel n of image r in every operand
+int a_val(unsigned r, unsigned n, unsigned c) { return  int((r*7 + n*3 + c) % 16) - 8; }
+int b_val(unsigned r, unsigned n, unsigned c) { return  int((r*5 + n*11 + c*3 + 1) % 16); }
+int c_val(unsigned r, unsigned n, unsigned c) { return  int((r*13 + n*5 + c*7 + 3) % 64) - 32; }
+
+int main() {
+	constexpr unsigned  CF = NUM_CHANNELS / PE;
+
+	stream<ap_uint<PE * INPUT_A_WIDTH>> input_stream_a("input_stream_a");
+	stream<ap_uint<PE * INPUT_B_WIDTH>> input_stream_b("input_stream_b");
+	stream<ap_uint<PE * INPUT_C_WIDTH>> input_stream_c("input_stream_c");
+	stream<ap_uint<PE * OUTPUT_WIDTH>>  output_stream("output_stream");
+
+	unsigned  errors = 0;
+	ap_uint<PE * OUTPUT_WIDTH>  expected[NUM_REPEAT][NUM_PIXELS][CF];
+	for(unsigned r = 0; r < NUM_REPEAT; r++) {
+		for(unsigned n = 0; n < NUM_PIXELS; n++) {
+			for(unsigned f = 0; f < CF; f++) {
+				ap_uint<PE * INPUT_A_WIDTH>  word_a;
+				ap_uint<PE * INPUT_B_WIDTH>  word_b;
+				ap_uint<PE * INPUT_C_WIDTH>  word_c;
+				ap_uint<PE * OUTPUT_WIDTH>   res;
+				for(unsigned p = 0; p < PE; p++) {
+					unsigned const  c = f*PE + p;
+					int const  a = a_val(r, n, c);
+					int const  b = b_val(r, n, c);
+					int const  d = c_val(r, n, c);
+					int  y = a + 3*b + d;
+					y = y < 0? 0 : y > (1 << OUTPUT_WIDTH) - 1? (1 << OUTPUT_WIDTH) - 1 : y;
+					word_a((p+1)*INPUT_A_WIDTH-1, p*INPUT_A_WIDTH) = a;
+					word_b((p+1)*INPUT_B_WIDTH-1, p*INPUT_B_WIDTH) = b;
+					word_c((p+1)*INPUT_C_WIDTH-1, p*INPUT_C_WIDTH) = d;
+					res((p+1)*OUTPUT_WIDTH-1, p*OUTPUT_WIDTH) = y;
+				}
+				input_stream_a.write(word_a);
+				input_stream_b.write(word_b);
+				input_stream_c.write(word_c);
+				expected[r][n][f] = res;
+			}
+		}
+	}
+	Testbench_Eltwise_Fused(input_stream_a, input_stream_b, input_stream_c, output_stream, NUM_REPEAT);
+	for(unsigned r = 0; r < NUM_REPEAT; r++) {
+		for(unsigned n = 0; n < NUM_PIXELS; n++) {
+			for(unsigned f = 0; f < CF; f++) {
+				ap_uint<PE * OUTPUT_WIDTH> const  value = output_stream.read();
+				if(value != expected[r][n][f]) {
+					std::cout << "ERROR with image " << r << " pixel " << n << " fold " << f << std::hex << " expected " << expected[r][n][f] << " value " << value << std::dec << std::endl;
+					errors++;
+				}
+			}
+		}
+	}
+	if(!input_stream_a.empty() || !input_stream_b.empty() || !input_stream_c.empty() || !output_stream.empty()) {
+		std::cout << "ERROR: streams not drained" << std::endl;
+		errors++;
+	}
+
+	if(errors) {
+		std::cout << "Test failed with " << errors << " errors" << std::endl;
+		return  1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return  0;
+}
@@ -0,0 +1,23 @@
+#include "eltwise.hpp"
+#include "interpret.hpp"
+
+#include "data/eltwise_fused_config.h"
+
+
+// relu(a + 3*b + c), saturated to the output range
+void Testbench_Eltwise_Fused(
+	hls::stream<ap_uint<PE * INPUT_A_WIDTH>> &in_a,
+	hls::stream<ap_uint<PE * INPUT_B_WIDTH>> &in_b,
+	hls::stream<ap_uint<PE * INPUT_C_WIDTH>> &in_c,
+	hls::stream<ap_uint<PE * OUTPUT_WIDTH>>  &out,
+	unsigned const  reps
+) {
+	StreamingEltwise_Fused_Batch<NUM_CHANNELS, PE, NUM_PIXELS, Slice<ap_uint<OUTPUT_WIDTH>>,
+		Slice<ap_int<INPUT_A_WIDTH>>, Slice<ap_uint<INPUT_B_WIDTH>>, Slice<ap_int<INPUT_C_WIDTH>>>(
+		out, reps, [](auto a, auto b, auto c) {
+			constexpr int  HI = (1 << OUTPUT_WIDTH) - 1;
+			ap_int<INPUT_C_WIDTH + 4> const  y = a + 3*b + c;
+			return  y < 0? ap_uint<OUTPUT_WIDTH>(0) : y > HI? ap_uint<OUTPUT_WIDTH>(HI) : ap_uint<OUTPUT_WIDTH>(y);
+		}, in_a, in_b, in_c
+	);
+}
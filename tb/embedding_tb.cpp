@@ -0,0 +1,117 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file embedding_tb.cpp
+ *
+ *  Testbench for the embedding lookups from an on-chip table and from
+ *  external memory with a cache of the leading rows, which must persist
+ *  across calls, and of the zero vectors of out-of-range indices
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_embedding.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_LOOKUPS 20
+#define WORDS_EM (EMBEDDING_DIM_EM/SIMD_EM)
+
+void Testbench_embedding(stream<ap_uint<INDEX_WIDTH_EM> > & in, stream<ap_uint<SIMD_EM*PRECISION_EM> > & out,
+	stream<ap_uint<INDEX_WIDTH_EM> > & in_ext, stream<ap_uint<SIMD_EM*PRECISION_EM> > & out_ext,
+	ap_uint<SIMD_EM*PRECISION_EM> const (&table)[NUM_EMBEDDINGS_EM][EMBEDDING_DIM_EM/SIMD_EM],
+	ap_uint<SIMD_EM*PRECISION_EM> const *table_ext, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<SIMD_EM*PRECISION_EM> TABLE[NUM_EMBEDDINGS_EM][WORDS_EM];
+	static ap_uint<SIMD_EM*PRECISION_EM> TABLE_EXT[NUM_EMBEDDINGS_EM*WORDS_EM];
+	static unsigned int INDEX[NUM_LOOKUPS];
+	stream<ap_uint<INDEX_WIDTH_EM> > in("in"), in_ext("in_ext");
+	stream<ap_uint<SIMD_EM*PRECISION_EM> > out("out"), out_ext("out_ext");
+	unsigned int errors = 0;
+
+	static ap_uint<SIMD_EM*PRECISION_EM> CACHED[NUM_EMBEDDINGS_EM][WORDS_EM];
+	for (unsigned int call = 0; call < 2; call++) {
+		// the second call changes the cached rows in memory, which must not be reloaded
+		for (unsigned int row = 0; row < NUM_EMBEDDINGS_EM; row++) {
+			for (unsigned int w = 0; w < WORDS_EM; w++) {
+				ap_uint<SIMD_EM*PRECISION_EM> const val = rand();
+				TABLE[row][w] = val;
+				TABLE_EXT[row*WORDS_EM + w] = val;
+				if ((call == 0) || (row >= CACHED_ROWS_EM))
+					CACHED[row][w] = val;
+			}
+		}
+		// lookups of cached, uncached and out-of-range rows, with repetitions
+		for (unsigned int i = 0; i < NUM_LOOKUPS; i++) {
+			INDEX[i] = rand() % (1 << INDEX_WIDTH_EM);
+			in.write(INDEX[i]);
+			in_ext.write(INDEX[i]);
+		}
+
+		Testbench_embedding(in, out, in_ext, out_ext, TABLE, TABLE_EXT, NUM_LOOKUPS);
+
+		for (unsigned int i = 0; i < NUM_LOOKUPS; i++) {
+			bool const valid = INDEX[i] < NUM_EMBEDDINGS_EM;
+			for (unsigned int w = 0; w < WORDS_EM; w++) {
+				ap_uint<SIMD_EM*PRECISION_EM> const exp = valid? TABLE[INDEX[i]][w] : ap_uint<SIMD_EM*PRECISION_EM>(0);
+				ap_uint<SIMD_EM*PRECISION_EM> const exp_ext = valid? CACHED[INDEX[i]][w] : ap_uint<SIMD_EM*PRECISION_EM>(0);
+				ap_uint<SIMD_EM*PRECISION_EM> const act = out.read();
+				ap_uint<SIMD_EM*PRECISION_EM> const act_ext = out_ext.read();
+				if (act != exp) {
+					cout << "ERROR: call " << call << " on-chip lookup " << i << " row " << INDEX[i] << " word " << w << " expected " << exp << " actual " << act << endl;
+					errors++;
+				}
+				if (act_ext != exp_ext) {
+					cout << "ERROR: call " << call << " external lookup " << i << " row " << INDEX[i] << " word " << w << " expected " << exp_ext << " actual " << act_ext << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!in.empty() || !out.empty() || !in_ext.empty() || !out_ext.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,19 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "embedding.hpp"
+#include "data/config_embedding.h"
+
+void Testbench_embedding(stream<ap_uint<INDEX_WIDTH_EM> > & in, stream<ap_uint<SIMD_EM*PRECISION_EM> > & out,
+	stream<ap_uint<INDEX_WIDTH_EM> > & in_ext, stream<ap_uint<SIMD_EM*PRECISION_EM> > & out_ext,
+	ap_uint<SIMD_EM*PRECISION_EM> const (&table)[NUM_EMBEDDINGS_EM][EMBEDDING_DIM_EM/SIMD_EM],
+	ap_uint<SIMD_EM*PRECISION_EM> const *table_ext, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi port=table_ext offset=slave num_read_outstanding=8
+	EmbeddingLookup_Batch<NUM_EMBEDDINGS_EM, EMBEDDING_DIM_EM, SIMD_EM, ap_uint<PRECISION_EM> >(in, out, table, numReps);
+	static OnChipCache<CACHED_ROWS_EM*(EMBEDDING_DIM_EM/SIMD_EM), SIMD_EM*PRECISION_EM> cache;
+	EmbeddingLookup_External_Batch<NUM_EMBEDDINGS_EM, EMBEDDING_DIM_EM, SIMD_EM, ap_uint<PRECISION_EM>, CACHED_ROWS_EM>
+		(in_ext, out_ext, table_ext, numReps, cache, ap_resource_uram());
+}
@@ -0,0 +1,147 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file folding_tb.cpp
+ *
+ *  Testbench for the compile-time folding selection of folding.hpp
+ *
+ *  The convolution of folding_top.cpp is folded by ConvLayer_Batch_folding
+ *  for TARGET_CYCLES_FD cycles per frame. Beyond checking its output, the
+ *  testbench checks the selected folding against the hand-derived optimum.
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "folding_top.h"
+using namespace hls;
+using namespace std;
+
+// 162*(IFM_Channels/SIMD) cycles in the SWG and 144*(OFM_Channels/PE) in the MVAU
+static_assert((SIMD_FD == 8) && (PE_FD == 4) && (FOLDING_FD.cycles == 288), "");
+static_assert(FOLDING_FD.cycles == std::max(
+	ConvolutionInputGenerator_cycles<KERNEL_DIM_FD, IFM_Channels_FD, IFMDim_FD, OFMDim_FD, SIMD_FD, 1>(1),
+	Matrix_Vector_Activate_Batch_cycles<MatrixW_FD, MatrixH_FD, SIMD_FD, PE_FD>(OFMDim_FD * OFMDim_FD)), "");
+
+// a target below the fully parallel schedule yields the fastest folding
+constexpr Folding FASTEST = Matrix_Vector_Activate_Batch_folding<24, 16>(0, 8);
+static_assert(!FASTEST.meets && (FASTEST.simd == 24) && (FASTEST.pe == 16) && (FASTEST.cycles == 8), "");
+// NF*SF at most 12: the cheapest folding meeting the target has a cost of 24*16/12
+constexpr Folding CHEAPEST = Matrix_Vector_Activate_Batch_folding<24, 16>(100, 8);
+static_assert(CHEAPEST.meets && (CHEAPEST.cost() == 32) && (CHEAPEST.cycles == 96), "");
+// parallelism limits and MMV
+static_assert(Matrix_Vector_Activate_Batch_folding<24, 16, 4, 4>(100, 8).cycles == 192, "");
+static_assert(ConvLayer_Batch_folding<KERNEL_DIM_FD, IFM_Channels_FD, IFMDim_FD, OFM_Channels_FD, OFMDim_FD, 1, 4>(150).mmv == 2, "");
+
+int main()
+{
+	constexpr unsigned int CF = IFM_Channels_FD / SIMD_FD;
+	constexpr unsigned int SF = MatrixW_FD / SIMD_FD;
+	constexpr unsigned int NF = MatrixH_FD / PE_FD;
+	static ap_int<INPUT_PRECISION_FD> IMAGE[MAX_IMAGES_FD][IFMDim_FD][IFMDim_FD][IFM_Channels_FD];
+	static ap_int<WIDTH_FD> W[OFM_Channels_FD][KERNEL_DIM_FD][KERNEL_DIM_FD][IFM_Channels_FD];
+	stream<ap_uint<SIMD_FD*INPUT_PRECISION_FD> > input_stream("input_stream");
+	stream<ap_uint<PE_FD*SIMD_FD*WIDTH_FD> > weight_stream("weight_stream");
+	stream<ap_uint<PE_FD*ACTIVATION_PRECISION_FD> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES_FD; n_image++)
+		for (unsigned int y = 0; y < IFMDim_FD; y++)
+			for (unsigned int x = 0; x < IFMDim_FD; x++)
+				for (unsigned int cf = 0; cf < CF; cf++) {
+					ap_uint<SIMD_FD*INPUT_PRECISION_FD> word;
+					for (unsigned int simd = 0; simd < SIMD_FD; simd++) {
+						ap_int<INPUT_PRECISION_FD> const val = (ap_int<INPUT_PRECISION_FD>)rand();
+						IMAGE[n_image][y][x][cf*SIMD_FD + simd] = val;
+						word((simd+1)*INPUT_PRECISION_FD-1, simd*INPUT_PRECISION_FD) = val;
+					}
+					input_stream.write(word);
+				}
+	for (unsigned int h = 0; h < OFM_Channels_FD; h++)
+		for (unsigned int ky = 0; ky < KERNEL_DIM_FD; ky++)
+			for (unsigned int kx = 0; kx < KERNEL_DIM_FD; kx++)
+				for (unsigned int c = 0; c < IFM_Channels_FD; c++)
+					W[h][ky][kx][c] = (ap_int<WIDTH_FD>)rand();
+
+	// the weights are streamed for every output pixel, columns in the (ky, kx, channel) order of the SWG
+	for (unsigned int pix = 0; pix < MAX_IMAGES_FD * OFMDim_FD * OFMDim_FD; pix++)
+		for (unsigned int nf = 0; nf < NF; nf++)
+			for (unsigned int sf = 0; sf < SF; sf++) {
+				ap_uint<PE_FD*SIMD_FD*WIDTH_FD> word;
+				for (unsigned int pe = 0; pe < PE_FD; pe++)
+					for (unsigned int simd = 0; simd < SIMD_FD; simd++) {
+						unsigned int const col = sf*SIMD_FD + simd;
+						unsigned int const c = col % IFM_Channels_FD;
+						unsigned int const kx = (col / IFM_Channels_FD) % KERNEL_DIM_FD;
+						unsigned int const ky = col / IFM_Channels_FD / KERNEL_DIM_FD;
+						word((pe*SIMD_FD + simd + 1)*WIDTH_FD-1, (pe*SIMD_FD + simd)*WIDTH_FD) = W[nf*PE_FD + pe][ky][kx][c];
+					}
+				weight_stream.write(word);
+			}
+
+	Testbench_folding(input_stream, weight_stream, output_stream, MAX_IMAGES_FD);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES_FD; n_image++)
+		for (unsigned int oy = 0; oy < OFMDim_FD; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_FD; ox++)
+				for (unsigned int nf = 0; nf < NF; nf++) {
+					ap_uint<PE_FD*ACTIVATION_PRECISION_FD> const outElem = output_stream.read();
+					for (unsigned int pe = 0; pe < PE_FD; pe++) {
+						unsigned int const h = nf*PE_FD + pe;
+						int exp = 0;
+						for (unsigned int ky = 0; ky < KERNEL_DIM_FD; ky++)
+							for (unsigned int kx = 0; kx < KERNEL_DIM_FD; kx++)
+								for (unsigned int c = 0; c < IFM_Channels_FD; c++)
+									exp += W[h][ky][kx][c] * IMAGE[n_image][oy + ky][ox + kx][c];
+						ap_int<ACTIVATION_PRECISION_FD> const EXP = exp;
+						ap_int<ACTIVATION_PRECISION_FD> out_chan;
+						out_chan(ACTIVATION_PRECISION_FD-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_FD-1, pe*ACTIVATION_PRECISION_FD);
+						if (EXP != out_chan) {
+							std::cout << "ERROR: Image " << n_image << " oy= " << oy << " ox= " << ox << " Expected[" << h << "]=" << EXP << " actual " << out_chan << std::endl;
+							err_counter++;
+						}
+					}
+				}
+	if (!input_stream.empty() || !weight_stream.empty() || !output_stream.empty()) {
+		std::cout << "ERROR: Streams not drained" << std::endl;
+		err_counter++;
+	}
+	std::cout << "Folding SIMD=" << SIMD_FD << " PE=" << PE_FD << " for " << FOLDING_FD.cycles << " cycles per frame" << std::endl;
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
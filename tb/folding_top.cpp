@@ -0,0 +1,20 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "folding_top.h"
+
+void Testbench_folding(stream<ap_uint<SIMD_FD*INPUT_PRECISION_FD> > & in, stream<ap_uint<PE_FD*SIMD_FD*WIDTH_FD> > & weights,
+	stream<ap_uint<PE_FD*ACTIVATION_PRECISION_FD> > & out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	stream<ap_uint<SIMD_FD*INPUT_PRECISION_FD> > convInp("Testbench_folding.convInp");
+	ConvolutionInputGenerator<KERNEL_DIM_FD, IFM_Channels_FD, INPUT_PRECISION_FD, IFMDim_FD, OFMDim_FD, SIMD_FD, 1>
+		(in, convInp, numReps, ap_resource_dflt());
+	Matrix_Vector_Activate_Stream_Batch<MatrixW_FD, MatrixH_FD, SIMD_FD, PE_FD, 1, Slice<ap_int<INPUT_PRECISION_FD> >, Slice<ap_int<ACTIVATION_PRECISION_FD> >, Identity, ap_int<WIDTH_FD> >
+		(convInp, out, weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_FD>>(), numReps * OFMDim_FD * OFMDim_FD, ap_resource_dsp());
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file folding_top.h
+ *
+ *  Convolution folded by ConvLayer_Batch_folding for the folding testbench
+ *
+ *****************************************************************************/
+#ifndef FOLDING_TOP_H
+#define FOLDING_TOP_H
+
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "folding.hpp"
+#include "data/config_folding.h"
+
+constexpr Folding FOLDING_FD = ConvLayer_Batch_folding<KERNEL_DIM_FD, IFM_Channels_FD, IFMDim_FD, OFM_Channels_FD, OFMDim_FD>(TARGET_CYCLES_FD);
+static_assert(FOLDING_FD.meets, "No folding meets the target cycles.");
+constexpr unsigned SIMD_FD = FOLDING_FD.simd;
+constexpr unsigned PE_FD = FOLDING_FD.pe;
+constexpr unsigned MatrixW_FD = KERNEL_DIM_FD * KERNEL_DIM_FD * IFM_Channels_FD;
+constexpr unsigned MatrixH_FD = OFM_Channels_FD;
+
+void Testbench_folding(hls::stream<ap_uint<SIMD_FD*INPUT_PRECISION_FD> > & in, hls::stream<ap_uint<PE_FD*SIMD_FD*WIDTH_FD> > & weights,
+	hls::stream<ap_uint<PE_FD*ACTIVATION_PRECISION_FD> > & out, unsigned int numReps);
+
+#endif
@@ -0,0 +1,239 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file fp_compute_tb.cpp
+ *
+ *  Testbench for the half and bfloat16 compute path: the conversions of the
+ *  MiniFloat types, a half MVAU with half output, a bfloat16 MVAU requantized
+ *  to integers and the thresholding of a half stream
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "activations.hpp"
+#include "data/memdata_fp.h"
+#include "data/config_fp.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 4
+#define SF_FP (MatrixW_FP/SIMD_FP)
+#define NF_FP (MatrixH_FP/PE_FP)
+
+void Testbench_fp_compute(stream<ap_uint<SIMD_FP*16> > & in_half, stream<ap_uint<PE_FP*16> > & out_half,
+	stream<ap_uint<SIMD_FP*16> > & in_bf16, stream<ap_uint<PE_FP*OUTPUT_PRECISION_FP> > & out_bf16,
+	stream<ap_uint<PE_FP*16> > & in_th, stream<ap_uint<PE_FP*2> > & out_th, unsigned int numReps);
+
+// Reference decoding of a 16-bit floating-point number, NaN excluded
+double ref_decode(unsigned const bits, int const exp_bits)
+{
+	int const man_bits = 15 - exp_bits;
+	int const bias = (1 << (exp_bits-1)) - 1;
+	int const e = (bits >> man_bits) & ((1 << exp_bits) - 1);
+	int const m = bits & ((1 << man_bits) - 1);
+	double const sgn = (bits >> 15)? -1.0 : 1.0;
+	if (e == (1 << exp_bits) - 1)
+		return sgn * INFINITY;
+	if (e == 0)
+		return sgn * ldexp(m, 1 - bias - man_bits);
+	return sgn * ldexp(m + (1 << man_bits), e - bias - man_bits);
+}
+
+bool is_nan(unsigned const bits, int const exp_bits)
+{
+	int const man_bits = 15 - exp_bits;
+	return (((bits >> man_bits) & ((1 << exp_bits) - 1)) == (1u << exp_bits) - 1) && (bits & ((1 << man_bits) - 1));
+}
+
+// Reference encoding by searching the nearest representable value, ties to even
+unsigned ref_encode(double const val, int const exp_bits)
+{
+	unsigned best = 0;
+	double best_err = INFINITY;
+	for (unsigned bits = 0; bits < 0x10000; bits++) {
+		if (is_nan(bits, exp_bits) || isinf(ref_decode(bits, exp_bits)))
+			continue;
+		double const err = fabs(ref_decode(bits, exp_bits) - val);
+		if ((err < best_err) || ((err == best_err) && !(bits & 1) && (signbit(val) == bool(bits >> 15)))) {
+			best = bits;
+			best_err = err;
+		}
+	}
+	return best;
+}
+
+template<typename T>
+unsigned encode(float const val)
+{
+	return T::from_float(val).m_bits;
+}
+
+int main()
+{
+	static float IMAGE_HALF[NUM_REPEAT][MatrixW_FP];
+	static float IMAGE_BF16[NUM_REPEAT][MatrixW_FP];
+	static float IMAGE_TH[NUM_REPEAT][MatrixH_FP];
+	stream<ap_uint<SIMD_FP*16> > in_half("in_half"), in_bf16("in_bf16");
+	stream<ap_uint<PE_FP*16> > out_half("out_half"), in_th("in_th");
+	stream<ap_uint<PE_FP*OUTPUT_PRECISION_FP> > out_bf16("out_bf16");
+	stream<ap_uint<PE_FP*2> > out_th("out_th");
+	unsigned int errors = 0;
+
+	// exhaustive check of the conversions against the reference
+	for (unsigned bits = 0; bits < 0x10000; bits++) {
+		ap_uint<16> const b = bits;
+		if (!is_nan(bits, 5)) {
+			if (double(float(Half(b))) != ref_decode(bits, 5) || encode<Half>(float(Half(b))) != bits) {
+				cout << "ERROR: half conversion of " << hex << bits << dec << endl;
+				errors++;
+			}
+		}
+		if (!is_nan(bits, 8)) {
+			if (double(float(BFloat16(b))) != ref_decode(bits, 8) || encode<BFloat16>(float(BFloat16(b))) != bits) {
+				cout << "ERROR: bfloat16 conversion of " << hex << bits << dec << endl;
+				errors++;
+			}
+		}
+	}
+	// rounding, overflow and underflow of from_float
+	struct { float val; unsigned half; unsigned bf16; } const ROUNDING[] = {
+		{ 1.0f,                  0x3C00, 0x3F80 },
+		{ 65504.0f,              0x7BFF, 0x4780 },
+		{ 65520.0f,              0x7C00, 0x4780 },
+		{ ldexpf(1.0f, -24),     0x0001, 0x3380 },
+		{ ldexpf(1.0f, -25),     0x0000, 0x3300 },
+		{ ldexpf(3.0f, -26),     0x0001, 0x3340 },
+		{ -0.0f,                 0x8000, 0x8000 },
+		{ 1.0f + ldexpf(1, -11), 0x3C00, 0x3F80 },
+		{ 1.0f + ldexpf(3, -11), 0x3C02, 0x3F80 },
+		{ 1.0f + ldexpf(1, -8),  0x3C04, 0x3F80 },
+		{ 1.0f + ldexpf(3, -8),  0x3C0C, 0x3F82 },
+		{ 3.0e38f,               0x7C00, 0x7F62 },
+		{ INFINITY,              0x7C00, 0x7F80 }
+	};
+	for (auto const &r : ROUNDING) {
+		if (encode<Half>(r.val) != r.half || encode<BFloat16>(r.val) != r.bf16) {
+			cout << "ERROR: rounding of " << r.val << " to " << hex << encode<Half>(r.val) << " " << encode<BFloat16>(r.val) << dec << endl;
+			errors++;
+		}
+	}
+	if (!is_nan(encode<Half>(NAN), 5) || !is_nan(encode<BFloat16>(NAN), 8)) {
+		cout << "ERROR: NaN not preserved" << endl;
+		errors++;
+	}
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_FP; sf++) {
+			ap_uint<SIMD_FP*16> word_half, word_bf16;
+			for (unsigned int s = 0; s < SIMD_FP; s++) {
+				float const val_half = (int(rand() % 129) - 64) / 32.0f;
+				float const val_bf16 = (int(rand() % 129) - 64) / 32.0f;
+				IMAGE_HALF[rep][sf*SIMD_FP + s] = val_half;
+				IMAGE_BF16[rep][sf*SIMD_FP + s] = val_bf16;
+				word_half((s+1)*16-1, s*16) = encode<Half>(val_half);
+				word_bf16((s+1)*16-1, s*16) = encode<BFloat16>(val_bf16);
+			}
+			in_half.write(word_half);
+			in_bf16.write(word_bf16);
+		}
+		for (unsigned int nf = 0; nf < NF_FP; nf++) {
+			ap_uint<PE_FP*16> word;
+			for (unsigned int pe = 0; pe < PE_FP; pe++) {
+				float const val = (int(rand() % 129) - 64) / 16.0f;
+				IMAGE_TH[rep][nf*PE_FP + pe] = val;
+				word((pe+1)*16-1, pe*16) = encode<Half>(val);
+			}
+			in_th.write(word);
+		}
+	}
+
+	Testbench_fp_compute(in_half, out_half, in_bf16, out_bf16, in_th, out_th, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF_FP; nf++) {
+			ap_uint<PE_FP*16> const value_half = out_half.read();
+			ap_uint<PE_FP*OUTPUT_PRECISION_FP> const value_bf16 = out_bf16.read();
+			ap_uint<PE_FP*2> const value_th = out_th.read();
+			for (unsigned int pe = 0; pe < PE_FP; pe++) {
+				unsigned int const row = nf*PE_FP + pe;
+				// all products and partial sums are exact in float
+				double acc_half = 0, acc_bf16 = 0;
+				for (unsigned int col = 0; col < MatrixW_FP; col++) {
+					acc_half += ref_decode(PARAM_FP::weights_half_raw[row][col], 5) * IMAGE_HALF[rep][col];
+					acc_bf16 += ref_decode(PARAM_FP::weights_bf16_raw[row][col], 8) * IMAGE_BF16[rep][col];
+				}
+				unsigned const exp_half = ref_encode(acc_half, 5);
+				unsigned const act_half = value_half((pe+1)*16-1, pe*16);
+				if (act_half != exp_half) {
+					cout << "ERROR: half rep " << rep << " row " << row << " expected " << hex << exp_half << " actual " << act_half << dec << endl;
+					errors++;
+				}
+
+				double const scaled = acc_bf16 * PARAM_FP::requant.m_scale[pe][nf] + PARAM_FP::requant.m_bias[pe][nf];
+				double const rounded = scaled < 0? ceil(scaled - 0.5) : floor(scaled + 0.5);
+				int const lo = -(1 << (OUTPUT_PRECISION_FP-1));
+				int const hi = (1 << (OUTPUT_PRECISION_FP-1)) - 1;
+				ap_int<OUTPUT_PRECISION_FP> const exp_bf16 = rounded < lo? lo : rounded > hi? hi : int(rounded);
+				ap_int<OUTPUT_PRECISION_FP> const act_bf16 = value_bf16((pe+1)*OUTPUT_PRECISION_FP-1, pe*OUTPUT_PRECISION_FP);
+				if (act_bf16 != exp_bf16) {
+					cout << "ERROR: bfloat16 rep " << rep << " row " << row << " expected " << exp_bf16 << " actual " << act_bf16 << endl;
+					errors++;
+				}
+
+				unsigned exp_th = 0;
+				for (unsigned int i = 0; i < NUM_TH_FP; i++)
+					exp_th += PARAM_FP::thresholds.m_thresholds[pe][nf][i] < IMAGE_TH[rep][row];
+				unsigned const act_th = value_th((pe+1)*2-1, pe*2);
+				if (act_th != exp_th) {
+					cout << "ERROR: thresholds rep " << rep << " channel " << row << " expected " << exp_th << " actual " << act_th << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!in_half.empty() || !out_half.empty() || !in_bf16.empty() || !out_bf16.empty() || !in_th.empty() || !out_th.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,25 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_fp.h"
+#include "data/config_fp.h"
+
+void Testbench_fp_compute(stream<ap_uint<SIMD_FP*16> > & in_half, stream<ap_uint<PE_FP*16> > & out_half,
+	stream<ap_uint<SIMD_FP*16> > & in_bf16, stream<ap_uint<PE_FP*OUTPUT_PRECISION_FP> > & out_bf16,
+	stream<ap_uint<PE_FP*16> > & in_th, stream<ap_uint<PE_FP*2> > & out_th, unsigned int numReps)
+{
+#pragma HLS ARRAY_PARTITION variable=PARAM_FP::weights_half.m_weights complete dim=1
+#pragma HLS ARRAY_PARTITION variable=PARAM_FP::weights_bf16.m_weights complete dim=1
+	Matrix_Vector_Activate_Batch<MatrixW_FP, MatrixH_FP, SIMD_FP, PE_FP, 1, Slice<Half>, Slice<Half>, Identity>
+		(in_half, out_half, PARAM_FP::weights_half, MiniFloatActivation<Half>(), numReps, ap_resource_fp_dsp());
+	Matrix_Vector_Activate_Batch<MatrixW_FP, MatrixH_FP, SIMD_FP, PE_FP, 1, Slice<BFloat16>, Slice<ap_int<OUTPUT_PRECISION_FP> >, Identity>
+		(in_bf16, out_bf16, PARAM_FP::weights_bf16, PARAM_FP::requant, numReps, ap_resource_dflt());
+	Thresholding_Batch<1, MatrixH_FP, PE_FP, Slice<Half>, Slice<ap_uint<2> > >
+		(in_th, out_th, PARAM_FP::thresholds, numReps);
+}
@@ -0,0 +1,95 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file frame_latency_tb.cpp
+ *
+ *  Testbench for the per-frame latency measurement through a pair of
+ *  StreamingDataWidthConverter_Batch with an intermediate tap
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_frame_latency.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_frame_latency(stream<ap_uint<IN_WIDTH_FL> > & in, stream<ap_uint<IN_WIDTH_FL> > & out,
+	ap_uint<32> latency_mid[DEPTH_FL], unsigned int & frames_mid, ap_uint<32> latency_out[DEPTH_FL], unsigned int & frames_out, unsigned int numReps);
+
+int main()
+{
+	stream<ap_uint<IN_WIDTH_FL> > input_stream("input_stream");
+	stream<ap_uint<IN_WIDTH_FL> > output_stream("output_stream");
+	static ap_uint<IN_WIDTH_FL> input[NUM_REPS_FL*NUM_WORDS_FL];
+	ap_uint<32> latency_mid[DEPTH_FL], latency_out[DEPTH_FL];
+	unsigned int frames_mid = 0, frames_out = 0;
+	unsigned int errors = 0;
+
+	for (unsigned int w = 0; w < NUM_REPS_FL*NUM_WORDS_FL; w++) {
+		input[w] = rand();
+		input_stream.write(input[w]);
+	}
+
+	Testbench_frame_latency(input_stream, output_stream, latency_mid, frames_mid, latency_out, frames_out, NUM_REPS_FL);
+
+	for (unsigned int w = 0; w < NUM_REPS_FL*NUM_WORDS_FL; w++) {
+		ap_uint<IN_WIDTH_FL> const value = output_stream.read();
+		if (value != input[w]) {
+			cout << "ERROR with word " << w << hex << " expected " << input[w] << " value " << value << dec << endl;
+			errors++;
+		}
+	}
+
+	// the ring buffers hold the last DEPTH_FL frames
+	for (unsigned int f = NUM_REPS_FL - DEPTH_FL; f < NUM_REPS_FL; f++) {
+		cout << "frame " << f << ": latency " << latency_mid[f % DEPTH_FL] << " cycles at the tap, " << latency_out[f % DEPTH_FL] << " cycles at the exit" << endl;
+	}
+	if (frames_mid != NUM_REPS_FL || frames_out != NUM_REPS_FL) {
+		cout << "ERROR: recorded " << frames_mid << " and " << frames_out << " frames instead of " << NUM_REPS_FL << endl;
+		errors++;
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,31 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_frame_latency.h"
+
+#define MID_WORDS_FL (NUM_WORDS_FL * (IN_WIDTH_FL / MID_WIDTH_FL))
+
+void Testbench_frame_latency(stream<ap_uint<IN_WIDTH_FL> > & in, stream<ap_uint<IN_WIDTH_FL> > & out,
+	ap_uint<32> latency_mid[DEPTH_FL], unsigned int & frames_mid, ap_uint<32> latency_out[DEPTH_FL], unsigned int & frames_out, unsigned int numReps)
+{
+#pragma HLS INTERFACE axis port=in
+#pragma HLS INTERFACE axis port=out
+#pragma HLS INTERFACE s_axilite port=latency_mid bundle=control
+#pragma HLS INTERFACE s_axilite port=frames_mid bundle=control
+#pragma HLS INTERFACE s_axilite port=latency_out bundle=control
+#pragma HLS INTERFACE s_axilite port=frames_out bundle=control
+#pragma HLS INTERFACE s_axilite port=numReps bundle=control
+#pragma HLS INTERFACE s_axilite port=return bundle=control
+#pragma HLS DATAFLOW
+	stream<ap_uint<IN_WIDTH_FL> > stamped("stamped"), wide("wide");
+	stream<ap_uint<MID_WIDTH_FL> > narrow("narrow"), narrow_tap("narrow_tap");
+	stream<frame_stamp_t> stamps("stamps"), stamps_mid("stamps_mid");
+#pragma HLS stream variable=stamps depth=8
+#pragma HLS stream variable=stamps_mid depth=8
+	FrameTimestamp_Batch<true, NUM_WORDS_FL>(in, stamped, stamps, numReps);
+	StreamingDataWidthConverter_Batch<IN_WIDTH_FL, MID_WIDTH_FL, NUM_WORDS_FL>(stamped, narrow, numReps);
+	FrameLatencyTap_Batch<true, MID_WORDS_FL, DEPTH_FL>(narrow, narrow_tap, stamps, stamps_mid, latency_mid, frames_mid, numReps);
+	StreamingDataWidthConverter_Batch<MID_WIDTH_FL, IN_WIDTH_FL, MID_WORDS_FL>(narrow_tap, wide, numReps);
+	FrameLatency_Batch<true, NUM_WORDS_FL, DEPTH_FL>(wide, out, stamps_mid, latency_out, frames_out, numReps);
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file fused_mvau_tb.cpp
+ *
+ *  Testbench for the precision-scalable MVAU with streaming weights at all
+ *  operand widths of its fused multipliers
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_fused_mvau.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPS_FU 2
+
+unsigned const WordBits_FU = SIMD_FU*MAX_BITS_FU*MAX_BITS_FU/BRICK_BITS_FU;
+
+void Testbench_fused_mvau(int mode, unsigned int bits, stream<ap_uint<WordBits_FU> > & in, stream<ap_uint<PE_FU*WordBits_FU> > & weights,
+	stream<ap_uint<PE_FU*ACTIVATION_PRECISION_FU> > & out, unsigned int numReps);
+
+// random operand of the given width, drawn from its full signed or unsigned range
+int random_operand(unsigned int bits, bool is_signed) {
+	int const val = rand() & ((1 << bits) - 1);
+	return is_signed && (val >> (bits-1))? val - (1 << bits) : val;
+}
+
+int main()
+{
+	static int W[MatrixH_FU][MatrixW_FU];
+	static int IN[NUM_REPS_FU][MatrixW_FU];
+	stream<ap_uint<WordBits_FU> > input_stream("input_stream");
+	stream<ap_uint<PE_FU*WordBits_FU> > weight_stream("weight_stream");
+	stream<ap_uint<PE_FU*ACTIVATION_PRECISION_FU> > output_stream("output_stream");
+	int err_counter = 0;
+
+	for (int mode = 0; mode < 2; mode++) {
+		for (unsigned int bits = BRICK_BITS_FU; bits <= MAX_BITS_FU; bits *= 2) {
+			unsigned int const simd = SIMD_FU * (MAX_BITS_FU/bits) * (MAX_BITS_FU/bits);
+			unsigned int const sf = MatrixW_FU / simd;
+			unsigned int const nf = MatrixH_FU / PE_FU;
+			for (unsigned int r = 0; r < MatrixH_FU; r++)
+				for (unsigned int c = 0; c < MatrixW_FU; c++)
+					W[r][c] = random_operand(bits, true);
+			for (unsigned int n = 0; n < NUM_REPS_FU; n++) {
+				for (unsigned int c = 0; c < MatrixW_FU; c++)
+					IN[n][c] = random_operand(bits, mode == 1);
+				// input words of simd activations, unused msbs of the wider operands left zero
+				for (unsigned int f = 0; f < sf; f++) {
+					ap_uint<WordBits_FU> word = 0;
+					for (unsigned int i = 0; i < simd; i++)
+						word((i+1)*bits-1, i*bits) = IN[n][f*simd + i];
+					input_stream.write(word);
+				}
+				for (unsigned int o = 0; o < nf; o++) {
+					for (unsigned int f = 0; f < sf; f++) {
+						ap_uint<PE_FU*WordBits_FU> word = 0;
+						for (unsigned int pe = 0; pe < PE_FU; pe++)
+							for (unsigned int i = 0; i < simd; i++)
+								word(pe*WordBits_FU + (i+1)*bits-1, pe*WordBits_FU + i*bits) = W[o*PE_FU + pe][f*simd + i];
+						weight_stream.write(word);
+					}
+				}
+			}
+
+			Testbench_fused_mvau(mode, bits, input_stream, weight_stream, output_stream, NUM_REPS_FU);
+
+			for (unsigned int n = 0; n < NUM_REPS_FU; n++) {
+				for (unsigned int o = 0; o < nf; o++) {
+					ap_uint<PE_FU*ACTIVATION_PRECISION_FU> const outElem = output_stream.read();
+					for (unsigned int pe = 0; pe < PE_FU; pe++) {
+						int expected = 0;
+						for (unsigned int c = 0; c < MatrixW_FU; c++)
+							expected += W[o*PE_FU + pe][c] * IN[n][c];
+						ap_int<ACTIVATION_PRECISION_FU> const actual = outElem((pe+1)*ACTIVATION_PRECISION_FU-1, pe*ACTIVATION_PRECISION_FU);
+						if (actual != expected) {
+							std::cout << "ERROR: mode " << mode << " bits " << bits << " image " << n << " row " << o*PE_FU + pe
+								<< " expected " << expected << " actual " << actual << std::endl;
+							err_counter++;
+						}
+					}
+				}
+			}
+			if (!input_stream.empty() || !weight_stream.empty() || !output_stream.empty()) {
+				std::cout << "ERROR: mode " << mode << " bits " << bits << " streams not empty" << std::endl;
+				err_counter++;
+			}
+		}
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return 0;
+}
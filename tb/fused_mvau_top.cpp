@@ -0,0 +1,27 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/config_fused_mvau.h"
+
+unsigned const WordBits_FU = SIMD_FU*MAX_BITS_FU*MAX_BITS_FU/BRICK_BITS_FU;
+typedef ap_int<ACTIVATION_PRECISION_FU> TO_FU;
+
+// mode 0: unsigned input activations, 1: signed input activations
+void Testbench_fused_mvau(int mode, unsigned int bits, stream<ap_uint<WordBits_FU> > & in, stream<ap_uint<PE_FU*WordBits_FU> > & weights,
+	stream<ap_uint<PE_FU*ACTIVATION_PRECISION_FU> > & out, unsigned int numReps)
+{
+#pragma HLS INTERFACE s_axilite port=mode
+#pragma HLS INTERFACE s_axilite port=bits
+#pragma HLS INTERFACE s_axilite port=numReps
+	if (mode == 0)
+		Matrix_Vector_Activate_Fused_Stream_Batch<MatrixW_FU, MatrixH_FU, SIMD_FU, PE_FU, MAX_BITS_FU, BRICK_BITS_FU, true, false, Slice<TO_FU> >
+			(in, out, weights, PassThroughActivation<TO_FU>(), numReps, bits);
+	else
+		Matrix_Vector_Activate_Fused_Stream_Batch<MatrixW_FU, MatrixH_FU, SIMD_FU, PE_FU, MAX_BITS_FU, BRICK_BITS_FU, true, true, Slice<TO_FU> >
+			(in, out, weights, PassThroughActivation<TO_FU>(), numReps, bits);
+}
@@ -0,0 +1,110 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file global_avgpool_tb.cpp
+ *
+ *  Testbench for the global accumulate and average pooling layers
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_global_avgpool.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 4
+void Testbench_global_avgpool(stream<ap_uint<PE_GP*INPUT_PRECISION_GP> > & in_acc, stream<ap_uint<PE_GP*INPUT_PRECISION_GP> > & in_avg,
+	stream<ap_uint<PE_GP*ACC_PRECISION_GP> > & out_acc, stream<ap_uint<PE_GP*OUTPUT_PRECISION_GP> > & out_avg, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int NUM_PIXELS = IFMDim_X_GP*IFMDim_Y_GP;
+	constexpr unsigned int NF = IFM_Channels_GP / PE_GP;
+	static int SUM[MAX_IMAGES][IFM_Channels_GP];
+	stream<ap_uint<PE_GP*INPUT_PRECISION_GP> > input_stream_acc("input_stream_acc");
+	stream<ap_uint<PE_GP*INPUT_PRECISION_GP> > input_stream_avg("input_stream_avg");
+	stream<ap_uint<PE_GP*ACC_PRECISION_GP> > output_stream_acc("output_stream_acc");
+	stream<ap_uint<PE_GP*OUTPUT_PRECISION_GP> > output_stream_avg("output_stream_avg");
+	unsigned int err_counter = 0;
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int ch = 0; ch < IFM_Channels_GP; ch++)
+			SUM[n_image][ch] = 0;
+		for (unsigned int pixel = 0; pixel < NUM_PIXELS; pixel++)
+			for (unsigned int nf = 0; nf < NF; nf++) {
+				ap_uint<PE_GP*INPUT_PRECISION_GP> word;
+				for (unsigned int pe = 0; pe < PE_GP; pe++) {
+					// the first image saturates the accumulation towards the most negative average
+					ap_int<INPUT_PRECISION_GP> const val = n_image == 0? ap_int<INPUT_PRECISION_GP>(1 << (INPUT_PRECISION_GP-1)) : ap_int<INPUT_PRECISION_GP>(rand());
+					word((pe+1)*INPUT_PRECISION_GP-1, pe*INPUT_PRECISION_GP) = val;
+					SUM[n_image][nf*PE_GP + pe] += int(val);
+				}
+				input_stream_acc.write(word);
+				input_stream_avg.write(word);
+			}
+	}
+
+	Testbench_global_avgpool(input_stream_acc, input_stream_avg, output_stream_acc, output_stream_avg, MAX_IMAGES);
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_GP*ACC_PRECISION_GP> const accElem = output_stream_acc.read();
+			ap_uint<PE_GP*OUTPUT_PRECISION_GP> const avgElem = output_stream_avg.read();
+			for (unsigned int pe = 0; pe < PE_GP; pe++) {
+				int const sum = SUM[n_image][nf*PE_GP + pe];
+				ap_int<ACC_PRECISION_GP> const acc = accElem((pe+1)*ACC_PRECISION_GP-1, pe*ACC_PRECISION_GP);
+				ap_int<OUTPUT_PRECISION_GP> const avg = avgElem((pe+1)*OUTPUT_PRECISION_GP-1, pe*OUTPUT_PRECISION_GP);
+				// same truncation towards zero as AvgPoolFunction
+				ap_int<OUTPUT_PRECISION_GP> const exp_avg = sum / int(NUM_PIXELS);
+				if (int(acc) != sum) {
+					std::cout << "ERROR ACC: Image " << n_image << " channel " << nf*PE_GP + pe << " Expected " << sum << " actual " << acc << std::endl;
+					err_counter++;
+				}
+				if (avg != exp_avg) {
+					std::cout << "ERROR AVG: Image " << n_image << " channel " << nf*PE_GP + pe << " Expected " << exp_avg << " actual " << avg << std::endl;
+					err_counter++;
+				}
+			}
+		}
+	if (!output_stream_acc.empty() || !output_stream_avg.empty()) {
+		std::cout << "ERROR: Output streams not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	return 0;
+}
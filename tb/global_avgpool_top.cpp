@@ -0,0 +1,15 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_global_avgpool.h"
+
+void Testbench_global_avgpool(stream<ap_uint<PE_GP*INPUT_PRECISION_GP> > & in_acc, stream<ap_uint<PE_GP*INPUT_PRECISION_GP> > & in_avg,
+	stream<ap_uint<PE_GP*ACC_PRECISION_GP> > & out_acc, stream<ap_uint<PE_GP*OUTPUT_PRECISION_GP> > & out_avg, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	GlobalAccPool_Batch<IFMDim_X_GP*IFMDim_Y_GP, IFM_Channels_GP, ap_int<INPUT_PRECISION_GP>, PE_GP, ap_int<ACC_PRECISION_GP> >
+		(in_acc, out_acc, numReps);
+	GlobalAvgPool_Batch<IFMDim_X_GP*IFMDim_Y_GP, IFM_Channels_GP, ap_int<INPUT_PRECISION_GP>, PE_GP, ap_int<ACC_PRECISION_GP>, ap_int<OUTPUT_PRECISION_GP> >
+		(in_avg, out_avg, numReps);
+}
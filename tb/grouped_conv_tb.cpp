@@ -0,0 +1,110 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file grouped_conv_tb.cpp
+ *
+ *  Testbench for the grouped convolutional layer
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_grouped_conv.h"
+#include "data/config_grouped_conv.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 2
+#define IFM_GROUP_GC (IFM_Channels_GC/GROUPS_GC)
+#define OFM_GROUP_GC (OFM_Channels_GC/GROUPS_GC)
+
+void Testbench_grouped_conv(stream<ap_uint<IFM_Channels_GC*INPUT_PRECISION_GC> > & in, stream<ap_uint<OFM_Channels_GC*ACTIVATION_PRECISION_GC> > & out, unsigned int numReps);
+
+int main()
+{
+	static int IMAGE[NUM_REPEAT][IFMDim_GC][IFMDim_GC][IFM_Channels_GC];
+	stream<ap_uint<IFM_Channels_GC*INPUT_PRECISION_GC> > in("in");
+	stream<ap_uint<OFM_Channels_GC*ACTIVATION_PRECISION_GC> > out("out");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int y = 0; y < IFMDim_GC; y++) {
+			for (unsigned int x = 0; x < IFMDim_GC; x++) {
+				ap_uint<IFM_Channels_GC*INPUT_PRECISION_GC> word;
+				for (unsigned int c = 0; c < IFM_Channels_GC; c++) {
+					ap_uint<INPUT_PRECISION_GC> const act = rand();
+					IMAGE[rep][y][x][c] = act;
+					word((c+1)*INPUT_PRECISION_GC-1, c*INPUT_PRECISION_GC) = act;
+				}
+				in.write(word);
+			}
+		}
+	}
+
+	Testbench_grouped_conv(in, out, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int y = 0; y < OFMDim_GC; y++) {
+			for (unsigned int x = 0; x < OFMDim_GC; x++) {
+				ap_uint<OFM_Channels_GC*ACTIVATION_PRECISION_GC> const value = out.read();
+				for (unsigned int o = 0; o < OFM_Channels_GC; o++) {
+					// output channel o only sees the input channels of its group
+					unsigned int const g = o / OFM_GROUP_GC;
+					int exp = 0;
+					for (unsigned int ky = 0; ky < KERNEL_DIM_GC; ky++)
+						for (unsigned int kx = 0; kx < KERNEL_DIM_GC; kx++)
+							for (unsigned int c = 0; c < IFM_GROUP_GC; c++)
+								exp += PARAM_GROUPED_CONV::weights_raw[o][(ky*KERNEL_DIM_GC + kx)*IFM_GROUP_GC + c] * IMAGE[rep][y+ky][x+kx][g*IFM_GROUP_GC + c];
+					ap_int<ACTIVATION_PRECISION_GC> const act = value((o+1)*ACTIVATION_PRECISION_GC-1, o*ACTIVATION_PRECISION_GC);
+					if (act != exp) {
+						cout << "ERROR: rep " << rep << " pixel " << y << "," << x << " channel " << o << " expected " << exp << " actual " << act << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	if (!in.empty() || !out.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,20 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_grouped_conv.h"
+#include "data/config_grouped_conv.h"
+
+typedef ap_uint<INPUT_PRECISION_GC> TI_GC;
+typedef ap_int<ACTIVATION_PRECISION_GC> TO_GC;
+
+void Testbench_grouped_conv(stream<ap_uint<IFM_Channels_GC*INPUT_PRECISION_GC> > & in, stream<ap_uint<OFM_Channels_GC*ACTIVATION_PRECISION_GC> > & out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	ConvLayer_Grouped_Batch<KERNEL_DIM_GC, IFM_Channels_GC, IFMDim_GC, OFM_Channels_GC, OFMDim_GC, GROUPS_GC, SIMD_GC, PE_GC,
+		Slice<TI_GC>, Slice<TO_GC>, Identity>
+		(in, out, PARAM_GROUPED_CONV::weights, PassThroughActivation<TO_GC>(), numReps, ap_resource_dsp());
+}
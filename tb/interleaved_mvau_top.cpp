@@ -0,0 +1,19 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_systolic.h"
+#include "data/config_systolic.h"
+
+#define INTERLEAVE_SY 2
+
+void Testbench_interleaved_mvau(stream<MultiChanData<MMV_SY, SIMD_SY*INPUT_PRECISION_SY> > & in, stream<MultiChanData<MMV_SY, PE_SY*ACTIVATION_PRECISION_SY> > & out, unsigned int numReps){
+#pragma HLS ARRAY_PARTITION variable=PARAM_SYSTOLIC::weights.m_weights complete dim=1
+	Matrix_Vector_Activate_Interleaved_Batch<MatrixW_SY, MatrixH_SY, SIMD_SY, PE_SY, MMV_SY, INTERLEAVE_SY, Slice_mmv<ap_uint<INPUT_PRECISION_SY>, MMV_SY>, Slice_mmv<ap_int<ACTIVATION_PRECISION_SY>, MMV_SY>, Identity>
+		(in, out, PARAM_SYSTOLIC::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_SY>>(), numReps, ap_resource_dsp());
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file label_select_tournament_tb.cpp
+ *
+ *  Testbench for the tournament based LabelSelect layer
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_label_select_tournament.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 4
+void Testbench_label_select_tournament(stream<ap_uint<PE_LT*INPUT_PRECISION_LT> > & in, stream<ap_uint<PE_LT*INPUT_PRECISION_LT> > & in_scores,
+	stream<ap_uint<OUT_WIDTH_LT> > & out, stream<ap_uint<OUT_WIDTH_LT> > & out_scores, stream<ap_int<INPUT_PRECISION_LT> > & scores, unsigned int numReps);
+
+int main()
+{
+	static int VALUES[MAX_IMAGES][NumClasses_LT];
+	stream<ap_uint<PE_LT*INPUT_PRECISION_LT> > input_stream("input_stream");
+	stream<ap_uint<PE_LT*INPUT_PRECISION_LT> > input_stream_scores("input_stream_scores");
+	stream<ap_uint<OUT_WIDTH_LT> > output_stream("output_stream");
+	stream<ap_uint<OUT_WIDTH_LT> > output_stream_scores("output_stream_scores");
+	stream<ap_int<INPUT_PRECISION_LT> > scores_stream("scores_stream");
+	unsigned int err_counter = 0;
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int block = 0; block < NumClasses_LT / PE_LT; block++) {
+			ap_uint<PE_LT*INPUT_PRECISION_LT> word;
+			for (unsigned int pe = 0; pe < PE_LT; pe++) {
+				// the narrow input precision produces many ties
+				ap_int<INPUT_PRECISION_LT> const val = rand();
+				VALUES[n_image][block*PE_LT + pe] = val;
+				word((pe+1)*INPUT_PRECISION_LT-1, pe*INPUT_PRECISION_LT) = val;
+			}
+			input_stream.write(word);
+			input_stream_scores.write(word);
+		}
+
+	Testbench_label_select_tournament(input_stream, input_stream_scores, output_stream, output_stream_scores, scores_stream, MAX_IMAGES);
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		// highest value first, equal values by ascending label
+		unsigned int labels[NumClasses_LT];
+		for (unsigned int i = 0; i < NumClasses_LT; i++)
+			labels[i] = i;
+		std::stable_sort(labels, labels + NumClasses_LT, [&](unsigned int a, unsigned int b) {
+			return VALUES[n_image][a] > VALUES[n_image][b];
+		});
+		for (unsigned int top = 0; top < NumTop_LT; top++) {
+			unsigned int const label = output_stream.read();
+			unsigned int const label_scores = output_stream_scores.read();
+			int const score = scores_stream.read();
+			if ((label != labels[top]) || (label_scores != labels[top]) || (score != VALUES[n_image][labels[top]])) {
+				std::cout << "ERROR: Image " << n_image << " top " << top << " Expected " << labels[top] << " (" << VALUES[n_image][labels[top]]
+					<< ") actual " << label << ", " << label_scores << " (" << score << ")" << std::endl;
+				err_counter++;
+			}
+		}
+	}
+	if (!output_stream.empty() || !output_stream_scores.empty() || !scores_stream.empty()) {
+		std::cout << "ERROR: Output streams not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	return 0;
+}
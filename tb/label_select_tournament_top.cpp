@@ -0,0 +1,13 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_label_select_tournament.h"
+
+void Testbench_label_select_tournament(stream<ap_uint<PE_LT*INPUT_PRECISION_LT> > & in, stream<ap_uint<PE_LT*INPUT_PRECISION_LT> > & in_scores,
+	stream<ap_uint<OUT_WIDTH_LT> > & out, stream<ap_uint<OUT_WIDTH_LT> > & out_scores, stream<ap_int<INPUT_PRECISION_LT> > & scores, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	LabelSelect_Tournament_Batch<NumClasses_LT, PE_LT, NumTop_LT, ap_int<INPUT_PRECISION_LT>, ap_uint<OUT_WIDTH_LT> >(in, out, numReps);
+	LabelSelect_Tournament_Batch<NumClasses_LT, PE_LT, NumTop_LT, ap_int<INPUT_PRECISION_LT>, ap_uint<OUT_WIDTH_LT> >(in_scores, out_scores, scores, numReps);
+}
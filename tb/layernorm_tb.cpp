@@ -0,0 +1,142 @@
+/******************************************************************************
+ *  Copyright (c) 2022, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ * @brief	Testbench for LayerNorm layer.
+ *******************************************************************************/
+#include "layernorm_top.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <cmath>
+#include <vector>
+
+template<unsigned  N, unsigned  PE, typename  TO, typename  TG, typename  TB>
+unsigned check(
+	std::vector<int> const &x,
+	unsigned const  eps,
+	TG const (&gamma)[PE][N/PE],
+	TB const (&beta)[PE][N/PE],
+	hls::stream<ap_uint<PE*TO::width>> &dst,
+	double const  lsb
+) {
+	constexpr unsigned  WO = TO::width;
+	unsigned  mismatches = 0;
+	double  mean = 0;
+	for(int  v : x)  mean += v;
+	mean /= N;
+	double  var = 0;
+	for(int  v : x)  var += (v - mean)*(v - mean);
+	var /= N;
+	for(unsigned  i = 0; i < N; i += PE) {
+		ap_uint<PE*WO> const  y = dst.read();
+		for(unsigned  pe = 0; pe < PE; pe++) {
+			TO  yv;
+			yv.range(WO-1, 0) = y((pe+1)*WO-1, pe*WO);
+			double const  g   = gamma[pe][i/PE].to_double();
+			double const  b   = beta[pe][i/PE].to_double();
+			double const  ref = g * (x[i+pe] - mean) / std::sqrt(var + eps) + b;
+			// saturate the reference into the output range
+			TO const      lim = TO(ap_uint<WO>(-1) >> 1);
+			double const  hi  = double(lim);
+			double const  lo  = -hi - lsb;
+			double const  r   = ref > hi? hi : ref < lo? lo : ref;
+			bool  const   ok  = std::abs(double(yv) - r) <= lsb;
+			if(!ok)  mismatches++;
+			std::cout << std::setw(4) << x[i+pe] << " -> " << std::setw(8) << double(yv) << " / " << std::setw(10) << ref << '\t' << (ok? '.' : 'X') << std::endl;
+		}
+	}
+	std::cout << "--------------\n" << std::endl;
+	return  mismatches;
+}
+
+int main() {
+	unsigned  mismatches = 0; {
+		std::default_random_engine  rnd;
+		std::uniform_int_distribution<>  dist0(-(1<<(TI0::width-1)), (1<<(TI0::width-1))-1);
+		std::uniform_int_distribution<>  dist1(0, (1<<TI1::width)-1);
+		std::uniform_real_distribution<>  dist_g(-2.0, 2.0);
+		std::uniform_real_distribution<>  dist_b(-4.0, 4.0);
+
+		static TG0  gamma0[PE0][N0/PE0];
+		static TB0  beta0[PE0][N0/PE0];
+		static TG1  gamma1[PE1][N1/PE1];
+		static TB1  beta1[PE1][N1/PE1];
+		for(unsigned  pe = 0; pe < PE0; pe++) {
+			for(unsigned  nf = 0; nf < N0/PE0; nf++) {
+				gamma0[pe][nf] = dist_g(rnd);
+				beta0[pe][nf]  = dist_b(rnd);
+			}
+		}
+		for(unsigned  pe = 0; pe < PE1; pe++) {
+			for(unsigned  nf = 0; nf < N1/PE1; nf++) {
+				gamma1[pe][nf] = dist_g(rnd);
+				beta1[pe][nf]  = dist_b(rnd);
+			}
+		}
+
+		hls::stream<ap_uint<PE0*TI0::width>>  src0("src0");
+		hls::stream<ap_uint<PE0*TO0::width>>  dst0("dst0");
+		hls::stream<ap_uint<PE1*TI1::width>>  src1("src1");
+		hls::stream<ap_uint<PE1*TO1::width>>  dst1("dst1");
+		std::vector<std::vector<int>>  x0(REPS, std::vector<int>(N0));
+		std::vector<std::vector<int>>  x1(REPS, std::vector<int>(N1));
+		for(unsigned  k = 0; k < REPS; k++) {
+			// include a constant vector
+			bool const  flat = k == REPS-1;
+			for(unsigned  i = 0; i < N0; i += PE0) {
+				ap_uint<PE0*TI0::width>  w;
+				for(unsigned  pe = 0; pe < PE0; pe++) {
+					x0[k][i+pe] = flat? -3 : dist0(rnd);
+					w((pe+1)*TI0::width-1, pe*TI0::width) = TI0(x0[k][i+pe]);
+				}
+				src0.write(w);
+			}
+			for(unsigned  i = 0; i < N1; i++) {
+				x1[k][i] = flat? 5 : dist1(rnd);
+				src1.write(x1[k][i]);
+			}
+		}
+
+		layernorm_top(src0, dst0, gamma0, beta0, src1, dst1, gamma1, beta1);
+
+		for(unsigned  k = 0; k < REPS; k++) {
+			mismatches += check<N0, PE0, TO0>(x0[k], 1, gamma0, beta0, dst0, 1.0/16);
+			mismatches += check<N1, PE1, TO1>(x1[k], EPS1, gamma1, beta1, dst1, 1.0);
+		}
+		if(!src0.empty() || !dst0.empty() || !src1.empty() || !dst1.empty())  mismatches++;
+	}
+
+	if(mismatches == 0)  return  0;
+	else {
+		std::cout << mismatches << " output mismatches." << std::endl;
+		return  1;
+	}
+}
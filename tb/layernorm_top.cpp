@@ -0,0 +1,54 @@
+/******************************************************************************
+ *  Copyright (c) 2022, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ * @brief	Top-level for LayerNorm layer test.
+ *******************************************************************************/
+#include "normalize.hpp"
+#include "layernorm_top.hpp"
+
+
+void layernorm_top(
+	hls::stream<ap_uint<PE0*TI0::width>> &src0,
+	hls::stream<ap_uint<PE0*TO0::width>> &dst0,
+	TG0 const (&gamma0)[PE0][N0/PE0],
+	TB0 const (&beta0)[PE0][N0/PE0],
+	hls::stream<ap_uint<PE1*TI1::width>> &src1,
+	hls::stream<ap_uint<PE1*TO1::width>> &dst1,
+	TG1 const (&gamma1)[PE1][N1/PE1],
+	TB1 const (&beta1)[PE1][N1/PE1]
+) {
+#pragma HLS interface AXIS port=src0
+#pragma HLS interface AXIS port=dst0
+#pragma HLS interface AXIS port=src1
+#pragma HLS interface AXIS port=dst1
+#pragma HLS dataflow disable_start_propagation
+	LayerNorm_Batch<N0, PE0, ZF0, TI0, TO0>(src0, dst0, gamma0, beta0, REPS);
+	LayerNorm_Batch<N1, PE1, ZF1, TI1, TO1, EPS1>(src1, dst1, gamma1, beta1, REPS);
+}
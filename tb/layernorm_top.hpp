@@ -0,0 +1,71 @@
+/******************************************************************************
+ *  Copyright (c) 2022, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ * @brief	Top-level for LayerNorm layer test.
+ *******************************************************************************/
+#ifndef LAYERNORM_TOP_HPP
+#define LAYERNORM_TOP_HPP
+
+#include <ap_int.h>
+#include <ap_fixed.h>
+#include <hls_stream.h>
+
+constexpr unsigned  REPS = 10;
+
+// Instance 0: signed input, PE-parallel, saturating fixed-point output
+constexpr unsigned  N0   = 16;
+constexpr unsigned  PE0  = 4;
+constexpr unsigned  ZF0  = 8;
+using  TI0 = ap_int<8>;
+using  TO0 = ap_fixed<8, 4, AP_RND, AP_SAT>;
+using  TG0 = ap_fixed<8, 2>;
+using  TB0 = ap_fixed<8, 3>;
+
+// Instance 1: unsigned input, larger variance offset, integer output
+constexpr unsigned  N1   = 8;
+constexpr unsigned  PE1  = 1;
+constexpr unsigned  ZF1  = 6;
+constexpr unsigned  EPS1 = 4;
+using  TI1 = ap_uint<4>;
+using  TO1 = ap_int<6>;
+using  TG1 = ap_fixed<6, 2>;
+using  TB1 = ap_fixed<6, 3>;
+
+void layernorm_top(
+	hls::stream<ap_uint<PE0*TI0::width>> &src0,
+	hls::stream<ap_uint<PE0*TO0::width>> &dst0,
+	TG0 const (&gamma0)[PE0][N0/PE0],
+	TB0 const (&beta0)[PE0][N0/PE0],
+	hls::stream<ap_uint<PE1*TI1::width>> &src1,
+	hls::stream<ap_uint<PE1*TO1::width>> &dst1,
+	TG1 const (&gamma1)[PE1][N1/PE1],
+	TB1 const (&beta1)[PE1][N1/PE1]
+);
+#endif
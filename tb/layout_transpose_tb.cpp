@@ -0,0 +1,126 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file layout_transpose_tb.cpp
+ *
+ *  Testbench for the NCHW to NHWC and NHWC to NCHW layout transpose blocks
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_layout_transpose.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 3
+#define PF_LT (PIXELS_LT/SIMD_LT)
+#define CF_LT (Channels_LT/SIMD_LT)
+
+void Testbench_layout_transpose(stream<ap_uint<SIMD_LT*PRECISION_LT> > & in, stream<ap_uint<SIMD_LT*PRECISION_LT> > & out,
+	stream<ap_uint<SIMD_LT*PRECISION_LT> > & in_nhwc, stream<ap_uint<SIMD_LT*PRECISION_LT> > & out_nchw, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<PRECISION_LT> IMAGE[NUM_REPEAT][PIXELS_LT][Channels_LT];
+	stream<ap_uint<SIMD_LT*PRECISION_LT> > in("in"), out("out"), in_nhwc("in_nhwc"), out_nchw("out_nchw");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int p = 0; p < PIXELS_LT; p++)
+			for (unsigned int c = 0; c < Channels_LT; c++)
+				IMAGE[rep][p][c] = rand();
+		// planar input: SIMD pixels of a channel per word
+		for (unsigned int c = 0; c < Channels_LT; c++) {
+			for (unsigned int pf = 0; pf < PF_LT; pf++) {
+				ap_uint<SIMD_LT*PRECISION_LT> word;
+				for (unsigned int s = 0; s < SIMD_LT; s++)
+					word((s+1)*PRECISION_LT-1, s*PRECISION_LT) = IMAGE[rep][pf*SIMD_LT + s][c];
+				in.write(word);
+			}
+		}
+		// interleaved input: SIMD channels of a pixel per word
+		for (unsigned int p = 0; p < PIXELS_LT; p++) {
+			for (unsigned int cf = 0; cf < CF_LT; cf++) {
+				ap_uint<SIMD_LT*PRECISION_LT> word;
+				for (unsigned int s = 0; s < SIMD_LT; s++)
+					word((s+1)*PRECISION_LT-1, s*PRECISION_LT) = IMAGE[rep][p][cf*SIMD_LT + s];
+				in_nhwc.write(word);
+			}
+		}
+	}
+
+	Testbench_layout_transpose(in, out, in_nhwc, out_nchw, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int p = 0; p < PIXELS_LT; p++) {
+			for (unsigned int cf = 0; cf < CF_LT; cf++) {
+				ap_uint<SIMD_LT*PRECISION_LT> const value = out.read();
+				for (unsigned int s = 0; s < SIMD_LT; s++) {
+					ap_uint<PRECISION_LT> const exp = IMAGE[rep][p][cf*SIMD_LT + s];
+					ap_uint<PRECISION_LT> const act = value((s+1)*PRECISION_LT-1, s*PRECISION_LT);
+					if (act != exp) {
+						cout << "ERROR: NCHW to NHWC rep " << rep << " pixel " << p << " channel " << cf*SIMD_LT + s << " expected " << exp << " actual " << act << endl;
+						errors++;
+					}
+				}
+			}
+		}
+		for (unsigned int c = 0; c < Channels_LT; c++) {
+			for (unsigned int pf = 0; pf < PF_LT; pf++) {
+				ap_uint<SIMD_LT*PRECISION_LT> const value = out_nchw.read();
+				for (unsigned int s = 0; s < SIMD_LT; s++) {
+					ap_uint<PRECISION_LT> const exp = IMAGE[rep][pf*SIMD_LT + s][c];
+					ap_uint<PRECISION_LT> const act = value((s+1)*PRECISION_LT-1, s*PRECISION_LT);
+					if (act != exp) {
+						cout << "ERROR: NHWC to NCHW rep " << rep << " pixel " << pf*SIMD_LT + s << " channel " << c << " expected " << exp << " actual " << act << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	if (!in.empty() || !out.empty() || !in_nhwc.empty() || !out_nchw.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,13 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_layout_transpose.h"
+
+void Testbench_layout_transpose(stream<ap_uint<SIMD_LT*PRECISION_LT> > & in, stream<ap_uint<SIMD_LT*PRECISION_LT> > & out,
+	stream<ap_uint<SIMD_LT*PRECISION_LT> > & in_nhwc, stream<ap_uint<SIMD_LT*PRECISION_LT> > & out_nchw, unsigned int numReps)
+{
+	NCHWToNHWC_Batch<PIXELS_LT, Channels_LT, SIMD_LT, ap_uint<PRECISION_LT> >(in, out, numReps, ap_resource_bram());
+	NHWCToNCHW_Batch<PIXELS_LT, Channels_LT, SIMD_LT, ap_uint<PRECISION_LT> >(in_nhwc, out_nchw, numReps, ap_resource_dflt());
+}
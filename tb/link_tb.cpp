@@ -0,0 +1,149 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file link_tb.cpp
+ *
+ *  Testbench for the credit-controlled inter-device link adapters
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_link.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 6
+void Testbench_link(stream<ap_uint<DATA_WIDTH_LK> > & in, stream<ap_uint<DATA_WIDTH_LK> > & out,
+	stream<LinkCredit> & tx_credit, stream<LinkCredit> & rx_credit, unsigned int & errors,
+	stream<qdma_axis<LINK_WIDTH_LK,0,0,0> > & link_in, stream<ap_uint<LINK_WIDTH_LK> > & link_out, stream<LinkCredit> & link_credit,
+	unsigned int & link_errors, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int LINK_WORDS = NUM_WORDS_LK*DATA_WIDTH_LK/LINK_WIDTH_LK;
+	constexpr unsigned int PACKETS = (LINK_WORDS + PACKET_WORDS_LK - 1) / PACKET_WORDS_LK;
+	static ap_uint<DATA_WIDTH_LK> IMAGE[MAX_IMAGES][NUM_WORDS_LK];
+	static ap_uint<LINK_WIDTH_LK> LINK_IMAGE[MAX_IMAGES][LINK_WORDS];
+	stream<ap_uint<DATA_WIDTH_LK> > input_stream("input_stream");
+	stream<ap_uint<DATA_WIDTH_LK> > output_stream("output_stream");
+	stream<LinkCredit> tx_credit("tx_credit");
+	stream<LinkCredit> rx_credit("rx_credit");
+	stream<qdma_axis<LINK_WIDTH_LK,0,0,0> > link_in("link_in");
+	stream<ap_uint<LINK_WIDTH_LK> > link_out("link_out");
+	stream<LinkCredit> link_credit("link_credit");
+	int err_counter = 0;
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int w = 0; w < NUM_WORDS_LK; w++) {
+			IMAGE[n_image][w] = rand();
+		}
+		for (unsigned int w = 0; w < LINK_WORDS; w++) {
+			for (unsigned int k = 0; k < LINK_WIDTH_LK/DATA_WIDTH_LK; k++) {
+				LINK_IMAGE[n_image][w]((k+1)*DATA_WIDTH_LK-1, k*DATA_WIDTH_LK) = rand();
+			}
+		}
+	}
+
+	// One frame per call, as the sender only holds the credits of a single frame and the
+	// returned credits have to be carried back to it between calls in csim.
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int w = 0; w < NUM_WORDS_LK; w++) {
+			input_stream.write(IMAGE[n_image][w]);
+		}
+		// hand-built packets for the receiver alone, with a wrong frame index in the header of image 2
+		for (unsigned int p = 0; p < PACKETS; p++) {
+			unsigned int const words = p == PACKETS-1? LINK_WORDS - p*PACKET_WORDS_LK : PACKET_WORDS_LK;
+			qdma_axis<LINK_WIDTH_LK,0,0,0> beat;
+			beat.set_keep(-1);
+			beat.set_last(0);
+			beat.set_data(LinkPacketHeader<LINK_WIDTH_LK>::pack(n_image == 2? 1 : 0, p, words, p == PACKETS-1));
+			link_in.write(beat);
+			for (unsigned int w = 0; w < words; w++) {
+				beat.set_data(LINK_IMAGE[n_image][p*PACKET_WORDS_LK + w]);
+				beat.set_last(w == words-1);
+				link_in.write(beat);
+			}
+		}
+
+		unsigned int errors = 0;
+		unsigned int link_errors = 0;
+		Testbench_link(input_stream, output_stream, tx_credit, rx_credit, errors, link_in, link_out, link_credit, link_errors, 1);
+
+		if (rx_credit.size() != PACKETS || link_credit.size() != PACKETS) {
+			std::cout << "ERROR: Image " << n_image << " returned " << rx_credit.size() << " and " << link_credit.size() << " credits" << std::endl;
+			err_counter++;
+		}
+		while (!rx_credit.empty()) {
+			tx_credit.write(rx_credit.read());
+		}
+		while (!link_credit.empty()) {
+			link_credit.read();
+		}
+		if (errors != 0) {
+			std::cout << "ERROR: Image " << n_image << " reported " << errors << " header errors" << std::endl;
+			err_counter++;
+		}
+		if (link_errors != (n_image == 2? PACKETS : 0)) {
+			std::cout << "ERROR: Image " << n_image << " reported " << link_errors << " header errors on the receiver" << std::endl;
+			err_counter++;
+		}
+		for (unsigned int w = 0; w < NUM_WORDS_LK; w++) {
+			ap_uint<DATA_WIDTH_LK> const out = output_stream.read();
+			if (out != IMAGE[n_image][w]) {
+				std::cout << "ERROR: Image " << n_image << " Expected[" << w << "]=" << IMAGE[n_image][w] << " actual " << out << std::endl;
+				err_counter++;
+			}
+		}
+		for (unsigned int w = 0; w < LINK_WORDS; w++) {
+			ap_uint<LINK_WIDTH_LK> const out = link_out.read();
+			if (out != LINK_IMAGE[n_image][w]) {
+				std::cout << "ERROR: Image " << n_image << " Receiver expected[" << w << "]=" << LINK_IMAGE[n_image][w] << " actual " << out << std::endl;
+				err_counter++;
+			}
+		}
+	}
+
+	if (!output_stream.empty() || !link_out.empty() || !input_stream.empty() || !link_in.empty()) {
+		std::cout << "ERROR: Streams not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return 0;
+}
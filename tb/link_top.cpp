@@ -0,0 +1,18 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_link.h"
+
+void Testbench_link(stream<ap_uint<DATA_WIDTH_LK> > & in, stream<ap_uint<DATA_WIDTH_LK> > & out,
+	stream<LinkCredit> & tx_credit, stream<LinkCredit> & rx_credit, unsigned int & errors,
+	stream<qdma_axis<LINK_WIDTH_LK,0,0,0> > & link_in, stream<ap_uint<LINK_WIDTH_LK> > & link_out, stream<LinkCredit> & link_credit,
+	unsigned int & link_errors, unsigned int numReps){
+#pragma HLS DATAFLOW
+	stream<qdma_axis<LINK_WIDTH_LK,0,0,0> > link("link");
+#pragma HLS STREAM variable=link depth=CREDITS_LK*(PACKET_WORDS_LK+1)
+	Stream2Link_Adjusted_Batch<DATA_WIDTH_LK, LINK_WIDTH_LK, NUM_WORDS_LK, PACKET_WORDS_LK, CREDITS_LK>(in, link, tx_credit, numReps);
+	errors = Link2Stream_Adjusted_Batch<DATA_WIDTH_LK, LINK_WIDTH_LK, NUM_WORDS_LK, PACKET_WORDS_LK>(link, out, rx_credit, numReps);
+	link_errors = Link2Stream_Batch<LINK_WIDTH_LK, NUM_WORDS_LK*DATA_WIDTH_LK/LINK_WIDTH_LK, PACKET_WORDS_LK>(link_in, link_out, link_credit, numReps);
+}
@@ -0,0 +1,119 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file log_mvau_tb.cpp
+ *
+ *  Testbench for the matrix vector activation with power-of-two weights
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_log.h"
+#include "data/config_log.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 8
+#define SF_LG (MatrixW_LG/SIMD_LG)
+#define NF_LG (MatrixH_LG/PE_LG)
+
+void Testbench_log_mvau(stream<ap_uint<SIMD_LG*INPUT_PRECISION_LG> > & in, stream<ap_uint<PE_LG*ACTIVATION_PRECISION_LG> > & out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<INPUT_PRECISION_LG> IMAGE[NUM_REPEAT][MatrixW_LG];
+	stream<ap_uint<SIMD_LG*INPUT_PRECISION_LG> > input_stream("input_stream");
+	stream<ap_uint<PE_LG*ACTIVATION_PRECISION_LG> > output_stream("output_stream");
+	unsigned int errors = 0;
+
+	// the decoded weights must be those of the generator
+	for (unsigned int nf = 0; nf < NF_LG; nf++) {
+		for (unsigned int sf = 0; sf < SF_LG; sf++) {
+			for (unsigned int pe = 0; pe < PE_LG; pe++) {
+				auto const w = PARAM_LOG::weights.weights(nf*SF_LG + sf)[pe];
+				for (unsigned int simd = 0; simd < SIMD_LG; simd++) {
+					if (w[simd].value() != PARAM_LOG::raw[nf*PE_LG + pe][sf*SIMD_LG + simd]) {
+						cout << "ERROR decode: row " << nf*PE_LG + pe << " column " << sf*SIMD_LG + simd << " expected " << PARAM_LOG::raw[nf*PE_LG + pe][sf*SIMD_LG + simd] << " decoded " << w[simd].value() << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_LG; sf++) {
+			ap_uint<SIMD_LG*INPUT_PRECISION_LG> word;
+			for (unsigned int simd = 0; simd < SIMD_LG; simd++) {
+				ap_uint<INPUT_PRECISION_LG> const act = rand();
+				IMAGE[rep][sf*SIMD_LG + simd] = act;
+				word((simd+1)*INPUT_PRECISION_LG-1, simd*INPUT_PRECISION_LG) = act;
+			}
+			input_stream.write(word);
+		}
+	}
+
+	Testbench_log_mvau(input_stream, output_stream, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF_LG; nf++) {
+			ap_uint<PE_LG*ACTIVATION_PRECISION_LG> const outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_LG; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_LG; col++)
+					exp += PARAM_LOG::raw[nf*PE_LG + pe][col] * IMAGE[rep][col];
+				ap_int<ACTIVATION_PRECISION_LG> const EXP = exp;
+				ap_int<ACTIVATION_PRECISION_LG> out_chan;
+				out_chan(ACTIVATION_PRECISION_LG-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_LG-1, pe*ACTIVATION_PRECISION_LG);
+				if (EXP != out_chan) {
+					cout << "ERROR: rep " << rep << " expected[" << nf*PE_LG + pe << "]=" << EXP << " actual " << out_chan << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
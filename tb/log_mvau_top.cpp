@@ -0,0 +1,16 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_log.h"
+#include "data/config_log.h"
+
+void Testbench_log_mvau(stream<ap_uint<SIMD_LG*INPUT_PRECISION_LG> > & in, stream<ap_uint<PE_LG*ACTIVATION_PRECISION_LG> > & out, unsigned int numReps){
+	Matrix_Vector_Activate_Batch<MatrixW_LG, MatrixH_LG, SIMD_LG, PE_LG, 1, Slice<ap_uint<INPUT_PRECISION_LG> >, Slice<ap_int<ACTIVATION_PRECISION_LG> >, Identity>
+		(in, out, PARAM_LOG::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_LG>>(), numReps, ap_resource_shift());
+}
@@ -0,0 +1,14 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_lut.h"
+#include "data/config_lut.h"
+
+void Testbench_lut(stream<ap_uint<PE_L*INPUT_PRECISION_L> > & in, stream<ap_uint<PE_L*OUTPUT_PRECISION_L> > & out, unsigned int numReps){
+	LUT_Batch<1, Channels_L, PE_L, Slice<ap_int<INPUT_PRECISION_L> >, Slice<ap_uint<OUTPUT_PRECISION_L> > >
+		(in, out, PARAM_LUT::lut, numReps);
+}
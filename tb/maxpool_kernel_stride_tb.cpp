@@ -0,0 +1,105 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file maxpool_kernel_stride_tb.cpp
+ *
+ *  Testbench for the max pooling layer with arbitrary kernel and stride
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_maxpool_kernel_stride.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_maxpool_kernel_stride(stream<ap_uint<PE_MK*PRECISION_MK> > & in, stream<ap_uint<PE_MK*PRECISION_MK> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int NF = FM_Channels_MK / PE_MK;
+	constexpr unsigned int OFMDim_X = (IFMDim_X_MK - POOL_DIM_X_MK) / STRIDE_X_MK + 1;
+	constexpr unsigned int OFMDim_Y = (IFMDim_Y_MK - POOL_DIM_Y_MK) / STRIDE_Y_MK + 1;
+	static int IMAGE[MAX_IMAGES][IFMDim_Y_MK][IFMDim_X_MK][FM_Channels_MK];
+	stream<ap_uint<PE_MK*PRECISION_MK> > input_stream("input_stream");
+	stream<ap_uint<PE_MK*PRECISION_MK> > output_stream("output_stream");
+	unsigned int err_counter = 0;
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int y = 0; y < IFMDim_Y_MK; y++)
+			for (unsigned int x = 0; x < IFMDim_X_MK; x++)
+				for (unsigned int nf = 0; nf < NF; nf++) {
+					ap_uint<PE_MK*PRECISION_MK> word;
+					for (unsigned int pe = 0; pe < PE_MK; pe++) {
+						ap_int<PRECISION_MK> const val = rand();
+						IMAGE[n_image][y][x][nf*PE_MK + pe] = val;
+						word((pe+1)*PRECISION_MK-1, pe*PRECISION_MK) = val;
+					}
+					input_stream.write(word);
+				}
+
+	Testbench_maxpool_kernel_stride(input_stream, output_stream, MAX_IMAGES);
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int oy = 0; oy < OFMDim_Y; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_X; ox++)
+				for (unsigned int nf = 0; nf < NF; nf++) {
+					ap_uint<PE_MK*PRECISION_MK> const outElem = output_stream.read();
+					for (unsigned int pe = 0; pe < PE_MK; pe++) {
+						int exp = IMAGE[n_image][oy*STRIDE_Y_MK][ox*STRIDE_X_MK][nf*PE_MK + pe];
+						for (unsigned int ky = 0; ky < POOL_DIM_Y_MK; ky++)
+							for (unsigned int kx = 0; kx < POOL_DIM_X_MK; kx++) {
+								int const val = IMAGE[n_image][oy*STRIDE_Y_MK + ky][ox*STRIDE_X_MK + kx][nf*PE_MK + pe];
+								if (val > exp)
+									exp = val;
+							}
+						ap_int<PRECISION_MK> const max = outElem((pe+1)*PRECISION_MK-1, pe*PRECISION_MK);
+						if (int(max) != exp) {
+							std::cout << "ERROR: Image " << n_image << " oy= " << oy << " ox= " << ox << " channel " << nf*PE_MK + pe
+								<< " Expected " << exp << " actual " << max << std::endl;
+							err_counter++;
+						}
+					}
+				}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,12 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_maxpool_kernel_stride.h"
+
+void Testbench_maxpool_kernel_stride(stream<ap_uint<PE_MK*PRECISION_MK> > & in, stream<ap_uint<PE_MK*PRECISION_MK> > & out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	StreamingMaxPool_Precision_kernel_stride_Batch<IFMDim_X_MK, IFMDim_Y_MK, POOL_DIM_X_MK, POOL_DIM_Y_MK, STRIDE_X_MK, STRIDE_Y_MK,
+		FM_Channels_MK, PE_MK, ap_int<PRECISION_MK> >(in, out, numReps);
+}
@@ -53,6 +53,7 @@
 #include "pool_tb.hpp"
 #include "activations.hpp"
 #include "interpret.hpp"
+#include "csim_bench.hpp"
 
 using namespace hls;
 using namespace std;
@@ -85,7 +86,10 @@ int main()
 		}
 	}
 	pool<MAX_IMAGES,IFMDim1,OFMDim1,FM_Channels1,KERNEL_DIM,KERNEL_DIM,ap_uint<PRECISION> >(IMAGE,OUTPUT);
-	Testbench_pool(input_stream, output_stream, MAX_IMAGES);
+	{
+		CsimBench const  bench("POOL", MAX_IMAGES, input_stream.size());
+		Testbench_pool(input_stream, output_stream, MAX_IMAGES);
+	}
 	int err_counter = 0, err_perimage=0;
 	ap_uint<PRECISION> out_chan;
 	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
@@ -0,0 +1,130 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file mixed_mvau_tb.cpp
+ *
+ *  Testbench for the matrix vector activation with mixed-precision weights,
+ *  through the per-group MACs and through the generic weight access
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_mixed.h"
+#include "data/config_mixed.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 8
+#define SF_MP (MatrixW_MP/SIMD_MP)
+#define NF_MP (MatrixH_MP/PE_MP)
+
+void Testbench_mixed_mvau(stream<ap_uint<SIMD_MP*INPUT_PRECISION_MP> > & in, stream<ap_uint<SIMD_MP*INPUT_PRECISION_MP> > & in_generic,
+	stream<ap_uint<PE_MP*ACTIVATION_PRECISION_MP> > & out, stream<ap_uint<PE_MP*ACTIVATION_PRECISION_MP> > & out_generic, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<INPUT_PRECISION_MP> IMAGE[NUM_REPEAT][MatrixW_MP];
+	stream<ap_uint<SIMD_MP*INPUT_PRECISION_MP> > input_stream("input_stream");
+	stream<ap_uint<SIMD_MP*INPUT_PRECISION_MP> > input_stream_generic("input_stream_generic");
+	stream<ap_uint<PE_MP*ACTIVATION_PRECISION_MP> > output_stream("output_stream");
+	stream<ap_uint<PE_MP*ACTIVATION_PRECISION_MP> > output_stream_generic("output_stream_generic");
+	unsigned int errors = 0;
+
+	// the weights of both groups must be those of the generator
+	for (unsigned int nf = 0; nf < NF_MP; nf++) {
+		for (unsigned int sf = 0; sf < SF_MP; sf++) {
+			auto const tile = PARAM_MIXED::weights.weights(nf*SF_MP + sf);
+			for (unsigned int pe = 0; pe < PE_MP; pe++) {
+				auto const w = tile[pe];
+				for (unsigned int simd = 0; simd < SIMD_MP; simd++) {
+					int const grouped = pe < PE_HI_MP? int(tile.hi(pe)[simd]) : int(tile.lo(pe)[simd]);
+					int const exp = PARAM_MIXED::raw[nf*PE_MP + pe][sf*SIMD_MP + simd];
+					if ((w[simd] != exp) || (grouped != exp)) {
+						cout << "ERROR decode: row " << nf*PE_MP + pe << " column " << sf*SIMD_MP + simd << " expected " << exp
+							<< " decoded " << w[simd] << ", " << grouped << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_MP; sf++) {
+			ap_uint<SIMD_MP*INPUT_PRECISION_MP> word;
+			for (unsigned int simd = 0; simd < SIMD_MP; simd++) {
+				ap_uint<INPUT_PRECISION_MP> const act = rand();
+				IMAGE[rep][sf*SIMD_MP + simd] = act;
+				word((simd+1)*INPUT_PRECISION_MP-1, simd*INPUT_PRECISION_MP) = act;
+			}
+			input_stream.write(word);
+			input_stream_generic.write(word);
+		}
+	}
+
+	Testbench_mixed_mvau(input_stream, input_stream_generic, output_stream, output_stream_generic, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF_MP; nf++) {
+			ap_uint<PE_MP*ACTIVATION_PRECISION_MP> const outElem = output_stream.read();
+			ap_uint<PE_MP*ACTIVATION_PRECISION_MP> const outElemGeneric = output_stream_generic.read();
+			for (unsigned int pe = 0; pe < PE_MP; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_MP; col++)
+					exp += PARAM_MIXED::raw[nf*PE_MP + pe][col] * IMAGE[rep][col];
+				ap_int<ACTIVATION_PRECISION_MP> const EXP = exp;
+				ap_int<ACTIVATION_PRECISION_MP> out_chan, out_chan_generic;
+				out_chan(ACTIVATION_PRECISION_MP-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_MP-1, pe*ACTIVATION_PRECISION_MP);
+				out_chan_generic(ACTIVATION_PRECISION_MP-1, 0) = outElemGeneric((pe+1)*ACTIVATION_PRECISION_MP-1, pe*ACTIVATION_PRECISION_MP);
+				if ((EXP != out_chan) || (EXP != out_chan_generic)) {
+					cout << "ERROR: rep " << rep << " expected[" << nf*PE_MP + pe << "]=" << EXP << " actual " << out_chan << ", " << out_chan_generic << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !input_stream_generic.empty() || !output_stream.empty() || !output_stream_generic.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
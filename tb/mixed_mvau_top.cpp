@@ -0,0 +1,21 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_mixed.h"
+#include "data/config_mixed.h"
+
+void Testbench_mixed_mvau(stream<ap_uint<SIMD_MP*INPUT_PRECISION_MP> > & in, stream<ap_uint<SIMD_MP*INPUT_PRECISION_MP> > & in_generic,
+	stream<ap_uint<PE_MP*ACTIVATION_PRECISION_MP> > & out, stream<ap_uint<PE_MP*ACTIVATION_PRECISION_MP> > & out_generic, unsigned int numReps){
+#pragma HLS DATAFLOW
+	Matrix_Vector_Activate_MixedPrecision_Batch<MatrixW_MP, MatrixH_MP, SIMD_MP, PE_MP, 1, Slice<ap_uint<INPUT_PRECISION_MP> >, Slice<ap_int<ACTIVATION_PRECISION_MP> >, Identity>
+		(in, out, PARAM_MIXED::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_MP>>(), numReps, ap_resource_dsp(), ap_resource_lut());
+	// the generic access widens the low-precision weights for the unchanged MVAU
+	Matrix_Vector_Activate_Batch<MatrixW_MP, MatrixH_MP, SIMD_MP, PE_MP, 1, Slice<ap_uint<INPUT_PRECISION_MP> >, Slice<ap_int<ACTIVATION_PRECISION_MP> >, Identity>
+		(in_generic, out_generic, PARAM_MIXED::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_MP>>(), numReps, ap_resource_lut());
+}
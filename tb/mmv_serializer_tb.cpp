@@ -0,0 +1,110 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file mmv_serializer_tb.cpp
+ *
+ *  Testbench for the MMV output serializer, narrowing and widening
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_mmv_serializer.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_GROUPS 5
+// bits per group in pixel-major order
+#define GROUP_BITS (MMV_SR*CHUNKS_SR*IN_WIDTH_SR)
+
+void Testbench_mmv_serializer(stream<MultiChanData<MMV_SR, IN_WIDTH_SR> > & in_down, stream<ap_uint<DOWN_WIDTH_SR> > & out_down,
+	stream<MultiChanData<MMV_SR, IN_WIDTH_SR> > & in_up, stream<ap_uint<UP_WIDTH_SR> > & out_up, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<GROUP_BITS> EXPECTED[NUM_GROUPS];
+	stream<MultiChanData<MMV_SR, IN_WIDTH_SR> > in_down("in_down");
+	stream<MultiChanData<MMV_SR, IN_WIDTH_SR> > in_up("in_up");
+	stream<ap_uint<DOWN_WIDTH_SR> > out_down("out_down");
+	stream<ap_uint<UP_WIDTH_SR> > out_up("out_up");
+	unsigned int errors = 0;
+
+	for (unsigned int g = 0; g < NUM_GROUPS; g++) {
+		for (unsigned int n = 0; n < CHUNKS_SR; n++) {
+			MultiChanData<MMV_SR, IN_WIDTH_SR> word;
+			for (unsigned int v = 0; v < MMV_SR; v++) {
+				ap_uint<IN_WIDTH_SR> const chunk = (ap_uint<IN_WIDTH_SR>(rand()) << 16) ^ rand();
+				word.data[v] = chunk;
+				// pixel v holds chunks 0..CHUNKS_SR-1 of the layer output
+				unsigned int const ofs = (v*CHUNKS_SR + n)*IN_WIDTH_SR;
+				EXPECTED[g](ofs+IN_WIDTH_SR-1, ofs) = chunk;
+			}
+			in_down.write(word);
+			in_up.write(word);
+		}
+	}
+
+	Testbench_mmv_serializer(in_down, out_down, in_up, out_up, NUM_GROUPS);
+
+	for (unsigned int g = 0; g < NUM_GROUPS; g++) {
+		for (unsigned int o = 0; o < GROUP_BITS/DOWN_WIDTH_SR; o++) {
+			ap_uint<DOWN_WIDTH_SR> const exp = EXPECTED[g]((o+1)*DOWN_WIDTH_SR-1, o*DOWN_WIDTH_SR);
+			ap_uint<DOWN_WIDTH_SR> const act = out_down.read();
+			if (exp != act) {
+				cout << "ERROR: narrow group " << g << " word " << o << " expected " << hex << exp << " actual " << act << dec << endl;
+				errors++;
+			}
+		}
+		for (unsigned int o = 0; o < GROUP_BITS/UP_WIDTH_SR; o++) {
+			ap_uint<UP_WIDTH_SR> const exp = EXPECTED[g]((o+1)*UP_WIDTH_SR-1, o*UP_WIDTH_SR);
+			ap_uint<UP_WIDTH_SR> const act = out_up.read();
+			if (exp != act) {
+				cout << "ERROR: wide group " << g << " word " << o << " expected " << hex << exp << " actual " << act << dec << endl;
+				errors++;
+			}
+		}
+	}
+
+	if (!in_down.empty() || !in_up.empty() || !out_down.empty() || !out_up.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
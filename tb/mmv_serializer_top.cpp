@@ -0,0 +1,12 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_mmv_serializer.h"
+
+void Testbench_mmv_serializer(stream<MultiChanData<MMV_SR, IN_WIDTH_SR> > & in_down, stream<ap_uint<DOWN_WIDTH_SR> > & out_down,
+	stream<MultiChanData<MMV_SR, IN_WIDTH_SR> > & in_up, stream<ap_uint<UP_WIDTH_SR> > & out_up, unsigned int numReps){
+	MultiChanDataSerialize_Batch<IN_WIDTH_SR, DOWN_WIDTH_SR, CHUNKS_SR, MMV_SR>(in_down, out_down, numReps);
+	MultiChanDataSerialize_Batch<IN_WIDTH_SR, UP_WIDTH_SR, CHUNKS_SR, MMV_SR>(in_up, out_up, numReps);
+}
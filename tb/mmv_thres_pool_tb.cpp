@@ -0,0 +1,182 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file mmv_thres_pool_tb.cpp
+ *
+ *  Testbench for the MMV variants of Thresholding_Batch,
+ *  Thresholding_Stream_Batch and Pool_batch, checked against the
+ *  single-pixel blocks run on the same pixels
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "cycles.hpp"
+#include "data/memdata_thresholds.h"
+#include "data/config_thresholds.h"
+#include "data/config_mmv_thres_pool.h"
+using namespace hls;
+using namespace std;
+
+typedef MultiChanData<MMV_MT, PE_T*INPUT_PRECISION_T> ThrIn_MT;
+typedef MultiChanData<MMV_MT, PE_T*OUTPUT_PRECISION_T> ThrOut_MT;
+typedef MultiChanData<MMV_MT, CHANNELS_MT*PRECISION_MT> Pool_MT;
+
+void Testbench_mmv_thres_pool(stream<ThrIn_MT> & thr_in, stream<ThrOut_MT> & thr_out,
+		stream<ThrIn_MT> & sthr_in, stream<ap_uint<PE_T*NumTH_T*INPUT_PRECISION_T> > & sthr_weights, stream<ThrOut_MT> & sthr_out,
+		stream<ap_uint<CHANNELS_MT*PRECISION_MT> > & pool_in, stream<Pool_MT> & pool_out, unsigned int numReps);
+
+// Splits the single-pixel words of groups of MMV pixels into MMV words, pixel v of a group in lane v
+template<unsigned Words, typename T>
+static void group(stream<T> & in, stream<MultiChanData<MMV_MT, T::width> > & out, unsigned pixels) {
+	static T buf[MMV_MT][Words];
+	for (unsigned p = 0; p < pixels; p += MMV_MT) {
+		for (unsigned v = 0; v < MMV_MT; v++)
+			for (unsigned w = 0; w < Words; w++)
+				buf[v][w] = in.read();
+		for (unsigned w = 0; w < Words; w++) {
+			MultiChanData<MMV_MT, T::width> e;
+			for (unsigned v = 0; v < MMV_MT; v++)
+				e.data[v] = buf[v][w];
+			out.write(e);
+		}
+	}
+}
+
+// Compares the MMV words with the grouped reference
+template<unsigned W>
+static unsigned compare(char const *name, stream<MultiChanData<MMV_MT, W> > & out, stream<MultiChanData<MMV_MT, W> > & ref) {
+	unsigned errors = 0;
+	for (unsigned i = 0; !ref.empty(); i++) {
+		MultiChanData<MMV_MT, W> const e = ref.read();
+		MultiChanData<MMV_MT, W> const o = out.read();
+		for (unsigned v = 0; v < MMV_MT; v++) {
+			if (o.data[v] != e.data[v]) {
+				cout << "ERROR: " << name << " word " << i << " pixel " << v << " expected " << e.data[v] << " got " << o.data[v] << endl;
+				errors++;
+			}
+		}
+	}
+	if (!out.empty()) {
+		cout << "ERROR: " << name << " output stream not empty" << endl;
+		errors++;
+	}
+	return errors;
+}
+
+int main()
+{
+	constexpr unsigned NF = Channels_T / PE_T;
+	constexpr unsigned PoolWords = IFMDIM_MT * IFMDIM_MT * NUM_REPS_MT;
+	static_assert(Pool_MMV_batch_cycles<CHANNELS_MT, CHANNELS_MT, KERNEL_DIM_MT*KERNEL_DIM_MT, MMV_MT>(OFMDIM_MT*OFMDIM_MT/MMV_MT) ==
+		Pool_batch_cycles<CHANNELS_MT, CHANNELS_MT, KERNEL_DIM_MT*KERNEL_DIM_MT>(OFMDIM_MT*OFMDIM_MT) / MMV_MT, "");
+
+	stream<ap_uint<PE_T*INPUT_PRECISION_T> > thr_flat("thr_flat"), thr_flat_copy("thr_flat_copy"), mmv_flat("mmv_flat"), mmv_flat_copy("mmv_flat_copy");
+	stream<ap_uint<PE_T*OUTPUT_PRECISION_T> > thr_ref_flat("thr_ref_flat"), sthr_ref_flat("sthr_ref_flat");
+	stream<ap_uint<PE_T*NumTH_T*INPUT_PRECISION_T> > sthr_weights("sthr_weights"), sthr_ref_weights("sthr_ref_weights");
+	stream<ThrIn_MT> thr_in("thr_in"), sthr_in("sthr_in");
+	stream<ThrOut_MT> thr_out("thr_out"), sthr_out("sthr_out"), thr_ref("thr_ref"), sthr_ref("sthr_ref");
+	stream<ap_uint<CHANNELS_MT*PRECISION_MT> > pool_in("pool_in"), pool_ref_in("pool_ref_in"), windows("windows"), pool_ref_flat("pool_ref_flat");
+	stream<Pool_MT> pool_out("pool_out"), pool_ref("pool_ref");
+
+	srand(1);
+	for (unsigned p = 0; p < IMG_DIM_MT * NUM_REPS_MT; p++) {
+		for (unsigned nf = 0; nf < NF; nf++) {
+			ap_uint<PE_T*INPUT_PRECISION_T> word = 0;
+			ap_uint<PE_T*NumTH_T*INPUT_PRECISION_T> thr = 0;
+			for (unsigned pe = 0; pe < PE_T; pe++) {
+				ap_int<INPUT_PRECISION_T> v = (ap_int<INPUT_PRECISION_T>)rand();
+				if (p % 4 == 0)
+					v = PARAM_THRESHOLDS::threshs.m_thresholds[pe][nf][p % NumTH_T];
+				word((pe+1)*INPUT_PRECISION_T-1, pe*INPUT_PRECISION_T) = ap_uint<INPUT_PRECISION_T>(v);
+				for (unsigned t = 0; t < NumTH_T; t++) {
+					unsigned const lane = pe*NumTH_T + t;
+					thr((lane+1)*INPUT_PRECISION_T-1, lane*INPUT_PRECISION_T) = ap_uint<INPUT_PRECISION_T>(PARAM_THRESHOLDS::threshs.m_thresholds[pe][nf][t]);
+				}
+			}
+			thr_flat.write(word);
+			thr_flat_copy.write(word);
+			mmv_flat.write(word);
+			mmv_flat_copy.write(word);
+			// the single-pixel block reads the thresholds for every pixel, the MMV one for every group
+			sthr_ref_weights.write(thr);
+			if (p % MMV_MT == 0)
+				sthr_weights.write(thr);
+		}
+	}
+	for (unsigned i = 0; i < PoolWords; i++) {
+		ap_uint<CHANNELS_MT*PRECISION_MT> const word = rand();
+		pool_in.write(word);
+		pool_ref_in.write(word);
+	}
+
+	// Single-pixel references
+	Thresholding_Batch<IMG_DIM_MT, Channels_T, PE_T, Slice<ap_int<INPUT_PRECISION_T> >, Slice<ap_uint<OUTPUT_PRECISION_T> > >
+		(thr_flat, thr_ref_flat, PARAM_THRESHOLDS::threshs, NUM_REPS_MT);
+	Thresholding_Stream_Batch<IMG_DIM_MT, Channels_T, PE_T, Slice<ap_int<INPUT_PRECISION_T> >, Slice<ap_uint<OUTPUT_PRECISION_T> >, 0, ap_int<INPUT_PRECISION_T>, NumTH_T>
+		(thr_flat_copy, sthr_ref_flat, sthr_ref_weights, NUM_REPS_MT);
+	ConvolutionInputGenerator<KERNEL_DIM_MT, CHANNELS_MT, PRECISION_MT, IFMDIM_MT, OFMDIM_MT, CHANNELS_MT, STRIDE_MT>
+		(pool_ref_in, windows, NUM_REPS_MT, ap_resource_dflt());
+	Pool_batch<CHANNELS_MT, CHANNELS_MT, KERNEL_DIM_MT*KERNEL_DIM_MT, Slice<ap_uint<PRECISION_MT> >, Slice<ap_uint<PRECISION_MT> > >
+		(windows, pool_ref_flat, MaxPoolFunction<ap_uint<PRECISION_MT>, KERNEL_DIM_MT>(), OFMDIM_MT*OFMDIM_MT*NUM_REPS_MT);
+	group<NF>(thr_ref_flat, thr_ref, IMG_DIM_MT * NUM_REPS_MT);
+	group<NF>(sthr_ref_flat, sthr_ref, IMG_DIM_MT * NUM_REPS_MT);
+	group<1>(pool_ref_flat, pool_ref, OFMDIM_MT * OFMDIM_MT * NUM_REPS_MT);
+
+	// The MMV inputs, grouped from copies of the single-pixel inputs
+	group<NF>(mmv_flat, thr_in, IMG_DIM_MT * NUM_REPS_MT);
+	group<NF>(mmv_flat_copy, sthr_in, IMG_DIM_MT * NUM_REPS_MT);
+
+	Testbench_mmv_thres_pool(thr_in, thr_out, sthr_in, sthr_weights, sthr_out, pool_in, pool_out, NUM_REPS_MT);
+
+	unsigned errors = 0;
+	errors += compare("Thresholding_MMV_Batch", thr_out, thr_ref);
+	errors += compare("Thresholding_Stream_MMV_Batch", sthr_out, sthr_ref);
+	errors += compare("Pool_MMV_batch", pool_out, pool_ref);
+
+	if (!thr_in.empty() || !sthr_in.empty() || !sthr_weights.empty() || !pool_in.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,36 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_thresholds.h"
+#include "data/config_thresholds.h"
+#include "data/config_mmv_thres_pool.h"
+
+typedef MultiChanData<MMV_MT, PE_T*INPUT_PRECISION_T> ThrIn_MT;
+typedef MultiChanData<MMV_MT, PE_T*OUTPUT_PRECISION_T> ThrOut_MT;
+typedef MultiChanData<MMV_MT, CHANNELS_MT*PRECISION_MT> Pool_MT;
+
+void Testbench_mmv_thres_pool(stream<ThrIn_MT> & thr_in, stream<ThrOut_MT> & thr_out,
+		stream<ThrIn_MT> & sthr_in, stream<ap_uint<PE_T*NumTH_T*INPUT_PRECISION_T> > & sthr_weights, stream<ThrOut_MT> & sthr_out,
+		stream<ap_uint<CHANNELS_MT*PRECISION_MT> > & pool_in, stream<Pool_MT> & pool_out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+#pragma HLS ARRAY_PARTITION variable=PARAM_THRESHOLDS::threshs.m_thresholds complete dim=1
+#pragma HLS ARRAY_PARTITION variable=PARAM_THRESHOLDS::threshs.m_thresholds complete dim=3
+	Thresholding_MMV_Batch<IMG_DIM_MT, Channels_T, PE_T, MMV_MT,
+		Slice_mmv<ap_int<INPUT_PRECISION_T>, MMV_MT>, Slice_mmv<ap_uint<OUTPUT_PRECISION_T>, MMV_MT> >
+		(thr_in, thr_out, PARAM_THRESHOLDS::threshs, numReps);
+	Thresholding_Stream_MMV_Batch<IMG_DIM_MT, Channels_T, PE_T, MMV_MT,
+		Slice_mmv<ap_int<INPUT_PRECISION_T>, MMV_MT>, Slice_mmv<ap_uint<OUTPUT_PRECISION_T>, MMV_MT>, 0, ap_int<INPUT_PRECISION_T>, NumTH_T>
+		(sthr_in, sthr_out, sthr_weights, numReps);
+
+	stream<Pool_MT> windows("windows");
+	ConvolutionInputGenerator_MMV<KERNEL_DIM_MT, CHANNELS_MT, PRECISION_MT, IFMDIM_MT, OFMDIM_MT, CHANNELS_MT, STRIDE_MT, MMV_MT>
+		(pool_in, windows, numReps, ap_resource_dflt());
+	Pool_MMV_batch<CHANNELS_MT, CHANNELS_MT, KERNEL_DIM_MT*KERNEL_DIM_MT, MMV_MT,
+		Slice_mmv<ap_uint<PRECISION_MT>, MMV_MT>, Slice_mmv<ap_uint<PRECISION_MT>, MMV_MT> >
+		(windows, pool_out, MaxPoolFunction<ap_uint<PRECISION_MT>, KERNEL_DIM_MT>(), OFMDIM_MT*OFMDIM_MT/MMV_MT*numReps);
+}
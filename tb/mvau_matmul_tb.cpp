@@ -0,0 +1,127 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file mvau_matmul_tb.cpp
+ *
+ *  Testbench for the matrix matrix activation with two streamed operands
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/mvau_matmul_config.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+using namespace hls;
+using namespace std;
+
+void Testbench_mvau_matmul(stream<ap_uint<SIMD_MM*INPUT_PRECISION_MM> > & in, stream<ap_uint<PE_MM*SIMD_MM*WIDTH_MM> > & operand,
+	stream<ap_uint<PE_MM*ACTIVATION_PRECISION_MM> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned SF = MatrixW_MM / SIMD_MM;
+	constexpr unsigned NF = MatrixH_MM / PE_MM;
+	static ap_int<INPUT_PRECISION_MM> A[NUM_REPEAT][NumVectors_MM][MatrixW_MM];
+	static ap_int<WIDTH_MM> B[NUM_REPEAT][MatrixH_MM][MatrixW_MM];
+	stream<ap_uint<SIMD_MM*INPUT_PRECISION_MM> > input_stream("input_stream");
+	stream<ap_uint<PE_MM*SIMD_MM*WIDTH_MM> > operand_stream("operand_stream");
+	stream<ap_uint<PE_MM*ACTIVATION_PRECISION_MM> > output_stream("output_stream");
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		// a new operand matrix for every frame
+		for (unsigned int row = 0; row < MatrixH_MM; row++)
+			for (unsigned int col = 0; col < MatrixW_MM; col++)
+				B[rep][row][col] = (ap_int<WIDTH_MM>)rand();
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			for (unsigned int sf = 0; sf < SF; sf++) {
+				ap_uint<PE_MM*SIMD_MM*WIDTH_MM> operand_word;
+				for (unsigned int pe = 0; pe < PE_MM; pe++)
+					for (unsigned int simd = 0; simd < SIMD_MM; simd++)
+						operand_word((pe*SIMD_MM + simd + 1)*WIDTH_MM-1, (pe*SIMD_MM + simd)*WIDTH_MM) = B[rep][nf*PE_MM + pe][sf*SIMD_MM + simd];
+				operand_stream.write(operand_word);
+			}
+		}
+		for (unsigned int v = 0; v < NumVectors_MM; v++) {
+			for (unsigned int sf = 0; sf < SF; sf++) {
+				ap_uint<SIMD_MM*INPUT_PRECISION_MM> input_word;
+				for (unsigned int simd = 0; simd < SIMD_MM; simd++) {
+					ap_int<INPUT_PRECISION_MM> input = (ap_int<INPUT_PRECISION_MM>)rand();
+					A[rep][v][sf*SIMD_MM + simd] = input;
+					input_word((simd+1)*INPUT_PRECISION_MM-1, simd*INPUT_PRECISION_MM) = input;
+				}
+				input_stream.write(input_word);
+			}
+		}
+	}
+
+	Testbench_mvau_matmul(input_stream, operand_stream, output_stream, NUM_REPEAT);
+
+	int err_counter = 0;
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int v = 0; v < NumVectors_MM; v++) {
+			for (unsigned int nf = 0; nf < NF; nf++) {
+				ap_uint<PE_MM*ACTIVATION_PRECISION_MM> outElem = output_stream.read();
+				for (unsigned int pe = 0; pe < PE_MM; pe++) {
+					int exp = 0;
+					for (unsigned int col = 0; col < MatrixW_MM; col++)
+						exp += B[rep][nf*PE_MM + pe][col] * A[rep][v][col];
+					ap_int<ACTIVATION_PRECISION_MM> const EXP = exp;
+					ap_int<ACTIVATION_PRECISION_MM> out_chan;
+					out_chan(ACTIVATION_PRECISION_MM-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_MM-1, pe*ACTIVATION_PRECISION_MM);
+					if (EXP != out_chan) {
+						std::cout << "ERROR: Rep " << rep << " Vector " << v << " Expected[" << nf*PE_MM + pe << "]=" << EXP << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (!input_stream.empty() || !operand_stream.empty() || !output_stream.empty()) {
+		std::cout << "ERROR: Streams not drained" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
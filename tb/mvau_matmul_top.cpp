@@ -0,0 +1,15 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/mvau_matmul_config.h"
+
+void Testbench_mvau_matmul(stream<ap_uint<SIMD_MM*INPUT_PRECISION_MM> > & in, stream<ap_uint<PE_MM*SIMD_MM*WIDTH_MM> > & operand,
+	stream<ap_uint<PE_MM*ACTIVATION_PRECISION_MM> > & out, unsigned int numReps){
+	Matrix_Matrix_Activate_Stream_Batch<MatrixW_MM, MatrixH_MM, NumVectors_MM, SIMD_MM, PE_MM, Slice<ap_int<INPUT_PRECISION_MM> >, Slice<ap_int<ACTIVATION_PRECISION_MM> >, Identity, ap_int<WIDTH_MM> >
+		(in, out, operand, PassThroughActivation<ap_int<ACTIVATION_PRECISION_MM>>(), numReps, ap_resource_dsp());
+}
@@ -0,0 +1,140 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file mvau_reload_tb.cpp
+ *
+ *  Testbench for the matrix vector activation with runtime-reloadable weights
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/mvau_reload_config.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+using namespace hls;
+using namespace std;
+
+void Testbench_mvau_reload(stream<ap_uint<SIMD_R*INPUT_PRECISION_R> > & in, stream<ap_uint<PE_R*SIMD_R*WIDTH_R> > & load,
+	stream<ap_uint<PE_R*ACTIVATION_PRECISION_R> > & out, unsigned int numReps);
+
+constexpr unsigned SF = MatrixW_R / SIMD_R;
+constexpr unsigned NF = MatrixH_R / PE_R;
+#define NUM_MODELS 3
+
+static ap_int<WIDTH_R> W[NUM_MODELS+1][MatrixH_R][MatrixW_R];
+static ap_uint<INPUT_PRECISION_R> IMAGE[MatrixW_R];
+
+void stream_weights(unsigned int model, stream<ap_uint<PE_R*SIMD_R*WIDTH_R> > & load) {
+	for (unsigned int nf = 0; nf < NF; nf++) {
+		for (unsigned int sf = 0; sf < SF; sf++) {
+			ap_uint<PE_R*SIMD_R*WIDTH_R> weight_word;
+			for (unsigned int pe = 0; pe < PE_R; pe++)
+				for (unsigned int simd = 0; simd < SIMD_R; simd++)
+					weight_word((pe*SIMD_R + simd + 1)*WIDTH_R-1, (pe*SIMD_R + simd)*WIDTH_R) = W[model][nf*PE_R + pe][sf*SIMD_R + simd];
+			load.write(weight_word);
+		}
+	}
+}
+
+void stream_image(stream<ap_uint<SIMD_R*INPUT_PRECISION_R> > & in) {
+	for (unsigned int sf = 0; sf < SF; sf++) {
+		ap_uint<SIMD_R*INPUT_PRECISION_R> input_word;
+		for (unsigned int simd = 0; simd < SIMD_R; simd++) {
+			ap_uint<INPUT_PRECISION_R> input = (ap_uint<INPUT_PRECISION_R>)rand();
+			IMAGE[sf*SIMD_R + simd] = input;
+			input_word((simd+1)*INPUT_PRECISION_R-1, simd*INPUT_PRECISION_R) = input;
+		}
+		in.write(input_word);
+	}
+}
+
+int check_image(unsigned int model, stream<ap_uint<PE_R*ACTIVATION_PRECISION_R> > & out) {
+	int err_counter = 0;
+	for (unsigned int nf = 0; nf < NF; nf++) {
+		ap_uint<PE_R*ACTIVATION_PRECISION_R> outElem = out.read();
+		for (unsigned int pe = 0; pe < PE_R; pe++) {
+			int exp = 0;
+			for (unsigned int col = 0; col < MatrixW_R; col++)
+				exp += W[model][nf*PE_R + pe][col] * IMAGE[col];
+			ap_int<ACTIVATION_PRECISION_R> const EXP = exp;
+			ap_int<ACTIVATION_PRECISION_R> out_chan;
+			out_chan(ACTIVATION_PRECISION_R-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_R-1, pe*ACTIVATION_PRECISION_R);
+			if (EXP != out_chan) {
+				std::cout << "ERROR: Model " << model << " Expected[" << nf*PE_R + pe << "]=" << EXP << " actual " << out_chan << std::endl;
+				err_counter++;
+			}
+		}
+	}
+	return err_counter;
+}
+
+int main()
+{
+	stream<ap_uint<SIMD_R*INPUT_PRECISION_R> > input_stream("input_stream");
+	stream<ap_uint<PE_R*SIMD_R*WIDTH_R> > load_stream("load_stream");
+	stream<ap_uint<PE_R*ACTIVATION_PRECISION_R> > output_stream("output_stream");
+
+	// model 0 is the initial (all-zero) content of the weight banks
+	for (unsigned int model = 1; model <= NUM_MODELS; model++)
+		for (unsigned int row = 0; row < MatrixH_R; row++)
+			for (unsigned int col = 0; col < MatrixW_R; col++)
+				W[model][row][col] = (ap_int<WIDTH_R>)rand();
+
+	int err_counter = 0;
+	// every frame computes on the current model while loading the next one
+	for (unsigned int model = 0; model <= NUM_MODELS; model++) {
+		if (model < NUM_MODELS)
+			stream_weights(model+1, load_stream);
+		stream_image(input_stream);
+		Testbench_mvau_reload(input_stream, load_stream, output_stream, 1);
+		err_counter += check_image(model, output_stream);
+	}
+	if (!load_stream.empty() || !output_stream.empty()) {
+		std::cout << "ERROR: Streams not drained" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
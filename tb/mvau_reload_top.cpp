@@ -0,0 +1,19 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/mvau_reload_config.h"
+
+void Testbench_mvau_reload(stream<ap_uint<SIMD_R*INPUT_PRECISION_R> > & in, stream<ap_uint<PE_R*SIMD_R*WIDTH_R> > & load,
+	stream<ap_uint<PE_R*ACTIVATION_PRECISION_R> > & out, unsigned int numReps){
+	static ReloadableFixedPointWeights<SIMD_R, ap_int<WIDTH_R>, PE_R, TILES_R> weights;
+#pragma HLS ARRAY_PARTITION variable=weights.m_weights complete dim=1
+#pragma HLS ARRAY_PARTITION variable=weights.m_weights complete dim=2
+	Matrix_Vector_Activate_Reload_Batch<MatrixW_R, MatrixH_R, SIMD_R, PE_R, 1, Slice<ap_uint<INPUT_PRECISION_R> >, Slice<ap_int<ACTIVATION_PRECISION_R> >, Identity>
+		(in, out, load, weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_R>>(), numReps, 1, ap_resource_dsp());
+}
@@ -0,0 +1,127 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file mvau_splitk_tb.cpp
+ *
+ *  Testbench for the partial-sum (split-K) matrix vector activation
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/mvau_splitk_config.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+using namespace hls;
+using namespace std;
+
+void Testbench_mvau_splitk(stream<ap_uint<SIMD_K*INPUT_PRECISION_K> > & in, stream<ap_uint<PE_K*SIMD_K*WIDTH_K> > (&weights)[PARTS_K],
+	stream<ap_uint<PE_K*ACTIVATION_PRECISION_K> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned SF = MatrixW_K / SIMD_K;
+	constexpr unsigned SF_PART = SF / PARTS_K;
+	constexpr unsigned NF = MatrixH_K / PE_K;
+	static ap_uint<INPUT_PRECISION_K> IMAGE[NUM_REPEAT][MatrixW_K];
+	static ap_int<WIDTH_K> W[MatrixH_K][MatrixW_K];
+	stream<ap_uint<SIMD_K*INPUT_PRECISION_K> > input_stream("input_stream");
+	stream<ap_uint<PE_K*SIMD_K*WIDTH_K> > weight_streams[PARTS_K];
+	stream<ap_uint<PE_K*ACTIVATION_PRECISION_K> > output_stream("output_stream");
+
+	for (unsigned int row = 0; row < MatrixH_K; row++)
+		for (unsigned int col = 0; col < MatrixW_K; col++)
+			W[row][col] = (ap_int<WIDTH_K>)rand();
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF; sf++) {
+			ap_uint<SIMD_K*INPUT_PRECISION_K> input_word;
+			for (unsigned int simd = 0; simd < SIMD_K; simd++) {
+				ap_uint<INPUT_PRECISION_K> input = (ap_uint<INPUT_PRECISION_K>)rand();
+				IMAGE[rep][sf*SIMD_K + simd] = input;
+				input_word((simd+1)*INPUT_PRECISION_K-1, simd*INPUT_PRECISION_K) = input;
+			}
+			input_stream.write(input_word);
+		}
+		// every part streams the weights of its column slice
+		for (unsigned int part = 0; part < PARTS_K; part++) {
+			for (unsigned int nf = 0; nf < NF; nf++) {
+				for (unsigned int sf = 0; sf < SF_PART; sf++) {
+					ap_uint<PE_K*SIMD_K*WIDTH_K> weight_word;
+					for (unsigned int pe = 0; pe < PE_K; pe++)
+						for (unsigned int simd = 0; simd < SIMD_K; simd++)
+							weight_word((pe*SIMD_K + simd + 1)*WIDTH_K-1, (pe*SIMD_K + simd)*WIDTH_K) = W[nf*PE_K + pe][(part*SF_PART + sf)*SIMD_K + simd];
+					weight_streams[part].write(weight_word);
+				}
+			}
+		}
+	}
+
+	Testbench_mvau_splitk(input_stream, weight_streams, output_stream, NUM_REPEAT);
+
+	int err_counter = 0;
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_K*ACTIVATION_PRECISION_K> outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_K; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_K; col++)
+					exp += W[nf*PE_K + pe][col] * IMAGE[rep][col];
+				ap_int<ACTIVATION_PRECISION_K> const EXP = exp;
+				ap_int<ACTIVATION_PRECISION_K> out_chan;
+				out_chan(ACTIVATION_PRECISION_K-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_K-1, pe*ACTIVATION_PRECISION_K);
+				if (EXP != out_chan) {
+					std::cout << "ERROR: Rep " << rep << " Expected[" << nf*PE_K + pe << "]=" << EXP << " actual " << out_chan << std::endl;
+					err_counter++;
+				}
+			}
+		}
+	}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
@@ -0,0 +1,26 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/mvau_splitk_config.h"
+
+void Testbench_mvau_splitk(stream<ap_uint<SIMD_K*INPUT_PRECISION_K> > & in, stream<ap_uint<PE_K*SIMD_K*WIDTH_K> > (&weights)[PARTS_K],
+	stream<ap_uint<PE_K*ACTIVATION_PRECISION_K> > & out, unsigned int numReps){
+#pragma HLS DATAFLOW
+	hls::stream<ap_uint<SIMD_K*INPUT_PRECISION_K> > slices[PARTS_K];
+	hls::stream<ap_uint<PE_K*ACTIVATION_PRECISION_K> > partials[PARTS_K];
+
+	Matrix_Vector_Split_Batch<MatrixW_K/SIMD_K, PARTS_K>(in, slices, numReps);
+	Matrix_Vector_Activate_Stream_Batch<MatrixW_K/PARTS_K, MatrixH_K, SIMD_K, PE_K, Slice<ap_uint<INPUT_PRECISION_K> >, Slice<ap_int<ACTIVATION_PRECISION_K> >, Identity, ap_int<WIDTH_K> >
+		(slices[0], partials[0], weights[0], PassThroughActivation<ap_int<ACTIVATION_PRECISION_K>>(), numReps, ap_resource_dsp());
+	Matrix_Vector_Activate_Stream_Batch<MatrixW_K/PARTS_K, MatrixH_K, SIMD_K, PE_K, Slice<ap_uint<INPUT_PRECISION_K> >, Slice<ap_int<ACTIVATION_PRECISION_K> >, Identity, ap_int<WIDTH_K> >
+		(slices[1], partials[1], weights[1], PassThroughActivation<ap_int<ACTIVATION_PRECISION_K>>(), numReps, ap_resource_dsp());
+	Matrix_Vector_Activate_Stream_Batch<MatrixW_K/PARTS_K, MatrixH_K, SIMD_K, PE_K, Slice<ap_uint<INPUT_PRECISION_K> >, Slice<ap_int<ACTIVATION_PRECISION_K> >, Identity, ap_int<WIDTH_K> >
+		(slices[2], partials[2], weights[2], PassThroughActivation<ap_int<ACTIVATION_PRECISION_K>>(), numReps, ap_resource_dsp());
+	Matrix_Vector_Reduce_Batch<MatrixH_K, PE_K, 1, PARTS_K, Slice<ap_int<ACTIVATION_PRECISION_K> >, Slice<ap_int<ACTIVATION_PRECISION_K> > >
+		(partials, out, PassThroughActivation<ap_int<ACTIVATION_PRECISION_K>>(), numReps);
+}
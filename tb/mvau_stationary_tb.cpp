@@ -0,0 +1,127 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file mvau_stationary_tb.cpp
+ *
+ *  Testbench for the weight-stationary matrix vector activation with streaming weights
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/mvau_stationary_config.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+using namespace hls;
+using namespace std;
+
+void Testbench_mvau_stationary(stream<ap_uint<SIMD_B*INPUT_PRECISION_B> > & in, stream<ap_uint<PE_B*SIMD_B*WIDTH_B> > & weights,
+	stream<ap_uint<PE_B*ACTIVATION_PRECISION_B> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned SF = MatrixW_B / SIMD_B;
+	constexpr unsigned NF = MatrixH_B / PE_B;
+	constexpr unsigned NUM_BATCHES = (NUM_REPEAT + BATCH_B - 1) / BATCH_B;
+	static ap_uint<INPUT_PRECISION_B> IMAGE[NUM_REPEAT][MatrixW_B];
+	static ap_int<WIDTH_B> W[MatrixH_B][MatrixW_B];
+	stream<ap_uint<SIMD_B*INPUT_PRECISION_B> > input_stream("input_stream");
+	stream<ap_uint<PE_B*SIMD_B*WIDTH_B> > weight_stream("weight_stream");
+	stream<ap_uint<PE_B*ACTIVATION_PRECISION_B> > output_stream("output_stream");
+
+	for (unsigned int row = 0; row < MatrixH_B; row++)
+		for (unsigned int col = 0; col < MatrixW_B; col++)
+			W[row][col] = (ap_int<WIDTH_B>)rand();
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF; sf++) {
+			ap_uint<SIMD_B*INPUT_PRECISION_B> input_word;
+			for (unsigned int simd = 0; simd < SIMD_B; simd++) {
+				ap_uint<INPUT_PRECISION_B> input = (ap_uint<INPUT_PRECISION_B>)rand();
+				IMAGE[rep][sf*SIMD_B + simd] = input;
+				input_word((simd+1)*INPUT_PRECISION_B-1, simd*INPUT_PRECISION_B) = input;
+			}
+			input_stream.write(input_word);
+		}
+	}
+	// the weights are only streamed once per batch
+	for (unsigned int batch = 0; batch < NUM_BATCHES; batch++) {
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			for (unsigned int sf = 0; sf < SF; sf++) {
+				ap_uint<PE_B*SIMD_B*WIDTH_B> weight_word;
+				for (unsigned int pe = 0; pe < PE_B; pe++)
+					for (unsigned int simd = 0; simd < SIMD_B; simd++)
+						weight_word((pe*SIMD_B + simd + 1)*WIDTH_B-1, (pe*SIMD_B + simd)*WIDTH_B) = W[nf*PE_B + pe][sf*SIMD_B + simd];
+				weight_stream.write(weight_word);
+			}
+		}
+	}
+
+	Testbench_mvau_stationary(input_stream, weight_stream, output_stream, NUM_REPEAT);
+
+	int err_counter = 0;
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_B*ACTIVATION_PRECISION_B> outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_B; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_B; col++)
+					exp += W[nf*PE_B + pe][col] * IMAGE[rep][col];
+				ap_int<ACTIVATION_PRECISION_B> const EXP = exp;
+				ap_int<ACTIVATION_PRECISION_B> out_chan;
+				out_chan(ACTIVATION_PRECISION_B-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_B-1, pe*ACTIVATION_PRECISION_B);
+				if (EXP != out_chan) {
+					std::cout << "ERROR: Rep " << rep << " Expected[" << nf*PE_B + pe << "]=" << EXP << " actual " << out_chan << std::endl;
+					err_counter++;
+				}
+			}
+		}
+	}
+	if (!weight_stream.empty() || !output_stream.empty()) {
+		std::cout << "ERROR: Streams not drained" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
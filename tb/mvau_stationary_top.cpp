@@ -0,0 +1,15 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/mvau_stationary_config.h"
+
+void Testbench_mvau_stationary(stream<ap_uint<SIMD_B*INPUT_PRECISION_B> > & in, stream<ap_uint<PE_B*SIMD_B*WIDTH_B> > & weights,
+	stream<ap_uint<PE_B*ACTIVATION_PRECISION_B> > & out, unsigned int numReps){
+	Matrix_Vector_Activate_Stream_Stationary_Batch<MatrixW_B, MatrixH_B, SIMD_B, PE_B, BATCH_B, Slice<ap_uint<INPUT_PRECISION_B> >, Slice<ap_int<ACTIVATION_PRECISION_B> >, Identity, ap_int<WIDTH_B> >
+		(in, out, weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_B>>(), numReps, ap_resource_dsp());
+}
@@ -0,0 +1,132 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file mvau_stream_mmv_tb.cpp
+ *
+ *  Testbench for the MMV matrix vector activation HLS block with streaming weights
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/mvau_stream_mmv_config.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "csim_bench.hpp"
+using namespace hls;
+using namespace std;
+
+void Testbench_mvau_stream_mmv(stream<MultiChanData<MMV_M, SIMD_M*INPUT_PRECISION_M> > & in, stream<ap_uint<PE_M*SIMD_M*WIDTH_M> > & weights,
+	stream<MultiChanData<MMV_M, PE_M*ACTIVATION_PRECISION_M> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned SF = MatrixW_M / SIMD_M;
+	constexpr unsigned NF = MatrixH_M / PE_M;
+	static ap_uint<INPUT_PRECISION_M> IMAGE[NUM_REPEAT][MMV_M][MatrixW_M];
+	static ap_int<WIDTH_M> W[MatrixH_M][MatrixW_M];
+	stream<MultiChanData<MMV_M, SIMD_M*INPUT_PRECISION_M> > input_stream("input_stream");
+	stream<ap_uint<PE_M*SIMD_M*WIDTH_M> > weight_stream("weight_stream");
+	stream<MultiChanData<MMV_M, PE_M*ACTIVATION_PRECISION_M> > output_stream("output_stream");
+
+	for (unsigned int row = 0; row < MatrixH_M; row++)
+		for (unsigned int col = 0; col < MatrixW_M; col++)
+			W[row][col] = (ap_int<WIDTH_M>)rand();
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF; sf++) {
+			MultiChanData<MMV_M, SIMD_M*INPUT_PRECISION_M> input_word;
+			for (unsigned int mmv = 0; mmv < MMV_M; mmv++) {
+				for (unsigned int simd = 0; simd < SIMD_M; simd++) {
+					ap_uint<INPUT_PRECISION_M> input = (ap_uint<INPUT_PRECISION_M>)rand();
+					IMAGE[rep][mmv][sf*SIMD_M + simd] = input;
+					input_word.data[mmv]((simd+1)*INPUT_PRECISION_M-1, simd*INPUT_PRECISION_M) = input;
+				}
+			}
+			input_stream.write(input_word);
+		}
+		// a single weight word per tile serves all MMV pixels
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			for (unsigned int sf = 0; sf < SF; sf++) {
+				ap_uint<PE_M*SIMD_M*WIDTH_M> weight_word;
+				for (unsigned int pe = 0; pe < PE_M; pe++)
+					for (unsigned int simd = 0; simd < SIMD_M; simd++)
+						weight_word((pe*SIMD_M + simd + 1)*WIDTH_M-1, (pe*SIMD_M + simd)*WIDTH_M) = W[nf*PE_M + pe][sf*SIMD_M + simd];
+				weight_stream.write(weight_word);
+			}
+		}
+	}
+
+	{
+		CsimBench const  bench("MVAU", NUM_REPEAT, input_stream.size());
+		Testbench_mvau_stream_mmv(input_stream, weight_stream, output_stream, NUM_REPEAT);
+	}
+
+	int err_counter = 0;
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			MultiChanData<MMV_M, PE_M*ACTIVATION_PRECISION_M> outElem = output_stream.read();
+			for (unsigned int mmv = 0; mmv < MMV_M; mmv++) {
+				for (unsigned int pe = 0; pe < PE_M; pe++) {
+					int exp = 0;
+					for (unsigned int col = 0; col < MatrixW_M; col++)
+						exp += W[nf*PE_M + pe][col] * IMAGE[rep][mmv][col];
+					ap_int<ACTIVATION_PRECISION_M> const EXP = exp;
+					ap_int<ACTIVATION_PRECISION_M> out_chan;
+					out_chan(ACTIVATION_PRECISION_M-1, 0) = outElem.data[mmv]((pe+1)*ACTIVATION_PRECISION_M-1, pe*ACTIVATION_PRECISION_M);
+					if (EXP != out_chan) {
+						std::cout << "ERROR: Rep " << rep << " MMV " << mmv << " Expected[" << nf*PE_M + pe << "]=" << EXP << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (!weight_stream.empty() || !output_stream.empty()) {
+		std::cout << "ERROR: Streams not drained" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
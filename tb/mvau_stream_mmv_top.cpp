@@ -0,0 +1,15 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/mvau_stream_mmv_config.h"
+
+void Testbench_mvau_stream_mmv(stream<MultiChanData<MMV_M, SIMD_M*INPUT_PRECISION_M> > & in, stream<ap_uint<PE_M*SIMD_M*WIDTH_M> > & weights,
+	stream<MultiChanData<MMV_M, PE_M*ACTIVATION_PRECISION_M> > & out, unsigned int numReps){
+	Matrix_Vector_Activate_Stream_Batch<MatrixW_M, MatrixH_M, SIMD_M, PE_M, MMV_M, Slice_mmv<ap_uint<INPUT_PRECISION_M>, MMV_M>, Slice_mmv<ap_int<ACTIVATION_PRECISION_M>, MMV_M>, Identity, ap_int<WIDTH_M> >
+		(in, out, weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_M>>(), numReps, ap_resource_dsp());
+}
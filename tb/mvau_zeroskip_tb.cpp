@@ -0,0 +1,143 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file mvau_zeroskip_tb.cpp
+ *
+ *  Testbench for the zero-run-length stream encoder and decoder and for the
+ *  matrix vector activation skipping all-zero input words
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_mvau_zeroskip.h"
+#include "data/config_mvau_zeroskip.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 20
+#define SF_ZS (MatrixW_ZS/SIMD_ZS)
+#define IN_WIDTH_ZS (SIMD_ZS*INPUT_PRECISION_ZS)
+typedef ZeroRunToken<IN_WIDTH_ZS, SF_ZS> Token;
+typedef Token::type token_t;
+
+void Testbench_mvau_zeroskip(stream<ap_uint<IN_WIDTH_ZS> > & in_enc, stream<token_t> & out_enc,
+	stream<token_t> & in_dec, stream<ap_uint<IN_WIDTH_ZS> > & out_dec,
+	stream<token_t> & in_mvau, stream<ap_uint<PE_ZS*ACTIVATION_PRECISION_ZS> > & out_mvau, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<INPUT_PRECISION_ZS> IMAGE[NUM_REPEAT][MatrixW_ZS];
+	static ap_uint<IN_WIDTH_ZS> WORDS[NUM_REPEAT][SF_ZS];
+	vector<token_t> tokens;
+	stream<ap_uint<IN_WIDTH_ZS> > in_enc("in_enc"), out_dec("out_dec");
+	stream<token_t> out_enc("out_enc"), in_dec("in_dec"), in_mvau("in_mvau");
+	stream<ap_uint<PE_ZS*ACTIVATION_PRECISION_ZS> > out_mvau("out_mvau");
+	unsigned int errors = 0;
+
+	// mostly zero words, the density growing over the images, the first one being all zero
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		unsigned int run = 0;
+		for (unsigned int sf = 0; sf < SF_ZS; sf++) {
+			bool const nz = (rep > 0) && (unsigned(rand() % NUM_REPEAT) < rep);
+			ap_uint<IN_WIDTH_ZS> word = 0;
+			for (unsigned int simd = 0; simd < SIMD_ZS; simd++) {
+				ap_uint<INPUT_PRECISION_ZS> const act = nz? rand() : 0;
+				IMAGE[rep][sf*SIMD_ZS + simd] = act;
+				word((simd+1)*INPUT_PRECISION_ZS-1, simd*INPUT_PRECISION_ZS) = act;
+			}
+			WORDS[rep][sf] = word;
+			in_enc.write(word);
+			bool const last = (sf == SF_ZS-1);
+			if ((word != 0) || last) {
+				tokens.push_back(Token::pack(word, run, last));
+				run = 0;
+			}
+			else
+				run++;
+		}
+	}
+	for (token_t const &t : tokens) {
+		in_dec.write(t);
+		in_mvau.write(t);
+	}
+
+	Testbench_mvau_zeroskip(in_enc, out_enc, in_dec, out_dec, in_mvau, out_mvau, NUM_REPEAT);
+
+	for (unsigned int i = 0; i < tokens.size(); i++) {
+		token_t const value = out_enc.read();
+		if (value != tokens[i]) {
+			cout << "ERROR encoder: token " << i << hex << " expected " << tokens[i] << " value " << value << dec << endl;
+			errors++;
+		}
+	}
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_ZS; sf++) {
+			ap_uint<IN_WIDTH_ZS> const value = out_dec.read();
+			if (value != WORDS[rep][sf]) {
+				cout << "ERROR decoder: rep " << rep << " word " << sf << hex << " expected " << WORDS[rep][sf] << " value " << value << dec << endl;
+				errors++;
+			}
+		}
+		for (unsigned int nf = 0; nf < MatrixH_ZS/PE_ZS; nf++) {
+			ap_uint<PE_ZS*ACTIVATION_PRECISION_ZS> const outElem = out_mvau.read();
+			for (unsigned int pe = 0; pe < PE_ZS; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_ZS; col++)
+					exp += PARAM_MVAU_ZEROSKIP::raw[nf*PE_ZS + pe][col] * IMAGE[rep][col];
+				ap_int<ACTIVATION_PRECISION_ZS> const EXP = exp;
+				ap_int<ACTIVATION_PRECISION_ZS> out_chan;
+				out_chan(ACTIVATION_PRECISION_ZS-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_ZS-1, pe*ACTIVATION_PRECISION_ZS);
+				if (EXP != out_chan) {
+					cout << "ERROR mvau: rep " << rep << " expected[" << nf*PE_ZS + pe << "]=" << EXP << " actual " << out_chan << endl;
+					errors++;
+				}
+			}
+		}
+	}
+	cout << tokens.size() << " tokens for " << NUM_REPEAT*SF_ZS << " words" << endl;
+
+	if (!in_enc.empty() || !out_enc.empty() || !in_dec.empty() || !out_dec.empty() || !in_mvau.empty() || !out_mvau.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
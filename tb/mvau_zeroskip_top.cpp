@@ -0,0 +1,25 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_mvau_zeroskip.h"
+#include "data/config_mvau_zeroskip.h"
+
+#define SF_ZS (MatrixW_ZS/SIMD_ZS)
+#define IN_WIDTH_ZS (SIMD_ZS*INPUT_PRECISION_ZS)
+typedef ZeroRunToken<IN_WIDTH_ZS, SF_ZS>::type token_t;
+
+void Testbench_mvau_zeroskip(stream<ap_uint<IN_WIDTH_ZS> > & in_enc, stream<token_t> & out_enc,
+	stream<token_t> & in_dec, stream<ap_uint<IN_WIDTH_ZS> > & out_dec,
+	stream<token_t> & in_mvau, stream<ap_uint<PE_ZS*ACTIVATION_PRECISION_ZS> > & out_mvau, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	ZeroRunEncode_Batch<IN_WIDTH_ZS, SF_ZS, SF_ZS>(in_enc, out_enc, numReps);
+	ZeroRunDecode_Batch<IN_WIDTH_ZS, SF_ZS, SF_ZS>(in_dec, out_dec, numReps);
+	Matrix_Vector_Activate_ZeroSkip_Batch<MatrixW_ZS, MatrixH_ZS, SIMD_ZS, PE_ZS, Slice<ap_uint<INPUT_PRECISION_ZS> >, Slice<ap_int<ACTIVATION_PRECISION_ZS> >, Identity>
+		(in_mvau, out_mvau, PARAM_MVAU_ZEROSKIP::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_ZS>>(), numReps, ap_resource_dsp());
+}
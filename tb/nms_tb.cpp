@@ -0,0 +1,168 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file nms_tb.cpp
+ *
+ *  Testbench for the non-maximum suppression, checking the detections of
+ *  clustered random boxes against a greedy software NMS
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "ap_fixed.h"
+#include "bnn-library.h"
+
+#include "detection.hpp"
+#include "data/config_nms.h"
+using namespace hls;
+using namespace std;
+
+typedef DetectionBox<ap_uint<SCORE_WIDTH_NM>, ap_uint<COORD_WIDTH_NM> > Box_NM;
+typedef ap_fixed<SCORE_WIDTH_NM, SCORE_INT_BITS_NM> Fixed_NM;
+typedef DetectionBox<Fixed_NM, ap_uint<COORD_WIDTH_NM> > FixedBox_NM;
+
+void Testbench_nms(stream<Box_NM::type> & in, stream<Box_NM::type> & out, unsigned int numReps);
+void Testbench_nms_fixed(stream<FixedBox_NM::type> & in, stream<FixedBox_NM::type> & out, unsigned int numReps);
+
+// scores in units of the lsb of the score type
+struct RefBox {
+	int score;
+	long long c[4];
+	ap_uint<Box_NM::width> word;
+};
+
+// score of the raw score bits, negative ones only for the signed fixed-point scores
+template<typename TS> int score_value(unsigned int raw) {
+	return raw;
+}
+template<> int score_value<Fixed_NM>(unsigned int raw) {
+	return raw >= (1u << (SCORE_WIDTH_NM-1))? int(raw) - (1 << SCORE_WIDTH_NM) : int(raw);
+}
+
+static bool iou_exceeds(RefBox const &a, RefBox const &b) {
+	long long const iw = max(0LL, min(a.c[2], b.c[2]) - max(a.c[0], b.c[0]));
+	long long const ih = max(0LL, min(a.c[3], b.c[3]) - max(a.c[1], b.c[1]));
+	long long const inter = iw * ih;
+	long long const uni = (a.c[2]-a.c[0])*(a.c[3]-a.c[1]) + (b.c[2]-b.c[0])*(b.c[3]-b.c[1]) - inter;
+	return (inter << IOU_BITS_NM) > IOU_THRESHOLD_NM * uni;
+}
+
+template<typename TS, typename Box>
+unsigned int test(void (*top)(stream<typename Box::type> &, stream<typename Box::type> &, unsigned int), char const *name)
+{
+	static_assert(Box::width == Box_NM::width, "Score types of different widths");
+	stream<typename Box::type> input_stream("input_stream");
+	stream<typename Box::type> output_stream("output_stream");
+	vector<vector<typename Box::type> > expected(NUM_REPS_NM);
+	unsigned int const max_coord = (1 << COORD_WIDTH_NM) - 1;
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPS_NM; rep++) {
+		vector<RefBox> boxes;
+		for (unsigned int n = 0; n < NUM_CANDIDATES_NM; n++) {
+			// boxes around a few centres, so that many of them overlap
+			unsigned int const cx = 100 + 250 * (rand() % 3) + rand() % 16;
+			unsigned int const cy = 100 + 250 * (rand() % 2) + rand() % 16;
+			unsigned int const w = 60 + rand() % 30;
+			unsigned int const h = 60 + rand() % 30;
+			RefBox b;
+			unsigned int const raw = rand() % (1 << SCORE_WIDTH_NM);
+			TS score;
+			score.range(SCORE_WIDTH_NM-1, 0) = raw;
+			b.score = score_value<TS>(raw);
+			b.c[0] = cx - w/2;
+			b.c[1] = cy - h/2;
+			b.c[2] = min(cx + w/2, max_coord);
+			b.c[3] = min(cy + h/2, max_coord);
+			b.word = Box::pack(score, b.c[0], b.c[1], b.c[2], b.c[3]);
+			if (Box::score(b.word) != score) {
+				cout << "ERROR: " << name << " score " << raw << " does not round-trip" << endl;
+				errors++;
+			}
+			input_stream.write(b.word);
+			if (b.score > int(SCORE_THRESHOLD_NM)) {
+				boxes.push_back(b);
+			}
+		}
+		stable_sort(boxes.begin(), boxes.end(), [](RefBox const &a, RefBox const &b) { return a.score > b.score; });
+		if (boxes.size() > TOP_N_NM) {
+			boxes.resize(TOP_N_NM);
+		}
+		vector<bool> keep(boxes.size(), true);
+		for (unsigned int i = 0; i < boxes.size(); i++) {
+			if (keep[i]) {
+				expected[rep].push_back(boxes[i].word);
+				for (unsigned int j = i+1; j < boxes.size(); j++) {
+					if (iou_exceeds(boxes[i], boxes[j])) {
+						keep[j] = false;
+					}
+				}
+			}
+		}
+		expected[rep].resize(TOP_N_NM, 0);
+	}
+
+	top(input_stream, output_stream, NUM_REPS_NM);
+
+	for (unsigned int rep = 0; rep < NUM_REPS_NM; rep++) {
+		for (unsigned int o = 0; o < TOP_N_NM; o++) {
+			typename Box::type const value = output_stream.read();
+			if (value != expected[rep][o]) {
+				cout << "ERROR: " << name << " frame " << rep << " detection " << o << hex << " expected " << expected[rep][o] << " value " << value << dec << endl;
+				errors++;
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: " << name << " streams not empty" << endl;
+		errors++;
+	}
+	return errors;
+}
+
+int main()
+{
+	unsigned int const errors = test<ap_uint<SCORE_WIDTH_NM>, Box_NM>(Testbench_nms, "unsigned") +
+		test<Fixed_NM, FixedBox_NM>(Testbench_nms_fixed, "fixed");
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,27 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "ap_fixed.h"
+#include "bnn-library.h"
+
+#include "detection.hpp"
+#include "data/config_nms.h"
+
+typedef DetectionBox<ap_uint<SCORE_WIDTH_NM>, ap_uint<COORD_WIDTH_NM> > Box_NM;
+typedef ap_fixed<SCORE_WIDTH_NM, SCORE_INT_BITS_NM> Fixed_NM;
+typedef DetectionBox<Fixed_NM, ap_uint<COORD_WIDTH_NM> > FixedBox_NM;
+
+void Testbench_nms(stream<Box_NM::type> & in, stream<Box_NM::type> & out, unsigned int numReps)
+{
+	NonMaxSuppression_Batch<NUM_CANDIDATES_NM, TOP_N_NM, PE_NM, ap_uint<SCORE_WIDTH_NM>, ap_uint<COORD_WIDTH_NM>, IOU_BITS_NM>
+		(in, out, SCORE_THRESHOLD_NM, IOU_THRESHOLD_NM, numReps);
+}
+
+// signed fixed-point scores, with the threshold in units of their lsb
+void Testbench_nms_fixed(stream<FixedBox_NM::type> & in, stream<FixedBox_NM::type> & out, unsigned int numReps)
+{
+	Fixed_NM  threshold;
+	threshold.range(SCORE_WIDTH_NM-1, 0) = SCORE_THRESHOLD_NM;
+	NonMaxSuppression_Batch<NUM_CANDIDATES_NM, TOP_N_NM, PE_NM, Fixed_NM, ap_uint<COORD_WIDTH_NM>, IOU_BITS_NM>
+		(in, out, threshold, IOU_THRESHOLD_NM, numReps);
+}
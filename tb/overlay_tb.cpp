@@ -0,0 +1,192 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file overlay_tb.cpp
+ *
+ *  Testbench for the layer-sequential overlay, running a small network of a
+ *  padded 3x3 convolution, a strided 3x3 convolution split into two slices of
+ *  its output channels and a pointwise convolution on a single engine
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "overlay.hpp"
+#include "cycles.hpp"
+#include "data/config_overlay.h"
+using namespace hls;
+using namespace std;
+
+typedef ap_uint<SIMD_OV * ACT_BITS_OV> ActWord_OV;
+typedef ap_uint<PE_OV * SIMD_OV * WGT_BITS_OV> WgtWord_OV;
+
+void Testbench_overlay(OverlayLayer const *layers, unsigned int numLayers, WgtWord_OV const *weights,
+		ActWord_OV const *src, ActWord_OV *dst, unsigned int numReps);
+
+// Feature maps of one frame in HWC order
+typedef vector<int> FM;
+
+struct Layer {
+	unsigned dim, ic, oc, k, s, pad, shift;
+	bool relu;
+	vector<int> w; // oc x (k*k*ic), columns in window order
+};
+
+static FM reference(Layer const &l, FM const &in) {
+	unsigned const P = l.dim + 2*l.pad;
+	unsigned const O = (P - l.k) / l.s + 1;
+	int const lo = l.relu? 0 : -(1 << (ACT_BITS_OV-1));
+	int const hi = (1 << (ACT_BITS_OV-1)) - 1;
+	FM out(O * O * l.oc);
+	for (unsigned oy = 0; oy < O; oy++)
+		for (unsigned ox = 0; ox < O; ox++)
+			for (unsigned o = 0; o < l.oc; o++) {
+				int acc = 0;
+				for (unsigned ky = 0; ky < l.k; ky++)
+					for (unsigned kx = 0; kx < l.k; kx++)
+						for (unsigned c = 0; c < l.ic; c++) {
+							int const y = int(oy * l.s + ky) - int(l.pad);
+							int const x = int(ox * l.s + kx) - int(l.pad);
+							if ((y < 0) || (x < 0) || (y >= int(l.dim)) || (x >= int(l.dim)))  continue;
+							acc += l.w[o * l.k*l.k*l.ic + (ky*l.k + kx)*l.ic + c] * in[(y*l.dim + x)*l.ic + c];
+						}
+				int v = acc >> l.shift;
+				out[(oy*O + ox)*l.oc + o] = v < lo? lo : v > hi? hi : v;
+			}
+	return out;
+}
+
+// Appends the weights of output channels [base, base+oc) to the blob in tile order
+static unsigned pack_weights(Layer const &l, unsigned base, unsigned oc, vector<WgtWord_OV> &blob) {
+	unsigned const ofs = blob.size();
+	unsigned const MW = l.k * l.k * l.ic;
+	for (unsigned nf = 0; nf < oc / PE_OV; nf++)
+		for (unsigned sf = 0; sf < MW / SIMD_OV; sf++) {
+			WgtWord_OV word = 0;
+			for (unsigned pe = 0; pe < PE_OV; pe++)
+				for (unsigned s = 0; s < SIMD_OV; s++) {
+					unsigned const lane = pe * SIMD_OV + s;
+					word((lane+1) * WGT_BITS_OV - 1, lane * WGT_BITS_OV) =
+						ap_int<WGT_BITS_OV>(l.w[(base + nf*PE_OV + pe) * MW + sf*SIMD_OV + s]);
+				}
+			blob.push_back(word);
+		}
+	return ofs;
+}
+
+static void store(FM const &fm, unsigned ofs, vector<ActWord_OV> &mem) {
+	for (unsigned i = 0; i < fm.size(); i++)
+		mem[ofs + i / SIMD_OV]((i % SIMD_OV + 1) * ACT_BITS_OV - 1, (i % SIMD_OV) * ACT_BITS_OV) = ap_int<ACT_BITS_OV>(fm[i]);
+}
+
+static OverlayLayer descriptor(Layer const &l, unsigned oc, unsigned base, unsigned wgt_ofs, unsigned src_ofs, unsigned dst_ofs) {
+	OverlayLayer d;
+	d.ifm_dim = l.dim;  d.ifm_ch = l.ic;  d.ofm_ch = oc;  d.kernel = l.k;  d.stride = l.s;  d.pad = l.pad;
+	d.shift = l.shift;  d.relu = l.relu;  d.wgt_ofs = wgt_ofs;  d.src_ofs = src_ofs;  d.dst_ofs = dst_ofs;
+	d.dst_ch = l.oc;  d.dst_base = base;
+	return d;
+}
+
+int main()
+{
+	Layer net[3] = {
+		{ 6, 4, 8, 3, 1, 1, 3, true,  {} },
+		{ 6, 8, 8, 3, 2, 1, 3, true,  {} },
+		{ 3, 8, 4, 1, 1, 0, 1, false, {} }
+	};
+	unsigned const region[4] = { 0, 1000, 2000, 3000 }; // feature maps in memory
+
+	srand(1);
+	for (Layer &l : net) {
+		l.w.resize(l.oc * l.k*l.k*l.ic);
+		for (int &w : l.w)  w = rand() % ((1 << WGT_BITS_OV) - 1) - ((1 << (WGT_BITS_OV-1)) - 1);
+	}
+
+	// Descriptor table, the second layer computed in two slices of its output channels
+	vector<WgtWord_OV> blob;
+	vector<OverlayLayer> table;
+	table.push_back(descriptor(net[0], 8, 0, pack_weights(net[0], 0, 8, blob), region[0], region[1]));
+	table.push_back(descriptor(net[1], 4, 0, pack_weights(net[1], 0, 4, blob), region[1], region[2]));
+	table.push_back(descriptor(net[1], 4, 4, pack_weights(net[1], 4, 4, blob), region[1], region[2]));
+	table.push_back(descriptor(net[2], 4, 0, pack_weights(net[2], 0, 4, blob), region[2], region[3]));
+	for (OverlayLayer const &d : table) {
+		if (d.tiles<SIMD_OV, PE_OV>() > MAX_TILES_OV) {
+			cout << "ERROR: descriptor exceeds the weight banks" << endl;
+			return 1;
+		}
+	}
+
+	vector<ActWord_OV> mem(4000, 0);
+	vector<FM> expected;
+	for (unsigned f = 0; f < NUM_REPS_OV; f++) {
+		FM fm(net[0].dim * net[0].dim * net[0].ic);
+		for (int &v : fm)  v = rand() % (1 << (ACT_BITS_OV-1));
+		store(fm, region[0] + f * fm.size() / SIMD_OV, mem);
+		for (Layer const &l : net)  fm = reference(l, fm);
+		expected.push_back(fm);
+	}
+
+	Testbench_overlay(table.data(), table.size(), blob.data(), mem.data(), mem.data(), NUM_REPS_OV);
+
+	unsigned errors = 0;
+	for (unsigned f = 0; f < NUM_REPS_OV; f++) {
+		FM const &fm = expected[f];
+		for (unsigned i = 0; i < fm.size(); i++) {
+			unsigned const w = region[3] + (f * fm.size() + i) / SIMD_OV;
+			int const got = ap_int<ACT_BITS_OV>(mem[w]((i % SIMD_OV + 1) * ACT_BITS_OV - 1, (i % SIMD_OV) * ACT_BITS_OV));
+			if (got != fm[i]) {
+				cout << "ERROR: frame " << f << " value " << i << " expected " << fm[i] << " got " << got << endl;
+				errors++;
+			}
+		}
+	}
+
+	cycles_t cycles = 0;
+	for (unsigned i = 0; i < table.size(); i++) {
+		OverlayLayer const &d = table[i];
+		cycles += Overlay_Layer_cycles<SIMD_OV, PE_OV>(d.kernel, d.stride, d.padded_dim(), d.ifm_ch, d.ofm_ch,
+			i + 1 < table.size()? table[i+1].tiles<SIMD_OV, PE_OV>() : 0, NUM_REPS_OV);
+	}
+	cout << "Modelled cycles of the network: " << cycles << endl;
+
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,24 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "overlay.hpp"
+#include "data/config_overlay.h"
+
+typedef ap_uint<SIMD_OV * ACT_BITS_OV> ActWord_OV;
+typedef ap_uint<PE_OV * SIMD_OV * WGT_BITS_OV> WgtWord_OV;
+
+void Testbench_overlay(OverlayLayer const *layers, unsigned int numLayers, WgtWord_OV const *weights,
+		ActWord_OV const *src, ActWord_OV *dst, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi offset=slave port=layers bundle=desc
+#pragma HLS INTERFACE m_axi offset=slave port=weights bundle=wgt
+#pragma HLS INTERFACE m_axi offset=slave port=src bundle=src
+#pragma HLS INTERFACE m_axi offset=slave port=dst bundle=dst
+#pragma HLS INTERFACE s_axilite port=numLayers
+#pragma HLS INTERFACE s_axilite port=numReps
+#pragma HLS INTERFACE s_axilite port=return
+	Overlay_Execute<MAX_IFM_DIM_OV, MAX_IFM_CH_OV, MAX_K_OV, MAX_STRIDE_OV, MAX_TILES_OV, SIMD_OV, PE_OV,
+		ap_int<ACT_BITS_OV>, ap_int<WGT_BITS_OV> >(layers, numLayers, weights, src, dst, numReps, ap_resource_lut());
+}
@@ -0,0 +1,119 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file packed_mvau_tb.cpp
+ *
+ *  Testbench for the matrix vector activation with PE-packed weights
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_packed.h"
+#include "data/config_packed.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 8
+#define SF_PK (MatrixW_PK/SIMD_PK)
+#define NF_PK (MatrixH_PK/PE_PK)
+
+void Testbench_packed_mvau(stream<ap_uint<SIMD_PK*INPUT_PRECISION_PK> > & in, stream<ap_uint<PE_PK*ACTIVATION_PRECISION_PK> > & out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<INPUT_PRECISION_PK> IMAGE[NUM_REPEAT][MatrixW_PK];
+	stream<ap_uint<SIMD_PK*INPUT_PRECISION_PK> > input_stream("input_stream");
+	stream<ap_uint<PE_PK*ACTIVATION_PRECISION_PK> > output_stream("output_stream");
+	unsigned int errors = 0;
+
+	// the unpacked weights must be those of the generator
+	for (unsigned int nf = 0; nf < NF_PK; nf++) {
+		for (unsigned int sf = 0; sf < SF_PK; sf++) {
+			for (unsigned int pe = 0; pe < PE_PK; pe++) {
+				auto const w = PARAM_PACKED::weights.weights(nf*SF_PK + sf)[pe];
+				for (unsigned int simd = 0; simd < SIMD_PK; simd++) {
+					if (w[simd] != PARAM_PACKED::raw[nf*PE_PK + pe][sf*SIMD_PK + simd]) {
+						cout << "ERROR decode: row " << nf*PE_PK + pe << " column " << sf*SIMD_PK + simd << " expected " << PARAM_PACKED::raw[nf*PE_PK + pe][sf*SIMD_PK + simd] << " decoded " << w[simd] << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_PK; sf++) {
+			ap_uint<SIMD_PK*INPUT_PRECISION_PK> word;
+			for (unsigned int simd = 0; simd < SIMD_PK; simd++) {
+				ap_uint<INPUT_PRECISION_PK> const act = rand();
+				IMAGE[rep][sf*SIMD_PK + simd] = act;
+				word((simd+1)*INPUT_PRECISION_PK-1, simd*INPUT_PRECISION_PK) = act;
+			}
+			input_stream.write(word);
+		}
+	}
+
+	Testbench_packed_mvau(input_stream, output_stream, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF_PK; nf++) {
+			ap_uint<PE_PK*ACTIVATION_PRECISION_PK> const outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_PK; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_PK; col++)
+					exp += PARAM_PACKED::raw[nf*PE_PK + pe][col] * IMAGE[rep][col];
+				ap_int<ACTIVATION_PRECISION_PK> const EXP = exp;
+				ap_int<ACTIVATION_PRECISION_PK> out_chan;
+				out_chan(ACTIVATION_PRECISION_PK-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_PK-1, pe*ACTIVATION_PRECISION_PK);
+				if (EXP != out_chan) {
+					cout << "ERROR: rep " << rep << " expected[" << nf*PE_PK + pe << "]=" << EXP << " actual " << out_chan << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,20 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_packed.h"
+#include "data/config_packed.h"
+
+// a shallow layer of narrow PEs shares a single wide memory word among all of them
+static_assert(packed_pe_per_word(PE_PK, MatrixW_PK/SIMD_PK*MatrixH_PK/PE_PK, SIMD_PK*WIDTH_PK) == PE_PER_WORD_PK, "Unexpected packing.");
+
+void Testbench_packed_mvau(stream<ap_uint<SIMD_PK*INPUT_PRECISION_PK> > & in, stream<ap_uint<PE_PK*ACTIVATION_PRECISION_PK> > & out, unsigned int numReps){
+#pragma HLS ARRAY_PARTITION variable=PARAM_PACKED::weights.m_weights complete dim=1
+	Matrix_Vector_Activate_Batch<MatrixW_PK, MatrixH_PK, SIMD_PK, PE_PK, 1, Slice<ap_uint<INPUT_PRECISION_PK> >, Slice<ap_int<ACTIVATION_PRECISION_PK> >, Identity>
+		(in, out, PARAM_PACKED::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_PK>>(), numReps, ap_resource_dsp());
+}
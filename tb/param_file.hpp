@@ -0,0 +1,233 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file param_file.hpp
+ *
+ *  Loading of weights and thresholds from binary parameter files in csim
+ *
+ *  A parameter file holds the contents of one parameter object as written by
+ *  tb/data/param_file.py. All fields are little-endian:
+ *
+ *    offset  size  field
+ *         0     8  magic "FINNPRM\0"
+ *         8     4  format version, currently 1
+ *        12     4  kind: 1 = weights m_weights[PE][TILES],
+ *                        2 = thresholds m_thresholds[PE][NF][NumTH]
+ *        16     4  bits per word
+ *        20     4  1 if the words are signed, 0 otherwise
+ *        24    12  dimensions: PE, TILES, 1 for weights and PE, NF, NumTH for thresholds
+ *        36     4  reserved, 0
+ *        40     -  words in row-major order of the array, each in
+ *                  ceil(bits/8) bytes, least significant byte first
+ *
+ *  The files are memory-mapped so that the testbench compile time no longer
+ *  depends on the size of the parameters. The loaders throw std::runtime_error
+ *  if a file does not match the shape of the object to fill.
+ *
+ *****************************************************************************/
+#ifndef PARAM_FILE_HPP
+#define PARAM_FILE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ap_int.h"
+#include "weights.hpp"
+#include "activations.hpp"
+
+/**
+ * \brief Read-only memory mapping of a binary parameter file
+ */
+class ParamFile {
+public:
+	static constexpr std::uint32_t  VERSION = 1;
+	static constexpr std::size_t  HEADER_SIZE = 40;
+	enum Kind : std::uint32_t { WEIGHTS = 1, THRESHOLDS = 2 };
+
+private:
+	std::string  m_path;
+	unsigned char const *m_map;
+	std::size_t  m_size;
+
+	std::uint32_t field(std::size_t const  ofs) const {
+		return  std::uint32_t(m_map[ofs]) | std::uint32_t(m_map[ofs+1]) << 8 |
+			std::uint32_t(m_map[ofs+2]) << 16 | std::uint32_t(m_map[ofs+3]) << 24;
+	}
+	[[noreturn]] void fail(std::string const &msg) const {
+		throw  std::runtime_error(m_path + ": " + msg);
+	}
+
+public:
+	ParamFile(std::string const &path) : m_path(path), m_map(nullptr), m_size(0) {
+		int const  fd = open(path.c_str(), O_RDONLY);
+		if(fd < 0)  fail("cannot open parameter file");
+		struct stat  st;
+		if(fstat(fd, &st) != 0) {
+			close(fd);
+			fail("cannot stat parameter file");
+		}
+		m_size = st.st_size;
+		void *const  map = m_size < HEADER_SIZE? MAP_FAILED : mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if(map == MAP_FAILED)  fail("not a parameter file");
+		m_map = static_cast<unsigned char const*>(map);
+		if(std::memcmp(m_map, "FINNPRM", 8) != 0)  fail("bad magic");
+		if(field(8) != VERSION)  fail("unsupported version " + std::to_string(field(8)));
+		if(m_size < HEADER_SIZE + std::size_t(dim(0)) * dim(1) * dim(2) * word_bytes())  fail("truncated data");
+	}
+	~ParamFile() {
+		munmap(const_cast<unsigned char*>(m_map), m_size);
+	}
+	ParamFile(ParamFile const&) = delete;
+	ParamFile& operator=(ParamFile const&) = delete;
+
+public:
+	std::uint32_t kind() const { return  field(12); }
+	unsigned word_bits() const { return  field(16); }
+	bool is_signed() const { return  field(20) != 0; }
+	unsigned dim(unsigned const  i) const { return  field(24 + 4*i); }
+	unsigned word_bytes() const { return  (word_bits() + 7) / 8; }
+
+	/** Checks the kind and shape of the file against those of the object to fill. */
+	void expect(Kind const  kind, unsigned const  bits, unsigned const  d0, unsigned const  d1, unsigned const  d2) const {
+		if(this->kind() != kind)  fail(std::string("expected ") + (kind == WEIGHTS? "weights" : "thresholds"));
+		if(word_bits() != bits)  fail("expected " + std::to_string(bits) + "-bit words, got " + std::to_string(word_bits()));
+		if((dim(0) != d0) || (dim(1) != d1) || (dim(2) != d2)) {
+			fail("expected shape " + std::to_string(d0) + "x" + std::to_string(d1) + "x" + std::to_string(d2) +
+				", got " + std::to_string(dim(0)) + "x" + std::to_string(dim(1)) + "x" + std::to_string(dim(2)));
+		}
+	}
+
+	/** Word idx of the data in row-major order. */
+	template<unsigned W>
+	ap_uint<W> word(std::size_t const  idx) const {
+		unsigned char const *const  src = m_map + HEADER_SIZE + idx * word_bytes();
+		ap_uint<W>  w = 0;
+		for(unsigned  b = 0; 8*b < W; b++) {
+			unsigned const  hi = 8*b+7 < W? 8*b+7 : W-1;
+			w(hi, 8*b) = src[b];
+		}
+		return  w;
+	}
+};
+
+/**
+ * \brief Fills binary weights from a parameter file
+ */
+template<unsigned SIMD, unsigned PE, unsigned TILES>
+void load_params(BinaryWeights<SIMD, PE, TILES> &weights, std::string const &path) {
+	ParamFile const  file(path);
+	file.expect(ParamFile::WEIGHTS, SIMD, PE, TILES, 1);
+	for(unsigned  pe = 0; pe < PE; pe++) {
+		for(unsigned  t = 0; t < TILES; t++) {
+			weights.m_weights[pe][t] = file.word<SIMD>(pe*TILES + t);
+		}
+	}
+}
+
+/**
+ * \brief Fills fixed-point weights from a parameter file
+ */
+template<unsigned SIMD, typename WT, unsigned PE, unsigned TILES>
+void load_params(FixedPointWeights<SIMD, WT, PE, TILES> &weights, std::string const &path) {
+	ParamFile const  file(path);
+	file.expect(ParamFile::WEIGHTS, SIMD*WT::width, PE, TILES, 1);
+	for(unsigned  pe = 0; pe < PE; pe++) {
+		for(unsigned  t = 0; t < TILES; t++) {
+			weights.m_weights[pe][t] = file.word<SIMD*WT::width>(pe*TILES + t);
+		}
+	}
+}
+
+namespace detail {
+	/** Fills a threshold array m_thresholds[PE][NF][NumTH] of an ap_[u]int or ap_[u]fixed type TA. */
+	template<unsigned NF, unsigned PE, unsigned NumTH, typename TA>
+	void load_thresholds(TA (&thresholds)[PE][NF][NumTH], std::string const &path) {
+		ParamFile const  file(path);
+		file.expect(ParamFile::THRESHOLDS, TA::width, PE, NF, NumTH);
+		for(unsigned  pe = 0; pe < PE; pe++) {
+			for(unsigned  nf = 0; nf < NF; nf++) {
+				for(unsigned  i = 0; i < NumTH; i++) {
+					thresholds[pe][nf][i].range(TA::width-1, 0) = file.word<TA::width>((pe*NF + nf)*NumTH + i);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * \brief Fills the thresholds of a ThresholdsActivation from a parameter file
+ */
+template<unsigned NF, unsigned PE, unsigned NumTH, typename TA, typename TR, int ActVal, typename Compare>
+void load_params(ThresholdsActivation<NF, PE, NumTH, TA, TR, ActVal, Compare> &act, std::string const &path) {
+	detail::load_thresholds<NF, PE, NumTH>(act.m_thresholds, path);
+}
+
+/**
+ * \brief Fills the thresholds of a ThresholdsActivationBinarySearch from a parameter file
+ */
+template<unsigned NF, unsigned PE, unsigned NumTH, typename TA, typename TR, int ActVal, typename Compare>
+void load_params(ThresholdsActivationBinarySearch<NF, PE, NumTH, TA, TR, ActVal, Compare> &act, std::string const &path) {
+	detail::load_thresholds<NF, PE, NumTH>(act.m_thresholds, path);
+}
+
+/**
+ * \brief Path of the parameter file name next to the header path, e.g. __FILE__ of a generated header
+ */
+inline std::string param_path(char const *header, char const *name) {
+	std::string const  h(header);
+	std::size_t const  sep = h.find_last_of('/');
+	return  (sep == std::string::npos? std::string() : h.substr(0, sep+1)) + name;
+}
+
+/**
+ * \brief Parameter object filled from a parameter file at static initialization
+ *
+ * Used by the headers that gen_weigths.py and gen_thresholds.py write with --binary in place
+ * of the initialized arrays, so that the parameters need not be compiled.
+ */
+template<typename T>
+T load_params(std::string const &path) {
+	T  obj;
+	load_params(obj, path);
+	return  obj;
+}
+
+#endif
@@ -0,0 +1,150 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file param_file_tb.cpp
+ *
+ *  Testbench for the loading of weights and thresholds from binary parameter
+ *  files, checking the loaded parameters against the generated headers and
+ *  the matrix vector activation against a golden model built from the files
+ *
+ *  The directory of the parameter files is the first argument, data/ if none
+ *  is given.
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "param_file.hpp"
+#include "data/memdata_param_file.h"
+#include "data/config_param_file.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 8
+#define NF_PF (MatrixH_PF/PE_PF)
+#define SF_PF (MatrixW_PF/SIMD_PF)
+#define TILES_PF (NF_PF*SF_PF)
+
+void Testbench_param_file(stream<ap_uint<SIMD_PF*INPUT_PRECISION_PF> > & in, stream<ap_uint<PE_PF*OUTPUT_PRECISION_PF> > & out, unsigned int numReps);
+
+int main(int argc, char *argv[])
+{
+	string const dir = argc > 1? argv[1] : "data/";
+	static FixedPointWeights<SIMD_PF, ap_int<WIDTH_PF>, PE_PF, TILES_PF> weights;
+	static ThresholdsActivation<NF_PF, PE_PF, NUM_TH_PF, ap_int<ACC_PRECISION_PF>, ap_uint<OUTPUT_PRECISION_PF> > threshs;
+	static ap_uint<INPUT_PRECISION_PF> IMAGE[NUM_REPEAT][MatrixW_PF];
+	stream<ap_uint<SIMD_PF*INPUT_PRECISION_PF> > input_stream("input_stream");
+	stream<ap_uint<PE_PF*OUTPUT_PRECISION_PF> > output_stream("output_stream");
+	unsigned int errors = 0;
+
+	try {
+		load_params(weights, dir + "params_param_file.bin");
+		load_params(threshs, dir + "thresholds_param_file.bin");
+	}
+	catch (std::runtime_error const &e) {
+		cout << "ERROR: " << e.what() << endl;
+		return 1;
+	}
+
+	// the files must reproduce the parameters of the headers used for synthesis
+	for (unsigned int pe = 0; pe < PE_PF; pe++) {
+		for (unsigned int t = 0; t < TILES_PF; t++) {
+			if (weights.m_weights[pe][t] != PARAM_PF::weights.m_weights[pe][t]) {
+				cout << "ERROR weights: pe " << pe << " tile " << t << hex << " expected " << PARAM_PF::weights.m_weights[pe][t] << " loaded " << weights.m_weights[pe][t] << dec << endl;
+				errors++;
+			}
+		}
+		for (unsigned int nf = 0; nf < NF_PF; nf++) {
+			for (unsigned int i = 0; i < NUM_TH_PF; i++) {
+				if (threshs.m_thresholds[pe][nf][i] != PARAM_PF::threshs.m_thresholds[pe][nf][i]) {
+					cout << "ERROR thresholds: pe " << pe << " nf " << nf << " threshold " << i << " expected " << PARAM_PF::threshs.m_thresholds[pe][nf][i] << " loaded " << threshs.m_thresholds[pe][nf][i] << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_PF; sf++) {
+			ap_uint<SIMD_PF*INPUT_PRECISION_PF> word;
+			for (unsigned int simd = 0; simd < SIMD_PF; simd++) {
+				ap_uint<INPUT_PRECISION_PF> const act = rand();
+				IMAGE[rep][sf*SIMD_PF + simd] = act;
+				word((simd+1)*INPUT_PRECISION_PF-1, simd*INPUT_PRECISION_PF) = act;
+			}
+			input_stream.write(word);
+		}
+	}
+
+	Testbench_param_file(input_stream, output_stream, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF_PF; nf++) {
+			ap_uint<PE_PF*OUTPUT_PRECISION_PF> const outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_PF; pe++) {
+				// golden model from the loaded parameters, row nf*PE + pe in tiles nf*SF + sf
+				ap_int<ACC_PRECISION_PF> acc = 0;
+				for (unsigned int sf = 0; sf < SF_PF; sf++) {
+					ap_uint<SIMD_PF*WIDTH_PF> const w = weights.m_weights[pe][nf*SF_PF + sf];
+					for (unsigned int simd = 0; simd < SIMD_PF; simd++) {
+						ap_int<WIDTH_PF> wgt;
+						wgt(WIDTH_PF-1, 0) = w((simd+1)*WIDTH_PF-1, simd*WIDTH_PF);
+						acc += wgt * IMAGE[rep][sf*SIMD_PF + simd];
+					}
+				}
+				unsigned int exp = 0;
+				for (unsigned int i = 0; i < NUM_TH_PF; i++)
+					exp += threshs.m_thresholds[pe][nf][i] <= acc;
+				ap_uint<OUTPUT_PRECISION_PF> const out_chan = outElem((pe+1)*OUTPUT_PRECISION_PF-1, pe*OUTPUT_PRECISION_PF);
+				if (out_chan != exp) {
+					cout << "ERROR: rep " << rep << " expected[" << nf*PE_PF + pe << "]=" << exp << " actual " << out_chan << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,16 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_param_file.h"
+#include "data/config_param_file.h"
+
+void Testbench_param_file(stream<ap_uint<SIMD_PF*INPUT_PRECISION_PF> > & in, stream<ap_uint<PE_PF*OUTPUT_PRECISION_PF> > & out, unsigned int numReps)
+{
+	Matrix_Vector_Activate_Batch<MatrixW_PF, MatrixH_PF, SIMD_PF, PE_PF, 1, Slice<ap_uint<INPUT_PRECISION_PF> >, Slice<ap_uint<OUTPUT_PRECISION_PF> >, Identity>
+		(in, out, PARAM_PF::weights, PARAM_PF::threshs, numReps, ap_resource_dsp());
+}
@@ -0,0 +1,128 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file pipeline_tb.cpp
+ *
+ *  Testbench for the type-level pipeline composer of pipeline.hpp
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_pipeline.h"
+#include "data/config_pipeline.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 3
+#define POOLED_DIM_PL (OFMDim_PL/POOL_DIM_PL)
+
+void Testbench_pipeline(stream<ap_uint<IFM_Channels_PL*INPUT_PRECISION_PL> > & in, stream<ap_uint<OUT_STREAM_WIDTH_PL> > & out, unsigned int numReps);
+
+int main()
+{
+	static int IMAGE[NUM_REPEAT][IFMDim_PL][IFMDim_PL][IFM_Channels_PL];
+	stream<ap_uint<IFM_Channels_PL*INPUT_PRECISION_PL> > in("in");
+	stream<ap_uint<OUT_STREAM_WIDTH_PL> > out("out");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int y = 0; y < IFMDim_PL; y++) {
+			for (unsigned int x = 0; x < IFMDim_PL; x++) {
+				ap_uint<IFM_Channels_PL*INPUT_PRECISION_PL> word;
+				for (unsigned int c = 0; c < IFM_Channels_PL; c++) {
+					ap_uint<INPUT_PRECISION_PL> const act = rand();
+					IMAGE[rep][y][x][c] = act;
+					word((c+1)*INPUT_PRECISION_PL-1, c*INPUT_PRECISION_PL) = act;
+				}
+				in.write(word);
+			}
+		}
+	}
+
+	Testbench_pipeline(in, out, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		// golden model: convolution, max pool and fully-connected layer
+		int conv[OFMDim_PL][OFMDim_PL][OFM_Channels_PL];
+		for (unsigned int y = 0; y < OFMDim_PL; y++)
+			for (unsigned int x = 0; x < OFMDim_PL; x++)
+				for (unsigned int o = 0; o < OFM_Channels_PL; o++) {
+					int acc = 0;
+					for (unsigned int ky = 0; ky < KERNEL_DIM_PL; ky++)
+						for (unsigned int kx = 0; kx < KERNEL_DIM_PL; kx++)
+							for (unsigned int c = 0; c < IFM_Channels_PL; c++)
+								acc += PARAM_PIPELINE::conv_weights_raw[o][(ky*KERNEL_DIM_PL + kx)*IFM_Channels_PL + c] * IMAGE[rep][y+ky][x+kx][c];
+					conv[y][x][o] = acc;
+				}
+		int pooled[FC_IN_PL];
+		for (unsigned int y = 0; y < POOLED_DIM_PL; y++)
+			for (unsigned int x = 0; x < POOLED_DIM_PL; x++)
+				for (unsigned int c = 0; c < OFM_Channels_PL; c++) {
+					int m = conv[y*POOL_DIM_PL][x*POOL_DIM_PL][c];
+					for (unsigned int py = 0; py < POOL_DIM_PL; py++)
+						for (unsigned int px = 0; px < POOL_DIM_PL; px++)
+							m = max(m, conv[y*POOL_DIM_PL + py][x*POOL_DIM_PL + px][c]);
+					pooled[(y*POOLED_DIM_PL + x)*OFM_Channels_PL + c] = m;
+				}
+		ap_uint<FC_OUT_PL*FC_PRECISION_PL> expected;
+		for (unsigned int h = 0; h < FC_OUT_PL; h++) {
+			int acc = 0;
+			for (unsigned int i = 0; i < FC_IN_PL; i++)
+				acc += PARAM_PIPELINE::fc_weights_raw[h][i] * pooled[i];
+			expected((h+1)*FC_PRECISION_PL-1, h*FC_PRECISION_PL) = ap_int<FC_PRECISION_PL>(acc);
+		}
+
+		for (unsigned int w = 0; w < FC_OUT_PL*FC_PRECISION_PL/OUT_STREAM_WIDTH_PL; w++) {
+			ap_uint<OUT_STREAM_WIDTH_PL> const exp = expected((w+1)*OUT_STREAM_WIDTH_PL-1, w*OUT_STREAM_WIDTH_PL);
+			ap_uint<OUT_STREAM_WIDTH_PL> const act = out.read();
+			if (act != exp) {
+				cout << "ERROR: rep " << rep << " word " << w << " expected " << hex << exp << " actual " << act << dec << endl;
+				errors++;
+			}
+		}
+	}
+
+	if (!in.empty() || !out.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
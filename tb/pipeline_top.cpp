@@ -0,0 +1,36 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "pipeline.hpp"
+#include "data/memdata_pipeline.h"
+#include "data/config_pipeline.h"
+
+typedef ap_uint<INPUT_PRECISION_PL> TI_PL;
+typedef ap_int<CONV_PRECISION_PL> TC_PL;
+typedef ap_int<FC_PRECISION_PL> TF_PL;
+
+// The convolution output is widened for the max pool and again for the fully-connected layer,
+// the pipeline input is read by the convolution as is.
+using Net_PL = Pipeline<
+	pipeline::Conv<KERNEL_DIM_PL, IFM_Channels_PL, IFMDim_PL, OFM_Channels_PL, OFMDim_PL, CONV_SIMD_PL, CONV_PE_PL,
+		Slice<TI_PL>, Slice<TC_PL>>,
+	pipeline::MaxPool<OFMDim_PL, POOL_DIM_PL, OFM_Channels_PL, TC_PL, -(1 << (CONV_PRECISION_PL-1))>,
+	pipeline::OnSLR<1, pipeline::MatrixVector<FC_IN_PL, FC_OUT_PL, FC_SIMD_PL, FC_PE_PL, Slice<TC_PL>, Slice<TF_PL>>>
+>;
+// the fully-connected layer is placed on the next die
+static_assert(Net_PL::Crossings == 1, "Unexpected SLR crossings");
+// the convolution is the slowest layer with 2x9 synapse and 2 neuron folds over 4x4 pixels
+static_assert(Net_PL::Cycles == 288, "Unexpected pipeline cycles");
+
+void Testbench_pipeline(stream<ap_uint<IFM_Channels_PL*INPUT_PRECISION_PL> > & in, stream<ap_uint<OUT_STREAM_WIDTH_PL> > & out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	Net_PL::run(in, out, numReps,
+		pipeline::params(PARAM_PIPELINE::conv_weights, PassThroughActivation<TC_PL>(), ap_resource_dsp()),
+		pipeline::none(),
+		pipeline::params(PARAM_PIPELINE::fc_weights, PassThroughActivation<TF_PL>(), ap_resource_dsp()));
+}
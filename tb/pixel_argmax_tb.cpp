@@ -0,0 +1,105 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file pixel_argmax_tb.cpp
+ *
+ *  Testbench for the per-pixel argmax of segmentation outputs
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "cycles.hpp"
+#include "data/config_pixel_argmax.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_pixel_argmax(stream<ap_uint<PE_PA*INPUT_PRECISION_PA> > & in, stream<ap_uint<PE_PA*INPUT_PRECISION_PA> > & in_scores,
+	stream<ap_uint<OUT_WIDTH_PA> > & out, stream<ap_uint<OUT_WIDTH_PA> > & out_scores, stream<ap_int<INPUT_PRECISION_PA> > & scores, unsigned int numReps);
+
+int main()
+{
+	static_assert(PixelArgmax_Batch_cycles<NUM_CLASSES_PA, PE_PA, NUM_PIXELS_PA>(NUM_REPS_PA) ==
+		NUM_REPS_PA * NUM_PIXELS_PA * NUM_CLASSES_PA / PE_PA, "");
+
+	static int VALUES[NUM_REPS_PA * NUM_PIXELS_PA][NUM_CLASSES_PA];
+	stream<ap_uint<PE_PA*INPUT_PRECISION_PA> > input_stream("input_stream");
+	stream<ap_uint<PE_PA*INPUT_PRECISION_PA> > input_stream_scores("input_stream_scores");
+	stream<ap_uint<OUT_WIDTH_PA> > output_stream("output_stream");
+	stream<ap_uint<OUT_WIDTH_PA> > output_stream_scores("output_stream_scores");
+	stream<ap_int<INPUT_PRECISION_PA> > scores_stream("scores_stream");
+	unsigned int err_counter = 0;
+
+	for (unsigned int pixel = 0; pixel < NUM_REPS_PA * NUM_PIXELS_PA; pixel++)
+		for (unsigned int block = 0; block < NUM_CLASSES_PA / PE_PA; block++) {
+			ap_uint<PE_PA*INPUT_PRECISION_PA> word;
+			for (unsigned int pe = 0; pe < PE_PA; pe++) {
+				// the narrow input precision produces many ties
+				ap_int<INPUT_PRECISION_PA> const val = rand();
+				VALUES[pixel][block*PE_PA + pe] = val;
+				word((pe+1)*INPUT_PRECISION_PA-1, pe*INPUT_PRECISION_PA) = val;
+			}
+			input_stream.write(word);
+			input_stream_scores.write(word);
+		}
+
+	Testbench_pixel_argmax(input_stream, input_stream_scores, output_stream, output_stream_scores, scores_stream, NUM_REPS_PA);
+
+	for (unsigned int pixel = 0; pixel < NUM_REPS_PA * NUM_PIXELS_PA; pixel++) {
+		// equal values resolve to the lowest label
+		unsigned int expected = 0;
+		for (unsigned int i = 1; i < NUM_CLASSES_PA; i++)
+			if (VALUES[pixel][i] > VALUES[pixel][expected])
+				expected = i;
+		unsigned int const label = output_stream.read();
+		unsigned int const label_scores = output_stream_scores.read();
+		int const score = scores_stream.read();
+		if ((label != expected) || (label_scores != expected) || (score != VALUES[pixel][expected])) {
+			std::cout << "ERROR: Pixel " << pixel << " Expected " << expected << " (" << VALUES[pixel][expected]
+				<< ") actual " << label << ", " << label_scores << " (" << score << ")" << std::endl;
+			err_counter++;
+		}
+	}
+	if (!input_stream.empty() || !output_stream.empty() || !output_stream_scores.empty() || !scores_stream.empty()) {
+		std::cout << "ERROR: streams not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return 0;
+}
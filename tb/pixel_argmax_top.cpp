@@ -0,0 +1,13 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_pixel_argmax.h"
+
+void Testbench_pixel_argmax(stream<ap_uint<PE_PA*INPUT_PRECISION_PA> > & in, stream<ap_uint<PE_PA*INPUT_PRECISION_PA> > & in_scores,
+	stream<ap_uint<OUT_WIDTH_PA> > & out, stream<ap_uint<OUT_WIDTH_PA> > & out_scores, stream<ap_int<INPUT_PRECISION_PA> > & scores, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	PixelArgmax_Batch<NUM_CLASSES_PA, PE_PA, NUM_PIXELS_PA, ap_int<INPUT_PRECISION_PA>, ap_uint<OUT_WIDTH_PA> >(in, out, numReps);
+	PixelArgmax_Batch<NUM_CLASSES_PA, PE_PA, NUM_PIXELS_PA, ap_int<INPUT_PRECISION_PA>, ap_uint<OUT_WIDTH_PA> >(in_scores, out_scores, scores, numReps);
+}
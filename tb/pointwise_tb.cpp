@@ -0,0 +1,112 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file pointwise_tb.cpp
+ *
+ *  Testbench for the pointwise convolutional layer, with and without stride
+ *  and MMV
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_pointwise.h"
+#include "data/config_pointwise.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 2
+
+void Testbench_pointwise(int mode, stream<ap_uint<IFM_Channels_PW*INPUT_PRECISION_PW> > & in, stream<ap_uint<INPUT_PRECISION_PW> > & in_narrow,
+	stream<ap_uint<OFM_Channels_PW*ACTIVATION_PRECISION_PW> > & out, unsigned int numReps);
+
+int main()
+{
+	static int IMAGE[NUM_REPEAT][IFMDim_PW][IFMDim_PW][IFM_Channels_PW];
+	stream<ap_uint<IFM_Channels_PW*INPUT_PRECISION_PW> > in("in");
+	stream<ap_uint<INPUT_PRECISION_PW> > in_narrow("in_narrow");
+	stream<ap_uint<OFM_Channels_PW*ACTIVATION_PRECISION_PW> > out("out");
+	unsigned int errors = 0;
+
+	for (int mode = 0; mode < 4; mode++) {
+		unsigned int const stride = mode == 0? 1 : STRIDE_PW;
+		unsigned int const ofm_dim = (IFMDim_PW - 1) / stride + 1;
+		for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+			for (unsigned int y = 0; y < IFMDim_PW; y++) {
+				for (unsigned int x = 0; x < IFMDim_PW; x++) {
+					ap_uint<IFM_Channels_PW*INPUT_PRECISION_PW> word;
+					for (unsigned int c = 0; c < IFM_Channels_PW; c++) {
+						ap_uint<INPUT_PRECISION_PW> const act = rand();
+						IMAGE[rep][y][x][c] = act;
+						word((c+1)*INPUT_PRECISION_PW-1, c*INPUT_PRECISION_PW) = act;
+						if (mode == 3)  in_narrow.write(act);
+					}
+					if (mode != 3)  in.write(word);
+				}
+			}
+		}
+
+		Testbench_pointwise(mode, in, in_narrow, out, NUM_REPEAT);
+
+		for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+			for (unsigned int y = 0; y < ofm_dim; y++) {
+				for (unsigned int x = 0; x < ofm_dim; x++) {
+					ap_uint<OFM_Channels_PW*ACTIVATION_PRECISION_PW> const value = out.read();
+					for (unsigned int o = 0; o < OFM_Channels_PW; o++) {
+						int exp = 0;
+						for (unsigned int c = 0; c < IFM_Channels_PW; c++)
+							exp += PARAM_POINTWISE::weights_raw[o][c] * IMAGE[rep][y*stride][x*stride][c];
+						ap_int<ACTIVATION_PRECISION_PW> const act = value((o+1)*ACTIVATION_PRECISION_PW-1, o*ACTIVATION_PRECISION_PW);
+						if (act != exp) {
+							cout << "ERROR: mode " << mode << " rep " << rep << " pixel " << y << "," << x << " channel " << o << " expected " << exp << " actual " << act << endl;
+							errors++;
+						}
+					}
+				}
+			}
+		}
+
+		if (!in.empty() || !in_narrow.empty() || !out.empty()) {
+			cout << "ERROR: mode " << mode << " streams not empty" << endl;
+			errors++;
+		}
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,36 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_pointwise.h"
+#include "data/config_pointwise.h"
+
+typedef ap_uint<INPUT_PRECISION_PW> TI_PW;
+typedef ap_int<ACTIVATION_PRECISION_PW> TO_PW;
+
+// mode 0: unit stride, 1: STRIDE_PW, 2: STRIDE_PW with MMV, 3: STRIDE_PW from a stream of single channels
+void Testbench_pointwise(int mode, stream<ap_uint<IFM_Channels_PW*INPUT_PRECISION_PW> > & in, stream<ap_uint<INPUT_PRECISION_PW> > & in_narrow,
+	stream<ap_uint<OFM_Channels_PW*ACTIVATION_PRECISION_PW> > & out, unsigned int numReps)
+{
+	switch(mode) {
+	case 0:
+		PointwiseConvLayer_Batch<IFM_Channels_PW, IFMDim_PW, OFM_Channels_PW, 1, SIMD_PW, PE_PW, Slice<TI_PW>, Slice<TO_PW>, Identity>
+			(in, out, PARAM_POINTWISE::weights, PassThroughActivation<TO_PW>(), numReps, ap_resource_dsp());
+		break;
+	case 1:
+		PointwiseConvLayer_Batch<IFM_Channels_PW, IFMDim_PW, OFM_Channels_PW, STRIDE_PW, SIMD_PW, PE_PW, Slice<TI_PW>, Slice<TO_PW>, Identity>
+			(in, out, PARAM_POINTWISE::weights, PassThroughActivation<TO_PW>(), numReps, ap_resource_dsp());
+		break;
+	case 2:
+		PointwiseConvLayer_Batch_MMV<IFM_Channels_PW, IFMDim_PW, OFM_Channels_PW, STRIDE_PW, SIMD_PW, PE_PW, MMV_PW, Slice_mmv<TI_PW, MMV_PW>, Slice_mmv<TO_PW, MMV_PW>, Identity>
+			(in, out, PARAM_POINTWISE::weights, PassThroughActivation<TO_PW>(), numReps, ap_resource_dsp());
+		break;
+	default:
+		PointwiseConvLayer_Batch<IFM_Channels_PW, IFMDim_PW, OFM_Channels_PW, STRIDE_PW, SIMD_PW, PE_PW, Slice<TI_PW>, Slice<TO_PW>, Identity>
+			(in_narrow, out, PARAM_POINTWISE::weights, PassThroughActivation<TO_PW>(), numReps, ap_resource_dsp());
+		break;
+	}
+}
@@ -0,0 +1,120 @@
+/******************************************************************************
+ *  Copyright (c) 2022, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ * @brief	Top-level for LayerNorm layer test.
+ * @brief	Testbench for image preprocessing.
+ *******************************************************************************/
+#include "preprocess_top.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+template<unsigned  FM, unsigned  C, unsigned  SIMD, bool  SWAP, typename  TO, typename  TC>
+unsigned check(
+	std::vector<unsigned> const &x,
+	TC const (&coeff)[C],
+	hls::stream<ap_uint<SIMD*C*TO::width>> &dst
+) {
+	constexpr unsigned  WO = TO::width;
+	unsigned  mismatches = 0;
+	for(unsigned  i = 0; i < REPS*FM; i += SIMD) {
+		ap_uint<SIMD*C*WO> const  y = dst.read();
+		for(unsigned  s = 0; s < SIMD; s++) {
+			for(unsigned  c = 0; c < C; c++) {
+				TO  yv;
+				yv.range(WO-1, 0) = y(((s*C + c)+1)*WO-1, (s*C + c)*WO);
+				unsigned const  v   = x[(i+s)*C + (SWAP? C-1-c : c)];
+				// quantize the exact reference as the output type does
+				TO const        ref = (v - coeff[c].mean.to_double()) * coeff[c].scale.to_double();
+				bool const      ok  = yv == ref;
+				if(!ok)  mismatches++;
+				std::cout << std::setw(4) << v << " -> " << std::setw(8) << double(yv) << " / " << std::setw(8) << double(ref) << '\t' << (ok? '.' : 'X') << std::endl;
+			}
+		}
+	}
+	std::cout << "--------------\n" << std::endl;
+	return  mismatches;
+}
+
+int main() {
+	std::default_random_engine  rnd;
+	std::uniform_int_distribution<>  dist(0, 255);
+
+	// ImageNet statistics of the RGB channels
+	TC0  coeff0[C0];
+	double const  mean[3] = { 123.675, 116.28, 103.53 };
+	double const  std[3]  = { 58.395, 57.12, 57.375 };
+	for(unsigned  c = 0; c < C0; c++) {
+		coeff0[C0-1-c].mean  = mean[c];
+		coeff0[C0-1-c].scale = 1 / std[c];
+	}
+	TC1  coeff1[C1];
+	coeff1[0].mean  = 0;
+	coeff1[0].scale = 1.0 / 256;
+
+	hls::stream<ap_uint<SIMD0*C0*8>>  src0("src0");
+	hls::stream<ap_uint<SIMD0*C0*TO0::width>>  dst0("dst0");
+	hls::stream<ap_uint<SIMD1*C1*8>>  src1("src1");
+	hls::stream<ap_uint<SIMD1*C1*TO1::width>>  dst1("dst1");
+	std::vector<unsigned>  x0;
+	std::vector<unsigned>  x1;
+	for(unsigned  i = 0; i < REPS*FM0; i += SIMD0) {
+		ap_uint<SIMD0*C0*8>  w;
+		for(unsigned  l = 0; l < SIMD0*C0; l++) {
+			unsigned const  v = dist(rnd);
+			w(8*l+7, 8*l) = v;
+			x0.push_back(v);
+		}
+		src0.write(w);
+	}
+	for(unsigned  i = 0; i < REPS*FM1; i++) {
+		unsigned const  v = dist(rnd);
+		src1.write(v);
+		x1.push_back(v);
+	}
+
+	preprocess_top(src0, dst0, coeff0, src1, dst1, coeff1);
+
+	unsigned  mismatches = 0;
+	mismatches += check<FM0, C0, SIMD0, true,  TO0>(x0, coeff0, dst0);
+	mismatches += check<FM1, C1, SIMD1, false, TO1>(x1, coeff1, dst1);
+	if(!src0.empty() || !src1.empty() || !dst0.empty() || !dst1.empty()) {
+		std::cout << "Streams not empty." << std::endl;
+		mismatches++;
+	}
+
+	if(mismatches == 0)  return  0;
+	else {
+		std::cout << mismatches << " output mismatches." << std::endl;
+		return  1;
+	}
+}
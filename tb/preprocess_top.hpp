@@ -0,0 +1,66 @@
+/******************************************************************************
+ *  Copyright (c) 2022, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ * @brief	Top-level for LayerNorm layer test.
+ * @brief	Top-level for image preprocessing test.
+ *******************************************************************************/
+#ifndef PREPROCESS_TOP_HPP
+#define PREPROCESS_TOP_HPP
+
+#include <ap_int.h>
+#include <ap_fixed.h>
+#include <hls_stream.h>
+#include "normalize.hpp"
+
+constexpr unsigned  REPS = 3;
+
+// Instance 0: RGB to BGR, mean/std normalization, SIMD pixels per word
+constexpr unsigned  FM0   = 16;
+constexpr unsigned  C0    = 3;
+constexpr unsigned  SIMD0 = 2;
+using  TO0 = ap_fixed<8, 3, AP_RND, AP_SAT>;
+using  TC0 = MeanScale<ap_ufixed<12, 8>, ap_ufixed<16, 0>>;
+
+// Instance 1: grayscale scaled into [0, 1)
+constexpr unsigned  FM1   = 8;
+constexpr unsigned  C1    = 1;
+constexpr unsigned  SIMD1 = 1;
+using  TO1 = ap_ufixed<4, 0, AP_RND, AP_SAT>;
+using  TC1 = MeanScale<ap_uint<1>, ap_ufixed<12, 0>>;
+
+void preprocess_top(
+	hls::stream<ap_uint<SIMD0*C0*8>> &src0,
+	hls::stream<ap_uint<SIMD0*C0*TO0::width>> &dst0,
+	TC0 const (&coeff0)[C0],
+	hls::stream<ap_uint<SIMD1*C1*8>> &src1,
+	hls::stream<ap_uint<SIMD1*C1*TO1::width>> &dst1,
+	TC1 const (&coeff1)[C1]
+);
+#endif
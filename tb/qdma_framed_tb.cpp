@@ -0,0 +1,123 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file qdma_framed_tb.cpp
+ *
+ *  Testbench for the TLAST-framed QDMA stream adapters
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "ap_axi_sdata.h"
+#include "data/config_qdma_framed.h"
+using namespace hls;
+using namespace std;
+
+typedef qdma_axis<DATA_WIDTH_QF,0,0,0> beat_t;
+void Testbench_qdma_framed(stream<beat_t> & in, stream<beat_t> & out,
+	stream<beat_t> & in_var, stream<ap_uint<DATA_WIDTH_QF> > & out_var, stream<bool> & eob_var);
+
+beat_t make_beat(ap_uint<DATA_WIDTH_QF> data, bool last, bool keep) {
+	beat_t b;
+	b.set_data(data);
+	b.set_keep(keep? -1 : 0);
+	b.set_last(last);
+	return b;
+}
+
+int main()
+{
+	stream<beat_t> in("in"), out("out"), in_var("in_var");
+	stream<ap_uint<DATA_WIDTH_QF> > out_var("out_var");
+	stream<bool> eob_var("eob_var");
+	vector<ap_uint<DATA_WIDTH_QF> > words, words_var;
+	vector<unsigned int> lengths;
+	unsigned int errors = 0;
+
+	// fixed-size frames looped back, the batch size unknown to the kernel
+	for (unsigned int f = 0; f < NUM_FRAMES_QF; f++) {
+		for (unsigned int w = 0; w < NUM_WORDS_QF; w++) {
+			words.push_back(rand());
+			in.write(make_beat(words.back(), w == NUM_WORDS_QF-1, true));
+		}
+	}
+	in.write(make_beat(0, true, false));
+	// variable-length frames
+	for (unsigned int f = 0; f < NUM_FRAMES_QF; f++) {
+		lengths.push_back(1 + rand() % (2*NUM_WORDS_QF));
+		for (unsigned int w = 0; w < lengths.back(); w++) {
+			words_var.push_back(rand());
+			in_var.write(make_beat(words_var.back(), w == lengths.back()-1, true));
+		}
+	}
+	in_var.write(make_beat(0, true, false));
+
+	Testbench_qdma_framed(in, out, in_var, out_var, eob_var);
+
+	for (unsigned int i = 0; i <= words.size(); i++) {
+		beat_t const b = out.read();
+		bool const terminator = (i == words.size());
+		bool const last = terminator || (i % NUM_WORDS_QF == NUM_WORDS_QF-1);
+		if ((bool(b.get_last()) != last) || ((b.get_keep() == 0) != terminator) || (!terminator && (b.get_data() != words[i]))) {
+			cout << "ERROR loopback: beat " << i << " last " << b.get_last() << " keep " << b.get_keep() << endl;
+			errors++;
+		}
+	}
+	for (unsigned int i = 0; i < words_var.size(); i++) {
+		ap_uint<DATA_WIDTH_QF> const value = out_var.read();
+		if (value != words_var[i]) {
+			cout << "ERROR variable: word " << i << hex << " expected " << words_var[i] << " value " << value << dec << endl;
+			errors++;
+		}
+	}
+	for (unsigned int f = 0; f <= NUM_FRAMES_QF; f++) {
+		bool const eob = eob_var.read();
+		if (eob != (f == NUM_FRAMES_QF)) {
+			cout << "ERROR variable: frame " << f << " end-of-batch token " << eob << endl;
+			errors++;
+		}
+	}
+	if (!in.empty() || !out.empty() || !in_var.empty() || !out_var.empty() || !eob_var.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
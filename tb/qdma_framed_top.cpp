@@ -0,0 +1,19 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_qdma_framed.h"
+
+void Testbench_qdma_framed(stream<qdma_axis<DATA_WIDTH_QF,0,0,0> > & in, stream<qdma_axis<DATA_WIDTH_QF,0,0,0> > & out,
+	stream<qdma_axis<DATA_WIDTH_QF,0,0,0> > & in_var, stream<ap_uint<DATA_WIDTH_QF> > & out_var, stream<bool> & eob_var)
+{
+#pragma HLS INTERFACE axis port=in
+#pragma HLS INTERFACE axis port=out
+#pragma HLS INTERFACE axis port=in_var
+#pragma HLS DATAFLOW
+	stream<ap_uint<DATA_WIDTH_QF> > data("data");
+	stream<bool> eob("eob");
+	Qdma2Stream_Framed_Batch<DATA_WIDTH_QF>(in, data, eob);
+	Stream2Qdma_Framed_Batch<DATA_WIDTH_QF, NUM_WORDS_QF>(data, eob, out);
+	Qdma2Stream_Framed_Batch<DATA_WIDTH_QF>(in_var, out_var, eob_var);
+}
@@ -0,0 +1,133 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file qdma_multiqueue_tb.cpp
+ *
+ *  Testbench for the multi-queue QDMA arbiter and router
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "ap_axi_sdata.h"
+#include "bnn-library.h"
+#include "data/config_qdma_multiqueue.h"
+using namespace hls;
+using namespace std;
+
+typedef qdma_axis<DATA_WIDTH_MQ,0,0,0> beat_t;
+typedef QdmaQueueTag<NUM_QUEUES_MQ>::type tag_t;
+void Testbench_qdma_multiqueue(stream<beat_t> (&in)[NUM_QUEUES_MQ], stream<beat_t> (&out)[NUM_QUEUES_MQ],
+	stream<beat_t> (&in_prio)[NUM_QUEUES_MQ], stream<ap_uint<DATA_WIDTH_MQ> > & out_prio, stream<tag_t> & tag_prio,
+	unsigned int numFrames, unsigned int numFramesPrio);
+
+// writes a frame of the given length to a queue, records its words
+void write_frame(stream<beat_t> & in, vector<ap_uint<DATA_WIDTH_MQ> > & words, unsigned int length) {
+	for (unsigned int w = 0; w < length; w++) {
+		beat_t b;
+		b.set_data(rand());
+		b.set_keep(-1);
+		b.set_last(w == length-1);
+		in.write(b);
+		words.push_back(b.get_data());
+	}
+}
+
+int main()
+{
+	stream<beat_t> in[NUM_QUEUES_MQ], out[NUM_QUEUES_MQ], in_prio[NUM_QUEUES_MQ];
+	stream<ap_uint<DATA_WIDTH_MQ> > out_prio("out_prio");
+	stream<tag_t> tag_prio("tag_prio");
+	vector<ap_uint<DATA_WIDTH_MQ> > words[NUM_QUEUES_MQ], words_prio[NUM_QUEUES_MQ];
+	unsigned int const frames[NUM_QUEUES_MQ] = { 3, 1, 2 };
+	unsigned int numFrames = 0;
+	unsigned int errors = 0;
+
+	// queue q holds frames[q] frames, of fixed length for the round-robin loopback, variable for the priority arbiter
+	vector<unsigned int> lengths_prio[NUM_QUEUES_MQ];
+	for (unsigned int q = 0; q < NUM_QUEUES_MQ; q++) {
+		for (unsigned int f = 0; f < frames[q]; f++) {
+			write_frame(in[q], words[q], NUM_WORDS_MQ);
+			lengths_prio[q].push_back(1 + rand() % (2*NUM_WORDS_MQ));
+			write_frame(in_prio[q], words_prio[q], lengths_prio[q].back());
+		}
+		numFrames += frames[q];
+	}
+
+	Testbench_qdma_multiqueue(in, out, in_prio, out_prio, tag_prio, numFrames, numFrames);
+
+	// every frame returns to its own queue, in order
+	for (unsigned int q = 0; q < NUM_QUEUES_MQ; q++) {
+		for (unsigned int i = 0; i < words[q].size(); i++) {
+			beat_t const b = out[q].read();
+			if ((b.get_data() != words[q][i]) || (bool(b.get_last()) != (i % NUM_WORDS_MQ == NUM_WORDS_MQ-1))) {
+				cout << "ERROR round-robin: queue " << q << " word " << i << endl;
+				errors++;
+			}
+		}
+	}
+	// all queues filled upfront, the priority arbiter drains them in index order
+	for (unsigned int q = 0; q < NUM_QUEUES_MQ; q++) {
+		unsigned int w = 0;
+		for (unsigned int f = 0; f < frames[q]; f++) {
+			tag_t const t = tag_prio.read();
+			if (t != q) {
+				cout << "ERROR priority: frame " << f << " of queue " << q << " tagged " << t << endl;
+				errors++;
+			}
+			for (unsigned int i = 0; i < lengths_prio[q][f]; i++, w++) {
+				ap_uint<DATA_WIDTH_MQ> const value = out_prio.read();
+				if (value != words_prio[q][w]) {
+					cout << "ERROR priority: queue " << q << " word " << w << endl;
+					errors++;
+				}
+			}
+		}
+	}
+
+	bool empty = out_prio.empty() && tag_prio.empty();
+	for (unsigned int q = 0; q < NUM_QUEUES_MQ; q++)
+		empty &= in[q].empty() && out[q].empty() && in_prio[q].empty();
+	if (!empty) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,20 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_qdma_multiqueue.h"
+
+typedef qdma_axis<DATA_WIDTH_MQ,0,0,0> beat_t;
+typedef QdmaQueueTag<NUM_QUEUES_MQ>::type tag_t;
+
+void Testbench_qdma_multiqueue(stream<beat_t> (&in)[NUM_QUEUES_MQ], stream<beat_t> (&out)[NUM_QUEUES_MQ],
+	stream<beat_t> (&in_prio)[NUM_QUEUES_MQ], stream<ap_uint<DATA_WIDTH_MQ> > & out_prio, stream<tag_t> & tag_prio,
+	unsigned int numFrames, unsigned int numFramesPrio)
+{
+#pragma HLS DATAFLOW
+	stream<ap_uint<DATA_WIDTH_MQ> > data("data");
+	stream<tag_t> tag("tag");
+	Qdma2Stream_Arbiter_Batch<DATA_WIDTH_MQ, NUM_QUEUES_MQ>(in, data, tag, numFrames);
+	Stream2Qdma_Router_Batch<DATA_WIDTH_MQ, NUM_WORDS_MQ, NUM_QUEUES_MQ>(data, tag, out, numFrames);
+	Qdma2Stream_Arbiter_Batch<DATA_WIDTH_MQ, NUM_QUEUES_MQ, true>(in_prio, out_prio, tag_prio, numFramesPrio);
+}
@@ -0,0 +1,180 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file recurrent_tb.cpp
+ *
+ *  Testbench for the recurrent cell with LSTM and GRU gate functions, run
+ *  over two sequences to check that the states restart from zero
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "activations.hpp"
+#include "recurrent.hpp"
+#include "data/config_recurrent.h"
+#include "data/memdata_recurrent.h"
+using namespace hls;
+using namespace std;
+using namespace PARAM_RECURRENT;
+
+#define NUM_SEQUENCES 2
+#define SF_RC (INPUT_SIZE_RC/SIMD_RC)
+#define NF_RC (HIDDEN_SIZE_RC/PE_RC)
+
+void Testbench_recurrent(stream<ap_uint<SIMD_RC*INPUT_PRECISION_RC> > & in_lstm, stream<ap_uint<PE_RC*HIDDEN_PRECISION_RC> > & out_lstm,
+	stream<ap_uint<SIMD_RC*INPUT_PRECISION_RC> > & in_gru, stream<ap_uint<PE_RC*HIDDEN_PRECISION_RC> > & out_gru, unsigned int seqLen);
+
+// Golden model of the gate functions in integer arithmetic
+int lut(int const (&table)[ENTRIES_RC], int const offset, int const shift, int const val)
+{
+	int const idx = (val - offset) >> shift;
+	return table[idx < 0? 0 : idx > ENTRIES_RC-1? ENTRIES_RC-1 : idx];
+}
+
+int saturate(int const val, int const width)
+{
+	int const hi = (1 << (width-1)) - 1;
+	int const lo = -(1 << (width-1));
+	return val > hi? hi : val < lo? lo : val;
+}
+
+int gate_sum(int const (&wx)[HIDDEN_SIZE_RC][INPUT_SIZE_RC], int const (&wh)[HIDDEN_SIZE_RC][HIDDEN_SIZE_RC],
+	int const u, int const (&x)[INPUT_SIZE_RC], int const (&h)[HIDDEN_SIZE_RC], bool const input)
+{
+	int acc = 0;
+	if (input)
+		for (int i = 0; i < INPUT_SIZE_RC; i++)
+			acc += wx[u][i] * x[i];
+	else
+		for (int i = 0; i < HIDDEN_SIZE_RC; i++)
+			acc += wh[u][i] * h[i];
+	return acc;
+}
+
+void lstm_golden(int const (&x)[INPUT_SIZE_RC], int (&h)[HIDDEN_SIZE_RC], int (&c)[HIDDEN_SIZE_RC])
+{
+	int hn[HIDDEN_SIZE_RC];
+	for (int u = 0; u < HIDDEN_SIZE_RC; u++) {
+		int pre[4];
+		for (int g = 0; g < 4; g++)
+			pre[g] = gate_sum(lstm_wx_raw[g], lstm_wh_raw[g], u, x, h, true) + gate_sum(lstm_wx_raw[g], lstm_wh_raw[g], u, x, h, false) + lstm_bias_raw[g][u];
+		int const i = lut(sigmoid_raw, ACC_OFFSET_RC, ACC_SHIFT_RC, pre[0]);
+		int const f = lut(sigmoid_raw, ACC_OFFSET_RC, ACC_SHIFT_RC, pre[1]);
+		int const g = lut(tanh_raw, ACC_OFFSET_RC, ACC_SHIFT_RC, pre[2]);
+		int const o = lut(sigmoid_raw, ACC_OFFSET_RC, ACC_SHIFT_RC, pre[3]);
+		c[u] = saturate((f*c[u] + i*g) >> FRAC_RC, STATE_PRECISION_RC);
+		hn[u] = saturate((o*lut(tanh_state_raw, STATE_OFFSET_RC, STATE_SHIFT_RC, c[u])) >> FRAC_RC, HIDDEN_PRECISION_RC);
+	}
+	for (int u = 0; u < HIDDEN_SIZE_RC; u++)
+		h[u] = hn[u];
+}
+
+void gru_golden(int const (&x)[INPUT_SIZE_RC], int (&h)[HIDDEN_SIZE_RC])
+{
+	int hn[HIDDEN_SIZE_RC];
+	for (int u = 0; u < HIDDEN_SIZE_RC; u++) {
+		int ax[3], ah[3];
+		for (int g = 0; g < 3; g++) {
+			ax[g] = gate_sum(gru_wx_raw[g], gru_wh_raw[g], u, x, h, true);
+			ah[g] = gate_sum(gru_wx_raw[g], gru_wh_raw[g], u, x, h, false);
+		}
+		int const r = lut(sigmoid_raw, ACC_OFFSET_RC, ACC_SHIFT_RC, ax[0] + ah[0] + gru_bias_raw[0][u]);
+		int const z = lut(sigmoid_raw, ACC_OFFSET_RC, ACC_SHIFT_RC, ax[1] + ah[1] + gru_bias_raw[1][u]);
+		int const n = lut(tanh_raw, ACC_OFFSET_RC, ACC_SHIFT_RC, ax[2] + gru_bias_raw[2][u] + ((r*(ah[2] + gru_bias_hn_raw[u])) >> FRAC_RC));
+		hn[u] = saturate((((1 << FRAC_RC) - z)*n + z*h[u]) >> FRAC_RC, HIDDEN_PRECISION_RC);
+	}
+	for (int u = 0; u < HIDDEN_SIZE_RC; u++)
+		h[u] = hn[u];
+}
+
+int main()
+{
+	stream<ap_uint<SIMD_RC*INPUT_PRECISION_RC> > in_lstm("in_lstm"), in_gru("in_gru");
+	stream<ap_uint<PE_RC*HIDDEN_PRECISION_RC> > out_lstm("out_lstm"), out_gru("out_gru");
+	unsigned int errors = 0;
+
+	for (unsigned int seq = 0; seq < NUM_SEQUENCES; seq++) {
+		static int INPUT[SEQ_LEN_RC][INPUT_SIZE_RC];
+		for (unsigned int t = 0; t < SEQ_LEN_RC; t++) {
+			for (unsigned int sf = 0; sf < SF_RC; sf++) {
+				ap_uint<SIMD_RC*INPUT_PRECISION_RC> word;
+				for (unsigned int s = 0; s < SIMD_RC; s++) {
+					ap_int<INPUT_PRECISION_RC> const val = rand();
+					INPUT[t][sf*SIMD_RC + s] = val;
+					word((s+1)*INPUT_PRECISION_RC-1, s*INPUT_PRECISION_RC) = val;
+				}
+				in_lstm.write(word);
+				in_gru.write(word);
+			}
+		}
+
+		Testbench_recurrent(in_lstm, out_lstm, in_gru, out_gru, SEQ_LEN_RC);
+
+		int h_lstm[HIDDEN_SIZE_RC] = {0}, c_lstm[HIDDEN_SIZE_RC] = {0}, h_gru[HIDDEN_SIZE_RC] = {0};
+		for (unsigned int t = 0; t < SEQ_LEN_RC; t++) {
+			lstm_golden(INPUT[t], h_lstm, c_lstm);
+			gru_golden(INPUT[t], h_gru);
+			for (unsigned int nf = 0; nf < NF_RC; nf++) {
+				ap_uint<PE_RC*HIDDEN_PRECISION_RC> const value_lstm = out_lstm.read();
+				ap_uint<PE_RC*HIDDEN_PRECISION_RC> const value_gru = out_gru.read();
+				for (unsigned int pe = 0; pe < PE_RC; pe++) {
+					int const u = nf*PE_RC + pe;
+					ap_int<HIDDEN_PRECISION_RC> const act_lstm = value_lstm((pe+1)*HIDDEN_PRECISION_RC-1, pe*HIDDEN_PRECISION_RC);
+					ap_int<HIDDEN_PRECISION_RC> const act_gru = value_gru((pe+1)*HIDDEN_PRECISION_RC-1, pe*HIDDEN_PRECISION_RC);
+					if (act_lstm != h_lstm[u]) {
+						cout << "ERROR: LSTM sequence " << seq << " step " << t << " unit " << u << " expected " << h_lstm[u] << " actual " << act_lstm << endl;
+						errors++;
+					}
+					if (act_gru != h_gru[u]) {
+						cout << "ERROR: GRU sequence " << seq << " step " << t << " unit " << u << " expected " << h_gru[u] << " actual " << act_gru << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	if (!in_lstm.empty() || !out_lstm.empty() || !in_gru.empty() || !out_gru.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,19 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "recurrent.hpp"
+#include "data/config_recurrent.h"
+#include "data/memdata_recurrent.h"
+
+void Testbench_recurrent(stream<ap_uint<SIMD_RC*INPUT_PRECISION_RC> > & in_lstm, stream<ap_uint<PE_RC*HIDDEN_PRECISION_RC> > & out_lstm,
+	stream<ap_uint<SIMD_RC*INPUT_PRECISION_RC> > & in_gru, stream<ap_uint<PE_RC*HIDDEN_PRECISION_RC> > & out_gru, unsigned int seqLen)
+{
+	Recurrent_Cell_Batch<INPUT_SIZE_RC, HIDDEN_SIZE_RC, SIMD_RC, PE_RC, Slice<ap_int<INPUT_PRECISION_RC> > >
+		(in_lstm, out_lstm, PARAM_RECURRENT::lstm_wx, PARAM_RECURRENT::lstm_wh, PARAM_RECURRENT::lstm_cell, seqLen, ap_resource_dsp());
+	Recurrent_Cell_Batch<INPUT_SIZE_RC, HIDDEN_SIZE_RC, SIMD_RC, PE_RC, Slice<ap_int<INPUT_PRECISION_RC> > >
+		(in_gru, out_gru, PARAM_RECURRENT::gru_wx, PARAM_RECURRENT::gru_wh, PARAM_RECURRENT::gru_cell, seqLen, ap_resource_dsp());
+}
@@ -0,0 +1,16 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_requant.h"
+#include "data/config_requant.h"
+
+void Testbench_requant(stream<ap_uint<PE_RQ*INPUT_PRECISION_RQ> > & in, stream<ap_uint<PE_RQ*OUTPUT_PRECISION_RQ> > & out, unsigned int numReps){
+#pragma HLS ARRAY_PARTITION variable=PARAM_REQUANT::requant.m_multiplier complete dim=1
+#pragma HLS ARRAY_PARTITION variable=PARAM_REQUANT::requant.m_shift complete dim=1
+	Thresholding_Batch<1, Channels_RQ, PE_RQ, Slice<ap_int<INPUT_PRECISION_RQ> >, Slice<ap_int<OUTPUT_PRECISION_RQ> > >
+		(in, out, PARAM_REQUANT::requant, numReps);
+}
@@ -0,0 +1,144 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file residual_block_tb.cpp
+ *
+ *  Testbench for the residual block, with the skip path held on chip and
+ *  spilled to memory
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_residual.h"
+#include "data/config_residual.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 3
+#define NUM_PIXELS_RB (IFMDim_RB*IFMDim_RB)
+#define SKIP_DEPTH_RB (residual_skip_depth<KERNEL_DIM_RB, IFMDim_RB>::value)
+
+// Two 3x3 convolutions over a 5x5 map: the skip path holds 2*((3+1-1)*5 + 4*(1+2)) pixels
+static_assert(SKIP_DEPTH_RB == 54, "Unexpected skip path depth");
+
+void Testbench_residual_block(stream<ap_uint<Channels_RB*INPUT_PRECISION_RB> > & in, stream<ap_uint<Channels_RB*OUTPUT_PRECISION_RB> > & out,
+	stream<ap_uint<Channels_RB*INPUT_PRECISION_RB> > & in_spill, stream<ap_uint<Channels_RB*OUTPUT_PRECISION_RB> > & out_spill,
+	ap_uint<Channels_RB*INPUT_PRECISION_RB> *spill, unsigned int numReps);
+
+// Golden model: convolution with zero padding keeping the map dimension
+void conv_golden(int const (&image)[IFMDim_RB][IFMDim_RB][Channels_RB], int const (&weights)[Channels_RB][KERNEL_DIM_RB*KERNEL_DIM_RB*Channels_RB],
+	int (&result)[IFMDim_RB][IFMDim_RB][Channels_RB])
+{
+	int const pad = (KERNEL_DIM_RB-1)/2 + (KERNEL_DIM_RB-1)%2;
+	for (int y = 0; y < IFMDim_RB; y++)
+		for (int x = 0; x < IFMDim_RB; x++)
+			for (int o = 0; o < Channels_RB; o++) {
+				int acc = 0;
+				for (int ky = 0; ky < KERNEL_DIM_RB; ky++)
+					for (int kx = 0; kx < KERNEL_DIM_RB; kx++) {
+						int const iy = y + ky - pad;
+						int const ix = x + kx - pad;
+						if (iy < 0 || iy >= IFMDim_RB || ix < 0 || ix >= IFMDim_RB)
+							continue;
+						for (int c = 0; c < Channels_RB; c++)
+							acc += weights[o][(ky*KERNEL_DIM_RB + kx)*Channels_RB + c] * image[iy][ix][c];
+					}
+				result[y][x][o] = acc;
+			}
+}
+
+int main()
+{
+	static int IMAGE[NUM_REPEAT][IFMDim_RB][IFMDim_RB][Channels_RB];
+	static ap_uint<Channels_RB*INPUT_PRECISION_RB> spill[residual_spill_depth<KERNEL_DIM_RB, IFMDim_RB>::value];
+	stream<ap_uint<Channels_RB*INPUT_PRECISION_RB> > in("in"), in_spill("in_spill");
+	stream<ap_uint<Channels_RB*OUTPUT_PRECISION_RB> > out("out"), out_spill("out_spill");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int y = 0; y < IFMDim_RB; y++) {
+			for (unsigned int x = 0; x < IFMDim_RB; x++) {
+				ap_uint<Channels_RB*INPUT_PRECISION_RB> word;
+				for (unsigned int c = 0; c < Channels_RB; c++) {
+					ap_uint<INPUT_PRECISION_RB> const act = rand();
+					IMAGE[rep][y][x][c] = act;
+					word((c+1)*INPUT_PRECISION_RB-1, c*INPUT_PRECISION_RB) = act;
+				}
+				in.write(word);
+				in_spill.write(word);
+			}
+		}
+	}
+
+	Testbench_residual_block(in, out, in_spill, out_spill, spill, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		int mid[IFMDim_RB][IFMDim_RB][Channels_RB];
+		int res[IFMDim_RB][IFMDim_RB][Channels_RB];
+		conv_golden(IMAGE[rep], PARAM_RESIDUAL::weights1_raw, mid);
+		conv_golden(mid, PARAM_RESIDUAL::weights2_raw, res);
+		for (unsigned int y = 0; y < IFMDim_RB; y++) {
+			for (unsigned int x = 0; x < IFMDim_RB; x++) {
+				ap_uint<Channels_RB*OUTPUT_PRECISION_RB> const value = out.read();
+				ap_uint<Channels_RB*OUTPUT_PRECISION_RB> const value_spill = out_spill.read();
+				for (unsigned int c = 0; c < Channels_RB; c++) {
+					int const exp = IMAGE[rep][y][x][c] + res[y][x][c];
+					ap_int<OUTPUT_PRECISION_RB> const act = value((c+1)*OUTPUT_PRECISION_RB-1, c*OUTPUT_PRECISION_RB);
+					ap_int<OUTPUT_PRECISION_RB> const act_spill = value_spill((c+1)*OUTPUT_PRECISION_RB-1, c*OUTPUT_PRECISION_RB);
+					if (act != exp) {
+						cout << "ERROR: rep " << rep << " pixel " << y << "," << x << " channel " << c << " expected " << exp << " actual " << act << endl;
+						errors++;
+					}
+					if (act_spill != exp) {
+						cout << "ERROR spill: rep " << rep << " pixel " << y << "," << x << " channel " << c << " expected " << exp << " actual " << act_spill << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	if (!in.empty() || !out.empty() || !in_spill.empty() || !out_spill.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,29 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_residual.h"
+#include "data/config_residual.h"
+
+typedef ap_uint<INPUT_PRECISION_RB> TI_RB;
+typedef ap_int<MID_PRECISION_RB> TM_RB;
+typedef ap_int<RES_PRECISION_RB> TR_RB;
+typedef ap_int<OUTPUT_PRECISION_RB> TO_RB;
+
+void Testbench_residual_block(stream<ap_uint<Channels_RB*INPUT_PRECISION_RB> > & in, stream<ap_uint<Channels_RB*OUTPUT_PRECISION_RB> > & out,
+	stream<ap_uint<Channels_RB*INPUT_PRECISION_RB> > & in_spill, stream<ap_uint<Channels_RB*OUTPUT_PRECISION_RB> > & out_spill,
+	ap_uint<Channels_RB*INPUT_PRECISION_RB> *spill, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	ResidualBlock_Batch<KERNEL_DIM_RB, Channels_RB, IFMDim_RB, SIMD1_RB, PE1_RB, SIMD2_RB, PE2_RB,
+		TI_RB, TM_RB, TR_RB, TO_RB>
+		(in, out, PARAM_RESIDUAL::weights1, PassThroughActivation<TM_RB>(),
+		 PARAM_RESIDUAL::weights2, PassThroughActivation<TR_RB>(), numReps, ap_resource_dsp());
+	ResidualBlock_Spill_Batch<KERNEL_DIM_RB, Channels_RB, IFMDim_RB, SIMD1_RB, PE1_RB, SIMD2_RB, PE2_RB,
+		TI_RB, TM_RB, TR_RB, TO_RB>
+		(in_spill, out_spill, spill, PARAM_RESIDUAL::weights1, PassThroughActivation<TM_RB>(),
+		 PARAM_RESIDUAL::weights2, PassThroughActivation<TR_RB>(), numReps, ap_resource_dsp());
+}
@@ -0,0 +1,165 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file resources_tb.cpp
+ *
+ *  Testbench for the compile-time resource estimates of resources.hpp
+ *
+ *  The estimates of the weight, threshold, sliding window and FIFO memories
+ *  and of the MAC lanes are checked against hand-derived counts. The MVAU of
+ *  resources_top.cpp is folded by Matrix_Vector_Activate_Batch_folding_fit
+ *  within DSP_BUDGET_RS DSP48, beyond checking its output the testbench
+ *  checks that the budget constrained the folding.
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "resources_top.h"
+using namespace hls;
+using namespace std;
+
+// 4 LUTRAM banks of 256x32 bits, 4 BRAM18 of 512x36 or 4 URAM288
+static_assert(ConvolutionInputGenerator_resources<3, 64, 4, 32, 30, 8, 1, ap_resource_bram>().bram18 == 4, "");
+static_assert(ConvolutionInputGenerator_resources<3, 64, 4, 32, 30, 8, 1, ap_resource_uram>().uram == 4, "");
+static_assert(ConvolutionInputGenerator_resources<3, 64, 4, 32, 30, 8, 1, ap_resource_lutram>().lut == 4*4*11*4 + resource_coefficients::SWG_LUT, "");
+static_assert(memory_buffer_resources<ap_uint<32>[4][256], ap_resource_auto>().bram18 == 4, "");
+
+// weight memories: 8 banks of 64x64 bits in LUTRAM, 2 banks of 256x64 bits and 16 banks of 1024x32 bits in two BRAM18 each
+static_assert(detail::memory_resources(64, 64, 8, ap_resource_dflt()).lut == 8*22*4, "");
+static_assert(Matrix_Vector_Activate_Batch_resources<256, 32, 16, 2, 4, 16, FixedPointWeights<16, ap_int<4>, 2, 256>, PassThroughActivation<ap_int<16>>, ap_resource_dsp>().bram18 == 2*2, "");
+static_assert(Matrix_Vector_Activate_Batch_resources<1024, 512, 32, 16, 1, 16, BinaryWeights<32, 16, 1024>, PassThroughActivation<ap_int<16>>, ap_resource_lut>().bram18 == 32, "");
+static_assert(Matrix_Vector_Activate_Batch_resources<1024, 512, 32, 16, 1, 16, BinaryWeights<32, 16, 1024>, PassThroughActivation<ap_int<16>>, ap_resource_lut>().dsp == 0, "");
+
+// MAC lanes: one DSP48 per product, two 4x4 products per DSP48 when packed, 8x8 products are not packed
+static_assert(detail::mac_resources<resource_coefficients>(4, 2, 8, 8, 24, ap_resource_dsp()).dsp == 8, "");
+static_assert(detail::mac_resources<resource_coefficients>(4, 2, 4, 4, 16, ap_resource_dsp_packed()).dsp == 4, "");
+static_assert(detail::mac_resources<resource_coefficients>(4, 2, 8, 8, 24, ap_resource_dsp_packed()).dsp == 8, "");
+static_assert(detail::mac_resources<resource_coefficients>(4, 2, 32, 32, 64, ap_resource_dsp()).dsp == 8*4, "");
+static_assert(detail::adder_tree_bits(4, 8) == 2*9 + 10, "");
+// XNOR popcount of 32 lanes: 32 lanes, a tree of 31 adders from 2 to 6 bits and the accumulator
+static_assert(detail::mac_resources<resource_coefficients>(32, 1, 1, 1, 6, ap_resource_lut()).lut == 32 + (16*2 + 8*3 + 4*4 + 2*5 + 6) + 6, "");
+
+// calibrated coefficients override the defaults
+struct half_mul_coefficients : resource_coefficients {
+	static constexpr double  MUL_LUT = 0.5;
+};
+static_assert(detail::mac_resources<half_mul_coefficients>(4, 1, 4, 4, 8, ap_resource_lut()).lut + 4*8 ==
+	detail::mac_resources<resource_coefficients>(4, 1, 4, 4, 8, ap_resource_lut()).lut, "");
+
+// 24 LUTRAM banks of 4x16 thresholds, 3 comparators of 16 bits and a 3-input adder per PE, or 2 search stages
+static_assert(activation_resources<ThresholdsActivation<4, 8, 3, ap_int<16>, ap_uint<2>>>::value().lut == 24*6*4 + 8*(48 + 5), "");
+static_assert(activation_resources<ThresholdsActivationBinarySearch<4, 8, 3, ap_int<16>, ap_uint<2>>>::value().lut == 24*6*4 + 8*(32 + 2), "");
+
+// FIFOs: 16x32 bits in SRL32, 512x64 bits in two BRAM18
+static_assert(StreamingFIFO_resources<32, 16>().lut == resource_coefficients::FIFO_LUT + 32, "");
+static_assert(StreamingFIFO_resources<64, 512>().bram18 == 2, "");
+
+// the cheapest folding meeting the target needs 128 DSP48, the fastest within the budget has 64 lanes
+static_assert(Matrix_Vector_Activate_Batch_folding<MatrixW_RS, MatrixH_RS>(TARGET_CYCLES_RS, VECTORS_RS).cost() == 128, "");
+static_assert(!FOLDING_RS.meets && (FOLDING_RS.cost() == DSP_BUDGET_RS) && (FOLDING_RS.cycles == 128), "");
+static_assert(Matrix_Vector_Activate_Stream_Batch_resources<MatrixW_RS, MatrixH_RS, SIMD_RS, PE_RS, INPUT_PRECISION_RS, WIDTH_RS, ACTIVATION_PRECISION_RS,
+	PassThroughActivation<ap_int<ACTIVATION_PRECISION_RS>>, ap_resource_dsp>().fits(BUDGET_RS), "");
+static_assert(Matrix_Vector_Activate_Batch_folding_fit<MatrixW_RS, MatrixH_RS, INPUT_PRECISION_RS, WIDTH_RS, ACTIVATION_PRECISION_RS, ap_resource_dsp>
+	(4*TARGET_CYCLES_RS, BUDGET_RS, VECTORS_RS).meets, "");
+
+int main()
+{
+	constexpr unsigned int SF = MatrixW_RS / SIMD_RS;
+	constexpr unsigned int NF = MatrixH_RS / PE_RS;
+	static ap_int<INPUT_PRECISION_RS> IMAGE[MAX_IMAGES_RS][VECTORS_RS][MatrixW_RS];
+	static ap_int<WIDTH_RS> W[MatrixH_RS][MatrixW_RS];
+	stream<ap_uint<SIMD_RS*INPUT_PRECISION_RS> > input_stream("input_stream");
+	stream<ap_uint<PE_RS*SIMD_RS*WIDTH_RS> > weight_stream("weight_stream");
+	stream<ap_uint<PE_RS*ACTIVATION_PRECISION_RS> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES_RS; n_image++)
+		for (unsigned int v = 0; v < VECTORS_RS; v++)
+			for (unsigned int sf = 0; sf < SF; sf++) {
+				ap_uint<SIMD_RS*INPUT_PRECISION_RS> word;
+				for (unsigned int simd = 0; simd < SIMD_RS; simd++) {
+					ap_int<INPUT_PRECISION_RS> const val = (ap_int<INPUT_PRECISION_RS>)rand();
+					IMAGE[n_image][v][sf*SIMD_RS + simd] = val;
+					word((simd+1)*INPUT_PRECISION_RS-1, simd*INPUT_PRECISION_RS) = val;
+				}
+				input_stream.write(word);
+			}
+	for (unsigned int h = 0; h < MatrixH_RS; h++)
+		for (unsigned int c = 0; c < MatrixW_RS; c++)
+			W[h][c] = (ap_int<WIDTH_RS>)rand();
+
+	// the weights are streamed for every input vector
+	for (unsigned int v = 0; v < MAX_IMAGES_RS * VECTORS_RS; v++)
+		for (unsigned int nf = 0; nf < NF; nf++)
+			for (unsigned int sf = 0; sf < SF; sf++) {
+				ap_uint<PE_RS*SIMD_RS*WIDTH_RS> word;
+				for (unsigned int pe = 0; pe < PE_RS; pe++)
+					for (unsigned int simd = 0; simd < SIMD_RS; simd++)
+						word((pe*SIMD_RS + simd + 1)*WIDTH_RS-1, (pe*SIMD_RS + simd)*WIDTH_RS) = W[nf*PE_RS + pe][sf*SIMD_RS + simd];
+				weight_stream.write(word);
+			}
+
+	Testbench_resources(input_stream, weight_stream, output_stream, MAX_IMAGES_RS);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES_RS; n_image++)
+		for (unsigned int v = 0; v < VECTORS_RS; v++)
+			for (unsigned int nf = 0; nf < NF; nf++) {
+				ap_uint<PE_RS*ACTIVATION_PRECISION_RS> const outElem = output_stream.read();
+				for (unsigned int pe = 0; pe < PE_RS; pe++) {
+					unsigned int const h = nf*PE_RS + pe;
+					int exp = 0;
+					for (unsigned int c = 0; c < MatrixW_RS; c++)
+						exp += W[h][c] * IMAGE[n_image][v][c];
+					ap_int<ACTIVATION_PRECISION_RS> const EXP = exp;
+					ap_int<ACTIVATION_PRECISION_RS> out_chan;
+					out_chan(ACTIVATION_PRECISION_RS-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_RS-1, pe*ACTIVATION_PRECISION_RS);
+					if (EXP != out_chan) {
+						std::cout << "ERROR: Image " << n_image << " vector " << v << " Expected[" << h << "]=" << EXP << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+				}
+			}
+	if (!input_stream.empty() || !weight_stream.empty() || !output_stream.empty()) {
+		std::cout << "ERROR: Streams not drained" << std::endl;
+		err_counter++;
+	}
+	std::cout << "Folding SIMD=" << SIMD_RS << " PE=" << PE_RS << " for " << FOLDING_RS.cycles << " cycles per frame" << std::endl;
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
@@ -0,0 +1,16 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "resources_top.h"
+
+void Testbench_resources(stream<ap_uint<SIMD_RS*INPUT_PRECISION_RS> > & in, stream<ap_uint<PE_RS*SIMD_RS*WIDTH_RS> > & weights,
+	stream<ap_uint<PE_RS*ACTIVATION_PRECISION_RS> > & out, unsigned int numReps)
+{
+	Matrix_Vector_Activate_Stream_Batch<MatrixW_RS, MatrixH_RS, SIMD_RS, PE_RS, 1, Slice<ap_int<INPUT_PRECISION_RS> >, Slice<ap_int<ACTIVATION_PRECISION_RS> >, Identity, ap_int<WIDTH_RS> >
+		(in, out, weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_RS>>(), numReps * VECTORS_RS, ap_resource_dsp());
+}
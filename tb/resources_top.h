@@ -0,0 +1,58 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file resources_top.h
+ *
+ *  MVAU folded by Matrix_Vector_Activate_Batch_folding_fit for the resource
+ *  estimation testbench
+ *
+ *****************************************************************************/
+#ifndef RESOURCES_TOP_H
+#define RESOURCES_TOP_H
+
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "resources.hpp"
+#include "data/config_resources.h"
+
+// the DSP48 of the device limited to DSP_BUDGET_RS
+constexpr Resources BUDGET_RS { device::xczu3eg.lut, device::xczu3eg.ff, device::xczu3eg.bram18, device::xczu3eg.uram, DSP_BUDGET_RS };
+constexpr Folding FOLDING_RS = Matrix_Vector_Activate_Batch_folding_fit<MatrixW_RS, MatrixH_RS, INPUT_PRECISION_RS, WIDTH_RS, ACTIVATION_PRECISION_RS, ap_resource_dsp>
+	(TARGET_CYCLES_RS, BUDGET_RS, VECTORS_RS);
+constexpr unsigned SIMD_RS = FOLDING_RS.simd;
+constexpr unsigned PE_RS = FOLDING_RS.pe;
+
+void Testbench_resources(hls::stream<ap_uint<SIMD_RS*INPUT_PRECISION_RS> > & in, hls::stream<ap_uint<PE_RS*SIMD_RS*WIDTH_RS> > & weights,
+	hls::stream<ap_uint<PE_RS*ACTIVATION_PRECISION_RS> > & out, unsigned int numReps);
+
+#endif
@@ -0,0 +1,173 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file roi_align_tb.cpp
+ *
+ *  Testbench for the RoI align, checking bilinear and nearest crops from
+ *  on-chip and external feature maps against a software model, with boxes
+ *  reaching beyond the feature map
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "detection.hpp"
+#include "data/config_roi_align.h"
+using namespace hls;
+using namespace std;
+
+#define NF_RA (CHANNELS_RA / SIMD_RA)
+#define FRAME_WORDS_RA (FMDIM_Y_RA * FMDIM_X_RA * NF_RA)
+#define ONE_RA (1 << FRAC_BITS_RA)
+
+typedef DetectionBox<ap_uint<SCORE_WIDTH_RA>, ap_uint<COORD_WIDTH_RA> > Box_RA;
+typedef ap_uint<SIMD_RA*PRECISION_RA> word_t;
+
+void Testbench_roi_align(stream<word_t> & fm, stream<Box_RA::type> & boxes, stream<word_t> & out,
+	stream<word_t> & fm_nn, stream<Box_RA::type> & boxes_nn, stream<word_t> & out_nn,
+	word_t const *fm_ext, stream<Box_RA::type> & boxes_ext, stream<word_t> & out_ext,
+	unsigned int numReps);
+
+// neighbours and weight of the second one along an axis of Dim pixels, in units of 1/ONE_RA
+static void sample(int lo, int hi, int j, int dim, bool bilinear, int &i0, int &i1, int &w1) {
+	int const pos = lo + ((2*j + 1) * max(hi - lo, 0)) / (2*CROP_DIM_RA);
+	if (!bilinear) {
+		i0 = i1 = min(pos / ONE_RA, dim - 1);
+		w1 = 0;
+		return;
+	}
+	int const s = pos - ONE_RA/2;
+	if (s < 0 || s / ONE_RA >= dim - 1) {
+		i0 = i1 = s < 0? 0 : dim - 1;
+		w1 = 0;
+		return;
+	}
+	i0 = s / ONE_RA;
+	i1 = i0 + 1;
+	w1 = s % ONE_RA;
+}
+
+int main()
+{
+	stream<word_t> fm("fm"), fm_nn("fm_nn");
+	stream<Box_RA::type> boxes("boxes"), boxes_nn("boxes_nn"), boxes_ext("boxes_ext");
+	stream<word_t> out("out"), out_nn("out_nn"), out_ext("out_ext");
+	static int pixels[NUM_REPS_RA][FMDIM_Y_RA][FMDIM_X_RA][CHANNELS_RA];
+	static word_t fm_mem[NUM_REPS_RA * FRAME_WORDS_RA];
+	static int box_coords[NUM_REPS_RA][NUM_BOXES_RA][4];
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPS_RA; rep++) {
+		for (unsigned int y = 0; y < FMDIM_Y_RA; y++) {
+			for (unsigned int x = 0; x < FMDIM_X_RA; x++) {
+				for (unsigned int f = 0; f < NF_RA; f++) {
+					word_t w;
+					for (unsigned int s = 0; s < SIMD_RA; s++) {
+						int const v = rand() % (1 << PRECISION_RA) - (1 << (PRECISION_RA-1));
+						pixels[rep][y][x][f*SIMD_RA + s] = v;
+						w((s+1)*PRECISION_RA-1, s*PRECISION_RA) = ap_int<PRECISION_RA>(v);
+					}
+					fm.write(w);
+					fm_nn.write(w);
+					fm_mem[rep*FRAME_WORDS_RA + (y*FMDIM_X_RA + x)*NF_RA + f] = w;
+				}
+			}
+		}
+		for (unsigned int b = 0; b < NUM_BOXES_RA; b++) {
+			int *const c = box_coords[rep][b];
+			int const max_coord = (1 << COORD_WIDTH_RA) - 1;
+			c[0] = rand() % (FMDIM_X_RA * ONE_RA);
+			c[1] = rand() % (FMDIM_Y_RA * ONE_RA);
+			// may exceed the feature map
+			c[2] = min(c[0] + rand() % (5 * ONE_RA), max_coord);
+			c[3] = min(c[1] + rand() % (5 * ONE_RA), max_coord);
+			Box_RA::type const box = Box_RA::pack(rand(), c[0], c[1], c[2], c[3]);
+			boxes.write(box);
+			boxes_nn.write(box);
+			boxes_ext.write(box);
+		}
+	}
+
+	Testbench_roi_align(fm, boxes, out, fm_nn, boxes_nn, out_nn, fm_mem, boxes_ext, out_ext, NUM_REPS_RA);
+
+	for (unsigned int rep = 0; rep < NUM_REPS_RA; rep++) {
+		for (unsigned int b = 0; b < NUM_BOXES_RA; b++) {
+			int const *const c = box_coords[rep][b];
+			for (unsigned int cy = 0; cy < CROP_DIM_RA; cy++) {
+				for (unsigned int cx = 0; cx < CROP_DIM_RA; cx++) {
+					int bx0, bx1, bwx, by0, by1, bwy, nx, ny, dummy;
+					sample(c[0], c[2], cx, FMDIM_X_RA, true, bx0, bx1, bwx);
+					sample(c[1], c[3], cy, FMDIM_Y_RA, true, by0, by1, bwy);
+					sample(c[0], c[2], cx, FMDIM_X_RA, false, nx, dummy, dummy);
+					sample(c[1], c[3], cy, FMDIM_Y_RA, false, ny, dummy, dummy);
+					for (unsigned int f = 0; f < NF_RA; f++) {
+						word_t const value = out.read();
+						word_t const value_nn = out_nn.read();
+						word_t const value_ext = out_ext.read();
+						for (unsigned int s = 0; s < SIMD_RA; s++) {
+							unsigned int const ch = f*SIMD_RA + s;
+							double const top = pixels[rep][by0][bx0][ch] * double(ONE_RA - bwx) + pixels[rep][by0][bx1][ch] * double(bwx);
+							double const bottom = pixels[rep][by1][bx0][ch] * double(ONE_RA - bwx) + pixels[rep][by1][bx1][ch] * double(bwx);
+							int const expected = int(floor((top * (ONE_RA - bwy) + bottom * bwy) / (ONE_RA * ONE_RA) + 0.5));
+							int const expected_nn = pixels[rep][ny][nx][ch];
+							int const v = ap_int<PRECISION_RA>(value((s+1)*PRECISION_RA-1, s*PRECISION_RA));
+							int const v_nn = ap_int<PRECISION_RA>(value_nn((s+1)*PRECISION_RA-1, s*PRECISION_RA));
+							int const v_ext = ap_int<PRECISION_RA>(value_ext((s+1)*PRECISION_RA-1, s*PRECISION_RA));
+							if (v != expected || v_ext != expected || v_nn != expected_nn) {
+								cout << "ERROR with frame " << rep << " box " << b << " pixel (" << cx << ", " << cy << ") channel " << ch
+								     << " expected " << expected << " / " << expected_nn << " value " << v << " / " << v_nn << ", external " << v_ext << endl;
+								errors++;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if (!fm.empty() || !fm_nn.empty() || !boxes.empty() || !boxes_nn.empty() || !boxes_ext.empty() ||
+	    !out.empty() || !out_nn.empty() || !out_ext.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,23 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "detection.hpp"
+#include "data/config_roi_align.h"
+
+typedef DetectionBox<ap_uint<SCORE_WIDTH_RA>, ap_uint<COORD_WIDTH_RA> > Box_RA;
+
+void Testbench_roi_align(stream<ap_uint<SIMD_RA*PRECISION_RA> > & fm, stream<Box_RA::type> & boxes, stream<ap_uint<SIMD_RA*PRECISION_RA> > & out,
+	stream<ap_uint<SIMD_RA*PRECISION_RA> > & fm_nn, stream<Box_RA::type> & boxes_nn, stream<ap_uint<SIMD_RA*PRECISION_RA> > & out_nn,
+	ap_uint<SIMD_RA*PRECISION_RA> const *fm_ext, stream<Box_RA::type> & boxes_ext, stream<ap_uint<SIMD_RA*PRECISION_RA> > & out_ext,
+	unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi port=fm_ext offset=slave
+	RoIAlign_Batch<FMDIM_X_RA, FMDIM_Y_RA, CHANNELS_RA, SIMD_RA, CROP_DIM_RA, NUM_BOXES_RA, FRAC_BITS_RA, true,
+		ap_int<PRECISION_RA>, ap_uint<SCORE_WIDTH_RA>, ap_uint<COORD_WIDTH_RA> >(fm, boxes, out, numReps);
+	RoIAlign_Batch<FMDIM_X_RA, FMDIM_Y_RA, CHANNELS_RA, SIMD_RA, CROP_DIM_RA, NUM_BOXES_RA, FRAC_BITS_RA, false,
+		ap_int<PRECISION_RA>, ap_uint<SCORE_WIDTH_RA>, ap_uint<COORD_WIDTH_RA> >(fm_nn, boxes_nn, out_nn, numReps, ap_resource_bram());
+	RoIAlign_External_Batch<FMDIM_X_RA, FMDIM_Y_RA, CHANNELS_RA, SIMD_RA, CROP_DIM_RA, NUM_BOXES_RA, FRAC_BITS_RA, true,
+		ap_int<PRECISION_RA>, ap_uint<SCORE_WIDTH_RA>, ap_uint<COORD_WIDTH_RA> >(fm_ext, boxes_ext, out_ext, numReps);
+}
@@ -0,0 +1,174 @@
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Parallel runner of the unit tests.
+#
+#  Every test_<name>.tcl is run by its own Vitis HLS process in the isolated
+#  directory <work>/<name>, with the add_files paths of the script made
+#  absolute, so that tests sharing project names cannot collide. The status,
+#  the elapsed time of csim, csynth and cosim and the cosimulated latency of
+#  every project of a test are collected in a summary printed at the end and
+#  written as CSV and JSON.
+#
+#  Usage (with FINN_HLS_ROOT set and vitis_hls in the PATH):
+#    python3 run_tests.py --jobs 32
+#    python3 run_tests.py swg 'mvau_*' --out results
+#
+import argparse
+import csv
+import fnmatch
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+ADD_FILES = re.compile(r"^(\s*add_files(?:\s+-tb)?\s+)([^\s$/\"][^\s\"]*)", re.M)
+FINISHED = re.compile(r"Finished Command (csim_design|csynth_design|cosim_design)\b.*?Elapsed time: ([0-9.]+) seconds")
+COSIM = re.compile(r"^\|\s*Verilog\|\s*Pass\|\s*(\d+)\|\s*(\d+)\|\s*(\d+)\|", re.M)
+FAILED = ("CSim failed", "C/RTL co-simulation finished: FAIL", "C TB testing failed")
+
+
+def tests(tb, patterns):
+    """Names of the test_<name>.tcl scripts matching any of the patterns."""
+    names = sorted(os.path.basename(f)[5:-4] for f in glob.glob(os.path.join(tb, "test_*.tcl")))
+    return [n for n in names if any(fnmatch.fnmatch(n, p) for p in patterns)]
+
+
+def cosim_latency(workdir):
+    """Max latency of the passing Verilog cosimulation of every project of a test."""
+    latency = {}
+    for rpt in sorted(glob.glob(os.path.join(workdir, "*", "sol1", "sim", "report", "*_cosim.rpt"))):
+        with open(rpt) as fp:
+            m = COSIM.search(fp.read())
+        if m:
+            latency[os.path.basename(rpt)[:-len("_cosim.rpt")]] = int(m.group(3))
+    return latency
+
+
+def run_test(args, name):
+    """Run one test and return its summary row."""
+    workdir = os.path.join(args.work, name)
+    os.makedirs(workdir, exist_ok=True)
+    with open(os.path.join(args.tb, "test_%s.tcl" % name)) as fp:
+        script = ADD_FILES.sub(lambda m: m.group(1) + os.path.join(args.tb, m.group(2)), fp.read())
+    with open(os.path.join(workdir, "test.tcl"), "w") as fp:
+        fp.write(script)
+    row = {"test": name}
+    if args.dry_run:
+        print("%s: %s" % (name, workdir))
+        return row
+    env = dict(os.environ, FINN_HLS_ROOT=args.root)
+    start = time.time()
+    with open(os.path.join(workdir, "vitis_hls.log"), "w") as log:
+        try:
+            rc = subprocess.call([args.hls, "-f", "test.tcl"], cwd=workdir, env=env, stdout=log, stderr=subprocess.STDOUT,
+                timeout=args.timeout or None)
+        except subprocess.TimeoutExpired:
+            rc = None
+    row["seconds"] = round(time.time() - start, 1)
+    with open(os.path.join(workdir, "vitis_hls.log"), errors="replace") as fp:
+        text = fp.read()
+    for step, sec in FINISHED.findall(text):
+        row[step.split("_")[0] + "_s"] = round(row.get(step.split("_")[0] + "_s", 0) + float(sec), 1)
+    latency = cosim_latency(workdir)
+    row["cosim_cycles"] = " ".join("%s=%d" % kv for kv in sorted(latency.items()))
+    if rc is None:
+        row["status"] = "timeout"
+    elif rc != 0 or any(f in text for f in FAILED):
+        row["status"] = "failed"
+    else:
+        row["status"] = "ok"
+    print("%s %s (%.0f s)%s" % ("PASS" if row["status"] == "ok" else "FAIL", name, row["seconds"],
+        "" if row["status"] == "ok" else ", see " + os.path.join(workdir, "vitis_hls.log")))
+    return row
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Parallel runner of the finn-hlslib unit tests")
+    parser.add_argument("tests", nargs="*", default=["*"], help="test names or glob patterns, e.g. swg 'mvau_*' (all by default)")
+    parser.add_argument("--list", action="store_true", help="list the selected tests and exit")
+    parser.add_argument("--dry-run", action="store_true", help="prepare the test directories without running Vitis HLS")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="number of concurrent tests")
+    parser.add_argument("--timeout", type=int, default=0, help="timeout per test in seconds, 0 for none")
+    parser.add_argument("--hls", default="vitis_hls", help="Vitis HLS executable")
+    parser.add_argument("--work", default="test-work", help="directory of the isolated test runs")
+    parser.add_argument("--out", help="prefix of the CSV and JSON summary files, <work>/summary by default")
+    args = parser.parse_args()
+
+    args.tb = os.path.abspath(os.path.dirname(__file__))
+    args.root = os.path.abspath(os.environ.get("FINN_HLS_ROOT", os.path.join(args.tb, "..")))
+    args.work = os.path.abspath(args.work)
+    names = tests(args.tb, args.tests)
+    if not names:
+        print("no test matches %s" % " ".join(args.tests))
+        return 1
+    if args.list:
+        print("\n".join(names))
+        return 0
+
+    # longest tests first, as far as known from the summary of an earlier run
+    out = args.out or os.path.join(args.work, "summary")
+    try:
+        with open(out + ".json") as fp:
+            last = {r["test"]: r.get("seconds", 0) for r in json.load(fp)}
+        names.sort(key=lambda n: -float(last.get(n, sys.maxsize)))
+    except (OSError, ValueError, KeyError):
+        pass
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        rows = list(pool.map(lambda n: run_test(args, n), names))
+    if args.dry_run:
+        return 0
+    rows.sort(key=lambda r: r["test"])
+
+    fields = ["test", "status", "seconds", "csim_s", "csynth_s", "cosim_s", "cosim_cycles"]
+    os.makedirs(os.path.dirname(os.path.abspath(out)), exist_ok=True)
+    with open(out + ".csv", "w", newline="") as fp:
+        writer = csv.DictWriter(fp, fieldnames=fields)
+        writer.writeheader()
+        writer.writerows(rows)
+    with open(out + ".json", "w") as fp:
+        json.dump(rows, fp, indent=1)
+
+    width = max(len(r["test"]) for r in rows)
+    print("\n%-*s  %-7s %8s %8s %8s %8s  %s" % (width, "test", "status", "total_s", "csim_s", "csynth_s", "cosim_s", "cosim_cycles"))
+    for r in rows:
+        print("%-*s  %-7s %8s %8s %8s %8s  %s" % (width, r["test"], r["status"], r.get("seconds", ""),
+            r.get("csim_s", ""), r.get("csynth_s", ""), r.get("cosim_s", ""), r.get("cosim_cycles", "")))
+    failed = [r["test"] for r in rows if r["status"] != "ok"]
+    print("%d tests, %d failed%s, summary in %s.csv and %s.json" % (
+        len(rows), len(failed), (": " + " ".join(failed)) if failed else "", out, out))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,177 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file runtime_tb.cpp
+ *
+ *  Testbench for the host runtime, submitting batches of varying size to the
+ *  C simulation of a Mem2Stream_Batch/Stream2Mem_Batch kernel through the
+ *  asynchronous queue and checking results, completion order and timing
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "host/runtime.hpp"
+#include "data/config_runtime.h"
+using namespace hls;
+using namespace std;
+using namespace finn::host;
+
+void Testbench_runtime(ap_uint<DATA_WIDTH_RT> * in, ap_uint<DATA_WIDTH_RT> * out, unsigned int numReps);
+
+// Calls the kernel on the byte buffers of the host as the AXI4 master sees them, least significant byte first
+static void kernel(void const *in, void *out, unsigned reps) {
+	unsigned const WordBytes = DATA_WIDTH_RT / 8;
+	unsigned const words = reps * IMAGE_BYTES_RT / WordBytes;
+	vector<ap_uint<DATA_WIDTH_RT> > src(words), dst(words);
+	for (unsigned w = 0; w < words; w++)
+		for (unsigned b = 0; b < WordBytes; b++)
+			src[w](8*b + 7, 8*b) = static_cast<unsigned char const*>(in)[w * WordBytes + b];
+	Testbench_runtime(src.data(), dst.data(), reps);
+	for (unsigned w = 0; w < words; w++)
+		for (unsigned b = 0; b < WordBytes; b++)
+			static_cast<unsigned char*>(out)[w * WordBytes + b] = unsigned(dst[w](8*b + 7, 8*b));
+}
+
+// Backend failing the next fail starts of a batch, as the start of an XRT run may throw
+struct FailingBackend : FunctionBackend {
+	unsigned fail = 0;
+	using FunctionBackend::FunctionBackend;
+	run start(buffer &in, buffer &out, unsigned const reps) {
+		if (fail) {
+			fail--;
+			throw runtime_error("start failed");
+		}
+		return FunctionBackend::start(in, out, reps);
+	}
+};
+
+int main()
+{
+	StreamLayout const layout = StreamLayout::of<DATA_WIDTH_RT, IMAGE_BYTES_RT>();
+	static_assert(StreamLayout::of<DATA_WIDTH_RT, IMAGE_BYTES_RT>().words_per_image() == IMAGE_BYTES_RT / (DATA_WIDTH_RT / 8), "");
+
+	FunctionBackend backend(kernel);
+	BufferPool<FunctionBackend> pool(backend, layout, layout, MAX_REPS_RT, SLOTS_RT);
+	atomic<unsigned> errors(0), hooks(0), images(0);
+	atomic<uint64_t> next(0);
+	{
+		Queue<FunctionBackend> queue(backend, pool, DEPTH_RT);
+		queue.on_complete([&](BatchTiming const &t) {
+			if ((t.submitted > t.started) || (t.started > t.completed)) {
+				cout << "ERROR: batch " << t.id << " timing out of order" << endl;
+				errors++;
+			}
+			hooks++;
+		});
+
+		for (unsigned b = 0; b < NUM_BATCHES_RT; b++) {
+			unsigned const reps = 1 + b % MAX_REPS_RT;
+			BufferPool<FunctionBackend>::Slot &slot = pool.acquire();
+			// Images filled in place: word i of image r of batch b holds b << 32 | r << 16 | i
+			for (unsigned r = 0; r < reps; r++) {
+				uint64_t *const img = layout.image<uint64_t>(slot.in_ptr, r);
+				for (unsigned i = 0; i < layout.words_per_image(); i++)
+					img[i] = (uint64_t(b) << 32) | (r << 16) | i;
+			}
+			uint64_t const id = queue.submit(slot, reps, [&, b](BufferPool<FunctionBackend>::Slot &s, BatchTiming const &t) {
+				if ((t.id != b) || (next++ != t.id) || (t.reps != 1 + b % MAX_REPS_RT)) {
+					cout << "ERROR: batch " << b << " completed as " << t.id << " out of order" << endl;
+					errors++;
+				}
+				for (unsigned r = 0; r < t.reps; r++) {
+					uint64_t const *const img = layout.image<uint64_t>(static_cast<void const*>(s.out_ptr), r);
+					for (unsigned i = 0; i < layout.words_per_image(); i++) {
+						uint64_t const expected = ((uint64_t(b) << 32) | (r << 16) | i) + 1;
+						if (img[i] != expected) {
+							cout << "ERROR: batch " << b << " image " << r << " word " << i << " expected " << expected
+								<< " got " << img[i] << endl;
+							errors++;
+						}
+					}
+				}
+				images += t.reps;
+			});
+			if (id != b) {
+				cout << "ERROR: batch " << b << " submitted as " << id << endl;
+				errors++;
+			}
+		}
+		queue.drain();
+		if (queue.retired() != NUM_BATCHES_RT) {
+			cout << "ERROR: " << queue.retired() << " of " << NUM_BATCHES_RT << " batches retired" << endl;
+			errors++;
+		}
+	}
+
+	// A batch failing to start takes no sequence number and returns its slot, the only one of this pool
+	{
+		FailingBackend failing(kernel);
+		BufferPool<FailingBackend> single(failing, layout, layout, 1, 1);
+		Queue<FailingBackend> queue(failing, single, 1);
+		failing.fail = 1;
+		bool thrown = false;
+		try {
+			queue.submit(single.acquire(), 1);
+		}
+		catch (runtime_error const&) {
+			thrown = true;
+		}
+		uint64_t const id = queue.submit(single.acquire(), 1);
+		queue.drain();
+		if (!thrown || (id != 0) || (queue.retired() != 1)) {
+			cout << "ERROR: failed start " << (thrown? "" : "not ") << "thrown, next batch " << id << ", "
+				<< queue.retired() << " batches retired" << endl;
+			errors++;
+		}
+	}
+
+	if (hooks != NUM_BATCHES_RT) {
+		cout << "ERROR: timing hook called " << hooks << " times" << endl;
+		errors++;
+	}
+	cout << images << " images in " << NUM_BATCHES_RT << " batches" << endl;
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
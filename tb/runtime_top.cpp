@@ -0,0 +1,30 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_runtime.h"
+
+constexpr unsigned  WORDS_RT = IMAGE_BYTES_RT / (DATA_WIDTH_RT / 8);
+
+static void runtime_increment(stream<ap_uint<DATA_WIDTH_RT> > & in, stream<ap_uint<DATA_WIDTH_RT> > & out, unsigned int numReps)
+{
+	for(unsigned int i = 0; i < numReps * WORDS_RT; i++) {
+#pragma HLS pipeline II=1
+		out.write(in.read() + 1);
+	}
+}
+
+void Testbench_runtime(ap_uint<DATA_WIDTH_RT> * in, ap_uint<DATA_WIDTH_RT> * out, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi offset=slave port=in bundle=hostmem depth=MAX_REPS_RT*WORDS_RT
+#pragma HLS INTERFACE m_axi offset=slave port=out bundle=hostmem depth=MAX_REPS_RT*WORDS_RT
+#pragma HLS INTERFACE s_axilite port=numReps
+#pragma HLS INTERFACE s_axilite port=return
+#pragma HLS DATAFLOW
+	stream<ap_uint<DATA_WIDTH_RT> > images("images");
+	stream<ap_uint<DATA_WIDTH_RT> > results("results");
+	Mem2Stream_Batch<DATA_WIDTH_RT, IMAGE_BYTES_RT>(in, images, numReps);
+	runtime_increment(images, results, numReps);
+	Stream2Mem_Batch<DATA_WIDTH_RT, IMAGE_BYTES_RT>(results, out, numReps);
+}
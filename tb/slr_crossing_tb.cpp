@@ -0,0 +1,87 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file slr_crossing_tb.cpp
+ *
+ *  Testbench for the SLR crossing, checking that a wide stream passes
+ *  the register hops unchanged
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "cycles.hpp"
+#include "data/config_slr_crossing.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_slr_crossing(stream<ap_uint<WIDTH_SC> > & in, stream<ap_uint<WIDTH_SC> > & out, unsigned int numReps);
+
+int main()
+{
+	stream<ap_uint<WIDTH_SC> > input_stream("input_stream");
+	stream<ap_uint<WIDTH_SC> > output_stream("output_stream");
+	static ap_uint<WIDTH_SC> input[NUM_REPS_SC*NUM_WORDS_SC];
+	unsigned int errors = 0;
+
+	for (unsigned int w = 0; w < NUM_REPS_SC*NUM_WORDS_SC; w++) {
+		for (unsigned int b = 0; b < WIDTH_SC; b += 16) {
+			input[w](b+15, b) = rand();
+		}
+		input_stream.write(input[w]);
+	}
+
+	Testbench_slr_crossing(input_stream, output_stream, NUM_REPS_SC);
+
+	for (unsigned int w = 0; w < NUM_REPS_SC*NUM_WORDS_SC; w++) {
+		ap_uint<WIDTH_SC> const value = output_stream.read();
+		if (value != input[w]) {
+			cout << "ERROR with word " << w << hex << " expected " << input[w] << " value " << value << dec << endl;
+			errors++;
+		}
+	}
+	static_assert(SLRCrossing_Batch_latency<STAGES_SC>() == STAGES_SC, "Unexpected crossing latency");
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
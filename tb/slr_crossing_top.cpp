@@ -0,0 +1,11 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_slr_crossing.h"
+
+void Testbench_slr_crossing(stream<ap_uint<WIDTH_SC> > & in, stream<ap_uint<WIDTH_SC> > & out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	SLRCrossing_Batch<STAGES_SC, NUM_WORDS_SC>(in, out, numReps);
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ *  Copyright (c) 2022, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ * @brief	Testbench for softmax layer.
+ *******************************************************************************/
+#include "softmax_top.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <cmath>
+#include <vector>
+
+template<unsigned  PE, unsigned  FRAC, typename  TI, int  WO>
+unsigned check(
+	std::vector<int> const &x,
+	hls::stream<ap_uint<PE*WO>> &dst,
+	float const  normax
+) {
+	unsigned  mismatches = 0;
+	float  max = x[0];
+	for(int  v : x)  max = std::max(max, float(v));
+	float  sum = 0;
+	for(int  v : x)  sum += std::exp((v - max) / (1<<FRAC));
+	for(unsigned  i = 0; i < FM_SIZE; i += PE) {
+		ap_uint<PE*WO> const  y = dst.read();
+		for(unsigned  pe = 0; pe < PE; pe++) {
+			ap_uint<WO> const  yv  = y((pe+1)*WO-1, pe*WO);
+			float const        ref = normax * std::exp((x[i+pe] - max) / (1<<FRAC)) / sum;
+			bool  const        ok  = std::abs(float(yv) - ref) <= 1.0f;
+			if(!ok)  mismatches++;
+			std::cout << std::setw(4) << x[i+pe] << " -> " << std::setw(4) << yv << " / " << std::setw(8) << ref << '\t' << (ok? '.' : 'X') << std::endl;
+		}
+	}
+	std::cout << "--------------\n" << std::endl;
+	return  mismatches;
+}
+
+int main() {
+	unsigned  mismatches = 0; {
+		std::default_random_engine  rnd;
+		std::uniform_int_distribution<>  dist0(-(1<<(TI0::width-1)), (1<<(TI0::width-1))-1);
+		std::uniform_int_distribution<>  dist1(0, (1<<TI1::width)-1);
+
+		hls::stream<ap_uint<PE0*TI0::width>>  src0("src0");
+		hls::stream<ap_uint<PE0*WO0>>  dst0("dst0");
+		hls::stream<ap_uint<PE1*TI1::width>>  src1("src1");
+		hls::stream<ap_uint<PE1*WO1>>  dst1("dst1");
+		for(unsigned  k = 0; k < 12; k++) {
+			std::vector<int>  x0(FM_SIZE);
+			std::vector<int>  x1(FM_SIZE);
+			for(unsigned  i = 0; i < FM_SIZE; i += PE0) {
+				ap_uint<PE0*TI0::width>  w;
+				for(unsigned  pe = 0; pe < PE0; pe++) {
+					x0[i+pe] = dist0(rnd);
+					w((pe+1)*TI0::width-1, pe*TI0::width) = TI0(x0[i+pe]);
+				}
+				src0.write(w);
+			}
+			for(unsigned  i = 0; i < FM_SIZE; i++) {
+				x1[i] = dist1(rnd);
+				src1.write(x1[i]);
+			}
+
+			softmax_top(src0, dst0, src1, dst1);
+
+			mismatches += check<PE0, FRAC0, TI0, WO0>(x0, dst0, float((1u<<WO0)-1));
+			mismatches += check<PE1, FRAC1, TI1, WO1>(x1, dst1, float(NORMAX1));
+		}
+		if(!dst0.empty() || !dst1.empty())  mismatches++;
+	}
+
+	if(mismatches == 0)  return  0;
+	else {
+		std::cout << mismatches << " output mismatches." << std::endl;
+		return  1;
+	}
+}
@@ -0,0 +1,50 @@
+/******************************************************************************
+ *  Copyright (c) 2022, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ * @brief	Top-level for softmax layer test.
+ *******************************************************************************/
+#include "normalize.hpp"
+#include "softmax_top.hpp"
+
+
+void softmax_top(
+	hls::stream<ap_uint<PE0*TI0::width>> &src0,
+	hls::stream<ap_uint<PE0*WO0>> &dst0,
+	hls::stream<ap_uint<PE1*TI1::width>> &src1,
+	hls::stream<ap_uint<PE1*WO1>> &dst1
+) {
+#pragma HLS interface AXIS port=src0
+#pragma HLS interface AXIS port=dst0
+#pragma HLS interface AXIS port=src1
+#pragma HLS interface AXIS port=dst1
+#pragma HLS dataflow disable_start_propagation
+	softmax<FM_SIZE, PE0, FRAC0, WE0, TI0, WO0>(src0, dst0);
+	softmax<FM_SIZE, PE1, FRAC1, WE1, TI1, WO1, NORMAX1>(src1, dst1);
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+ *  Copyright (c) 2022, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ * @brief	Top-level for softmax layer test.
+ *******************************************************************************/
+#ifndef SOFTMAX_TOP_HPP
+#define SOFTMAX_TOP_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+constexpr unsigned  FM_SIZE = 12;
+
+// Instance 0: signed input, PE-parallel
+using  TI0 = ap_int<6>;
+constexpr unsigned  PE0   = 3;
+constexpr unsigned  FRAC0 = 2;
+constexpr unsigned  WE0   = 12;
+constexpr unsigned  WO0   = 8;
+
+// Instance 1: unsigned input, explicit normalized maximum
+using  TI1 = ap_uint<5>;
+constexpr unsigned  PE1     = 1;
+constexpr unsigned  FRAC1   = 1;
+constexpr unsigned  WE1     = 10;
+constexpr unsigned  WO1     = 7;
+constexpr unsigned  NORMAX1 = 100;
+
+void softmax_top(
+	hls::stream<ap_uint<PE0*TI0::width>> &src0,
+	hls::stream<ap_uint<PE0*WO0>> &dst0,
+	hls::stream<ap_uint<PE1*TI1::width>> &src1,
+	hls::stream<ap_uint<PE1*WO1>> &dst1
+);
+#endif
@@ -0,0 +1,141 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file space_to_depth_tb.cpp
+ *
+ *  Testbench for the space to depth and depth to space blocks, the latter
+ *  restoring the input of the former
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_space_to_depth.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 3
+#define OFMDim_S2D (IFMDim_S2D/BLOCK_S2D)
+#define CF_S2D (Channels_S2D/SIMD_S2D)
+
+void Testbench_space_to_depth(stream<ap_uint<SIMD_S2D*PRECISION_S2D> > & in, stream<ap_uint<SIMD_S2D*PRECISION_S2D> > & out,
+	stream<ap_uint<SIMD_S2D*PRECISION_S2D> > & in_d2s, stream<ap_uint<SIMD_S2D*PRECISION_S2D> > & out_d2s, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<PRECISION_S2D> IMAGE[NUM_REPEAT][IFMDim_S2D][IFMDim_S2D][Channels_S2D];
+	stream<ap_uint<SIMD_S2D*PRECISION_S2D> > in("in"), out("out"), in_d2s("in_d2s"), out_d2s("out_d2s");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int y = 0; y < IFMDim_S2D; y++) {
+			for (unsigned int x = 0; x < IFMDim_S2D; x++) {
+				for (unsigned int cf = 0; cf < CF_S2D; cf++) {
+					ap_uint<SIMD_S2D*PRECISION_S2D> word;
+					for (unsigned int s = 0; s < SIMD_S2D; s++) {
+						ap_uint<PRECISION_S2D> const val = rand();
+						IMAGE[rep][y][x][cf*SIMD_S2D + s] = val;
+						word((s+1)*PRECISION_S2D-1, s*PRECISION_S2D) = val;
+					}
+					in.write(word);
+				}
+			}
+		}
+		// the space to depth result in the order of the golden model
+		for (unsigned int y = 0; y < OFMDim_S2D; y++) {
+			for (unsigned int x = 0; x < OFMDim_S2D; x++) {
+				for (unsigned int by = 0; by < BLOCK_S2D; by++) {
+					for (unsigned int bx = 0; bx < BLOCK_S2D; bx++) {
+						for (unsigned int cf = 0; cf < CF_S2D; cf++) {
+							ap_uint<SIMD_S2D*PRECISION_S2D> word;
+							for (unsigned int s = 0; s < SIMD_S2D; s++)
+								word((s+1)*PRECISION_S2D-1, s*PRECISION_S2D) = IMAGE[rep][y*BLOCK_S2D + by][x*BLOCK_S2D + bx][cf*SIMD_S2D + s];
+							in_d2s.write(word);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	Testbench_space_to_depth(in, out, in_d2s, out_d2s, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int y = 0; y < OFMDim_S2D; y++) {
+			for (unsigned int x = 0; x < OFMDim_S2D; x++) {
+				for (unsigned int c = 0; c < BLOCK_S2D*BLOCK_S2D*CF_S2D; c++) {
+					ap_uint<SIMD_S2D*PRECISION_S2D> const value = out.read();
+					unsigned int const by = c / (BLOCK_S2D*CF_S2D);
+					unsigned int const bx = (c / CF_S2D) % BLOCK_S2D;
+					unsigned int const cf = c % CF_S2D;
+					for (unsigned int s = 0; s < SIMD_S2D; s++) {
+						ap_uint<PRECISION_S2D> const exp = IMAGE[rep][y*BLOCK_S2D + by][x*BLOCK_S2D + bx][cf*SIMD_S2D + s];
+						ap_uint<PRECISION_S2D> const act = value((s+1)*PRECISION_S2D-1, s*PRECISION_S2D);
+						if (act != exp) {
+							cout << "ERROR: space to depth rep " << rep << " pixel " << y << "," << x << " channel " << c*SIMD_S2D + s << " expected " << exp << " actual " << act << endl;
+							errors++;
+						}
+					}
+				}
+			}
+		}
+		for (unsigned int y = 0; y < IFMDim_S2D; y++) {
+			for (unsigned int x = 0; x < IFMDim_S2D; x++) {
+				for (unsigned int cf = 0; cf < CF_S2D; cf++) {
+					ap_uint<SIMD_S2D*PRECISION_S2D> const value = out_d2s.read();
+					for (unsigned int s = 0; s < SIMD_S2D; s++) {
+						ap_uint<PRECISION_S2D> const exp = IMAGE[rep][y][x][cf*SIMD_S2D + s];
+						ap_uint<PRECISION_S2D> const act = value((s+1)*PRECISION_S2D-1, s*PRECISION_S2D);
+						if (act != exp) {
+							cout << "ERROR: depth to space rep " << rep << " pixel " << y << "," << x << " channel " << cf*SIMD_S2D + s << " expected " << exp << " actual " << act << endl;
+							errors++;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if (!in.empty() || !out.empty() || !in_d2s.empty() || !out_d2s.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,13 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_space_to_depth.h"
+
+void Testbench_space_to_depth(stream<ap_uint<SIMD_S2D*PRECISION_S2D> > & in, stream<ap_uint<SIMD_S2D*PRECISION_S2D> > & out,
+	stream<ap_uint<SIMD_S2D*PRECISION_S2D> > & in_d2s, stream<ap_uint<SIMD_S2D*PRECISION_S2D> > & out_d2s, unsigned int numReps)
+{
+	SpaceToDepth_Batch<IFMDim_S2D, BLOCK_S2D, Channels_S2D, SIMD_S2D, ap_uint<PRECISION_S2D> >(in, out, numReps);
+	DepthToSpace_Batch<IFMDim_S2D/BLOCK_S2D, BLOCK_S2D, Channels_S2D, SIMD_S2D, ap_uint<PRECISION_S2D> >(in_d2s, out_d2s, numReps);
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file sparse_mvau_tb.cpp
+ *
+ *  Testbench for the sparse matrix vector activation HLS block
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "weights.hpp"
+#include "bnn-library.h"
+#include "data/memdata_sparse.h"
+#include "data/config_sparse.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 4
+void Testbench_sparse_mvau(stream<ap_uint<SIMD_S*INPUT_PRECISION_S> > & in, stream<ap_uint<PE_S*ACTIVATION_PRECISION_S> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned SF = MatrixW_S / SIMD_S;
+	constexpr unsigned NF = MatrixH_S / PE_S;
+	static ap_uint<INPUT_PRECISION_S> IMAGE[MAX_IMAGES][MatrixW_S];
+	static ap_int<WIDTH_S> W[MatrixH_S][MatrixW_S];
+	stream<ap_uint<SIMD_S*INPUT_PRECISION_S> > input_stream("input_stream");
+	stream<ap_uint<PE_S*ACTIVATION_PRECISION_S> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int sf = 0; sf < SF; sf++) {
+			ap_uint<SIMD_S*INPUT_PRECISION_S> input_word = 0;
+			for (unsigned int simd = 0; simd < SIMD_S; simd++) {
+				ap_uint<INPUT_PRECISION_S> input = (ap_uint<INPUT_PRECISION_S>)rand();
+				IMAGE[n_image][sf*SIMD_S + simd] = input;
+				input_word((simd+1)*INPUT_PRECISION_S-1, simd*INPUT_PRECISION_S) = input;
+			}
+			input_stream.write(input_word);
+		}
+	}
+
+	// expand the sparse weights into the dense matrix
+	for (unsigned int row = 0; row < MatrixH_S; row++)
+		for (unsigned int col = 0; col < MatrixW_S; col++)
+			W[row][col] = 0;
+	unsigned int nf = 0;
+	for (unsigned int tile = 0; tile < NZTILES_S; tile++) {
+		unsigned int const sf = PARAM_SPARSE::weights.synapse(tile);
+		for (unsigned int pe = 0; pe < PE_S; pe++)
+			for (unsigned int simd = 0; simd < SIMD_S; simd++)
+				W[nf*PE_S + pe][sf*SIMD_S + simd] = PARAM_SPARSE::weights.weights(tile)[pe][simd];
+		if (PARAM_SPARSE::weights.last(tile))
+			nf++;
+	}
+	if (nf != NF) {
+		std::cout << "ERROR: Sparse weights describe " << nf << " neuron folds instead of " << NF << std::endl;
+		return 1;
+	}
+
+	Testbench_sparse_mvau(input_stream, output_stream, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_S*ACTIVATION_PRECISION_S> outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_S; pe++) {
+				int exp = 0;
+				for (unsigned int col = 0; col < MatrixW_S; col++)
+					exp += W[nf*PE_S + pe][col] * IMAGE[n_image][col];
+				ap_int<ACTIVATION_PRECISION_S> const EXP = exp;
+				ap_int<ACTIVATION_PRECISION_S> out_chan;
+				out_chan(ACTIVATION_PRECISION_S-1, 0) = outElem((pe+1)*ACTIVATION_PRECISION_S-1, pe*ACTIVATION_PRECISION_S);
+				if (EXP != out_chan) {
+					std::cout << "ERROR: Image " << n_image << " Expected[" << nf*PE_S + pe << "]=" << EXP << " actual " << out_chan << std::endl;
+					err_counter++;
+				}
+			}
+		}
+	}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
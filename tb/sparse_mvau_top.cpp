@@ -0,0 +1,16 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_sparse.h"
+#include "data/config_sparse.h"
+
+void Testbench_sparse_mvau(stream<ap_uint<SIMD_S*INPUT_PRECISION_S> > & in, stream<ap_uint<PE_S*ACTIVATION_PRECISION_S> > & out, unsigned int numReps){
+	Matrix_Vector_Activate_Sparse_Batch<MatrixW_S, MatrixH_S, SIMD_S, PE_S, 1, Slice<ap_uint<INPUT_PRECISION_S> >, Slice<ap_int<ACTIVATION_PRECISION_S> >, Identity>
+		(in, out, PARAM_SPARSE::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_S>>(), numReps, ap_resource_dsp());
+}
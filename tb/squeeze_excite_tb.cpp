@@ -0,0 +1,143 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file squeeze_excite_tb.cpp
+ *
+ *  Testbench for the squeeze-and-excitation block, with the feature map held
+ *  on chip and spilled to memory
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_squeeze_excite.h"
+#include "data/config_squeeze_excite.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 4
+#define NUM_PIXELS_SE (IFMDim_SE*IFMDim_SE)
+#define NF_SE (Channels_SE/PE_SE)
+
+void Testbench_squeeze_excite(stream<ap_uint<PE_SE*INPUT_PRECISION_SE> > & in, stream<ap_uint<PE_SE*OUTPUT_PRECISION_SE> > & out,
+	stream<ap_uint<PE_SE*INPUT_PRECISION_SE> > & in_spill, stream<ap_uint<PE_SE*OUTPUT_PRECISION_SE> > & out_spill,
+	ap_uint<PE_SE*INPUT_PRECISION_SE> *spill, unsigned int numReps);
+
+// Golden model: channel scales of one image
+void se_golden(unsigned const (&image)[NUM_PIXELS_SE][Channels_SE], unsigned (&scale)[Channels_SE])
+{
+	int pooled[Channels_SE];
+	for (unsigned int c = 0; c < Channels_SE; c++) {
+		pooled[c] = 0;
+		for (unsigned int p = 0; p < NUM_PIXELS_SE; p++)
+			pooled[c] += image[p][c];
+	}
+	int mid[Reduced_SE];
+	for (unsigned int r = 0; r < Reduced_SE; r++) {
+		mid[r] = 0;
+		for (unsigned int c = 0; c < Channels_SE; c++)
+			mid[r] += PARAM_SQUEEZE_EXCITE::weights1_raw[r][c] * pooled[c];
+	}
+	for (unsigned int c = 0; c < Channels_SE; c++) {
+		int acc = 0;
+		for (unsigned int r = 0; r < Reduced_SE; r++)
+			acc += PARAM_SQUEEZE_EXCITE::weights2_raw[c][r] * mid[r];
+		int idx = (acc - OFFSET_SE) >> SHIFT_SE;
+		idx = idx < 0? 0 : idx > ENTRIES_SE-1? ENTRIES_SE-1 : idx;
+		scale[c] = PARAM_SQUEEZE_EXCITE::sigmoid.m_table[idx];
+	}
+}
+
+int main()
+{
+	static unsigned IMAGE[NUM_REPEAT][NUM_PIXELS_SE][Channels_SE];
+	static ap_uint<PE_SE*INPUT_PRECISION_SE> spill[2*NUM_PIXELS_SE*NF_SE];
+	stream<ap_uint<PE_SE*INPUT_PRECISION_SE> > in("in"), in_spill("in_spill");
+	stream<ap_uint<PE_SE*OUTPUT_PRECISION_SE> > out("out"), out_spill("out_spill");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int p = 0; p < NUM_PIXELS_SE; p++) {
+			for (unsigned int nf = 0; nf < NF_SE; nf++) {
+				ap_uint<PE_SE*INPUT_PRECISION_SE> word;
+				for (unsigned int pe = 0; pe < PE_SE; pe++) {
+					ap_uint<INPUT_PRECISION_SE> const act = rand();
+					IMAGE[rep][p][nf*PE_SE + pe] = act;
+					word((pe+1)*INPUT_PRECISION_SE-1, pe*INPUT_PRECISION_SE) = act;
+				}
+				in.write(word);
+				in_spill.write(word);
+			}
+		}
+	}
+
+	Testbench_squeeze_excite(in, out, in_spill, out_spill, spill, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		unsigned scale[Channels_SE];
+		se_golden(IMAGE[rep], scale);
+		for (unsigned int p = 0; p < NUM_PIXELS_SE; p++) {
+			for (unsigned int nf = 0; nf < NF_SE; nf++) {
+				ap_uint<PE_SE*OUTPUT_PRECISION_SE> const value = out.read();
+				ap_uint<PE_SE*OUTPUT_PRECISION_SE> const value_spill = out_spill.read();
+				for (unsigned int pe = 0; pe < PE_SE; pe++) {
+					unsigned int const c = nf*PE_SE + pe;
+					unsigned const exp = scale[c] * IMAGE[rep][p][c];
+					unsigned const act = value((pe+1)*OUTPUT_PRECISION_SE-1, pe*OUTPUT_PRECISION_SE);
+					unsigned const act_spill = value_spill((pe+1)*OUTPUT_PRECISION_SE-1, pe*OUTPUT_PRECISION_SE);
+					if (act != exp) {
+						cout << "ERROR: rep " << rep << " pixel " << p << " channel " << c << " expected " << exp << " actual " << act << endl;
+						errors++;
+					}
+					if (act_spill != exp) {
+						cout << "ERROR spill: rep " << rep << " pixel " << p << " channel " << c << " expected " << exp << " actual " << act_spill << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	if (!in.empty() || !out.empty() || !in_spill.empty() || !out_spill.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
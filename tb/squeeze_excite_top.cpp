@@ -0,0 +1,30 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_squeeze_excite.h"
+#include "data/config_squeeze_excite.h"
+
+typedef ap_uint<INPUT_PRECISION_SE> TI_SE;
+typedef ap_uint<ACC_PRECISION_SE> TAcc_SE;
+typedef ap_int<MID_PRECISION_SE> TMid_SE;
+typedef ap_uint<SCALE_PRECISION_SE> TS_SE;
+typedef ap_uint<OUTPUT_PRECISION_SE> TO_SE;
+
+void Testbench_squeeze_excite(stream<ap_uint<PE_SE*INPUT_PRECISION_SE> > & in, stream<ap_uint<PE_SE*OUTPUT_PRECISION_SE> > & out,
+	stream<ap_uint<PE_SE*INPUT_PRECISION_SE> > & in_spill, stream<ap_uint<PE_SE*OUTPUT_PRECISION_SE> > & out_spill,
+	ap_uint<PE_SE*INPUT_PRECISION_SE> *spill, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	SqueezeExcite_Batch<IFMDim_SE*IFMDim_SE, Channels_SE, Reduced_SE, PE_SE, SIMD1_SE, PE1_SE, SIMD2_SE, PE2_SE,
+		TI_SE, TAcc_SE, TMid_SE, TS_SE, TO_SE>
+		(in, out, PARAM_SQUEEZE_EXCITE::weights1, PassThroughActivation<TMid_SE>(),
+		 PARAM_SQUEEZE_EXCITE::weights2, PARAM_SQUEEZE_EXCITE::sigmoid, numReps, ap_resource_dsp());
+	SqueezeExcite_Spill_Batch<IFMDim_SE*IFMDim_SE, Channels_SE, Reduced_SE, PE_SE, SIMD1_SE, PE1_SE, SIMD2_SE, PE2_SE,
+		TI_SE, TAcc_SE, TMid_SE, TS_SE, TO_SE>
+		(in_spill, out_spill, spill, PARAM_SQUEEZE_EXCITE::weights1, PassThroughActivation<TMid_SE>(),
+		 PARAM_SQUEEZE_EXCITE::weights2, PARAM_SQUEEZE_EXCITE::sigmoid, numReps, ap_resource_dsp());
+}
@@ -0,0 +1,110 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file stream2mem_layout_tb.cpp
+ *
+ *  Testbench for the DMA writing frames into interleaved and planar host
+ *  tensor layouts
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_stream2mem_layout.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_stream2mem_layout(stream<ap_uint<DATA_WIDTH_SL> > & in, stream<ap_uint<32> > & bases,
+		ap_uint<DATA_WIDTH_SL> * mem, Stream2MemLayout const layout, int mode, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int GUARD = 0xDEAD;
+	static ap_uint<DATA_WIDTH_SL> MEM[MEM_WORDS_SL];
+	static ap_uint<DATA_WIDTH_SL> EXPECTED[MEM_WORDS_SL];
+	stream<ap_uint<DATA_WIDTH_SL> > input_stream("input_stream");
+	stream<ap_uint<32> > base_stream("base_stream");
+	int err_counter = 0;
+
+	// NHWC with two words of padding per row, frames back to back after an offset;
+	// NCHWc with a padded row and plane, frames scattered over a batch tensor
+	Stream2MemLayout const layouts[2] = {
+		{ 3, 4, 2, 10, 1, 30, 5 },
+		{ 3, 4, 2, 5, 16, 0, 0 }
+	};
+	unsigned int const frame_bases[NUM_REPS_SL] = { 70, 3, 37 };
+
+	for (int mode = 0; mode < 2; mode++) {
+		Stream2MemLayout const &layout = layouts[mode];
+		for (unsigned int i = 0; i < MEM_WORDS_SL; i++) {
+			MEM[i] = GUARD;
+			EXPECTED[i] = GUARD;
+		}
+		for (unsigned int rep = 0; rep < NUM_REPS_SL; rep++) {
+			unsigned int const base = mode == 0? layout.base + rep * layout.frame_stride : frame_bases[rep];
+			if (mode == 1)  base_stream.write(base);
+			for (unsigned int y = 0; y < layout.rows; y++) {
+				for (unsigned int x = 0; x < layout.pixels; x++) {
+					for (unsigned int g = 0; g < layout.groups; g++) {
+						ap_uint<DATA_WIDTH_SL> const word = rand() & 0x7FFF;
+						input_stream.write(word);
+						unsigned int const addr = base + y * layout.row_pitch +
+							(layout.planar()? g * layout.group_stride + x : x * layout.groups + g);
+						EXPECTED[addr] = word;
+					}
+				}
+			}
+		}
+
+		Testbench_stream2mem_layout(input_stream, base_stream, MEM, layout, mode, NUM_REPS_SL);
+
+		for (unsigned int i = 0; i < MEM_WORDS_SL; i++) {
+			if (MEM[i] != EXPECTED[i]) {
+				std::cout << "ERROR: mode " << mode << " word " << i << " expected " << EXPECTED[i] << " actual " << MEM[i] << std::endl;
+				err_counter++;
+			}
+		}
+		if (!input_stream.empty() || !base_stream.empty()) {
+			std::cout << "ERROR: mode " << mode << " streams not empty" << std::endl;
+			err_counter++;
+		}
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return 0;
+}
@@ -0,0 +1,20 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_stream2mem_layout.h"
+
+// mode 0: frames frame_stride apart from base, mode 1: frame bases from a stream
+void Testbench_stream2mem_layout(stream<ap_uint<DATA_WIDTH_SL> > & in, stream<ap_uint<32> > & bases,
+		ap_uint<DATA_WIDTH_SL> * mem, Stream2MemLayout const layout, int mode, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi offset=slave port=mem bundle=hostmem depth=MEM_WORDS_SL max_write_burst_length=MAX_BURST_SL
+#pragma HLS INTERFACE s_axilite port=layout
+#pragma HLS INTERFACE s_axilite port=mode
+#pragma HLS INTERFACE s_axilite port=numReps
+	if (mode == 0)
+		Stream2Mem_Layout_Batch<DATA_WIDTH_SL, MAX_ROW_WORDS_SL, MAX_BURST_SL>(in, mem, layout, numReps);
+	else
+		Stream2Mem_Layout_Batch<DATA_WIDTH_SL, MAX_ROW_WORDS_SL, MAX_BURST_SL>(in, bases, mem, layout, numReps);
+}
@@ -0,0 +1,109 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file stream2mem_variable_tb.cpp
+ *
+ *  Testbench for the variable-length Stream2Mem, writing frames of random
+ *  lengths, empty ones among them, into a ring buffer that wraps around and
+ *  checking the ring buffer and the frame descriptors
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_stream2mem_variable.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_stream2mem_variable(stream<ap_uint<DATA_WIDTH_SV> > & in, stream<ap_uint<32> > & lengths,
+		ap_uint<DATA_WIDTH_SV> * ring, Stream2MemDescriptor::type * desc, unsigned int numReps);
+
+int main()
+{
+	unsigned const WordBytes = DATA_WIDTH_SV / 8;
+	stream<ap_uint<DATA_WIDTH_SV> > input_stream("input_stream");
+	stream<ap_uint<32> > lengths("lengths");
+	ap_uint<DATA_WIDTH_SV> ring[RING_WORDS_SV], expected[RING_WORDS_SV];
+	Stream2MemDescriptor::type desc[NUM_REPS_SV];
+	unsigned offset[NUM_REPS_SV], length[NUM_REPS_SV];
+
+	srand(1);
+	unsigned wr = 0;
+	for (unsigned i = 0; i < RING_WORDS_SV; i++)
+		ring[i] = expected[i] = 0;
+	for (unsigned f = 0; f < NUM_REPS_SV; f++) {
+		desc[f] = 0;
+		length[f] = (f == 2)? 0 : rand() % (MAX_WORDS_SV + 1);
+		offset[f] = wr;
+		lengths.write(length[f]);
+		for (unsigned i = 0; i < length[f]; i++) {
+			ap_uint<DATA_WIDTH_SV> const word = (ap_uint<DATA_WIDTH_SV>(f) << 48) | (ap_uint<DATA_WIDTH_SV>(i) << 32) | rand();
+			input_stream.write(word);
+			expected[wr] = word;
+			if (++wr == RING_WORDS_SV)  wr = 0;
+		}
+	}
+
+	Testbench_stream2mem_variable(input_stream, lengths, ring, desc, NUM_REPS_SV);
+
+	unsigned errors = 0;
+	for (unsigned f = 0; f < NUM_REPS_SV; f++) {
+		if (!Stream2MemDescriptor::valid(desc[f]) || (Stream2MemDescriptor::offset(desc[f]) != offset[f] * WordBytes) ||
+				(Stream2MemDescriptor::length(desc[f]) != length[f] * WordBytes)) {
+			cout << "ERROR: frame " << f << " expected offset " << offset[f] * WordBytes << " length " << length[f] * WordBytes
+				<< ", got offset " << Stream2MemDescriptor::offset(desc[f]) << " length " << Stream2MemDescriptor::length(desc[f])
+				<< (Stream2MemDescriptor::valid(desc[f])? "" : " (invalid)") << endl;
+			errors++;
+		}
+	}
+	for (unsigned i = 0; i < RING_WORDS_SV; i++) {
+		if (ring[i] != expected[i]) {
+			cout << "ERROR: ring buffer word " << i << " expected " << expected[i] << " got " << ring[i] << endl;
+			errors++;
+		}
+	}
+
+	if (!input_stream.empty() || !lengths.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,15 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_stream2mem_variable.h"
+
+void Testbench_stream2mem_variable(stream<ap_uint<DATA_WIDTH_SV> > & in, stream<ap_uint<32> > & lengths,
+		ap_uint<DATA_WIDTH_SV> * ring, Stream2MemDescriptor::type * desc, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi offset=slave port=ring bundle=hostmem depth=RING_WORDS_SV max_write_burst_length=MAX_BURST_SV
+#pragma HLS INTERFACE m_axi offset=slave port=desc bundle=hostmem depth=NUM_REPS_SV
+#pragma HLS INTERFACE s_axilite port=numReps
+	Stream2Mem_Variable_Batch<DATA_WIDTH_SV, MAX_BURST_SV>(in, lengths, ring, RING_WORDS_SV, desc, numReps);
+}
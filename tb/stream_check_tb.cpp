@@ -0,0 +1,128 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file stream_check_tb.cpp
+ *
+ *  Testbench for the csim stream word count checks enabled by
+ *  FINN_STREAM_CHECK, running a residual-style topology with matching,
+ *  too few and too many repetitions of its addition
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "data/config_stream_check.h"
+using namespace hls;
+using namespace std;
+
+#define IN_WIDTH_CK (NUM_CHANNELS_CK * INPUT_WIDTH_CK)
+
+void Testbench_stream_check(stream<ap_uint<IN_WIDTH_CK> > & in, stream<ap_uint<NUM_CHANNELS_CK * OUTPUT_WIDTH_CK> > & out,
+	unsigned int numReps, unsigned int addReps);
+
+static unsigned int run(unsigned int addReps) {
+	stream<ap_uint<IN_WIDTH_CK> > input_stream("input_stream");
+	stream<ap_uint<NUM_CHANNELS_CK * OUTPUT_WIDTH_CK> > output_stream("output_stream");
+	unsigned int errors = 0;
+	for (unsigned int w = 0; w < NUM_REPS_CK*NUM_WORDS_CK; w++) {
+		input_stream.write(rand());
+	}
+	Testbench_stream_check(input_stream, output_stream, NUM_REPS_CK, addReps);
+	if (!input_stream.empty()) {
+		cout << "ERROR: input stream not empty" << endl;
+		errors++;
+	}
+	while (!output_stream.empty()) {
+		output_stream.read();
+	}
+	return errors;
+}
+
+static bool reported(string const &what) {
+	for (string const &r : StreamChecker::instance().reports()) {
+		if (r.find("AddStreams_Batch") != string::npos && r.find(what) != string::npos) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int main()
+{
+	unsigned int errors = 0;
+
+	// matching repetitions pass without a report
+	errors += run(NUM_REPS_CK);
+	if (!StreamChecker::instance().reports().empty()) {
+		cout << "ERROR: reports of a consistent design" << endl;
+		errors++;
+	}
+
+	// too few repetitions of the addition leave words on both of its inputs
+	StreamChecker::instance().reset();
+	errors += run(NUM_REPS_CK - 1);
+	if (StreamChecker::instance().reports().size() != 2 ||
+	    !reported("stream in1 left with " + to_string(NUM_WORDS_CK) + " unread words") ||
+	    !reported("stream in2 left with " + to_string(NUM_WORDS_CK) + " unread words")) {
+		cout << "ERROR: leftover words not reported" << endl;
+		errors++;
+	}
+
+	// too many repetitions stop the simulation before the first read of an empty stream
+	StreamChecker::instance().reset();
+	StreamChecker::instance().fatal(true);
+	bool stopped = false;
+	try {
+		run(NUM_REPS_CK + 1);
+	}
+	catch (runtime_error const &e) {
+		stopped = string(e.what()).find("stream in1 holds " + to_string(NUM_REPS_CK*NUM_WORDS_CK) + " of the " +
+			to_string((NUM_REPS_CK+1)*NUM_WORDS_CK) + " words to be read") != string::npos;
+		cout << "Stopped at " << e.what() << endl;
+	}
+	if (!stopped || !reported("stream in1 holds")) {
+		cout << "ERROR: starved read not reported" << endl;
+		errors++;
+	}
+
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
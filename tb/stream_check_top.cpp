@@ -0,0 +1,23 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_stream_check.h"
+
+#define IN_WIDTH_CK (NUM_CHANNELS_CK * INPUT_WIDTH_CK)
+
+// A residual-style topology whose addition may be given a different number of repetitions
+void Testbench_stream_check(stream<ap_uint<IN_WIDTH_CK> > & in, stream<ap_uint<NUM_CHANNELS_CK * OUTPUT_WIDTH_CK> > & out,
+	unsigned int numReps, unsigned int addReps)
+{
+#pragma HLS DATAFLOW
+	stream<ap_uint<IN_WIDTH_CK> > bypass("bypass");
+	stream<ap_uint<IN_WIDTH_CK> > branch("branch");
+	stream<ap_uint<IN_WIDTH_CK / 2> > narrow("narrow");
+	stream<ap_uint<IN_WIDTH_CK> > wide("wide");
+	DuplicateStreams_Batch<IN_WIDTH_CK, NUM_WORDS_CK>(in, bypass, branch, numReps);
+	StreamingDataWidthConverter_Batch<IN_WIDTH_CK, IN_WIDTH_CK / 2, NUM_WORDS_CK>(branch, narrow, numReps);
+	StreamingDataWidthConverter_Batch<IN_WIDTH_CK / 2, IN_WIDTH_CK, 2 * NUM_WORDS_CK>(narrow, wide, numReps);
+	AddStreams_Batch<NUM_CHANNELS_CK, ap_uint<INPUT_WIDTH_CK>, ap_uint<INPUT_WIDTH_CK>, ap_uint<OUTPUT_WIDTH_CK>, NUM_WORDS_CK>
+		(bypass, wide, out, addReps);
+}
@@ -0,0 +1,107 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file stream_perf_tb.cpp
+ *
+ *  Testbench for the stream performance monitors around a down-converting
+ *  StreamingDataWidthConverter_Batch and for a disabled monitor
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_stream_perf.h"
+using namespace hls;
+using namespace std;
+
+#define RATIO_PC (IN_WIDTH_PC / OUT_WIDTH_PC)
+
+void Testbench_stream_perf(stream<ap_uint<IN_WIDTH_PC> > & in, stream<ap_uint<OUT_WIDTH_PC> > & out,
+	StreamPerfCounters & perf_in, StreamPerfCounters & perf_out, unsigned int numReps);
+
+int main()
+{
+	stream<ap_uint<IN_WIDTH_PC> > input_stream("input_stream");
+	stream<ap_uint<OUT_WIDTH_PC> > output_stream("output_stream");
+	static ap_uint<IN_WIDTH_PC> input[NUM_REPS_PC*NUM_WORDS_PC];
+	StreamPerfCounters perf_in, perf_out;
+	unsigned int errors = 0;
+
+	for (unsigned int w = 0; w < NUM_REPS_PC*NUM_WORDS_PC; w++) {
+		input[w] = rand();
+		input_stream.write(input[w]);
+	}
+
+	Testbench_stream_perf(input_stream, output_stream, perf_in, perf_out, NUM_REPS_PC);
+
+	for (unsigned int w = 0; w < NUM_REPS_PC*NUM_WORDS_PC; w++) {
+		for (unsigned int r = 0; r < RATIO_PC; r++) {
+			ap_uint<OUT_WIDTH_PC> const expected = input[w]((r+1)*OUT_WIDTH_PC-1, r*OUT_WIDTH_PC);
+			ap_uint<OUT_WIDTH_PC> const value = output_stream.read();
+			if (value != expected) {
+				cout << "ERROR with word " << w << " part " << r << hex << " expected " << expected << " value " << value << dec << endl;
+				errors++;
+			}
+		}
+	}
+
+	cout << "input monitor: active " << perf_in.active << ", stalled on input " << perf_in.stall_in << ", on output " << perf_in.stall_out << endl;
+	cout << "output monitor: active " << perf_out.active << ", stalled on input " << perf_out.stall_in << ", on output " << perf_out.stall_out << endl;
+	if (perf_in.active != NUM_REPS_PC*NUM_WORDS_PC || perf_out.active != NUM_REPS_PC*NUM_WORDS_PC*RATIO_PC) {
+		cout << "ERROR: active cycles do not match the words passed" << endl;
+		errors++;
+	}
+
+	// a disabled monitor leaves its counters and output alone and makes the consumer read the input
+	stream<ap_uint<IN_WIDTH_PC> > bypass("bypass"), unused("unused");
+	StreamPerfCounters perf_off = { 7, 7, 7 };
+	bypass.write(input[0]);
+	StreamPerfMonitor_Batch<false, 1>(bypass, unused, perf_off, 1);
+	if (!unused.empty() || &StreamPerfOutput<false>(bypass, unused) != &bypass || perf_off.active != 7 || bypass.read() != input[0]) {
+		cout << "ERROR: disabled monitor is not a bypass" << endl;
+		errors++;
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
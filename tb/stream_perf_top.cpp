@@ -0,0 +1,25 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_stream_perf.h"
+
+#define OUT_WORDS_PC (NUM_WORDS_PC * (IN_WIDTH_PC / OUT_WIDTH_PC))
+
+void Testbench_stream_perf(stream<ap_uint<IN_WIDTH_PC> > & in, stream<ap_uint<OUT_WIDTH_PC> > & out,
+	StreamPerfCounters & perf_in, StreamPerfCounters & perf_out, unsigned int numReps)
+{
+#pragma HLS INTERFACE axis port=in
+#pragma HLS INTERFACE axis port=out
+#pragma HLS INTERFACE s_axilite port=perf_in bundle=control
+#pragma HLS INTERFACE s_axilite port=perf_out bundle=control
+#pragma HLS INTERFACE s_axilite port=numReps bundle=control
+#pragma HLS INTERFACE s_axilite port=return bundle=control
+#pragma HLS DATAFLOW
+	stream<ap_uint<IN_WIDTH_PC> > in_mon("in_mon");
+	stream<ap_uint<OUT_WIDTH_PC> > narrow("narrow");
+	// the down-conversion takes one input word every IN_WIDTH_PC/OUT_WIDTH_PC cycles and stalls the input monitor
+	StreamPerfMonitor_Batch<true, NUM_WORDS_PC>(in, in_mon, perf_in, numReps);
+	StreamingDataWidthConverter_Batch<IN_WIDTH_PC, OUT_WIDTH_PC, NUM_WORDS_PC>(StreamPerfOutput<true>(in, in_mon), narrow, numReps);
+	StreamPerfMonitor_Batch<true, OUT_WORDS_PC>(narrow, out, perf_out, numReps);
+}
@@ -0,0 +1,111 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file stream_profile_tb.cpp
+ *
+ *  Testbench for the csim stream profiler, built with
+ *  FINN_STREAM_PROFILE on an AddStreamsLayer_Batch
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "data/config_stream_profile.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_stream_profile(stream<ap_uint<NUM_CHANNELS_SP * INPUT_WIDTH_SP> > & in1, stream<ap_uint<NUM_CHANNELS_SP * INPUT_WIDTH_SP> > & in2,
+	stream<ap_uint<NUM_CHANNELS_SP * OUTPUT_WIDTH_SP> > & out, unsigned int numReps);
+
+int main()
+{
+	stream<ap_uint<NUM_CHANNELS_SP * INPUT_WIDTH_SP> > input_stream1("input_stream1");
+	stream<ap_uint<NUM_CHANNELS_SP * INPUT_WIDTH_SP> > input_stream2("input_stream2");
+	stream<ap_uint<NUM_CHANNELS_SP * OUTPUT_WIDTH_SP> > output_stream("output_stream");
+	static ap_uint<NUM_CHANNELS_SP * OUTPUT_WIDTH_SP> expected[NUM_REPS_SP*NUM_WORDS_SP];
+	unsigned int errors = 0;
+
+	for (unsigned int w = 0; w < NUM_REPS_SP*NUM_WORDS_SP; w++) {
+		ap_uint<NUM_CHANNELS_SP * INPUT_WIDTH_SP> a, b;
+		for (unsigned int c = 0; c < NUM_CHANNELS_SP; c++) {
+			ap_uint<INPUT_WIDTH_SP> const x = rand(), y = rand();
+			a((c+1)*INPUT_WIDTH_SP-1, c*INPUT_WIDTH_SP) = x;
+			b((c+1)*INPUT_WIDTH_SP-1, c*INPUT_WIDTH_SP) = y;
+			expected[w]((c+1)*OUTPUT_WIDTH_SP-1, c*OUTPUT_WIDTH_SP) = x + y;
+		}
+		input_stream1.write(a);
+		input_stream2.write(b);
+	}
+
+	Testbench_stream_profile(input_stream1, input_stream2, output_stream, NUM_REPS_SP);
+
+	for (unsigned int w = 0; w < NUM_REPS_SP*NUM_WORDS_SP; w++) {
+		ap_uint<NUM_CHANNELS_SP * OUTPUT_WIDTH_SP> const value = output_stream.read();
+		if (value != expected[w]) {
+			cout << "ERROR with word " << w << hex << " expected " << expected[w] << " value " << value << dec << endl;
+			errors++;
+		}
+	}
+
+	// Every folded stream is written completely by its producer before being drained
+	unsigned int const folded = NUM_REPS_SP * NUM_WORDS_SP * (NUM_CHANNELS_SP / PE_SP);
+	ostringstream report;
+	StreamProfiler::instance().report(report);
+	cout << report.str();
+	for (char const *name : { "in_folded1", "in_folded2", "out_folded" }) {
+		ostringstream prefix, counts;
+		prefix << "  AddStreamsLayer_Batch." << name << " [";
+		counts << ", 1, " << folded << ", 0\n";
+		size_t const pos = report.str().find(prefix.str());
+		size_t const end = report.str().find('\n', pos);
+		if ((pos == string::npos) || (report.str().compare(end + 1 - counts.str().size(), counts.str().size(), counts.str()) != 0)) {
+			cout << "ERROR: missing profile entry " << prefix.str() << "..." << counts.str();
+			errors++;
+		}
+	}
+
+	if (!input_stream1.empty() || !input_stream2.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
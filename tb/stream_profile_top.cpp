@@ -0,0 +1,13 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_stream_profile.h"
+
+void Testbench_stream_profile(stream<ap_uint<NUM_CHANNELS_SP * INPUT_WIDTH_SP> > & in1, stream<ap_uint<NUM_CHANNELS_SP * INPUT_WIDTH_SP> > & in2,
+	stream<ap_uint<NUM_CHANNELS_SP * OUTPUT_WIDTH_SP> > & out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	AddStreamsLayer_Batch<NUM_CHANNELS_SP, ap_uint<INPUT_WIDTH_SP>, ap_uint<INPUT_WIDTH_SP>, ap_uint<OUTPUT_WIDTH_SP>, NUM_WORDS_SP, PE_SP>
+		(in1, in2, out, numReps);
+}
@@ -0,0 +1,131 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file stream_stats_tb.cpp
+ *
+ *  Testbench for the stream statistics, checking the passed words, the
+ *  per-channel extrema and the histogram against a software model on an
+ *  input with runs of repeated bins
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_stream_stats.h"
+using namespace hls;
+using namespace std;
+
+#define NF_SS (NUM_CHANNELS_SS / PE_SS)
+#define NUM_WORDS_SS (NUM_REPS_SS * NUM_PIXELS_SS * NF_SS)
+
+typedef ap_int<ELEM_WIDTH_SS> elem_t;
+
+void Testbench_stream_stats(stream<ap_uint<PE_SS*ELEM_WIDTH_SS> > & in, stream<ap_uint<PE_SS*ELEM_WIDTH_SS> > & out,
+	ap_int<ELEM_WIDTH_SS> minimum[NUM_CHANNELS_SS], ap_int<ELEM_WIDTH_SS> maximum[NUM_CHANNELS_SS], ap_uint<32> histogram[BINS_SS],
+	unsigned int numReps);
+
+int main()
+{
+	stream<ap_uint<PE_SS*ELEM_WIDTH_SS> > input_stream("input_stream");
+	stream<ap_uint<PE_SS*ELEM_WIDTH_SS> > output_stream("output_stream");
+	static ap_uint<PE_SS*ELEM_WIDTH_SS> input[NUM_WORDS_SS];
+	elem_t minimum[NUM_CHANNELS_SS], maximum[NUM_CHANNELS_SS];
+	ap_uint<32> histogram[BINS_SS];
+	int expected_min[NUM_CHANNELS_SS], expected_max[NUM_CHANNELS_SS];
+	unsigned int expected_hist[BINS_SS] = { 0 };
+	int const lowest = -(1 << (ELEM_WIDTH_SS-1));
+	int const bin_size = (1 << ELEM_WIDTH_SS) / BINS_SS;
+	unsigned int errors = 0;
+
+	for (unsigned int c = 0; c < NUM_CHANNELS_SS; c++) {
+		expected_min[c] = 1 << ELEM_WIDTH_SS;
+		expected_max[c] = lowest - 1;
+	}
+	int value = 0;
+	for (unsigned int w = 0; w < NUM_WORDS_SS; w++) {
+		ap_uint<PE_SS*ELEM_WIDTH_SS> word;
+		for (unsigned int pe = 0; pe < PE_SS; pe++) {
+			// runs of values in the same bin, sometimes returning to the bin before
+			if (rand() % 3 == 0) {
+				value = lowest + rand() % (1 << ELEM_WIDTH_SS);
+			}
+			else if (rand() % 2) {
+				value = (value - lowest + bin_size) % (1 << ELEM_WIDTH_SS) + lowest;
+			}
+			elem_t const x = value;
+			word((pe+1)*ELEM_WIDTH_SS-1, pe*ELEM_WIDTH_SS) = ap_uint<ELEM_WIDTH_SS>(x);
+			unsigned int const c = (w % NF_SS) * PE_SS + pe;
+			expected_min[c] = min(expected_min[c], value);
+			expected_max[c] = max(expected_max[c], value);
+			expected_hist[(value - lowest) / bin_size]++;
+		}
+		input[w] = word;
+		input_stream.write(word);
+	}
+
+	Testbench_stream_stats(input_stream, output_stream, minimum, maximum, histogram, NUM_REPS_SS);
+
+	for (unsigned int w = 0; w < NUM_WORDS_SS; w++) {
+		ap_uint<PE_SS*ELEM_WIDTH_SS> const value = output_stream.read();
+		if (value != input[w]) {
+			cout << "ERROR with word " << w << hex << " expected " << input[w] << " value " << value << dec << endl;
+			errors++;
+		}
+	}
+	for (unsigned int c = 0; c < NUM_CHANNELS_SS; c++) {
+		if (minimum[c] != expected_min[c] || maximum[c] != expected_max[c]) {
+			cout << "ERROR with channel " << c << " expected range " << expected_min[c] << ".." << expected_max[c]
+			     << " value " << minimum[c] << ".." << maximum[c] << endl;
+			errors++;
+		}
+	}
+	for (unsigned int b = 0; b < BINS_SS; b++) {
+		if (histogram[b] != expected_hist[b]) {
+			cout << "ERROR with bin " << b << " expected " << expected_hist[b] << " value " << histogram[b] << endl;
+			errors++;
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,15 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_stream_stats.h"
+
+void Testbench_stream_stats(stream<ap_uint<PE_SS*ELEM_WIDTH_SS> > & in, stream<ap_uint<PE_SS*ELEM_WIDTH_SS> > & out,
+	ap_int<ELEM_WIDTH_SS> minimum[NUM_CHANNELS_SS], ap_int<ELEM_WIDTH_SS> maximum[NUM_CHANNELS_SS], ap_uint<32> histogram[BINS_SS],
+	unsigned int numReps)
+{
+#pragma HLS INTERFACE s_axilite port=minimum
+#pragma HLS INTERFACE s_axilite port=maximum
+#pragma HLS INTERFACE s_axilite port=histogram
+	StreamStats_Batch<NUM_CHANNELS_SS, PE_SS, NUM_PIXELS_SS, BINS_SS, ap_int<ELEM_WIDTH_SS> >(in, out, minimum, maximum, histogram, numReps);
+}
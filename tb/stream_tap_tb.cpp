@@ -0,0 +1,143 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file stream_tap_tb.cpp
+ *
+ *  Testbench for the stream taps, recording the input of a
+ *  StreamingDataWidthConverter_Batch and checking its output against a
+ *  golden file with one corrupted word
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_stream_tap.h"
+using namespace hls;
+using namespace std;
+
+#define RATIO_ST (IN_WIDTH_ST / OUT_WIDTH_ST)
+#define IN_BYTES_ST (IN_WIDTH_ST / 8)
+
+void Testbench_stream_tap(stream<ap_uint<IN_WIDTH_ST> > & in, stream<ap_uint<OUT_WIDTH_ST> > & out, unsigned int numReps);
+
+int main()
+{
+	stream<ap_uint<IN_WIDTH_ST> > input_stream("input_stream");
+	stream<ap_uint<OUT_WIDTH_ST> > output_stream("output_stream");
+	static ap_uint<IN_WIDTH_ST> input[NUM_REPS_ST*NUM_WORDS_ST];
+	vector<unsigned char> golden;
+	unsigned int errors = 0;
+
+	for (unsigned int w = 0; w < NUM_REPS_ST*NUM_WORDS_ST; w++) {
+		input[w] = rand();
+		input_stream.write(input[w]);
+		for (unsigned int r = 0; r < RATIO_ST; r++) {
+			golden.push_back(input[w]((r+1)*OUT_WIDTH_ST-1, r*OUT_WIDTH_ST));
+		}
+	}
+	golden[CORRUPT_ST] ^= 1;
+	FILE *const f = fopen("stream_tap_golden.bin", "wb");
+	fwrite(golden.data(), 1, golden.size(), f);
+	fclose(f);
+
+	StreamTapper::instance().record(0);
+	StreamTapper::instance().record(1, "stream_tap_record.bin");
+	StreamTapper::instance().compare(1, "stream_tap_golden.bin");
+
+	Testbench_stream_tap(input_stream, output_stream, NUM_REPS_ST);
+
+	for (unsigned int w = 0; w < NUM_REPS_ST*NUM_WORDS_ST; w++) {
+		for (unsigned int r = 0; r < RATIO_ST; r++) {
+			ap_uint<OUT_WIDTH_ST> const expected = input[w]((r+1)*OUT_WIDTH_ST-1, r*OUT_WIDTH_ST);
+			ap_uint<OUT_WIDTH_ST> const value = output_stream.read();
+			if (value != expected) {
+				cout << "ERROR with word " << w << " part " << r << hex << " expected " << expected << " value " << value << dec << endl;
+				errors++;
+			}
+		}
+	}
+
+	StreamTapper::Tap const &tap0 = StreamTapper::instance().tap(0);
+	StreamTapper::Tap const &tap1 = StreamTapper::instance().tap(1);
+	if (tap0.words() == 0) {
+		// the taps are only simulated in csim
+		cout << "Taps not simulated" << endl;
+	}
+	else {
+		if (tap0.words() != NUM_REPS_ST*NUM_WORDS_ST || tap0.data().size() != NUM_REPS_ST*NUM_WORDS_ST*IN_BYTES_ST) {
+			cout << "ERROR: tap 0 recorded " << tap0.words() << " words in " << tap0.data().size() << " bytes" << endl;
+			errors++;
+		}
+		else {
+			for (unsigned int w = 0; w < NUM_REPS_ST*NUM_WORDS_ST; w++) {
+				for (unsigned int b = 0; b < IN_BYTES_ST; b++) {
+					if (tap0.data()[w*IN_BYTES_ST + b] != unsigned(input[w](8*b+7, 8*b))) {
+						cout << "ERROR: tap 0 recorded word " << w << " wrongly" << endl;
+						errors++;
+						break;
+					}
+				}
+			}
+		}
+		if (tap1.first_mismatch() != CORRUPT_ST || tap1.mismatches() != 1) {
+			cout << "ERROR: tap 1 reported " << tap1.mismatches() << " mismatches, the first at " << tap1.first_mismatch() << " instead of " << CORRUPT_ST << endl;
+			errors++;
+		}
+		StreamTapper::instance().flush();
+		FILE *const r = fopen("stream_tap_record.bin", "rb");
+		vector<unsigned char> recorded(golden.size() + 1);
+		size_t const n = r? fread(recorded.data(), 1, recorded.size(), r) : 0;
+		if (r)
+			fclose(r);
+		recorded[CORRUPT_ST] ^= 1;
+		if (n != golden.size() || !equal(golden.begin(), golden.end(), recorded.begin())) {
+			cout << "ERROR: tap 1 wrote " << n << " bytes differing from the golden file" << endl;
+			errors++;
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
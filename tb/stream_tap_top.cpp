@@ -0,0 +1,17 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_stream_tap.h"
+
+#define OUT_WORDS_ST (NUM_WORDS_ST * (IN_WIDTH_ST / OUT_WIDTH_ST))
+
+void Testbench_stream_tap(stream<ap_uint<IN_WIDTH_ST> > & in, stream<ap_uint<OUT_WIDTH_ST> > & out, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	stream<ap_uint<IN_WIDTH_ST> > tapped("tapped");
+	stream<ap_uint<OUT_WIDTH_ST> > narrow("narrow");
+	StreamTap_Batch<0, NUM_WORDS_ST>(in, tapped, numReps);
+	StreamingDataWidthConverter_Batch<IN_WIDTH_ST, OUT_WIDTH_ST, NUM_WORDS_ST>(tapped, narrow, numReps);
+	StreamTap_Batch<1, OUT_WORDS_ST>(narrow, out, numReps);
+}
@@ -0,0 +1,381 @@
+#!/usr/bin/env python3
+#   Copyright (c) 2019, Xilinx, Inc.
+#   All rights reserved.
+# 
+#   Redistribution and use in source and binary forms, with or without 
+#   modification, are permitted provided that the following conditions are met:
+#
+#   1.  Redistributions of source code must retain the above copyright notice, 
+#       this list of conditions and the following disclaimer.
+#
+#   2.  Redistributions in binary form must reproduce the above copyright 
+#       notice, this list of conditions and the following disclaimer in the 
+#       documentation and/or other materials provided with the distribution.
+#
+#   3.  Neither the name of the copyright holder nor the names of its 
+#       contributors may be used to endorse or promote products derived from 
+#       this software without specific prior written permission.
+#
+#   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, 
+#   THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR 
+#   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+#   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+#   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+#   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+#   OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+#   WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+#   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+#   ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Synthesis parameter sweep of the library blocks.
+#
+#  For every point of the parameter grid of a block, a Vitis HLS project is
+#  generated around sweep_top.cpp, synthesized and its csynth report parsed.
+#  The latency, initiation interval, clock estimate and resource estimates
+#  of all points are collected in a CSV and a JSON file. Comparing against
+#  the CSV of an earlier run flags synthesis regressions.
+#
+#  Usage (with FINN_HLS_ROOT set and vitis_hls in the PATH):
+#    python3 sweep.py --blocks mvau swg --jobs 8 --out results
+#    python3 sweep.py --baseline old/results.csv --out results
+#    python3 sweep.py --calibrate results.csv
+#
+#  The calibration fits the logic coefficients of resources.hpp to the MVAU
+#  points of a sweep and prints them as a class to pass to the estimates.
+#
+import argparse
+import csv
+import itertools
+import json
+import os
+import re
+import subprocess
+import sys
+import xml.etree.ElementTree as ET
+from concurrent.futures import ThreadPoolExecutor
+
+# Parameter grids per block: the define selecting the block in sweep_top.cpp,
+# the swept SWEEP_* parameters and a predicate rejecting invalid combinations.
+BLOCKS = {
+    "mvau": {
+        "define": "SWEEP_MVAU",
+        "grid": {
+            "MW": [64], "MH": [32],
+            "SIMD": [1, 4, 16, 64], "PE": [1, 4, 16, 32],
+            "WI": [2, 4, 8], "WW": [2, 4, 8], "WO": [16],
+            "RES": ["ap_resource_lut", "ap_resource_dsp"],
+        },
+        "valid": lambda p: p["MW"] % p["SIMD"] == 0 and p["MH"] % p["PE"] == 0,
+    },
+    "vvau": {
+        "define": "SWEEP_VVAU",
+        "grid": {
+            "CH": [32], "K": [3],
+            "SIMD": [1, 3, 9], "PE": [1, 4, 16, 32],
+            "WI": [4, 8], "WW": [4, 8], "WO": [16],
+            "RES": ["ap_resource_lut", "ap_resource_dsp"],
+        },
+        "valid": lambda p: (p["K"] * p["K"]) % p["SIMD"] == 0 and p["CH"] % p["PE"] == 0,
+    },
+    "swg": {
+        "define": "SWEEP_SWG",
+        "grid": {
+            "K": [3], "CH": [64], "IFM": [32], "STRIDE": [1],
+            "SIMD": [1, 8, 64], "WI": [4, 8],
+            "RES": ["ap_resource_dflt", "ap_resource_lutram", "ap_resource_bram", "ap_resource_uram"],
+        },
+        "valid": lambda p: p["CH"] % p["SIMD"] == 0,
+    },
+    "swg_kernel_stride": {
+        "define": "SWEEP_SWG_KERNEL_STRIDE",
+        "grid": {
+            "K": [3], "CH": [64], "IFM": [33], "STRIDE": [2],
+            "SIMD": [1, 8, 64], "WI": [4, 8],
+            "RES": ["ap_resource_dflt", "ap_resource_bram"],
+        },
+        "valid": lambda p: p["CH"] % p["SIMD"] == 0 and p["K"] % p["STRIDE"] != 0,
+    },
+    "swg_mmv": {
+        "define": "SWEEP_SWG_MMV",
+        "grid": {
+            "K": [3], "CH": [64], "IFM": [32], "STRIDE": [1],
+            "SIMD": [8, 64], "MMV": [1, 2, 5], "WI": [4],
+            "RES": ["ap_resource_dflt", "ap_resource_bram"],
+        },
+        "valid": lambda p: p["CH"] % p["SIMD"] == 0 and ((p["IFM"] - p["K"]) // p["STRIDE"] + 1) % p["MMV"] == 0,
+    },
+    "swg_1d": {
+        "define": "SWEEP_SWG_1D",
+        "grid": {
+            "K": [3, 9], "CH": [64], "IFM": [128], "STRIDE": [1, 2],
+            "SIMD": [1, 8, 64], "WI": [4],
+            "RES": ["ap_resource_dflt", "ap_resource_lutram"],
+        },
+        "valid": lambda p: p["CH"] % p["SIMD"] == 0,
+    },
+    "dwc": {
+        "define": "SWEEP_DWC",
+        "grid": {
+            "IW": [8, 32, 256], "OW": [8, 32, 256], "WORDS": [1024],
+        },
+        "valid": lambda p: max(p["IW"], p["OW"]) % min(p["IW"], p["OW"]) == 0,
+    },
+    "thresholding": {
+        "define": "SWEEP_THRESHOLDING",
+        "grid": {
+            "CH": [64], "PIX": [64],
+            "PE": [1, 4, 16, 64], "WI": [8, 16], "WO": [1, 2, 4],
+        },
+        "valid": lambda p: p["CH"] % p["PE"] == 0,
+    },
+}
+
+# Metrics extracted from the csynth report, compared against a baseline
+METRICS = ["latency_min", "latency_max", "ii_min", "ii_max", "lut", "ff", "bram_18k", "dsp", "uram"]
+
+TCL = """open_project {project}
+add_files {src} -cflags "-std=c++14 -I{root} -I{root}/tb {defines}"
+set_top sweep_top
+open_solution sol1
+set_part {{{part}}}
+create_clock -period {clock} -name default
+csynth_design
+{impl}exit
+"""
+
+
+def points(block):
+    """Valid parameter combinations of a block."""
+    spec = BLOCKS[block]
+    keys = list(spec["grid"])
+    for values in itertools.product(*(spec["grid"][k] for k in keys)):
+        p = dict(zip(keys, values))
+        if spec["valid"](p):
+            yield p
+
+
+def point_name(block, p):
+    return block + "-" + "-".join("%s%s" % (k.lower(), str(v).replace("ap_resource_", "")) for k, v in p.items())
+
+
+def xml_int(node, path):
+    """Integer value of an element, None if absent or not a number (e.g. 'undef')."""
+    e = node.find(path)
+    try:
+        return int(e.text)
+    except (AttributeError, TypeError, ValueError):
+        return None
+
+
+def parse_csynth(xml_file):
+    """Latency, II, clock and resource estimates of a csynth.xml report."""
+    root = ET.parse(xml_file).getroot()
+    perf = root.find("PerformanceEstimates")
+    lat = perf.find("SummaryOfOverallLatency")
+    res = root.find("AreaEstimates/Resources")
+    clock = float(perf.find("SummaryOfTimingAnalysis/EstimatedClockPeriod").text)
+    dsp = xml_int(res, "DSP")
+    if dsp is None:
+        dsp = xml_int(res, "DSP48E")
+    return {
+        "latency_min": xml_int(lat, "Best-caseLatency"),
+        "latency_max": xml_int(lat, "Worst-caseLatency"),
+        "ii_min": xml_int(lat, "Interval-min"),
+        "ii_max": xml_int(lat, "Interval-max"),
+        "clock_est_ns": clock,
+        "fmax_est_mhz": round(1000.0 / clock, 1) if clock > 0 else None,
+        "lut": xml_int(res, "LUT"),
+        "ff": xml_int(res, "FF"),
+        "bram_18k": xml_int(res, "BRAM_18K"),
+        "dsp": dsp,
+        "uram": xml_int(res, "URAM"),
+    }
+
+
+def parse_impl(project):
+    """Post-implementation clock period of an export_design -flow impl run."""
+    rpt_dir = os.path.join(project, "sol1", "impl", "report", "verilog")
+    if not os.path.isdir(rpt_dir):
+        return {}
+    for f in sorted(os.listdir(rpt_dir)):
+        if f.endswith("_export.rpt"):
+            with open(os.path.join(rpt_dir, f)) as fp:
+                m = re.search(r"CP achieved post-implementation:\s*([0-9.]+)", fp.read())
+            if m:
+                cp = float(m.group(1))
+                return {"clock_impl_ns": cp, "fmax_impl_mhz": round(1000.0 / cp, 1)}
+    return {}
+
+
+def run_point(args, block, p):
+    """Synthesize one point and return its result row."""
+    name = point_name(block, p)
+    workdir = os.path.join(args.work, name)
+    os.makedirs(workdir, exist_ok=True)
+    defines = " ".join(["-D" + BLOCKS[block]["define"]] + ["-DSWEEP_%s=%s" % (k, v) for k, v in p.items()])
+    with open(os.path.join(workdir, "sweep.tcl"), "w") as fp:
+        fp.write(TCL.format(
+            project="hls-syn-sweep", src=os.path.join(args.root, "tb", "sweep", "sweep_top.cpp"),
+            root=args.root, defines=defines, part=args.part, clock=args.clock,
+            impl="export_design -flow impl\n" if args.impl else ""))
+    row = dict(block=block, **p)
+    if args.dry_run:
+        print("%s: %s" % (name, defines))
+        return row
+    with open(os.path.join(workdir, "vitis_hls.log"), "w") as log:
+        rc = subprocess.call([args.hls, "-f", "sweep.tcl"], cwd=workdir, stdout=log, stderr=subprocess.STDOUT)
+    project = os.path.join(workdir, "hls-syn-sweep")
+    report = os.path.join(project, "sol1", "syn", "report", "csynth.xml")
+    if rc != 0 or not os.path.isfile(report):
+        row["status"] = "failed"
+        print("FAIL %s, see %s" % (name, os.path.join(workdir, "vitis_hls.log")))
+        return row
+    row["status"] = "ok"
+    row.update(parse_csynth(report))
+    row.update(parse_impl(project))
+    print("DONE %s" % name)
+    return row
+
+
+def compare(rows, baseline_csv, tolerance):
+    """Rows of the baseline whose metrics grew by more than tolerance."""
+    key = lambda r: (r["block"],) + tuple((k, str(r[k])) for k in sorted(r) if k.isupper())
+    with open(baseline_csv) as fp:
+        base = {key(r): r for r in csv.DictReader(fp)}
+    regressions = []
+    for r in rows:
+        b = base.get(key(r))
+        if b is None or r.get("status") != "ok" or b.get("status") != "ok":
+            continue
+        for m in METRICS:
+            if r.get(m) is None or b.get(m) in (None, ""):
+                continue
+            old, new = int(b[m]), int(r[m])
+            if new > old * (1 + tolerance):
+                regressions.append((point_name(r["block"], {k: r[k] for k in r if k.isupper()}), m, old, new))
+    return regressions
+
+
+def adder_tree_bits(n, w):
+    """Adder bits of a balanced tree of n operands of w bits, as detail::adder_tree_bits of resources.hpp."""
+    return 0 if n < 2 else (n // 2) * (w + 1) + adder_tree_bits((n + 1) // 2, w + 1)
+
+
+def product_bits(wi, ww):
+    return wi + ww if ww > 1 else (wi + 1 if wi > 1 else 1)
+
+
+def least_squares(xs, ys):
+    """Solution of the normal equations of xs * c = ys, None if they are singular."""
+    n = len(xs[0])
+    a = [[sum(x[i] * x[j] for x in xs) for j in range(n)] + [sum(x[i] * y for x, y in zip(xs, ys))] for i in range(n)]
+    for i in range(n):
+        piv = max(range(i, n), key=lambda k: abs(a[k][i]))
+        if abs(a[piv][i]) < 1e-9:
+            return None
+        a[i], a[piv] = a[piv], a[i]
+        for k in range(n):
+            if k != i:
+                f = a[k][i] / a[i][i]
+                a[k] = [u - f * v for u, v in zip(a[k], a[i])]
+    return [a[i][n] / a[i][i] for i in range(n)]
+
+
+def calibrate(rows):
+    """Coefficients of resource_coefficients fitted to the LUT and FF counts of the MVAU points.
+
+    The features mirror Matrix_Vector_Activate_Stream_Batch_resources: the LUT
+    multipliers and operand registers of ap_resource_lut lanes, the adder tree
+    and accumulator bits and a constant for the control logic.
+    """
+    lut_x, lut_y, ff_x, ff_y = [], [], [], []
+    for r in rows:
+        if r["block"] != "mvau" or r.get("status") != "ok":
+            continue
+        simd, pe, wi, ww, acc = (int(r[k]) for k in ("SIMD", "PE", "WI", "WW", "WO"))
+        fabric = r["RES"] == "ap_resource_lut"
+        adders = pe * (adder_tree_bits(simd, product_bits(wi, ww)) + acc)
+        lut_x.append([pe * simd * wi * ww if fabric else 0, adders, 1])
+        ff_x.append([pe * simd * (wi + ww) if fabric else 0, adders, 1])
+        lut_y.append(int(r["lut"]))
+        ff_y.append(int(r["ff"]))
+    lut = least_squares(lut_x, lut_y) if lut_x else None
+    ff = least_squares(ff_x, ff_y) if ff_x else None
+    if lut is None or ff is None:
+        return None
+    return "\n".join([
+        "struct calibrated_coefficients : resource_coefficients {",
+        "\tstatic constexpr double  MUL_LUT = %.3f;" % lut[0],
+        "\tstatic constexpr double  ADD_LUT = %.3f;" % lut[1],
+        "\tstatic constexpr double  OPERAND_FF = %.3f;" % ff[0],
+        "\tstatic constexpr double  ADD_FF = %.3f;" % ff[1],
+        "\tstatic constexpr unsigned  MVAU_LUT = %d;" % max(0, round(lut[2])),
+        "\tstatic constexpr unsigned  MVAU_FF = %d;" % max(0, round(ff[2])),
+        "};",
+    ])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Synthesis parameter sweep of the finn-hlslib blocks")
+    parser.add_argument("--blocks", nargs="+", default=sorted(BLOCKS), choices=sorted(BLOCKS), help="blocks to sweep")
+    parser.add_argument("--list", action="store_true", help="list the grid points and exit")
+    parser.add_argument("--dry-run", action="store_true", help="generate the projects without running synthesis")
+    parser.add_argument("--jobs", type=int, default=1, help="number of concurrent synthesis runs")
+    parser.add_argument("--part", default="xczu3eg-sbva484-1-i", help="target part")
+    parser.add_argument("--clock", type=float, default=5.0, help="target clock period in ns")
+    parser.add_argument("--impl", action="store_true", help="also run out-of-context implementation for the achieved Fmax")
+    parser.add_argument("--hls", default="vitis_hls", help="Vitis HLS executable")
+    parser.add_argument("--work", default="sweep-work", help="directory of the generated projects")
+    parser.add_argument("--out", default="sweep", help="prefix of the CSV and JSON result files")
+    parser.add_argument("--baseline", help="CSV of an earlier sweep to check for regressions")
+    parser.add_argument("--tolerance", type=float, default=0.05, help="relative metric growth tolerated against the baseline")
+    parser.add_argument("--calibrate", metavar="CSV", help="fit the coefficients of resources.hpp to the MVAU points of an earlier sweep and exit")
+    args = parser.parse_args()
+
+    if args.calibrate:
+        with open(args.calibrate) as fp:
+            coefficients = calibrate(list(csv.DictReader(fp)))
+        if coefficients is None:
+            print("Too few MVAU points with ap_resource_lut and ap_resource_dsp lanes to calibrate")
+            return 1
+        print(coefficients)
+        return 0
+
+    if args.list:
+        for block in args.blocks:
+            for p in points(block):
+                print(point_name(block, p))
+        return 0
+
+    args.root = os.path.abspath(os.environ.get("FINN_HLS_ROOT", os.path.join(os.path.dirname(__file__), "..", "..")))
+    args.work = os.path.abspath(args.work)
+    todo = [(block, p) for block in args.blocks for p in points(block)]
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        rows = list(pool.map(lambda bp: run_point(args, *bp), todo))
+    if args.dry_run:
+        return 0
+
+    fields = []
+    for r in rows:
+        fields += [k for k in r if k not in fields]
+    with open(args.out + ".csv", "w", newline="") as fp:
+        writer = csv.DictWriter(fp, fieldnames=fields)
+        writer.writeheader()
+        writer.writerows(rows)
+    with open(args.out + ".json", "w") as fp:
+        json.dump(rows, fp, indent=1)
+    print("%d points, %d failed, results in %s.csv and %s.json" % (
+        len(rows), sum(r.get("status") != "ok" for r in rows), args.out, args.out))
+
+    failed = any(r.get("status") != "ok" for r in rows)
+    if args.baseline:
+        regressions = compare(rows, args.baseline, args.tolerance)
+        for name, m, old, new in regressions:
+            print("REGRESSION %s: %s %d -> %d" % (name, m, old, new))
+        failed = failed or bool(regressions)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,146 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file sweep_top.cpp
+ *
+ *  Parametrized top-level for the synthesis sweeps of sweep.py
+ *
+ *  The block is selected by defining SWEEP_<BLOCK> and configured by the
+ *  SWEEP_* macros below, all of which are passed by sweep.py with -D. The
+ *  weights and thresholds are streamed so that the results reflect the
+ *  compute datapath of the block without any parameter memory.
+ *
+ *****************************************************************************/
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+
+#ifndef SWEEP_SIMD
+#define SWEEP_SIMD 1
+#endif
+#ifndef SWEEP_PE
+#define SWEEP_PE 1
+#endif
+#ifndef SWEEP_MMV
+#define SWEEP_MMV 1
+#endif
+#ifndef SWEEP_WI
+#define SWEEP_WI 4
+#endif
+#ifndef SWEEP_WW
+#define SWEEP_WW 4
+#endif
+#ifndef SWEEP_WO
+#define SWEEP_WO 16
+#endif
+#ifndef SWEEP_RES
+#define SWEEP_RES ap_resource_dflt
+#endif
+#ifndef SWEEP_REPS
+#define SWEEP_REPS 1
+#endif
+
+#if defined(SWEEP_MVAU)
+// SWEEP_MW x SWEEP_MH matrix
+void sweep_top(stream<ap_uint<SWEEP_SIMD*SWEEP_WI> > & in, stream<ap_uint<SWEEP_PE*SWEEP_SIMD*SWEEP_WW> > & weights,
+	stream<ap_uint<SWEEP_PE*SWEEP_WO> > & out)
+{
+	Matrix_Vector_Activate_Stream_Batch<SWEEP_MW, SWEEP_MH, SWEEP_SIMD, SWEEP_PE, 1, Slice<ap_int<SWEEP_WI> >, Slice<ap_int<SWEEP_WO> >, Identity, ap_int<SWEEP_WW> >
+		(in, out, weights, PassThroughActivation<ap_int<SWEEP_WO>>(), SWEEP_REPS, SWEEP_RES());
+}
+
+#elif defined(SWEEP_VVAU)
+// SWEEP_CH channels with SWEEP_K x SWEEP_K kernels
+void sweep_top(stream<ap_uint<SWEEP_PE*SWEEP_SIMD*SWEEP_WI> > & in, stream<ap_uint<SWEEP_PE*SWEEP_SIMD*SWEEP_WW> > & weights,
+	stream<ap_uint<SWEEP_PE*SWEEP_WO> > & out)
+{
+	Vector_Vector_Activate_Stream_Batch<SWEEP_CH, SWEEP_K*SWEEP_K, SWEEP_SIMD, SWEEP_PE, 1, Slice<ap_int<SWEEP_WI> >, Slice<ap_int<SWEEP_WO> >, Identity, ap_int<SWEEP_WW> >
+		(in, out, weights, PassThroughActivation<ap_int<SWEEP_WO>>(), SWEEP_REPS, SWEEP_RES());
+}
+
+#elif defined(SWEEP_SWG) || defined(SWEEP_SWG_KERNEL_STRIDE) || defined(SWEEP_SWG_MMV)
+// SWEEP_K x SWEEP_K windows of SWEEP_CH channels over an SWEEP_IFM x SWEEP_IFM input
+constexpr unsigned SWEEP_OFM = (SWEEP_IFM - SWEEP_K) / SWEEP_STRIDE + 1;
+#if defined(SWEEP_SWG_MMV)
+void sweep_top(stream<ap_uint<SWEEP_SIMD*SWEEP_WI> > & in, stream<MultiChanData<SWEEP_MMV, SWEEP_SIMD*SWEEP_WI> > & out)
+{
+	ConvolutionInputGenerator_MMV<SWEEP_K, SWEEP_CH, SWEEP_WI, SWEEP_IFM, SWEEP_OFM, SWEEP_SIMD, SWEEP_STRIDE, SWEEP_MMV>
+		(in, out, SWEEP_REPS, SWEEP_RES());
+}
+#else
+void sweep_top(stream<ap_uint<SWEEP_SIMD*SWEEP_WI> > & in, stream<ap_uint<SWEEP_SIMD*SWEEP_WI> > & out)
+{
+#if defined(SWEEP_SWG)
+	ConvolutionInputGenerator<SWEEP_K, SWEEP_CH, SWEEP_WI, SWEEP_IFM, SWEEP_OFM, SWEEP_SIMD, SWEEP_STRIDE>
+		(in, out, SWEEP_REPS, SWEEP_RES());
+#else
+	ConvolutionInputGenerator_kernel_stride<SWEEP_K, SWEEP_CH, SWEEP_WI, SWEEP_IFM, SWEEP_OFM, SWEEP_SIMD, SWEEP_STRIDE>
+		(in, out, SWEEP_REPS, SWEEP_RES());
+#endif
+}
+#endif
+
+#elif defined(SWEEP_SWG_1D)
+// windows of SWEEP_K elements of SWEEP_CH channels over an input of SWEEP_IFM elements
+constexpr unsigned SWEEP_OFM = (SWEEP_IFM - SWEEP_K) / SWEEP_STRIDE + 1;
+void sweep_top(stream<ap_uint<SWEEP_SIMD*SWEEP_WI> > & in, stream<ap_uint<SWEEP_SIMD*SWEEP_WI> > & out)
+{
+	ConvolutionInputGenerator_1D<SWEEP_K, SWEEP_CH, SWEEP_WI, SWEEP_IFM, SWEEP_OFM, SWEEP_STRIDE, SWEEP_SIMD>
+		(in, out, SWEEP_REPS, SWEEP_RES());
+}
+
+#elif defined(SWEEP_DWC)
+// SWEEP_WORDS input words of SWEEP_IW bits converted to SWEEP_OW bits
+void sweep_top(stream<ap_uint<SWEEP_IW> > & in, stream<ap_uint<SWEEP_OW> > & out)
+{
+	StreamingDataWidthConverter_Batch<SWEEP_IW, SWEEP_OW, SWEEP_WORDS>(in, out, SWEEP_REPS);
+}
+
+#elif defined(SWEEP_THRESHOLDING)
+// SWEEP_CH channels of SWEEP_PIX pixels, thresholded to SWEEP_WO bits
+constexpr unsigned SWEEP_STEPS = (1u << SWEEP_WO) - 1;
+void sweep_top(stream<ap_uint<SWEEP_PE*SWEEP_WI> > & in, stream<ap_uint<SWEEP_PE*SWEEP_STEPS*SWEEP_WI> > & thresholds,
+	stream<ap_uint<SWEEP_PE*SWEEP_WO> > & out)
+{
+	Thresholding_Stream_Batch<SWEEP_PIX, SWEEP_CH, SWEEP_PE, Slice<ap_int<SWEEP_WI> >, Slice<ap_uint<SWEEP_WO> >, 0, ap_int<SWEEP_WI>, SWEEP_STEPS>
+		(in, out, thresholds, SWEEP_REPS);
+}
+
+#else
+#error "Select the swept block by defining one of the SWEEP_<BLOCK> macros."
+#endif
@@ -0,0 +1,141 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file swg_2d_parallel_tb.cpp
+ *
+ *  Testbench for the fully parallel 2D sliding window generator, checking
+ *  unit stride windows of all channels and strided windows in channel folds
+ *  against a software im2col
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_swg_2d_parallel.h"
+using namespace hls;
+using namespace std;
+
+#define WINDOW_SP (KERNEL_DIM_SP*KERNEL_DIM_SP)
+
+void Testbench_swg_2d_parallel(stream<ap_uint<IFM_CHANNELS_SP*INPUT_PRECISION_SP> > & in,
+	stream<ap_uint<WINDOW_SP*IFM_CHANNELS_SP*INPUT_PRECISION_SP> > & out,
+	stream<ap_uint<SIMD_FOLDED_SP*INPUT_PRECISION_SP> > & in_folded,
+	stream<ap_uint<WINDOW_SP*SIMD_FOLDED_SP*INPUT_PRECISION_SP> > & out_folded,
+	unsigned int numReps);
+
+// Windows of one image with SIMD channels per word, by output pixel, fold and tap
+template<unsigned int Channels, unsigned int SIMD, unsigned int IFMDim, unsigned int OFMDim, unsigned int Stride>
+unsigned int check(unsigned int const (&image)[IFMDim][IFMDim][Channels], stream<ap_uint<WINDOW_SP*SIMD*INPUT_PRECISION_SP> > &out, unsigned int rep) {
+	unsigned int errors = 0;
+	for (unsigned int oy = 0; oy < OFMDim; oy++) {
+		for (unsigned int ox = 0; ox < OFMDim; ox++) {
+			for (unsigned int f = 0; f < Channels/SIMD; f++) {
+				ap_uint<WINDOW_SP*SIMD*INPUT_PRECISION_SP> const value = out.read();
+				for (unsigned int ky = 0; ky < KERNEL_DIM_SP; ky++) {
+					for (unsigned int kx = 0; kx < KERNEL_DIM_SP; kx++) {
+						for (unsigned int s = 0; s < SIMD; s++) {
+							unsigned int const lane = (ky*KERNEL_DIM_SP + kx)*SIMD + s;
+							unsigned int const expected = image[oy*Stride + ky][ox*Stride + kx][f*SIMD + s];
+							unsigned int const v = value((lane+1)*INPUT_PRECISION_SP-1, lane*INPUT_PRECISION_SP);
+							if (v != expected) {
+								cout << "ERROR with image " << rep << " pixel (" << ox << ", " << oy << ") fold " << f << " tap (" << kx << ", " << ky
+								     << ") lane " << s << " expected " << expected << " value " << v << endl;
+								errors++;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	return errors;
+}
+
+int main()
+{
+	stream<ap_uint<IFM_CHANNELS_SP*INPUT_PRECISION_SP> > input_stream("input_stream");
+	stream<ap_uint<WINDOW_SP*IFM_CHANNELS_SP*INPUT_PRECISION_SP> > output_stream("output_stream");
+	stream<ap_uint<SIMD_FOLDED_SP*INPUT_PRECISION_SP> > input_folded("input_folded");
+	stream<ap_uint<WINDOW_SP*SIMD_FOLDED_SP*INPUT_PRECISION_SP> > output_folded("output_folded");
+	static unsigned int image[NUM_REPS_SP][IFMDIM_SP][IFMDIM_SP][IFM_CHANNELS_SP];
+	static unsigned int image_folded[NUM_REPS_SP][IFMDIM_FOLDED_SP][IFMDIM_FOLDED_SP][IFM_CHANNELS_FOLDED_SP];
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPS_SP; rep++) {
+		for (unsigned int y = 0; y < IFMDIM_SP; y++) {
+			for (unsigned int x = 0; x < IFMDIM_SP; x++) {
+				ap_uint<IFM_CHANNELS_SP*INPUT_PRECISION_SP> w;
+				for (unsigned int c = 0; c < IFM_CHANNELS_SP; c++) {
+					image[rep][y][x][c] = rand() % (1 << INPUT_PRECISION_SP);
+					w((c+1)*INPUT_PRECISION_SP-1, c*INPUT_PRECISION_SP) = image[rep][y][x][c];
+				}
+				input_stream.write(w);
+			}
+		}
+		for (unsigned int y = 0; y < IFMDIM_FOLDED_SP; y++) {
+			for (unsigned int x = 0; x < IFMDIM_FOLDED_SP; x++) {
+				for (unsigned int f = 0; f < IFM_CHANNELS_FOLDED_SP/SIMD_FOLDED_SP; f++) {
+					ap_uint<SIMD_FOLDED_SP*INPUT_PRECISION_SP> w;
+					for (unsigned int s = 0; s < SIMD_FOLDED_SP; s++) {
+						unsigned int const c = f*SIMD_FOLDED_SP + s;
+						image_folded[rep][y][x][c] = rand() % (1 << INPUT_PRECISION_SP);
+						w((s+1)*INPUT_PRECISION_SP-1, s*INPUT_PRECISION_SP) = image_folded[rep][y][x][c];
+					}
+					input_folded.write(w);
+				}
+			}
+		}
+	}
+
+	Testbench_swg_2d_parallel(input_stream, output_stream, input_folded, output_folded, NUM_REPS_SP);
+
+	for (unsigned int rep = 0; rep < NUM_REPS_SP; rep++) {
+		errors += check<IFM_CHANNELS_SP, IFM_CHANNELS_SP, IFMDIM_SP, OFMDIM_SP, STRIDE_SP>(image[rep], output_stream, rep);
+	}
+	for (unsigned int rep = 0; rep < NUM_REPS_SP; rep++) {
+		errors += check<IFM_CHANNELS_FOLDED_SP, SIMD_FOLDED_SP, IFMDIM_FOLDED_SP, OFMDIM_FOLDED_SP, STRIDE_FOLDED_SP>(image_folded[rep], output_folded, rep);
+	}
+
+	if (!input_stream.empty() || !output_stream.empty() || !input_folded.empty() || !output_folded.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,19 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_swg_2d_parallel.h"
+
+#define WINDOW_SP (KERNEL_DIM_SP*KERNEL_DIM_SP)
+
+void Testbench_swg_2d_parallel(stream<ap_uint<IFM_CHANNELS_SP*INPUT_PRECISION_SP> > & in,
+	stream<ap_uint<WINDOW_SP*IFM_CHANNELS_SP*INPUT_PRECISION_SP> > & out,
+	stream<ap_uint<SIMD_FOLDED_SP*INPUT_PRECISION_SP> > & in_folded,
+	stream<ap_uint<WINDOW_SP*SIMD_FOLDED_SP*INPUT_PRECISION_SP> > & out_folded,
+	unsigned int numReps)
+{
+	ConvolutionInputGenerator_2D_parallel<KERNEL_DIM_SP, IFM_CHANNELS_SP, INPUT_PRECISION_SP, IFMDIM_SP, OFMDIM_SP, STRIDE_SP,
+		IFM_CHANNELS_SP>(in, out, numReps, ap_resource_dflt());
+	ConvolutionInputGenerator_2D_parallel<KERNEL_DIM_SP, IFM_CHANNELS_FOLDED_SP, INPUT_PRECISION_SP, IFMDIM_FOLDED_SP, OFMDIM_FOLDED_SP, STRIDE_FOLDED_SP,
+		SIMD_FOLDED_SP>(in_folded, out_folded, numReps, ap_resource_bram());
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file swg_3d_tb.cpp
+ *
+ *  Testbench for the 3D (spatio-temporal) sliding window generator
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_swg_3d.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_swg_3d(stream<ap_uint<SIMD_3D*INPUT_PRECISION_3D> > & in, stream<ap_uint<SIMD_3D*INPUT_PRECISION_3D> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int CF = IFM_Channels_3D / SIMD_3D;
+	static ap_uint<SIMD_3D*INPUT_PRECISION_3D> IMAGE[MAX_IMAGES][IFMDepth_3D][IFMDim_3D][IFMDim_3D][CF];
+	stream<ap_uint<SIMD_3D*INPUT_PRECISION_3D> > input_stream("input_stream");
+	stream<ap_uint<SIMD_3D*INPUT_PRECISION_3D> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int t = 0; t < IFMDepth_3D; t++)
+		for (unsigned int y = 0; y < IFMDim_3D; y++)
+			for (unsigned int x = 0; x < IFMDim_3D; x++)
+				for (unsigned int cf = 0; cf < CF; cf++) {
+					ap_uint<SIMD_3D*INPUT_PRECISION_3D> const word = ap_uint<SIMD_3D*INPUT_PRECISION_3D>(rand());
+					IMAGE[n_image][t][y][x][cf] = word;
+					input_stream.write(word);
+				}
+
+	Testbench_swg_3d(input_stream, output_stream, MAX_IMAGES);
+
+	// output pixel, kernel frame, kernel row, kernel column, channel fold
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int ot = 0; ot < OFMDepth_3D; ot++)
+		for (unsigned int oy = 0; oy < OFMDim_3D; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_3D; ox++)
+				for (unsigned int kt = 0; kt < KERNEL_DIM_T_3D; kt++)
+				for (unsigned int ky = 0; ky < KERNEL_DIM_3D; ky++)
+					for (unsigned int kx = 0; kx < KERNEL_DIM_3D; kx++)
+						for (unsigned int cf = 0; cf < CF; cf++) {
+							ap_uint<SIMD_3D*INPUT_PRECISION_3D> const exp = IMAGE[n_image][ot*STRIDE_T_3D + kt][oy*STRIDE_3D + ky][ox*STRIDE_3D + kx][cf];
+							ap_uint<SIMD_3D*INPUT_PRECISION_3D> const outElem = output_stream.read();
+							if (exp != outElem) {
+								std::cout << "ERROR: Image " << n_image << " ot= " << ot << " kt= " << kt << " oy= " << oy << " ox= " << ox << " ky= " << ky << " kx= " << kx << " cf= " << cf
+									<< " Expected " << exp << " actual " << outElem << std::endl;
+								return 1;
+							}
+						}
+	if (!output_stream.empty() || !input_stream.empty()) {
+		std::cout << "ERROR: Streams not empty" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,11 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_swg_3d.h"
+
+void Testbench_swg_3d(stream<ap_uint<SIMD_3D*INPUT_PRECISION_3D> > & in, stream<ap_uint<SIMD_3D*INPUT_PRECISION_3D> > & out, unsigned int numReps)
+{
+	ConvolutionInputGenerator_3D<KERNEL_DIM_T_3D, KERNEL_DIM_3D, IFM_Channels_3D, INPUT_PRECISION_3D, IFMDepth_3D, IFMDim_3D, OFMDepth_3D, OFMDim_3D,
+		SIMD_3D, STRIDE_T_3D, STRIDE_3D>(in, out, numReps, ap_resource_dflt());
+}
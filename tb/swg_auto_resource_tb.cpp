@@ -0,0 +1,106 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file swg_auto_resource_tb.cpp
+ *
+ *  Testbench for the sliding window generator with automatic memory resource selection
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "data/config_swg_auto_resource.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 3
+
+// resource selection: shallow buffers to LUTRAM, well filled URAMs preferred over BRAMs
+struct lutram_only_thresholds {
+	static constexpr unsigned  LUTRAM_MAX_DEPTH = 1 << 20;
+	static constexpr unsigned  LUTRAM_MAX_BITS = 0;
+	static constexpr unsigned  URAM_BRAM18_RATIO = 16;
+};
+static_assert(std::is_same<auto_memory_resource<32, 256>::type, ap_resource_lutram>::value, "");
+static_assert(std::is_same<auto_memory_resource<128, 8>::type, ap_resource_lutram>::value, "");
+static_assert(std::is_same<auto_memory_resource<1024, 32>::type, ap_resource_bram>::value, "");
+static_assert(std::is_same<auto_memory_resource<4096, 8>::type, ap_resource_bram>::value, "");
+static_assert(std::is_same<auto_memory_resource<16384, 72>::type, ap_resource_uram>::value, "");
+static_assert(std::is_same<auto_memory_resource<16384, 72, lutram_only_thresholds>::type, ap_resource_lutram>::value, "");
+static_assert(bram18_count(1024, 18) == 1 && bram18_count(2048, 36) == 4 && bram18_count(16384, 3) == 3, "");
+static_assert(memory_geometry<ap_uint<16>[3][100]>::depth == 100 && memory_geometry<ap_uint<16>[3][100]>::banks == 3, "");
+static_assert(memory_geometry<ap_uint<16>[3][100]>::width == 16, "");
+
+void Testbench_swg_auto_resource(stream<ap_uint<SIMD_AR*INPUT_PRECISION_AR> > & in, stream<ap_uint<SIMD_AR*INPUT_PRECISION_AR> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int CF = IFM_Channels_AR / SIMD_AR;
+	static ap_uint<SIMD_AR*INPUT_PRECISION_AR> IMAGE[MAX_IMAGES][IFMDim_AR][IFMDim_AR][CF];
+	stream<ap_uint<SIMD_AR*INPUT_PRECISION_AR> > input_stream("input_stream");
+	stream<ap_uint<SIMD_AR*INPUT_PRECISION_AR> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int y = 0; y < IFMDim_AR; y++)
+			for (unsigned int x = 0; x < IFMDim_AR; x++)
+				for (unsigned int cf = 0; cf < CF; cf++) {
+					ap_uint<SIMD_AR*INPUT_PRECISION_AR> const word = ap_uint<SIMD_AR*INPUT_PRECISION_AR>(rand());
+					IMAGE[n_image][y][x][cf] = word;
+					input_stream.write(word);
+				}
+
+	Testbench_swg_auto_resource(input_stream, output_stream, MAX_IMAGES);
+
+	// same order as ConvolutionInputGenerator: output pixel, kernel row, kernel column, channel fold
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int oy = 0; oy < OFMDim_AR; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_AR; ox++)
+				for (unsigned int ky = 0; ky < KERNEL_DIM_AR; ky++)
+					for (unsigned int kx = 0; kx < KERNEL_DIM_AR; kx++)
+						for (unsigned int cf = 0; cf < CF; cf++) {
+							ap_uint<SIMD_AR*INPUT_PRECISION_AR> const exp = IMAGE[n_image][oy*STRIDE_AR + ky][ox*STRIDE_AR + kx][cf];
+							ap_uint<SIMD_AR*INPUT_PRECISION_AR> const outElem = output_stream.read();
+							if (exp != outElem) {
+								std::cout << "ERROR: Image " << n_image << " oy= " << oy << " ox= " << ox << " ky= " << ky << " kx= " << kx << " cf= " << cf
+									<< " Expected " << exp << " actual " << outElem << std::endl;
+								return 1;
+							}
+						}
+	if (!output_stream.empty() || !input_stream.empty()) {
+		std::cout << "ERROR: Streams not empty" << std::endl;
+		return 1;
+	}
+	return 0;
+}
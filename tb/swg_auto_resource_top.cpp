@@ -0,0 +1,11 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_swg_auto_resource.h"
+
+void Testbench_swg_auto_resource(stream<ap_uint<SIMD_AR*INPUT_PRECISION_AR> > & in, stream<ap_uint<SIMD_AR*INPUT_PRECISION_AR> > & out, unsigned int numReps)
+{
+	ConvolutionInputGenerator<KERNEL_DIM_AR, IFM_Channels_AR, INPUT_PRECISION_AR, IFMDim_AR, OFMDim_AR, SIMD_AR, STRIDE_AR>
+		(in, out, numReps, ap_resource_auto());
+}
@@ -0,0 +1,133 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file swg_dilated_tb.cpp
+ *
+ *  Testbench for the dilated standard, MMV and depthwise sliding window generators
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "mmv.hpp"
+#include "data/config_swg_dilated.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_swg_dilated(stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > & in, stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > & in_mmv,
+	stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > & in_dws, stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > & out,
+	stream<MultiChanData<MMV_DL, SIMD_DL*INPUT_PRECISION_DL> > & out_mmv, stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > & out_dws, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int CF = IFM_Channels_DL / SIMD_DL;
+	static ap_uint<SIMD_DL*INPUT_PRECISION_DL> IMAGE[MAX_IMAGES][IFMDim_DL][IFMDim_DL][CF];
+	stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > input_stream("input_stream");
+	stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > input_stream_mmv("input_stream_mmv");
+	stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > input_stream_dws("input_stream_dws");
+	stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > output_stream("output_stream");
+	stream<MultiChanData<MMV_DL, SIMD_DL*INPUT_PRECISION_DL> > output_stream_mmv("output_stream_mmv");
+	stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > output_stream_dws("output_stream_dws");
+	unsigned int err_counter = 0;
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int y = 0; y < IFMDim_DL; y++)
+			for (unsigned int x = 0; x < IFMDim_DL; x++)
+				for (unsigned int cf = 0; cf < CF; cf++) {
+					ap_uint<SIMD_DL*INPUT_PRECISION_DL> const word = ap_uint<SIMD_DL*INPUT_PRECISION_DL>(rand());
+					IMAGE[n_image][y][x][cf] = word;
+					input_stream.write(word);
+					input_stream_mmv.write(word);
+					input_stream_dws.write(word);
+				}
+
+	Testbench_swg_dilated(input_stream, input_stream_mmv, input_stream_dws, output_stream, output_stream_mmv, output_stream_dws, MAX_IMAGES);
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		// standard order: output pixel, kernel row, kernel column, channel fold
+		for (unsigned int oy = 0; oy < OFMDim_DL; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_DL; ox++)
+				for (unsigned int ky = 0; ky < KERNEL_DIM_DL; ky++)
+					for (unsigned int kx = 0; kx < KERNEL_DIM_DL; kx++)
+						for (unsigned int cf = 0; cf < CF; cf++) {
+							ap_uint<SIMD_DL*INPUT_PRECISION_DL> const exp = IMAGE[n_image][oy*STRIDE_DL + ky*DILATION_DL][ox*STRIDE_DL + kx*DILATION_DL][cf];
+							ap_uint<SIMD_DL*INPUT_PRECISION_DL> const outElem = output_stream.read();
+							if (exp != outElem) {
+								std::cout << "ERROR: Image " << n_image << " oy= " << oy << " ox= " << ox << " ky= " << ky << " kx= " << kx << " cf= " << cf
+									<< " Expected " << exp << " actual " << outElem << std::endl;
+								err_counter++;
+							}
+						}
+		// MMV order: MMV_DL neighbouring output pixels per word
+		for (unsigned int oy = 0; oy < OFMDim_DL; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_DL; ox += MMV_DL)
+				for (unsigned int ky = 0; ky < KERNEL_DIM_DL; ky++)
+					for (unsigned int kx = 0; kx < KERNEL_DIM_DL; kx++)
+						for (unsigned int cf = 0; cf < CF; cf++) {
+							MultiChanData<MMV_DL, SIMD_DL*INPUT_PRECISION_DL> outElem = output_stream_mmv.read();
+							for (unsigned int v = 0; v < MMV_DL; v++) {
+								ap_uint<SIMD_DL*INPUT_PRECISION_DL> const exp = IMAGE[n_image][oy*STRIDE_DL + ky*DILATION_DL][(ox+v)*STRIDE_DL + kx*DILATION_DL][cf];
+								if (exp != outElem.data[v]) {
+									std::cout << "ERROR MMV: Image " << n_image << " oy= " << oy << " ox= " << ox+v << " ky= " << ky << " kx= " << kx << " cf= " << cf
+										<< " Expected " << exp << " actual " << outElem.data[v] << std::endl;
+									err_counter++;
+								}
+							}
+						}
+		// depthwise order: output pixel, channel fold, kernel row, kernel column
+		for (unsigned int oy = 0; oy < OFMDim_DL; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_DL; ox++)
+				for (unsigned int cf = 0; cf < CF; cf++)
+					for (unsigned int ky = 0; ky < KERNEL_DIM_DL; ky++)
+						for (unsigned int kx = 0; kx < KERNEL_DIM_DL; kx++) {
+							ap_uint<SIMD_DL*INPUT_PRECISION_DL> const exp = IMAGE[n_image][oy*STRIDE_DL + ky*DILATION_DL][ox*STRIDE_DL + kx*DILATION_DL][cf];
+							ap_uint<SIMD_DL*INPUT_PRECISION_DL> const outElem = output_stream_dws.read();
+							if (exp != outElem) {
+								std::cout << "ERROR DWS: Image " << n_image << " oy= " << oy << " ox= " << ox << " cf= " << cf << " ky= " << ky << " kx= " << kx
+									<< " Expected " << exp << " actual " << outElem << std::endl;
+								err_counter++;
+							}
+						}
+	}
+	if (!output_stream.empty() || !output_stream_mmv.empty() || !output_stream_dws.empty()) {
+		std::cout << "ERROR: Output streams not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	return 0;
+}
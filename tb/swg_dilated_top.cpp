@@ -0,0 +1,18 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_swg_dilated.h"
+
+void Testbench_swg_dilated(stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > & in, stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > & in_mmv,
+	stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > & in_dws, stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > & out,
+	stream<MultiChanData<MMV_DL, SIMD_DL*INPUT_PRECISION_DL> > & out_mmv, stream<ap_uint<SIMD_DL*INPUT_PRECISION_DL> > & out_dws, unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	ConvolutionInputGenerator_kernel_stride<KERNEL_DIM_DL, IFM_Channels_DL, INPUT_PRECISION_DL, IFMDim_DL, OFMDim_DL, SIMD_DL, STRIDE_DL, DILATION_DL>
+		(in, out, numReps, ap_resource_dflt());
+	ConvolutionInputGenerator_kernel_stride_MMV<KERNEL_DIM_DL, IFM_Channels_DL, INPUT_PRECISION_DL, IFMDim_DL, OFMDim_DL, SIMD_DL, STRIDE_DL, MMV_DL, DILATION_DL>
+		(in_mmv, out_mmv, numReps, ap_resource_dflt());
+	ConvolutionInputGenerator_dws<KERNEL_DIM_DL, IFM_Channels_DL, INPUT_PRECISION_DL, IFMDim_DL, OFMDim_DL, SIMD_DL, STRIDE_DL, DILATION_DL>
+		(in_dws, out_dws, numReps, ap_resource_dflt());
+}
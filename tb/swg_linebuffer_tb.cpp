@@ -0,0 +1,88 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file swg_linebuffer_tb.cpp
+ *
+ *  Testbench for the line buffer sliding window generator
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_swg_linebuffer.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 3
+void Testbench_swg_linebuffer(stream<ap_uint<SIMD_LB*INPUT_PRECISION_LB> > & in, stream<ap_uint<SIMD_LB*INPUT_PRECISION_LB> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int CF = IFM_Channels_LB / SIMD_LB;
+	static ap_uint<SIMD_LB*INPUT_PRECISION_LB> IMAGE[MAX_IMAGES][IFMDim_LB][IFMDim_LB][CF];
+	stream<ap_uint<SIMD_LB*INPUT_PRECISION_LB> > input_stream("input_stream");
+	stream<ap_uint<SIMD_LB*INPUT_PRECISION_LB> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int y = 0; y < IFMDim_LB; y++)
+			for (unsigned int x = 0; x < IFMDim_LB; x++)
+				for (unsigned int cf = 0; cf < CF; cf++) {
+					ap_uint<SIMD_LB*INPUT_PRECISION_LB> const word = ap_uint<SIMD_LB*INPUT_PRECISION_LB>(rand());
+					IMAGE[n_image][y][x][cf] = word;
+					input_stream.write(word);
+				}
+
+	Testbench_swg_linebuffer(input_stream, output_stream, MAX_IMAGES);
+
+	// same order as ConvolutionInputGenerator: output pixel, kernel row, kernel column, channel fold
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int oy = 0; oy < OFMDim_LB; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_LB; ox++)
+				for (unsigned int ky = 0; ky < KERNEL_DIM_LB; ky++)
+					for (unsigned int kx = 0; kx < KERNEL_DIM_LB; kx++)
+						for (unsigned int cf = 0; cf < CF; cf++) {
+							ap_uint<SIMD_LB*INPUT_PRECISION_LB> const exp = IMAGE[n_image][oy*STRIDE_LB + ky][ox*STRIDE_LB + kx][cf];
+							ap_uint<SIMD_LB*INPUT_PRECISION_LB> const outElem = output_stream.read();
+							if (exp != outElem) {
+								std::cout << "ERROR: Image " << n_image << " oy= " << oy << " ox= " << ox << " ky= " << ky << " kx= " << kx << " cf= " << cf
+									<< " Expected " << exp << " actual " << outElem << std::endl;
+								return 1;
+							}
+						}
+	if (!output_stream.empty() || !input_stream.empty()) {
+		std::cout << "ERROR: Streams not empty" << std::endl;
+		return 1;
+	}
+	return 0;
+}
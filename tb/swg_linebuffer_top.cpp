@@ -0,0 +1,11 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_swg_linebuffer.h"
+
+void Testbench_swg_linebuffer(stream<ap_uint<SIMD_LB*INPUT_PRECISION_LB> > & in, stream<ap_uint<SIMD_LB*INPUT_PRECISION_LB> > & out, unsigned int numReps)
+{
+	ConvolutionInputGenerator_LineBuffer<KERNEL_DIM_LB, IFM_Channels_LB, INPUT_PRECISION_LB, IFMDim_LB, OFMDim_LB, SIMD_LB, STRIDE_LB>
+		(in, out, numReps, ap_resource_dflt());
+}
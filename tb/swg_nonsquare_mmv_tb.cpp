@@ -0,0 +1,159 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file swg_nonsquare_mmv_tb.cpp
+ *
+ *  Testbench for the MMV variants of the NonSquare, NonSquare dilated, NonSquare depthwise
+ *  and 1D sliding window generators
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "mmv.hpp"
+#include "data/config_swg_nonsquare_mmv.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+typedef ap_uint<SIMD_NM*INPUT_PRECISION_NM> elem_t;
+typedef MultiChanData<MMV_NM, SIMD_NM*INPUT_PRECISION_NM> mmv_t;
+
+void Testbench_swg_nonsquare_mmv(stream<ap_uint<SIMD_NM*INPUT_PRECISION_NM> > & in, stream<ap_uint<SIMD_NM*INPUT_PRECISION_NM> > & in_dil,
+	stream<ap_uint<SIMD_NM*INPUT_PRECISION_NM> > & in_dws, stream<ap_uint<SIMD_NM*INPUT_PRECISION_NM> > & in_1d,
+	stream<MultiChanData<MMV_NM, SIMD_NM*INPUT_PRECISION_NM> > & out, stream<MultiChanData<MMV_NM, SIMD_NM*INPUT_PRECISION_NM> > & out_dil,
+	stream<MultiChanData<MMV_NM, SIMD_NM*INPUT_PRECISION_NM> > & out_dws, stream<MultiChanData<MMV_NM, SIMD_NM*INPUT_PRECISION_NM> > & out_1d,
+	unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int CF = IFM_Channels_NM / SIMD_NM;
+	static elem_t IMAGE[MAX_IMAGES][IFMDim_Y_NM][IFMDim_X_NM][CF];
+	static elem_t LINE[MAX_IMAGES][IFMDim_1D_NM][CF];
+	stream<elem_t> input_stream("input_stream");
+	stream<elem_t> input_stream_dil("input_stream_dil");
+	stream<elem_t> input_stream_dws("input_stream_dws");
+	stream<elem_t> input_stream_1d("input_stream_1d");
+	stream<mmv_t> output_stream("output_stream");
+	stream<mmv_t> output_stream_dil("output_stream_dil");
+	stream<mmv_t> output_stream_dws("output_stream_dws");
+	stream<mmv_t> output_stream_1d("output_stream_1d");
+	unsigned int err_counter = 0;
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int y = 0; y < IFMDim_Y_NM; y++)
+			for (unsigned int x = 0; x < IFMDim_X_NM; x++)
+				for (unsigned int cf = 0; cf < CF; cf++) {
+					elem_t const word = elem_t(rand());
+					IMAGE[n_image][y][x][cf] = word;
+					input_stream.write(word);
+					input_stream_dil.write(word);
+					input_stream_dws.write(word);
+				}
+		for (unsigned int x = 0; x < IFMDim_1D_NM; x++)
+			for (unsigned int cf = 0; cf < CF; cf++) {
+				elem_t const word = elem_t(rand());
+				LINE[n_image][x][cf] = word;
+				input_stream_1d.write(word);
+			}
+	}
+
+	Testbench_swg_nonsquare_mmv(input_stream, input_stream_dil, input_stream_dws, input_stream_1d,
+		output_stream, output_stream_dil, output_stream_dws, output_stream_1d, MAX_IMAGES);
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		// standard order: MMV_NM neighbouring output pixels, kernel row, kernel column, channel fold
+		for (unsigned int oy = 0; oy < OFMDim_Y_NM; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_X_NM; ox += MMV_NM)
+				for (unsigned int ky = 0; ky < KERNEL_DIM_Y_NM; ky++)
+					for (unsigned int kx = 0; kx < KERNEL_DIM_X_NM; kx++)
+						for (unsigned int cf = 0; cf < CF; cf++) {
+							mmv_t outElem = output_stream.read();
+							mmv_t outElemDil = output_stream_dil.read();
+							for (unsigned int v = 0; v < MMV_NM; v++) {
+								elem_t const exp = IMAGE[n_image][oy*STRIDE_Y_NM + ky][(ox+v)*STRIDE_X_NM + kx][cf];
+								elem_t const expDil = IMAGE[n_image][oy*STRIDE_Y_NM + ky*DILATION_Y_NM][(ox+v)*STRIDE_X_NM + kx*DILATION_X_NM][cf];
+								if (exp != outElem.data[v]) {
+									std::cout << "ERROR: Image " << n_image << " oy= " << oy << " ox= " << ox+v << " ky= " << ky << " kx= " << kx << " cf= " << cf
+										<< " Expected " << exp << " actual " << outElem.data[v] << std::endl;
+									err_counter++;
+								}
+								if (expDil != outElemDil.data[v]) {
+									std::cout << "ERROR DILATED: Image " << n_image << " oy= " << oy << " ox= " << ox+v << " ky= " << ky << " kx= " << kx << " cf= " << cf
+										<< " Expected " << expDil << " actual " << outElemDil.data[v] << std::endl;
+									err_counter++;
+								}
+							}
+						}
+		// depthwise order: MMV_NM neighbouring output pixels, channel fold, kernel row, kernel column
+		for (unsigned int oy = 0; oy < OFMDim_Y_NM; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_X_NM; ox += MMV_NM)
+				for (unsigned int cf = 0; cf < CF; cf++)
+					for (unsigned int ky = 0; ky < KERNEL_DIM_Y_NM; ky++)
+						for (unsigned int kx = 0; kx < KERNEL_DIM_X_NM; kx++) {
+							mmv_t outElem = output_stream_dws.read();
+							for (unsigned int v = 0; v < MMV_NM; v++) {
+								elem_t const exp = IMAGE[n_image][oy*STRIDE_Y_NM + ky][(ox+v)*STRIDE_X_NM + kx][cf];
+								if (exp != outElem.data[v]) {
+									std::cout << "ERROR DWS: Image " << n_image << " oy= " << oy << " ox= " << ox+v << " cf= " << cf << " ky= " << ky << " kx= " << kx
+										<< " Expected " << exp << " actual " << outElem.data[v] << std::endl;
+									err_counter++;
+								}
+							}
+						}
+		// 1D order: MMV_NM neighbouring output pixels, kernel position, channel fold
+		for (unsigned int ox = 0; ox < OFMDim_1D_NM; ox += MMV_NM)
+			for (unsigned int kx = 0; kx < KERNEL_DIM_X_NM; kx++)
+				for (unsigned int cf = 0; cf < CF; cf++) {
+					mmv_t outElem = output_stream_1d.read();
+					for (unsigned int v = 0; v < MMV_NM; v++) {
+						elem_t const exp = LINE[n_image][(ox+v)*STRIDE_1D_NM + kx][cf];
+						if (exp != outElem.data[v]) {
+							std::cout << "ERROR 1D: Image " << n_image << " ox= " << ox+v << " kx= " << kx << " cf= " << cf
+								<< " Expected " << exp << " actual " << outElem.data[v] << std::endl;
+							err_counter++;
+						}
+					}
+				}
+	}
+	if (!output_stream.empty() || !output_stream_dil.empty() || !output_stream_dws.empty() || !output_stream_1d.empty()) {
+		std::cout << "ERROR: Output streams not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	return 0;
+}
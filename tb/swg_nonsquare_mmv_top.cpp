@@ -0,0 +1,22 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_swg_nonsquare_mmv.h"
+
+void Testbench_swg_nonsquare_mmv(stream<ap_uint<SIMD_NM*INPUT_PRECISION_NM> > & in, stream<ap_uint<SIMD_NM*INPUT_PRECISION_NM> > & in_dil,
+	stream<ap_uint<SIMD_NM*INPUT_PRECISION_NM> > & in_dws, stream<ap_uint<SIMD_NM*INPUT_PRECISION_NM> > & in_1d,
+	stream<MultiChanData<MMV_NM, SIMD_NM*INPUT_PRECISION_NM> > & out, stream<MultiChanData<MMV_NM, SIMD_NM*INPUT_PRECISION_NM> > & out_dil,
+	stream<MultiChanData<MMV_NM, SIMD_NM*INPUT_PRECISION_NM> > & out_dws, stream<MultiChanData<MMV_NM, SIMD_NM*INPUT_PRECISION_NM> > & out_1d,
+	unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	ConvolutionInputGenerator_NonSquare_MMV<KERNEL_DIM_X_NM, KERNEL_DIM_Y_NM, IFM_Channels_NM, INPUT_PRECISION_NM, IFMDim_X_NM, IFMDim_Y_NM,
+		OFMDim_X_NM, OFMDim_Y_NM, SIMD_NM, STRIDE_X_NM, STRIDE_Y_NM, MMV_NM>(in, out, numReps, ap_resource_dflt());
+	ConvolutionInputGenerator_NonSquare_Dilated_MMV<KERNEL_DIM_X_NM, KERNEL_DIM_Y_NM, IFM_Channels_NM, INPUT_PRECISION_NM, IFMDim_X_NM, IFMDim_Y_NM,
+		OFMDim_X_NM, OFMDim_Y_NM, SIMD_NM, STRIDE_X_NM, STRIDE_Y_NM, DILATION_X_NM, DILATION_Y_NM, MMV_NM>(in_dil, out_dil, numReps, ap_resource_dflt());
+	ConvolutionInputGenerator_NonSquare_dws_MMV<KERNEL_DIM_X_NM, KERNEL_DIM_Y_NM, IFM_Channels_NM, INPUT_PRECISION_NM, IFMDim_X_NM, IFMDim_Y_NM,
+		OFMDim_X_NM, OFMDim_Y_NM, SIMD_NM, STRIDE_X_NM, STRIDE_Y_NM, MMV_NM>(in_dws, out_dws, numReps, ap_resource_dflt());
+	ConvolutionInputGenerator_1D_MMV<KERNEL_DIM_X_NM, IFM_Channels_NM, INPUT_PRECISION_NM, IFMDim_1D_NM, OFMDim_1D_NM, STRIDE_1D_NM, SIMD_NM, MMV_NM>
+		(in_1d, out_1d, numReps, ap_resource_dflt());
+}
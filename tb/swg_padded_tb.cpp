@@ -0,0 +1,95 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file swg_padded_tb.cpp
+ *
+ *  Testbench for the sliding window generator with fused padding
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_swg_padded.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 3
+void Testbench_swg_padded(stream<ap_uint<SIMD_PD*INPUT_PRECISION_PD> > & in, stream<ap_uint<SIMD_PD*INPUT_PRECISION_PD> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int CF = IFM_Channels_PD / SIMD_PD;
+	static ap_uint<SIMD_PD*INPUT_PRECISION_PD> IMAGE[MAX_IMAGES][IFMDim_PD][IFMDim_PD][CF];
+	stream<ap_uint<SIMD_PD*INPUT_PRECISION_PD> > input_stream("input_stream");
+	stream<ap_uint<SIMD_PD*INPUT_PRECISION_PD> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int y = 0; y < IFMDim_PD; y++)
+			for (unsigned int x = 0; x < IFMDim_PD; x++)
+				for (unsigned int cf = 0; cf < CF; cf++) {
+					ap_uint<SIMD_PD*INPUT_PRECISION_PD> const word = ap_uint<SIMD_PD*INPUT_PRECISION_PD>(rand());
+					IMAGE[n_image][y][x][cf] = word;
+					input_stream.write(word);
+				}
+
+	Testbench_swg_padded(input_stream, output_stream, MAX_IMAGES);
+
+	ap_uint<SIMD_PD*INPUT_PRECISION_PD> padElem;
+	for (unsigned int simd = 0; simd < SIMD_PD; simd++)
+		padElem((simd+1)*INPUT_PRECISION_PD-1, simd*INPUT_PRECISION_PD) = PAD_VALUE_PD;
+
+	// same order as ConvolutionInputGenerator on the padded image: output pixel, kernel row, kernel column, channel fold
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++)
+		for (unsigned int oy = 0; oy < OFMDim_PD; oy++)
+			for (unsigned int ox = 0; ox < OFMDim_PD; ox++)
+				for (unsigned int ky = 0; ky < KERNEL_DIM_PD; ky++)
+					for (unsigned int kx = 0; kx < KERNEL_DIM_PD; kx++)
+						for (unsigned int cf = 0; cf < CF; cf++) {
+							int const y = int(oy*STRIDE_PD + ky) - PAD_TOP_PD;
+							int const x = int(ox*STRIDE_PD + kx) - PAD_LEFT_PD;
+							bool const inside = (y >= 0) && (y < IFMDim_PD) && (x >= 0) && (x < IFMDim_PD);
+							ap_uint<SIMD_PD*INPUT_PRECISION_PD> const exp = inside? IMAGE[n_image][y][x][cf] : padElem;
+							ap_uint<SIMD_PD*INPUT_PRECISION_PD> const outElem = output_stream.read();
+							if (exp != outElem) {
+								std::cout << "ERROR: Image " << n_image << " oy= " << oy << " ox= " << ox << " ky= " << ky << " kx= " << kx << " cf= " << cf
+									<< " Expected " << exp << " actual " << outElem << std::endl;
+								return 1;
+							}
+						}
+	if (!output_stream.empty() || !input_stream.empty()) {
+		std::cout << "ERROR: Streams not empty" << std::endl;
+		return 1;
+	}
+	return 0;
+}
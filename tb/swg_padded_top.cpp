@@ -0,0 +1,12 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_swg_padded.h"
+
+void Testbench_swg_padded(stream<ap_uint<SIMD_PD*INPUT_PRECISION_PD> > & in, stream<ap_uint<SIMD_PD*INPUT_PRECISION_PD> > & out, unsigned int numReps)
+{
+	ConvolutionInputGenerator_Padded<KERNEL_DIM_PD, IFM_Channels_PD, INPUT_PRECISION_PD, IFMDim_PD, OFMDim_PD, SIMD_PD, STRIDE_PD,
+		PAD_TOP_PD, PAD_BOTTOM_PD, PAD_LEFT_PD, PAD_RIGHT_PD, PAD_VALUE_PD>
+		(in, out, numReps, ap_resource_dflt());
+}
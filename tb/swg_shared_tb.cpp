@@ -0,0 +1,126 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file swg_shared_tb.cpp
+ *
+ *  Testbench for the sliding window generator shared by several branches,
+ *  checked against a ConvolutionInputGenerator_Padded per branch
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "cycles.hpp"
+#include "data/config_swg_shared.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_swg_shared(stream<ap_uint<SIMD_SH*INPUT_PRECISION_SH> > & in, stream<ap_uint<SIMD_SH*INPUT_PRECISION_SH> > (&out)[5], unsigned int numReps);
+
+using Word = ap_uint<SIMD_SH*INPUT_PRECISION_SH>;
+
+static_assert(ConvolutionInputGenerator_Shared_cycles_bound<IFM_Channels_SH, IFMDim_SH, SIMD_SH,
+	SWGWindow<1>, SWGWindow<3>, SWGWindow<5>, SWGWindow<5, 2, 2, PAD_VALUE_SH>, SWGWindow<3, 2, 0> >(1) == 162 + 1458 + 4050 + 1250 + 288,
+	"Cycle bound must add up the words of all branches");
+
+template<typename Window>
+int check(stream<Word> &actual, Word const (&image)[MAX_IMAGES][IFMDim_SH*IFMDim_SH*IFM_Channels_SH/SIMD_SH], unsigned int const branch) {
+	constexpr unsigned int OFMDim = Window::ofm_dim(IFMDim_SH);
+	stream<Word> in("ref_in");
+	stream<Word> expected("ref_out");
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int i = 0; i < IFMDim_SH*IFMDim_SH*IFM_Channels_SH/SIMD_SH; i++) {
+			in.write(image[n_image][i]);
+		}
+	}
+	constexpr unsigned int PadEnd = (OFMDim-1)*Window::stride + Window::kernel - IFMDim_SH - Window::pad;
+	ConvolutionInputGenerator_Padded<Window::kernel, IFM_Channels_SH, INPUT_PRECISION_SH, IFMDim_SH, OFMDim, SIMD_SH, Window::stride,
+		Window::pad, PadEnd, Window::pad, PadEnd, Window::pad_value>(in, expected, MAX_IMAGES, ap_resource_dflt());
+
+	int errors = 0;
+	unsigned int word = 0;
+	while (!expected.empty()) {
+		Word const exp = expected.read();
+		if (actual.empty()) {
+			std::cout << "ERROR: Branch " << branch << " ends after " << word << " words" << std::endl;
+			return errors + 1;
+		}
+		Word const out = actual.read();
+		if (out != exp) {
+			std::cout << "ERROR: Branch " << branch << " word " << word << " expected " << exp << " actual " << out << std::endl;
+			errors++;
+		}
+		word++;
+	}
+	if (!actual.empty()) {
+		std::cout << "ERROR: Branch " << branch << " has excess words" << std::endl;
+		errors++;
+	}
+	return errors;
+}
+
+int main()
+{
+	static Word IMAGE[MAX_IMAGES][IFMDim_SH*IFMDim_SH*IFM_Channels_SH/SIMD_SH];
+	stream<Word> input_stream("input_stream");
+	stream<Word> output_stream[5];
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int i = 0; i < IFMDim_SH*IFMDim_SH*IFM_Channels_SH/SIMD_SH; i++) {
+			IMAGE[n_image][i] = rand();
+			input_stream.write(IMAGE[n_image][i]);
+		}
+	}
+
+	Testbench_swg_shared(input_stream, output_stream, MAX_IMAGES);
+
+	int err_counter = 0;
+	err_counter += check<SWGWindow<1> >(output_stream[0], IMAGE, 0);
+	err_counter += check<SWGWindow<3> >(output_stream[1], IMAGE, 1);
+	err_counter += check<SWGWindow<5> >(output_stream[2], IMAGE, 2);
+	err_counter += check<SWGWindow<5, 2, 2, PAD_VALUE_SH> >(output_stream[3], IMAGE, 3);
+	err_counter += check<SWGWindow<3, 2, 0> >(output_stream[4], IMAGE, 4);
+	if (!input_stream.empty()) {
+		std::cout << "ERROR: Input stream not empty" << std::endl;
+		err_counter++;
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return 0;
+}
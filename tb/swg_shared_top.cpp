@@ -0,0 +1,15 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_swg_shared.h"
+
+// 1x1, 3x3 and 5x5 with "same" padding, a strided 5x5 and a strided 3x3 without padding
+#define WINDOWS_SH \
+	SWGWindow<1>, SWGWindow<3>, SWGWindow<5>, SWGWindow<5, 2, 2, PAD_VALUE_SH>, SWGWindow<3, 2, 0>
+
+void Testbench_swg_shared(stream<ap_uint<SIMD_SH*INPUT_PRECISION_SH> > & in, stream<ap_uint<SIMD_SH*INPUT_PRECISION_SH> > (&out)[5], unsigned int numReps)
+{
+	ConvolutionInputGenerator_Shared<IFM_Channels_SH, INPUT_PRECISION_SH, IFMDim_SH, SIMD_SH, WINDOWS_SH>
+		(in, out, numReps, ap_resource_dflt());
+}
@@ -44,6 +44,7 @@
 #include <string>
 #include "data/input_gen.h"
 #include "math.h"
+#include "csim_bench.hpp"
 using namespace hls;
 using namespace std;
 
@@ -75,7 +76,10 @@ stream<ap_uint<IFM_Channels*INPUT_PRECISION> > output_stream("output_stream");
 			}
 		}
 	}
-	Testbench(input_stream, output_stream, MAX_IMAGES);
+	{
+		CsimBench const  bench("SWG", MAX_IMAGES, input_stream.size());
+		Testbench(input_stream, output_stream, MAX_IMAGES);
+	}
 	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
 		for (unsigned int oy = 0; oy < OFMDim; oy++) {
 			for (unsigned int ox = 0; ox < OFMDim; ox+=MMV) {
@@ -0,0 +1,108 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file systolic_mvau_tb.cpp
+ *
+ *  Testbench for the systolic matrix vector activation
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_systolic.h"
+#include "data/config_systolic.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 8
+#define SF_SY (MatrixW_SY/SIMD_SY)
+#define NF_SY (MatrixH_SY/PE_SY)
+
+void Testbench_systolic_mvau(stream<MultiChanData<MMV_SY, SIMD_SY*INPUT_PRECISION_SY> > & in, stream<MultiChanData<MMV_SY, PE_SY*ACTIVATION_PRECISION_SY> > & out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<INPUT_PRECISION_SY> IMAGE[NUM_REPEAT][MMV_SY][MatrixW_SY];
+	stream<MultiChanData<MMV_SY, SIMD_SY*INPUT_PRECISION_SY> > input_stream("input_stream");
+	stream<MultiChanData<MMV_SY, PE_SY*ACTIVATION_PRECISION_SY> > output_stream("output_stream");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int sf = 0; sf < SF_SY; sf++) {
+			MultiChanData<MMV_SY, SIMD_SY*INPUT_PRECISION_SY> word;
+			for (unsigned int mmv = 0; mmv < MMV_SY; mmv++) {
+				for (unsigned int simd = 0; simd < SIMD_SY; simd++) {
+					ap_uint<INPUT_PRECISION_SY> const act = rand();
+					IMAGE[rep][mmv][sf*SIMD_SY + simd] = act;
+					word.data[mmv]((simd+1)*INPUT_PRECISION_SY-1, simd*INPUT_PRECISION_SY) = act;
+				}
+			}
+			input_stream.write(word);
+		}
+	}
+
+	Testbench_systolic_mvau(input_stream, output_stream, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int nf = 0; nf < NF_SY; nf++) {
+			MultiChanData<MMV_SY, PE_SY*ACTIVATION_PRECISION_SY> const outElem = output_stream.read();
+			for (unsigned int mmv = 0; mmv < MMV_SY; mmv++) {
+				for (unsigned int pe = 0; pe < PE_SY; pe++) {
+					int exp = 0;
+					for (unsigned int col = 0; col < MatrixW_SY; col++)
+						exp += PARAM_SYSTOLIC::raw[nf*PE_SY + pe][col] * IMAGE[rep][mmv][col];
+					ap_int<ACTIVATION_PRECISION_SY> const EXP = exp;
+					ap_int<ACTIVATION_PRECISION_SY> out_chan;
+					out_chan(ACTIVATION_PRECISION_SY-1, 0) = outElem.data[mmv]((pe+1)*ACTIVATION_PRECISION_SY-1, pe*ACTIVATION_PRECISION_SY);
+					if (EXP != out_chan) {
+						cout << "ERROR: rep " << rep << " pixel " << mmv << " expected[" << nf*PE_SY + pe << "]=" << EXP << " actual " << out_chan << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	if (!input_stream.empty() || !output_stream.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,16 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_ternary.h"
+#include "data/config_ternary.h"
+
+void Testbench_ternary_mvau(stream<ap_uint<SIMD_TN*INPUT_PRECISION_TN> > & in, stream<ap_uint<PE_TN*ACTIVATION_PRECISION_TN> > & out, unsigned int numReps){
+	Matrix_Vector_Activate_Batch<MatrixW_TN, MatrixH_TN, SIMD_TN, PE_TN, 1, Slice<ap_uint<INPUT_PRECISION_TN> >, Slice<ap_int<ACTIVATION_PRECISION_TN> >, Identity>
+		(in, out, PARAM_TERNARY::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_TN>>(), numReps, ap_resource_lut());
+}
@@ -0,0 +1,87 @@
+##############################################################################
+ #  Copyright (c) 2019, Xilinx, Inc.
+ #  All rights reserved.
+ #
+ #  Redistribution and use in source and binary forms, with or without
+ #  modification, are permitted provided that the following conditions are met:
+ #
+ #  1.  Redistributions of source code must retain the above copyright notice,
+ #     this list of conditions and the following disclaimer.
+ #
+ #  2.  Redistributions in binary form must reproduce the above copyright
+ #      notice, this list of conditions and the following disclaimer in the
+ #      documentation and/or other materials provided with the distribution.
+ #
+ #  3.  Neither the name of the copyright holder nor the names of its
+ #      contributors may be used to endorse or promote products derived from
+ #      this software without specific prior written permission.
+ #
+ #  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ #  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ #  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ #  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ #  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ #  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ #  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ #  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ #  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ #  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ #  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ #
+###############################################################################
+ #
+ # \file test_cycles_model.tcl
+ #
+ # Tcl script for HLS csim, synthesis and cosim of the analytical cycle models.
+ # The latency measured by the cosimulation of every top is checked against the
+ # cycle count modelled by the testbench, allowing for the depth of each entered
+ # pipeline.
+ #
+###############################################################################
+proc check_cycles {project top} {
+	set fp [open "$project/sol1/csim/build/cycles_model.txt" r]
+	set model [read $fp]
+	close $fp
+	set line [lsearch -inline -regexp [split $model "\n"] "^$top "]
+	set expected [lindex $line 1]
+	set entries [lindex $line 2]
+
+	set fp [open "$project/sol1/sim/report/${top}_cosim.rpt" r]
+	set report [read $fp]
+	close $fp
+	if {![regexp -line {^\|\s*Verilog\|\s*Pass\|\s*(\d+)\|\s*(\d+)\|\s*(\d+)\|} $report -> lat_min lat_avg lat_max]} {
+		error "$top: no passing Verilog cosimulation latency in report"
+	}
+	set slack [expr {32 * ($entries + 1)}]
+	puts "$top: modelled $expected cycles, measured $lat_max cycles"
+	if {($lat_max < $expected) || ($lat_max > $expected + $slack)} {
+		error "$top: measured latency $lat_max outside of \[$expected, [expr {$expected + $slack}]\]"
+	}
+}
+
+open_project hls-syn-cycles-model-swg
+add_files cycles_model_top.cpp -cflags "-std=c++14 -I$::env(FINN_HLS_ROOT) -I$::env(FINN_HLS_ROOT)/tb"
+add_files -tb cycles_model_tb.cpp -cflags "-std=c++14 -I$::env(FINN_HLS_ROOT) -I$::env(FINN_HLS_ROOT)/tb"
+set_top Testbench_cycles_model_swg
+open_solution sol1
+set_part {xczu3eg-sbva484-1-i}
+create_clock -period 5 -name default
+csim_design
+csynth_design
+cosim_design
+check_cycles hls-syn-cycles-model-swg Testbench_cycles_model_swg
+close_project
+
+open_project hls-syn-cycles-model-mvau
+add_files cycles_model_top.cpp -cflags "-std=c++14 -I$::env(FINN_HLS_ROOT) -I$::env(FINN_HLS_ROOT)/tb"
+add_files -tb cycles_model_tb.cpp -cflags "-std=c++14 -I$::env(FINN_HLS_ROOT) -I$::env(FINN_HLS_ROOT)/tb"
+set_top Testbench_cycles_model_mvau
+open_solution sol1
+set_part {xczu3eg-sbva484-1-i}
+create_clock -period 5 -name default
+csim_design
+csynth_design
+cosim_design
+check_cycles hls-syn-cycles-model-mvau Testbench_cycles_model_mvau
+close_project
+exit
@@ -0,0 +1,129 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file thresholding_compressed_tb.cpp
+ *
+ *  Testbench for the thresholding with streaming compressed thresholds
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/config_thresholds_compressed.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 16
+constexpr unsigned int THR_WIDTH_TC = INPUT_PRECISION_TC + (NumTH_TC-1)*DELTA_PRECISION_TC;
+void Testbench_thresholding_compressed(stream<ap_uint<PE_TC*INPUT_PRECISION_TC> > & in, stream<ap_uint<PE_TC*OUTPUT_PRECISION_TC> > & out,
+	stream<ap_uint<PE_TC*THR_WIDTH_TC> > & thresholds, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int NF = Channels_TC / PE_TC;
+	static int THRESHOLDS[Channels_TC][NumTH_TC];
+	static ap_int<INPUT_PRECISION_TC> IMAGE[MAX_IMAGES][Channels_TC];
+	stream<ap_uint<PE_TC*INPUT_PRECISION_TC> > input_stream("input_stream");
+	stream<ap_uint<PE_TC*OUTPUT_PRECISION_TC> > output_stream("output_stream");
+	stream<ap_uint<PE_TC*THR_WIDTH_TC> > threshold_stream("threshold_stream");
+
+	// sorted thresholds with narrow differences, including repeated ones
+	for (unsigned int channel = 0; channel < Channels_TC; channel++) {
+		THRESHOLDS[channel][0] = (rand() % 20000) - 10000;
+		for (unsigned int t = 1; t < NumTH_TC; t++)
+			THRESHOLDS[channel][t] = THRESHOLDS[channel][t-1] + (rand() % (1 << DELTA_PRECISION_TC));
+	}
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_TC*INPUT_PRECISION_TC> input_word = 0;
+			ap_uint<PE_TC*THR_WIDTH_TC> thr_word = 0;
+			for (unsigned int pe = 0; pe < PE_TC; pe++) {
+				unsigned int const channel = nf*PE_TC + pe;
+				// inputs around the thresholds, hitting them every now and then
+				ap_int<INPUT_PRECISION_TC> input = THRESHOLDS[channel][0] + (rand() % (NumTH_TC << DELTA_PRECISION_TC)) - (1 << DELTA_PRECISION_TC);
+				if (n_image % 4 == 0)
+					input = THRESHOLDS[channel][n_image % NumTH_TC];
+				IMAGE[n_image][channel] = input;
+				input_word((pe+1)*INPUT_PRECISION_TC-1, pe*INPUT_PRECISION_TC) = input;
+
+				ap_uint<THR_WIDTH_TC> thr = 0;
+				thr(INPUT_PRECISION_TC-1, 0) = ap_int<INPUT_PRECISION_TC>(THRESHOLDS[channel][0]);
+				for (unsigned int t = 1; t < NumTH_TC; t++)
+					thr(INPUT_PRECISION_TC+t*DELTA_PRECISION_TC-1, INPUT_PRECISION_TC+(t-1)*DELTA_PRECISION_TC) = THRESHOLDS[channel][t] - THRESHOLDS[channel][t-1];
+				thr_word((pe+1)*THR_WIDTH_TC-1, pe*THR_WIDTH_TC) = thr;
+			}
+			input_stream.write(input_word);
+			threshold_stream.write(thr_word);
+		}
+	}
+
+	Testbench_thresholding_compressed(input_stream, output_stream, threshold_stream, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_TC*OUTPUT_PRECISION_TC> outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_TC; pe++) {
+				unsigned int const channel = nf*PE_TC + pe;
+				unsigned int exp = 0;
+				for (unsigned int t = 0; t < NumTH_TC; t++)
+					exp += THRESHOLDS[channel][t] <= IMAGE[n_image][channel];
+				ap_uint<OUTPUT_PRECISION_TC> const EXP = exp;
+				ap_uint<OUTPUT_PRECISION_TC> const out_chan = outElem((pe+1)*OUTPUT_PRECISION_TC-1, pe*OUTPUT_PRECISION_TC);
+				if (EXP != out_chan) {
+					std::cout << "ERROR: Image " << n_image << " Expected[" << channel << "]=" << EXP << " actual " << out_chan << std::endl;
+					err_counter++;
+				}
+			}
+		}
+	}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
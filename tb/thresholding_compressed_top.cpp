@@ -0,0 +1,16 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/config_thresholds_compressed.h"
+
+constexpr unsigned int THR_WIDTH_TC = INPUT_PRECISION_TC + (NumTH_TC-1)*DELTA_PRECISION_TC;
+
+void Testbench_thresholding_compressed(stream<ap_uint<PE_TC*INPUT_PRECISION_TC> > & in, stream<ap_uint<PE_TC*OUTPUT_PRECISION_TC> > & out,
+	stream<ap_uint<PE_TC*THR_WIDTH_TC> > & thresholds, unsigned int numReps){
+	Thresholding_Stream_Compressed_Batch<1, Channels_TC, PE_TC, Slice<ap_int<INPUT_PRECISION_TC> >, Slice<ap_uint<OUTPUT_PRECISION_TC> >, 0,
+		ap_int<INPUT_PRECISION_TC>, ap_uint<DELTA_PRECISION_TC>, NumTH_TC>(in, out, thresholds, numReps);
+}
@@ -0,0 +1,109 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file thresholding_tb.cpp
+ *
+ *  Testbench for the multi-threshold activations
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_thresholds.h"
+#include "data/config_thresholds.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 64
+void Testbench_thresholding(stream<ap_uint<PE_T*INPUT_PRECISION_T> > & in, stream<ap_uint<PE_T*OUTPUT_PRECISION_T> > & out, unsigned int numReps);
+
+int main()
+{
+	constexpr unsigned int NF = Channels_T / PE_T;
+	static ap_int<INPUT_PRECISION_T> IMAGE[MAX_IMAGES][Channels_T];
+	stream<ap_uint<PE_T*INPUT_PRECISION_T> > input_stream("input_stream");
+	stream<ap_uint<PE_T*OUTPUT_PRECISION_T> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_T*INPUT_PRECISION_T> input_word = 0;
+			for (unsigned int pe = 0; pe < PE_T; pe++) {
+				ap_int<INPUT_PRECISION_T> input = (ap_int<INPUT_PRECISION_T>)rand();
+				// hit the thresholds themselves every now and then
+				if (n_image % 4 == 0)
+					input = PARAM_THRESHOLDS::threshs.m_thresholds[pe][nf][n_image % NumTH_T];
+				IMAGE[n_image][nf*PE_T + pe] = input;
+				input_word((pe+1)*INPUT_PRECISION_T-1, pe*INPUT_PRECISION_T) = input;
+			}
+			input_stream.write(input_word);
+		}
+	}
+
+	Testbench_thresholding(input_stream, output_stream, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int nf = 0; nf < NF; nf++) {
+			ap_uint<PE_T*OUTPUT_PRECISION_T> outElem = output_stream.read();
+			for (unsigned int pe = 0; pe < PE_T; pe++) {
+				unsigned int exp = 0;
+				for (unsigned int t = 0; t < NumTH_T; t++)
+					exp += PARAM_THRESHOLDS::threshs.m_thresholds[pe][nf][t] < IMAGE[n_image][nf*PE_T + pe];
+				ap_uint<OUTPUT_PRECISION_T> const EXP = exp;
+				ap_uint<OUTPUT_PRECISION_T> const out_chan = outElem((pe+1)*OUTPUT_PRECISION_T-1, pe*OUTPUT_PRECISION_T);
+				if (EXP != out_chan) {
+					std::cout << "ERROR: Image " << n_image << " Expected[" << nf*PE_T + pe << "]=" << EXP << " actual " << out_chan << std::endl;
+					err_counter++;
+				}
+			}
+		}
+	}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
@@ -0,0 +1,16 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "data/memdata_thresholds.h"
+#include "data/config_thresholds.h"
+
+void Testbench_thresholding(stream<ap_uint<PE_T*INPUT_PRECISION_T> > & in, stream<ap_uint<PE_T*OUTPUT_PRECISION_T> > & out, unsigned int numReps){
+#pragma HLS ARRAY_PARTITION variable=PARAM_THRESHOLDS::threshs.m_thresholds complete dim=1
+#pragma HLS ARRAY_PARTITION variable=PARAM_THRESHOLDS::threshs.m_thresholds complete dim=3
+	Thresholding_Batch<1, Channels_T, PE_T, Slice<ap_int<INPUT_PRECISION_T> >, Slice<ap_uint<OUTPUT_PRECISION_T> > >
+		(in, out, PARAM_THRESHOLDS::threshs, numReps);
+}
@@ -0,0 +1,134 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file tiling_tb.cpp
+ *
+ *  Testbench for the spatial tiling of a chain of two convolutional layers
+ *  into overlapping column tiles, against the untiled golden model
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "weights.hpp"
+#include "data/memdata_tiling.h"
+#include "data/config_tiling.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPS_TL 2
+#define OFMDim1_x_TL IFMDim_x_TL
+#define OFMDim1_y_TL IFMDim_y_TL
+#define OFMDim2_x_TL ((OFMDim1_x_TL - KERNEL_DIM2_TL) / STRIDE2_TL + 1)
+#define OFMDim2_y_TL ((OFMDim1_y_TL - KERNEL_DIM2_TL) / STRIDE2_TL + 1)
+
+unsigned const InWidth_TL = IFM_Channels_TL*INPUT_PRECISION_TL;
+unsigned const OutWidth_TL = OFM_Channels2_TL*ACTIVATION_PRECISION2_TL;
+
+void Testbench_tiling(ap_uint<InWidth_TL> const * in, ap_uint<OutWidth_TL> * out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<InWidth_TL> IMAGES[NUM_REPS_TL][IFMDim_y_TL][IFMDim_x_TL];
+	static ap_uint<OutWidth_TL> RESULTS[NUM_REPS_TL][OFMDim2_y_TL][OFMDim2_x_TL];
+	static int MID[OFMDim1_y_TL][OFMDim1_x_TL][OFM_Channels1_TL];
+	int err_counter = 0;
+
+	for (unsigned int n = 0; n < NUM_REPS_TL; n++) {
+		for (unsigned int y = 0; y < IFMDim_y_TL; y++) {
+			for (unsigned int x = 0; x < IFMDim_x_TL; x++) {
+				IMAGES[n][y][x] = rand() & ((1 << InWidth_TL) - 1);
+			}
+		}
+		for (unsigned int y = 0; y < OFMDim2_y_TL; y++) {
+			for (unsigned int x = 0; x < OFMDim2_x_TL; x++) {
+				RESULTS[n][y][x] = ~ap_uint<OutWidth_TL>(0);
+			}
+		}
+	}
+
+	Testbench_tiling(&IMAGES[0][0][0], &RESULTS[0][0][0], NUM_REPS_TL);
+
+	for (unsigned int n = 0; n < NUM_REPS_TL; n++) {
+		// first layer over the padded image
+		for (unsigned int y = 0; y < OFMDim1_y_TL; y++) {
+			for (unsigned int x = 0; x < OFMDim1_x_TL; x++) {
+				for (unsigned int oc = 0; oc < OFM_Channels1_TL; oc++) {
+					int acc = 0;
+					for (unsigned int ky = 0; ky < KERNEL_DIM1_TL; ky++) {
+						for (unsigned int kx = 0; kx < KERNEL_DIM1_TL; kx++) {
+							int const iy = int(y + ky) - PAD1_TL;
+							int const ix = int(x + kx) - PAD1_TL;
+							if (iy < 0 || iy >= IFMDim_y_TL || ix < 0 || ix >= IFMDim_x_TL)  continue;
+							for (unsigned int c = 0; c < IFM_Channels_TL; c++) {
+								int const pixel = IMAGES[n][iy][ix](c*INPUT_PRECISION_TL + INPUT_PRECISION_TL-1, c*INPUT_PRECISION_TL);
+								acc += PARAM_TILING::weights1_raw[oc][(ky*KERNEL_DIM1_TL + kx)*IFM_Channels_TL + c] * pixel;
+							}
+						}
+					}
+					MID[y][x][oc] = acc;
+				}
+			}
+		}
+		// second layer without padding
+		for (unsigned int y = 0; y < OFMDim2_y_TL; y++) {
+			for (unsigned int x = 0; x < OFMDim2_x_TL; x++) {
+				for (unsigned int oc = 0; oc < OFM_Channels2_TL; oc++) {
+					int acc = 0;
+					for (unsigned int ky = 0; ky < KERNEL_DIM2_TL; ky++) {
+						for (unsigned int kx = 0; kx < KERNEL_DIM2_TL; kx++) {
+							for (unsigned int c = 0; c < OFM_Channels1_TL; c++) {
+								int const pixel = MID[y*STRIDE2_TL + ky][x*STRIDE2_TL + kx][c];
+								acc += PARAM_TILING::weights2_raw[oc][(ky*KERNEL_DIM2_TL + kx)*OFM_Channels1_TL + c] * pixel;
+							}
+						}
+					}
+					ap_int<ACTIVATION_PRECISION2_TL> const actual = RESULTS[n][y][x]((oc+1)*ACTIVATION_PRECISION2_TL-1, oc*ACTIVATION_PRECISION2_TL);
+					if (actual != acc) {
+						std::cout << "ERROR: image " << n << " pixel " << y << "," << x << " channel " << oc
+							<< " expected " << acc << " actual " << actual << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (err_counter != 0) {
+		std::cout << "Test failed with " << err_counter << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "Test passed" << std::endl;
+	return 0;
+}
@@ -0,0 +1,51 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "mvau.hpp"
+#include "data/memdata_tiling.h"
+#include "data/config_tiling.h"
+
+typedef SWGWindow<KERNEL_DIM1_TL, STRIDE1_TL, PAD1_TL> W1_TL;
+typedef SWGWindow<KERNEL_DIM2_TL, STRIDE2_TL, PAD2_TL> W2_TL;
+typedef TileGeometry<IFMDim_x_TL, IFMDim_y_TL, TILE_OUT_TL, W1_TL, W2_TL> Tiles_TL;
+
+unsigned const InWidth_TL = IFM_Channels_TL*INPUT_PRECISION_TL;
+unsigned const MidWidth_TL = OFM_Channels1_TL*ACTIVATION_PRECISION1_TL;
+unsigned const OutWidth_TL = OFM_Channels2_TL*ACTIVATION_PRECISION2_TL;
+
+void Testbench_tiling(ap_uint<InWidth_TL> const * in, ap_uint<OutWidth_TL> * out, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi offset=slave port=in bundle=hostmem depth=IFMDim_x_TL*IFMDim_y_TL
+#pragma HLS INTERFACE m_axi offset=slave port=out bundle=hostmem depth=Tiles_TL::ofm_x*Tiles_TL::ofm_y
+#pragma HLS INTERFACE s_axilite port=numReps
+#pragma HLS DATAFLOW
+	// tile dimensions of the layers, all without padding
+	unsigned const Dim1_x = Tiles_TL::tile_ifm_x;
+	unsigned const Dim1_y = Tiles_TL::tile_ifm_y;
+	unsigned const Dim2_x = ReceptiveField<W2_TL>::ifm_dim(TILE_OUT_TL);
+	unsigned const Dim2_y = (Dim1_y - KERNEL_DIM1_TL) / STRIDE1_TL + 1;
+	unsigned const Reps = numReps * Tiles_TL::tiles;
+
+	stream<ap_uint<InWidth_TL> > tiles("tiles");
+	stream<ap_uint<InWidth_TL> > convInp1("convInp1");
+	stream<ap_uint<MidWidth_TL> > mid("mid");
+	stream<ap_uint<MidWidth_TL> > convInp2("convInp2");
+	stream<ap_uint<OutWidth_TL> > res("res");
+	Mem2Stream_Tiled_Batch<InWidth_TL, 1, Tiles_TL>(in, tiles, numReps);
+	ConvolutionInputGenerator_NonSquare<KERNEL_DIM1_TL, KERNEL_DIM1_TL, IFM_Channels_TL, INPUT_PRECISION_TL, Dim1_x, Dim1_y,
+		Dim2_x, Dim2_y, SIMD1_TL, STRIDE1_TL, STRIDE1_TL>(tiles, convInp1, Reps, ap_resource_dflt());
+	Matrix_Vector_Activate_Batch<KERNEL_DIM1_TL*KERNEL_DIM1_TL*IFM_Channels_TL, OFM_Channels1_TL, SIMD1_TL, PE1_TL, 1,
+		Slice<ap_uint<INPUT_PRECISION_TL> >, Slice<ap_int<ACTIVATION_PRECISION1_TL> >, Identity>
+		(convInp1, mid, PARAM_TILING::weights1, PassThroughActivation<ap_int<ACTIVATION_PRECISION1_TL> >(), Reps * Dim2_x * Dim2_y, ap_resource_dsp());
+	ConvolutionInputGenerator_NonSquare<KERNEL_DIM2_TL, KERNEL_DIM2_TL, OFM_Channels1_TL, ACTIVATION_PRECISION1_TL, Dim2_x, Dim2_y,
+		TILE_OUT_TL, Tiles_TL::ofm_y, SIMD2_TL, STRIDE2_TL, STRIDE2_TL>(mid, convInp2, Reps, ap_resource_dflt());
+	Matrix_Vector_Activate_Batch<KERNEL_DIM2_TL*KERNEL_DIM2_TL*OFM_Channels1_TL, OFM_Channels2_TL, SIMD2_TL, PE2_TL, 1,
+		Slice<ap_int<ACTIVATION_PRECISION1_TL> >, Slice<ap_int<ACTIVATION_PRECISION2_TL> >, Identity>
+		(convInp2, res, PARAM_TILING::weights2, PassThroughActivation<ap_int<ACTIVATION_PRECISION2_TL> >(), Reps * TILE_OUT_TL * Tiles_TL::ofm_y, ap_resource_dsp());
+	Stream2Mem_Tiled_Batch<OutWidth_TL, 1, Tiles_TL>(res, out, numReps);
+}
@@ -0,0 +1,142 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file tmrc_folded_tb.cpp
+ *
+ *  Testbench for the folded TMR checker, compared against TMRCheck_Batch on an
+ *  OFM with injected faults, and for its per-triplet fault counters
+ *
+ *****************************************************************************/
+#define AP_INT_MAX_W 8191
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_tmrc.h"
+#include "data/config_tmrc.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 8
+#define PE_TF 4
+#define CNT_WIDTH_TF 4
+#define OFM_ChannelsTMR (OFM_Channels1-NUM_RED*(REDF-1))
+
+void Testbench_tmrc_folded(stream<ap_uint<OFM_Channels1*ACTIVATION_PRECISION> > & in_ref,
+						   stream<ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> > & out_ref,
+						   stream<ap_uint<PE_TF*ACTIVATION_PRECISION> > & in,
+						   stream<ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> > & out,
+						   unsigned int numReps,
+						   ap_uint<2> &errortype_ref,
+						   ap_uint<2> &errortype,
+						   ap_uint<CNT_WIDTH_TF> errcount[NUM_RED]);
+
+int main()
+{
+	stream<ap_uint<OFM_Channels1*ACTIVATION_PRECISION> > in_ref("in_ref");
+	stream<ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> > out_ref("out_ref"), out("out");
+	stream<ap_uint<PE_TF*ACTIVATION_PRECISION> > in("in");
+	unsigned int expcount[NUM_RED] = {0};
+	unsigned int errors = 0;
+
+	// Triplets carry the same value, with one or all of them corrupted now and then
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int pos = 0; pos < OFMDim1*OFMDim1; pos++) {
+			ap_uint<ACTIVATION_PRECISION> ofm[OFM_Channels1];
+			for (unsigned int ch = 0; ch < OFM_Channels1; ch++)
+				ofm[ch] = rand();
+			for (unsigned int t = 0; t < NUM_RED; t++) {
+				unsigned int const idx = PARAM::red_ch_index[t];
+				ofm[idx+1] = ofm[idx+2] = ofm[idx];
+				unsigned int const fault = rand() % 6;
+				if (fault == 1)
+					ofm[idx + rand() % REDF] ^= 1 << (rand() % ACTIVATION_PRECISION);
+				else if (fault == 2) {
+					ofm[idx+1] = ofm[idx] + 1;
+					ofm[idx+2] = ofm[idx] + 2;
+				}
+				if (fault == 1 || fault == 2)
+					expcount[t]++;
+			}
+			ap_uint<OFM_Channels1*ACTIVATION_PRECISION> word;
+			for (unsigned int ch = 0; ch < OFM_Channels1; ch++)
+				word((ch+1)*ACTIVATION_PRECISION-1, ch*ACTIVATION_PRECISION) = ofm[ch];
+			in_ref.write(word);
+			for (unsigned int nf = 0; nf < OFM_Channels1/PE_TF; nf++)
+				in.write(word((nf+1)*PE_TF*ACTIVATION_PRECISION-1, nf*PE_TF*ACTIVATION_PRECISION));
+		}
+	}
+
+	// counters accumulate on top of their previous value and saturate
+	ap_uint<CNT_WIDTH_TF> errcount[NUM_RED];
+	for (unsigned int t = 0; t < NUM_RED; t++) {
+		errcount[t] = 12*t;
+		expcount[t] += 12*t;
+		if (expcount[t] > (1 << CNT_WIDTH_TF) - 1)
+			expcount[t] = (1 << CNT_WIDTH_TF) - 1;
+	}
+	ap_uint<2> errortype_ref = 0, errortype = 0;
+	Testbench_tmrc_folded(in_ref, out_ref, in, out, NUM_REPEAT, errortype_ref, errortype, errcount);
+
+	for (unsigned int i = 0; i < NUM_REPEAT*OFMDim1*OFMDim1; i++) {
+		ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> const exp = out_ref.read();
+		ap_uint<OFM_ChannelsTMR*ACTIVATION_PRECISION> const value = out.read();
+		if (value != exp) {
+			cout << "ERROR: pixel " << i << hex << " expected " << exp << " value " << value << dec << endl;
+			errors++;
+		}
+	}
+	if (errortype != errortype_ref) {
+		cout << "ERROR: errortype expected " << errortype_ref << " value " << errortype << endl;
+		errors++;
+	}
+	for (unsigned int t = 0; t < NUM_RED; t++) {
+		cout << "Triplet " << t << ": " << errcount[t] << " faults" << endl;
+		if (errcount[t] != expcount[t]) {
+			cout << "ERROR: triplet " << t << " expected count " << expcount[t] << " value " << errcount[t] << endl;
+			errors++;
+		}
+	}
+
+	if (!in_ref.empty() || !out_ref.empty() || !in.empty() || !out.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
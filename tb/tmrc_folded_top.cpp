@@ -0,0 +1,24 @@
+#define AP_INT_MAX_W 8191
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/memdata_tmrc.h"
+#include "data/config_tmrc.h"
+
+#define PE_TF 4
+#define CNT_WIDTH_TF 4
+
+void Testbench_tmrc_folded(stream<ap_uint<OFM_Channels1*ACTIVATION_PRECISION> > & in_ref,
+						   stream<ap_uint<(OFM_Channels1-NUM_RED*(REDF-1))*ACTIVATION_PRECISION> > & out_ref,
+						   stream<ap_uint<PE_TF*ACTIVATION_PRECISION> > & in,
+						   stream<ap_uint<(OFM_Channels1-NUM_RED*(REDF-1))*ACTIVATION_PRECISION> > & out,
+						   unsigned int numReps,
+						   ap_uint<2> &errortype_ref,
+						   ap_uint<2> &errortype,
+						   ap_uint<CNT_WIDTH_TF> errcount[NUM_RED]){
+#pragma HLS INTERFACE s_axilite port=errcount
+#pragma HLS DATAFLOW
+	TMRCheck_Batch<ACTIVATION_PRECISION, OFM_Channels1, NUM_RED, REDF, OFMDim1, MAX_CH_WIDTH>(in_ref, out_ref, errortype_ref, PARAM::channel_mask, PARAM::red_ch_index, numReps);
+	TMRCheck_Folded_Batch<ACTIVATION_PRECISION, OFM_Channels1, PE_TF, NUM_RED, REDF, OFMDim1, MAX_CH_WIDTH>(in, out, errortype, PARAM::channel_mask, PARAM::red_ch_index, errcount, numReps);
+}
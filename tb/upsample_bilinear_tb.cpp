@@ -0,0 +1,169 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file upsample_bilinear_tb.cpp
+ *
+ *  Testbench for the bilinear upsampling, for a signed input with PE folding
+ *  and an odd scale factor and for an unsigned input with an even one
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/upsample_bilinear_config.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 3
+
+void Testbench_upsample_bilinear(stream<ap_uint<PE_UB*PRECISION_UB> > & in, stream<ap_uint<PE_UB*PRECISION_UB> > & out,
+	stream<ap_uint<FM_CHANNELS2_UB*PRECISION2_UB> > & in2, stream<ap_uint<FM_CHANNELS2_UB*PRECISION2_UB> > & out2,
+	unsigned int numReps);
+
+// Neighbours and weight of the second one in units of 1/(2*Scale) for output sample o
+void golden_coord(int o, int ifm, int scale, int &i0, int &i1, int &w1)
+{
+	double const src = (o + 0.5) / scale - 0.5;
+	int const base = (int)floor(src);
+	w1 = (int)lround((src - base) * 2 * scale);
+	i0 = base < 0? 0 : base;
+	i1 = base+1 > ifm-1? ifm-1 : base+1;
+}
+
+// Golden model: bilinear interpolation with half-pixel centers, rounded to nearest
+template<unsigned IFM, unsigned OFM, unsigned CH>
+void golden_upsample(int const (&in)[IFM][IFM][CH], int (&out)[OFM][OFM][CH])
+{
+	int const scale = OFM / IFM;
+	int const D = 4 * scale * scale;
+	for (int y = 0; y < int(OFM); y++) {
+		int y0, y1, wy1;
+		golden_coord(y, IFM, scale, y0, y1, wy1);
+		for (int x = 0; x < int(OFM); x++) {
+			int x0, x1, wx1;
+			golden_coord(x, IFM, scale, x0, x1, wx1);
+			for (int c = 0; c < int(CH); c++) {
+				int const v = (2*scale - wy1) * ((2*scale - wx1) * in[y0][x0][c] + wx1 * in[y0][x1][c])
+							+ wy1 * ((2*scale - wx1) * in[y1][x0][c] + wx1 * in[y1][x1][c]);
+				out[y][x][c] = (int)floor((v + D/2) / double(D));
+			}
+		}
+	}
+}
+
+int main()
+{
+	static int IN1[NUM_REPEAT][IFMDIM_UB][IFMDIM_UB][FM_CHANNELS_UB];
+	static int OUT1[OFMDIM_UB][OFMDIM_UB][FM_CHANNELS_UB];
+	static int IN2[NUM_REPEAT][IFMDIM2_UB][IFMDIM2_UB][FM_CHANNELS2_UB];
+	static int OUT2[OFMDIM2_UB][OFMDIM2_UB][FM_CHANNELS2_UB];
+	stream<ap_uint<PE_UB*PRECISION_UB> > in("in"), out("out");
+	stream<ap_uint<FM_CHANNELS2_UB*PRECISION2_UB> > in2("in2"), out2("out2");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int y = 0; y < IFMDIM_UB; y++) {
+			for (unsigned int x = 0; x < IFMDIM_UB; x++) {
+				for (unsigned int nf = 0; nf < FM_CHANNELS_UB/PE_UB; nf++) {
+					ap_uint<PE_UB*PRECISION_UB> word;
+					for (unsigned int pe = 0; pe < PE_UB; pe++) {
+						ap_int<PRECISION_UB> const val = rand();
+						IN1[rep][y][x][nf*PE_UB + pe] = val;
+						word((pe+1)*PRECISION_UB-1, pe*PRECISION_UB) = val;
+					}
+					in.write(word);
+				}
+			}
+		}
+		for (unsigned int y = 0; y < IFMDIM2_UB; y++) {
+			for (unsigned int x = 0; x < IFMDIM2_UB; x++) {
+				ap_uint<FM_CHANNELS2_UB*PRECISION2_UB> word;
+				for (unsigned int c = 0; c < FM_CHANNELS2_UB; c++) {
+					ap_uint<PRECISION2_UB> const val = rand();
+					IN2[rep][y][x][c] = val;
+					word((c+1)*PRECISION2_UB-1, c*PRECISION2_UB) = val;
+				}
+				in2.write(word);
+			}
+		}
+	}
+
+	Testbench_upsample_bilinear(in, out, in2, out2, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		golden_upsample<IFMDIM_UB, OFMDIM_UB, FM_CHANNELS_UB>(IN1[rep], OUT1);
+		for (unsigned int y = 0; y < OFMDIM_UB; y++) {
+			for (unsigned int x = 0; x < OFMDIM_UB; x++) {
+				for (unsigned int nf = 0; nf < FM_CHANNELS_UB/PE_UB; nf++) {
+					ap_uint<PE_UB*PRECISION_UB> const word = out.read();
+					for (unsigned int pe = 0; pe < PE_UB; pe++) {
+						ap_int<PRECISION_UB> const val = word((pe+1)*PRECISION_UB-1, pe*PRECISION_UB);
+						int const exp = OUT1[y][x][nf*PE_UB + pe];
+						if (val != exp) {
+							cout << "ERROR: rep " << rep << " Expected[" << y << "][" << x << "][" << nf*PE_UB + pe << "]=" << exp << " actual " << val << endl;
+							errors++;
+						}
+					}
+				}
+			}
+		}
+		golden_upsample<IFMDIM2_UB, OFMDIM2_UB, FM_CHANNELS2_UB>(IN2[rep], OUT2);
+		for (unsigned int y = 0; y < OFMDIM2_UB; y++) {
+			for (unsigned int x = 0; x < OFMDIM2_UB; x++) {
+				ap_uint<FM_CHANNELS2_UB*PRECISION2_UB> const word = out2.read();
+				for (unsigned int c = 0; c < FM_CHANNELS2_UB; c++) {
+					ap_uint<PRECISION2_UB> const val = word((c+1)*PRECISION2_UB-1, c*PRECISION2_UB);
+					int const exp = OUT2[y][x][c];
+					if (val != exp) {
+						cout << "ERROR: rep " << rep << " Expected2[" << y << "][" << x << "][" << c << "]=" << exp << " actual " << val << endl;
+						errors++;
+					}
+				}
+			}
+		}
+	}
+
+	if (!in.empty() || !out.empty() || !in2.empty() || !out2.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,15 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/upsample_bilinear_config.h"
+
+void Testbench_upsample_bilinear(stream<ap_uint<PE_UB*PRECISION_UB> > & in, stream<ap_uint<PE_UB*PRECISION_UB> > & out,
+	stream<ap_uint<FM_CHANNELS2_UB*PRECISION2_UB> > & in2, stream<ap_uint<FM_CHANNELS2_UB*PRECISION2_UB> > & out2,
+	unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	UpsampleBilinear_Batch<OFMDIM_UB, IFMDIM_UB, FM_CHANNELS_UB, PE_UB, ap_int<PRECISION_UB> >(in, out, numReps);
+	UpsampleBilinear_Batch<OFMDIM2_UB, IFMDIM2_UB, FM_CHANNELS2_UB, FM_CHANNELS2_UB, ap_uint<PRECISION2_UB> >(in2, out2, numReps);
+}
@@ -0,0 +1,135 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file upsample_mmv_tb.cpp
+ *
+ *  Testbench for the Nearest Neighbour upsampling of non-square feature maps,
+ *  with one and with MMV output pixels per cycle
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/upsample_mmv_config.h"
+using namespace hls;
+using namespace std;
+
+#define NUM_REPEAT 3
+#define CW_UM (FM_CHANNELS_UM*PRECISION_UM)
+
+void Testbench_upsample_mmv(stream<ap_uint<CW_UM> > & in_mmv, stream<MultiChanData<MMV_UM, CW_UM> > & out_mmv,
+	stream<ap_uint<CW_UM> > & in_ns, stream<ap_uint<CW_UM> > & out_ns,
+	stream<ap_uint<CW_UM> > & in_sq, stream<ap_uint<CW_UM> > & out_sq,
+	stream<ap_uint<CW_UM> > & in_sq_ref, stream<ap_uint<CW_UM> > & out_sq_ref,
+	unsigned int numReps);
+
+// Golden model: source index along one dimension, the border padding split as in UpsampleNearestNeighbour
+int golden_source(int o, int ofm, int ifm)
+{
+	int const scale = ofm / ifm;
+	int const pad = ofm % ifm;
+	int const pad_low = pad - pad/2;
+	int const src = o < pad_low? 0 : (o - pad_low) / scale;
+	return src < ifm? src : ifm-1;
+}
+
+int main()
+{
+	static ap_uint<CW_UM> IMAGE[NUM_REPEAT][IFMDIM_Y_UM][IFMDIM_X_UM];
+	stream<ap_uint<CW_UM> > in_mmv("in_mmv"), in_ns("in_ns"), out_ns("out_ns");
+	stream<ap_uint<CW_UM> > in_sq("in_sq"), out_sq("out_sq"), in_sq_ref("in_sq_ref"), out_sq_ref("out_sq_ref");
+	stream<MultiChanData<MMV_UM, CW_UM> > out_mmv("out_mmv");
+	unsigned int errors = 0;
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (unsigned int y = 0; y < IFMDIM_Y_UM; y++) {
+			for (unsigned int x = 0; x < IFMDIM_X_UM; x++) {
+				ap_uint<CW_UM> const val = rand();
+				IMAGE[rep][y][x] = val;
+				in_mmv.write(val);
+				in_ns.write(val);
+			}
+		}
+		for (unsigned int i = 0; i < IFMDIM_SQ_UM*IFMDIM_SQ_UM; i++) {
+			ap_uint<CW_UM> const val = rand();
+			in_sq.write(val);
+			in_sq_ref.write(val);
+		}
+	}
+
+	Testbench_upsample_mmv(in_mmv, out_mmv, in_ns, out_ns, in_sq, out_sq, in_sq_ref, out_sq_ref, NUM_REPEAT);
+
+	for (unsigned int rep = 0; rep < NUM_REPEAT; rep++) {
+		for (int y = 0; y < OFMDIM_Y_UM; y++) {
+			int const sy = golden_source(y, OFMDIM_Y_UM, IFMDIM_Y_UM);
+			MultiChanData<MMV_UM, CW_UM> group;
+			for (int x = 0; x < OFMDIM_X_UM; x++) {
+				ap_uint<CW_UM> const exp = IMAGE[rep][sy][golden_source(x, OFMDIM_X_UM, IFMDIM_X_UM)];
+				ap_uint<CW_UM> const val = out_ns.read();
+				if (val != exp) {
+					cout << "ERROR: rep " << rep << " Expected[" << y << "][" << x << "]=" << exp << " actual " << val << endl;
+					errors++;
+				}
+				if (x % MMV_UM == 0)
+					group = out_mmv.read();
+				if (group.data[x % MMV_UM] != exp) {
+					cout << "ERROR MMV: rep " << rep << " Expected[" << y << "][" << x << "]=" << exp << " actual " << group.data[x % MMV_UM] << endl;
+					errors++;
+				}
+			}
+		}
+		// square maps match UpsampleNearestNeighbour
+		for (unsigned int i = 0; i < OFMDIM_SQ_UM*OFMDIM_SQ_UM; i++) {
+			ap_uint<CW_UM> const exp = out_sq_ref.read();
+			ap_uint<CW_UM> const val = out_sq.read();
+			if (val != exp) {
+				cout << "ERROR square: rep " << rep << " pixel " << i << " expected " << exp << " actual " << val << endl;
+				errors++;
+			}
+		}
+	}
+
+	if (!in_mmv.empty() || !out_mmv.empty() || !in_ns.empty() || !out_ns.empty() ||
+		!in_sq.empty() || !out_sq.empty() || !in_sq_ref.empty() || !out_sq_ref.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,21 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/upsample_mmv_config.h"
+
+#define CW_UM (FM_CHANNELS_UM*PRECISION_UM)
+
+void Testbench_upsample_mmv(stream<ap_uint<CW_UM> > & in_mmv, stream<MultiChanData<MMV_UM, CW_UM> > & out_mmv,
+	stream<ap_uint<CW_UM> > & in_ns, stream<ap_uint<CW_UM> > & out_ns,
+	stream<ap_uint<CW_UM> > & in_sq, stream<ap_uint<CW_UM> > & out_sq,
+	stream<ap_uint<CW_UM> > & in_sq_ref, stream<ap_uint<CW_UM> > & out_sq_ref,
+	unsigned int numReps)
+{
+#pragma HLS DATAFLOW
+	UpsampleNearestNeighbour_MMV_Batch<OFMDIM_X_UM, OFMDIM_Y_UM, IFMDIM_X_UM, IFMDIM_Y_UM, FM_CHANNELS_UM, ap_uint<PRECISION_UM>, MMV_UM>(in_mmv, out_mmv, numReps);
+	UpsampleNearestNeighbour_NonSquare_Batch<OFMDIM_X_UM, OFMDIM_Y_UM, IFMDIM_X_UM, IFMDIM_Y_UM, FM_CHANNELS_UM, ap_uint<PRECISION_UM> >(in_ns, out_ns, numReps);
+	UpsampleNearestNeighbour_NonSquare_Batch<OFMDIM_SQ_UM, OFMDIM_SQ_UM, IFMDIM_SQ_UM, IFMDIM_SQ_UM, FM_CHANNELS_UM, ap_uint<PRECISION_UM> >(in_sq, out_sq, numReps);
+	UpsampleNearestNeighbour_Batch<OFMDIM_SQ_UM, IFMDIM_SQ_UM, FM_CHANNELS_UM, ap_uint<PRECISION_UM> >(in_sq_ref, out_sq_ref, numReps);
+}
@@ -0,0 +1,106 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file virtual_fifo_tb.cpp
+ *
+ *  Testbench for the virtual FIFO, checking that frames pass through in order
+ *  both with every word spilled to the external ring buffer and with words
+ *  bypassing it
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_virtual_fifo.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_virtual_fifo(stream<ap_uint<DATA_WIDTH_VF> > & in_spill, stream<ap_uint<DATA_WIDTH_VF> > & out_spill,
+		stream<ap_uint<DATA_WIDTH_VF> > & in_bypass, stream<ap_uint<DATA_WIDTH_VF> > & out_bypass,
+		ap_uint<DATA_WIDTH_VF> * mem_spill, ap_uint<DATA_WIDTH_VF> * mem_bypass, unsigned int numReps);
+
+int main()
+{
+	stream<ap_uint<DATA_WIDTH_VF> > in_spill("in_spill"), out_spill("out_spill");
+	stream<ap_uint<DATA_WIDTH_VF> > in_bypass("in_bypass"), out_bypass("out_bypass");
+	static ap_uint<DATA_WIDTH_VF> mem_spill[DEPTH_VF], mem_bypass[DEPTH_VF];
+	static ap_uint<DATA_WIDTH_VF> expected[NUM_REPS_VF * NUM_WORDS_VF];
+
+	srand(1);
+	for (unsigned i = 0; i < NUM_REPS_VF * NUM_WORDS_VF; i++) {
+		expected[i] = ap_uint<DATA_WIDTH_VF>(rand()) ^ (ap_uint<DATA_WIDTH_VF>(i) << 16);
+		in_spill.write(expected[i]);
+		in_bypass.write(expected[i]);
+	}
+	for (unsigned i = 0; i < DEPTH_VF; i++) {
+		mem_spill[i] = 0;
+		mem_bypass[i] = 0;
+	}
+
+	Testbench_virtual_fifo(in_spill, out_spill, in_bypass, out_bypass, mem_spill, mem_bypass, NUM_REPS_VF);
+
+	unsigned errors = 0;
+	for (unsigned i = 0; i < NUM_REPS_VF * NUM_WORDS_VF; i++) {
+		ap_uint<DATA_WIDTH_VF> const spill = out_spill.read();
+		ap_uint<DATA_WIDTH_VF> const bypass = out_bypass.read();
+		if ((spill != expected[i]) || (bypass != expected[i])) {
+			cout << "ERROR: word " << i << " expected " << expected[i] << " got " << spill << " spilled and "
+				<< bypass << " bypassed" << endl;
+			errors++;
+		}
+	}
+	// The ring buffer has wrapped around: it holds the last words spilled into each of its slots
+	unsigned const total = NUM_REPS_VF * NUM_WORDS_VF;
+	unsigned const last = total - (total % DEPTH_VF == 0? DEPTH_VF : total % DEPTH_VF);
+	for (unsigned i = 0; i < DEPTH_VF; i++) {
+		ap_uint<DATA_WIDTH_VF> const ref = (last + i < total)? expected[last + i] : expected[last - DEPTH_VF + i];
+		if (mem_spill[i] != ref) {
+			cout << "ERROR: ring buffer slot " << i << " expected " << ref << " got " << mem_spill[i] << endl;
+			errors++;
+		}
+	}
+
+	if (!in_spill.empty() || !in_bypass.empty() || !out_spill.empty() || !out_bypass.empty()) {
+		cout << "ERROR: streams not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
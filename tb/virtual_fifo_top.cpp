@@ -0,0 +1,18 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "data/config_virtual_fifo.h"
+
+void Testbench_virtual_fifo(stream<ap_uint<DATA_WIDTH_VF> > & in_spill, stream<ap_uint<DATA_WIDTH_VF> > & out_spill,
+		stream<ap_uint<DATA_WIDTH_VF> > & in_bypass, stream<ap_uint<DATA_WIDTH_VF> > & out_bypass,
+		ap_uint<DATA_WIDTH_VF> * mem_spill, ap_uint<DATA_WIDTH_VF> * mem_bypass, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi offset=slave port=mem_spill bundle=spill depth=DEPTH_VF max_read_burst_length=BURST_VF max_write_burst_length=BURST_VF
+#pragma HLS INTERFACE m_axi offset=slave port=mem_bypass bundle=bypass depth=DEPTH_VF max_read_burst_length=BURST_VF max_write_burst_length=BURST_VF
+#pragma HLS INTERFACE s_axilite port=numReps
+#pragma HLS DATAFLOW
+	VirtualFIFO_Batch<DATA_WIDTH_VF, NUM_WORDS_VF, DEPTH_VF, BURST_VF, false>(in_spill, out_spill, mem_spill, numReps);
+	VirtualFIFO_Batch<DATA_WIDTH_VF, NUM_WORDS_VF, DEPTH_VF, BURST_VF>(in_bypass, out_bypass, mem_bypass, numReps);
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file weight_cache_tb.cpp
+ *
+ *  Testbench for the parameter streamer with an on-chip tile cache
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cstdlib>
+#include <hls_stream.h>
+#include "ap_int.h"
+#include "data/config_weight_cache.h"
+using namespace hls;
+using namespace std;
+
+void Testbench_weight_cache(ap_uint<SIMD_WC*PE_WC*WP_WC> const * in, stream<ap_uint<SIMD_WC*PE_WC*WP_WC> > & out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<SIMD_WC*PE_WC*WP_WC> mem[TILES_WC];
+	stream<ap_uint<SIMD_WC*PE_WC*WP_WC> > out("out");
+	unsigned int errors = 0;
+
+	// the second call must replay the cache loaded by the first and fetch only the other tiles
+	static ap_uint<SIMD_WC*PE_WC*WP_WC> expected[TILES_WC];
+	for (unsigned int call = 0; call < 2; call++) {
+		for (unsigned int tile = 0; tile < TILES_WC; tile++) {
+			mem[tile] = rand();
+			if ((call == 0) || (tile >= CACHED_TILES_WC))
+				expected[tile] = mem[tile];
+		}
+
+		Testbench_weight_cache(mem, out, NUM_REPS_WC);
+
+		for (unsigned int rep = 0; rep < NUM_REPS_WC; rep++) {
+			for (unsigned int tile = 0; tile < TILES_WC; tile++) {
+				ap_uint<SIMD_WC*PE_WC*WP_WC> const value = out.read();
+				if (value != expected[tile]) {
+					cout << "ERROR: call " << call << " rep " << rep << " tile " << tile << hex << " expected " << expected[tile] << " value " << value << dec << endl;
+					errors++;
+				}
+			}
+		}
+	}
+	if (!out.empty()) {
+		cout << "ERROR: output stream not empty" << endl;
+		errors++;
+	}
+	if (errors) {
+		cout << "Test failed with " << errors << " errors" << endl;
+		return 1;
+	}
+	cout << "Test passed" << endl;
+	return 0;
+}
@@ -0,0 +1,12 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+#include "data/config_weight_cache.h"
+
+void Testbench_weight_cache(ap_uint<SIMD_WC*PE_WC*WP_WC> const * in, stream<ap_uint<SIMD_WC*PE_WC*WP_WC> > & out, unsigned int numReps)
+{
+#pragma HLS INTERFACE m_axi port=in offset=slave
+	static OnChipCache<CACHED_TILES_WC, SIMD_WC*PE_WC*WP_WC> cache;
+	GenParamStream_Cached<TILES_WC, CACHED_TILES_WC, SIMD_WC, PE_WC, WP_WC>(in, out, numReps, cache, ap_resource_lutram());
+}
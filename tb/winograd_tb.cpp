@@ -0,0 +1,115 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+/******************************************************************************
+ *
+ *  \file winograd_tb.cpp
+ *
+ *  Testbench for the Winograd F(2x2,3x3) convolutional layer
+ *
+ *****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <ctime>
+#include <cstring>
+#include <hls_stream.h>
+#include <cstdlib>
+#define AP_INT_MAX_W 8191
+#include "ap_int.h"
+#include "weights.hpp"
+#include "bnn-library.h"
+#include "data/memdata_winograd.h"
+#include "data/config_winograd.h"
+#include "activations.hpp"
+#include "interpret.hpp"
+#include "convlayer.h"
+using namespace hls;
+using namespace std;
+
+#define MAX_IMAGES 2
+void Testbench_winograd(stream<ap_uint<IFM_Channels_W*INPUT_PRECISION_W> > & in, stream<ap_uint<OFM_Channels_W*ACTIVATION_PRECISION_W> > & out, unsigned int numReps);
+
+int main()
+{
+	static ap_uint<INPUT_PRECISION_W> IMAGE[MAX_IMAGES][IFMDim_W][IFMDim_W][IFM_Channels_W];
+	stream<ap_uint<IFM_Channels_W*INPUT_PRECISION_W> > input_stream("input_stream");
+	stream<ap_uint<OFM_Channels_W*ACTIVATION_PRECISION_W> > output_stream("output_stream");
+
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < IFMDim_W; oy++) {
+			for (unsigned int ox = 0; ox < IFMDim_W; ox++) {
+				ap_uint<IFM_Channels_W*INPUT_PRECISION_W> input_word = 0;
+				for (unsigned int channel = 0; channel < IFM_Channels_W; channel++) {
+					ap_uint<INPUT_PRECISION_W> input = (ap_uint<INPUT_PRECISION_W>)rand();
+					IMAGE[n_image][oy][ox][channel] = input;
+					input_word((channel+1)*INPUT_PRECISION_W-1, channel*INPUT_PRECISION_W) = input;
+				}
+				input_stream.write(input_word);
+			}
+		}
+	}
+
+	Testbench_winograd(input_stream, output_stream, MAX_IMAGES);
+
+	int err_counter = 0;
+	for (unsigned int n_image = 0; n_image < MAX_IMAGES; n_image++) {
+		for (unsigned int oy = 0; oy < OFMDim_W; oy++) {
+			for (unsigned int ox = 0; ox < OFMDim_W; ox++) {
+				ap_uint<OFM_Channels_W*ACTIVATION_PRECISION_W> outElem = output_stream.read();
+				for (unsigned int channel = 0; channel < OFM_Channels_W; channel++) {
+					// direct 3x3 convolution as reference
+					int exp = 0;
+					for (unsigned int c = 0; c < IFM_Channels_W; c++)
+						for (unsigned int ky = 0; ky < 3; ky++)
+							for (unsigned int kx = 0; kx < 3; kx++)
+								exp += PARAM_WINOGRAD::raw[channel][c][ky][kx] * IMAGE[n_image][oy+ky][ox+kx][c];
+					ap_int<ACTIVATION_PRECISION_W> const EXP = exp;
+					ap_int<ACTIVATION_PRECISION_W> out_chan;
+					out_chan(ACTIVATION_PRECISION_W-1, 0) = outElem((channel+1)*ACTIVATION_PRECISION_W-1, channel*ACTIVATION_PRECISION_W);
+					if (EXP != out_chan) {
+						std::cout << "ERROR: Image " << n_image << " Pixel (" << oy << "," << ox << ") Expected[" << channel << "]=" << EXP << " actual " << out_chan << std::endl;
+						err_counter++;
+					}
+				}
+			}
+		}
+	}
+	if (!output_stream.empty()) {
+		std::cout << "ERROR: Output stream not empty" << std::endl;
+		err_counter++;
+	}
+	if(err_counter == 0){
+		return 0;
+	}
+	else{
+		return 1;
+	}
+}
@@ -0,0 +1,17 @@
+#include <hls_stream.h>
+using namespace hls;
+#include "ap_int.h"
+#include "bnn-library.h"
+
+#include "activations.hpp"
+#include "weights.hpp"
+#include "interpret.hpp"
+#include "convlayer.h"
+#include "data/memdata_winograd.h"
+#include "data/config_winograd.h"
+
+void Testbench_winograd(stream<ap_uint<IFM_Channels_W*INPUT_PRECISION_W> > & in, stream<ap_uint<OFM_Channels_W*ACTIVATION_PRECISION_W> > & out, unsigned int numReps){
+#pragma HLS DATAFLOW
+	WinogradConvLayer_Batch<IFM_Channels_W, IFMDim_W, OFM_Channels_W, SIMD_W, PE_W, Slice<ap_uint<INPUT_PRECISION_W> >, Slice<ap_int<ACTIVATION_PRECISION_W> >, Identity, ap_int<ACC_PRECISION_W> >
+		(in, out, PARAM_WINOGRAD::weights, PassThroughActivation<ap_int<ACTIVATION_PRECISION_W>>(), numReps, ap_resource_dsp());
+}
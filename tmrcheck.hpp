@@ -45,6 +45,107 @@
 #define TMR_HPP
 
 #include "hls_stream.h"
+#include "mmv.hpp"
+
+/**
+ * \brief Redundancy check of a single OFM pixel
+ *
+ * Outputs a single channel for each triplication of the pixel, being this channel one which contains valid data,
+ * and ORs the character of the detected errors into errortype.
+ *
+ * \tparam InW              Input data width, activation precision
+ * \tparam OFMChannels      Number of Output Feature Map channels, including triplications
+ * \tparam NUM_RED          Number of redundancies (or triplicated channels)
+ * \tparam REDF             Redundancy factor (3 to triplicate)
+ * \tparam MAX_CH_WIDTH     Value to determine the precision of channel indexes
+ *
+ * \param input             All channels of the pixel, including triplications
+ * \param errortype         Flag to inform redundancy check results. LSB set if one PE is faulty, MSB set if all differ
+ * \param channel_mask      Value with binary channel masks (1 if channel is triplicated, 0 otherwise)
+ * \param red_ch_index      Array of redundant triplets' indexes. Each position stores the first triplicated channel index of a triplet
+ *
+ * \return                  Valid channels of the pixel
+ */
+
+template<unsigned int InW,
+         unsigned int OFMChannels,
+         unsigned int NUM_RED,
+         unsigned int REDF,
+         unsigned int MAX_CH_WIDTH>
+ap_uint<InW*(OFMChannels-NUM_RED*(REDF-1))> TMRVote(ap_uint<InW*OFMChannels> const &input,
+              ap_uint<2> &errortype,
+              ap_uint<OFMChannels> channel_mask,
+              ap_uint<MAX_CH_WIDTH> red_ch_index[NUM_RED]) {
+#pragma HLS INLINE
+
+    // Number of channels without triplications
+    constexpr unsigned int OFMChannelsTMR = (OFMChannels-NUM_RED*(REDF-1));
+
+    ap_uint<InW*NUM_RED> tmr_out = {0};
+    ap_uint<InW*OFMChannelsTMR> out_aux = {0};
+    ap_uint<2> numerrors[NUM_RED];
+#pragma HLS ARRAY_PARTITION variable=numerrors complete dim=0
+
+    // Check triplicated channel indexes and store the corresponding data to perform TMR check
+    for(unsigned int i = 0; i < NUM_RED; i++){
+#pragma HLS UNROLL
+
+        numerrors[i] = 0;
+        // TMR CHECK: start
+        // Store index of triplicated channel
+        unsigned int idx = red_ch_index[i];
+        // CompareLoop: performs comparisons between PE0, PE1, PE2
+        for(unsigned int y = 0; y < REDF; y++){
+            for(unsigned int x = y+1; x < REDF; x++){
+                if( (input((idx+y+1)*InW-1, (idx+y)*InW)) == (input((idx+x+1)*InW-1, (idx+x)*InW)) ){
+                    tmr_out((i+1)*InW-1, i*InW) = input((idx+x+1)*InW-1, (idx+x)*InW);
+                } else {
+                    numerrors[i]++;
+                    if(numerrors[i] == REDF){
+                        errortype |= (ap_uint<2>)0b10;
+                    } else {
+                        errortype |= (ap_uint<2>)0b1;
+                    }
+                    tmr_out((i+1)*InW-1, i*InW) = input((idx+1)*InW-1, idx*InW);
+                }
+            }
+        } // end CompareLoop
+    } // end Check triplicated channel indexes
+
+    ap_uint<OFMChannels> unitL = 1;
+    ap_uint<1> compute[OFMChannels];
+#pragma HLS ARRAY_PARTITION variable=compute complete dim=0
+    // ChannelLoop: iterates over all OFM channels (including triplications), and outputs either: TMR check output/input/nothing
+    for(unsigned int k = 0; k < OFMChannels; k++){
+#pragma HLS UNROLL
+        compute[k] = 0;
+        // Check if current channel is any of the FIRST triplicated
+        for(unsigned int i = 0; i < NUM_RED; i++){
+            // Store index of triplicated channel
+            unsigned int idx = red_ch_index[i];
+            if(k == idx){
+                compute[k] = 1;
+            }
+        }
+        
+        // If it is one of the first triplicated, forward the TMR check output, which contains valid data
+        if(compute[k]){
+            out_aux = out_aux >> InW;
+            out_aux(OFMChannelsTMR*InW-1, (OFMChannelsTMR-1)*InW) = tmr_out(InW-1, 0);
+            tmr_out = tmr_out >> InW;
+        // If it is not a first triplicated channel, check if it is a triplicated or not using mask
+        } else if((channel_mask & (unitL << k)) != 0){
+            ; // Nothing to do, skip triplicated channel
+        // If it is a not triplicated channel, forward the input data
+        } else {
+            out_aux = out_aux >> InW;
+            out_aux(OFMChannelsTMR*InW-1, (OFMChannelsTMR-1)*InW) = input((k+1)*InW-1, k*InW);
+        }
+
+    } // end ChannelLoop
+
+    return out_aux;
+} // end TMRVote
 
 /**
  * \brief Smart TMR block
@@ -82,8 +183,6 @@ void TMRCheck(hls::stream<ap_uint<InW*OFMChannels>> &in,
 #pragma HLS ARRAY_PARTITION variable=red_ch_index complete dim=0
     ap_uint<InW*OFMChannels> input;
 
-    // Number of channels without triplications
-    constexpr unsigned int OFMChannelsTMR = (OFMChannels-NUM_RED*(REDF-1));
     errortype = 0;
 
     // CheckLoop: iterates over all OFM positions
@@ -93,70 +192,7 @@ void TMRCheck(hls::stream<ap_uint<InW*OFMChannels>> &in,
         // Read input stream
         input = in.read();
 
-        ap_uint<InW*NUM_RED> tmr_out = {0};
-        ap_uint<InW*OFMChannelsTMR> out_aux = {0};
-        ap_uint<2> numerrors[NUM_RED];
-#pragma HLS ARRAY_PARTITION variable=numerrors complete dim=0
-
-        // Check triplicated channel indexes and store the corresponding data to perform TMR check
-        for(unsigned int i = 0; i < NUM_RED; i++){
-#pragma HLS UNROLL
-
-            numerrors[i] = 0;
-            // TMR CHECK: start
-            // Store index of triplicated channel
-            unsigned int idx = red_ch_index[i];
-            // CompareLoop: performs comparisons between PE0, PE1, PE2
-            for(unsigned int y = 0; y < REDF; y++){
-                for(unsigned int x = y+1; x < REDF; x++){
-                    if( (input((idx+y+1)*InW-1, (idx+y)*InW)) == (input((idx+x+1)*InW-1, (idx+x)*InW)) ){
-                        tmr_out((i+1)*InW-1, i*InW) = input((idx+x+1)*InW-1, (idx+x)*InW);
-                    } else {
-                        numerrors[i]++;
-                        if(numerrors[i] == REDF){
-                            errortype |= (ap_uint<2>)0b10;
-                        } else {
-                            errortype |= (ap_uint<2>)0b1;
-                        }
-                        tmr_out((i+1)*InW-1, i*InW) = input((idx+1)*InW-1, idx*InW);
-                    }
-                }
-            } // end CompareLoop
-        } // end Check triplicated channel indexes
-
-        ap_uint<OFMChannels> unitL = 1;
-        ap_uint<1> compute[OFMChannels];
-#pragma HLS ARRAY_PARTITION variable=compute complete dim=0
-        // ChannelLoop: iterates over all OFM channels (including triplications), and outputs either: TMR check output/input/nothing
-        for(unsigned int k = 0; k < OFMChannels; k++){
-#pragma HLS UNROLL
-            compute[k] = 0;
-            // Check if current channel is any of the FIRST triplicated
-            for(unsigned int i = 0; i < NUM_RED; i++){
-                // Store index of triplicated channel
-                unsigned int idx = red_ch_index[i];
-                if(k == idx){
-                    compute[k] = 1;
-                }
-            }
-            
-            // If it is one of the first triplicated, forward the TMR check output, which contains valid data
-            if(compute[k]){
-                out_aux = out_aux >> InW;
-                out_aux(OFMChannelsTMR*InW-1, (OFMChannelsTMR-1)*InW) = tmr_out(InW-1, 0);
-                tmr_out = tmr_out >> InW;
-            // If it is not a first triplicated channel, check if it is a triplicated or not using mask
-            } else if((channel_mask & (unitL << k)) != 0){
-                ; // Nothing to do, skip triplicated channel
-            // If it is a not triplicated channel, forward the input data
-            } else {
-                out_aux = out_aux >> InW;
-                out_aux(OFMChannelsTMR*InW-1, (OFMChannelsTMR-1)*InW) = input((k+1)*InW-1, k*InW);
-            }
-
-        } // end ChannelLoop
-
-        out.write(out_aux);
+        out.write(TMRVote<InW, OFMChannels, NUM_RED, REDF, MAX_CH_WIDTH>(input, errortype, channel_mask, red_ch_index));
     } // end CheckLoop
 } // end TMRCheck
 
@@ -201,4 +237,205 @@ void TMRCheck_Batch(hls::stream<ap_uint<InW*OFMChannels>> &in,
     }
 }
 
+/**
+ * \brief Smart TMR block for MMV (batch)
+ *
+ * Works as TMRCheck_Batch on an OFM computed with MMV pixels in parallel. The redundancy check is performed on all
+ * MMV pixel lanes of an input element in the same cycle.
+ *
+ * \tparam InW              Input data width, activation precision
+ * \tparam OFMChannels      Number of Output Feature Map channels, including triplications
+ * \tparam NUM_RED          Number of redundancies (or triplicated channels)
+ * \tparam REDF             Redundancy factor (3 to triplicate)
+ * \tparam OFMDim           Width and Height of the Output Feature Map (assumed square)
+ * \tparam MAX_CH_WIDTH     Value to determine the precision of channel indexes
+ * \tparam MMV              Number of pixels per input element
+ *
+ * \param in                Input stream
+ * \param out               Output stream
+ * \param errortype         Flag to inform redundancy check results. 0 if no faults, LSB set if one PE is faulty, MSB set if all differ
+ * \param channel_mask      Value with binary channel masks (1 if channel is triplicated, 0 otherwise)
+ * \param red_ch_index      Array of redundant triplets' indexes. Each position stores the first triplicated channel index of a triplet
+ * \param numReps           Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+
+template<unsigned int InW,
+         unsigned int OFMChannels,
+         unsigned int NUM_RED,
+         unsigned int REDF,
+         unsigned int OFMDim,
+         unsigned int MAX_CH_WIDTH,
+         unsigned int MMV>
+void TMRCheck_MMV_Batch(hls::stream<MultiChanData<MMV, InW*OFMChannels>> &in,
+                        hls::stream<MultiChanData<MMV, InW*(OFMChannels-NUM_RED*(REDF-1))>> &out,
+                        ap_uint<2> &errortype,
+                        ap_uint<OFMChannels> channel_mask,
+                        ap_uint<MAX_CH_WIDTH> red_ch_index[NUM_RED],
+                        unsigned int numReps) {
+    static_assert((OFMDim * OFMDim) % MMV == 0, "MMV must divide the number of OFM pixels");
+#pragma HLS ARRAY_PARTITION variable=red_ch_index complete dim=0
+
+    // Number of channels without triplications
+    constexpr unsigned int OFMChannelsTMR = (OFMChannels-NUM_RED*(REDF-1));
+    ap_uint<2> err = 0;
+
+    // CheckLoop: iterates over all groups of MMV OFM positions
+    for(unsigned int pos = 0; pos < numReps * (OFMDim * OFMDim / MMV); pos++){
+#pragma HLS pipeline style=flp II=1
+        MultiChanData<MMV, InW*OFMChannels> const input = in.read();
+        MultiChanData<MMV, InW*OFMChannelsTMR> out_aux;
+        ap_uint<2> lane_err[MMV];
+#pragma HLS ARRAY_PARTITION variable=lane_err complete dim=0
+        // LaneLoop: checks all pixel lanes in parallel
+        for(unsigned int v = 0; v < MMV; v++){
+#pragma HLS UNROLL
+            lane_err[v] = 0;
+            out_aux.data[v] = TMRVote<InW, OFMChannels, NUM_RED, REDF, MAX_CH_WIDTH>(input.data[v], lane_err[v], channel_mask, red_ch_index);
+        }
+        for(unsigned int v = 0; v < MMV; v++){
+#pragma HLS UNROLL
+            err |= lane_err[v];
+        }
+        out.write(out_aux);
+    } // end CheckLoop
+    errortype = err;
+}
+
+/**
+ * \brief Smart TMR block with PE folding and per-triplet fault counters (batch)
+ *
+ * Works as TMRCheck_Batch, but receives the OFM folded into OFMChannels/PE words per pixel, so the checker can
+ * directly follow an MVAU with PE < OFMChannels. Every triplet must be contained in a single fold, i.e.
+ * red_ch_index[i]%PE + REDF <= PE. The output is a single word per pixel as for TMRCheck_Batch.
+ *
+ * Besides the errortype flag of the batch, a saturating counter per triplet counts the pixels in which the
+ * triplet did not agree. The counters are accumulated on top of their values on entry, so they can be mapped to
+ * a register interface (e.g. #pragma HLS INTERFACE s_axilite port=errcount) that is cleared by the host.
+ *
+ * \tparam InW              Input data width, activation precision
+ * \tparam OFMChannels      Number of Output Feature Map channels, including triplications
+ * \tparam PE               Number of channels per input word
+ * \tparam NUM_RED          Number of redundancies (or triplicated channels)
+ * \tparam REDF             Redundancy factor (3 to triplicate)
+ * \tparam OFMDim           Width and Height of the Output Feature Map (assumed square)
+ * \tparam MAX_CH_WIDTH     Value to determine the precision of channel indexes
+ * \tparam CntW             Width of the fault counters - safely deducible from the paramaters
+ *
+ * \param in                Input stream
+ * \param out               Output stream
+ * \param errortype         Flag to inform redundancy check results. 0 if no faults, LSB set if one PE is faulty, MSB set if all differ
+ * \param channel_mask      Value with binary channel masks (1 if channel is triplicated, 0 otherwise)
+ * \param red_ch_index      Array of redundant triplets' indexes. Each position stores the first triplicated channel index of a triplet
+ * \param errcount          Saturating fault counters, one per triplet
+ * \param numReps           Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+
+template<unsigned int InW,
+         unsigned int OFMChannels,
+         unsigned int PE,
+         unsigned int NUM_RED,
+         unsigned int REDF,
+         unsigned int OFMDim,
+         unsigned int MAX_CH_WIDTH,
+         int CntW>
+void TMRCheck_Folded_Batch(hls::stream<ap_uint<InW*PE>> &in,
+                           hls::stream<ap_uint<InW*(OFMChannels-NUM_RED*(REDF-1))>> &out,
+                           ap_uint<2> &errortype,
+                           ap_uint<OFMChannels> channel_mask,
+                           ap_uint<MAX_CH_WIDTH> red_ch_index[NUM_RED],
+                           ap_uint<CntW> errcount[NUM_RED],
+                           unsigned int numReps) {
+    static_assert(OFMChannels % PE == 0, "PE must divide OFMChannels");
+    static_assert(PE >= REDF, "A fold must hold a complete triplet");
+
+    // Number of channels without triplications
+    constexpr unsigned int OFMChannelsTMR = (OFMChannels-NUM_RED*(REDF-1));
+    constexpr unsigned int NF = OFMChannels / PE;
+
+    // Fold and position within the fold of every triplet
+    ap_uint<MAX_CH_WIDTH> trip_fold[NUM_RED];
+    ap_uint<MAX_CH_WIDTH> trip_ofs[NUM_RED];
+    ap_uint<CntW> counters[NUM_RED];
+#pragma HLS ARRAY_PARTITION variable=trip_fold complete dim=0
+#pragma HLS ARRAY_PARTITION variable=trip_ofs complete dim=0
+#pragma HLS ARRAY_PARTITION variable=counters complete dim=0
+    // Channels forwarded to the output: all not triplicated ones and the first of every triplet
+    ap_uint<OFMChannels> forward = ~channel_mask;
+    for(unsigned int i = 0; i < NUM_RED; i++){
+#pragma HLS UNROLL
+        unsigned int idx = red_ch_index[i];
+        trip_fold[i] = idx / PE;
+        trip_ofs[i] = idx % PE;
+        counters[i] = errcount[i];
+        forward[idx] = 1;
+    }
+    ap_uint<PE> fold_forward[NF];
+#pragma HLS ARRAY_PARTITION variable=fold_forward complete dim=0
+    for(unsigned int f = 0; f < NF; f++){
+#pragma HLS UNROLL
+        fold_forward[f] = forward((f+1)*PE-1, f*PE);
+    }
+
+    ap_uint<2> err = 0;
+    ap_uint<InW*OFMChannelsTMR> out_aux = 0;
+    unsigned int nf = 0;
+    // CheckLoop: iterates over all folds of all OFM positions
+    for(unsigned int i = 0; i < numReps * OFMDim * OFMDim * NF; i++){
+#pragma HLS pipeline style=flp II=1
+        ap_uint<InW*PE> const input = in.read();
+        ap_uint<InW*PE> voted = input;
+
+        // TMR CHECK of the triplets within this fold
+        for(unsigned int t = 0; t < NUM_RED; t++){
+#pragma HLS UNROLL
+            if(trip_fold[t] == nf){
+                unsigned int idx = trip_ofs[t];
+                ap_uint<2> numerrors = 0;
+                ap_uint<InW> tmr_out = 0;
+                // CompareLoop: performs comparisons between PE0, PE1, PE2
+                for(unsigned int y = 0; y < REDF; y++){
+                    for(unsigned int x = y+1; x < REDF; x++){
+                        if( (input((idx+y+1)*InW-1, (idx+y)*InW)) == (input((idx+x+1)*InW-1, (idx+x)*InW)) ){
+                            tmr_out = input((idx+x+1)*InW-1, (idx+x)*InW);
+                        } else {
+                            numerrors++;
+                            if(numerrors == REDF){
+                                err |= (ap_uint<2>)0b10;
+                            } else {
+                                err |= (ap_uint<2>)0b1;
+                            }
+                            tmr_out = input((idx+1)*InW-1, idx*InW);
+                        }
+                    }
+                } // end CompareLoop
+                voted((idx+1)*InW-1, idx*InW) = tmr_out;
+                if((numerrors != 0) && (counters[t] != ap_uint<CntW>(-1))){
+                    counters[t]++;
+                }
+            }
+        }
+
+        // ChannelLoop: forwards the valid channels of this fold
+        ap_uint<PE> const fwd = fold_forward[nf];
+        for(unsigned int k = 0; k < PE; k++){
+#pragma HLS UNROLL
+            if(fwd[k]){
+                out_aux = out_aux >> InW;
+                out_aux(OFMChannelsTMR*InW-1, (OFMChannelsTMR-1)*InW) = voted((k+1)*InW-1, k*InW);
+            }
+        } // end ChannelLoop
+
+        if(++nf == NF){
+            nf = 0;
+            out.write(out_aux);
+        }
+    } // end CheckLoop
+
+    errortype = err;
+    for(unsigned int i = 0; i < NUM_RED; i++){
+#pragma HLS UNROLL
+        errcount[i] = counters[i];
+    }
+}
+
 #endif
@@ -47,6 +47,9 @@
 #include <ap_int.h>
 #include <hls_stream.h>
 
+#include "utils.hpp"
+#include "mmv.hpp"
+
 
 /**
  * \brief Upsampling with the Nearest Neighbour algorithm. Works with square feature maps
@@ -179,4 +182,618 @@ void UpsampleNearestNeighbour_1D(
 	}
 }
 
+/**
+ * \brief Source index of output sample o for Nearest Neighbour upsampling along one dimension
+ *
+ * Uses the same scale factor and border padding as UpsampleNearestNeighbour, i.e. the scale factor OFMDim/IFMDim
+ * is applied after skipping (OFMDim%IFMDim+1)/2 leading output samples, which replicate the first input sample.
+ *
+ * \tparam 	OFMDim 		Output size
+ * \tparam 	IFMDim 		Input size
+ *
+ * \param 	o 			Output index
+ */
+template<unsigned OFMDim, unsigned IFMDim>
+unsigned upsample_nn_source(unsigned const  o) {
+#pragma HLS INLINE
+	constexpr unsigned  scale_factor = OFMDim/IFMDim;
+	constexpr unsigned  Padding = OFMDim % IFMDim;
+	constexpr unsigned  PaddingLow = Padding - Padding/2;
+	unsigned const  src = o < PaddingLow? 0 : (o - PaddingLow)/scale_factor;
+	return  src < IFMDim? src : IFMDim-1;
+}
+
+/**
+ * \brief Upsampling with the Nearest Neighbour algorithm. Works with non-square feature maps on multiple images
+ *
+ * \tparam 	OFMDim_x 		Width of the output feature map
+ * \tparam 	OFMDim_y 		Height of the output feature map
+ * \tparam 	IFMDim_x 		Width of the input feature map
+ * \tparam 	IFMDim_y 		Height of the input feature map
+ * \tparam 	NumChannels 	Amount of channels of the input feature map
+ * \tparam 	In_t		 	Input datatype
+ *
+ * \param 	in 			Input stream
+ * \param 	out 			Output stream
+ * \param     numReps      Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<unsigned int OFMDim_x,
+	unsigned int OFMDim_y,
+	unsigned int IFMDim_x,
+	unsigned int IFMDim_y,
+	unsigned int NumChannels,
+	typename In_t>
+void UpsampleNearestNeighbour_NonSquare_Batch(
+        hls::stream<ap_uint<NumChannels * In_t::width>> & in,
+        hls::stream<ap_uint<NumChannels * In_t::width>> & out,
+		unsigned int numReps) {
+  static_assert(OFMDim_x >= IFMDim_x && OFMDim_y >= IFMDim_y, "");
+
+  using  buf_t = ap_uint<NumChannels * In_t::width>;
+  buf_t  RowBuf[IFMDim_x];
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+	for (unsigned int y = 0; y < OFMDim_y; y++) {
+		// the first output row of every input row reads it
+		bool const  read_row = (y == 0) || (upsample_nn_source<OFMDim_y, IFMDim_y>(y) != upsample_nn_source<OFMDim_y, IFMDim_y>(y-1));
+		buf_t  inData;
+		int  last_col = -1;
+		for (unsigned int x = 0; x < OFMDim_x; x++) {
+#pragma HLS pipeline style=flp II=1
+			unsigned int const  src = upsample_nn_source<OFMDim_x, IFMDim_x>(x);
+			if (read_row && (int(src) > last_col)) {
+				inData = in.read();
+				RowBuf[src] = inData;
+				last_col = src;
+			}
+			out.write(read_row? inData : RowBuf[src]);
+		}
+	}
+  }
+}
+
+/**
+ * \brief Upsampling with the Nearest Neighbour algorithm producing MMV adjacent output pixels per cycle.
+ * Works with non-square feature maps on multiple images
+ *
+ * The pixels of an output row are produced in groups of MMV as MultiChanData, which can be flattened with
+ * FlattenMultiChanData for downstream consumers. As an output group spans at most two input pixels, one input
+ * pixel needs to be fetched per cycle at most, so the first output row of every input row is produced at the same
+ * rate as the replicated ones.
+ *
+ * \tparam 	OFMDim_x 		Width of the output feature map, a multiple of MMV
+ * \tparam 	OFMDim_y 		Height of the output feature map
+ * \tparam 	IFMDim_x 		Width of the input feature map
+ * \tparam 	IFMDim_y 		Height of the input feature map
+ * \tparam 	NumChannels 	Amount of channels of the input feature map
+ * \tparam 	In_t		 	Input datatype
+ * \tparam 	MMV 			Number of output pixels produced in parallel, at most OFMDim_x/IFMDim_x
+ *
+ * \param 	in 			Input stream
+ * \param 	out 			Output stream
+ * \param     numReps      Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<unsigned int OFMDim_x,
+	unsigned int OFMDim_y,
+	unsigned int IFMDim_x,
+	unsigned int IFMDim_y,
+	unsigned int NumChannels,
+	typename In_t,
+	unsigned int MMV>
+void UpsampleNearestNeighbour_MMV_Batch(
+        hls::stream<ap_uint<NumChannels * In_t::width>> & in,
+        hls::stream<MultiChanData<MMV, NumChannels * In_t::width>> & out,
+		unsigned int numReps) {
+  static_assert(OFMDim_x >= IFMDim_x && OFMDim_y >= IFMDim_y, "");
+  static_assert(OFMDim_x % MMV == 0, "MMV must divide OFMDim_x.");
+  static_assert(MMV <= OFMDim_x/IFMDim_x, "MMV must not exceed the horizontal scale factor.");
+
+  using  buf_t = ap_uint<NumChannels * In_t::width>;
+  buf_t  RowBuf[IFMDim_x];
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+	for (unsigned int y = 0; y < OFMDim_y; y++) {
+		// the first output row of every input row reads it
+		bool const  read_row = (y == 0) || (upsample_nn_source<OFMDim_y, IFMDim_y>(y) != upsample_nn_source<OFMDim_y, IFMDim_y>(y-1));
+		// newest input pixel of the row and its predecessor
+		buf_t  cur, prev;
+		int  last_col = -1;
+		for (unsigned int g = 0; g < OFMDim_x/MMV; g++) {
+#pragma HLS pipeline style=flp II=1
+			unsigned int const  src_last = upsample_nn_source<OFMDim_x, IFMDim_x>(g*MMV + MMV-1);
+			if (int(src_last) > last_col) {
+				prev = cur;
+				if (read_row) {
+					cur = in.read();
+					RowBuf[src_last] = cur;
+				}
+				else
+					cur = RowBuf[src_last];
+				last_col = src_last;
+			}
+			MultiChanData<MMV, NumChannels * In_t::width>  outData;
+			for (unsigned int v = 0; v < MMV; v++) {
+#pragma HLS UNROLL
+				unsigned int const  src = upsample_nn_source<OFMDim_x, IFMDim_x>(g*MMV + v);
+				outData.data[v] = (src == src_last)? cur : prev;
+			}
+			out.write(outData);
+		}
+	}
+  }
+}
+
+/**
+ * \brief Interpolation weight of the second neighbour for bilinear upsampling by an integer factor
+ *
+ * Output sample o lies at (o+0.5)/Scale-0.5 in input coordinates (half-pixel centers). For the phase p = o%Scale,
+ * its neighbours are the input samples o/Scale-1 and o/Scale if 2p+1 < Scale, and o/Scale and o/Scale+1 otherwise.
+ * The returned weight of the second neighbour is exact in units of 1/(2*Scale), the weight of the first neighbour
+ * is 2*Scale minus this value.
+ *
+ * \tparam 	Scale 		Upsampling factor
+ *
+ * \param 	p 			Output phase
+ */
+template<unsigned Scale>
+constexpr unsigned bilinear_weight(unsigned const  p) {
+	return  (2*p+1 < Scale)? 2*p+1+Scale : 2*p+1-Scale;
+}
+
+/**
+ * \brief Upsampling with bilinear interpolation. Works with square feature maps on multiple images
+ *
+ * The output is interpolated from the two input rows around every output row, which are held in a two-row line
+ * buffer. An input row is read while the first output row using it is produced, so that one fold of PE channels of
+ * an output pixel is generated every cycle. The interpolation uses the exact weights of bilinear_weight() and rounds
+ * to the nearest output value. Samples beyond the border are replaced by the nearest border sample.
+ *
+ * \tparam 	OFMDim 		Size of the output feature map, a multiple of IFMDim
+ * \tparam 	IFMDim 		Size of the input feature map
+ * \tparam 	NumChannels 	Amount of channels of the input feature map
+ * \tparam 	PE 			Number of channels processed in parallel
+ * \tparam 	In_t		 	Input datatype
+ *
+ * \param 	in 			Input stream
+ * \param 	out 			Output stream
+ * \param     numReps      Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<unsigned int OFMDim,
+	unsigned int IFMDim,
+	unsigned int NumChannels,
+	unsigned int PE,
+	typename In_t>
+void UpsampleBilinear_Batch(
+        hls::stream<ap_uint<PE * In_t::width>> & in,
+        hls::stream<ap_uint<PE * In_t::width>> & out,
+		unsigned int numReps) {
+  static_assert(OFMDim > IFMDim, "");
+  static_assert(OFMDim % IFMDim == 0, "OFMDim must be a whole multiple of IFMDim.");
+  static_assert(NumChannels % PE == 0, "PE must divide NumChannels.");
+
+  constexpr unsigned int Scale = OFMDim / IFMDim;
+  constexpr unsigned int NF = NumChannels / PE;
+  // weights in units of 1/WD per dimension
+  constexpr unsigned int WD = 2 * Scale;
+  constexpr unsigned int D = WD * WD;
+  constexpr unsigned int AW = In_t::width + clog2(D) + 2;
+  using  buf_t = ap_uint<PE * In_t::width>;
+  using  acc_t = ap_int<AW>;
+
+  // two-row line buffer, split into even and odd columns to read two neighbours per cycle
+  buf_t  bufEven[2][(IFMDim+1)/2][NF];
+  buf_t  bufOdd [2][(IFMDim+1)/2][NF];
+#pragma HLS ARRAY_PARTITION variable=bufEven complete dim=1
+#pragma HLS ARRAY_PARTITION variable=bufOdd complete dim=1
+
+  for (unsigned int rep = 0; rep < numReps; rep++) {
+	int  last_row = -1;
+	unsigned int  iy = 0, py = 0;
+	for (unsigned int y = 0; y < OFMDim; y++) {
+		bool const  lower_y = 2*py+1 < Scale;
+		unsigned int const  r0 = lower_y? (iy > 0? iy-1 : 0) : iy;
+		unsigned int const  r1 = lower_y? iy : (iy+1 < IFMDim? iy+1 : IFMDim-1);
+		unsigned int const  wy1 = bilinear_weight<Scale>(py);
+		unsigned int const  wy0 = WD - wy1;
+		bool const  read_row = int(r1) > last_row;
+		unsigned int const  s0 = r0 & 1;
+		unsigned int const  s1 = r1 & 1;
+
+		int  last_col = -1;
+		unsigned int  ix = 0, px = 0, f = 0;
+		for (unsigned int i = 0; i < OFMDim * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+			bool const  lower_x = 2*px+1 < Scale;
+			unsigned int const  c0 = lower_x? (ix > 0? ix-1 : 0) : ix;
+			unsigned int const  c1 = lower_x? ix : (ix+1 < IFMDim? ix+1 : IFMDim-1);
+			unsigned int const  wx1 = bilinear_weight<Scale>(px);
+			unsigned int const  wx0 = WD - wx1;
+
+			// c0 and c1 are equal or adjacent, hence at most one read per bank
+			unsigned int const  ce = (c0 & 1)? c1 : c0;
+			unsigned int const  co = (c0 & 1)? c0 : c1;
+			buf_t const  e0 = bufEven[s0][ce >> 1][f];
+			buf_t const  o0 = bufOdd [s0][co >> 1][f];
+			buf_t const  e1 = bufEven[s1][ce >> 1][f];
+			buf_t const  o1 = bufOdd [s1][co >> 1][f];
+			buf_t  a0 = (c0 & 1)? o0 : e0;
+			buf_t  a1 = (c1 & 1)? o0 : e0;
+			buf_t  b0 = (c0 & 1)? o1 : e1;
+			buf_t  b1 = (c1 & 1)? o1 : e1;
+
+			// fetch the next input column of a new row when it is first needed
+			if (read_row && (int(c1) > last_col)) {
+				buf_t const  inData = in.read();
+				if (c1 & 1)  bufOdd [s1][c1 >> 1][f] = inData;
+				else         bufEven[s1][c1 >> 1][f] = inData;
+				b1 = inData;
+				if (c0 == c1)  b0 = inData;
+				if (s0 == s1) {
+					a1 = inData;
+					if (c0 == c1)  a0 = inData;
+				}
+			}
+
+			buf_t  outData;
+			for (unsigned int pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+				In_t const  va0 = a0((pe+1)*In_t::width-1, pe*In_t::width);
+				In_t const  va1 = a1((pe+1)*In_t::width-1, pe*In_t::width);
+				In_t const  vb0 = b0((pe+1)*In_t::width-1, pe*In_t::width);
+				In_t const  vb1 = b1((pe+1)*In_t::width-1, pe*In_t::width);
+				acc_t const  v = wy0*(wx0*acc_t(va0) + wx1*acc_t(va1)) + wy1*(wx0*acc_t(vb0) + wx1*acc_t(vb1));
+				// round to nearest, floor division for negative values
+				acc_t const  n = v + acc_t(D/2);
+				acc_t  q = n / acc_t(D);
+				if (q * acc_t(D) > n)  q--;
+				In_t const  res = q;
+				outData((pe+1)*In_t::width-1, pe*In_t::width) = res;
+			}
+			out.write(outData);
+
+			if (++f == NF) {
+				f = 0;
+				if (read_row && (int(c1) > last_col))  last_col = c1;
+				if (++px == Scale) {
+					px = 0;
+					ix++;
+				}
+			}
+		}
+		if (read_row)  last_row = r1;
+		if (++py == Scale) {
+			py = 0;
+			iy++;
+		}
+	}
+  }
+}
+
+/**
+ * \brief Downsampling with bilinear interpolation. Works with non-square feature maps of runtime dimensions on multiple images
+ *
+ * Output sample o lies at (o+0.5)*IFMDim/OFMDim-0.5 in input coordinates (half-pixel centers), which is computed with
+ * 16 fractional bits, rounded down. As OFMDim does not exceed IFMDim, every input row and column is the later of the
+ * two neighbours of one output sample at most. Each output pixel is hence produced in the cycle its last input fold is
+ * read, from the current input, the previous input pixel of the same row and the previous input row, which is held in
+ * a line buffer of widths up to MaxIFMDim_x. One fold of PE channels is read every cycle. The interpolation weights
+ * have WeightBits fractional bits and the result is rounded to the nearest output value.
+ *
+ * \tparam 	MaxIFMDim_x 	Maximum width of the input feature map
+ * \tparam 	NumChannels 	Amount of channels of the input feature map
+ * \tparam 	PE 			Number of channels processed in parallel
+ * \tparam 	In_t		 	Input datatype
+ * \tparam 	WeightBits 	Fractional bits of the interpolation weights
+ *
+ * \param 	in 			Input stream
+ * \param 	out 			Output stream
+ * \param 	ifm_x 		Width of the input feature map, at most MaxIFMDim_x
+ * \param 	ifm_y 		Height of the input feature map
+ * \param 	ofm_x 		Width of the output feature map, at most ifm_x
+ * \param 	ofm_y 		Height of the output feature map, at most ifm_y
+ * \param     numReps      Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<unsigned int MaxIFMDim_x,
+	unsigned int NumChannels,
+	unsigned int PE,
+	typename In_t,
+	unsigned int WeightBits = 8>
+void DownsampleBilinear_Dynamic_Batch(
+        hls::stream<ap_uint<PE * In_t::width>> & in,
+        hls::stream<ap_uint<PE * In_t::width>> & out,
+		unsigned int const  ifm_x, unsigned int const  ifm_y,
+		unsigned int const  ofm_x, unsigned int const  ofm_y,
+		unsigned int numReps) {
+  static_assert(NumChannels % PE == 0, "PE must divide NumChannels.");
+  static_assert(WeightBits <= 16, "WeightBits exceeds the position precision.");
+
+  constexpr unsigned int NF = NumChannels / PE;
+  constexpr unsigned int PosBits = 16;
+  constexpr unsigned int D = 1u << 2*WeightBits;
+  constexpr unsigned int AW = In_t::width + 2*WeightBits + 2;
+  using  buf_t = ap_uint<PE * In_t::width>;
+  using  acc_t = ap_int<AW>;
+  using  pos_t = ap_uint<32>;
+  using  wgt_t = ap_uint<WeightBits+1>;
+
+  // output sample positions, a step being at least one input sample
+  pos_t const  step_x = (pos_t(ifm_x) << PosBits) / ofm_x;
+  pos_t const  step_y = (pos_t(ifm_y) << PosBits) / ofm_y;
+  pos_t const  pos0_x = (step_x - (pos_t(1) << PosBits)) / 2;
+  pos_t const  pos0_y = (step_y - (pos_t(1) << PosBits)) / 2;
+
+  buf_t  line[MaxIFMDim_x][NF];
+  buf_t  prevCur[NF];
+  buf_t  prevUp[NF];
+
+  unsigned int  f = 0, ix = 0, iy = 0, ox = 0, oy = 0;
+  pos_t  pos_x = pos0_x, pos_y = pos0_y;
+  for (unsigned int i = 0; i < numReps * ifm_y * ifm_x * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+	buf_t const  cur = in.read();
+	buf_t const  up = line[ix][f];
+	line[ix][f] = cur;
+
+	// an output sample with a fraction is due at its second neighbour
+	bool const  frac_x = pos_x(PosBits-1, 0) != 0;
+	bool const  frac_y = pos_y(PosBits-1, 0) != 0;
+	bool const  hit_x = (ox < ofm_x) && (ix == unsigned(pos_x >> PosBits) + frac_x);
+	bool const  hit_y = (oy < ofm_y) && (iy == unsigned(pos_y >> PosBits) + frac_y);
+
+	if (hit_x && hit_y) {
+		wgt_t const  wx1 = pos_x(PosBits-1, PosBits-WeightBits);
+		wgt_t const  wy1 = pos_y(PosBits-1, PosBits-WeightBits);
+		wgt_t const  wx0 = wgt_t(1 << WeightBits) - wx1;
+		wgt_t const  wy0 = wgt_t(1 << WeightBits) - wy1;
+		buf_t const  br = cur;
+		buf_t const  bl = frac_x? prevCur[f] : cur;
+		buf_t const  tr = frac_y? up : cur;
+		buf_t const  tl = frac_y? (frac_x? prevUp[f] : up) : bl;
+
+		buf_t  outData;
+		for (unsigned int pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+			In_t const  vtl = tl((pe+1)*In_t::width-1, pe*In_t::width);
+			In_t const  vtr = tr((pe+1)*In_t::width-1, pe*In_t::width);
+			In_t const  vbl = bl((pe+1)*In_t::width-1, pe*In_t::width);
+			In_t const  vbr = br((pe+1)*In_t::width-1, pe*In_t::width);
+			acc_t const  v = wy0*(wx0*acc_t(vtl) + wx1*acc_t(vtr)) + wy1*(wx0*acc_t(vbl) + wx1*acc_t(vbr));
+			// round to nearest, the shift flooring negative values
+			In_t const  res = (v + acc_t(D/2)) >> (2*WeightBits);
+			outData((pe+1)*In_t::width-1, pe*In_t::width) = res;
+		}
+		out.write(outData);
+	}
+	prevCur[f] = cur;
+	prevUp[f] = up;
+
+	if (++f == NF) {
+		f = 0;
+		if (hit_x && hit_y) {
+			ox++;
+			pos_x += step_x;
+		}
+		if (++ix == ifm_x) {
+			ix = 0;
+			ox = 0;
+			pos_x = pos0_x;
+			if (hit_y) {
+				oy++;
+				pos_y += step_y;
+			}
+			if (++iy == ifm_y) {
+				iy = 0;
+				oy = 0;
+				pos_y = pos0_y;
+			}
+		}
+	}
+  }
+}
+
+/**
+ * \brief Downsampling with bilinear interpolation. Works with non-square feature maps on multiple images
+ *
+ * See DownsampleBilinear_Dynamic_Batch for the feature map dimensions fixed at compile time.
+ *
+ * \tparam 	IFMDim_x 	Width of the input feature map
+ * \tparam 	IFMDim_y 	Height of the input feature map
+ * \tparam 	OFMDim_x 	Width of the output feature map
+ * \tparam 	OFMDim_y 	Height of the output feature map
+ * \tparam 	NumChannels 	Amount of channels of the input feature map
+ * \tparam 	PE 			Number of channels processed in parallel
+ * \tparam 	In_t		 	Input datatype
+ * \tparam 	WeightBits 	Fractional bits of the interpolation weights
+ *
+ * \param 	in 			Input stream
+ * \param 	out 			Output stream
+ * \param     numReps      Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<unsigned int IFMDim_x,
+	unsigned int IFMDim_y,
+	unsigned int OFMDim_x,
+	unsigned int OFMDim_y,
+	unsigned int NumChannels,
+	unsigned int PE,
+	typename In_t,
+	unsigned int WeightBits = 8>
+void DownsampleBilinear_Batch(
+        hls::stream<ap_uint<PE * In_t::width>> & in,
+        hls::stream<ap_uint<PE * In_t::width>> & out,
+		unsigned int numReps) {
+#pragma HLS INLINE
+  static_assert((OFMDim_x <= IFMDim_x) && (OFMDim_y <= IFMDim_y), "The output must not exceed the input feature map.");
+  DownsampleBilinear_Dynamic_Batch<IFMDim_x, NumChannels, PE, In_t, WeightBits>
+	(in, out, IFMDim_x, IFMDim_y, OFMDim_x, OFMDim_y, numReps);
+}
+
+namespace detail {
+
+/**
+ * \brief Table of ceil(2^K / n) for n = 1:N, turning the division by n of a numerator below 2^(K-clog2(N+1)) into an
+ *        exact floor division by a multiplication and shift
+ */
+template<unsigned N, unsigned K>
+class ReciprocalTable {
+	static_assert(K < 63, "Reciprocal precision exceeds table entry width");
+public:
+	unsigned long long  tab[N+1];
+public:
+	constexpr ReciprocalTable() : tab() {
+		for(unsigned  n = 1; n <= N; n++) {
+			tab[n] = ((1ull << K) + n - 1) / n;
+		}
+	}
+};
+
+} // namespace detail
+
+/**
+ * \brief Downsampling by area averaging. Works with non-square feature maps of runtime dimensions on multiple images
+ *
+ * Output sample o averages the input samples i of o = floor(i*OFMDim/IFMDim), horizontally and vertically, whose
+ * boxes are of up to MaxBox samples in either dimension. The box boundaries are tracked by error accumulators, so that
+ * no division is needed for them. The sums of the rows of the boxes of every output column are collected in a line of
+ * accumulators of widths up to MaxOFMDim_x, and the average is rounded to the nearest output value using a table of
+ * reciprocals of the box sizes. One fold of PE channels is read every cycle.
+ *
+ * \tparam 	MaxOFMDim_x 	Maximum width of the output feature map
+ * \tparam 	MaxBox 		Maximum box size, ceil(IFMDim/OFMDim) in either dimension
+ * \tparam 	NumChannels 	Amount of channels of the input feature map
+ * \tparam 	PE 			Number of channels processed in parallel
+ * \tparam 	In_t		 	Input datatype
+ *
+ * \param 	in 			Input stream
+ * \param 	out 			Output stream
+ * \param 	ifm_x 		Width of the input feature map
+ * \param 	ifm_y 		Height of the input feature map
+ * \param 	ofm_x 		Width of the output feature map, at most ifm_x and MaxOFMDim_x
+ * \param 	ofm_y 		Height of the output feature map, at most ifm_y
+ * \param     numReps      Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<unsigned int MaxOFMDim_x,
+	unsigned int MaxBox,
+	unsigned int NumChannels,
+	unsigned int PE,
+	typename In_t>
+void DownsampleArea_Dynamic_Batch(
+        hls::stream<ap_uint<PE * In_t::width>> & in,
+        hls::stream<ap_uint<PE * In_t::width>> & out,
+		unsigned int const  ifm_x, unsigned int const  ifm_y,
+		unsigned int const  ofm_x, unsigned int const  ofm_y,
+		unsigned int numReps) {
+  static_assert(NumChannels % PE == 0, "PE must divide NumChannels.");
+  static_assert(MaxBox > 0, "");
+
+  constexpr unsigned int NF = NumChannels / PE;
+  constexpr unsigned int W = In_t::width;
+  constexpr unsigned int MaxArea = MaxBox * MaxBox;
+  constexpr unsigned int HW = W + clog2(MaxBox);		// row sum of a box
+  constexpr unsigned int SW = W + clog2(MaxArea);		// sum of a box
+  constexpr unsigned int K = SW + clog2(MaxArea+1);
+  static constexpr detail::ReciprocalTable<MaxArea, K>  RCP {};
+  // signed inputs are averaged in offset binary
+  ap_uint<W> const  bias = In_t::sign_flag? ap_uint<W>(1) << (W-1) : ap_uint<W>(0);
+  using  buf_t = ap_uint<PE * In_t::width>;
+
+  ap_uint<PE * SW>  colAcc[MaxOFMDim_x][NF];
+  ap_uint<PE * HW>  rowAcc[NF];
+
+  unsigned int  f = 0, ix = 0, iy = 0, ox = 0;
+  unsigned int  ex = 0, ey = 0;		// (i*OFMDim) mod IFMDim of the current input sample
+  unsigned int  cx = 0, cy = 0;		// samples of the current box before the current one
+  for (unsigned int i = 0; i < numReps * ifm_y * ifm_x * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+	buf_t const  inData = in.read();
+	bool const  end_x = ex + ofm_x >= ifm_x;
+	bool const  end_y = ey + ofm_y >= ifm_y;
+	unsigned int const  n = (cx+1) * (cy+1);
+
+	ap_uint<PE * HW> const  rowPrev = rowAcc[f];
+	ap_uint<PE * SW> const  colPrev = colAcc[ox][f];
+	ap_uint<PE * HW>  rowSum;
+	ap_uint<PE * SW>  colSum;
+	buf_t  outData;
+	for (unsigned int pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+		ap_uint<W> const  v = ap_uint<W>(inData((pe+1)*W-1, pe*W)) ^ bias;
+		ap_uint<HW> const  r = (cx == 0? ap_uint<HW>(0) : ap_uint<HW>(rowPrev((pe+1)*HW-1, pe*HW))) + v;
+		ap_uint<SW> const  c = (cy == 0? ap_uint<SW>(0) : ap_uint<SW>(colPrev((pe+1)*SW-1, pe*SW))) + r;
+		rowSum((pe+1)*HW-1, pe*HW) = r;
+		colSum((pe+1)*SW-1, pe*SW) = c;
+		// round half up by an exact floor division
+		ap_uint<SW> const  num = c + n/2;
+		ap_uint<W> const  q = (ap_uint<SW+K>(num) * ap_uint<K+1>(RCP.tab[n])) >> K;
+		outData((pe+1)*W-1, pe*W) = q ^ bias;
+	}
+	rowAcc[f] = rowSum;
+	if (end_x) {
+		if (end_y)  out.write(outData);
+		else        colAcc[ox][f] = colSum;
+	}
+
+	if (++f == NF) {
+		f = 0;
+		if (end_x) {
+			ox++;
+			cx = 0;
+			ex = ex + ofm_x - ifm_x;
+		}
+		else {
+			cx++;
+			ex += ofm_x;
+		}
+		if (++ix == ifm_x) {
+			ix = 0;
+			ox = 0;
+			if (end_y) {
+				cy = 0;
+				ey = ey + ofm_y - ifm_y;
+			}
+			else {
+				cy++;
+				ey += ofm_y;
+			}
+			if (++iy == ifm_y) {
+				iy = 0;
+			}
+		}
+	}
+  }
+}
+
+/**
+ * \brief Downsampling by area averaging. Works with non-square feature maps on multiple images
+ *
+ * See DownsampleArea_Dynamic_Batch for the feature map dimensions fixed at compile time.
+ *
+ * \tparam 	IFMDim_x 	Width of the input feature map
+ * \tparam 	IFMDim_y 	Height of the input feature map
+ * \tparam 	OFMDim_x 	Width of the output feature map
+ * \tparam 	OFMDim_y 	Height of the output feature map
+ * \tparam 	NumChannels 	Amount of channels of the input feature map
+ * \tparam 	PE 			Number of channels processed in parallel
+ * \tparam 	In_t		 	Input datatype
+ *
+ * \param 	in 			Input stream
+ * \param 	out 			Output stream
+ * \param     numReps      Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<unsigned int IFMDim_x,
+	unsigned int IFMDim_y,
+	unsigned int OFMDim_x,
+	unsigned int OFMDim_y,
+	unsigned int NumChannels,
+	unsigned int PE,
+	typename In_t>
+void DownsampleArea_Batch(
+        hls::stream<ap_uint<PE * In_t::width>> & in,
+        hls::stream<ap_uint<PE * In_t::width>> & out,
+		unsigned int numReps) {
+#pragma HLS INLINE
+  static_assert((OFMDim_x <= IFMDim_x) && (OFMDim_y <= IFMDim_y), "The output must not exceed the input feature map.");
+  constexpr unsigned int BoxX = (IFMDim_x + OFMDim_x - 1) / OFMDim_x;
+  constexpr unsigned int BoxY = (IFMDim_y + OFMDim_y - 1) / OFMDim_y;
+  DownsampleArea_Dynamic_Batch<OFMDim_x, (BoxX > BoxY? BoxX : BoxY), NumChannels, PE, In_t>
+	(in, out, IFMDim_x, IFMDim_y, OFMDim_x, OFMDim_y, numReps);
+}
+
 #endif
@@ -53,6 +53,8 @@
 #include <iostream>
 #include <fstream>
 #include <cstddef>
+#include <algorithm>
+#include <type_traits>
 
 //- Static Evaluation of ceil(log2(x)) ---------------------------------------
 constexpr unsigned clog2(size_t  x) {
@@ -70,14 +72,586 @@ struct first_param<R (C::*)(A, Args...)> { typedef A  type; };
 class ap_resource_dflt {};
 class ap_resource_lut {};
 class ap_resource_dsp {};
+class ap_resource_dsp_packed {};
+class ap_resource_dsp_cascade {};
+class ap_resource_shift {};  // power-of-two weights, see LogWeights
+class ap_resource_fp_dsp {};  // floating-point operators in DSP48, see MiniFloat
 //- Resource Representatives for sliding window-------------------------------
 class ap_resource_lutram {};
 class ap_resource_bram {};
 class ap_resource_uram {};
 
+/**
+ * \brief   Default thresholds for the automatic memory resource selection
+ *
+ * A project can override the selection by passing a class with the same members
+ * to ap_resource_auto_t.
+ */
+struct ap_resource_auto_thresholds {
+  // buffers of at most this depth or this number of bits go to LUTRAM
+  static constexpr unsigned  LUTRAM_MAX_DEPTH = 64;
+  static constexpr unsigned  LUTRAM_MAX_BITS = 1024;
+  // number of BRAM18 a URAM288 has to replace at least to be chosen
+  static constexpr unsigned  URAM_BRAM18_RATIO = 16;
+};
+
+/**
+ * \brief   Resource Representative selecting LUTRAM, BRAM or URAM for a sliding window buffer
+ * at compile time from its depth and width, see auto_memory_resource
+ */
+template<typename Thresholds = ap_resource_auto_thresholds>
+class ap_resource_auto_t {};
+using ap_resource_auto = ap_resource_auto_t<>;
+
+//- Static Evaluation of memory geometry -------------------------------------
+// number of BRAM18 for a depth x width memory, best of the 16Kx1 to 512x36 aspect ratios
+constexpr unsigned bram18_count(unsigned long long  depth, unsigned  width, unsigned  d = 16384, unsigned  w = 1) {
+  return  d < 512? ~0u : std::min<unsigned long long>(
+    ((depth+d-1)/d) * ((width+w-1)/w),
+    bram18_count(depth, width, d/2, d == 4096? 9 : 2*w)
+  );
+}
+// number of URAM288 (4Kx72) for a depth x width memory
+constexpr unsigned uram288_count(unsigned long long  depth, unsigned  width) {
+  return  ((depth+4095)/4096) * ((width+71)/72);
+}
+
+// BRAM18 equivalents of PE/G banks of depth x G*width bits, URAM288 counted as URAM_BRAM18_RATIO BRAM18
+template<typename Thresholds = ap_resource_auto_thresholds>
+constexpr unsigned long long packed_pe_cost(unsigned  pe, unsigned  g, unsigned long long  depth, unsigned  width) {
+  return  (unsigned long long)(pe/g) * std::min<unsigned long long>(
+    bram18_count(depth, g*width),
+    (unsigned long long)uram288_count(depth, g*width) * Thresholds::URAM_BRAM18_RATIO
+  );
+}
+// number of PEs (a divisor of pe) sharing a memory word of depth x width bit weights at the least cost,
+// the widest word among equally expensive ones
+template<typename Thresholds = ap_resource_auto_thresholds>
+constexpr unsigned packed_pe_per_word(unsigned  pe, unsigned long long  depth, unsigned  width, unsigned  g = 2, unsigned  best = 1) {
+  return  g > pe? best : packed_pe_per_word<Thresholds>(pe, depth, width, g+1,
+    (pe%g == 0) && (packed_pe_cost<Thresholds>(pe, g, depth, width) <= packed_pe_cost<Thresholds>(pe, best, depth, width))? g : best
+  );
+}
+
+/**
+ * \brief   Geometry of a buffer array, the innermost dimension giving the depth of a memory bank
+ * and the outer dimensions, which are typically partitioned, the number of banks
+ */
+template<typename T>
+struct memory_geometry {
+  static constexpr unsigned  width = T::width;
+  static constexpr unsigned long long  depth = 1;
+  static constexpr unsigned long long  banks = 1;
+};
+template<typename T, size_t N>
+struct memory_geometry<T[N]> {
+  static constexpr unsigned  width = memory_geometry<T>::width;
+  static constexpr unsigned long long  depth = std::is_array<T>::value? memory_geometry<T>::depth : N;
+  static constexpr unsigned long long  banks = std::is_array<T>::value? N * memory_geometry<T>::banks : 1;
+};
+
+/**
+ * \brief   Compile-time selection of the memory resource for a bank of Depth x Width bits
+ *
+ * LUTRAM is chosen for shallow or small banks, URAM if it saves at least URAM_BRAM18_RATIO
+ * BRAM18 per URAM288 (i.e., it is filled at least as well as the BRAMs would be), BRAM otherwise.
+ *
+ * \tparam  Depth       Number of words of the memory bank
+ * \tparam  Width       Width of a word
+ * \tparam  Thresholds  Selection thresholds, see ap_resource_auto_thresholds
+ */
+template<unsigned long long Depth, unsigned Width, typename Thresholds = ap_resource_auto_thresholds>
+struct auto_memory_resource {
+  static constexpr bool  use_lutram = (Depth <= Thresholds::LUTRAM_MAX_DEPTH) || (Depth*Width <= Thresholds::LUTRAM_MAX_BITS);
+  static constexpr bool  use_uram = !use_lutram &&
+    (uram288_count(Depth, Width) * Thresholds::URAM_BRAM18_RATIO <= bram18_count(Depth, Width));
+  using type = typename std::conditional<use_lutram, ap_resource_lutram,
+    typename std::conditional<use_uram, ap_resource_uram, ap_resource_bram>::type>::type;
+};
+
+/**
+ * \brief     Memory resource pragma instantiation for an on-chip buffer, default resource
+ * 
+ * The buffer in the sliding window generator can be implemented in multiple hardware resources. 
+ * 
+ * ap_resource_dflt will let HLS choose the best one
+ * ap_resource_bram will force HLS to implement the buffer in BRAMs
+ * ap_resource_uram will force HLS to implement the buffer in URAMs
+ * ap_resource_lutram will force HLS to implement the buffer in LUTRAMs
+ *
+ * \tparam     T		Datatype of the buffer instantiated in the sliding window generator
+ * 
+ * \param      inputBuf	Buffer used in the SWG
+ * \param      r     	Resource type for the hardware implementation
+ *
+ * \return     Result of the multiply operation
+ */
+template <typename T>
+void memory_resource(T inputBuf, ap_resource_dflt const&){
+#pragma HLS BIND_STORAGE variable=inputBuf type=RAM_2P
+}
+/**
+ * \brief     Memory resource pragma instantiation for an on-chip buffer, BRAM resource
+ * 
+ * The buffer in the sliding window generator can be implemented in multiple hardware resources. 
+ * 
+ * ap_resource_dflt will let HLS choose the best one
+ * ap_resource_bram will force HLS to implement the buffer in BRAMs
+ * ap_resource_uram will force HLS to implement the buffer in URAMs
+ * ap_resource_lutram will force HLS to implement the buffer in LUTRAMs
+ *
+ * \tparam     T		Datatype of the buffer instantiated in the sliding window generator
+ * 
+ * \param      inputBuf	Buffer used in the SWG
+ * \param      r     	Resource type for the hardware implementation
+ *
+ * \return     Result of the multiply operation
+ */
+template <typename T>
+void memory_resource(T inputBuf, ap_resource_bram const&){
+#pragma HLS BIND_STORAGE variable=inputBuf type=RAM_S2P impl=BRAM
+}
+/**
+ * \brief     Memory resource pragma instantiation for an on-chip buffer, URAM resource
+ * 
+ * The buffer in the sliding window generator can be implemented in multiple hardware resources. 
+ * 
+ * ap_resource_dflt will let HLS choose the best one
+ * ap_resource_bram will force HLS to implement the buffer in BRAMs
+ * ap_resource_uram will force HLS to implement the buffer in URAMs
+ * ap_resource_lutram will force HLS to implement the buffer in LUTRAMs
+ *
+ * \tparam     T		Datatype of the buffer instantiated in the sliding window generator
+ * 
+ * \param      inputBuf	Buffer used in the SWG
+ * \param      r     	Resource type for the hardware implementation
+ *
+ * \return     Result of the multiply operation
+ */
+template <typename T>
+void memory_resource(T inputBuf, ap_resource_uram const&){
+#pragma HLS BIND_STORAGE variable=inputBuf type=RAM_S2P impl=URAM
+}
+/**
+ * \brief     Memory resource pragma instantiation for an on-chip buffer, LUTRAM resource
+ * 
+ * The buffer in the sliding window generator can be implemented in multiple hardware resources. 
+ * 
+ * ap_resource_dflt will let HLS choose the best one
+ * ap_resource_bram will force HLS to implement the buffer in BRAMs
+ * ap_resource_uram will force HLS to implement the buffer in URAMs
+ * ap_resource_lutram will force HLS to implement the buffer in LUTRAMs
+ *
+ * \tparam     T		Datatype of the buffer instantiated in the sliding window generator
+ * 
+ * \param      inputBuf	Buffer used in the SWG
+ * \param      r     	Resource type for the hardware implementation
+ *
+ * \return     Result of the multiply operation
+ */
+template <typename T>
+void memory_resource(T inputBuf, ap_resource_lutram const&){
+#pragma HLS BIND_STORAGE variable=inputBuf type=RAM_S2P impl=LUTRAM
+}
+/**
+ * \brief     Memory resource pragma instantiation for an on-chip buffer, automatic resource
+ *
+ * ap_resource_auto chooses LUTRAM, BRAM or URAM at compile time from the depth and width of the buffer
+ * as computed by auto_memory_resource. The innermost dimension of the buffer is taken as the depth of
+ * a memory bank, outer dimensions are assumed to be partitioned.
+ *
+ * \tparam     T		Datatype of the buffer instantiated in the sliding window generator
+ * \tparam     N		Outermost dimension of the buffer
+ * \tparam     Thresholds	Selection thresholds, see ap_resource_auto_thresholds
+ *
+ * \param      inputBuf	Buffer used in the SWG
+ * \param      r     	Resource type for the hardware implementation
+ */
+template <typename T, size_t N, typename Thresholds>
+void memory_resource(T (&inputBuf)[N], ap_resource_auto_t<Thresholds> const&){
+#pragma HLS INLINE
+  using geometry = memory_geometry<T[N]>;
+  memory_resource(inputBuf, typename auto_memory_resource<geometry::depth, geometry::width, Thresholds>::type());
+}
+
+/**
+ * \brief   On-chip cache of Depth words kept across calls
+ *
+ * Owned by the caller of a block filling it on its first call, typically as a static variable of the top
+ * level so that it persists from one invocation of the accelerator to the next. Clearing loaded makes the
+ * next call refill it, e.g. after the cached data was changed in memory.
+ *
+ * \tparam  Depth  Number of words, at least 1
+ * \tparam  Width  Width of a word
+ */
+template<unsigned Depth, unsigned Width>
+struct OnChipCache {
+  ap_uint<Width>  words[Depth];
+  bool  loaded = false;
+};
+
+//- Stream occupancy profiling for csim -------------------------------------
+/**
+ * \brief   Records the words passed through the intermediate streams of the library blocks during C simulation
+ *
+ * Enabled by defining FINN_STREAM_PROFILE, otherwise FINN_STREAM_PROBE expands to nothing. A single
+ * FINN_STREAM_PROBE(s) placed right after the producer of a stream s local to a block counts the words the
+ * producer has written, and once more the words left unread as s goes out of scope. As csim executes the
+ * stages of a dataflow region one after the other, the words written are those a stream would have to hold
+ * for every producer to complete on its own, i.e. a safe upper bound of the depth needed in hardware:
+ * streams between rate-matched stages need far less. csim does not model the actual occupancy of a FIFO.
+ * Streams are named by the block declaring them, including its template arguments, and their variable
+ * name, so that the calls of a block with the same configuration are accumulated. The report is printed
+ * at program exit, or on demand by StreamProfiler::report().
+ */
+#if defined(FINN_STREAM_PROFILE) && !defined(__SYNTHESIS__)
+#include <map>
+#include <string>
+#include <vector>
+
+class StreamProfiler {
+  struct Entry {
+    std::string  name;
+    size_t  calls   = 0;
+    size_t  written = 0;
+    size_t  left    = 0;
+  };
+  std::map<std::string, size_t>  m_index;
+  std::vector<Entry>  m_entries;
+
+  StreamProfiler() {}
+  ~StreamProfiler() {
+    report(std::cout);
+  }
+
+public:
+  static StreamProfiler &instance() {
+    static StreamProfiler  profiler;
+    return  profiler;
+  }
+
+  /**
+   * Name of a stream given the __PRETTY_FUNCTION__ of its block: the function name, the stream name
+   * and the template arguments following the parameter list.
+   */
+  static std::string name(char const *block, char const *stream) {
+    std::string const  sig(block);
+    size_t const  open = sig.find('(');
+    if(open == std::string::npos)  return  sig + "." + stream;
+    size_t const  start = sig.rfind(' ', open);
+    size_t  close = open;
+    for(unsigned  depth = 0; close < sig.size(); close++) {
+      if(sig[close] == '(')  depth++;
+      else if((sig[close] == ')') && (--depth == 0))  break;
+    }
+    std::string  name = sig.substr(start == std::string::npos? 0 : start+1, open - (start == std::string::npos? 0 : start+1));
+    name += std::string(".") + stream;
+    if(close + 1 < sig.size())  name += sig.substr(close + 1);
+    return  name;
+  }
+
+  size_t record(std::string const &name, size_t const  written) {
+    auto  it = m_index.find(name);
+    if(it == m_index.end()) {
+      it = m_index.emplace(name, m_entries.size()).first;
+      m_entries.emplace_back();
+      m_entries.back().name = name;
+    }
+    Entry &e = m_entries[it->second];
+    e.calls++;
+    e.written += written;
+    return  it->second;
+  }
+
+  void left(size_t const  idx, size_t const  words) {
+    m_entries[idx].left += words;
+  }
+
+  void report(std::ostream &os) const {
+    os << "Stream profile (name, calls, words written, words left):" << std::endl;
+    for(Entry const &e : m_entries) {
+      os << "  " << e.name << ", " << e.calls << ", " << e.written << ", " << e.left << std::endl;
+    }
+  }
+
+  void reset() {
+    m_index.clear();
+    m_entries.clear();
+  }
+};
+
+/**
+ * \brief   Probe of a single stream, see StreamProfiler
+ */
+template<typename S>
+class StreamProbe {
+  S const &m_stream;
+  size_t const  m_idx;
+public:
+  StreamProbe(S const &stream, std::string const &name)
+    : m_stream(stream), m_idx(StreamProfiler::instance().record(name, stream.size())) {}
+  ~StreamProbe() {
+    StreamProfiler::instance().left(m_idx, m_stream.size());
+  }
+};
+
+#define FINN_STREAM_PROBE(s) \
+  StreamProbe<typename std::decay<decltype(s)>::type> const  finn_stream_probe_##s((s), StreamProfiler::name(__PRETTY_FUNCTION__, #s))
+#else
+#define FINN_STREAM_PROBE(s)
+#endif
+
+//- Stream word count checks for csim -----------------------------------------
+/**
+ * \brief   Checks the words read and written by the library blocks during C simulation
+ *
+ * Enabled by defining FINN_STREAM_CHECK, otherwise FINN_STREAM_CHECK_IN and FINN_STREAM_CHECK_OUT expand
+ * to nothing. A block states with FINN_STREAM_CHECK_IN(s, words) how many words it will read from stream s
+ * and with FINN_STREAM_CHECK_OUT(s, words) how many it will write to s, both derived from its template
+ * parameters and its number of repetitions. As csim executes the stages of a dataflow region one after
+ * the other, all the words a block reads must be present when it starts. A block finding fewer would read
+ * an empty stream, which hangs cosim and hardware, and is reported before it does so. Words left unread on
+ * an input when the block returns, and outputs with a number of words other than the stated one, are
+ * reported as well. Every report names the block with its template arguments and the stream. The reports
+ * are printed as they occur and kept for StreamChecker::reports(); with fatal(true), the first one throws
+ * a std::runtime_error instead, stopping the simulation where the mismatch started.
+ *
+ * A mismatch of numReps between adjacent stages thus shows at the first stage reading too few or too many
+ * words. Stream depths are not modelled by csim, StreamProfiler gives upper bounds of them.
+ */
+#if defined(FINN_STREAM_CHECK) && !defined(__SYNTHESIS__)
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class StreamChecker {
+  std::vector<std::string>  m_reports;
+  bool  m_fatal = false;
+
+  StreamChecker() {}
+
+public:
+  static StreamChecker &instance() {
+    static StreamChecker  checker;
+    return  checker;
+  }
+
+  /** Whether the first report throws a std::runtime_error. */
+  void fatal(bool const  enable) {
+    m_fatal = enable;
+  }
+
+  void report(std::string const &block, char const *stream, std::string const &what) {
+    std::string const  msg = block + ": stream " + stream + " " + what;
+    std::cerr << "StreamChecker: " << msg << std::endl;
+    m_reports.push_back(msg);
+    // not while an earlier report unwinds the stack
+    if(m_fatal && !std::uncaught_exception())  throw  std::runtime_error(msg);
+  }
+
+  std::vector<std::string> const& reports() const {
+    return  m_reports;
+  }
+
+  void reset() {
+    m_reports.clear();
+  }
+
+  /** Checks the words available on an input at the start of a block and the words left at its end. */
+  template<typename S>
+  class Input {
+    S const &m_stream;
+    char const *const  m_name;
+    std::string const  m_block;
+
+  public:
+    Input(S const &s, char const *name, unsigned long long const  words, char const *block)
+      : m_stream(s), m_name(name), m_block(block) {
+      if(s.size() < words) {
+        std::ostringstream  what;
+        what << "holds " << s.size() << " of the " << words << " words to be read";
+        instance().report(m_block, m_name, what.str());
+      }
+    }
+    ~Input() noexcept(false) {
+      if(m_stream.size() > 0) {
+        std::ostringstream  what;
+        what << "left with " << m_stream.size() << " unread words";
+        instance().report(m_block, m_name, what.str());
+      }
+    }
+  };
+
+  /** Checks the words written to an output by a block. */
+  template<typename S>
+  class Output {
+    S const &m_stream;
+    char const *const  m_name;
+    std::string const  m_block;
+    unsigned long long const  m_start;
+    unsigned long long const  m_words;
+
+  public:
+    Output(S const &s, char const *name, unsigned long long const  words, char const *block)
+      : m_stream(s), m_name(name), m_block(block), m_start(s.size()), m_words(words) {}
+    ~Output() noexcept(false) {
+      unsigned long long const  written = m_stream.size() - m_start;
+      if(written != m_words) {
+        std::ostringstream  what;
+        what << "written with " << written << " instead of " << m_words << " words";
+        instance().report(m_block, m_name, what.str());
+      }
+    }
+  };
+};
+
+#define FINN_STREAM_CHECK_IN(s, words) \
+  StreamChecker::Input<typename std::remove_reference<decltype(s)>::type> const  finn_stream_check_##s((s), #s, (words), __PRETTY_FUNCTION__)
+#define FINN_STREAM_CHECK_OUT(s, words) \
+  StreamChecker::Output<typename std::remove_reference<decltype(s)>::type> const  finn_stream_check_##s((s), #s, (words), __PRETTY_FUNCTION__)
+#else
+#define FINN_STREAM_CHECK_IN(s, words)
+#define FINN_STREAM_CHECK_OUT(s, words)
+#endif
+
+//- Stream taps for csim ----------------------------------------------------
+/**
+ * \brief   Records and checks the words passing the StreamTap_Batch stages during C simulation
+ *
+ * The taps are identified by the Id template argument of StreamTap_Batch and selected by the testbench
+ * before running the design: record(id) keeps the words of a tap in a buffer sized once per batch and,
+ * given a path, writes them there at program exit or on flush(); compare(id, path) checks every word
+ * against a golden file as it passes and reports the first mismatch. The files hold the raw words in
+ * ceil(BitWidth/8) bytes each, least significant byte first, as e.g. numpy's tofile() writes them.
+ * Taps not selected only forward their words.
+ */
+#ifndef __SYNTHESIS__
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class StreamTapper {
+public:
+  class Tap {
+    friend class StreamTapper;
+    std::string  m_path;
+    bool  m_record = false;
+    std::vector<unsigned char>  m_data;
+    std::vector<unsigned char>  m_golden;
+    bool  m_compare = false;
+    unsigned long long  m_words = 0;
+    long long  m_mismatch = -1;
+    unsigned long long  m_mismatches = 0;
+
+  public:
+    unsigned long long words() const { return  m_words; }
+    long long first_mismatch() const { return  m_mismatch; }
+    unsigned long long mismatches() const { return  m_mismatches; }
+    std::vector<unsigned char> const& data() const { return  m_data; }
+
+    template<int BitWidth>
+    void word(unsigned const  id, ap_uint<BitWidth> const &w) {
+      unsigned char  bytes[(BitWidth+7)/8];
+      for(unsigned  b = 0; 8*b < BitWidth; b++) {
+        bytes[b] = ap_uint<8>(w >> (8*b));
+      }
+      if(m_record)  m_data.insert(m_data.end(), bytes, bytes + sizeof(bytes));
+      if(m_compare) {
+        size_t const  ofs = m_words * sizeof(bytes);
+        bool const  match = (ofs + sizeof(bytes) <= m_golden.size()) && std::equal(bytes, bytes + sizeof(bytes), &m_golden[ofs]);
+        if(!match) {
+          if(m_mismatch < 0) {
+            m_mismatch = m_words;
+            std::cout << "StreamTap " << id << ": first mismatch at word " << m_words << ", value 0x" << std::hex << w;
+            if(ofs + sizeof(bytes) <= m_golden.size()) {
+              ap_uint<BitWidth>  g = 0;
+              for(unsigned  b = sizeof(bytes); b-- > 0;)  g = (g << 8) | m_golden[ofs+b];
+              std::cout << ", golden 0x" << g;
+            }
+            else  std::cout << ", beyond the end of the golden file";
+            std::cout << std::dec << std::endl;
+          }
+          m_mismatches++;
+        }
+      }
+      m_words++;
+    }
+  };
+
+private:
+  std::map<unsigned, Tap>  m_taps;
+
+  StreamTapper() {}
+  ~StreamTapper() {
+    flush();
+  }
+
+public:
+  static StreamTapper &instance() {
+    static StreamTapper  tapper;
+    return  tapper;
+  }
+
+  /** Records the words of tap id, writing them to path unless it is empty. */
+  void record(unsigned const  id, std::string const &path = "") {
+    Tap &t = m_taps[id];
+    t.m_record = true;
+    t.m_path = path;
+  }
+
+  /** Compares the words of tap id against the golden file at path. */
+  void compare(unsigned const  id, std::string const &path) {
+    std::FILE *const  f = std::fopen(path.c_str(), "rb");
+    if(!f)  throw  std::runtime_error("StreamTapper: cannot open golden file " + path);
+    Tap &t = m_taps[id];
+    t.m_golden.clear();
+    unsigned char  buf[4096];
+    for(size_t  n; (n = std::fread(buf, 1, sizeof(buf), f)) > 0;)  t.m_golden.insert(t.m_golden.end(), buf, buf + n);
+    std::fclose(f);
+    t.m_compare = true;
+  }
+
+  /** The selected tap id at the start of a batch of words bytes wide, nullptr if not selected. */
+  Tap *begin(unsigned const  id, unsigned long long const  words, unsigned const  bytes) {
+    auto const  it = m_taps.find(id);
+    if(it == m_taps.end())  return  nullptr;
+    Tap &t = it->second;
+    if(t.m_record)  t.m_data.reserve(t.m_data.size() + words * bytes);
+    return &t;
+  }
+
+  Tap const& tap(unsigned const  id) const {
+    return  m_taps.at(id);
+  }
+
+  /** Writes the recorded words of all taps with a path. */
+  void flush() {
+    for(auto const &kv : m_taps) {
+      Tap const &t = kv.second;
+      if(!t.m_record || t.m_path.empty())  continue;
+      std::FILE *const  f = std::fopen(t.m_path.c_str(), "wb");
+      if(f) {
+        std::fwrite(t.m_data.data(), 1, t.m_data.size(), f);
+        std::fclose(f);
+      }
+      else  std::cerr << "StreamTapper: cannot write " << t.m_path << std::endl;
+    }
+  }
+
+  void reset() {
+    m_taps.clear();
+  }
+};
+#endif
+
 /**
  * \brief   Stream logger - Logging call to dump on file - not synthezisable
  *
+ * Drains and refills the stream between stages, StreamTap_Batch records and checks a stream in place.
  *
  * \tparam     BitWidth    Width, in number of bits, of the input (and output) stream
  *
@@ -55,10 +55,14 @@
  * The function performs the multiplication between a weigth vector and the input activation vector,
  * accumulating the results and then applying an activation function on the accumulated result.
  * It is used to implement depth-wise separable convolution
+ *
+ * With SIMD > 1, every input word carries SIMD kernel positions for each of the PE channels, element
+ * pe*SIMD + simd holding kernel position sf*SIMD + simd of channel nf*PE + pe (see
+ * DepthwiseKernelPacker_Batch). Weight tile nf*(Kernel_2/SIMD) + sf holds the matching SIMD weights per PE.
  * 
  * \tparam Channels   Number of channels
  * \tparam Kernel_2   Kernel * Kernel dimension (Kernel ^ 2 if square)
- * \tparam SIMD       Number of input columns computed in parallel, must be set to 1
+ * \tparam SIMD       Number of kernel positions computed in parallel, must divide Kernel_2
  * \tparam PE         Number of output rows computed in parallel
  * \tparam MMV        Number of output pixels computed in parallel
  * \tparam TSrcI      DataType of the input activation (as used in the MAC)
@@ -89,7 +93,7 @@ void Vector_Vector_Activate_Batch(hls::stream<TI> &in,
 				  int const  reps,
 				  R const &r) {
 
-  static_assert(SIMD == 1, "SIMD parallelism not yet supported.");
+  static_assert(Kernel_2 % SIMD == 0, "SIMD must divide Kernel_2.");
 
   // how many different rows each neuron will compute
   // alternatively: number of vertical matrix chunks
@@ -97,8 +101,8 @@ void Vector_Vector_Activate_Batch(hls::stream<TI> &in,
 
   // how many synapse groups each row is split into
   // alternatively: number of horizontal matrix chunks
-  // always equal to # kernel pixels since no SIMD
-  unsigned const  SF = Kernel_2;
+  // equal to # kernel pixels divided by the kernel positions computed in parallel
+  unsigned const  SF = Kernel_2 / SIMD;
   decltype(activation.init(0,0))  accu[MMV][PE];
 #pragma HLS ARRAY_PARTITION variable=accu complete dim=0
 
@@ -129,7 +133,10 @@ void Vector_Vector_Activate_Batch(hls::stream<TI> &in,
       auto const  wgt = TWeightI()(w[pe]);
       for (unsigned mmv = 0; mmv < MMV; mmv++){
         auto const  act = TSrcI()(inElem, mmv);
-		accu[mmv][pe] += mul(wgt[0], act(pe,mmv), r);
+        for(unsigned  simd = 0; simd < SIMD; simd++) {
+#pragma HLS UNROLL
+          accu[mmv][pe] += mul(wgt[simd], act(pe*SIMD + simd, mmv), r);
+        }
       }
     }
 
@@ -163,11 +170,12 @@ void Vector_Vector_Activate_Batch(hls::stream<TI> &in,
  * The function performs the multiplication between a weigth vector and the input activation vector,
  * accumulating the results and then applying an activation function on the accumulated result.
  * It is used to implement depth-wise separable convolution. The weights are supplied from a stream
- * input to facilitate memory-compute decoupling.
+ * input to facilitate memory-compute decoupling. The input and weight layouts for SIMD > 1 are the same as for
+ * Vector_Vector_Activate_Batch.
  * 
  * \tparam Channels   Number of channels
  * \tparam Kernel_2   Kernel * Kernel dimension (Kernel ^ 2 if square)
- * \tparam SIMD       Number of input columns computed in parallel, must be set to 1
+ * \tparam SIMD       Number of kernel positions computed in parallel, must divide Kernel_2
  * \tparam PE         Number of output rows computed in parallel
  * \tparam MMV        Number of output pixels computed in parallel
  * \tparam TSrcI      DataType of the input activation (as used in the MAC)
@@ -199,7 +207,7 @@ void Vector_Vector_Activate_Stream_Batch(
 	int const  reps,
 	R const &r
 ) {
-	static_assert(SIMD == 1, "SIMD parallelism not yet supported.");
+	static_assert(Kernel_2 % SIMD == 0, "SIMD must divide Kernel_2.");
 
 	// how many different rows each neuron will compute
 	// alternatively: number of vertical matrix chunks
@@ -207,8 +215,8 @@ void Vector_Vector_Activate_Stream_Batch(
 
 	// how many synapse groups each row is split into
 	// alternatively: number of horizontal matrix chunks
-	// always equal to # kernel pixels since no SIMD
-	constexpr unsigned  SF = Kernel_2;
+	// equal to # kernel pixels divided by the kernel positions computed in parallel
+	constexpr unsigned  SF = Kernel_2 / SIMD;
 	decltype(activation.init(0,0))  accu[MMV][PE];
 #pragma HLS ARRAY_PARTITION variable=accu complete dim=0
 
@@ -247,7 +255,10 @@ void Vector_Vector_Activate_Stream_Batch(
 			auto const  wgt = TWeightI()(w[pe]);
 			for(unsigned mmv = 0; mmv < MMV; mmv++) {
 				auto const  act = TSrcI()(inElem, mmv);
-				accu[mmv][pe] += mul(wgt[0], act(pe,mmv), r);
+				for(unsigned  simd = 0; simd < SIMD; simd++) {
+#pragma HLS UNROLL
+					accu[mmv][pe] += mul(wgt[simd], act(pe*SIMD + simd, mmv), r);
+				}
 			}
 		}
 
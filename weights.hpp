@@ -54,6 +54,8 @@
 #include <ap_int.h>
 #include <array>
 
+#include "utils.hpp"
+
 
 /**
  * \brief      A binary weight storage adapter that translates the internal 
@@ -148,6 +150,573 @@ class FixedPointWeights {
 };
 
 
+/**
+ * \brief      A binary weight storage adapter packing the weights of
+ * PE_PER_WORD PEs into a single memory word.
+ *
+ * The weights of PE pe are found in word m_weights[pe/PE_PER_WORD][tile] at
+ * bits [(pe%PE_PER_WORD+1)*SIMD-1 : (pe%PE_PER_WORD)*SIMD]. The default
+ * PE_PER_WORD is the packing needing the fewest BRAM18 (or URAM288) for the
+ * given depth, see packed_pe_per_word. The access by the MVAU is the one of
+ * BinaryWeights, and m_weights is partitioned along its first dimension.
+ *
+ * \tparam     SIMD         Number of input columns (channels) computed in parallel
+ * \tparam     PE           Number of output rows (channels) computed in parallel
+ * \tparam     TILES        3rd dimension of the weights matrix
+ * \tparam     PE_PER_WORD  Number of PEs sharing a memory word, a divisor of PE
+ */
+template<unsigned SIMD, unsigned PE, unsigned TILES,
+	unsigned PE_PER_WORD = packed_pe_per_word(PE, TILES, SIMD)>
+class PackedBinaryWeights {
+  static_assert(PE % PE_PER_WORD == 0, "PE_PER_WORD must divide PE.");
+
+ public:
+  ap_uint<PE_PER_WORD*SIMD>  m_weights[PE/PE_PER_WORD][TILES];
+
+ private:
+  /**
+   * Temporary container for the tile index to implement the
+   * memory access in pe -> tile order.
+   */
+  class TileIndex {
+    PackedBinaryWeights const &m_par;
+    unsigned            const  m_idx;
+
+   public:
+    TileIndex(PackedBinaryWeights const &par, unsigned const  idx)
+      : m_par(par), m_idx(idx) {
+#pragma HLS inline
+    }
+
+   public:
+    ap_uint<SIMD> operator[](unsigned const  pe) const {
+#pragma HLS inline
+      unsigned const  ofs = (pe % PE_PER_WORD) * SIMD;
+      return  m_par.m_weights[pe / PE_PER_WORD][m_idx](ofs+SIMD-1, ofs);
+    }
+  };
+
+ public:
+  TileIndex weights(unsigned const  tile) const {
+#pragma HLS inline
+    return  TileIndex(*this, tile);
+  }
+};
+
+
+/**
+ * \brief      A fixed point weight storage adapter packing the weights of
+ * PE_PER_WORD PEs into a single memory word.
+ *
+ * The weights of PE pe are found in word m_weights[pe/PE_PER_WORD][tile] at
+ * bits [(pe%PE_PER_WORD+1)*SIMD*WT::width-1 : (pe%PE_PER_WORD)*SIMD*WT::width]
+ * in the lane order of FixedPointWeights. The default PE_PER_WORD is the
+ * packing needing the fewest BRAM18 (or URAM288) for the given depth, see
+ * packed_pe_per_word. The access by the MVAU is the one of FixedPointWeights,
+ * and m_weights is partitioned along its first dimension.
+ *
+ * \tparam     SIMD         Number of input columns (channels) computed in parallel
+ * \tparam     WT           Datatype of the weights
+ * \tparam     PE           Number of output rows (channels) computed in parallel
+ * \tparam     TILES        3rd dimension of the weights matrix
+ * \tparam     PE_PER_WORD  Number of PEs sharing a memory word, a divisor of PE
+ */
+template<unsigned SIMD, typename WT, unsigned PE, unsigned TILES,
+	unsigned PE_PER_WORD = packed_pe_per_word(PE, TILES, SIMD*WT::width)>
+class PackedFixedPointWeights {
+  static_assert(PE % PE_PER_WORD == 0, "PE_PER_WORD must divide PE.");
+  static unsigned constexpr  PE_BITS = SIMD*WT::width;
+
+ public:
+  ap_uint<PE_PER_WORD*PE_BITS>  m_weights[PE/PE_PER_WORD][TILES];
+
+ private:
+  /**
+   * Temporary container for the tile index to implement the
+   * memory access in pe -> tile order.
+   */
+  class TileIndex {
+    PackedFixedPointWeights const &m_par;
+    unsigned                const  m_idx;
+
+   public:
+    TileIndex(PackedFixedPointWeights const &par, unsigned const  idx)
+      : m_par(par), m_idx(idx) {
+#pragma HLS inline
+    }
+
+   public:
+    std::array<WT,SIMD> operator[](unsigned const  pe) const {
+#pragma HLS inline
+      unsigned const  ofs = (pe % PE_PER_WORD) * PE_BITS;
+      ap_uint<PE_BITS> const  w = m_par.m_weights[pe / PE_PER_WORD][m_idx](ofs+PE_BITS-1, ofs);
+      std::array<WT,SIMD>  ret;
+      for(unsigned  i = 0; i < SIMD; i++) {
+#pragma HLS unroll
+        ap_int<WT::width> const  local_temp = w((i+1)*WT::width-1, i*WT::width);
+        ret[i] = WT(local_temp);
+      }
+      return  ret;
+    }
+  };
+
+ public:
+  TileIndex weights(unsigned const  tile) const {
+#pragma HLS inline
+    return  TileIndex(*this, tile);
+  }
+};
+
+
+/**
+ * \brief      A sparse fixed point weight storage adapter that only keeps the
+ * tiles of the folded weight matrix holding at least one non-zero weight in
+ * any of the PEs.
+ *
+ * Stored tiles are ordered by neuron fold and, within a neuron fold, by
+ * ascending synapse fold. m_index records the synapse fold each stored tile
+ * originates from and m_last flags the final stored tile of a neuron fold.
+ * Every neuron fold must contribute at least one tile: an all-zero tile is to
+ * be stored for a neuron fold without any non-zero weight.
+ *
+ * \tparam     SIMD     Number of input columns (channels) computed in parallel
+ * \tparam     WT       Datatype of the weights
+ * \tparam     PE       Number of output rows (channels) computed in parallel
+ * \tparam     SF       Number of synapse folds of the dense matrix (MatrixW / SIMD)
+ * \tparam     NZTILES  Number of stored (non-zero) tiles
+ */
+template<unsigned SIMD, typename WT, unsigned PE, unsigned SF, unsigned NZTILES>
+class SparseFixedPointWeights {
+ public:
+  static unsigned const  INDEX_WIDTH = SF > 1? clog2(SF) : 1;
+
+  ap_uint<SIMD*WT::width>  m_weights[PE][NZTILES];
+  ap_uint<INDEX_WIDTH>     m_index[NZTILES];
+  ap_uint<1>               m_last[NZTILES];
+
+ private:
+  /**
+   * Temporary container for the tile index to implement the
+   * memory access in pe -> tile order.
+   */
+  class TileIndex {
+    SparseFixedPointWeights const &m_par;
+    unsigned                const  m_idx;
+
+   public:
+    TileIndex(SparseFixedPointWeights const &par, unsigned const  idx)
+      : m_par(par), m_idx(idx) {
+#pragma HLS inline
+    }
+
+   public:
+    std::array<WT,SIMD> operator[](unsigned const  pe) const {
+#pragma HLS inline
+      std::array<WT,SIMD>  ret;
+      for(unsigned int i=0; i<SIMD; i++) {
+#pragma HLS unroll
+        ap_int<WT::width> const  local_temp = m_par.m_weights[pe][m_idx]((i+1)*WT::width-1, i*WT::width);
+        ret[i] = WT(local_temp);
+      }
+      return  ret;
+    }
+  };
+
+ public:
+  TileIndex weights(unsigned const  tile) const {
+#pragma HLS inline
+    return  TileIndex(*this, tile);
+  }
+
+  // synapse fold of the dense matrix the stored tile belongs to
+  unsigned synapse(unsigned const  tile) const {
+#pragma HLS inline
+    return  m_index[tile];
+  }
+
+  // whether the stored tile completes its neuron fold
+  bool last(unsigned const  tile) const {
+#pragma HLS inline
+    return  m_last[tile];
+  }
+};
+
+
+/**
+ * \brief      A fixed point weight storage with two banks that allows for the
+ * weights to be replaced at runtime without stalling the MVAU.
+ *
+ * The MVAU computes on the active bank while the words of the next weight set
+ * are written into the shadow bank through load(). Once the shadow bank has
+ * been filled completely, swap() makes it the active bank. The words are
+ * expected tile after tile with the PE weights concatenated in little endian
+ * PE order, i.e. in the layout produced by GenParamStream.
+ *
+ * \tparam     SIMD   Number of input columns (channels) computed in parallel
+ * \tparam     WT     Datatype of the weights
+ * \tparam     PE     Number of output rows (channels) computed in parallel
+ * \tparam     TILES  3rd dimension of the weights matrix
+ */
+template<unsigned SIMD, typename WT, unsigned PE, unsigned TILES>
+class ReloadableFixedPointWeights {
+ public:
+  ap_uint<SIMD*WT::width>  m_weights[2][PE][TILES];
+  ap_uint<1>  m_active = 0;  // bank in use by the MVAU
+  unsigned    m_loaded = 0;  // tiles written into the shadow bank
+
+ private:
+  /**
+   * Temporary container for the tile index to implement the
+   * memory access in pe -> tile order.
+   */
+  class TileIndex {
+    ReloadableFixedPointWeights const &m_par;
+    unsigned                    const  m_idx;
+
+   public:
+    TileIndex(ReloadableFixedPointWeights const &par, unsigned const  idx)
+      : m_par(par), m_idx(idx) {
+#pragma HLS inline
+    }
+
+   public:
+    std::array<WT,SIMD> operator[](unsigned const  pe) const {
+#pragma HLS inline
+      std::array<WT,SIMD>  ret;
+      for(unsigned int i=0; i<SIMD; i++) {
+#pragma HLS unroll
+        ap_int<WT::width> const  local_temp = m_par.m_weights[m_par.m_active][pe][m_idx]((i+1)*WT::width-1, i*WT::width);
+        ret[i] = WT(local_temp);
+      }
+      return  ret;
+    }
+  };
+
+ public:
+  TileIndex weights(unsigned const  tile) const {
+#pragma HLS inline
+    return  TileIndex(*this, tile);
+  }
+
+  // whether the shadow bank still accepts words of the next weight set
+  bool loading() const {
+#pragma HLS inline
+    return  m_loaded < TILES;
+  }
+
+  // write the next tile of the shadow bank
+  void load(ap_uint<PE*SIMD*WT::width> const &w) {
+#pragma HLS inline
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+      m_weights[!m_active][pe][m_loaded] = w((pe+1)*SIMD*WT::width-1, pe*SIMD*WT::width);
+    }
+    m_loaded++;
+  }
+
+  // activate the shadow bank once complete, returns whether the banks were swapped
+  bool swap() {
+#pragma HLS inline
+    if(m_loaded < TILES)  return  false;
+    m_active = !m_active;
+    m_loaded = 0;
+    return  true;
+  }
+};
+
+
+/**
+ * \brief      A power-of-two weight (-1)^sign * 2^exp, consumed by the barrel
+ * shifter multiplication selected by ap_resource_shift.
+ *
+ * \tparam     ExpBits  Width of the exponent
+ */
+template<unsigned ExpBits>
+struct LogWeight {
+  ap_uint<1>        sign;
+  ap_uint<ExpBits>  exp;
+
+  // value of the weight
+  int value() const {
+#pragma HLS inline
+    return  sign? -(1 << exp) : (1 << exp);
+  }
+};
+
+/**
+ * \brief      A power-of-two weight storage adapter keeping a sign bit and an
+ * exponent per weight.
+ *
+ * A lane occupies ExpBits+1 bits of the tile word, the exponent in the low
+ * ExpBits bits and the sign above it. Lane i is found at bits
+ * [(i+1)*(ExpBits+1)-1 : i*(ExpBits+1)] as in FixedPointWeights.
+ *
+ * \tparam     SIMD     Number of input columns (channels) computed in parallel
+ * \tparam     PE       Number of output rows (channels) computed in parallel
+ * \tparam     TILES    3rd dimension of the weights matrix
+ * \tparam     ExpBits  Width of the exponent
+ */
+template<unsigned SIMD, unsigned PE, unsigned TILES, unsigned ExpBits>
+class LogWeights {
+ public:
+  static unsigned constexpr  LANE_BITS = ExpBits+1;
+  ap_uint<SIMD*LANE_BITS>  m_weights[PE][TILES];
+
+ private:
+  /**
+   * Temporary container for the tile index to implement the
+   * memory access in pe -> tile order.
+   */
+  class TileIndex {
+    LogWeights const &m_par;
+    unsigned   const  m_idx;
+
+   public:
+    TileIndex(LogWeights const &par, unsigned const  idx)
+      : m_par(par), m_idx(idx) {
+#pragma HLS inline
+    }
+
+   public:
+    std::array<LogWeight<ExpBits>,SIMD> operator[](unsigned const  pe) const {
+#pragma HLS inline
+      std::array<LogWeight<ExpBits>,SIMD>  ret;
+      for(unsigned  i = 0; i < SIMD; i++) {
+#pragma HLS unroll
+        ap_uint<LANE_BITS> const  lane = m_par.m_weights[pe][m_idx]((i+1)*LANE_BITS-1, i*LANE_BITS);
+        ret[i].exp  = lane(ExpBits-1, 0);
+        ret[i].sign = lane[ExpBits];
+      }
+      return  ret;
+    }
+  };
+
+ public:
+  TileIndex weights(unsigned const  tile) const {
+#pragma HLS inline
+    return  TileIndex(*this, tile);
+  }
+};
+
+
+/**
+ * \brief      The ternary (-1/0/+1) weights of SIMD lanes as a nonzero mask and
+ * a sign bitplane, consumed by the multiplier-free ternary mac.
+ *
+ * \tparam     SIMD   Number of lanes
+ */
+template<unsigned SIMD>
+struct TernaryWord {
+  ap_uint<SIMD>  mask;  // lanes with a nonzero weight
+  ap_uint<SIMD>  sign;  // lanes with a weight of -1, only meaningful where mask is set
+
+  // weight of a lane as -1, 0 or +1
+  ap_int<2> weight(unsigned const  i) const {
+#pragma HLS inline
+    return  mask[i]? (sign[i]? ap_int<2>(-1) : ap_int<2>(1)) : ap_int<2>(0);
+  }
+};
+
+/**
+ * \brief      A ternary weight storage adapter keeping a nonzero mask and a sign
+ * bitplane per tile, so that the MVAU adds and subtracts the activations
+ * instead of multiplying them.
+ *
+ * Bit i of the words refers to SIMD lane i as in BinaryWeights. A lane with
+ * a cleared mask bit has a zero weight, its sign bit is ignored.
+ *
+ * \tparam     SIMD   Number of input columns (channels) computed in parallel
+ * \tparam     PE     Number of output rows (channels) computed in parallel
+ * \tparam     TILES  3rd dimension of the weights matrix
+ */
+template<unsigned SIMD, unsigned PE, unsigned TILES>
+class TernaryWeights {
+ public:
+  ap_uint<SIMD>  m_mask[PE][TILES];
+  ap_uint<SIMD>  m_sign[PE][TILES];
+
+ private:
+  /**
+   * Temporary container for the tile index to implement the
+   * memory access in pe -> tile order.
+   */
+  class TileIndex {
+    TernaryWeights const &m_par;
+    unsigned       const  m_idx;
+
+   public:
+    TileIndex(TernaryWeights const &par, unsigned const  idx)
+      : m_par(par), m_idx(idx) {
+#pragma HLS inline
+    }
+
+   public:
+    TernaryWord<SIMD> operator[](unsigned const  pe) const {
+#pragma HLS inline
+      TernaryWord<SIMD>  ret;
+      ret.mask = m_par.m_mask[pe][m_idx];
+      ret.sign = m_par.m_sign[pe][m_idx];
+      return  ret;
+    }
+  };
+
+ public:
+  TileIndex weights(unsigned const  tile) const {
+#pragma HLS inline
+    return  TileIndex(*this, tile);
+  }
+};
+
+
+/**
+ * \brief      A codebook weight storage for weight-clustered layers, which
+ * keeps an index into a small table of centroids per weight.
+ *
+ * m_weights packs SIMD indices of IndexBits bits per tile in the same little
+ * endian SIMD order as FixedPointWeights. Every PE decodes them through its
+ * own row of m_codebook, which holds the same centroids in every row for a
+ * per-layer codebook. The decoded weights are returned as an array of WT so
+ * that the MVAU is unchanged. Partition m_codebook completely for the SIMD
+ * lookups of a PE to proceed in parallel.
+ *
+ * \tparam     SIMD       Number of input columns (channels) computed in parallel
+ * \tparam     WT         Datatype of the weights (centroids)
+ * \tparam     PE         Number of output rows (channels) computed in parallel
+ * \tparam     TILES      3rd dimension of the weights matrix
+ * \tparam     IndexBits  Width of the centroid indices, 2^IndexBits centroids
+ */
+template<unsigned SIMD, typename WT, unsigned PE, unsigned TILES, unsigned IndexBits = 4>
+class CodebookWeights {
+ public:
+  static unsigned const  CENTROIDS = 1u << IndexBits;
+
+  ap_uint<SIMD*IndexBits>  m_weights[PE][TILES];
+  WT                       m_codebook[PE][CENTROIDS];
+
+ private:
+  /**
+   * Temporary container for the tile index to implement the
+   * memory access in pe -> tile order.
+   */
+  class TileIndex {
+    CodebookWeights const &m_par;
+    unsigned        const  m_idx;
+
+   public:
+    TileIndex(CodebookWeights const &par, unsigned const  idx)
+      : m_par(par), m_idx(idx) {
+#pragma HLS inline
+    }
+
+   public:
+    std::array<WT,SIMD> operator[](unsigned const  pe) const {
+#pragma HLS inline
+      std::array<WT,SIMD>  ret;
+      ap_uint<SIMD*IndexBits> const  indices = m_par.m_weights[pe][m_idx];
+      for(unsigned int i=0; i<SIMD; i++) {
+#pragma HLS unroll
+        ap_uint<IndexBits> const  idx = indices((i+1)*IndexBits-1, i*IndexBits);
+        ret[i] = m_par.m_codebook[pe][idx];
+      }
+      return  ret;
+    }
+  };
+
+ public:
+  TileIndex weights(unsigned const  tile) const {
+#pragma HLS inline
+    return  TileIndex(*this, tile);
+  }
+};
+
+
+/**
+ * \brief      A mixed-precision fixed point weight storage keeping the first
+ * PE_HI PEs at the precision WT_HI and the remaining ones at WT_LO.
+ *
+ * Both precision groups are stored in separate memories packed at their own
+ * width in the SIMD order of FixedPointWeights: PE pe < PE_HI in
+ * m_weights_hi[pe][tile] and PE pe >= PE_HI in m_weights_lo[pe-PE_HI][tile].
+ * As output row r of the matrix is computed by PE r % PE, the rows are to be
+ * reordered such that the sensitive ones of every neuron fold map to the
+ * first PE_HI PEs. The generic access returns the weights of all PEs as WT_HI
+ * so that the MVAU is unchanged. Matrix_Vector_Activate_MixedPrecision_Batch
+ * instead uses the accessors hi() and lo() to give each group its own MAC
+ * resource at its native width.
+ *
+ * \tparam     SIMD   Number of input columns (channels) computed in parallel
+ * \tparam     WT_HI  Datatype of the weights of the high-precision PEs
+ * \tparam     WT_LO  Datatype of the weights of the low-precision PEs
+ * \tparam     PE     Number of output rows (channels) computed in parallel
+ * \tparam     PE_HI  Number of high-precision PEs, 0 < PE_HI < PE
+ * \tparam     TILES  3rd dimension of the weights matrix
+ */
+template<unsigned SIMD, typename WT_HI, typename WT_LO, unsigned PE, unsigned PE_HI, unsigned TILES>
+class MixedPrecisionWeights {
+  static_assert((0 < PE_HI) && (PE_HI < PE), "Both precision groups must hold at least one PE.");
+  static_assert(WT_LO::width <= WT_HI::width, "WT_LO must not be wider than WT_HI.");
+
+ public:
+  ap_uint<SIMD*WT_HI::width>  m_weights_hi[PE_HI][TILES];
+  ap_uint<SIMD*WT_LO::width>  m_weights_lo[PE-PE_HI][TILES];
+
+ private:
+  template<typename WT, unsigned PES>
+  static std::array<WT,SIMD> unpack(ap_uint<SIMD*WT::width> const (&mem)[PES][TILES], unsigned const  pe, unsigned const  tile) {
+#pragma HLS inline
+    std::array<WT,SIMD>  ret;
+    for(unsigned int i=0; i<SIMD; i++) {
+#pragma HLS unroll
+      ap_int<WT::width> const  local_temp = mem[pe][tile]((i+1)*WT::width-1, i*WT::width);
+      ret[i] = WT(local_temp);
+    }
+    return  ret;
+  }
+
+  /**
+   * Temporary container for the tile index to implement the
+   * memory access in pe -> tile order.
+   */
+  class TileIndex {
+    MixedPrecisionWeights const &m_par;
+    unsigned              const  m_idx;
+
+   public:
+    TileIndex(MixedPrecisionWeights const &par, unsigned const  idx)
+      : m_par(par), m_idx(idx) {
+#pragma HLS inline
+    }
+
+   public:
+    std::array<WT_HI,SIMD> hi(unsigned const  pe) const {
+#pragma HLS inline
+      return  unpack<WT_HI>(m_par.m_weights_hi, pe, m_idx);
+    }
+    std::array<WT_LO,SIMD> lo(unsigned const  pe) const {
+#pragma HLS inline
+      return  unpack<WT_LO>(m_par.m_weights_lo, pe - PE_HI, m_idx);
+    }
+    std::array<WT_HI,SIMD> operator[](unsigned const  pe) const {
+#pragma HLS inline
+      if(pe < PE_HI)  return  hi(pe);
+      std::array<WT_LO,SIMD> const  l = lo(pe);
+      std::array<WT_HI,SIMD>  ret;
+      for(unsigned int i=0; i<SIMD; i++) {
+#pragma HLS unroll
+        ret[i] = l[i];
+      }
+      return  ret;
+    }
+  };
+
+ public:
+  TileIndex weights(unsigned const  tile) const {
+#pragma HLS inline
+    return  TileIndex(*this, tile);
+  }
+};
+
+
 template<unsigned SIMD, typename WT, unsigned PE>
 class Weights_Tile { 
 public:
@@ -0,0 +1,379 @@
+/******************************************************************************
+ *  Copyright (c) 2019, Xilinx, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1.  Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2.  Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ *  3.  Neither the name of the copyright holder nor the names of its
+ *      contributors may be used to endorse or promote products derived from
+ *      this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION). HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *
+ *  \file winograd.hpp
+ *
+ *  Library of templated HLS functions for BNN deployment.
+ *  This file lists the building blocks of a Winograd F(2x2,3x3) convolution:
+ *  the input transform, the element-wise multiply-accumulate stage, the
+ *  output transform and the reordering of the output tiles into raster order.
+ *
+ *  Following Lavin & Gray, an output tile Y of 2x2 pixels is computed from a
+ *  4x4 input tile d as Y = A^T [(G g G^T) . (B^T d B)] A. The weights are
+ *  expected pre-transformed with G' = 2G so that U' = G' g G'^T is integer;
+ *  the resulting factor of 4 is removed exactly by the output transform.
+ *
+ *******************************************************************************/
+
+#ifndef WINOGRAD_HPP
+#define WINOGRAD_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "mac.hpp"
+#include "interpret.hpp"
+
+namespace winograd {
+
+  // Coefficients of B^T
+  inline ap_int<2> bt(unsigned const  row, unsigned const  col) {
+#pragma HLS inline
+    return  row == 0? (col == 0? 1 : col == 2? -1 : 0) :
+            row == 1? (col == 1 || col == 2? 1 : 0) :
+            row == 2? (col == 1? -1 : col == 2? 1 : 0) :
+                      (col == 1? 1 : col == 3? -1 : 0);
+  }
+
+  // Coefficients of A^T
+  inline ap_int<2> at(unsigned const  row, unsigned const  col) {
+#pragma HLS inline
+    return  row == 0? (col < 3? 1 : 0) :
+                      (col == 1? 1 : col == 0? 0 : -1);
+  }
+
+} // namespace winograd
+
+/**
+ * \brief Winograd F(2x2,3x3) input transform
+ *
+ * Consumes 4x4 input tiles as produced by ConvolutionInputGenerator with a kernel of 4 and stride 2
+ * (kernel position major, channel fold minor) and emits the 16 transformed elements V = B^T d B of every
+ * tile, each as a vector of IFMChannels values in SIMD-wide words. While one tile is transformed, the
+ * next one is buffered so that a word is consumed and produced every cycle.
+ *
+ * \tparam IFMChannels  Number of Input Feature Maps
+ * \tparam SIMD         Number of channels per stream word
+ * \tparam TSrcI        DataType of the input activation
+ * \tparam TV           DataType of the transformed elements
+ * \tparam TI           DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO           DataType of the output stream - safely deducible from the paramaters
+ *
+ * \param in            Input stream
+ * \param out           Output stream
+ * \param numTiles      Number of tiles to be transformed
+ */
+template<
+  unsigned IFMChannels, unsigned SIMD,
+  typename TSrcI, typename TV,
+  typename TI, typename TO
+>
+void Winograd_InputTransform_Batch(hls::stream<TI> &in, hls::stream<TO> &out, unsigned const  numTiles) {
+  static_assert(IFMChannels % SIMD == 0, "SIMD must divide IFMChannels.");
+  static_assert(TO::width >= SIMD*TV::width, "Output stream too narrow.");
+  constexpr unsigned  CF = IFMChannels / SIMD;
+  constexpr unsigned  TILE_WORDS = 16 * CF;
+
+  // ping-pong tile buffers
+  TI  buf[2][16][CF];
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=2
+
+  ap_uint<1>  bank = 0; // bank being filled
+  unsigned  e  = 0;     // tile element, input position and output element alike
+  unsigned  cf = 0;     // channel fold
+  for(unsigned  i = 0; i < (numTiles+1) * TILE_WORDS; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=buf inter false
+    // buffer the next tile
+    if(i < numTiles * TILE_WORDS) {
+      buf[bank][e][cf] = in.read();
+    }
+
+    // transform the previous tile
+    if(i >= TILE_WORDS) {
+      unsigned const  row = e / 4;
+      unsigned const  col = e % 4;
+      TO  outElem = 0;
+      for(unsigned  simd = 0; simd < SIMD; simd++) {
+#pragma HLS UNROLL
+        TV  v = 0;
+        for(unsigned  k = 0; k < 4; k++) {
+#pragma HLS UNROLL
+          for(unsigned  l = 0; l < 4; l++) {
+#pragma HLS UNROLL
+            auto const  act = TSrcI()(buf[!bank][4*k+l][cf], 0);
+            v += winograd::bt(row, k) * winograd::bt(col, l) * act(simd, 0);
+          }
+        }
+        outElem((simd+1)*TV::width-1, simd*TV::width) = v;
+      }
+      out.write(outElem);
+    }
+
+    if(++cf == CF) {
+      cf = 0;
+      if(++e == 16) {
+        e = 0;
+        bank = !bank;
+      }
+    }
+  }
+}
+
+/**
+ * \brief Winograd F(2x2,3x3) element-wise multiply-accumulate stage
+ *
+ * For each of the 16 transformed elements e of a tile, a matrix vector product between the transformed
+ * weights U'_e (OFMChannels x IFMChannels) and the transformed input vector V_e is computed and the raw
+ * accumulators are emitted, PE channels per word. The weights are stored with tile index (e*NF + nf)*SF + sf.
+ *
+ * \tparam IFMChannels  Number of Input Feature Maps
+ * \tparam OFMChannels  Number of Output Feature Maps
+ * \tparam SIMD         Number of input columns computed in parallel
+ * \tparam PE           Number of output rows computed in parallel
+ * \tparam TAcc         DataType of the accumulators
+ * \tparam TSrcI        DataType of the transformed input (as used in the MAC)
+ * \tparam TDstI        DataType of the output accumulators
+ * \tparam TWeightI     DataType of the weights and how to access them in the array
+ * \tparam TI           DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO           DataType of the output stream - safely deducible from the paramaters
+ * \tparam TW           DataType of the weights matrix - safely deducible from the paramaters
+ * \tparam R            Datatype for the resource used for FPGA implementation of the MAC  - safely deducible from the paramaters
+ *
+ * \param in            Input stream
+ * \param out           Output stream
+ * \param weights       Transformed weights (FixedPointWeights with 16*NF*SF tiles)
+ * \param numTiles      Number of tiles to be processed
+ * \param r             Resource type for the hardware implementation of the MAC block
+ */
+template<
+  unsigned IFMChannels, unsigned OFMChannels, unsigned SIMD, unsigned PE, typename TAcc,
+  typename TSrcI = Identity, typename TDstI = Identity, typename TWeightI = Identity,
+  typename TI, typename TO, typename TW, typename R
+>
+void Winograd_Elementwise_Batch(hls::stream<TI> &in, hls::stream<TO> &out,
+				  TW const &weights, unsigned const  numTiles, R const &r) {
+  constexpr unsigned  NF = OFMChannels / PE;
+  constexpr unsigned  SF = IFMChannels / SIMD;
+  constexpr unsigned  TOTAL_FOLD = 16 * NF * SF;
+
+  // input vector buffers
+  TI  inputBuf[SF];
+#pragma HLS ARRAY_PARTITION variable=inputBuf complete dim=0
+
+  TAcc  accu[PE];
+#pragma HLS ARRAY_PARTITION variable=accu complete dim=0
+
+  unsigned  nf   = 0;
+  unsigned  sf   = 0;
+  unsigned  tile = 0; // invariant: tile = (e*NF + nf)*SF + sf
+  for(unsigned  i = 0; i < numTiles * TOTAL_FOLD; i++) {
+#pragma HLS pipeline style=flp II=1
+    TI  inElem;
+    if(nf == 0) {
+      // read input from stream
+      inElem = in.read();
+      // store in appropriate buffer for reuse
+      inputBuf[sf] = inElem;
+    }
+    else {
+      // reuse buffered input
+      inElem = inputBuf[sf];
+    }
+
+    if(sf == 0) {
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        accu[pe] = 0;
+      }
+    }
+
+    // compute matrix-vector product for each processing element
+    auto const &w = weights.weights(tile);
+    for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+      auto const  wgt = TWeightI()(w[pe]);
+      auto const  act = TSrcI()(inElem, 0);
+      accu[pe] = mac<SIMD>(accu[pe], wgt, act, r, 0);
+    }
+
+    // keep track of which transformed element/folded neuron we are processing
+    if(++tile == TOTAL_FOLD)  tile = 0;
+    if(++sf == SF) {
+      auto  outElem = TDstI().template operator()<TO>();
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        outElem(pe,0,1) = accu[pe];
+      }
+      out.write(outElem);
+      sf = 0;
+      if(++nf == NF)  nf = 0;
+    }
+  }
+}
+
+/**
+ * \brief Winograd F(2x2,3x3) output transform
+ *
+ * Collects the 16 accumulated elements M of a tile and computes the 2x2 output pixels A^T M A. The factor
+ * of 4 introduced by the integer weight transform is removed before the activation is applied. The pixels
+ * of a tile are emitted in raster order, each as NF words of PE channels. While one tile is transformed,
+ * the next one is buffered.
+ *
+ * \tparam OFMChannels  Number of Output Feature Maps
+ * \tparam PE           Number of output channels per stream word
+ * \tparam TSrcI        DataType of the accumulated elements
+ * \tparam TDstI        DataType of the output activation (as generated by the activation)
+ * \tparam TI           DataType of the input stream - safely deducible from the paramaters
+ * \tparam TO           DataType of the output stream - safely deducible from the paramaters
+ * \tparam TA           DataType of the activation class (e.g. thresholds) - safely deducible from the paramaters
+ *
+ * \param in            Input stream
+ * \param out           Output stream
+ * \param activation    Activation class
+ * \param numTiles      Number of tiles to be transformed
+ */
+template<
+  unsigned OFMChannels, unsigned PE,
+  typename TSrcI = Identity, typename TDstI = Identity,
+  typename TI, typename TO, typename TA
+>
+void Winograd_OutputTransform_Batch(hls::stream<TI> &in, hls::stream<TO> &out,
+				  TA const &activation, unsigned const  numTiles) {
+  constexpr unsigned  NF = OFMChannels / PE;
+  constexpr unsigned  TILE_WORDS = 16 * NF;
+
+  // ping-pong tile buffers
+  TI  buf[2][16][NF];
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+#pragma HLS ARRAY_PARTITION variable=buf complete dim=2
+
+  ap_uint<1>  bank = 0; // bank being filled
+  unsigned  e   = 0;    // element being buffered
+  unsigned  nf  = 0;
+  unsigned  px  = 0;    // output pixel of the previous tile
+  unsigned  nfo = 0;
+  for(unsigned  i = 0; i < (numTiles+1) * TILE_WORDS; i++) {
+#pragma HLS pipeline style=flp II=1
+#pragma HLS DEPENDENCE variable=buf inter false
+    // buffer the next tile
+    if(i < numTiles * TILE_WORDS) {
+      buf[bank][e][nf] = in.read();
+    }
+
+    // transform the previous tile
+    if((i >= TILE_WORDS) && (px < 4)) {
+      unsigned const  row = px / 2;
+      unsigned const  col = px % 2;
+      auto  outElem = TDstI().template operator()<TO>();
+      for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS UNROLL
+        ap_int<TSrcI::width+4>  y = 0;
+        for(unsigned  k = 0; k < 4; k++) {
+#pragma HLS UNROLL
+          for(unsigned  l = 0; l < 4; l++) {
+#pragma HLS UNROLL
+            auto const  m = TSrcI()(buf[!bank][4*k+l][nfo], 0);
+            y += winograd::at(row, k) * winograd::at(col, l) * m(pe, 0);
+          }
+        }
+        auto  accu = activation.init(nfo, pe);
+        accu += (y >> 2);
+        outElem(pe,0,1) = activation.activate(nfo, pe, accu);
+      }
+      out.write(outElem);
+      if(++nfo == NF) {
+        nfo = 0;
+        px++;
+      }
+    }
+
+    if(++nf == NF) {
+      nf = 0;
+      if(++e == 16) {
+        e    = 0;
+        bank = !bank;
+        px   = 0;
+      }
+    }
+  }
+}
+
+/**
+ * \brief Reorders the 2x2 output tiles of a Winograd convolution into raster order
+ *
+ * The upper pixel row of each tile is forwarded immediately, the lower one is buffered until the
+ * tile row has been completed.
+ *
+ * \tparam OFMDim       Width and Height of the Output Feature Map (assumed square and even)
+ * \tparam NF           Number of stream words per output pixel
+ * \tparam T            DataType of the stream - safely deducible from the paramaters
+ *
+ * \param in            Input stream
+ * \param out           Output stream
+ * \param reps          Number of time the function has to be repeatedly executed (e.g. number of images)
+ */
+template<unsigned OFMDim, unsigned NF, typename T>
+void Winograd_OutputReorder_Batch(hls::stream<T> &in, hls::stream<T> &out, unsigned const  reps) {
+  static_assert(OFMDim % 2 == 0, "Output dimension must be even.");
+  constexpr unsigned  TX = OFMDim / 2;
+
+  T  lowerRow[OFMDim * NF];
+  for(unsigned  rep = 0; rep < reps * TX; rep++) {
+    // one row of tiles
+    unsigned  tx = 0;
+    unsigned  px = 0;
+    unsigned  nf = 0;
+    for(unsigned  i = 0; i < TX * 4 * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+      T const  inElem = in.read();
+      if(px < 2)  out.write(inElem);
+      else        lowerRow[((2*tx) + (px-2)) * NF + nf] = inElem;
+      if(++nf == NF) {
+        nf = 0;
+        if(++px == 4) {
+          px = 0;
+          tx++;
+        }
+      }
+    }
+    for(unsigned  i = 0; i < OFMDim * NF; i++) {
+#pragma HLS pipeline style=flp II=1
+      out.write(lowerRow[i]);
+    }
+  }
+}
+
+#endif